@@ -17,6 +17,14 @@
  */
 static char* build_json_keys_message(const char *ar_name, char **keys);
 
+/**
+ * Build JSON message with a command and no parameters to be sent to execd
+ * @param ar_name Name of active response
+ * @param command Command of the message
+ * @return char * with the JSON message in string format
+ */
+static char* build_json_command_message(const char *ar_name, const char *command);
+
 /**
  * Get srcip from win eventdata
  * @param data Input
@@ -148,6 +156,30 @@ int send_keys_and_check_message(char **argv, char **keys) {
     return ret;
 }
 
+int is_resident(int argc, char **argv) {
+    return argc > 1 && argv[1] && !strcmp(argv[1], RESIDENT_ARG);
+}
+
+int wait_for_request(void) {
+    int c = fgetc(stdin);
+
+    if (c == EOF) {
+        return 0;
+    }
+
+    ungetc(c, stdin);
+    return 1;
+}
+
+void send_done_message(char **argv) {
+    char *done_msg = build_json_command_message(basename_ex(argv[0]), DONE_ENTRY);
+
+    fprintf(stdout, "%s\n", done_msg);
+    fflush(stdout);
+
+    os_free(done_msg);
+}
+
 cJSON* get_json_from_input(const char *input) {
     cJSON *input_json = NULL;
     cJSON *version_json = NULL;
@@ -437,6 +469,31 @@ static char* build_json_keys_message(const char *ar_name, char **keys) {
     return msg;
 }
 
+static char* build_json_command_message(const char *ar_name, const char *command) {
+    cJSON *_object = NULL;
+    char *msg = NULL;
+
+    cJSON *message = cJSON_CreateObject();
+
+    cJSON_AddNumberToObject(message, "version", VERSION);
+
+    _object = cJSON_CreateObject();
+    cJSON_AddItemToObject(message, "origin", _object);
+
+    cJSON_AddStringToObject(_object, "name", ar_name ? ar_name : "");
+    cJSON_AddStringToObject(_object, "module", AR_MODULE_NAME);
+
+    cJSON_AddStringToObject(message, "command", command);
+
+    cJSON_AddItemToObject(message, "parameters", cJSON_CreateObject());
+
+    msg = cJSON_PrintUnformatted(message);
+
+    cJSON_Delete(message);
+
+    return msg;
+}
+
 void splitStrFromCharDelimiter(const char * output_buf, const char delimiter, char * strBefore, char * strAfter){
     const char *pos = NULL;
 
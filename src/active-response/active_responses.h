@@ -20,6 +20,10 @@
 #define VERSION 1
 #define AR_MODULE_NAME "active-response"
 #define CHECK_KEYS_ENTRY "check_keys"
+#define DONE_ENTRY "done"
+
+/* Argument given by execd to the active responses it keeps resident */
+#define RESIDENT_ARG "resident"
 
 /**
  * Enumeration of the available commands
@@ -54,6 +58,27 @@ int setup_and_check_message(char **argv, cJSON **message);
  */
 int send_keys_and_check_message(char **argv, char **keys);
 
+/**
+ * @brief Check if the active response runs resident, processing the requests
+ * of execd one after another until it closes stdin
+ * @param argc Number of arguments of the script
+ * @param argv Arguments of the script
+ * @return 1 if resident, 0 otherwise
+ */
+int is_resident(int argc, char **argv);
+
+/**
+ * @brief Wait for the next request from execd
+ * @return 1 if there is a request to read, 0 if stdin was closed
+ */
+int wait_for_request(void);
+
+/**
+ * @brief Send the message that ends a request of a resident active response
+ * @param argv Arguments of the script
+ */
+void send_done_message(char **argv);
+
 /**
  * Get the json structure from input
  * Caller must call cJSON_Delete() to release the object
@@ -14,8 +14,25 @@
 #define IP4TABLES "iptables"
 #define IP6TABLES "ip6tables"
 
+static int run_ar(char **argv);
+
 int main (int argc, char **argv) {
-    (void)argc;
+    int ret = OS_SUCCESS;
+
+    if (!is_resident(argc, argv)) {
+        return run_ar(argv);
+    }
+
+    // Resident: execd sends the requests one after another and closes stdin when done
+    while (wait_for_request()) {
+        ret = run_ar(argv);
+        send_done_message(argv);
+    }
+
+    return ret;
+}
+
+static int run_ar(char **argv) {
     char iptables_tmp[COMMANDSIZE_4096 - 5] = "";
     char log_msg[OS_MAXSTR];
     int action = OS_INVALID;
@@ -47,6 +47,8 @@ int os_analysisd_acm_lookups;
 
 time_t os_analysisd_acm_purge_ts;
 
+w_acm_shard_t os_analysisd_acm_shards[OS_ACM_SHARDS];
+
 
 /**
  * @brief Copies the C string pointed by src into the array pointed by dst
@@ -93,6 +95,55 @@ int Accumulate_Init(OSHash **acm_store, int *acm_lookups, time_t *acm_purge_ts)
     return (1);
 }
 
+/* Start a sharded Accumulator */
+int Accumulate_Init_Shards(w_acm_shard_t *shards, unsigned int count)
+{
+    unsigned int i;
+
+    for (i = 0; i < count; i++) {
+        if (!Accumulate_Init(&shards[i].store, &shards[i].lookups, &shards[i].purge_ts)) {
+            return (0);
+        }
+
+        w_mutex_init(&shards[i].mutex, NULL);
+    }
+
+    return (1);
+}
+
+/* Accumulate data in the shard of the event */
+Eventinfo *Accumulate_Shard(Eventinfo *lf, w_acm_shard_t *shards, unsigned int count)
+{
+    const char *fields[3] = { NULL };
+    unsigned int hash = 2166136261U;
+    w_acm_shard_t *shard;
+    const char *c;
+    int i;
+
+    if (lf == NULL) {
+        return lf;
+    }
+
+    /* Same fields as the accumulator key (FNV-1a) */
+    fields[0] = lf->hostname;
+    fields[1] = lf->decoder_info ? lf->decoder_info->name : NULL;
+    fields[2] = lf->id;
+
+    for (i = 0; i < 3; i++) {
+        for (c = fields[i]; c != NULL && *c != '\0'; c++) {
+            hash = (hash ^ (unsigned char)*c) * 16777619U;
+        }
+    }
+
+    shard = &shards[hash % count];
+
+    w_mutex_lock(&shard->mutex);
+    lf = Accumulate(lf, &shard->store, &shard->lookups, &shard->purge_ts);
+    w_mutex_unlock(&shard->mutex);
+
+    return lf;
+}
+
 /* Accumulate data from events sharing the same ID */
 Eventinfo *Accumulate(Eventinfo *lf, OSHash **acm_store, int *acm_lookups, time_t *acm_purge_ts)
 {
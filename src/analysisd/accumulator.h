@@ -27,6 +27,27 @@ extern int os_analysisd_acm_lookups;
  */
 extern time_t os_analysisd_acm_purge_ts;
 
+/* Number of shards of the accumulator store in Analysisd */
+#define OS_ACM_SHARDS 32
+
+/**
+ * @brief Accumulator store with its own lock and purge counters
+ *
+ * The events are spread among the shards by the accumulator key, so the
+ * events of the same ID always go to the same shard.
+ */
+typedef struct w_acm_shard_t {
+    OSHash *store;           ///< Hash to save data which have the same id
+    int lookups;             ///< Counter of the number of times purged
+    time_t purge_ts;         ///< Counter of interval time since the last purge
+    pthread_mutex_t mutex;   ///< Lock of the shard
+} w_acm_shard_t;
+
+/**
+ * @brief Accumulator shards of Analysisd
+ */
+extern w_acm_shard_t os_analysisd_acm_shards[OS_ACM_SHARDS];
+
 /**
  * @brief Initialize accumulator engine
  * @param acm_store Hash to save data which have the same id
@@ -54,6 +75,23 @@ Eventinfo *Accumulate(Eventinfo *lf, OSHash **acm_store, int *acm_lookups, time_
  */
 void Accumulate_CleanUp(OSHash **acm_store, int *acm_lookups, time_t *acm_purge_ts);
 
+/**
+ * @brief Initialize a sharded accumulator store
+ * @param shards Array of shards
+ * @param count Number of shards
+ * @return 1 on succes, otherwise 0
+ */
+int Accumulate_Init_Shards(w_acm_shard_t *shards, unsigned int count);
+
+/**
+ * @brief Accumulate data from events sharing the same ID, locking only the shard of the event
+ * @param lf EventInfo to proccess
+ * @param shards Array of shards
+ * @param count Number of shards
+ * @return EventInfo passed from input
+ */
+Eventinfo *Accumulate_Shard(Eventinfo *lf, w_acm_shard_t *shards, unsigned int count);
+
 /**
  * @brief Free accumulate hash table
  * 
@@ -111,7 +111,7 @@ void OS_Exec(int *execq, int *arq, int *sock, const Eventinfo *lf, const active_
 
                 snprintf(c_agent_id, OS_SIZE_16, "%.3d", id_array[i]);
 
-                agt_labels = labels_find(c_agent_id, sock);
+                agt_labels = labels_find(c_agent_id);
                 agt_version = labels_get(agt_labels, "_wazuh_version");
 
                 if (!agt_version) {
@@ -201,7 +201,7 @@ void OS_Exec(int *execq, int *arq, int *sock, const Eventinfo *lf, const active_
 
             snprintf(c_agent_id, OS_SIZE_16, "%.3d", agt_id);
 
-            agt_labels = labels_find(c_agent_id, sock);
+            agt_labels = labels_find(c_agent_id);
             agt_version = labels_get(agt_labels, "_wazuh_version");
 
             if (!agt_version) {
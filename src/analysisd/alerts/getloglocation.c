@@ -12,6 +12,7 @@
 
 #include "getloglocation.h"
 #include "config.h"
+#include "monitord/monitord.h"
 
 /* Global definitions */
 FILE *_eflog;
@@ -33,10 +34,19 @@ static char __alogfile[OS_FLSIZE + 1];
 static char __flogfile[OS_FLSIZE + 1];
 static char __jlogfile[OS_FLSIZE + 1];
 static char __ejlogfile[OS_FLSIZE + 1];
+static FILE * __eilog;
+static FILE * __ejilog;
+static time_t __crt_imark;
 
 // Open a valid log or die. No return on error.
 static FILE * openlog(FILE * fp, char path[OS_FLSIZE + 1], const char * logdir, int year, const char * month, const char * tag, int day, const char * ext, const char * lname, int * counter, int rotate);
 
+// Open an archives chunk with its offset index, compressing the previous chunk if rotated.
+static FILE * openarchive(FILE * fp, FILE ** index, char path[OS_FLSIZE + 1], int year, const char * month, int day, const char * ext, const char * lname, int * counter, int rotate);
+
+// Compress a closed archives chunk
+static void * compress_chunk(void * path);
+
 void OS_InitLog()
 {
     OS_InitFwLog();
@@ -60,6 +70,8 @@ void OS_InitLog()
     _fflog = NULL;
     _jflog = NULL;
     _ejflog = NULL;
+    __eilog = NULL;
+    __ejilog = NULL;
 
     /* Set the umask */
     umask(0027);
@@ -73,11 +85,11 @@ int OS_GetLogLocation(int day,int year,char *mon)
      */
 
     /* For the events */
-    _eflog = openlog(_eflog, __elogfile, EVENTS, year, mon, "archive", day, "log", EVENTS_DAILY, &__ecounter, FALSE);
+    _eflog = openarchive(_eflog, &__eilog, __elogfile, year, mon, day, "log", EVENTS_DAILY, &__ecounter, FALSE);
 
     /* For the events in JSON */
     if (Config.logall_json) {
-        _ejflog = openlog(_ejflog, __ejlogfile, EVENTS, year, mon, "archive", day, "json", EVENTSJSON_DAILY, &__ejcounter, FALSE);
+        _ejflog = openarchive(_ejflog, &__ejilog, __ejlogfile, year, mon, day, "json", EVENTSJSON_DAILY, &__ejcounter, FALSE);
     }
 
     /* For the alerts logs */
@@ -150,16 +162,111 @@ FILE * openlog(FILE * fp, char * path, const char * logdir, int year, const char
     return fp;
 }
 
+// Open an archives chunk with its offset index, compressing the previous chunk if rotated.
+
+FILE * openarchive(FILE * fp, FILE ** index, char * path, int year, const char * month, int day, const char * ext, const char * lname, int * counter, int rotate) {
+    char previous[OS_FLSIZE + 1];
+    char index_path[OS_FLSIZE + 6];
+    int compress = Config.archives_compress && rotate && fp && ftell(fp) > 0;
+
+    strncpy(previous, path, OS_FLSIZE);
+    previous[OS_FLSIZE] = '\0';
+
+    if (*index) {
+        if (ftell(*index) == 0) {
+            snprintf(index_path, sizeof(index_path), "%s.idx", previous);
+            unlink(index_path);
+        }
+
+        fclose(*index);
+        *index = NULL;
+    }
+
+    fp = openlog(fp, path, EVENTS, year, month, "archive", day, ext, lname, counter, rotate);
+
+    // The writes are batched until the buffer fills up or the logs are flushed
+    if (Config.archives_buffer_size && setvbuf(fp, NULL, _IOFBF, Config.archives_buffer_size) != 0) {
+        mwarn("Cannot set the buffer of '%s'", path);
+    }
+
+    if (Config.archives_index_interval) {
+        snprintf(index_path, sizeof(index_path), "%s.idx", path);
+
+        if (*index = wfopen(index_path, "a"), !*index) {
+            merror(FOPEN_ERROR, index_path, errno, strerror(errno));
+        }
+
+        // Mark the start of the new chunk
+        __crt_imark = 0;
+    }
+
+    if (compress) {
+        char * chunk;
+
+        os_strdup(previous, chunk);
+
+        if (!CreateThread(compress_chunk, chunk)) {
+            merror("Cannot compress '%s'", chunk);
+            os_free(chunk);
+        }
+    }
+
+    return fp;
+}
+
+// Compress a closed archives chunk. Its index keeps the offsets of the uncompressed content.
+
+void * compress_chunk(void * path) {
+    mdebug1("Compressing '%s'", (char *)path);
+    OS_CompressLog(path);
+    os_free(path);
+    return NULL;
+}
+
+void OS_IndexArchives(void) {
+    time_t mark;
+
+    if (!Config.archives_index_interval) {
+        return;
+    }
+
+    mark = c_time - c_time % Config.archives_index_interval;
+
+    if (mark == __crt_imark) {
+        return;
+    }
+
+    __crt_imark = mark;
+
+    if (_eflog && __eilog) {
+        fprintf(__eilog, "%ld %ld\n", (long)mark, ftell(_eflog));
+    }
+
+    if (_ejflog && __ejilog) {
+        fprintf(__ejilog, "%ld %ld\n", (long)mark, ftell(_ejflog));
+    }
+}
+
+void OS_IndexArchives_Flush(void) {
+    if (__eilog) {
+        fflush(__eilog);
+    }
+
+    if (__ejilog) {
+        fflush(__ejilog);
+    }
+}
+
 void OS_RotateLogs(int day,int year,char *mon) {
 
     if (Config.rotate_interval && c_time - __crt_rsec > Config.rotate_interval) {
         // If timespan exceeded the rotation time and the file isn't empty
         if (_eflog && ftell(_eflog) > 0) {
-            _eflog = openlog(_eflog, __elogfile, EVENTS, year, mon, "archive", day, "log", EVENTS_DAILY, &__ecounter, TRUE);
+            _eflog = openarchive(_eflog, &__eilog, __elogfile, year, mon, day, "log", EVENTS_DAILY, &__ecounter, TRUE);
         }
 
         if (_ejflog && ftell(_ejflog) > 0) {
-            _ejflog = openlog(_ejflog, __ejlogfile, EVENTS, year, mon, "archive", day, "json", EVENTSJSON_DAILY, &__ejcounter, TRUE);
+            _ejflog = openarchive(_ejflog, &__ejilog, __ejlogfile, year, mon, day, "json", EVENTSJSON_DAILY, &__ejcounter, TRUE);
         }
 
         if (_aflog && ftell(_aflog) > 0) {
@@ -179,12 +286,12 @@ void OS_RotateLogs(int day,int year,char *mon) {
         // Or if timespan from last rotation is enough and the file is too big
 
         if (_eflog && ftell(_eflog) > Config.max_output_size) {
-            _eflog = openlog(_eflog, __elogfile, EVENTS, year, mon, "archive", day, "log", EVENTS_DAILY, &__ecounter, TRUE);
+            _eflog = openarchive(_eflog, &__eilog, __elogfile, year, mon, day, "log", EVENTS_DAILY, &__ecounter, TRUE);
             __crt_rsec = c_time;
         }
 
         if (_ejflog && ftell(_ejflog) > Config.max_output_size) {
-            _ejflog = openlog(_ejflog, __ejlogfile, EVENTS, year, mon, "archive", day, "json", EVENTSJSON_DAILY, &__ejcounter, TRUE);
+            _ejflog = openarchive(_ejflog, &__ejilog, __ejlogfile, year, mon, day, "json", EVENTSJSON_DAILY, &__ejcounter, TRUE);
             __crt_rsec = c_time;
         }
 
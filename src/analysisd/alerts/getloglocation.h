@@ -33,4 +33,10 @@ extern FILE *_ejflog;
 
 void OS_RotateLogs(int day,int year,char *mon);
 
+/* Record the current offset of the archives in their index at the start of each
+ * archives_index_interval. Each index line is "<timestamp> <offset>".
+ */
+void OS_IndexArchives(void);
+void OS_IndexArchives_Flush(void);
+
 #endif /* GETLL_H */
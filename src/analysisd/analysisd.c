@@ -36,8 +36,10 @@
 #include "accumulator.h"
 #include "analysisd.h"
 #include "fts.h"
+#include "wdb_async.h"
 #include "cleanevent.h"
 #include "output/jsonout.h"
+#include "output/alert_bus.h"
 #include "labels.h"
 #include "state.h"
 #include "syscheck_op.h"
@@ -54,10 +56,14 @@
 /** Prototypes **/
 void OS_ReadMSG(int m_queue);
 static void LoopRule(RuleNode *curr_node, FILE *flog);
+static OS_XML_FILE * ParseRulesetFiles(char **files, size_t *count);
 
 /* For decoders */
 int DecodeSyscheck(Eventinfo *lf, _sdb *sdb);
 int decode_fim_event(_sdb *sdb, Eventinfo *lf); // Decode events in json format
+char ** fim_expand_batch(const char * msg); // Expand a batch of events into their messages
+void fim_db_batch_start(_sdb * sdb);
+void fim_db_batch_end(_sdb * sdb);
 int DecodeRootcheck(Eventinfo *lf);
 int DecodeHostinfo(Eventinfo *lf);
 int DecodeSyscollector(Eventinfo *lf, int *socket);
@@ -167,53 +173,50 @@ typedef struct _osmatch_exec {
 } _osmatch_execute;
 
 /* Archives writer queue */
-w_queue_t * writer_queue;
+w_mpmc_queue_t * writer_queue;
 
 /* Alerts log writer queue */
-w_queue_t * writer_queue_log;
+w_mpmc_queue_t * writer_queue_log;
 
 /* Statistical log writer queue */
-w_queue_t * writer_queue_log_statistical;
+w_mpmc_queue_t * writer_queue_log_statistical;
 
 /* Firewall log writer queue */
-w_queue_t * writer_queue_log_firewall;
+w_mpmc_queue_t * writer_queue_log_firewall;
 
 /* Decode syscheck input queue */
-w_queue_t * decode_queue_syscheck_input;
+w_mpmc_queue_t * decode_queue_syscheck_input;
 
 /* Decode syscollector input queue */
-w_queue_t * decode_queue_syscollector_input;
+w_mpmc_queue_t * decode_queue_syscollector_input;
 
 /* Decode rootcheck input queue */
-w_queue_t * decode_queue_rootcheck_input;
+w_mpmc_queue_t * decode_queue_rootcheck_input;
 
 /* Decode policy monitoring input queue */
-w_queue_t * decode_queue_sca_input;
+w_mpmc_queue_t * decode_queue_sca_input;
 
 /* Decode hostinfo input queue */
-w_queue_t * decode_queue_hostinfo_input;
+w_mpmc_queue_t * decode_queue_hostinfo_input;
 
 /* Decode event input queue */
-w_queue_t * decode_queue_event_input;
+w_mpmc_queue_t * decode_queue_event_input;
 
 /* Decode pending event output */
-w_queue_t * decode_queue_event_output;
+w_mpmc_queue_t * decode_queue_event_output;
 
 /* Decode windows event input queue */
-w_queue_t * decode_queue_winevt_input;
+w_mpmc_queue_t * decode_queue_winevt_input;
 
 /* Database synchronization input queue */
-w_queue_t * dispatch_dbsync_input;
+w_mpmc_queue_t * dispatch_dbsync_input;
 
 /* Upgrade module decoder  */
-w_queue_t * upgrade_module_input;
+w_mpmc_queue_t * upgrade_module_input;
 
 /* Hourly firewall mutex */
 static pthread_mutex_t hourly_firewall_mutex = PTHREAD_MUTEX_INITIALIZER;
 
-/* Accumulate mutex */
-static pthread_mutex_t accumulate_mutex = PTHREAD_MUTEX_INITIALIZER;
-
 static pthread_mutex_t current_time_mutex = PTHREAD_MUTEX_INITIALIZER;
 
 /* Reported variables */
@@ -583,14 +586,17 @@ int main_analysisd(int argc, char **argv)
 
             /* New loaded based on file loaded (in ossec.conf or default) */
             {
-                char **decodersfiles;
-                decodersfiles = Config.decoders;
-                while ( decodersfiles && *decodersfiles) {
+                size_t count = 0;
+                OS_XML_FILE *xml_files = ParseRulesetFiles(Config.decoders, &count);
+
+                for (size_t n = 0; n < count; n++) {
+                    char **decodersfiles = &Config.decoders[n];
+
                     if (!test_config) {
-                        mdebug1("Reading decoder file %s.", *decodersfiles);
+                        mdebug1("Reading decoder file %s (parsed in %.3f ms).", *decodersfiles, xml_files[n].time * 1000);
                     }
-                    if (!ReadDecodeXML(*decodersfiles, &os_analysisd_decoderlist_pn,
-                                        &os_analysisd_decoderlist_nopn, &os_analysisd_decoder_store, list_msg)) {
+                    if (!ReadDecodeParsedXML(&xml_files[n], &os_analysisd_decoderlist_pn,
+                                             &os_analysisd_decoderlist_nopn, &os_analysisd_decoder_store, list_msg)) {
                         error_exit = 1;
                     }
                     node_log_msg = OSList_GetFirstNode(list_msg);
@@ -612,9 +618,9 @@ int main_analysisd(int argc, char **argv)
                     if (error_exit) {
                         merror_exit(CONFIG_ERROR, *decodersfiles);
                     }
-
-                    decodersfiles++;
                 }
+
+                os_free(xml_files);
             }
 
             /* Load decoders */
@@ -710,16 +716,28 @@ int main_analysisd(int argc, char **argv)
                 OSListNode * node_log_msg;
                 int error_exit = 0;
 
-                char **rulesfiles;
-                rulesfiles = Config.includes;
-                while (rulesfiles && *rulesfiles) {
+                size_t count = 0;
+                char **rulepaths = NULL;
+                OS_XML_FILE *xml_files;
+
+                while (Config.includes && Config.includes[count]) {
+                    os_realloc(rulepaths, (count + 2) * sizeof(char *), rulepaths);
+                    rulepaths[count] = Rules_OP_GetRulePath(Config.includes[count]);
+                    rulepaths[++count] = NULL;
+                }
+
+                xml_files = ParseRulesetFiles(rulepaths, &count);
+
+                for (size_t n = 0; n < count; n++) {
+                    char **rulesfiles = &Config.includes[n];
+
                     if (!test_config) {
-                        mdebug1("Reading rules file: '%s'", *rulesfiles);
+                        mdebug1("Reading rules file: '%s' (parsed in %.3f ms)", *rulesfiles, xml_files[n].time * 1000);
                     }
 
-                    if (Rules_OP_ReadRules(*rulesfiles, &os_analysisd_rulelist,
-                                           &os_analysisd_cdblists, &os_analysisd_last_events,
-                                           &os_analysisd_decoder_store, list_msg) < 0) {
+                    if (Rules_OP_ReadParsedRules(*rulesfiles, &xml_files[n], &os_analysisd_rulelist,
+                                                 &os_analysisd_cdblists, &os_analysisd_last_events,
+                                                 &os_analysisd_decoder_store, list_msg) < 0) {
                         error_exit = 1;
                     }
 
@@ -742,9 +760,10 @@ int main_analysisd(int argc, char **argv)
                     if (error_exit) {
                         merror_exit(RULES_ERROR, *rulesfiles);
                     }
-
-                    rulesfiles++;
                 }
+
+                os_free(xml_files);
+                free_strarray(rulepaths);
                 OSList_Destroy(list_msg);
             }
 
@@ -766,6 +785,9 @@ int main_analysisd(int argc, char **argv)
         if (!test_config) {
             minfo("Total rules enabled: '%d'", total_rules);
         }
+
+        /* Index the rules by decoder */
+        OS_IndexRules(tmp_node);
     }
 
     /* Create a rules hash (for reading alerts from other servers) */
@@ -842,6 +864,11 @@ int main_analysisd(int argc, char **argv)
     // Start com request thread
     w_create_thread(asyscom_main, NULL);
 
+    // Start alert bus thread
+    if (getDefine_Int("analysisd", "alert_bus", 0, 1)) {
+        w_create_thread(alert_bus_main, NULL);
+    }
+
     /* Load Mitre JSON File and Mitre hash table */
     mitre_load();
 
@@ -891,7 +918,7 @@ void OS_ReadMSG_analysisd(int m_queue)
     SecurityConfigurationAssessmentInit();
 
     /* Initialize the Accumulator */
-    if (!Accumulate_Init(&os_analysisd_acm_store, &os_analysisd_acm_lookups, &os_analysisd_acm_purge_ts)) {
+    if (!Accumulate_Init_Shards(os_analysisd_acm_shards, OS_ACM_SHARDS)) {
         merror("accumulator: ERROR: Initialization failed");
         exit(1);
     }
@@ -1038,6 +1065,9 @@ void OS_ReadMSG_analysisd(int m_queue)
     /* Create log rotation thread */
     w_create_thread(w_log_rotate_thread, NULL);
 
+    /* Start the asynchronous wazuh-db client of the decoders */
+    wdb_async_init();
+
     /* Create decode syscheck threads */
     for(i = 0; i < num_decode_syscheck_threads;i++){
         w_create_thread(w_decode_syscheck_thread, NULL);
@@ -1089,6 +1119,9 @@ void OS_ReadMSG_analysisd(int m_queue)
     /* Create State thread */
     w_create_thread(w_analysisd_state_main, NULL);
 
+    /* Create labels refresh thread */
+    w_create_thread(labels_refresh_thread, NULL);
+
     mdebug1("Startup completed. Waiting for new messages..");
 
     while (1) {
@@ -1104,6 +1137,29 @@ void OS_ReadMSG_analysisd(int m_queue)
     }
 }
 
+/* Parse the ruleset files on a pool of threads, to be loaded in order afterwards */
+static OS_XML_FILE * ParseRulesetFiles(char **files, size_t *count)
+{
+    OS_XML_FILE *xml_files = NULL;
+    struct timespec start;
+    struct timespec end;
+
+    for (*count = 0; files && files[*count]; (*count)++);
+
+    os_calloc(*count + 1, sizeof(OS_XML_FILE), xml_files);
+
+    for (size_t n = 0; n < *count; n++) {
+        xml_files[n].file = files[n];
+    }
+
+    gettime(&start);
+    OS_ReadXMLFiles(xml_files, *count, cpu_cores > 0 ? (unsigned int)cpu_cores : 1);
+    gettime(&end);
+
+    mdebug1("Parsed %zu ruleset files in %.3f seconds.", *count, time_diff(&start, &end));
+    return xml_files;
+}
+
 /*  Update each rule and print it to the logs */
 static void LoopRule(RuleNode *curr_node, FILE *flog)
 {
@@ -1218,10 +1274,10 @@ void * ad_input_main(void * args) {
             result = -1;
 
             if (msg[0] == SYSCHECK_MQ) {
-                if (!queue_full(decode_queue_syscheck_input)) {
+                if (!mpmc_queue_full(decode_queue_syscheck_input)) {
                     os_strdup(buffer, copy);
 
-                    result = queue_push_ex(decode_queue_syscheck_input, copy);
+                    result = mpmc_queue_push(decode_queue_syscheck_input, copy);
 
                     if (result == -1) {
                         free(copy);
@@ -1240,10 +1296,10 @@ void * ad_input_main(void * args) {
                     }
                 }
             } else if (msg[0] == ROOTCHECK_MQ) {
-                if (!queue_full(decode_queue_rootcheck_input)) {
+                if (!mpmc_queue_full(decode_queue_rootcheck_input)) {
                     os_strdup(buffer, copy);
 
-                    result = queue_push_ex(decode_queue_rootcheck_input, copy);
+                    result = mpmc_queue_push(decode_queue_rootcheck_input, copy);
 
                     if (result == -1) {
                         free(copy);
@@ -1261,10 +1317,10 @@ void * ad_input_main(void * args) {
                     }
                 }
             } else if (msg[0] == SCA_MQ) {
-                if (!queue_full(decode_queue_sca_input)) {
+                if (!mpmc_queue_full(decode_queue_sca_input)) {
                     os_strdup(buffer, copy);
 
-                    result = queue_push_ex(decode_queue_sca_input, copy);
+                    result = mpmc_queue_push(decode_queue_sca_input, copy);
 
                     if (result == -1) {
                         free(copy);
@@ -1282,10 +1338,10 @@ void * ad_input_main(void * args) {
                     }
                 }
             } else if (msg[0] == SYSCOLLECTOR_MQ) {
-                if (!queue_full(decode_queue_syscollector_input)) {
+                if (!mpmc_queue_full(decode_queue_syscollector_input)) {
                     os_strdup(buffer, copy);
 
-                    result = queue_push_ex(decode_queue_syscollector_input, copy);
+                    result = mpmc_queue_push(decode_queue_syscollector_input, copy);
 
                     if (result == -1) {
                         free(copy);
@@ -1303,10 +1359,10 @@ void * ad_input_main(void * args) {
                     }
                 }
             } else if (msg[0] == HOSTINFO_MQ) {
-                if (!queue_full(decode_queue_hostinfo_input)) {
+                if (!mpmc_queue_full(decode_queue_hostinfo_input)) {
                     os_strdup(buffer, copy);
 
-                    result = queue_push_ex(decode_queue_hostinfo_input, copy);
+                    result = mpmc_queue_push(decode_queue_hostinfo_input, copy);
 
                     if (result == -1) {
                         free(copy);
@@ -1324,10 +1380,10 @@ void * ad_input_main(void * args) {
                     }
                 }
             } else if (msg[0] == WIN_EVT_MQ) {
-                if (!queue_full(decode_queue_winevt_input)) {
+                if (!mpmc_queue_full(decode_queue_winevt_input)) {
                     os_strdup(buffer, copy);
 
-                    result = queue_push_ex(decode_queue_winevt_input, copy);
+                    result = mpmc_queue_push(decode_queue_winevt_input, copy);
 
                     if (result == -1) {
                         free(copy);
@@ -1345,10 +1401,10 @@ void * ad_input_main(void * args) {
                     }
                 }
             } else if (msg[0] == DBSYNC_MQ) {
-                if (!queue_full(dispatch_dbsync_input)) {
+                if (!mpmc_queue_full(dispatch_dbsync_input)) {
                     os_strdup(buffer, copy);
 
-                    result = queue_push_ex(dispatch_dbsync_input, copy);
+                    result = mpmc_queue_push(dispatch_dbsync_input, copy);
 
                     if (result == -1) {
                         free(copy);
@@ -1366,10 +1422,10 @@ void * ad_input_main(void * args) {
                     }
                 }
             } else if (msg[0] == UPGRADE_MQ) {
-                if (!queue_full(upgrade_module_input)) {
+                if (!mpmc_queue_full(upgrade_module_input)) {
                     os_strdup(buffer, copy);
 
-                    result = queue_push_ex(upgrade_module_input, copy);
+                    result = mpmc_queue_push(upgrade_module_input, copy);
 
                     if (result == -1) {
                         free(copy);
@@ -1387,10 +1443,10 @@ void * ad_input_main(void * args) {
                     }
                 }
             } else {
-                if (!queue_full(decode_queue_event_input)) {
+                if (!mpmc_queue_full(decode_queue_event_input)) {
                     os_strdup(buffer, copy);
 
-                    result = queue_push_ex(decode_queue_event_input, copy);
+                    result = mpmc_queue_push(decode_queue_event_input, copy);
 
                     if (result == -1) {
                         free(copy);
@@ -1453,10 +1509,11 @@ void * w_writer_thread(__attribute__((unused)) void * args ){
 
     while(1){
         /* Receive message from queue */
-        if (lf = queue_pop_ex(writer_queue), lf) {
+        if (lf = mpmc_queue_pop_block(writer_queue), lf) {
 
             w_mutex_lock(&writer_threads_mutex);
             w_inc_archives_written(lf->agent_id);
+            OS_IndexArchives();
 
             /* If configured to log all, do it */
             if (Config.logall) {
@@ -1477,7 +1534,7 @@ void * w_writer_log_thread(__attribute__((unused)) void * args ){
 
     while(1){
         /* Receive message from queue */
-        if (lf = queue_pop_ex(writer_queue_log), lf) {
+        if (lf = mpmc_queue_pop_block(writer_queue_log), lf) {
 
             w_mutex_lock(&writer_threads_mutex);
             w_inc_alerts_written(lf->agent_id);
@@ -1524,9 +1581,51 @@ void * w_writer_log_thread(__attribute__((unused)) void * args ){
     }
 }
 
-void * w_decode_syscheck_thread(__attribute__((unused)) void * args){
+/* Decode a syscheck message, that is released */
+static void w_decode_syscheck_msg(char *msg, _sdb *sdb, OSDecoderInfo *fim_decoder) {
     Eventinfo *lf = NULL;
+    int res = 0;
+
+    get_eps_credit();
+
+    os_calloc(1, sizeof(Eventinfo), lf);
+    os_calloc(Config.decoder_order_size, sizeof(DynamicField), lf->fields);
+
+    /* Default values for the log info */
+    Zero_Eventinfo(lf);
+
+    if (OS_CleanMSG(msg, lf) < 0) {
+        merror(IMSG_ERROR, msg);
+        Free_Eventinfo(lf);
+        free(msg);
+        return;
+    }
+
+    free(msg);
+
+    /* Msg cleaned */
+    DEBUG_MSG("%s: DEBUG: Msg cleanup: %s ", ARGV0, lf->log);
+
+    w_inc_modules_syscheck_decoded_events(lf->agent_id);
+
+    lf->decoder_info = fim_decoder;
+
+    // If the event comes in JSON format agent version is >= 3.11. Therefore we decode, alert and update DB entry.
+    if (*lf->log == '{') {
+        res = decode_fim_event(sdb, lf);
+    } else {
+        res = DecodeSyscheck(lf, sdb);
+    }
+
+    if (res != 1 || mpmc_queue_push_block(decode_queue_event_output, lf) != 0) {
+        /* We don't process syscheck events further */
+        w_free_event_info(lf);
+    }
+}
+
+void * w_decode_syscheck_thread(__attribute__((unused)) void * args){
     char *msg = NULL;
+    char **batch = NULL;
     _sdb sdb;
     OSDecoderInfo *fim_decoder = NULL;
 
@@ -1537,45 +1636,23 @@ void * w_decode_syscheck_thread(__attribute__((unused)) void * args){
 
     while(1) {
         /* Receive message from queue */
-        if (msg = queue_pop_ex(decode_queue_syscheck_input), msg) {
-            get_eps_credit();
-
-            int res = 0;
-            os_calloc(1, sizeof(Eventinfo), lf);
-            os_calloc(Config.decoder_order_size, sizeof(DynamicField), lf->fields);
-
-            /* Default values for the log info */
-            Zero_Eventinfo(lf);
-
-            if (OS_CleanMSG(msg, lf) < 0) {
-                merror(IMSG_ERROR, msg);
-                Free_Eventinfo(lf);
-                free(msg);
+        if (msg = mpmc_queue_pop_block(decode_queue_syscheck_input), msg) {
+            if (batch = fim_expand_batch(msg), batch == NULL) {
+                w_decode_syscheck_msg(msg, &sdb, fim_decoder);
                 continue;
             }
 
             free(msg);
 
-            /* Msg cleaned */
-            DEBUG_MSG("%s: DEBUG: Msg cleanup: %s ", ARGV0, lf->log);
-
-            w_inc_modules_syscheck_decoded_events(lf->agent_id);
+            // Every event of the batch is decoded for the rules, and their entries are stored together
+            fim_db_batch_start(&sdb);
 
-            lf->decoder_info = fim_decoder;
-
-            // If the event comes in JSON format agent version is >= 3.11. Therefore we decode, alert and update DB entry.
-            if (*lf->log == '{') {
-                res = decode_fim_event(&sdb, lf);
-            } else {
-                res = DecodeSyscheck(lf, &sdb);
+            for (int i = 0; batch[i] != NULL; i++) {
+                w_decode_syscheck_msg(batch[i], &sdb, fim_decoder);
             }
 
-            if (res == 1 && queue_push_ex_block(decode_queue_event_output, lf) == 0) {
-                continue;
-            } else {
-                /* We don't process syscheck events further */
-                w_free_event_info(lf);
-            }
+            fim_db_batch_end(&sdb);
+            free(batch);
         }
     }
 }
@@ -1587,7 +1664,7 @@ void * w_decode_syscollector_thread(__attribute__((unused)) void * args){
 
     while(1) {
         /* Receive message from queue */
-        if (msg = queue_pop_ex(decode_queue_syscollector_input), msg) {
+        if (msg = mpmc_queue_pop_block(decode_queue_syscollector_input), msg) {
             get_eps_credit();
 
             os_calloc(1, sizeof(Eventinfo), lf);
@@ -1615,7 +1692,7 @@ void * w_decode_syscollector_thread(__attribute__((unused)) void * args){
                 w_free_event_info(lf);
             }
             else {
-                if (queue_push_ex_block(decode_queue_event_output, lf) < 0) {
+                if (mpmc_queue_push_block(decode_queue_event_output, lf) < 0) {
                     w_free_event_info(lf);
                 }
             }
@@ -1629,7 +1706,7 @@ void * w_decode_rootcheck_thread(__attribute__((unused)) void * args){
 
     while(1) {
         /* Receive message from queue */
-        if (msg = queue_pop_ex(decode_queue_rootcheck_input), msg) {
+        if (msg = mpmc_queue_pop_block(decode_queue_rootcheck_input), msg) {
             get_eps_credit();
 
             os_calloc(1, sizeof(Eventinfo), lf);
@@ -1657,7 +1734,7 @@ void * w_decode_rootcheck_thread(__attribute__((unused)) void * args){
                 w_free_event_info(lf);
             }
             else {
-                if (queue_push_ex_block(decode_queue_event_output, lf) < 0) {
+                if (mpmc_queue_push_block(decode_queue_event_output, lf) < 0) {
                     w_free_event_info(lf);
                 }
             }
@@ -1672,7 +1749,7 @@ void * w_decode_sca_thread(__attribute__((unused)) void * args){
 
     while(1) {
         /* Receive message from queue */
-        if (msg = queue_pop_ex(decode_queue_sca_input), msg) {
+        if (msg = mpmc_queue_pop_block(decode_queue_sca_input), msg) {
             get_eps_credit();
 
             os_calloc(1, sizeof(Eventinfo), lf);
@@ -1700,7 +1777,7 @@ void * w_decode_sca_thread(__attribute__((unused)) void * args){
                 w_free_event_info(lf);
             }
             else {
-                if (queue_push_ex_block(decode_queue_event_output, lf) < 0) {
+                if (mpmc_queue_push_block(decode_queue_event_output, lf) < 0) {
                     w_free_event_info(lf);
                 }
             }
@@ -1714,7 +1791,7 @@ void * w_decode_hostinfo_thread(__attribute__((unused)) void * args){
 
     while(1) {
         /* Receive message from queue */
-        if (msg = queue_pop_ex(decode_queue_hostinfo_input), msg) {
+        if (msg = mpmc_queue_pop_block(decode_queue_hostinfo_input), msg) {
             get_eps_credit();
 
             os_calloc(1, sizeof(Eventinfo), lf);
@@ -1742,7 +1819,7 @@ void * w_decode_hostinfo_thread(__attribute__((unused)) void * args){
                 w_free_event_info(lf);
             }
             else {
-                if (queue_push_ex_block(decode_queue_event_output, lf) < 0) {
+                if (mpmc_queue_push_block(decode_queue_event_output, lf) < 0) {
                     w_free_event_info(lf);
                 }
             }
@@ -1760,7 +1837,7 @@ void * w_decode_event_thread(__attribute__((unused)) void * args){
 
     while(1) {
         /* Receive message from queue */
-        if (msg = queue_pop_ex(decode_queue_event_input), msg) {
+        if (msg = mpmc_queue_pop_block(decode_queue_event_input), msg) {
             get_eps_credit();
 
             os_calloc(1, sizeof(Eventinfo), lf);
@@ -1798,7 +1875,7 @@ void * w_decode_event_thread(__attribute__((unused)) void * args){
             /* Msg cleaned */
             DEBUG_MSG("%s: DEBUG: Msg cleanup: %s ", ARGV0, lf->log);
 
-            if (queue_push_ex_block(decode_queue_event_output, lf) < 0) {
+            if (mpmc_queue_push_block(decode_queue_event_output, lf) < 0) {
                 Free_Eventinfo(lf);
             }
         }
@@ -1811,7 +1888,7 @@ void * w_decode_winevt_thread(__attribute__((unused)) void * args) {
 
     while(1) {
         /* Receive message from queue */
-        if (msg = queue_pop_ex(decode_queue_winevt_input), msg) {
+        if (msg = mpmc_queue_pop_block(decode_queue_winevt_input), msg) {
             get_eps_credit();
 
             os_calloc(1, sizeof(Eventinfo), lf);
@@ -1839,7 +1916,7 @@ void * w_decode_winevt_thread(__attribute__((unused)) void * args) {
                 w_free_event_info(lf);
             }
             else {
-                if (queue_push_ex_block(decode_queue_event_output, lf) < 0) {
+                if (mpmc_queue_push_block(decode_queue_event_output, lf) < 0) {
                     w_free_event_info(lf);
                 }
             }
@@ -1853,7 +1930,7 @@ void * w_dispatch_dbsync_thread(__attribute__((unused)) void * args) {
     dbsync_context_t ctx = { .db_sock = -1, .ar_sock = -1 };
 
     for (;;) {
-        if (msg = queue_pop_ex(dispatch_dbsync_input), msg) {
+        if (msg = mpmc_queue_pop_block(dispatch_dbsync_input), msg) {
             get_eps_credit();
 
             os_calloc(1, sizeof(Eventinfo), lf);
@@ -1884,7 +1961,7 @@ void * w_dispatch_upgrade_module_thread(__attribute__((unused)) void * args) {
     Eventinfo * lf;
 
     while (true) {
-        if (msg = queue_pop_ex(upgrade_module_input), msg) {
+        if (msg = mpmc_queue_pop_block(upgrade_module_input), msg) {
             get_eps_credit();
 
             os_calloc(1, sizeof(Eventinfo), lf);
@@ -1972,7 +2049,7 @@ void * w_process_event_thread(__attribute__((unused)) void * id){
         lf_logall = NULL;
 
         /* Extract decoded event from the queue */
-        if (lf = queue_pop_ex(decode_queue_event_output), !lf) {
+        if (lf = mpmc_queue_pop_block(decode_queue_event_output), !lf) {
             continue;
         }
 
@@ -1983,9 +2060,7 @@ void * w_process_event_thread(__attribute__((unused)) void * id){
 
         /* Run accumulator */
         if ( lf->decoder_info->accumulate == 1 ) {
-            w_mutex_lock(&accumulate_mutex);
-            lf = Accumulate(lf, &os_analysisd_acm_store, &os_analysisd_acm_lookups, &os_analysisd_acm_purge_ts);
-            w_mutex_unlock(&accumulate_mutex);
+            lf = Accumulate_Shard(lf, os_analysisd_acm_shards, OS_ACM_SHARDS);
         }
 
         /* Firewall event */
@@ -2007,7 +2082,7 @@ void * w_process_event_thread(__attribute__((unused)) void * id){
                 os_calloc(1, sizeof(Eventinfo), lf_cpy);
                 w_copy_event_for_log(lf, lf_cpy);
 
-                if (queue_push_ex_block(writer_queue_log_firewall, lf_cpy) < 0) {
+                if (mpmc_queue_push_block(writer_queue_log_firewall, lf_cpy) < 0) {
                     Free_Eventinfo(lf_cpy);
                 }
             }
@@ -2031,7 +2106,7 @@ void * w_process_event_thread(__attribute__((unused)) void * id){
                     os_calloc(1, sizeof(Eventinfo), lf_cpy);
                     w_copy_event_for_log(lf, lf_cpy);
 
-                    if (queue_push_ex_block(writer_queue_log_statistical, lf_cpy) < 0) {
+                    if (mpmc_queue_push_block(writer_queue_log_statistical, lf_cpy) < 0) {
                         Free_Eventinfo(lf_cpy);
                     }
                 }
@@ -2044,7 +2119,7 @@ void * w_process_event_thread(__attribute__((unused)) void * id){
         }
 
         // Insert labels
-        lf->labels = labels_find(lf->agent_id, &sock);
+        lf->labels = labels_find(lf->agent_id);
 
         /* Check the rules */
         DEBUG_MSG("%s: DEBUG: Checking the rules - %d ",
@@ -2128,7 +2203,13 @@ void * w_process_event_thread(__attribute__((unused)) void * id){
             if (t_currently_rule->alert_opts & DO_LOGALERT) {
                 os_calloc(1, sizeof(Eventinfo), lf_cpy);
                 w_copy_event_for_log(lf, lf_cpy);
-                if (queue_push_ex_block(writer_queue_log, lf_cpy) < 0) {
+
+                /* The archives writer takes the same copy, the event doesn't change until then */
+                if (Config.logall || Config.logall_json) {
+                    lf_logall = w_share_event_for_log(lf_cpy);
+                }
+
+                if (mpmc_queue_push_block(writer_queue_log, lf_cpy) < 0) {
                     Free_Eventinfo(lf_cpy);
                 }
             }
@@ -2158,6 +2239,9 @@ void * w_process_event_thread(__attribute__((unused)) void * id){
                 }
             }
 
+            /* Count the event for the rules that search it, before it can be found in the lists */
+            w_correlation_add_event(t_currently_rule, lf);
+
             /* Copy the structure to the state memory of if_matched_sid */
             if (t_currently_rule->sid_prev_matched) {
                 OSListNode *node;
@@ -2188,8 +2272,13 @@ void * w_process_event_thread(__attribute__((unused)) void * id){
             }
 
             lf->queue_added = 1;
-            os_calloc(1, sizeof(Eventinfo), lf_logall);
-            w_copy_event_for_log(lf, lf_logall);
+
+            /* The event may be freed by other thread once it's in the list */
+            if (!lf_logall && (Config.logall || Config.logall_json)) {
+                os_calloc(1, sizeof(Eventinfo), lf_logall);
+                w_copy_event_for_log(lf, lf_logall);
+            }
+
             w_free_event_info(lf);
             OS_AddEvent(lf, os_analysisd_last_events);
             break;
@@ -2201,7 +2290,7 @@ void * w_process_event_thread(__attribute__((unused)) void * id){
                 os_calloc(1, sizeof(Eventinfo), lf_logall);
                 w_copy_event_for_log(lf, lf_logall);
             }
-            result = queue_push_ex(writer_queue, lf_logall);
+            result = mpmc_queue_push(writer_queue, lf_logall);
             if (result < 0) {
                 if (!reported_writer){
                     mwarn("Archive writer queue is full. %d", t_id);
@@ -2279,7 +2368,7 @@ void * w_writer_log_statistical_thread(__attribute__((unused)) void * args ){
 
     while(1){
         /* Receive message from queue */
-        if (lf = queue_pop_ex(writer_queue_log_statistical), lf) {
+        if (lf = mpmc_queue_pop_block(writer_queue_log_statistical), lf) {
 
             w_mutex_lock(&writer_threads_mutex);
             w_inc_stats_written();
@@ -2311,7 +2400,7 @@ void * w_writer_log_firewall_thread(__attribute__((unused)) void * args ){
 
     while(1){
         /* Receive message from queue */
-        if (lf = queue_pop_ex(writer_queue_log_firewall), lf) {
+        if (lf = mpmc_queue_pop_block(writer_queue_log_firewall), lf) {
 
             w_mutex_lock(&writer_threads_mutex);
             w_inc_firewall_written(lf->agent_id);
@@ -2334,6 +2423,8 @@ void w_log_flush(){
         jsonout_output_archive_flush();
     }
 
+    OS_IndexArchives_Flush();
+
     /* Flush alerts.json */
     if (Config.jsonout_output) {
         jsonout_output_event_flush();
@@ -2352,67 +2443,72 @@ void w_log_flush(){
 }
 
 void * w_writer_log_fts_thread(__attribute__((unused)) void * args ){
-    char * line;
+    char * lines[FTS_WRITE_BATCH];
+    size_t count;
+    size_t i;
 
     while(1){
-        /* Receive message from queue */
-        if (line = queue_pop_ex(writer_queue_log_fts), line) {
+        /* Receive all the pending messages, up to a batch */
+        count = mpmc_queue_pop_batch_block(writer_queue_log_fts, (void **)lines, FTS_WRITE_BATCH);
 
-            w_mutex_lock(&writer_threads_mutex);
+        w_mutex_lock(&writer_threads_mutex);
+        for (i = 0; i < count; i++) {
             w_inc_fts_written();
-            FTS_Fprintf(line);
-            w_mutex_unlock(&writer_threads_mutex);
+        }
+        FTS_Fprintf_Batch(lines, count);
+        w_mutex_unlock(&writer_threads_mutex);
 
-            free(line);
+        for (i = 0; i < count; i++) {
+            free(lines[i]);
         }
     }
 }
 
 void w_init_queues(){
      /* Init the archives writer queue */
-    writer_queue = queue_init(getDefine_Int("analysisd", "archives_queue_size", 128, 2000000));
+    writer_queue = mpmc_queue_init(getDefine_Int("analysisd", "archives_queue_size", 128, 2000000));
 
     /* Init the alerts log writer queue */
-    writer_queue_log = queue_init(getDefine_Int("analysisd", "alerts_queue_size", 128, 2000000));
+    writer_queue_log = mpmc_queue_init(getDefine_Int("analysisd", "alerts_queue_size", 128, 2000000));
 
     /* Init statistical the log writer queue */
-    writer_queue_log_statistical = queue_init(getDefine_Int("analysisd", "statistical_queue_size", 128, 2000000));
+    writer_queue_log_statistical = mpmc_queue_init(getDefine_Int("analysisd", "statistical_queue_size", 128, 2000000));
 
     /* Init the firewall log writer queue */
-    writer_queue_log_firewall = queue_init(getDefine_Int("analysisd", "firewall_queue_size", 128, 2000000));
+    writer_queue_log_firewall = mpmc_queue_init(getDefine_Int("analysisd", "firewall_queue_size", 128, 2000000));
 
     /* Init the FTS log writer queue */
-    writer_queue_log_fts = queue_init(getDefine_Int("analysisd", "fts_queue_size", 128, 2000000));
+    writer_queue_log_fts = mpmc_queue_init(getDefine_Int("analysisd", "fts_queue_size", 128, 2000000));
 
     /* Init the decode syscheck queue input */
-    decode_queue_syscheck_input = queue_init(getDefine_Int("analysisd", "decode_syscheck_queue_size", 128, 2000000));
+    decode_queue_syscheck_input = mpmc_queue_init(getDefine_Int("analysisd", "decode_syscheck_queue_size", 128, 2000000));
 
     /* Init the decode syscollector queue input */
-    decode_queue_syscollector_input = queue_init(getDefine_Int("analysisd", "decode_syscollector_queue_size", 128, 2000000));
+    decode_queue_syscollector_input = mpmc_queue_init(getDefine_Int("analysisd", "decode_syscollector_queue_size", 128, 2000000));
 
     /* Init the decode rootcheck queue input */
-    decode_queue_rootcheck_input = queue_init(getDefine_Int("analysisd", "decode_rootcheck_queue_size", 128, 2000000));
+    decode_queue_rootcheck_input = mpmc_queue_init(getDefine_Int("analysisd", "decode_rootcheck_queue_size", 128, 2000000));
 
     /* Init the decode SCA queue input */
-    decode_queue_sca_input = queue_init(getDefine_Int("analysisd", "decode_sca_queue_size", 128, 2000000));
+    decode_queue_sca_input = mpmc_queue_init(getDefine_Int("analysisd", "decode_sca_queue_size", 128, 2000000));
 
     /* Init the decode hostinfo queue input */
-    decode_queue_hostinfo_input = queue_init(getDefine_Int("analysisd", "decode_hostinfo_queue_size", 128, 2000000));
+    decode_queue_hostinfo_input = mpmc_queue_init(getDefine_Int("analysisd", "decode_hostinfo_queue_size", 128, 2000000));
 
     /* Init the decode winevt queue input */
-    decode_queue_winevt_input = queue_init(getDefine_Int("analysisd", "decode_winevt_queue_size", 128, 2000000));
+    decode_queue_winevt_input = mpmc_queue_init(getDefine_Int("analysisd", "decode_winevt_queue_size", 128, 2000000));
 
     /* Init the decode event queue input */
-    decode_queue_event_input = queue_init(getDefine_Int("analysisd", "decode_event_queue_size", 128, 2000000));
+    decode_queue_event_input = mpmc_queue_init(getDefine_Int("analysisd", "decode_event_queue_size", 128, 2000000));
 
     /* Init the decode event queue output */
-    decode_queue_event_output = queue_init(getDefine_Int("analysisd", "decode_output_queue_size", 128, 2000000));
+    decode_queue_event_output = mpmc_queue_init(getDefine_Int("analysisd", "decode_output_queue_size", 128, 2000000));
 
     /* Initialize database synchronization message queue */
-    dispatch_dbsync_input = queue_init(getDefine_Int("analysisd", "dbsync_queue_size", 128, 2000000));
+    dispatch_dbsync_input = mpmc_queue_init(getDefine_Int("analysisd", "dbsync_queue_size", 128, 2000000));
 
     /* Initialize upgrade module message queue */
-    upgrade_module_input = queue_init(getDefine_Int("analysisd", "upgrade_queue_size", 128, 2000000));
+    upgrade_module_input = mpmc_queue_init(getDefine_Int("analysisd", "upgrade_queue_size", 128, 2000000));
 }
 
 time_t w_get_current_time(void) {
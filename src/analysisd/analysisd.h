@@ -49,46 +49,46 @@ extern ListNode *os_analysisd_cdblists;
 extern ListRule *os_analysisd_cdbrules;
 
 /* Archives writer queue */
-extern w_queue_t * writer_queue;
+extern w_mpmc_queue_t * writer_queue;
 
 /* Alerts log writer queue */
-extern w_queue_t * writer_queue_log;
+extern w_mpmc_queue_t * writer_queue_log;
 
 /* Statistical log writer queue */
-extern w_queue_t * writer_queue_log_statistical;
+extern w_mpmc_queue_t * writer_queue_log_statistical;
 
 /* Firewall log writer queue */
-extern w_queue_t * writer_queue_log_firewall;
+extern w_mpmc_queue_t * writer_queue_log_firewall;
 
 /* Decode syscheck input queue */
-extern w_queue_t * decode_queue_syscheck_input;
+extern w_mpmc_queue_t * decode_queue_syscheck_input;
 
 /* Decode syscollector input queue */
-extern w_queue_t * decode_queue_syscollector_input;
+extern w_mpmc_queue_t * decode_queue_syscollector_input;
 
 /* Decode rootcheck input queue */
-extern w_queue_t * decode_queue_rootcheck_input;
+extern w_mpmc_queue_t * decode_queue_rootcheck_input;
 
 /* Decode policy monitoring input queue */
-extern w_queue_t * decode_queue_sca_input;
+extern w_mpmc_queue_t * decode_queue_sca_input;
 
 /* Decode hostinfo input queue */
-extern w_queue_t * decode_queue_hostinfo_input;
+extern w_mpmc_queue_t * decode_queue_hostinfo_input;
 
 /* Decode event input queue */
-extern w_queue_t * decode_queue_event_input;
+extern w_mpmc_queue_t * decode_queue_event_input;
 
 /* Decode pending event output */
-extern w_queue_t * decode_queue_event_output;
+extern w_mpmc_queue_t * decode_queue_event_output;
 
 /* Decode windows event input queue */
-extern w_queue_t * decode_queue_winevt_input;
+extern w_mpmc_queue_t * decode_queue_winevt_input;
 
 /* Database synchronization input queue */
-extern w_queue_t * dispatch_dbsync_input;
+extern w_mpmc_queue_t * dispatch_dbsync_input;
 
 /* Upgrade module decoder  */
-extern w_queue_t * upgrade_module_input;
+extern w_mpmc_queue_t * upgrade_module_input;
 
 /**
  * @brief Initialize queues
@@ -20,6 +20,7 @@
 #include "analysisd.h"
 #include "state.h"
 #include "config.h"
+#include "labels.h"
 
 typedef enum _error_codes {
     ERROR_OK = 0,
@@ -33,7 +34,9 @@ typedef enum _error_codes {
     ERROR_INVALID_AGENTS,
     ERROR_EMPTY_AGENTS,
     ERROR_EMPTY_LASTID,
-    ERROR_TOO_MANY_AGENTS
+    ERROR_TOO_MANY_AGENTS,
+    ERROR_INVALID_AGENT,
+    ERROR_INVALID_LABELS
 } error_codes;
 
 const char * error_messages[] = {
@@ -48,7 +51,9 @@ const char * error_messages[] = {
     [ERROR_INVALID_AGENTS] = "Invalid agents parameter",
     [ERROR_EMPTY_AGENTS] = "Error getting agents from DB",
     [ERROR_EMPTY_LASTID] = "Empty last id",
-    [ERROR_TOO_MANY_AGENTS] = "Too many agents"
+    [ERROR_TOO_MANY_AGENTS] = "Too many agents",
+    [ERROR_INVALID_AGENT] = "Invalid agent parameter",
+    [ERROR_INVALID_LABELS] = "Invalid labels parameter"
 };
 
 /**
@@ -97,6 +102,7 @@ STATIC size_t asyscom_dispatch(char* request, char** output) {
     cJSON *config_json = NULL;
     cJSON *agents_json = NULL;
     cJSON *last_id_json = NULL;
+    cJSON *agent_json = NULL;
     const char *json_err;
     int *agents_ids;
     int count;
@@ -163,6 +169,21 @@ STATIC size_t asyscom_dispatch(char* request, char** output) {
             } else {
                 *output = asyscom_output_builder(ERROR_EMPTY_PARAMATERS, error_messages[ERROR_EMPTY_PARAMATERS], NULL);
             }
+        } else if (strcmp(command_json->valuestring, "setlabels") == 0) {
+            if (parameters_json = cJSON_GetObjectItem(request_json, "parameters"), cJSON_IsObject(parameters_json)) {
+                agent_json = cJSON_GetObjectItem(parameters_json, "agent");
+                if (cJSON_IsString(agent_json) && OS_StrIsNum(agent_json->valuestring)) {
+                    if (labels_cache_set(agent_json->valuestring, cJSON_GetObjectItem(parameters_json, "labels")) == OS_SUCCESS) {
+                        *output = asyscom_output_builder(ERROR_OK, error_messages[ERROR_OK], NULL);
+                    } else {
+                        *output = asyscom_output_builder(ERROR_INVALID_LABELS, error_messages[ERROR_INVALID_LABELS], NULL);
+                    }
+                } else {
+                    *output = asyscom_output_builder(ERROR_INVALID_AGENT, error_messages[ERROR_INVALID_AGENT], NULL);
+                }
+            } else {
+                *output = asyscom_output_builder(ERROR_EMPTY_PARAMATERS, error_messages[ERROR_EMPTY_PARAMATERS], NULL);
+            }
         } else {
             *output = asyscom_output_builder(ERROR_UNRECOGNIZED_COMMAND, error_messages[ERROR_UNRECOGNIZED_COMMAND], NULL);
         }
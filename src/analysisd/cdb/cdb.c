@@ -7,6 +7,7 @@
 #include <sys/mman.h>
 #include <unistd.h>
 #include <string.h>
+#include <stdlib.h>
 #include <errno.h>
 #include "cdb.h"
 #include "debug_op.h"
@@ -16,12 +17,78 @@
 #define EPROTO -15  /* cdb 0.75's default for PROTOless systems */
 #endif
 
+/* Bits of the bloom filter per key, rounded up to a power of two words */
+#define CDB_BLOOM_BITS 16
+
 void cdb_free(struct cdb *c)
 {
     if (c->map) {
         munmap(c->map, c->size);
         c->map = 0;
     }
+    if (c->bloom) {
+        free(c->bloom);
+        c->bloom = 0;
+    }
+}
+
+/* Each key sets three bits of a single word, so a check reads one
+ * cache line. The cdb hash is reused to avoid hashing the key twice. */
+static uint64_t bloom_bits(uint32 h, uint32 mask, uint32 *word)
+{
+    uint64_t x = (uint64_t) h * 0x9E3779B97F4A7C15ULL;
+
+    *word = (uint32) (x >> 32) & mask;
+    return (1ULL << (x & 63)) | (1ULL << ((x >> 6) & 63)) | (1ULL << ((x >> 12) & 63));
+}
+
+/* Builds the bloom filter walking the records of the map, which are
+ * stored from the end of the header to the first hash table */
+static void cdb_bloom_build(struct cdb *c)
+{
+    uint32 start = 2048;
+    uint32 end;
+    uint32 pos;
+    uint32 klen;
+    uint32 dlen;
+    uint32 count = 0;
+    uint32 words = 1;
+    uint32 word;
+
+    if (c->size < 2048) {
+        return;
+    }
+
+    uint32_unpack(c->map, &end);
+    if (end < start || end > c->size) {
+        return;
+    }
+
+    for (pos = start; end - pos >= 8; count++) {
+        uint32_unpack(c->map + pos, &klen);
+        uint32_unpack(c->map + pos + 4, &dlen);
+        if (klen > end - pos - 8 || dlen > end - pos - 8 - klen) {
+            return;
+        }
+        pos += 8 + klen + dlen;
+    }
+
+    while (words < count / (64 / CDB_BLOOM_BITS) + 1 && words < 0x80000000) {
+        words <<= 1;
+    }
+
+    if (c->bloom = (uint64_t *) calloc(words, sizeof(uint64_t)), !c->bloom) {
+        return;
+    }
+    c->bloom_mask = words - 1;
+
+    for (pos = start; end - pos >= 8; ) {
+        uint32_unpack(c->map + pos, &klen);
+        uint32_unpack(c->map + pos + 4, &dlen);
+        uint64_t bits = bloom_bits(cdb_hash(c->map + pos + 8, klen), c->bloom_mask, &word);
+        c->bloom[word] |= bits;
+        pos += 8 + klen + dlen;
+    }
 }
 
 void cdb_findstart(struct cdb *c)
@@ -47,6 +114,7 @@ void cdb_init(struct cdb *c, int fd)
             if (x + 1) {
                 c->size = st.st_size;
                 c->map = x;
+                cdb_bloom_build(c);
             }
         }
 }
@@ -59,14 +127,11 @@ int cdb_read(struct cdb *c, char *buf, unsigned int len, uint32 pos)
         }
         memcpy(buf, c->map + pos, len);
     } else {
-        if (lseek(c->fd, pos, SEEK_SET) == -1) {
-            return -1;
-        }
-        /* if (seek_set(c->fd,pos) == -1) return -1; */
+        /* pread doesn't move the offset of the file, so it can be shared */
         while (len > 0) {
-            int r;
+            ssize_t r;
             do {
-                r = read(c->fd, buf, len);
+                r = pread(c->fd, buf, len, pos);
             } while ((r == -1) && (errno == EINTR));
             if (r == -1) {
                 return -1;
@@ -76,6 +141,7 @@ int cdb_read(struct cdb *c, char *buf, unsigned int len, uint32 pos)
             }
             buf += r;
             len -= r;
+            pos += r;
         }
     }
     return 0;
@@ -178,3 +244,67 @@ int cdb_find(struct cdb *c, char *key, unsigned int len)
     cdb_findstart(c);
     return cdb_findnext(c, key, len);
 }
+
+int cdb_lookup(struct cdb *c, char *key, unsigned int len, uint32 *dpos, uint32 *dlen)
+{
+    char buf[8];
+    uint32 khash;
+    uint32 hpos;
+    uint32 hslots;
+    uint32 kpos;
+    uint32 loop;
+    uint32 pos;
+    uint32 u;
+
+    khash = cdb_hash(key, len);
+
+    if (c->bloom) {
+        uint32 word;
+        uint64_t bits = bloom_bits(khash, c->bloom_mask, &word);
+
+        if ((c->bloom[word] & bits) != bits) {
+            return 0;
+        }
+    }
+
+    if (cdb_read(c, buf, 8, (khash << 3) & 2047) == -1) {
+        return -1;
+    }
+    uint32_unpack(buf + 4, &hslots);
+    if (!hslots) {
+        return 0;
+    }
+    uint32_unpack(buf, &hpos);
+    kpos = hpos + (((khash >> 8) % hslots) << 3);
+
+    for (loop = 0; loop < hslots; loop++) {
+        if (cdb_read(c, buf, 8, kpos) == -1) {
+            return -1;
+        }
+        uint32_unpack(buf + 4, &pos);
+        if (!pos) {
+            return 0;
+        }
+        kpos += 8;
+        if (kpos == hpos + (hslots << 3)) {
+            kpos = hpos;
+        }
+        uint32_unpack(buf, &u);
+        if (u == khash) {
+            if (cdb_read(c, buf, 8, pos) == -1) {
+                return -1;
+            }
+            uint32_unpack(buf, &u);
+            if (u == len)
+                switch (match(c, key, len, pos + 8)) {
+                    case -1:
+                        return -1;
+                    case 1:
+                        uint32_unpack(buf + 4, dlen);
+                        *dpos = pos + 8 + len;
+                        return 1;
+                }
+        }
+    }
+    return 0;
+}
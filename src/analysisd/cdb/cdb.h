@@ -5,6 +5,7 @@
 #ifndef CDB_H
 #define CDB_H
 
+#include <stdint.h>
 #include "uint32.h"
 #include <pthread.h>
 #include "pthreads_op.h"
@@ -25,6 +26,8 @@ struct cdb {
     uint32 dpos; /* initialized if cdb_findnext() returns 1 */
     uint32 dlen; /* initialized if cdb_findnext() returns 1 */
     pthread_mutex_t mutex;
+    uint64_t *bloom; /* blocked bloom filter of the keys, 0 if not built */
+    uint32 bloom_mask; /* number of words of the filter minus one */
 } ;
 
 extern void cdb_free(struct cdb *);
@@ -36,6 +39,14 @@ extern void cdb_findstart(struct cdb *);
 extern int cdb_findnext(struct cdb *, char *, unsigned int);
 extern int cdb_find(struct cdb *, char *, unsigned int);
 
+/* Reentrant lookup: the search state is kept by the caller instead of
+ * the shared struct, so it can be called by several threads at once.
+ * Keys that aren't in the bloom filter are answered without reading
+ * the hash tables.
+ * Returns 1 and sets the data position and length if found, 0 if not
+ * found and -1 on error. */
+extern int cdb_lookup(struct cdb *, char *, unsigned int, uint32 *, uint32 *);
+
 #define cdb_datapos(c) ((c)->dpos)
 #define cdb_datalen(c) ((c)->dlen)
 
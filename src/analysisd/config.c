@@ -100,6 +100,9 @@ int GlobalConf(const char *cfgfile)
     }
 
     Config.min_rotate_interval = getDefine_Int("analysisd", "min_rotate_interval", 10, 86400);
+    Config.archives_buffer_size = (size_t)getDefine_Int("analysisd", "archives_buffer_size", 0, 65536) * 1024;
+    Config.archives_index_interval = getDefine_Int("analysisd", "archives_index_interval", 0, 86400);
+    Config.archives_compress = getDefine_Int("analysisd", "archives_compress", 0, 1);
 
     /* Minimum memory size */
     if (Config.memorysize < 2048) {
@@ -271,6 +274,9 @@ cJSON *getAnalysisInternalOptions(void) {
     cJSON_AddNumberToObject(analysisd, "show_hidden_labels", Config.show_hidden_labels);
     cJSON_AddNumberToObject(analysisd, "rlimit_nofile", nofile);
     cJSON_AddNumberToObject(analysisd, "min_rotate_interval", Config.min_rotate_interval);
+    cJSON_AddNumberToObject(analysisd, "archives_buffer_size", Config.archives_buffer_size / 1024);
+    cJSON_AddNumberToObject(analysisd, "archives_index_interval", Config.archives_index_interval);
+    cJSON_AddNumberToObject(analysisd, "archives_compress", Config.archives_compress);
 #ifdef LIBGEOIP_ENABLED
     cJSON_AddNumberToObject(analysisd, "geoip_jsonout", Config.geoip_jsonout);
 #endif
@@ -0,0 +1,278 @@
+/* Copyright (C) 2015, Wazuh Inc.
+ * All right reserved.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation
+ */
+
+/* Index of the previous matches of the frequency rules */
+
+#include "shared.h"
+#include "eventinfo.h"
+#include "correlation.h"
+
+#ifdef WAZUH_UNIT_TESTING
+// Remove STATIC qualifier from tests
+#define STATIC
+#else
+#define STATIC static
+#endif
+
+extern size_t field_offset[];
+
+/* Number of fields in field_offset */
+#define W_CORRELATION_FIELDS 17
+
+/**
+ * @brief Append a field to a key
+ * @return false if the field is missing, so the event can't be correlated.
+ */
+static bool w_correlation_key_add(char * key, size_t * length, const char * field) {
+    int written;
+
+    if (field == NULL) {
+        return false;
+    }
+
+    // A truncated key only merges keys, which can only raise the counts
+    if (*length < W_CORRELATION_KEY_SIZE - 1) {
+        written = snprintf(key + *length, W_CORRELATION_KEY_SIZE - *length, "%s\x1f", field);
+        *length += written > 0 ? (size_t)written : 0;
+
+        if (*length >= W_CORRELATION_KEY_SIZE) {
+            *length = W_CORRELATION_KEY_SIZE - 1;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Build the key of an event from the same_* options of a rule
+ *
+ * It takes the same fields that Search_LastSids() and Search_LastGroups()
+ * require to be equal in both events.
+ *
+ * @param rule Frequency rule.
+ * @param lf Event.
+ * @param key Buffer of W_CORRELATION_KEY_SIZE bytes.
+ * @return false if the event lacks a field, so it can't match the rule.
+ */
+STATIC bool w_correlation_key(const RuleInfo * rule, const Eventinfo * lf, char * key) {
+    size_t length = 0;
+    u_int32_t same;
+    int i;
+
+    *key = '\0';
+
+    if (!(rule->context_opts & FIELD_GFREQUENCY) && !w_correlation_key_add(key, &length, lf->agent_id)) {
+        return false;
+    }
+
+    if ((rule->same_field & FIELD_ID) && !w_correlation_key_add(key, &length, lf->id)) {
+        return false;
+    }
+
+    if ((rule->same_field & FIELD_SRCIP) && !w_correlation_key_add(key, &length, lf->srcip)) {
+        return false;
+    }
+
+    if (rule->same_field & FIELD_DYNAMICS) {
+        if (lf->nfields == 0) {
+            return false;
+        }
+
+        for (i = 0; rule->same_fields && rule->same_fields[i]; i++) {
+            if (!w_correlation_key_add(key, &length, FindField(lf, rule->same_fields[i]))) {
+                return false;
+            }
+        }
+    }
+
+    // Same fields as same_loop()
+    if (rule->alert_opts & SAME_EXTRAINFO) {
+        same = rule->same_field >> 2;
+
+        for (i = 2; same != 0 && i < W_CORRELATION_FIELDS; i++, same >>= 1) {
+            if ((same & 1) && !w_correlation_key_add(key, &length, *(char **)((char *)lf + field_offset[i]))) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/* Remove the keys whose events are all out of any future window */
+static void w_correlation_sweep(w_correlation_t * correlation, time_t slot) {
+    OSHashNode * node;
+    OSHashNode * next;
+    unsigned int i;
+
+    for (i = 0; i < correlation->keys->rows; i++) {
+        for (node = correlation->keys->table[i]; node != NULL; node = next) {
+            next = node->next;
+
+            if (((w_correlation_entry_t *)node->data)->newest <= slot - W_CORRELATION_BUCKETS) {
+                free(OSHash_Delete(correlation->keys, node->key));
+            }
+        }
+    }
+}
+
+/* Count an event in the index of a rule that searches it */
+static void w_correlation_add(RuleInfo * searcher, const Eventinfo * lf) {
+    w_correlation_t * correlation = searcher->correlation;
+    w_correlation_entry_t * entry;
+    w_correlation_bucket_t * bucket;
+    char key[W_CORRELATION_KEY_SIZE];
+    time_t slot;
+
+    if (correlation == NULL || !w_correlation_key(searcher, lf, key)) {
+        return;
+    }
+
+    slot = lf->generate_time / correlation->width;
+
+    w_mutex_lock(&correlation->mutex);
+
+    if (entry = OSHash_Get(correlation->keys, key), entry == NULL) {
+        os_calloc(1, sizeof(w_correlation_entry_t), entry);
+        entry->newest = slot;
+
+        if (OSHash_Add(correlation->keys, key, entry) != 2) {
+            os_free(entry);
+            w_mutex_unlock(&correlation->mutex);
+            return;
+        }
+    }
+
+    bucket = &entry->buckets[slot % W_CORRELATION_BUCKETS];
+
+    // Older events go to the newer slice that took their bucket: the count can only grow
+    if (bucket->slot < slot) {
+        bucket->slot = slot;
+        bucket->count = 0;
+    }
+
+    bucket->count++;
+
+    if (slot > entry->newest) {
+        entry->newest = slot;
+    }
+
+    if (slot > correlation->newest) {
+        correlation->newest = slot;
+    }
+
+    if (++correlation->added >= W_CORRELATION_SWEEP) {
+        correlation->added = 0;
+        w_correlation_sweep(correlation, slot);
+    }
+
+    w_mutex_unlock(&correlation->mutex);
+}
+
+w_correlation_t * w_correlation_init(int timeframe) {
+    w_correlation_t * correlation;
+
+    os_calloc(1, sizeof(w_correlation_t), correlation);
+
+    if (correlation->keys = OSHash_Create(), correlation->keys == NULL) {
+        merror_exit(HASH_ERROR);
+    }
+
+    /* The window spans two buckets less than the ring, so a clock that lags
+     * one bucket behind the events never reads a bucket that was reused. */
+    correlation->timeframe = timeframe;
+    correlation->width = (timeframe + W_CORRELATION_BUCKETS - 3) / (W_CORRELATION_BUCKETS - 2);
+
+    if (correlation->width < 1) {
+        correlation->width = 1;
+    }
+
+    w_mutex_init(&correlation->mutex, NULL);
+
+    return correlation;
+}
+
+void w_correlation_free(w_correlation_t * correlation) {
+    if (correlation == NULL) {
+        return;
+    }
+
+    OSHash_SetFreeDataPointer(correlation->keys, free);
+    OSHash_Free(correlation->keys);
+    w_mutex_destroy(&correlation->mutex);
+    os_free(correlation);
+}
+
+void w_correlation_add_sid_searcher(RuleInfo * rule, RuleInfo * searcher) {
+    unsigned int count = 0;
+
+    if (rule->sid_searchers) {
+        while (rule->sid_searchers[count]) {
+            count++;
+        }
+    }
+
+    os_realloc(rule->sid_searchers, (count + 2) * sizeof(RuleInfo *), rule->sid_searchers);
+    rule->sid_searchers[count] = searcher;
+    rule->sid_searchers[count + 1] = NULL;
+}
+
+void w_correlation_add_event(RuleInfo * rule, Eventinfo * lf) {
+    unsigned int i;
+
+    // Same lists as the ones the event is added to
+    if (rule->sid_prev_matched) {
+        for (i = 0; rule->sid_searchers && rule->sid_searchers[i]; i++) {
+            w_correlation_add(rule->sid_searchers[i], lf);
+        }
+    } else if (rule->group_prev_matched) {
+        for (i = 0; rule->group_searchers && i < rule->group_prev_matched_sz; i++) {
+            if (rule->group_searchers[i]) {
+                w_correlation_add(rule->group_searchers[i], lf);
+            }
+        }
+    }
+}
+
+int w_correlation_count(RuleInfo * rule, const Eventinfo * lf, time_t now) {
+    w_correlation_t * correlation = rule->correlation;
+    w_correlation_entry_t * entry;
+    char key[W_CORRELATION_KEY_SIZE];
+    time_t first;
+    int count = 0;
+    int i;
+
+    if (correlation == NULL || correlation->timeframe != rule->timeframe) {
+        return -1;
+    }
+
+    if (!w_correlation_key(rule, lf, key)) {
+        return 0;
+    }
+
+    // First bucket that overlaps the timeframe
+    first = (now - rule->timeframe) / correlation->width;
+
+    w_mutex_lock(&correlation->mutex);
+
+    if (now / correlation->width < correlation->newest - 1) {
+        // The clock went back: the old buckets may have been reused or swept
+        count = -1;
+    } else if (entry = OSHash_Get(correlation->keys, key), entry != NULL) {
+        for (i = 0; i < W_CORRELATION_BUCKETS; i++) {
+            if (entry->buckets[i].count > 0 && entry->buckets[i].slot >= first) {
+                count += entry->buckets[i].count;
+            }
+        }
+    }
+
+    w_mutex_unlock(&correlation->mutex);
+
+    return count;
+}
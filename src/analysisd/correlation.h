@@ -0,0 +1,94 @@
+/* Copyright (C) 2015, Wazuh Inc.
+ * All right reserved.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation
+ */
+
+#ifndef CORRELATION_H
+#define CORRELATION_H
+
+#include "shared.h"
+
+#define W_CORRELATION_BUCKETS   16      // Buckets of the time window of a key
+#define W_CORRELATION_SWEEP     1024    // Events added between two sweeps of the expired keys
+#define W_CORRELATION_KEY_SIZE  OS_SIZE_2048
+
+struct _RuleInfo;
+struct _Eventinfo;
+
+/* Events of a key in a slice of time */
+typedef struct w_correlation_bucket_t {
+    time_t slot;                    // Start of the slice, in bucket widths
+    unsigned int count;
+} w_correlation_bucket_t;
+
+/* Time window of the events that share the same_* fields */
+typedef struct w_correlation_entry_t {
+    w_correlation_bucket_t buckets[W_CORRELATION_BUCKETS];
+    time_t newest;                  // Newest slot with events
+} w_correlation_entry_t;
+
+/**
+ * Previous matches of a frequency rule (if_matched_sid or if_matched_group),
+ * counted by the values of its same_* fields in time buckets.
+ *
+ * The counts are an upper bound of the events that the list search can match:
+ * the different_* options and the events removed from the list are not taken
+ * into account. So the index can only tell that a rule will not match.
+ */
+typedef struct w_correlation_t {
+    OSHash * keys;                  // Key of the same_* fields -> w_correlation_entry_t
+    int timeframe;                  // Timeframe of the rule when the index was created
+    time_t width;                   // Seconds of a bucket
+    time_t newest;                  // Newest slot with events, of any key
+    unsigned int added;             // Events added since the last sweep
+    pthread_mutex_t mutex;
+} w_correlation_t;
+
+/**
+ * @brief Create the correlation index of a rule
+ *
+ * @param timeframe Timeframe of the rule, in seconds.
+ * @return Index of the rule.
+ */
+w_correlation_t * w_correlation_init(int timeframe);
+
+/**
+ * @brief Free the correlation index of a rule
+ *
+ * @param correlation Index to free. NULL is allowed.
+ */
+void w_correlation_free(w_correlation_t * correlation);
+
+/**
+ * @brief Register a rule that searches the previous matches of another one
+ *
+ * @param rule Rule whose matches are searched (if_matched_sid).
+ * @param searcher Rule that searches them.
+ */
+void w_correlation_add_sid_searcher(struct _RuleInfo * rule, struct _RuleInfo * searcher);
+
+/**
+ * @brief Count an event that matched a rule in the indexes of the rules that search it
+ *
+ * It must be called after adding the event to the previous matches lists of the rule.
+ *
+ * @param rule Rule matched by the event.
+ * @param lf Event.
+ */
+void w_correlation_add_event(struct _RuleInfo * rule, struct _Eventinfo * lf);
+
+/**
+ * @brief Count the previous matches in the timeframe with the same_* fields of an event
+ *
+ * @param rule Frequency rule.
+ * @param lf Event being evaluated.
+ * @param now Current time, as used by the search.
+ * @return Upper bound of the matches, or -1 if the index can't tell.
+ */
+int w_correlation_count(struct _RuleInfo * rule, const struct _Eventinfo * lf, time_t now);
+
+#endif /* CORRELATION_H */
@@ -15,6 +15,8 @@
 
 #include "../eventinfo.h"
 #include "wazuhdb_op.h"
+#include "wazuh_db/wdb.h"
+#include "../wdb_async.h"
 
 #ifdef WAZUH_UNIT_TESTING
 /* Remove static qualifier when unit testing */
@@ -28,6 +30,33 @@ extern void mock_assert(const int result, const char* const expression,
     mock_assert((int)(expression), #expression, __FILE__, __LINE__);
 #endif
 
+/* Syscollector components whose state is saved through frame operations */
+static const struct {
+    const char * name;
+    wdb_component_t component;
+} dbsync_frame_components[] = {
+    { "syscollector_processes", WDB_SYSCOLLECTOR_PROCESSES },
+    { "syscollector_packages", WDB_SYSCOLLECTOR_PACKAGES },
+    { "syscollector_hotfixes", WDB_SYSCOLLECTOR_HOTFIXES },
+    { "syscollector_ports", WDB_SYSCOLLECTOR_PORTS },
+    { "syscollector_network_protocol", WDB_SYSCOLLECTOR_NETPROTO },
+    { "syscollector_network_address", WDB_SYSCOLLECTOR_NETADDRESS },
+    { "syscollector_network_iface", WDB_SYSCOLLECTOR_NETINFO },
+    { "syscollector_hwinfo", WDB_SYSCOLLECTOR_HWINFO },
+    { "syscollector_osinfo", WDB_SYSCOLLECTOR_OSINFO },
+};
+
+/* Argument of a Syscollector save frame operation, or -1 if the component has no binary form */
+static int dispatch_frame_component(const char * component) {
+    for (size_t i = 0; i < sizeof(dbsync_frame_components) / sizeof(dbsync_frame_components[0]); i++) {
+        if (strcmp(component, dbsync_frame_components[i].name) == 0) {
+            return dbsync_frame_components[i].component;
+        }
+    }
+
+    return -1;
+}
+
 static void dispatch_send_local(dbsync_context_t * ctx, const char * query) {
     int sock;
 
@@ -128,7 +157,8 @@ static void dispatch_check(dbsync_context_t * ctx, const char * command) {
         goto end;
     }
 
-    switch (wdbc_query_ex(&ctx->db_sock, query, response, OS_MAXSTR)) {
+    // Sent after the pending writes of the agent, so it sees them
+    switch (wdb_async_query_ex(&ctx->db_sock, ctx->agent_id, query, response, OS_MAXSTR)) {
     case -2:
         merror("dbsync: Cannot communicate with database.");
         goto end;
@@ -166,6 +196,7 @@ static void dispatch_state(dbsync_context_t * ctx) {
     }
 
     char * data_plain = cJSON_PrintUnformatted(ctx->data);
+    const int component = dispatch_frame_component(ctx->component);
     char * query;
     char * response;
     char * arg;
@@ -173,11 +204,20 @@ static void dispatch_state(dbsync_context_t * ctx) {
     os_malloc(OS_MAXSTR, query);
     os_malloc(OS_MAXSTR, response);
 
+    // The asynchronous client merges the consecutive saves of a resync into batches
+    if (component >= 0 && wdb_async_frame_op(WDB_FRAME_SYSCOLLECTOR_SAVE, ctx->agent_id, component, NULL, data_plain) == 0) {
+        goto end;
+    }
+
     if (snprintf(query, OS_MAXSTR, "agent %s %s save2 %s", ctx->agent_id, ctx->component, data_plain) >= OS_MAXSTR) {
         merror("dbsync: Cannot build save query: input is too long.");
         goto end;
     }
 
+    if (wdb_async_query(ctx->agent_id, query) == 0) {
+        goto end;
+    }
+
     switch (wdbc_query_ex(&ctx->db_sock, query, response, OS_MAXSTR)) {
     case -2:
         merror("dbsync: Cannot communicate with database.");
@@ -224,6 +264,10 @@ static void dispatch_clear(dbsync_context_t * ctx) {
         goto end;
     }
 
+    if (wdb_async_query(ctx->agent_id, query) == 0) {
+        goto end;
+    }
+
     switch (wdbc_query_ex(&ctx->db_sock, query, response, OS_MAXSTR)) {
     case -2:
         merror("dbsync: Cannot communicate with database.");
@@ -146,7 +146,18 @@ int ReadDecodeXML(const char *file, OSDecoderNode **decoderlist_pn,
                   OSDecoderNode **decoderlist_nopn, OSStore **decoder_list,
                   OSList* log_msg)
 {
-    OS_XML xml;
+    OS_XML_FILE xml_file = { .file = file };
+
+    OS_ReadXMLFile(&xml_file);
+    return ReadDecodeParsedXML(&xml_file, decoderlist_pn, decoderlist_nopn, decoder_list, log_msg);
+}
+
+int ReadDecodeParsedXML(OS_XML_FILE *xml_file, OSDecoderNode **decoderlist_pn,
+                        OSDecoderNode **decoderlist_nopn, OSStore **decoder_list,
+                        OSList* log_msg)
+{
+    const char *file = xml_file->file;
+    OS_XML *xml = &xml_file->xml;
     XML_NODE node = NULL;
     int retval = 0; // 0 means error
 
@@ -184,14 +195,14 @@ int ReadDecodeXML(const char *file, OSDecoderNode **decoderlist_pn,
     XML_NODE elements = NULL;
     OSDecoderInfo *pi = NULL;
 
-    /* Read the XML */
-    switch(OS_ReadXML(file, &xml)) {
+    /* Check the result of reading the XML */
+    switch(xml_file->result) {
         case -2:
-            smwarn(log_msg, FOPEN_ERROR, file, errno, strerror(errno));
+            smwarn(log_msg, FOPEN_ERROR, file, xml_file->error, strerror(xml_file->error));
             retval = 1;
             goto cleanup;
         case -1:
-            smerror(log_msg, XML_ERROR, file, xml.err, xml.err_line);
+            smerror(log_msg, XML_ERROR, file, xml->err, xml->err_line);
             goto cleanup;
         case 0:
         default:
@@ -199,8 +210,8 @@ int ReadDecodeXML(const char *file, OSDecoderNode **decoderlist_pn,
     }
 
     /* Apply any variables found */
-    if (OS_ApplyVariables(&xml) != 0) {
-        smerror(log_msg, XML_ERROR_VAR, file, xml.err);
+    if (OS_ApplyVariables(xml) != 0) {
+        smerror(log_msg, XML_ERROR_VAR, file, xml->err);
         goto cleanup;
     }
 
@@ -212,7 +223,7 @@ int ReadDecodeXML(const char *file, OSDecoderNode **decoderlist_pn,
     }
 
     /* Get the root elements */
-    node = OS_GetElementsbyNode(&xml, NULL);
+    node = OS_GetElementsbyNode(xml, NULL);
     if (!node) {
         if (strcmp(file, XML_LDECODER) != 0) {
             smerror(log_msg, XML_ELEMNULL);
@@ -270,7 +281,7 @@ int ReadDecodeXML(const char *file, OSDecoderNode **decoderlist_pn,
         }
 
         /* Get decoder options */
-        elements = OS_GetElementsbyNode(&xml, node[i]);
+        elements = OS_GetElementsbyNode(xml, node[i]);
         if (elements == NULL) {
             smerror(log_msg, XML_ELEMNULL);
             goto cleanup;
@@ -839,7 +850,7 @@ cleanup:
     /* Clean node and XML structures */
     OS_ClearNode(elements);
     OS_ClearNode(node);
-    OS_ClearXML(&xml);
+    OS_ClearXML(xml);
 
     FreeDecoderInfo(pi);
 
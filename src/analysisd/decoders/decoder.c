@@ -455,7 +455,7 @@ void *DynamicField_FP(Eventinfo *lf, char *field, const char *order)
     }
 #endif
 
-    os_strdup(order, lf->fields[lf->nfields].key);
+    lf->fields[lf->nfields].key = event_arena_strdup(&lf->arena, order);
     lf->fields[lf->nfields++].value = field;
     return (NULL);
 }
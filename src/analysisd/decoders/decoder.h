@@ -228,6 +228,19 @@ int ReadDecodeXML(const char *file, OSDecoderNode **decoderlist_pn,
                   OSDecoderNode **decoderlist_nopn, OSStore **decoder_list,
                   OSList* log_msg);
 
+/**
+ * @brief Save the decoders of an already parsed file in the decoder list
+ * @param xml_file file parsed with OS_ReadXMLFile() or OS_ReadXMLFiles(). Its XML is cleared
+ * @param decoderlist_pn list of decoders which have program_name
+ * @param decoderlist_nopn list of decoders which haven't program_name
+ * @param decoder_store list to save all decoders (internals and xml decoders)
+ * @param log_msg list to save log messages
+ * @return 0 on error, as ReadDecodeXML()
+ */
+int ReadDecodeParsedXML(OS_XML_FILE *xml_file, OSDecoderNode **decoderlist_pn,
+                        OSDecoderNode **decoderlist_nopn, OSStore **decoder_list,
+                        OSList* log_msg);
+
 /**
  * @brief Remove decoder information
  * @param pi OSDecoderInfo struct to remove
@@ -193,8 +193,8 @@ void fillData(Eventinfo *lf, const char *key, const char *value)
     }
 #endif
 
-    os_strdup(key, lf->fields[lf->nfields].key);
-    os_strdup(value, lf->fields[lf->nfields].value);
+    lf->fields[lf->nfields].key = event_arena_strdup(&lf->arena, key);
+    lf->fields[lf->nfields].value = event_arena_strdup(&lf->arena, value);
     lf->nfields++;
 
 }
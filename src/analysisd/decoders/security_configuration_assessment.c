@@ -29,10 +29,13 @@ static int FindScanInfo(Eventinfo *lf, char *policy_id, int *socket, char *wdb_r
 static int FindPolicyInfo(Eventinfo *lf, char *policy, int *socket);
 static int FindPolicySHA256(Eventinfo *lf, char *policy, int *socket, char *wdb_response);
 static int FindCheckResults(Eventinfo *lf, char *policy_id, int *socket, char *wdb_response);
+static int FindCheckResultsRange(Eventinfo *lf, char *policy_id, int first, int last, int *socket, char *wdb_response);
+static char *FindDivergentRanges(Eventinfo *lf, char *policy_id, cJSON *ranges, int *socket);
 static int FindPoliciesIds(Eventinfo *lf, int *socket, char *wdb_response);
 static int DeletePolicy(Eventinfo *lf, char *policy, int *socket);
 static int DeletePolicyCheck(Eventinfo *lf, char *policy, int *socket);
 static int DeletePolicyCheckDistinct(Eventinfo *lf, char *policy_id,int scan_id, int *socket);
+static int DeletePolicyCheckDistinctRange(Eventinfo *lf, char *policy_id, int scan_id, int first, int last, int *socket);
 static int SaveEventcheck(Eventinfo *lf, int exists, int *socket, int id , int scan_id, char * result,
         char *reason, cJSON *event);
 static int SaveScanInfo(Eventinfo *lf,int *socket, char * policy_id,int scan_id, int pm_start_scan, int pm_end_scan,
@@ -57,7 +60,7 @@ static void FillCheckEventInfo(Eventinfo *lf, cJSON *scan_id, cJSON *id, cJSON *
         cJSON *command);
 static void FillScanInfo(Eventinfo *lf, cJSON *scan_id, cJSON *name, cJSON *description, cJSON *pass, cJSON *failed,
         cJSON *invalid, cJSON *total_checks, cJSON *score, cJSON *file, cJSON *policy_id);
-static void PushDumpRequest(char *agent_id, char *policy_id, int first_scan);
+static void PushDumpRequest(char *agent_id, char *policy_id, int first_scan, const char *ranges);
 static void *RequestDBThread();
 static int ConnectToSecurityConfigurationAssessmentSocket();
 static int ConnectToSecurityConfigurationAssessmentSocketRemoted();
@@ -374,6 +377,95 @@ static int FindCheckResults(Eventinfo *lf, char * policy_id, int *socket,char *w
 
 }
 
+static int FindCheckResultsRange(Eventinfo *lf, char *policy_id, int first, int last, int *socket, char *wdb_response) {
+    assert(lf);
+    assert(wdb_response);
+
+    char *msg = NULL;
+    char *response = NULL;
+    int retval = -1;
+
+    os_calloc(OS_MAXSTR, sizeof(char), msg);
+    os_calloc(OS_MAXSTR, sizeof(char), response);
+
+    snprintf(msg, OS_MAXSTR - 1, "agent %s sca query_results_range %s|%d|%d", lf->agent_id, policy_id, first, last);
+
+    if (!wdbc_query_ex(socket, msg, response, OS_MAXSTR))
+    {
+        if (!strncmp(response, "ok found", 8))
+        {
+            snprintf(wdb_response, OS_MAXSTR, "%s", response + 9);
+            retval = 0;
+        }
+        else if (!strcmp(response, "ok not found"))
+        {
+            retval = 1;
+        }
+    }
+
+    free(msg);
+    free(response);
+    return retval;
+}
+
+/* Compare the hash of each range of checks in the summary with the DB.
+ * Returns the divergent ranges as "first-last,first-last", or NULL to dump the whole policy. */
+static char *FindDivergentRanges(Eventinfo *lf, char *policy_id, cJSON *ranges, int *socket) {
+    char *divergent = NULL;
+    char *wdb_response = NULL;
+    cJSON *range;
+
+    if (!cJSON_IsArray(ranges)) {
+        return NULL;
+    }
+
+    os_calloc(OS_MAXSTR, sizeof(char), wdb_response);
+
+    cJSON_ArrayForEach(range, ranges) {
+        cJSON *first = cJSON_GetObjectItem(range, "first");
+        cJSON *last = cJSON_GetObjectItem(range, "last");
+        cJSON *hash = cJSON_GetObjectItem(range, "hash");
+        char buffer[OS_SIZE_64];
+
+        if (!cJSON_IsNumber(first) || !cJSON_IsNumber(last) || !cJSON_IsString(hash)) {
+            mdebug1("Malformed range of checks in the summary for policy '%s'.", policy_id);
+            goto full_dump;
+        }
+
+        switch (FindCheckResultsRange(lf, policy_id, first->valueint, last->valueint, socket, wdb_response)) {
+        case 0:
+            if (!strcmp(wdb_response, hash->valuestring)) {
+                continue;
+            }
+            break;
+        case 1:
+            break;
+        default:
+            goto full_dump;
+        }
+
+        snprintf(buffer, sizeof(buffer), "%d-%d", first->valueint, last->valueint);
+        wm_strcat(&divergent, buffer, ',');
+
+        if (strlen(divergent) > OS_SIZE_2048) {
+            goto full_dump;
+        }
+    }
+
+    os_free(wdb_response);
+
+    if (divergent) {
+        mdebug1("Divergent ranges of checks for policy '%s': %s", policy_id, divergent);
+    }
+
+    return divergent;
+
+full_dump:
+    os_free(wdb_response);
+    os_free(divergent);
+    return NULL;
+}
+
 static int FindPoliciesIds(Eventinfo *lf, int *socket,char *wdb_response) {
     assert(lf);
     assert(wdb_response);
@@ -902,6 +994,38 @@ static void HandleCheckEvent(Eventinfo *lf,int *socket,cJSON *event) {
     }
 }
 
+static int DeletePolicyCheckDistinctRange(Eventinfo *lf, char *policy_id, int scan_id, int first, int last, int *socket) {
+    assert(lf);
+    assert(policy_id);
+
+    char *msg = NULL;
+    char *response = NULL;
+    int retval = -1;
+
+    os_calloc(OS_MAXSTR, sizeof(char), msg);
+    os_calloc(OS_MAXSTR, sizeof(char), response);
+
+    mdebug1("Deleting check distinct policy id '%s', agent id '%s', checks %d-%d", policy_id, lf->agent_id, first, last);
+
+    snprintf(msg, OS_MAXSTR - 1, "agent %s sca delete_check_distinct %s|%d|%d|%d", lf->agent_id, policy_id, scan_id, first, last);
+
+    if (!wdbc_query_ex(socket, msg, response, OS_MAXSTR))
+    {
+        if (!strncmp(response, "ok", 2))
+        {
+            retval = 0;
+        }
+        else if (!strncmp(response, "err",3))
+        {
+            retval = 1;
+        }
+    }
+
+    free(msg);
+    free(response);
+    return retval;
+}
+
 static void HandleScanInfo(Eventinfo *lf,int *socket,cJSON *event) {
 
     int alert_data_fill = 0;
@@ -1100,7 +1224,7 @@ static void HandleScanInfo(Eventinfo *lf,int *socket,cJSON *event) {
                         alert_data_fill = 1;
                     } else {
                         /* Request dump */
-                        PushDumpRequest(lf->agent_id,policy_id->valuestring,1);
+                        PushDumpRequest(lf->agent_id,policy_id->valuestring,1,NULL);
                     }
                 }
 
@@ -1156,7 +1280,7 @@ static void HandleScanInfo(Eventinfo *lf,int *socket,cJSON *event) {
                         case 0:
                             /* Delete checks */
                             DeletePolicyCheck(lf, policy_id->valuestring, socket);
-                            PushDumpRequest(lf->agent_id, policy_id->valuestring, 1);
+                            PushDumpRequest(lf->agent_id, policy_id->valuestring, 1, NULL);
                             minfo("Policy '%s' information for agent '%s' is outdated. Requested latest scan results.", policy_id->valuestring, lf->agent_id);
                             break;
                         default:
@@ -1182,11 +1306,17 @@ static void HandleScanInfo(Eventinfo *lf,int *socket,cJSON *event) {
             if(strcmp(wdb_response,hash->valuestring)) {
                 mdebug1("Scan result integrity failed for policy '%s'. Hash from DB: '%s', hash from summary: '%s'. Requesting DB dump.",
                         policy_id->valuestring, wdb_response, hash->valuestring);
+
+                /* Only the ranges of checks that differ, if the agent sent their hashes */
+                char *ranges = FindDivergentRanges(lf, policy_id->valuestring, cJSON_GetObjectItem(event, "ranges"), socket);
+
                 if (!first_scan) {
-                    PushDumpRequest(lf->agent_id,policy_id->valuestring,0);
+                    PushDumpRequest(lf->agent_id,policy_id->valuestring,0,ranges);
                 } else {
-                    PushDumpRequest(lf->agent_id,policy_id->valuestring,1);
+                    PushDumpRequest(lf->agent_id,policy_id->valuestring,1,ranges);
                 }
+
+                os_free(ranges);
             }
 
             break;
@@ -1196,9 +1326,9 @@ static void HandleScanInfo(Eventinfo *lf,int *socket,cJSON *event) {
             mdebug1("Check results DB empty for policy '%s'. Requesting DB dump.",
                     policy_id->valuestring);
             if (!first_scan) {
-                PushDumpRequest(lf->agent_id,policy_id->valuestring,0);
+                PushDumpRequest(lf->agent_id,policy_id->valuestring,0,NULL);
             } else {
-                PushDumpRequest(lf->agent_id,policy_id->valuestring,1);
+                PushDumpRequest(lf->agent_id,policy_id->valuestring,1,NULL);
             }
 
             break;
@@ -1222,7 +1352,29 @@ static void HandleDumpEvent(Eventinfo *lf,int *socket,cJSON *event) {
 
     if(!CheckDumpJSON(event,&elements_sent,&policy_id,&scan_id)) {
 
-        int result_db = DeletePolicyCheckDistinct(lf, policy_id->valuestring,scan_id->valueint,socket);
+        cJSON *ranges = cJSON_GetObjectItem(event, "ranges");
+        int result_db = 0;
+
+        if (cJSON_IsString(ranges)) {
+            /* Partial dump: only the checks in the dumped ranges are stale */
+            char *ranges_copy = NULL;
+            char *range = NULL;
+            char *save_ptr = NULL;
+            int first;
+            int last;
+
+            os_strdup(ranges->valuestring, ranges_copy);
+
+            for (range = strtok_r(ranges_copy, ",", &save_ptr); range && result_db != -1; range = strtok_r(NULL, ",", &save_ptr)) {
+                if (sscanf(range, "%d-%d", &first, &last) == 2) {
+                    result_db = DeletePolicyCheckDistinctRange(lf, policy_id->valuestring, scan_id->valueint, first, last, socket);
+                }
+            }
+
+            os_free(ranges_copy);
+        } else {
+            result_db = DeletePolicyCheckDistinct(lf, policy_id->valuestring,scan_id->valueint,socket);
+        }
 
         switch (result_db)
         {
@@ -1255,7 +1407,7 @@ static void HandleDumpEvent(Eventinfo *lf,int *socket,cJSON *event) {
                 if(strcmp(wdb_response, hash_sha256)) {
                     mdebug1("Scan result integrity failed for policy '%s'. Hash from DB: '%s' hash from summary: '%s'. Requesting DB dump.",
                         policy_id->valuestring, wdb_response, hash_sha256);
-                    PushDumpRequest(lf->agent_id,policy_id->valuestring,0);
+                    PushDumpRequest(lf->agent_id,policy_id->valuestring,0,NULL);
                 }
             }
             os_free(hash_scan_info);
@@ -1799,7 +1951,7 @@ static void FillScanInfo(Eventinfo *lf,cJSON *scan_id,cJSON *name,cJSON *descrip
     }
 }
 
-static void PushDumpRequest(char * agent_id, char * policy_id, int first_scan) {
+static void PushDumpRequest(char * agent_id, char * policy_id, int first_scan, const char * ranges) {
     assert(agent_id);
     assert(policy_id);
 
@@ -1808,7 +1960,11 @@ static void PushDumpRequest(char * agent_id, char * policy_id, int first_scan) {
 
     mdebug1("Requesting dump for policy: %s", policy_id);
 
-    snprintf(request_db,OS_SIZE_4096,"%s:sca-dump:%s:%d",agent_id,policy_id,first_scan);
+    if (ranges) {
+        snprintf(request_db,OS_SIZE_4096,"%s:sca-dump:%s:%d:%s",agent_id,policy_id,first_scan,ranges);
+    } else {
+        snprintf(request_db,OS_SIZE_4096,"%s:sca-dump:%s:%d",agent_id,policy_id,first_scan);
+    }
     char *msg = NULL;
 
     os_strdup(request_db,msg);
@@ -19,6 +19,13 @@
 #include "wazuh_modules/wmodules.h"
 #include "os_net/os_net.h"
 #include "wazuhdb_op.h"
+#include "../wdb_async.h"
+
+// Start of the batches of events, the agents print the type first
+#define FIM_BATCH_PREFIX "{\"type\":\"event_batch\""
+
+// Size of the FIM entries stored in a single query, leaving room for the command
+#define FIM_DB_BATCH_MAX_SIZE (OS_MAXSTR - OS_SIZE_1024)
 
 #ifdef WAZUH_UNIT_TESTING
 /* Remove static qualifier when testing */
@@ -88,6 +95,21 @@ void fim_send_db_delete(_sdb * sdb, const char * agent_id, const char * path);
 // Send a query to Wazuh DB
 void fim_send_db_query(int * sock, const char * query);
 
+// Add an entry to the batch of FIM entries, if it's enabled
+static int fim_db_batch_add(_sdb * sdb, const char * agent_id, const char * entry);
+
+// Start storing the FIM entries in batches
+void fim_db_batch_start(_sdb * sdb);
+
+// Store the batch of FIM entries
+void fim_db_batch_flush(_sdb * sdb);
+
+// Store the batch of FIM entries and stop batching them
+void fim_db_batch_end(_sdb * sdb);
+
+// Expand a batch of events into the messages of its events, NULL if the message is not a batch
+char ** fim_expand_batch(const char * msg);
+
 // Build change comment
 static size_t fim_generate_comment(char * str, long size, const char * format, const char * a1, const char * a2);
 
@@ -165,6 +187,9 @@ int fim_init(void) {
 void sdb_init(_sdb *localsdb, OSDecoderInfo *fim_decoder) {
     localsdb->db_err = 0;
     localsdb->socket = -1;
+    localsdb->db_batch = NULL;
+    localsdb->db_batch_size = 0;
+    localsdb->db_batch_agent = NULL;
 
     sdb_clean(localsdb);
 
@@ -1215,6 +1240,23 @@ int decode_fim_event(_sdb *sdb, Eventinfo *lf) {
      *     timestamp:           number
      *   }
      * }
+     *
+     * The batches of events of a directory are expanded by fim_expand_batch() before being decoded:
+     * {
+     *   type:                  "event_batch"
+     *   data: {
+     *     dir:                 string
+     *     mode:                "scheduled"
+     *     version:             number
+     *     tags:                string
+     *     events: [
+     *       {
+     *         name:            string
+     *         (the rest of the data of the event, with only the changed attributes in old_attributes)
+     *       }
+     *     ]
+     *   }
+     * }
      */
 
     cJSON *root_json = NULL;
@@ -1407,7 +1449,15 @@ void fim_send_db_save(_sdb * sdb, const char * agent_id, cJSON * data) {
     cJSON_DeleteItemFromObject(data, "audit");
 
     char * data_plain = cJSON_PrintUnformatted(data);
-    char * query;
+    char * query = NULL;
+
+    if (fim_db_batch_add(sdb, agent_id, data_plain) == 0) {
+        goto end;
+    }
+
+    if (wdb_async_frame_op(WDB_FRAME_FIM_SAVE, agent_id, 0, NULL, data_plain) == 0) {
+        goto end;
+    }
 
     os_malloc(OS_MAXSTR, query);
 
@@ -1426,14 +1476,201 @@ end:
 void fim_send_db_delete(_sdb * sdb, const char * agent_id, const char * path) {
     char query[OS_SIZE_6144];
 
+    if (sdb->db_batch != NULL) {
+        cJSON * entry = cJSON_CreateObject();
+        cJSON_AddStringToObject(entry, "delete", path);
+        char * entry_plain = cJSON_PrintUnformatted(entry);
+        int added = fim_db_batch_add(sdb, agent_id, entry_plain);
+
+        free(entry_plain);
+        cJSON_Delete(entry);
+
+        if (added == 0) {
+            return;
+        }
+    }
+
     if (snprintf(query, sizeof(query), "agent %s syscheck delete %s", agent_id, path) >= OS_SIZE_6144) {
         merror("FIM decoder: Cannot build delete query: input is too long.");
         return;
     }
 
+    if (wdb_async_query(agent_id, query) == 0) {
+        return;
+    }
+
     fim_send_db_query(&sdb->socket, query);
 }
 
+static int fim_db_batch_add(_sdb * sdb, const char * agent_id, const char * entry) {
+    size_t size;
+
+    if (sdb->db_batch == NULL || agent_id == NULL || entry == NULL) {
+        return -1;
+    }
+
+    if (size = strlen(entry), size + 2 > FIM_DB_BATCH_MAX_SIZE) {
+        return -1;
+    }
+
+    if (sdb->db_batch_agent != NULL &&
+        (strcmp(sdb->db_batch_agent, agent_id) != 0 || sdb->db_batch_size + size + 1 > FIM_DB_BATCH_MAX_SIZE)) {
+        fim_db_batch_flush(sdb);
+    }
+
+    if (sdb->db_batch_agent == NULL) {
+        os_strdup(agent_id, sdb->db_batch_agent);
+        sdb->db_batch_size = 2;
+    }
+
+    // The entry is printed once, the batch copies it verbatim
+    cJSON_AddItemToArray(sdb->db_batch, cJSON_CreateRaw(entry));
+    sdb->db_batch_size += size + 1;
+
+    return 0;
+}
+
+void fim_db_batch_start(_sdb * sdb) {
+    if (sdb->db_batch == NULL) {
+        sdb->db_batch = cJSON_CreateArray();
+    }
+}
+
+void fim_db_batch_flush(_sdb * sdb) {
+    char * data_plain = NULL;
+    char * query = NULL;
+
+    if (sdb->db_batch == NULL || sdb->db_batch_agent == NULL) {
+        return;
+    }
+
+    data_plain = cJSON_PrintUnformatted(sdb->db_batch);
+
+    if (wdb_async_frame_op(WDB_FRAME_FIM_BATCH, sdb->db_batch_agent, 0, NULL, data_plain) == 0) {
+        goto end;
+    }
+
+    os_malloc(OS_MAXSTR, query);
+
+    if (snprintf(query, OS_MAXSTR, "agent %s syscheck save_batch %s", sdb->db_batch_agent, data_plain) >= OS_MAXSTR) {
+        merror("FIM decoder: Cannot build save_batch query: input is too long.");
+        goto end;
+    }
+
+    fim_send_db_query(&sdb->socket, query);
+
+end:
+    free(data_plain);
+    free(query);
+    os_free(sdb->db_batch_agent);
+    cJSON_Delete(sdb->db_batch);
+    sdb->db_batch = cJSON_CreateArray();
+    sdb->db_batch_size = 0;
+}
+
+void fim_db_batch_end(_sdb * sdb) {
+    fim_db_batch_flush(sdb);
+    cJSON_Delete(sdb->db_batch);
+    sdb->db_batch = NULL;
+}
+
+char ** fim_expand_batch(const char * msg) {
+    char ** messages = NULL;
+    const char * log = NULL;
+    const char * dir = NULL;
+    cJSON * root = NULL;
+    cJSON * data = NULL;
+    cJSON * events = NULL;
+    cJSON * item = NULL;
+    int count = 0;
+
+    if (msg[0] == '\0' || msg[1] == '\0' || (log = wstr_chr_escape(msg + 2, ':', '|'), log == NULL)) {
+        return NULL;
+    }
+
+    log++;
+
+    if (strncmp(log, FIM_BATCH_PREFIX, sizeof(FIM_BATCH_PREFIX) - 1) != 0 || (root = cJSON_Parse(log), root == NULL)) {
+        return NULL;
+    }
+
+    data = cJSON_GetObjectItem(root, "data");
+    dir = cJSON_GetStringValue(cJSON_GetObjectItem(data, "dir"));
+    events = cJSON_GetObjectItem(data, "events");
+
+    if (dir == NULL || !cJSON_IsArray(events)) {
+        merror("Invalid FIM event batch");
+        os_calloc(1, sizeof(char *), messages);
+        goto end;
+    }
+
+    os_calloc(cJSON_GetArraySize(events) + 1, sizeof(char *), messages);
+
+    cJSON_ArrayForEach(item, events) {
+        const char * name = cJSON_GetStringValue(cJSON_GetObjectItem(item, "name"));
+        cJSON * event = NULL;
+        cJSON * event_data = NULL;
+        cJSON * field = NULL;
+        cJSON * old_attributes = NULL;
+        cJSON * attributes = NULL;
+        char * path = NULL;
+        char * event_plain = NULL;
+
+        if (name == NULL) {
+            mdebug1("FIM event batch contains an event with no name.");
+            continue;
+        }
+
+        event = cJSON_CreateObject();
+        event_data = cJSON_CreateObject();
+        cJSON_AddStringToObject(event, "type", "event");
+        cJSON_AddItemToObject(event, "data", event_data);
+
+        os_malloc(strlen(dir) + strlen(name) + 1, path);
+        strcpy(path, dir);
+        strcat(path, name);
+        cJSON_AddStringToObject(event_data, "path", path);
+        os_free(path);
+
+        cJSON_ArrayForEach(field, data) {
+            if (strcmp(field->string, "dir") != 0 && strcmp(field->string, "events") != 0) {
+                cJSON_AddItemToObject(event_data, field->string, cJSON_Duplicate(field, true));
+            }
+        }
+
+        cJSON_ArrayForEach(field, item) {
+            if (strcmp(field->string, "name") != 0) {
+                cJSON_AddItemToObject(event_data, field->string, cJSON_Duplicate(field, true));
+            }
+        }
+
+        // Only the changed attributes carry their old value
+        old_attributes = cJSON_GetObjectItem(event_data, "old_attributes");
+        attributes = cJSON_GetObjectItem(event_data, "attributes");
+
+        if (old_attributes != NULL) {
+            cJSON_ArrayForEach(field, attributes) {
+                if (!cJSON_HasObjectItem(old_attributes, field->string)) {
+                    cJSON_AddItemToObject(old_attributes, field->string, cJSON_Duplicate(field, true));
+                }
+            }
+        }
+
+        event_plain = cJSON_PrintUnformatted(event);
+        os_malloc((log - msg) + strlen(event_plain) + 1, messages[count]);
+        memcpy(messages[count], msg, log - msg);
+        strcpy(messages[count] + (log - msg), event_plain);
+        count++;
+
+        free(event_plain);
+        cJSON_Delete(event);
+    }
+
+end:
+    cJSON_Delete(root);
+    return messages;
+}
+
 void fim_send_db_query(int * sock, const char * query) {
     char * response;
     char * arg;
@@ -1681,6 +1918,10 @@ void fim_process_scan_info(_sdb * sdb, const char * agent_id, fim_scan_event eve
         return;
     }
 
+    if (wdb_async_query(agent_id, query) == 0) {
+        return;
+    }
+
     fim_send_db_query(&sdb->socket, query);
 }
 
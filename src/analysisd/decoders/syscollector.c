@@ -22,6 +22,7 @@
 #include <time.h>
 #include "wazuhdb_op.h"
 #include "wazuh_db/wdb.h"
+#include "../wdb_async.h"
 
 #ifdef WAZUH_UNIT_TESTING
 #define STATIC
@@ -44,6 +45,7 @@ static int decode_hotfix(Eventinfo *lf, cJSON * logJSON, int *socket);
 static int decode_port( Eventinfo *lf, cJSON * logJSON, int *socket);
 static int decode_process( Eventinfo *lf, cJSON * logJSON, int *socket);
 static int decode_dbsync( Eventinfo *lf, char *msg_type, cJSON * logJSON, int *socket);
+static int dbsync_frame_operation(const char * operation);
 
 static OSDecoderInfo *sysc_decoder = NULL;
 
@@ -2110,6 +2112,19 @@ void delta_map_values(const char * type, cJSON * data) {
     }
 }
 
+/* Argument of a dbsync frame operation, or -1 if the operation has no binary form */
+static int dbsync_frame_operation(const char * operation) {
+    if (strcmp(operation, "INSERTED") == 0) {
+        return WDB_FRAME_DBSYNC_INSERTED;
+    } else if (strcmp(operation, "MODIFIED") == 0) {
+        return WDB_FRAME_DBSYNC_MODIFIED;
+    } else if (strcmp(operation, "DELETED") == 0) {
+        return WDB_FRAME_DBSYNC_DELETED;
+    }
+
+    return -1;
+}
+
 static int decode_dbsync(Eventinfo * lf,   /* Event information */
                          char *msg_type,   /* Message type */
                          cJSON *logJSON,   /* JSON object with the message */
@@ -2137,7 +2152,15 @@ static int decode_dbsync(Eventinfo * lf,   /* Event information */
                                                                                        performed in the table. */
                     char * data = cJSON_PrintUnformatted(data_object);              /* Data is the JSON object with the
                                                                                        values to be processed. */
-                    if (NULL != data) {
+                    const int frame_operation = dbsync_frame_operation(operation); /* Argument of the frame
+                                                                                       operation. */
+                    if (NULL != data && frame_operation >= 0
+                        && wdb_async_frame_op(WDB_FRAME_DBSYNC, lf->agent_id, frame_operation, type, data) == 0) {
+                        /* The delta was enqueued: wazuh-db errors are logged by the asynchronous client. */
+                        fill_event_alert(lf, field_list, operation, data_object);
+                        ret_val = 0;
+                        cJSON_free(data);
+                    } else if (NULL != data) {
                         const size_t data_len = strlen(data) + 1;                   /* Data length is the size of the
                                                                                        data string. */
                         char *response = NULL;                                      /* Response is the string that will
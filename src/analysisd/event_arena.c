@@ -0,0 +1,112 @@
+/* Copyright (C) 2015, Wazuh Inc.
+ * All right reserved.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation
+ */
+
+#include "shared.h"
+#include "event_arena.h"
+
+/* Rolling estimate of the memory used by an event. It's only a hint, so lost updates don't matter */
+static atomic_int_t arena_estimate = ATOMIC_INT_INITIALIZER(EVENT_ARENA_MIN_SIZE);
+
+/* Get a new chunk, big enough for the request */
+static event_arena_chunk_t * event_arena_grow(event_arena_t * arena, size_t size) {
+    event_arena_chunk_t * chunk;
+    size_t chunk_size;
+
+    if (arena->chunks == NULL) {
+        // Some headroom over the average, so most events fit in one chunk
+        chunk_size = (size_t)atomic_int_get(&arena_estimate);
+        chunk_size += chunk_size / 4;
+    } else {
+        chunk_size = arena->chunks->size * 2;
+    }
+
+    if (chunk_size < size) {
+        chunk_size = size;
+    }
+
+    os_malloc(sizeof(event_arena_chunk_t) + chunk_size, chunk);
+    chunk->size = chunk_size;
+    chunk->used = 0;
+    chunk->next = arena->chunks;
+    arena->chunks = chunk;
+
+    return chunk;
+}
+
+void * event_arena_alloc(event_arena_t * arena, size_t size) {
+    event_arena_chunk_t * chunk;
+    void * ptr;
+
+    size = (size + EVENT_ARENA_ALIGN - 1) & ~(EVENT_ARENA_ALIGN - 1);
+
+    if (chunk = arena->chunks, chunk == NULL || chunk->size - chunk->used < size) {
+        chunk = event_arena_grow(arena, size);
+    }
+
+    ptr = chunk->data + chunk->used;
+    chunk->used += size;
+    arena->used += size;
+
+    return ptr;
+}
+
+char * event_arena_strdup(event_arena_t * arena, const char * str) {
+    size_t length;
+    char * copy;
+
+    if (str == NULL) {
+        return NULL;
+    }
+
+    length = strlen(str) + 1;
+    copy = event_arena_alloc(arena, length);
+    memcpy(copy, str, length);
+
+    return copy;
+}
+
+bool event_arena_owns(const event_arena_t * arena, const void * ptr) {
+    if (ptr == NULL) {
+        return false;
+    }
+
+    for (const event_arena_chunk_t * chunk = arena->chunks; chunk != NULL; chunk = chunk->next) {
+        if ((const char *)ptr >= chunk->data && (const char *)ptr < chunk->data + chunk->size) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void event_arena_free(event_arena_t * arena) {
+    event_arena_chunk_t * chunk;
+    event_arena_chunk_t * next;
+    int estimate;
+    int used;
+
+    // Events that don't use the arena don't change the estimate
+    if (arena->chunks == NULL) {
+        return;
+    }
+
+    // Exponential moving average of the memory used, with a weight of 1/8 for the last event
+    used = arena->used < EVENT_ARENA_MAX_SIZE ? (int)arena->used : EVENT_ARENA_MAX_SIZE;
+    estimate = atomic_int_get(&arena_estimate);
+    estimate += (used - estimate) / 8;
+    atomic_int_set(&arena_estimate, estimate > EVENT_ARENA_ALIGN ? estimate : (int)EVENT_ARENA_ALIGN);
+
+    for (chunk = arena->chunks; chunk != NULL; chunk = next) {
+        next = chunk->next;
+        os_free(chunk);
+    }
+
+    arena->chunks = NULL;
+    arena->used = 0;
+}
@@ -0,0 +1,75 @@
+/* Copyright (C) 2015, Wazuh Inc.
+ * All right reserved.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation
+ */
+
+#ifndef EVENT_ARENA_H
+#define EVENT_ARENA_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#define EVENT_ARENA_MIN_SIZE    1024    // Size of the first chunk of an arena when there is no estimate
+#define EVENT_ARENA_MAX_SIZE    65536   // Maximum size estimated for the first chunk
+#define EVENT_ARENA_ALIGN       sizeof(void *)
+
+/* Block of memory of an arena */
+typedef struct event_arena_chunk_t {
+    struct event_arena_chunk_t * next;
+    size_t size;
+    size_t used;
+    char data[];
+} event_arena_chunk_t;
+
+/**
+ * Bump allocator that holds the strings of a single event.
+ * The memory is never released piece by piece: all the chunks are freed at once when the event is freed.
+ */
+typedef struct event_arena_t {
+    event_arena_chunk_t * chunks;   // Last chunk first
+    size_t used;                    // Bytes given by the arena
+} event_arena_t;
+
+/**
+ * @brief Allocate memory from an event arena
+ *
+ * The first chunk is allocated on the first request. Its size comes from a
+ * rolling estimate of the memory used by the previous events.
+ *
+ * @param arena Arena of the event, zeroed before its first use.
+ * @param size Bytes to allocate.
+ * @return Pointer to the memory, aligned for any pointer.
+ */
+void * event_arena_alloc(event_arena_t * arena, size_t size);
+
+/**
+ * @brief Duplicate a string into an event arena
+ *
+ * @param arena Arena of the event.
+ * @param str String to copy.
+ * @return Copy of the string, or NULL if str is NULL.
+ */
+char * event_arena_strdup(event_arena_t * arena, const char * str);
+
+/**
+ * @brief Check whether some memory belongs to an arena
+ *
+ * @param arena Arena of the event.
+ * @param ptr Pointer to check.
+ * @retval true The memory was given by the arena and must not be freed on its own.
+ * @retval false Otherwise.
+ */
+bool event_arena_owns(const event_arena_t * arena, const void * ptr);
+
+/**
+ * @brief Free all the memory of an event arena
+ *
+ * @param arena Arena of the event. It's left empty, ready to be used again.
+ */
+void event_arena_free(event_arena_t * arena);
+
+#endif /* EVENT_ARENA_H */
@@ -94,6 +94,7 @@ Eventinfo *Search_LastSids(Eventinfo *my_lf, __attribute__((unused)) EventList *
     int frequency_count = 0;
     int i;
     int found;
+    int count;
     const char * my_field;
     const char * field;
     time_t current_time;
@@ -104,6 +105,17 @@ Eventinfo *Search_LastSids(Eventinfo *my_lf, __attribute__((unused)) EventList *
         return NULL;
     }
 
+    current_time = w_get_current_time();
+
+#ifdef TESTRULE
+    time(&current_time);
+#endif
+
+    /* Skip the search if the index holds too few matches with the same fields */
+    if (count = w_correlation_count(rule, my_lf, current_time), count >= 0 && count <= rule->frequency) {
+        return NULL;
+    }
+
     while (1) {
         w_mutex_lock(&rule->sid_search->mutex);
             if (!rule->sid_search->pending_remove) {
@@ -270,6 +282,7 @@ Eventinfo *Search_LastGroups(Eventinfo *my_lf, __attribute__((unused)) EventList
     int frequency_count = 0;
     int i;
     int found;
+    int count;
     OSList *list = rule->group_search;
     const char * my_field;
     const char * field;
@@ -283,6 +296,17 @@ Eventinfo *Search_LastGroups(Eventinfo *my_lf, __attribute__((unused)) EventList
         return NULL;
     }
 
+    current_time = w_get_current_time();
+
+#ifdef TESTRULE
+    time(&current_time);
+#endif
+
+    /* Skip the search if the index holds too few matches with the same fields */
+    if (count = w_correlation_count(rule, my_lf, current_time), count >= 0 && count <= rule->frequency) {
+        return NULL;
+    }
+
     while (1) {
         w_mutex_lock(&list->mutex);
             if (!list->pending_remove) {
@@ -669,8 +693,11 @@ void Zero_Eventinfo(Eventinfo *lf)
 
     if (lf->fields) {
         int i;
-        for (i = 0; i < lf->nfields; i++)
-            free(lf->fields[i].value);
+        for (i = 0; i < lf->nfields; i++) {
+            if (!event_arena_owns(&lf->arena, lf->fields[i].value)) {
+                free(lf->fields[i].value);
+            }
+        }
 
         memset(lf->fields, 0, sizeof(DynamicField) * Config.decoder_order_size);
     }
@@ -713,6 +740,11 @@ void Free_Eventinfo(Eventinfo *lf)
         return;
     }
 
+    /* A copy shared by several writers is freed by the last one */
+    if (lf->is_a_copy && atomic_int_dec(&lf->refs) > 0) {
+        return;
+    }
+
     if (lf->node && lf->node->prev) {
         EventNode *prev = lf->node->prev;
         w_mutex_lock(&prev->mutex);
@@ -853,13 +885,19 @@ void Free_Eventinfo(Eventinfo *lf)
     if (lf->fields) {
         int i;
         for (i = 0; i < lf->nfields; i++) {
-            free(lf->fields[i].key);
-            free(lf->fields[i].value);
+            if (!event_arena_owns(&lf->arena, lf->fields[i].key)) {
+                free(lf->fields[i].key);
+            }
+            if (!event_arena_owns(&lf->arena, lf->fields[i].value)) {
+                free(lf->fields[i].value);
+            }
         }
 
         free(lf->fields);
     }
 
+    event_arena_free(&lf->arena);
+
     if (lf->previous) {
         free(lf->previous);
     }
@@ -1150,6 +1188,12 @@ void w_copy_event_for_log(Eventinfo *lf,Eventinfo *lf_cpy){
     lf_cpy->decoder_syscheck_id = lf->decoder_syscheck_id;
     lf_cpy->rootcheck_fts = lf->rootcheck_fts;
     lf_cpy->is_a_copy = 1;
+    lf_cpy->refs = (atomic_int_t)ATOMIC_INT_INITIALIZER(1);
+}
+
+Eventinfo * w_share_event_for_log(Eventinfo *lf_cpy) {
+    atomic_int_inc(&lf_cpy->refs);
+    return lf_cpy;
 }
 
 void w_free_event_info(Eventinfo *lf) {
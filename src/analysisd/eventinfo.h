@@ -13,6 +13,7 @@
 
 #include "rules.h"
 #include "decoders/decoder.h"
+#include "event_arena.h"
 
 typedef enum syscheck_event_t { FIM_ADDED, FIM_MODIFIED, FIM_READDED, FIM_DELETED } syscheck_event_t;
 typedef struct _EventNode EventNode;
@@ -89,6 +90,8 @@ typedef struct _Eventinfo {
     u_int16_t decoder_syscheck_id;
     int rootcheck_fts;
     int is_a_copy;
+    atomic_int_t refs;  // Writers holding a copy. The last one frees it.
+    event_arena_t arena;    // Strings of the dynamic fields added by the decoders
     char **last_events;
     int r_firedtimes;
     int queue_added;
@@ -239,6 +242,9 @@ void *DynamicField_FP(Eventinfo *lf, char *field, const char *order);
 /* Copy Eventinfo for writing log */
 void w_copy_event_for_log(Eventinfo *lf,Eventinfo *lf_cpy);
 
+/* Take another reference to a copy, so another writer can use it. Each reference is released by Free_Eventinfo */
+Eventinfo * w_share_event_for_log(Eventinfo *lf_cpy);
+
 /* Add an event to last_events array */
 #define add_lastevt(x, y, z) os_realloc(x, sizeof(char *) * (y + 2), x); \
                              os_strdup(z, x[y]); \
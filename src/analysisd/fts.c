@@ -26,7 +26,12 @@ OSHash *os_analysisd_fts_store;
 
 /* Multiple readers / one write mutex */
 static pthread_rwlock_t file_update_rwlock;
-static pthread_mutex_t fts_write_lock;
+
+/* Lock of the list of the last FTS events. The store is only locked by its own hash */
+static pthread_mutex_t fts_write_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* Lock of the fts-queue file */
+static pthread_mutex_t fts_file_lock = PTHREAD_MUTEX_INITIALIZER;
 
 /* Start the FTS module */
 int FTS_Init(int threads, OSList **fts_list, OSHash **fts_store)
@@ -43,7 +48,6 @@ int FTS_Init(int threads, OSList **fts_list, OSHash **fts_store)
     }
 
     w_rwlock_init(&file_update_rwlock, NULL);
-    fts_write_lock = (pthread_mutex_t)PTHREAD_MUTEX_INITIALIZER;
 
     fp_ignore = (FILE **)calloc(threads, sizeof(FILE*));
     if (!fp_ignore) {
@@ -312,12 +316,12 @@ char * FTS(Eventinfo *lf, OSList **fts_list, OSHash **fts_store)
         return NULL;
     }
 
-    w_mutex_lock(&fts_write_lock);
-
     /* Check if from the last FTS events, we had at least 3 "similars" before.
      * If yes, we just ignore it.
      */
     if (lf->decoder_info->type == IDS) {
+        w_mutex_lock(&fts_write_lock);
+
         fts_node = OSList_GetLastNode(*fts_list);
         while (fts_node) {
             if (OS_StrHowClosedMatch((char *)fts_node->data, _line) >
@@ -351,41 +355,57 @@ char * FTS(Eventinfo *lf, OSList **fts_list, OSHash **fts_store)
             w_mutex_unlock(&fts_write_lock);
             return NULL;
         }
-    }
 
-    /* Store new entry */
-    if (line_for_list == NULL) {
-        os_strdup(_line, line_for_list);
-        if (!line_for_list) {
-            merror(MEM_ERROR, errno, strerror(errno));
+        /* Store new entry. The list node must be removed if it's a duplicate */
+        if (OSHash_Add_ex(*fts_store, line_for_list, line_for_list) != 2) {
+            OSList_DeleteThisNode(*fts_list, fts_node);
+            free(line_for_list);
             free(_line);
             w_mutex_unlock(&fts_write_lock);
             return NULL;
         }
+
+        w_mutex_unlock(&fts_write_lock);
+        return _line;
+    }
+
+    /* Store new entry. The hash adds it atomically, so only one thread reports it */
+    os_strdup(_line, line_for_list);
+    if (!line_for_list) {
+        merror(MEM_ERROR, errno, strerror(errno));
+        free(_line);
+        return NULL;
     }
 
     if (OSHash_Add_ex(*fts_store, line_for_list, line_for_list) != 2) {
-        if (fts_node) OSList_DeleteThisNode(*fts_list, fts_node);
         free(line_for_list);
         free(_line);
-        w_mutex_unlock(&fts_write_lock);
         return NULL;
     }
 
-    w_mutex_unlock(&fts_write_lock);
     return _line;
 }
 
 void FTS_Fprintf(char * _line){
+    FTS_Fprintf_Batch(&_line, 1);
+}
+
+void FTS_Fprintf_Batch(char ** lines, size_t count){
+    size_t i;
+
     /* Save to fts fp */
-    w_mutex_lock(&fts_write_lock);
+    w_mutex_lock(&fts_file_lock);
     fseek(fp_list, 0, SEEK_END);
-    fprintf(fp_list, "%s\n", _line);
-    w_mutex_unlock(&fts_write_lock);
+
+    for (i = 0; i < count; i++) {
+        fprintf(fp_list, "%s\n", lines[i]);
+    }
+
+    w_mutex_unlock(&fts_file_lock);
 }
 
 void FTS_Flush(){
-    w_mutex_lock(&fts_write_lock);
+    w_mutex_lock(&fts_file_lock);
     fflush(fp_list);
-    w_mutex_unlock(&fts_write_lock);
+    w_mutex_unlock(&fts_file_lock);
 }
@@ -17,6 +17,9 @@
 #define FTS_QUEUE "queue/fts/fts-queue"
 #define IG_QUEUE  "queue/fts/ig-queue"
 
+/* Maximum number of values written to fts-queue at once */
+#define FTS_WRITE_BATCH 256
+
 /**
  * @brief Structure to save previous fts events
  */
@@ -70,6 +73,13 @@ char * FTS(Eventinfo *lf, OSList **fts_list, OSHash **fts_store);
  */
 void FTS_Fprintf(char * _line);
 
+/**
+ * @brief Save several values in fts-queue at once
+ * @param lines Values to print in fts-queue
+ * @param count Number of values
+ */
+void FTS_Fprintf_Batch(char ** lines, size_t count);
+
 /**
  * @brief Flush file fts-queue
  */
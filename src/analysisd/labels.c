@@ -9,6 +9,13 @@
  * Foundation.
  */
 
+#ifdef WAZUH_UNIT_TESTING
+// Remove static qualifier when unit testing
+#define STATIC
+#else
+#define STATIC static
+#endif
+
 #include "headers/shared.h"
 #include "wazuh_db/helpers/wdb_global_helpers.h"
 #include "eventinfo.h"
@@ -17,6 +24,7 @@
 
 static OSHash *label_cache;
 static pthread_mutex_t label_cache_mutex;
+static w_mpmc_queue_t *label_refresh_queue;
 
 /* Free label cache */
 void free_label_cache(wlabel_data_t *data) {
@@ -35,64 +43,173 @@ int labels_init() {
     OSHash_SetFreeDataPointer(label_cache, (void (*)(void *))free_label_cache);
 
     label_cache_mutex = (pthread_mutex_t) PTHREAD_MUTEX_INITIALIZER;
+    label_refresh_queue = mpmc_queue_init(LABELS_REFRESH_QUEUE_SIZE);
     return (1);
 }
 
 /* Finalize label cache */
 void labels_finalize() {
+    char *agent_id;
+
+    while (agent_id = mpmc_queue_pop(label_refresh_queue), agent_id) {
+        os_free(agent_id);
+    }
+
+    mpmc_queue_free(label_refresh_queue);
     OSHash_Free(label_cache);
 }
 
-wlabel_data_t * labels_cache_update(char *agent_id, int *sock) {
-    wlabel_t *labels = NULL;
-    wlabel_data_t *data = NULL;
+/**
+ * @brief Gets the cache entry of an agent, creating an expired one if it does not exist.
+ * The cache mutex must be locked.
+ *
+ * @param agent_id The ID of the agent.
+ * @retval The cache entry. NULL on error.
+ */
+STATIC wlabel_data_t * labels_cache_entry(const char *agent_id) {
+    wlabel_data_t *data = (wlabel_data_t*)OSHash_Get(label_cache, agent_id);
+
+    if (data == NULL) {
+        os_calloc(1, sizeof(wlabel_data_t), data);
+
+        if (OSHash_Add(label_cache, agent_id, data) != 2) {
+            merror("Cannot cache labels.");
+            os_free(data);
+        }
+    }
+
+    return data;
+}
+
+/**
+ * @brief Stores the labels of an agent unless the entry was updated after a given time.
+ *
+ * @param agent_id The ID of the agent.
+ * @param labels Labels to store, freed if they are not stored.
+ * @param since Time the labels were read at, 0 to always store them.
+ */
+STATIC void labels_cache_store(const char *agent_id, wlabel_t *labels, time_t since) {
+    wlabel_data_t *data;
+
+    w_mutex_lock(&label_cache_mutex);
+
+    if (data = labels_cache_entry(agent_id), data == NULL) {
+        labels_free(labels);
+    } else if (since && data->mtime >= since) {
+        // A notification arrived while the labels were being fetched
+        labels_free(labels);
+        data->pending = false;
+    } else {
+        labels_free(data->labels);
+        data->labels = labels;
+        data->mtime = time(NULL);
+        data->pending = false;
+    }
+
+    w_mutex_unlock(&label_cache_mutex);
+}
+
+int labels_cache_set(const char *agent_id, cJSON *labels_json) {
+    if (!cJSON_IsArray(labels_json)) {
+        return OS_INVALID;
+    }
+
+    labels_cache_store(agent_id, labels_parse(labels_json), 0);
+    return OS_SUCCESS;
+}
+
+/**
+ * @brief Fetches the labels of an agent from Wazuh DB and caches them.
+ *
+ * @param agent_id The ID of the agent.
+ * @param sock The Wazuh DB socket connection.
+ */
+STATIC void labels_cache_fetch(const char *agent_id, int *sock) {
+    wlabel_data_t *data;
+    time_t since = time(NULL);
 
     // Requesting labels to Wazuh DB
     cJSON *labels_json = wdb_get_agent_labels(atoi(agent_id), sock);
 
     if (labels_json == NULL) {
-        return NULL;
+        // Keep the cached labels, the entry is refreshed again once it expires
+        w_mutex_lock(&label_cache_mutex);
+        if (data = (wlabel_data_t*)OSHash_Get(label_cache, agent_id), data) {
+            data->mtime = since;
+            data->pending = false;
+        }
+        w_mutex_unlock(&label_cache_mutex);
+        return;
     }
 
-    labels = labels_parse(labels_json);
+    labels_cache_store(agent_id, labels_parse(labels_json), since);
     cJSON_Delete(labels_json);
+}
 
-    // Cleaning labels from cache
-    if (data = OSHash_Delete(label_cache, agent_id), data) {
-        labels_free(data->labels);
-        os_free(data);
+void * labels_refresh_thread(__attribute__((unused)) void * arg) {
+    char agent_id[OS_SIZE_16];
+    char *queued_id;
+    int *agents;
+    int sock = -1;
+    int i;
+
+    mdebug1("Labels refresh thread ready");
+
+    // Filling the cache with the labels of all the agents
+    if (agents = wdb_get_all_agents(false, &sock), agents) {
+        for (i = 0; agents[i] != -1; i++) {
+            snprintf(agent_id, OS_SIZE_16, "%.3d", agents[i]);
+            labels_cache_fetch(agent_id, &sock);
+        }
+
+        mdebug1("Labels of %d agents cached", i);
+        os_free(agents);
+    } else {
+        mwarn("Cannot get the agents to cache their labels.");
     }
 
-    // Adding new labels to the cache
-    os_calloc(1, sizeof(wlabel_data_t), data);
-    data->labels = labels;
-    data->mtime = time(NULL);
-    if (OSHash_Add(label_cache, agent_id, data) != 2) {
-        merror("Cannot cache labels.");
-        labels_free(data->labels);
-        os_free(data);
+    while (1) {
+        if (queued_id = mpmc_queue_pop_block(label_refresh_queue), queued_id) {
+            labels_cache_fetch(queued_id, &sock);
+            os_free(queued_id);
+        }
+
+    #ifdef WAZUH_UNIT_TESTING
+        break;
+    #endif
     }
 
-    return data;
+    return NULL;
 }
 
-wlabel_t * labels_find(char *agent_id, int *sock) {
+wlabel_t * labels_find(const char *agent_id) {
     wlabel_t *ret_labels = NULL;
     wlabel_data_t *data = NULL;
+    char *queued_id;
 
     if (strcmp(agent_id, "000") == 0) {
         return Config.labels;
     }
 
     w_mutex_lock(&label_cache_mutex);
-    data = (wlabel_data_t*)OSHash_Get(label_cache, agent_id);
-    if (data == NULL || (time(NULL) > data->mtime + Config.label_cache_maxage)) {
-        data = labels_cache_update(agent_id, sock);
-    }
 
-    if (data != NULL) {
-        ret_labels = labels_dup(data->labels);
+    if (data = labels_cache_entry(agent_id), data != NULL) {
+        if (!data->pending && time(NULL) > data->mtime + Config.label_cache_maxage) {
+            os_strdup(agent_id, queued_id);
+
+            if (mpmc_queue_push(label_refresh_queue, queued_id) < 0) {
+                // Queue full, another event of the agent will retry
+                os_free(queued_id);
+            } else {
+                data->pending = true;
+            }
+        }
+
+        if (data->labels != NULL) {
+            ret_labels = labels_dup(data->labels);
+        }
     }
+
     w_mutex_unlock(&label_cache_mutex);
 
     return ret_labels;
@@ -14,9 +14,13 @@
 
 #include <pthread.h>
 
+/* Maximum number of agents waiting for their labels to be fetched */
+#define LABELS_REFRESH_QUEUE_SIZE 4096
+
 typedef struct wlabel_data_t {
     wlabel_t *labels;
     time_t mtime;
+    bool pending;   ///< The agent is queued to fetch its labels from Wazuh DB
 } wlabel_data_t;
 
 /* Initialize label cache */
@@ -27,11 +31,30 @@ void labels_finalize();
 
 /**
  * @brief Finds the label array of an agent that generated an event.
- * 
+ *
+ * It never queries Wazuh DB: the labels of an agent not cached yet, or whose entry is
+ * older than label_cache_maxage, are fetched by the refresh thread.
+ *
  * @param agent_id The ID of the agent for whom the labels are requested.
- * @param sock The Wazuh DB socket connection.
- * @retval The agent's labels array on success. NULL on error.
+ * @retval The agent's labels array on success. NULL if the labels are not cached.
+ */
+wlabel_t* labels_find(const char *agent_id);
+
+/**
+ * @brief Replaces the cached labels of an agent.
+ *
+ * @param agent_id The ID of the agent.
+ * @param labels_json Labels array in the format returned by Wazuh DB.
+ * @retval OS_SUCCESS on success. OS_INVALID if the labels are not an array.
+ */
+int labels_cache_set(const char *agent_id, cJSON *labels_json);
+
+/**
+ * @brief Thread that fills the label cache of all the agents at startup and then
+ * fetches the labels of the agents queued by labels_find().
+ *
+ * @param arg Unused.
  */
-wlabel_t* labels_find(char *agent_id, int *sock);
+void * labels_refresh_thread(void * arg);
 
 #endif
@@ -118,156 +118,118 @@ ListRule *OS_AddListRule(ListRule *first_rule_list, int lookup_type, int field,
     return first_rule_list;
 }
 
+/* Opens the CDB file of a list the first time it's looked up. The
+ * flag is read without the lock once it's set, so the lookups of every
+ * rule that uses the list don't serialize on it. */
 static int _OS_CDBOpen(ListNode *lnode)
 {
     int fd;
+    int result = 0;
+
+    if (__atomic_load_n(&lnode->loaded, __ATOMIC_ACQUIRE) == 1) {
+        return 0;
+    }
+
+    w_mutex_lock(&lnode->mutex);
     if (lnode->loaded != 1) {
         if ((fd = open(lnode->cdb_filename, O_RDONLY)) == -1) {
             merror(OPEN_ERROR, lnode->cdb_filename, errno, strerror (errno));
-            return -1;
+            result = -1;
+        } else {
+            cdb_init(&lnode->cdb, fd);
+            __atomic_store_n(&lnode->loaded, 1, __ATOMIC_RELEASE);
         }
-        cdb_init(&lnode->cdb, fd);
-        lnode->loaded = 1;
     }
-    return 0;
+    w_mutex_unlock(&lnode->mutex);
+    return result;
 }
 
-static int OS_DBSearchKeyValue(ListRule *lrule, char *key)
+/* Matches the value stored at vpos against the rule */
+static int _OS_DBMatchValue(ListRule *lrule, uint32 vpos, uint32 vlen)
 {
-    int result = -1;
+    int result;
     char *val;
-    unsigned vlen, vpos;
-    w_mutex_lock(&lrule->mutex);
-    if (lrule->db != NULL) {
-        if (_OS_CDBOpen(lrule->db) == -1) {
-            w_mutex_unlock(&lrule->mutex);
-            return 0;
-        }
-        if (cdb_find(&lrule->db->cdb, key, strlen(key)) > 0 ) {
-            vpos = cdb_datapos(&lrule->db->cdb);
-            vlen = cdb_datalen(&lrule->db->cdb);
-            val = (char *) calloc(vlen + 1, sizeof(char));
 
-            w_mutex_unlock(&lrule->mutex);
-            if (!val){
-                return 0;
-            }
+    os_calloc(vlen + 1, sizeof(char), val);
+    if (cdb_read(&lrule->db->cdb, val, vlen, vpos) == -1) {
+        free(val);
+        return 0;
+    }
+    result = OSMatch_Execute(val, vlen, lrule->matcher);
+    free(val);
+    return result;
+}
 
-            w_mutex_lock(&lrule->db->cdb.mutex)
-            cdb_read(&lrule->db->cdb, val, vlen, vpos);
-            w_mutex_unlock(&lrule->db->cdb.mutex);
-            result = OSMatch_Execute(val, vlen, lrule->matcher);
-            free(val);
-            return result;
-        } else {
-            w_mutex_unlock(&lrule->mutex);
-            return 0;
+/* Looks up the subnets of an address, from the longest to the shortest
+ * prefix ending in a dot (e.g. "10.1.2." and "10.1." for "10.1.2.3") */
+static int _OS_DBFindSubnet(ListRule *lrule, char *key, uint32 *vpos, uint32 *vlen)
+{
+    size_t i;
+
+    for (i = strlen(key); i > 0; i--) {
+        if (key[i - 1] == '.' && cdb_lookup(&lrule->db->cdb, key, i, vpos, vlen) > 0) {
+            return 1;
         }
     }
-    w_mutex_unlock(&lrule->mutex);
+    return 0;
+}
+
+static int OS_DBSearchKeyValue(ListRule *lrule, char *key)
+{
+    uint32 vlen, vpos;
+
+    if (lrule->db == NULL || _OS_CDBOpen(lrule->db) == -1) {
+        return 0;
+    }
+    if (cdb_lookup(&lrule->db->cdb, key, strlen(key), &vpos, &vlen) > 0) {
+        return _OS_DBMatchValue(lrule, vpos, vlen);
+    }
     return 0;
 }
 
 static int OS_DBSeachKey(ListRule *lrule, char *key)
 {
-    w_mutex_lock(&lrule->mutex);
+    uint32 vlen, vpos;
+
     if (lrule->db != NULL) {
         if (_OS_CDBOpen(lrule->db) == -1) {
-            w_mutex_unlock(&lrule->mutex);
             return -1;
         }
-        w_mutex_unlock(&lrule->mutex);
-        if ( cdb_find(&lrule->db->cdb, key, strlen(key)) > 0 ) {
+        if (cdb_lookup(&lrule->db->cdb, key, strlen(key), &vpos, &vlen) > 0) {
             return 1;
         }
-    }else {
-        w_mutex_unlock(&lrule->mutex);
     }
     return 0;
 }
 
 static int OS_DBSeachKeyAddress(ListRule *lrule, char *key)
 {
-    w_mutex_lock(&lrule->mutex);
+    uint32 vlen, vpos;
+
     if (lrule->db != NULL) {
         if (_OS_CDBOpen(lrule->db) == -1) {
-            w_mutex_unlock(&lrule->mutex);
             return -1;
         }
-        w_mutex_unlock(&lrule->mutex);
-        if ( cdb_find(&lrule->db->cdb, key, strlen(key)) > 0 ) {
+        if (cdb_lookup(&lrule->db->cdb, key, strlen(key), &vpos, &vlen) > 0) {
             return 1;
-        } else {
-            char *tmpkey;
-            os_strdup(key, tmpkey);
-            while (strlen(tmpkey) > 0) {
-                if (tmpkey[strlen(tmpkey) - 1] == '.') {
-                    if ( cdb_find(&lrule->db->cdb, tmpkey, strlen(tmpkey)) > 0 ) {
-                        free(tmpkey);
-                        return 1;
-                    }
-                }
-                tmpkey[strlen(tmpkey) - 1] = '\0';
-            }
-            free(tmpkey);
         }
-    }else{
-        w_mutex_unlock(&lrule->mutex);
+        return _OS_DBFindSubnet(lrule, key, &vpos, &vlen);
     }
     return 0;
 }
 
 static int OS_DBSearchKeyAddressValue(ListRule *lrule, char *key)
 {
-    int result = -1;
-    char *val;
-    unsigned vlen, vpos;
-    w_mutex_lock(&lrule->mutex);
-    if (lrule->db != NULL) {
-        if (_OS_CDBOpen(lrule->db) == -1) {
-            w_mutex_unlock(&lrule->mutex);
-            return 0;
-        }
+    uint32 vlen, vpos;
 
-        w_mutex_unlock(&lrule->mutex);
+    if (lrule->db == NULL || _OS_CDBOpen(lrule->db) == -1) {
+        return 0;
+    }
 
-        /* First lookup for a single IP address */
-        if (cdb_find(&lrule->db->cdb, key, strlen(key)) > 0 ) {
-            vpos = cdb_datapos(&lrule->db->cdb);
-            vlen = cdb_datalen(&lrule->db->cdb);
-            os_calloc(vlen, sizeof(char), val);
-            w_mutex_lock(&lrule->db->cdb.mutex)
-            cdb_read(&lrule->db->cdb, val, vlen, vpos);
-            w_mutex_unlock(&lrule->db->cdb.mutex)
-            result = OSMatch_Execute(val, vlen, lrule->matcher);
-            free(val);
-            return result;
-        } else {
-            /* IP address not found, look for matching subnets */
-            char *tmpkey;
-            os_strdup(key, tmpkey);
-            while (strlen(tmpkey) > 0) {
-                if (tmpkey[strlen(tmpkey) - 1] == '.') {
-                    if ( cdb_find(&lrule->db->cdb, tmpkey, strlen(tmpkey)) > 0 ) {
-                        vpos = cdb_datapos(&lrule->db->cdb);
-                        vlen = cdb_datalen(&lrule->db->cdb);
-                        os_calloc(vlen, sizeof(char), val);
-                        w_mutex_lock(&lrule->db->cdb.mutex)
-                        cdb_read(&lrule->db->cdb, val, vlen, vpos);
-                        w_mutex_unlock(&lrule->db->cdb.mutex)
-                        result = OSMatch_Execute(val, vlen, lrule->matcher);
-                        free(val);
-                        free(tmpkey);
-                        return result;
-                    }
-                }
-                tmpkey[strlen(tmpkey) - 1] = '\0';
-            }
-            free(tmpkey);
-            return 0;
-        }
-    }else{
-        w_mutex_unlock(&lrule->mutex);
+    /* First lookup for a single IP address, then for matching subnets */
+    if (cdb_lookup(&lrule->db->cdb, key, strlen(key), &vpos, &vlen) > 0 ||
+            _OS_DBFindSubnet(lrule, key, &vpos, &vlen)) {
+        return _OS_DBMatchValue(lrule, vpos, vlen);
     }
     return 0;
 }
@@ -275,12 +237,14 @@ static int OS_DBSearchKeyAddressValue(ListRule *lrule, char *key)
 int OS_DBSearch(ListRule *lrule, char *key, ListNode **l_node)
 {
     //XXX - god damn hack!!! Jeremy Rossi
-    w_mutex_lock(&lrule->mutex);
-    if (lrule->loaded == 0) {
-        lrule->db = OS_FindList(lrule->filename, l_node);
-        lrule->loaded = 1;
+    if (__atomic_load_n(&lrule->loaded, __ATOMIC_ACQUIRE) == 0) {
+        w_mutex_lock(&lrule->mutex);
+        if (lrule->loaded == 0) {
+            lrule->db = OS_FindList(lrule->filename, l_node);
+            __atomic_store_n(&lrule->loaded, 1, __ATOMIC_RELEASE);
+        }
+        w_mutex_unlock(&lrule->mutex);
     }
-    w_mutex_unlock(&lrule->mutex);
 
     switch (lrule->lookup_type) {
         case LR_STRING_MATCH:
@@ -325,6 +289,10 @@ void os_remove_cdblist(ListNode **l_node) {
         tmp = *l_node;
         *l_node = (*l_node)->next;
 
+        if (tmp->loaded == 1) {
+            cdb_free(&tmp->cdb);
+            close(tmp->cdb.fd);
+        }
         os_free(tmp->cdb_filename);
         os_free(tmp->txt_filename);
         os_free(tmp);
@@ -13,6 +13,11 @@
 
 OSHash *w_logtest_sessions;
 
+/* Decoders and CDB lists shared by the sessions. They are only shared once logtest is running */
+static bool w_logtest_share_ruleset;
+static w_logtest_shared_ruleset_t *w_logtest_current_ruleset;
+static pthread_mutex_t w_logtest_ruleset_mutex = PTHREAD_MUTEX_INITIALIZER;
+
 
 void *w_logtest_init() {
 
@@ -46,6 +51,7 @@ void *w_logtest_init() {
 
     w_mutex_init(&connection.mutex, NULL);
     connection.active_client = 0;
+    w_logtest_share_ruleset = true;
 
     minfo(LOGTEST_INITIALIZED);
 
@@ -359,6 +365,9 @@ int w_logtest_rulesmatching_phase(Eventinfo * lf, w_logtest_session_t * session,
         }
 
 
+        /* Count the event for the rules that search it */
+        w_correlation_add_event(ruleinformation, lf);
+
         /* Copy the structure to the state memory of if_matched_sid */
         if (ruleinformation->sid_prev_matched) {
 
@@ -424,41 +433,24 @@ w_logtest_session_t * w_logtest_initialize_session(OSList * list_msg) {
         goto cleanup;
     }
 
-    /* Load decoders */
-    session->decoderlist_forpname = NULL;
-    session->decoderlist_nopname = NULL;
-    session->decoder_store = NULL;
-
-    files = ruleset_config.decoders;
+    /* Load decoders and CDB lists, or reference the ones already loaded */
+    session->cdblistrule = NULL;
 
-    while (files != NULL && *files != NULL) {
-        if (ReadDecodeXML(*files, &session->decoderlist_forpname,
-            &session->decoderlist_nopname, &session->decoder_store, list_msg) == 0) {
+    if (w_logtest_share_ruleset) {
+        if (session->shared_ruleset = w_logtest_shared_ruleset_get(&ruleset_config, list_msg), !session->shared_ruleset) {
             goto cleanup;
         }
-        files++;
-    }
 
-    if (SetDecodeXML(list_msg, &session->decoder_store, &session->decoderlist_nopname,
-                     &session->decoderlist_forpname) == 0) {
+        session->decoderlist_forpname = session->shared_ruleset->decoderlist_forpname;
+        session->decoderlist_nopname = session->shared_ruleset->decoderlist_nopname;
+        session->decoder_store = session->shared_ruleset->decoder_store;
+        session->cdblistnode = session->shared_ruleset->cdblistnode;
+    } else if (!w_logtest_load_decoders_lists(&ruleset_config, &session->decoderlist_forpname,
+                                              &session->decoderlist_nopname, &session->decoder_store,
+                                              &session->cdblistnode, list_msg)) {
         goto cleanup;
     }
 
-    /* Load CDB list */
-    session->cdblistnode = NULL;
-    session->cdblistrule = NULL;
-
-    files = ruleset_config.lists;
-
-    while (files != NULL && *files != NULL) {
-        if (Lists_OP_LoadList(*files, &session->cdblistnode, list_msg) < 0) {
-            goto cleanup;
-        }
-        files++;
-    }
-
-    Lists_OP_MakeAll(0, 0, &session->cdblistnode);
-
     /* Load rules */
     session->rule_list = NULL;
 
@@ -478,6 +470,9 @@ w_logtest_session_t * w_logtest_initialize_session(OSList * list_msg) {
     /* _setlevels */
     _setlevels(session->rule_list, 0);
 
+    /* Index the rules by decoder */
+    OS_IndexRules(session->rule_list);
+
     /* Creating rule hash */
     if (session->g_rules_hash = OSHash_Create(), !session->g_rules_hash) {
         goto cleanup;
@@ -517,14 +512,18 @@ cleanup:
             OSHash_Free(session->g_rules_hash);
         }
 
-        /* Remove decoder lists */
-        os_remove_decoders_list(session->decoderlist_forpname, session->decoderlist_nopname);
-        if (session->decoder_store != NULL) {
-            OSStore_Free(session->decoder_store);
+        /* Remove decoder lists and cdblistnode */
+        if (session->shared_ruleset) {
+            w_logtest_shared_ruleset_release(session->shared_ruleset);
+        } else {
+            os_remove_decoders_list(session->decoderlist_forpname, session->decoderlist_nopname);
+            if (session->decoder_store != NULL) {
+                OSStore_Free(session->decoder_store);
+            }
+            os_remove_cdblist(&session->cdblistnode);
         }
 
-        /* Remove cdblistnode and cdblistrule */
-        os_remove_cdblist(&session->cdblistnode);
+        /* Remove cdblistrule */
         os_remove_cdbrules(&session->cdblistrule);
 
         /* Remove fts list and hash */
@@ -572,12 +571,16 @@ void w_logtest_remove_session(char *token) {
     os_remove_rules_list(session->rule_list);
     OSHash_Free(session->g_rules_hash);
 
-    /* Remove decoder lists */
-    os_remove_decoders_list(session->decoderlist_forpname, session->decoderlist_nopname);
-    OSStore_Free(session->decoder_store);
+    /* Remove decoder lists and cdblistnode */
+    if (session->shared_ruleset) {
+        w_logtest_shared_ruleset_release(session->shared_ruleset);
+    } else {
+        os_remove_decoders_list(session->decoderlist_forpname, session->decoderlist_nopname);
+        OSStore_Free(session->decoder_store);
+        os_remove_cdblist(&session->cdblistnode);
+    }
 
-    /* Remove cdblistnode and cdblistrule */
-    os_remove_cdblist(&session->cdblistnode);
+    /* Remove cdblistrule */
     os_remove_cdbrules(&session->cdblistrule);
 
     /* Remove fts list and hash */
@@ -602,6 +605,130 @@ void w_logtest_remove_session(char *token) {
 }
 
 
+bool w_logtest_load_decoders_lists(_Config * ruleset_config, OSDecoderNode ** decoderlist_forpname,
+                                   OSDecoderNode ** decoderlist_nopname, OSStore ** decoder_store,
+                                   ListNode ** cdblistnode, OSList * list_msg) {
+
+    char ** files;
+
+    /* Load decoders */
+    *decoderlist_forpname = NULL;
+    *decoderlist_nopname = NULL;
+    *decoder_store = NULL;
+
+    files = ruleset_config->decoders;
+
+    while (files != NULL && *files != NULL) {
+        if (ReadDecodeXML(*files, decoderlist_forpname, decoderlist_nopname, decoder_store, list_msg) == 0) {
+            return false;
+        }
+        files++;
+    }
+
+    if (SetDecodeXML(list_msg, decoder_store, decoderlist_nopname, decoderlist_forpname) == 0) {
+        return false;
+    }
+
+    /* Load CDB list */
+    *cdblistnode = NULL;
+
+    files = ruleset_config->lists;
+
+    while (files != NULL && *files != NULL) {
+        if (Lists_OP_LoadList(*files, cdblistnode, list_msg) < 0) {
+            return false;
+        }
+        files++;
+    }
+
+    Lists_OP_MakeAll(0, 0, cdblistnode);
+
+    return true;
+}
+
+/* Paths, sizes and modification times of the decoder and list files */
+static char * w_logtest_ruleset_signature(_Config * ruleset_config) {
+
+    char ** file_lists[] = { ruleset_config->decoders, ruleset_config->lists };
+    char * signature = NULL;
+    char buffer[PATH_MAX + 64];
+    struct stat file_stat;
+
+    for (size_t i = 0; i < sizeof(file_lists) / sizeof(file_lists[0]); i++) {
+        for (char ** files = file_lists[i]; files != NULL && *files != NULL; files++) {
+            if (stat(*files, &file_stat) == 0) {
+                snprintf(buffer, sizeof(buffer), "%s:%lld:%lld", *files, (long long)file_stat.st_size,
+                         (long long)file_stat.st_mtime);
+            } else {
+                snprintf(buffer, sizeof(buffer), "%s:-", *files);
+            }
+
+            wm_strcat(&signature, buffer, '|');
+        }
+    }
+
+    return signature ? signature : strdup("");
+}
+
+static void w_logtest_shared_ruleset_free(w_logtest_shared_ruleset_t * ruleset) {
+
+    os_remove_decoders_list(ruleset->decoderlist_forpname, ruleset->decoderlist_nopname);
+    if (ruleset->decoder_store != NULL) {
+        OSStore_Free(ruleset->decoder_store);
+    }
+    os_remove_cdblist(&ruleset->cdblistnode);
+    os_free(ruleset->signature);
+    os_free(ruleset);
+}
+
+w_logtest_shared_ruleset_t * w_logtest_shared_ruleset_get(_Config * ruleset_config, OSList * list_msg) {
+
+    w_logtest_shared_ruleset_t * ruleset = NULL;
+    char * signature = w_logtest_ruleset_signature(ruleset_config);
+
+    /* Loading under the lock makes the concurrent new sessions wait for a single load */
+    w_mutex_lock(&w_logtest_ruleset_mutex);
+
+    if (w_logtest_current_ruleset && strcmp(w_logtest_current_ruleset->signature, signature) == 0) {
+        ruleset = w_logtest_current_ruleset;
+        ruleset->references++;
+        os_free(signature);
+    } else {
+        os_calloc(1, sizeof(w_logtest_shared_ruleset_t), ruleset);
+        ruleset->signature = signature;
+
+        if (w_logtest_load_decoders_lists(ruleset_config, &ruleset->decoderlist_forpname,
+                                          &ruleset->decoderlist_nopname, &ruleset->decoder_store,
+                                          &ruleset->cdblistnode, list_msg)) {
+            /* The previous snapshot is freed when its last session is removed */
+            if (w_logtest_current_ruleset && --w_logtest_current_ruleset->references == 0) {
+                w_logtest_shared_ruleset_free(w_logtest_current_ruleset);
+            }
+
+            ruleset->references = 2;
+            w_logtest_current_ruleset = ruleset;
+        } else {
+            w_logtest_shared_ruleset_free(ruleset);
+            ruleset = NULL;
+        }
+    }
+
+    w_mutex_unlock(&w_logtest_ruleset_mutex);
+
+    return ruleset;
+}
+
+void w_logtest_shared_ruleset_release(w_logtest_shared_ruleset_t * ruleset) {
+
+    w_mutex_lock(&w_logtest_ruleset_mutex);
+
+    if (--ruleset->references == 0) {
+        w_logtest_shared_ruleset_free(ruleset);
+    }
+
+    w_mutex_unlock(&w_logtest_ruleset_mutex);
+}
+
 void *w_logtest_check_inactive_sessions(w_logtest_connection_t * connection) {
 
     OSHashNode *hash_node;
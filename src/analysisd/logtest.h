@@ -78,6 +78,21 @@
 #define valid_str_session(x,y) (cJSON_IsString(x) && x->valuestring && strlen(x->valuestring) == y) ? 1 : 0)
 
 
+/**
+ * @brief Decoders and CDB lists shared by the sessions
+ *
+ * They are not modified once loaded, so the sessions created while their files do not change use the same
+ * snapshot. The rules are still compiled per session because they keep the correlation state of the session.
+ */
+typedef struct w_logtest_shared_ruleset_t {
+    OSDecoderNode *decoderlist_forpname;    ///< Decoder list to match logs which have a program name
+    OSDecoderNode *decoderlist_nopname;     ///< Decoder list to match logs which haven't a program name
+    OSStore *decoder_store;                 ///< Decoder list to save internals decoders
+    ListNode *cdblistnode;                  ///< List of CDB lists
+    char *signature;                        ///< Paths, sizes and modification times of the decoder and list files
+    unsigned int references;                ///< Sessions using the snapshot, plus one while it is the current one
+} w_logtest_shared_ruleset_t;
+
 /**
  * @brief A w_logtest_session_t instance represents a client
  */
@@ -103,6 +118,7 @@ typedef struct w_logtest_session_t {
     regex_matching decoder_match;           ///< Used for decoding phase
     regex_matching rule_match;              ///< Used for rules matching phase
     u_int8_t logbylevel;                    ///< Custom severity level for generate alerts 
+    w_logtest_shared_ruleset_t *shared_ruleset; ///< Decoders and CDB lists of the session, NULL if the session owns them
 
 } w_logtest_session_t;
 
@@ -215,6 +231,40 @@ w_logtest_session_t *w_logtest_initialize_session(OSList * list_msg);
  */
 void w_logtest_remove_session(char * token);
 
+/**
+ * @brief Load the decoders and CDB lists of a ruleset
+ *
+ * @param ruleset_config List files of ruleset
+ * @param decoderlist_forpname Decoder list to match logs which have a program name
+ * @param decoderlist_nopname Decoder list to match logs which haven't a program name
+ * @param decoder_store Decoder list to save internals decoders
+ * @param cdblistnode List of CDB lists
+ * @param list_msg list of \ref os_analysisd_log_msg_t for store messages
+ * @return true on success, otherwise return false
+ */
+bool w_logtest_load_decoders_lists(_Config * ruleset_config, OSDecoderNode ** decoderlist_forpname,
+                                   OSDecoderNode ** decoderlist_nopname, OSStore ** decoder_store,
+                                   ListNode ** cdblistnode, OSList * list_msg);
+
+/**
+ * @brief Get the shared decoders and CDB lists of a ruleset
+ *
+ * The current snapshot is reused if the decoder and list files did not change since it was loaded, otherwise
+ * a new snapshot replaces it. The caller must release the snapshot with w_logtest_shared_ruleset_release().
+ *
+ * @param ruleset_config List files of ruleset
+ * @param list_msg list of \ref os_analysisd_log_msg_t for store messages
+ * @return Snapshot of the decoders and CDB lists, NULL on failure
+ */
+w_logtest_shared_ruleset_t * w_logtest_shared_ruleset_get(_Config * ruleset_config, OSList * list_msg);
+
+/**
+ * @brief Release a reference to the shared decoders and CDB lists, and free them if it was the last one
+ *
+ * @param ruleset Snapshot to release
+ */
+void w_logtest_shared_ruleset_release(w_logtest_shared_ruleset_t * ruleset);
+
 /**
  * @brief Check the inactive logtest sessions
  *
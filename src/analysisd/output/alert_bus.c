@@ -0,0 +1,271 @@
+/* Copyright (C) 2015, Wazuh Inc.
+ * All rights reserved.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "shared.h"
+#include "os_net/os_net.h"
+#include "rules.h"
+#include "alert_bus.h"
+
+static alert_bus_subscriber_t **subscribers;
+static int subscribers_count;
+static pthread_mutex_t subscribers_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static void alert_bus_free_subscriber(alert_bus_subscriber_t *subscriber) {
+    if (subscriber->sock >= 0) {
+        close(subscriber->sock);
+    }
+
+    free_strarray(subscriber->groups);
+    os_free(subscriber->rule_ids);
+    os_free(subscriber);
+}
+
+int alert_bus_parse_filter(alert_bus_subscriber_t *subscriber, const char *filter) {
+    cJSON *root;
+    cJSON *item;
+    cJSON *element;
+    int i;
+
+    if (root = cJSON_Parse(filter), !cJSON_IsObject(root)) {
+        cJSON_Delete(root);
+        return -1;
+    }
+
+    if (item = cJSON_GetObjectItem(root, "level"), item) {
+        if (!cJSON_IsNumber(item) || item->valueint < 0) {
+            goto error;
+        }
+
+        subscriber->level = item->valueint;
+    }
+
+    if (item = cJSON_GetObjectItem(root, "groups"), item) {
+        if (!cJSON_IsArray(item)) {
+            goto error;
+        }
+
+        os_calloc(cJSON_GetArraySize(item) + 1, sizeof(char *), subscriber->groups);
+        i = 0;
+
+        cJSON_ArrayForEach(element, item) {
+            if (!cJSON_IsString(element)) {
+                goto error;
+            }
+
+            os_strdup(element->valuestring, subscriber->groups[i++]);
+        }
+    }
+
+    if (item = cJSON_GetObjectItem(root, "rule_ids"), item) {
+        if (!cJSON_IsArray(item)) {
+            goto error;
+        }
+
+        os_calloc(cJSON_GetArraySize(item) + 1, sizeof(int), subscriber->rule_ids);
+        i = 0;
+
+        cJSON_ArrayForEach(element, item) {
+            if (!cJSON_IsNumber(element)) {
+                goto error;
+            }
+
+            subscriber->rule_ids[i++] = element->valueint;
+        }
+
+        subscriber->rule_ids[i] = -1;
+    }
+
+    if (item = cJSON_GetObjectItem(root, "mail"), item) {
+        if (!cJSON_IsBool(item)) {
+            goto error;
+        }
+
+        subscriber->mail = cJSON_IsTrue(item);
+    }
+
+    cJSON_Delete(root);
+    return 0;
+
+error:
+    cJSON_Delete(root);
+    free_strarray(subscriber->groups);
+    subscriber->groups = NULL;
+    os_free(subscriber->rule_ids);
+    return -1;
+}
+
+bool alert_bus_match(const alert_bus_subscriber_t *subscriber, const Eventinfo *lf) {
+    const RuleInfo *rule = lf->generated_rule;
+    int i;
+
+    if (!rule) {
+        return false;
+    }
+
+    if (rule->level < 0 || (unsigned int)rule->level < subscriber->level) {
+        return false;
+    }
+
+    if (subscriber->mail && !(rule->alert_opts & DO_MAILALERT)) {
+        return false;
+    }
+
+    if (subscriber->rule_ids) {
+        for (i = 0; subscriber->rule_ids[i] != -1 && subscriber->rule_ids[i] != rule->sigid; i++);
+
+        if (subscriber->rule_ids[i] == -1) {
+            return false;
+        }
+    }
+
+    if (subscriber->groups) {
+        // The groups of the rule are separated by commas
+        const char *group = rule->group;
+
+        while (group && *group) {
+            size_t length = strcspn(group, ",");
+
+            for (i = 0; subscriber->groups[i]; i++) {
+                if (strlen(subscriber->groups[i]) == length && strncmp(subscriber->groups[i], group, length) == 0) {
+                    return true;
+                }
+            }
+
+            group += length;
+            group += *group == ',';
+        }
+
+        return false;
+    }
+
+    return true;
+}
+
+void alert_bus_publish(const Eventinfo *lf, const char *json_alert) {
+    size_t length = strlen(json_alert);
+    int i = 0;
+
+    w_mutex_lock(&subscribers_mutex);
+
+    while (i < subscribers_count) {
+        alert_bus_subscriber_t *subscriber = subscribers[i];
+
+        if (!alert_bus_match(subscriber, lf)) {
+            i++;
+            continue;
+        }
+
+        // Never block the writer thread on a slow subscriber
+        if (send(subscriber->sock, json_alert, length, MSG_DONTWAIT | MSG_NOSIGNAL) < 0) {
+            switch (errno) {
+            case EAGAIN:
+#if EAGAIN != EWOULDBLOCK
+            case EWOULDBLOCK:
+#endif
+            case EMSGSIZE:
+                if (subscriber->dropped++ == 0) {
+                    mwarn("Alert bus subscriber not keeping up, dropping alerts.");
+                }
+                break;
+
+            default:
+                mdebug1("Alert bus subscriber disconnected: %s (%d). Alerts dropped: %lu.", strerror(errno), errno, subscriber->dropped);
+                alert_bus_free_subscriber(subscriber);
+                subscribers[i] = subscribers[--subscribers_count];
+                continue;
+            }
+        }
+
+        i++;
+    }
+
+    w_mutex_unlock(&subscribers_mutex);
+}
+
+void * alert_bus_main(__attribute__((unused)) void * arg) {
+    int sock;
+    int peer;
+    char *buffer = NULL;
+    ssize_t length;
+    fd_set fdset;
+
+    if (sock = OS_BindUnixDomain(ALERT_BUS_SOCK, SOCK_SEQPACKET, OS_MAXSTR), sock < 0) {
+        merror("Unable to bind to socket '%s': (%d) '%s'", ALERT_BUS_SOCK, errno, strerror(errno));
+        return NULL;
+    }
+
+    if (listen(sock, 128) < 0) {
+        merror("Unable to listen on socket '%s': (%d) '%s'", ALERT_BUS_SOCK, errno, strerror(errno));
+        close(sock);
+        return NULL;
+    }
+
+    mdebug1("Alert bus thread ready");
+
+    os_malloc(OS_MAXSTR + 1, buffer);
+
+    while (1) {
+        alert_bus_subscriber_t *subscriber;
+
+        // Wait for socket
+        FD_ZERO(&fdset);
+        FD_SET(sock, &fdset);
+
+        switch (select(sock + 1, &fdset, NULL, NULL, NULL)) {
+        case -1:
+            if (errno != EINTR) {
+                merror_exit("At select(): '%s'", strerror(errno));
+            }
+            continue;
+        case 0:
+            continue;
+        }
+
+        if (peer = accept(sock, NULL, NULL), peer < 0) {
+            if (errno != EINTR) {
+                merror("At accept(): '%s'", strerror(errno));
+            }
+            continue;
+        }
+
+        // The filter is the first message of the subscriber
+        OS_SetRecvTimeout(peer, 1, 0);
+
+        if (length = recv(peer, buffer, OS_MAXSTR, 0), length <= 0) {
+            mdebug1("Alert bus subscriber did not send its filter.");
+            close(peer);
+            continue;
+        }
+
+        buffer[length] = '\0';
+        os_calloc(1, sizeof(alert_bus_subscriber_t), subscriber);
+        subscriber->sock = peer;
+
+        if (alert_bus_parse_filter(subscriber, buffer) < 0) {
+            mwarn("Invalid alert bus filter: '%.64s'", buffer);
+            alert_bus_free_subscriber(subscriber);
+            continue;
+        }
+
+        w_mutex_lock(&subscribers_mutex);
+        os_realloc(subscribers, (subscribers_count + 1) * sizeof(alert_bus_subscriber_t *), subscribers);
+        subscribers[subscribers_count++] = subscriber;
+        w_mutex_unlock(&subscribers_mutex);
+
+        mdebug1("New alert bus subscriber: '%.64s'", buffer);
+
+    #ifdef WAZUH_UNIT_TESTING
+        break;
+    #endif
+    }
+
+    os_free(buffer);
+    close(sock);
+    return NULL;
+}
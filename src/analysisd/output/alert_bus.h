@@ -0,0 +1,62 @@
+/* Copyright (C) 2015, Wazuh Inc.
+ * All rights reserved.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef ALERT_BUS_H
+#define ALERT_BUS_H
+
+#include "eventinfo.h"
+
+/* Alert bus subscriber. The filter is evaluated on the event before sending the alert */
+typedef struct alert_bus_subscriber_t {
+    int sock;
+    unsigned int level;     // Minimum rule level
+    char **groups;          // The rule must belong to any of these groups, NULL for any group
+    int *rule_ids;          // The rule must be any of these, terminated with -1. NULL for any rule
+    bool mail;              // Only rules with the mail alert option
+    unsigned long dropped;  // Alerts dropped because the subscriber was not keeping up
+} alert_bus_subscriber_t;
+
+/**
+ * @brief Thread accepting the subscribers of the alert bus.
+ *
+ * The subscribers connect to ALERT_BUS_SOCK (SOCK_SEQPACKET) and send their filter as the first message, a JSON
+ * object with the optional fields "level", "groups", "rule_ids" and "mail". Then every matching alert is sent
+ * to them as a message with the JSON alert.
+ */
+void * alert_bus_main(void * arg);
+
+/**
+ * @brief Send an alert to the subscribers whose filter matches it.
+ *
+ * The alerts are sent without blocking, a subscriber whose socket is full loses the alert.
+ *
+ * @param lf Event of the alert.
+ * @param json_alert Alert in JSON format, as written into alerts.json.
+ */
+void alert_bus_publish(const Eventinfo *lf, const char *json_alert);
+
+/**
+ * @brief Parse the filter of a subscriber.
+ *
+ * @param subscriber Subscriber to fill in.
+ * @param filter Filter in JSON format.
+ * @return 0 on success, -1 if the filter is invalid.
+ */
+int alert_bus_parse_filter(alert_bus_subscriber_t *subscriber, const char *filter);
+
+/**
+ * @brief Check whether an event matches the filter of a subscriber.
+ *
+ * @param subscriber Subscriber.
+ * @param lf Event with the generated rule.
+ * @return true if the alert must be sent to the subscriber.
+ */
+bool alert_bus_match(const alert_bus_subscriber_t *subscriber, const Eventinfo *lf);
+
+#endif /* ALERT_BUS_H */
@@ -11,6 +11,7 @@
 #include "jsonout.h"
 #include "alerts/getloglocation.h"
 #include "format/to_json.h"
+#include "alert_bus.h"
 
 void jsonout_output_event(const Eventinfo *lf)
 {
@@ -22,6 +23,7 @@ void jsonout_output_event(const Eventinfo *lf)
     if (strstr(json_alert,"gcp")) {
         mdebug2("Sending gcp event: %s", json_alert);
     }
+    alert_bus_publish(lf, json_alert);
     free(json_alert);
     return;
 }
@@ -35,7 +35,7 @@ static pthread_mutex_t do_diff_mutex = PTHREAD_MUTEX_INITIALIZER;
 /* Hourly alerts mutex */
 extern pthread_mutex_t hourly_alert_mutex;
 
-w_queue_t * writer_queue_log_fts;
+w_mpmc_queue_t * writer_queue_log_fts;
 
 EventList *os_analysisd_last_events;
 
@@ -50,7 +50,6 @@ STATIC int getattributes(char **attributes, char **values, int *id, int *level,
                          int *maxsize, int *timeframe, int *frequency,
                          int *accuracy, int *noalert, int *ignore_time,
                          int *overwrite, OSList* log_msg);
-STATIC int doesRuleExist(int sid, RuleNode *r_node);
 STATIC void Rule_AddAR(RuleInfo *config_rule);
 STATIC char *loadmemory(char *at, const char *str, OSList* log_msg);
 STATIC void printRuleinfo(const RuleInfo *rule, int node);
@@ -97,12 +96,51 @@ void Rules_OP_CreateRules() {
 
 }
 
+char * Rules_OP_GetRulePath(const char *rulefile)
+{
+    char * rulepath = NULL;
+    size_t i;
+
+    /* If no directory in the rulefile, add the default */
+    if ((strchr(rulefile, '/')) == NULL) {
+        /* Build the rule file name + path */
+        i = strlen(RULEPATH) + strlen(rulefile) + 2;
+        rulepath = (char *)calloc(i, sizeof(char));
+        if (!rulepath) {
+            merror_exit(MEM_ERROR, errno, strerror(errno));
+        }
+        snprintf(rulepath, i, "%s/%s", RULEPATH, rulefile);
+    } else {
+        os_strdup(rulefile, rulepath);
+        mdebug1("%s is the rulefile", rulefile);
+        mdebug1("Not modifing the rule path");
+    }
+
+    return rulepath;
+}
+
 int Rules_OP_ReadRules(const char *rulefile, RuleNode **r_node, ListNode **l_node,
                        EventList **last_event_list, OSStore **decoder_list, OSList* log_msg)
 {
-    OS_XML xml;
+    OS_XML_FILE xml_file = { .file = NULL };
+    char * rulepath = Rules_OP_GetRulePath(rulefile);
+    int retval;
+
+    xml_file.file = rulepath;
+    OS_ReadXMLFile(&xml_file);
+    retval = Rules_OP_ReadParsedRules(rulefile, &xml_file, r_node, l_node, last_event_list, decoder_list, log_msg);
+
+    os_free(rulepath);
+    return retval;
+}
+
+int Rules_OP_ReadParsedRules(const char *rulefile, OS_XML_FILE *xml_file, RuleNode **r_node, ListNode **l_node,
+                             EventList **last_event_list, OSStore **decoder_list, OSList* log_msg)
+{
+    OS_XML *xml = &xml_file->xml;
     XML_NODE node = NULL;
     XML_NODE rule = NULL;
+    OSHash *sid_index = NULL;
 
     int retval = -1;
 
@@ -226,36 +264,19 @@ int Rules_OP_ReadRules(const char *rulefile, RuleNode **r_node, ListNode **l_nod
 
     rules_tmp_params_t rule_tmp_params = {0};
     RuleInfo * config_ruleinfo = NULL;
-    char * rulepath = NULL;
+    const char * rulepath = xml_file->file;
 
-    size_t i;
+    size_t i = 0;
     default_timeframe = 360;
 
-    /* If no directory in the rulefile, add the default */
-    if ((strchr(rulefile, '/')) == NULL) {
-        /* Build the rule file name + path */
-        i = strlen(RULEPATH) + strlen(rulefile) + 2;
-        rulepath = (char *)calloc(i, sizeof(char));
-        if (!rulepath) {
-            merror_exit(MEM_ERROR, errno, strerror(errno));
-        }
-        snprintf(rulepath, i, "%s/%s", RULEPATH, rulefile);
-    } else {
-        os_strdup(rulefile, rulepath);
-        mdebug1("%s is the rulefile", rulefile);
-        mdebug1("Not modifing the rule path");
-    }
-
-    i = 0;
-
-    /* Read the XML */
-    switch(OS_ReadXML(rulepath, &xml)) {
+    /* Check the result of reading the XML */
+    switch(xml_file->result) {
         case -2:
-            smwarn(log_msg, FOPEN_ERROR, rulepath, errno, strerror(errno));
+            smwarn(log_msg, FOPEN_ERROR, rulepath, xml_file->error, strerror(xml_file->error));
             retval = 0;
             goto cleanup;
         case -1:
-            smerror(log_msg, XML_ERROR, rulepath, xml.err, xml.err_line);
+            smerror(log_msg, XML_ERROR, rulepath, xml->err, xml->err_line);
             goto cleanup;
         case 0:
         default:
@@ -264,8 +285,8 @@ int Rules_OP_ReadRules(const char *rulefile, RuleNode **r_node, ListNode **l_nod
     mdebug2("Read xml for rule.");
 
     /* Apply any variable found */
-    if (OS_ApplyVariables(&xml) != 0) {
-        smerror(log_msg, XML_ERROR_VAR, rulepath, xml.err);
+    if (OS_ApplyVariables(xml) != 0) {
+        smerror(log_msg, XML_ERROR_VAR, rulepath, xml->err);
         goto cleanup;
     }
     mdebug2("XML Variables applied.");
@@ -277,16 +298,12 @@ int Rules_OP_ReadRules(const char *rulefile, RuleNode **r_node, ListNode **l_nod
     }
 
     /* Get the root elements */
-    node = OS_GetElementsbyNode(&xml, NULL);
+    node = OS_GetElementsbyNode(xml, NULL);
     if (!node) {
         smerror(log_msg, CONFIG_ERROR, rulepath);
         goto cleanup;
     }
 
-    /* Zero the rule memory -- not used anymore */
-    free(rulepath);
-    rulepath = NULL;
-
     /* Get default time frame */
     default_timeframe = getDefine_Int("analysisd",
                                       "default_timeframe",
@@ -314,13 +331,16 @@ int Rules_OP_ReadRules(const char *rulefile, RuleNode **r_node, ListNode **l_nod
         i++;
     }
 
+    /* Index the rules already loaded by ID */
+    sid_index = OS_CreateRuleIndex(*r_node);
+
     /* Get the rules */
     i = 0;
     while (node[i]) {
         int j = 0;
 
         /* Get all rules for a global group */
-        rule = OS_GetElementsbyNode(&xml, node[i]);
+        rule = OS_GetElementsbyNode(xml, node[i]);
         if (rule == NULL) {
             smerror(log_msg, "Group '%s' without any rule.", node[i]->element);
             goto cleanup;
@@ -368,7 +388,7 @@ int Rules_OP_ReadRules(const char *rulefile, RuleNode **r_node, ListNode **l_nod
                     goto cleanup;
                 }
 
-                if (doesRuleExist(id, *r_node)) {
+                if (OS_RuleIndexHas(sid_index, id)) {
                     // If rule exists but 'overwrite' was not set to 'yes', then the rule is skipped.
                     if (overwrite != 1) {
                         smwarn(log_msg, ANALYSISD_DUPLICATED_SIG_ID, id);
@@ -470,7 +490,7 @@ int Rules_OP_ReadRules(const char *rulefile, RuleNode **r_node, ListNode **l_nod
 
                 memset(&rule_tmp_params, 0, sizeof(rules_tmp_params_t));
 
-                rule_tmp_params.rule_arr_opt =  OS_GetElementsbyNode(&xml, rule[j]);
+                rule_tmp_params.rule_arr_opt =  OS_GetElementsbyNode(xml, rule[j]);
                 if (rule_tmp_params.rule_arr_opt == NULL) {
                     smerror(log_msg, "Rule '%d' without any option. It may lead to false positives and some "
                            "other problems for the system. Exiting.", config_ruleinfo->sigid);
@@ -1466,7 +1486,7 @@ int Rules_OP_ReadRules(const char *rulefile, RuleNode **r_node, ListNode **l_nod
                         int l;
                         XML_NODE mitre_opt = NULL;
 
-                        mitre_opt = OS_GetElementsbyNode(&xml, rule_tmp_params.rule_arr_opt[k]);
+                        mitre_opt = OS_GetElementsbyNode(xml, rule_tmp_params.rule_arr_opt[k]);
 
                         if (mitre_opt == NULL) {
                             smwarn(log_msg, "Empty Mitre information for rule '%d'", config_ruleinfo->sigid);
@@ -1905,12 +1925,13 @@ int Rules_OP_ReadRules(const char *rulefile, RuleNode **r_node, ListNode **l_nod
              */
             if (config_ruleinfo->sigid < 10) {
                 OS_AddRule(config_ruleinfo, r_node);
+                OS_RuleIndexAdd(sid_index, config_ruleinfo->sigid);
             } else if (config_ruleinfo->alert_opts & DO_OVERWRITE) {
 
                 if (!OS_AddRuleInfo(*r_node, config_ruleinfo, config_ruleinfo->sigid, log_msg)) {
 
                     // If there is no rule to overwrite, then the rule is added as any other rule
-                    if (OS_AddChild(config_ruleinfo, r_node, log_msg) == -1) {
+                    if (OS_AddIndexedChild(config_ruleinfo, r_node, sid_index, log_msg) == -1) {
                         // Skip rule, without having to abort analysisd execution
                         os_remove_ruleinfo(config_ruleinfo);
                         config_ruleinfo = NULL;
@@ -1919,7 +1940,7 @@ int Rules_OP_ReadRules(const char *rulefile, RuleNode **r_node, ListNode **l_nod
                 }
             } else {
 
-                if (OS_AddChild(config_ruleinfo, r_node, log_msg) == -1) {
+                if (OS_AddIndexedChild(config_ruleinfo, r_node, sid_index, log_msg) == -1) {
                     // Skip rule, without having to abort analysisd execution
                     os_remove_ruleinfo(config_ruleinfo);
                     config_ruleinfo = NULL;
@@ -1938,6 +1959,7 @@ int Rules_OP_ReadRules(const char *rulefile, RuleNode **r_node, ListNode **l_nod
                 !(config_ruleinfo->alert_opts & DO_OVERWRITE)) {
 
                 config_ruleinfo->event_search = (void *(*)(void *, void *, void *, void *)) Search_LastSids;
+                config_ruleinfo->correlation = w_correlation_init(config_ruleinfo->timeframe);
 
                 /* Mark rules that match this id */
                 OS_MarkID(*r_node, config_ruleinfo);
@@ -1952,6 +1974,8 @@ int Rules_OP_ReadRules(const char *rulefile, RuleNode **r_node, ListNode **l_nod
                     merror_exit(MEM_ERROR, errno, strerror(errno));
                 }
 
+                config_ruleinfo->correlation = w_correlation_init(config_ruleinfo->timeframe);
+
                 /* Mark rules that match this group */
                 OS_MarkGroup(*r_node, config_ruleinfo);
 
@@ -1998,7 +2022,6 @@ int Rules_OP_ReadRules(const char *rulefile, RuleNode **r_node, ListNode **l_nod
 
 cleanup:
 
-    os_free(rulepath);
     OS_ClearNode(rule);
     w_free_rules_tmp_params(&rule_tmp_params);
 
@@ -2006,9 +2029,13 @@ cleanup:
         os_remove_ruleinfo(config_ruleinfo);
     }
 
+    if (sid_index != NULL) {
+        OSHash_Free(sid_index);
+    }
+
     /* Clean global node */
     OS_ClearNode(node);
-    OS_ClearXML(&xml);
+    OS_ClearXML(xml);
 
     return retval;
 }
@@ -2178,6 +2205,10 @@ RuleInfo *zerorulemember(int id, int level, int maxsize, int frequency,
     ruleinfo_pt->sid_search = NULL;
     ruleinfo_pt->group_search = NULL;
 
+    ruleinfo_pt->sid_searchers = NULL;
+    ruleinfo_pt->group_searchers = NULL;
+    ruleinfo_pt->correlation = NULL;
+
     ruleinfo_pt->event_search = NULL;
     ruleinfo_pt->compiled_rule = NULL;
     ruleinfo_pt->lists = NULL;
@@ -2540,31 +2571,6 @@ int _setlevels(RuleNode *node, int nnode)
     return (l_size);
 }
 
-/* Test if a rule id exists
- * return 1 if exists, otherwise 0
- */
-STATIC int doesRuleExist(int sid, RuleNode *r_node)
-{
-    while (r_node) {
-        /* Check if the sigid matches */
-        if (r_node->ruleinfo->sigid == sid) {
-            return (1);
-        }
-
-        /* Check if the rule has a child */
-        if (r_node->child) {
-            /* Check recursively */
-            if (doesRuleExist(sid, r_node->child)) {
-                return (1);
-            }
-        }
-
-        /* Go to the next rule */
-        r_node = r_node->next;
-    }
-
-    return (0);
-}
 
 /* Checks if the current_rule matches the event information */
 RuleInfo * OS_CheckIfRuleMatch(struct _Eventinfo *lf, EventList *last_events,
@@ -2916,7 +2922,7 @@ RuleInfo * OS_CheckIfRuleMatch(struct _Eventinfo *lf, EventList *last_events,
 
             if (_line && save_fts_value) {
                 os_strdup(_line, _line_cpy);
-                if (queue_push_ex_block(writer_queue_log_fts, _line_cpy) < 0) {
+                if (mpmc_queue_push_block(writer_queue_log_fts, _line_cpy) < 0) {
                     os_free(_line_cpy);
                 }
             }
@@ -3100,10 +3106,13 @@ RuleInfo * OS_CheckIfRuleMatch(struct _Eventinfo *lf, EventList *last_events,
     /* Search for dependent rules */
     if (curr_node->child) {
         RuleNode *child_node = curr_node->child;
+        RuleNode **children = NULL;
         RuleInfo *child_rule = NULL;
+        bool trace_children = rules_debug_list != NULL;
 #ifdef TESTRULE
         if (full_output && !alert_only) {
             print_out("       *Trying child rules.");
+            trace_children = true;
         }
 #endif
 
@@ -3111,6 +3120,13 @@ RuleInfo * OS_CheckIfRuleMatch(struct _Eventinfo *lf, EventList *last_events,
             cJSON_AddItemToArray(rules_debug_list, cJSON_CreateString(RULES_DEBUG_MSG_III));
         }
 
+        /* Skip the children decoded as another decoder, unless every child tried is reported */
+        if (curr_node->children_index && !trace_children) {
+            children = OS_GetRuleChildren(curr_node, lf->decoder_syscheck_id != 0 ?
+                                          lf->decoder_syscheck_id : lf->decoder_info->id);
+            child_node = *children;
+        }
+
         while (child_node) {
             child_rule = OS_CheckIfRuleMatch(lf, last_events, cdblists,
                                              child_node, rule_match, fts_list,
@@ -3123,7 +3139,7 @@ RuleInfo * OS_CheckIfRuleMatch(struct _Eventinfo *lf, EventList *last_events,
                 return (child_rule);
             }
 
-            child_node = child_node->next;
+            child_node = children ? *(++children) : child_node->next;
         }
     }
 
@@ -18,6 +18,7 @@
 #include "active-response.h"
 #include "lists.h"
 #include "logmsg.h"
+#include "correlation.h"
 
 
 /* Event fields - stored on a u_int32_t */
@@ -156,6 +157,14 @@ typedef struct _RuleInfo {
     /* Pointer to group_prev_matched */
     OSList *group_search;
 
+    /* Rules that search the lists of sid_prev_matched (NULL-terminated)
+     * and group_prev_matched (same positions) */
+    struct _RuleInfo **sid_searchers;
+    struct _RuleInfo **group_searchers;
+
+    /* Index of the previous matches by the same_* fields (if_matched_sid and if_matched_group) */
+    w_correlation_t *correlation;
+
     /* Function pointer to the event_search */
     void *(*event_search)(void *lf, void *os_analysisd_last_events, void *rule, void *rule_match);
 
@@ -250,10 +259,28 @@ typedef struct _rules_tmp_params_t {
 
 } rules_tmp_params_t;
 
+/**
+ * @brief Children of a rule that can match the events of a decoder
+ */
+typedef struct rule_decoder_children_t {
+    u_int16_t decoder_id;          ///< Decoder of the events
+    struct _RuleNode ** children;  ///< NULL-terminated list, in the order of the rule tree
+} rule_decoder_children_t;
+
+/**
+ * @brief Index of the children of a rule by the decoder of the event (decoded_as)
+ */
+typedef struct rule_children_index_t {
+    struct _RuleNode ** generic;          ///< Children without decoded_as, for the decoders not in the index
+    rule_decoder_children_t * decoders;   ///< Children for each decoder, sorted by decoder_id
+    size_t decoders_size;                 ///< Number of decoders
+} rule_children_index_t;
+
 typedef struct _RuleNode {
     RuleInfo *ruleinfo;
     struct _RuleNode *next;
     struct _RuleNode *child;
+    rule_children_index_t *children_index; ///< Index of the children by decoder, NULL if they aren't indexed
 } RuleNode;
 
 /**
@@ -264,7 +291,7 @@ extern RuleNode *os_analysisd_rulelist;
 /**
  * @brief FTS log writer queue
  */
-extern w_queue_t * writer_queue_log_fts;
+extern w_mpmc_queue_t * writer_queue_log_fts;
 
 /**
  * @brief Structure to save the last list of events.
@@ -327,6 +354,42 @@ int OS_AddRule(RuleInfo *read_rule, RuleNode **r_node);
  */
 int OS_AddChild(RuleInfo *read_rule, RuleNode **r_node, OSList* log_msg);
 
+/**
+ * @brief Add rule information as a child, looking up the if_sid parents in an index of the rule IDs.
+ * @param read_rule rule information.
+ * @param r_node node to add as a child rule information.
+ * @param sid_index index created with OS_CreateRuleIndex() for r_node. The rule is added to it.
+ * @param log_msg List to save log messages.
+ * @retval -1 Critical errors.
+ * @retval  0 successful.
+ */
+int OS_AddIndexedChild(RuleInfo *read_rule, RuleNode **r_node, OSHash *sid_index, OSList* log_msg);
+
+/**
+ * @brief Create the index of the rule IDs of a rule list, to add rules without walking the whole list.
+ *
+ * Every rule ID is mapped to its first node in depth-first order, the one used as parent by if_sid.
+ * The index is valid while the rules are only added through OS_AddRule() and OS_AddIndexedChild().
+ * @param r_node rule list.
+ * @return index, to be freed with OSHash_Free().
+ */
+OSHash * OS_CreateRuleIndex(RuleNode *r_node);
+
+/**
+ * @brief Check if a rule ID is in the index.
+ * @param sid_index index created with OS_CreateRuleIndex().
+ * @param sid rule ID.
+ * @return true if the rule exists.
+ */
+bool OS_RuleIndexHas(OSHash *sid_index, int sid);
+
+/**
+ * @brief Add a rule ID to the index after adding its rule to the list.
+ * @param sid_index index created with OS_CreateRuleIndex().
+ * @param sid rule ID.
+ */
+void OS_RuleIndexAdd(OSHash *sid_index, int sid);
+
 /**
  * @brief Add an overwrite rule.
  * @param r_node node to look for the original rule and replace it
@@ -396,8 +459,49 @@ void Rules_OP_CreateRules(void);
 int Rules_OP_ReadRules(const char *rulefile, RuleNode **r_node, ListNode **l_node,
                        EventList **last_event_list, OSStore **decoder_list, OSList* log_msg);
 
+/**
+ * @brief Save the rules of an already parsed file in r_node
+ * @param rulefile file name, as passed to Rules_OP_ReadRules()
+ * @param xml_file file parsed with OS_ReadXMLFile() or OS_ReadXMLFiles(). Its XML is cleared
+ * @param r_node reference to the rule list
+ * @param l_node reference to the first list of the cdb lists
+ * @param last_event_list reference to first node to the previous events list
+ * @param log_msg List to save log messages.
+ * @return 0 on success, otherwise -1
+ */
+int Rules_OP_ReadParsedRules(const char *rulefile, OS_XML_FILE *xml_file, RuleNode **r_node, ListNode **l_node,
+                             EventList **last_event_list, OSStore **decoder_list, OSList* log_msg);
+
+/**
+ * @brief Get the path of a rules file, relative to RULEPATH if it has no directory
+ * @param rulefile file name
+ * @return allocated path
+ */
+char * Rules_OP_GetRulePath(const char *rulefile);
+
 int AddHash_Rule(RuleNode *node);
 
+/**
+ * @brief Index the children of every rule of the tree by decoded_as, so only the children that can match the
+ *        decoder of an event are tried. Must be called once all the rules are loaded.
+ * @param node first node of the rule list
+ */
+void OS_IndexRules(RuleNode *node);
+
+/**
+ * @brief Get the children of a rule that can match the events of a decoder
+ * @param node indexed rule node
+ * @param decoder_id decoder of the event
+ * @return NULL-terminated list of children, in the order of the rule tree
+ */
+RuleNode ** OS_GetRuleChildren(const RuleNode *node, u_int16_t decoder_id);
+
+/**
+ * @brief Free the index of the children of a rule
+ * @param node rule node
+ */
+void os_remove_children_index(RuleNode *node);
+
 int _setlevels(RuleNode *node, int nnode);
 
 int doDiff(RuleInfo *rule, struct _Eventinfo *lf);
@@ -21,10 +21,23 @@
 #endif
 
 
+/* Minimum number of children of a rule to index them */
+#define RULE_INDEX_MIN_CHILDREN 8
+
+/* Rows of the index of the rule IDs */
+#define RULE_INDEX_SIZE 4096
+
 /* _OS_Addrule: Internal AddRule */
 STATIC RuleNode *_OS_AddRule(RuleNode *_rulenode, RuleInfo *read_rule);
 STATIC int _AddtoRule(int sid, int level, int none, const char *group,
                RuleNode *r_node, RuleInfo *read_rule);
+STATIC rule_children_index_t * _OS_IndexChildren(RuleNode *child);
+STATIC int _OS_AddChild(RuleInfo *read_rule, RuleNode **r_node, OSHash *sid_index, OSList* log_msg);
+STATIC RuleNode * _OS_FindRuleNode(int sid, RuleNode *r_node);
+STATIC void _OS_IndexRuleNodes(OSHash *sid_index, RuleNode *r_node);
+
+/* Value of the rule IDs added to the index whose first node hasn't been looked up yet */
+static RuleNode rule_node_unresolved;
 
 
 RuleNode *os_analysisd_rulelist;
@@ -120,8 +133,116 @@ STATIC int _AddtoRule(int sid, int level, int none, const char *group,
     return (r_code);
 }
 
+/* Search the first node of a rule, in the same order as _AddtoRule() */
+STATIC RuleNode * _OS_FindRuleNode(int sid, RuleNode *r_node)
+{
+    RuleNode *found;
+
+    while (r_node) {
+        if (r_node->ruleinfo->sigid == sid) {
+            return r_node;
+        }
+
+        if (r_node->child && (found = _OS_FindRuleNode(sid, r_node->child), found)) {
+            return found;
+        }
+
+        r_node = r_node->next;
+    }
+
+    return NULL;
+}
+
+/* Add the first node of every rule to the index */
+STATIC void _OS_IndexRuleNodes(OSHash *sid_index, RuleNode *r_node)
+{
+    char key[OS_SIZE_32];
+
+    for (; r_node; r_node = r_node->next) {
+        snprintf(key, sizeof(key), "%d", r_node->ruleinfo->sigid);
+
+        // OSHash_Add() keeps the node found first
+        OSHash_Add(sid_index, key, r_node);
+
+        if (r_node->child) {
+            _OS_IndexRuleNodes(sid_index, r_node->child);
+        }
+    }
+}
+
+OSHash * OS_CreateRuleIndex(RuleNode *r_node)
+{
+    OSHash *sid_index = OSHash_Create();
+
+    if (sid_index == NULL || !OSHash_setSize(sid_index, RULE_INDEX_SIZE)) {
+        merror_exit(MEM_ERROR, errno, strerror(errno));
+    }
+
+    _OS_IndexRuleNodes(sid_index, r_node);
+    return sid_index;
+}
+
+bool OS_RuleIndexHas(OSHash *sid_index, int sid)
+{
+    char key[OS_SIZE_32];
+
+    snprintf(key, sizeof(key), "%d", sid);
+    return OSHash_Get(sid_index, key) != NULL;
+}
+
+void OS_RuleIndexAdd(OSHash *sid_index, int sid)
+{
+    char key[OS_SIZE_32];
+
+    snprintf(key, sizeof(key), "%d", sid);
+    OSHash_Add(sid_index, key, &rule_node_unresolved);
+}
+
+/* Add a rule as a child of the first node of the rule sid, looked up in the index */
+STATIC int _AddtoIndexedRule(int sid, RuleNode *r_node, OSHash *sid_index, RuleInfo *read_rule)
+{
+    char key[OS_SIZE_32];
+    RuleNode *parent;
+
+    snprintf(key, sizeof(key), "%d", sid);
+
+    if (parent = OSHash_Get(sid_index, key), parent == NULL) {
+        return 0;
+    }
+
+    /* The nodes of a rule are created at once, and the later ones never
+     * go before them, so the first node can be cached after searching it
+     */
+    if (parent == &rule_node_unresolved) {
+        if (parent = _OS_FindRuleNode(sid, r_node), parent == NULL) {
+            return 0;
+        }
+
+        OSHash_Update(sid_index, key, parent);
+    }
+
+    read_rule->category = parent->ruleinfo->category;
+    parent->child = _OS_AddRule(parent->child, read_rule);
+    return 1;
+}
+
 /* Add a child */
 int OS_AddChild(RuleInfo *read_rule, RuleNode **r_node, OSList* log_msg)
+{
+    return _OS_AddChild(read_rule, r_node, NULL, log_msg);
+}
+
+int OS_AddIndexedChild(RuleInfo *read_rule, RuleNode **r_node, OSHash *sid_index, OSList* log_msg)
+{
+    if (_OS_AddChild(read_rule, r_node, sid_index, log_msg) == -1) {
+        return -1;
+    }
+
+    OS_RuleIndexAdd(sid_index, read_rule->sigid);
+    return 0;
+}
+
+STATIC int _OS_AddChild(RuleInfo *read_rule, RuleNode **r_node, OSHash *sid_index, OSList* log_msg)
 {
     if (read_rule == NULL) {
         smwarn(log_msg, ANALYSISD_NULL_RULE);
@@ -147,7 +268,10 @@ int OS_AddChild(RuleInfo *read_rule, RuleNode **r_node, OSList* log_msg)
 
                     int if_sid_rule_id = atoi(sid_ptr);
 
-                    if (_AddtoRule(if_sid_rule_id, 0, 0, NULL, *r_node, read_rule) == 0) {
+                    int added = sid_index ? _AddtoIndexedRule(if_sid_rule_id, *r_node, sid_index, read_rule)
+                                          : _AddtoRule(if_sid_rule_id, 0, 0, NULL, *r_node, read_rule);
+
+                    if (added == 0) {
                         if (read_rule->if_matched_sid != 0) {
                             // if_matched_sid is not a list of sid, but a single sid
                             smwarn(log_msg, ANALYSISD_SIG_ID_NOT_FOUND_MID, if_sid_rule_id, read_rule->sigid);
@@ -295,6 +419,12 @@ int OS_AddRuleInfo(RuleNode *r_node, RuleInfo *newrule, int sid, OSList* log_msg
             r_node->ruleinfo->maxsize = newrule->maxsize;
             r_node->ruleinfo->frequency = newrule->frequency;
             r_node->ruleinfo->timeframe = newrule->timeframe;
+
+            /* The buckets of the index depend on the timeframe */
+            if (r_node->ruleinfo->correlation) {
+                w_correlation_free(r_node->ruleinfo->correlation);
+                r_node->ruleinfo->correlation = w_correlation_init(r_node->ruleinfo->timeframe);
+            }
             r_node->ruleinfo->context = newrule->context;
 
             r_node->ruleinfo->ignore_time = newrule->ignore_time;
@@ -511,6 +641,7 @@ int OS_MarkID(RuleNode *r_node, RuleInfo *orig_rule)
 
             /* Assign the parent pointer to it */
             orig_rule->sid_search = r_node->ruleinfo->sid_prev_matched;
+            w_correlation_add_sid_searcher(r_node->ruleinfo, orig_rule);
         }
 
         /* Check if the child has a rule */
@@ -550,6 +681,13 @@ int OS_MarkGroup(RuleNode *r_node, RuleInfo *orig_rule)
             r_node->ruleinfo->group_prev_matched[rule_g] = NULL;
             r_node->ruleinfo->group_prev_matched[rule_g + 1] = NULL;
 
+            os_realloc(r_node->ruleinfo->group_searchers,
+                       (rule_g + 2)*sizeof(RuleInfo *),
+                       r_node->ruleinfo->group_searchers);
+
+            r_node->ruleinfo->group_searchers[rule_g] = orig_rule;
+            r_node->ruleinfo->group_searchers[rule_g + 1] = NULL;
+
             /* Set the size */
             r_node->ruleinfo->group_prev_matched_sz = rule_g + 1;
 
@@ -601,6 +739,8 @@ void os_remove_rulenode(RuleNode *node, RuleInfo **rules, int *pos, int *max_siz
         tmp = node;
         node = node->next;
 
+        os_remove_children_index(tmp);
+
         if (tmp->ruleinfo->internal_saving == false && *pos <= *max_size) {
 
             tmp->ruleinfo->internal_saving = true;
@@ -627,6 +767,9 @@ void os_remove_ruleinfo(RuleInfo *ruleinfo) {
 
     os_free(ruleinfo->sid_prev_matched);
     os_free(ruleinfo->group_prev_matched);
+    os_free(ruleinfo->sid_searchers);
+    os_free(ruleinfo->group_searchers);
+    w_correlation_free(ruleinfo->correlation);
 
     os_free(ruleinfo->group);
     w_free_expression_t(&ruleinfo->match);
@@ -718,3 +861,148 @@ void os_count_rules(RuleNode *node, int *num_rules) {
         node = node->next;
     }
 }
+
+void OS_IndexRules(RuleNode *node) {
+
+    while (node) {
+
+        if (node->child) {
+            OS_IndexRules(node->child);
+
+            os_remove_children_index(node);
+            node->children_index = _OS_IndexChildren(node->child);
+        }
+
+        node = node->next;
+    }
+}
+
+static int _OS_CompareDecoders(const void *a, const void *b) {
+    const u_int16_t id_a = *(const u_int16_t *)a;
+    const u_int16_t id_b = *(const u_int16_t *)b;
+
+    return (id_a > id_b) - (id_a < id_b);
+}
+
+/* Index the children of a rule by decoded_as. A child with decoded_as only
+ * matches the events of that decoder, the others can match any event.
+ */
+STATIC rule_children_index_t * _OS_IndexChildren(RuleNode *child) {
+
+    rule_children_index_t *index = NULL;
+    u_int16_t *decoders = NULL;
+    size_t num_children = 0;
+    size_t num_decoders = 0;
+    size_t num_generic = 0;
+    size_t i;
+    size_t j;
+    RuleNode *node;
+
+    for (node = child; node; node = node->next) {
+        num_children++;
+    }
+
+    /* Short lists are cheaper to walk */
+    if (num_children < RULE_INDEX_MIN_CHILDREN) {
+        return NULL;
+    }
+
+    os_calloc(num_children, sizeof(u_int16_t), decoders);
+
+    for (node = child; node; node = node->next) {
+        if (node->ruleinfo->decoded_as) {
+            decoders[num_decoders++] = node->ruleinfo->decoded_as;
+        } else {
+            num_generic++;
+        }
+    }
+
+    /* Nothing to skip */
+    if (num_decoders == 0) {
+        os_free(decoders);
+        return NULL;
+    }
+
+    /* Remove duplicates */
+    qsort(decoders, num_decoders, sizeof(u_int16_t), _OS_CompareDecoders);
+
+    for (i = 1, j = 1; i < num_decoders; i++) {
+        if (decoders[i] != decoders[j - 1]) {
+            decoders[j++] = decoders[i];
+        }
+    }
+
+    num_decoders = j;
+
+    os_calloc(1, sizeof(rule_children_index_t), index);
+    os_calloc(num_generic + 1, sizeof(RuleNode *), index->generic);
+    os_calloc(num_decoders, sizeof(rule_decoder_children_t), index->decoders);
+    index->decoders_size = num_decoders;
+
+    for (node = child, j = 0; node; node = node->next) {
+        if (!node->ruleinfo->decoded_as) {
+            index->generic[j++] = node;
+        }
+    }
+
+    for (i = 0; i < num_decoders; i++) {
+        size_t size = num_generic;
+
+        for (node = child; node; node = node->next) {
+            if (node->ruleinfo->decoded_as == decoders[i]) {
+                size++;
+            }
+        }
+
+        index->decoders[i].decoder_id = decoders[i];
+        os_calloc(size + 1, sizeof(RuleNode *), index->decoders[i].children);
+
+        for (node = child, j = 0; node; node = node->next) {
+            if (!node->ruleinfo->decoded_as || node->ruleinfo->decoded_as == decoders[i]) {
+                index->decoders[i].children[j++] = node;
+            }
+        }
+    }
+
+    os_free(decoders);
+
+    return index;
+}
+
+RuleNode ** OS_GetRuleChildren(const RuleNode *node, u_int16_t decoder_id) {
+
+    const rule_children_index_t *index = node->children_index;
+    size_t low = 0;
+    size_t high = index->decoders_size;
+
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+
+        if (index->decoders[middle].decoder_id == decoder_id) {
+            return index->decoders[middle].children;
+        } else if (index->decoders[middle].decoder_id < decoder_id) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    return index->generic;
+}
+
+void os_remove_children_index(RuleNode *node) {
+
+    rule_children_index_t *index = node->children_index;
+
+    if (!index) {
+        return;
+    }
+
+    for (size_t i = 0; i < index->decoders_size; i++) {
+        os_free(index->decoders[i].children);
+    }
+
+    os_free(index->decoders);
+    os_free(index->generic);
+    os_free(node->children_index);
+}
@@ -34,6 +34,12 @@
 /** Internal Functions **/
 void OS_ReadMSG(char *ut_str);
 
+// Print the time spent on the events read
+static void print_benchmark(unsigned long events, double decode_time, double free_time, double total_time);
+
+/* Benchmark mode: measure the events without printing them */
+static int benchmark;
+
 // Cleanup at exit
 static void onexit();
 
@@ -46,7 +52,7 @@ static void help_logtest(char * home_path)
 {
     print_header();
     print_out("\nSince Wazuh v4.1.0 this binary is deprecated. Use wazuh-logtest instead\n");
-    print_out("  %s: -[Vhdtva] [-c config] [-D dir] [-U rule:alert:decoder]", ARGV0);
+    print_out("  %s: -[Vhdtvab] [-c config] [-D dir] [-U rule:alert:decoder]", ARGV0);
     print_out("    -V          Version and license message");
     print_out("    -h          This help message");
     print_out("    -d          Execute in debug mode. This parameter");
@@ -55,6 +61,7 @@ static void help_logtest(char * home_path)
     print_out("    -t          Test configuration");
     print_out("    -a          Alerts output");
     print_out("    -v          Verbose (full) output/rule debugging");
+    print_out("    -b          Benchmark. Print only the time spent decoding and releasing the events");
     print_out("    -c <config> Configuration file to use (default: %s)", OSSECCONF);
     print_out("    -D <dir>    Directory to chroot into (default: %s)", home_path);
     print_out("    -U <rule:alert:decoder>  Unit test. Refer to contrib/ossec-testing/runtests.py");
@@ -97,7 +104,7 @@ int main(int argc, char **argv)
     geoipdb = NULL;
 #endif
 
-    while ((c = getopt(argc, argv, "VatvdhU:D:c:q")) != -1) {
+    while ((c = getopt(argc, argv, "VatvbdhU:D:c:q")) != -1) {
         switch (c) {
             case 'V':
                 print_version();
@@ -138,6 +145,10 @@ int main(int argc, char **argv)
             case 'v':
                 full_output = 1;
                 break;
+            case 'b':
+                benchmark = 1;
+                alert_only = 1;
+                break;
             default:
                 help_logtest(home_path);
                 break;
@@ -452,6 +463,9 @@ int main(int argc, char **argv)
 
         total_rules = _setlevels(tmp_node, 0);
         mdebug1("Total rules enabled: '%d'", total_rules);
+
+        /* Index the rules by decoder */
+        OS_IndexRules(tmp_node);
     }
 
     /* Creating a rules hash (for reading alerts from other servers) */
@@ -530,6 +544,13 @@ void OS_ReadMSG(char *ut_str)
     Eventinfo *lf;
     OSDecoderNode *node = NULL;
 
+    unsigned long bench_events = 0;
+    double bench_decode = 0;
+    double bench_free = 0;
+    struct timespec bench_start;
+    struct timespec ts_begin;
+    struct timespec ts_end;
+
     RuleInfo * currently_rule;
     /* Null global pointer to current rule */
     currently_rule = NULL;
@@ -559,6 +580,8 @@ void OS_ReadMSG(char *ut_str)
         print_out("%s: Type one log per line.\n", ARGV0);
     }
 
+    gettime(&bench_start);
+
     /* Daemon loop */
     while (1) {
         os_calloc(1, sizeof(Eventinfo), lf);
@@ -590,6 +613,7 @@ void OS_ReadMSG(char *ut_str)
             }
 
             /* Default values for the log info */
+            gettime(&ts_begin);
             Zero_Eventinfo(lf);
             lf->tid = 0;
 
@@ -613,6 +637,10 @@ void OS_ReadMSG(char *ut_str)
             node = OS_GetFirstOSDecoder(lf->program_name);
             DecodeEvent(lf, Config.g_rules_hash, &decoder_match, node);
 
+            gettime(&ts_end);
+            bench_decode += time_diff(&ts_begin, &ts_end);
+            bench_events++;
+
             /* Run accumulator */
             if ( lf->decoder_info->accumulate == 1 ) {
                 print_out("\n**ACCUMULATOR: LEVEL UP!!**\n");
@@ -706,7 +734,9 @@ void OS_ReadMSG(char *ut_str)
 
                 /* Log the alert if configured to */
                 if (currently_rule->alert_opts & DO_LOGALERT) {
-                    if (alert_only) {
+                    if (benchmark) {
+                        __crt_ftell++;
+                    } else if (alert_only) {
                         OS_Log(lf, stdout);
                         fflush(stdout);
                         __crt_ftell++;
@@ -715,6 +745,9 @@ void OS_ReadMSG(char *ut_str)
                     }
                 }
 
+                /* Count the event for the rules that search it */
+                w_correlation_add_event(currently_rule, lf);
+
                 /* Copy the structure to the state memory of if_matched_sid */
                 if (currently_rule->sid_prev_matched) {
                     if (!OSList_AddData(currently_rule->sid_prev_matched, lf)) {
@@ -780,16 +813,30 @@ void OS_ReadMSG(char *ut_str)
              * -- message is free inside clean event --
              */
             if (lf->generated_rule == NULL) {
+                gettime(&ts_begin);
                 Free_Eventinfo(lf);
+                gettime(&ts_end);
+                bench_free += time_diff(&ts_begin, &ts_end);
             }
 
         } else {
+            if (benchmark) {
+                gettime(&ts_end);
+                print_benchmark(bench_events, bench_decode, bench_free, time_diff(&bench_start, &ts_end));
+            }
             exit(exit_code);
         }
     }
     exit(exit_code);
 }
 
+void print_benchmark(unsigned long events, double decode_time, double free_time, double total_time) {
+    print_out("Events: %lu", events);
+    print_out("Total time: %.3f s (%.0f events/s)", total_time, total_time > 0 ? events / total_time : 0);
+    print_out("Decoding: %.3f s (%.2f us/event)", decode_time, events ? decode_time * 1e6 / events : 0);
+    print_out("Releasing: %.3f s (%.2f us/event)", free_time, events ? free_time * 1e6 / events : 0);
+}
+
 // Cleanup at exit
 void onexit() {
     char testdir[PATH_MAX + 1];
@@ -0,0 +1,491 @@
+/* Copyright (C) 2015, Wazuh Inc.
+ * All right reserved.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation
+ */
+
+/* Asynchronous client of wazuh-db for the decoders */
+
+#include "shared.h"
+#include "wazuhdb_op.h"
+#include "os_net/os_net.h"
+#include "wdb_async.h"
+
+#ifdef WAZUH_UNIT_TESTING
+// Remove STATIC qualifier from tests
+#define STATIC
+#else
+#define STATIC static
+#endif
+
+static w_mpmc_queue_t * wdb_async_queue;
+static w_mpmc_queue_t * wdb_async_window;
+static bool wdb_async_running;
+static pthread_mutex_t wdb_async_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static void * wdb_async_sender(void * arg);
+static void * wdb_async_receiver(void * arg);
+
+/* Parse an agent ID */
+static int wdb_async_agent(const char * agent_id, uint32_t * agent) {
+    char * end;
+    unsigned long value;
+
+    if (agent_id == NULL || !isdigit((unsigned char)*agent_id)) {
+        return -1;
+    }
+
+    value = strtoul(agent_id, &end, 10);
+
+    if (*end != '\0' || value > INT32_MAX) {
+        return -1;
+    }
+
+    *agent = (uint32_t)value;
+    return 0;
+}
+
+static void wdb_async_op_free(wdb_async_op_t * op) {
+    os_free(op->name);
+    os_free(op->data);
+    os_free(op);
+}
+
+/* Order by agent, keeping the order of the operations of every agent */
+static int wdb_async_compare(const void * a, const void * b) {
+    const wdb_async_op_t * op_a = *(wdb_async_op_t * const *)a;
+    const wdb_async_op_t * op_b = *(wdb_async_op_t * const *)b;
+
+    if (op_a->agent != op_b->agent) {
+        return op_a->agent < op_b->agent ? -1 : 1;
+    }
+
+    return op_a->seq < op_b->seq ? -1 : op_a->seq > op_b->seq;
+}
+
+static void wdb_async_wake(wdb_async_waiter_t * waiter, int result) {
+    w_mutex_lock(&wdb_async_mutex);
+    waiter->result = result;
+    waiter->done = true;
+    w_cond_signal(&waiter->cond);
+    w_mutex_unlock(&wdb_async_mutex);
+}
+
+/* Drop operations that can't be sent */
+static void wdb_async_discard(wdb_async_op_t ** ops, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        if (ops[i]->waiter) {
+            wdb_async_wake(ops[i]->waiter, -2);
+        }
+
+        wdb_async_op_free(ops[i]);
+    }
+}
+
+/* Syscollector saves that can go in the same batch operation */
+static bool wdb_async_mergeable(const wdb_async_op_t * first, const wdb_async_op_t * op) {
+    return first->frame && first->type == WDB_FRAME_SYSCOLLECTOR_SAVE &&
+           op->frame && op->type == WDB_FRAME_SYSCOLLECTOR_SAVE &&
+           op->agent == first->agent && op->argument == first->argument;
+}
+
+/**
+ * @brief Merge the consecutive Syscollector saves of an agent and component into batch operations
+ *
+ * wazuh-db stores a batch in a single transaction and answers it once.
+ *
+ * @param ops Operations, sorted by agent. The merged ones are freed.
+ * @param count Number of operations.
+ * @return Number of operations left.
+ */
+STATIC size_t wdb_async_coalesce(wdb_async_op_t ** ops, size_t count) {
+    const size_t max_length = OS_MAXSTR - WDB_FRAME_HEADER - WDB_FRAME_OP_HEADER;
+    size_t merged = 0;
+    size_t length;
+    size_t offset;
+    size_t i;
+    size_t j;
+    size_t k;
+    char * data;
+
+    for (i = 0; i < count; i = j) {
+        wdb_async_op_t * first = ops[i];
+
+        // Brackets and a comma between entries
+        length = first->data_length + 2;
+
+        for (j = i + 1; j < count && wdb_async_mergeable(first, ops[j]) && length + ops[j]->data_length + 1 <= max_length; j++) {
+            length += ops[j]->data_length + 1;
+        }
+
+        if (j - i > 1) {
+            os_malloc(length, data);
+            data[0] = '[';
+            offset = 1;
+
+            for (k = i; k < j; k++) {
+                if (k > i) {
+                    data[offset++] = ',';
+                }
+
+                memcpy(data + offset, ops[k]->data, ops[k]->data_length);
+                offset += ops[k]->data_length;
+
+                if (k > i) {
+                    wdb_async_op_free(ops[k]);
+                }
+            }
+
+            data[offset++] = ']';
+
+            os_free(first->data);
+            first->data = data;
+            first->data_length = offset;
+            first->type = WDB_FRAME_SYSCOLLECTOR_BATCH;
+        }
+
+        ops[merged++] = first;
+    }
+
+    return merged;
+}
+
+/**
+ * @brief Pack the leading frame operations of a batch into a binary frame
+ *
+ * @param ops Operations. The first one must be a frame operation.
+ * @param count Number of operations.
+ * @param buffer Buffer for the frame.
+ * @param size Size of the buffer.
+ * @param packed Number of operations packed.
+ * @return Length of the frame.
+ */
+STATIC size_t wdb_async_pack(wdb_async_op_t ** ops, size_t count, char * buffer, size_t size, size_t * packed) {
+    size_t length = WDB_FRAME_HEADER;
+    size_t name_length;
+    uint32_t value;
+    uint16_t total;
+    size_t i;
+
+    for (i = 0; i < count && i < WDB_FRAME_MAX_OPERATIONS && ops[i]->frame; i++) {
+        name_length = ops[i]->name ? strlen(ops[i]->name) : 0;
+
+        if (length + WDB_FRAME_OP_HEADER + name_length + ops[i]->data_length > size) {
+            break;
+        }
+
+        buffer[length] = ops[i]->type;
+        value = htonl(ops[i]->agent);
+        memcpy(buffer + length + 1, &value, sizeof(value));
+        buffer[length + 5] = ops[i]->argument;
+        buffer[length + 6] = name_length;
+        value = htonl(ops[i]->data_length);
+        memcpy(buffer + length + 7, &value, sizeof(value));
+        length += WDB_FRAME_OP_HEADER;
+
+        if (name_length > 0) {
+            memcpy(buffer + length, ops[i]->name, name_length);
+            length += name_length;
+        }
+
+        memcpy(buffer + length, ops[i]->data, ops[i]->data_length);
+        length += ops[i]->data_length;
+    }
+
+    total = htons(i);
+    buffer[0] = (char)WDB_FRAME_MAGIC;
+    buffer[1] = WDB_FRAME_VERSION;
+    memcpy(buffer + 2, &total, sizeof(total));
+
+    *packed = i;
+    return length;
+}
+
+/**
+ * @brief Check the response to a binary frame and log the errors
+ *
+ * @param response Response frame.
+ * @param length Length of the response.
+ * @param operations Operations sent in the frame.
+ * @return Number of operations that failed or were not processed.
+ */
+STATIC unsigned int wdb_async_frame_result(const char * response, size_t length, unsigned int operations) {
+    unsigned int failed = 0;
+    unsigned int processed = 0;
+    size_t offset = WDB_FRAME_HEADER;
+    size_t msg_length;
+
+    if (length < WDB_FRAME_HEADER || (unsigned char)response[0] != WDB_FRAME_MAGIC) {
+        merror("wazuh-db client: Invalid response to a frame.");
+        return operations;
+    }
+
+    while (processed < operations && offset + 2 <= length) {
+        msg_length = (unsigned char)response[offset + 1];
+
+        if (offset + 2 + msg_length > length) {
+            break;
+        }
+
+        if (response[offset] != 0) {
+            failed++;
+
+            if (msg_length != strlen("Agent not found") || strncmp(response + offset + 2, "Agent not found", msg_length) != 0) {
+                merror("wazuh-db client: Bad response from database: %.*s", (int)msg_length, response + offset + 2);
+            }
+        }
+
+        offset += 2 + msg_length;
+        processed++;
+    }
+
+    if (processed < operations) {
+        merror("wazuh-db client: %u operations of a frame were not processed.", operations - processed);
+    }
+
+    return failed + operations - processed;
+}
+
+/* Tell the receiver to close a socket after its pending responses */
+static void wdb_async_disconnect(int * sock) {
+    wdb_async_request_t * request;
+
+    shutdown(*sock, SHUT_WR);
+
+    os_calloc(1, sizeof(wdb_async_request_t), request);
+    request->sock = *sock;
+    request->close = true;
+    mpmc_queue_push_block(wdb_async_window, request);
+
+    *sock = -1;
+}
+
+void * wdb_async_sender(__attribute__((unused)) void * arg) {
+    wdb_async_op_t * ops[WDB_ASYNC_BATCH];
+    wdb_async_request_t * request;
+    char * frame;
+    const char * message;
+    size_t count;
+    size_t packed;
+    size_t length;
+    size_t i;
+    size_t j;
+    int sock = -1;
+
+    os_malloc(OS_MAXSTR, frame);
+
+    while (true) {
+        count = mpmc_queue_pop_batch_block(wdb_async_queue, (void **)ops, WDB_ASYNC_BATCH);
+
+        for (i = 0; i < count; i++) {
+            ops[i]->seq = i;
+        }
+
+        // Consecutive operations of an agent share the frame and the database handle
+        qsort(ops, count, sizeof(wdb_async_op_t *), wdb_async_compare);
+        count = wdb_async_coalesce(ops, count);
+
+        for (i = 0; i < count; i += packed) {
+            if (sock < 0 && (sock = wdbc_connect(), sock < 0)) {
+                merror("wazuh-db client: Cannot communicate with database. %zu operations discarded.", count - i);
+                wdb_async_discard(ops + i, count - i);
+                break;
+            }
+
+            if (ops[i]->frame) {
+                length = wdb_async_pack(ops + i, count - i, frame, OS_MAXSTR, &packed);
+                message = frame;
+            } else {
+                packed = 1;
+                length = ops[i]->data_length + 1;
+                message = ops[i]->data;
+            }
+
+            if (OS_SendSecureTCP(sock, length, message) != 0) {
+                merror("wazuh-db client: Cannot send message: (%d) '%s'. Reconnecting.", errno, strerror(errno));
+                wdb_async_disconnect(&sock);
+                wdb_async_discard(ops + i, packed);
+                continue;
+            }
+
+            // The window is bounded: a slow database holds the sender here
+            os_calloc(1, sizeof(wdb_async_request_t), request);
+            request->sock = sock;
+            request->operations = ops[i]->frame ? packed : 0;
+            request->waiter = ops[i]->waiter;
+            mpmc_queue_push_block(wdb_async_window, request);
+
+            for (j = i; j < i + packed; j++) {
+                wdb_async_op_free(ops[j]);
+            }
+        }
+    }
+
+    return NULL;
+}
+
+void * wdb_async_receiver(__attribute__((unused)) void * arg) {
+    wdb_async_request_t * request;
+    char * response;
+    char * payload;
+    ssize_t length;
+    int broken = -1;
+
+    os_malloc(OS_MAXSTR + 1, response);
+
+    while (true) {
+        request = mpmc_queue_pop_block(wdb_async_window);
+
+        if (request->close) {
+            close(request->sock);
+
+            if (broken == request->sock) {
+                broken = -1;
+            }
+
+            os_free(request);
+            continue;
+        }
+
+        length = OS_RecvSecureTCP(request->sock, response, OS_MAXSTR);
+
+        if (length <= 0) {
+            if (broken != request->sock) {
+                if (length == OS_SOCKTERR) {
+                    merror("wazuh-db client: Cannot receive message: response size is bigger than expected");
+                } else {
+                    merror("wazuh-db client: Cannot get response from database.");
+                }
+
+                // The stream is lost: make the sender reconnect
+                shutdown(request->sock, SHUT_RDWR);
+                broken = request->sock;
+            }
+
+            if (request->waiter) {
+                wdb_async_wake(request->waiter, -1);
+            }
+
+            os_free(request);
+            continue;
+        }
+
+        response[length] = '\0';
+
+        if (request->operations > 0) {
+            wdb_async_frame_result(response, length, request->operations);
+        } else if (request->waiter) {
+            strncpy(request->waiter->response, response, request->waiter->len - 1);
+            request->waiter->response[request->waiter->len - 1] = '\0';
+            wdb_async_wake(request->waiter, 0);
+        } else if (wdbc_parse_result(response, &payload) == WDBC_ERROR && strcmp(payload, "Agent not found") != 0) {
+            merror("wazuh-db client: Bad response from database: %s", payload);
+        }
+
+        os_free(request);
+    }
+
+    return NULL;
+}
+
+void wdb_async_init(void) {
+    if (!getDefine_Int("analysisd", "wdb_async", 0, 1)) {
+        mdebug1("Asynchronous wazuh-db client disabled.");
+        return;
+    }
+
+    wdb_async_queue = mpmc_queue_init(getDefine_Int("analysisd", "wdb_async_queue_size", 128, 2000000));
+    wdb_async_window = mpmc_queue_init(WDB_ASYNC_WINDOW);
+
+    w_create_thread(wdb_async_sender, NULL);
+    w_create_thread(wdb_async_receiver, NULL);
+
+    wdb_async_running = true;
+}
+
+bool wdb_async_enabled(void) {
+    return wdb_async_running;
+}
+
+int wdb_async_query(const char * agent_id, const char * query) {
+    wdb_async_op_t * op;
+    uint32_t agent;
+
+    if (!wdb_async_running || wdb_async_agent(agent_id, &agent) != 0) {
+        return -1;
+    }
+
+    os_calloc(1, sizeof(wdb_async_op_t), op);
+    op->agent = agent;
+    os_strdup(query, op->data);
+    op->data_length = strlen(query);
+
+    mpmc_queue_push_block(wdb_async_queue, op);
+    return 0;
+}
+
+int wdb_async_frame_op(wdb_frame_op_t type, const char * agent_id, unsigned char argument, const char * name, const char * data) {
+    wdb_async_op_t * op;
+    size_t name_length = name ? strlen(name) : 0;
+    size_t data_length = strlen(data);
+    uint32_t agent;
+
+    if (!wdb_async_running || wdb_async_agent(agent_id, &agent) != 0) {
+        return -1;
+    }
+
+    if (name_length > UINT8_MAX || WDB_FRAME_HEADER + WDB_FRAME_OP_HEADER + name_length + data_length > OS_MAXSTR) {
+        return -1;
+    }
+
+    os_calloc(1, sizeof(wdb_async_op_t), op);
+    op->agent = agent;
+    op->frame = true;
+    op->type = type;
+    op->argument = argument;
+
+    if (name) {
+        os_strdup(name, op->name);
+    }
+
+    os_malloc(data_length, op->data);
+    memcpy(op->data, data, data_length);
+    op->data_length = data_length;
+
+    mpmc_queue_push_block(wdb_async_queue, op);
+    return 0;
+}
+
+int wdb_async_query_ex(int * sock, const char * agent_id, const char * query, char * response, int len) {
+    wdb_async_waiter_t waiter = { .response = response, .len = len };
+    wdb_async_op_t * op;
+    uint32_t agent;
+
+    if (!wdb_async_running || wdb_async_agent(agent_id, &agent) != 0) {
+        return wdbc_query_ex(sock, query, response, len);
+    }
+
+    w_cond_init(&waiter.cond, NULL);
+
+    os_calloc(1, sizeof(wdb_async_op_t), op);
+    op->agent = agent;
+    os_strdup(query, op->data);
+    op->data_length = strlen(query);
+    op->waiter = &waiter;
+
+    mpmc_queue_push_block(wdb_async_queue, op);
+
+    w_mutex_lock(&wdb_async_mutex);
+
+    while (!waiter.done) {
+        w_cond_wait(&waiter.cond, &wdb_async_mutex);
+    }
+
+    w_mutex_unlock(&wdb_async_mutex);
+    w_cond_destroy(&waiter.cond);
+
+    return waiter.result;
+}
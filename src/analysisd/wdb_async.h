@@ -0,0 +1,111 @@
+/* Copyright (C) 2015, Wazuh Inc.
+ * All right reserved.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation
+ */
+
+/**
+ * Asynchronous client of wazuh-db for the decoders.
+ *
+ * The decoders enqueue their writes and go on. A sender thread takes the
+ * pending operations in batches, groups them by agent, packs the frame
+ * operations into binary frames and sends them without waiting for the
+ * responses. A completion thread reads the responses in order and logs
+ * the errors. All the requests go through a single connection, so the
+ * operations of an agent are applied in the same order they were enqueued.
+ */
+
+#ifndef WDB_ASYNC_H
+#define WDB_ASYNC_H
+
+#include "shared.h"
+#include "../wazuh_db/wdb_frame.h"
+
+#define WDB_ASYNC_BATCH     256     // Operations taken from the queue at once
+#define WDB_ASYNC_WINDOW    64      // Requests sent and not answered yet
+
+/* Caller waiting for the response of a query */
+typedef struct wdb_async_waiter_t {
+    char * response;
+    int len;
+    int result;
+    bool done;
+    pthread_cond_t cond;
+} wdb_async_waiter_t;
+
+/* Operation waiting to be sent */
+typedef struct wdb_async_op_t {
+    uint32_t agent;
+    size_t seq;                     // Position in the batch, to keep the order of the agent
+    bool frame;                     // Frame operation or text query
+    unsigned char type;
+    unsigned char argument;
+    char * name;
+    char * data;                    // Data of the frame operation, or text query
+    size_t data_length;
+    wdb_async_waiter_t * waiter;
+} wdb_async_op_t;
+
+/* Request sent and not answered yet */
+typedef struct wdb_async_request_t {
+    int sock;
+    unsigned int operations;        // Operations of the frame, 0 for a text query
+    bool close;                     // No more requests on this socket: close it
+    wdb_async_waiter_t * waiter;
+} wdb_async_request_t;
+
+/**
+ * @brief Start the asynchronous client, unless it's disabled in the internal options
+ */
+void wdb_async_init(void);
+
+/**
+ * @brief Check whether the asynchronous client is running
+ *
+ * @return true if the operations can be enqueued.
+ */
+bool wdb_async_enabled(void);
+
+/**
+ * @brief Enqueue a text query whose response is not needed
+ *
+ * @param agent_id Agent of the query.
+ * @param query Query to send.
+ * @retval 0 The query was enqueued.
+ * @retval -1 The client is not running: the query must be sent synchronously.
+ */
+int wdb_async_query(const char * agent_id, const char * query);
+
+/**
+ * @brief Enqueue an operation of a binary frame
+ *
+ * @param type Type of operation.
+ * @param agent_id Agent of the operation.
+ * @param argument Argument of the operation.
+ * @param name Name of the operation, up to 255 bytes. NULL is allowed.
+ * @param data Data of the operation.
+ * @retval 0 The operation was enqueued.
+ * @retval -1 The client is not running or the operation doesn't fit in a frame:
+ *            the equivalent text query must be sent synchronously.
+ */
+int wdb_async_frame_op(wdb_frame_op_t type, const char * agent_id, unsigned char argument, const char * name, const char * data);
+
+/**
+ * @brief Send a query after the pending asynchronous operations and wait for its response
+ *
+ * The query sees the changes of the operations of the same agent enqueued
+ * before it. If the client is not running, it's the same as wdbc_query_ex().
+ *
+ * @param sock Socket for the synchronous query, when the client is not running.
+ * @param agent_id Agent of the query.
+ * @param query Query to send.
+ * @param response Buffer for the response.
+ * @param len Size of the response buffer.
+ * @return Same as wdbc_query_ex(): 0 on success, -1 if there was no response, -2 if it couldn't be sent.
+ */
+int wdb_async_query_ex(int * sock, const char * agent_id, const char * query, char * response, int len);
+
+#endif /* WDB_ASYNC_H */
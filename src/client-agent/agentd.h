@@ -19,10 +19,11 @@
 
 /* Buffer functions */
 #define full(i, j, n) ((i + 1) % (n) == j)
-#define warn(i, j) ((float)((i - j + agt->buflength + 1) % (agt->buflength + 1)) / (float)agt->buflength >= ((float)warn_level/100.0))
-#define nowarn(i, j) ((float)((i - j + agt->buflength + 1) % (agt->buflength + 1)) / (float)agt->buflength <= ((float)warn_level/100.0))
-#define normal(i, j) ((float)((i - j + agt->buflength + 1) % (agt->buflength + 1)) / (float)agt->buflength <= ((float)normal_level/100.0))
-#define capacity(i, j) (float)((i - j + agt->buflength + 1) % (agt->buflength + 1)) / (float)agt->buflength
+#define warn(n) ((float)(n) / (float)agt->buflength >= ((float)warn_level/100.0))
+#define nowarn(n) ((float)(n) / (float)agt->buflength <= ((float)warn_level/100.0))
+#define normal(n) ((float)(n) / (float)agt->buflength <= ((float)normal_level/100.0))
+#define capacity(n) (float)(n) / (float)agt->buflength
+#define overflow(n) ((n) >= (unsigned int)agt->buflength)
 #define empty(i, j) (i == j)
 #define forward(x, n) x = (x + 1) % (n)
 
@@ -61,6 +62,14 @@ void buffer_init();
 /* Send message to a buffer with the aim to avoid flooding issues */
 int buffer_append(const char *msg);
 
+/**
+ * @brief Set the share of the events per second that the server can absorb
+ *
+ * @param ack_options Options of the ack of the server, with the credit in percentage. The whole rate is allowed if
+ *                    there is no credit.
+ */
+void buffer_set_credit(const char * ack_options);
+
 /* Thread to dispatch messages from the buffer */
 #ifdef WIN32
 DWORD WINAPI dispatch_buffer(LPVOID arg);
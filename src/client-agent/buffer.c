@@ -25,8 +25,38 @@
 #define STATIC static
 #endif
 
-STATIC volatile int i = 0;
-STATIC volatile int j = 0;
+/* Maximum size of the length prefix of an event in a batch */
+#define EVENT_PREFIX_SIZE 8
+
+/* Lane of the buffer, holding the events of some queues */
+typedef struct buffer_lane_t {
+    const char * name;      // Name of the lane in the internal options
+    const char * queues;    // Queues of the events of the lane, NULL for the rest
+    int weight;             // Events sent in a row while the other lanes wait, and eviction priority
+    char ** events;         // Ring of events
+    unsigned int head;      // Oldest event
+    unsigned int count;     // Events in the lane
+    int credit;             // Events the lane can still send in a row
+} buffer_lane_t;
+
+STATIC buffer_lane_t lanes[] = {
+    { "fim", (const char[]){ SYSCHECK_MQ, '\0' }, 0, NULL, 0, 0, 0 },
+    { "inventory", (const char[]){ SYSCOLLECTOR_MQ, DBSYNC_MQ, '\0' }, 0, NULL, 0, 0, 0 },
+    { "sca", (const char[]){ SCA_MQ, '\0' }, 0, NULL, 0, 0, 0 },
+    { "logs", NULL, 0, NULL, 0, 0, 0 },
+};
+
+#define BUFFER_LANES (sizeof(lanes) / sizeof(lanes[0]))
+
+/* Lane being dispatched */
+STATIC unsigned int current_lane = 0;
+
+/* Events in all the lanes */
+STATIC volatile unsigned int buffered = 0;
+
+/* Percentage of the events per second that the server can absorb */
+STATIC volatile int eps_credit = 100;
+
 static volatile int state = NORMAL;
 
 int warn_level;
@@ -40,7 +70,6 @@ struct{
   unsigned int normal:1;
 } buff;
 
-static char ** buffer;
 static pthread_mutex_t mutex_lock;
 static pthread_cond_t cond_no_empty;
 
@@ -49,23 +78,78 @@ static time_t start, end;
 /**
  * @brief Sleep according to max_eps parameter
  *
- * Sleep (1 / max_eps) - ts_loop
+ * Sleep (events / max_eps) - ts_loop
  *
  * @param ts_loop Loop time.
+ * @param events Number of events sent in the loop.
+ */
+static void delay(struct timespec * ts_loop, unsigned int events);
+
+/**
+ * @brief Get the events per second to be sent, as allowed by the server
+ *
+ * @return The configured events per second lowered by the credit of the server, not below min_eps.
+ */
+STATIC int current_eps();
+
+/**
+ * @brief Get the lane of an event
+ *
+ * @param msg Event, starting with its queue.
+ * @return Lane of the queue of the event.
+ */
+STATIC buffer_lane_t * lane_of(const char * msg);
+
+/**
+ * @brief Select the lane of the next event to send, by weighted round robin
+ *
+ * Each lane sends up to its weight in events before the next one with events is taken.
+ *
+ * @pre The buffer is locked and it is not empty.
+ * @return Lane of the next event.
+ */
+STATIC buffer_lane_t * next_lane();
+
+/**
+ * @brief Take the oldest event of a lane
+ *
+ * @pre The buffer is locked and the lane is not empty.
+ * @param lane Lane.
+ * @return The event, to be freed by the caller.
+ */
+STATIC char * take_event(buffer_lane_t * lane);
+
+/**
+ * @brief Pack the events into a batch message
+ *
+ * Format: EVENT_BATCH_HEADER <length>:<event><length>:<event>...
+ *
+ * @param events Events to pack.
+ * @param count Number of events.
+ * @param batch Output buffer, of at least agt->event_batch_size + 1 bytes.
+ * @return Length of the batch message.
  */
-static void delay(struct timespec * ts_loop);
+STATIC size_t build_event_batch(char ** events, unsigned int count, char * batch);
 
 /* Create agent buffer */
 void buffer_init(){
 
-    if (!buffer)
-        os_calloc(agt->buflength+1, sizeof(char *), buffer);
+    char option[OS_SIZE_128];
 
     /* Read internal configuration */
     warn_level = getDefine_Int("agent", "warn_level", 1, 100);
     normal_level = getDefine_Int("agent", "normal_level", 0, warn_level-1);
     tolerance = getDefine_Int("agent", "tolerance", 0, 600);
 
+    for (unsigned int k = 0; k < BUFFER_LANES; k++) {
+        if (!lanes[k].events)
+            os_calloc(agt->buflength, sizeof(char *), lanes[k].events);
+
+        snprintf(option, sizeof(option), "buffer_weight_%s", lanes[k].name);
+        lanes[k].weight = getDefine_Int("agent", option, 1, 100);
+        lanes[k].credit = lanes[k].weight;
+    }
+
     w_mutex_init(&mutex_lock, NULL);
     w_cond_init(&cond_no_empty, NULL);
 
@@ -84,18 +168,18 @@ int buffer_append(const char *msg){
     switch (state) {
 
         case NORMAL:
-            if (full(i, j, agt->buflength + 1)){
+            if (overflow(buffered)){
                 buff.full = 1;
                 state = FULL;
                 start = time(0);
-            }else if (warn(i, j)){
+            }else if (warn(buffered)){
                 state = WARNING;
                 buff.warn = 1;
             }
             break;
 
         case WARNING:
-            if (full(i, j, agt->buflength + 1)){
+            if (overflow(buffered)){
                 buff.full = 1;
                 state = FULL;
                 start = time(0);
@@ -116,23 +200,40 @@ int buffer_append(const char *msg){
 
     w_agentd_state_update(INCREMENT_MSG_COUNT, NULL);
 
-    /* When buffer is full, event is dropped */
+    buffer_lane_t * lane = lane_of(msg);
 
-    if (full(i, j, agt->buflength + 1)){
+    /* When buffer is full, the oldest event of a lane with a lower weight is dropped, or else the new one */
 
-        w_mutex_unlock(&mutex_lock);
-        mdebug2("Unable to store new packet: Buffer is full.");
-        return(-1);
+    if (overflow(buffered)){
+        buffer_lane_t * victim = NULL;
 
-    }else{
+        for (unsigned int k = 0; k < BUFFER_LANES; k++) {
+            if (lanes[k].count > 0 && lanes[k].weight < lane->weight && (!victim || lanes[k].weight < victim->weight)) {
+                victim = &lanes[k];
+            }
+        }
 
-        buffer[i] = strdup(msg);
-        forward(i, agt->buflength + 1);
-        w_cond_signal(&cond_no_empty);
-        w_mutex_unlock(&mutex_lock);
+        if (!victim) {
+            w_mutex_unlock(&mutex_lock);
+            mdebug2("Unable to store new packet: Buffer is full.");
+            return(-1);
+        }
 
-        return(0);
+        mdebug2("Buffer is full: dropping the oldest event of the '%s' lane for the '%s' lane.", victim->name, lane->name);
+        free(victim->events[victim->head]);
+        victim->events[victim->head] = NULL;
+        forward(victim->head, agt->buflength);
+        victim->count--;
+        buffered--;
     }
+
+    lane->events[(lane->head + lane->count) % agt->buflength] = strdup(msg);
+    lane->count++;
+    buffered++;
+    w_cond_signal(&cond_no_empty);
+    w_mutex_unlock(&mutex_lock);
+
+    return(0);
 }
 
 /* Send messages from buffer to the server */
@@ -149,13 +250,21 @@ void *dispatch_buffer(__attribute__((unused)) void * arg){
     char warn_str[OS_SIZE_2048];
     struct timespec ts0;
     struct timespec ts1;
+    char ** events = NULL;
+    char * batch = NULL;
+    unsigned int count;
+
+    if (agt->event_batch_size > 0) {
+        os_calloc(agt->events_persec, sizeof(char *), events);
+        os_malloc(agt->event_batch_size + 1, batch);
+    }
 
     while(1){
         gettime(&ts0);
 
         w_mutex_lock(&mutex_lock);
 
-        while(empty(i, j)){
+        while(buffered == 0){
             w_cond_wait(&cond_no_empty, &mutex_lock);
         }
         /* Check if buffer usage reaches any lower level */
@@ -165,35 +274,55 @@ void *dispatch_buffer(__attribute__((unused)) void * arg){
                 break;
 
             case WARNING:
-                if (normal(i, j)){
+                if (normal(buffered)){
                     state = NORMAL;
                     buff.normal = 1;
                 }
                 break;
 
             case FULL:
-                if (nowarn(i, j))
+                if (nowarn(buffered))
                     state = WARNING;
 
-                if (normal(i, j)){
+                if (normal(buffered)){
                     state = NORMAL;
                     buff.normal = 1;
                 }
                 break;
 
             case FLOOD:
-                if (nowarn(i, j))
+                if (nowarn(buffered))
                     state = WARNING;
 
-                if (normal(i, j)){
+                if (normal(buffered)){
                     state = NORMAL;
                     buff.normal = 1;
                 }
                 break;
         }
 
-        char * msg_output = buffer[j];
-        forward(j, agt->buflength + 1);
+        char * msg_output = take_event(next_lane());
+        count = 1;
+
+        /* Take the events waiting in the buffer that fit in a batch, up to a second of events */
+        if (agt->event_batch && batch != NULL) {
+            size_t batch_size = strlen(EVENT_BATCH_HEADER) + strlen(msg_output) + EVENT_PREFIX_SIZE;
+            unsigned int max_count = (unsigned int)current_eps();
+            events[0] = msg_output;
+
+            while (buffered > 0 && count < max_count) {
+                buffer_lane_t * lane = next_lane();
+                size_t event_size = strlen(lane->events[lane->head]) + EVENT_PREFIX_SIZE;
+
+                if (batch_size + event_size > (size_t)agt->event_batch_size) {
+                    break;
+                }
+
+                batch_size += event_size;
+                events[count++] = take_event(lane);
+            }
+        }
+
         w_mutex_unlock(&mutex_lock);
 
         if (buff.warn){
@@ -230,20 +359,102 @@ void *dispatch_buffer(__attribute__((unused)) void * arg){
         }
 
         os_wait();
-        send_msg(msg_output, -1);
-        free(msg_output);
+
+        if (count > 1) {
+            send_msg(batch, build_event_batch(events, count, batch));
+
+            for (unsigned int k = 0; k < count; k++) {
+                free(events[k]);
+            }
+        } else {
+            send_msg(msg_output, -1);
+            free(msg_output);
+        }
 
         gettime(&ts1);
         time_sub(&ts1, &ts0);
 
         if (ts1.tv_sec >= 0) {
-            delay(&ts1);
+            delay(&ts1, count);
+        }
+    }
+}
+
+size_t build_event_batch(char ** events, unsigned int count, char * batch) {
+    size_t length = strlen(EVENT_BATCH_HEADER);
+
+    memcpy(batch, EVENT_BATCH_HEADER, length);
+
+    for (unsigned int k = 0; k < count; k++) {
+        size_t event_length = strlen(events[k]);
+
+        length += sprintf(batch + length, "%u:", (unsigned int)event_length);
+        memcpy(batch + length, events[k], event_length);
+        length += event_length;
+    }
+
+    batch[length] = '\0';
+    return length;
+}
+
+buffer_lane_t * lane_of(const char * msg) {
+    for (unsigned int k = 0; k < BUFFER_LANES; k++) {
+        if (!lanes[k].queues || (*msg != '\0' && strchr(lanes[k].queues, *msg))) {
+            return &lanes[k];
         }
     }
+
+    return &lanes[BUFFER_LANES - 1];
 }
 
-void delay(struct timespec * ts_loop) {
-    long interval_ns = 1000000000 / agt->events_persec;
+buffer_lane_t * next_lane() {
+    while (lanes[current_lane].count == 0 || lanes[current_lane].credit <= 0) {
+        lanes[current_lane].credit = lanes[current_lane].weight;
+        current_lane = (current_lane + 1) % BUFFER_LANES;
+    }
+
+    return &lanes[current_lane];
+}
+
+char * take_event(buffer_lane_t * lane) {
+    char * msg = lane->events[lane->head];
+
+    lane->events[lane->head] = NULL;
+    forward(lane->head, agt->buflength);
+    lane->count--;
+    lane->credit--;
+    buffered--;
+
+    return msg;
+}
+
+void buffer_set_credit(const char * ack_options) {
+    cJSON * options = NULL;
+    int credit = 100;
+
+    if (ack_options && *ack_options != '\0' && (options = cJSON_Parse(ack_options), options)) {
+        cJSON * value = cJSON_GetObjectItem(options, "credit");
+
+        if (cJSON_IsNumber(value)) {
+            credit = value->valueint < 0 ? 0 : value->valueint > 100 ? 100 : value->valueint;
+        }
+
+        cJSON_Delete(options);
+    }
+
+    if (credit != eps_credit) {
+        mdebug1("The server allows %d%% of the events per second.", credit);
+        eps_credit = credit;
+    }
+}
+
+int current_eps() {
+    int eps = (int)((long long)agt->events_persec * eps_credit / 100);
+    return eps < min_eps ? min_eps : eps;
+}
+
+void delay(struct timespec * ts_loop, unsigned int events) {
+    long long interval_ns = 1000000000LL * events / current_eps();
     struct timespec ts_timeout = { interval_ns / 1000000000, interval_ns % 1000000000 };
     time_sub(&ts_timeout, ts_loop);
 
@@ -258,10 +469,8 @@ int w_agentd_get_buffer_lenght() {
 
     if (agt->buffer > 0) {
         w_mutex_lock(&mutex_lock);
-        retval = (i - j) % (agt->buflength + 1);
+        retval = (int)buffered;
         w_mutex_unlock(&mutex_lock);
-
-        retval = (retval < 0) ? (retval + agt->buflength + 1) : retval;
     }
 
     return retval;
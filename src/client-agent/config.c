@@ -74,6 +74,8 @@ int ClientConf(const char *cfgfile)
         agt->events_persec = min_eps;
     }
 
+    agt->event_batch_size = getDefine_Int("agent", "event_batch_size", 0, OS_MAXSTR / 2);
+
     return (1);
 }
 
@@ -150,8 +150,11 @@ int receive_msg()
                 continue;
             }
 
-            /* Ack from server */
-            else if (strcmp(tmp_msg, HC_ACK) == 0) {
+            /* Ack from server, with the credit of events per second if the buffer follows it */
+            else if (strncmp(tmp_msg, HC_ACK, strlen(HC_ACK)) == 0) {
+                if (agt->buffer) {
+                    buffer_set_credit(tmp_msg + strlen(HC_ACK));
+                }
                 continue;
             }
 
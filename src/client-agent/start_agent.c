@@ -38,6 +38,7 @@ static ssize_t receive_message(char *buffer, unsigned int max_lenght);
 static void w_agentd_keys_init (void);
 STATIC bool agent_handshake_to_server(int server_id, bool is_startup);
 STATIC void send_msg_on_startup(void);
+STATIC bool ack_accepts_batch(const char *options);
 
 /**
  * @brief Connects to a specified server
@@ -337,6 +338,12 @@ STATIC bool agent_handshake_to_server(int server_id, bool is_startup) {
 
     cJSON* agent_info = cJSON_CreateObject();
     cJSON_AddStringToObject(agent_info, "version", __ossec_version);
+    if (agt->event_batch_size > 0) {
+        cJSON_AddTrueToObject(agent_info, "batch");
+    }
+    if (agt->buffer) {
+        cJSON_AddTrueToObject(agent_info, "credit");
+    }
     char *agent_info_string = cJSON_PrintUnformatted(agent_info);
     cJSON_Delete(agent_info);
 
@@ -359,8 +366,12 @@ STATIC bool agent_handshake_to_server(int server_id, bool is_startup) {
                 /* Check for commands */
                 if (IsValidHeader(tmp_msg)) {
                     /* If it is an ack reply */
-                    if (strcmp(tmp_msg, HC_ACK) == 0) {
+                    if (strncmp(tmp_msg, HC_ACK, strlen(HC_ACK)) == 0) {
                         available_server = time(0);
+                        agt->event_batch = agt->event_batch_size > 0 && ack_accepts_batch(tmp_msg + strlen(HC_ACK));
+                        if (agt->buffer) {
+                            buffer_set_credit(tmp_msg + strlen(HC_ACK));
+                        }
 
                         minfo(AG_CONNECTED, agt->server[server_id].rip,
                                 agt->server[server_id].port, agt->server[server_id].protocol == IPPROTO_UDP ? "udp" : "tcp");
@@ -392,6 +403,28 @@ STATIC bool agent_handshake_to_server(int server_id, bool is_startup) {
     return false;
 }
 
+/**
+ * @brief Checks whether the server accepts batches of events
+ * @param options Options sent by the server along with the ack, if any
+ * @retval true if the server accepts them
+ * @retval false otherwise
+ * */
+STATIC bool ack_accepts_batch(const char *options) {
+    cJSON *ack_options = NULL;
+    bool retval = false;
+
+    if (*options != '\0' && (ack_options = cJSON_Parse(options), ack_options)) {
+        retval = cJSON_IsTrue(cJSON_GetObjectItem(ack_options, "batch"));
+        cJSON_Delete(ack_options);
+    }
+
+    if (retval) {
+        mdebug1("The server accepts batches of events.");
+    }
+
+    return retval;
+}
+
 /**
  * @brief Sends log message about start up
  * */
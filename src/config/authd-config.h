@@ -61,6 +61,8 @@ typedef struct authd_config_t {
     char *manager_key;
     long timeout_sec;
     long timeout_usec;
+    int handshake_threads;
+    int keys_compaction_interval;
     bool worker_node;
     bool ipv6;
     bool allow_higher_versions;
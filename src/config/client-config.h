@@ -44,6 +44,8 @@ typedef struct _agent {
     int buffer;
     int buflength;
     int events_persec;
+    int event_batch_size; ///< Maximum size of a batch of events (0: disabled)
+    bool event_batch;     ///< The current server accepts batches of events
     int crypto_method;
     wlabel_t *labels; /* null-ended label set */
     agent_flags_t flags;
@@ -137,6 +137,9 @@ typedef struct __Config {
     int rotate_interval;
     int min_rotate_interval;
     ssize_t max_output_size;
+    size_t archives_buffer_size;
+    int archives_index_interval;
+    int archives_compress;
     long queue_size;
 
     // EPS limits configuration
@@ -29,6 +29,11 @@ static const char * valid_paths[] = {
     "indexer.ssl.certificate_authorities",
     "indexer.ssl.certificate",
     "indexer.ssl.key",
+    "indexer.bulk_concurrency",
+    "indexer.max_bulk_bytes",
+    "indexer.refresh",
+    "indexer.bulk_compression",
+    "indexer.resync_mode",
     NULL
 };
 
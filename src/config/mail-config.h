@@ -21,6 +21,7 @@ typedef struct _MailConfig {
     int mn;
     int maxperhour;
     int strict_checking;
+    int alert_bus;
     int grouping;
     int subject_full;
     int priority;
@@ -35,6 +35,8 @@ typedef struct _monitor_config {
     int keep_log_days;
     unsigned long size_rotate;
     int daily_rotations;
+    int compress_threads;
+    unsigned int compress_rate;
 
     char *smtpserver;
     char *emailfrom;
@@ -38,6 +38,8 @@ typedef struct _rkconfig {
     int disabled;
     short skip_nfs;
     int tsleep;
+    int threads;    /* Threads probing the PIDs and ports */
+    int io_idle;    /* Run the scan in the idle I/O scheduling class */
 
     int time;
     int queue;
@@ -366,6 +366,9 @@ typedef struct _config {
     int scan_on_start;
     int max_depth;                                     /* max level of recursivity allowed */
     size_t file_max_size;                              /* max file size for calculating hashes */
+    unsigned int scan_threads;                         /* threads that hash the files in scheduled scans */
+    unsigned int full_hash_interval;                   /* scheduled scans to rehash all the unchanged files */
+    unsigned int event_batch;                          /* events of a directory sent in one message by the scans */
 
     fs_set skip_fs;
     int rt_delay;                                      /* Delay before real-time dispatching (ms) */
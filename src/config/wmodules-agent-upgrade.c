@@ -151,7 +151,7 @@ int wm_agent_upgrade_read(__attribute__((unused)) const OS_XML *xml, xml_node **
                 return (OS_INVALID);
             }
             int chunk;
-            if (chunk = atoi(nodes[i]->content), chunk < 64 || chunk > 32768) {
+            if (chunk = atoi(nodes[i]->content), chunk < 64 || chunk > WM_UPGRADE_CHUNK_SIZE_MAX) {
                 merror("Invalid content for tag '%s' at module '%s'.", XML_CHUNK_SIZE, WM_AGENT_UPGRADE_CONTEXT.name);
                 return (OS_INVALID);
             }
@@ -167,7 +167,7 @@ int wm_agent_upgrade_read(__attribute__((unused)) const OS_XML *xml, xml_node **
             if (!max_threads) {
                 // If 0, we assign the number of cpu cores
                 data->manager_config.max_threads = get_nproc();
-            } else if (max_threads <= 256) {
+            } else if (max_threads <= WM_UPGRADE_MAX_THREADS_LIMIT) {
                 data->manager_config.max_threads = max_threads;
             } else {
                 merror("Invalid content for tag '%s' at module '%s'.", XML_MAX_THREADS, WM_AGENT_UPGRADE_CONTEXT.name);
@@ -20,6 +20,7 @@ static const char * valid_paths[] = {
     "feed-update-interval",
     "offline-url",
     "cti-url",
+    "feed-distribution",
     NULL
 };
 
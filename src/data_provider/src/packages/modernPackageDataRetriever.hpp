@@ -13,9 +13,11 @@
 #define _MODERN_PACKAGE_DATA_RETRIEVER_HPP
 
 #include "json.hpp"
+#include "packages/packagesSourceCache.hpp"
 #include "sharedDefs.h"
 #include <functional>
 #include <map>
+#include <memory>
 
 #if defined(HAS_STDFILESYSTEM) && HAS_STDFILESYSTEM==true
 #include "packages/packagesNPM.hpp"
@@ -24,11 +26,13 @@
 class PYPI
 {
     public:
+        explicit PYPI(std::shared_ptr<PackagesSourceCache> /*spCache*/ = nullptr) {}
         void getPackages(const std::set<std::string>& /*paths*/, std::function<void(nlohmann::json&)> /*callback*/);
 };
 class NPM
 {
     public:
+        explicit NPM(std::shared_ptr<PackagesSourceCache> /*spCache*/ = nullptr) {}
         void getPackages(const std::set<std::string>& /*paths*/, std::function<void(nlohmann::json&)> /*callback*/);
 };
 #endif
@@ -50,8 +54,12 @@ class ModernFactoryPackagesCreator<true> final
     public:
         static void getPackages(const std::map<std::string, std::set<std::string>>& paths, std::function<void(nlohmann::json&)> callback)
         {
-            PYPI().getPackages(paths.at("PYPI"), callback);
-            NPM().getPackages(paths.at("NPM"), callback);
+            // The folders are only read again when they're modified.
+            static const auto spPypiCache {std::make_shared<PackagesSourceCache>()};
+            static const auto spNpmCache {std::make_shared<PackagesSourceCache>()};
+
+            PYPI(spPypiCache).getPackages(paths.at("PYPI"), callback);
+            NPM(spNpmCache).getPackages(paths.at("NPM"), callback);
         }
 };
 
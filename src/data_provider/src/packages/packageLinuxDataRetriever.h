@@ -15,6 +15,7 @@
 #include <memory>
 #include "filesystemHelper.h"
 #include "json.hpp"
+#include "packagesSourceCache.hpp"
 #include "sharedDefs.h"
 #include "utilsWrapperLinux.hpp"
 
@@ -79,29 +80,40 @@ class FactoryPackagesCreator<LinuxType::STANDARD> final
     public:
         static void getPackages(std::function<void(nlohmann::json&)> callback)
         {
+            static PackagesSourceCache cache;
+
             if (Utils::existsDir(DPKG_PATH))
             {
-                getDpkgInfo(DPKG_STATUS_PATH, callback);
+                cache.getPackages("dpkg", {DPKG_STATUS_PATH}, [](std::function<void(nlohmann::json&)> packagesCallback)
+                {
+                    getDpkgInfo(DPKG_STATUS_PATH, packagesCallback);
+                }, callback);
             }
 
             if (Utils::existsDir(PACMAN_PATH))
             {
-                getPacmanInfo(PACMAN_PATH, callback);
+                cache.getPackages("pacman", {PACMAN_LOCAL_PATH}, [](std::function<void(nlohmann::json&)> packagesCallback)
+                {
+                    getPacmanInfo(PACMAN_PATH, packagesCallback);
+                }, callback);
             }
 
             if (Utils::existsDir(RPM_PATH))
             {
-                getRpmInfo(callback);
+                cache.getPackages("rpm", RPM_DATABASE_FILES, getRpmInfo, callback);
             }
 
             if (Utils::existsDir(APK_PATH))
             {
-                getApkInfo(APK_DB_PATH, callback);
+                cache.getPackages("apk", {APK_DB_PATH}, [](std::function<void(nlohmann::json&)> packagesCallback)
+                {
+                    getApkInfo(APK_DB_PATH, packagesCallback);
+                }, callback);
             }
 
             if (Utils::existsDir(SNAP_PATH))
             {
-                getSnapInfo(callback);
+                cache.getPackages("snap", {SNAP_STATE_PATH}, getSnapInfo, callback);
             }
         }
 };
@@ -113,9 +125,11 @@ class FactoryPackagesCreator<LinuxType::LEGACY> final
     public:
         static void getPackages(std::function<void(nlohmann::json&)> callback)
         {
+            static PackagesSourceCache cache;
+
             if (Utils::existsDir(RPM_PATH))
             {
-                getRpmInfoLegacy(callback);
+                cache.getPackages("rpm", RPM_DATABASE_FILES, getRpmInfoLegacy, callback);
             }
         }
 };
@@ -15,28 +15,59 @@
 #include "fileSystem.hpp"
 #include "stdFileSystemHelper.hpp"
 #include "json.hpp"
-#include "jsonIO.hpp"
+#include "packagesSourceCache.hpp"
 #include "sharedDefs.h"
+#include "stringHelper.h"
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <set>
 
-template<typename TFileSystem = RealFileSystem, typename TJsonReader = JsonIO<nlohmann::json>>
+// Map to match fields
+static const std::map<std::string, std::string> NPM_FIELDS
+{
+    {"name", "name"},
+    {"version", "version"},
+    {"description", "description"},
+    {"homepage", "source"},
+};
+
+/**
+ * @brief Reads the package.json files, keeping only the top level fields used by the scan: The rest of the file (e.g.
+ * the dependencies, the scripts or the readme) is parsed but not stored.
+ */
+class NPMPackageJsonReader
+{
+    public:
+        static nlohmann::json readJson(const std::filesystem::path& filePath)
+        {
+            std::ifstream file(filePath);
+
+            if (!file.is_open())
+            {
+                throw std::runtime_error("Could not open file");
+            }
+
+            return nlohmann::json::parse(file,
+                                         [](int depth, nlohmann::json::parse_event_t event, nlohmann::json & parsed)
+            {
+                return event != nlohmann::json::parse_event_t::key ||
+                       depth != 1 ||
+                       NPM_FIELDS.find(parsed.get_ref<const std::string&>()) != NPM_FIELDS.end();
+            });
+        }
+};
+
+template<typename TFileSystem = RealFileSystem, typename TJsonReader = NPMPackageJsonReader>
 class NPM final
     : public TFileSystem
     , public TJsonReader
 {
+        std::shared_ptr<PackagesSourceCache> m_spCache;
+
         void parsePackage(const std::filesystem::path& folderPath, std::function<void(nlohmann::json&)>& callback)
         {
-            // Map to match fields
-            static const std::map<std::string, std::string> NPM_FIELDS
-            {
-                {"name", "name"},
-                {"version", "version"},
-                {"description", "description"},
-                {"homepage", "source"},
-            };
             const auto path = folderPath / "package.json";
 
             try
@@ -92,12 +123,34 @@ class NPM final
 
                     if (TFileSystem::exists(nodeModulesFolder))
                     {
-                        for (const auto& packageFolder : TFileSystem::directory_iterator(nodeModulesFolder))
+                        const auto exploreFolder
                         {
-                            if (TFileSystem::is_directory(packageFolder))
+                            [this, &nodeModulesFolder](std::function<void(nlohmann::json&)> folderCallback)
                             {
-                                parsePackage(packageFolder, callback);
+                                for (const auto& packageFolder : TFileSystem::directory_iterator(nodeModulesFolder))
+                                {
+                                    // Hidden entries (e.g. .bin or .package-lock.json) aren't packages.
+                                    if (!Utils::startsWith(std::filesystem::path(packageFolder).filename().string(), ".") &&
+                                            TFileSystem::is_directory(packageFolder))
+                                    {
+                                        parsePackage(packageFolder, folderCallback);
+                                    }
+                                }
                             }
+                        };
+
+                        if (m_spCache)
+                        {
+                            // npm replaces the folders of the packages it installs, upgrades or removes, which
+                            // modifies node_modules.
+                            m_spCache->getPackages(nodeModulesFolder.string(),
+                                                   {nodeModulesFolder.string()},
+                                                   exploreFolder,
+                                                   callback);
+                        }
+                        else
+                        {
+                            exploreFolder(callback);
                         }
                     }
                 }
@@ -109,7 +162,15 @@ class NPM final
         }
 
     public:
-        NPM() = default;
+        /**
+         * @brief Constructor.
+         *
+         * @param spCache Cache of the packages of each node_modules folder, nullptr to read every folder on each scan.
+         */
+        explicit NPM(std::shared_ptr<PackagesSourceCache> spCache = nullptr)
+            : m_spCache {std::move(spCache)}
+        {
+        }
         ~NPM() = default;
 
         void getPackages(const std::set<std::string>& osRootFolders, std::function<void(nlohmann::json&)> callback)
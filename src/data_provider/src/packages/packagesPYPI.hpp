@@ -16,9 +16,11 @@
 #include "fileSystem.hpp"
 #include "stdFileSystemHelper.hpp"
 #include "json.hpp"
+#include "packagesSourceCache.hpp"
 #include "sharedDefs.h"
 #include "stringHelper.h"
 #include <iostream>
+#include <memory>
 #include <set>
 
 const static std::map<std::string, std::string> FILE_MAPPING_PYPI {{"egg-info", "PKG-INFO"}, {"dist-info", "METADATA"}};
@@ -70,7 +72,11 @@ class PYPI final : public TFileSystem, public TFileIO
                         packageInfo[value] = Utils::trim(line.substr(key.length()), "\r");
                     }
                 }
-                return true;
+
+                // The headers end with an empty line, the description that follows (usually the whole readme) isn't
+                // read.
+                return !Utils::trim(line, "\r").empty() &&
+                       !(packageInfo.contains("name") && packageInfo.contains("version"));
             });
 
             // Check if we have a name and version
@@ -120,9 +126,25 @@ class PYPI final : public TFileSystem, public TFileIO
                     // Exist and is a directory
                     if (TFileSystem::exists(expandedPath) && TFileSystem::is_directory(expandedPath))
                     {
-                        for (const std::filesystem::path& path : TFileSystem::directory_iterator(expandedPath))
+                        const auto exploreFolder
+                        {
+                            [this, &expandedPath](std::function<void(nlohmann::json&)> folderCallback)
+                            {
+                                for (const std::filesystem::path& path : TFileSystem::directory_iterator(expandedPath))
+                                {
+                                    findCorrectPath(path, folderCallback);
+                                }
+                            }
+                        };
+
+                        if (m_spCache)
+                        {
+                            // Installing, upgrading or removing a package modifies the folder.
+                            m_spCache->getPackages(expandedPath, {expandedPath}, exploreFolder, callback);
+                        }
+                        else
                         {
-                            findCorrectPath(path, callback);
+                            exploreFolder(callback);
                         }
                     }
                 }
@@ -133,7 +155,19 @@ class PYPI final : public TFileSystem, public TFileIO
             }
         }
 
+        std::shared_ptr<PackagesSourceCache> m_spCache;
+
     public:
+        /**
+         * @brief Constructor.
+         *
+         * @param spCache Cache of the packages of each folder, nullptr to read every folder on each scan.
+         */
+        explicit PYPI(std::shared_ptr<PackagesSourceCache> spCache = nullptr)
+            : m_spCache {std::move(spCache)}
+        {
+        }
+
         void getPackages(const std::set<std::string>& osRootFolders, std::function<void(nlohmann::json&)> callback)
         {
 
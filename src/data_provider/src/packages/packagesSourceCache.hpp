@@ -0,0 +1,130 @@
+/*
+ * Wazuh SYSINFO
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _PACKAGES_SOURCE_CACHE_HPP
+#define _PACKAGES_SOURCE_CACHE_HPP
+
+#include <sys/stat.h>
+#include <ctime>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "json.hpp"
+
+/**
+ * @brief Caches the packages read from each package database (e.g. the dpkg status file, the RPM database or a
+ * site-packages folder), so a scan only reads the databases modified since the previous one. The version of a
+ * database is given by the modification time and size of its files: When they didn't change, the packages read by
+ * the previous scan are reported again.
+ */
+class PackagesSourceCache final
+{
+    public:
+        using PackagesCallback = std::function<void(nlohmann::json&)>;
+        using PackagesRetriever = std::function<void(PackagesCallback)>;
+
+        /**
+         * @brief Gets the packages of a database.
+         *
+         * @param source    Name of the database.
+         * @param files     Files (or directories) of the database, they don't need to exist.
+         * @param retriever Reads the packages of the database, called when its files changed since the last read.
+         * @param callback  Callback to be called for every single package.
+         */
+        void getPackages(const std::string& source,
+                         const std::vector<std::string>& files,
+                         const PackagesRetriever& retriever,
+                         const PackagesCallback& callback)
+        {
+            // The version is taken before reading, so a database modified while it's read is read again next time.
+            const auto currentVersion { version(files) };
+            std::vector<nlohmann::json> packages;
+            auto cached { false };
+
+            {
+                std::lock_guard<std::mutex> lock{m_mutex};
+                const auto it { m_sources.find(source) };
+
+                if (it != m_sources.end() && it->second.version == currentVersion)
+                {
+                    packages = it->second.packages;
+                    cached = true;
+                }
+                else
+                {
+                    m_sources.erase(source);
+                }
+            }
+
+            if (cached)
+            {
+                for (auto& package : packages)
+                {
+                    callback(package);
+                }
+
+                return;
+            }
+
+            retriever([&packages, &callback](nlohmann::json & package)
+            {
+                packages.push_back(package);
+                callback(package);
+            });
+
+            std::lock_guard<std::mutex> lock{m_mutex};
+            m_sources[source] = Source{currentVersion, std::move(packages)};
+        }
+
+    private:
+        struct Source final
+        {
+            std::string version;
+            std::vector<nlohmann::json> packages;
+        };
+
+        static std::string version(const std::vector<std::string>& files)
+        {
+            std::string ret;
+
+            for (const auto& file : files)
+            {
+                struct stat fileStat {};
+
+                if (stat(file.c_str(), &fileStat) == 0)
+                {
+#if defined(__APPLE__)
+                    const auto& modificationTime { fileStat.st_mtimespec };
+#elif defined(_WIN32)
+                    const struct timespec modificationTime { fileStat.st_mtime, 0 };
+#else
+                    const auto& modificationTime { fileStat.st_mtim };
+#endif
+                    ret += std::to_string(modificationTime.tv_sec) + "." +
+                           std::to_string(modificationTime.tv_nsec) + ":" +
+                           std::to_string(fileStat.st_size) + ";";
+                }
+                else
+                {
+                    ret += "-;";
+                }
+            }
+
+            return ret;
+        }
+
+        std::mutex m_mutex;
+        std::map<std::string, Source> m_sources;
+};
+
+#endif // _PACKAGES_SOURCE_CACHE_HPP
@@ -0,0 +1,209 @@
+/*
+ * Wazuh SYSINFO
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _PORT_LINUX_NETLINK_WRAPPER_H
+#define _PORT_LINUX_NETLINK_WRAPPER_H
+
+#include <functional>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <linux/netlink.h>
+#include <linux/sock_diag.h>
+#include <linux/inet_diag.h>
+#include "portLinuxWrapper.h"
+
+constexpr uint32_t NETLINK_ALL_STATES { 0xFFFFFFFF };
+constexpr size_t NETLINK_BUFFER_SIZE { 32768 };
+
+// Port built from a socket record of NETLINK_SOCK_DIAG, with the same values as the /proc/net files.
+class LinuxNetlinkPortWrapper final : public IPortWrapper
+{
+        PortType m_type;
+        inet_diag_msg m_msg;
+
+        std::string address(const __be32 rawAddress[4]) const
+        {
+            std::string retVal;
+
+            if (IPVERSION_TYPE.at(m_type) == IPV4)
+            {
+                in_addr addr {};
+                addr.s_addr = rawAddress[0];
+                retVal = Utils::NetworkHelper::IAddressToBinary(AF_INET, &addr);
+            }
+            else if (IPVERSION_TYPE.at(m_type) == IPV6)
+            {
+                in6_addr sin6 {};
+                memcpy(&sin6, rawAddress, sizeof(sin6));
+                retVal = Utils::NetworkHelper::IAddressToBinary(AF_INET6, &sin6);
+            }
+
+            return retVal;
+        }
+
+        bool isTcp() const
+        {
+            return PROTOCOL_TYPE.at(m_type) == TCP;
+        }
+
+    public:
+        explicit LinuxNetlinkPortWrapper(const PortType type, const inet_diag_msg& msg)
+            : m_type { type }
+            , m_msg (msg)
+        { }
+
+        ~LinuxNetlinkPortWrapper() = default;
+        std::string protocol() const override
+        {
+            std::string retVal;
+
+            const auto it { PORTS_TYPE.find(m_type) };
+
+            if (PORTS_TYPE.end() != it)
+            {
+                retVal = it->second;
+            }
+
+            return retVal;
+        }
+
+        std::string localIp() const override
+        {
+            return address(m_msg.id.idiag_src);
+        }
+        int32_t localPort() const override
+        {
+            return ntohs(m_msg.id.idiag_sport);
+        }
+        std::string remoteIP() const override
+        {
+            return address(m_msg.id.idiag_dst);
+        }
+        int32_t remotePort() const override
+        {
+            return ntohs(m_msg.id.idiag_dport);
+        }
+        int32_t txQueue() const override
+        {
+            // The write queue of a listening socket holds its maximum backlog, that /proc/net does not show
+            return isTcp() && m_msg.idiag_state == TCP_LISTEN ? 0 : static_cast<int32_t>(m_msg.idiag_wqueue);
+        }
+        int32_t rxQueue() const override
+        {
+            return static_cast<int32_t>(m_msg.idiag_rqueue);
+        }
+        int64_t inode() const override
+        {
+            return static_cast<int64_t>(m_msg.idiag_inode);
+        }
+        std::string state() const override
+        {
+            std::string retVal;
+
+            if (isTcp())
+            {
+                const auto itState { STATE_TYPE.find(m_msg.idiag_state) };
+
+                if (STATE_TYPE.end() != itState)
+                {
+                    retVal = itState->second;
+                }
+            }
+
+            return retVal;
+        }
+
+        std::string processName() const override
+        {
+            return UNKNOWN_VALUE;
+        }
+
+        int32_t pid() const override
+        {
+            return {};
+        }
+
+        /**
+         * @brief Dump the sockets of a type through NETLINK_SOCK_DIAG.
+         *
+         * @param type Protocol and IP version of the sockets.
+         * @param states Mask of the TCP states to dump (1 << TCP_LISTEN for the listening sockets only).
+         * @param callback Function called with every socket record.
+         * @return true if the whole dump was received, false if the kernel does not support it.
+         */
+        static bool dump(const PortType type,
+                         const uint32_t states,
+                         const std::function<void(const inet_diag_msg&)>& callback)
+        {
+            const int fd { socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_SOCK_DIAG) };
+
+            if (fd < 0)
+            {
+                return false;
+            }
+
+            struct
+            {
+                nlmsghdr nlh;
+                inet_diag_req_v2 req;
+            } request {};
+
+            request.nlh.nlmsg_len = sizeof(request);
+            request.nlh.nlmsg_type = SOCK_DIAG_BY_FAMILY;
+            request.nlh.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+            request.req.sdiag_family = IPVERSION_TYPE.at(type) == IPV4 ? AF_INET : AF_INET6;
+            request.req.sdiag_protocol = PROTOCOL_TYPE.at(type) == TCP ? IPPROTO_TCP : IPPROTO_UDP;
+            request.req.idiag_states = states;
+
+            sockaddr_nl kernel {};
+            kernel.nl_family = AF_NETLINK;
+
+            auto retVal { sendto(fd, &request, sizeof(request), 0, reinterpret_cast<sockaddr*>(&kernel), sizeof(kernel)) == sizeof(request) };
+            auto done { false };
+            std::vector<nlmsghdr> buffer(NETLINK_BUFFER_SIZE / sizeof(nlmsghdr));
+
+            while (retVal && !done)
+            {
+                auto length { recv(fd, buffer.data(), buffer.size() * sizeof(nlmsghdr), 0) };
+
+                if (length <= 0)
+                {
+                    retVal = length < 0 && errno == EINTR;
+                    continue;
+                }
+
+                for (auto nlh { buffer.data() }; NLMSG_OK(nlh, length); nlh = NLMSG_NEXT(nlh, length))
+                {
+                    if (nlh->nlmsg_type == NLMSG_DONE)
+                    {
+                        done = true;
+                        break;
+                    }
+
+                    if (nlh->nlmsg_type == NLMSG_ERROR)
+                    {
+                        retVal = false;
+                        break;
+                    }
+
+                    if (nlh->nlmsg_type == SOCK_DIAG_BY_FAMILY)
+                    {
+                        callback(*reinterpret_cast<const inet_diag_msg*>(NLMSG_DATA(nlh)));
+                    }
+                }
+            }
+
+            close(fd);
+            return retVal && done;
+        }
+};
+
+#endif //_PORT_LINUX_NETLINK_WRAPPER_H
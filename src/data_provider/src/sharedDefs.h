@@ -14,6 +14,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 constexpr auto WM_SYS_HW_DIR {"/sys/class/dmi/id/board_serial"};
 constexpr auto WM_SYS_CPU_DIR {"/proc/cpuinfo"};
@@ -30,12 +31,22 @@ constexpr auto DPKG_PATH {"/var/lib/dpkg/"};
 constexpr auto DPKG_STATUS_PATH {"/var/lib/dpkg/status"};
 
 constexpr auto RPM_PATH {"/var/lib/rpm/"};
+// Files modified by the RPM database backends (Berkeley DB, SQLite) when a package is installed or removed.
+static const std::vector<std::string> RPM_DATABASE_FILES
+{
+    "/var/lib/rpm/",
+    "/var/lib/rpm/Packages",
+    "/var/lib/rpm/rpmdb.sqlite",
+    "/var/lib/rpm/rpmdb.sqlite-wal"
+};
 
 constexpr auto PACMAN_PATH {"/var/lib/pacman"};
+constexpr auto PACMAN_LOCAL_PATH {"/var/lib/pacman/local"};
 
 constexpr auto APK_PATH {"/lib/apk/db"};
 constexpr auto APK_DB_PATH {"/lib/apk/db/installed"};
 constexpr auto SNAP_PATH {"/var/lib/snapd"};
+constexpr auto SNAP_STATE_PATH {"/var/lib/snapd/state.json"};
 
 constexpr auto UNKNOWN_VALUE {" "};
 constexpr auto MAC_ADDRESS_COUNT_SEGMENTS
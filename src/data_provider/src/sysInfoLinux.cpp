@@ -11,6 +11,11 @@
 #include <fstream>
 #include <iostream>
 #include <regex>
+#include <mutex>
+#include <unordered_set>
+#include <fcntl.h>
+#include <grp.h>
+#include <pwd.h>
 #include <sys/utsname.h>
 #include "packages/modernPackageDataRetriever.hpp"
 #include "sharedDefs.h"
@@ -19,12 +24,12 @@
 #include "cmdHelper.h"
 #include "osinfo/sysOsParsers.h"
 #include "sysInfo.hpp"
-#include "readproc.h"
 #include "networkUnixHelper.h"
 #include "networkHelper.h"
 #include "network/networkLinuxWrapper.h"
 #include "network/networkFamilyDataAFactory.h"
 #include "ports/portLinuxWrapper.h"
+#include "ports/portLinuxNetlinkWrapper.h"
 #include "ports/portImpl.h"
 #include "packages/berkeleyRpmDbHelper.h"
 #include "packages/packageLinuxDataRetriever.h"
@@ -32,20 +37,57 @@
 
 using ProcessInfo = std::unordered_map<int64_t, std::pair<int32_t, std::string>>;
 
-struct ProcTableDeleter
+// Fields of /proc/<pid>/stat, numbered as in proc(5).
+enum ProcStatField
 {
-    void operator()(PROCTAB* proc)
-    {
-        closeproc(proc);
-    }
-    void operator()(proc_t* proc)
-    {
-        freeproc(proc);
-    }
+    STAT_PPID = 4,
+    STAT_PGRP = 5,
+    STAT_SESSION = 6,
+    STAT_TTY = 7,
+    STAT_UTIME = 14,
+    STAT_STIME = 15,
+    STAT_PRIORITY = 18,
+    STAT_NICE = 19,
+    STAT_NLWP = 20,
+    STAT_START_TIME = 22,
+    STAT_PROCESSOR = 39,
+    STAT_FIELDS_SIZE
+};
+
+// Fields of /proc/<pid>/statm, in pages.
+enum ProcStatmField
+{
+    STATM_SIZE,
+    STATM_RESIDENT,
+    STATM_SHARE,
+    STATM_FIELDS_SIZE
+};
+
+constexpr auto PROC_FILE_BUFFER_SIZE {4096};
+
+// Command line of the processes, that does not change while they live. The processes are
+// identified by their PID and start time, so a reused PID is never taken for the old process.
+struct ProcessCmdline
+{
+    uint64_t startTime;
+    std::string cmd;
+    std::string argvs;
+    bool seen;
 };
 
-using SysInfoProcessesTable = std::unique_ptr<PROCTAB, ProcTableDeleter>;
-using SysInfoProcess        = std::unique_ptr<proc_t, ProcTableDeleter>;
+static std::unordered_map<pid_t, ProcessCmdline> s_processesCmdline;
+static std::mutex s_processesCmdlineMutex;
+
+// State shared by the processes of a scan, to avoid allocations and repeated lookups.
+struct ProcessesScan
+{
+    std::unordered_map<uint32_t, std::string> users;
+    std::unordered_map<uint32_t, std::string> groups;
+    std::string buffer;
+    std::string name;
+    std::vector<long long> stat;
+    std::vector<long> statm;
+};
 
 static void parseLineAndFillMap(const std::string& line, const std::string& separator, std::map<std::string, std::string>& systemInfo)
 {
@@ -79,62 +121,242 @@ static bool getSystemInfo(const std::string& fileName, const std::string& separa
     return ret;
 }
 
-static nlohmann::json getProcessInfo(const SysInfoProcess& process)
+static bool readProcFile(const int dirFd, const char* fileName, std::string& buffer)
 {
-    nlohmann::json jsProcessInfo{};
-    // Current process information
-    jsProcessInfo["pid"]        = std::to_string(process->tid);
-    jsProcessInfo["name"]       = process->cmd;
-    jsProcessInfo["state"]      = &process->state;
-    jsProcessInfo["ppid"]       = process->ppid;
-    jsProcessInfo["utime"]      = process->utime;
-    jsProcessInfo["stime"]      = process->stime;
-    std::string commandLine;
-    std::string commandLineArgs;
+    const int fd { openat(dirFd, fileName, O_RDONLY | O_CLOEXEC) };
+
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    // The buffer keeps its capacity between reads, so it is allocated only for the first processes
+    size_t length {0};
+    ssize_t bytes {0};
+    buffer.resize(std::max<size_t>(buffer.capacity(), PROC_FILE_BUFFER_SIZE));
+
+    while ((bytes = read(fd, &buffer[length], buffer.size() - length)) > 0)
+    {
+        length += bytes;
+
+        if (length == buffer.size())
+        {
+            buffer.resize(buffer.size() * 2);
+        }
+    }
+
+    close(fd);
+    buffer.resize(length);
+    return bytes == 0;
+}
+
+static bool parseProcStat(const std::string& statContent, std::string& name, char& state, std::vector<long long>& fields)
+{
+    // The name is between parentheses and may contain any character, even parentheses
+    const auto openParenthesisPos { statContent.find('(') };
+    const auto closeParenthesisPos { statContent.rfind(')') };
+
+    if (openParenthesisPos == std::string::npos || closeParenthesisPos == std::string::npos ||
+            closeParenthesisPos < openParenthesisPos || closeParenthesisPos + 2 >= statContent.size())
+    {
+        return false;
+    }
+
+    name = statContent.substr(openParenthesisPos + 1, closeParenthesisPos - openParenthesisPos - 1);
+    state = statContent[closeParenthesisPos + 2];
+    fields.assign(STAT_FIELDS_SIZE, 0);
+
+    const char* field { statContent.c_str() + closeParenthesisPos + 3 };
+
+    for (size_t i = STAT_PPID; i < fields.size() && *field; ++i)
+    {
+        char* end { nullptr };
+        fields[i] = std::strtoll(field, &end, 10);
+        field = end;
+    }
+
+    return true;
+}
+
+static void parseProcStatm(const std::string& statm, std::vector<long>& fields)
+{
+    const char* field { statm.c_str() };
+    fields.assign(STATM_FIELDS_SIZE, 0);
+
+    for (auto& value : fields)
+    {
+        char* end { nullptr };
+        value = std::strtol(field, &end, 10);
+        field = end;
+    }
+}
 
-    if (process->cmdline && process->cmdline[0])
+// Get the real, effective, saved and filesystem IDs of a "Uid:" or "Gid:" line of /proc/<pid>/status.
+static void parseProcStatusIds(const std::string& status, const std::string& key, uint32_t ids[4])
+{
+    auto pos { status.find(key) };
+
+    std::fill(ids, ids + 4, 0);
+
+    if (pos != std::string::npos)
     {
-        commandLine = process->cmdline[0];
+        const char* field { status.c_str() + pos + key.size() };
 
-        for (int idx = 1; process->cmdline[idx]; ++idx)
+        for (int i = 0; i < 4; ++i)
         {
-            const auto cmdlineArgSize { sizeof(process->cmdline[idx]) };
+            char* end { nullptr };
+            ids[i] = static_cast<uint32_t>(std::strtoul(field, &end, 10));
+            field = end;
+        }
+    }
+}
+
+static void parseProcCmdline(const std::string& cmdline, std::string& commandLine, std::string& commandLineArgs)
+{
+    std::vector<std::string> args;
+
+    // The arguments are separated by null characters
+    for (size_t pos = 0; pos < cmdline.size();)
+    {
+        const auto end { cmdline.find('\0', pos) };
+        args.push_back(cmdline.substr(pos, end == std::string::npos ? std::string::npos : end - pos));
+        pos = end == std::string::npos ? cmdline.size() : end + 1;
+    }
 
-            if (strnlen(process->cmdline[idx], cmdlineArgSize) != 0)
+    commandLine.clear();
+    commandLineArgs.clear();
+
+    if (!args.empty())
+    {
+        commandLine = args[0];
+
+        for (size_t idx = 1; idx < args.size(); ++idx)
+        {
+            if (!args[idx].empty())
             {
-                commandLineArgs += process->cmdline[idx];
+                commandLineArgs += args[idx];
 
-                if (process->cmdline[idx + 1])
+                if (idx + 1 < args.size())
                 {
                     commandLineArgs += " ";
                 }
             }
         }
     }
+}
+
+static const std::string& getUserName(const uint32_t uid, std::unordered_map<uint32_t, std::string>& users)
+{
+    const auto it { users.find(uid) };
+
+    if (it != users.end())
+    {
+        return it->second;
+    }
+
+    struct passwd pwd {};
+    struct passwd* result { nullptr };
+    char buffer[PROC_FILE_BUFFER_SIZE];
 
-    jsProcessInfo["cmd"]        = commandLine;
-    jsProcessInfo["argvs"]      = commandLineArgs;
-    jsProcessInfo["euser"]      = process->euser;
-    jsProcessInfo["ruser"]      = process->ruser;
-    jsProcessInfo["suser"]      = process->suser;
-    jsProcessInfo["egroup"]     = process->egroup;
-    jsProcessInfo["rgroup"]     = process->rgroup;
-    jsProcessInfo["sgroup"]     = process->sgroup;
-    jsProcessInfo["fgroup"]     = process->fgroup;
-    jsProcessInfo["priority"]   = process->priority;
-    jsProcessInfo["nice"]       = process->nice;
-    jsProcessInfo["size"]       = process->size;
-    jsProcessInfo["vm_size"]    = process->vm_size;
-    jsProcessInfo["resident"]   = process->vm_rss;
-    jsProcessInfo["share"]      = process->share;
-    jsProcessInfo["start_time"] = Utils::timeTick2unixTime(process->start_time);
-    jsProcessInfo["pgrp"]       = process->pgrp;
-    jsProcessInfo["session"]    = process->session;
-    jsProcessInfo["tgid"]       = process->tgid;
-    jsProcessInfo["tty"]        = process->tty;
-    jsProcessInfo["processor"]  = process->processor;
-    jsProcessInfo["nlwp"]       = process->nlwp;
-    return jsProcessInfo;
+    getpwuid_r(uid, &pwd, buffer, sizeof(buffer), &result);
+
+    return users[uid] = result ? result->pw_name : std::to_string(uid);
+}
+
+static const std::string& getGroupName(const uint32_t gid, std::unordered_map<uint32_t, std::string>& groups)
+{
+    const auto it { groups.find(gid) };
+
+    if (it != groups.end())
+    {
+        return it->second;
+    }
+
+    struct group grp {};
+    struct group* result { nullptr };
+    char buffer[PROC_FILE_BUFFER_SIZE];
+
+    getgrgid_r(gid, &grp, buffer, sizeof(buffer), &result);
+
+    return groups[gid] = result ? result->gr_name : std::to_string(gid);
+}
+
+static bool getProcessInfo(const int pidFd, const std::string& pid, ProcessesScan& scan, nlohmann::json& jsProcessInfo)
+{
+    static const long pageSizeKb { sysconf(_SC_PAGESIZE) / 1024 };
+    char state { 0 };
+    uint32_t uids[4];
+    uint32_t gids[4];
+
+    if (!readProcFile(pidFd, "stat", scan.buffer) || !parseProcStat(scan.buffer, scan.name, state, scan.stat))
+    {
+        return false;
+    }
+
+    const uint64_t startTime { static_cast<uint64_t>(scan.stat[STAT_START_TIME]) };
+    const auto inserted { s_processesCmdline.emplace(std::stoi(pid), ProcessCmdline{}) };
+    auto& cmdline { inserted.first->second };
+
+    // Only the new processes have their command line read
+    if (inserted.second || cmdline.startTime != startTime)
+    {
+        if (!readProcFile(pidFd, "cmdline", scan.buffer))
+        {
+            scan.buffer.clear();
+        }
+
+        parseProcCmdline(scan.buffer, cmdline.cmd, cmdline.argvs);
+        cmdline.startTime = startTime;
+    }
+
+    cmdline.seen = true;
+
+    if (!readProcFile(pidFd, "statm", scan.buffer))
+    {
+        scan.buffer.clear();
+    }
+
+    parseProcStatm(scan.buffer, scan.statm);
+
+    if (!readProcFile(pidFd, "status", scan.buffer))
+    {
+        scan.buffer.clear();
+    }
+
+    parseProcStatusIds(scan.buffer, "\nUid:", uids);
+    parseProcStatusIds(scan.buffer, "\nGid:", gids);
+
+    // Current process information
+    jsProcessInfo["pid"]        = pid;
+    jsProcessInfo["name"]       = scan.name;
+    jsProcessInfo["state"]      = std::string(1, state);
+    jsProcessInfo["ppid"]       = static_cast<int>(scan.stat[STAT_PPID]);
+    jsProcessInfo["utime"]      = static_cast<unsigned long long>(scan.stat[STAT_UTIME]);
+    jsProcessInfo["stime"]      = static_cast<unsigned long long>(scan.stat[STAT_STIME]);
+    jsProcessInfo["cmd"]        = cmdline.cmd;
+    jsProcessInfo["argvs"]      = cmdline.argvs;
+    jsProcessInfo["euser"]      = getUserName(uids[1], scan.users);
+    jsProcessInfo["ruser"]      = getUserName(uids[0], scan.users);
+    jsProcessInfo["suser"]      = getUserName(uids[2], scan.users);
+    jsProcessInfo["egroup"]     = getGroupName(gids[1], scan.groups);
+    jsProcessInfo["rgroup"]     = getGroupName(gids[0], scan.groups);
+    jsProcessInfo["sgroup"]     = getGroupName(gids[2], scan.groups);
+    jsProcessInfo["fgroup"]     = getGroupName(gids[3], scan.groups);
+    jsProcessInfo["priority"]   = static_cast<long>(scan.stat[STAT_PRIORITY]);
+    jsProcessInfo["nice"]       = static_cast<long>(scan.stat[STAT_NICE]);
+    jsProcessInfo["size"]       = scan.statm[STATM_SIZE];
+    jsProcessInfo["vm_size"]    = static_cast<unsigned long>(scan.statm[STATM_SIZE] * pageSizeKb);
+    jsProcessInfo["resident"]   = static_cast<unsigned long>(scan.statm[STATM_RESIDENT] * pageSizeKb);
+    jsProcessInfo["share"]      = scan.statm[STATM_SHARE];
+    jsProcessInfo["start_time"] = Utils::timeTick2unixTime(startTime);
+    jsProcessInfo["pgrp"]       = static_cast<int>(scan.stat[STAT_PGRP]);
+    jsProcessInfo["session"]    = static_cast<int>(scan.stat[STAT_SESSION]);
+    // Only the thread group leaders are listed in /proc
+    jsProcessInfo["tgid"]       = std::stoi(pid);
+    jsProcessInfo["tty"]        = static_cast<int>(scan.stat[STAT_TTY]);
+    jsProcessInfo["processor"]  = static_cast<int>(scan.stat[STAT_PROCESSOR]);
+    jsProcessInfo["nlwp"]       = static_cast<int>(scan.stat[STAT_NLWP]);
+    return true;
 }
 
 static std::string getSerialNumber()
@@ -414,7 +636,7 @@ nlohmann::json SysInfo::getNetworks() const
 }
 
 
-ProcessInfo portProcessInfo(const std::string& procPath, const std::deque<int64_t>& inodes)
+ProcessInfo portProcessInfo(const std::string& procPath, const std::unordered_set<int64_t>& inodes)
 {
     ProcessInfo ret;
     auto getProcessName = [](const std::string & filePath) -> std::string
@@ -434,75 +656,56 @@ ProcessInfo portProcessInfo(const std::string& procPath, const std::deque<int64_
         return processInfo;
     };
 
-    auto findInode = [](const std::string & filePath) -> int64_t
+    const std::unique_ptr<DIR, Utils::DirSmartDeleter> spProcDir { opendir(procPath.c_str()) };
+
+    if (!spProcDir)
     {
-        constexpr size_t MAX_LENGTH {256};
-        char buffer[MAX_LENGTH];
+        return ret;
+    }
 
-        if (-1 == readlink(filePath.c_str(), buffer, MAX_LENGTH))
+    // Iterate proc directory.
+    for (auto procEntry { readdir(spProcDir.get()) }; procEntry; procEntry = readdir(spProcDir.get()))
+    {
+        // Only directories that represent a PID are inspected.
+        if (!Utils::isNumber(procEntry->d_name))
         {
-            throw std::system_error(errno, std::system_category(), "readlink");
+            continue;
         }
 
-        // ret format is "socket:[<num>]".
-        const std::string bufferStr {buffer};
-        const auto openBracketPos {bufferStr.find("[")};
-        const auto closeBracketPos {bufferStr.find("]")};
-        const auto match {bufferStr.substr(openBracketPos + 1, closeBracketPos - openBracketPos - 1)};
+        // Only fd directory is inspected.
+        const std::string procFilePath { procPath + "/" + procEntry->d_name };
+        const std::unique_ptr<DIR, Utils::DirSmartDeleter> spFdDir { opendir((procFilePath + "/fd").c_str()) };
 
-        return std::stoll(match);
-    };
+        if (!spFdDir)
+        {
+            continue;
+        }
 
-    if (Utils::existsDir(procPath))
-    {
-        std::vector<std::string> procFiles = Utils::enumerateDir(procPath);
+        std::string processName;
 
-        // Iterate proc directory.
-        for (const auto& procFile : procFiles)
+        for (auto fdEntry { readdir(spFdDir.get()) }; fdEntry; fdEntry = readdir(spFdDir.get()))
         {
-            // Only directories that represent a PID are inspected.
-            const std::string procFilePath {procPath + "/" + procFile};
+            // Only symlinks that represent a socket are read, their format is "socket:[<num>]".
+            constexpr char SOCKET_PREFIX[] { "socket:[" };
+            char buffer[64];
+            const auto length { readlinkat(dirfd(spFdDir.get()), fdEntry->d_name, buffer, sizeof(buffer) - 1) };
 
-            if (Utils::isNumber(procFile) && Utils::existsDir(procFilePath))
+            if (length <= 0 || strncmp(buffer, SOCKET_PREFIX, sizeof(SOCKET_PREFIX) - 1) != 0)
             {
-                // Only fd directory is inspected.
-                const std::string pidFilePath {procFilePath + "/fd"};
-
-                if (Utils::existsDir(pidFilePath))
-                {
-                    std::vector<std::string> fdFiles = Utils::enumerateDir(pidFilePath);
+                continue;
+            }
 
-                    // Iterate fd directory.
-                    for (const auto& fdFile : fdFiles)
-                    {
-                        // Only sysmlinks that represent a socket are read.
-                        const std::string fdFilePath {pidFilePath + "/" + fdFile};
+            buffer[length] = '\0';
+            const int64_t inode { std::strtoll(buffer + sizeof(SOCKET_PREFIX) - 1, nullptr, 10) };
 
-                        if (!Utils::startsWith(fdFile, ".") && Utils::existsSocket(fdFilePath))
-                        {
-                            try
-                            {
-                                int64_t inode {findInode(fdFilePath)};
-
-                                if (std::any_of(inodes.cbegin(), inodes.cend(), [&](const auto it)
-                            {
-                                return it == inode;
-                            }))
-                                {
-                                    std::string statPath {procFilePath + "/" + "stat"};
-                                    std::string processName = getProcessName(statPath);
-                                    int32_t pid { std::stoi(procFile) };
-
-                                    ret.emplace(std::make_pair(inode, std::make_pair(pid, processName)));
-                                }
-                            }
-                            catch (const std::exception& e)
-                            {
-                                std::cerr << "Error: " << e.what() << std::endl;
-                            }
-                        }
-                    }
+            if (inodes.find(inode) != inodes.end())
+            {
+                if (processName.empty())
+                {
+                    processName = getProcessName(procFilePath + "/stat");
                 }
+
+                ret.emplace(inode, std::make_pair(std::stoi(procEntry->d_name), processName));
             }
         }
     }
@@ -510,42 +713,80 @@ ProcessInfo portProcessInfo(const std::string& procPath, const std::deque<int64_
     return ret;
 }
 
-nlohmann::json SysInfo::getPorts() const
+static void getProcPorts(const PortType type, nlohmann::json& ports)
 {
-    nlohmann::json ports;
-    std::deque<int64_t> inodes;
+    const auto fileContent { Utils::getFileContent(WM_SYS_NET_DIR + PORTS_TYPE.at(type)) };
+    auto rows { Utils::split(fileContent, '\n') };
+    auto fileBody { false };
 
-    for (const auto& portType : PORTS_TYPE)
+    for (auto& row : rows)
     {
-        const auto fileContent { Utils::getFileContent(WM_SYS_NET_DIR + portType.second) };
-        auto rows { Utils::split(fileContent, '\n') };
-        auto fileBody { false };
+        nlohmann::json port {};
+
+        try
+        {
+            if (fileBody)
+            {
+                row = Utils::trim(row);
+                Utils::replaceAll(row, "\t", " ");
+                Utils::replaceAll(row, "  ", " ");
+                std::make_unique<PortImpl>(std::make_shared<LinuxPortWrapper>(type, row))->buildPortData(port);
+                ports.push_back(std::move(port));
+            }
 
-        for (auto& row : rows)
+            fileBody = true;
+        }
+        catch (const std::exception& e)
+        {
+            std::cerr << "Error while parsing port: " << e.what() << std::endl;
+        }
+    }
+}
+
+static bool getNetlinkPorts(const PortType type, const uint32_t states, nlohmann::json& ports)
+{
+    nlohmann::json dumpPorts;
+
+    const auto ret
+    {
+        LinuxNetlinkPortWrapper::dump(type, states, [&dumpPorts, type](const inet_diag_msg & msg)
         {
             nlohmann::json port {};
+            std::make_unique<PortImpl>(std::make_shared<LinuxNetlinkPortWrapper>(type, msg))->buildPortData(port);
+            dumpPorts.push_back(std::move(port));
+        })
+    };
 
-            try
-            {
-                if (fileBody)
-                {
-                    row = Utils::trim(row);
-                    Utils::replaceAll(row, "\t", " ");
-                    Utils::replaceAll(row, "  ", " ");
-                    std::make_unique<PortImpl>(std::make_shared<LinuxPortWrapper>(portType.first, row))->buildPortData(port);
-                    inodes.push_back(port.at("inode"));
-                    ports.push_back(std::move(port));
-                }
+    // An interrupted dump is discarded, the ports are read again from /proc
+    if (ret)
+    {
+        for (auto& port : dumpPorts)
+        {
+            ports.push_back(std::move(port));
+        }
+    }
 
-                fileBody = true;
-            }
-            catch (const std::exception& e)
-            {
-                std::cerr << "Error while parsing port: " << e.what() << std::endl;
-            }
+    return ret;
+}
+
+nlohmann::json SysInfo::getPorts() const
+{
+    nlohmann::json ports;
+    std::unordered_set<int64_t> inodes;
+
+    for (const auto& portType : PORTS_TYPE)
+    {
+        // The sockets are streamed by the kernel, /proc/net is only read if NETLINK_SOCK_DIAG is not available
+        if (!getNetlinkPorts(portType.first, NETLINK_ALL_STATES, ports))
+        {
+            getProcPorts(portType.first, ports);
         }
     }
 
+    for (const auto& port : ports)
+    {
+        inodes.insert(port.at("inode").get<int64_t>());
+    }
 
     if (!inodes.empty())
     {
@@ -576,20 +817,49 @@ nlohmann::json SysInfo::getPorts() const
 
 void SysInfo::getProcessesInfo(std::function<void(nlohmann::json&)> callback) const
 {
+    const std::unique_ptr<DIR, Utils::DirSmartDeleter> spProcDir { opendir(WM_SYS_PROC_DIR) };
 
-    const SysInfoProcessesTable spProcTable
+    if (!spProcDir)
     {
-        openproc(PROC_FILLMEM | PROC_FILLSTAT | PROC_FILLSTATUS | PROC_FILLARG | PROC_FILLGRP | PROC_FILLUSR | PROC_FILLCOM | PROC_FILLENV)
-    };
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock { s_processesCmdlineMutex };
+    ProcessesScan scan;
+
+    for (auto& process : s_processesCmdline)
+    {
+        process.second.seen = false;
+    }
+
+    for (auto entry { readdir(spProcDir.get()) }; entry; entry = readdir(spProcDir.get()))
+    {
+        if (!Utils::isNumber(entry->d_name))
+        {
+            continue;
+        }
+
+        const int pidFd { openat(dirfd(spProcDir.get()), entry->d_name, O_RDONLY | O_DIRECTORY | O_CLOEXEC) };
+
+        // The process may have ended while the directory was being read
+        if (pidFd >= 0)
+        {
+            nlohmann::json jsProcessInfo{};
+            const bool ret { getProcessInfo(pidFd, entry->d_name, scan, jsProcessInfo) };
 
-    SysInfoProcess spProcInfo { readproc(spProcTable.get(), nullptr) };
+            close(pidFd);
+
+            if (ret)
+            {
+                callback(jsProcessInfo);
+            }
+        }
+    }
 
-    while (nullptr != spProcInfo)
+    // Forget the processes that ended
+    for (auto it = s_processesCmdline.begin(); it != s_processesCmdline.end();)
     {
-        // Get process information object and push it to the caller
-        auto processInfo = getProcessInfo(spProcInfo);
-        callback(processInfo);
-        spProcInfo.reset(readproc(spProcTable.get(), nullptr));
+        it = it->second.seen ? std::next(it) : s_processesCmdline.erase(it);
     }
 }
 
@@ -10,6 +10,8 @@
  */
 
 #include "sysInfoPackagesNPM_test.hpp"
+#include <cstdio>
+#include <fstream>
 
 using testing::_;
 using testing::Return;
@@ -182,3 +184,60 @@ TEST_F(NPMTest, getPackages_ValidPackageJson2Test)
     EXPECT_TRUE(callbackCalledSecond);
 }
 
+
+TEST_F(NPMTest, getPackages_CachedFolderTest)
+{
+    std::vector<std::filesystem::path> fakePackages = {"/fake/node_modules/.bin", "/fake/node_modules/package1"};
+    auto spCache {std::make_shared<PackagesSourceCache>()};
+    npm = std::make_unique<NPM<MockFileSystem<std::vector<std::filesystem::path>>, MockJsonIO>>(spCache);
+
+    EXPECT_CALL(*npm, exists(_)).WillRepeatedly(Return(true));
+    EXPECT_CALL(*npm, is_directory(_)).WillRepeatedly(Return(true));
+    EXPECT_CALL(*npm, directory_iterator(_)).WillOnce(Return(fakePackages));
+
+    nlohmann::json fakePackageJson1 = {{"name", "TestPackage1"}, {"version", "1.0.0"}};
+
+    // The folder doesn't exist in the real filesystem, so its version doesn't change and it's only read once.
+    EXPECT_CALL(*npm, readJson(std::filesystem::path("/fake/node_modules/package1/package.json")))
+    .WillOnce(Return(fakePackageJson1));
+
+    std::vector<nlohmann::json> packages;
+    auto callback = [&](nlohmann::json & json)
+    {
+        packages.push_back(json);
+    };
+
+    std::set<std::string> folders = {"/fake"};
+
+    npm->getPackages(folders, callback);
+    npm->getPackages(folders, callback);
+
+    ASSERT_EQ(packages.size(), 2u);
+    EXPECT_EQ(packages[0], packages[1]);
+    EXPECT_EQ(packages[0].at("name"), "TestPackage1");
+}
+
+TEST_F(NPMTest, packageJsonReaderTest)
+{
+    constexpr auto PACKAGE_JSON {"package_test.json"};
+    std::ofstream{PACKAGE_JSON} << R"({
+        "name": "TestPackage1",
+        "version": "1.0.0",
+        "description": "Test package",
+        "homepage": "https://example.com",
+        "dependencies": {"name": "dependency", "version": "2.0.0"},
+        "readme": "Readme"
+    })";
+
+    const auto packageJson = NPMPackageJsonReader::readJson(PACKAGE_JSON);
+    std::remove(PACKAGE_JSON);
+
+    EXPECT_EQ(packageJson,
+              nlohmann::json::parse(R"({
+        "name": "TestPackage1",
+        "version": "1.0.0",
+        "description": "Test package",
+        "homepage": "https://example.com"
+    })"));
+    EXPECT_THROW(NPMPackageJsonReader::readJson(PACKAGE_JSON), std::runtime_error);
+}
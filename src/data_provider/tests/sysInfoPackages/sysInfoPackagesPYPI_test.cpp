@@ -392,3 +392,81 @@ TEST_F(PYPITest, getPackages_InvalidPackageTest_MissingVersion)
     std::cout << capturedJson.dump(4) << std::endl;
     EXPECT_TRUE(capturedJson.empty());
 }
+
+TEST_F(PYPITest, getPackages_StopsReadingAtTheEndOfTheHeaders)
+{
+    std::vector<std::filesystem::path> fakeFiles = {"/fake/dir/dist-info"};
+
+    EXPECT_CALL(*pypi, exists(_)).WillRepeatedly(Return(true));
+    EXPECT_CALL(*pypi, is_directory(_)).WillRepeatedly(Return(true));
+    EXPECT_CALL(*pypi, directory_iterator(_)).WillRepeatedly(Return(fakeFiles));
+    EXPECT_CALL(*pypi, is_regular_file(_)).WillRepeatedly(Return(true));
+
+    std::vector<std::string> fakePackageLines = {"Metadata-Version: 2.1", "Name: TestPackage", "", "Version: 1.0.0"};
+    size_t linesRead {0};
+    EXPECT_CALL(*pypi, readLineByLine(std::filesystem::path("/fake/dir/dist-info"), _)).WillOnce([&](const std::filesystem::path&, const std::function<bool(const std::string&)>& callback)
+    {
+        for (const auto& line : fakePackageLines)
+        {
+            ++linesRead;
+
+            if (!callback(line))
+            {
+                break;
+            }
+        }
+    });
+
+    nlohmann::json capturedJson;
+    auto callback = [&](nlohmann::json & j)
+    {
+        capturedJson = j;
+    };
+
+    std::set<std::string> folders = { "/usr/local/lib/python3.9/site-packages" };
+
+    pypi->getPackages(folders, callback);
+
+    // The version after the headers isn't read.
+    EXPECT_EQ(linesRead, 3u);
+    EXPECT_TRUE(capturedJson.empty());
+}
+
+TEST_F(PYPITest, getPackages_StopsReadingWhenTheFieldsAreFound)
+{
+    std::vector<std::filesystem::path> fakeFiles = {"/fake/dir/dist-info"};
+
+    EXPECT_CALL(*pypi, exists(_)).WillRepeatedly(Return(true));
+    EXPECT_CALL(*pypi, is_directory(_)).WillRepeatedly(Return(true));
+    EXPECT_CALL(*pypi, directory_iterator(_)).WillRepeatedly(Return(fakeFiles));
+    EXPECT_CALL(*pypi, is_regular_file(_)).WillRepeatedly(Return(true));
+
+    std::vector<std::string> fakePackageLines = {"Name: TestPackage", "Version: 1.0.0", "Summary: Test package"};
+    size_t linesRead {0};
+    EXPECT_CALL(*pypi, readLineByLine(std::filesystem::path("/fake/dir/dist-info"), _)).WillOnce([&](const std::filesystem::path&, const std::function<bool(const std::string&)>& callback)
+    {
+        for (const auto& line : fakePackageLines)
+        {
+            ++linesRead;
+
+            if (!callback(line))
+            {
+                break;
+            }
+        }
+    });
+
+    nlohmann::json capturedJson;
+    auto callback = [&](nlohmann::json & j)
+    {
+        capturedJson = j;
+    };
+
+    std::set<std::string> folders = { "/usr/local/lib/python3.9/site-packages" };
+
+    pypi->getPackages(folders, callback);
+
+    EXPECT_EQ(linesRead, 2u);
+    EXPECT_EQ(capturedJson.at("name"), "TestPackage");
+    EXPECT_EQ(capturedJson.at("version"), "1.0.0");
+}
@@ -16,10 +16,13 @@
 #include "packages/packageLinuxRpmParserHelperLegacy.h"
 #include "packages/packageLinuxApkParserHelper.h"
 #include "packages/rpmPackageManager.h"
+#include "packages/packagesSourceCache.hpp"
 #include <alpm.h>
 #include <package.h>
 #include <handle.h>
 #include "sharedDefs.h"
+#include <cstdio>
+#include <fstream>
 
 using ::testing::_;
 using ::testing::Return;
@@ -745,3 +748,68 @@ TEST_F(SysInfoPackagesLinuxHelperTest, parseSnapWrongJSON)
     });
 }
 
+
+TEST_F(SysInfoPackagesLinuxHelperTest, packagesSourceCacheReadsModifiedSources)
+{
+    constexpr auto SOURCE_FILE {"packagesSourceCache_test.db"};
+    std::ofstream{SOURCE_FILE} << "package";
+
+    PackagesSourceCache cache;
+    auto reads {0};
+    std::vector<nlohmann::json> packages;
+    const auto retriever
+    {
+        [&reads](std::function<void(nlohmann::json&)> callback)
+        {
+            ++reads;
+            auto package = R"({"name":"curl","version":"7.68.0"})"_json;
+            callback(package);
+        }
+    };
+    const auto callback
+    {
+        [&packages](nlohmann::json & package)
+        {
+            packages.push_back(package);
+            // The packages are modified by the consumers, e.g. with their checksum.
+            package["checksum"] = "checksum";
+        }
+    };
+
+    cache.getPackages("test", {SOURCE_FILE, "nonexistent.db"}, retriever, callback);
+    cache.getPackages("test", {SOURCE_FILE, "nonexistent.db"}, retriever, callback);
+    EXPECT_EQ(1, reads);
+    ASSERT_EQ(2u, packages.size());
+    EXPECT_EQ(packages[0], packages[1]);
+    EXPECT_FALSE(packages[1].contains("checksum"));
+
+    std::ofstream{SOURCE_FILE, std::ios_base::app} << "s";
+    cache.getPackages("test", {SOURCE_FILE, "nonexistent.db"}, retriever, callback);
+    EXPECT_EQ(2, reads);
+    EXPECT_EQ(3u, packages.size());
+
+    std::remove(SOURCE_FILE);
+}
+
+TEST_F(SysInfoPackagesLinuxHelperTest, packagesSourceCacheRetrieverFailure)
+{
+    PackagesSourceCache cache;
+    auto reads {0};
+    const auto retriever
+    {
+        [&reads](std::function<void(nlohmann::json&)> callback)
+        {
+            auto package = R"({"name":"curl"})"_json;
+            callback(package);
+
+            if (++reads == 1)
+            {
+                throw std::runtime_error {"Error reading the packages."};
+            }
+        }
+    };
+
+    EXPECT_THROW(cache.getPackages("test", {"nonexistent.db"}, retriever, [](nlohmann::json&) {}), std::runtime_error);
+    EXPECT_NO_THROW(cache.getPackages("test", {"nonexistent.db"}, retriever, [](nlohmann::json&) {}));
+    EXPECT_EQ(2, reads);
+}
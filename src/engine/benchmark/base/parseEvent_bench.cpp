@@ -59,6 +59,64 @@ const std::vector<std::string>
                        R"(2:10.0.0.1:Feb 14 09:40:10.326: %ASA-3-106014: Deny inbound icmp src inside:10.10.1.132 dst inside:192.3.69.136 (type 0, code 0))",
                        R"(2:10.0.0.1:Mar  1 18:48:50.483 UTC: %ASA-3-106014: Deny inbound icmp src fw111:10.10.10.10 dst fw111:10.10.10.10(type 8, code 0))",
                        R"(2:10.0.0.1:Mar  1 18:46:11: %ASA-2-106016: Deny IP spoof from (0.0.0.0) to 192.88.99.47 on interface Mobile_Traffic)"};
+
+/**
+ * @brief Windows eventchannel like event, a multi-KB payload
+ */
+const std::string bigEventStr = []()
+{
+    std::string event {R"(f:[003] (win-agent) any->EventChannel:{"win":{"system":{"providerName":"Microsoft-Windows-Security-Auditing","eventID":"4688","level":"0","channel":"Security","computer":"WIN-SERVER","message":")"};
+    while (event.size() < 8192)
+    {
+        event += R"(A new process has been created. Creator Subject: Security ID: S-1-5-18 Account Name: WIN-SERVER$ )";
+    }
+    event += R"("},"eventdata":{"newProcessName":"C:\Windows\System32\svchost.exe"}}})";
+    return event;
+}();
+
+/**
+ * @brief Previous implementation of the parser, kept to compare the performance
+ */
+base::Event parseWazuhEventLegacy(const std::string& event)
+{
+    auto parseEvent = std::make_shared<json::Json>();
+    parseEvent->setObject();
+
+    if (event.length() <= 4 || ':' != event[1])
+    {
+        throw std::runtime_error("Invalid event format");
+    }
+
+    const int queue {event[0]};
+    parseEvent->setInt(queue, base::parseEvent::EVENT_QUEUE_ID);
+    auto locationIdx = std::string::npos;
+    for (auto i = 2; i < event.size(); ++i)
+    {
+        if (event[i] == ':' && event[i - 1] != '|')
+        {
+            locationIdx = i;
+            break;
+        }
+    }
+
+    if (locationIdx == std::string::npos)
+    {
+        throw std::runtime_error("Invalid event format");
+    }
+
+    std::string location = event.substr(2, locationIdx - 2);
+    {
+        size_t pos;
+        while ((pos = location.find("|:")) != std::string::npos)
+        {
+            location.erase(pos, 1);
+        }
+    }
+    parseEvent->setString(location, base::parseEvent::EVENT_LOCATION_ID);
+    parseEvent->setString(event.substr(locationIdx + 1), base::parseEvent::EVENT_MESSAGE_ID);
+
+    return parseEvent;
+}
 } // namespace
 
 // Parse Events
@@ -108,3 +166,45 @@ static void copyEvents_batch(benchmark::State& state)
 }
 
 BENCHMARK(copyEvents_batch)->Threads(1)->Threads(2)->Threads(4)->UseRealTime();
+
+// Parse events with the previous implementation (before/after comparison)
+static void parseWazuhEventLegacy_batch(benchmark::State& state)
+{
+    const auto sizeOfEvents = sampleEventsStr.size();
+    auto current = 0;
+
+    for (auto _ : state)
+    {
+        current = (current + 1) % sizeOfEvents;
+        base::Event e;
+        benchmark::DoNotOptimize(e = parseWazuhEventLegacy(sampleEventsStr[current]));
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(parseWazuhEventLegacy_batch)->Threads(1)->Threads(2)->Threads(4)->UseRealTime();
+
+// Parse a multi-KB event
+static void parseWazuhEvent_big(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        base::Event e;
+        benchmark::DoNotOptimize(e = base::parseEvent::parseWazuhEvent(bigEventStr));
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * bigEventStr.size());
+}
+BENCHMARK(parseWazuhEvent_big)->Threads(1)->Threads(4)->UseRealTime();
+
+// Parse a multi-KB event with the previous implementation
+static void parseWazuhEventLegacy_big(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        base::Event e;
+        benchmark::DoNotOptimize(e = parseWazuhEventLegacy(bigEventStr));
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * bigEventStr.size());
+}
+BENCHMARK(parseWazuhEventLegacy_big)->Threads(1)->Threads(4)->UseRealTime();
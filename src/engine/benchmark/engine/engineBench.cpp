@@ -0,0 +1,417 @@
+/**
+ * @brief Replays a file of events through the router of the engine and measures it.
+ *
+ * The events are read from a file with one event per line, in the format the engine receives them
+ * (`<queue>:<location>:<message>`), and replayed through a real Orchestrator routing them to a policy of the store.
+ * The report has the events per second, the latency percentiles of each asset, the allocations per event and the
+ * resident memory, in JSON so it can be compared with the report of a previous version.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <CLI/CLI.hpp>
+#include <fmt/format.h>
+
+#include <bk/profiler.hpp>
+#include <bk/rx/controller.hpp>
+#include <bk/vm/controller.hpp>
+#include <builder/builder.hpp>
+#include <defs/defs.hpp>
+#include <geo/downloader.hpp>
+#include <geo/manager.hpp>
+#include <hlp/hlp.hpp>
+#include <json/json.hpp>
+#include <kvdb/kvdbManager.hpp>
+#include <logging/logging.hpp>
+#include <logpar/logpar.hpp>
+#include <logpar/registerParsers.hpp>
+#include <metrics/metricsManager.hpp>
+#include <parseEvent.hpp>
+#include <queue/concurrentQueue.hpp>
+#include <router/orchestrator.hpp>
+#include <schemf/schema.hpp>
+#include <sockiface/unixSocketFactory.hpp>
+#include <store/drivers/fileDriver.hpp>
+#include <store/store.hpp>
+#include <wdb/wdbManager.hpp>
+
+namespace
+{
+
+// Allocations done by the process, counted by the global operator new below
+std::atomic<uint64_t> g_allocations {0};
+
+constexpr auto BENCH_ROUTE = "bench";
+constexpr auto POLL_INTERVAL = std::chrono::milliseconds(1);
+
+struct Options
+{
+    std::string storePath;
+    std::string policy {"policy/wazuh/0"};
+    std::string filter {"filter/allow-all/0"};
+    std::string eventsPath;
+    int workers {1};
+    int repeat {1};
+    int batchSize {1};
+    std::string backend {"rx"};
+    int profileRate {1};
+    std::string kvdbPath {"/tmp/wazuh-engine-bench/kvdb/"};
+    std::string tzdbPath {"/var/ossec/engine/tzdb"};
+    std::string output {"-"};
+    std::string baseline;
+    double maxRegression {10.0};
+};
+
+/**
+ * @brief Get a field of /proc/self/status in bytes, 0 if it is not available.
+ */
+uint64_t procStatusBytes(const std::string& field)
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+    {
+        if (line.compare(0, field.size(), field) == 0 && line.size() > field.size() && line[field.size()] == ':')
+        {
+            // The values are in kB
+            return std::strtoull(line.c_str() + field.size() + 1, nullptr, 10) * 1024;
+        }
+    }
+    return 0;
+}
+
+std::vector<std::string> readEvents(const std::string& path)
+{
+    std::ifstream ifs(path);
+    if (!ifs)
+    {
+        throw std::runtime_error(fmt::format("Cannot open the events file '{}'", path));
+    }
+
+    std::vector<std::string> events;
+    std::string line;
+    while (std::getline(ifs, line))
+    {
+        if (!line.empty())
+        {
+            events.emplace_back(std::move(line));
+        }
+    }
+    if (events.empty())
+    {
+        throw std::runtime_error(fmt::format("The events file '{}' has no events", path));
+    }
+    return events;
+}
+
+json::Json summariesJson(const std::vector<bk::Profiler::Summary>& summaries)
+{
+    json::Json array;
+    array.setArray();
+    for (const auto& summary : summaries)
+    {
+        json::Json item;
+        item.setString(summary.name, "/name");
+        item.setInt64(static_cast<int64_t>(summary.success), "/success");
+        item.setInt64(static_cast<int64_t>(summary.failure), "/failure");
+        item.setInt64(static_cast<int64_t>(summary.meanNs), "/mean_ns");
+        item.setInt64(static_cast<int64_t>(summary.p50Ns), "/p50_ns");
+        item.setInt64(static_cast<int64_t>(summary.p99Ns), "/p99_ns");
+        item.setInt64(static_cast<int64_t>(summary.maxNs), "/max_ns");
+        array.appendJson(item);
+    }
+    return array;
+}
+
+/**
+ * @brief Compare the report with the one of a previous run, failing if it got worse by more than the maximum.
+ *
+ * @return true if the report is within the limits of the baseline.
+ */
+bool checkBaseline(const json::Json& report, const Options& options)
+{
+    std::ifstream ifs(options.baseline);
+    if (!ifs)
+    {
+        throw std::runtime_error(fmt::format("Cannot open the baseline '{}'", options.baseline));
+    }
+    const std::string content((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    const json::Json baseline(content.c_str());
+
+    const auto limit = options.maxRegression / 100.0;
+    bool ok = true;
+
+    const auto baseEps = baseline.getDouble("/eps");
+    const auto eps = report.getDouble("/eps").value();
+    if (baseEps && eps < baseEps.value() * (1.0 - limit))
+    {
+        std::cerr << fmt::format("EPS regression: {:.0f} -> {:.0f}\n", baseEps.value(), eps);
+        ok = false;
+    }
+
+    const auto baseAllocs = baseline.getDouble("/allocations_per_event");
+    const auto allocs = report.getDouble("/allocations_per_event").value();
+    if (baseAllocs && allocs > baseAllocs.value() * (1.0 + limit))
+    {
+        std::cerr << fmt::format("Allocations regression: {:.1f} -> {:.1f} per event\n", baseAllocs.value(), allocs);
+        ok = false;
+    }
+
+    return ok;
+}
+
+int run(const Options& options)
+{
+    const auto lines = readEvents(options.eventsPath);
+
+    auto metrics = std::make_shared<metricsManager::MetricsManager>();
+    auto store = std::make_shared<store::Store>(std::make_shared<store::drivers::FileDriver>(options.storePath));
+
+    auto kvdbManager = std::make_shared<kvdbManager::KVDBManager>(
+        kvdbManager::KVDBManagerOptions {options.kvdbPath, "kvdb"}, metrics);
+    kvdbManager->initialize();
+
+    auto geoManager = std::make_shared<geo::Manager>(store, std::make_shared<geo::Downloader>(), metrics);
+
+    auto schema = std::make_shared<schemf::Schema>();
+    auto schemaDoc = store->readInternalDoc("schema/engine-schema/0");
+    if (!std::holds_alternative<base::Error>(schemaDoc))
+    {
+        schema->load(std::get<json::Json>(schemaDoc));
+    }
+
+    hlp::initTZDB(options.tzdbPath, false);
+    auto hlpParsers = store->readInternalDoc(base::Name({"schema", "wazuh-logpar-types", "0"}));
+    if (std::holds_alternative<base::Error>(hlpParsers))
+    {
+        throw std::runtime_error(
+            fmt::format("Cannot read the parsers configuration: {}", std::get<base::Error>(hlpParsers).message));
+    }
+    auto logpar = std::make_shared<hlp::logpar::Logpar>(std::get<json::Json>(hlpParsers), schema);
+    hlp::registerParsers(logpar);
+
+    builder::BuilderDeps builderDeps;
+    builderDeps.logparDebugLvl = 0;
+    builderDeps.logpar = logpar;
+    builderDeps.kvdbScopeName = "builder";
+    builderDeps.kvdbManager = kvdbManager;
+    builderDeps.sockFactory = std::make_shared<sockiface::UnixSocketFactory>();
+    builderDeps.wdbManager =
+        std::make_shared<wazuhdb::WDBManager>(std::string(wazuhdb::WDB_SOCK_PATH), builderDeps.sockFactory);
+    builderDeps.geoManager = geoManager;
+    auto builder =
+        std::make_shared<builder::Builder>(store, schema, std::make_shared<defs::DefinitionsBuilder>(), builderDeps);
+
+    auto profiler = std::make_shared<bk::Profiler>(static_cast<std::size_t>(options.profileRate));
+    std::shared_ptr<bk::IControllerMaker> controllerMaker;
+    if (options.backend == "vm")
+    {
+        controllerMaker = std::make_shared<bk::vm::ControllerMaker>(profiler);
+    }
+    else
+    {
+        controllerMaker = std::make_shared<bk::rx::ControllerMaker>(profiler);
+    }
+
+    // Every event is queued before the workers start, so the replay measures the workers and not the producer
+    const auto total = lines.size() * static_cast<std::size_t>(options.repeat);
+    auto eventQueue = std::make_shared<base::queue::ConcurrentQueue<base::Event>>(
+        static_cast<int>(total), metrics->getMetricsScope("EventQueue"), metrics->getMetricsScope("EventQueueDelta"));
+    auto testQueue = std::make_shared<base::queue::ConcurrentQueue<router::test::QueueType>>(
+        1, metrics->getMetricsScope("TestQueue"), metrics->getMetricsScope("TestQueueDelta"));
+
+    router::Orchestrator::Options config {.m_numThreads = options.workers,
+                                          .m_wStore = store,
+                                          .m_builder = builder,
+                                          .m_controllerMaker = controllerMaker,
+                                          .m_prodQueue = eventQueue,
+                                          .m_testQueue = testQueue,
+                                          .m_testTimeout = 1000,
+                                          .m_batchSize = options.batchSize};
+    auto orchestrator = std::make_shared<router::Orchestrator>(config);
+
+    if (auto err = orchestrator->postEntry(
+            router::prod::EntryPost(BENCH_ROUTE, base::Name(options.policy), base::Name(options.filter), 1)))
+    {
+        throw std::runtime_error(fmt::format("Cannot route to '{}': {}", options.policy, err->message));
+    }
+
+    // Parsed up front, the parsing of the protocol is not part of the pipeline measured
+    std::vector<base::Event> events;
+    events.reserve(total);
+    for (auto i = 0; i < options.repeat; ++i)
+    {
+        for (const auto& line : lines)
+        {
+            events.emplace_back(base::parseEvent::parseWazuhEvent(line));
+        }
+    }
+
+    eventQueue->pushBulk(events);
+
+    const auto allocationsBefore = g_allocations.load(std::memory_order_relaxed);
+    const auto start = std::chrono::steady_clock::now();
+
+    orchestrator->start();
+    while (!eventQueue->empty())
+    {
+        std::this_thread::sleep_for(POLL_INTERVAL);
+    }
+    // The workers finish the events they took before stopping
+    orchestrator->stop();
+
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const auto allocations = g_allocations.load(std::memory_order_relaxed) - allocationsBefore;
+
+    json::Json report;
+    report.setString(options.policy, "/policy");
+    report.setString(options.backend, "/backend");
+    report.setInt(options.workers, "/workers");
+    report.setInt(options.batchSize, "/batch_size");
+    report.setInt64(static_cast<int64_t>(total), "/events");
+    report.setDouble(elapsed, "/seconds");
+    report.setDouble(static_cast<double>(total) / elapsed, "/eps");
+    report.setDouble(static_cast<double>(allocations) / static_cast<double>(total), "/allocations_per_event");
+    report.setInt64(static_cast<int64_t>(procStatusBytes("VmRSS")), "/rss_bytes");
+    report.setInt64(static_cast<int64_t>(procStatusBytes("VmHWM")), "/peak_rss_bytes");
+    report.setInt(options.profileRate, "/profile_rate");
+    report.set("/assets", summariesJson(profiler->assets()));
+    report.set("/helpers", summariesJson(profiler->helpers()));
+
+    if (options.output == "-")
+    {
+        std::cout << report.prettyStr() << std::endl;
+    }
+    else
+    {
+        std::ofstream ofs(options.output);
+        ofs << report.prettyStr() << std::endl;
+        if (!ofs)
+        {
+            throw std::runtime_error(fmt::format("Cannot write the report to '{}'", options.output));
+        }
+    }
+
+    kvdbManager->finalize();
+
+    if (!options.baseline.empty() && !checkBaseline(report, options))
+    {
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (auto ptr = std::malloc(size == 0 ? 1 : size))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept
+{
+    return operator new(size, tag);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+int main(int argc, char** argv)
+{
+    Options options;
+    CLI::App app {"Replays a file of events through the router of the engine and reports its performance."};
+
+    app.add_option("--store", options.storePath, "Store directory with the policy, its assets and the schemas.")
+        ->required()
+        ->check(CLI::ExistingDirectory);
+    app.add_option(
+           "--events", options.eventsPath, "File of events to replay, one `<queue>:<location>:<message>` per line.")
+        ->required()
+        ->check(CLI::ExistingFile);
+    app.add_option("--policy", options.policy, "Policy the events are routed to.")->capture_default_str();
+    app.add_option("--filter", options.filter, "Filter of the route.")->capture_default_str();
+    app.add_option("--workers", options.workers, "Number of router workers.")
+        ->capture_default_str()
+        ->check(CLI::Range(1, 128));
+    app.add_option("--repeat", options.repeat, "Times the events file is replayed.")
+        ->capture_default_str()
+        ->check(CLI::PositiveNumber);
+    app.add_option("--batch_size", options.batchSize, "Events dequeued at once by each worker.")
+        ->capture_default_str()
+        ->check(CLI::PositiveNumber);
+    app.add_option("--backend", options.backend, "Backend of the router.")
+        ->capture_default_str()
+        ->check(CLI::IsMember({"rx", "vm"}));
+    app.add_option("--profile_rate", options.profileRate, "One of every N events is timed by the asset profiler.")
+        ->capture_default_str()
+        ->check(CLI::PositiveNumber);
+    app.add_option("--kvdb_path", options.kvdbPath, "Directory of the key-value databases.")->capture_default_str();
+    app.add_option("--tzdb_path", options.tzdbPath, "Directory of the time zone database.")->capture_default_str();
+    app.add_option("--output", options.output, "File of the JSON report, `-` for the standard output.")
+        ->capture_default_str();
+    app.add_option("--baseline", options.baseline, "Report of a previous run, the run fails if it regressed.")
+        ->check(CLI::ExistingFile);
+    app.add_option("--max_regression", options.maxRegression, "Regression allowed against the baseline, in percent.")
+        ->capture_default_str()
+        ->check(CLI::NonNegativeNumber);
+
+    CLI11_PARSE(app, argc, argv);
+
+    logging::LoggingConfig logConfig;
+    logConfig.level = logging::Level::Warn;
+    logConfig.truncate = false;
+    logging::start(logConfig);
+
+    try
+    {
+        return run(options);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "wazuh-engine-bench: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
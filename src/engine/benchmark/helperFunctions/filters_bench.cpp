@@ -1,201 +1,143 @@
-#include "builders/opBuilderHelperFilter.hpp"
+#include <memory>
+#include <string>
+#include <vector>
 
 #include <benchmark/benchmark.h>
+#include <fmt/format.h>
 
-#include <baseTypes.hpp>
-#include <defs/mocks/failDef.hpp>
-#include <expression.hpp>
 #include <json/json.hpp>
+#include <schemf/schema.hpp>
 
-/******
- * Base event:
- * {
- *   "wazuh": {
- *     "queue": 49,
- *     "origin": "/var/cosas"
- *   },
- *   "agent": {
- *     "id": "0",
- *     "name": "hostname0",
- *     "registeredIP": "any"
- *   },
- *   "event": {
- *     "original": "TEST MSG"
- *   }
- * }
- */
+#include "builders/buildCtx.hpp"
+#include "builders/opfilter/opBuilderHelperFilter.hpp"
 
-/**************************************************************
- *                 opBuilderHelperIntEqual
- **************************************************************/
+using namespace builder::builders;
 
-static void opBuilderHelperIntEqual_success(benchmark::State& state)
+namespace
 {
-    auto tuple = std::make_tuple(std::string {"/wazuh/queue"},
-                                 std::string {"int_equal"},
-                                 std::vector<std::string> {"10"},
-                                 std::make_shared<defs::mocks::FailDef>());
-
-    base::Event event1 = std::make_shared<json::Json>(R"({"wazuh":{"queue":10,"origin":"/var/cosas"},
-                                                          "agent":{"id":"0","name":"hostname0","registeredIP":"any"},
-                                                          "event":{"original":"TEST MSG"}})");
 
-    auto op = std::apply(builder::internals::builders::opBuilderHelperIntEqual, tuple)
-                  ->getPtr<base::Term<base::EngineOp>>()
-                  ->getFn();
+using Builder = FilterOp (*)(const Reference&, const std::vector<OpArg>&, const std::shared_ptr<const IBuildCtx>&);
 
-    for (auto _ : state)
-    {
-        base::result::Result<base::Event> result = op(event1);
-        benchmark::DoNotOptimize(result);
-        if (result.failure())
-        {
-            state.SkipWithError(result.trace().c_str());
-        }
-    }
-}
-BENCHMARK(opBuilderHelperIntEqual_success)->Threads(1)->Threads(2)->Threads(4)->UseRealTime();
-
-// opBuilderHelperIntEqual
-static void opBuilderHelperIntEqual_fail(benchmark::State& state)
+/******
+ * Event:
+ * {
+ *   "int": { "field": 10, "ref": 10 },
+ *   "str": { "field": "hello world", "ref": "hello" }
+ * }
+ */
+constexpr auto EVENT = R"({"int":{"field":10,"ref":10},"str":{"field":"hello world","ref":"hello"}})";
+
+/**
+ * @brief Run the filter built by the helper, each specialization (operator, type and value or reference) is a
+ * different benchmark.
+ *
+ * @param builder The helper builder
+ * @param type The type of the operands, "int" or "str"
+ * @param parameter The right operand, a JSON value or a reference (`$ref`)
+ */
+void BM_Filter(benchmark::State& state, Builder builder, const std::string& type, const std::string& parameter)
 {
-    auto tuple = std::make_tuple(std::string {"/wazuh/queue"},
-                                 std::string {"int_equal"},
-                                 std::vector<std::string> {"11"},
-                                 std::make_shared<defs::mocks::FailDef>());
+    auto buildCtx = std::make_shared<BuildCtx>();
+    buildCtx->setValidator(std::make_shared<schemf::Schema>());
+    buildCtx->context().opName = "filter";
+    buildCtx->runState().trace = false;
 
-    base::Event event1 = std::make_shared<json::Json>(R"({"wazuh":{"queue":10,"origin":"/var/cosas"},
-                                                          "agent":{"id":"0","name":"hostname0","registeredIP":"any"},
-                                                          "event":{"original":"TEST MSG"}})");
-
-    auto op = std::apply(builder::internals::builders::opBuilderHelperIntEqual, tuple)
-                  ->getPtr<base::Term<base::EngineOp>>()
-                  ->getFn();
+    const OpArg arg = parameter == "$ref" ? OpArg {std::make_shared<Reference>(type + ".ref")}
+                                          : OpArg {std::make_shared<Value>(json::Json(parameter.c_str()))};
+    auto op = builder(Reference(type + ".field"), {arg}, buildCtx);
 
+    base::ConstEvent event = std::make_shared<json::Json>(EVENT);
     for (auto _ : state)
     {
-        base::result::Result<base::Event> result = op(event1);
+        auto result = op(event);
         benchmark::DoNotOptimize(result);
-        if (result.success())
-        {
-            state.SkipWithError(result.trace().c_str());
-        }
     }
 }
-BENCHMARK(opBuilderHelperIntEqual_fail)->Threads(1)->Threads(2)->Threads(4)->UseRealTime();
 
-/**************************************************************
- *                 opBuilderHelperStringStarts
- **************************************************************/
-// opBuilderHelperStringStarts
-static void opBuilderHelperStringStarts_success(benchmark::State& state)
+} // namespace
+
+// Integers
+BENCHMARK_CAPTURE(BM_Filter, int_equal_value, opfilter::opBuilderHelperIntEqual, "int", "10");
+BENCHMARK_CAPTURE(BM_Filter, int_equal_ref, opfilter::opBuilderHelperIntEqual, "int", "$ref");
+BENCHMARK_CAPTURE(BM_Filter, int_not_equal_value, opfilter::opBuilderHelperIntNotEqual, "int", "10");
+BENCHMARK_CAPTURE(BM_Filter, int_not_equal_ref, opfilter::opBuilderHelperIntNotEqual, "int", "$ref");
+BENCHMARK_CAPTURE(BM_Filter, int_greater_value, opfilter::opBuilderHelperIntGreaterThan, "int", "10");
+BENCHMARK_CAPTURE(BM_Filter, int_greater_ref, opfilter::opBuilderHelperIntGreaterThan, "int", "$ref");
+BENCHMARK_CAPTURE(BM_Filter, int_greater_or_equal_value, opfilter::opBuilderHelperIntGreaterThanEqual, "int", "10");
+BENCHMARK_CAPTURE(BM_Filter, int_greater_or_equal_ref, opfilter::opBuilderHelperIntGreaterThanEqual, "int", "$ref");
+BENCHMARK_CAPTURE(BM_Filter, int_less_value, opfilter::opBuilderHelperIntLessThan, "int", "10");
+BENCHMARK_CAPTURE(BM_Filter, int_less_ref, opfilter::opBuilderHelperIntLessThan, "int", "$ref");
+BENCHMARK_CAPTURE(BM_Filter, int_less_or_equal_value, opfilter::opBuilderHelperIntLessThanEqual, "int", "10");
+BENCHMARK_CAPTURE(BM_Filter, int_less_or_equal_ref, opfilter::opBuilderHelperIntLessThanEqual, "int", "$ref");
+
+// Strings
+BENCHMARK_CAPTURE(BM_Filter, string_equal_value, opfilter::opBuilderHelperStringEqual, "str", R"("hello")");
+BENCHMARK_CAPTURE(BM_Filter, string_equal_ref, opfilter::opBuilderHelperStringEqual, "str", "$ref");
+BENCHMARK_CAPTURE(BM_Filter, string_not_equal_value, opfilter::opBuilderHelperStringNotEqual, "str", R"("hello")");
+BENCHMARK_CAPTURE(BM_Filter, string_not_equal_ref, opfilter::opBuilderHelperStringNotEqual, "str", "$ref");
+BENCHMARK_CAPTURE(BM_Filter, string_greater_value, opfilter::opBuilderHelperStringGreaterThan, "str", R"("hello")");
+BENCHMARK_CAPTURE(BM_Filter, string_greater_ref, opfilter::opBuilderHelperStringGreaterThan, "str", "$ref");
+BENCHMARK_CAPTURE(
+    BM_Filter, string_greater_or_equal_value, opfilter::opBuilderHelperStringGreaterThanEqual, "str", R"("hello")");
+BENCHMARK_CAPTURE(
+    BM_Filter, string_greater_or_equal_ref, opfilter::opBuilderHelperStringGreaterThanEqual, "str", "$ref");
+BENCHMARK_CAPTURE(BM_Filter, string_less_value, opfilter::opBuilderHelperStringLessThan, "str", R"("hello")");
+BENCHMARK_CAPTURE(BM_Filter, string_less_ref, opfilter::opBuilderHelperStringLessThan, "str", "$ref");
+BENCHMARK_CAPTURE(
+    BM_Filter, string_less_or_equal_value, opfilter::opBuilderHelperStringLessThanEqual, "str", R"("hello")");
+BENCHMARK_CAPTURE(BM_Filter, string_less_or_equal_ref, opfilter::opBuilderHelperStringLessThanEqual, "str", "$ref");
+BENCHMARK_CAPTURE(BM_Filter, starts_with_value, opfilter::opBuilderHelperStringStarts, "str", R"("hello")");
+BENCHMARK_CAPTURE(BM_Filter, starts_with_ref, opfilter::opBuilderHelperStringStarts, "str", "$ref");
+BENCHMARK_CAPTURE(BM_Filter, contains_value, opfilter::opBuilderHelperStringContains, "str", R"("world")");
+BENCHMARK_CAPTURE(BM_Filter, contains_ref, opfilter::opBuilderHelperStringContains, "str", "$ref");
+
+namespace
 {
-    auto tuple = std::make_tuple(std::string {"/agent/name"},
-                                 std::string {"starts_with"},
-                                 std::vector<std::string> {"specificHost"},
-                                 std::make_shared<defs::mocks::FailDef>());
+constexpr auto COMMAND_LINE =
+    R"({"cmd":"C:\\Windows\\System32\\WindowsPowerShell\\v1.0\\powershell.exe -nop -w hidden -c IEX"})";
 
-    base::Event event1 = std::make_shared<json::Json>(R"({"wazuh":{"queue":10,"origin":"/var/cosas"},
-                                                          "agent":{"id":"0","name":"specificHost_001",
-                                                          "registeredIP":"any"},"event":{"original":"TEST MSG"}})");
-
-    auto op = std::apply(builder::internals::builders::opBuilderHelperStringStarts, tuple)
-                  ->getPtr<base::Term<base::EngineOp>>()
-                  ->getFn();
+/**
+ * @brief Look for any of `needles` substrings in a command line that contains none of them, with one `contains`
+ * filter per needle or with a single `contains_any` filter.
+ */
+void BM_ContainsMany(benchmark::State& state, bool automaton)
+{
+    auto buildCtx = std::make_shared<BuildCtx>();
+    buildCtx->setValidator(std::make_shared<schemf::Schema>());
+    buildCtx->context().opName = "filter";
+    buildCtx->runState().trace = false;
 
-    for (auto _ : state)
+    std::vector<OpArg> needles;
+    for (int64_t i = 0; i < state.range(0); ++i)
     {
-        base::result::Result<base::Event> result = op(event1);
-        benchmark::DoNotOptimize(result);
-        if (result.failure())
-        {
-            state.SkipWithError(result.trace().c_str());
-        }
+        const auto needle = fmt::format("\"suspicious-{}\"", i);
+        needles.emplace_back(std::make_shared<Value>(json::Json(needle.c_str())));
     }
-}
-BENCHMARK(opBuilderHelperStringStarts_success)->Threads(1)->Threads(2)->Threads(4)->UseRealTime();
 
-static void opBuilderHelperStringStarts_fail(benchmark::State& state)
-{
-    auto tuple = std::make_tuple(std::string {"/agent/name"},
-                                 std::string {"starts_with"},
-                                 std::vector<std::string> {"otherHost"},
-                                 std::make_shared<defs::mocks::FailDef>());
-
-    base::Event event1 = std::make_shared<json::Json>(R"({"wazuh":{"queue":10,"origin":"/var/cosas"},
-                                                          "agent":{"id":"0","name":"specificHost_001",
-                                                          "registeredIP":"any"},"event":{"original":"TEST MSG"}})");
-
-    auto op = std::apply(builder::internals::builders::opBuilderHelperStringStarts, tuple)
-                  ->getPtr<base::Term<base::EngineOp>>()
-                  ->getFn();
-
-    for (auto _ : state)
+    std::vector<FilterOp> ops;
+    if (automaton)
     {
-        base::result::Result<base::Event> result = op(event1);
-        benchmark::DoNotOptimize(result);
-        if (result.success())
-        {
-            state.SkipWithError(result.trace().c_str());
-        }
+        ops.emplace_back(opfilter::opBuilderHelperStringContainsAny(Reference("cmd"), needles, buildCtx));
     }
-}
-BENCHMARK(opBuilderHelperStringStarts_fail)->Threads(1)->Threads(2)->Threads(4)->UseRealTime();
-
-/**************************************************************
- *                 opBuilderHelperIPCIDR
- **************************************************************/
-// opBuilderHelperIPCIDR
-static void opBuilderHelperIPCIDR_success(benchmark::State& state)
-{
-    auto tuple = std::make_tuple(std::string {"/agent/registeredIP"},
-                                 std::string {"ip_in_cidr"},
-                                 std::vector<std::string> {"192.168.0.0", "24"},
-                                 std::make_shared<defs::mocks::FailDef>());
-
-    base::Event event1 = std::make_shared<json::Json>(R"({"wazuh":{"queue":10,"origin":"/var/cosas"},
-                                                          "agent":{"id":"0","name":"specificHost_001",
-                                                          "registeredIP":"192.168.0.10"},
-                                                          "event":{"original":"TEST MSG"}})");
-
-    auto op = std::apply(builder::internals::builders::opBuilderHelperIPCIDR, tuple)
-                  ->getPtr<base::Term<base::EngineOp>>()
-                  ->getFn();
-    for (auto _ : state)
+    else
     {
-        base::result::Result<base::Event> result = op(event1);
-        benchmark::DoNotOptimize(result);
-        if (result.failure())
+        for (const auto& needle : needles)
         {
-            state.SkipWithError(result.trace().c_str());
+            ops.emplace_back(opfilter::opBuilderHelperStringContains(Reference("cmd"), {needle}, buildCtx));
         }
     }
-}
-BENCHMARK(opBuilderHelperIPCIDR_success)->Threads(1)->Threads(2)->Threads(4)->UseRealTime();
 
-static void opBuilderHelperIPCIDR_fail(benchmark::State& state)
-{
-    auto tuple = std::make_tuple(std::string {"/agent/registeredIP"},
-                                 std::string {"ip_in_cidr"},
-                                 std::vector<std::string> {"192.168.0.0", "24"},
-                                 std::make_shared<defs::mocks::FailDef>());
-
-    base::Event event1 = std::make_shared<json::Json>(R"({"wazuh":{"queue":10,"origin":"/var/cosas"},
-                                                          "agent":{"id":"0","name":"specificHost_001",
-                                                          "registeredIP":"10.0.0.10"},
-                                                          "event":{"original":"TEST MSG"}})");
-
-    auto op = std::apply(builder::internals::builders::opBuilderHelperIPCIDR, tuple)
-                  ->getPtr<base::Term<base::EngineOp>>()
-                  ->getFn();
+    base::ConstEvent event = std::make_shared<json::Json>(COMMAND_LINE);
     for (auto _ : state)
     {
-        base::result::Result<base::Event> result = op(event1);
-        benchmark::DoNotOptimize(result);
-        if (result.success())
+        for (const auto& op : ops)
         {
-            state.SkipWithError(result.trace().c_str());
+            auto result = op(event);
+            benchmark::DoNotOptimize(result);
         }
     }
 }
-BENCHMARK(opBuilderHelperIPCIDR_fail)->Threads(1)->Threads(2)->Threads(4)->UseRealTime();
+} // namespace
+
+BENCHMARK_CAPTURE(BM_ContainsMany, contains_each, false)->Arg(10)->Arg(200);
+BENCHMARK_CAPTURE(BM_ContainsMany, contains_any, true)->Arg(10)->Arg(200);
@@ -0,0 +1,116 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+
+#include <json/json.hpp>
+#include <kvdb/mockKvdbHandler.hpp>
+#include <kvdb/mockKvdbManager.hpp>
+#include <schemf/schema.hpp>
+#include <sockiface/mockSockFactory.hpp>
+#include <sockiface/mockSockHandler.hpp>
+#include <wdb/mockWdbHandler.hpp>
+#include <wdb/mockWdbManager.hpp>
+
+#include "builders/buildCtx.hpp"
+#include "builders/optransform/sca.hpp"
+#include "builders/optransform/windows.hpp"
+
+using namespace builder::builders;
+using testing::_;
+using testing::NiceMock;
+using testing::Return;
+
+namespace
+{
+
+std::shared_ptr<BuildCtx> getBuildCtx(const std::string& opName)
+{
+    auto buildCtx = std::make_shared<BuildCtx>();
+    buildCtx->setValidator(std::make_shared<schemf::Schema>());
+    buildCtx->context().opName = opName;
+    buildCtx->runState().trace = false;
+
+    return buildCtx;
+}
+
+/******
+ * Windows SID list, two account SIDs, one domain SID and one unknown SID
+ */
+constexpr auto SID_EVENT =
+    R"({"sids":"%{S-1-5-32-544} %{S-1-5-18} %{S-1-5-21-3623811015-3361044348-30300820-512} %{S-1-2-3}"})";
+
+/**
+ * @brief Map a list of SIDs to their descriptions, with a table of `state.range(0)` account SIDs.
+ */
+void BM_WindowsSidListDesc(benchmark::State& state)
+{
+    auto accountSids = json::Json {R"({"S-1-5-32-544":"Administrators","S-1-5-18":"Local System"})"};
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        accountSids.setString(fmt::format("Account {}", i), fmt::format("/S-1-5-80-{}", i));
+    }
+
+    auto kvdbManager = std::make_shared<NiceMock<kvdb::mocks::MockKVDBManager>>();
+    auto kvdbHandler = std::make_shared<NiceMock<kvdb::mocks::MockKVDBHandler>>();
+    ON_CALL(*kvdbManager, getKVDBHandler(_, _)).WillByDefault(Return(kvdbHandler));
+    ON_CALL(*kvdbHandler, get(detail::ACC_SID_DESC_KEY)).WillByDefault(Return(accountSids.str()));
+    ON_CALL(*kvdbHandler, get(detail::DOM_SPC_SID_KEY))
+        .WillByDefault(Return(std::string {R"({"500":"Administrator","512":"Domain Admins","513":"Domain Users"})"}));
+
+    auto builder = getWindowsSidListDescHelperBuilder(kvdbManager, "bench");
+    auto op = builder(Reference("descs"),
+                      {std::make_shared<Value>(json::Json(R"("windows")")), std::make_shared<Reference>("sids")},
+                      getBuildCtx("windows_sid_list_desc"));
+
+    auto event = std::make_shared<json::Json>(SID_EVENT);
+    for (auto _ : state)
+    {
+        auto result = op(event);
+        benchmark::DoNotOptimize(result);
+        event->erase("/descs");
+    }
+}
+
+/******
+ * SCA check event with a result that differs from the stored one
+ */
+constexpr auto SCA_CHECK_EVENT =
+    R"({"agent":{"id":"001"},"sca":{"type":"check","id":1,"policy":"CIS","policy_id":"cis_debian","check":)"
+    R"({"id":1000,"title":"Ensure mounting of cramfs is disabled","result":"failed",)"
+    R"("file":"/etc/fstab,/etc/modprobe.d"}}})";
+
+/**
+ * @brief Decode an SCA check event, the wazuh-db answers are mocked.
+ */
+void BM_SCADecoderCheck(benchmark::State& state)
+{
+    auto wdbManager = std::make_shared<NiceMock<MockWdbManager>>();
+    auto wdbHandler = std::make_shared<NiceMock<wazuhdb::mocks::MockWdbHandler>>();
+    ON_CALL(*wdbManager, connection()).WillByDefault(Return(wdbHandler));
+    ON_CALL(*wdbHandler, tryQueryAndParseResult(_, _))
+        .WillByDefault(Return(wazuhdb::mocks::okQueryRes("found passed")));
+
+    auto sockFactory = std::make_shared<NiceMock<sockiface::mocks::MockSockFactory>>();
+    auto sockHandler = std::make_shared<NiceMock<sockiface::mocks::MockSockHandler>>();
+    ON_CALL(*sockFactory, getHandler(_, _)).WillByDefault(Return(sockHandler));
+
+    auto builder = optransform::getBuilderSCAdecoder(wdbManager, sockFactory);
+    auto op = builder(Reference("decoded"),
+                      {std::make_shared<Reference>("sca"), std::make_shared<Reference>("agent.id")},
+                      getBuildCtx("sca_decoder"));
+
+    auto event = std::make_shared<json::Json>(SCA_CHECK_EVENT);
+    for (auto _ : state)
+    {
+        auto result = op(event);
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+} // namespace
+
+BENCHMARK(BM_WindowsSidListDesc)->Arg(2)->Arg(1000);
+BENCHMARK(BM_SCADecoderCheck);
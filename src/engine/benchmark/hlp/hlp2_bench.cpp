@@ -5,6 +5,7 @@
 
 #include "poc_parsec.hpp"
 #include <hlp/hlp.hpp>
+#include <scan.hpp>
 
 std::string randomString(int size)
 {
@@ -599,3 +600,133 @@ static void BM_pocLitIpLitFailureLastLit(benchmark::State& state)
     }
 }
 BENCHMARK(BM_pocLitIpLitFailureLastLit);
+
+/******************************************************************************/
+// Delimiter scanning on long inputs, see hlp/src/scan.hpp
+/******************************************************************************/
+static void BM_scanParser(benchmark::State& state, hlp::ParserBuilder builder, hlp::Params params, std::string input)
+{
+    auto parser = builder(params);
+    std::string_view inputView(input);
+
+    for (auto _ : state)
+    {
+        auto result = parser(inputView);
+        benchmark::DoNotOptimize(result);
+        benchmark::ClobberMemory();
+
+        if (result.failure())
+        {
+            state.SkipWithError("Parsing failed");
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * input.size());
+}
+
+static const std::string LONG_TEXT = randomString(512);
+
+BENCHMARK_CAPTURE(BM_scanParser,
+                  between,
+                  hlp::parsers::getBetweenParser,
+                  hlp::Params {"between", "", {}, {"[", "]>"}},
+                  "[" + LONG_TEXT + "]>");
+BENCHMARK_CAPTURE(BM_scanParser,
+                  quoted,
+                  hlp::parsers::getQuotedParser,
+                  hlp::Params {"quoted", "", {}, {}},
+                  "\"" + LONG_TEXT + "\\\"" + LONG_TEXT + "\"");
+BENCHMARK_CAPTURE(BM_scanParser,
+                  text,
+                  hlp::parsers::getTextParser,
+                  hlp::Params {"text", "", {" - end"}, {}},
+                  LONG_TEXT + " - end");
+BENCHMARK_CAPTURE(BM_scanParser,
+                  kv,
+                  hlp::parsers::getKVParser,
+                  hlp::Params {"kv", "", {}, {"=", " ", "\"", "\\"}},
+                  "first=" + LONG_TEXT + " second=\"" + LONG_TEXT + "\" third=" + LONG_TEXT);
+BENCHMARK_CAPTURE(BM_scanParser,
+                  csv,
+                  hlp::parsers::getCSVParser,
+                  hlp::Params {"csv", "", {}, {"first", "second", "third"}},
+                  LONG_TEXT + ",\"" + LONG_TEXT + "\"," + LONG_TEXT);
+
+/******************************************************************************/
+// Date parsing, compiled layouts and date::parse fallback, see hlp/src/parsers/date.cpp
+/******************************************************************************/
+static void BM_dateParser(benchmark::State& state, std::string format, std::string input)
+{
+    auto parser = hlp::parsers::getDateParser(hlp::Params {"date", "/date", {}, {format}});
+    std::string_view inputView(input);
+
+    for (auto _ : state)
+    {
+        auto result = parser(inputView);
+        benchmark::DoNotOptimize(result);
+        benchmark::ClobberMemory();
+
+        if (result.failure())
+        {
+            state.SkipWithError("Parsing failed");
+        }
+    }
+}
+
+BENCHMARK_CAPTURE(BM_dateParser, syslog, "SYSLOG", "Jun 14 15:16:01");
+BENCHMARK_CAPTURE(BM_dateParser, iso8601, "ISO8601", "2018-08-14T14:30:02.203151+02:00");
+BENCHMARK_CAPTURE(BM_dateParser, iso8601z, "ISO8601Z", "2018-08-14T14:30:02.203151Z");
+BENCHMARK_CAPTURE(BM_dateParser, httpdate, "HTTPDATE", "26/Dec/2016:16:22:14 +0000");
+BENCHMARK_CAPTURE(BM_dateParser, nginxError, "NGINX_ERROR", "2019/10/30 23:26:34");
+// Not compiled: weekday and time zone name
+BENCHMARK_CAPTURE(BM_dateParser, unixDate, "UnixDate", "Mon Jan 02 15:04:05 MST 2006");
+// Compiled layout, full month name left to date::parse
+BENCHMARK_CAPTURE(BM_dateParser, syslogFallback, "SYSLOG", "June 14 15:16:01");
+
+static void BM_scanFindAny(benchmark::State& state)
+{
+    const auto input = randomString(state.range(0)) + ",";
+    const hlp::scan::CharSet set {",\"\\"};
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(hlp::scan::findAny(input, set));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * input.size());
+}
+BENCHMARK(BM_scanFindAny)->RangeMultiplier(4)->Range(16, 4096);
+
+static void BM_stdFindFirstOf(benchmark::State& state)
+{
+    const auto input = randomString(state.range(0)) + ",";
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(std::string_view(input).find_first_of(",\"\\"));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * input.size());
+}
+BENCHMARK(BM_stdFindFirstOf)->RangeMultiplier(4)->Range(16, 4096);
+
+static void BM_scanFind(benchmark::State& state)
+{
+    const auto input = randomString(state.range(0)) + " - end";
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(hlp::scan::find(input, " - end"));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * input.size());
+}
+BENCHMARK(BM_scanFind)->RangeMultiplier(4)->Range(16, 4096);
+
+static void BM_stdFind(benchmark::State& state)
+{
+    const auto input = randomString(state.range(0)) + " - end";
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(std::string_view(input).find(" - end"));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * input.size());
+}
+BENCHMARK(BM_stdFind)->RangeMultiplier(4)->Range(16, 4096);
@@ -0,0 +1,67 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include <json/json.hpp>
+
+namespace
+{
+// Decoded event, as it is spilled by the queue or returned by the tester
+constexpr auto EVENT =
+    R"({"wazuh":{"queue":49,"location":"/var/log/suricata/eve.json","origin":"/var/log/suricata/eve.json"},)"
+    R"("agent":{"id":"001","name":"agent-001","version":"v4.8.0"},"event":{"original":"{\"timestamp\":)"
+    R"(\"2021-01-27T01:28:11.488362+0100\",\"flow_id\":1805461738637437,\"event_type\":\"alert\"}","kind":"alert",)"
+    R"("category":["network","intrusion_detection"],"severity":2,"risk_score":7.1},"source":{"ip":"81.2.69.143",)"
+    R"("port":80,"bytes":876,"packets":5},"destination":{"ip":"10.31.64.240","port":47592,"bytes":496,"packets":6},)"
+    R"("network":{"transport":"tcp","protocol":"http","community_id":null},"http":{"request":{"method":"GET"},)"
+    R"("response":{"status_code":200,"body":{"bytes":39}}},"url":{"domain":"testmynids.org","path":"/uid/index.html"},)"
+    R"("rule":{"id":"2100498","name":"GPL ATTACK_RESPONSE id check returned root","category":"Potentially Bad Traffic"},)"
+    R"("tags":["suricata","cve-2019-91325","t1190"],"tls":{"established":false}})";
+
+void BM_EncodeText(benchmark::State& state)
+{
+    json::Json event {EVENT};
+    for (auto _ : state)
+    {
+        auto encoded = event.str();
+        benchmark::DoNotOptimize(encoded);
+    }
+    state.counters["bytes"] = static_cast<double>(event.str().size());
+}
+
+void BM_EncodeBinary(benchmark::State& state)
+{
+    json::Json event {EVENT};
+    for (auto _ : state)
+    {
+        auto encoded = event.binary();
+        benchmark::DoNotOptimize(encoded);
+    }
+    state.counters["bytes"] = static_cast<double>(event.binary().size());
+}
+
+void BM_DecodeText(benchmark::State& state)
+{
+    const auto encoded = json::Json {EVENT}.str();
+    for (auto _ : state)
+    {
+        json::Json event {encoded.c_str()};
+        benchmark::DoNotOptimize(event);
+    }
+}
+
+void BM_DecodeBinary(benchmark::State& state)
+{
+    const auto encoded = json::Json {EVENT}.binary();
+    for (auto _ : state)
+    {
+        auto event = json::Json::fromBinary(encoded);
+        benchmark::DoNotOptimize(event);
+    }
+}
+} // namespace
+
+BENCHMARK(BM_EncodeText);
+BENCHMARK(BM_EncodeBinary);
+BENCHMARK(BM_DecodeText);
+BENCHMARK(BM_DecodeBinary);
@@ -8,6 +8,8 @@
 
 #include <rapidjson/document.h>
 
+#include <json/json.hpp>
+
 #define MAX_SIZE 1000000
 
 struct InputTest
@@ -237,3 +239,91 @@ static void BM_MapMiss(benchmark::State& state)
     }
 }
 BENCHMARK(BM_MapMiss)->RangeMultiplier(10)->Range(1, MAX_SIZE)->Unit(benchmark::kNanosecond);
+
+// Accessors on a typical event, parsing the pointer path on each call vs the precompiled path
+constexpr auto ACCESSOR_EVENT = R"({"wazuh": {"queue": 49, "location": "/var/log/syslog", "origin": {"module": "m"}},
+                                    "event": {"original": "Mar  1 00:00:00 host sshd[1]: Accepted password"}})";
+
+static void BM_JsonExists(benchmark::State& state)
+{
+    json::Json event {ACCESSOR_EVENT};
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(event.exists("/wazuh/origin/module"));
+    }
+}
+BENCHMARK(BM_JsonExists);
+
+static void BM_JsonExistsPointerPath(benchmark::State& state)
+{
+    json::Json event {ACCESSOR_EVENT};
+    const json::PointerPath path {"/wazuh/origin/module"};
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(event.exists(path));
+    }
+}
+BENCHMARK(BM_JsonExistsPointerPath);
+
+static void BM_JsonGetString(benchmark::State& state)
+{
+    json::Json event {ACCESSOR_EVENT};
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(event.getString("/event/original"));
+    }
+}
+BENCHMARK(BM_JsonGetString);
+
+static void BM_JsonGetStringPointerPath(benchmark::State& state)
+{
+    json::Json event {ACCESSOR_EVENT};
+    const json::PointerPath path {"/event/original"};
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(event.getString(path));
+    }
+}
+BENCHMARK(BM_JsonGetStringPointerPath);
+
+static void BM_JsonGetInt64(benchmark::State& state)
+{
+    json::Json event {ACCESSOR_EVENT};
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(event.getIntAsInt64("/wazuh/queue"));
+    }
+}
+BENCHMARK(BM_JsonGetInt64);
+
+static void BM_JsonGetInt64PointerPath(benchmark::State& state)
+{
+    json::Json event {ACCESSOR_EVENT};
+    const json::PointerPath path {"/wazuh/queue"};
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(event.getIntAsInt64(path));
+    }
+}
+BENCHMARK(BM_JsonGetInt64PointerPath);
+
+static void BM_JsonSetString(benchmark::State& state)
+{
+    json::Json event {ACCESSOR_EVENT};
+    for (auto _ : state)
+    {
+        event.setString("sshd", "/process/name");
+    }
+}
+BENCHMARK(BM_JsonSetString);
+
+static void BM_JsonSetStringPointerPath(benchmark::State& state)
+{
+    json::Json event {ACCESSOR_EVENT};
+    const json::PointerPath path {"/process/name"};
+    for (auto _ : state)
+    {
+        event.setString("sshd", path);
+    }
+}
+BENCHMARK(BM_JsonSetStringPointerPath);
@@ -1,3 +1,4 @@
+#include <filesystem>
 #include <random>
 #include <thread>
 
@@ -11,136 +12,120 @@
 using namespace metricsManager;
 
 static constexpr char kBenchDbName[] = "bench";
+static const std::filesystem::path kBenchPath {"/tmp/kvdb_bench/"};
 static auto metricsManagerPtr = std::make_shared<MetricsManager>();
-static auto kvdbManager = std::make_shared<kvdb_manager::KVDBManager>("/tmp/", metricsManagerPtr);
 
-static void dbSetup(const benchmark::State& s)
+// One manager without cache and one with it, so both read paths are measured on the same data
+static std::shared_ptr<kvdbManager::KVDBManager> kvdbManagers[2];
+
+static std::shared_ptr<kvdbManager::IKVDBHandler> getHandler(bool cached)
 {
-    auto res = kvdbManager->getHandler(kBenchDbName);
+    auto res = kvdbManagers[cached]->getKVDBHandler(kBenchDbName, "bench");
     if (auto err = std::get_if<base::Error>(&res))
     {
         throw std::runtime_error(err->message);
     }
-    auto db = std::get<kvdb_manager::KVDBHandle>(res);
+    return std::get<std::shared_ptr<kvdbManager::IKVDBHandler>>(res);
+}
 
-    for (int i = 0; i < s.range(0); ++i)
+static void dbSetup(const benchmark::State& s)
+{
+    for (auto cached : {false, true})
     {
-        db->write(fmt::format("user-{}", i), "action");
+        const auto path = kBenchPath / (cached ? "cached/" : "uncached/");
+        std::filesystem::remove_all(path);
+
+        kvdbManager::KVDBManagerOptions options {path, "kvdb", cached ? kvdbManager::DEFAULT_CACHE_SIZE : 0};
+        kvdbManagers[cached] = std::make_shared<kvdbManager::KVDBManager>(options, metricsManagerPtr);
+        kvdbManagers[cached]->initialize();
+        if (auto err = kvdbManagers[cached]->createDB(kBenchDbName))
+        {
+            throw std::runtime_error(err->message);
+        }
+
+        auto db = getHandler(cached);
+        for (int i = 0; i < s.range(0); ++i)
+        {
+            const auto value = fmt::format(R"({{"id":"{:03}","name":"agent-{}","groups":["default"]}})", i, i);
+            db->set(fmt::format("agent-{}", i), json::Json {value.c_str()});
+        }
     }
 }
 
 static void dbTeardown(const benchmark::State& s)
 {
-    kvdbManager->unloadDB(kBenchDbName);
+    for (auto& manager : kvdbManagers)
+    {
+        manager->finalize();
+        manager.reset();
+    }
+    std::filesystem::remove_all(kBenchPath);
 }
 
-static void kvdbRead(benchmark::State& state)
+// Arg 0: number of keys
+// Arg 1: 0 reads through RocksDB and parses every value, 1 reads through the cache
+static void kvdbGetJson(benchmark::State& state)
 {
-    auto res = kvdbManager->getHandler(kBenchDbName);
-    if (auto err = std::get_if<base::Error>(&res))
-    {
-        throw std::runtime_error(err->message);
-    }
-    auto db = std::get<kvdb_manager::KVDBHandle>(res);
+    auto db = getHandler(state.range(1) != 0);
 
     std::random_device rd;
     std::mt19937 gen(rd());
-    std::uniform_int_distribution<> distrib(0, state.range(0));
-    auto user = fmt::format("user-{}", distrib(gen));
+    std::uniform_int_distribution<> distrib(0, state.range(0) - 1);
 
     for (auto _ : state)
     {
-        auto val = db->read(user);
-        benchmark::DoNotOptimize(std::get<std::string>(val));
+        auto val = db->getJson(fmt::format("agent-{}", distrib(gen)));
+        benchmark::DoNotOptimize(std::get<json::Json>(val));
     }
 }
 
-BENCHMARK(kvdbRead)
+BENCHMARK(kvdbGetJson)
     ->Setup(dbSetup)
     ->Teardown(dbTeardown)
-    ->Range(8, 16 << 10)
+    ->ArgsProduct({{8, 1 << 10, 16 << 10}, {0, 1}})
     ->ThreadRange(1, std::thread::hardware_concurrency());
 
-static void kvdbHasKey(benchmark::State& state)
+static void kvdbContains(benchmark::State& state)
 {
-    auto res = kvdbManager->getHandler(kBenchDbName);
-    if (auto err = std::get_if<base::Error>(&res))
-    {
-        throw std::runtime_error(err->message);
-    }
-    auto db = std::get<kvdb_manager::KVDBHandle>(res);
+    auto db = getHandler(state.range(1) != 0);
 
     std::random_device rd;
     std::mt19937 gen(rd());
-    std::uniform_int_distribution<> distrib(0, state.range(0));
-    auto user = fmt::format("user-{}", distrib(gen));
+    std::uniform_int_distribution<> distrib(0, state.range(0) - 1);
+
+    // Warm the cache, contains only hits the keys already read
+    for (int i = 0; i < state.range(0); ++i)
+    {
+        db->getJson(fmt::format("agent-{}", i));
+    }
 
     for (auto _ : state)
     {
-        auto val = db->hasKey(user);
+        auto val = db->contains(fmt::format("agent-{}", distrib(gen)));
         benchmark::DoNotOptimize(val);
     }
 }
 
-BENCHMARK(kvdbHasKey)
-    ->Setup(dbSetup)
-    ->Teardown(dbTeardown)
-    ->Range(8, 16 << 10)
-    ->ThreadRange(1, std::thread::hardware_concurrency());
+BENCHMARK(kvdbContains)->Setup(dbSetup)->Teardown(dbTeardown)->ArgsProduct({{8, 1 << 10}, {0, 1}});
 
-static void kvdbWrite(benchmark::State& state)
+// Writes invalidate the cached keys
+static void kvdbSet(benchmark::State& state)
 {
-    auto res = kvdbManager->getHandler(kBenchDbName);
-    if (auto err = std::get_if<base::Error>(&res))
-    {
-        throw std::runtime_error(err->message);
-    }
-    auto db = std::get<kvdb_manager::KVDBHandle>(res);
+    auto db = getHandler(state.range(1) != 0);
 
     std::vector<std::string> keys;
     for (int i = 0; i < state.range(0); ++i)
     {
-        keys.push_back(fmt::format("user-{}", i));
+        keys.push_back(fmt::format("agent-{}", i));
     }
 
     for (auto _ : state)
     {
         for (auto const& key : keys)
         {
-            db->write(key, "action");
+            db->set(key, "\"action\"");
         }
-
-        state.PauseTiming();
-        db->cleanColumn();
-        state.ResumeTiming();
-    }
-}
-
-BENCHMARK(kvdbWrite)->Setup(dbSetup)->Teardown(dbTeardown)->Range(8, 16 << 10);
-
-static void kvdbWriteTx(benchmark::State& state)
-{
-    auto res = kvdbManager->getHandler(kBenchDbName);
-    if (auto err = std::get_if<base::Error>(&res))
-    {
-        throw std::runtime_error(err->message);
-    }
-    auto db = std::get<kvdb_manager::KVDBHandle>(res);
-
-    std::vector<std::pair<std::string, std::string>> keysList;
-    for (int i = 0; i < state.range(0); ++i)
-    {
-        keysList.push_back({fmt::format("user-{}", i), "action"});
-    }
-
-    for (auto _ : state)
-    {
-        db->writeToTransaction(keysList);
-
-        state.PauseTiming();
-        db->cleanColumn();
-        state.ResumeTiming();
     }
 }
 
-BENCHMARK(kvdbWriteTx)->Setup(dbSetup)->Teardown(dbTeardown)->Range(8, 16 << 10);
+BENCHMARK(kvdbSet)->Setup(dbSetup)->Teardown(dbTeardown)->ArgsProduct({{8, 1 << 10}, {0, 1}});
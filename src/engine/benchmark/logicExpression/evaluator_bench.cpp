@@ -1,5 +1,8 @@
 #include <benchmark/benchmark.h>
 
+#include <regex>
+#include <string>
+
 #include <logicexpr/logicexpr.hpp>
 
 static void BM_DijkstraEvaluator(benchmark::State& state)
@@ -71,8 +74,94 @@ static void BM_DijkstraEvaluator(benchmark::State& state)
     }
 }
 
+// Rule authors do not order the terms by cost, the expensive regex is written first but the cheap term rejects most
+// of the events
+static const auto unorderedExpression = "regex AND rare AND (regex OR even)";
+
+static std::function<bool(int)> costTermBuilder(std::string s)
+{
+    if (s == "regex")
+    {
+        return [re = std::make_shared<std::regex>("^[0-9]*(12|34|56)[0-9]*$")](int i)
+        {
+            return std::regex_match(std::to_string(i), *re);
+        };
+    }
+    else if (s == "rare")
+    {
+        return [](int i)
+        {
+            return i % 10 == 0;
+        };
+    }
+    else if (s == "even")
+    {
+        return [](int i)
+        {
+            return i % 2 == 0;
+        };
+    }
+    throw std::runtime_error("Error test fakeBuilder, got unexpected term: " + s);
+}
+
+static parsec::Parser<std::string> costTermParser()
+{
+    return [](std::string_view text, size_t pos) -> parsec::Result<std::string>
+    {
+        auto end = text.find_first_of(" ()", pos);
+        if (end == std::string_view::npos)
+        {
+            end = text.size();
+        }
+        if (std::isupper(text[pos]) || text[pos] == '(' || text[pos] == ')')
+        {
+            return parsec::makeError<std::string>("Unexpected token", pos);
+        }
+        return parsec::makeSuccess<std::string>(std::string {text.substr(pos, end - pos)}, end);
+    };
+}
+
+static void BM_UnorderedDijkstra(benchmark::State& state)
+{
+    auto evaluator =
+        logicexpr::buildDijstraEvaluator<int, std::string>(unorderedExpression, costTermBuilder, costTermParser());
+
+    for (auto _ : state)
+    {
+        for (auto i = 0; i < state.range(0); ++i)
+        {
+            benchmark::DoNotOptimize(evaluator(i));
+        }
+    }
+}
+
+// Arg 0: with the static costs, the regex is known to be expensive
+// Arg 1: without costs, the order is only learned from the pass rates
+static void BM_UnorderedAdaptive(benchmark::State& state)
+{
+    const auto withCosts = state.range(1) == 0;
+    auto evaluator = logicexpr::buildAdaptiveEvaluator<int, std::string>(
+        unorderedExpression,
+        costTermBuilder,
+        costTermParser(),
+        [withCosts](std::string& s) { return withCosts && s == "regex" ? 50.0 : 1.0; });
+
+    for (auto _ : state)
+    {
+        for (auto i = 0; i < state.range(0); ++i)
+        {
+            benchmark::DoNotOptimize(evaluator(i));
+        }
+    }
+}
+
 // Benchmarks
 
 BENCHMARK(BM_DijkstraEvaluator)
     ->RangeMultiplier(10)->Range(1, 10000000)
     ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK(BM_UnorderedDijkstra)->RangeMultiplier(10)->Range(10, 100000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_UnorderedAdaptive)
+    ->ArgsProduct({benchmark::CreateRange(10, 100000, 10), {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
@@ -1,5 +1,9 @@
+#include <memory>
 #include <re2/re2.h>
+#include <re2/set.h>
 #include <regex>
+#include <string>
+#include <vector>
 
 #include "benchmark/benchmark.h"
 
@@ -89,3 +93,61 @@ static void std_full_bench(benchmark::State & state)
 }
 
 BENCHMARK(std_full_bench);
+
+// Many sibling checks on the same field, as a decoder tree with a regex_match per decoder on event.original
+static std::vector<std::string> many_patterns(int count)
+{
+    std::vector<std::string> patterns;
+    for (int i = 0; i < count; ++i)
+    {
+        patterns.push_back(" app" + std::to_string(i) + "\\[[0-9]+\\]: .*(error|fail)");
+    }
+    return patterns;
+}
+
+static const std::string MANY_PATTERNS_INPUT {"Oct 14 10:00:00 host app99[1234]: authentication failure for user"};
+
+static void re2_many_patterns_partial_bench(benchmark::State& state)
+{
+    std::vector<std::unique_ptr<RE2>> regexes;
+    for (const auto& pattern : many_patterns(state.range(0)))
+    {
+        regexes.emplace_back(std::make_unique<RE2>(pattern));
+    }
+
+    for (auto _ : state)
+    {
+        int matched = 0;
+        for (const auto& regex : regexes)
+        {
+            matched += RE2::PartialMatch(MANY_PATTERNS_INPUT, *regex);
+        }
+        benchmark::DoNotOptimize(matched);
+    }
+}
+
+BENCHMARK(re2_many_patterns_partial_bench)->Arg(10)->Arg(100)->Arg(300);
+
+static void re2_many_patterns_set_bench(benchmark::State& state)
+{
+    RE2::Set set(RE2::DefaultOptions, RE2::UNANCHORED);
+    for (const auto& pattern : many_patterns(state.range(0)))
+    {
+        set.Add(pattern, nullptr);
+    }
+    if (!set.Compile())
+    {
+        state.SkipWithError("Cannot compile the set");
+        return;
+    }
+
+    std::vector<int> matched;
+    for (auto _ : state)
+    {
+        matched.clear();
+        set.Match(MANY_PATTERNS_INPUT, &matched);
+        benchmark::DoNotOptimize(matched);
+    }
+}
+
+BENCHMARK(re2_many_patterns_set_bench)->Arg(10)->Arg(100)->Arg(300);
@@ -0,0 +1,74 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <bk/rx/controller.hpp>
+#include <bk/taskf/controller.hpp>
+#include <bk/vm/controller.hpp>
+
+namespace
+{
+
+base::Expression term(const std::string& name, bool success)
+{
+    return base::Term<base::EngineOp>::create(name,
+                                              [success](base::Event event)
+                                              {
+                                                  if (success)
+                                                  {
+                                                      return base::result::makeSuccess(std::move(event));
+                                                  }
+                                                  return base::result::makeFailure(std::move(event));
+                                              });
+}
+
+/**
+ * @brief Build an expression shaped like a policy: an Or of decoders, each one an implication of a check over a chain
+ * of maps. Only the last decoder matches, so all the checks are run.
+ *
+ * @param decoders Number of decoders
+ * @param maps Number of maps of each decoder
+ */
+base::Expression policy(int decoders, int maps)
+{
+    std::vector<base::Expression> assets;
+    for (auto i = 0; i < decoders; ++i)
+    {
+        const auto name = "decoder" + std::to_string(i);
+        std::vector<base::Expression> steps;
+        for (auto j = 0; j < maps; ++j)
+        {
+            steps.emplace_back(term(name + "_map" + std::to_string(j), true));
+        }
+        assets.emplace_back(base::Implication::create(
+            name, term(name + "_check", i == decoders - 1), base::Chain::create(name + "_maps", steps)));
+    }
+
+    return base::Or::create("decoders", assets);
+}
+
+template<typename Controller>
+void BM_ControllerIngest(benchmark::State& state)
+{
+    const auto decoders = static_cast<int>(state.range(0));
+    const auto maps = static_cast<int>(state.range(1));
+    Controller controller(policy(decoders, maps), {});
+
+    auto event = std::make_shared<json::Json>();
+    for (auto _ : state)
+    {
+        event = controller.ingestGet(std::move(event));
+        benchmark::DoNotOptimize(event);
+    }
+
+    state.counters["terms"] = decoders * (maps + 1);
+    state.counters["eventRate"] = benchmark::Counter(state.iterations(), benchmark::Counter::kIsRate);
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_ControllerIngest, bk::rx::Controller)->ArgsProduct({{1, 16, 128}, {1, 8}});
+BENCHMARK_TEMPLATE(BM_ControllerIngest, bk::taskf::Controller)->ArgsProduct({{1, 16, 128}, {1, 8}});
+BENCHMARK_TEMPLATE(BM_ControllerIngest, bk::vm::Controller)->ArgsProduct({{1, 16, 128}, {1, 8}});
@@ -0,0 +1,136 @@
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <sockiface/unixSecureStream.hpp>
+
+namespace
+{
+constexpr auto SOCK_PATH {"/tmp/sockiface_bench.sock"};
+constexpr int MAX_MSG_SIZE {8 * 1024 * 1024};
+
+/**
+ * @brief Remote end of a stream, running in its own thread until the stream is disconnected.
+ */
+class StreamPeer
+{
+    int m_acceptFD {-1};
+    int m_fd {-1};
+    std::thread m_thread;
+
+public:
+    StreamPeer(sockiface::unixSecureStream& stream, const std::function<void(int)>& run)
+    {
+        unlink(SOCK_PATH);
+        m_acceptFD = socket(AF_UNIX, SOCK_STREAM, 0);
+
+        sockaddr_un addr {};
+        addr.sun_family = AF_UNIX;
+        strncpy(addr.sun_path, SOCK_PATH, sizeof(addr.sun_path) - 1);
+        if (bind(m_acceptFD, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 || listen(m_acceptFD, 1) < 0)
+        {
+            throw std::runtime_error(std::string {"Cannot listen on the benchmark socket: "} + strerror(errno));
+        }
+
+        stream.socketConnect();
+        m_fd = accept(m_acceptFD, nullptr, nullptr);
+        m_thread = std::thread(run, m_fd);
+    }
+
+    ~StreamPeer()
+    {
+        m_thread.join();
+        close(m_fd);
+        close(m_acceptFD);
+        unlink(SOCK_PATH);
+    }
+};
+
+// Send the same message until the stream is closed
+void feed(int fd, const std::string& payload)
+{
+    const auto size {static_cast<uint32_t>(payload.size())};
+    std::string frame(reinterpret_cast<const char*>(&size), sizeof(size));
+    frame.append(payload);
+
+    auto sent {static_cast<ssize_t>(frame.size())};
+    while (sent > 0)
+    {
+        for (size_t offset = 0; offset < frame.size() && sent > 0; offset += sent)
+        {
+            sent = send(fd, frame.data() + offset, frame.size() - offset, MSG_NOSIGNAL);
+        }
+    }
+}
+
+// Discard everything until the stream is closed
+void drain(int fd)
+{
+    std::vector<char> buffer(64 * 1024);
+    while (recv(fd, buffer.data(), buffer.size(), 0) > 0)
+    {
+    }
+}
+
+void BM_SendMsg(benchmark::State& state)
+{
+    sockiface::unixSecureStream stream {SOCK_PATH, MAX_MSG_SIZE};
+    const std::string msg(state.range(0), 'x');
+    {
+        StreamPeer peer {stream, drain};
+        for (auto _ : state)
+        {
+            benchmark::DoNotOptimize(stream.sendMsg(msg));
+        }
+        stream.socketDisconnect();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+// Copy of the message in a new buffer on each receive
+void BM_RecvString(benchmark::State& state)
+{
+    sockiface::unixSecureStream stream {SOCK_PATH, MAX_MSG_SIZE};
+    const std::string msg(state.range(0), 'x');
+    {
+        StreamPeer peer {stream, [&msg](int fd) { feed(fd, msg); }};
+        for (auto _ : state)
+        {
+            auto result {stream.recvString()};
+            benchmark::DoNotOptimize(result);
+        }
+        stream.socketDisconnect();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+// Message received in the same buffer on each receive
+void BM_RecvView(benchmark::State& state)
+{
+    sockiface::unixSecureStream stream {SOCK_PATH, MAX_MSG_SIZE};
+    const std::string msg(state.range(0), 'x');
+    std::vector<char> buffer;
+    {
+        StreamPeer peer {stream, [&msg](int fd) { feed(fd, msg); }};
+        for (auto _ : state)
+        {
+            auto result {stream.recvView(buffer)};
+            benchmark::DoNotOptimize(result);
+        }
+        stream.socketDisconnect();
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+} // namespace
+
+BENCHMARK(BM_SendMsg)->Arg(64)->Arg(64 * 1024)->Arg(4 * 1024 * 1024);
+BENCHMARK(BM_RecvString)->Arg(64)->Arg(64 * 1024)->Arg(4 * 1024 * 1024);
+BENCHMARK(BM_RecvView)->Arg(64)->Arg(64 * 1024)->Arg(4 * 1024 * 1024);
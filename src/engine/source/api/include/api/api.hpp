@@ -1,6 +1,8 @@
 #ifndef _API_API_HPP
 #define _API_API_HPP
 
+#include <string_view>
+
 #include "registry.hpp"
 
 #include <json/json.hpp>
@@ -68,6 +70,54 @@ public:
         };
     }
 
+    /**
+     * @brief Get the command of a raw request without parsing it, to classify it cheaply before processing it.
+     *
+     * Only looks for the first "command" key followed by a string value, so it may be fooled by a request that is not
+     * valid, which is rejected when processed anyway.
+     *
+     * @param message Raw string request
+     * @return std::string_view The command, empty if not found. Points into the message.
+     */
+    static std::string_view peekCommand(std::string_view message)
+    {
+        constexpr std::string_view key {"\"command\""};
+        const auto isSpace = [](char c)
+        {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+        };
+
+        auto pos = message.find(key);
+        if (pos == std::string_view::npos)
+        {
+            return {};
+        }
+        pos += key.size();
+        while (pos < message.size() && isSpace(message[pos]))
+        {
+            ++pos;
+        }
+        if (pos >= message.size() || message[pos] != ':')
+        {
+            return {};
+        }
+        ++pos;
+        while (pos < message.size() && isSpace(message[pos]))
+        {
+            ++pos;
+        }
+        if (pos >= message.size() || message[pos] != '"')
+        {
+            return {};
+        }
+        const auto end = message.find('"', ++pos);
+        if (end == std::string_view::npos)
+        {
+            return {};
+        }
+        return message.substr(pos, end - pos);
+    }
+
     /**
      * @brief Processes a raw string request and invokes a callback function with the response.
      * 
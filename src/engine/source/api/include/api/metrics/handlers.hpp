@@ -2,6 +2,7 @@
 #define _API_METRICS_HANDLERS_HPP
 
 #include <api/api.hpp>
+#include <bk/profiler.hpp>
 #include <metrics/iMetricsManagerAPI.hpp>
 
 namespace api::metrics::handlers
@@ -41,13 +42,23 @@ api::HandlerSync metricsList(const std::shared_ptr<metricsManager::IMetricsManag
 */
 api::HandlerSync metricsTestCmd(const std::shared_ptr<metricsManager::IMetricsManagerAPI>& metricsAPI);
 
+/**
+ * @brief Get the latency of the assets and helpers sampled by the profiler, slowest first.
+ *
+ * @return The statistics of the assets and helpers, or error message if the profiler is disabled.
+ */
+api::HandlerSync metricsProfileCmd(const std::shared_ptr<bk::Profiler>& profiler);
+
 /**
  * @brief Register all available Metrics commands in the API registry.
  *
  * @param registry API registry.
+ * @param profiler Profiler of the backend, null if disabled.
  * @throw std::runtime_error If the command registration fails for any reason.
  */
-void registerHandlers(const std::shared_ptr<metricsManager::IMetricsManagerAPI>& metricsAPI, std::shared_ptr<api::Api> api);
+void registerHandlers(const std::shared_ptr<metricsManager::IMetricsManagerAPI>& metricsAPI,
+                      std::shared_ptr<api::Api> api,
+                      const std::shared_ptr<bk::Profiler>& profiler = nullptr);
 
 } // namespace api::metrics::handlers
 
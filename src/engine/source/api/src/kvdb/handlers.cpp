@@ -20,6 +20,93 @@ constexpr auto MESSAGE_MISSING_NAME = "Missing /name";
 constexpr auto MESSAGE_NAME_EMPTY = "Field /name is empty";
 constexpr auto MESSAGE_MISSING_KEY = "Missing /key";
 constexpr auto MESSAGE_KEY_EMPTY = "Field /key is empty";
+constexpr auto MESSAGE_MISSING_PATH = "Missing /path";
+constexpr auto MESSAGE_PATH_EMPTY = "Field /path is empty";
+constexpr auto MESSAGE_CURSOR_AND_PAGE = "Fields /cursor and /page are exclusive";
+
+/**
+ * @brief Add the key-value pairs of the database to the entries of a response.
+ *
+ * @param content Key-value pairs, the values are JSON strings.
+ * @param entries Entries of the response.
+ * @return std::optional<std::string> Error message if a value is not valid.
+ */
+template<typename Content>
+std::optional<std::string> addEntries(const Content& content,
+                                      google::protobuf::RepeatedPtrField<eKVDB::Entry>* entries)
+{
+    entries->Reserve(entries->size() + static_cast<int>(content.size()));
+    for (const auto& [key, value] : content)
+    {
+        auto entry = eKVDB::Entry();
+        entry.mutable_key()->assign(key);
+
+        const auto res = eMessage::eMessageFromJson<google::protobuf::Value>(value);
+        if (std::holds_alternative<base::Error>(res)) // Should not happen but just in case
+        {
+            return fmt::format("{}. For key '{}' and value {}", std::get<base::Error>(res).message, key, value);
+        }
+        entry.mutable_value()->CopyFrom(std::get<google::protobuf::Value>(res));
+        entries->Add(std::move(entry));
+    }
+
+    return std::nullopt;
+}
+
+/**
+ * @brief Fill a dump or search response, from the cursor of the request if any or from its page otherwise.
+ *
+ * @param handler Handler of the database.
+ * @param eRequest Request with the page or the cursor.
+ * @param prefix Prefix of the keys, empty for all the keys.
+ * @return ResponseType or error message.
+ */
+template<typename ResponseType, typename RequestType>
+std::variant<ResponseType, std::string> pageResponse(const std::shared_ptr<kvdbManager::IKVDBHandler>& handler,
+                                                     const RequestType& eRequest,
+                                                     const std::string& prefix)
+{
+    const unsigned int records = eRequest.has_records() ? eRequest.records() : DEFAULT_HANDLER_RECORDS;
+
+    ResponseType eResponse;
+    eResponse.set_status(eEngine::ReturnStatus::OK);
+
+    std::optional<std::string> error;
+    if (eRequest.has_cursor())
+    {
+        auto scanRes = handler->scan(prefix, eRequest.cursor(), records);
+        if (std::holds_alternative<base::Error>(scanRes))
+        {
+            return std::get<base::Error>(scanRes).message;
+        }
+
+        const auto& page = std::get<kvdbManager::KVDBPage>(scanRes);
+        error = addEntries(page.entries, eResponse.mutable_entries());
+        if (!page.cursor.empty())
+        {
+            eResponse.set_next_cursor(page.cursor);
+        }
+    }
+    else
+    {
+        const unsigned int page = eRequest.has_page() ? eRequest.page() : DEFAULT_HANDLER_PAGE;
+        auto pageRes = prefix.empty() ? handler->dump(page, records) : handler->search(prefix, page, records);
+        if (std::holds_alternative<base::Error>(pageRes))
+        {
+            return std::get<base::Error>(pageRes).message;
+        }
+
+        error = addEntries(std::get<std::list<std::pair<std::string, std::string>>>(pageRes),
+                           eResponse.mutable_entries());
+    }
+
+    if (error)
+    {
+        return std::move(error.value());
+    }
+
+    return std::move(eResponse);
+}
 
 /* Manager Endpoint */
 
@@ -108,6 +195,45 @@ api::HandlerSync managerPost(std::shared_ptr<kvdbManager::IKVDBManager> kvdbMana
     };
 }
 
+api::HandlerSync managerImport(std::shared_ptr<kvdbManager::IKVDBManager> kvdbManager)
+{
+    return [kvdbManager](const api::wpRequest& wRequest) -> api::wpResponse
+    {
+        using RequestType = eKVDB::managerImport_Request;
+        using ResponseType = eEngine::GenericStatus_Response;
+        auto res = ::api::adapter::fromWazuhRequest<RequestType, ResponseType>(wRequest);
+
+        // If the request is not valid, return the error
+        if (std::holds_alternative<api::wpResponse>(res))
+        {
+            return std::move(std::get<api::wpResponse>(res));
+        }
+
+        const auto& eRequest = std::get<RequestType>(res);
+
+        auto errorMsg = !eRequest.has_name()      ? std::make_optional(MESSAGE_MISSING_NAME)
+                        : eRequest.name().empty() ? std::make_optional(MESSAGE_NAME_EMPTY)
+                        : !eRequest.has_path()    ? std::make_optional(MESSAGE_MISSING_PATH)
+                        : eRequest.path().empty() ? std::make_optional(MESSAGE_PATH_EMPTY)
+                                                  : std::nullopt;
+        if (errorMsg.has_value())
+        {
+            return ::api::adapter::genericError<ResponseType>(errorMsg.value());
+        }
+
+        const auto resultImport = kvdbManager->importDB(eRequest.name(), eRequest.path(), eRequest.replace());
+        if (resultImport)
+        {
+            const auto message =
+                fmt::format("The database could not be imported. Error: {}", resultImport.value().message);
+            return ::api::adapter::genericError<ResponseType>(message);
+        }
+
+        // Adapt the response to wazuh api
+        return ::api::adapter::genericSuccess<ResponseType>();
+    };
+}
+
 api::HandlerSync managerDelete(std::shared_ptr<kvdbManager::IKVDBManager> kvdbManager)
 {
     return [kvdbManager](const api::wpRequest& wRequest) -> api::wpResponse
@@ -162,11 +288,10 @@ api::HandlerSync managerDump(std::shared_ptr<kvdbManager::IKVDBManager> kvdbMana
         }
 
         const auto& eRequest = std::get<RequestType>(res);
-        unsigned int page = eRequest.has_page() ? eRequest.page() : DEFAULT_HANDLER_PAGE;
-        unsigned int records = eRequest.has_records() ? eRequest.records() : DEFAULT_HANDLER_RECORDS;
 
         auto errorMsg = !eRequest.has_name()      ? std::make_optional(MESSAGE_MISSING_NAME)
                         : eRequest.name().empty() ? std::make_optional("Field /name cannot be empty")
+                        : eRequest.has_cursor() && eRequest.has_page() ? std::make_optional(MESSAGE_CURSOR_AND_PAGE)
                         : eRequest.has_page() && eRequest.page() == 0
                             ? std::make_optional("Field /page must be greater than 0")
                         : eRequest.has_records() && eRequest.records() == 0
@@ -193,36 +318,15 @@ api::HandlerSync managerDump(std::shared_ptr<kvdbManager::IKVDBManager> kvdbMana
         }
 
         auto handler = std::move(std::get<std::shared_ptr<kvdbManager::IKVDBHandler>>(resultHandler));
-        auto dumpRes = handler->dump(page, records);
-
-        if (std::holds_alternative<base::Error>(dumpRes))
-        {
-            return ::api::adapter::genericError<ResponseType>(std::get<base::Error>(dumpRes).message);
-        }
-        const auto& dump = std::get<std::list<std::pair<std::string, std::string>>>(dumpRes);
-        ResponseType eResponse;
-        eResponse.set_status(eEngine::ReturnStatus::OK);
+        auto dumpRes = pageResponse<ResponseType>(handler, eRequest, "");
 
-        auto entries = eResponse.mutable_entries();
-        for (const auto& [key, value] : dump)
+        if (std::holds_alternative<std::string>(dumpRes))
         {
-            auto entry = eKVDB::Entry();
-            entry.mutable_key()->assign(key);
-
-            const auto res = eMessage::eMessageFromJson<google::protobuf::Value>(value);
-            if (std::holds_alternative<base::Error>(res)) // Should not happen but just in case
-            {
-                const auto msg =
-                    fmt::format("{}. For key '{}' and value {}", std::get<base::Error>(res).message, key, value);
-                return ::api::adapter::genericError<ResponseType>(msg);
-            }
-            const auto json_value = std::get<google::protobuf::Value>(res);
-            entry.mutable_value()->CopyFrom(json_value);
-            entries->Add(std::move(entry));
+            return ::api::adapter::genericError<ResponseType>(std::get<std::string>(dumpRes));
         }
 
         // Adapt the response to wazuh api
-        return ::api::adapter::toWazuhResponse<ResponseType>(eResponse);
+        return ::api::adapter::toWazuhResponse<ResponseType>(std::get<ResponseType>(dumpRes));
     };
 }
 
@@ -424,14 +528,13 @@ api::HandlerSync dbSearch(std::shared_ptr<kvdbManager::IKVDBManager> kvdbManager
         }
 
         const auto& eRequest = std::get<RequestType>(res);
-        unsigned int page = eRequest.has_page() ? eRequest.page() : DEFAULT_HANDLER_PAGE;
-        unsigned int records = eRequest.has_records() ? eRequest.records() : DEFAULT_HANDLER_RECORDS;
 
         // Validate the params request
         auto errorMsg = !eRequest.has_name()        ? std::make_optional(MESSAGE_MISSING_NAME)
                         : eRequest.name().empty()   ? std::make_optional(MESSAGE_NAME_EMPTY)
                         : !eRequest.has_prefix()    ? std::make_optional("Missing /prefix")
                         : eRequest.prefix().empty() ? std::make_optional("Field /prefix is empty")
+                        : eRequest.has_cursor() && eRequest.has_page() ? std::make_optional(MESSAGE_CURSOR_AND_PAGE)
                         : eRequest.has_page() && eRequest.page() == 0
                             ? std::make_optional("Field /page must be greater than 0")
                         : eRequest.has_records() && eRequest.records() == 0
@@ -457,36 +560,15 @@ api::HandlerSync dbSearch(std::shared_ptr<kvdbManager::IKVDBManager> kvdbManager
 
         auto handler = std::move(std::get<std::shared_ptr<kvdbManager::IKVDBHandler>>(resultHandler));
 
-        const auto searchRes = handler->search(eRequest.prefix(), page, records);
+        auto searchRes = pageResponse<ResponseType>(handler, eRequest, eRequest.prefix());
 
-        if (std::holds_alternative<base::Error>(searchRes))
+        if (std::holds_alternative<std::string>(searchRes))
         {
-            return ::api::adapter::genericError<ResponseType>(std::get<base::Error>(searchRes).message);
-        }
-        const auto& resultSearch = std::get<std::list<std::pair<std::string, std::string>>>(searchRes);
-        ResponseType eResponse;
-        eResponse.set_status(eEngine::ReturnStatus::OK);
-
-        auto entries = eResponse.mutable_entries();
-        for (const auto& [key, value] : resultSearch)
-        {
-            auto entry = eKVDB::Entry();
-            entry.mutable_key()->assign(key);
-
-            const auto res = eMessage::eMessageFromJson<google::protobuf::Value>(value);
-            if (std::holds_alternative<base::Error>(res)) // Should not happen but just in case
-            {
-                const auto msg =
-                    fmt::format("{}. For key '{}' and value {}", std::get<base::Error>(res).message, key, value);
-                return ::api::adapter::genericError<ResponseType>(msg);
-            }
-            const auto json_value = std::get<google::protobuf::Value>(res);
-            entry.mutable_value()->CopyFrom(json_value);
-            entries->Add(std::move(entry));
+            return ::api::adapter::genericError<ResponseType>(std::get<std::string>(searchRes));
         }
 
         // Adapt the response to wazuh api
-        return ::api::adapter::toWazuhResponse<ResponseType>(eResponse);
+        return ::api::adapter::toWazuhResponse<ResponseType>(std::get<ResponseType>(searchRes));
     };
 }
 
@@ -497,6 +579,7 @@ void registerHandlers(std::shared_ptr<kvdbManager::IKVDBManager> kvdbManager,
 
     //        Manager (Works on the KVDB manager, create/delete/list/dump KVDBs)
     const bool ok = api->registerHandler("kvdb.manager/post", Api::convertToHandlerAsync(managerPost(kvdbManager)))
+                    && api->registerHandler("kvdb.manager/import", Api::convertToHandlerAsync(managerImport(kvdbManager)))
                     && api->registerHandler("kvdb.manager/delete", Api::convertToHandlerAsync(managerDelete(kvdbManager)))
                     && api->registerHandler("kvdb.manager/get", Api::convertToHandlerAsync(managerGet(kvdbManager)))
                     && api->registerHandler("kvdb.manager/dump", Api::convertToHandlerAsync(managerDump(kvdbManager, kvdbScopeName))) &&
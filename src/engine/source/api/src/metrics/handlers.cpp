@@ -1,5 +1,7 @@
 #include "api/metrics/handlers.hpp"
 
+#include <algorithm>
+
 #include <json/json.hpp>
 #include <eMessages/eMessage.h>
 #include <eMessages/metrics.pb.h>
@@ -189,7 +191,76 @@ api::HandlerSync metricsList(const std::shared_ptr<metricsManager::IMetricsManag
     };
 }
 
-void registerHandlers(const std::shared_ptr<metricsManager::IMetricsManagerAPI>& metricsAPI, std::shared_ptr<api::Api> api)
+namespace
+{
+json::Json summariesToJson(const std::vector<bk::Profiler::Summary>& summaries, std::size_t limit)
+{
+    json::Json jSummaries;
+    jSummaries.setArray();
+    const auto size = limit == 0 ? summaries.size() : std::min<std::size_t>(limit, summaries.size());
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        const auto& summary = summaries[i];
+        json::Json jSummary;
+        jSummary.setString(summary.name, "/name");
+        jSummary.setInt64(static_cast<int64_t>(summary.success), "/success");
+        jSummary.setInt64(static_cast<int64_t>(summary.failure), "/failure");
+        jSummary.setInt64(static_cast<int64_t>(summary.meanNs), "/meanNs");
+        jSummary.setInt64(static_cast<int64_t>(summary.p50Ns), "/p50Ns");
+        jSummary.setInt64(static_cast<int64_t>(summary.p99Ns), "/p99Ns");
+        jSummary.setInt64(static_cast<int64_t>(summary.maxNs), "/maxNs");
+        jSummaries.appendJson(jSummary);
+    }
+    return jSummaries;
+}
+} // namespace
+
+api::HandlerSync metricsProfileCmd(const std::shared_ptr<bk::Profiler>& profiler)
+{
+    return [profiler](api::wpRequest wRequest) -> api::wpResponse
+    {
+        using RequestType = eMetrics::Profile_Request;
+        using ResponseType = eMetrics::Profile_Response;
+        auto res = ::api::adapter::fromWazuhRequest<RequestType, ResponseType>(wRequest);
+
+        // If the request is not valid, return the error
+        if (std::holds_alternative<api::wpResponse>(res))
+        {
+            return std::move(std::get<api::wpResponse>(res));
+        }
+
+        if (!profiler)
+        {
+            return ::api::adapter::genericError<ResponseType>(
+                "The profiler is disabled, set a profile sample rate greater than 0 to enable it");
+        }
+
+        const auto& eRequest = std::get<RequestType>(res);
+        const auto limit = eRequest.has_limit() ? static_cast<std::size_t>(eRequest.limit()) : 0;
+
+        json::Json jProfile;
+        jProfile.setInt64(static_cast<int64_t>(profiler->sampleRate()), "/sampleRate");
+        jProfile.set("/assets", summariesToJson(profiler->assets(), limit));
+        jProfile.set("/helpers", summariesToJson(profiler->helpers(), limit));
+        if (eRequest.has_reset() && eRequest.reset())
+        {
+            profiler->reset();
+        }
+
+        const auto protoVal = eMessage::eMessageFromJson<google::protobuf::Value>(jProfile.str());
+        const auto json_value = std::get<google::protobuf::Value>(protoVal);
+
+        ResponseType eResponse;
+        eResponse.set_status(eEngine::ReturnStatus::OK);
+        eResponse.mutable_value()->CopyFrom(json_value);
+
+        return ::api::adapter::toWazuhResponse(eResponse);
+    };
+}
+
+void registerHandlers(const std::shared_ptr<metricsManager::IMetricsManagerAPI>& metricsAPI,
+                      std::shared_ptr<api::Api> api,
+                      const std::shared_ptr<bk::Profiler>& profiler)
 {
     try
     {
@@ -198,6 +269,7 @@ void registerHandlers(const std::shared_ptr<metricsManager::IMetricsManagerAPI>&
         api->registerHandler("metrics.manager/enable", Api::convertToHandlerAsync(metricsEnableCmd(metricsAPI)));
         api->registerHandler("metrics.manager/test", Api::convertToHandlerAsync(metricsTestCmd(metricsAPI)));
         api->registerHandler("metrics.manager/list", Api::convertToHandlerAsync(metricsList(metricsAPI)));
+        api->registerHandler("metrics.manager/profile", Api::convertToHandlerAsync(metricsProfileCmd(profiler)));
     }
     catch (const std::exception& e)
     {
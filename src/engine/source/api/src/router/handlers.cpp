@@ -117,6 +117,10 @@ eRouter::Entry eRouteEntryFromEntry(const ::router::prod::Entry& entry,
     {
         eEntry.mutable_description()->assign(entry.description().value());
     }
+    if (entry.isShadow())
+    {
+        eEntry.set_shadow_rate(entry.shadowRate());
+    }
 
     eRouter::State state = ::router::env::State::ENABLED == entry.status()    ? eRouter::State::ENABLED
                            : ::router::env::State::DISABLED == entry.status() ? eRouter::State::DISABLED
@@ -172,6 +176,10 @@ api::HandlerSync routePost(const std::weak_ptr<::router::IRouterAPI>& router)
         {
             entryPost.description(eRequest.route().description());
         }
+        if (eRequest.route().has_shadow_rate())
+        {
+            entryPost.shadowRate(eRequest.route().shadow_rate());
+        }
         auto error = router->postEntry(entryPost);
 
         // Build the response
@@ -58,3 +58,19 @@ INSTANTIATE_TEST_SUITE_P(
                         R"({"data":{},"error":5,"message":"Command \"no_exist_cmd\" not found"})"),
         std::make_tuple(wpRequest::create("testCommandException", "test_moudule", json::Json(R"({})")).toStr(),
                         wpResponse::unknownError().toString())));
+
+TEST(ApiPeekCommandTest, Command)
+{
+    const auto request = wpRequest::create("tester.run/post", "test_moudule", json::Json(R"({})")).toStr();
+    EXPECT_EQ(Api::peekCommand(request), "tester.run/post");
+    EXPECT_EQ(Api::peekCommand(R"({ "command" :  "router.route/get", "parameters":{}})"), "router.route/get");
+}
+
+TEST(ApiPeekCommandTest, NoCommand)
+{
+    EXPECT_EQ(Api::peekCommand(R"({"version":1,"parameters":{}})"), "");
+    EXPECT_EQ(Api::peekCommand(R"({"command":123})"), "");
+    EXPECT_EQ(Api::peekCommand(R"({"command": "tester.run)"), "");
+    EXPECT_EQ(Api::peekCommand(R"({"command")"), "");
+    EXPECT_EQ(Api::peekCommand(""), "");
+}
@@ -320,6 +320,104 @@ TEST_F(KVDBApiTest, managerPostDBExists)
     ASSERT_EQ(response.data(), expectedData);
 }
 
+TEST_F(KVDBApiTest, managerImportOk)
+{
+    ASSERT_NO_THROW(managerImport(kvdbManager));
+}
+
+TEST_F(KVDBApiTest, managerImportNameMissing)
+{
+    api::HandlerSync cmd;
+    ASSERT_NO_THROW(cmd = managerImport(kvdbManager));
+    const auto response = cmd(commonWRequest());
+    const auto expectedData = json::Json {R"({"status":"ERROR","error":"Missing /name"})"};
+
+    ASSERT_TRUE(response.isValid());
+    ASSERT_EQ(response.error(), 0);
+    ASSERT_FALSE(response.message().has_value());
+    ASSERT_EQ(response.data(), expectedData);
+}
+
+TEST_F(KVDBApiTest, managerImportPathMissing)
+{
+    api::HandlerSync cmd;
+    ASSERT_NO_THROW(cmd = managerImport(kvdbManager));
+    const auto response = cmd(commonWRequest(KVDB_TEST_1));
+    const auto expectedData = json::Json {R"({"status":"ERROR","error":"Missing /path"})"};
+
+    ASSERT_TRUE(response.isValid());
+    ASSERT_EQ(response.error(), 0);
+    ASSERT_FALSE(response.message().has_value());
+    ASSERT_EQ(response.data(), expectedData);
+}
+
+TEST_F(KVDBApiTest, managerImportPathEmpty)
+{
+    api::HandlerSync cmd;
+    ASSERT_NO_THROW(cmd = managerImport(kvdbManager));
+    const auto response = cmd(commonWRequest(KVDB_TEST_1, ""));
+    const auto expectedData = json::Json {R"({"status":"ERROR","error":"Field /path is empty"})"};
+
+    ASSERT_TRUE(response.isValid());
+    ASSERT_EQ(response.error(), 0);
+    ASSERT_FALSE(response.message().has_value());
+    ASSERT_EQ(response.data(), expectedData);
+}
+
+TEST_F(KVDBApiTest, managerImport)
+{
+    auto kvdbManager = std::make_shared<MockKVDBManager>();
+    api::HandlerSync cmd;
+    EXPECT_CALL(*kvdbManager, importDB(KVDB_TEST_1, JSON_FILE_WITH_VALUE_OK, false))
+        .WillOnce(testing::Return(kvdbOk()));
+    ASSERT_NO_THROW(cmd = managerImport(kvdbManager));
+    const auto response = cmd(commonWRequest(KVDB_TEST_1, JSON_FILE_WITH_VALUE_OK));
+    const auto expectedData = json::Json {R"({"status":"OK"})"};
+
+    ASSERT_TRUE(response.isValid());
+    ASSERT_EQ(response.error(), 0);
+    ASSERT_FALSE(response.message().has_value());
+    ASSERT_EQ(response.data(), expectedData);
+}
+
+TEST_F(KVDBApiTest, managerImportReplace)
+{
+    auto kvdbManager = std::make_shared<MockKVDBManager>();
+    api::HandlerSync cmd;
+    EXPECT_CALL(*kvdbManager, importDB(KVDB_TEST_1, JSON_FILE_WITH_VALUE_OK, true))
+        .WillOnce(testing::Return(kvdbOk()));
+    ASSERT_NO_THROW(cmd = managerImport(kvdbManager));
+    json::Json data {};
+    data.setObject();
+    data.setString(KVDB_TEST_1, "/name");
+    data.setString(JSON_FILE_WITH_VALUE_OK, "/path");
+    data.setBool(true, "/replace");
+    const auto response = cmd(api::wpRequest::create(rCommand, rOrigin, data));
+    const auto expectedData = json::Json {R"({"status":"OK"})"};
+
+    ASSERT_TRUE(response.isValid());
+    ASSERT_EQ(response.error(), 0);
+    ASSERT_FALSE(response.message().has_value());
+    ASSERT_EQ(response.data(), expectedData);
+}
+
+TEST_F(KVDBApiTest, managerImportError)
+{
+    auto kvdbManager = std::make_shared<MockKVDBManager>();
+    api::HandlerSync cmd;
+    EXPECT_CALL(*kvdbManager, importDB(KVDB_TEST_1, JSON_FILE_NOK, false))
+        .WillOnce(testing::Return(kvdbError("An error occurred while parsing the JSON file '/tmp/kvdb_nok.json'")));
+    ASSERT_NO_THROW(cmd = managerImport(kvdbManager));
+    const auto response = cmd(commonWRequest(KVDB_TEST_1, JSON_FILE_NOK));
+    const auto expectedData = json::Json {
+        R"({"status":"ERROR","error":"The database could not be imported. Error: An error occurred while parsing the JSON file '/tmp/kvdb_nok.json'"})"};
+
+    ASSERT_TRUE(response.isValid());
+    ASSERT_EQ(response.error(), 0);
+    ASSERT_FALSE(response.message().has_value());
+    ASSERT_EQ(response.data(), expectedData);
+}
+
 TEST_F(KVDBApiTest, managerDeleteOk)
 {
     auto kvdbManager = std::make_shared<MockKVDBManager>();
@@ -1037,6 +1135,47 @@ TEST_F(KVDBApiTest, dbSearchDBNotExists)
     ASSERT_EQ(response.data(), expectedData);
 }
 
+TEST_F(KVDBApiTest, managerDumpWithCursor)
+{
+    auto kvdbHandler = std::make_shared<MockKVDBHandler>();
+    kvdbManager::KVDBPage page;
+    page.entries = {{"key2", R"("value2")"}, {"key3", R"("value3")"}};
+    page.cursor = "key3";
+
+    EXPECT_CALL(*kvdbManager, existsDB("test")).WillOnce(testing::Return(true));
+    EXPECT_CALL(*kvdbManager, getKVDBHandler("test", "test")).WillOnce(testing::Return(kvdbHandler));
+    EXPECT_CALL(*kvdbHandler, scan("", "key1", 2)).WillOnce(testing::Return(page));
+
+    api::HandlerSync cmd;
+    ASSERT_NO_THROW(cmd = managerDump(kvdbManager, "test"));
+    const auto response =
+        cmd(api::wpRequest::create(rCommand, rOrigin, json::Json {R"({"name":"test","cursor":"key1","records":2})"}));
+    const auto expectedData = json::Json {
+        R"({"status":"OK","entries":[{"key":"key2","value":"value2"},{"key":"key3","value":"value3"}],"next_cursor":"key3"})"};
+
+    ASSERT_TRUE(response.isValid());
+    ASSERT_EQ(response.error(), 0);
+    ASSERT_EQ(response.data(), expectedData);
+}
+
+TEST_F(KVDBApiTest, dbSearchWithCursor)
+{
+    auto kvdbHandler = std::make_shared<MockKVDBHandler>();
+
+    EXPECT_CALL(*kvdbManager, existsDB("test")).WillOnce(testing::Return(true));
+    EXPECT_CALL(*kvdbManager, getKVDBHandler("test", "test")).WillOnce(testing::Return(kvdbHandler));
+    EXPECT_CALL(*kvdbHandler, scan("key", "", DEFAULT_HANDLER_RECORDS)).WillOnce(testing::Return(kvdbScanOk()));
+
+    api::HandlerSync cmd;
+    ASSERT_NO_THROW(cmd = dbSearch(kvdbManager, "test"));
+    const auto response =
+        cmd(api::wpRequest::create(rCommand, rOrigin, json::Json {R"({"name":"test","prefix":"key","cursor":""})"}));
+
+    ASSERT_TRUE(response.isValid());
+    ASSERT_EQ(response.error(), 0);
+    ASSERT_EQ(response.data(), json::Json {R"({"status":"OK","entries":[]})"});
+}
+
 template<typename T>
 class DumpTest : public ::testing::TestWithParam<T>
 {
@@ -1075,7 +1214,9 @@ INSTANTIATE_TEST_SUITE_P(
         std::make_tuple(R"({"name": "test", "page": 1, "records": 0})",
                         R"({"status":"ERROR","entries":[],"error":"Field /records must be greater than 0"})"),
         std::make_tuple(R"({"name": "test", "page": 0, "records": 2})",
-                        R"({"status":"ERROR","entries":[],"error":"Field /page must be greater than 0"})")));
+                        R"({"status":"ERROR","entries":[],"error":"Field /page must be greater than 0"})"),
+        std::make_tuple(R"({"name": "test", "page": 1, "cursor": "key1"})",
+                        R"({"status":"ERROR","entries":[],"error":"Fields /cursor and /page are exclusive"})")));
 
 using DumpWithMultiplePages = DumpTest<std::tuple<std::string, std::string>>;
 
@@ -1157,7 +1298,9 @@ INSTANTIATE_TEST_SUITE_P(
         std::make_tuple(R"({"name":"", "prefix":"key1"})",
                         R"({"status":"ERROR","entries":[],"error":"Field /name is empty"})"),
         std::make_tuple(R"({"name":"test", "prefix":""})",
-                        R"({"status":"ERROR","entries":[],"error":"Field /prefix is empty"})")));
+                        R"({"status":"ERROR","entries":[],"error":"Field /prefix is empty"})"),
+        std::make_tuple(R"({"name":"test", "prefix":"key", "page":1, "cursor":"key1"})",
+                        R"({"status":"ERROR","entries":[],"error":"Fields /cursor and /page are exclusive"})")));
 
 // Default expected function
 template<typename Ret = base::OptError>
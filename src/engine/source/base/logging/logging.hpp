@@ -1,8 +1,11 @@
 #ifndef _H_LOGGING
 #define _H_LOGGING
 
+#include <atomic>
+#include <chrono>
 #include <iostream>
 #include <map>
+#include <optional>
 
 #include <spdlog/async.h>
 #include <spdlog/sinks/basic_file_sink.h>
@@ -47,7 +50,7 @@ constexpr auto DEFAULT_LOG_LEVEL {"info"};
 
 /**
  * @brief Default number of dedicated threads.
- * 0 means no dedicated threads.
+ * 0 means no dedicated threads, the messages are written by the thread that logs them.
  */
 constexpr auto DEFAULT_LOG_THREADS {0};
 
@@ -62,6 +65,16 @@ constexpr auto DEFAULT_LOG_THREADS_QUEUE_SIZE {8192};
  */
 constexpr auto DEFAULT_LOG_FLUSH_INTERVAL {1};
 
+/**
+ * @brief Default number of messages a rate limited call site logs per interval.
+ */
+constexpr auto DEFAULT_RATE_LIMIT_BURST {10};
+
+/**
+ * @brief Default interval of the rate limited call sites.
+ */
+constexpr std::chrono::milliseconds DEFAULT_RATE_LIMIT_INTERVAL {std::chrono::seconds {10}};
+
 /**
  * @brief Enum class defining logging levels.
  *
@@ -164,8 +177,8 @@ struct LoggingConfig
     std::string filePath {STD_OUT_PATH};                       ///< Path to the log file.
     Level level {Level::Info};                                 ///< Log level.
     const uint32_t flushInterval {DEFAULT_LOG_FLUSH_INTERVAL}; ///< Flush interval in milliseconds.
-    const uint32_t dedicatedThreads {DEFAULT_LOG_THREADS};     ///< Number of dedicated threads.
-    const uint32_t queueSize {DEFAULT_LOG_THREADS_QUEUE_SIZE}; ///< Size of the log queue for dedicated threads.
+    uint32_t dedicatedThreads {DEFAULT_LOG_THREADS};           ///< Number of dedicated threads.
+    uint32_t queueSize {DEFAULT_LOG_THREADS_QUEUE_SIZE};       ///< Size of the log queue for dedicated threads.
     bool truncate; ///< If true, the log file will be deleted for each start of the engine.
 };
 
@@ -204,32 +217,54 @@ inline void setLevel(Level level)
 
 /**
  * @brief Starts logging with the given configuration.
+ *
+ * With dedicated threads the callers only queue the messages. If the queue is full the oldest message is dropped, so
+ * a burst of logs never blocks the caller.
  * @param cfg Logging configuration parameters.
  */
 inline void start(const LoggingConfig& cfg)
 {
+    spdlog::sink_ptr sink;
+
+    if (cfg.filePath == STD_ERR_PATH)
+    {
+        sink = std::make_shared<spdlog::sinks::stderr_color_sink_mt>();
+    }
+    else if (cfg.filePath == STD_OUT_PATH)
+    {
+        sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+    }
+    else
+    {
+        sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(cfg.filePath, cfg.truncate);
+    }
+
     std::shared_ptr<spdlog::logger> logger;
 
     if (0 < cfg.dedicatedThreads)
     {
         spdlog::init_thread_pool(cfg.queueSize, cfg.dedicatedThreads);
+        logger = std::make_shared<spdlog::async_logger>(
+            "default", std::move(sink), spdlog::thread_pool(), spdlog::async_overflow_policy::overrun_oldest);
     }
-
-    if (cfg.filePath == STD_ERR_PATH)
+    else
     {
-        logger = spdlog::stderr_color_mt("default");
+        logger = std::make_shared<spdlog::logger>("default", std::move(sink));
     }
-    else if (cfg.filePath == STD_OUT_PATH)
+
+    spdlog::initialize_logger(logger);
+    setLevel(cfg.level);
+
+    if (0 < cfg.dedicatedThreads)
     {
-        logger = spdlog::stdout_color_mt("default");
+        // A flush per message would double the queued work, the pool flushes periodically instead
+        logger->flush_on(spdlog::level::err);
+        spdlog::flush_every(std::chrono::ceil<std::chrono::seconds>(std::chrono::milliseconds(cfg.flushInterval)));
     }
     else
     {
-        logger = spdlog::basic_logger_mt("default", cfg.filePath, cfg.truncate);
+        logger->flush_on(spdlog::level::trace);
     }
-
-    setLevel(cfg.level);
-    logger->flush_on(spdlog::level::trace);
 }
 
 /**
@@ -240,6 +275,65 @@ inline void stop()
     spdlog::shutdown();
 }
 
+/**
+ * @brief Limits the messages logged from one call site.
+ *
+ * A burst of messages is logged per interval, the rest are counted and the count is reported with the next message
+ * that gets through. Used through the LOG_*_RATE_LIMITED macros, which keep one instance per call site.
+ */
+class RateLimiter
+{
+private:
+    using Clock = std::chrono::steady_clock;
+
+    const uint64_t m_burst;                 ///< Messages logged per interval
+    const Clock::rep m_interval;            ///< Interval length, in clock ticks
+    std::atomic<Clock::rep> m_windowStart;  ///< Start of the current interval, in clock ticks
+    std::atomic<uint64_t> m_inWindow {0};   ///< Messages seen in the current interval
+    std::atomic<uint64_t> m_suppressed {0}; ///< Messages dropped since the last one logged
+
+public:
+    /**
+     * @brief Construct a new Rate Limiter
+     *
+     * @param burst Messages logged per interval.
+     * @param interval Interval length.
+     */
+    explicit RateLimiter(uint64_t burst = DEFAULT_RATE_LIMIT_BURST,
+                         std::chrono::milliseconds interval = DEFAULT_RATE_LIMIT_INTERVAL)
+        : m_burst(burst)
+        , m_interval(std::chrono::duration_cast<Clock::duration>(interval).count())
+        , m_windowStart(Clock::now().time_since_epoch().count())
+    {
+    }
+
+    /**
+     * @brief Decide if a message is logged.
+     *
+     * @return std::optional<uint64_t> Empty if the message must be dropped, otherwise the number of messages dropped
+     * since the last one logged.
+     */
+    std::optional<uint64_t> admit()
+    {
+        const auto now = Clock::now().time_since_epoch().count();
+        auto windowStart = m_windowStart.load(std::memory_order_relaxed);
+
+        if (now - windowStart >= m_interval
+            && m_windowStart.compare_exchange_strong(windowStart, now, std::memory_order_relaxed))
+        {
+            m_inWindow.store(0, std::memory_order_relaxed);
+        }
+
+        if (m_inWindow.fetch_add(1, std::memory_order_relaxed) < m_burst)
+        {
+            return m_suppressed.exchange(0, std::memory_order_relaxed);
+        }
+
+        m_suppressed.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+};
+
 inline void testInit()
 {
     static bool initialized = false;
@@ -274,4 +368,23 @@ inline void testInit()
     logging::getDefaultLogger()->log(                                                                                  \
         spdlog::source_loc {__FILE__, __LINE__, SPDLOG_FUNCTION}, spdlog::level::critical, msg, ##__VA_ARGS__)
 
+// Rate limited variants for the per-event paths. The arguments are only evaluated for the messages that are logged.
+#define LOG_RATE_LIMITED(lvl, msg, ...)                                                                                \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        static logging::RateLimiter logRateLimiter_;                                                                   \
+        if (const auto logSuppressed_ = logRateLimiter_.admit(); logSuppressed_.has_value())                           \
+        {                                                                                                              \
+            const auto logger_ = logging::getDefaultLogger();                                                          \
+            const spdlog::source_loc logLoc_ {__FILE__, __LINE__, SPDLOG_FUNCTION};                                    \
+            if (logSuppressed_.value() > 0)                                                                            \
+            {                                                                                                          \
+                logger_->log(logLoc_, lvl, "{} similar messages suppressed", logSuppressed_.value());                  \
+            }                                                                                                          \
+            logger_->log(logLoc_, lvl, msg, ##__VA_ARGS__);                                                            \
+        }                                                                                                              \
+    } while (0)
+#define LOG_WARNING_RATE_LIMITED(msg, ...) LOG_RATE_LIMITED(spdlog::level::warn, msg, ##__VA_ARGS__)
+#define LOG_ERROR_RATE_LIMITED(msg, ...)   LOG_RATE_LIMITED(spdlog::level::err, msg, ##__VA_ARGS__)
+
 #endif
@@ -14,11 +14,14 @@ constexpr int MINIMUM_EVENT_ALLOWED_LENGTH = 4;
 constexpr char FIRST_FULL_LOCATION_CHAR {'['};
 } // namespace
 
-Event parseWazuhEvent(const std::string& event)
+Event parseWazuhEvent(std::string_view event)
 {
-    int msgStartIndex {0};
+    return parseWazuhEvent(event, std::make_shared<json::Json>());
+}
 
-    auto parseEvent = std::make_shared<json::Json>();
+Event parseWazuhEvent(std::string_view event, Event target)
+{
+    auto parseEvent = std::move(target);
     parseEvent->setObject();
 
     if (event.length() <= MINIMUM_EVENT_ALLOWED_LENGTH)
@@ -33,30 +36,38 @@ Event parseWazuhEvent(const std::string& event)
 
     const int queue {event[0]};
     parseEvent->setInt(queue, EVENT_QUEUE_ID);
-    auto locationIdx = std::string::npos;
-    // If we have an IPv6, double dots are preceded by a |
+
+    // If we have an IPv6, double dots are preceded by a |, which is removed from the location in the same pass
+    auto locationIdx = std::string_view::npos;
+    std::string location;
+    location.reserve(event.size() < 256 ? event.size() : 256);
     for (auto i = LOCATION_OFFSET; i < event.size(); ++i)
     {
-        if (event[i] == ':' && event[i - 1] != '|')
+        if (event[i] == ':')
+        {
+            if (event[i - 1] != '|')
+            {
+                locationIdx = i;
+                break;
+            }
+            // Drop the escape (a run of pipes is fully removed, as they are all escaping the colon)
+            while (!location.empty() && location.back() == '|')
+            {
+                location.pop_back();
+            }
+            location.push_back(':');
+        }
+        else
         {
-            locationIdx = i;
-            break;
+            location.push_back(event[i]);
         }
     }
 
-    if (locationIdx == std::string::npos)
+    if (locationIdx == std::string_view::npos)
     {
         throw std::runtime_error("Invalid event format, a colon was expected to be right after the location");
     }
 
-    std::string location = event.substr(LOCATION_OFFSET, locationIdx - LOCATION_OFFSET);
-    {
-        size_t pos;
-        while ((pos = location.find("|:")) != std::string::npos)
-        {
-            location.erase(pos, 1);
-        }
-    }
     parseEvent->setString(location, EVENT_LOCATION_ID);
     parseEvent->setString(event.substr(locationIdx + 1), EVENT_MESSAGE_ID);
 
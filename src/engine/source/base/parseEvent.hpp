@@ -3,6 +3,7 @@
 #define _PARSE_EVENT_H
 
 #include <string>
+#include <string_view>
 
 #include "baseTypes.hpp"
 
@@ -15,10 +16,21 @@ constexpr char EVENT_MESSAGE_ID[] {"/event/original"};
 /**
  * @brief Parse an Wazuh message and extract the queue, location and message
  *
+ * The message is copied only once, directly into the event document, and the location is unescaped in a single pass.
+ *
  * @param event Wazuh message
  * @return Event Event object
  */
-Event parseWazuhEvent(const std::string& event);
+Event parseWazuhEvent(std::string_view event);
+
+/**
+ * @brief Parse an Wazuh message into an existing event
+ *
+ * @param event Wazuh message
+ * @param target Empty event to fill (e.g. recycled from an event pool)
+ * @return Event The target event
+ */
+Event parseWazuhEvent(std::string_view event, Event target);
 
 } // namespace base::parseEvent
 
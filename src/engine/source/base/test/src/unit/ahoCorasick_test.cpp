@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include <utils/ahoCorasick.hpp>
+
+using base::utils::string::AhoCorasick;
+
+TEST(AhoCorasick, ContainsAny)
+{
+    AhoCorasick automaton({"he", "she", "his", "hers"});
+    EXPECT_EQ(automaton.size(), 4);
+
+    EXPECT_TRUE(automaton.containsAny("ushers"));
+    EXPECT_TRUE(automaton.containsAny("this"));
+    EXPECT_TRUE(automaton.containsAny("ahe"));
+    EXPECT_FALSE(automaton.containsAny("hi"));
+    EXPECT_FALSE(automaton.containsAny(""));
+    EXPECT_FALSE(automaton.containsAny("HERS"));
+}
+
+TEST(AhoCorasick, ContainsAll)
+{
+    AhoCorasick automaton({"he", "she", "his", "hers"});
+
+    EXPECT_FALSE(automaton.containsAll("ushers"));
+    EXPECT_TRUE(automaton.containsAll("ushers his"));
+    EXPECT_TRUE(automaton.containsAll("hishers"));
+    EXPECT_FALSE(automaton.containsAll(""));
+}
+
+TEST(AhoCorasick, SuffixNeedles)
+{
+    // The needles ending inside a longer one are found through the output links
+    AhoCorasick automaton({"abcd", "bcd", "cd", "d"});
+    EXPECT_TRUE(automaton.containsAll("xabcdx"));
+    EXPECT_FALSE(automaton.containsAll("xbcdx"));
+    EXPECT_TRUE(automaton.containsAny("d"));
+}
+
+TEST(AhoCorasick, CaseInsensitive)
+{
+    AhoCorasick automaton({"PowerShell", "-EncodedCommand", "mimikatz"}, true);
+
+    EXPECT_TRUE(automaton.containsAny("C:\\WINDOWS\\powershell.exe -nop"));
+    EXPECT_TRUE(automaton.containsAny("run MIMIKATZ now"));
+    EXPECT_TRUE(automaton.containsAll("POWERSHELL -encodedcommand AAAA Mimikatz"));
+    EXPECT_FALSE(automaton.containsAny("cmd.exe /c whoami"));
+}
+
+TEST(AhoCorasick, RepeatedAndEmptyNeedles)
+{
+    AhoCorasick repeated({"abc", "abc", "ABC"}, true);
+    EXPECT_EQ(repeated.size(), 1);
+    EXPECT_TRUE(repeated.containsAll("xAbC"));
+
+    AhoCorasick withEmpty({"", "abc"});
+    EXPECT_EQ(withEmpty.size(), 2);
+    EXPECT_TRUE(withEmpty.containsAny("x"));
+    EXPECT_FALSE(withEmpty.containsAll("x"));
+    EXPECT_TRUE(withEmpty.containsAll("abc"));
+
+    AhoCorasick none({});
+    EXPECT_FALSE(none.containsAny("abc"));
+    EXPECT_TRUE(none.containsAll("abc"));
+}
+
+TEST(AhoCorasick, BinaryBytes)
+{
+    std::string needle {"\x00\xff\x80", 3};
+    AhoCorasick automaton({needle});
+    EXPECT_TRUE(automaton.containsAny(std::string {"a\x00\xff\x80z", 5}));
+    EXPECT_FALSE(automaton.containsAny(std::string {"a\x00\xff\x7fz", 5}));
+}
+
+TEST(AhoCorasick, MatchesNaiveSearch)
+{
+    const std::vector<std::string> needles {"ab", "bab", "bca", "c", "caa", "aaab"};
+    AhoCorasick automaton(needles);
+
+    // Every text over {a, b, c} of length 6
+    for (int code = 0; code < 729; ++code)
+    {
+        std::string text;
+        for (int i = 0, n = code; i < 6; ++i, n /= 3)
+        {
+            text.push_back(static_cast<char>('a' + n % 3));
+        }
+
+        bool any = false;
+        bool all = true;
+        for (const auto& needle : needles)
+        {
+            const auto found = text.find(needle) != std::string::npos;
+            any = any || found;
+            all = all && found;
+        }
+        ASSERT_EQ(automaton.containsAny(text), any) << text;
+        ASSERT_EQ(automaton.containsAll(text), all) << text;
+    }
+}
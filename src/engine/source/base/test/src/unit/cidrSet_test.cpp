@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+#include <utils/cidrSet.hpp>
+
+using utils::ip::CIDRSet;
+
+TEST(CIDRSet, Empty)
+{
+    CIDRSet set;
+    EXPECT_TRUE(set.empty());
+    EXPECT_EQ(set.contains("10.0.0.1"), false);
+    EXPECT_EQ(set.contains("::1"), false);
+    EXPECT_FALSE(set.contains("not an ip").has_value());
+}
+
+TEST(CIDRSet, InvalidNetworks)
+{
+    CIDRSet set;
+    EXPECT_THROW(set.add(""), std::invalid_argument);
+    EXPECT_THROW(set.add("10.0.0"), std::invalid_argument);
+    EXPECT_THROW(set.add("10.0.0.0/"), std::invalid_argument);
+    EXPECT_THROW(set.add("10.0.0.0/33"), std::invalid_argument);
+    EXPECT_THROW(set.add("10.0.0.0/-1"), std::invalid_argument);
+    EXPECT_THROW(set.add("10.0.0.0/255.0.255.0"), std::invalid_argument);
+    EXPECT_THROW(set.add("::/129"), std::invalid_argument);
+    EXPECT_THROW(set.add("::/255.0.0.0"), std::invalid_argument);
+    EXPECT_THROW(set.add("fe80:::1/10"), std::invalid_argument);
+    EXPECT_TRUE(set.empty());
+}
+
+TEST(CIDRSet, IPv4)
+{
+    CIDRSet set;
+    set.add("10.0.0.0/8");
+    set.add("192.168.1.0/255.255.255.0");
+    set.add("172.16.5.4/12"); // Host bits are ignored
+    set.add("8.8.8.8");
+    EXPECT_EQ(set.size(), 4);
+
+    EXPECT_EQ(set.contains("10.255.255.255"), true);
+    EXPECT_EQ(set.contains("11.0.0.0"), false);
+    EXPECT_EQ(set.contains("192.168.1.200"), true);
+    EXPECT_EQ(set.contains("192.168.2.1"), false);
+    EXPECT_EQ(set.contains("172.31.0.1"), true);
+    EXPECT_EQ(set.contains("172.32.0.1"), false);
+    EXPECT_EQ(set.contains("8.8.8.8"), true);
+    EXPECT_EQ(set.contains("8.8.8.9"), false);
+    EXPECT_EQ(set.contains("::ffff:10.1.2.3"), true);
+    EXPECT_FALSE(set.contains("10.0.0.256").has_value());
+}
+
+TEST(CIDRSet, IPv6)
+{
+    CIDRSet set;
+    set.add("fe80::/10");
+    set.add("fc00::/7");
+    set.add("::1");
+    set.add("2001:db8:abcd::/48");
+
+    EXPECT_EQ(set.contains("fe80::1"), true);
+    EXPECT_EQ(set.contains("febf:ffff::1"), true);
+    EXPECT_EQ(set.contains("fec0::1"), false);
+    EXPECT_EQ(set.contains("fd12:3456::1"), true);
+    EXPECT_EQ(set.contains("::1"), true);
+    EXPECT_EQ(set.contains("::2"), false);
+    EXPECT_EQ(set.contains("2001:db8:abcd:1::1"), true);
+    EXPECT_EQ(set.contains("2001:db8:abce::1"), false);
+    EXPECT_EQ(set.contains("10.0.0.1"), false);
+}
+
+TEST(CIDRSet, NestedAndSplitPrefixes)
+{
+    CIDRSet set;
+    set.add("10.1.2.0/24");
+    set.add("10.1.3.0/24");
+    EXPECT_EQ(set.contains("10.1.1.1"), false);
+    EXPECT_EQ(set.contains("10.1.2.1"), true);
+    EXPECT_EQ(set.contains("10.1.3.1"), true);
+
+    // A shorter prefix covering the previous ones
+    set.add("10.1.0.0/16");
+    EXPECT_EQ(set.contains("10.1.1.1"), true);
+    EXPECT_EQ(set.contains("10.2.0.0"), false);
+
+    // A prefix ending on the split node
+    CIDRSet other;
+    other.add("192.168.1.0/24");
+    other.add("192.168.2.0/24");
+    other.add("192.168.0.0/22");
+    EXPECT_EQ(other.contains("192.168.0.1"), true);
+    EXPECT_EQ(other.contains("192.168.4.1"), false);
+}
+
+TEST(CIDRSet, MatchAll)
+{
+    CIDRSet set;
+    set.add("0.0.0.0/0");
+    EXPECT_EQ(set.contains("1.2.3.4"), true);
+    EXPECT_EQ(set.contains("::1"), false);
+
+    set.add("::/0");
+    EXPECT_EQ(set.contains("::1"), true);
+}
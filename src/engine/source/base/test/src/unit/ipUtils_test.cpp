@@ -34,6 +34,37 @@ TEST(IPv4ToUInt, Valid_range)
     EXPECT_EQ(utils::ip::IPv4ToUInt("255.255.255.255"), 0xFFFFFFFF);
 }
 
+TEST(parseIPv4, Invalid_format)
+{
+    uint32_t value = 0x01020304;
+    EXPECT_FALSE(utils::ip::parseIPv4("", value));
+    EXPECT_FALSE(utils::ip::parseIPv4("1.2.3", value));
+    EXPECT_FALSE(utils::ip::parseIPv4("1.2.3.4.", value));
+    EXPECT_FALSE(utils::ip::parseIPv4("1.2.3.4.5", value));
+    EXPECT_FALSE(utils::ip::parseIPv4("1..3.4", value));
+    EXPECT_FALSE(utils::ip::parseIPv4(".2.3.4", value));
+    EXPECT_FALSE(utils::ip::parseIPv4(" 1.1.1.1", value));
+    EXPECT_FALSE(utils::ip::parseIPv4("01.1.1.1", value));
+    EXPECT_FALSE(utils::ip::parseIPv4("1.1.1.00", value));
+    EXPECT_FALSE(utils::ip::parseIPv4("-1.1.1.1", value));
+    EXPECT_FALSE(utils::ip::parseIPv4("256.1.1.1", value));
+    EXPECT_FALSE(utils::ip::parseIPv4("1.1.1.1000", value));
+    EXPECT_EQ(value, 0x01020304);
+}
+
+TEST(parseIPv4, Valid_range)
+{
+    uint32_t value = 0;
+    EXPECT_TRUE(utils::ip::parseIPv4("0.0.0.0", value));
+    EXPECT_EQ(value, 0x0);
+    EXPECT_TRUE(utils::ip::parseIPv4("127.0.0.1", value));
+    EXPECT_EQ(value, 0x7F'00'00'01);
+    EXPECT_TRUE(utils::ip::parseIPv4("192.168.10.1", value));
+    EXPECT_EQ(value, 0xC0'A8'0A'01);
+    EXPECT_TRUE(utils::ip::parseIPv4("255.255.255.255", value));
+    EXPECT_EQ(value, 0xFFFFFFFF);
+}
+
 TEST(IPv4MaskUInt, Invalid_format)
 {
     EXPECT_THROW(utils::ip::IPv4MaskUInt(""), std::invalid_argument);
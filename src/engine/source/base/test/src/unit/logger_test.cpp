@@ -3,6 +3,7 @@
 #include <fstream>
 #include <gtest/gtest.h>
 #include <regex>
+#include <thread>
 
 #include "logging/logging.hpp"
 
@@ -64,6 +65,53 @@ TEST_F(LoggerTest, LogGetSomeInstance)
     ASSERT_EQ(logger, someLogger);
 }
 
+TEST_F(LoggerTest, LogAsyncStart)
+{
+    ASSERT_NO_THROW(logging::start(logging::LoggingConfig {.filePath = m_tmpPath, .dedicatedThreads = 1}));
+    LOG_WARNING("WARNING message");
+    logging::stop();
+
+    EXPECT_NE(readFileContents(m_tmpPath).find("WARNING message"), std::string::npos);
+}
+
+TEST(RateLimiterTest, BurstPerInterval)
+{
+    logging::RateLimiter limiter {2, std::chrono::hours {1}};
+
+    EXPECT_EQ(limiter.admit(), 0);
+    EXPECT_EQ(limiter.admit(), 0);
+    EXPECT_FALSE(limiter.admit().has_value());
+    EXPECT_FALSE(limiter.admit().has_value());
+}
+
+TEST(RateLimiterTest, ReportSuppressed)
+{
+    logging::RateLimiter limiter {1, std::chrono::milliseconds {50}};
+
+    EXPECT_EQ(limiter.admit(), 0);
+    EXPECT_FALSE(limiter.admit().has_value());
+    EXPECT_FALSE(limiter.admit().has_value());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds {60});
+    EXPECT_EQ(limiter.admit(), 2);
+    EXPECT_FALSE(limiter.admit().has_value());
+}
+
+TEST_F(LoggerTest, LogRateLimited)
+{
+    ASSERT_NO_THROW(logging::start(logging::LoggingConfig {.filePath = m_tmpPath}));
+
+    for (auto i = 0; i < logging::DEFAULT_RATE_LIMIT_BURST * 2; ++i)
+    {
+        LOG_WARNING_RATE_LIMITED("Repeated message {}", i);
+    }
+
+    const auto content = readFileContents(m_tmpPath);
+    EXPECT_NE(content.find(fmt::format("Repeated message {}", logging::DEFAULT_RATE_LIMIT_BURST - 1)),
+              std::string::npos);
+    EXPECT_EQ(content.find(fmt::format("Repeated message {}", logging::DEFAULT_RATE_LIMIT_BURST)), std::string::npos);
+}
+
 class LoggerTestLevels : public ::testing::TestWithParam<logging::Level>
 {
 public:
@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+
+#include <unistd.h>
+
+#include <utils/numaUtils.hpp>
+
+TEST(ParseCpuList, Valid)
+{
+    EXPECT_EQ(utils::numa::parseCpuList(""), std::vector<int> {});
+    EXPECT_EQ(utils::numa::parseCpuList("\n"), std::vector<int> {});
+    EXPECT_EQ(utils::numa::parseCpuList("3"), std::vector<int> {3});
+    EXPECT_EQ(utils::numa::parseCpuList("0-3\n"), (std::vector<int> {0, 1, 2, 3}));
+    EXPECT_EQ(utils::numa::parseCpuList("0-1,4,8-9"), (std::vector<int> {0, 1, 4, 8, 9}));
+}
+
+TEST(ParseCpuList, Invalid)
+{
+    EXPECT_THROW(utils::numa::parseCpuList("a"), std::invalid_argument);
+    EXPECT_THROW(utils::numa::parseCpuList("0-"), std::invalid_argument);
+    EXPECT_THROW(utils::numa::parseCpuList("3-1"), std::invalid_argument);
+    EXPECT_THROW(utils::numa::parseCpuList("0,,1"), std::invalid_argument);
+    EXPECT_THROW(utils::numa::parseCpuList("-1"), std::invalid_argument);
+}
+
+class GetTopology : public ::testing::Test
+{
+protected:
+    std::filesystem::path m_path;
+
+    void SetUp() override
+    {
+        m_path = std::filesystem::temp_directory_path() / ("numa_test_" + std::to_string(getpid()));
+        std::filesystem::create_directories(m_path);
+    }
+
+    void TearDown() override { std::filesystem::remove_all(m_path); }
+
+    void addNode(const std::string& name, const std::string& cpuList)
+    {
+        std::filesystem::create_directories(m_path / name);
+        std::ofstream {m_path / name / "cpulist"} << cpuList << '\n';
+    }
+};
+
+TEST_F(GetTopology, Nodes)
+{
+    addNode("node1", "4-7");
+    addNode("node0", "0-3");
+    addNode("node2", ""); // Memory only node
+    addNode("other", "8");
+
+    auto topology = utils::numa::getTopology(m_path.string());
+    ASSERT_EQ(topology.size(), 2);
+    EXPECT_EQ(topology[0], (std::vector<int> {0, 1, 2, 3}));
+    EXPECT_EQ(topology[1], (std::vector<int> {4, 5, 6, 7}));
+}
+
+TEST_F(GetTopology, FallbackToSingleNode)
+{
+    auto topology = utils::numa::getTopology((m_path / "missing").string());
+    ASSERT_EQ(topology.size(), 1);
+    EXPECT_FALSE(topology[0].empty());
+}
+
+TEST(PinCurrentThread, InvalidCpu)
+{
+    EXPECT_TRUE(utils::numa::pinCurrentThread(-1));
+}
@@ -106,3 +106,21 @@ TEST(parseWazuhEvent, Forms)
         execute(useCase);
     }
 }
+
+TEST(parseWazuhEvent, StringViewInput)
+{
+    // The event does not need to be null terminated
+    const std::string buffer {"1:location:message tail-not-part-of-the-event"};
+    const std::string_view event {buffer.data(), std::string_view(buffer).find(" tail")};
+
+    auto e = base::parseEvent::parseWazuhEvent(event);
+    EXPECT_EQ(e->getString(base::parseEvent::EVENT_LOCATION_ID).value(), "location");
+    EXPECT_EQ(e->getString(base::parseEvent::EVENT_MESSAGE_ID).value(), "message");
+}
+
+TEST(parseWazuhEvent, EscapedPipesRun)
+{
+    auto e = base::parseEvent::parseWazuhEvent(std::string {"1:a||:b|c:message"});
+    EXPECT_EQ(e->getString(base::parseEvent::EVENT_LOCATION_ID).value(), "a:b|c");
+    EXPECT_EQ(e->getString(base::parseEvent::EVENT_MESSAGE_ID).value(), "message");
+}
@@ -0,0 +1,193 @@
+#include "ahoCorasick.hpp"
+
+#include <cctype>
+#include <queue>
+
+namespace base::utils::string
+{
+
+AhoCorasick::AhoCorasick(const std::vector<std::string>& needles, bool caseInsensitive)
+    : m_classes()
+    , m_alphabet(1)
+    , m_transitions()
+    , m_outputs()
+    , m_outputLinks()
+    , m_accepting()
+    , m_needles(0)
+    , m_hasEmpty(false)
+{
+    // Only the bytes used by the needles get a class, the rest share the class 0
+    m_classes.fill(0);
+    for (const auto& needle : needles)
+    {
+        for (const auto c : needle)
+        {
+            auto byte = static_cast<unsigned char>(c);
+            if (caseInsensitive)
+            {
+                byte = static_cast<unsigned char>(std::tolower(byte));
+            }
+            if (m_classes[byte] == 0)
+            {
+                m_classes[byte] = static_cast<uint16_t>(m_alphabet++);
+            }
+        }
+    }
+
+    if (caseInsensitive)
+    {
+        for (int byte = 'A'; byte <= 'Z'; ++byte)
+        {
+            m_classes[byte] = m_classes[std::tolower(byte)];
+        }
+    }
+
+    buildTrie(needles);
+    buildLinks();
+}
+
+void AhoCorasick::buildTrie(const std::vector<std::string>& needles)
+{
+    // Root state
+    m_transitions.assign(m_alphabet, NO_STATE);
+    m_outputs.assign(1, NO_STATE);
+
+    for (const auto& needle : needles)
+    {
+        if (needle.empty())
+        {
+            m_hasEmpty = true;
+            continue;
+        }
+
+        int32_t state = 0;
+        for (const auto c : needle)
+        {
+            const auto index = state * m_alphabet + m_classes[static_cast<unsigned char>(c)];
+            if (m_transitions[index] == NO_STATE)
+            {
+                m_transitions[index] = static_cast<int32_t>(m_outputs.size());
+                m_transitions.resize(m_transitions.size() + m_alphabet, NO_STATE);
+                m_outputs.push_back(NO_STATE);
+            }
+            state = m_transitions[index];
+        }
+
+        // Repeated needles end on the same state
+        if (m_outputs[state] == NO_STATE)
+        {
+            m_outputs[state] = static_cast<int32_t>(m_needles++);
+        }
+    }
+
+    if (m_hasEmpty)
+    {
+        ++m_needles;
+    }
+}
+
+void AhoCorasick::buildLinks()
+{
+    const auto states = m_outputs.size();
+    std::vector<int32_t> failure(states, 0);
+    m_outputLinks.assign(states, NO_STATE);
+    m_accepting.assign(states, 0);
+
+    std::queue<int32_t> pending;
+    for (std::size_t c = 0; c < m_alphabet; ++c)
+    {
+        auto& next = m_transitions[c];
+        if (next == NO_STATE)
+        {
+            next = 0;
+        }
+        else
+        {
+            pending.push(next);
+        }
+    }
+
+    while (!pending.empty())
+    {
+        const auto state = pending.front();
+        pending.pop();
+
+        const auto link = m_outputs[failure[state]] != NO_STATE ? failure[state] : m_outputLinks[failure[state]];
+        m_outputLinks[state] = link;
+        m_accepting[state] = m_outputs[state] != NO_STATE || m_outputLinks[state] != NO_STATE;
+
+        for (std::size_t c = 0; c < m_alphabet; ++c)
+        {
+            auto& next = m_transitions[state * m_alphabet + c];
+            const auto fallback = m_transitions[failure[state] * m_alphabet + c];
+            if (next == NO_STATE)
+            {
+                next = fallback;
+            }
+            else
+            {
+                failure[next] = fallback;
+                pending.push(next);
+            }
+        }
+    }
+}
+
+bool AhoCorasick::containsAny(std::string_view text) const
+{
+    if (m_hasEmpty)
+    {
+        return true;
+    }
+
+    std::size_t state = 0;
+    for (const auto c : text)
+    {
+        state = m_transitions[state * m_alphabet + m_classes[static_cast<unsigned char>(c)]];
+        if (m_accepting[state])
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool AhoCorasick::containsAll(std::string_view text) const
+{
+    std::vector<uint8_t> found(m_needles, 0);
+    std::size_t pending = m_needles;
+    if (m_hasEmpty)
+    {
+        found.back() = 1;
+        --pending;
+    }
+    if (pending == 0)
+    {
+        return true;
+    }
+
+    std::size_t state = 0;
+    for (const auto c : text)
+    {
+        state = m_transitions[state * m_alphabet + m_classes[static_cast<unsigned char>(c)]];
+        if (!m_accepting[state])
+        {
+            continue;
+        }
+
+        // The suffixes of a found state were found with it, stop at the first one already seen
+        auto output = m_outputs[state] != NO_STATE ? static_cast<int32_t>(state) : m_outputLinks[state];
+        while (output != NO_STATE && !found[m_outputs[output]])
+        {
+            found[m_outputs[output]] = 1;
+            if (--pending == 0)
+            {
+                return true;
+            }
+            output = m_outputLinks[output];
+        }
+    }
+    return false;
+}
+
+} // namespace base::utils::string
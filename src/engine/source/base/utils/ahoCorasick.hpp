@@ -0,0 +1,87 @@
+#ifndef _AHO_CORASICK_H
+#define _AHO_CORASICK_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace base::utils::string
+{
+
+/**
+ * @brief Aho-Corasick automaton that finds many substrings in a single scan of the text.
+ *
+ * The automaton is built once from the needles and only read afterwards, so it can be shared between threads. The
+ * bytes are mapped to the classes of the bytes used by the needles, so the table has one row per state and one column
+ * per class. The case insensitive automaton folds ASCII letters in the class table, the text is not copied.
+ */
+class AhoCorasick
+{
+private:
+    static constexpr int32_t NO_STATE = -1; ///< Missing transition, output or link
+
+    std::array<uint16_t, 256> m_classes; ///< Class of each byte, 0 for the bytes not used by the needles
+    std::size_t m_alphabet;              ///< Number of classes
+    std::vector<int32_t> m_transitions;  ///< Next state by state and class, the complete automaton
+    std::vector<int32_t> m_outputs;      ///< Needle ending at each state
+    std::vector<int32_t> m_outputLinks;  ///< Closest suffix state with an output
+    std::vector<uint8_t> m_accepting;    ///< The state or one of its suffixes ends a needle
+    std::size_t m_needles;               ///< Number of distinct needles
+    bool m_hasEmpty;                     ///< An empty needle, it is found in any text
+
+    /**
+     * @brief Add the needles to the trie, leaving the missing transitions unset.
+     */
+    void buildTrie(const std::vector<std::string>& needles);
+
+    /**
+     * @brief Compute the failure links breadth first and complete the transitions with them.
+     */
+    void buildLinks();
+
+public:
+    /**
+     * @brief Build the automaton of the needles.
+     *
+     * @param needles The substrings to find, the repeated ones are counted once.
+     * @param caseInsensitive Match the ASCII letters regardless of their case.
+     */
+    explicit AhoCorasick(const std::vector<std::string>& needles, bool caseInsensitive = false);
+
+    /**
+     * @brief Check if the text contains any of the needles.
+     *
+     * @param text The text to scan.
+     * @return true if at least one needle is found.
+     */
+    bool containsAny(std::string_view text) const;
+
+    /**
+     * @brief Check if the text contains all the needles.
+     *
+     * @param text The text to scan.
+     * @return true if every needle is found.
+     */
+    bool containsAll(std::string_view text) const;
+
+    /**
+     * @brief Get the number of distinct needles.
+     *
+     * @return std::size_t
+     */
+    std::size_t size() const { return m_needles; }
+
+    /**
+     * @brief Get the number of states of the automaton.
+     *
+     * @return std::size_t
+     */
+    std::size_t states() const { return m_outputs.size(); }
+};
+
+} // namespace base::utils::string
+
+#endif // _AHO_CORASICK_H
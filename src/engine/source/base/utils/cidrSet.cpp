@@ -0,0 +1,248 @@
+#include "cidrSet.hpp"
+#include "ipUtils.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+
+#include <arpa/inet.h>
+
+#include <fmt/format.h>
+
+namespace utils::ip
+{
+
+namespace
+{
+constexpr uint8_t IPV6_BITS = 128;
+constexpr uint8_t IPV4_BITS = 32;
+constexpr uint8_t IPV4_MAPPED_OFFSET = 96; ///< Bits of the ::ffff:0:0/96 prefix
+
+/**
+ * @brief Get a bit of an address, the bit 0 is the most significant one.
+ */
+inline uint8_t bitAt(const CIDRSet::Address& address, uint8_t index)
+{
+    return (address[index / 8] >> (7 - index % 8)) & 1;
+}
+
+/**
+ * @brief Get the number of leading bits shared by two addresses, up to `limit`.
+ */
+inline uint8_t commonPrefix(const CIDRSet::Address& lhs, const CIDRSet::Address& rhs, uint8_t limit)
+{
+    for (uint8_t bit = 0; bit < limit; bit += 8)
+    {
+        const auto diff = static_cast<uint8_t>(lhs[bit / 8] ^ rhs[bit / 8]);
+        if (diff != 0)
+        {
+            const auto leading = static_cast<uint8_t>(__builtin_clz(diff) - 24);
+            return std::min<uint8_t>(limit, bit + leading);
+        }
+    }
+    return limit;
+}
+
+/**
+ * @brief Clear the bits of the address after the prefix length.
+ */
+void maskAddress(CIDRSet::Address& address, uint8_t length)
+{
+    for (std::size_t i = 0; i < address.size(); ++i)
+    {
+        const int bits = static_cast<int>(length) - static_cast<int>(i * 8);
+        if (bits <= 0)
+        {
+            address[i] = 0;
+        }
+        else if (bits < 8)
+        {
+            address[i] &= static_cast<uint8_t>(0xFF << (8 - bits));
+        }
+    }
+}
+
+/**
+ * @brief Parse the prefix length of a network, as a number of bits or as an IPv4 mask.
+ */
+uint8_t parseLength(const std::string& length, bool isIPv4)
+{
+    const uint8_t maxLength = isIPv4 ? IPV4_BITS : IPV6_BITS;
+    if (isIPv4 && length.find('.') != std::string::npos)
+    {
+        in_addr mask {};
+        if (inet_pton(AF_INET, length.c_str(), &mask) != 1)
+        {
+            throw std::invalid_argument(fmt::format("Invalid network mask '{}'", length));
+        }
+
+        const uint32_t value = ntohl(mask.s_addr);
+        const uint32_t hostBits = ~value;
+        if ((hostBits & (hostBits + 1)) != 0)
+        {
+            throw std::invalid_argument(fmt::format("Network mask '{}' is not contiguous", length));
+        }
+        return static_cast<uint8_t>(__builtin_popcount(value));
+    }
+
+    if (length.empty() || length.size() > 3
+        || !std::all_of(length.begin(), length.end(), [](unsigned char c) { return std::isdigit(c); }))
+    {
+        throw std::invalid_argument(fmt::format("Invalid prefix length '{}'", length));
+    }
+
+    const auto value = std::stoi(length);
+    if (value > maxLength)
+    {
+        throw std::invalid_argument(fmt::format("Prefix length '{}' is greater than {}", length, maxLength));
+    }
+    return static_cast<uint8_t>(value);
+}
+} // namespace
+
+CIDRSet::CIDRSet()
+    : m_nodes(1)
+    , m_size(0)
+{
+}
+
+std::optional<CIDRSet::Address> CIDRSet::parseAddress(const std::string& ip)
+{
+    Address address {};
+    if (ip.find(':') != std::string::npos)
+    {
+        if (inet_pton(AF_INET6, ip.c_str(), address.data()) != 1)
+        {
+            return std::nullopt;
+        }
+        return address;
+    }
+
+    // IPv4-mapped IPv6 address ::ffff:x.x.x.x
+    uint32_t ipv4 {};
+    if (!parseIPv4(ip, ipv4))
+    {
+        return std::nullopt;
+    }
+    address[10] = 0xFF;
+    address[11] = 0xFF;
+    address[12] = static_cast<uint8_t>(ipv4 >> 24);
+    address[13] = static_cast<uint8_t>(ipv4 >> 16);
+    address[14] = static_cast<uint8_t>(ipv4 >> 8);
+    address[15] = static_cast<uint8_t>(ipv4);
+    return address;
+}
+
+void CIDRSet::add(const std::string& cidr)
+{
+    const auto slash = cidr.find('/');
+    const auto ip = cidr.substr(0, slash);
+
+    auto address = parseAddress(ip);
+    if (!address)
+    {
+        throw std::invalid_argument(fmt::format("Invalid IP address '{}'", ip));
+    }
+
+    const bool isIPv4 = ip.find(':') == std::string::npos;
+    uint8_t length = isIPv4 ? IPV4_BITS : IPV6_BITS;
+    if (slash != std::string::npos)
+    {
+        length = parseLength(cidr.substr(slash + 1), isIPv4);
+    }
+    if (isIPv4)
+    {
+        length += IPV4_MAPPED_OFFSET;
+    }
+
+    maskAddress(address.value(), length);
+    insert(address.value(), length);
+    ++m_size;
+}
+
+void CIDRSet::insert(const Address& prefix, uint8_t length)
+{
+    std::size_t current = 0;
+    while (true)
+    {
+        if (m_nodes[current].length == length)
+        {
+            m_nodes[current].terminal = true;
+            return;
+        }
+
+        const auto branch = bitAt(prefix, m_nodes[current].length);
+        const auto childIndex = m_nodes[current].children[branch];
+        if (childIndex == NO_CHILD)
+        {
+            Node leaf {prefix, length, true};
+            m_nodes.push_back(leaf);
+            m_nodes[current].children[branch] = static_cast<int32_t>(m_nodes.size() - 1);
+            return;
+        }
+
+        const auto& child = m_nodes[childIndex];
+        const auto shared = commonPrefix(prefix, child.prefix, std::min(length, child.length));
+        if (shared == child.length)
+        {
+            current = childIndex;
+            continue;
+        }
+
+        // The new prefix diverges inside the child edge, split it
+        Node split {prefix, shared, shared == length};
+        maskAddress(split.prefix, shared);
+        split.children[bitAt(child.prefix, shared)] = childIndex;
+        if (!split.terminal)
+        {
+            Node leaf {prefix, length, true};
+            m_nodes.push_back(leaf);
+            split.children[bitAt(prefix, shared)] = static_cast<int32_t>(m_nodes.size() - 1);
+        }
+        m_nodes.push_back(split);
+        m_nodes[current].children[branch] = static_cast<int32_t>(m_nodes.size() - 1);
+        return;
+    }
+}
+
+bool CIDRSet::contains(const Address& address) const
+{
+    std::size_t current = 0;
+    while (true)
+    {
+        const auto& node = m_nodes[current];
+        if (node.terminal)
+        {
+            return true;
+        }
+        if (node.length == IPV6_BITS)
+        {
+            return false;
+        }
+
+        const auto childIndex = node.children[bitAt(address, node.length)];
+        if (childIndex == NO_CHILD)
+        {
+            return false;
+        }
+
+        const auto& child = m_nodes[childIndex];
+        if (commonPrefix(address, child.prefix, child.length) != child.length)
+        {
+            return false;
+        }
+        current = childIndex;
+    }
+}
+
+std::optional<bool> CIDRSet::contains(const std::string& ip) const
+{
+    const auto address = parseAddress(ip);
+    if (!address)
+    {
+        return std::nullopt;
+    }
+    return contains(address.value());
+}
+
+} // namespace utils::ip
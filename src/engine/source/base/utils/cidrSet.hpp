@@ -0,0 +1,105 @@
+#ifndef _CIDR_SET_H
+#define _CIDR_SET_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace utils::ip
+{
+
+/**
+ * @brief A set of IPv4 and IPv6 networks, backed by a path compressed binary trie.
+ *
+ * The networks are added while the set is built, after that it is only read, so it can be shared between threads.
+ * The IPv4 networks are stored as IPv4-mapped IPv6 networks (::ffff:0:0/96), and a lookup walks at most one node per
+ * bit of the longest prefix of the set.
+ */
+class CIDRSet
+{
+public:
+    using Address = std::array<uint8_t, 16>; ///< IPv6 address, network byte order
+
+private:
+    static constexpr int32_t NO_CHILD = -1; ///< Index of a missing child
+
+    /**
+     * @brief A node of the trie, the prefix of the node includes the prefixes of its ancestors.
+     */
+    struct Node
+    {
+        Address prefix {};                                    ///< Prefix bits, the bits after `length` are zero
+        uint8_t length {0};                                   ///< Number of bits of the prefix
+        bool terminal {false};                                ///< The prefix is a network of the set
+        std::array<int32_t, 2> children {NO_CHILD, NO_CHILD}; ///< Children by the bit after the prefix
+    };
+
+    std::vector<Node> m_nodes; ///< The nodes, the root is the first one
+    std::size_t m_size;        ///< Number of networks added
+
+    /**
+     * @brief Insert a network in the trie.
+     *
+     * @param prefix The network address, the bits after `length` must be zero.
+     * @param length The prefix length.
+     */
+    void insert(const Address& prefix, uint8_t length);
+
+public:
+    CIDRSet();
+
+    /**
+     * @brief Parse an IPv4 or IPv6 address.
+     *
+     * @param ip The address to parse.
+     * @return std::optional<Address> The address, IPv4 addresses are mapped to IPv6, empty if the string is not an
+     * address.
+     */
+    static std::optional<Address> parseAddress(const std::string& ip);
+
+    /**
+     * @brief Add a network to the set.
+     *
+     * @param cidr The network, in any of the formats: `x.x.x.x/len`, `x.x.x.x/m.m.m.m`, `x:x::x/len` or a single
+     * address. The host bits are ignored.
+     * @throw std::invalid_argument if the network is not valid.
+     */
+    void add(const std::string& cidr);
+
+    /**
+     * @brief Check if an address belongs to any network of the set.
+     *
+     * @param address The address, IPv4 addresses must be mapped to IPv6.
+     * @return true if the address is in the set.
+     */
+    bool contains(const Address& address) const;
+
+    /**
+     * @brief Check if an address belongs to any network of the set.
+     *
+     * @param ip The IPv4 or IPv6 address.
+     * @return std::optional<bool> empty if the string is not an address.
+     */
+    std::optional<bool> contains(const std::string& ip) const;
+
+    /**
+     * @brief Get the number of networks added to the set.
+     *
+     * @return std::size_t
+     */
+    std::size_t size() const { return m_size; }
+
+    /**
+     * @brief Check if no network has been added to the set.
+     *
+     * @return true if the set is empty.
+     */
+    bool empty() const { return m_size == 0; }
+};
+
+} // namespace utils::ip
+
+#endif // _CIDR_SET_H
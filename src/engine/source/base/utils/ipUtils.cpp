@@ -30,6 +30,52 @@ uint32_t IPv4ToUInt(const std::string& ipStr)
     return ipUInt;
 }
 
+bool parseIPv4(std::string_view ip, uint32_t& value) noexcept
+{
+    uint32_t address = 0;
+    uint32_t octet = 0;
+    unsigned digits = 0;
+    unsigned dots = 0;
+
+    for (const auto c : ip)
+    {
+        const auto digit = static_cast<unsigned>(c - '0');
+
+        if (digit <= 9)
+        {
+            // A leading zero is only valid as the whole octet
+            if (digits != 0 && octet == 0)
+            {
+                return false;
+            }
+
+            octet = octet * 10 + digit;
+            if (++digits > 3 || octet > 255)
+            {
+                return false;
+            }
+        }
+        else if (c == '.' && digits != 0 && ++dots < 4)
+        {
+            address = (address << 8) | octet;
+            octet = 0;
+            digits = 0;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    if (dots != 3 || digits == 0)
+    {
+        return false;
+    }
+
+    value = (address << 8) | octet;
+    return true;
+}
+
 // TODO: Missing unit tests fot this
 uint32_t IPv4MaskUInt(const std::string& maskStr)
 {
@@ -1,7 +1,9 @@
 #ifndef _IP_UTILS_H
 #define _IP_UTILS_H
 
+#include <cstdint>
 #include <iostream>
+#include <string_view>
 
 namespace utils::ip
 {
@@ -15,6 +17,18 @@ namespace utils::ip
  */
 uint32_t IPv4ToUInt(const std::string& ip);
 
+/**
+ * @brief Parse a IPv4 string in a single pass, without allocations nor exceptions
+ *
+ * Accepts the same addresses as inet_pton(AF_INET): four decimal octets up to 255, without leading zeros nor
+ * trailing characters.
+ *
+ * @param ip String to be parsed (format x.x.x.x)
+ * @param value ipv4 in host byte order, only set if the address is valid
+ * @return true if the string is a valid IPv4 address
+ */
+bool parseIPv4(std::string_view ip, uint32_t& value) noexcept;
+
 /**
  * @brief convert a mask IPv4 string to a uint32_t
  *
@@ -0,0 +1,156 @@
+#include "numaUtils.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <thread>
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <fmt/format.h>
+
+namespace utils::numa
+{
+
+namespace
+{
+int toCpu(std::string_view str, std::string_view cpuList)
+{
+    int cpu {-1};
+    auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), cpu);
+    if (ec != std::errc() || ptr != str.data() + str.size() || cpu < 0)
+    {
+        throw std::invalid_argument(fmt::format("Invalid CPU list '{}'", cpuList));
+    }
+    return cpu;
+}
+
+Topology singleNode()
+{
+    const auto count = std::max(1U, std::thread::hardware_concurrency());
+    std::vector<int> cpus(count);
+    for (unsigned int i = 0; i < count; ++i)
+    {
+        cpus[i] = static_cast<int>(i);
+    }
+    return {cpus};
+}
+} // namespace
+
+std::vector<int> parseCpuList(std::string_view cpuList)
+{
+    std::vector<int> cpus {};
+
+    // The sysfs files end with a new line
+    const auto last = cpuList.find_last_not_of(" \n");
+    auto list = last == std::string_view::npos ? std::string_view {} : cpuList.substr(0, last + 1);
+
+    while (!list.empty())
+    {
+        const auto comma = list.find(',');
+        const auto range = list.substr(0, comma);
+        list = comma == std::string_view::npos ? std::string_view {} : list.substr(comma + 1);
+
+        const auto dash = range.find('-');
+        const auto first = toCpu(range.substr(0, dash), cpuList);
+        const auto end = dash == std::string_view::npos ? first : toCpu(range.substr(dash + 1), cpuList);
+        if (end < first)
+        {
+            throw std::invalid_argument(fmt::format("Invalid CPU list '{}'", cpuList));
+        }
+
+        for (auto cpu = first; cpu <= end; ++cpu)
+        {
+            cpus.emplace_back(cpu);
+        }
+    }
+
+    return cpus;
+}
+
+Topology getTopology(const std::string& sysfsNodePath)
+{
+    std::map<int, std::vector<int>> nodes {};
+
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(sysfsNodePath, ec))
+    {
+        const auto name = entry.path().filename().string();
+        if (name.rfind("node", 0) != 0)
+        {
+            continue;
+        }
+
+        int node {-1};
+        const auto* begin = name.data() + 4;
+        const auto* end = name.data() + name.size();
+        auto [ptr, err] = std::from_chars(begin, end, node);
+        if (err != std::errc() || ptr != end)
+        {
+            continue;
+        }
+
+        std::ifstream file {entry.path() / "cpulist"};
+        std::string cpuList {};
+        if (!file.good() || !std::getline(file, cpuList))
+        {
+            continue;
+        }
+
+        try
+        {
+            auto cpus = parseCpuList(cpuList);
+            if (!cpus.empty())
+            {
+                nodes.emplace(node, std::move(cpus));
+            }
+        }
+        catch (const std::invalid_argument&)
+        {
+            continue;
+        }
+    }
+
+    if (nodes.empty())
+    {
+        return singleNode();
+    }
+
+    Topology topology {};
+    topology.reserve(nodes.size());
+    for (auto& [node, cpus] : nodes)
+    {
+        topology.emplace_back(std::move(cpus));
+    }
+    return topology;
+}
+
+int currentCpu()
+{
+    return sched_getcpu();
+}
+
+base::OptError pinCurrentThread(int cpu)
+{
+    if (cpu < 0 || cpu >= CPU_SETSIZE)
+    {
+        return base::Error {fmt::format("Invalid CPU {}", cpu)};
+    }
+
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(cpu, &cpuSet);
+    if (auto res = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet); res != 0)
+    {
+        return base::Error {fmt::format("Cannot pin the thread to CPU {}: {}", cpu, std::strerror(res))};
+    }
+
+    return base::noError();
+}
+
+} // namespace utils::numa
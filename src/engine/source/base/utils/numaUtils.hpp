@@ -0,0 +1,54 @@
+#ifndef _NUMA_UTILS_H
+#define _NUMA_UTILS_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <error.hpp>
+
+namespace utils::numa
+{
+
+constexpr auto SYSFS_NODE_PATH = "/sys/devices/system/node"; ///< Where the kernel describes the NUMA nodes
+
+using Topology = std::vector<std::vector<int>>; ///< CPUs of each NUMA node, indexed by node
+
+/**
+ * @brief Parse a kernel CPU list (i.e. "0-3,8,10-11")
+ *
+ * @param cpuList The list, as found in the cpulist files of sysfs
+ * @return std::vector<int> The CPUs of the list, in order
+ * @throws std::invalid_argument if the list is not valid
+ */
+std::vector<int> parseCpuList(std::string_view cpuList);
+
+/**
+ * @brief Get the CPUs of each NUMA node of the host
+ *
+ * The nodes without CPUs (memory only nodes) are skipped. If the topology cannot be read, all the CPUs are reported
+ * as a single node.
+ *
+ * @param sysfsNodePath The sysfs directory of the NUMA nodes
+ * @return Topology The CPUs of each node, there is always at least one node with one CPU
+ */
+Topology getTopology(const std::string& sysfsNodePath = SYSFS_NODE_PATH);
+
+/**
+ * @brief Get the CPU the calling thread is running on
+ *
+ * @return int The CPU, or -1 if it is not known
+ */
+int currentCpu();
+
+/**
+ * @brief Pin the calling thread to a CPU
+ *
+ * @param cpu The CPU
+ * @return base::OptError An error if the affinity cannot be set
+ */
+base::OptError pinCurrentThread(int cpu);
+
+} // namespace utils::numa
+
+#endif // _NUMA_UTILS_H
@@ -1,6 +1,7 @@
 #ifndef _BK_RX_CONTROLLER_HPP
 #define _BK_RX_CONTROLLER_HPP
 
+#include <functional>
 #include <memory>
 #include <unordered_map>
 #include <unordered_set>
@@ -8,6 +9,7 @@
 #include <rxcpp/rx.hpp>
 
 #include <bk/icontroller.hpp>
+#include <bk/profiler.hpp>
 #include <expression.hpp>
 
 #include "baseTypes.hpp"
@@ -38,6 +40,50 @@ private:
     rxcpp::subscriber<RxEvent> m_policyInput;
     rxcpp::observable<RxEvent> m_policyOutput;
 
+    std::function<void()> m_endCallback; ///< Callback to call when the expression is finished
+    bool m_traced;                       ///< The pipeline publishes the traces
+    std::size_t m_subscriptions;         ///< Number of subscriptions to the traceables
+
+    std::shared_ptr<Profiler> m_profiler;       ///< Profiler of the assets and terms, null if not profiled
+    std::shared_ptr<Profiler::Sample> m_sample; ///< Timing of the event being processed, shared with the pipeline
+    std::size_t m_untilSample;                  ///< Events to ingest until the next sampled one
+
+    /**
+     * @brief Build the pipeline of the expression, replacing the current one.
+     *
+     * @param traced If false, the terms do not publish their traces.
+     */
+    void build(bool traced);
+
+    /**
+     * @brief Rebuild the pipeline if the tracing does not match the subscriptions.
+     *
+     * Tracing is compiled out of the pipeline while nobody is subscribed.
+     */
+    void updateTracing()
+    {
+        if (m_traced != (m_subscriptions > 0))
+        {
+            build(m_subscriptions > 0);
+        }
+    }
+
+    /**
+     * @brief Decide if the next event is timed, one of every `Profiler::sampleRate` events is.
+     */
+    void updateSample()
+    {
+        if (m_profiler)
+        {
+            m_sample->active = --m_untilSample == 0;
+            if (m_sample->active)
+            {
+                m_untilSample = m_profiler->sampleRate();
+                m_sample->starts.clear();
+            }
+        }
+    }
+
 public:
     Controller() = delete;
     Controller(const Controller&) = delete;
@@ -50,16 +96,20 @@ public:
      * @param expression expression to build
      * @param traceables traceables expressions
      * @param endCallback callback to call when the expression is finished
+     * @param profiler profiler of the assets and terms, null to not profile them
      */
     Controller(const base::Expression& expression,
                const std::unordered_set<std::string>& traceables,
-               const std::function<void()>& endCallback = nullptr);
+               const std::function<void()>& endCallback = nullptr,
+               std::shared_ptr<Profiler> profiler = nullptr);
 
     /**
      * @copydoc bk::IController::ingest
      */
     void ingest(base::Event&& event) override
     {
+        updateTracing();
+        updateSample();
         if (m_policyInput.is_subscribed())
         {
             RxEvent rxEvent =
@@ -73,6 +123,8 @@ public:
      */
     base::Event ingestGet(base::Event&& event) override
     {
+        updateTracing();
+        updateSample();
         if (m_policyInput.is_subscribed())
         {
             RxEvent rxEvent =
@@ -133,7 +185,20 @@ public:
 
 class ControllerMaker : public IControllerMaker
 {
+private:
+    std::shared_ptr<Profiler> m_profiler; ///< Profiler of the controllers, null if not profiled
+
 public:
+    /**
+     * @brief Construct a new Controller Maker.
+     *
+     * @param profiler profiler shared by the controllers created, null to not profile them
+     */
+    explicit ControllerMaker(std::shared_ptr<Profiler> profiler = nullptr)
+        : m_profiler(std::move(profiler))
+    {
+    }
+
     /**
      * @copydoc bk::IControllerMaker::create
      */
@@ -141,7 +206,7 @@ public:
                                         const std::unordered_set<std::string>& traceables,
                                         const std::function<void()>& endCallback) override
     {
-        return std::make_shared<Controller>(expression, traceables, endCallback);
+        return std::make_shared<Controller>(expression, traceables, endCallback, m_profiler);
     }
 };
 
@@ -1,6 +1,7 @@
 #ifndef _BK_TASKF_CONTROLLER_HPP
 #define _BK_TASKF_CONTROLLER_HPP
 
+#include <functional>
 #include <memory>
 #include <unordered_map>
 #include <unordered_set>
@@ -27,6 +28,17 @@ private:
 
     base::Event m_event; ///< Shared event between the tasks
 
+    std::function<void()> m_endCallback; ///< Callback to call when the expression is finished
+    bool m_traced;                       ///< The graph publishes the traces
+    std::size_t m_subscriptions;         ///< Number of subscriptions to the traceables
+
+    /**
+     * @brief Build the graph of the expression, replacing the current one.
+     *
+     * @param traced If false, the terms do not publish their traces.
+     */
+    void build(bool traced);
+
 public:
     Controller() = delete;
     Controller(const Controller&) = delete;
@@ -49,6 +61,12 @@ public:
      */
     void ingest(base::Event&& event) override
     {
+        // Tracing is compiled out of the graph while nobody is subscribed
+        if (m_traced != (m_subscriptions > 0))
+        {
+            build(m_subscriptions > 0);
+        }
+
         m_event = std::move(event);
         m_executor.run(m_tf).wait();
     }
@@ -0,0 +1,162 @@
+#ifndef _BK_VM_CONTROLLER_HPP
+#define _BK_VM_CONTROLLER_HPP
+
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <bk/icontroller.hpp>
+#include <bk/profiler.hpp>
+#include <expression.hpp>
+
+namespace bk::vm
+{
+
+namespace detail
+{
+class Program;
+} // namespace detail
+
+/**
+ * @brief Backend that lowers the expression to a flat array of instructions and runs it with an interpreter loop.
+ *
+ * The events are processed in the calling thread, without scheduler, so the cost of each term is the call of its
+ * operation. While nobody is subscribed to the traceables the terms are built without publishers, the program is
+ * rebuilt with them on the first event ingested after a subscription.
+ *
+ * With a profiler, the assets and terms of one of every `Profiler::sampleRate` events are timed. Without it the
+ * program has no profiling instructions.
+ */
+class Controller final : public IController
+{
+private:
+    class TracerImpl; ///< Implementation of the trace
+
+    std::unordered_map<std::string, std::shared_ptr<TracerImpl>> m_traces; ///< Traces
+    std::unordered_set<std::string> m_traceables;                          ///< Traceables
+    base::Expression m_expression;                                         ///< Expression
+
+    std::unique_ptr<detail::Program> m_program; ///< Program built from the expression
+    std::function<void()> m_endCallback;        ///< Callback to call when the expression is finished
+
+    base::Event m_event; ///< Event being processed
+
+    bool m_traced;               ///< The program publishes the traces
+    std::size_t m_subscriptions; ///< Number of subscriptions to the traceables
+
+    std::shared_ptr<Profiler> m_profiler; ///< Profiler of the assets and terms, null if not profiled
+    Profiler::Sample m_sample;            ///< Timing of the event being processed
+    std::size_t m_untilSample;            ///< Events to ingest until the next sampled one
+
+    /**
+     * @brief Build the program of the expression, replacing the current one.
+     *
+     * @param traced If false, the terms do not publish their traces.
+     */
+    void build(bool traced);
+
+public:
+    Controller() = delete;
+    Controller(const Controller&) = delete;
+
+    ~Controller();
+
+    /**
+     * @brief Construct a new Controller from an expression and a set of traceables
+     *
+     * @param expression expression to build
+     * @param traceables traceables expressions
+     * @param endCallback callback to call when the expression is finished
+     * @param profiler profiler of the assets and terms, null to not profile them
+     */
+    Controller(const base::Expression& expression,
+               const std::unordered_set<std::string>& traceables,
+               const std::function<void()>& endCallback = nullptr,
+               std::shared_ptr<Profiler> profiler = nullptr);
+
+    /**
+     * @copydoc bk::IController::ingest
+     */
+    void ingest(base::Event&& event) override;
+
+    /**
+     * @copydoc bk::IController::ingestGet
+     */
+    base::Event ingestGet(base::Event&& event) override
+    {
+        ingest(std::move(event));
+        return std::move(m_event);
+    };
+
+    /**
+     * @copydoc bk::IController::start
+     */
+    void start() override {};
+
+    /**
+     * @copydoc bk::IController::stop
+     */
+    void stop() override {};
+
+    /**
+     * @copydoc bk::IController::isAviable
+     */
+    inline bool isAviable() const override { return true; }
+
+    /**
+     * @copydoc bk::IController::printGraph
+     */
+    std::string printGraph() const override;
+
+    /**
+     * @copydoc bk::IController::getTraceables
+     */
+    const std::unordered_set<std::string>& getTraceables() const override { return m_traceables; }
+
+    /**
+     * @copydoc bk::IController::getTraces
+     */
+    base::RespOrError<Subscription> subscribe(const std::string& traceable, const Subscriber& subscriber) override;
+
+    /**
+     * @copydoc bk::IController::unsubscribe
+     */
+    void unsubscribe(const std::string& traceable, Subscription subscription) override;
+
+    /**
+     * @copydoc bk::IController::unsubscribeAll
+     */
+    void unsubscribeAll() override;
+};
+
+class ControllerMaker : public IControllerMaker
+{
+private:
+    std::shared_ptr<Profiler> m_profiler; ///< Profiler of the controllers, null if not profiled
+
+public:
+    /**
+     * @brief Construct a new Controller Maker.
+     *
+     * @param profiler profiler shared by the controllers created, null to not profile them
+     */
+    explicit ControllerMaker(std::shared_ptr<Profiler> profiler = nullptr)
+        : m_profiler(std::move(profiler))
+    {
+    }
+
+    /**
+     * @copydoc bk::IControllerMaker::create
+     */
+    std::shared_ptr<IController> create(const base::Expression& expression,
+                                        const std::unordered_set<std::string>& traceables,
+                                        const std::function<void()>& endCallback) override
+    {
+        return std::make_shared<Controller>(expression, traceables, endCallback, m_profiler);
+    }
+};
+
+} // namespace bk::vm
+
+#endif // _BK_VM_CONTROLLER_HPP
@@ -0,0 +1,339 @@
+#ifndef _BK_PROFILER_HPP
+#define _BK_PROFILER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace bk
+{
+
+/**
+ * @brief Latency profiler of the assets and helpers run by the controllers.
+ *
+ * The controllers time one of every `sampleRate` events they ingest, at the boundaries of the traceable expressions
+ * (the assets) and of the terms (the helpers). The statistics are kept by name and shared by all the controllers
+ * built with the same profiler, the lookups happen when the controllers are built and the records are lock-free, so
+ * the profiler can be shared by the controllers of all the workers.
+ *
+ * The assets keep a histogram of their latency, with 4 buckets per power of two (up to 25% of error in the
+ * percentiles). The helpers are far more, so they only keep the counters and the total and maximum latency.
+ */
+class Profiler
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::size_t HISTOGRAM_BUCKETS = 160; ///< Buckets of the histograms, up to ~2^40 ns
+
+    /**
+     * @brief Summary of the statistics of an asset or helper, latencies in nanoseconds.
+     */
+    struct Summary
+    {
+        std::string name; ///< Name of the asset or helper
+        uint64_t success; ///< Sampled runs that succeeded
+        uint64_t failure; ///< Sampled runs that failed
+        uint64_t meanNs;  ///< Mean latency
+        uint64_t p50Ns;   ///< Median latency, 0 if not kept
+        uint64_t p99Ns;   ///< 99th percentile of the latency, 0 if not kept
+        uint64_t maxNs;   ///< Maximum latency
+    };
+
+    /**
+     * @brief Statistics of an asset or helper.
+     */
+    class Stats
+    {
+    private:
+        std::atomic<uint64_t> m_success {0}; ///< Sampled runs that succeeded
+        std::atomic<uint64_t> m_failure {0}; ///< Sampled runs that failed
+        std::atomic<uint64_t> m_totalNs {0}; ///< Sum of the latencies
+        std::atomic<uint64_t> m_maxNs {0};   ///< Maximum latency
+
+        std::unique_ptr<std::atomic<uint64_t>[]> m_buckets; ///< Histogram of the latencies, null if not kept
+
+        static uint64_t percentile(const std::vector<uint64_t>& buckets, uint64_t total, double quantile)
+        {
+            const auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(quantile * static_cast<double>(total)));
+            uint64_t seen = 0;
+            for (std::size_t i = 0; i < buckets.size(); ++i)
+            {
+                seen += buckets[i];
+                if (seen >= rank)
+                {
+                    return bucketBound(i + 1) - 1;
+                }
+            }
+            return 0;
+        }
+
+    public:
+        explicit Stats(bool histogram)
+            : m_buckets(histogram ? std::make_unique<std::atomic<uint64_t>[]>(HISTOGRAM_BUCKETS) : nullptr)
+        {
+        }
+
+        /**
+         * @brief Get the bucket of a latency.
+         *
+         * The values below 4 have their own bucket, the rest are split in 4 buckets per power of two.
+         *
+         * @param ns Latency in nanoseconds.
+         * @return std::size_t
+         */
+        static std::size_t bucket(uint64_t ns)
+        {
+            if (ns < 4)
+            {
+                return ns;
+            }
+            const auto msb = 63 - static_cast<std::size_t>(__builtin_clzll(ns));
+            return std::min((msb - 1) * 4 + ((ns >> (msb - 2)) & 3), HISTOGRAM_BUCKETS - 1);
+        }
+
+        /**
+         * @brief Get the lowest latency of a bucket.
+         *
+         * @param index Bucket index.
+         * @return uint64_t
+         */
+        static uint64_t bucketBound(std::size_t index)
+        {
+            if (index < 4)
+            {
+                return index;
+            }
+            return (4 + index % 4) << (index / 4 - 1);
+        }
+
+        /**
+         * @brief Record a sampled run.
+         *
+         * @param ns Latency in nanoseconds.
+         * @param success Result of the run.
+         */
+        void record(uint64_t ns, bool success)
+        {
+            (success ? m_success : m_failure).fetch_add(1, std::memory_order_relaxed);
+            m_totalNs.fetch_add(ns, std::memory_order_relaxed);
+            auto max = m_maxNs.load(std::memory_order_relaxed);
+            while (ns > max && !m_maxNs.compare_exchange_weak(max, ns, std::memory_order_relaxed)) {}
+            if (m_buckets)
+            {
+                m_buckets[bucket(ns)].fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * @brief Get the summary of the statistics.
+         *
+         * @param name Name of the asset or helper.
+         * @return Summary
+         */
+        Summary summary(const std::string& name) const
+        {
+            Summary summary {name,
+                             m_success.load(std::memory_order_relaxed),
+                             m_failure.load(std::memory_order_relaxed),
+                             0,
+                             0,
+                             0,
+                             m_maxNs.load(std::memory_order_relaxed)};
+            const auto total = summary.success + summary.failure;
+            if (total == 0)
+            {
+                return summary;
+            }
+            summary.meanNs = m_totalNs.load(std::memory_order_relaxed) / total;
+
+            if (m_buckets)
+            {
+                // The buckets are read after the counters, so they may hold a few more runs
+                std::vector<uint64_t> buckets(HISTOGRAM_BUCKETS);
+                uint64_t inBuckets = 0;
+                for (std::size_t i = 0; i < HISTOGRAM_BUCKETS; ++i)
+                {
+                    buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+                    inBuckets += buckets[i];
+                }
+                summary.p50Ns = std::min(percentile(buckets, inBuckets, 0.5), summary.maxNs);
+                summary.p99Ns = std::min(percentile(buckets, inBuckets, 0.99), summary.maxNs);
+            }
+
+            return summary;
+        }
+
+        /**
+         * @brief Drop the recorded runs.
+         */
+        void reset()
+        {
+            m_success.store(0, std::memory_order_relaxed);
+            m_failure.store(0, std::memory_order_relaxed);
+            m_totalNs.store(0, std::memory_order_relaxed);
+            m_maxNs.store(0, std::memory_order_relaxed);
+            if (m_buckets)
+            {
+                for (std::size_t i = 0; i < HISTOGRAM_BUCKETS; ++i)
+                {
+                    m_buckets[i].store(0, std::memory_order_relaxed);
+                }
+            }
+        }
+    };
+
+    /**
+     * @brief Timing of the event sampled by a controller.
+     *
+     * The assets nest inside each other and run in the thread of the controller, so their start times are kept in a
+     * stack.
+     */
+    struct Sample
+    {
+        bool active {false};                   ///< The event being processed is sampled
+        std::vector<Clock::time_point> starts; ///< Start of the assets being run
+
+        void begin()
+        {
+            if (active)
+            {
+                starts.push_back(Clock::now());
+            }
+        }
+
+        void end(Stats& stats, bool success)
+        {
+            if (active && !starts.empty())
+            {
+                stats.record(elapsedNs(starts.back()), success);
+                starts.pop_back();
+            }
+        }
+
+        static uint64_t elapsedNs(Clock::time_point start)
+        {
+            return static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+        }
+    };
+
+private:
+    std::size_t m_sampleRate; ///< One of every `m_sampleRate` events is timed
+
+    mutable std::mutex m_mutex;                                        ///< Protects the maps, not the statistics
+    std::unordered_map<std::string, std::shared_ptr<Stats>> m_assets;  ///< Statistics of the assets
+    std::unordered_map<std::string, std::shared_ptr<Stats>> m_helpers; ///< Statistics of the helpers
+
+    std::shared_ptr<Stats> get(std::unordered_map<std::string, std::shared_ptr<Stats>>& map,
+                               const std::string& name,
+                               bool histogram)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto& stats = map[name];
+        if (!stats)
+        {
+            stats = std::make_shared<Stats>(histogram);
+        }
+        return stats;
+    }
+
+    std::vector<Summary> summaries(const std::unordered_map<std::string, std::shared_ptr<Stats>>& map) const
+    {
+        std::vector<Summary> result;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            result.reserve(map.size());
+            for (const auto& [name, stats] : map)
+            {
+                result.emplace_back(stats->summary(name));
+            }
+        }
+        std::sort(result.begin(),
+                  result.end(),
+                  [](const Summary& a, const Summary& b)
+                  { return a.p99Ns != b.p99Ns ? a.p99Ns > b.p99Ns : a.meanNs > b.meanNs; });
+        return result;
+    }
+
+public:
+    /**
+     * @brief Construct a new Profiler.
+     *
+     * @param sampleRate One of every `sampleRate` events is timed.
+     * @throw std::runtime_error if the sample rate is 0.
+     */
+    explicit Profiler(std::size_t sampleRate)
+        : m_sampleRate(sampleRate)
+    {
+        if (m_sampleRate == 0)
+        {
+            throw std::runtime_error("Profiler sample rate must be greater than 0");
+        }
+    }
+
+    /**
+     * @brief Get the sample rate.
+     *
+     * @return std::size_t
+     */
+    std::size_t sampleRate() const { return m_sampleRate; }
+
+    /**
+     * @brief Get the statistics of an asset, created if needed.
+     *
+     * @param name Name of the asset.
+     * @return std::shared_ptr<Stats>
+     */
+    std::shared_ptr<Stats> asset(const std::string& name) { return get(m_assets, name, true); }
+
+    /**
+     * @brief Get the statistics of a helper, created if needed.
+     *
+     * @param name Name of the helper (term).
+     * @return std::shared_ptr<Stats>
+     */
+    std::shared_ptr<Stats> helper(const std::string& name) { return get(m_helpers, name, false); }
+
+    /**
+     * @brief Get the summaries of the assets, slowest (by p99) first.
+     *
+     * @return std::vector<Summary>
+     */
+    std::vector<Summary> assets() const { return summaries(m_assets); }
+
+    /**
+     * @brief Get the summaries of the helpers, slowest (by mean) first.
+     *
+     * @return std::vector<Summary>
+     */
+    std::vector<Summary> helpers() const { return summaries(m_helpers); }
+
+    /**
+     * @brief Drop the runs recorded by all the assets and helpers.
+     */
+    void reset()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& [name, stats] : m_assets)
+        {
+            stats->reset();
+        }
+        for (auto& [name, stats] : m_helpers)
+        {
+            stats->reset();
+        }
+    }
+};
+
+} // namespace bk
+
+#endif // _BK_PROFILER_HPP
@@ -11,26 +11,48 @@ class Controller::TracerImpl final : public detail::Tracer
 
 Controller::Controller(const base::Expression& expression,
                        const std::unordered_set<std::string>& traceables,
-                       const std::function<void()>& endCallback)
+                       const std::function<void()>& endCallback,
+                       std::shared_ptr<Profiler> profiler)
     : m_traceables {traceables}
     , m_expression {expression}
     , m_policyInput {m_policySubject.get_subscriber()}
+    , m_endCallback {endCallback}
+    , m_traced {false}
+    , m_subscriptions {0}
+    , m_profiler {std::move(profiler)}
+    , m_sample {std::make_shared<Profiler::Sample>()}
+    , m_untilSample {m_profiler ? m_profiler->sampleRate() : 0}
 {
+    build(false);
+}
+
+void Controller::build(bool traced)
+{
+    // Close the current pipeline, if any, and open a new one
+    if (m_policyInput.is_subscribed())
+    {
+        m_policyInput.on_completed();
+    }
+    m_policySubject = rxcpp::subjects::subject<RxEvent>();
+    m_policyInput = m_policySubject.get_subscriber();
+
     detail::ExprBuilder builder;
-    std::unordered_map<std::string, std::shared_ptr<detail::Tracer>> traces;
-    m_policyOutput = builder.build(expression, traces, m_traceables, m_policySubject.get_observable());
+    std::unordered_map<std::string, std::shared_ptr<detail::Tracer>> traces(m_traces.begin(), m_traces.end());
+    m_policyOutput = builder.build(
+        m_expression, traces, m_traceables, traced, m_policySubject.get_observable(), m_profiler.get(), m_sample);
     for (auto& [name, trace] : traces)
     {
         m_traces.emplace(name, std::static_pointer_cast<TracerImpl>(trace));
     }
-    if (endCallback != nullptr)
+    if (m_endCallback != nullptr)
     {
-        m_policyOutput.subscribe([endCallback](const RxEvent& event) { endCallback(); });
+        m_policyOutput.subscribe([endCallback = m_endCallback](const RxEvent& event) { endCallback(); });
     }
     else
     {
         m_policyOutput.subscribe();
     }
+    m_traced = traced;
 }
 
 base::RespOrError<Subscription> Controller::subscribe(const std::string& traceable, const Subscriber& subscriber)
@@ -41,7 +63,12 @@ base::RespOrError<Subscription> Controller::subscribe(const std::string& traceab
         return base::Error {"Traceable not found"};
     }
 
-    return it->second->subscribe(subscriber);
+    auto res = it->second->subscribe(subscriber);
+    if (!base::isError(res))
+    {
+        ++m_subscriptions;
+    }
+    return res;
 }
 
 void Controller::unsubscribe(const std::string& traceable, Subscription subscription)
@@ -52,7 +79,10 @@ void Controller::unsubscribe(const std::string& traceable, Subscription subscrip
         return;
     }
 
-    it->second->unsubscribe(subscription);
+    if (it->second->unsubscribe(subscription))
+    {
+        --m_subscriptions;
+    }
 }
 
 void Controller::unsubscribeAll()
@@ -61,6 +91,7 @@ void Controller::unsubscribeAll()
     {
         trace->unsubscribeAll();
     }
+    m_subscriptions = 0;
 }
 
 } // namespace bk::rx
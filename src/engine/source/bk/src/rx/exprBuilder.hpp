@@ -5,6 +5,7 @@
 #include <memory>
 
 #include <baseTypes.hpp>
+#include <bk/profiler.hpp>
 #include <expression.hpp>
 
 #include "tracer.hpp"
@@ -23,6 +24,9 @@ private:
         Publisher publisher;
         std::unordered_map<std::string, std::shared_ptr<Tracer>>& traces;
         const std::unordered_set<std::string>& traceables;
+        bool traced;
+        Profiler* profiler;
+        std::shared_ptr<Profiler::Sample> sample;
     };
 
     Observable recBuild(const Observable& input, const base::Expression& expression, BuildParams& params)
@@ -42,9 +46,35 @@ private:
                 params.traces.emplace(expression->getName(), std::make_shared<Tracer>());
             }
 
-            params.publisher = params.traces[expression->getName()]->publisher();
+            if (params.traced)
+            {
+                params.publisher = params.traces[expression->getName()]->publisher();
+            }
+
+            // The inner pipeline is subscribed before the output, so the output sees the event once it is done
+            if (params.profiler != nullptr)
+            {
+                auto begin = input.map(
+                    [sample = params.sample](RxEvent result)
+                    {
+                        sample->begin();
+                        return result;
+                    });
+                return buildExpression(begin, expression, params)
+                    .map(
+                        [sample = params.sample, stats = params.profiler->asset(expression->getName())](RxEvent result)
+                        {
+                            sample->end(*stats, result->success());
+                            return result;
+                        });
+            }
         }
 
+        return buildExpression(input, expression, params);
+    }
+
+    Observable buildExpression(const Observable& input, const base::Expression& expression, BuildParams& params)
+    {
         // Handle pipelines
         if (expression->isOperation())
         {
@@ -123,6 +153,31 @@ private:
         else if (expression->isTerm())
         {
             auto term = expression->getPtr<base::Term<base::EngineOp>>();
+            if (params.profiler != nullptr)
+            {
+                return input.map(
+                    [op = term->getFn(),
+                     tracer = params.publisher,
+                     sample = params.sample,
+                     stats = params.profiler->helper(term->getName())](RxEvent result)
+                    {
+                        if (!sample->active)
+                        {
+                            *result = op(result->payload());
+                        }
+                        else
+                        {
+                            const auto start = Profiler::Clock::now();
+                            *result = op(result->payload());
+                            stats->record(Profiler::Sample::elapsedNs(start), result->success());
+                        }
+                        if (tracer != nullptr)
+                        {
+                            tracer(std::string {result->trace()}, result->success());
+                        }
+                        return result;
+                    });
+            }
             return input.map(
                 [op = term->getFn(), tracer = params.publisher](RxEvent result)
                 {
@@ -148,9 +203,17 @@ public:
     Observable build(const base::Expression& expression,
                      std::unordered_map<std::string, std::shared_ptr<Tracer>>& traces,
                      const std::unordered_set<std::string>& traceables,
-                     const Observable& input)
+                     bool traced,
+                     const Observable& input,
+                     Profiler* profiler = nullptr,
+                     const std::shared_ptr<Profiler::Sample>& sample = nullptr)
     {
-        BuildParams params {.publisher = nullptr, .traces = traces, .traceables = traceables};
+        BuildParams params {.publisher = nullptr,
+                            .traces = traces,
+                            .traceables = traceables,
+                            .traced = traced,
+                            .profiler = profiler,
+                            .sample = sample};
         auto output = recBuild(input, expression, params);
 
         return output;
@@ -17,14 +17,25 @@ Controller::Controller(const base::Expression& expression,
     , m_event()
     , m_traceables(traceables)
     , m_expression(expression)
+    , m_endCallback(endCallback)
+    , m_traced(false)
+    , m_subscriptions(0)
 {
+    build(false);
+}
+
+void Controller::build(bool traced)
+{
+    std::unordered_map<std::string, std::shared_ptr<detail::Tracer>> traces(m_traces.begin(), m_traces.end());
+
+    m_tf.clear();
     detail::ExprBuilder builder;
-    std::unordered_map<std::string, std::shared_ptr<detail::Tracer>> traces;
-    builder.build(m_expression, m_tf, &m_event, traces, m_traceables, endCallback);
+    builder.build(m_expression, m_tf, &m_event, traces, m_traceables, traced, m_endCallback);
     for (auto& [name, trace] : traces)
     {
         m_traces.emplace(name, std::static_pointer_cast<TracerImpl>(trace));
     }
+    m_traced = traced;
 }
 
 base::RespOrError<Subscription> Controller::subscribe(const std::string& traceable, const Subscriber& subscriber)
@@ -35,7 +46,12 @@ base::RespOrError<Subscription> Controller::subscribe(const std::string& traceab
         return base::Error {"Traceable not found"};
     }
 
-    return it->second->subscribe(subscriber);
+    auto res = it->second->subscribe(subscriber);
+    if (!base::isError(res))
+    {
+        ++m_subscriptions;
+    }
+    return res;
 }
 
 void Controller::unsubscribe(const std::string& traceable, Subscription subscription)
@@ -46,7 +62,10 @@ void Controller::unsubscribe(const std::string& traceable, Subscription subscrip
         return;
     }
 
-    it->second->unsubscribe(subscription);
+    if (it->second->unsubscribe(subscription))
+    {
+        --m_subscriptions;
+    }
 }
 
 void Controller::unsubscribeAll()
@@ -55,6 +74,7 @@ void Controller::unsubscribeAll()
     {
         trace->unsubscribeAll();
     }
+    m_subscriptions = 0;
 }
 
 } // namespace bk::taskf
@@ -276,6 +276,7 @@ private:
         void* data;
         std::unordered_map<std::string, std::shared_ptr<Tracer>>& traces;
         const std::unordered_set<std::string>& traceables;
+        bool traced;
     };
 
     ComplexTask buildTerm(const base::Term<base::EngineOp>& term, BuildParams& params)
@@ -367,7 +368,10 @@ private:
                 params.traces.emplace(expression->getName(), std::make_unique<Tracer>());
             }
 
-            params.publisher = params.traces[expression->getName()]->publisher();
+            if (params.traced)
+            {
+                params.publisher = params.traces[expression->getName()]->publisher();
+            }
         }
 
         if (expression->isTerm())
@@ -416,9 +420,15 @@ public:
                void* data,
                std::unordered_map<std::string, std::shared_ptr<Tracer>>& traces,
                const std::unordered_set<std::string>& traceables,
+               bool traced,
                std::function<void()> endCallback = nullptr)
     {
-        BuildParams params {.tf = tf, .publisher = nullptr, .data = data, .traces = traces, .traceables = traceables};
+        BuildParams params {.tf = tf,
+                            .publisher = nullptr,
+                            .data = data,
+                            .traces = traces,
+                            .traceables = traceables,
+                            .traced = traced};
         // As complex task are not finished until output is connected we need to force the connection
         auto finalTask = recBuild(expression, params);
         auto output = tf.placeholder().name("output");
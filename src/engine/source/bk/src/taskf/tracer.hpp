@@ -57,11 +57,12 @@ public:
      * @brief Unsubscribe a subscriber from the trace.
      *
      * @param subscription The subscription identifier to unsubscribe.
+     * @return true if the subscription existed.
      */
-    inline void unsubscribe(Subscription subscription)
+    inline bool unsubscribe(Subscription subscription)
     {
         std::unique_lock lock {m_subscribersMutex};
-        m_subscribers.erase(subscription);
+        return m_subscribers.erase(subscription) > 0;
     }
 
     /**
@@ -0,0 +1,119 @@
+#include "controller.hpp"
+
+#include "exprBuilder.hpp"
+#include "program.hpp"
+#include "tracer.hpp"
+
+namespace bk::vm
+{
+
+class Controller::TracerImpl final : public detail::Tracer
+{
+};
+
+Controller::Controller(const base::Expression& expression,
+                       const std::unordered_set<std::string>& traceables,
+                       const std::function<void()>& endCallback,
+                       std::shared_ptr<Profiler> profiler)
+    : m_traceables(traceables)
+    , m_expression(expression)
+    , m_program()
+    , m_endCallback(endCallback)
+    , m_event()
+    , m_traced(false)
+    , m_subscriptions(0)
+    , m_profiler(std::move(profiler))
+    , m_sample()
+    , m_untilSample(m_profiler ? m_profiler->sampleRate() : 0)
+{
+    build(false);
+}
+
+void Controller::build(bool traced)
+{
+    std::unordered_map<std::string, std::shared_ptr<detail::Tracer>> traces(m_traces.begin(), m_traces.end());
+
+    auto program = std::make_unique<detail::Program>();
+    detail::ExprBuilder builder;
+    builder.build(m_expression, *program, traces, m_traceables, traced, m_profiler.get());
+    for (auto& [name, trace] : traces)
+    {
+        m_traces.emplace(name, std::static_pointer_cast<TracerImpl>(trace));
+    }
+    m_program = std::move(program);
+    m_traced = traced;
+}
+
+Controller::~Controller() = default;
+
+void Controller::ingest(base::Event&& event)
+{
+    // Tracing is compiled out of the program while nobody is subscribed
+    if (m_traced != (m_subscriptions > 0))
+    {
+        build(m_subscriptions > 0);
+    }
+
+    if (m_profiler)
+    {
+        m_sample.active = --m_untilSample == 0;
+        if (m_sample.active)
+        {
+            m_untilSample = m_profiler->sampleRate();
+            m_sample.starts.clear();
+        }
+    }
+
+    m_event = std::move(event);
+    m_program->run(m_event, m_sample);
+    if (m_endCallback)
+    {
+        m_endCallback();
+    }
+}
+
+std::string Controller::printGraph() const
+{
+    return m_program->dump();
+}
+
+base::RespOrError<Subscription> Controller::subscribe(const std::string& traceable, const Subscriber& subscriber)
+{
+    auto it = m_traces.find(traceable);
+    if (it == m_traces.end())
+    {
+        return base::Error {"Traceable not found"};
+    }
+
+    auto res = it->second->subscribe(subscriber);
+    if (!base::isError(res))
+    {
+        ++m_subscriptions;
+    }
+    return res;
+}
+
+void Controller::unsubscribe(const std::string& traceable, Subscription subscription)
+{
+    auto it = m_traces.find(traceable);
+    if (it == m_traces.end())
+    {
+        return;
+    }
+
+    if (it->second->unsubscribe(subscription))
+    {
+        --m_subscriptions;
+    }
+}
+
+void Controller::unsubscribeAll()
+{
+    for (auto& [name, trace] : m_traces)
+    {
+        trace->unsubscribeAll();
+    }
+    m_subscriptions = 0;
+}
+
+} // namespace bk::vm
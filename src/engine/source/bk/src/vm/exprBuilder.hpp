@@ -0,0 +1,188 @@
+#ifndef _BK_VM_EXPRBUILDER_HPP
+#define _BK_VM_EXPRBUILDER_HPP
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <baseTypes.hpp>
+#include <bk/profiler.hpp>
+#include <expression.hpp>
+
+#include "program.hpp"
+#include "tracer.hpp"
+
+namespace bk::vm::detail
+{
+
+/**
+ * @brief Lowers an expression to a flat program.
+ *
+ * - Term: runs the term.
+ * - Chain and Broadcast: run all the operands in order, the result is success.
+ * - And: runs the operands until one fails, the result is the last operand run.
+ * - Or: runs the operands until one succeeds, the result is the last operand run.
+ * - Implication: runs the condition and, if it succeeds, the consequence. The result is the condition.
+ *
+ * With a profiler, the traceables are wrapped between profiling instructions and the terms carry their statistics.
+ */
+class ExprBuilder
+{
+private:
+    struct BuildParams
+    {
+        Program& program;
+        Publisher publisher;
+        std::unordered_map<std::string, std::shared_ptr<Tracer>>& traces;
+        const std::unordered_set<std::string>& traceables;
+        bool traced;
+        Profiler* profiler;
+    };
+
+    /**
+     * @brief Run the operands until one of them sets the status to `stop`.
+     *
+     * @param operation The operation.
+     * @param stop The jump that leaves the operation.
+     * @param params The build parameters.
+     */
+    void buildShortCircuit(const base::Operation& operation, OpCode stop, BuildParams& params)
+    {
+        const auto& operands = operation.getOperands();
+        if (operands.empty())
+        {
+            throw std::runtime_error("Operation '" + operation.getName() + "' has no operands");
+        }
+
+        std::vector<std::size_t> jumps;
+        jumps.reserve(operands.size() - 1);
+        for (std::size_t i = 0; i + 1 < operands.size(); ++i)
+        {
+            recBuild(operands[i], params);
+            jumps.emplace_back(params.program.emitJump(stop));
+        }
+        recBuild(operands.back(), params);
+
+        for (const auto jump : jumps)
+        {
+            params.program.patchJump(jump);
+        }
+    }
+
+    void buildSequence(const base::Operation& operation, BuildParams& params)
+    {
+        for (const auto& operand : operation.getOperands())
+        {
+            recBuild(operand, params);
+        }
+        params.program.emit(OpCode::SET_SUCCESS);
+    }
+
+    void buildImplication(const base::Implication& implication, BuildParams& params)
+    {
+        recBuild(implication.getOperands()[0], params);
+        auto jump = params.program.emitJump(OpCode::JUMP_IF_FAILURE);
+        recBuild(implication.getOperands()[1], params);
+        params.program.emit(OpCode::SET_SUCCESS);
+        params.program.patchJump(jump);
+    }
+
+    void recBuild(const base::Expression& expression, BuildParams& params)
+    {
+        // Error if empty expression
+        if (expression == nullptr)
+        {
+            throw std::runtime_error {"Expression is null"};
+        }
+
+        // Create traceable if found and get the publisher function
+        auto traceIt = params.traceables.find(expression->getName());
+        if (traceIt != params.traceables.end())
+        {
+            if (params.traces.find(expression->getName()) == params.traces.end())
+            {
+                params.traces.emplace(expression->getName(), std::make_shared<Tracer>());
+            }
+
+            if (params.traced)
+            {
+                params.publisher = params.traces[expression->getName()]->publisher();
+            }
+
+            if (params.profiler != nullptr)
+            {
+                auto asset = params.program.emitProfileBegin(expression->getName(),
+                                                             params.profiler->asset(expression->getName()));
+                buildExpression(expression, params);
+                params.program.emitProfileEnd(asset);
+                return;
+            }
+        }
+
+        buildExpression(expression, params);
+    }
+
+    void buildExpression(const base::Expression& expression, BuildParams& params)
+    {
+        if (expression->isTerm())
+        {
+            auto term = expression->getPtr<base::Term<base::EngineOp>>();
+            auto stats = params.profiler != nullptr ? params.profiler->helper(term->getName()) : nullptr;
+            params.program.emitTerm(term->getFn(), term->getName(), params.publisher, std::move(stats));
+        }
+        else if (expression->isOperation())
+        {
+            if (expression->isBroadcast() || expression->isChain())
+            {
+                buildSequence(*expression->getPtr<base::Operation>(), params);
+            }
+            else if (expression->isImplication())
+            {
+                buildImplication(*expression->getPtr<base::Implication>(), params);
+            }
+            else if (expression->isAnd())
+            {
+                buildShortCircuit(*expression->getPtr<base::Operation>(), OpCode::JUMP_IF_FAILURE, params);
+            }
+            else if (expression->isOr())
+            {
+                buildShortCircuit(*expression->getPtr<base::Operation>(), OpCode::JUMP_IF_SUCCESS, params);
+            }
+            else
+            {
+                throw std::runtime_error("Unsupported operation type");
+            }
+        }
+        else
+        {
+            throw std::runtime_error("Unsupported expression type");
+        }
+    }
+
+public:
+    virtual ~ExprBuilder() = default;
+    ExprBuilder() = default;
+
+    void build(const base::Expression& expression,
+               Program& program,
+               std::unordered_map<std::string, std::shared_ptr<Tracer>>& traces,
+               const std::unordered_set<std::string>& traceables,
+               bool traced,
+               Profiler* profiler = nullptr)
+    {
+        BuildParams params {.program = program,
+                            .publisher = nullptr,
+                            .traces = traces,
+                            .traceables = traceables,
+                            .traced = traced,
+                            .profiler = profiler};
+        recBuild(expression, params);
+    }
+};
+
+} // namespace bk::vm::detail
+
+#endif // _BK_VM_EXPRBUILDER_HPP
@@ -0,0 +1,240 @@
+#ifndef _BK_VM_PROGRAM_HPP
+#define _BK_VM_PROGRAM_HPP
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <baseTypes.hpp>
+#include <bk/profiler.hpp>
+
+#include "tracer.hpp"
+
+namespace bk::vm::detail
+{
+
+/**
+ * @brief Operation codes of the program.
+ *
+ * The program has a single status register, which holds the result of the last term or operation executed.
+ */
+enum class OpCode : std::uint8_t
+{
+    TERM,            ///< Run the term `arg` and store its result in the status
+    JUMP_IF_SUCCESS, ///< Jump `arg` instructions forward if the status is success
+    JUMP_IF_FAILURE, ///< Jump `arg` instructions forward if the status is failure
+    SET_SUCCESS,     ///< Set the status to success
+    PROFILE_BEGIN,   ///< Start timing the asset `arg`, if the event is sampled
+    PROFILE_END      ///< Record the time and status of the asset `arg`, if the event is sampled
+};
+
+/**
+ * @brief Instruction of the program.
+ */
+struct Instruction
+{
+    OpCode code;     ///< Operation code
+    std::size_t arg; ///< Term index, asset index or jump offset, depending on the operation code
+};
+
+/**
+ * @brief Term of the program, the only instruction that runs engine code.
+ */
+struct Term
+{
+    base::EngineOp fn;                      ///< Operation of the term
+    Publisher publisher;                    ///< Publisher of the traces of the term, null if the term is not traced
+    std::string name;                       ///< Name of the term
+    std::shared_ptr<Profiler::Stats> stats; ///< Statistics of the term, null if the program is not profiled
+};
+
+/**
+ * @brief Flat representation of an expression.
+ *
+ * The expression tree is lowered to an array of instructions, the operations are replaced by conditional jumps over
+ * their remaining operands, so running an event is a single loop over the array, without recursion, scheduler or
+ * intermediate closures.
+ */
+class Program
+{
+private:
+    std::vector<Instruction> m_code;                        ///< Instructions
+    std::vector<Term> m_terms;                              ///< Terms referenced by the instructions
+    std::vector<std::shared_ptr<Profiler::Stats>> m_assets; ///< Statistics of the profiled assets
+    std::vector<std::string> m_assetNames;                  ///< Names of the profiled assets
+
+public:
+    /**
+     * @brief Append a term to the program.
+     *
+     * @param fn The operation of the term.
+     * @param name The name of the term.
+     * @param publisher The publisher of the traces of the term.
+     * @param stats The statistics of the term, null if it is not profiled.
+     */
+    void emitTerm(base::EngineOp fn,
+                  const std::string& name,
+                  Publisher publisher,
+                  std::shared_ptr<Profiler::Stats> stats = nullptr)
+    {
+        m_code.push_back({OpCode::TERM, m_terms.size()});
+        m_terms.push_back({std::move(fn), std::move(publisher), name, std::move(stats)});
+    }
+
+    /**
+     * @brief Append the start of a profiled asset, the instructions of the asset must follow and be closed by
+     * `emitProfileEnd` with the returned index.
+     *
+     * @param name The name of the asset.
+     * @param stats The statistics of the asset.
+     * @return std::size_t The index of the asset.
+     */
+    std::size_t emitProfileBegin(const std::string& name, std::shared_ptr<Profiler::Stats> stats)
+    {
+        m_code.push_back({OpCode::PROFILE_BEGIN, m_assets.size()});
+        m_assets.push_back(std::move(stats));
+        m_assetNames.push_back(name);
+        return m_assets.size() - 1;
+    }
+
+    /**
+     * @brief Append the end of a profiled asset.
+     *
+     * @param asset The index returned by `emitProfileBegin`.
+     */
+    void emitProfileEnd(std::size_t asset) { m_code.push_back({OpCode::PROFILE_END, asset}); }
+
+    /**
+     * @brief Append a jump to the program, its offset must be set by `patchJump` once the target is emitted.
+     *
+     * @param code The jump operation code.
+     * @return std::size_t The position of the jump.
+     */
+    std::size_t emitJump(OpCode code)
+    {
+        m_code.push_back({code, 0});
+        return m_code.size() - 1;
+    }
+
+    /**
+     * @brief Append an instruction without argument to the program.
+     *
+     * @param code The operation code.
+     */
+    void emit(OpCode code) { m_code.push_back({code, 0}); }
+
+    /**
+     * @brief Set the target of a jump to the end of the program.
+     *
+     * @param jump The position of the jump.
+     */
+    void patchJump(std::size_t jump) { m_code[jump].arg = m_code.size() - jump; }
+
+    /**
+     * @brief Get the instructions of the program.
+     *
+     * @return const std::vector<Instruction>&
+     */
+    const std::vector<Instruction>& code() const { return m_code; }
+
+    /**
+     * @brief Run the program over an event.
+     *
+     * @param event The event, replaced by the payload of each term.
+     * @param sample The timing of the event, the profiling instructions are skipped unless it is active.
+     * @return true if the expression succeeded, false otherwise.
+     */
+    bool run(base::Event& event, Profiler::Sample& sample) const
+    {
+        bool success = true;
+        const auto size = m_code.size();
+        std::size_t pc = 0;
+        while (pc < size)
+        {
+            const auto& instruction = m_code[pc];
+            switch (instruction.code)
+            {
+                case OpCode::TERM:
+                {
+                    const auto& term = m_terms[instruction.arg];
+                    Profiler::Clock::time_point start;
+                    const auto timed = sample.active && term.stats;
+                    if (timed)
+                    {
+                        start = Profiler::Clock::now();
+                    }
+                    auto res = term.fn(event);
+                    success = res.success();
+                    if (timed)
+                    {
+                        term.stats->record(Profiler::Sample::elapsedNs(start), success);
+                    }
+                    if (term.publisher)
+                    {
+                        term.publisher(res.trace(), success);
+                    }
+                    event = res.popPayload();
+                    ++pc;
+                    break;
+                }
+                case OpCode::JUMP_IF_SUCCESS: pc += success ? instruction.arg : 1; break;
+                case OpCode::JUMP_IF_FAILURE: pc += success ? 1 : instruction.arg; break;
+                case OpCode::SET_SUCCESS:
+                    success = true;
+                    ++pc;
+                    break;
+                case OpCode::PROFILE_BEGIN:
+                    sample.begin();
+                    ++pc;
+                    break;
+                case OpCode::PROFILE_END:
+                    sample.end(*m_assets[instruction.arg], success);
+                    ++pc;
+                    break;
+            }
+        }
+
+        return success;
+    }
+
+    /**
+     * @brief Get the program as a graph in DOT format, one node per instruction.
+     *
+     * @return std::string
+     */
+    std::string dump() const
+    {
+        std::stringstream ss;
+        ss << "digraph Program {\n";
+        for (std::size_t pc = 0; pc < m_code.size(); ++pc)
+        {
+            const auto& instruction = m_code[pc];
+            ss << "  i" << pc << " [label=\"" << pc << ": ";
+            switch (instruction.code)
+            {
+                case OpCode::TERM: ss << "term " << m_terms[instruction.arg].name; break;
+                case OpCode::JUMP_IF_SUCCESS: ss << "jump if success +" << instruction.arg; break;
+                case OpCode::JUMP_IF_FAILURE: ss << "jump if failure +" << instruction.arg; break;
+                case OpCode::SET_SUCCESS: ss << "set success"; break;
+                case OpCode::PROFILE_BEGIN: ss << "profile begin " << m_assetNames[instruction.arg]; break;
+                case OpCode::PROFILE_END: ss << "profile end " << m_assetNames[instruction.arg]; break;
+            }
+            ss << "\"];\n";
+
+            ss << "  i" << pc << " -> i" << pc + 1 << ";\n";
+            if (instruction.code == OpCode::JUMP_IF_SUCCESS || instruction.code == OpCode::JUMP_IF_FAILURE)
+            {
+                ss << "  i" << pc << " -> i" << pc + instruction.arg << " [style=dashed];\n";
+            }
+        }
+        ss << "  i" << m_code.size() << " [label=\"end\"];\n";
+        ss << "}\n";
+
+        return ss.str();
+    }
+};
+
+} // namespace bk::vm::detail
+
+#endif // _BK_VM_PROGRAM_HPP
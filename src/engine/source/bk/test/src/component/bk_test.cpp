@@ -2,6 +2,7 @@
 
 #include <bk/rx/controller.hpp>
 #include <bk/taskf/controller.hpp>
+#include <bk/vm/controller.hpp>
 #include <bk/mockController.hpp> // Force mock compilation
 
 #include "bk_test.hpp"
@@ -85,6 +86,13 @@ TEST_P(PipelineTest, RxProcessTraces)
     GTEST_SKIP(); // TODO
 }
 
+TEST_P(PipelineTest, VmProcessEvent)
+{
+    auto [name, expression, expectedPath] = GetParam();
+    auto testExpression = getTestExpression(expression);
+    buildIngestTest<bk::vm::Controller>(testExpression, expectedPath);
+}
+
 INSTANTIATE_TEST_SUITE_P(
     BK,
     PipelineTest,
@@ -867,6 +875,7 @@ TEST(BKTraceTest, Subscribe)
 {
     subscribeTest<bk::taskf::Controller>();
     subscribeTest<bk::rx::Controller>();
+    subscribeTest<bk::vm::Controller>();
 }
 
 template<typename Controller>
@@ -883,6 +892,7 @@ TEST(BKTraceTest, SubscribeTraceableNotFound)
 {
     subscribeTraceableNotFoundTest<bk::taskf::Controller>();
     subscribeTraceableNotFoundTest<bk::rx::Controller>();
+    subscribeTraceableNotFoundTest<bk::vm::Controller>();
 }
 
 template<typename Controller>
@@ -901,6 +911,7 @@ TEST(BKTraceTest, MultipleSubscribers)
 {
     multipleSubscribersTest<bk::taskf::Controller>();
     multipleSubscribersTest<bk::rx::Controller>();
+    multipleSubscribersTest<bk::vm::Controller>();
 }
 
 template<typename Controller>
@@ -918,6 +929,7 @@ TEST(BKTraceTest, Unsubscribe)
 {
     unsubscribeTest<bk::taskf::Controller>();
     unsubscribeTest<bk::rx::Controller>();
+    unsubscribeTest<bk::vm::Controller>();
 }
 
 template<typename Controller>
@@ -937,4 +949,105 @@ TEST(BKTraceTest, UnsubscribeNotExists)
 {
     unsubscribeNotExistsTest<bk::taskf::Controller>();
     unsubscribeNotExistsTest<bk::rx::Controller>();
+    unsubscribeNotExistsTest<bk::vm::Controller>();
+}
+
+template<typename Controller>
+void resubscribeTest()
+{
+    Controller c(EasyExp::term("term", true), {"term"});
+    Subscriber<Controller> s;
+    s.checkTraceActivation(c, {});
+
+    auto subRes = c.subscribe("term", s.getSubscriber());
+    ASSERT_FALSE(base::isError(subRes)) << "Error subscribing: " << base::getError(subRes).message;
+    s.checkTraceActivation(c, {SUCCES_TRACE});
+
+    ASSERT_NO_THROW(c.unsubscribeAll());
+    s.checkTraceActivation(c, {SUCCES_TRACE});
+
+    subRes = c.subscribe("term", s.getSubscriber());
+    ASSERT_FALSE(base::isError(subRes)) << "Error subscribing: " << base::getError(subRes).message;
+    s.checkTraceActivation(c, {SUCCES_TRACE, SUCCES_TRACE});
+}
+
+TEST(BKTraceTest, Resubscribe)
+{
+    resubscribeTest<bk::taskf::Controller>();
+    resubscribeTest<bk::rx::Controller>();
+    resubscribeTest<bk::vm::Controller>();
+}
+
+template<typename Controller>
+void profileSampledTest()
+{
+    auto profiler = std::make_shared<bk::Profiler>(2);
+    auto expression = base::And::create("asset", {EasyExp::term("t1", true), EasyExp::term("t2", false)});
+    Controller c(expression, {"asset"}, nullptr, profiler);
+    for (auto i = 0; i < 10; ++i)
+    {
+        auto event = std::make_shared<json::Json>();
+        ASSERT_NO_THROW(c.ingest(std::move(event)));
+    }
+
+    auto assets = profiler->assets();
+    ASSERT_EQ(assets.size(), 1);
+    ASSERT_EQ(assets[0].name, "asset");
+    ASSERT_EQ(assets[0].success, 0);
+    ASSERT_EQ(assets[0].failure, 5);
+    ASSERT_GE(assets[0].p99Ns, assets[0].p50Ns);
+
+    auto helpers = profiler->helpers();
+    ASSERT_EQ(helpers.size(), 2);
+    for (const auto& helper : helpers)
+    {
+        ASSERT_EQ(helper.success + helper.failure, 5) << helper.name;
+        ASSERT_EQ(helper.success, helper.name == "t1" ? 5 : 0) << helper.name;
+    }
+}
+
+TEST(BKProfileTest, SampledEvents)
+{
+    profileSampledTest<bk::rx::Controller>();
+    profileSampledTest<bk::vm::Controller>();
+}
+
+template<typename Controller>
+void profileNestedTest()
+{
+    auto profiler = std::make_shared<bk::Profiler>(1);
+    auto child = base::Implication::create("child", EasyExp::term("condition", true), EasyExp::term("t", false));
+    auto parent = base::Or::create("parent", {EasyExp::term("first", false), child});
+    Controller c(parent, {"parent", "child"}, nullptr, profiler);
+    auto event = std::make_shared<json::Json>();
+    ASSERT_NO_THROW(c.ingest(std::move(event)));
+
+    auto assets = profiler->assets();
+    ASSERT_EQ(assets.size(), 2);
+    for (const auto& asset : assets)
+    {
+        // The implication takes the result of the condition
+        ASSERT_EQ(asset.success, 1) << asset.name;
+        ASSERT_EQ(asset.failure, 0) << asset.name;
+    }
+
+    // The parent includes the time of the child
+    const auto& parentStats = assets[0].name == "parent" ? assets[0] : assets[1];
+    const auto& childStats = assets[0].name == "child" ? assets[0] : assets[1];
+    ASSERT_GE(parentStats.maxNs, childStats.maxNs);
+}
+
+TEST(BKProfileTest, NestedAssets)
+{
+    profileNestedTest<bk::rx::Controller>();
+    profileNestedTest<bk::vm::Controller>();
+}
+
+TEST(BKProfileTest, VmNotProfiled)
+{
+    bk::vm::Controller c(EasyExp::term("term", true), {"term"});
+    ASSERT_EQ(c.printGraph().find("profile"), std::string::npos);
+
+    bk::vm::Controller profiled(EasyExp::term("term", true), {"term"}, nullptr, std::make_shared<bk::Profiler>(1));
+    ASSERT_NE(profiled.printGraph().find("profile begin term"), std::string::npos);
 }
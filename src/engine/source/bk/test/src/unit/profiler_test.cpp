@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include <bk/profiler.hpp>
+
+using bk::Profiler;
+
+TEST(ProfilerTest, ZeroSampleRate)
+{
+    ASSERT_THROW(Profiler(0), std::runtime_error);
+    ASSERT_EQ(Profiler(100).sampleRate(), 100);
+}
+
+TEST(ProfilerTest, Buckets)
+{
+    for (uint64_t ns : {0UL, 1UL, 3UL, 4UL, 5UL, 7UL, 8UL, 100UL, 1000UL, 123456UL, 1UL << 30})
+    {
+        const auto bucket = Profiler::Stats::bucket(ns);
+        ASSERT_LE(Profiler::Stats::bucketBound(bucket), ns) << ns;
+        ASSERT_GT(Profiler::Stats::bucketBound(bucket + 1), ns) << ns;
+    }
+
+    // Latencies out of the range go to the last bucket
+    ASSERT_EQ(Profiler::Stats::bucket(UINT64_MAX), Profiler::HISTOGRAM_BUCKETS - 1);
+}
+
+TEST(ProfilerTest, Summary)
+{
+    Profiler profiler(1);
+    auto stats = profiler.asset("asset");
+    for (auto i = 0; i < 98; ++i)
+    {
+        stats->record(1000, true);
+    }
+    stats->record(100000, false);
+    stats->record(100000, false);
+
+    auto assets = profiler.assets();
+    ASSERT_EQ(assets.size(), 1);
+    const auto& summary = assets[0];
+    ASSERT_EQ(summary.name, "asset");
+    ASSERT_EQ(summary.success, 98);
+    ASSERT_EQ(summary.failure, 2);
+    ASSERT_EQ(summary.maxNs, 100000);
+    ASSERT_EQ(summary.meanNs, (98 * 1000 + 2 * 100000) / 100);
+    // Upper bound of the bucket, 25% of error at most
+    ASSERT_GE(summary.p50Ns, 1000);
+    ASSERT_LE(summary.p50Ns, 1250);
+    ASSERT_GE(summary.p99Ns, 80000);
+    ASSERT_LE(summary.p99Ns, 100000);
+}
+
+TEST(ProfilerTest, SameNameSameStats)
+{
+    Profiler profiler(1);
+    ASSERT_EQ(profiler.asset("name"), profiler.asset("name"));
+    ASSERT_NE(profiler.asset("name"), profiler.helper("name"));
+}
+
+TEST(ProfilerTest, HelpersWithoutHistogram)
+{
+    Profiler profiler(1);
+    profiler.helper("slow")->record(5000, true);
+    profiler.helper("fast")->record(10, false);
+
+    auto helpers = profiler.helpers();
+    ASSERT_EQ(helpers.size(), 2);
+    ASSERT_EQ(helpers[0].name, "slow");
+    ASSERT_EQ(helpers[0].meanNs, 5000);
+    ASSERT_EQ(helpers[0].p99Ns, 0);
+    ASSERT_EQ(helpers[1].name, "fast");
+    ASSERT_EQ(helpers[1].failure, 1);
+}
+
+TEST(ProfilerTest, Reset)
+{
+    Profiler profiler(1);
+    profiler.asset("asset")->record(1000, true);
+    profiler.helper("helper")->record(1000, true);
+    profiler.reset();
+
+    auto assets = profiler.assets();
+    ASSERT_EQ(assets.size(), 1);
+    ASSERT_EQ(assets[0].success, 0);
+    ASSERT_EQ(assets[0].maxNs, 0);
+    ASSERT_EQ(assets[0].p99Ns, 0);
+    ASSERT_EQ(profiler.helpers()[0].success, 0);
+}
+
+TEST(ProfilerTest, ConcurrentRecords)
+{
+    Profiler profiler(1);
+    std::vector<std::thread> threads;
+    for (auto t = 0; t < 4; ++t)
+    {
+        threads.emplace_back(
+            [&profiler, t]()
+            {
+                auto stats = profiler.asset("asset");
+                for (auto i = 0; i < 1000; ++i)
+                {
+                    stats->record(100 * (t + 1), i % 2 == 0);
+                }
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    auto summary = profiler.assets()[0];
+    ASSERT_EQ(summary.success + summary.failure, 4000);
+    ASSERT_EQ(summary.maxNs, 400);
+}
@@ -14,6 +14,7 @@
 #include <wdb/iwdbManager.hpp>
 
 #include <builder/ibuilder.hpp>
+#include <builder/indexerConnection.hpp>
 #include <builder/ivalidator.hpp>
 
 namespace builder
@@ -29,6 +30,10 @@ struct BuilderDeps
     std::shared_ptr<sockiface::ISockFactory> sockFactory;
     std::shared_ptr<wazuhdb::IWDBManager> wdbManager;
     std::shared_ptr<geo::IManager> geoManager;
+
+    std::size_t buildThreads = 1; ///< Threads compiling the assets of a policy, 0 uses one per core
+
+    IndexerConnection indexer; ///< Connection of the indexer outputs
 };
 
 class Builder final
@@ -43,6 +48,7 @@ private:
     std::shared_ptr<defs::IDefinitionsBuilder> m_definitionsBuilder; ///< Definitions builder
 
     std::shared_ptr<Registry> m_registry; ///< builders registry
+    std::size_t m_buildThreads {1};       ///< Threads compiling the assets of a policy
 
 public:
     Builder() = default;
@@ -54,6 +60,8 @@ public:
             const BuilderDeps& builderDeps);
 
     std::shared_ptr<IPolicy> buildPolicy(const base::Name& name) const override;
+    std::shared_ptr<IPolicy> buildPolicy(const base::Name& name,
+                                         const std::shared_ptr<AssetCache>& cache) const override;
     base::Expression buildAsset(const base::Name& name) const override;
 
     base::OptError validateIntegration(const json::Json& json, const std::string& namespaceId) const override;
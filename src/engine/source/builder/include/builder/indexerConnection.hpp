@@ -0,0 +1,23 @@
+#ifndef _BUILDER2_INDEXERCONNECTION_HPP
+#define _BUILDER2_INDEXERCONNECTION_HPP
+
+#include <string>
+
+namespace builder
+{
+
+/**
+ * @brief Connection of the indexer outputs, they cannot be built if the url is empty.
+ */
+struct IndexerConnection
+{
+    std::string url;      ///< Base url of the indexer, e.g. https://localhost:9200
+    std::string username; ///< User of the basic authentication, none if empty
+    std::string password; ///< Password of the basic authentication
+    std::string caFile;   ///< CA bundle verifying the certificate of the indexer, the system one if empty
+    std::string queueDir; ///< Directory the bulks not acknowledged yet are kept in, in memory if empty
+};
+
+} // namespace builder
+
+#endif // _BUILDER2_INDEXERCONNECTION_HPP
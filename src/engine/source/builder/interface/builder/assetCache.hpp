@@ -0,0 +1,156 @@
+#ifndef _BUILDER2_ASSETCACHE_HPP
+#define _BUILDER2_ASSETCACHE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include <expression.hpp>
+#include <name.hpp>
+
+namespace builder
+{
+
+/**
+ * @brief Compiled assets kept between the builds of the policies, keyed by the asset name and the hash of its
+ * document, so only the assets whose document changed are compiled again. The last expression built for each policy is
+ * kept too, so a rebuild that keeps the relations of the assets only replaces the changed ones in it.
+ *
+ * The built operations keep their own state and are not thread-safe, so a cache must only be shared by the policies run
+ * by the same thread (i.e. the routes and the test sessions of a worker). Its methods can be called from the threads
+ * building a policy.
+ */
+class AssetCache
+{
+public:
+    /**
+     * @brief A compiled asset
+     */
+    struct Entry
+    {
+        std::size_t hash;                ///< Hash of the document it was compiled from
+        base::Expression expression;     ///< Expression of the asset
+        std::vector<base::Name> parents; ///< Parents declared by the asset, without the default ones
+    };
+
+    /**
+     * @brief The last expression built for a policy
+     */
+    struct PolicyEntry
+    {
+        std::size_t layout;                                      ///< Hash of the assets and their relations
+        std::unordered_map<base::Name, base::Expression> assets; ///< Expression of each asset in the policy expression
+        base::Expression expression;                             ///< Expression of the policy
+    };
+
+    /**
+     * @brief Get the compiled asset, if its document did not change since it was cached.
+     *
+     * @param name Name of the asset.
+     * @param hash Hash of the current document of the asset.
+     * @return std::optional<Entry>
+     */
+    std::optional<Entry> get(const base::Name& name, std::size_t hash) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(name);
+        if (it == m_entries.end() || it->second.hash != hash)
+        {
+            m_misses.fetch_add(1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+        m_hits.fetch_add(1, std::memory_order_relaxed);
+        return it->second;
+    }
+
+    /**
+     * @brief Cache a compiled asset, replacing the one compiled from a previous document.
+     *
+     * @param name Name of the asset.
+     * @param entry The compiled asset.
+     */
+    void put(const base::Name& name, Entry entry)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_entries.insert_or_assign(name, std::move(entry));
+    }
+
+    /**
+     * @brief Get the last expression built for a policy.
+     *
+     * @param name Name of the policy.
+     * @return std::optional<PolicyEntry>
+     */
+    std::optional<PolicyEntry> getPolicy(const base::Name& name) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_policies.find(name);
+        if (it == m_policies.end())
+        {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    /**
+     * @brief Keep the expression built for a policy, replacing the previous one.
+     *
+     * @param name Name of the policy.
+     * @param entry The built policy.
+     */
+    void putPolicy(const base::Name& name, PolicyEntry entry)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_policies.insert_or_assign(name, std::move(entry));
+    }
+
+    /**
+     * @brief Drop all the compiled assets and policies.
+     */
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_entries.clear();
+        m_policies.clear();
+    }
+
+    /**
+     * @brief Get the number of compiled assets.
+     *
+     * @return std::size_t
+     */
+    std::size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_entries.size();
+    }
+
+    /**
+     * @brief Get the number of lookups that found the compiled asset.
+     *
+     * @return uint64_t
+     */
+    uint64_t hits() const { return m_hits.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Get the number of lookups that had to compile the asset.
+     *
+     * @return uint64_t
+     */
+    uint64_t misses() const { return m_misses.load(std::memory_order_relaxed); }
+
+private:
+    mutable std::mutex m_mutex;                             ///< Protects the entries
+    std::unordered_map<base::Name, Entry> m_entries;        ///< Compiled assets by name
+    std::unordered_map<base::Name, PolicyEntry> m_policies; ///< Last expression of each policy by name
+    mutable std::atomic<uint64_t> m_hits {0};               ///< Lookups that found the compiled asset
+    mutable std::atomic<uint64_t> m_misses {0};             ///< Lookups that had to compile the asset
+};
+
+} // namespace builder
+
+#endif // _BUILDER2_ASSETCACHE_HPP
@@ -3,6 +3,7 @@
 
 #include <memory>
 
+#include <builder/assetCache.hpp>
 #include <builder/ipolicy.hpp>
 #include <error.hpp>
 #include <expression.hpp>
@@ -28,6 +29,18 @@ public:
      */
     virtual std::shared_ptr<IPolicy> buildPolicy(const base::Name& name) const = 0;
 
+    /**
+     * @brief Build a policy from the store, reusing the assets compiled by previous builds.
+     *
+     * @param name Name of the policy.
+     * @param cache Compiled assets, updated with the assets compiled by this build. Null compiles all the assets.
+     * @return std::shared_ptr<IPolicy> The policy.
+     */
+    virtual std::shared_ptr<IPolicy> buildPolicy(const base::Name& name, const std::shared_ptr<AssetCache>& cache) const
+    {
+        return buildPolicy(name);
+    }
+
     /**
      * @brief Build an asset expression from the store.
      * @attention This method ignores the parents of the asset.
@@ -1,6 +1,8 @@
 #include "builder.hpp"
 
+#include <algorithm>
 #include <stdexcept>
+#include <thread>
 
 #include <store/utils.hpp>
 
@@ -25,6 +27,8 @@ Builder::Builder(const std::shared_ptr<store::IStore>& storeRead,
     : m_storeRead {storeRead}
     , m_schema {schema}
     , m_definitionsBuilder {definitionsBuilder}
+    , m_buildThreads {builderDeps.buildThreads > 0 ? builderDeps.buildThreads
+                                                   : std::max(1u, std::thread::hardware_concurrency())}
 {
     if (!m_storeRead)
     {
@@ -49,6 +53,11 @@ Builder::Builder(const std::shared_ptr<store::IStore>& storeRead,
 }
 
 std::shared_ptr<IPolicy> Builder::buildPolicy(const base::Name& name) const
+{
+    return buildPolicy(name, nullptr);
+}
+
+std::shared_ptr<IPolicy> Builder::buildPolicy(const base::Name& name, const std::shared_ptr<AssetCache>& cache) const
 {
     auto policyDoc = m_storeRead->readInternalDoc(name);
     if (base::isError(policyDoc))
@@ -56,8 +65,13 @@ std::shared_ptr<IPolicy> Builder::buildPolicy(const base::Name& name) const
         throw std::runtime_error(base::getError(policyDoc).message);
     }
 
-    auto policy = std::make_shared<policy::Policy>(
-        base::getResponse<store::Doc>(policyDoc), m_storeRead, m_definitionsBuilder, m_registry, m_schema);
+    auto policy = std::make_shared<policy::Policy>(base::getResponse<store::Doc>(policyDoc),
+                                                   m_storeRead,
+                                                   m_definitionsBuilder,
+                                                   m_registry,
+                                                   m_schema,
+                                                   cache,
+                                                   m_buildThreads);
 
     return policy;
 }
@@ -172,7 +186,7 @@ base::OptError Builder::validatePolicy(const json::Json& json) const
     try
     {
         auto policy = std::make_shared<policy::Policy>(
-            json, m_storeRead, m_definitionsBuilder, m_registry, m_schema);
+            json, m_storeRead, m_definitionsBuilder, m_registry, m_schema, nullptr, m_buildThreads);
     }
     catch (const std::exception& e)
     {
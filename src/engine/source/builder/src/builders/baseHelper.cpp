@@ -155,7 +155,7 @@ TransformBuilder mapToTransform(const MapBuilder& builder, const Reference& targ
                 return base::result::makeFailure<base::Event>(event, mapRes.popTrace());
             }
 
-            event->set(targetField.jsonPath(), mapRes.popPayload());
+            event->set(targetField.pointerPath(), mapRes.popPayload());
 
             return base::result::makeSuccess(event, mapRes.popTrace());
         };
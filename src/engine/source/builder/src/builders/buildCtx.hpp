@@ -4,6 +4,8 @@
 #include <string>
 
 #include "ibuildCtx.hpp"
+#include "mmdbGroup.hpp"
+#include "regexSet.hpp"
 
 namespace builder::builders
 {
@@ -22,6 +24,12 @@ private:
 
     std::shared_ptr<const schemf::ISchema> m_schema; // Schema
 
+    std::shared_ptr<RegexSets> m_regexSets; // Regex sets, shared by the assets of the build
+
+    std::shared_ptr<MMDBGroups> m_mmdbGroups; // MMDB lookups, shared by the assets of the build
+
+    std::shared_ptr<OutputBuffer> m_outputBuffer; // Event serialized by the outputs stage being built, if any
+
 public:
     BuildCtx()
     {
@@ -30,6 +38,8 @@ public:
         m_registry = nullptr;
         m_definitions = nullptr;
         m_schemaValidator = nullptr;
+        m_regexSets = std::make_shared<RegexSets>();
+        m_mmdbGroups = std::make_shared<MMDBGroups>();
     }
 
     ~BuildCtx() = default;
@@ -44,6 +54,8 @@ public:
         , m_registry(registry)
         , m_definitions(definitions)
         , m_schemaValidator(schemaValidator)
+        , m_regexSets(std::make_shared<RegexSets>())
+        , m_mmdbGroups(std::make_shared<MMDBGroups>())
     {
     }
 
@@ -72,6 +84,16 @@ public:
 
     inline std::shared_ptr<const RunState> runState() const override { return m_runState; }
     inline RunState& runState() { return *m_runState; }
+
+    inline std::shared_ptr<RegexSets> regexSets() const override { return m_regexSets; }
+
+    inline std::shared_ptr<MMDBGroups> mmdbGroups() const override { return m_mmdbGroups; }
+
+    inline std::shared_ptr<OutputBuffer> outputBuffer() const override { return m_outputBuffer; }
+    inline void setOutputBuffer(const std::shared_ptr<OutputBuffer>& outputBuffer) override
+    {
+        m_outputBuffer = outputBuffer;
+    }
 };
 
 } // namespace builder::builders
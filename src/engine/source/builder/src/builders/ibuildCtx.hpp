@@ -13,6 +13,10 @@
 namespace builder::builders
 {
 
+class RegexSets;
+class MMDBGroups;
+class OutputBuffer;
+
 /**
  * @brief Control flags for the runtime
  *
@@ -56,6 +60,13 @@ public:
     virtual Context& context() = 0;
 
     virtual std::shared_ptr<const RunState> runState() const = 0;
+
+    virtual std::shared_ptr<RegexSets> regexSets() const = 0;
+
+    virtual std::shared_ptr<MMDBGroups> mmdbGroups() const = 0;
+
+    virtual std::shared_ptr<OutputBuffer> outputBuffer() const = 0;
+    virtual void setOutputBuffer(const std::shared_ptr<OutputBuffer>& outputBuffer) = 0;
 };
 
 } // namespace builder::builders
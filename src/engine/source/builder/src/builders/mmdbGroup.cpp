@@ -0,0 +1,77 @@
+#include "mmdbGroup.hpp"
+
+namespace builder::builders
+{
+
+MMDBGroup::MMDBGroup(std::shared_ptr<geo::ILocator> locator)
+    : m_locator(std::move(locator))
+    , m_fields(std::make_shared<geo::Fields>())
+    , m_indexes()
+    , m_mutex()
+    , m_closed(false)
+{
+}
+
+std::optional<std::vector<std::size_t>> MMDBGroup::add(const FieldList& fields)
+{
+    std::lock_guard lock {m_mutex};
+    if (m_closed.load())
+    {
+        return std::nullopt;
+    }
+
+    std::vector<std::size_t> indexes;
+    indexes.reserve(fields.size());
+    for (const auto& [path, type] : fields)
+    {
+        const auto [it, added] = m_indexes.try_emplace({path.str(), static_cast<int>(type)}, m_fields->size());
+        if (added)
+        {
+            m_fields->add(path, type);
+        }
+        indexes.push_back(it->second);
+    }
+
+    return indexes;
+}
+
+base::RespOrError<std::shared_ptr<const geo::Fields::Values>> MMDBGroup::getFields(const std::string& ip)
+{
+    if (!m_closed.load(std::memory_order_acquire))
+    {
+        // The fields must not change once the locator caches values for them
+        std::lock_guard lock {m_mutex};
+        m_closed.store(true, std::memory_order_release);
+    }
+
+    return m_locator->getFields(ip, m_fields);
+}
+
+base::RespOrError<std::pair<std::shared_ptr<MMDBGroup>, std::vector<std::size_t>>>
+MMDBGroups::add(const std::shared_ptr<geo::IManager>& geoManager,
+                geo::Type type,
+                const std::string& ipField,
+                const MMDBGroup::FieldList& fields)
+{
+    std::lock_guard lock {m_mutex};
+    auto& group = m_open[{type, ipField}];
+    if (group)
+    {
+        if (auto indexes = group->add(fields); indexes)
+        {
+            return std::make_pair(group, std::move(indexes.value()));
+        }
+    }
+
+    // The group is closed, start a new one
+    auto resLocator = geoManager->getLocator(type);
+    if (base::isError(resLocator))
+    {
+        return base::getError(resLocator);
+    }
+
+    group = std::make_shared<MMDBGroup>(base::getResponse(resLocator));
+    return std::make_pair(group, group->add(fields).value());
+}
+
+} // namespace builder::builders
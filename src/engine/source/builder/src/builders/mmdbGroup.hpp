@@ -0,0 +1,101 @@
+#ifndef _BUILDER_BUILDERS_MMDBGROUP_HPP
+#define _BUILDER_BUILDERS_MMDBGROUP_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <geo/imanager.hpp>
+
+namespace builder::builders
+{
+
+/**
+ * @brief The MMDB helpers that look up the same IP field in the same database.
+ *
+ * The helpers add their fields while the policy is built, and share the locator and the compiled fields, so the IP is
+ * looked up and its record decoded once for all of them: the siblings get the values cached by the locator. The group
+ * is closed on the first lookup, after that no more fields are accepted.
+ */
+class MMDBGroup
+{
+private:
+    std::shared_ptr<geo::ILocator> m_locator;                     ///< Locator shared by the helpers
+    std::shared_ptr<geo::Fields> m_fields;                        ///< Fields of all the helpers
+    std::map<std::pair<std::string, int>, std::size_t> m_indexes; ///< Index of each field, by path and type
+    std::mutex m_mutex;                                           ///< Protects the fields while the policy is built
+    std::atomic<bool> m_closed;                                   ///< The fields are being looked up
+
+public:
+    using FieldList = std::vector<std::pair<DotPath, geo::Fields::Type>>; ///< Fields of a helper
+
+    explicit MMDBGroup(std::shared_ptr<geo::ILocator> locator);
+
+    MMDBGroup(const MMDBGroup&) = delete;
+    MMDBGroup& operator=(const MMDBGroup&) = delete;
+
+    /**
+     * @brief Add the fields of a helper to the group, the fields already added by a sibling are shared.
+     *
+     * @param fields The fields of the helper.
+     * @return std::optional<std::vector<std::size_t>> The index of each field in the values, empty if the group is
+     * already closed.
+     */
+    std::optional<std::vector<std::size_t>> add(const FieldList& fields);
+
+    /**
+     * @brief Get the values of all the fields of the group for an IP, closing the group.
+     *
+     * @param ip The IP to look up.
+     * @return base::RespOrError<std::shared_ptr<const geo::Fields::Values>> The values or an error if the IP could not
+     * be looked up.
+     */
+    base::RespOrError<std::shared_ptr<const geo::Fields::Values>> getFields(const std::string& ip);
+
+    /**
+     * @brief Get the number of fields of the group.
+     *
+     * @return std::size_t
+     */
+    std::size_t size() const { return m_fields->size(); }
+};
+
+/**
+ * @brief The MMDB groups of a policy build, one open group per database and IP field.
+ *
+ * It is shared by the build contexts of all the assets of the policy.
+ */
+class MMDBGroups
+{
+private:
+    std::mutex m_mutex;                                                             ///< Protects the open groups
+    std::map<std::pair<geo::Type, std::string>, std::shared_ptr<MMDBGroup>> m_open; ///< Group of each db and field
+
+public:
+    /**
+     * @brief Add the fields of a helper to the open group of the database and IP field, starting a new group if it
+     * does not accept more fields.
+     *
+     * @param geoManager The geo manager, provides the locator of a new group.
+     * @param type The database looked up.
+     * @param ipField The field with the IP.
+     * @param fields The fields of the helper.
+     * @return base::RespOrError<std::pair<std::shared_ptr<MMDBGroup>, std::vector<std::size_t>>> The group and the
+     * index of each field in its values, or an error if the database has no locator.
+     */
+    base::RespOrError<std::pair<std::shared_ptr<MMDBGroup>, std::vector<std::size_t>>>
+    add(const std::shared_ptr<geo::IManager>& geoManager,
+        geo::Type type,
+        const std::string& ipField,
+        const MMDBGroup::FieldList& fields);
+};
+
+} // namespace builder::builders
+
+#endif // _BUILDER_BUILDERS_MMDBGROUP_HPP
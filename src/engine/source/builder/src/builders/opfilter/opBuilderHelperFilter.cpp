@@ -2,12 +2,18 @@
 
 #include <algorithm>
 #include <optional>
+#include <unordered_map>
+#include <tuple>
+#include <type_traits>
 #include <variant>
 
 #include <re2/re2.h>
 
 #include "baseTypes.hpp"
+#include "builders/regexSet.hpp"
 #include "syntax.hpp"
+#include <utils/ahoCorasick.hpp>
+#include <utils/cidrSet.hpp>
 #include <utils/ipUtils.hpp>
 
 namespace builder::builders::opfilter
@@ -43,6 +49,203 @@ enum class Type
     INT
 };
 
+/**
+ * @brief Type of the operands of the comparison helpers.
+ */
+template<Type T>
+using Operand = std::conditional_t<T == Type::INT, int64_t, std::string>;
+
+/**
+ * @brief Tag to select the operator of a comparison at compile time.
+ */
+template<Operator Op>
+using OperatorTag = std::integral_constant<Operator, Op>;
+
+/**
+ * @brief Tracing messages of the comparison helpers.
+ */
+struct CmpTraces
+{
+    std::string success;        ///< The comparison is true
+    std::string targetNotFound; ///< The target field is missing or has another type
+    std::string refNotFound;    ///< The reference is missing or has another type
+    std::string falseCmp;       ///< The comparison is false
+};
+
+CmpTraces cmpTraces(const std::string& name, const json::PointerPath& targetField)
+{
+    return {fmt::format("[{}] -> Success", name),
+            fmt::format("[{}] -> Failure: Target field '{}' not found", name, targetField.str()),
+            fmt::format("[{}] -> Failure: Reference not found", name),
+            fmt::format("[{}] -> Failure: Comparison is false", name)};
+}
+
+/**
+ * @brief Get an operand of the comparison from the event.
+ *
+ * @return std::optional<Operand<T>> empty if the field is missing or has another type.
+ */
+template<Type T>
+inline std::optional<Operand<T>> getOperand(const base::ConstEvent& event, const json::PointerPath& path)
+{
+    if constexpr (T == Type::INT)
+    {
+        return event->getIntAsInt64(path);
+    }
+    else
+    {
+        return event->getString(path);
+    }
+}
+
+/**
+ * @brief Apply the operator, resolved at compile time.
+ */
+template<Operator Op, typename V>
+inline bool compare(const V& l, const V& r)
+{
+    if constexpr (Op == Operator::EQ)
+    {
+        return l == r;
+    }
+    else if constexpr (Op == Operator::NE)
+    {
+        return l != r;
+    }
+    else if constexpr (Op == Operator::GT)
+    {
+        return l > r;
+    }
+    else if constexpr (Op == Operator::GE)
+    {
+        return l >= r;
+    }
+    else if constexpr (Op == Operator::LT)
+    {
+        return l < r;
+    }
+    else if constexpr (Op == Operator::LE)
+    {
+        return l <= r;
+    }
+    else if constexpr (Op == Operator::ST)
+    {
+        return l.compare(0, r.size(), r) == 0;
+    }
+    else
+    {
+        static_assert(Op == Operator::CN, "Unsupported comparison operator");
+        return !r.empty() && l.find(r) != std::string::npos;
+    }
+}
+
+/**
+ * @brief Build the comparison of a field against a value, fixed when the helper is built.
+ */
+template<Operator Op, Type T>
+FilterOp makeValueCmp(const json::PointerPath& targetField,
+                      Operand<T> rValue,
+                      CmpTraces traces,
+                      std::shared_ptr<const RunState> runState)
+{
+    return [targetField, rValue = std::move(rValue), traces = std::move(traces), runState = std::move(runState)](
+               base::ConstEvent event) -> FilterResult
+    {
+        const auto lValue = getOperand<T>(event, targetField);
+        if (!lValue.has_value())
+        {
+            RETURN_FAILURE(runState, false, traces.targetNotFound);
+        }
+
+        if (compare<Op>(lValue.value(), rValue))
+        {
+            RETURN_SUCCESS(runState, true, traces.success);
+        }
+        RETURN_FAILURE(runState, false, traces.falseCmp);
+    };
+}
+
+/**
+ * @brief Build the comparison of a field against a reference, resolved on each event.
+ */
+template<Operator Op, Type T>
+FilterOp makeRefCmp(const json::PointerPath& targetField,
+                    const json::PointerPath& rRef,
+                    CmpTraces traces,
+                    std::shared_ptr<const RunState> runState)
+{
+    return [targetField, rRef, traces = std::move(traces), runState = std::move(runState)](
+               base::ConstEvent event) -> FilterResult
+    {
+        const auto lValue = getOperand<T>(event, targetField);
+        if (!lValue.has_value())
+        {
+            RETURN_FAILURE(runState, false, traces.targetNotFound);
+        }
+
+        const auto rValue = getOperand<T>(event, rRef);
+        if (!rValue.has_value())
+        {
+            RETURN_FAILURE(runState, false, traces.refNotFound);
+        }
+
+        if (compare<Op>(lValue.value(), rValue.value()))
+        {
+            RETURN_SUCCESS(runState, true, traces.success);
+        }
+        RETURN_FAILURE(runState, false, traces.falseCmp);
+    };
+}
+
+/**
+ * @brief Build the closure specialized on the operator, the type and whether the right operand is a reference, so
+ * the filter does not branch on them for each event.
+ *
+ * @throws std::runtime_error if the operator is not supported by the type.
+ */
+template<Type T>
+FilterOp buildCmp(const json::PointerPath& targetField,
+                  Operator op,
+                  const std::variant<json::PointerPath, Operand<T>>& rValue,
+                  const std::shared_ptr<const IBuildCtx>& buildCtx)
+{
+    auto build = [&](auto tag) -> FilterOp
+    {
+        constexpr auto Op = decltype(tag)::value;
+        if constexpr (T == Type::INT && (Op == Operator::ST || Op == Operator::CN))
+        {
+            throw std::runtime_error(
+                fmt::format("Comparison helper: Operator '{}' not supported for integers", static_cast<int>(Op)));
+        }
+        else
+        {
+            auto traces = cmpTraces(buildCtx->context().opName, targetField);
+            if (std::holds_alternative<json::PointerPath>(rValue))
+            {
+                return makeRefCmp<Op, T>(
+                    targetField, std::get<json::PointerPath>(rValue), std::move(traces), buildCtx->runState());
+            }
+            return makeValueCmp<Op, T>(
+                targetField, std::get<Operand<T>>(rValue), std::move(traces), buildCtx->runState());
+        }
+    };
+
+    switch (op)
+    {
+        case Operator::EQ: return build(OperatorTag<Operator::EQ> {});
+        case Operator::NE: return build(OperatorTag<Operator::NE> {});
+        case Operator::GT: return build(OperatorTag<Operator::GT> {});
+        case Operator::GE: return build(OperatorTag<Operator::GE> {});
+        case Operator::LT: return build(OperatorTag<Operator::LT> {});
+        case Operator::LE: return build(OperatorTag<Operator::LE> {});
+        case Operator::ST: return build(OperatorTag<Operator::ST> {});
+        case Operator::CN: return build(OperatorTag<Operator::CN> {});
+        default:
+            throw std::runtime_error(
+                fmt::format("Comparison helper: Operator '{}' not supported", static_cast<int>(op)));
+    }
+}
+
 /**
  * @brief Get the Int Cmp Function object
  *
@@ -55,13 +258,13 @@ enum class Type
  *   - if the right parameter is a value and not a valid integer
  *   - if helper::base::Parameter::Type is not supported
  */
-FilterOp getIntCmpFunction(const std::string& targetField,
+FilterOp getIntCmpFunction(const json::PointerPath& targetField,
                            Operator op,
                            const OpArg& rightParameter,
                            const std::shared_ptr<const IBuildCtx>& buildCtx)
 {
     // Depending on rValue type we store the reference or the integer value
-    std::variant<std::string, int64_t> rValue {};
+    std::variant<json::PointerPath, int64_t> rValue {};
 
     if (rightParameter->isValue())
     {
@@ -87,97 +290,10 @@ FilterOp getIntCmpFunction(const std::string& targetField,
                             ref->dotPath(),
                             schemf::typeToStr(buildCtx->validator().getType(ref->dotPath()))));
         }
-        rValue = std::static_pointer_cast<Reference>(rightParameter)->jsonPath();
-    }
-
-    // Depending on the operator we return the correct function
-    std::function<bool(int64_t l, int64_t r)> cmpFunction;
-    switch (op)
-    {
-        case Operator::EQ:
-            cmpFunction = [](int64_t l, int64_t r)
-            {
-                return l == r;
-            };
-            break;
-        case Operator::NE:
-            cmpFunction = [](int64_t l, int64_t r)
-            {
-                return l != r;
-            };
-            break;
-        case Operator::GT:
-            cmpFunction = [](int64_t l, int64_t r)
-            {
-                return l > r;
-            };
-            break;
-        case Operator::GE:
-            cmpFunction = [](int64_t l, int64_t r)
-            {
-                return l >= r;
-            };
-            break;
-        case Operator::LT:
-            cmpFunction = [](int64_t l, int64_t r)
-            {
-                return l < r;
-            };
-            break;
-        case Operator::LE:
-            cmpFunction = [](int64_t l, int64_t r)
-            {
-                return l <= r;
-            };
-            break;
-        default: break;
+        rValue = std::static_pointer_cast<Reference>(rightParameter)->pointerPath();
     }
 
-    // Tracing messages
-    const auto name = buildCtx->context().opName;
-    const auto successTrace {fmt::format("[{}] -> Success", name)};
-
-    const std::string failureTrace1 {fmt::format("[{}] -> Failure: Target field '{}' not found", name, targetField)};
-    const std::string failureTrace2 {fmt::format("[{}] -> Failure: Reference not found", name)};
-    const std::string failureTrace3 {fmt::format("[{}] -> Failure: Comparison is false", name)};
-
-    // Function that implements the helper
-    return [=, runState = buildCtx->runState()](base::ConstEvent event) -> FilterResult
-    {
-        // We assert that references exists, checking if the optional from Json getter is
-        // empty ot not. Then if is a reference we get the value from the event, otherwise
-        // we get the value from the parameter
-
-        auto lValue = event->getIntAsInt64(targetField);
-        if (!lValue.has_value())
-        {
-            RETURN_FAILURE(runState, false, failureTrace1);
-        }
-
-        int64_t resolvedValue {0};
-        if (std::holds_alternative<std::string>(rValue))
-        {
-            auto resolvedRValue = event->getIntAsInt64(std::get<std::string>(rValue));
-            if (!resolvedRValue.has_value())
-            {
-                RETURN_FAILURE(runState, false, failureTrace2);
-            }
-            resolvedValue = resolvedRValue.value();
-        }
-        else
-        {
-            resolvedValue = std::get<int64_t>(rValue);
-        }
-
-        if (cmpFunction(lValue.value(), resolvedValue))
-        {
-            RETURN_SUCCESS(runState, true, successTrace);
-        }
-        else
-        {
-            RETURN_FAILURE(runState, false, failureTrace3);
-        }
-    };
+    return buildCmp<Type::INT>(targetField, op, rValue, buildCtx);
 }
 
 /**
@@ -191,70 +307,13 @@ FilterOp getIntCmpFunction(const std::string& targetField,
  *
  * @throws std::runtime_error if helper::base::Parameter::Type is not supported
  */
-FilterOp getStringCmpFunction(const std::string& targetField,
+FilterOp getStringCmpFunction(const json::PointerPath& targetField,
                               Operator op,
                               const OpArg& rightParameter,
                               const std::shared_ptr<const IBuildCtx>& buildCtx)
 {
-    // Depending on the operator we return the correct function
-    std::function<bool(const std::string& l, const std::string& r)> cmpFunction;
-    switch (op)
-    {
-        case Operator::EQ:
-            cmpFunction = [](const std::string& l, const std::string& r)
-            {
-                return l == r;
-            };
-            break;
-        case Operator::NE:
-            cmpFunction = [](const std::string& l, const std::string& r)
-            {
-                return l != r;
-            };
-            break;
-        case Operator::GT:
-            cmpFunction = [](const std::string& l, const std::string& r)
-            {
-                return l > r;
-            };
-            break;
-        case Operator::GE:
-            cmpFunction = [](const std::string& l, const std::string& r)
-            {
-                return l >= r;
-            };
-            break;
-        case Operator::LT:
-            cmpFunction = [](const std::string& l, const std::string& r)
-            {
-                return l < r;
-            };
-            break;
-        case Operator::LE:
-            cmpFunction = [](const std::string& l, const std::string& r)
-            {
-                return l <= r;
-            };
-            break;
-        case Operator::ST:
-            cmpFunction = [](const std::string& l, const std::string& r)
-            {
-                return l.substr(0, r.length()) == r;
-            };
-            break;
-        case Operator::CN:
-            cmpFunction = [](const std::string& l, const std::string& r)
-            {
-                if (!r.empty())
-                {
-                    return l.find(r) != std::string::npos;
-                }
-                return false;
-            };
-            break;
-
-        default: break;
-    }
+    // Depending on rValue type we store the reference or the string value
+    std::variant<json::PointerPath, std::string> rValue {};
 
     if (rightParameter->isValue())
     {
@@ -263,6 +322,7 @@ FilterOp getStringCmpFunction(const std::string& targetField,
             throw std::runtime_error(fmt::format(R"(Expected a string but got '{}'.)",
                                                  std::static_pointer_cast<Value>(rightParameter)->value().str()));
         }
+        rValue = std::static_pointer_cast<Value>(rightParameter)->value().getString().value();
     }
     else
     {
@@ -279,55 +339,10 @@ FilterOp getStringCmpFunction(const std::string& targetField,
                                 json::Json::typeToStr(jType)));
             }
         }
+        rValue = ref->pointerPath();
     }
 
-    // Tracing messages
-    const auto name = buildCtx->context().opName;
-    const auto successTrace {fmt::format("[{}] -> Success", name)};
-
-    const std::string failureTrace1 {fmt::format("[{}] -> Failure: Target field '{}' not found", name, targetField)};
-    const std::string failureTrace2 {fmt::format("[{}] -> Failure: Reference not found", name)};
-    const std::string failureTrace3 {fmt::format("[{}] -> Failure: Comparison is false", name)};
-
-    // Function that implements the helper
-    return [=, runState = buildCtx->runState()](base::ConstEvent event) -> FilterResult
-    {
-        // We assert that references exists, checking if the optional from Json getter is
-        // empty ot not. Then if is a reference we get the value from the event, otherwise
-        // we get the value from the parameter
-
-        const auto lValue {event->getString(targetField)};
-        if (!lValue.has_value())
-        {
-            RETURN_FAILURE(runState, false, failureTrace1);
-        }
-
-        std::string rValue {};
-        if (rightParameter->isValue())
-        {
-            rValue = std::static_pointer_cast<Value>(rightParameter)->value().getString().value();
-        }
-        else
-        {
-            const auto resolvedRValue {
-                event->getString(std::static_pointer_cast<Reference>(rightParameter)->jsonPath())};
-            if (!resolvedRValue.has_value())
-            {
-                RETURN_FAILURE(runState, false, failureTrace2);
-            }
-
-            rValue = resolvedRValue.value();
-        }
-
-        if (cmpFunction(lValue.value(), rValue))
-        {
-            RETURN_SUCCESS(runState, true, successTrace);
-        }
-        else
-        {
-            RETURN_FAILURE(runState, false, failureTrace3);
-        }
-    };
+    return buildCmp<Type::STRING>(targetField, op, rValue, buildCtx);
 }
 
 /**
@@ -338,7 +353,7 @@ FilterOp getStringCmpFunction(const std::string& targetField,
  * @param type Type of the comparison
  * @return base::Expression
  */
-FilterOp opBuilderComparison(const std::string& targetField,
+FilterOp opBuilderComparison(const json::PointerPath& targetField,
                              const std::vector<OpArg>& parameters,
                              Operator op,
                              Type t,
@@ -374,7 +389,7 @@ FilterOp opBuilderHelperIntEqual(const Reference& targetField,
                                  const std::vector<OpArg>& opArgs,
                                  const std::shared_ptr<const IBuildCtx>& buildCtx)
 {
-    auto op = opBuilderComparison(targetField.jsonPath(), opArgs, Operator::EQ, Type::INT, buildCtx);
+    auto op = opBuilderComparison(targetField.pointerPath(), opArgs, Operator::EQ, Type::INT, buildCtx);
     return op;
 }
 
@@ -383,7 +398,7 @@ FilterOp opBuilderHelperIntNotEqual(const Reference& targetField,
                                     const std::vector<OpArg>& opArgs,
                                     const std::shared_ptr<const IBuildCtx>& buildCtx)
 {
-    auto op = opBuilderComparison(targetField.jsonPath(), opArgs, Operator::NE, Type::INT, buildCtx);
+    auto op = opBuilderComparison(targetField.pointerPath(), opArgs, Operator::NE, Type::INT, buildCtx);
     return op;
 }
 
@@ -392,7 +407,7 @@ FilterOp opBuilderHelperIntLessThan(const Reference& targetField,
                                     const std::vector<OpArg>& opArgs,
                                     const std::shared_ptr<const IBuildCtx>& buildCtx)
 {
-    auto op = opBuilderComparison(targetField.jsonPath(), opArgs, Operator::LT, Type::INT, buildCtx);
+    auto op = opBuilderComparison(targetField.pointerPath(), opArgs, Operator::LT, Type::INT, buildCtx);
     return op;
 }
 
@@ -401,7 +416,7 @@ FilterOp opBuilderHelperIntLessThanEqual(const Reference& targetField,
                                          const std::vector<OpArg>& opArgs,
                                          const std::shared_ptr<const IBuildCtx>& buildCtx)
 {
-    auto op = opBuilderComparison(targetField.jsonPath(), opArgs, Operator::LE, Type::INT, buildCtx);
+    auto op = opBuilderComparison(targetField.pointerPath(), opArgs, Operator::LE, Type::INT, buildCtx);
     return op;
 }
 
@@ -410,7 +425,7 @@ FilterOp opBuilderHelperIntGreaterThan(const Reference& targetField,
                                        const std::vector<OpArg>& opArgs,
                                        const std::shared_ptr<const IBuildCtx>& buildCtx)
 {
-    auto op = opBuilderComparison(targetField.jsonPath(), opArgs, Operator::GT, Type::INT, buildCtx);
+    auto op = opBuilderComparison(targetField.pointerPath(), opArgs, Operator::GT, Type::INT, buildCtx);
     return op;
 }
 
@@ -419,7 +434,7 @@ FilterOp opBuilderHelperIntGreaterThanEqual(const Reference& targetField,
                                             const std::vector<OpArg>& opArgs,
                                             const std::shared_ptr<const IBuildCtx>& buildCtx)
 {
-    auto op = opBuilderComparison(targetField.jsonPath(), opArgs, Operator::GE, Type::INT, buildCtx);
+    auto op = opBuilderComparison(targetField.pointerPath(), opArgs, Operator::GE, Type::INT, buildCtx);
     return op;
 }
 
@@ -432,7 +447,7 @@ FilterOp opBuilderHelperStringEqual(const Reference& targetField,
                                     const std::vector<OpArg>& opArgs,
                                     const std::shared_ptr<const IBuildCtx>& buildCtx)
 {
-    auto op = opBuilderComparison(targetField.jsonPath(), opArgs, Operator::EQ, Type::STRING, buildCtx);
+    auto op = opBuilderComparison(targetField.pointerPath(), opArgs, Operator::EQ, Type::STRING, buildCtx);
     return op;
 }
 
@@ -441,7 +456,7 @@ FilterOp opBuilderHelperStringNotEqual(const Reference& targetField,
                                        const std::vector<OpArg>& opArgs,
                                        const std::shared_ptr<const IBuildCtx>& buildCtx)
 {
-    auto op = opBuilderComparison(targetField.jsonPath(), opArgs, Operator::NE, Type::STRING, buildCtx);
+    auto op = opBuilderComparison(targetField.pointerPath(), opArgs, Operator::NE, Type::STRING, buildCtx);
     return op;
 }
 
@@ -450,7 +465,7 @@ FilterOp opBuilderHelperStringGreaterThan(const Reference& targetField,
                                           const std::vector<OpArg>& opArgs,
                                           const std::shared_ptr<const IBuildCtx>& buildCtx)
 {
-    auto op = opBuilderComparison(targetField.jsonPath(), opArgs, Operator::GT, Type::STRING, buildCtx);
+    auto op = opBuilderComparison(targetField.pointerPath(), opArgs, Operator::GT, Type::STRING, buildCtx);
     return op;
 }
 
@@ -459,7 +474,7 @@ FilterOp opBuilderHelperStringGreaterThanEqual(const Reference& targetField,
                                                const std::vector<OpArg>& opArgs,
                                                const std::shared_ptr<const IBuildCtx>& buildCtx)
 {
-    auto op = opBuilderComparison(targetField.jsonPath(), opArgs, Operator::GE, Type::STRING, buildCtx);
+    auto op = opBuilderComparison(targetField.pointerPath(), opArgs, Operator::GE, Type::STRING, buildCtx);
     return op;
 }
 
@@ -468,7 +483,7 @@ FilterOp opBuilderHelperStringLessThan(const Reference& targetField,
                                        const std::vector<OpArg>& opArgs,
                                        const std::shared_ptr<const IBuildCtx>& buildCtx)
 {
-    auto op = opBuilderComparison(targetField.jsonPath(), opArgs, Operator::LT, Type::STRING, buildCtx);
+    auto op = opBuilderComparison(targetField.pointerPath(), opArgs, Operator::LT, Type::STRING, buildCtx);
     return op;
 }
 
@@ -477,7 +492,7 @@ FilterOp opBuilderHelperStringLessThanEqual(const Reference& targetField,
                                             const std::vector<OpArg>& opArgs,
                                             const std::shared_ptr<const IBuildCtx>& buildCtx)
 {
-    auto op = opBuilderComparison(targetField.jsonPath(), opArgs, Operator::LE, Type::STRING, buildCtx);
+    auto op = opBuilderComparison(targetField.pointerPath(), opArgs, Operator::LE, Type::STRING, buildCtx);
     return op;
 }
 
@@ -486,7 +501,7 @@ FilterOp opBuilderHelperStringStarts(const Reference& targetField,
                                      const std::vector<OpArg>& opArgs,
                                      const std::shared_ptr<const IBuildCtx>& buildCtx)
 {
-    auto op = opBuilderComparison(targetField.jsonPath(), opArgs, Operator::ST, Type::STRING, buildCtx);
+    auto op = opBuilderComparison(targetField.pointerPath(), opArgs, Operator::ST, Type::STRING, buildCtx);
     return op;
 }
 
@@ -495,10 +510,121 @@ FilterOp opBuilderHelperStringContains(const Reference& targetField,
                                        const std::vector<OpArg>& opArgs,
                                        const std::shared_ptr<const IBuildCtx>& buildCtx)
 {
-    auto op = opBuilderComparison(targetField.jsonPath(), opArgs, Operator::CN, Type::STRING, buildCtx);
+    auto op = opBuilderComparison(targetField.pointerPath(), opArgs, Operator::CN, Type::STRING, buildCtx);
     return op;
 }
 
+namespace
+{
+enum class ContainsMode
+{
+    ANY,             ///< Any of the values, case sensitive
+    ANY_INSENSITIVE, ///< Any of the values, ignoring the case of the ASCII letters
+    ALL              ///< All the values, case sensitive
+};
+
+FilterOp opBuilderHelperStringContainsMany(const Reference& targetField,
+                                           const std::vector<OpArg>& opArgs,
+                                           ContainsMode mode,
+                                           const std::shared_ptr<const IBuildCtx>& buildCtx)
+{
+    // Assert expected number of parameters
+    utils::assertSize(opArgs, 1, utils::MAX_OP_ARGS);
+    // Parameter type check
+    utils::assertValue(opArgs);
+    const auto name = buildCtx->context().opName;
+
+    std::vector<std::string> needles;
+    auto addNeedle = [&](const json::Json& value)
+    {
+        if (!value.isString())
+        {
+            throw std::runtime_error(fmt::format("\"{}\" function: Expected a string but got '{}'", name, value.str()));
+        }
+        needles.emplace_back(value.getString().value());
+    };
+
+    for (const auto& arg : opArgs)
+    {
+        const auto& value = std::static_pointer_cast<const Value>(arg)->value();
+        if (value.isArray())
+        {
+            const auto items = value.getArray().value();
+            for (const auto& item : items)
+            {
+                addNeedle(item);
+            }
+        }
+        else
+        {
+            addNeedle(value);
+        }
+    }
+
+    if (needles.empty())
+    {
+        throw std::runtime_error(fmt::format("\"{}\" function: Expected at least one value", name));
+    }
+
+    auto automaton =
+        std::make_shared<const base::utils::string::AhoCorasick>(needles, mode == ContainsMode::ANY_INSENSITIVE);
+
+    // Tracing
+    const std::string successTrace {fmt::format("[{}] -> Success", name)};
+    const std::string failureTrace1 {
+        fmt::format("[{}] -> Failure: Target field '{}' not found or not a string", name, targetField.dotPath())};
+    const std::string failureTrace2 {fmt::format("[{}] -> Failure: Target field '{}' does not contain {} the values",
+                                                 name,
+                                                 targetField.dotPath(),
+                                                 mode == ContainsMode::ALL ? "all" : "any of")};
+
+    const bool all = mode == ContainsMode::ALL;
+
+    // Return Op
+    return [=, runState = buildCtx->runState(), targetField = targetField.pointerPath()](
+               base::ConstEvent event) -> FilterResult
+    {
+        const auto resolvedField {event->getString(targetField)};
+        if (!resolvedField.has_value())
+        {
+            RETURN_FAILURE(runState, false, failureTrace1);
+        }
+
+        const auto found =
+            all ? automaton->containsAll(resolvedField.value()) : automaton->containsAny(resolvedField.value());
+        if (found)
+        {
+            RETURN_SUCCESS(runState, true, successTrace);
+        }
+        RETURN_FAILURE(runState, false, failureTrace2);
+    };
+}
+} // namespace
+
+// field: +contains_any/value1/value2/...valueN
+FilterOp opBuilderHelperStringContainsAny(const Reference& targetField,
+                                          const std::vector<OpArg>& opArgs,
+                                          const std::shared_ptr<const IBuildCtx>& buildCtx)
+{
+    return opBuilderHelperStringContainsMany(targetField, opArgs, ContainsMode::ANY, buildCtx);
+}
+
+// field: +contains_any_insensitive/value1/value2/...valueN
+FilterOp opBuilderHelperStringContainsAnyInsensitive(const Reference& targetField,
+                                                     const std::vector<OpArg>& opArgs,
+                                                     const std::shared_ptr<const IBuildCtx>& buildCtx)
+{
+    return opBuilderHelperStringContainsMany(targetField, opArgs, ContainsMode::ANY_INSENSITIVE, buildCtx);
+}
+
+// field: +contains_all/value1/value2/...valueN
+FilterOp opBuilderHelperStringContainsAll(const Reference& targetField,
+                                          const std::vector<OpArg>& opArgs,
+                                          const std::shared_ptr<const IBuildCtx>& buildCtx)
+{
+    return opBuilderHelperStringContainsMany(targetField, opArgs, ContainsMode::ALL, buildCtx);
+}
+
 // field: binary_and($ref, value)
 FilterOp opBuilderHelperBinaryAnd(const Reference& targetField,
                                   const std::vector<OpArg>& opArgs,
@@ -565,7 +691,7 @@ FilterOp opBuilderHelperBinaryAnd(const Reference& targetField,
     auto getValue = [targetField, referenceNotFoundTrace, referenceNotValidHexTrace](
                         base::ConstEvent event) -> base::RespOrError<uint64_t>
     {
-        const auto value = event->getString(targetField.jsonPath());
+        const auto value = event->getString(targetField.pointerPath());
         if (!value.has_value())
         {
             return base::Error {referenceNotFoundTrace};
@@ -628,6 +754,14 @@ FilterOp opBuilderHelperRegexMatch(const Reference& targetField,
         throw std::runtime_error(fmt::format("Invalid regex: \"{}\".", value));
     }
 
+    // The regex filters on the same field are grouped in a set, so the field is scanned once for all of them
+    std::shared_ptr<RegexSet> regexSet {};
+    std::size_t setIndex {0};
+    if (auto regexSets = buildCtx->regexSets(); regexSets)
+    {
+        std::tie(regexSet, setIndex) = regexSets->add(targetField.dotPath(), value);
+    }
+
     // Tracing
     const auto name = buildCtx->context().opName;
     const auto successTrace {fmt::format("[{}] -> Success", name)};
@@ -637,7 +771,7 @@ FilterOp opBuilderHelperRegexMatch(const Reference& targetField,
     const std::string failureTrace2 {fmt::format("[{}] -> Failure: Regex did not match", name)};
 
     // Return Op
-    return [=, runState = buildCtx->runState(), targetField = targetField.jsonPath()](
+    return [=, runState = buildCtx->runState(), targetField = targetField.pointerPath()](
                base::ConstEvent event) -> FilterResult
     {
         const auto resolvedField {event->getString(targetField)};
@@ -646,7 +780,8 @@ FilterOp opBuilderHelperRegexMatch(const Reference& targetField,
             RETURN_FAILURE(runState, false, failureTrace1);
         }
 
-        if (RE2::PartialMatch(resolvedField.value(), *regex_ptr))
+        const auto grouped = regexSet ? regexSet->matches(resolvedField.value(), setIndex) : std::nullopt;
+        if ((grouped ? grouped.value() : RE2::PartialMatch(resolvedField.value(), *regex_ptr)))
         {
             RETURN_SUCCESS(runState, true, successTrace);
         }
@@ -681,6 +816,14 @@ FilterOp opBuilderHelperRegexNotMatch(const Reference& targetField,
                                              value));
     }
 
+    // The regex filters on the same field are grouped in a set, so the field is scanned once for all of them
+    std::shared_ptr<RegexSet> regexSet {};
+    std::size_t setIndex {0};
+    if (auto regexSets = buildCtx->regexSets(); regexSets)
+    {
+        std::tie(regexSet, setIndex) = regexSets->add(targetField.dotPath(), value);
+    }
+
     // Tracing
     const auto successTrace {fmt::format("[{}] -> Success", name)};
 
@@ -689,7 +832,7 @@ FilterOp opBuilderHelperRegexNotMatch(const Reference& targetField,
     const std::string failureTrace2 {fmt::format("[{}] -> Failure: Regex did match", name)};
 
     // Return Op
-    return [=, runState = buildCtx->runState(), targetField = targetField.jsonPath()](
+    return [=, runState = buildCtx->runState(), targetField = targetField.pointerPath()](
                base::ConstEvent event) -> FilterResult
     {
         const auto resolvedField {event->getString(targetField)};
@@ -698,7 +841,8 @@ FilterOp opBuilderHelperRegexNotMatch(const Reference& targetField,
             RETURN_FAILURE(runState, false, failureTrace1);
         }
 
-        if (!RE2::PartialMatch(resolvedField.value(), *regex_ptr))
+        const auto grouped = regexSet ? regexSet->matches(resolvedField.value(), setIndex) : std::nullopt;
+        if (!(grouped ? grouped.value() : RE2::PartialMatch(resolvedField.value(), *regex_ptr)))
         {
             RETURN_SUCCESS(runState, true, successTrace);
         }
@@ -766,7 +910,7 @@ FilterOp opBuilderHelperIPCIDR(const Reference& targetField,
     const std::string failureTrace3 {fmt::format("[{}] -> Failure: IP address is not in CIDR", name)};
 
     // Return Op
-    return [=, runState = buildCtx->runState(), targetField = targetField.jsonPath()](
+    return [=, runState = buildCtx->runState(), targetField = targetField.pointerPath()](
                base::ConstEvent event) -> FilterResult
     {
         const auto resolvedField {event->getString(targetField)};
@@ -775,26 +919,126 @@ FilterOp opBuilderHelperIPCIDR(const Reference& targetField,
             RETURN_FAILURE(runState, false, failureTrace1);
         }
 
+        // The canonical addresses are converted without exceptions, the rest as before
         uint32_t ip {};
+        if (!::utils::ip::parseIPv4(resolvedField.value(), ip))
+        {
+            try
+            {
+                ip = ::utils::ip::IPv4ToUInt(resolvedField.value());
+            }
+            catch (std::exception& e)
+            {
+                RETURN_FAILURE(runState,
+                               false,
+                               failureTrace2
+                                   + fmt::format(
+                                       "'{}' could not be converted to int: {}", resolvedField.value(), e.what()));
+            }
+        }
+        if (net_lower <= ip && ip <= net_upper)
+        {
+            RETURN_SUCCESS(runState, true, successTrace);
+        }
+        else
+        {
+            RETURN_FAILURE(runState, false, failureTrace3);
+        }
+    };
+}
+
+// field: +ip_cidr_match_any/10.0.0.0/8/192.168.0.0/255.255.0.0/fe80::/10
+// field: +ip_cidr_match_any/["10.0.0.0/8", "fe80::/10"]
+FilterOp opBuilderHelperIPCIDRSet(const Reference& targetField,
+                                  const std::vector<OpArg>& opArgs,
+                                  const std::shared_ptr<const IBuildCtx>& buildCtx)
+{
+    // Assert expected number of parameters
+    utils::assertSize(opArgs, 1, utils::MAX_OP_ARGS);
+    // Parameter type check
+    utils::assertValue(opArgs);
+    // Format name for the tracer
+    const auto name = buildCtx->context().opName;
+
+    auto networks = std::make_shared<::utils::ip::CIDRSet>();
+    auto addNetwork = [&](const json::Json& value)
+    {
+        if (!value.isString())
+        {
+            throw std::runtime_error(
+                fmt::format("\"{}\" function: Expected a CIDR string but got '{}'", name, value.str()));
+        }
+
         try
         {
-            ip = ::utils::ip::IPv4ToUInt(resolvedField.value());
+            networks->add(value.getString().value());
         }
-        catch (std::exception& e)
+        catch (const std::invalid_argument& e)
         {
-            RETURN_FAILURE(
-                runState,
-                false,
-                failureTrace2 + fmt::format("'{}' could not be converted to int: {}", resolvedField.value(), e.what()));
+            throw std::runtime_error(fmt::format(
+                "\"{}\" function: Invalid CIDR '{}': {}", name, value.getString().value(), e.what()));
         }
-        if (net_lower <= ip && ip <= net_upper)
+    };
+
+    for (const auto& arg : opArgs)
+    {
+        const auto& value = std::static_pointer_cast<const Value>(arg)->value();
+        if (value.isArray())
         {
-            RETURN_SUCCESS(runState, true, successTrace);
+            const auto items = value.getArray().value();
+            for (const auto& item : items)
+            {
+                addNetwork(item);
+            }
         }
         else
+        {
+            addNetwork(value);
+        }
+    }
+
+    if (networks->empty())
+    {
+        throw std::runtime_error(fmt::format("\"{}\" function: Expected at least one CIDR", name));
+    }
+
+    return buildCIDRSetFilter(targetField, std::move(networks), buildCtx);
+}
+
+FilterOp buildCIDRSetFilter(const Reference& targetField,
+                            std::shared_ptr<const ::utils::ip::CIDRSet> networks,
+                            const std::shared_ptr<const IBuildCtx>& buildCtx)
+{
+    const auto name = buildCtx->context().opName;
+
+    // Tracing
+    const std::string successTrace {fmt::format("{} -> Success", name)};
+    const std::string failureTrace1 {
+        fmt::format("{} -> Failure: Target field '{}' not found or not a string", name, targetField.dotPath())};
+    const std::string failureTrace2 {fmt::format("{} -> Failure: IP address is not in any CIDR", name)};
+    const std::string failureTrace3 {fmt::format("{} -> Failure: Not a valid IP address", name)};
+
+    // Return Op
+    return [=, runState = buildCtx->runState(), targetField = targetField.pointerPath()](
+               base::ConstEvent event) -> FilterResult
+    {
+        const auto resolvedField {event->getString(targetField)};
+        if (!resolvedField.has_value())
+        {
+            RETURN_FAILURE(runState, false, failureTrace1);
+        }
+
+        const auto found = networks->contains(resolvedField.value());
+        if (!found.has_value())
         {
             RETURN_FAILURE(runState, false, failureTrace3);
         }
+
+        if (found.value())
+        {
+            RETURN_SUCCESS(runState, true, successTrace);
+        }
+        RETURN_FAILURE(runState, false, failureTrace2);
     };
 }
 
@@ -814,23 +1058,20 @@ FilterOp opBuilderHelperPublicIP(const Reference& targetField,
     const std::string failureTrace2 {fmt::format("{} -> Failure: IP address is not public", name)};
     const std::string failureTrace3 {fmt::format("{} -> Failure: Not a valid IP address", name)};
 
-    auto checkFn = [](const std::string& ip) -> base::RespOrError<bool>
+    // Loopback, private, link-local and unique local networks, built once and shared by all the helpers
+    static const auto specialNetworks = []()
     {
-        using namespace ::utils::ip;
-        if (checkStrIsIPv4(ip))
-        {
-            return !isSpecialIPv4Address(ip);
-        }
-
-        if (checkStrIsIPv6(ip))
+        auto networks = std::make_shared<::utils::ip::CIDRSet>();
+        for (const auto& cidr :
+             {"10.0.0.0/8", "172.16.0.0/12", "192.168.0.0/16", "127.0.0.0/8", "::1/128", "fe80::/10", "fc00::/7"})
         {
-            return !isSpecialIPv6Address(ip);
+            networks->add(cidr);
         }
-        return base::Error {};
-    };
+        return std::shared_ptr<const ::utils::ip::CIDRSet>(networks);
+    }();
 
     // Return Op
-    return [=, runState = buildCtx->runState(), targetField = targetField.jsonPath()](
+    return [=, runState = buildCtx->runState(), targetField = targetField.pointerPath(), networks = specialNetworks](
                base::ConstEvent event) -> FilterResult
     {
         const auto resolvedField {event->getString(targetField)};
@@ -839,14 +1080,13 @@ FilterOp opBuilderHelperPublicIP(const Reference& targetField,
             RETURN_FAILURE(runState, false, failureTrace1);
         }
 
-        // Check for IPv4
-        auto checkResult = checkFn(resolvedField.value());
-        if (base::isError(checkResult))
+        const auto isSpecial = networks->contains(resolvedField.value());
+        if (!isSpecial.has_value())
         {
             RETURN_FAILURE(runState, false, failureTrace3);
         }
 
-        if (base::getResponse(checkResult))
+        if (!isSpecial.value())
         {
             RETURN_SUCCESS(runState, true, successTrace);
         }
@@ -856,6 +1096,60 @@ FilterOp opBuilderHelperPublicIP(const Reference& targetField,
 //*************************************************
 //*               Array filters                   *
 //*************************************************
+namespace
+{
+using LiteralStrings = std::unordered_map<std::string, std::size_t>;
+
+/**
+ * @brief Index the parameters when all of them are string values, so each element of the array is looked up once
+ * instead of being compared with every parameter.
+ *
+ * @return std::shared_ptr<const LiteralStrings> The index of each distinct string, null if any parameter is a
+ * reference or not a string.
+ */
+std::shared_ptr<const LiteralStrings> literalStrings(const std::vector<OpArg>& opArgs)
+{
+    auto literals = std::make_shared<LiteralStrings>();
+    for (const auto& arg : opArgs)
+    {
+        if (!arg->isValue() || !std::static_pointer_cast<const Value>(arg)->value().isString())
+        {
+            return nullptr;
+        }
+        literals->emplace(std::static_pointer_cast<const Value>(arg)->value().getString().value(), literals->size());
+    }
+    return literals;
+}
+
+/**
+ * @brief Get the number of distinct literals present in the array, stops when `enough` are found.
+ */
+std::size_t countLiterals(const LiteralStrings& literals, const std::vector<json::Json>& array, std::size_t enough)
+{
+    std::vector<uint8_t> found(literals.size(), 0);
+    std::size_t count = 0;
+    for (const auto& element : array)
+    {
+        const auto value = element.getString();
+        if (!value.has_value())
+        {
+            continue;
+        }
+
+        const auto it = literals.find(value.value());
+        if (it != literals.end() && !found[it->second])
+        {
+            found[it->second] = 1;
+            if (++count == enough)
+            {
+                break;
+            }
+        }
+    }
+    return count;
+}
+} // namespace
+
 FilterOp opBuilderHelperArrayPresence(const Reference& targetField,
                                       const std::vector<OpArg>& opArgs,
                                       bool atleastOne,
@@ -878,8 +1172,10 @@ FilterOp opBuilderHelperArrayPresence(const Reference& targetField,
                                                  targetField.dotPath(),
                                                  "does not contain at least one")};
 
+    const auto literals = literalStrings(opArgs);
+
     // Return Op
-    return [=, parameters = opArgs, runState = buildCtx->runState(), targetField = targetField.jsonPath()](
+    return [=, parameters = opArgs, runState = buildCtx->runState(), targetField = targetField.pointerPath()](
                base::ConstEvent event) -> FilterResult
     {
         if (!event->exists(targetField))
@@ -893,13 +1189,23 @@ FilterOp opBuilderHelperArrayPresence(const Reference& targetField,
             RETURN_FAILURE(runState, false, failureTrace2);
         }
 
+        if (literals)
+        {
+            const auto wanted = atleastOne ? 1 : literals->size();
+            if (countLiterals(*literals, resolvedArray.value(), wanted) == wanted)
+            {
+                RETURN_SUCCESS(runState, true, successTrace);
+            }
+            RETURN_FAILURE(runState, false, failureTrace3);
+        }
+
         json::Json cmpValue {};
         auto successCount {0};
         for (const auto& parameter : parameters)
         {
             if (parameter->isReference())
             {
-                auto resolvedParameter {event->getJson(std::static_pointer_cast<Reference>(parameter)->jsonPath())};
+                auto resolvedParameter {event->getJson(std::static_pointer_cast<Reference>(parameter)->pointerPath())};
                 if (resolvedParameter.has_value())
                 {
                     cmpValue = std::move(resolvedParameter.value());
@@ -959,8 +1265,10 @@ FilterOp opBuilderHelperArrayNotPresence(const Reference& targetField,
                                                  targetField.dotPath(),
                                                  "contain at least one")};
 
+    const auto literals = literalStrings(opArgs);
+
     // Return Op
-    return [=, parameters = opArgs, runState = buildCtx->runState(), targetField = targetField.jsonPath()](
+    return [=, parameters = opArgs, runState = buildCtx->runState(), targetField = targetField.pointerPath()](
                base::ConstEvent event) -> FilterResult
     {
         if (!event->exists(targetField))
@@ -974,13 +1282,24 @@ FilterOp opBuilderHelperArrayNotPresence(const Reference& targetField,
             RETURN_FAILURE(runState, false, failureTrace2);
         }
 
+        if (literals)
+        {
+            // At least one missing, or none of them present
+            const auto present = countLiterals(*literals, resolvedArray.value(), literals->size());
+            if (atleastOne ? present < literals->size() : present == 0)
+            {
+                RETURN_SUCCESS(runState, true, successTrace);
+            }
+            RETURN_FAILURE(runState, false, failureTrace3);
+        }
+
         json::Json cmpValue {};
         auto successCount {0};
         for (const auto& parameter : parameters)
         {
             if (parameter->isReference())
             {
-                auto resolvedParameter {event->getJson(std::static_pointer_cast<Reference>(parameter)->jsonPath())};
+                auto resolvedParameter {event->getJson(std::static_pointer_cast<Reference>(parameter)->pointerPath())};
                 if (resolvedParameter.has_value())
                 {
                     cmpValue = std::move(resolvedParameter.value());
@@ -1243,7 +1562,7 @@ FilterOp opBuilderHelperMatchValue(const Reference& targetField,
     const std::string failureTrace5 {fmt::format("[{}] -> Failure", name)};
 
     // Return op
-    return [=, runState = buildCtx->runState(), targetField = targetField.jsonPath(), parameter = opArgs[0]](
+    return [=, runState = buildCtx->runState(), targetField = targetField.pointerPath(), parameter = opArgs[0]](
                base::ConstEvent event) -> FilterResult
     {
         if (!event->exists(targetField))
@@ -3,6 +3,11 @@
 
 #include "builders/types.hpp"
 
+namespace utils::ip
+{
+class CIDRSet;
+} // namespace utils::ip
+
 /*
  * The helper filter, builds a lifter that will chain rxcpp filter operation
  * Rxcpp filter expects a function that returns bool.
@@ -148,6 +153,48 @@ FilterOp opBuilderHelperStringContains(const Reference& targetField,
                                        const std::vector<OpArg>& opArgs,
                                        const std::shared_ptr<const IBuildCtx>& buildCtx);
 
+/**
+ * @brief Create the `contains_any` helper function that checks if a field string contains any of the values.
+ *
+ * The values (strings or arrays of strings) are built in an Aho-Corasick automaton, so the field is scanned once
+ * whatever the number of values.
+ * @param targetField target field of the helper
+ * @param opArgs Vector of operation arguments with the substrings.
+ * @param buildCtx Shared pointer to the build context used for the conversion operation.
+ * @return FilterOp The lifter with the `contains_any` filter.
+ * @throw std::runtime_error if a parameter is a reference or not a string.
+ */
+FilterOp opBuilderHelperStringContainsAny(const Reference& targetField,
+                                          const std::vector<OpArg>& opArgs,
+                                          const std::shared_ptr<const IBuildCtx>& buildCtx);
+
+/**
+ * @brief Create the `contains_any_insensitive` helper function, as `contains_any` ignoring the case of the ASCII
+ * letters.
+ *
+ * @param targetField target field of the helper
+ * @param opArgs Vector of operation arguments with the substrings.
+ * @param buildCtx Shared pointer to the build context used for the conversion operation.
+ * @return FilterOp The lifter with the `contains_any_insensitive` filter.
+ * @throw std::runtime_error if a parameter is a reference or not a string.
+ */
+FilterOp opBuilderHelperStringContainsAnyInsensitive(const Reference& targetField,
+                                                     const std::vector<OpArg>& opArgs,
+                                                     const std::shared_ptr<const IBuildCtx>& buildCtx);
+
+/**
+ * @brief Create the `contains_all` helper function that checks if a field string contains all the values.
+ *
+ * @param targetField target field of the helper
+ * @param opArgs Vector of operation arguments with the substrings.
+ * @param buildCtx Shared pointer to the build context used for the conversion operation.
+ * @return FilterOp The lifter with the `contains_all` filter.
+ * @throw std::runtime_error if a parameter is a reference or not a string.
+ */
+FilterOp opBuilderHelperStringContainsAll(const Reference& targetField,
+                                          const std::vector<OpArg>& opArgs,
+                                          const std::shared_ptr<const IBuildCtx>& buildCtx);
+
 //*************************************************
 //*              Int filters                      *
 //*************************************************
@@ -302,6 +349,35 @@ FilterOp opBuilderHelperIPCIDR(const Reference& targetField,
                                const std::vector<OpArg>& opArgs,
                                const std::shared_ptr<const IBuildCtx>& buildCtx);
 
+/**
+ * @brief Create `ip_cidr_match_any` helper function that filters events if the field
+ * is an IPv4 or IPv6 address in any of the specified CIDR ranges.
+ *
+ * The ranges are given as string values or arrays of strings (`x.x.x.x/len`, `x.x.x.x/m.m.m.m`, `x:x::x/len` or a
+ * single address), and are built in a radix trie, so the check does not depend on the number of ranges.
+ * @param targetField target field of the helper
+ * @param opArgs Vector of operation arguments with the CIDR ranges.
+ * @param buildCtx Shared pointer to the build context used for the conversion operation.
+ * @return FilterOp The lifter with the `ip_cidr_match_any` filter.
+ * @throw std::runtime_error if a parameter is a reference or not a valid CIDR range.
+ */
+FilterOp opBuilderHelperIPCIDRSet(const Reference& targetField,
+                                  const std::vector<OpArg>& opArgs,
+                                  const std::shared_ptr<const IBuildCtx>& buildCtx);
+
+/**
+ * @brief Build a filter that passes the events whose field is an IP address in the set of networks.
+ *
+ * Shared by the helpers that get the networks from other sources (i.e. a KVDB).
+ * @param targetField target field of the helper
+ * @param networks The set of networks, it is not modified after the call.
+ * @param buildCtx Shared pointer to the build context.
+ * @return FilterOp The filter.
+ */
+FilterOp buildCIDRSetFilter(const Reference& targetField,
+                            std::shared_ptr<const ::utils::ip::CIDRSet> networks,
+                            const std::shared_ptr<const IBuildCtx>& buildCtx);
+
 /**
  * @brief Create `is_public_ip` helper function that filters events if the field
  * is a public IP address.
@@ -22,7 +22,7 @@ startsWithValue(const Reference& targetField, const Value& value, const std::sha
     const auto failure = fmt::format("{} -> Failure", buildCtx->context().opName);
     const auto targetNotString =
         fmt::format("{} -> Target field '{}' is not a string", buildCtx->context().opName, targetField.dotPath());
-    return [targetField = targetField.jsonPath(),
+    return [targetField = targetField.pointerPath(),
             value = json::Json(value.value()),
             runState = buildCtx->runState(),
             targetNotFound,
@@ -76,8 +76,8 @@ FilterOp startsWithReference(const Reference& targetField,
     const auto successTrace = fmt::format("{} -> Success", buildCtx->context().opName);
     const auto failure = fmt::format("{} -> Failure", buildCtx->context().opName);
 
-    return [targetField = targetField.jsonPath(),
-            reference = reference.jsonPath(),
+    return [targetField = targetField.pointerPath(),
+            reference = reference.pointerPath(),
             runState = buildCtx->runState(),
             referenceNotFound,
             referenceNotString,
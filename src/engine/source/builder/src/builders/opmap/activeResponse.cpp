@@ -1,5 +1,9 @@
 #include "builders/opmap/activeResponse.hpp"
 
+#include <mutex>
+
+#include <sockiface/coalescingSender.hpp>
+
 // TODO: move the wazuhRequest to a common path such as "utils"
 #include <base/utils/wazuhProtocol/wazuhRequest.hpp>
 
@@ -13,6 +17,8 @@ namespace ar
 // TODO: move all the sockets to a shared utils directory
 // TODO: when the api is merged these values can be obtained from "base".
 constexpr const char* AR_QUEUE_PATH {"/var/ossec/queue/alerts/ar"};
+constexpr std::chrono::milliseconds AR_COALESCING_WINDOW {1000}; ///< Identical AR messages are sent once per window
+constexpr std::size_t AR_QUEUE_CAPACITY {4096};                  ///< AR messages waiting to be sent
 
 // TODO: unify these parameters with the api ones
 constexpr const char* AGENT_ID_PATH {"/agent/id"};
@@ -256,16 +262,11 @@ MapOp CreateARBuilder(const std::vector<OpArg>& opArgs, const std::shared_ptr<co
 }
 
 // result: active_response_send('query'|$query)
-MapOp SendAR(std::shared_ptr<sockiface::ISockFactory> sockFactory,
+MapOp SendAR(const std::function<std::shared_ptr<sockiface::ISockHandler>()>& getSocketAR,
              const std::vector<OpArg>& opArgs,
              const std::shared_ptr<const IBuildCtx>& buildCtx)
 {
     // Validate parameters
-    if (!sockFactory)
-    {
-        throw std::runtime_error("sockFactory is nullptr");
-    }
-
     utils::assertSize(opArgs, 1);
     if (opArgs[0]->isValue() && !std::static_pointer_cast<Value>(opArgs[0])->value().isString())
     {
@@ -274,7 +275,7 @@ MapOp SendAR(std::shared_ptr<sockiface::ISockFactory> sockFactory,
     }
     const auto& rightParameter = opArgs[0];
 
-    auto socketAR = sockFactory->getHandler(Protocol::DATAGRAM, ar::AR_QUEUE_PATH);
+    auto socketAR = getSocketAR();
 
     const auto& name = buildCtx->context().opName;
 
@@ -284,7 +285,7 @@ MapOp SendAR(std::shared_ptr<sockiface::ISockFactory> sockFactory,
             ar::TRACE_REFERENCE_STR_NOT_FOUND, name, std::static_pointer_cast<Reference>(rightParameter)->dotPath())
                                       : std::string();
     const auto failureTrace2 = fmt::format("[{}] -> Failure: The query is empty", name);
-    const auto failureTrace3 = fmt::format("[{}] -> Failure: AR message could not be send", name);
+    const auto failureTrace3 = fmt::format("[{}] -> Failure: AR message could not be queued", name);
     const auto failureTrace4 = fmt::format("[{}] -> Failure: Error trying to send AR message: ", name);
 
     return [runState = buildCtx->runState(),
@@ -344,9 +345,25 @@ MapBuilder getOpBuilderSendAr(std::shared_ptr<sockiface::ISockFactory> sockFacto
         throw std::runtime_error("sockFactory is nullptr");
     }
 
-    return [sockFactory](const std::vector<OpArg>& opArgs, const std::shared_ptr<const IBuildCtx>& buildCtx) -> MapOp
+    // All the helpers share the sender, created when the first one is built
+    auto mutex = std::make_shared<std::mutex>();
+    auto sender = std::make_shared<std::shared_ptr<sockiface::ISockHandler>>();
+    auto getSocketAR = [sockFactory, mutex, sender]() -> std::shared_ptr<sockiface::ISockHandler>
+    {
+        std::lock_guard<std::mutex> lock(*mutex);
+        if (!*sender)
+        {
+            *sender = std::make_shared<sockiface::CoalescingSender>(
+                sockFactory->getHandler(Protocol::DATAGRAM, ar::AR_QUEUE_PATH),
+                ar::AR_COALESCING_WINDOW,
+                ar::AR_QUEUE_CAPACITY);
+        }
+        return *sender;
+    };
+
+    return [getSocketAR](const std::vector<OpArg>& opArgs, const std::shared_ptr<const IBuildCtx>& buildCtx) -> MapOp
     {
-        return SendAR(sockFactory, opArgs, buildCtx);
+        return SendAR(getSocketAR, opArgs, buildCtx);
     };
 }
 
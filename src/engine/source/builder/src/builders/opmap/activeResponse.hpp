@@ -12,15 +12,28 @@ namespace builder::builders
 /**
  * @brief Helper Function that allows to send a message through the AR queue.
  *
- * @param sockFactory
+ * The message is queued in the sender and the helper returns without waiting on the AR queue, it only fails if the
+ * sender queue is full.
+ *
+ * @param getSocketAR Returns the sender of the AR messages.
  * @param opArgs
  * @param buildCtx
  * @return TransformOp
  */
-MapOp SendAR(std::shared_ptr<sockiface::ISockFactory> sockFactory,
+MapOp SendAR(const std::function<std::shared_ptr<sockiface::ISockHandler>()>& getSocketAR,
              const std::vector<OpArg>& opArgs,
              const std::shared_ptr<const IBuildCtx>& buildCtx);
 
+/**
+ * @brief Get the builder of the active_response_send helper.
+ *
+ * The helpers built share a sockiface::CoalescingSender in front of the AR queue socket, created when the first one is
+ * built: the messages are sent in batches from its thread and identical messages are sent once per window.
+ *
+ * @param sockFactory Factory of the AR queue socket.
+ * @return MapBuilder
+ * @throw std::runtime_error if the factory is null.
+ */
 MapBuilder getOpBuilderSendAr(std::shared_ptr<sockiface::ISockFactory> sockFactory);
 
 // TODO: this helper is not used in the codebase
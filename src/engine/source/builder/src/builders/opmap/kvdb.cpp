@@ -1,5 +1,6 @@
 #include "builders/opmap/kvdb.hpp"
 
+#include <list>
 #include <string>
 #include <variant>
 
@@ -7,8 +8,10 @@
 
 #include <json/json.hpp>
 #include <kvdb/ikvdbhandler.hpp>
+#include <utils/cidrSet.hpp>
 #include <utils/stringUtils.hpp>
 
+#include "builders/opfilter/opBuilderHelperFilter.hpp"
 #include "syntax.hpp"
 
 namespace builder::builders
@@ -147,17 +150,16 @@ TransformOp KVDBGet(std::shared_ptr<IKVDBManager> kvdbManager,
             resolvedKey = std::static_pointer_cast<const Value>(key)->value().getString().value();
         }
 
-        // Get value from KVDB
-        auto resultValue = kvdbHandler->get(resolvedKey);
-
-        if (base::isError(resultValue))
-        {
-            RETURN_FAILURE(runState, event, failureTrace4)
-        }
-
         try
         {
-            json::Json value {base::getResponse<std::string>(resultValue).c_str()};
+            // Get value from KVDB, parsed values are cached by the handler
+            auto resultValue = kvdbHandler->getJson(resolvedKey);
+            if (base::isError(resultValue))
+            {
+                RETURN_FAILURE(runState, event, failureTrace4)
+            }
+
+            auto& value = std::get<json::Json>(resultValue);
             if (validator != nullptr)
             {
                 auto res = validator(value);
@@ -319,6 +321,69 @@ FilterBuilder getOpBuilderKVDBNotMatch(std::shared_ptr<IKVDBManager> kvdbManager
     };
 }
 
+FilterOp KVDBCIDRMatch(std::shared_ptr<IKVDBManager> kvdbManager,
+                       const std::string& kvdbScopeName,
+                       const Reference& targetField,
+                       const std::vector<OpArg>& opArgs,
+                       const std::shared_ptr<const IBuildCtx>& buildCtx)
+{
+    if (!kvdbManager)
+    {
+        throw std::runtime_error("Got null KVDB manager");
+    }
+
+    // Assert expected number of parameters
+    utils::assertSize(opArgs, 1);
+
+    // First argument is kvdb name
+    utils::assertValue(opArgs, 0);
+    if (!std::static_pointer_cast<Value>(opArgs[0])->value().isString())
+    {
+        throw std::runtime_error(fmt::format("Expected db name 'string' as first argument but got '{}'",
+                                             std::static_pointer_cast<Value>(opArgs[0])->value().str()));
+    }
+
+    auto dbName = std::static_pointer_cast<const Value>(opArgs[0])->value().getString().value();
+    auto resultHandler = kvdbManager->getKVDBHandler(dbName, kvdbScopeName);
+    if (base::isError(resultHandler))
+    {
+        throw std::runtime_error(fmt::format("Error getting KVDB handler: {}", base::getError(resultHandler).message));
+    }
+
+    auto resultDump = base::getResponse<std::shared_ptr<kvdbManager::IKVDBHandler>>(resultHandler)->dump();
+    if (base::isError(resultDump))
+    {
+        throw std::runtime_error(fmt::format("Error dumping DB '{}': {}", dbName, base::getError(resultDump).message));
+    }
+
+    // The keys are the ranges, the trie is built once and the DB is not queried per event
+    auto networks = std::make_shared<::utils::ip::CIDRSet>();
+    for (const auto& [key, value] : base::getResponse<std::list<std::pair<std::string, std::string>>>(resultDump))
+    {
+        try
+        {
+            networks->add(key);
+        }
+        catch (const std::invalid_argument& e)
+        {
+            throw std::runtime_error(fmt::format("Invalid CIDR '{}' in DB '{}': {}", key, dbName, e.what()));
+        }
+    }
+
+    return opfilter::buildCIDRSetFilter(targetField, std::move(networks), buildCtx);
+}
+
+// <field>: +kvdb_cidr_match/<DB>
+FilterBuilder getOpBuilderKVDBCIDRMatch(std::shared_ptr<IKVDBManager> kvdbManager, const std::string& kvdbScopeName)
+{
+    return [kvdbManager, kvdbScopeName](const Reference& targetField,
+                                        const std::vector<OpArg>& opArgs,
+                                        const std::shared_ptr<const IBuildCtx>& buildCtx)
+    {
+        return KVDBCIDRMatch(kvdbManager, kvdbScopeName, targetField, opArgs, buildCtx);
+    };
+}
+
 TransformOp KVDBSet(std::shared_ptr<IKVDBManager> kvdbManager,
                     const std::string& kvdbScopeName,
                     const Reference& targetField,
@@ -785,16 +850,15 @@ TransformBuilder getOpBuilderKVDBGetArray(std::shared_ptr<IKVDBManager> kvdbMana
             std::vector<json::Json> values;
             for (const auto& jKey : keys)
             {
-                auto resultValue = kvdbHandler->get(jKey.getString().value());
-                if (base::isError(resultValue))
-                {
-                    RETURN_FAILURE(runState, event, failureTrace3 + std::get<base::Error>(resultValue).message);
-                }
-
                 json::Json jValue;
                 try
                 {
-                    jValue = json::Json {std::get<std::string>(resultValue).c_str()};
+                    auto resultValue = kvdbHandler->getJson(jKey.getString().value());
+                    if (base::isError(resultValue))
+                    {
+                        RETURN_FAILURE(runState, event, failureTrace3 + std::get<base::Error>(resultValue).message);
+                    }
+                    jValue = std::move(std::get<json::Json>(resultValue));
                 }
                 catch (const std::runtime_error& e)
                 {
@@ -93,6 +93,33 @@ FilterBuilder getOpBuilderKVDBMatch(std::shared_ptr<IKVDBManager> kvdbManager, c
  */
 FilterBuilder getOpBuilderKVDBNotMatch(std::shared_ptr<IKVDBManager> kvdbManager, const std::string& kvdbScopeName);
 
+/**
+ * @brief Builder for KVDB CIDR match operation
+ *
+ * The keys of the DB are loaded as CIDR ranges when the helper is built, later changes to the DB are not seen until
+ * the policy is built again. This builder is not intended to be used directly, i.e. it is not registered. It is
+ * exposed for testing purposes.
+ *
+ * @param targetField target field of the helper
+ * @param opArgs vector of parameters as present in the raw definition
+ * @param buildCtx Build context
+ * @return FilterOp
+ * @throw std::runtime_error if the DB cannot be read or a key is not a valid CIDR range.
+ */
+FilterOp KVDBCIDRMatch(std::shared_ptr<IKVDBManager> kvdbManager,
+                       const std::string& kvdbScopeName,
+                       const Reference& targetField,
+                       const std::vector<OpArg>& opArgs,
+                       const std::shared_ptr<const IBuildCtx>& buildCtx);
+
+/**
+ * @brief Get the KVDB CIDR match function helper builder
+ *
+ * @param kvdbScope KVDB Scope
+ * @return Builder
+ */
+FilterBuilder getOpBuilderKVDBCIDRMatch(std::shared_ptr<IKVDBManager> kvdbManager, const std::string& kvdbScopeName);
+
 /**
  * @brief Get the KVDB Set function helper builder
  *
@@ -21,7 +21,7 @@ MapOp mapReference(const Reference& reference, const std::shared_ptr<const IBuil
     auto referenceNotFound =
         fmt::format("{} -> Reference '{}' not found", buildCtx->context().opName, reference.dotPath());
     const auto successTrace = fmt::format("{} -> Success", buildCtx->context().opName);
-    return [successTrace, runState = buildCtx->runState(), referenceNotFound, referencePath = reference.jsonPath()](
+    return [successTrace, runState = buildCtx->runState(), referenceNotFound, referencePath = reference.pointerPath()](
                base::ConstEvent event) -> MapResult
     {
         if (!event->exists(referencePath))
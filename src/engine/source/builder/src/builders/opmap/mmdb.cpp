@@ -1,5 +1,7 @@
 #include "mmdb.hpp"
 
+#include "builders/mmdbGroup.hpp"
+
 namespace builder::builders::mmdb
 {
 
@@ -14,100 +16,113 @@ MapOp dumpFailTransform(const std::string& trace, const std::shared_ptr<const Ru
     };
 }
 
-// Only for the MMDB City / Country db
-json::Json mapGeoToECS(const std::string& ip, const std::shared_ptr<geo::ILocator>& locator)
+/**
+ * @brief Field of a MMDB database mapped to the Wazuh schema.
+ */
+struct ECSField
 {
-    json::Json cityData;
-    cityData.setObject();
-
-    // Geo data
-    auto city = locator->getString(ip, "city.names.en");
-    if (!base::isError(city))
-    {
-        cityData.setString(getResponse(city), "/city_name");
-    }
-
-    auto continentCode = locator->getString(ip, "continent.code");
-    if (!base::isError(continentCode))
-    {
-        cityData.setString(getResponse(continentCode), "/continent_code");
-    }
-
-    auto continentName = locator->getString(ip, "continent.names.en");
-    if (!base::isError(continentName))
-    {
-        cityData.setString(getResponse(continentName), "/continent_name");
-    }
-
-    auto countryIsoCode = locator->getString(ip, "country.iso_code");
-    if (!base::isError(countryIsoCode))
-    {
-        cityData.setString(getResponse(countryIsoCode), "/country_iso_code");
-    }
-
-    auto countryName = locator->getString(ip, "country.names.en");
-    if (!base::isError(countryName))
-    {
-        cityData.setString(getResponse(countryName), "/country_name");
-    }
-
-    auto lat = locator->getDouble(ip, "location.latitude");
-    if (!base::isError(lat))
-    {
-        cityData.setDouble(getResponse(lat), "/location/lat");
-    }
-
-    auto lon = locator->getDouble(ip, "location.longitude");
-    if (!base::isError(lon))
-    {
-        cityData.setDouble(getResponse(lon), "/location/lon");
-    }
+    const char* path;       ///< Path in the MMDB database
+    geo::Fields::Type type; ///< Type of the value
+    const char* target;     ///< Json path in the mapped data
+};
 
-    auto postalCode = locator->getString(ip, "postal.code");
-    if (!base::isError(postalCode))
-    {
-        cityData.setString(getResponse(postalCode), "/postal_code");
-    }
+// Only for the MMDB City / Country db
+const std::vector<ECSField> GEO_FIELDS {
+    {"city.names.en", geo::Fields::Type::STRING, "/city_name"},
+    {"continent.code", geo::Fields::Type::STRING, "/continent_code"},
+    {"continent.names.en", geo::Fields::Type::STRING, "/continent_name"},
+    {"country.iso_code", geo::Fields::Type::STRING, "/country_iso_code"},
+    {"country.names.en", geo::Fields::Type::STRING, "/country_name"},
+    {"location.latitude", geo::Fields::Type::DOUBLE, "/location/lat"},
+    {"location.longitude", geo::Fields::Type::DOUBLE, "/location/lon"},
+    {"postal.code", geo::Fields::Type::STRING, "/postal_code"},
+    {"location.time_zone", geo::Fields::Type::STRING, "/timezone"},
+    {"subdivisions.0.iso_code", geo::Fields::Type::STRING, "/region_iso_code"},
+    {"subdivisions.0.names.en", geo::Fields::Type::STRING, "/region_name"}};
+
+const std::vector<ECSField> AS_FIELDS {
+    {"autonomous_system_number", geo::Fields::Type::UINT32, "/number"},
+    {"autonomous_system_organization", geo::Fields::Type::STRING, "/organization/name"}};
+
+/**
+ * @brief Fields of a helper, looked up with the siblings on the same IP field and database.
+ */
+struct Lookup
+{
+    std::shared_ptr<MMDBGroup> group; ///< Group of the helper
+    std::vector<std::size_t> indexes; ///< Index in the values of the group of each field of the helper
+};
 
-    auto timeZone = locator->getString(ip, "location.time_zone");
-    if (!base::isError(timeZone))
+/**
+ * @brief Add the fields of a helper to the group of its database and IP field.
+ *
+ * The helpers of a build looking up the same IP in the same database share one lookup and one walk of the record.
+ * Without groups in the build context, the helper gets a group of its own.
+ */
+base::RespOrError<Lookup> joinLookup(const std::shared_ptr<geo::IManager>& geoManager,
+                                     const std::shared_ptr<const IBuildCtx>& buildCtx,
+                                     geo::Type type,
+                                     const std::string& ipField,
+                                     const std::vector<ECSField>& ecsFields)
+{
+    MMDBGroup::FieldList fields;
+    fields.reserve(ecsFields.size());
+    for (const auto& ecsField : ecsFields)
     {
-        cityData.setString(getResponse(timeZone), "/timezone");
+        fields.emplace_back(DotPath(ecsField.path), ecsField.type);
     }
 
-    auto regionIsoCode = locator->getString(ip, "subdivisions.0.iso_code");
-    if (!base::isError(regionIsoCode))
+    if (auto groups = buildCtx->mmdbGroups(); groups)
     {
-        cityData.setString(getResponse(regionIsoCode), "/region_iso_code");
+        auto resGroup = groups->add(geoManager, type, ipField, fields);
+        if (base::isError(resGroup))
+        {
+            return base::getError(resGroup);
+        }
+        auto& [group, indexes] = base::getResponse(resGroup);
+        return Lookup {std::move(group), std::move(indexes)};
     }
 
-    auto regionName = locator->getString(ip, "subdivisions.0.names.en");
-    if (!base::isError(regionName))
+    auto resLocator = geoManager->getLocator(type);
+    if (base::isError(resLocator))
     {
-        cityData.setString(getResponse(regionName), "/region_name");
+        return base::getError(resLocator);
     }
-
-    return cityData;
+    auto group = std::make_shared<MMDBGroup>(base::getResponse(resLocator));
+    auto indexes = group->add(fields).value();
+    return Lookup {std::move(group), std::move(indexes)};
 }
 
-json::Json mapAStoECS(const std::string& ip, const std::shared_ptr<geo::ILocator>& locator)
+json::Json mapToECS(const std::string& ip, const Lookup& lookup, const std::vector<ECSField>& ecsFields)
 {
-    json::Json asData;
-    asData.setObject();
+    json::Json data;
+    data.setObject();
 
-    auto asn = locator->getUint32(ip, "autonomous_system_number");
-    if (!base::isError(asn))
+    auto valuesResp = lookup.group->getFields(ip);
+    if (base::isError(valuesResp))
     {
-        asData.setInt64(getResponse(asn), "/number");
+        return data;
     }
 
-    auto asnOrg = locator->getString(ip, "autonomous_system_organization");
-    if (!base::isError(asnOrg))
+    const auto& values = *base::getResponse(valuesResp);
+    for (std::size_t i = 0; i < ecsFields.size(); ++i)
     {
-        asData.setString(getResponse(asnOrg), "/organization/name");
+        const auto& value = values[lookup.indexes[i]];
+        if (const auto str = std::get_if<std::string>(&value))
+        {
+            data.setString(*str, ecsFields[i].target);
+        }
+        else if (const auto uint = std::get_if<uint32_t>(&value))
+        {
+            data.setInt64(*uint, ecsFields[i].target);
+        }
+        else if (const auto dbl = std::get_if<double>(&value))
+        {
+            data.setDouble(*dbl, ecsFields[i].target);
+        }
     }
 
-    return asData;
+    return data;
 }
 
 } // namespace
@@ -128,13 +143,14 @@ MapBuilder getMMDBGeoBuilder(const std::shared_ptr<geo::IManager>& geoManager)
             throw std::runtime_error(fmt::format("The reference '{}' is not an IP.", ipRef.dotPath()));
         }
 
-        auto resDB = geoManager->getLocator(geo::Type::CITY);
+        auto resLookup = joinLookup(geoManager, buildCtx, geo::Type::CITY, ipRef.dotPath(), GEO_FIELDS);
         // TODO Temporary error handling, this should be mandatory
         auto runstate = buildCtx->runState();
         const auto name = buildCtx->context().opName;
-        if (base::isError(resDB))
+        if (base::isError(resLookup))
         {
-            const auto trace = fmt::format("{} -> Failure: handler error: {}", name, base::getError(resDB).message);
+            const auto trace =
+                fmt::format("{} -> Failure: handler error: {}", name, base::getError(resLookup).message);
             return dumpFailTransform(trace, runstate);
         }
 
@@ -145,7 +161,8 @@ MapBuilder getMMDBGeoBuilder(const std::shared_ptr<geo::IManager>& geoManager)
         const std::string notFoundDBTrace {fmt::format("{} -> Failure: IP Not found in DB", name)};
         const std::string emptyDataTrace {fmt::format("{} -> Failure: Empty wcs data", name)};
 
-        return [=, locator = base::getResponse(resDB), srcRef = ipRef.jsonPath()](base::ConstEvent event) -> MapResult
+        return [=, lookup = base::getResponse(resLookup), srcRef = ipRef.jsonPath()](
+                   base::ConstEvent event) -> MapResult
         {
             // Get the ip
             auto ipStr = event->getString(srcRef);
@@ -154,7 +171,7 @@ MapBuilder getMMDBGeoBuilder(const std::shared_ptr<geo::IManager>& geoManager)
                 RETURN_FAILURE(runstate, json::Json {}, notFoundTrace);
             }
 
-            auto geo = mapGeoToECS(ipStr.value(), locator);
+            auto geo = mapToECS(ipStr.value(), lookup, GEO_FIELDS);
 
             if (geo.size() == 0)
             {
@@ -191,15 +208,16 @@ MapBuilder getMMDBASNBuilder(const std::shared_ptr<geo::IManager>& geoManager)
             throw std::runtime_error(fmt::format("The reference '{}' is not an IP.", ipRef.dotPath()));
         }
 
-        auto resDB = geoManager->getLocator(geo::Type::ASN);
+        auto resLookup = joinLookup(geoManager, buildCtx, geo::Type::ASN, ipRef.dotPath(), AS_FIELDS);
         // TODO Temporary error handling, this should be mandatory
         auto runstate = buildCtx->runState();
-        if (base::isError(resDB))
+        if (base::isError(resLookup))
         {
-            return dumpFailTransform("Error getting geo asn locator: " + base::getError(resDB).message, runstate);
+            return dumpFailTransform("Error getting geo asn locator: " + base::getError(resLookup).message, runstate);
         }
 
-        return [=, locator = base::getResponse(resDB), srcRef = ipRef.jsonPath()](base::ConstEvent event) -> MapResult
+        return [=, lookup = base::getResponse(resLookup), srcRef = ipRef.jsonPath()](
+                   base::ConstEvent event) -> MapResult
         {
             // Get the ip
             auto ipStr = event->getString(srcRef);
@@ -208,7 +226,7 @@ MapBuilder getMMDBASNBuilder(const std::shared_ptr<geo::IManager>& geoManager)
                 RETURN_FAILURE(runstate, json::Json {}, notFoundTrace);
             }
 
-            auto as = mapAStoECS(ipStr.value(), locator);
+            auto as = mapToECS(ipStr.value(), lookup, AS_FIELDS);
 
             if (as.size() == 0)
             {
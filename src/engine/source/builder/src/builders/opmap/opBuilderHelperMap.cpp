@@ -2,10 +2,12 @@
 
 #include <algorithm>
 #include <chrono>
+#include <iterator>
 #include <numeric>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <tuple>
 #include <variant>
 
 #include <date/date.h>
@@ -17,6 +19,7 @@
 #include <utils/ipUtils.hpp>
 #include <utils/stringUtils.hpp>
 
+#include "builders/regexSet.hpp"
 #include "syntax.hpp"
 
 namespace
@@ -404,6 +407,30 @@ std::optional<std::string> hashStringSHA1(std::string& input)
     return {output};
 }
 
+/**
+ * @brief Get the scratch buffer of the calling thread, empty and with room for at least `sizeHint` characters.
+ *
+ * The buffer keeps its capacity between events, so the string helpers don't allocate a new string per event. It must
+ * not be used again until the string built in it has been copied into the event.
+ * @param sizeHint Expected size of the string
+ * @return std::string& The buffer
+ */
+std::string& scratchBuffer(size_t sizeHint)
+{
+    // Don't keep the memory of an unusually big event forever
+    constexpr size_t MAX_IDLE_CAPACITY = 64 * 1024;
+
+    thread_local std::string buffer;
+    if (buffer.capacity() > MAX_IDLE_CAPACITY && sizeHint <= MAX_IDLE_CAPACITY)
+    {
+        std::string {}.swap(buffer);
+    }
+    buffer.clear();
+    buffer.reserve(sizeHint);
+
+    return buffer;
+}
+
 } // namespace
 
 namespace builder::builders
@@ -479,8 +506,8 @@ TransformOp opBuilderHelperStringTrim(const Reference& targetField,
     const std::string failureTrace3 {fmt::format("[{}] -> Failure: Invalid trim type '{}'", name, trimType)};
 
     // Return Op
-    return
-        [=, runState = buildCtx->runState(), targetField = targetField.jsonPath()](base::Event event) -> TransformResult
+    return [=, runState = buildCtx->runState(), targetField = targetField.pointerPath()](
+               base::Event event) -> TransformResult
     {
         // Get field value
         if (!event->exists(targetField))
@@ -571,18 +598,34 @@ MapBuilder opBuilderHelperStringConcat(bool atleastOne)
         const std::string failureTrace1 {fmt::format("{} -> Failure: ", name)};
         const std::string failureTrace2 {fmt::format("{} -> Failure: ", name)};
 
+        // Resolve the values once, a reference keeps an empty value
+        std::vector<std::string> values;
+        size_t sizeHint = 0;
+        for (const auto& arg : opArgs)
+        {
+            if (arg->isValue())
+            {
+                const auto& value = std::static_pointer_cast<Value>(arg)->value();
+                values.emplace_back(value.isString() ? value.getString().value() : value.str());
+                sizeHint += values.back().size();
+            }
+            else
+            {
+                values.emplace_back();
+            }
+        }
+
         // Return Op
         return [=, runState = buildCtx->runState()](base::ConstEvent event) -> MapResult
         {
-            std::string result {};
+            auto& result = scratchBuffer(sizeHint);
 
-            for (const auto& arg : opArgs)
+            for (size_t i = 0; i < opArgs.size(); ++i)
             {
-                if (arg->isReference())
+                if (opArgs[i]->isReference())
                 {
                     // Check path exists
-                    std::string resolvedField {};
-                    const auto& ref = std::static_pointer_cast<Reference>(arg)->jsonPath();
+                    const auto& ref = std::static_pointer_cast<Reference>(opArgs[i])->jsonPath();
 
                     auto isExist = event->exists(ref);
 
@@ -594,26 +637,26 @@ MapBuilder opBuilderHelperStringConcat(bool atleastOne)
                                 runState, json::Json {}, failureTrace1 + fmt::format("Reference '{}' not found", ref));
                         }
 
-                        result.append(resolvedField);
                         continue;
                     }
 
                     // Get field value
                     if (event->isString(ref))
                     {
-                        resolvedField = event->getString(ref).value();
+                        result.append(event->getString(ref).value());
                     }
                     else if (event->isDouble(ref))
                     {
-                        resolvedField = std::to_string(event->getDouble(ref).value());
+                        // Same format as std::to_string
+                        fmt::format_to(std::back_inserter(result), "{:f}", event->getDouble(ref).value());
                     }
                     else if (event->isInt(ref) ||event->isInt64(ref))
                     {
-                        resolvedField = std::to_string(event->getIntAsInt64(ref).value());
+                        fmt::format_to(std::back_inserter(result), "{}", event->getIntAsInt64(ref).value());
                     }
                     else if (event->isObject(ref))
                     {
-                        resolvedField = event->str(ref).value();
+                        result.append(event->str(ref).value());
                     }
                     else
                     {
@@ -621,15 +664,10 @@ MapBuilder opBuilderHelperStringConcat(bool atleastOne)
                                        json::Json {},
                                        failureTrace2 + fmt::format("Parameter '{}' type cannot be handled", ref));
                     }
-
-                    result.append(resolvedField);
                 }
                 else
                 {
-                    const std::string value = std::static_pointer_cast<Value>(arg)->value().isString()
-                                                  ? std::static_pointer_cast<Value>(arg)->value().getString().value()
-                                                  : std::static_pointer_cast<Value>(arg)->value().str();
-                    result.append(value);
+                    result.append(values[i]);
                 }
             }
             json::Json resultJson;
@@ -685,7 +723,7 @@ MapOp opBuilderHelperStringFromArray(const std::vector<OpArg>& opArgs, const std
     const std::string failureTrace3 {fmt::format(TRACE_REFERENCE_TYPE_IS_NOT, "array", traceName, arrayRef.dotPath())};
 
     // Return Op
-    return [=, runState = buildCtx->runState(), arrayName = arrayRef.jsonPath()](base::ConstEvent event) -> MapResult
+    return [=, runState = buildCtx->runState(), arrayName = arrayRef.pointerPath()](base::ConstEvent event) -> MapResult
     {
         // Check if reference exists
         if (!event->exists(arrayName))
@@ -700,23 +738,24 @@ MapOp opBuilderHelperStringFromArray(const std::vector<OpArg>& opArgs, const std
             RETURN_FAILURE(runState, json::Json {}, failureTrace3);
         }
 
-        std::vector<std::string> stringArray;
-        for (const auto& s_param : stringJsonArray.value())
+        // accumulated concation without trailing indexes
+        const auto& items = stringJsonArray.value();
+        auto& composedValueString = scratchBuffer(items.empty() ? 0 : separator.size() * (items.size() - 1));
+        for (size_t i = 0; i < items.size(); ++i)
         {
-            if (s_param.isString())
+            const auto strVal = items[i].getString();
+            if (!strVal.has_value())
             {
-                const auto strVal = s_param.getString().value();
-                stringArray.emplace_back(std::move(strVal));
+                RETURN_FAILURE(runState, json::Json {}, failureTrace1);
             }
-            else
+
+            if (i != 0)
             {
-                RETURN_FAILURE(runState, json::Json {}, failureTrace1);
+                composedValueString.append(separator);
             }
+            composedValueString.append(strVal.value());
         }
 
-        // accumulated concation without trailing indexes
-        const std::string composedValueString {base::utils::string::join(stringArray, separator)};
-
         json::Json result;
         result.setString(composedValueString);
 
@@ -757,7 +796,7 @@ MapOp opBuilderHelperStringFromHexa(const std::vector<OpArg>& opArgs, const std:
     const auto failureTrace5 = fmt::format("{} -> Found non ascii character", traceName);
 
     // Return Op
-    return [=, runState = buildCtx->runState(), sourceField = hexRef.jsonPath()](base::ConstEvent event) -> MapResult
+    return [=, runState = buildCtx->runState(), sourceField = hexRef.pointerPath()](base::ConstEvent event) -> MapResult
     {
         std::string strHex {};
 
@@ -844,7 +883,7 @@ MapOp opBuilderHelperHexToNumber(const std::vector<OpArg>& opArgs, const std::sh
     const std::string failureTrace3 {fmt::format("[{}] -> Failure: ", traceName)};
 
     // Return Op
-    return [=, runState = buildCtx->runState(), sourceField = hexRef.jsonPath()](base::ConstEvent event) -> MapResult
+    return [=, runState = buildCtx->runState(), sourceField = hexRef.pointerPath()](base::ConstEvent event) -> MapResult
     {
         // Getting string field from a reference
         if (!event->exists(sourceField))
@@ -913,8 +952,8 @@ TransformOp opBuilderHelperStringReplace(const Reference& targetField,
     const std::string failureTrace2 {fmt::format(TRACE_TARGET_TYPE_NOT_STRING, name, targetField.dotPath())};
 
     // Return Op
-    return
-        [=, runState = buildCtx->runState(), targetField = targetField.jsonPath()](base::Event event) -> TransformResult
+    return [=, runState = buildCtx->runState(), targetField = targetField.pointerPath()](
+               base::Event event) -> TransformResult
     {
         if (!event->exists(targetField))
         {
@@ -930,14 +969,19 @@ TransformOp opBuilderHelperStringReplace(const Reference& targetField,
             RETURN_FAILURE(runState, event, failureTrace2);
         }
 
-        auto newString = resolvedField.value();
+        const auto& oldString = resolvedField.value();
+        auto& newString = scratchBuffer(oldString.size());
 
+        // Copy the text between the matches once, instead of shifting the tail on every replace
+        size_t last_pos = 0;
         size_t start_pos = 0;
-        while ((start_pos = newString.find(oldSubstr, start_pos)) != std::string::npos)
+        while ((start_pos = oldString.find(oldSubstr, last_pos)) != std::string::npos)
         {
-            newString.replace(start_pos, oldSubstr.length(), newSubstr);
-            start_pos += newSubstr.length();
+            newString.append(oldString, last_pos, start_pos - last_pos);
+            newString.append(newSubstr);
+            last_pos = start_pos + oldSubstr.length();
         }
+        newString.append(oldString, last_pos);
 
         event->setString(newString, targetField);
 
@@ -1057,6 +1101,14 @@ MapOp opBuilderHelperRegexExtract(const std::vector<OpArg>& opArgs, const std::s
         }
     }
 
+    // The set of the regex filters on the field tells if the extraction can match without scanning it again
+    std::shared_ptr<RegexSet> regexSet {};
+    std::size_t setIndex {0};
+    if (auto regexSets = buildCtx->regexSets(); regexSets)
+    {
+        std::tie(regexSet, setIndex) = regexSets->add(refField.dotPath(), regex_ptr->pattern());
+    }
+
     // Tracing
     const auto name = buildCtx->context().opName;
     const auto successTrace = fmt::format("{} -> Success", name);
@@ -1065,7 +1117,7 @@ MapOp opBuilderHelperRegexExtract(const std::vector<OpArg>& opArgs, const std::s
     const auto failureTrace3 = fmt::format("[{}] -> Regex did not match", name);
 
     // Return Op
-    return [=, runState = buildCtx->runState(), refField = refField.jsonPath()](base::ConstEvent event) -> MapResult
+    return [=, runState = buildCtx->runState(), refField = refField.pointerPath()](base::ConstEvent event) -> MapResult
     {
         if (!event->exists(refField))
         {
@@ -1080,7 +1132,8 @@ MapOp opBuilderHelperRegexExtract(const std::vector<OpArg>& opArgs, const std::s
         }
 
         std::string match {};
-        if (RE2::PartialMatch(resolvedField.value(), *regex_ptr, &match))
+        const auto grouped = regexSet ? regexSet->matches(resolvedField.value(), setIndex) : std::nullopt;
+        if (grouped.value_or(true) && RE2::PartialMatch(resolvedField.value(), *regex_ptr, &match))
         {
             json::Json result;
             result.setString(match);
@@ -1220,7 +1273,7 @@ TransformOp opBuilderHelperAppendSplitString(const Reference& targetField,
     return [=,
             runState = buildCtx->runState(),
             targetField = targetField.jsonPath(),
-            fieldReference = ref.jsonPath(),
+            fieldReference = ref.pointerPath(),
             separator = separator[0]](base::Event event) -> TransformResult
     {
         // Check if reference exists
@@ -1234,11 +1287,18 @@ TransformOp opBuilderHelperAppendSplitString(const Reference& targetField,
             RETURN_FAILURE(runState, event, failureTrace2);
         }
 
-        const auto splitted = base::utils::string::split(resolvedReference.value(), separator);
+        // Same items as base::utils::string::split, appended as views of the reference
+        std::string_view pending {resolvedReference.value()};
+        if (!pending.empty() && pending[0] == separator)
+        {
+            pending.remove_prefix(1);
+        }
 
-        for (const auto& value : splitted)
+        while (!pending.empty())
         {
-            event->appendString(value, targetField);
+            const auto pos = pending.find(separator);
+            event->appendString(pending.substr(0, pos), targetField);
+            pending.remove_prefix(pos == pending.npos ? pending.size() : pos + 1);
         }
 
         RETURN_SUCCESS(runState, event, successTrace);
@@ -1451,7 +1511,7 @@ MapOp opBuilderHelperIPVersionFromIPStr(const std::vector<OpArg>& opArgs,
         fmt::format("{} -> Reference '{}' value is not a valid IP address", name, ipRef.dotPath());
 
     // Return Op
-    return [=, runState = buildCtx->runState(), ipStrPath = ipRef.jsonPath()](base::ConstEvent event) -> MapResult
+    return [=, runState = buildCtx->runState(), ipStrPath = ipRef.pointerPath()](base::ConstEvent event) -> MapResult
     {
         // Check if reference exists
         if (!event->exists(ipStrPath))
@@ -1549,7 +1609,7 @@ MapOp opBuilderHelperDateFromEpochTime(const std::vector<OpArg>& opArgs,
         fmt::format("{} -> Reference '{}' does not hold a valid integer epoch number", name, epochRef.dotPath());
 
     // Return Op
-    return [=, runState = buildCtx->runState(), refPath = epochRef.jsonPath()](base::ConstEvent event) -> MapResult
+    return [=, runState = buildCtx->runState(), refPath = epochRef.pointerPath()](base::ConstEvent event) -> MapResult
     {
         // Check if reference exists
         if (!event->exists(refPath))
@@ -1608,7 +1668,7 @@ MapOp opBuilderHelperHashSHA1(const std::vector<OpArg>& opArgs, const std::share
     const auto failureTrace3 = fmt::format("{} -> Could not hash string", name);
 
     // Return Op
-    return [=, runState = buildCtx->runState(), refPath = ref.jsonPath()](base::ConstEvent event) -> MapResult
+    return [=, runState = buildCtx->runState(), refPath = ref.pointerPath()](base::ConstEvent event) -> MapResult
     {
         // Check if reference exists
         if (!event->exists(refPath))
@@ -1722,9 +1782,9 @@ TransformOp opBuilderHelperGetValueGeneric(const Reference& targetField,
     // Return Op
     return [=,
             runState = buildCtx->runState(),
-            targetField = targetField.jsonPath(),
+            targetField = targetField.pointerPath(),
             parameter = opArgs[0],
-            key = keyRef.jsonPath()](base::Event event) -> TransformResult
+            key = keyRef.pointerPath()](base::Event event) -> TransformResult
     {
         // Get key
         if (!event->exists(key))
@@ -1739,8 +1799,8 @@ TransformOp opBuilderHelperGetValueGeneric(const Reference& targetField,
 
         auto pointerPath = json::Json::formatJsonPath(resolvedKey.value());
 
-        // Get object
-        std::optional<json::Json> resolvedObject {std::nullopt};
+        // Get object, the value is read in place instead of copying the whole object
+        const json::Json* resolvedObject {nullptr};
 
         if (parameter->isReference())
         {
@@ -1748,37 +1808,41 @@ TransformOp opBuilderHelperGetValueGeneric(const Reference& targetField,
             const auto& ref = *std::static_pointer_cast<Reference>(parameter);
 
             // Get reference object
-            if (!event->exists(ref.jsonPath()))
+            if (!event->exists(ref.pointerPath()))
             {
                 RETURN_FAILURE(runState, event, failureTrace3);
             }
-            resolvedObject = event->getJson(ref.jsonPath());
-            if (!resolvedObject.value().isObject())
+            if (!event->isObject(ref.jsonPath()))
             {
                 RETURN_FAILURE(runState, event, failureTrace4);
             }
+            resolvedObject = event.get();
+            pointerPath.insert(0, ref.jsonPath());
         }
         else
         {
             // Parameter is a value
-            resolvedObject = std::static_pointer_cast<Value>(parameter)->value();
+            resolvedObject = &std::static_pointer_cast<Value>(parameter)->value();
         }
 
         // Get value from object
-        std::optional<json::Json> resolvedValue {std::nullopt};
-
         try
         {
-            resolvedValue = resolvedObject->getJson(pointerPath);
+            if (!resolvedObject->exists(pointerPath))
+            {
+                RETURN_FAILURE(runState, event, failureTrace6);
+            }
         }
         catch (const std::exception& e)
         {
             RETURN_FAILURE(runState, event, failureTrace5 + e.what());
         }
 
-        if (!resolvedValue.has_value())
+        // A merge copies the value straight into the target, it only needs its own copy to be validated
+        std::optional<json::Json> resolvedValue {std::nullopt};
+        if (!isMerge || runValidator != nullptr)
         {
-            RETURN_FAILURE(runState, event, failureTrace6);
+            resolvedValue = resolvedObject->getJson(pointerPath);
         }
 
         if (runValidator != nullptr)
@@ -1798,7 +1862,7 @@ TransformOp opBuilderHelperGetValueGeneric(const Reference& targetField,
         {
             try
             {
-                event->merge(json::NOT_RECURSIVE, resolvedValue.value(), targetField);
+                event->merge(json::NOT_RECURSIVE, *resolvedObject, pointerPath, targetField.str());
             }
             catch (std::runtime_error& e)
             {
@@ -1,10 +1,11 @@
 #include "builders/optransform/sca.hpp"
 
 #include <algorithm>
-#include <map>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <tuple>
+#include <unordered_map>
 #include <variant>
 
 #include <logging/logging.hpp>
@@ -118,7 +119,7 @@ std::string getRealtivePath(Name field)
  */
 inline void copyIfExist(const DecodeCxt& ctx, Name field)
 {
-    const auto origin = ctx.sourcePath.at(field);
+    const auto& origin = ctx.sourcePath.at(field);
     if (ctx.event->exists(origin))
     {
         ctx.event->set(ctx.destinationPath.at(field), origin);
@@ -139,7 +140,7 @@ inline void csvStr2ArrayIfExist(const DecodeCxt& ctx, Name field)
     const auto csv = ctx.getSrcStr(field);
     if (csv)
     {
-        const auto scaArrayPath = ctx.destinationPath.at(field);
+        const auto& scaArrayPath = ctx.destinationPath.at(field);
         const auto cvaArray = base::utils::string::split(csv.value(), ',');
 
         ctx.event->setArray(scaArrayPath);
@@ -197,7 +198,7 @@ inline bool isValidEvent(const DecodeCxt& ctx, const std::vector<conditionToChec
 
     for (const auto& [field, type, mandatory] : conditions)
     {
-        const auto path = ctx.sourcePath.at(field);
+        const auto& path = ctx.sourcePath.at(field);
         if (!isValidCondition(type, path, mandatory))
         {
             return false; // Some condition is not met.
@@ -213,9 +214,9 @@ inline bool isValidEvent(const DecodeCxt& ctx, const std::vector<conditionToChec
  * @brief Get the Rule String from de code rule.
  *
  * @param ruleChar The code rule.
- * @return std::optional<std::string> The rule string.
+ * @return std::optional<std::string_view> The rule string.
  */
-inline std::optional<std::string> getRuleTypeStr(const char ruleChar)
+inline std::optional<std::string_view> getRuleTypeStr(const char ruleChar)
 {
     switch (ruleChar)
     {
@@ -293,7 +294,7 @@ bool isValidCheckEvent(const DecodeCxt& ctx)
     auto retval {true};
 
     // CheckEvent conditions list
-    const std::vector<field::conditionToCheck> listFieldConditions = {
+    static const std::vector<field::conditionToCheck> listFieldConditions = {
         {field::Name::CHECK_COMMAND, field::Type::STRING, false},
         {field::Name::CHECK_COMPLIANCE, field::Type::OBJECT, false},
         {field::Name::CHECK_CONDITION, field::Type::STRING, false},
@@ -469,7 +470,7 @@ std::optional<std::string> handleCheckEvent(const DecodeCxt& ctx)
         case SearchResult::NOT_FOUND:
         {
             // There is no previous result, save it
-            const auto rootPath = ctx.sourcePath.at(field::Name::ROOT);
+            const auto& rootPath = ctx.sourcePath.at(field::Name::ROOT);
             const auto root = ctx.event->str(rootPath).value_or("{}");
 
             saveQuery = fmt::format("agent {} sca insert {}", ctx.agentID, root);
@@ -517,7 +518,7 @@ bool isValidScanInfoEvent(const DecodeCxt& ctx)
 {
 
     // ScanInfo conditions list
-    const std::vector<field::conditionToCheck> conditions = {
+    static const std::vector<field::conditionToCheck> conditions = {
         {field::Name::POLICY_ID, field::Type::STRING, true},
         {field::Name::SCAN_ID, field::Type::INT, true},
         {field::Name::START_TIME, field::Type::INT, true},
@@ -958,7 +959,7 @@ std::tuple<std::optional<std::string>, std::string, int> isValidDumpEvent(const
 {
 
     // ScanInfo conditions list
-    const std::vector<field::conditionToCheck> conditions = {
+    static const std::vector<field::conditionToCheck> conditions = {
         {field::Name::ELEMENTS_SENT, field::Type::INT, true},
         {field::Name::POLICY_ID, field::Type::STRING, true},
         {field::Name::SCAN_ID, field::Type::INT, true},
@@ -1050,6 +1051,29 @@ std::optional<std::string> handleDumpEvent(const DecodeCxt& ctx)
 
 // - Helper - //
 
+namespace
+{
+using EventHandler = std::optional<std::string> (*)(const sca::DecodeCxt&);
+
+/**
+ * @brief Get the handler of an SCA event type.
+ *
+ * @param type Value of the `type` field of the event.
+ * @return The handler, or nullptr if the type is unknown.
+ */
+EventHandler getEventHandler(std::string_view type)
+{
+    static const std::unordered_map<std::string_view, EventHandler> handlers {
+        {sca::TYPE_CHECK, sca::handleCheckEvent},
+        {sca::TYPE_SUMMARY, sca::handleScanInfo},
+        {sca::TYPE_POLICIES, sca::handlePoliciesInfo},
+        {sca::TYPE_DUMP_END, sca::handleDumpEvent}};
+
+    const auto it = handlers.find(type);
+    return it != handlers.end() ? it->second : nullptr;
+}
+} // namespace
+
 TransformBuilder getBuilderSCAdecoder(const std::shared_ptr<wazuhdb::IWDBManager>& wdbManager,
                                       const std::shared_ptr<sockiface::ISockFactory>& sockFactory)
 {
@@ -1091,6 +1115,7 @@ TransformBuilder getBuilderSCAdecoder(const std::shared_ptr<wazuhdb::IWDBManager
                 runState = buildCtx->runState(),
                 targetField = targetField.jsonPath(),
                 sourceSCApath = jsonRef.jsonPath(),
+                typePath = jsonRef.jsonPath() + SF::getRealtivePath(SF::Name::TYPE),
                 agentIdPath = agentIdRef.jsonPath(),
                 fieldSrc = std::move(fieldSource),
                 fieldDst = std::move(fieldDest),
@@ -1106,28 +1131,16 @@ TransformBuilder getBuilderSCAdecoder(const std::shared_ptr<wazuhdb::IWDBManager
                 const auto cxt = sca::DecodeCxt {event, agentId, wdb, cfgarSock, fieldSrc, fieldDst};
 
                 // TODO: Field type is mandatory and should be checked in the decoder
-                auto type = event->getString(sourceSCApath + "/type");
+                auto type = event->getString(typePath);
                 if (!type)
                 {
                     // TODO: Change trace message
                     error = failureTrace1;
                 }
                 // Proccess event with the appropriate handler
-                else if (sca::TYPE_CHECK == type.value())
-                {
-                    error = sca::handleCheckEvent(cxt);
-                }
-                else if (sca::TYPE_SUMMARY == type.value())
-                {
-                    error = sca::handleScanInfo(cxt);
-                }
-                else if (sca::TYPE_POLICIES == type.value())
-                {
-                    error = sca::handlePoliciesInfo(cxt);
-                }
-                else if (sca::TYPE_DUMP_END == type.value())
+                else if (const auto handler = getEventHandler(type.value()); handler != nullptr)
                 {
-                    error = sca::handleDumpEvent(cxt);
+                    error = handler(cxt);
                 }
                 else
                 {
@@ -1,31 +1,98 @@
 #include "builders/optransform/windows.hpp"
 
-#include <regex>
+#include <algorithm>
+#include <cctype>
+#include <deque>
+#include <string_view>
+#include <unordered_map>
 
 using namespace builder::builders;
 
 namespace
 {
 
+/**
+ * @brief Read-only string to string table, looked up by string_view without building a key string.
+ *
+ * The views used as keys point to the strings owned by the table, so the table can't be copied or moved.
+ */
+class StringTable
+{
+private:
+    std::deque<std::string> m_keys;
+    std::unordered_map<std::string_view, std::string> m_table;
+
+public:
+    StringTable() = default;
+    StringTable(const StringTable&) = delete;
+    StringTable& operator=(const StringTable&) = delete;
+
+    void emplace(const std::string& key, std::string value)
+    {
+        if (m_table.find(key) == m_table.end())
+        {
+            m_table.emplace(m_keys.emplace_back(key), std::move(value));
+        }
+    }
+
+    const std::string* find(std::string_view key) const
+    {
+        auto it = m_table.find(key);
+        return it != m_table.end() ? &it->second : nullptr;
+    }
+
+    bool empty() const { return m_table.empty(); }
+};
+
+/**
+ * @brief Get the number between 1 and 5 digits at the end of the sid, as the relative identifier of a domain sid.
+ *
+ * @param sid The sid
+ * @return std::string_view The trailing digits, empty if the sid doesn't end with a digit
+ */
+std::string_view domainRid(std::string_view sid)
+{
+    constexpr size_t MAX_DIGITS = 5;
+
+    size_t digits = 0;
+    while (digits < sid.size() && std::isdigit(static_cast<unsigned char>(sid[sid.size() - digits - 1])))
+    {
+        ++digits;
+    }
+
+    digits = std::min(digits, MAX_DIGITS);
+    return sid.substr(sid.size() - digits);
+}
+
 /**
  * @brief Parse the list of SID, the list must be in the format:
  *
  * '%{sid1} %{sid2} %{sid3} ... ' // TODO: Check the format
  *
  * Ths function will return a vector with the sids in the same order as the input
- * or return an empty vector if the input is not valid
+ * or return an empty vector if the input is not valid. The sids are views of the input.
  * @param listSrt String with the list of sids
- * @return std::vector<std::string>
+ * @return std::vector<std::string_view>
  */
-std::vector<std::string> parserListSID(const std::string& listStr)
+std::vector<std::string_view> parserListSID(std::string_view listStr)
 {
     const char DELIMITER = ' ';
-    const std::string HEADER = "%{";
-    const std::string TAIL = "}";
-    const size_t HEADER_SIZE = HEADER.size();
-    const size_t TAIL_SIZE = TAIL.size();
+    const size_t HEADER_SIZE = 2; // '%{'
+    const size_t TAIL_SIZE = 1;   // '}'
 
-    std::vector<std::string> result = base::utils::string::split(listStr, DELIMITER); // TODO Check format
+    // Same items as base::utils::string::split // TODO Check format
+    std::vector<std::string_view> result;
+    if (!listStr.empty() && listStr[0] == DELIMITER)
+    {
+        listStr.remove_prefix(1);
+    }
+
+    while (!listStr.empty())
+    {
+        const auto pos = listStr.find(DELIMITER);
+        result.emplace_back(listStr.substr(0, pos));
+        listStr.remove_prefix(pos == listStr.npos ? listStr.size() : pos + 1);
+    }
 
     for (auto& sid : result)
     {
@@ -88,7 +155,7 @@ TransformBuilder getWindowsSidListDescHelperBuilder(const std::shared_ptr<kvdbMa
 
         // Get the lists
         auto parseDbJsonToMap = [&](const std::string& key,
-                                    const std::string& errorMsg) -> std::map<std::string, std::string>
+                                    const std::string& errorMsg) -> std::shared_ptr<const StringTable>
         {
             auto response = kvdbHandler->get(key);
             if (base::isError(response))
@@ -103,7 +170,7 @@ TransformBuilder getWindowsSidListDescHelperBuilder(const std::shared_ptr<kvdbMa
                 throw std::runtime_error(fmt::format("Error parsing {} from DB: Expected object", errorMsg));
             }
 
-            std::map<std::string, std::string> resultMap;
+            auto resultMap = std::make_shared<StringTable>();
             for (auto& [key, value] : jsonObject.value())
             {
                 auto optValue = value.getString();
@@ -112,10 +179,10 @@ TransformBuilder getWindowsSidListDescHelperBuilder(const std::shared_ptr<kvdbMa
                     throw std::runtime_error(
                         fmt::format("Error parsing {} from DB: Expected string for key '{}'", errorMsg, key));
                 }
-                resultMap.emplace(key, optValue.value());
+                resultMap->emplace(key, std::move(optValue.value()));
             }
 
-            if (resultMap.empty())
+            if (resultMap->empty())
             {
                 throw std::runtime_error(fmt::format("Error parsing {} from DB: Empty object", errorMsg));
             }
@@ -136,7 +203,6 @@ TransformBuilder getWindowsSidListDescHelperBuilder(const std::shared_ptr<kvdbMa
             fmt::format("{} -> Error parsing reference '{}' as sidList", name, sidListRef.dotPath());
         // const std::string failureItemNotString {
         //     fmt::format("[{}] -> Failure: Item in array {} is not a string", name, sidListRef)};
-        std::regex endRegex("\\d{1,5}$");
 
         // Return Op
         return [=,
@@ -161,27 +227,24 @@ TransformBuilder getWindowsSidListDescHelperBuilder(const std::shared_ptr<kvdbMa
             for (const auto& sid : sidList)
             {
 
-                auto asdIt = asdMap.find(sid);
+                const auto* asd = asdMap->find(sid);
                 bool hasDesc = false;
                 // Check if is a account sid
-                if (asdIt != asdMap.end())
+                if (asd != nullptr)
                 {
-                    event->appendString(asdIt->second, targetField);
+                    event->appendString(*asd, targetField);
                     hasDesc = true;
                 }
-                else if (base::utils::string::startsWith(sid, "S-1-5-21")) // If not found and check if is a domain
+                else if (sid.compare(0, 8, "S-1-5-21") == 0) // If not found and check if is a domain
                 {
                     // Che if sid end with a number between 1 and 5 digits
-                    std::smatch matches;
-
-                    if (std::regex_search(sid, matches, endRegex)) // If the regex matches
+                    const auto rid = domainRid(sid);
+                    if (!rid.empty())
                     {
-                        // Extraxt string from the regex match
-                        auto match = matches[0].str();
-                        auto dssIt = dssMap.find(match);
-                        if (dssIt != dssMap.end())
+                        const auto* dss = dssMap->find(rid);
+                        if (dss != nullptr)
                         {
-                            event->appendString(dssIt->second, targetField);
+                            event->appendString(*dss, targetField);
                             hasDesc = true;
                         }
                     }
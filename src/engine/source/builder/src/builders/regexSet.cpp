@@ -0,0 +1,169 @@
+#include "regexSet.hpp"
+
+#include <vector>
+
+#include <re2/set.h>
+
+#include <logging/logging.hpp>
+
+namespace builder::builders
+{
+
+namespace
+{
+constexpr std::size_t CACHED_VALUES = 8; ///< Values whose matches are kept by each thread
+
+std::atomic<uint64_t> g_nextId {0};
+
+RE2::Options setOptions()
+{
+    RE2::Options options(RE2::Quiet);
+    options.set_max_mem(REGEX_SET_MAX_MEM);
+    return options;
+}
+
+/**
+ * @brief The matches of a set against a value.
+ */
+struct CachedMatches
+{
+    uint64_t setId {0};           ///< Set matched, 0 if the entry is empty
+    std::string value;            ///< Value matched
+    std::vector<bool> matches {}; ///< Patterns that matched the value
+};
+
+/**
+ * @brief The last matches of each thread, replaced in round robin.
+ */
+struct MatchesCache
+{
+    std::vector<CachedMatches> entries = std::vector<CachedMatches>(CACHED_VALUES);
+    std::size_t next {0};
+};
+
+thread_local MatchesCache t_cache {};
+} // namespace
+
+class RegexSet::Patterns
+{
+public:
+    RE2::Set m_set; ///< Unanchored, as RE2::PartialMatch
+
+    Patterns()
+        : m_set(setOptions(), RE2::UNANCHORED)
+    {
+    }
+};
+
+RegexSet::RegexSet()
+    : m_id(++g_nextId)
+    , m_mutex()
+    , m_patterns(std::make_unique<Patterns>())
+    , m_size(0)
+    , m_state(State::OPEN)
+{
+}
+
+RegexSet::~RegexSet() = default;
+
+std::optional<std::size_t> RegexSet::add(const std::string& pattern)
+{
+    std::lock_guard lock {m_mutex};
+    if (m_state.load() != State::OPEN || m_size >= REGEX_SET_MAX_PATTERNS)
+    {
+        return std::nullopt;
+    }
+
+    std::string error;
+    const auto index = m_patterns->m_set.Add(pattern, &error);
+    if (index < 0)
+    {
+        return std::nullopt;
+    }
+
+    ++m_size;
+    return static_cast<std::size_t>(index);
+}
+
+bool RegexSet::compile()
+{
+    std::lock_guard lock {m_mutex};
+    if (m_state.load() == State::OPEN)
+    {
+        if (m_patterns->m_set.Compile())
+        {
+            m_state.store(State::COMPILED);
+        }
+        else
+        {
+            LOG_WARNING("Cannot compile a set of {} regular expressions, they are matched one by one", m_size);
+            m_state.store(State::FAILED);
+        }
+    }
+
+    return m_state.load() == State::COMPILED;
+}
+
+std::optional<bool> RegexSet::matches(std::string_view value, std::size_t index)
+{
+    const auto state = m_state.load(std::memory_order_acquire);
+    if (state == State::FAILED || (state == State::OPEN && !compile()))
+    {
+        return std::nullopt;
+    }
+
+    for (const auto& entry : t_cache.entries)
+    {
+        if (entry.setId == m_id && entry.value == value)
+        {
+            return entry.matches[index];
+        }
+    }
+
+    std::vector<int> matched;
+    RE2::Set::ErrorInfo errorInfo;
+    const re2::StringPiece text(value.data(), value.size());
+    if (!m_patterns->m_set.Match(text, &matched, &errorInfo) && errorInfo.kind != RE2::Set::kNoError)
+    {
+        // Out of memory for the automaton, the helpers keep their own regex as fallback
+        LOG_WARNING("Cannot match a set of {} regular expressions, they are matched one by one", m_size);
+        m_state.store(State::FAILED);
+        return std::nullopt;
+    }
+
+    auto& entry = t_cache.entries[t_cache.next];
+    t_cache.next = (t_cache.next + 1) % t_cache.entries.size();
+    entry.setId = m_id;
+    entry.value.assign(value);
+    entry.matches.assign(m_size, false);
+    for (const auto i : matched)
+    {
+        entry.matches[i] = true;
+    }
+
+    return entry.matches[index];
+}
+
+std::pair<std::shared_ptr<RegexSet>, std::size_t> RegexSets::add(const std::string& field, const std::string& pattern)
+{
+    std::lock_guard lock {m_mutex};
+    auto& set = m_open[field];
+    if (set)
+    {
+        if (auto index = set->add(pattern); index)
+        {
+            return {set, index.value()};
+        }
+    }
+
+    // The set is compiled or full, start a new one
+    set = std::make_shared<RegexSet>();
+    if (auto index = set->add(pattern); index)
+    {
+        return {set, index.value()};
+    }
+
+    return {nullptr, 0};
+}
+
+} // namespace builder::builders
@@ -0,0 +1,112 @@
+#ifndef _BUILDER_BUILDERS_REGEXSET_HPP
+#define _BUILDER_BUILDERS_REGEXSET_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace builder::builders
+{
+
+constexpr std::size_t REGEX_SET_MAX_PATTERNS = 512;     ///< Patterns of a set, a new set is started when it is full
+constexpr int64_t REGEX_SET_MAX_MEM = 64 * 1024 * 1024; ///< Memory budget of the automaton of a set
+
+/**
+ * @brief A group of regular expressions matched against the same field in a single scan.
+ *
+ * The helpers add their pattern while the policy is built, and the set is compiled on the first match, after that
+ * no more patterns are accepted. The matches of the last values are cached per thread, so the siblings checking
+ * the same value only scan it once.
+ */
+class RegexSet
+{
+private:
+    enum class State
+    {
+        OPEN,     ///< Accepting patterns
+        COMPILED, ///< Ready to match
+        FAILED    ///< The set cannot be used, the helpers use their own regex
+    };
+
+    class Patterns; ///< The RE2 set, it is kept out of the header so the users do not need the RE2 headers
+
+    const uint64_t m_id;                  ///< Unique id, identifies the matches of the set in the thread cache
+    std::mutex m_mutex;                   ///< Protects the patterns and the compilation
+    std::unique_ptr<Patterns> m_patterns; ///< The patterns
+    std::size_t m_size;                   ///< Number of patterns
+    std::atomic<State> m_state;           ///< Compilation state
+
+    /**
+     * @brief Compile the set if it is still open.
+     *
+     * @return true if the set can be used.
+     */
+    bool compile();
+
+public:
+    RegexSet();
+    ~RegexSet();
+
+    RegexSet(const RegexSet&) = delete;
+    RegexSet& operator=(const RegexSet&) = delete;
+
+    /**
+     * @brief Add a pattern to the set.
+     *
+     * @param pattern The regular expression, matched as RE2::PartialMatch does.
+     * @return std::optional<std::size_t> The index of the pattern, empty if the set is already compiled, full or the
+     * pattern cannot be added.
+     */
+    std::optional<std::size_t> add(const std::string& pattern);
+
+    /**
+     * @brief Check if a pattern of the set matches the value.
+     *
+     * The whole set is matched against the value, and the result is reused by the next calls with the same value.
+     * @param value The value to match.
+     * @param index The index of the pattern.
+     * @return std::optional<bool> empty if the set cannot be used (i.e. it ran out of memory).
+     */
+    std::optional<bool> matches(std::string_view value, std::size_t index);
+
+    /**
+     * @brief Get the number of patterns of the set.
+     *
+     * @return std::size_t
+     */
+    std::size_t size() const { return m_size; }
+};
+
+/**
+ * @brief The regex sets of a policy build, one open set per field.
+ *
+ * It is shared by the build contexts of all the assets of the policy.
+ */
+class RegexSets
+{
+private:
+    std::mutex m_mutex;                                                ///< Protects the open sets
+    std::unordered_map<std::string, std::shared_ptr<RegexSet>> m_open; ///< Set being filled for each field
+
+public:
+    /**
+     * @brief Add a pattern to the open set of the field, starting a new set if it does not accept more patterns.
+     *
+     * @param field The field the pattern is matched against.
+     * @param pattern The regular expression.
+     * @return std::pair<std::shared_ptr<RegexSet>, std::size_t> The set and the index of the pattern, the set is
+     * null if the pattern cannot be grouped.
+     */
+    std::pair<std::shared_ptr<RegexSet>, std::size_t> add(const std::string& field, const std::string& pattern);
+};
+
+} // namespace builder::builders
+
+#endif // _BUILDER_BUILDERS_REGEXSET_HPP
@@ -0,0 +1,115 @@
+#include "bulkClient.hpp"
+
+#include <mutex>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include <logging/logging.hpp>
+
+namespace builder::builders::detail
+{
+
+namespace
+{
+constexpr auto BULK_PATH = "/_bulk";
+constexpr auto BULK_ERRORS = R"("errors":true)"; ///< Set in the response if the indexer rejected documents
+
+std::size_t writeCallback(void* contents, std::size_t size, std::size_t nmemb, std::string* response)
+{
+    response->append(static_cast<char*>(contents), size * nmemb);
+    return size * nmemb;
+}
+} // namespace
+
+CurlBulkClient::CurlBulkClient(const IndexerConnection& connection)
+    : m_url()
+    , m_connection(connection)
+    , m_curl(nullptr)
+    , m_headers(nullptr)
+    , m_gzipHeaders(nullptr)
+{
+    if (m_connection.url.empty())
+    {
+        throw std::runtime_error("The url of the indexer is empty");
+    }
+
+    auto base = m_connection.url;
+    while (!base.empty() && base.back() == '/')
+    {
+        base.pop_back();
+    }
+    m_url = base + BULK_PATH;
+
+    static std::once_flag curlInit;
+    std::call_once(curlInit, []() { curl_global_init(CURL_GLOBAL_DEFAULT); });
+
+    m_curl = curl_easy_init();
+    if (m_curl == nullptr)
+    {
+        throw std::runtime_error("Could not initialize the indexer client");
+    }
+
+    m_headers = curl_slist_append(m_headers, "Content-Type: application/x-ndjson");
+    m_gzipHeaders = curl_slist_append(m_gzipHeaders, "Content-Type: application/x-ndjson");
+    m_gzipHeaders = curl_slist_append(m_gzipHeaders, "Content-Encoding: gzip");
+
+    curl_easy_setopt(m_curl, CURLOPT_URL, m_url.c_str());
+    curl_easy_setopt(m_curl, CURLOPT_POST, 1L);
+    curl_easy_setopt(m_curl, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(m_curl, CURLOPT_TIMEOUT, static_cast<long>(BULK_REQUEST_TIMEOUT.count()));
+    curl_easy_setopt(m_curl, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(m_curl, CURLOPT_SSL_VERIFYPEER, 1L);
+    curl_easy_setopt(m_curl, CURLOPT_SSL_VERIFYHOST, 2L);
+    curl_easy_setopt(m_curl, CURLOPT_WRITEFUNCTION, writeCallback);
+    if (!m_connection.caFile.empty())
+    {
+        curl_easy_setopt(m_curl, CURLOPT_CAINFO, m_connection.caFile.c_str());
+    }
+    if (!m_connection.username.empty())
+    {
+        curl_easy_setopt(m_curl, CURLOPT_HTTPAUTH, CURLAUTH_BASIC);
+        curl_easy_setopt(m_curl, CURLOPT_USERNAME, m_connection.username.c_str());
+        curl_easy_setopt(m_curl, CURLOPT_PASSWORD, m_connection.password.c_str());
+    }
+}
+
+CurlBulkClient::~CurlBulkClient()
+{
+    curl_slist_free_all(m_headers);
+    curl_slist_free_all(m_gzipHeaders);
+    curl_easy_cleanup(m_curl);
+}
+
+bool CurlBulkClient::send(const std::string& body, bool gzip)
+{
+    std::string response;
+    curl_easy_setopt(m_curl, CURLOPT_HTTPHEADER, gzip ? m_gzipHeaders : m_headers);
+    curl_easy_setopt(m_curl, CURLOPT_POSTFIELDS, body.data());
+    curl_easy_setopt(m_curl, CURLOPT_POSTFIELDSIZE_LARGE, static_cast<curl_off_t>(body.size()));
+    curl_easy_setopt(m_curl, CURLOPT_WRITEDATA, &response);
+
+    const auto res = curl_easy_perform(m_curl);
+    if (res != CURLE_OK)
+    {
+        LOG_WARNING("Indexer output cannot send a bulk to '{}': {}", m_url, curl_easy_strerror(res));
+        return false;
+    }
+
+    long status = 0;
+    curl_easy_getinfo(m_curl, CURLINFO_RESPONSE_CODE, &status);
+    if (status < 200 || status >= 300)
+    {
+        LOG_WARNING("Indexer output bulk to '{}' failed with status {}: {}", m_url, status, response.substr(0, 512));
+        return false;
+    }
+
+    if (response.find(BULK_ERRORS) != std::string::npos)
+    {
+        LOG_WARNING("Indexer output bulk to '{}' has rejected documents: {}", m_url, response.substr(0, 512));
+    }
+
+    return true;
+}
+
+} // namespace builder::builders::detail
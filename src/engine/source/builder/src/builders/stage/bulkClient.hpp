@@ -0,0 +1,73 @@
+#ifndef _BUILDER_BUILDERS_STAGE_BULKCLIENT_HPP
+#define _BUILDER_BUILDERS_STAGE_BULKCLIENT_HPP
+
+#include <chrono>
+#include <string>
+
+#include <curl/curl.h>
+
+#include <builder/indexerConnection.hpp>
+
+namespace builder::builders::detail
+{
+
+constexpr std::chrono::seconds BULK_REQUEST_TIMEOUT {30}; ///< Maximum time a bulk request takes
+
+/**
+ * @brief Sends bulk requests to the indexer.
+ */
+class IBulkClient
+{
+public:
+    virtual ~IBulkClient() = default;
+
+    /**
+     * @brief Send the body of a bulk request.
+     *
+     * @param body The actions and documents, in the bulk format (new line delimited).
+     * @param gzip The body is gzipped.
+     * @return true if the indexer acknowledged the request, false if it must be sent again.
+     */
+    virtual bool send(const std::string& body, bool gzip) = 0;
+};
+
+/**
+ * @brief Bulk client over libcurl.
+ *
+ * The curl handle is kept between the requests, so the connection to the indexer is reused. It must only be used by
+ * one thread at a time.
+ *
+ * The indexer acknowledges a request with a 2xx status. The documents the indexer rejects in an acknowledged request
+ * (e.g. mapping errors) are logged and not sent again, as sending them again would fail the same way.
+ */
+class CurlBulkClient : public IBulkClient
+{
+private:
+    std::string m_url;              ///< Url of the bulk endpoint
+    IndexerConnection m_connection; ///< Connection to the indexer
+    CURL* m_curl;                   ///< The curl handle
+    curl_slist* m_headers;          ///< Headers of the plain requests
+    curl_slist* m_gzipHeaders;      ///< Headers of the gzipped requests
+
+public:
+    /**
+     * @brief Construct a new Curl Bulk Client.
+     *
+     * @param connection Connection to the indexer.
+     * @throw std::runtime_error if the url is empty or curl cannot be initialized.
+     */
+    explicit CurlBulkClient(const IndexerConnection& connection);
+    ~CurlBulkClient();
+
+    CurlBulkClient(const CurlBulkClient&) = delete;
+    CurlBulkClient& operator=(const CurlBulkClient&) = delete;
+
+    /**
+     * @copydoc IBulkClient::send
+     */
+    bool send(const std::string& body, bool gzip) override;
+};
+
+} // namespace builder::builders::detail
+
+#endif // _BUILDER_BUILDERS_STAGE_BULKCLIENT_HPP
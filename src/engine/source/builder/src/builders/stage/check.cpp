@@ -1,6 +1,8 @@
 #include "check.hpp"
 
 #include <algorithm>
+#include <string_view>
+#include <unordered_map>
 
 #include <regex>
 
@@ -84,6 +86,37 @@ getTermBuilder(const std::shared_ptr<const IBuildCtx>& buildCtx)
     };
 }
 
+/**
+ * @brief Static cost of a filter helper, relative to reading and comparing a field, used to order the terms of the
+ * expression before any event is seen.
+ */
+double helperCost(const parsers::HelperToken& token)
+{
+    static const std::unordered_map<std::string_view, double> costs {{"binary_and", 2},
+                                                                     {"starts_with", 2},
+                                                                     {"contains", 3},
+                                                                     {"contains_all", 3},
+                                                                     {"ip_cidr_match", 3},
+                                                                     {"is_public_ip", 3},
+                                                                     {"contains_any", 4},
+                                                                     {"contains_any_insensitive", 4},
+                                                                     {"array_contains", 4},
+                                                                     {"array_contains_any", 4},
+                                                                     {"array_not_contains", 4},
+                                                                     {"array_not_contains_any", 4},
+                                                                     {"ip_cidr_match_any", 4},
+                                                                     {"match_value", 4},
+                                                                     {"exists_key_in", 4},
+                                                                     {"regex_match", 20},
+                                                                     {"regex_not_match", 20},
+                                                                     {"kvdb_match", 50},
+                                                                     {"kvdb_not_match", 50},
+                                                                     {"kvdb_cidr_match", 50}};
+
+    const auto it = costs.find(token.name);
+    return it != costs.end() ? it->second : logicexpr::evaluator::DEFAULT_TERM_COST;
+}
+
 base::Expression checkExpressionBuilder(const std::string& logicExpr, const std::shared_ptr<const IBuildCtx>& buildCtx)
 {
     std::function<bool(base::Event)> evaluator;
@@ -92,8 +125,8 @@ base::Expression checkExpressionBuilder(const std::string& logicExpr, const std:
         // Apply definitions
         auto replacedExpr = buildCtx->definitions().replace(logicExpr);
         // TODO: make a factory and inject this dependency
-        evaluator = logicexpr::buildDijstraEvaluator<base::Event, parsers::HelperToken>(
-            replacedExpr, getTermBuilder(buildCtx), parsers::getTermParser());
+        evaluator = logicexpr::buildAdaptiveEvaluator<base::Event, parsers::HelperToken>(
+            replacedExpr, getTermBuilder(buildCtx), parsers::getTermParser(), helperCost);
     }
     catch (const std::exception& e)
     {
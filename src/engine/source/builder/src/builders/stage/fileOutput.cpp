@@ -1,8 +1,10 @@
 #include "fileOutput.hpp"
 
 #include <memory>
+#include <optional>
 #include <stdexcept>
 
+#include "builders/stage/outputBuffer.hpp"
 #include "builders/utils.hpp"
 
 namespace builder::builders
@@ -16,45 +18,95 @@ base::Expression fileOutputBuilder(const json::Json& definition, const std::shar
             "Stage '{}' expects an object but got '{}'", syntax::asset::FILE_OUTPUT_KEY, definition.typeName()));
     }
 
-    if (definition.size() != 1)
+    auto outputObj = definition.getObject().value();
+
+    std::optional<std::string> path;
+    detail::FileWriterOptions options;
+    for (const auto& [key, value] : outputObj)
     {
-        throw std::runtime_error(fmt::format("Stage '{}' expects an object with one key but got '{}'",
-                                             syntax::asset::FILE_OUTPUT_KEY,
-                                             definition.size()));
+        if (key == syntax::asset::FILE_OUTPUT_PATH_KEY)
+        {
+            if (!value.isString())
+            {
+                throw std::runtime_error(
+                    fmt::format("Stage '{}' expects an object with key '{}' to be a string but got '{}'",
+                                syntax::asset::FILE_OUTPUT_KEY,
+                                syntax::asset::FILE_OUTPUT_PATH_KEY,
+                                value.typeName()));
+            }
+            path = value.getString().value();
+        }
+        else if (key == syntax::asset::FILE_OUTPUT_MAX_SIZE_KEY)
+        {
+            if (!value.isInt64() || value.getInt64().value() <= 0)
+            {
+                throw std::runtime_error(
+                    fmt::format("Stage '{}' expects an object with key '{}' to be a positive integer but got '{}'",
+                                syntax::asset::FILE_OUTPUT_KEY,
+                                syntax::asset::FILE_OUTPUT_MAX_SIZE_KEY,
+                                value.str()));
+            }
+            options.maxSize = static_cast<std::size_t>(value.getInt64().value());
+        }
+        else if (key == syntax::asset::FILE_OUTPUT_COMPRESS_KEY)
+        {
+            if (!value.isBool())
+            {
+                throw std::runtime_error(
+                    fmt::format("Stage '{}' expects an object with key '{}' to be a boolean but got '{}'",
+                                syntax::asset::FILE_OUTPUT_KEY,
+                                syntax::asset::FILE_OUTPUT_COMPRESS_KEY,
+                                value.typeName()));
+            }
+            options.compress = value.getBool().value();
+        }
+        else
+        {
+            throw std::runtime_error(fmt::format("Stage '{}' expects an object with key '{}' but got '{}'",
+                                                 syntax::asset::FILE_OUTPUT_KEY,
+                                                 syntax::asset::FILE_OUTPUT_PATH_KEY,
+                                                 key));
+        }
     }
 
-    auto outputObj = definition.getObject().value();
-
-    const auto& [key, value] = *outputObj.begin();
-    if (key != syntax::asset::FILE_OUTPUT_PATH_KEY)
+    if (!path)
     {
-        throw std::runtime_error(fmt::format("Stage '{}' expects an object with key '{}' but got '{}'",
+        throw std::runtime_error(fmt::format("Stage '{}' expects an object with key '{}'",
                                              syntax::asset::FILE_OUTPUT_KEY,
-                                             syntax::asset::FILE_OUTPUT_PATH_KEY,
-                                             key));
+                                             syntax::asset::FILE_OUTPUT_PATH_KEY));
     }
 
-    if (!value.isString())
+    if (options.compress && options.maxSize == 0)
     {
-        throw std::runtime_error(fmt::format("Stage '{}' expects an object with key '{}' to be a string but got '{}'",
+        throw std::runtime_error(fmt::format("Stage '{}' only compresses the rotated files, '{}' needs '{}'",
                                              syntax::asset::FILE_OUTPUT_KEY,
-                                             syntax::asset::FILE_OUTPUT_PATH_KEY,
-                                             value.typeName()));
+                                             syntax::asset::FILE_OUTPUT_COMPRESS_KEY,
+                                             syntax::asset::FILE_OUTPUT_MAX_SIZE_KEY));
     }
 
-    auto path = value.getString().value();
-    auto filePtr = std::make_shared<detail::FileOutput>(path);
-    auto name = fmt::format("write.output({})", path);
+    auto filePtr = std::make_shared<detail::FileOutput>(path.value(), options);
+    auto name = fmt::format("write.output({})", path.value());
     const auto successTrace = fmt::format("{} -> Success", name);
     const auto failureTrace = fmt::format("{} -> Could not write event to output", name);
 
     return base::Term<base::EngineOp>::create(name,
-                                              [filePtr, successTrace, failureTrace, runState = buildCtx->runState()](
+                                              [filePtr,
+                                               successTrace,
+                                               failureTrace,
+                                               runState = buildCtx->runState(),
+                                               outputBuffer = buildCtx->outputBuffer()](
                                                   base::Event event) -> base::result::Result<base::Event>
                                               {
                                                   try
                                                   {
-                                                      filePtr->write(event);
+                                                      if (outputBuffer)
+                                                      {
+                                                          filePtr->write(outputBuffer->get(event));
+                                                      }
+                                                      else
+                                                      {
+                                                          filePtr->write(event);
+                                                      }
                                                       RETURN_SUCCESS(runState, event, successTrace);
                                                   }
                                                   catch (const std::exception& e)
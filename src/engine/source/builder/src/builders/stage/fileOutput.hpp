@@ -1,13 +1,12 @@
 #ifndef _BUILDER_BUILDERS_STAGE_FILEOUTPUT_HPP
 #define _BUILDER_BUILDERS_STAGE_FILEOUTPUT_HPP
 
-#include <filesystem>
-#include <fstream>
-#include <iostream>
+#include <memory>
 #include <string>
 
 #include <fmt/format.h>
 
+#include "builders/stage/fileWriter.hpp"
 #include "builders/types.hpp"
 
 namespace builder::builders
@@ -17,48 +16,46 @@ namespace detail
 {
 /**
  * @brief implements a subscriber which will save all received events
- * of type E into a file. Needed to implement Destructor to close file.
+ * of type E into a file. The events are written by the writer thread of the file, shared by all its outputs.
  *
  *
  */
 class FileOutput
 {
 protected:
-    std::ofstream m_os;
+    std::shared_ptr<FileWriter> m_writer;
 
 public:
     /**
      * @brief Construct a new File Output object
      *
      * @param path file to store the events received
+     * @param options options of the writer, if no other output writes to the file yet
      */
-    explicit FileOutput(const std::string& path)
-        : m_os {path, std::ios::out | std::ios::app | std::ios::binary}
+    explicit FileOutput(const std::string& path, const FileWriterOptions& options = {})
+        : m_writer {FileWriter::get(path, options)}
     {
-        if (!this->m_os)
-        {
-            throw std::invalid_argument(fmt::format("Could not open file {}", path));
-        }
     }
 
     /**
-     * @brief Closes file if open
+     * @brief Queue the event string to be written to the file
      *
+     * @param e
      */
-    ~FileOutput()
-    {
-        if (this->m_os.is_open())
-        {
-            this->m_os.close();
-        }
-    }
+    void write(base::ConstEvent e) { m_writer->write(e->str()); }
 
     /**
-     * @brief Write event string to file
+     * @brief Queue the event already serialized to be written to the file
+     *
+     * @param str
+     */
+    void write(std::shared_ptr<const std::string> str) { m_writer->write(std::move(str)); }
+
+    /**
+     * @brief Wait until the events written so far are in the file
      *
-     * @param e
      */
-    void write(base::ConstEvent e) { this->m_os << e->str() << std::endl; }
+    void flush() { m_writer->flush(); }
 };
 } // namespace detail
 
@@ -0,0 +1,429 @@
+#include "fileWriter.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <fmt/format.h>
+
+#include <logging/logging.hpp>
+
+namespace builder::builders::detail
+{
+
+namespace
+{
+constexpr std::size_t MAX_IOVECS = 1024; ///< Buffers written by a single writev, IOV_MAX on Linux
+constexpr char NEW_LINE = '\n';
+constexpr std::size_t GZIP_CHUNK = 1 << 16;
+
+int openFile(const std::string& path)
+{
+    return ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0666);
+}
+
+/**
+ * @brief Gzip a file next to it and remove it.
+ */
+void compressFile(const std::string& path)
+{
+    const auto gzPath = path + ".gz";
+    auto in = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (in < 0)
+    {
+        LOG_ERROR("File output cannot open '{}' to compress it: {}", path, std::strerror(errno));
+        return;
+    }
+
+    auto out = gzopen(gzPath.c_str(), "wb");
+    if (out == nullptr)
+    {
+        LOG_ERROR("File output cannot create '{}'", gzPath);
+        ::close(in);
+        return;
+    }
+
+    std::vector<char> chunk(GZIP_CHUNK);
+    bool failed = false;
+    ssize_t read;
+    while ((read = ::read(in, chunk.data(), chunk.size())) > 0)
+    {
+        if (gzwrite(out, chunk.data(), static_cast<unsigned>(read)) != read)
+        {
+            failed = true;
+            break;
+        }
+    }
+    failed = failed || read < 0;
+
+    ::close(in);
+    if (gzclose(out) != Z_OK || failed)
+    {
+        LOG_ERROR("File output cannot compress '{}'", path);
+        std::error_code ec;
+        std::filesystem::remove(gzPath, ec);
+        return;
+    }
+
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+}
+} // namespace
+
+MPSCRing::MPSCRing(std::size_t capacity)
+    : m_cells()
+    , m_mask(0)
+    , m_tail(0)
+    , m_head(0)
+{
+    std::size_t size = 2;
+    while (size < capacity)
+    {
+        size <<= 1;
+    }
+
+    m_cells = std::make_unique<Cell[]>(size);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    m_mask = size - 1;
+}
+
+bool MPSCRing::push(std::shared_ptr<const std::string>& value)
+{
+    auto pos = m_tail.load(std::memory_order_relaxed);
+    while (true)
+    {
+        auto& cell = m_cells[pos & m_mask];
+        const auto sequence = cell.sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+        if (diff == 0)
+        {
+            // The cell is free for this position, claim it
+            if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                cell.value = std::move(value);
+                cell.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (diff < 0)
+        {
+            // The consumer did not free the cell of the previous lap yet
+            return false;
+        }
+        else
+        {
+            pos = m_tail.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool MPSCRing::empty() const
+{
+    return m_cells[m_head & m_mask].sequence.load(std::memory_order_acquire) != m_head + 1;
+}
+
+bool MPSCRing::pop(std::shared_ptr<const std::string>& value)
+{
+    auto& cell = m_cells[m_head & m_mask];
+    if (cell.sequence.load(std::memory_order_acquire) != m_head + 1)
+    {
+        return false;
+    }
+
+    value = std::move(cell.value);
+    cell.value.reset();
+    cell.sequence.store(m_head + m_mask + 1, std::memory_order_release);
+    ++m_head;
+    return true;
+}
+
+std::shared_ptr<FileWriter> FileWriter::get(const std::string& path, const FileWriterOptions& options)
+{
+    static std::mutex mutex;
+    static std::map<std::string, std::weak_ptr<FileWriter>> writers;
+
+    const auto key = std::filesystem::absolute(path).lexically_normal().string();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto writer = writers[key].lock();
+    if (writer == nullptr)
+    {
+        writer = std::make_shared<FileWriter>(path, options);
+        writers[key] = writer;
+    }
+
+    // Drop the files no longer written
+    for (auto it = writers.begin(); it != writers.end();)
+    {
+        it = it->second.expired() ? writers.erase(it) : std::next(it);
+    }
+
+    return writer;
+}
+
+FileWriter::FileWriter(const std::string& path, const FileWriterOptions& options)
+    : m_path(path)
+    , m_options(options)
+    , m_fd(openFile(path))
+    , m_fileSize(0)
+    , m_ring(options.capacity)
+    , m_queued(0)
+    , m_sleeping(false)
+    , m_flushWanted(false)
+    , m_running(true)
+    , m_mutex()
+    , m_wakeCv()
+    , m_doneCv()
+    , m_written(0)
+    , m_thread()
+{
+    if (m_fd < 0)
+    {
+        throw std::invalid_argument(fmt::format("Could not open file {}", path));
+    }
+
+    struct stat st;
+    if (::fstat(m_fd, &st) == 0)
+    {
+        m_fileSize = static_cast<std::size_t>(st.st_size);
+    }
+
+    m_thread = std::thread(&FileWriter::run, this);
+}
+
+FileWriter::~FileWriter()
+{
+    m_running.store(false);
+    wake();
+    m_thread.join();
+
+    if (m_fd >= 0)
+    {
+        ::close(m_fd);
+    }
+}
+
+void FileWriter::wake()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_wakeCv.notify_one();
+}
+
+void FileWriter::write(std::string&& line)
+{
+    write(std::make_shared<const std::string>(std::move(line)));
+}
+
+void FileWriter::write(std::shared_ptr<const std::string> line)
+{
+    while (!m_ring.push(line))
+    {
+        // Full, wait for the writer thread to catch up
+        wake();
+        std::this_thread::yield();
+    }
+    m_queued.fetch_add(1, std::memory_order_release);
+
+    // Pairs with the fence of the thread going to sleep, one of both sees the other
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_sleeping.load(std::memory_order_relaxed))
+    {
+        wake();
+    }
+}
+
+void FileWriter::flush()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    const auto target = m_queued.load(std::memory_order_acquire);
+    m_flushWanted.store(true);
+    m_wakeCv.notify_one();
+    m_doneCv.wait(lock, [this, target]() { return m_written >= target; });
+}
+
+void FileWriter::run()
+{
+    std::vector<std::shared_ptr<const std::string>> batch;
+    std::size_t batchBytes = 0;
+    auto oldest = std::chrono::steady_clock::now();
+    std::shared_ptr<const std::string> line;
+
+    const auto take = [&](std::size_t maxBytes)
+    {
+        bool popped = false;
+        while (batchBytes < maxBytes && m_ring.pop(line))
+        {
+            if (batch.empty())
+            {
+                oldest = std::chrono::steady_clock::now();
+            }
+            batchBytes += line->size() + 1;
+            batch.emplace_back(std::move(line));
+            popped = true;
+        }
+        return popped;
+    };
+
+    while (true)
+    {
+        const auto popped = take(m_options.flushBytes);
+
+        // A flush or the stop write everything queued
+        const auto stopping = !m_running.load();
+        const auto flushWanted = m_flushWanted.exchange(false);
+        if (stopping || flushWanted)
+        {
+            take(SIZE_MAX);
+        }
+
+        if (!batch.empty()
+            && (stopping || flushWanted || batchBytes >= m_options.flushBytes
+                || std::chrono::steady_clock::now() - oldest >= m_options.flushInterval))
+        {
+            const auto count = batch.size();
+            writeBatch(batch);
+            batch.clear();
+            batchBytes = 0;
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_written += count;
+            m_doneCv.notify_all();
+        }
+        else if (flushWanted)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_doneCv.notify_all();
+        }
+
+        if (stopping)
+        {
+            break;
+        }
+
+        if (!popped)
+        {
+            // Sleep until a line is queued or the oldest buffered one must be written
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_sleeping.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (m_running.load() && !m_flushWanted.load() && m_ring.empty())
+            {
+                auto timeout = m_options.flushInterval;
+                if (!batch.empty())
+                {
+                    timeout -= std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now()
+                                                                                     - oldest);
+                }
+                m_wakeCv.wait_for(lock, std::max(timeout, std::chrono::milliseconds {1}));
+            }
+            m_sleeping.store(false, std::memory_order_relaxed);
+        }
+    }
+}
+
+void FileWriter::writeBatch(std::vector<std::shared_ptr<const std::string>>& batch)
+{
+    // The lines may be shared with other outputs, the new lines are written from their own buffer
+    constexpr auto maxLines = MAX_IOVECS / 2;
+    std::vector<struct iovec> iovecs;
+    iovecs.reserve(std::min(batch.size(), maxLines) * 2);
+
+    for (std::size_t first = 0; first < batch.size(); first += maxLines)
+    {
+        const auto last = std::min(first + maxLines, batch.size());
+        iovecs.clear();
+        std::size_t bytes = 0;
+        for (auto i = first; i < last; ++i)
+        {
+            iovecs.push_back({const_cast<char*>(batch[i]->data()), batch[i]->size()});
+            iovecs.push_back({const_cast<char*>(&NEW_LINE), 1});
+            bytes += batch[i]->size() + 1;
+        }
+
+        // Resume the partial writes where they stopped
+        std::size_t done = 0;
+        std::size_t iov = 0;
+        while (done < bytes)
+        {
+            const auto written = ::writev(m_fd, iovecs.data() + iov, static_cast<int>(iovecs.size() - iov));
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                LOG_ERROR("File output cannot write to '{}': {}", m_path, std::strerror(errno));
+                return;
+            }
+
+            done += static_cast<std::size_t>(written);
+            m_fileSize += static_cast<std::size_t>(written);
+            auto left = static_cast<std::size_t>(written);
+            while (iov < iovecs.size() && left >= iovecs[iov].iov_len)
+            {
+                left -= iovecs[iov].iov_len;
+                ++iov;
+            }
+            if (left > 0)
+            {
+                iovecs[iov].iov_base = static_cast<char*>(iovecs[iov].iov_base) + left;
+                iovecs[iov].iov_len -= left;
+            }
+        }
+    }
+
+    if (m_options.maxSize > 0 && m_fileSize >= m_options.maxSize)
+    {
+        rotate();
+    }
+}
+
+void FileWriter::rotate()
+{
+    const auto now =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch());
+    auto rotated = fmt::format("{}.{}", m_path, now.count());
+    for (auto n = 1; std::filesystem::exists(rotated) || std::filesystem::exists(rotated + ".gz"); ++n)
+    {
+        rotated = fmt::format("{}.{}.{}", m_path, now.count(), n);
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(m_path, rotated, ec);
+    if (ec)
+    {
+        LOG_ERROR("File output cannot rotate '{}': {}", m_path, ec.message());
+        return;
+    }
+
+    auto fd = openFile(m_path);
+    if (fd < 0)
+    {
+        // Keep appending to the rotated file rather than losing events
+        LOG_ERROR("File output cannot reopen '{}': {}", m_path, std::strerror(errno));
+        return;
+    }
+    ::close(m_fd);
+    m_fd = fd;
+    m_fileSize = 0;
+
+    if (m_options.compress)
+    {
+        compressFile(rotated);
+    }
+}
+
+} // namespace builder::builders::detail
@@ -0,0 +1,175 @@
+#ifndef _BUILDER_BUILDERS_STAGE_FILEWRITER_HPP
+#define _BUILDER_BUILDERS_STAGE_FILEWRITER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace builder::builders::detail
+{
+
+constexpr std::size_t DEFAULT_WRITER_CAPACITY = 1 << 16;           ///< Events queued before the producers wait
+constexpr std::size_t DEFAULT_WRITER_FLUSH_BYTES = 1 << 20;        ///< Bytes buffered before they are written
+constexpr std::chrono::milliseconds DEFAULT_WRITER_FLUSH_MS {200}; ///< Maximum time an event stays buffered
+
+/**
+ * @brief Bounded lock-free queue of shared strings, with many producers and a single consumer.
+ *
+ * Each cell has a sequence number telling whether it is free for the producer of a position or ready for the
+ * consumer, so producers only contend on the tail index.
+ */
+class MPSCRing
+{
+public:
+    /**
+     * @brief Construct a new MPSCRing object
+     *
+     * @param capacity Number of cells, rounded up to a power of two.
+     */
+    explicit MPSCRing(std::size_t capacity);
+
+    /**
+     * @brief Add a string, from any thread.
+     *
+     * @param value The string, moved only if it is added.
+     * @return false if the ring is full.
+     */
+    bool push(std::shared_ptr<const std::string>& value);
+
+    /**
+     * @brief Take the oldest string, only from the consumer thread.
+     *
+     * @param value Set to the string.
+     * @return false if the ring is empty.
+     */
+    bool pop(std::shared_ptr<const std::string>& value);
+
+    /**
+     * @brief Check if there is no string to take, only from the consumer thread.
+     *
+     * @return true if the ring is empty.
+     */
+    bool empty() const;
+
+    /**
+     * @brief Get the number of cells.
+     *
+     * @return std::size_t
+     */
+    std::size_t capacity() const { return m_mask + 1; }
+
+private:
+    struct alignas(64) Cell
+    {
+        std::atomic<std::size_t> sequence;        ///< Position the cell is free or ready for
+        std::shared_ptr<const std::string> value; ///< The string, valid while ready
+    };
+
+    std::unique_ptr<Cell[]> m_cells;             ///< The cells
+    std::size_t m_mask;                          ///< Number of cells - 1
+    alignas(64) std::atomic<std::size_t> m_tail; ///< Next position to push
+    alignas(64) std::size_t m_head;              ///< Next position to pop, owned by the consumer
+};
+
+/**
+ * @brief Options of a file writer.
+ */
+struct FileWriterOptions
+{
+    std::size_t capacity {DEFAULT_WRITER_CAPACITY};                    ///< Events queued before the producers wait
+    std::size_t flushBytes {DEFAULT_WRITER_FLUSH_BYTES};               ///< Bytes buffered before they are written
+    std::chrono::milliseconds flushInterval {DEFAULT_WRITER_FLUSH_MS}; ///< Maximum time an event stays buffered
+    std::size_t maxSize {0};                                           ///< Size the file is rotated at, 0 never does
+    bool compress {false};                                             ///< Gzip the rotated files
+};
+
+/**
+ * @brief Appends lines to a file from a dedicated thread.
+ *
+ * The producers only queue the lines. The writer thread buffers them and writes them with writev, once enough bytes
+ * are buffered or the oldest one waited for the flush interval. Rotation and compression also run on the writer
+ * thread. A writer is shared by all the outputs of the same file.
+ */
+class FileWriter
+{
+public:
+    /**
+     * @brief Get the writer of a file, opening it if no output writes to it yet.
+     *
+     * @param path The file to append to.
+     * @param options The options, only used when the writer is created.
+     * @return std::shared_ptr<FileWriter>
+     * @throws std::invalid_argument if the file cannot be opened.
+     */
+    static std::shared_ptr<FileWriter> get(const std::string& path, const FileWriterOptions& options = {});
+
+    /**
+     * @brief Construct a new FileWriter object, starting its thread.
+     *
+     * @param path The file to append to.
+     * @param options The options.
+     * @throws std::invalid_argument if the file cannot be opened.
+     */
+    FileWriter(const std::string& path, const FileWriterOptions& options);
+
+    /**
+     * @brief Write the queued lines, stop the thread and close the file.
+     */
+    ~FileWriter();
+
+    FileWriter(const FileWriter&) = delete;
+    FileWriter& operator=(const FileWriter&) = delete;
+
+    /**
+     * @brief Queue a line, waiting only if the queue is full.
+     *
+     * @param line The line, without the trailing new line.
+     */
+    void write(std::string&& line);
+
+    /**
+     * @brief Queue a line shared with other outputs, waiting only if the queue is full.
+     *
+     * @param line The line, without the trailing new line, not modified.
+     */
+    void write(std::shared_ptr<const std::string> line);
+
+    /**
+     * @brief Wait until the lines queued so far are written.
+     */
+    void flush();
+
+private:
+    std::string m_path;          ///< The file
+    FileWriterOptions m_options; ///< The options
+    int m_fd;                    ///< The file descriptor, only used by the thread after the construction
+    std::size_t m_fileSize;      ///< Size of the file, to rotate it
+
+    MPSCRing m_ring;                  ///< Lines queued by the producers
+    std::atomic<uint64_t> m_queued;   ///< Lines queued
+    std::atomic<bool> m_sleeping;     ///< The thread waits for lines
+    std::atomic<bool> m_flushWanted;  ///< A flush is waiting for the lines to be written
+    std::atomic<bool> m_running;      ///< The thread must go on
+    std::mutex m_mutex;               ///< Protects the waits of the thread and the flushes
+    std::condition_variable m_wakeCv; ///< Wakes the thread
+    std::condition_variable m_doneCv; ///< Wakes the flushes
+    uint64_t m_written;               ///< Lines written, protected by the mutex
+
+    std::thread m_thread; ///< The writer thread
+
+    void run();
+    void wake();
+    void writeBatch(std::vector<std::shared_ptr<const std::string>>& batch);
+    void rotate();
+};
+
+} // namespace builder::builders::detail
+
+#endif // _BUILDER_BUILDERS_STAGE_FILEWRITER_HPP
@@ -0,0 +1,168 @@
+#include "indexerOutput.hpp"
+
+#include <cctype>
+#include <optional>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include "builders/stage/outputBuffer.hpp"
+#include "builders/utils.hpp"
+#include "syntax.hpp"
+
+namespace builder::builders
+{
+
+namespace
+{
+// The index is part of the action lines and of the queue directory
+constexpr auto INDEX_FORBIDDEN_CHARS = "/\\ \"*?<>|,#:";
+
+void validateIndex(const std::string& index)
+{
+    if (index.empty() || index.find_first_of(INDEX_FORBIDDEN_CHARS) != std::string::npos || index.front() == '.'
+        || index.front() == '-' || index.front() == '_')
+    {
+        throw std::runtime_error(fmt::format("Stage '{}' expects key '{}' to be a valid index name but got '{}'",
+                                             syntax::asset::INDEXER_OUTPUT_KEY,
+                                             syntax::asset::INDEXER_OUTPUT_INDEX_KEY,
+                                             index));
+    }
+
+    for (const auto c : index)
+    {
+        if (std::isupper(static_cast<unsigned char>(c)) || std::iscntrl(static_cast<unsigned char>(c)))
+        {
+            throw std::runtime_error(
+                fmt::format("Stage '{}' expects key '{}' to be a lowercase index name but got '{}'",
+                            syntax::asset::INDEXER_OUTPUT_KEY,
+                            syntax::asset::INDEXER_OUTPUT_INDEX_KEY,
+                            index));
+        }
+    }
+}
+
+int64_t getPositiveInt(const json::Json& value, const std::string& key)
+{
+    if (!value.isInt64() || value.getInt64().value() <= 0)
+    {
+        throw std::runtime_error(
+            fmt::format("Stage '{}' expects an object with key '{}' to be a positive integer but got '{}'",
+                        syntax::asset::INDEXER_OUTPUT_KEY,
+                        key,
+                        value.str()));
+    }
+    return value.getInt64().value();
+}
+} // namespace
+
+StageBuilder getIndexerOutputBuilder(const IndexerConnection& connection)
+{
+    return getIndexerOutputBuilder(
+        [connection](const std::string& index, const detail::IndexerWriterOptions& options)
+        {
+            if (connection.url.empty())
+            {
+                throw std::runtime_error(fmt::format("Stage '{}' needs the url of the indexer to be configured",
+                                                     syntax::asset::INDEXER_OUTPUT_KEY));
+            }
+            return detail::IndexerWriter::get(connection, index, options);
+        });
+}
+
+StageBuilder getIndexerOutputBuilder(detail::IndexerWriterGetter getWriter)
+{
+    return [getWriter](const json::Json& definition, const std::shared_ptr<const IBuildCtx>& buildCtx)
+    {
+        if (!definition.isObject())
+        {
+            throw std::runtime_error(fmt::format("Stage '{}' expects an object but got '{}'",
+                                                 syntax::asset::INDEXER_OUTPUT_KEY,
+                                                 definition.typeName()));
+        }
+
+        std::optional<std::string> index;
+        detail::IndexerWriterOptions options;
+        for (const auto& [key, value] : definition.getObject().value())
+        {
+            if (key == syntax::asset::INDEXER_OUTPUT_INDEX_KEY)
+            {
+                if (!value.isString())
+                {
+                    throw std::runtime_error(
+                        fmt::format("Stage '{}' expects an object with key '{}' to be a string but got '{}'",
+                                    syntax::asset::INDEXER_OUTPUT_KEY,
+                                    syntax::asset::INDEXER_OUTPUT_INDEX_KEY,
+                                    value.typeName()));
+                }
+                index = value.getString().value();
+                validateIndex(index.value());
+            }
+            else if (key == syntax::asset::INDEXER_OUTPUT_BULK_SIZE_KEY)
+            {
+                options.bulkBytes = static_cast<std::size_t>(getPositiveInt(value, key));
+            }
+            else if (key == syntax::asset::INDEXER_OUTPUT_INTERVAL_KEY)
+            {
+                options.flushInterval = std::chrono::milliseconds(getPositiveInt(value, key));
+            }
+            else if (key == syntax::asset::INDEXER_OUTPUT_COMPRESS_KEY)
+            {
+                if (!value.isBool())
+                {
+                    throw std::runtime_error(
+                        fmt::format("Stage '{}' expects an object with key '{}' to be a boolean but got '{}'",
+                                    syntax::asset::INDEXER_OUTPUT_KEY,
+                                    syntax::asset::INDEXER_OUTPUT_COMPRESS_KEY,
+                                    value.typeName()));
+                }
+                options.compress = value.getBool().value();
+            }
+            else
+            {
+                throw std::runtime_error(fmt::format(
+                    "Stage '{}' does not expect key '{}'", syntax::asset::INDEXER_OUTPUT_KEY, key));
+            }
+        }
+
+        if (!index)
+        {
+            throw std::runtime_error(fmt::format("Stage '{}' expects an object with key '{}'",
+                                                 syntax::asset::INDEXER_OUTPUT_KEY,
+                                                 syntax::asset::INDEXER_OUTPUT_INDEX_KEY));
+        }
+
+        auto writer = getWriter(index.value(), options);
+        auto name = fmt::format("write.indexer({})", index.value());
+        const auto successTrace = fmt::format("{} -> Success", name);
+        const auto failureTrace = fmt::format("{} -> Could not queue event to the indexer", name);
+
+        return base::Term<base::EngineOp>::create(
+            name,
+            [writer,
+             successTrace,
+             failureTrace,
+             runState = buildCtx->runState(),
+             outputBuffer = buildCtx->outputBuffer()](base::Event event) -> base::result::Result<base::Event>
+            {
+                try
+                {
+                    if (outputBuffer)
+                    {
+                        writer->write(outputBuffer->get(event));
+                    }
+                    else
+                    {
+                        writer->write(event->str());
+                    }
+                    RETURN_SUCCESS(runState, event, successTrace);
+                }
+                catch (const std::exception& e)
+                {
+                    RETURN_FAILURE(runState, event, failureTrace);
+                }
+            });
+    };
+}
+
+} // namespace builder::builders
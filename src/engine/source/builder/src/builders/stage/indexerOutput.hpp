@@ -0,0 +1,46 @@
+#ifndef _BUILDER_BUILDERS_STAGE_INDEXEROUTPUT_HPP
+#define _BUILDER_BUILDERS_STAGE_INDEXEROUTPUT_HPP
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include <builder/indexerConnection.hpp>
+
+#include "builders/stage/indexerWriter.hpp"
+#include "builders/types.hpp"
+
+namespace builder::builders
+{
+
+namespace detail
+{
+/**
+ * @brief Gets the writer of an index, given the index and the options of the output.
+ */
+using IndexerWriterGetter =
+    std::function<std::shared_ptr<IndexerWriter>(const std::string& index, const IndexerWriterOptions& options)>;
+} // namespace detail
+
+/**
+ * @brief Builds the indexer output stage, sending the events to an index of the indexer in bulks.
+ *
+ * The events are only queued by the stage, the writer of the index batches, compresses and sends them from its own
+ * thread.
+ *
+ * @param connection The connection to the indexer, outputs fail to build if it has no url.
+ * @return StageBuilder
+ */
+StageBuilder getIndexerOutputBuilder(const IndexerConnection& connection);
+
+/**
+ * @brief Builds the indexer output stage, getting the writers from the given getter.
+ *
+ * @param getWriter Gets the writer of an index.
+ * @return StageBuilder
+ */
+StageBuilder getIndexerOutputBuilder(detail::IndexerWriterGetter getWriter);
+
+} // namespace builder::builders
+
+#endif // _BUILDER_BUILDERS_STAGE_INDEXEROUTPUT_HPP
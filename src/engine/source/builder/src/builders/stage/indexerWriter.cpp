@@ -0,0 +1,419 @@
+#include "indexerWriter.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <stdexcept>
+#include <vector>
+
+#include <zlib.h>
+
+#include <fmt/format.h>
+
+#include <logging/logging.hpp>
+
+namespace builder::builders::detail
+{
+
+namespace
+{
+constexpr auto BULK_EXTENSION = ".bulk";
+constexpr auto GZIP_BULK_EXTENSION = ".bulk.gz";
+constexpr int GZIP_WINDOW_BITS = 15 + 16; ///< Deflate window with the gzip header and trailer
+
+std::string gzip(const std::string& input)
+{
+    z_stream stream {};
+    if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, GZIP_WINDOW_BITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+        throw std::runtime_error("Could not initialize the compression of the bulk");
+    }
+
+    std::string output(deflateBound(&stream, static_cast<uLong>(input.size())), '\0');
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+    stream.avail_in = static_cast<uInt>(input.size());
+    stream.next_out = reinterpret_cast<Bytef*>(output.data());
+    stream.avail_out = static_cast<uInt>(output.size());
+
+    const auto result = deflate(&stream, Z_FINISH);
+    output.resize(stream.total_out);
+    deflateEnd(&stream);
+    if (result != Z_STREAM_END)
+    {
+        throw std::runtime_error("Could not compress the bulk");
+    }
+
+    return output;
+}
+
+bool endsWith(const std::string& value, const std::string& suffix)
+{
+    return value.size() >= suffix.size() && value.compare(value.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+} // namespace
+
+std::shared_ptr<IndexerWriter>
+IndexerWriter::get(const IndexerConnection& connection, const std::string& index, IndexerWriterOptions options)
+{
+    static std::mutex mutex;
+    static std::map<std::string, std::weak_ptr<IndexerWriter>> writers;
+
+    const auto key = fmt::format("{}|{}", connection.url, index);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto writer = writers[key].lock();
+    if (writer == nullptr)
+    {
+        options.queueDir = connection.queueDir;
+        writer = std::make_shared<IndexerWriter>(std::make_shared<CurlBulkClient>(connection), index, options);
+        writers[key] = writer;
+    }
+
+    // Drop the indices no longer written
+    for (auto it = writers.begin(); it != writers.end();)
+    {
+        it = it->second.expired() ? writers.erase(it) : std::next(it);
+    }
+
+    return writer;
+}
+
+IndexerWriter::IndexerWriter(std::shared_ptr<IBulkClient> client,
+                             const std::string& index,
+                             const IndexerWriterOptions& options)
+    : m_client(std::move(client))
+    , m_index(index)
+    , m_action(fmt::format(R"({{"index":{{"_index":"{}"}}}})"
+                           "\n",
+                           index))
+    , m_options(options)
+    , m_queueDir()
+    , m_nextFile(0)
+    , m_pending()
+    , m_pendingCount(0)
+    , m_nextRetry()
+    , m_retryDelay(options.retryMin)
+    , m_ring(options.capacity)
+    , m_queued(0)
+    , m_sleeping(false)
+    , m_flushRequested(0)
+    , m_running(true)
+    , m_mutex()
+    , m_wakeCv()
+    , m_doneCv()
+    , m_flushDone(0)
+    , m_acknowledged(0)
+    , m_dropped(0)
+    , m_thread()
+{
+    if (m_client == nullptr)
+    {
+        throw std::runtime_error("Indexer output needs a bulk client");
+    }
+    if (m_index.empty())
+    {
+        throw std::runtime_error("Indexer output needs an index");
+    }
+
+    if (!m_options.queueDir.empty())
+    {
+        m_queueDir = std::filesystem::path(m_options.queueDir) / m_index;
+        std::error_code ec;
+        std::filesystem::create_directories(m_queueDir, ec);
+        if (ec)
+        {
+            throw std::runtime_error(fmt::format(
+                "Indexer output cannot use the queue directory '{}': {}", m_queueDir.string(), ec.message()));
+        }
+        recover();
+    }
+
+    m_thread = std::thread(&IndexerWriter::run, this);
+}
+
+IndexerWriter::~IndexerWriter()
+{
+    m_running.store(false);
+    wake();
+    m_thread.join();
+
+    if (!m_pending.empty())
+    {
+        LOG_WARNING("Indexer output stopped with {} bulks not sent to '{}'{}",
+                    m_pending.size(),
+                    m_index,
+                    m_queueDir.empty() ? ", they are lost" : ", they are kept in the queue directory");
+    }
+}
+
+void IndexerWriter::recover()
+{
+    std::vector<std::filesystem::path> files;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(m_queueDir, ec))
+    {
+        const auto name = entry.path().filename().string();
+        if (entry.is_regular_file(ec) && (endsWith(name, BULK_EXTENSION) || endsWith(name, GZIP_BULK_EXTENSION)))
+        {
+            files.push_back(entry.path());
+        }
+    }
+
+    // The names are zero padded sequences, so they sort as the bulks were closed
+    std::sort(files.begin(), files.end());
+    for (const auto& file : files)
+    {
+        const auto name = file.filename().string();
+        try
+        {
+            m_nextFile = std::max<uint64_t>(m_nextFile, std::stoull(name.substr(0, name.find('.'))) + 1);
+        }
+        catch (const std::exception&)
+        {
+            continue;
+        }
+        m_pending.push_back(Bulk {{}, file, endsWith(name, GZIP_BULK_EXTENSION)});
+    }
+    m_pendingCount.store(m_pending.size(), std::memory_order_relaxed);
+
+    if (!m_pending.empty())
+    {
+        LOG_INFO(
+            "Indexer output recovered {} bulks for '{}' from '{}'", m_pending.size(), m_index, m_queueDir.string());
+    }
+}
+
+void IndexerWriter::wake()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_wakeCv.notify_one();
+}
+
+void IndexerWriter::write(std::string&& document)
+{
+    write(std::make_shared<const std::string>(std::move(document)));
+}
+
+void IndexerWriter::write(std::shared_ptr<const std::string> document)
+{
+    while (!m_ring.push(document))
+    {
+        // Full, wait for the writer thread to catch up
+        wake();
+        std::this_thread::yield();
+    }
+    m_queued.fetch_add(1, std::memory_order_release);
+
+    // Pairs with the fence of the thread going to sleep, one of both sees the other
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_sleeping.load(std::memory_order_relaxed))
+    {
+        wake();
+    }
+}
+
+void IndexerWriter::flush()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    const auto request = m_flushRequested.fetch_add(1) + 1;
+    m_wakeCv.notify_one();
+    m_doneCv.wait(lock, [this, request]() { return m_flushDone >= request; });
+}
+
+std::size_t IndexerWriter::pending() const
+{
+    return m_pendingCount.load(std::memory_order_relaxed);
+}
+
+void IndexerWriter::close(std::string& body)
+{
+    Bulk bulk {{}, {}, m_options.compress};
+    try
+    {
+        bulk.body = m_options.compress ? gzip(body) : std::move(body);
+    }
+    catch (const std::exception& e)
+    {
+        LOG_WARNING("Indexer output sends the bulk uncompressed: {}", e.what());
+        bulk.body = std::move(body);
+        bulk.gzip = false;
+    }
+    body.clear();
+
+    if (!m_queueDir.empty())
+    {
+        const auto file =
+            m_queueDir / fmt::format("{:020}{}", m_nextFile++, bulk.gzip ? GZIP_BULK_EXTENSION : BULK_EXTENSION);
+        std::ofstream ofs(file, std::ios::binary | std::ios::trunc);
+        ofs.write(bulk.body.data(), static_cast<std::streamsize>(bulk.body.size()));
+        ofs.close();
+        if (ofs)
+        {
+            bulk.body.clear();
+            bulk.body.shrink_to_fit();
+            bulk.file = file;
+        }
+        else
+        {
+            LOG_ERROR("Indexer output cannot keep a bulk in '{}', it is kept in memory", file.string());
+            std::error_code ec;
+            std::filesystem::remove(file, ec);
+        }
+    }
+
+    if (bulk.file.empty())
+    {
+        const auto inMemory = std::count_if(
+            m_pending.begin(), m_pending.end(), [](const Bulk& pending) { return pending.file.empty(); });
+        if (static_cast<std::size_t>(inMemory) >= m_options.maxPending)
+        {
+            auto oldest = std::find_if(
+                m_pending.begin(), m_pending.end(), [](const Bulk& pending) { return pending.file.empty(); });
+            m_pending.erase(oldest);
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            LOG_WARNING("Indexer output dropped a bulk for '{}', too many are waiting to be sent", m_index);
+        }
+    }
+
+    m_pending.push_back(std::move(bulk));
+    m_pendingCount.store(m_pending.size(), std::memory_order_relaxed);
+}
+
+void IndexerWriter::sendPending(bool force)
+{
+    while (!m_pending.empty())
+    {
+        const auto now = std::chrono::steady_clock::now();
+        if (!force && now < m_nextRetry)
+        {
+            return;
+        }
+
+        auto& bulk = m_pending.front();
+        std::string fileBody;
+        if (!bulk.file.empty())
+        {
+            std::ifstream ifs(bulk.file, std::ios::binary);
+            fileBody.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+            if (!ifs && !ifs.eof())
+            {
+                LOG_ERROR("Indexer output cannot read the bulk '{}', it is dropped", bulk.file.string());
+                m_pending.pop_front();
+                m_pendingCount.store(m_pending.size(), std::memory_order_relaxed);
+                continue;
+            }
+        }
+
+        if (!m_client->send(bulk.file.empty() ? bulk.body : fileBody, bulk.gzip))
+        {
+            m_nextRetry = now + m_retryDelay;
+            m_retryDelay = std::min(m_retryDelay * 2, m_options.retryMax);
+            return;
+        }
+
+        if (!bulk.file.empty())
+        {
+            std::error_code ec;
+            std::filesystem::remove(bulk.file, ec);
+        }
+        m_pending.pop_front();
+        m_pendingCount.store(m_pending.size(), std::memory_order_relaxed);
+        m_acknowledged.fetch_add(1, std::memory_order_relaxed);
+        m_retryDelay = m_options.retryMin;
+        m_nextRetry = now;
+    }
+}
+
+void IndexerWriter::run()
+{
+    std::string body;
+    std::size_t documents = 0;
+    auto oldest = std::chrono::steady_clock::now();
+    std::shared_ptr<const std::string> document;
+
+    const auto add = [&]()
+    {
+        if (documents == 0)
+        {
+            oldest = std::chrono::steady_clock::now();
+        }
+        body.append(m_action);
+        body.append(*document);
+        body.push_back('\n');
+        ++documents;
+    };
+
+    const auto closeBulk = [&]()
+    {
+        close(body);
+        documents = 0;
+    };
+
+    uint64_t flushDone = 0;
+    while (true)
+    {
+        // Read before taking the documents, so the ones queued before the flushes are taken
+        const auto flushRequested = m_flushRequested.load();
+        const auto stopping = !m_running.load();
+        const auto flushWanted = flushRequested != flushDone;
+
+        bool popped = false;
+        while ((flushWanted || stopping || body.size() < m_options.bulkBytes) && m_ring.pop(document))
+        {
+            add();
+            popped = true;
+            if (body.size() >= m_options.bulkBytes)
+            {
+                closeBulk();
+            }
+        }
+
+        if (documents > 0
+            && (stopping || flushWanted || std::chrono::steady_clock::now() - oldest >= m_options.flushInterval))
+        {
+            closeBulk();
+        }
+
+        sendPending(stopping || flushWanted);
+
+        if (flushWanted)
+        {
+            flushDone = flushRequested;
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_flushDone = flushDone;
+            m_doneCv.notify_all();
+        }
+
+        if (stopping)
+        {
+            break;
+        }
+
+        if (!popped)
+        {
+            // Sleep until a document is queued, the open bulk must be closed or the pending ones sent again
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_sleeping.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (m_running.load() && m_flushRequested.load() == flushDone && m_ring.empty())
+            {
+                const auto now = std::chrono::steady_clock::now();
+                auto timeout = m_options.flushInterval;
+                if (documents > 0)
+                {
+                    timeout -= std::chrono::duration_cast<std::chrono::milliseconds>(now - oldest);
+                }
+                if (!m_pending.empty())
+                {
+                    timeout =
+                        std::min(timeout, std::chrono::duration_cast<std::chrono::milliseconds>(m_nextRetry - now));
+                }
+                m_wakeCv.wait_for(lock, std::max(timeout, std::chrono::milliseconds {1}));
+            }
+            m_sleeping.store(false, std::memory_order_relaxed);
+        }
+    }
+}
+
+} // namespace builder::builders::detail
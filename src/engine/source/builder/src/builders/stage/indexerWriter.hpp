@@ -0,0 +1,176 @@
+#ifndef _BUILDER_BUILDERS_STAGE_INDEXERWRITER_HPP
+#define _BUILDER_BUILDERS_STAGE_INDEXERWRITER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <builder/indexerConnection.hpp>
+
+#include "builders/stage/bulkClient.hpp"
+#include "builders/stage/fileWriter.hpp"
+
+namespace builder::builders::detail
+{
+
+constexpr std::size_t DEFAULT_INDEXER_BULK_BYTES = 5 << 20;         ///< Bytes of documents a bulk is sent at
+constexpr std::chrono::milliseconds DEFAULT_INDEXER_FLUSH_MS {1000}; ///< Maximum time a bulk is kept open
+constexpr std::size_t DEFAULT_INDEXER_MAX_PENDING = 64;              ///< Bulks kept in memory waiting to be sent
+constexpr std::chrono::milliseconds INDEXER_RETRY_MIN_MS {500};      ///< First wait before sending a bulk again
+constexpr std::chrono::milliseconds INDEXER_RETRY_MAX_MS {30000};    ///< Maximum wait before sending a bulk again
+
+/**
+ * @brief Options of an indexer writer.
+ */
+struct IndexerWriterOptions
+{
+    std::size_t capacity {DEFAULT_WRITER_CAPACITY};                     ///< Documents queued before the producers wait
+    std::size_t bulkBytes {DEFAULT_INDEXER_BULK_BYTES};                 ///< Bytes of documents a bulk is sent at
+    std::chrono::milliseconds flushInterval {DEFAULT_INDEXER_FLUSH_MS}; ///< Maximum time a bulk is kept open
+    bool compress {true};                                               ///< Gzip the bulks
+    std::string queueDir {};                                            ///< Directory of the bulks not acknowledged
+    std::size_t maxPending {DEFAULT_INDEXER_MAX_PENDING};               ///< Bulks kept in memory, without directory
+    std::chrono::milliseconds retryMin {INDEXER_RETRY_MIN_MS};          ///< First wait before sending a bulk again
+    std::chrono::milliseconds retryMax {INDEXER_RETRY_MAX_MS};          ///< Maximum wait before sending a bulk again
+};
+
+/**
+ * @brief Sends documents to an index of the indexer in bulks, from a dedicated thread.
+ *
+ * The producers only queue the documents. The writer thread adds them to the open bulk, which is closed once it holds
+ * enough bytes or its oldest document waited for the flush interval. A closed bulk is gzipped and sent, the bulks the
+ * indexer does not acknowledge are sent again, oldest first, waiting more after each failure.
+ *
+ * With a queue directory the closed bulks are kept in it until acknowledged, so they survive a restart of the engine
+ * and are sent by the next writer of the index. Otherwise they are kept in memory, dropping the oldest ones past the
+ * maximum. A writer is shared by all the outputs of the same index.
+ */
+class IndexerWriter
+{
+public:
+    /**
+     * @brief Get the writer of an index, creating it if no output writes to it yet.
+     *
+     * @param connection The connection to the indexer.
+     * @param index The index.
+     * @param options The options, only used when the writer is created. The queue directory is the one of the
+     * connection.
+     * @return std::shared_ptr<IndexerWriter>
+     * @throws std::runtime_error if the writer cannot be created.
+     */
+    static std::shared_ptr<IndexerWriter>
+    get(const IndexerConnection& connection, const std::string& index, IndexerWriterOptions options = {});
+
+    /**
+     * @brief Construct a new IndexerWriter object, starting its thread.
+     *
+     * @param client The client sending the bulks, only used by the writer thread.
+     * @param index The index.
+     * @param options The options.
+     * @throws std::runtime_error if the client is null, the index is empty or the queue directory cannot be used.
+     */
+    IndexerWriter(std::shared_ptr<IBulkClient> client, const std::string& index, const IndexerWriterOptions& options);
+
+    /**
+     * @brief Close the open bulk, try to send the pending ones once and stop the thread.
+     */
+    ~IndexerWriter();
+
+    IndexerWriter(const IndexerWriter&) = delete;
+    IndexerWriter& operator=(const IndexerWriter&) = delete;
+
+    /**
+     * @brief Queue a document, waiting only if the queue is full.
+     *
+     * @param document The document, without new lines.
+     */
+    void write(std::string&& document);
+
+    /**
+     * @brief Queue a document shared with other outputs, waiting only if the queue is full.
+     *
+     * @param document The document, without new lines.
+     */
+    void write(std::shared_ptr<const std::string> document);
+
+    /**
+     * @brief Wait until the documents queued so far are in closed bulks, and the pending bulks have been tried.
+     */
+    void flush();
+
+    /**
+     * @brief Get the number of closed bulks not acknowledged yet.
+     *
+     * @return std::size_t
+     */
+    std::size_t pending() const;
+
+    /**
+     * @brief Get the number of bulks acknowledged by the indexer.
+     *
+     * @return uint64_t
+     */
+    uint64_t acknowledged() const { return m_acknowledged.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Get the number of bulks dropped because too many were kept in memory.
+     *
+     * @return uint64_t
+     */
+    uint64_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    /**
+     * @brief A closed bulk, in memory or in the queue directory.
+     */
+    struct Bulk
+    {
+        std::string body;           ///< The body, empty if it is in a file
+        std::filesystem::path file; ///< The file of the body, empty if it is in memory
+        bool gzip;                  ///< The body is gzipped
+    };
+
+    std::shared_ptr<IBulkClient> m_client; ///< Sends the bulks
+    std::string m_index;                   ///< The index
+    std::string m_action;                  ///< Action line added before each document
+    IndexerWriterOptions m_options;        ///< The options
+    std::filesystem::path m_queueDir;      ///< Directory of the bulks of the index, empty if in memory
+    uint64_t m_nextFile;                   ///< Sequence of the next bulk file
+
+    std::deque<Bulk> m_pending;                        ///< Closed bulks not acknowledged, oldest first
+    std::atomic<std::size_t> m_pendingCount;           ///< Size of the pending bulks, read by any thread
+    std::chrono::steady_clock::time_point m_nextRetry; ///< The pending bulks are not sent before
+    std::chrono::milliseconds m_retryDelay;            ///< Wait after the next failure
+
+    MPSCRing m_ring;                        ///< Documents queued by the producers
+    std::atomic<uint64_t> m_queued;         ///< Documents queued
+    std::atomic<bool> m_sleeping;           ///< The thread waits for documents
+    std::atomic<uint64_t> m_flushRequested; ///< Flushes requested
+    std::atomic<bool> m_running;            ///< The thread must go on
+    std::mutex m_mutex;                     ///< Protects the waits of the thread and the flushes
+    std::condition_variable m_wakeCv;       ///< Wakes the thread
+    std::condition_variable m_doneCv;       ///< Wakes the flushes
+    uint64_t m_flushDone;                   ///< Flushes done, protected by the mutex
+    std::atomic<uint64_t> m_acknowledged;   ///< Bulks acknowledged
+    std::atomic<uint64_t> m_dropped;        ///< Bulks dropped
+
+    std::thread m_thread; ///< The writer thread
+
+    void run();
+    void wake();
+    void recover();
+    void close(std::string& body);
+    void sendPending(bool force);
+};
+
+} // namespace builder::builders::detail
+
+#endif // _BUILDER_BUILDERS_STAGE_INDEXERWRITER_HPP
@@ -0,0 +1,63 @@
+#ifndef _BUILDER_BUILDERS_STAGE_OUTPUTBUFFER_HPP
+#define _BUILDER_BUILDERS_STAGE_OUTPUTBUFFER_HPP
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <baseTypes.hpp>
+
+namespace builder::builders
+{
+
+/**
+ * @brief Event serialized once by an outputs stage, shared by all its outputs.
+ *
+ * The stage serializes the event before running the outputs, which queue the same immutable string to their writers.
+ * The string is kept with the event it was made from: the workers sharing the stage overwrite it with their own
+ * events, so an output that does not find its event serializes it itself.
+ */
+class OutputBuffer
+{
+private:
+    mutable std::mutex m_mutex;               ///< Protects the event and its string
+    const json::Json* m_event {nullptr};      ///< Event serialized last, only compared
+    std::shared_ptr<const std::string> m_str; ///< The event serialized
+
+public:
+    /**
+     * @brief Serialize an event for the outputs.
+     *
+     * @param event The event, not modified until the outputs run.
+     */
+    void set(const base::ConstEvent& event)
+    {
+        auto str = std::make_shared<const std::string>(event->str());
+        std::lock_guard lock {m_mutex};
+        m_event = event.get();
+        m_str = std::move(str);
+    }
+
+    /**
+     * @brief Get an event serialized, from the buffer if it was set with it.
+     *
+     * @param event The event.
+     * @return std::shared_ptr<const std::string>
+     */
+    std::shared_ptr<const std::string> get(const base::ConstEvent& event) const
+    {
+        {
+            std::lock_guard lock {m_mutex};
+            if (m_event == event.get())
+            {
+                return m_str;
+            }
+        }
+
+        return std::make_shared<const std::string>(event->str());
+    }
+};
+
+} // namespace builder::builders
+
+#endif // _BUILDER_BUILDERS_STAGE_OUTPUTBUFFER_HPP
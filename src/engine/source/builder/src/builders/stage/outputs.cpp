@@ -5,6 +5,7 @@
 #include <expression.hpp>
 #include <json/json.hpp>
 
+#include "builders/stage/outputBuffer.hpp"
 #include "syntax.hpp"
 
 namespace builder::builders
@@ -23,6 +24,17 @@ base::Expression outputsBuilder(const json::Json& definition, const std::shared_
         throw std::runtime_error(fmt::format("Stage '{}' expects a non-empty array", syntax::asset::OUTPUTS_KEY));
     }
 
+    // The outputs share the event serialized once by the stage
+    std::shared_ptr<OutputBuffer> outputBuffer;
+    auto outputsCtx = buildCtx;
+    if (definition.size() > 1)
+    {
+        outputBuffer = std::make_shared<OutputBuffer>();
+        auto ctx = buildCtx->clone();
+        ctx->setOutputBuffer(outputBuffer);
+        outputsCtx = ctx;
+    }
+
     // All output expressions
     std::vector<base::Expression> outputExpressions;
 
@@ -33,7 +45,7 @@ base::Expression outputsBuilder(const json::Json& definition, const std::shared_
         outputObjects.begin(),
         outputObjects.end(),
         std::back_inserter(outputExpressions),
-        [buildCtx](const auto& outputDefinition)
+        [buildCtx, outputsCtx](const auto& outputDefinition)
         {
             if (!outputDefinition.isObject())
             {
@@ -67,7 +79,7 @@ base::Expression outputsBuilder(const json::Json& definition, const std::shared_
             base::Expression outputExpression;
             try
             {
-                outputExpression = builder(outputValue, buildCtx);
+                outputExpression = builder(outputValue, outputsCtx);
             }
             catch (const std::exception& e)
             {
@@ -79,7 +91,20 @@ base::Expression outputsBuilder(const json::Json& definition, const std::shared_
         });
 
     // Create stage expression and return
-    return base::Broadcast::create("outputs", outputExpressions);
+    if (!outputBuffer)
+    {
+        return base::Broadcast::create("outputs", outputExpressions);
+    }
+
+    auto serialize = base::Term<base::EngineOp>::create(
+        "outputs.serialize",
+        [outputBuffer](base::Event event) -> base::result::Result<base::Event>
+        {
+            outputBuffer->set(event);
+            return base::result::makeSuccess(std::move(event));
+        });
+
+    return base::Chain::create("outputs", {serialize, base::Broadcast::create("outputs.broadcast", outputExpressions)});
 }
 
 } // namespace builder::builders
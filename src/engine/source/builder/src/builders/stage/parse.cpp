@@ -1,11 +1,138 @@
 #include "parse.hpp"
 
+#include <algorithm>
+#include <iterator>
+
 #include <json/json.hpp>
 
 #include "syntax.hpp"
 
 namespace builder::builders
 {
+namespace
+{
+base::Expression
+buildParseTerm(const hlp::logpar::Logpar& logpar, const std::string& field, const std::string& logparExpr)
+{
+    hlp::parser::Parser parser;
+    try
+    {
+        parser = logpar.build(logparExpr);
+    }
+    catch (const std::exception& e)
+    {
+        throw std::runtime_error(fmt::format("An error occurred while parsing a log: {}", e.what()));
+    }
+
+    // Traces
+    const auto name = fmt::format("{}: {}", field, logparExpr);
+    const auto successTrace = fmt::format("[{}] -> Success", name);
+
+    // field to be parsed not exists
+    const std::string failureTrace1 =
+        fmt::format(R"([{}] -> Failure: Parameter "{}" reference not found)", name, field);
+    // Parsing failed
+    const std::string failureTrace2 = fmt::format("[{}] -> Failure: Parse operation failed: ", name);
+    // Parsing ok, mapping failed
+    const std::string failureTrace3 = fmt::format("[{}] -> Failure: field [{}] is not a string", name, field);
+
+    try
+    {
+        return base::Term<base::EngineOp>::create(
+            logparExpr,
+            [=, parser = std::move(parser)](base::Event event)
+            {
+                if (!event->exists(field))
+                {
+                    return base::result::makeFailure(std::move(event), failureTrace1);
+                }
+                if (!event->isString(field))
+                {
+                    return base::result::makeFailure(std::move(event), failureTrace3);
+                }
+
+                auto ev = event->getString(field).value();
+                auto error = hlp::parser::run(parser, ev, *event);
+                if (error)
+                {
+                    return base::result::makeFailure(std::move(event), failureTrace2 + error.value().message);
+                }
+
+                return base::result::makeSuccess(std::move(event), successTrace);
+            });
+    }
+    catch (const std::exception& e)
+    {
+        throw std::runtime_error(fmt::format(
+            "[builder::opBuilderLogParser(json)] Exception creating [{}: {}]: {}", field, logparExpr, e.what()));
+    }
+}
+
+base::Expression buildTrieTerm(const hlp::logpar::Logpar& logpar,
+                               const std::string& field,
+                               const std::vector<std::string>& logparExprs)
+{
+    auto trie = std::make_shared<hlp::logpar::ParserTrie>();
+    try
+    {
+        *trie = logpar.buildTrie(logparExprs);
+    }
+    catch (const std::exception& e)
+    {
+        throw std::runtime_error(fmt::format("An error occurred while parsing a log: {}", e.what()));
+    }
+
+    // Traces
+    const auto termName = fmt::format("{}", fmt::join(logparExprs, " | "));
+    std::vector<std::string> successTraces {};
+    for (const auto& logparExpr : logparExprs)
+    {
+        successTraces.emplace_back(fmt::format("[{}: {}] -> Success", field, logparExpr));
+    }
+
+    const auto name = fmt::format("{}: {}", field, termName);
+    // field to be parsed not exists
+    const std::string failureTrace1 =
+        fmt::format(R"([{}] -> Failure: Parameter "{}" reference not found)", name, field);
+    // Parsing failed
+    const std::string failureTrace2 = fmt::format("[{}] -> Failure: Parse operation failed: ", name);
+    // Parsing ok, mapping failed
+    const std::string failureTrace3 = fmt::format("[{}] -> Failure: field [{}] is not a string", name, field);
+
+    try
+    {
+        return base::Term<base::EngineOp>::create(
+            termName,
+            [=](base::Event event)
+            {
+                if (!event->exists(field))
+                {
+                    return base::result::makeFailure(std::move(event), failureTrace1);
+                }
+                if (!event->isString(field))
+                {
+                    return base::result::makeFailure(std::move(event), failureTrace3);
+                }
+
+                auto ev = event->getString(field).value();
+                auto res = trie->run(ev, *event);
+                if (std::holds_alternative<base::Error>(res))
+                {
+                    return base::result::makeFailure(std::move(event),
+                                                     failureTrace2 + std::get<base::Error>(res).message);
+                }
+
+                return base::result::makeSuccess(std::move(event), successTraces[std::get<std::size_t>(res)]);
+            });
+    }
+    catch (const std::exception& e)
+    {
+        throw std::runtime_error(fmt::format(
+            "[builder::opBuilderLogParser(json)] Exception creating [{}: {}]: {}", field, termName, e.what()));
+    }
+}
+} // namespace
+
 // TODO: QoL error messages
 StageBuilder getParseBuilder(std::shared_ptr<hlp::logpar::Logpar> logpar, size_t debugLvl)
 {
@@ -35,7 +162,7 @@ StageBuilder getParseBuilder(std::shared_ptr<hlp::logpar::Logpar> logpar, size_t
         }
 
         auto logparArr = definition.getArray().value();
-        std::vector<base::Expression> parsersExpressions {};
+        std::vector<std::pair<std::string, std::string>> items {};
         for (const json::Json& item : logparArr)
         {
             if (!item.isObject())
@@ -53,65 +180,31 @@ StageBuilder getParseBuilder(std::shared_ptr<hlp::logpar::Logpar> logpar, size_t
             auto field = json::Json::formatJsonPath(std::get<0>(itemObj[0]));
             auto logparExpr = std::get<1>(itemObj[0]).getString().value();
             logparExpr = buildCtx->definitions().replace(logparExpr);
+            items.emplace_back(std::move(field), std::move(logparExpr));
+        }
 
-            hlp::parser::Parser parser;
-            try
-            {
-                parser = logpar->build(logparExpr);
-            }
-            catch (const std::exception& e)
-            {
-                throw std::runtime_error(fmt::format("An error occurred while parsing a log: {}", e.what()));
-            }
-
-            // Traces
-            const auto name = fmt::format("{}: {}", field, logparExpr);
-            const auto successTrace = fmt::format("[{}] -> Success", name);
-
-            // field to be parsed not exists
-            const std::string failureTrace1 =
-                fmt::format(R"([{}] -> Failure: Parameter "{}" reference not found)", name, field);
-            // Parsing failed
-            const std::string failureTrace2 = fmt::format("[{}] -> Failure: Parse operation failed: ", name);
-            // Parsing ok, mapping failed
-            const std::string failureTrace3 = fmt::format("[{}] -> Failure: field [{}] is not a string", name, field);
+        // Consecutive expressions of the same field are built in a single prefix tree, so their common prefixes are
+        // parsed once
+        std::vector<base::Expression> parsersExpressions {};
+        for (auto begin = items.cbegin(); begin != items.cend();)
+        {
+            const auto& field = begin->first;
+            auto end = std::find_if(begin, items.cend(), [&field](const auto& item) { return item.first != field; });
 
-            base::Expression parseExpression;
-            try
+            if (std::next(begin) == end)
             {
-                parseExpression = base::Term<base::EngineOp>::create(
-                    logparExpr,
-                    [=, parser = std::move(parser)](base::Event event)
-                    {
-                        if (!event->exists(field))
-                        {
-                            return base::result::makeFailure(std::move(event), failureTrace1);
-                        }
-                        if (!event->isString(field))
-                        {
-                            return base::result::makeFailure(std::move(event), failureTrace3);
-                        }
-
-                        auto ev = event->getString(field).value();
-                        auto error = hlp::parser::run(parser, ev, *event);
-                        if (error)
-                        {
-                            return base::result::makeFailure(std::move(event), failureTrace2 + error.value().message);
-                        }
-
-                        return base::result::makeSuccess(std::move(event), successTrace);
-                    });
+                parsersExpressions.push_back(buildParseTerm(*logpar, field, begin->second));
             }
-            catch (const std::exception& e)
+            else
             {
-                throw std::runtime_error(
-                    fmt::format("[builder::opBuilderLogParser(json)] Exception creating [{}: {}]: {}",
-                                field,
-                                logparExpr,
-                                e.what()));
+                std::vector<std::string> logparExprs {};
+                std::transform(begin,
+                               end,
+                               std::back_inserter(logparExprs),
+                               [](const auto& item) { return item.second; });
+                parsersExpressions.push_back(buildTrieTerm(*logpar, field, logparExprs));
             }
-
-            parsersExpressions.push_back(parseExpression);
+            begin = end;
         }
 
         return base::Or::create("parse", parsersExpressions);
@@ -1,7 +1,12 @@
 #include "policy/factory.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
 #include <numeric> // std::accumulate
 #include <stdexcept>
+#include <thread>
+#include <vector>
 
 #include <fmt/format.h>
 
@@ -318,45 +323,114 @@ PolicyData readData(const store::Doc& doc, const std::shared_ptr<store::IStoreRe
 
 BuiltAssets buildAssets(const PolicyData& data,
                         const std::shared_ptr<store::IStoreReader> store,
-                        const std::shared_ptr<IAssetBuilder>& assetBuilder)
+                        const std::shared_ptr<IAssetBuilder>& assetBuilder,
+                        const std::shared_ptr<AssetCache>& cache,
+                        std::size_t threads)
 {
-    BuiltAssets builtAssets;
-
-    // Build assets for each type
+    // Collect the assets of each type, in the order they are added
+    struct Task
+    {
+        PolicyData::AssetType type;
+        const SubgraphData* subgraph;
+        const store::NamespaceId* ns;
+        const base::Name* name;
+        Asset asset;
+        std::exception_ptr error;
+    };
+
+    std::vector<Task> tasks;
     for (const auto& [assetType, subgraphData] : data.subgraphs())
     {
         for (const auto& [assetNs, assetNames] : subgraphData.assets)
         {
             for (const auto& assetName : assetNames)
             {
-                // Get document
-                auto resp = store::utils::get(store, assetName);
-                if (base::isError(resp))
-                {
-                    throw std::runtime_error(fmt::format("Asset '{}' not found", assetName));
-                }
+                tasks.push_back(Task {assetType, &subgraphData, &assetNs, &assetName, Asset {}, nullptr});
+            }
+        }
+    }
 
-                Asset asset = (*assetBuilder)(base::getResponse<store::Doc>(resp));
+    const auto build = [&store, &assetBuilder, &cache](Task& task)
+    {
+        // Get document
+        auto resp = store::utils::get(store, *task.name);
+        if (base::isError(resp))
+        {
+            throw std::runtime_error(fmt::format("Asset '{}' not found", *task.name));
+        }
+        const auto& doc = base::getResponse<store::Doc>(resp);
 
-                // Add parents
-                if (asset.parents().empty())
-                {
-                    auto defParentIt = subgraphData.defaultParents.find(assetNs);
-                    if (defParentIt != subgraphData.defaultParents.end())
-                    {
-                        asset.parents().emplace_back(defParentIt->second);
-                    }
-                }
+        if (!cache)
+        {
+            task.asset = (*assetBuilder)(doc);
+            return;
+        }
 
-                // Add built asset to the subgraph
-                if (builtAssets.find(assetType) == builtAssets.end())
-                {
-                    builtAssets.emplace(assetType, std::unordered_map<base::Name, Asset> {});
-                }
+        const auto hash = std::hash<std::string> {}(doc.str());
+        if (auto entry = cache->get(*task.name, hash))
+        {
+            auto name = *task.name;
+            task.asset = Asset {std::move(name), std::move(entry->expression), std::move(entry->parents)};
+            return;
+        }
+
+        task.asset = (*assetBuilder)(doc);
+        cache->put(*task.name, AssetCache::Entry {hash, task.asset.expression(), task.asset.parents()});
+    };
 
-                builtAssets[assetType].emplace(assetName, asset);
+    // The workers take the next asset until all are built. The assets after one that failed are skipped, and the
+    // ones before it are still built, so the error is the same one a serial build would throw.
+    std::atomic<std::size_t> next {0};
+    std::atomic<std::size_t> firstFailed {tasks.size()};
+    const auto work = [&tasks, &next, &firstFailed, &build]()
+    {
+        for (auto i = next.fetch_add(1); i < tasks.size() && i < firstFailed.load(); i = next.fetch_add(1))
+        {
+            try
+            {
+                build(tasks[i]);
+            }
+            catch (...)
+            {
+                tasks[i].error = std::current_exception();
+                auto failed = firstFailed.load();
+                while (i < failed && !firstFailed.compare_exchange_weak(failed, i)) {}
             }
         }
+    };
+
+    std::vector<std::thread> workers;
+    const auto nWorkers = std::min(std::max<std::size_t>(threads, 1), tasks.size());
+    for (std::size_t i = 1; i < nWorkers; ++i)
+    {
+        workers.emplace_back(work);
+    }
+    work();
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    if (firstFailed.load() < tasks.size())
+    {
+        std::rethrow_exception(tasks[firstFailed.load()].error);
+    }
+
+    BuiltAssets builtAssets;
+    for (auto& task : tasks)
+    {
+        // Add parents
+        if (task.asset.parents().empty())
+        {
+            auto defParentIt = task.subgraph->defaultParents.find(*task.ns);
+            if (defParentIt != task.subgraph->defaultParents.end())
+            {
+                task.asset.parents().emplace_back(defParentIt->second);
+            }
+        }
+
+        // Add built asset to the subgraph
+        builtAssets[task.type].emplace(*task.name, std::move(task.asset));
     }
 
     return builtAssets;
@@ -499,4 +573,101 @@ base::Expression buildExpression(const PolicyGraph& graph, const PolicyData& dat
     return policy;
 }
 
+std::size_t layoutHash(const BuiltAssets& assets, const PolicyData& data)
+{
+    // The graph only depends on the type, the name and the parents of each asset
+    std::vector<std::string> relations;
+    for (const auto& [assetType, typeAssets] : assets)
+    {
+        for (const auto& [name, asset] : typeAssets)
+        {
+            auto relation = fmt::format("{}:{}<", PolicyData::assetTypeStr(assetType), name.toStr());
+            for (const auto& parent : asset.parents())
+            {
+                relation += parent.toStr() + ",";
+            }
+            relations.emplace_back(std::move(relation));
+        }
+    }
+    std::sort(relations.begin(), relations.end());
+
+    auto layout = data.name().toStr();
+    for (const auto& relation : relations)
+    {
+        layout += "\n" + relation;
+    }
+
+    return std::hash<std::string> {}(layout);
+}
+
+base::Expression spliceExpression(const base::Expression& expression,
+                                  const std::unordered_map<const base::Formula*, base::Expression>& replacements)
+{
+    // The nodes of the assets with several parents are shared, so they are copied once
+    std::unordered_map<const base::Formula*, base::Expression> spliced;
+
+    auto visit = [&](const base::Expression& current, auto& visitRef) -> base::Expression
+    {
+        if (auto it = replacements.find(current.get()); it != replacements.end())
+        {
+            return it->second;
+        }
+
+        if (!current->isOperation())
+        {
+            return current;
+        }
+
+        if (auto it = spliced.find(current.get()); it != spliced.end())
+        {
+            return it->second;
+        }
+
+        const auto& operands = current->getPtr<base::Operation>()->getOperands();
+        std::vector<base::Expression> newOperands;
+        newOperands.reserve(operands.size());
+        auto changed = false;
+        for (const auto& operand : operands)
+        {
+            newOperands.emplace_back(visitRef(operand, visitRef));
+            changed = changed || newOperands.back() != operand;
+        }
+
+        auto result = current;
+        if (changed)
+        {
+            const auto name = current->getName();
+            if (current->isImplication())
+            {
+                result = base::Implication::create(name, newOperands[0], newOperands[1]);
+            }
+            else if (current->isAnd())
+            {
+                result = base::And::create(name, std::move(newOperands));
+            }
+            else if (current->isOr())
+            {
+                result = base::Or::create(name, std::move(newOperands));
+            }
+            else if (current->isChain())
+            {
+                result = base::Chain::create(name, std::move(newOperands));
+            }
+            else if (current->isBroadcast())
+            {
+                result = base::Broadcast::create(name, std::move(newOperands));
+            }
+            else
+            {
+                throw std::runtime_error(fmt::format("Cannot copy the operation '{}' of unknown type", name));
+            }
+        }
+
+        spliced.emplace(current.get(), result);
+        return result;
+    };
+
+    return visit(expression, visit);
+}
+
 } // namespace builder::policy::factory
@@ -8,6 +8,7 @@
 
 #include <fmt/format.h>
 
+#include <builder/assetCache.hpp>
 #include <expression.hpp>
 #include <graph.hpp>
 #include <store/istore.hpp>
@@ -241,17 +242,24 @@ using BuiltAssets = std::unordered_map<PolicyData::AssetType, std::unordered_map
 /**
  * @brief Build the assets of the policy.
  *
+ * The assets are read and compiled by up to `threads` threads. An asset found in the cache with the same document is
+ * not compiled again.
+ *
  * @param data Policy data.
  * @param store The store interface to query assets and namespaces.
  * @param assetBuilder The asset builder instance to build each asset.
+ * @param cache (Optional) Assets compiled by previous builds, the compiled assets are added to it.
+ * @param threads (Optional) Threads compiling the assets.
  *
  * @return BuiltAssets
  *
- * @throw std::runtime_error If any error occurs.
+ * @throw std::runtime_error If any error occurs, the one of the first asset that failed.
  */
 BuiltAssets buildAssets(const PolicyData& data,
                         const std::shared_ptr<store::IStoreReader> store,
-                        const std::shared_ptr<IAssetBuilder>& assetBuilder);
+                        const std::shared_ptr<IAssetBuilder>& assetBuilder,
+                        const std::shared_ptr<AssetCache>& cache = nullptr,
+                        std::size_t threads = 1);
 
 /**
  * @brief This struct contains the policy graphs by type.
@@ -390,6 +398,32 @@ base::Expression buildSubgraphExpression(const Graph<base::Name, Asset>& subgrap
  */
 base::Expression buildExpression(const PolicyGraph& graph, const PolicyData& data);
 
+/**
+ * @brief Hash the assets of the policy and their relations, the builds with the same layout have the same graph.
+ *
+ * @param assets Assets of the policy, with their default parents.
+ * @param data Policy data.
+ *
+ * @return std::size_t
+ */
+std::size_t layoutHash(const BuiltAssets& assets, const PolicyData& data);
+
+/**
+ * @brief Replace some sub-expressions of an expression.
+ *
+ * The operations above a replaced sub-expression are copied, the rest of the expression is shared with the original
+ * one, which is not modified.
+ *
+ * @param expression Expression to replace the sub-expressions in.
+ * @param replacements New sub-expression of each sub-expression replaced.
+ *
+ * @return base::Expression
+ *
+ * @throw std::runtime_error If an operation to copy has an unknown type.
+ */
+base::Expression spliceExpression(const base::Expression& expression,
+                                  const std::unordered_map<const base::Formula*, base::Expression>& replacements);
+
 } // namespace builder::policy::factory
 
 #endif // _BUILDER_POLICY_FACTORY_HPP
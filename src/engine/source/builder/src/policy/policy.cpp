@@ -13,7 +13,9 @@ Policy::Policy(const store::Doc& doc,
                const std::shared_ptr<store::IStoreReader>& store,
                const std::shared_ptr<defs::IDefinitionsBuilder>& definitionsBuilder,
                const std::shared_ptr<builders::RegistryType>& registry,
-               const std::shared_ptr<schemf::IValidator>& schema)
+               const std::shared_ptr<schemf::IValidator>& schema,
+               const std::shared_ptr<AssetCache>& cache,
+               std::size_t threads)
 {
     // Read the policy data
     auto policyData = factory::readData(doc, store);
@@ -33,7 +35,7 @@ Policy::Policy(const store::Doc& doc,
     buildCtx->runState().trace = true;
 
     auto assetBuilder = std::make_shared<AssetBuilder>(buildCtx, definitionsBuilder);
-    auto builtAssets = factory::buildAssets(policyData, store, assetBuilder);
+    auto builtAssets = factory::buildAssets(policyData, store, assetBuilder, cache, threads);
 
     // Assign the assets
     for (const auto& [type, assets] : builtAssets)
@@ -44,13 +46,51 @@ Policy::Policy(const store::Doc& doc,
         }
     }
 
-    // Build the policy graph
-    // Exposing this step here is only needed for gathering the graphivz string
-    auto policyGraph = factory::buildGraph(builtAssets, policyData);
-    // TODO: Assign graphiv string
+    // If the assets keep their relations since the last build, only the changed assets are replaced in its
+    // expression, the rest of it is reused
+    const auto layout = factory::layoutHash(builtAssets, policyData);
+    auto previous = cache ? cache->getPolicy(m_name) : std::nullopt;
+    if (previous && previous->layout == layout)
+    {
+        std::unordered_map<const base::Formula*, base::Expression> replacements;
+        for (const auto& [type, assets] : builtAssets)
+        {
+            for (const auto& [name, asset] : assets)
+            {
+                const auto& old = previous->assets.at(name);
+                if (old != asset.expression())
+                {
+                    replacements.emplace(old.get(), asset.expression());
+                }
+            }
+        }
+
+        m_expression = replacements.empty() ? previous->expression
+                                            : factory::spliceExpression(previous->expression, replacements);
+    }
+    else
+    {
+        // Build the policy graph
+        // Exposing this step here is only needed for gathering the graphivz string
+        auto policyGraph = factory::buildGraph(builtAssets, policyData);
+        // TODO: Assign graphiv string
 
-    // Build the expression
-    m_expression = factory::buildExpression(policyGraph, policyData);
+        // Build the expression
+        m_expression = factory::buildExpression(policyGraph, policyData);
+    }
+
+    if (cache)
+    {
+        AssetCache::PolicyEntry entry {layout, {}, m_expression};
+        for (const auto& [type, assets] : builtAssets)
+        {
+            for (const auto& [name, asset] : assets)
+            {
+                entry.assets.emplace(name, asset.expression());
+            }
+        }
+        cache->putPolicy(m_name, std::move(entry));
+    }
 }
 
 } // namespace builder::policy
@@ -1,6 +1,7 @@
 #ifndef _BUILDER_POLICY_POLICY_HPP
 #define _BUILDER_POLICY_POLICY_HPP
 
+#include <builder/assetCache.hpp>
 #include <builder/ipolicy.hpp>
 
 #include <defs/idefinitions.hpp>
@@ -34,12 +35,16 @@ public:
      * @param definitionsBuilder Definitions builder
      * @param registry Registry instance
      * @param schema Schema validator instance
+     * @param cache (Optional) Assets compiled by previous builds, updated with the ones compiled by this one
+     * @param threads (Optional) Threads compiling the assets
      */
     Policy(const store::Doc& doc,
            const std::shared_ptr<store::IStoreReader>& store,
            const std::shared_ptr<defs::IDefinitionsBuilder>& definitionsBuilder,
            const std::shared_ptr<builders::RegistryType>& registry,
-           const std::shared_ptr<schemf::IValidator>& schema);
+           const std::shared_ptr<schemf::IValidator>& schema,
+           const std::shared_ptr<AssetCache>& cache = nullptr,
+           std::size_t threads = 1);
 
     /**
      * @copydoc IPolicy::name
@@ -30,6 +30,7 @@
 // Stage builders
 #include "builders/stage/check.hpp"
 #include "builders/stage/fileOutput.hpp"
+#include "builders/stage/indexerOutput.hpp"
 #include "builders/stage/map.hpp"
 #include "builders/stage/normalize.hpp"
 #include "builders/stage/outputs.hpp"
@@ -87,6 +88,9 @@ void registerOpBuilders(const std::shared_ptr<Registry>& registry, const Builder
         {schemf::JTypeToken::create(json::Json::Type::Number), builders::opfilter::opBuilderHelperIntNotEqual});
     registry->template add<builders::OpBuilderEntry>(
         "ip_cidr_match", {schemf::STypeToken::create(schemf::Type::IP), builders::opfilter::opBuilderHelperIPCIDR});
+    registry->template add<builders::OpBuilderEntry>(
+        "ip_cidr_match_any",
+        {schemf::STypeToken::create(schemf::Type::IP), builders::opfilter::opBuilderHelperIPCIDRSet});
     registry->template add<builders::OpBuilderEntry>(
         "is_public_ip", {schemf::STypeToken::create(schemf::Type::IP), builders::opfilter::opBuilderHelperPublicIP});
     registry->template add<builders::OpBuilderEntry>(
@@ -146,6 +150,16 @@ void registerOpBuilders(const std::shared_ptr<Registry>& registry, const Builder
     registry->template add<builders::OpBuilderEntry>(
         "contains",
         {schemf::JTypeToken::create(json::Json::Type::String), builders::opfilter::opBuilderHelperStringContains});
+    registry->template add<builders::OpBuilderEntry>(
+        "contains_any",
+        {schemf::JTypeToken::create(json::Json::Type::String), builders::opfilter::opBuilderHelperStringContainsAny});
+    registry->template add<builders::OpBuilderEntry>(
+        "contains_any_insensitive",
+        {schemf::JTypeToken::create(json::Json::Type::String),
+         builders::opfilter::opBuilderHelperStringContainsAnyInsensitive});
+    registry->template add<builders::OpBuilderEntry>(
+        "contains_all",
+        {schemf::JTypeToken::create(json::Json::Type::String), builders::opfilter::opBuilderHelperStringContainsAll});
     registry->template add<builders::OpBuilderEntry>(
         "match_value", {schemf::runtimeValidation(), builders::opfilter::opBuilderHelperMatchValue});
     registry->template add<builders::OpBuilderEntry>(
@@ -279,6 +293,10 @@ void registerOpBuilders(const std::shared_ptr<Registry>& registry, const Builder
         {schemf::STypeToken::create(schemf::Type::TEXT), builders::optransform::alphanumericParseBuilder});
 
     // KVDB builders
+    registry->template add<builders::OpBuilderEntry>(
+        "kvdb_cidr_match",
+        {schemf::STypeToken::create(schemf::Type::IP),
+         builders::getOpBuilderKVDBCIDRMatch(deps.kvdbManager, deps.kvdbScopeName)});
     registry->template add<builders::OpBuilderEntry>(
         "kvdb_delete",
         {schemf::runtimeValidation(), builders::getOpBuilderKVDBDelete(deps.kvdbManager, deps.kvdbScopeName)});
@@ -351,6 +369,8 @@ void registerStageBuilders(const std::shared_ptr<Registry>& registry, const Buil
                                                    builders::getParseBuilder(deps.logpar, deps.logparDebugLvl));
     registry->template add<builders::StageBuilder>(syntax::asset::OUTPUTS_KEY, builders::outputsBuilder);
     registry->template add<builders::StageBuilder>(syntax::asset::FILE_OUTPUT_KEY, builders::fileOutputBuilder);
+    registry->template add<builders::StageBuilder>(syntax::asset::INDEXER_OUTPUT_KEY,
+                                                   builders::getIndexerOutputBuilder(deps.indexer));
 }
 
 } // namespace builder::detail
@@ -16,17 +16,24 @@ namespace builder::syntax
 // Asset syntax
 namespace asset
 {
-constexpr auto NAME_KEY = "name";               ///< Key for the name field in an asset.
-constexpr auto METADATA_KEY = "metadata";       ///< Key for the metadata field in an asset.
-constexpr auto PARENTS_KEY = "parents";         ///< Key for the parents field in an asset.
-constexpr auto CHECK_KEY = "check";             ///< Key for the check stage in an asset.
-constexpr auto PARSE_KEY = "parse";             ///< Key for the parse stage in an asset.
-constexpr auto NORMALIZE_KEY = "normalize";     ///< Key for the normalize stage in an asset.
-constexpr auto MAP_KEY = "map";                 ///< Key for the map stage in an asset.
-constexpr auto DEFINITIONS_KEY = "definitions"; ///< Key for the definitions stage in an asset.
-constexpr auto OUTPUTS_KEY = "outputs";         ///< Key for the outputs stage in an asset.
-constexpr auto FILE_OUTPUT_KEY = "file";        ///< Key for the file output stage in an asset.
-constexpr auto FILE_OUTPUT_PATH_KEY = "path";   ///< Key for the file output path in an asset.
+constexpr auto NAME_KEY = "name";                     ///< Key for the name field in an asset.
+constexpr auto METADATA_KEY = "metadata";             ///< Key for the metadata field in an asset.
+constexpr auto PARENTS_KEY = "parents";               ///< Key for the parents field in an asset.
+constexpr auto CHECK_KEY = "check";                   ///< Key for the check stage in an asset.
+constexpr auto PARSE_KEY = "parse";                   ///< Key for the parse stage in an asset.
+constexpr auto NORMALIZE_KEY = "normalize";           ///< Key for the normalize stage in an asset.
+constexpr auto MAP_KEY = "map";                       ///< Key for the map stage in an asset.
+constexpr auto DEFINITIONS_KEY = "definitions";       ///< Key for the definitions stage in an asset.
+constexpr auto OUTPUTS_KEY = "outputs";               ///< Key for the outputs stage in an asset.
+constexpr auto FILE_OUTPUT_KEY = "file";              ///< Key for the file output stage in an asset.
+constexpr auto FILE_OUTPUT_PATH_KEY = "path";         ///< Key for the file output path in an asset.
+constexpr auto FILE_OUTPUT_MAX_SIZE_KEY = "max_size"; ///< Key for the size the file output is rotated at.
+constexpr auto FILE_OUTPUT_COMPRESS_KEY = "compress"; ///< Key for the compression of the rotated file outputs.
+constexpr auto INDEXER_OUTPUT_KEY = "indexer";                 ///< Key for the indexer output stage in an asset.
+constexpr auto INDEXER_OUTPUT_INDEX_KEY = "index";             ///< Key for the index of the indexer output.
+constexpr auto INDEXER_OUTPUT_BULK_SIZE_KEY = "bulk_size";     ///< Key for the bytes of the indexer output bulks.
+constexpr auto INDEXER_OUTPUT_INTERVAL_KEY = "flush_interval"; ///< Key for the milliseconds a bulk is kept open.
+constexpr auto INDEXER_OUTPUT_COMPRESS_KEY = "compress";       ///< Key for the compression of the indexer bulks.
 
 constexpr auto CONDITION_NAME =
     "condition"; ///< Name of the condition expression in the asset to be displayed in traces.
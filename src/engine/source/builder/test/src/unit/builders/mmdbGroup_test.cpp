@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include <geo/mockLocator.hpp>
+#include <geo/mockManager.hpp>
+
+#include "builders/mmdbGroup.hpp"
+
+using namespace builder::builders;
+
+namespace
+{
+const MMDBGroup::FieldList CITY_FIELDS {{DotPath("city.names.en"), geo::Fields::Type::STRING},
+                                        {DotPath("location.latitude"), geo::Fields::Type::DOUBLE}};
+
+const MMDBGroup::FieldList COUNTRY_FIELDS {{DotPath("country.iso_code"), geo::Fields::Type::STRING},
+                                           {DotPath("city.names.en"), geo::Fields::Type::STRING}};
+} // namespace
+
+TEST(MMDBGroupTest, SharesFields)
+{
+    MMDBGroup group(std::make_shared<geo::mocks::MockLocator>());
+
+    auto city = group.add(CITY_FIELDS);
+    auto country = group.add(COUNTRY_FIELDS);
+    ASSERT_TRUE(city.has_value());
+    ASSERT_TRUE(country.has_value());
+
+    ASSERT_EQ(city.value(), std::vector<std::size_t>({0, 1}));
+    ASSERT_EQ(country.value(), std::vector<std::size_t>({2, 0}));
+    ASSERT_EQ(group.size(), 3);
+
+    // The same path with another type is another field
+    auto otherType = group.add({{DotPath("city.names.en"), geo::Fields::Type::UINT32}});
+    ASSERT_EQ(otherType.value(), std::vector<std::size_t>({3}));
+}
+
+TEST(MMDBGroupTest, ClosedAfterLookup)
+{
+    auto locator = std::make_shared<geo::mocks::MockLocator>();
+    MMDBGroup group(locator);
+    ASSERT_TRUE(group.add(CITY_FIELDS).has_value());
+
+    EXPECT_CALL(*locator, getString("1.2.3.4", DotPath("city.names.en"))).WillOnce(testing::Return("City"));
+    EXPECT_CALL(*locator, getDouble("1.2.3.4", DotPath("location.latitude")))
+        .WillOnce(testing::Return(base::Error {"Not found"}));
+
+    auto res = group.getFields("1.2.3.4");
+    ASSERT_FALSE(base::isError(res));
+    const auto& values = *base::getResponse(res);
+    ASSERT_EQ(std::get<std::string>(values[0]), "City");
+    ASSERT_TRUE(std::holds_alternative<std::monostate>(values[1]));
+
+    ASSERT_FALSE(group.add(COUNTRY_FIELDS).has_value());
+}
+
+TEST(MMDBGroupsTest, GroupsByDbAndField)
+{
+    auto manager = std::make_shared<geo::mocks::MockManager>();
+    MMDBGroups groups;
+
+    EXPECT_CALL(*manager, getLocator(geo::Type::CITY))
+        .Times(2)
+        .WillRepeatedly(testing::Return(std::make_shared<geo::mocks::MockLocator>()));
+    EXPECT_CALL(*manager, getLocator(geo::Type::ASN))
+        .WillOnce(testing::Return(std::make_shared<geo::mocks::MockLocator>()));
+
+    auto srcCity = groups.add(manager, geo::Type::CITY, "source.ip", CITY_FIELDS);
+    auto srcCountry = groups.add(manager, geo::Type::CITY, "source.ip", COUNTRY_FIELDS);
+    auto dstCity = groups.add(manager, geo::Type::CITY, "destination.ip", CITY_FIELDS);
+    auto srcAs = groups.add(manager, geo::Type::ASN, "source.ip", CITY_FIELDS);
+    ASSERT_FALSE(base::isError(srcCity));
+    ASSERT_FALSE(base::isError(srcCountry));
+    ASSERT_FALSE(base::isError(dstCity));
+    ASSERT_FALSE(base::isError(srcAs));
+
+    ASSERT_EQ(base::getResponse(srcCity).first, base::getResponse(srcCountry).first);
+    ASSERT_EQ(base::getResponse(srcCountry).second, std::vector<std::size_t>({2, 0}));
+    ASSERT_NE(base::getResponse(srcCity).first, base::getResponse(dstCity).first);
+    ASSERT_NE(base::getResponse(srcCity).first, base::getResponse(srcAs).first);
+}
+
+TEST(MMDBGroupsTest, NewGroupOnceClosed)
+{
+    auto manager = std::make_shared<geo::mocks::MockManager>();
+    auto locator = std::make_shared<geo::mocks::MockLocator>();
+    MMDBGroups groups;
+
+    EXPECT_CALL(*manager, getLocator(geo::Type::ASN)).Times(2).WillRepeatedly(testing::Return(locator));
+    ON_CALL(*locator, getString(testing::_, testing::_)).WillByDefault(testing::Return(base::Error {"error"}));
+    ON_CALL(*locator, getDouble(testing::_, testing::_)).WillByDefault(testing::Return(base::Error {"error"}));
+
+    auto first = groups.add(manager, geo::Type::ASN, "source.ip", CITY_FIELDS);
+    ASSERT_FALSE(base::isError(first));
+    base::getResponse(first).first->getFields("1.2.3.4");
+
+    auto second = groups.add(manager, geo::Type::ASN, "source.ip", COUNTRY_FIELDS);
+    ASSERT_FALSE(base::isError(second));
+    ASSERT_NE(base::getResponse(first).first, base::getResponse(second).first);
+    ASSERT_EQ(base::getResponse(second).second, std::vector<std::size_t>({0, 1}));
+}
+
+TEST(MMDBGroupsTest, LocatorError)
+{
+    auto manager = std::make_shared<geo::mocks::MockManager>();
+    MMDBGroups groups;
+
+    EXPECT_CALL(*manager, getLocator(geo::Type::ASN)).WillOnce(testing::Return(base::Error {"error"}));
+    ASSERT_TRUE(base::isError(groups.add(manager, geo::Type::ASN, "source.ip", CITY_FIELDS)));
+}
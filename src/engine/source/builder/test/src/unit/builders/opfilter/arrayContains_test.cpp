@@ -178,3 +178,52 @@ INSTANTIATE_TEST_SUITE_P(
                 FAILURE())),
     testNameFormatter<FilterOperationTest>("ArrayContains"));
 } // namespace filteroperatestest
+
+namespace filteroperatestest
+{
+// All the parameters are strings, the elements are looked up in an index of the parameters
+INSTANTIATE_TEST_SUITE_P(
+    BuildersLiterals,
+    FilterOperationTest,
+    testing::Values(FilterT(R"({"target": [1, null, "value", {"value": 1}]})",
+                            opfilter::opBuilderHelperContains,
+                            "target",
+                            {makeValue(R"("value")"), makeValue(R"("value")")},
+                            SUCCESS()),
+                    FilterT(R"({"target": [1, "value2"]})",
+                            opfilter::opBuilderHelperContains,
+                            "target",
+                            {makeValue(R"("value")"), makeValue(R"("value2")")},
+                            FAILURE()),
+                    FilterT(R"({"target": ["1"]})",
+                            opfilter::opBuilderHelperContainsAny,
+                            "target",
+                            {makeValue(R"("value")"), makeValue(R"("1")")},
+                            SUCCESS()),
+                    FilterT(R"({"target": [1]})",
+                            opfilter::opBuilderHelperContainsAny,
+                            "target",
+                            {makeValue(R"("1")")},
+                            FAILURE()),
+                    FilterT(R"({"target": ["value"]})",
+                            opfilter::opBuilderHelperNotContains,
+                            "target",
+                            {makeValue(R"("value2")"), makeValue(R"("value3")")},
+                            SUCCESS()),
+                    FilterT(R"({"target": ["value", "value3"]})",
+                            opfilter::opBuilderHelperNotContains,
+                            "target",
+                            {makeValue(R"("value2")"), makeValue(R"("value3")")},
+                            FAILURE()),
+                    FilterT(R"({"target": ["value", "value3"]})",
+                            opfilter::opBuilderHelperNotContainsAny,
+                            "target",
+                            {makeValue(R"("value2")"), makeValue(R"("value3")")},
+                            SUCCESS()),
+                    FilterT(R"({"target": ["value2", "value3"]})",
+                            opfilter::opBuilderHelperNotContainsAny,
+                            "target",
+                            {makeValue(R"("value2")"), makeValue(R"("value3")"), makeValue(R"("value3")")},
+                            FAILURE())),
+    testNameFormatter<FilterOperationTest>("ArrayContainsLiterals"));
+} // namespace filteroperatestest
@@ -0,0 +1,94 @@
+#include "builders/baseBuilders_test.hpp"
+
+#include "builders/opfilter/opBuilderHelperFilter.hpp"
+
+namespace filterbuildtest
+{
+INSTANTIATE_TEST_SUITE_P(
+    Builders,
+    FilterBuilderTest,
+    testing::Values(
+        /*** Contains any ***/
+        FilterT({}, opfilter::opBuilderHelperStringContainsAny, FAILURE()),
+        FilterT({makeValue(R"("str")")}, opfilter::opBuilderHelperStringContainsAny, SUCCESS()),
+        FilterT({makeValue(R"("a")"), makeValue(R"("b")")}, opfilter::opBuilderHelperStringContainsAny, SUCCESS()),
+        FilterT({makeValue(R"(["a", "b"])")}, opfilter::opBuilderHelperStringContainsAny, SUCCESS()),
+        FilterT({makeValue(R"([])")}, opfilter::opBuilderHelperStringContainsAny, FAILURE()),
+        FilterT({makeValue(R"(["a", 1])")}, opfilter::opBuilderHelperStringContainsAny, FAILURE()),
+        FilterT({makeValue(R"(1)")}, opfilter::opBuilderHelperStringContainsAny, FAILURE()),
+        FilterT({makeValue(R"(null)")}, opfilter::opBuilderHelperStringContainsAny, FAILURE()),
+        FilterT({makeRef("ref")}, opfilter::opBuilderHelperStringContainsAny, FAILURE()),
+        FilterT({makeValue(R"("a")"), makeRef("ref")}, opfilter::opBuilderHelperStringContainsAny, FAILURE()),
+        /*** Contains any insensitive ***/
+        FilterT({}, opfilter::opBuilderHelperStringContainsAnyInsensitive, FAILURE()),
+        FilterT({makeValue(R"("str")")}, opfilter::opBuilderHelperStringContainsAnyInsensitive, SUCCESS()),
+        FilterT({makeRef("ref")}, opfilter::opBuilderHelperStringContainsAnyInsensitive, FAILURE()),
+        /*** Contains all ***/
+        FilterT({}, opfilter::opBuilderHelperStringContainsAll, FAILURE()),
+        FilterT({makeValue(R"("a")"), makeValue(R"("b")")}, opfilter::opBuilderHelperStringContainsAll, SUCCESS()),
+        FilterT({makeValue(R"(true)")}, opfilter::opBuilderHelperStringContainsAll, FAILURE()),
+        FilterT({makeRef("ref")}, opfilter::opBuilderHelperStringContainsAll, FAILURE())),
+    testNameFormatter<FilterBuilderTest>("ContainsAny"));
+} // namespace filterbuildtest
+
+namespace filteroperatestest
+{
+INSTANTIATE_TEST_SUITE_P(
+    Builders,
+    FilterOperationTest,
+    testing::Values(
+        /*** Contains any ***/
+        FilterT(R"({"target": "powershell.exe -EncodedCommand AAAA"})",
+                opfilter::opBuilderHelperStringContainsAny,
+                "target",
+                {makeValue(R"("mimikatz")"), makeValue(R"("-EncodedCommand")")},
+                SUCCESS()),
+        FilterT(R"({"target": "powershell.exe -encodedcommand AAAA"})",
+                opfilter::opBuilderHelperStringContainsAny,
+                "target",
+                {makeValue(R"(["mimikatz", "-EncodedCommand"])")},
+                FAILURE()),
+        FilterT(R"({"target": "cmd.exe /c whoami"})",
+                opfilter::opBuilderHelperStringContainsAny,
+                "target",
+                {makeValue(R"("mimikatz")"), makeValue(R"("-EncodedCommand")")},
+                FAILURE()),
+        FilterT(R"({"target": ""})",
+                opfilter::opBuilderHelperStringContainsAny,
+                "target",
+                {makeValue(R"("a")")},
+                FAILURE()),
+        FilterT(R"({"target": 1})",
+                opfilter::opBuilderHelperStringContainsAny,
+                "target",
+                {makeValue(R"("1")")},
+                FAILURE()),
+        FilterT(R"({"target": "value"})",
+                opfilter::opBuilderHelperStringContainsAny,
+                "notTarget",
+                {makeValue(R"("value")")},
+                FAILURE()),
+        /*** Contains any insensitive ***/
+        FilterT(R"({"target": "POWERSHELL.EXE -encodedcommand AAAA"})",
+                opfilter::opBuilderHelperStringContainsAnyInsensitive,
+                "target",
+                {makeValue(R"("mimikatz")"), makeValue(R"("-EncodedCommand")")},
+                SUCCESS()),
+        FilterT(R"({"target": "cmd.exe /c whoami"})",
+                opfilter::opBuilderHelperStringContainsAnyInsensitive,
+                "target",
+                {makeValue(R"("MIMIKATZ")")},
+                FAILURE()),
+        /*** Contains all ***/
+        FilterT(R"({"target": "powershell.exe -nop -EncodedCommand AAAA"})",
+                opfilter::opBuilderHelperStringContainsAll,
+                "target",
+                {makeValue(R"("-nop")"), makeValue(R"("-EncodedCommand")")},
+                SUCCESS()),
+        FilterT(R"({"target": "powershell.exe -EncodedCommand AAAA"})",
+                opfilter::opBuilderHelperStringContainsAll,
+                "target",
+                {makeValue(R"("-nop")"), makeValue(R"("-EncodedCommand")")},
+                FAILURE())),
+    testNameFormatter<FilterOperationTest>("ContainsAny"));
+} // namespace filteroperatestest
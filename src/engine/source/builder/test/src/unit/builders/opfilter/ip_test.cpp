@@ -20,6 +20,25 @@ INSTANTIATE_TEST_SUITE_P(
                 SUCCESS())),
     testNameFormatter<FilterBuilderTest>("IPCIDR"));
 
+INSTANTIATE_TEST_SUITE_P(
+    BuilderIPCIDRSet,
+    FilterBuilderTest,
+    testing::Values(
+        FilterT({}, opfilter::opBuilderHelperIPCIDRSet, FAILURE()),
+        FilterT({makeRef("ref")}, opfilter::opBuilderHelperIPCIDRSet, FAILURE()),
+        FilterT({makeValue(R"("10.0.0.0/8")")}, opfilter::opBuilderHelperIPCIDRSet, SUCCESS()),
+        FilterT({makeValue(R"("10.0.0.0/8")"), makeValue(R"("fe80::/10")")},
+                opfilter::opBuilderHelperIPCIDRSet,
+                SUCCESS()),
+        FilterT({makeValue(R"(["10.0.0.0/255.0.0.0", "::1"])")}, opfilter::opBuilderHelperIPCIDRSet, SUCCESS()),
+        FilterT({makeValue(R"([])")}, opfilter::opBuilderHelperIPCIDRSet, FAILURE()),
+        FilterT({makeValue(R"("10.0.0.0/33")")}, opfilter::opBuilderHelperIPCIDRSet, FAILURE()),
+        FilterT({makeValue(R"("invalid")")}, opfilter::opBuilderHelperIPCIDRSet, FAILURE()),
+        FilterT({makeValue(R"(["10.0.0.0/8", 1])")}, opfilter::opBuilderHelperIPCIDRSet, FAILURE()),
+        FilterT({makeValue(R"(8)")}, opfilter::opBuilderHelperIPCIDRSet, FAILURE()),
+        FilterT({makeValue(R"("10.0.0.0/8")"), makeRef("ref")}, opfilter::opBuilderHelperIPCIDRSet, FAILURE())),
+    testNameFormatter<FilterBuilderTest>("IPCIDRSet"));
+
 INSTANTIATE_TEST_SUITE_P(
     BuilderPublicIP,
     FilterBuilderTest,
@@ -55,6 +74,47 @@ INSTANTIATE_TEST_SUITE_P(BuilderIPCIDR,
                                                  FAILURE())),
                          testNameFormatter<FilterOperationTest>("IPCIDR"));
 
+INSTANTIATE_TEST_SUITE_P(
+    BuilderIPCIDRSet,
+    FilterOperationTest,
+    testing::Values(
+        FilterT(R"({"target": "10.1.2.3"})",
+                opfilter::opBuilderHelperIPCIDRSet,
+                "target",
+                {makeValue(R"("192.168.0.0/16")"), makeValue(R"("10.0.0.0/8")")},
+                SUCCESS()),
+        FilterT(R"({"target": "11.1.2.3"})",
+                opfilter::opBuilderHelperIPCIDRSet,
+                "target",
+                {makeValue(R"("192.168.0.0/16")"), makeValue(R"("10.0.0.0/8")")},
+                FAILURE()),
+        FilterT(R"({"target": "2001:db8::1"})",
+                opfilter::opBuilderHelperIPCIDRSet,
+                "target",
+                {makeValue(R"(["10.0.0.0/8", "2001:db8::/32"])")},
+                SUCCESS()),
+        FilterT(R"({"target": "2001:db9::1"})",
+                opfilter::opBuilderHelperIPCIDRSet,
+                "target",
+                {makeValue(R"(["10.0.0.0/8", "2001:db8::/32"])")},
+                FAILURE()),
+        FilterT(R"({"target": "10.1.2.3/8"})",
+                opfilter::opBuilderHelperIPCIDRSet,
+                "target",
+                {makeValue(R"("10.0.0.0/8")")},
+                FAILURE()),
+        FilterT(R"({"target": 10})",
+                opfilter::opBuilderHelperIPCIDRSet,
+                "target",
+                {makeValue(R"("10.0.0.0/8")")},
+                FAILURE()),
+        FilterT(R"({"target": "10.1.2.3"})",
+                opfilter::opBuilderHelperIPCIDRSet,
+                "notTarget",
+                {makeValue(R"("10.0.0.0/8")")},
+                FAILURE())),
+    testNameFormatter<FilterOperationTest>("IPCIDRSet"));
+
 INSTANTIATE_TEST_SUITE_P(
     BuilderPublicIP,
     FilterOperationTest,
@@ -71,8 +131,14 @@ INSTANTIATE_TEST_SUITE_P(
         FilterT(R"({"target": "127.1.1.1"})", opfilter::opBuilderHelperPublicIP, "target", {}, FAILURE()),
         FilterT(R"({"target": "192.168.1.1"})", opfilter::opBuilderHelperPublicIP, "target", {}, FAILURE()),
         FilterT(R"({"target": "10.0.0.1"})", opfilter::opBuilderHelperPublicIP, "target", {}, FAILURE()),
+        FilterT(R"({"target": "172.16.0.1"})", opfilter::opBuilderHelperPublicIP, "target", {}, FAILURE()),
+        FilterT(R"({"target": "fe80::1"})", opfilter::opBuilderHelperPublicIP, "target", {}, FAILURE()),
+        FilterT(R"({"target": "fd00::1"})", opfilter::opBuilderHelperPublicIP, "target", {}, FAILURE()),
+        // Not an IP
+        FilterT(R"({"target": "host"})", opfilter::opBuilderHelperPublicIP, "target", {}, FAILURE()),
         // Public IP
         FilterT(R"({"target": "8.8.8.8"})", opfilter::opBuilderHelperPublicIP, "target", {}, SUCCESS()),
+        FilterT(R"({"target": "172.32.0.1"})", opfilter::opBuilderHelperPublicIP, "target", {}, SUCCESS()),
         FilterT(R"({"target": "2001:4860:4860::8888"})", opfilter::opBuilderHelperPublicIP, "target", {}, SUCCESS())
         // End of test cases
         ),
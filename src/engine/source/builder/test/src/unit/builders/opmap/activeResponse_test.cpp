@@ -171,18 +171,46 @@ INSTANTIATE_TEST_SUITE_P(
         MapDepsT(R"({"ref": 1})", getBuilderExpectSockHandler(), {makeRef("ref")}, FAILURE()),
         MapDepsT(R"({"ref": ""})", getBuilderExpectSockHandler(), {makeRef("ref")}, FAILURE()),
         MapDepsT(R"({})", getBuilderExpectSockHandler(), {makeValue(R"("")")}, FAILURE()),
+        // The message is queued, the errors of the socket are only logged by the sender
         MapDepsT(R"({})",
                  getBuilderExpectSockHandler(
                      [](const std::shared_ptr<MockSockHandler>& handler) {
                          EXPECT_CALL(*handler, sendMsg("query")).WillOnce(testing::Throw(std::runtime_error("error")));
                      }),
                  {makeValue(R"("query")")},
-                 FAILURE()),
+                 SUCCESS(json::Json {R"(true)"})),
         MapDepsT(R"({})",
                  getBuilderExpectSockHandler(
                      [](const std::shared_ptr<MockSockHandler>& handler)
                      { EXPECT_CALL(*handler, sendMsg("query")).WillOnce(testing::Return(socketErrorSendMsgRes())); }),
                  {makeValue(R"("query")")},
-                 FAILURE())),
+                 SUCCESS(json::Json {R"(true)"}))),
     testNameFormatter<MapOperationWithDepsTest>("ActiveResponse"));
 } // namespace mapoperatestest
+
+namespace
+{
+class SendARTest : public BaseBuilderTest
+{
+};
+
+TEST_F(SendARTest, SharedSender)
+{
+    auto sockFactoryMock = std::make_shared<MockSockFactory>();
+    auto sockHandlerMock = std::make_shared<MockSockHandler>();
+    EXPECT_CALL(*sockFactoryMock, getHandler(ISockHandler::Protocol::DATAGRAM, "/var/ossec/queue/alerts/ar"))
+        .WillOnce(testing::Return(sockHandlerMock));
+    // Identical messages within the window are sent once
+    EXPECT_CALL(*sockHandlerMock, sendMsg("query")).WillOnce(testing::Return(successSendMsgRes()));
+    EXPECT_CALL(*mocks->ctx, context()).Times(testing::AnyNumber());
+    EXPECT_CALL(*mocks->ctx, runState()).Times(testing::AnyNumber());
+
+    auto builder = getOpBuilderSendAr(sockFactoryMock);
+    auto event = std::make_shared<json::Json>(R"({})");
+    for (auto i = 0; i < 3; ++i)
+    {
+        auto operation = builder({makeValue(R"("query")")}, mocks->ctx);
+        ASSERT_TRUE(operation(event));
+    }
+}
+} // namespace
@@ -243,6 +243,48 @@ auto expectKvdbDeleteError(const std::string& key)
     };
 }
 
+filterbuildtest::BuilderGetter getCIDRMatch()
+{
+    return []()
+    {
+        auto kvdbMock = std::make_shared<MockKVDBManager>();
+        return getOpBuilderKVDBCIDRMatch(kvdbMock, SCOPE);
+    };
+}
+
+template<typename Dump>
+filterbuildtest::BuilderGetter getCIDRMatchExpectDump(const std::string& name, Dump&& dump)
+{
+    return [=]()
+    {
+        auto kvdbMock = std::make_shared<MockKVDBManager>();
+        auto kvdbHandlerMock = std::make_shared<MockKVDBHandler>();
+        EXPECT_CALL(*kvdbMock, getKVDBHandler(name, SCOPE)).WillOnce(testing::Return(kvdbHandlerMock));
+        EXPECT_CALL(*kvdbHandlerMock, dump(0, 0)).WillOnce(testing::Return(dump));
+        return getOpBuilderKVDBCIDRMatch(kvdbMock, SCOPE);
+    };
+}
+
+filterbuildtest::BuilderGetter getCIDRMatchExpectKeys(const std::string& name, const std::list<std::string>& keys)
+{
+    std::list<std::pair<std::string, std::string>> dump;
+    for (const auto& key : keys)
+    {
+        dump.emplace_back(key, "null");
+    }
+    return getCIDRMatchExpectDump(name, base::RespOrError<std::list<std::pair<std::string, std::string>>> {dump});
+}
+
+filterbuildtest::BuilderGetter getCIDRMatchExpectHandlerError(const std::string& name)
+{
+    return [=]()
+    {
+        auto kvdbMock = std::make_shared<MockKVDBManager>();
+        EXPECT_CALL(*kvdbMock, getKVDBHandler(name, SCOPE)).WillOnce(testing::Return(base::Error {"error"}));
+        return getOpBuilderKVDBCIDRMatch(kvdbMock, SCOPE);
+    };
+}
+
 } // namespace
 
 namespace filterbuildtest
@@ -1041,3 +1083,58 @@ INSTANTIATE_TEST_SUITE_P(
                            }))),
     testNameFormatter<TransformOperationWithDepsTest>("KVDB"));
 } // namespace transformoperatestest
+
+namespace filterbuildtest
+{
+INSTANTIATE_TEST_SUITE_P(
+    CIDRBuilders,
+    FilterBuilderWithDepsTest,
+    testing::Values(
+        FilterDepsT({}, getCIDRMatch(), FAILURE()),
+        FilterDepsT({makeRef("ref")}, getCIDRMatch(), FAILURE()),
+        FilterDepsT({makeValue(R"(1)")}, getCIDRMatch(), FAILURE()),
+        FilterDepsT({makeValue(R"("name")"), makeValue(R"("value")")}, getCIDRMatch(), FAILURE()),
+        FilterDepsT({makeValue(R"("name")")}, getCIDRMatchExpectKeys("name", {}), SUCCESS()),
+        FilterDepsT({makeValue(R"("name")")}, getCIDRMatchExpectKeys("name", {"10.0.0.0/8", "fe80::/10"}), SUCCESS()),
+        FilterDepsT({makeValue(R"("name")")}, getCIDRMatchExpectKeys("name", {"10.0.0.0/8", "invalid"}), FAILURE()),
+        FilterDepsT({makeValue(R"("name")")},
+                    getCIDRMatchExpectDump("name",
+                                           base::RespOrError<std::list<std::pair<std::string, std::string>>> {
+                                               base::Error {"error"}}),
+                    FAILURE()),
+        FilterDepsT({makeValue(R"("name")")}, getCIDRMatchExpectHandlerError("name"), FAILURE())),
+    testNameFormatter<FilterBuilderWithDepsTest>("KVDBCIDR"));
+} // namespace filterbuildtest
+
+namespace filteroperatestest
+{
+INSTANTIATE_TEST_SUITE_P(
+    CIDRBuilders,
+    FilterOperationWithDepsTest,
+    testing::Values(FilterDepsT(R"({"target": "10.1.2.3"})",
+                                getCIDRMatchExpectKeys("dbname", {"10.0.0.0/8", "fe80::/10"}),
+                                "target",
+                                {makeValue(R"("dbname")")},
+                                SUCCESS()),
+                    FilterDepsT(R"({"target": "fe80::1"})",
+                                getCIDRMatchExpectKeys("dbname", {"10.0.0.0/8", "fe80::/10"}),
+                                "target",
+                                {makeValue(R"("dbname")")},
+                                SUCCESS()),
+                    FilterDepsT(R"({"target": "11.0.0.1"})",
+                                getCIDRMatchExpectKeys("dbname", {"10.0.0.0/8", "fe80::/10"}),
+                                "target",
+                                {makeValue(R"("dbname")")},
+                                FAILURE()),
+                    FilterDepsT(R"({"target": "key"})",
+                                getCIDRMatchExpectKeys("dbname", {"10.0.0.0/8"}),
+                                "target",
+                                {makeValue(R"("dbname")")},
+                                FAILURE()),
+                    FilterDepsT(R"({"target": "10.1.2.3"})",
+                                getCIDRMatchExpectKeys("dbname", {"10.0.0.0/8"}),
+                                "notTarget",
+                                {makeValue(R"("dbname")")},
+                                FAILURE())),
+    testNameFormatter<FilterOperationWithDepsTest>("KVDBCIDR"));
+} // namespace filteroperatestest
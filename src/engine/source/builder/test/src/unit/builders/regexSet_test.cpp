@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+#include "builders/buildCtx.hpp"
+#include "builders/opfilter/opBuilderHelperFilter.hpp"
+#include "builders/regexSet.hpp"
+
+using namespace builder::builders;
+
+TEST(RegexSetTest, MatchesPatterns)
+{
+    RegexSet set;
+    ASSERT_EQ(set.add("^foo"), 0);
+    ASSERT_EQ(set.add("bar$"), 1);
+    ASSERT_EQ(set.add("baz"), 2);
+    ASSERT_EQ(set.size(), 3);
+
+    ASSERT_EQ(set.matches("foobar", 0), true);
+    ASSERT_EQ(set.matches("foobar", 1), true);
+    ASSERT_EQ(set.matches("foobar", 2), false);
+
+    // The cached matches belong to the value
+    ASSERT_EQ(set.matches("xfoo baz", 0), false);
+    ASSERT_EQ(set.matches("xfoo baz", 2), true);
+    ASSERT_EQ(set.matches("foobar", 0), true);
+}
+
+TEST(RegexSetTest, SealedAfterMatch)
+{
+    RegexSet set;
+    ASSERT_EQ(set.add("a"), 0);
+    ASSERT_EQ(set.matches("a", 0), true);
+    ASSERT_FALSE(set.add("b").has_value());
+}
+
+TEST(RegexSetTest, InvalidPattern)
+{
+    RegexSet set;
+    ASSERT_FALSE(set.add("(").has_value());
+    ASSERT_EQ(set.size(), 0);
+}
+
+TEST(RegexSetTest, Full)
+{
+    RegexSet set;
+    for (std::size_t i = 0; i < REGEX_SET_MAX_PATTERNS; ++i)
+    {
+        ASSERT_EQ(set.add("p" + std::to_string(i)), i);
+    }
+    ASSERT_FALSE(set.add("overflow").has_value());
+}
+
+TEST(RegexSetsTest, GroupsByField)
+{
+    RegexSets sets;
+    auto [setA, indexA] = sets.add("field", "a");
+    auto [setB, indexB] = sets.add("field", "b");
+    auto [setC, indexC] = sets.add("other", "c");
+
+    ASSERT_EQ(setA, setB);
+    ASSERT_EQ(indexA, 0);
+    ASSERT_EQ(indexB, 1);
+    ASSERT_NE(setA, setC);
+    ASSERT_EQ(indexC, 0);
+
+    // Once matched the set is sealed, the next patterns start a new one
+    ASSERT_EQ(setA->matches("b", indexB), true);
+    auto [setD, indexD] = sets.add("field", "d");
+    ASSERT_NE(setA, setD);
+    ASSERT_EQ(indexD, 0);
+
+    auto [invalid, indexInvalid] = sets.add("field", "(");
+    ASSERT_EQ(invalid, nullptr);
+}
+
+TEST(RegexSetsTest, SiblingFilters)
+{
+    auto buildCtx = std::make_shared<BuildCtx>();
+    buildCtx->runState().trace = false;
+
+    auto build = [&](auto builder, const std::string& regex)
+    {
+        const auto value = "\"" + regex + "\"";
+        return builder(Reference("target"), {std::make_shared<Value>(json::Json(value.c_str()))}, buildCtx);
+    };
+    auto startsWithVal = build(opfilter::opBuilderHelperRegexMatch, "^val");
+    auto endsWithUe = build(opfilter::opBuilderHelperRegexMatch, "ue$");
+    auto other = build(opfilter::opBuilderHelperRegexMatch, "^other");
+    auto notOther = build(opfilter::opBuilderHelperRegexNotMatch, "^other");
+
+    auto event = std::make_shared<json::Json>(R"({"target": "value"})");
+    ASSERT_TRUE(startsWithVal(event).success());
+    ASSERT_TRUE(endsWithUe(event).success());
+    ASSERT_TRUE(other(event).failure());
+    ASSERT_TRUE(notOther(event).success());
+
+    event = std::make_shared<json::Json>(R"({"target": "other value"})");
+    ASSERT_TRUE(startsWithVal(event).failure());
+    ASSERT_TRUE(endsWithUe(event).success());
+    ASSERT_TRUE(other(event).success());
+    ASSERT_TRUE(notOther(event).failure());
+
+    event = std::make_shared<json::Json>(R"({"notTarget": "value"})");
+    ASSERT_TRUE(startsWithVal(event).failure());
+}
@@ -16,7 +16,24 @@ INSTANTIATE_TEST_SUITE_P(Builders,
                                          StageT(R"({"key": "val", "key2": "val2"})", fileOutputBuilder, FAILURE()),
                                          StageT(R"({"path": 1})", fileOutputBuilder, FAILURE()),
                                          StageT(R"({"path": "///"})", fileOutputBuilder, FAILURE()),
+                                         StageT(R"({"max_size": 1024})", fileOutputBuilder, FAILURE()),
+                                         StageT(R"({"path": "/tmp/path", "max_size": 0})",
+                                                fileOutputBuilder,
+                                                FAILURE()),
+                                         StageT(R"({"path": "/tmp/path", "max_size": "1"})",
+                                                fileOutputBuilder,
+                                                FAILURE()),
+                                         StageT(R"({"path": "/tmp/path", "compress": 1})",
+                                                fileOutputBuilder,
+                                                FAILURE()),
+                                         StageT(R"({"path": "/tmp/path", "compress": true})",
+                                                fileOutputBuilder,
+                                                FAILURE()),
                                          StageT(R"({"path": "/tmp/path"})",
+                                                fileOutputBuilder,
+                                                SUCCESS(base::Term<base::EngineOp>::create("write.output(/tmp/path)",
+                                                                                           {}))),
+                                         StageT(R"({"path": "/tmp/path", "max_size": 1024, "compress": true})",
                                                 fileOutputBuilder,
                                                 SUCCESS(base::Term<base::EngineOp>::create("write.output(/tmp/path)",
                                                                                            {})))),
@@ -93,6 +110,22 @@ TEST_F(FileOutputTest, Create)
     ASSERT_TRUE(std::filesystem::exists(FILE_PATH));
 }
 
+TEST_F(FileOutputTest, SharedWriter)
+{
+    auto msg = std::make_shared<json::Json>(messageStr);
+    auto output = FileOutput(FILE_PATH);
+    auto other = FileOutput(FILE_PATH);
+    ASSERT_NO_THROW(output.write(msg));
+    ASSERT_NO_THROW(other.write(msg));
+    ASSERT_NO_THROW(other.flush());
+
+    std::ifstream ifs(FILE_PATH);
+    std::stringstream buffer;
+    buffer << ifs.rdbuf();
+
+    ASSERT_EQ(buffer.str(), std::string {compact_message} + compact_message);
+}
+
 TEST_F(FileOutputTest, UnknownPath)
 {
     ASSERT_THROW(FileOutput("/tmp45/file"), std::invalid_argument);
@@ -103,6 +136,7 @@ TEST_F(FileOutputTest, Write)
     auto msg = std::make_shared<json::Json>(messageStr);
     auto output = FileOutput(FILE_PATH);
     ASSERT_NO_THROW(output.write(msg));
+    ASSERT_NO_THROW(output.flush());
 
     std::ifstream ifs(FILE_PATH);
     std::stringstream buffer;
@@ -0,0 +1,275 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "builders/stage/fileWriter.hpp"
+
+using namespace builder::builders::detail;
+
+namespace
+{
+const std::filesystem::path TEST_DIR {"/tmp/fileWriter_test"};
+
+std::size_t countLines(const std::filesystem::path& path)
+{
+    std::ifstream ifs(path);
+    std::size_t lines = 0;
+    std::string line;
+    while (std::getline(ifs, line))
+    {
+        ++lines;
+    }
+    return lines;
+}
+} // namespace
+
+TEST(MPSCRingTest, PushPop)
+{
+    MPSCRing ring(3);
+    ASSERT_EQ(ring.capacity(), 4);
+    ASSERT_TRUE(ring.empty());
+
+    for (auto i = 0; i < 4; ++i)
+    {
+        auto value = std::make_shared<const std::string>(std::to_string(i));
+        ASSERT_TRUE(ring.push(value));
+        ASSERT_FALSE(value);
+    }
+
+    // Full, the value is kept
+    auto value = std::make_shared<const std::string>("full");
+    ASSERT_FALSE(ring.push(value));
+    ASSERT_EQ(*value, "full");
+
+    for (auto i = 0; i < 4; ++i)
+    {
+        ASSERT_TRUE(ring.pop(value));
+        ASSERT_EQ(*value, std::to_string(i));
+    }
+    ASSERT_TRUE(ring.empty());
+    ASSERT_FALSE(ring.pop(value));
+}
+
+TEST(MPSCRingTest, ConcurrentProducers)
+{
+    constexpr auto producers = 4;
+    constexpr auto perProducer = 10000;
+    MPSCRing ring(64);
+
+    std::vector<std::thread> threads;
+    for (auto p = 0; p < producers; ++p)
+    {
+        threads.emplace_back(
+            [&ring, p]()
+            {
+                for (auto i = 0; i < perProducer; ++i)
+                {
+                    auto value = std::make_shared<const std::string>(fmt::format("{}:{}", p, i));
+                    while (!ring.push(value))
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+    }
+
+    // Each producer's values come out in order
+    std::vector<int> next(producers, 0);
+    std::shared_ptr<const std::string> value;
+    for (auto popped = 0; popped < producers * perProducer;)
+    {
+        if (!ring.pop(value))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        const auto sep = value->find(':');
+        const auto p = std::stoi(value->substr(0, sep));
+        ASSERT_EQ(std::stoi(value->substr(sep + 1)), next[p]++);
+        ++popped;
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    ASSERT_TRUE(ring.empty());
+}
+
+class FileWriterTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        std::filesystem::remove_all(TEST_DIR);
+        std::filesystem::create_directories(TEST_DIR);
+    }
+
+    void TearDown() override { std::filesystem::remove_all(TEST_DIR); }
+};
+
+TEST_F(FileWriterTest, UnknownPath)
+{
+    ASSERT_THROW(FileWriter("/tmp45/file", {}), std::invalid_argument);
+}
+
+TEST_F(FileWriterTest, Flush)
+{
+    const auto path = TEST_DIR / "out";
+    FileWriter writer(path, {});
+    writer.write("first");
+    writer.write("second");
+    writer.flush();
+
+    std::ifstream ifs(path);
+    std::stringstream buffer;
+    buffer << ifs.rdbuf();
+    ASSERT_EQ(buffer.str(), "first\nsecond\n");
+}
+
+TEST_F(FileWriterTest, SharedLine)
+{
+    const auto path = TEST_DIR / "out";
+    const auto line = std::make_shared<const std::string>("shared");
+    FileWriter writer(path, {});
+    writer.write(line);
+    writer.write(line);
+    writer.flush();
+
+    std::ifstream ifs(path);
+    std::stringstream buffer;
+    buffer << ifs.rdbuf();
+    ASSERT_EQ(buffer.str(), "shared\nshared\n");
+    ASSERT_EQ(*line, "shared");
+}
+
+TEST_F(FileWriterTest, WritesOnDestruction)
+{
+    const auto path = TEST_DIR / "out";
+    {
+        FileWriterOptions options;
+        options.flushInterval = std::chrono::hours {1};
+        FileWriter writer(path, options);
+        writer.write("line");
+    }
+
+    ASSERT_EQ(countLines(path), 1);
+}
+
+TEST_F(FileWriterTest, Appends)
+{
+    const auto path = TEST_DIR / "out";
+    {
+        std::ofstream ofs(path);
+        ofs << "existing\n";
+    }
+
+    FileWriter writer(path, {});
+    writer.write("line");
+    writer.flush();
+    ASSERT_EQ(countLines(path), 2);
+}
+
+TEST_F(FileWriterTest, SharedByPath)
+{
+    const auto path = (TEST_DIR / "out").string();
+    auto writer = FileWriter::get(path);
+    ASSERT_EQ(writer, FileWriter::get(TEST_DIR / "." / "out"));
+    ASSERT_NE(writer, FileWriter::get(TEST_DIR / "other"));
+}
+
+TEST_F(FileWriterTest, ConcurrentWrites)
+{
+    constexpr auto producers = 8;
+    constexpr auto perProducer = 5000;
+    const auto path = TEST_DIR / "out";
+
+    FileWriterOptions options;
+    options.capacity = 128;
+    options.flushBytes = 4096;
+    FileWriter writer(path, options);
+
+    std::vector<std::thread> threads;
+    for (auto p = 0; p < producers; ++p)
+    {
+        threads.emplace_back(
+            [&writer, p]()
+            {
+                for (auto i = 0; i < perProducer; ++i)
+                {
+                    writer.write(fmt::format(R"({{"producer":{},"event":{}}})", p, i));
+                }
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    writer.flush();
+
+    ASSERT_EQ(countLines(path), producers * perProducer);
+}
+
+TEST_F(FileWriterTest, Rotates)
+{
+    const auto path = TEST_DIR / "out";
+    FileWriterOptions options;
+    options.flushBytes = 1;
+    options.maxSize = 100;
+    FileWriter writer(path, options);
+
+    // The file is rotated after the batch that reaches the size
+    for (auto i = 0; i < 50; ++i)
+    {
+        writer.write(std::string(9, 'a'));
+        writer.flush();
+    }
+
+    std::size_t files = 0;
+    std::size_t lines = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(TEST_DIR))
+    {
+        ASSERT_LE(std::filesystem::file_size(entry.path()), options.maxSize);
+        lines += countLines(entry.path());
+        ++files;
+    }
+    ASSERT_EQ(lines, 50);
+    ASSERT_EQ(files, 6);
+}
+
+TEST_F(FileWriterTest, RotatesCompressed)
+{
+    const auto path = TEST_DIR / "out";
+    FileWriterOptions options;
+    options.flushBytes = 1;
+    options.maxSize = 100;
+    options.compress = true;
+    FileWriter writer(path, options);
+
+    for (auto i = 0; i < 10; ++i)
+    {
+        writer.write(std::string(9, 'a'));
+        writer.flush();
+    }
+
+    std::size_t compressed = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(TEST_DIR))
+    {
+        if (entry.path().extension() == ".gz")
+        {
+            ++compressed;
+        }
+        else
+        {
+            ASSERT_EQ(entry.path(), path);
+        }
+    }
+    ASSERT_EQ(compressed, 1);
+    ASSERT_EQ(countLines(path), 0);
+}
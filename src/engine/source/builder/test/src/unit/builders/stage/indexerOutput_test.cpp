@@ -0,0 +1,53 @@
+#include "builders/baseBuilders_test.hpp"
+#include "builders/stage/indexerOutput.hpp"
+
+using namespace builder::builders;
+
+namespace
+{
+class NoopBulkClient : public detail::IBulkClient
+{
+public:
+    bool send(const std::string&, bool) override { return true; }
+};
+
+StageBuilder indexerOutputBuilder()
+{
+    return getIndexerOutputBuilder(
+        [](const std::string& index, const detail::IndexerWriterOptions& options)
+        { return std::make_shared<detail::IndexerWriter>(std::make_shared<NoopBulkClient>(), index, options); });
+}
+} // namespace
+
+namespace stagebuildtest
+{
+INSTANTIATE_TEST_SUITE_P(
+    Builders,
+    StageBuilderTest,
+    testing::Values(
+        StageT(R"([])", indexerOutputBuilder(), FAILURE()),
+        StageT(R"("notObject")", indexerOutputBuilder(), FAILURE()),
+        StageT(R"(1)", indexerOutputBuilder(), FAILURE()),
+        StageT(R"(null)", indexerOutputBuilder(), FAILURE()),
+        StageT(R"({})", indexerOutputBuilder(), FAILURE()),
+        StageT(R"({"key": "val"})", indexerOutputBuilder(), FAILURE()),
+        StageT(R"({"index": 1})", indexerOutputBuilder(), FAILURE()),
+        StageT(R"({"index": ""})", indexerOutputBuilder(), FAILURE()),
+        StageT(R"({"index": "wazuh/alerts"})", indexerOutputBuilder(), FAILURE()),
+        StageT(R"({"index": "Wazuh-alerts"})", indexerOutputBuilder(), FAILURE()),
+        StageT(R"({"index": "-wazuh-alerts"})", indexerOutputBuilder(), FAILURE()),
+        StageT(R"({"index": "wazuh \"alerts"})", indexerOutputBuilder(), FAILURE()),
+        StageT(R"({"bulk_size": 1024})", indexerOutputBuilder(), FAILURE()),
+        StageT(R"({"index": "wazuh-alerts", "bulk_size": 0})", indexerOutputBuilder(), FAILURE()),
+        StageT(R"({"index": "wazuh-alerts", "bulk_size": "1"})", indexerOutputBuilder(), FAILURE()),
+        StageT(R"({"index": "wazuh-alerts", "flush_interval": -1})", indexerOutputBuilder(), FAILURE()),
+        StageT(R"({"index": "wazuh-alerts", "compress": 1})", indexerOutputBuilder(), FAILURE()),
+        StageT(R"({"index": "wazuh-alerts"})", getIndexerOutputBuilder(builder::IndexerConnection {}), FAILURE()),
+        StageT(R"({"index": "wazuh-alerts"})",
+               indexerOutputBuilder(),
+               SUCCESS(base::Term<base::EngineOp>::create("write.indexer(wazuh-alerts)", {}))),
+        StageT(R"({"index": "wazuh-alerts", "bulk_size": 1024, "flush_interval": 100, "compress": false})",
+               indexerOutputBuilder(),
+               SUCCESS(base::Term<base::EngineOp>::create("write.indexer(wazuh-alerts)", {})))),
+    testNameFormatter<StageBuilderTest>("IndexerOutput"));
+} // namespace stagebuildtest
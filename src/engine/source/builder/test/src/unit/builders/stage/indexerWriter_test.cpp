@@ -0,0 +1,313 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <zlib.h>
+
+#include <fmt/format.h>
+#include <logging/logging.hpp>
+
+#include "builders/stage/indexerWriter.hpp"
+
+using namespace builder::builders::detail;
+
+namespace
+{
+const std::filesystem::path TEST_DIR {"/tmp/indexerWriter_test"};
+
+/**
+ * @brief Keeps the bodies it is sent, failing while told to.
+ */
+class FakeBulkClient : public IBulkClient
+{
+public:
+    std::mutex m_mutex;
+    std::vector<std::string> m_bodies;
+    std::vector<bool> m_gzip;
+    std::atomic<bool> m_fail {false};
+    std::atomic<std::size_t> m_attempts {0};
+
+    bool send(const std::string& body, bool gzip) override
+    {
+        ++m_attempts;
+        if (m_fail)
+        {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_bodies.push_back(body);
+        m_gzip.push_back(gzip);
+        return true;
+    }
+
+    std::vector<std::string> bodies()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_bodies;
+    }
+};
+
+std::string gunzip(const std::string& input)
+{
+    z_stream stream {};
+    inflateInit2(&stream, 15 + 32);
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+    stream.avail_in = static_cast<uInt>(input.size());
+
+    std::string output;
+    char buffer[4096];
+    int result = Z_OK;
+    while (result == Z_OK)
+    {
+        stream.next_out = reinterpret_cast<Bytef*>(buffer);
+        stream.avail_out = sizeof(buffer);
+        result = inflate(&stream, Z_NO_FLUSH);
+        output.append(buffer, sizeof(buffer) - stream.avail_out);
+    }
+    inflateEnd(&stream);
+    EXPECT_EQ(result, Z_STREAM_END);
+    return output;
+}
+
+std::size_t countLines(const std::string& body)
+{
+    return static_cast<std::size_t>(std::count(body.begin(), body.end(), '\n'));
+}
+
+IndexerWriterOptions plainOptions()
+{
+    IndexerWriterOptions options;
+    options.compress = false;
+    options.flushInterval = std::chrono::seconds(60);
+    return options;
+}
+} // namespace
+
+class IndexerWriterTest : public ::testing::Test
+{
+protected:
+    std::shared_ptr<FakeBulkClient> m_client;
+
+    void SetUp() override
+    {
+        logging::testInit();
+        std::filesystem::remove_all(TEST_DIR);
+        m_client = std::make_shared<FakeBulkClient>();
+    }
+
+    void TearDown() override { std::filesystem::remove_all(TEST_DIR); }
+};
+
+TEST_F(IndexerWriterTest, Build)
+{
+    ASSERT_THROW(IndexerWriter(nullptr, "index", plainOptions()), std::runtime_error);
+    ASSERT_THROW(IndexerWriter(m_client, "", plainOptions()), std::runtime_error);
+    ASSERT_NO_THROW(IndexerWriter(m_client, "index", plainOptions()));
+}
+
+TEST_F(IndexerWriterTest, BulkFormat)
+{
+    IndexerWriter writer(m_client, "wazuh-alerts", plainOptions());
+    writer.write(R"({"a":1})");
+    writer.write(R"({"b":2})");
+    writer.flush();
+
+    auto bodies = m_client->bodies();
+    ASSERT_EQ(bodies.size(), 1);
+    ASSERT_EQ(bodies[0],
+              "{\"index\":{\"_index\":\"wazuh-alerts\"}}\n{\"a\":1}\n"
+              "{\"index\":{\"_index\":\"wazuh-alerts\"}}\n{\"b\":2}\n");
+    ASSERT_EQ(writer.acknowledged(), 1);
+    ASSERT_EQ(writer.pending(), 0);
+}
+
+TEST_F(IndexerWriterTest, BatchesBySize)
+{
+    auto options = plainOptions();
+    options.bulkBytes = 1024;
+    IndexerWriter writer(m_client, "index", options);
+
+    const std::string document(100, 'x');
+    for (auto i = 0; i < 100; ++i)
+    {
+        writer.write(std::string(document));
+    }
+    writer.flush();
+
+    auto bodies = m_client->bodies();
+    ASSERT_GT(bodies.size(), 1);
+    std::size_t lines = 0;
+    for (std::size_t i = 0; i < bodies.size(); ++i)
+    {
+        // Only the last bulk is closed before holding enough bytes
+        if (i + 1 < bodies.size())
+        {
+            ASSERT_GE(bodies[i].size(), options.bulkBytes);
+            ASSERT_LT(bodies[i].size(), options.bulkBytes + 200);
+        }
+        lines += countLines(bodies[i]);
+    }
+    ASSERT_EQ(lines, 200);
+}
+
+TEST_F(IndexerWriterTest, BatchesByTime)
+{
+    auto options = plainOptions();
+    options.flushInterval = std::chrono::milliseconds(20);
+    IndexerWriter writer(m_client, "index", options);
+
+    writer.write(R"({"a":1})");
+    for (auto i = 0; i < 200 && writer.acknowledged() == 0; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_EQ(writer.acknowledged(), 1);
+    ASSERT_EQ(countLines(m_client->bodies()[0]), 2);
+}
+
+TEST_F(IndexerWriterTest, Gzip)
+{
+    auto options = plainOptions();
+    options.compress = true;
+    IndexerWriter writer(m_client, "index", options);
+
+    for (auto i = 0; i < 50; ++i)
+    {
+        writer.write(fmt::format(R"({{"i":{}}})", i));
+    }
+    writer.flush();
+
+    auto bodies = m_client->bodies();
+    ASSERT_EQ(bodies.size(), 1);
+    ASSERT_TRUE(m_client->m_gzip[0]);
+    auto body = gunzip(bodies[0]);
+    ASSERT_EQ(countLines(body), 100);
+    ASSERT_LT(bodies[0].size(), body.size());
+}
+
+TEST_F(IndexerWriterTest, RetriesUntilAcknowledged)
+{
+    auto options = plainOptions();
+    options.retryMin = std::chrono::milliseconds(5);
+    options.retryMax = std::chrono::milliseconds(20);
+    m_client->m_fail = true;
+    IndexerWriter writer(m_client, "index", options);
+
+    writer.write(R"({"a":1})");
+    writer.flush();
+    ASSERT_EQ(writer.pending(), 1);
+    ASSERT_EQ(writer.acknowledged(), 0);
+
+    m_client->m_fail = false;
+    for (auto i = 0; i < 200 && writer.pending() != 0; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_EQ(writer.pending(), 0);
+    ASSERT_EQ(writer.acknowledged(), 1);
+    ASSERT_GT(m_client->m_attempts, 1);
+}
+
+TEST_F(IndexerWriterTest, KeepsUnacknowledgedInQueueDir)
+{
+    auto options = plainOptions();
+    options.compress = true;
+    options.queueDir = TEST_DIR.string();
+    m_client->m_fail = true;
+    {
+        IndexerWriter writer(m_client, "index", options);
+        writer.write(R"({"a":1})");
+        writer.flush();
+        writer.write(R"({"b":2})");
+        writer.flush();
+        ASSERT_EQ(writer.pending(), 2);
+    }
+
+    std::size_t files = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(TEST_DIR / "index"))
+    {
+        ASSERT_EQ(entry.path().extension(), ".gz");
+        ++files;
+    }
+    ASSERT_EQ(files, 2);
+
+    // The next writer of the index sends them first, oldest first
+    m_client->m_fail = false;
+    {
+        IndexerWriter writer(m_client, "index", options);
+        writer.write(R"({"c":3})");
+        writer.flush();
+        ASSERT_EQ(writer.pending(), 0);
+        ASSERT_EQ(writer.acknowledged(), 3);
+    }
+
+    auto bodies = m_client->bodies();
+    ASSERT_EQ(bodies.size(), 3);
+    ASSERT_NE(gunzip(bodies[0]).find(R"({"a":1})"), std::string::npos);
+    ASSERT_NE(gunzip(bodies[1]).find(R"({"b":2})"), std::string::npos);
+    ASSERT_NE(gunzip(bodies[2]).find(R"({"c":3})"), std::string::npos);
+    ASSERT_TRUE(std::filesystem::is_empty(TEST_DIR / "index"));
+}
+
+TEST_F(IndexerWriterTest, DropsOldestInMemory)
+{
+    auto options = plainOptions();
+    options.maxPending = 2;
+    m_client->m_fail = true;
+    IndexerWriter writer(m_client, "index", options);
+
+    for (auto i = 0; i < 4; ++i)
+    {
+        writer.write(fmt::format(R"({{"i":{}}})", i));
+        writer.flush();
+    }
+    ASSERT_EQ(writer.pending(), 2);
+    ASSERT_EQ(writer.dropped(), 2);
+
+    m_client->m_fail = false;
+    writer.flush();
+    auto bodies = m_client->bodies();
+    ASSERT_EQ(bodies.size(), 2);
+    ASSERT_NE(bodies[0].find(R"({"i":2})"), std::string::npos);
+    ASSERT_NE(bodies[1].find(R"({"i":3})"), std::string::npos);
+}
+
+TEST_F(IndexerWriterTest, ConcurrentProducers)
+{
+    auto options = plainOptions();
+    options.capacity = 64;
+    options.bulkBytes = 4096;
+    IndexerWriter writer(m_client, "index", options);
+
+    constexpr auto producers = 4;
+    constexpr auto documents = 1000;
+    std::vector<std::thread> threads;
+    for (auto p = 0; p < producers; ++p)
+    {
+        threads.emplace_back(
+            [&writer, p]()
+            {
+                for (auto i = 0; i < documents; ++i)
+                {
+                    writer.write(fmt::format(R"({{"p":{},"i":{}}})", p, i));
+                }
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    writer.flush();
+
+    std::size_t lines = 0;
+    for (const auto& body : m_client->bodies())
+    {
+        lines += countLines(body);
+    }
+    ASSERT_EQ(lines, 2 * producers * documents);
+}
@@ -71,11 +71,17 @@ INSTANTIATE_TEST_SUITE_P(
                    [](const auto& mocks)
                    {
                        const auto& innerRegistry = mocks.registry->template getRegistry<StageBuilder>();
+                       auto ctx = std::make_shared<MockBuildCtx>();
+                       EXPECT_CALL(*mocks.ctx, clone()).WillOnce(testing::Return(ctx));
+                       EXPECT_CALL(*ctx, setOutputBuffer(testing::NotNull()));
                        EXPECT_CALL(*mocks.ctx, registry()).WillRepeatedly(testing::ReturnRef(*mocks.registry));
                        EXPECT_CALL(innerRegistry, get("output1")).WillOnce(testing::Return(dummyStageBuilder()));
                        EXPECT_CALL(innerRegistry, get("output2")).WillOnce(testing::Return(dummyStageBuilder()));
-                       return base::Broadcast::create("outputs",
-                                                      {base::And::create("dummy", {}), base::And::create("dummy", {})});
+                       return base::Chain::create(
+                           "outputs",
+                           {base::Term<base::EngineOp>::create("outputs.serialize", {}),
+                            base::Broadcast::create("outputs.broadcast",
+                                                    {base::And::create("dummy", {}), base::And::create("dummy", {})})});
                    })),
         StageT(R"([{"output1": "ingnored", "output2": "ingnored"}])", outputsBuilder, FAILURE())),
     testNameFormatter<StageBuilderTest>("Outputs"));
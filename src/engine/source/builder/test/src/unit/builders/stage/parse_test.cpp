@@ -42,6 +42,17 @@ INSTANTIATE_TEST_SUITE_P(
                        return base::Or::create("parse", {base::Term<base::EngineOp>::create("expr", {})});
                    })),
         StageT(R"([{"target": "expr"}, {"target": "other"}])",
+               getBuilder(),
+               SUCCESS(
+                   [](const auto& mocks)
+                   {
+                       EXPECT_CALL(*mocks.ctx, definitions()).WillRepeatedly(testing::ReturnRef(*mocks.definitions));
+                       EXPECT_CALL(*mocks.definitions, replace(testing::_))
+                           .WillRepeatedly(testing::Invoke([](const auto& expr) { return std::string(expr); }));
+
+                       return base::Or::create("parse", {base::Term<base::EngineOp>::create("expr | other", {})});
+                   })),
+        StageT(R"([{"target": "expr"}, {"other": "other"}, {"other": "expr"}, {"target": "expr"}])",
                getBuilder(),
                SUCCESS(
                    [](const auto& mocks)
@@ -52,7 +63,8 @@ INSTANTIATE_TEST_SUITE_P(
 
                        return base::Or::create("parse",
                                                {base::Term<base::EngineOp>::create("expr", {}),
-                                                base::Term<base::EngineOp>::create("other", {})});
+                                                base::Term<base::EngineOp>::create("other | expr", {}),
+                                                base::Term<base::EngineOp>::create("expr", {})});
                    })),
         StageT(R"([{"target": "expr"}, {"target": "<invalid/expression"}])",
                getBuilder(),
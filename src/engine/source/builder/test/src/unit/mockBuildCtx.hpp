@@ -22,6 +22,10 @@ public:
     MOCK_METHOD((const Context&), context, (), (const));
     MOCK_METHOD((Context&), context, (), ());
     MOCK_METHOD((std::shared_ptr<const RunState>), runState, (), (const));
+    MOCK_METHOD((std::shared_ptr<RegexSets>), regexSets, (), (const));
+    MOCK_METHOD((std::shared_ptr<MMDBGroups>), mmdbGroups, (), (const));
+    MOCK_METHOD((std::shared_ptr<OutputBuffer>), outputBuffer, (), (const));
+    MOCK_METHOD(void, setOutputBuffer, (const std::shared_ptr<OutputBuffer>& outputBuffer), ());
 };
 
 } // namespace builder::builders::mocks
@@ -2,6 +2,8 @@
 
 #include <sstream>
 
+#include <fmt/format.h>
+
 #include <store/mockStore.hpp>
 #include <test/behaviour.hpp>
 
@@ -356,6 +358,120 @@ INSTANTIATE_TEST_SUITE_P(
 
             ));
 
+namespace
+{
+Asset makeAsset(const std::string& name, std::vector<base::Name> parents = {})
+{
+    return Asset {base::Name(name), base::And::create(name, {}), std::move(parents)};
+}
+} // namespace
+
+TEST(BuildAssetsCache, ReusesUnchangedAssets)
+{
+    auto assetBuilder = std::make_shared<MockAssetBuilder>();
+    auto store = std::make_shared<MockStoreRead>();
+    auto cache = std::make_shared<builder::AssetCache>();
+    factory::PolicyData policyData(D {.name = "test",
+                                      .hash = "test",
+                                      .defaultParents = {{"ns", "decoder/parent"}},
+                                      .assets = {{factory::PolicyData::AssetType::DECODER,
+                                                  {{"ns", {{"decoder/parent"}, {"decoder/child"}}}}}}});
+
+    json::Json parentDoc {R"({"name": "decoder/parent"})"};
+    json::Json childDoc {R"({"name": "decoder/child"})"};
+    auto parent = makeAsset("decoder/parent");
+    auto child = makeAsset("decoder/child");
+    EXPECT_CALL(*store, readDoc(base::Name("decoder/parent")))
+        .WillRepeatedly(testing::Return(storeReadDocResp(parentDoc)));
+    EXPECT_CALL(*store, readDoc(base::Name("decoder/child")))
+        .WillRepeatedly(testing::Return(storeReadDocResp(childDoc)));
+    EXPECT_CALL(*assetBuilder, CallableOp(parentDoc)).WillOnce(testing::Return(parent));
+    EXPECT_CALL(*assetBuilder, CallableOp(childDoc)).WillOnce(testing::Return(child));
+
+    factory::BuiltAssets first;
+    ASSERT_NO_THROW(first = factory::buildAssets(policyData, store, assetBuilder, cache));
+    ASSERT_EQ(cache->size(), 2);
+    ASSERT_EQ(cache->misses(), 2);
+
+    // The second build takes both assets from the cache, the cached parents are the declared ones
+    factory::BuiltAssets second;
+    ASSERT_NO_THROW(second = factory::buildAssets(policyData, store, assetBuilder, cache));
+    ASSERT_EQ(cache->hits(), 2);
+    ASSERT_EQ(first, second);
+    ASSERT_EQ(second[factory::PolicyData::AssetType::DECODER]["decoder/child"].parents(),
+              std::vector<base::Name> {"decoder/parent"});
+}
+
+TEST(BuildAssetsCache, RebuildsChangedAssets)
+{
+    auto assetBuilder = std::make_shared<MockAssetBuilder>();
+    auto store = std::make_shared<MockStoreRead>();
+    auto cache = std::make_shared<builder::AssetCache>();
+    factory::PolicyData policyData(
+        D {.name = "test",
+           .hash = "test",
+           .assets = {{factory::PolicyData::AssetType::DECODER, {{"ns", {{"decoder/asset"}}}}}}});
+
+    json::Json oldDoc {R"({"name": "decoder/asset", "check": "old"})"};
+    json::Json newDoc {R"({"name": "decoder/asset", "check": "new"})"};
+    auto oldAsset = makeAsset("decoder/asset");
+    auto newAsset = makeAsset("decoder/asset");
+    EXPECT_CALL(*store, readDoc(base::Name("decoder/asset")))
+        .WillOnce(testing::Return(storeReadDocResp(oldDoc)))
+        .WillOnce(testing::Return(storeReadDocResp(newDoc)));
+    EXPECT_CALL(*assetBuilder, CallableOp(oldDoc)).WillOnce(testing::Return(oldAsset));
+    EXPECT_CALL(*assetBuilder, CallableOp(newDoc)).WillOnce(testing::Return(newAsset));
+
+    factory::buildAssets(policyData, store, assetBuilder, cache);
+    auto got = factory::buildAssets(policyData, store, assetBuilder, cache);
+    ASSERT_EQ(got[factory::PolicyData::AssetType::DECODER]["decoder/asset"], newAsset);
+    ASSERT_EQ(cache->size(), 1);
+    ASSERT_EQ(cache->hits(), 0);
+}
+
+TEST(BuildAssetsParallel, BuildsAllAssets)
+{
+    auto assetBuilder = std::make_shared<MockAssetBuilder>();
+    auto store = std::make_shared<MockStoreRead>();
+    std::unordered_set<base::Name> names;
+    factory::BuiltAssets expected;
+    for (auto i = 0; i < 32; ++i)
+    {
+        auto name = fmt::format("rule/asset-{}", i);
+        names.emplace(name);
+        auto doc = json::Json {fmt::format(R"({{"name": "{}"}})", name).c_str()};
+        auto asset = makeAsset(name);
+        EXPECT_CALL(*store, readDoc(base::Name(name))).WillOnce(testing::Return(storeReadDocResp(doc)));
+        EXPECT_CALL(*assetBuilder, CallableOp(doc)).WillOnce(testing::Return(asset));
+        expected[factory::PolicyData::AssetType::RULE].emplace(name, asset);
+    }
+    factory::PolicyData policyData(
+        D {.name = "test", .hash = "test", .assets = {{factory::PolicyData::AssetType::RULE, {{"ns", names}}}}});
+
+    factory::BuiltAssets got;
+    ASSERT_NO_THROW(got = factory::buildAssets(policyData, store, assetBuilder, nullptr, 4));
+    ASSERT_EQ(got, expected);
+}
+
+TEST(BuildAssetsParallel, Failure)
+{
+    auto assetBuilder = std::make_shared<MockAssetBuilder>();
+    auto store = std::make_shared<MockStoreRead>();
+    std::unordered_set<base::Name> names;
+    for (auto i = 0; i < 8; ++i)
+    {
+        names.emplace(fmt::format("rule/asset-{}", i));
+    }
+    factory::PolicyData policyData(
+        D {.name = "test", .hash = "test", .assets = {{factory::PolicyData::AssetType::RULE, {{"ns", names}}}}});
+
+    store::Doc asset;
+    EXPECT_CALL(*store, readDoc(testing::_)).WillRepeatedly(testing::Return(storeReadDocResp(asset)));
+    EXPECT_CALL(*assetBuilder, CallableOp(asset)).WillRepeatedly(testing::Throw(std::runtime_error("")));
+
+    ASSERT_THROW(factory::buildAssets(policyData, store, assetBuilder, nullptr, 4), std::runtime_error);
+}
+
 } // namespace buildassetstest
 
 namespace buildgraphtest
@@ -802,3 +918,91 @@ INSTANTIATE_TEST_SUITE_P(
             ));
 
 } // namespace buildexpressiontest
+
+namespace splicetest
+{
+using namespace base;
+using D = factory::PolicyData::Params;
+
+TEST(SpliceExpression, CopiesOnlyThePathToTheReplaced)
+{
+    auto a = And::create("decoder/a", {});
+    auto b = And::create("decoder/b", {});
+    auto c = And::create("decoder/c", {});
+    auto d = And::create("decoder/d", {});
+    auto aChildren = Or::create("decoder/a/Children", {b, c});
+    auto aNode = Implication::create("decoder/a/Node", a, aChildren);
+    auto input = Or::create("decoder/Input", {aNode, d});
+    Expression policy = Chain::create("policy/test", {input});
+
+    auto newB = And::create("decoder/b", {});
+    Expression spliced;
+    ASSERT_NO_THROW(spliced = factory::spliceExpression(policy, {{b.get(), newB}}));
+
+    // The original expression is not modified
+    ASSERT_EQ(aChildren->getOperands()[0], b);
+
+    auto splicedInput = spliced->getPtr<Operation>()->getOperands()[0];
+    auto splicedNode = splicedInput->getPtr<Operation>()->getOperands()[0];
+    auto splicedChildren = splicedNode->getPtr<Operation>()->getOperands()[1];
+    ASSERT_NE(spliced, policy);
+    ASSERT_TRUE(spliced->isChain());
+    ASSERT_EQ(spliced->getName(), policy->getName());
+    ASSERT_NE(splicedInput, input);
+    ASSERT_TRUE(splicedNode->isImplication());
+    ASSERT_NE(splicedNode, aNode);
+    ASSERT_EQ(splicedNode->getPtr<Operation>()->getOperands()[0], a);
+    ASSERT_EQ(splicedChildren->getPtr<Operation>()->getOperands()[0], newB);
+    ASSERT_EQ(splicedChildren->getPtr<Operation>()->getOperands()[1], c);
+    ASSERT_EQ(splicedInput->getPtr<Operation>()->getOperands()[1], d);
+}
+
+TEST(SpliceExpression, CopiesSharedNodesOnce)
+{
+    auto shared = And::create("rule/shared", {});
+    auto sharedNode = Implication::create("rule/shared/Node", shared, Broadcast::create("rule/shared/Children", {}));
+    auto p1 = Implication::create("rule/p1/Node", And::create("rule/p1", {}), Broadcast::create("c1", {sharedNode}));
+    auto p2 = Implication::create("rule/p2/Node", And::create("rule/p2", {}), Broadcast::create("c2", {sharedNode}));
+    Expression policy = Broadcast::create("rule/Input", {p1, p2});
+
+    auto newShared = And::create("rule/shared", {});
+    auto spliced = factory::spliceExpression(policy, {{shared.get(), newShared}});
+
+    auto child = [](const Expression& node)
+    {
+        return node->getPtr<Operation>()->getOperands()[1]->getPtr<Operation>()->getOperands()[0];
+    };
+    const auto& operands = spliced->getPtr<Operation>()->getOperands();
+    ASSERT_NE(child(operands[0]), sharedNode);
+    ASSERT_EQ(child(operands[0]), child(operands[1]));
+    ASSERT_EQ(child(operands[0])->getPtr<Operation>()->getOperands()[0], newShared);
+}
+
+TEST(SpliceExpression, NothingReplaced)
+{
+    Expression policy = Chain::create("policy/test", {Or::create("decoder/Input", {And::create("decoder/a", {})})});
+    ASSERT_EQ(factory::spliceExpression(policy, {}), policy);
+}
+
+TEST(LayoutHash, DependsOnTheRelations)
+{
+    factory::PolicyData policyData(D {.name = "test", .hash = "test"});
+    auto built = [](std::vector<base::Name> parents)
+    {
+        factory::BuiltAssets assets;
+        auto& decoders = assets[factory::PolicyData::AssetType::DECODER];
+        decoders.emplace("decoder/parent",
+                         builder::policy::Asset {"decoder/parent", And::create("decoder/parent", {}), {}});
+        decoders.emplace(
+            "decoder/child",
+            builder::policy::Asset {"decoder/child", And::create("decoder/child", {}), std::move(parents)});
+        return assets;
+    };
+
+    // The expressions of the assets do not change the layout
+    ASSERT_EQ(factory::layoutHash(built({"decoder/parent"}), policyData),
+              factory::layoutHash(built({"decoder/parent"}), policyData));
+    ASSERT_NE(factory::layoutHash(built({"decoder/parent"}), policyData), factory::layoutHash(built({}), policyData));
+}
+
+} // namespace splicetest
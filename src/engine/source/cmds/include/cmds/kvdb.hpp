@@ -1,6 +1,7 @@
 #ifndef _CMD_KVDB_HPP
 #define _CMD_KVDB_HPP
 
+#include <optional>
 #include <string>
 
 #include <CLI/CLI.hpp>
@@ -19,6 +20,7 @@ constexpr auto API_KVDB_CREATE_SUBCOMMAND {"create"};
 constexpr auto API_KVDB_DELETE_SUBCOMMAND {"delete"};
 constexpr auto API_KVDB_DUMP_SUBCOMMAND {"dump"};
 constexpr auto API_KVDB_GET_SUBCOMMAND {"get"};
+constexpr auto API_KVDB_IMPORT_SUBCOMMAND {"import"};
 constexpr auto API_KVDB_INSERT_SUBCOMMAND {"insert"};
 constexpr auto API_KVDB_LIST_SUBCOMMAND {"list"};
 constexpr auto API_KVDB_REMOVE_SUBCOMMAND {"remove"};
@@ -30,10 +32,15 @@ void runList(std::shared_ptr<apiclnt::Client> client, const std::string& kvdbNam
 void runCreate(std::shared_ptr<apiclnt::Client> client,
                const std::string& kvdbName,
                const std::string& kvdbInputFilePath);
+void runImport(std::shared_ptr<apiclnt::Client> client,
+               const std::string& kvdbName,
+               const std::string& kvdbInputFilePath,
+               bool replace);
 void runDump(std::shared_ptr<apiclnt::Client> client,
              const std::string& kvdbName,
              const unsigned int page,
-             const unsigned int records);
+             const unsigned int records,
+             const std::optional<std::string>& cursor = std::nullopt);
 void runDelete(std::shared_ptr<apiclnt::Client> client, const std::string& kvdbName);
 void runGetKV(std::shared_ptr<apiclnt::Client> client, const std::string& kvdbName, const std::string& kvdbKey);
 void runInsertKV(std::shared_ptr<apiclnt::Client> client,
@@ -45,7 +52,8 @@ void runSearch(std::shared_ptr<apiclnt::Client> client,
                const std::string& kvdbName,
                const std::string& prefix,
                const unsigned int page,
-               const unsigned int records);
+               const unsigned int records,
+               const std::optional<std::string>& cursor = std::nullopt);
 void configure(const CLI::App_p& app);
 
 } // namespace cmd::kvdb
@@ -16,6 +16,9 @@ constexpr auto ENGINE_LOG_OUTPUT_ENV = "WZE_LOG_OUTPUT";
 constexpr auto ENGINE_LOG_TRUNCATE = false;
 constexpr auto ENGINE_LOG_TRUNCATE_ENV = "WZE_LOG_TRUNCATE";
 
+constexpr auto ENGINE_LOG_THREADS = 1; // 0 = log from the calling thread
+constexpr auto ENGINE_LOG_THREADS_ENV = "WZE_LOG_THREADS";
+
 // Server module
 constexpr auto ENGINE_SRV_PULL_THREADS = 1;
 constexpr auto ENGINE_SRV_PULL_THREADS_ENV = "WZE_PULL_THREADS";
@@ -25,12 +28,18 @@ constexpr auto ENGINE_SRV_EVENT_SOCK_ENV = "WZE_EVENT_SOCK";
 
 constexpr auto ENGINE_SRV_EVENT_QUEUE_TASK = 0;
 constexpr auto ENGINE_SRV_EVENT_QUEUE_TASK_ENV = "WZE_EVENT_QUEUE_TASK";
+constexpr auto ENGINE_SRV_EVENT_BATCH_SIZE = 1;
+constexpr auto ENGINE_SRV_EVENT_BATCH_SIZE_ENV = "WZE_EVENT_BATCH_SIZE";
 
 constexpr auto ENGINE_SRV_API_SOCK = "/var/ossec/queue/sockets/engine-api";
 constexpr auto ENGINE_SRV_API_SOCK_ENV = "WZE_API_SOCK";
 
 constexpr auto ENGINE_SRV_API_QUEUE_TASK = 50;
 constexpr auto ENGINE_SRV_API_QUEUE_TASK_ENV = "WZE_API_QUEUE_TASK";
+constexpr auto ENGINE_SRV_API_WORKERS = 2;
+constexpr auto ENGINE_SRV_API_WORKERS_ENV = "WZE_API_WORKERS";
+constexpr auto ENGINE_SRV_API_SLOW_WORKERS = 1;
+constexpr auto ENGINE_SRV_API_SLOW_WORKERS_ENV = "WZE_API_SLOW_WORKERS";
 
 constexpr auto ENGINE_CLIENT_TIMEOUT = 1000;
 constexpr auto ENGINE_SRV_API_TIMEOUT = 1000;
@@ -40,10 +49,46 @@ constexpr auto ENGINE_SRV_API_TIMEOUT_ENV = "WZE_API_TIMEOUT";
 constexpr auto ENGINE_DEFAULT_POLICY = "policy/wazuh/0";
 constexpr auto ENGINE_STORE_PATH = "/var/ossec/engine/store";
 constexpr auto ENGINE_STORE_PATH_ENV = "WZE_STORE_PATH";
+constexpr auto ENGINE_STORE_CACHE = true;
+constexpr auto ENGINE_STORE_CACHE_ENV = "WZE_STORE_CACHE";
 
 // KVDB module
 constexpr auto ENGINE_KVDB_PATH = "/var/ossec/etc/kvdb/";
 constexpr auto ENGINE_KVDB_PATH_ENV = "WZE_KVDB_PATH";
+constexpr auto ENGINE_KVDB_CACHE_SIZE = 4096;
+constexpr auto ENGINE_KVDB_CACHE_SIZE_ENV = "WZE_KVDB_CACHE_SIZE";
+constexpr auto ENGINE_KVDB_BLOCK_CACHE_SIZE = 64; // MiB
+constexpr auto ENGINE_KVDB_BLOCK_CACHE_SIZE_ENV = "WZE_KVDB_BLOCK_CACHE_SIZE";
+constexpr auto ENGINE_KVDB_BLOOM_BITS = 10;
+constexpr auto ENGINE_KVDB_BLOOM_BITS_ENV = "WZE_KVDB_BLOOM_BITS";
+constexpr auto ENGINE_KVDB_POINT_LOOKUP = true;
+constexpr auto ENGINE_KVDB_POINT_LOOKUP_ENV = "WZE_KVDB_POINT_LOOKUP";
+constexpr auto ENGINE_KVDB_COMPRESSION = "*:none";
+constexpr auto ENGINE_KVDB_COMPRESSION_ENV = "WZE_KVDB_COMPRESSION";
+constexpr auto ENGINE_KVDB_STATISTICS_INTERVAL = 10; // Seconds
+constexpr auto ENGINE_KVDB_STATISTICS_INTERVAL_ENV = "WZE_KVDB_STATISTICS_INTERVAL";
+
+// WDB module
+constexpr auto ENGINE_WDB_POOL_SIZE = 4;
+constexpr auto ENGINE_WDB_POOL_SIZE_ENV = "WZE_WDB_POOL_SIZE";
+constexpr auto ENGINE_WDB_CACHE_TTL = 1000; // Milliseconds
+constexpr auto ENGINE_WDB_CACHE_TTL_ENV = "WZE_WDB_CACHE_TTL";
+
+// Builder module
+constexpr auto ENGINE_BUILDER_THREADS = 0; // One per core
+constexpr auto ENGINE_BUILDER_THREADS_ENV = "WZE_BUILDER_THREADS";
+
+// Indexer outputs
+constexpr auto ENGINE_INDEXER_URL = ""; // No indexer outputs
+constexpr auto ENGINE_INDEXER_URL_ENV = "WZE_INDEXER_URL";
+constexpr auto ENGINE_INDEXER_USER = "";
+constexpr auto ENGINE_INDEXER_USER_ENV = "WZE_INDEXER_USER";
+constexpr auto ENGINE_INDEXER_PASSWORD = "";
+constexpr auto ENGINE_INDEXER_PASSWORD_ENV = "WZE_INDEXER_PASSWORD";
+constexpr auto ENGINE_INDEXER_CA = "";
+constexpr auto ENGINE_INDEXER_CA_ENV = "WZE_INDEXER_CA";
+constexpr auto ENGINE_INDEXER_QUEUE_DIR = "/var/ossec/engine/indexer-queue";
+constexpr auto ENGINE_INDEXER_QUEUE_DIR_ENV = "WZE_INDEXER_QUEUE_DIR";
 
 // TZDB
 constexpr auto ENGINE_TZDB_PATH = "/var/ossec/engine/tzdb";
@@ -58,6 +103,18 @@ constexpr auto ENGINE_KVDB_CLI_RECORDS = 50;
 constexpr auto ENGINE_ROUTER_THREADS = 1;
 constexpr auto ENGINE_ROUTER_THREADS_ENV = "WZE_ROUTER_THREADS";
 
+constexpr auto ENGINE_ROUTER_BATCH_SIZE = 1;
+constexpr auto ENGINE_ROUTER_BATCH_SIZE_ENV = "WZE_ROUTER_BATCH_SIZE";
+
+constexpr auto ENGINE_ROUTER_PIN_WORKERS = false;
+constexpr auto ENGINE_ROUTER_PIN_WORKERS_ENV = "WZE_ROUTER_PIN_WORKERS";
+
+constexpr auto ENGINE_ROUTER_BACKEND = "rx";
+constexpr auto ENGINE_ROUTER_BACKEND_ENV = "WZE_ROUTER_BACKEND";
+
+constexpr auto ENGINE_ROUTER_PROFILE_RATE = 0; // Disabled
+constexpr auto ENGINE_ROUTER_PROFILE_RATE_ENV = "WZE_ROUTER_PROFILE_RATE";
+
 // Maxmind module
 constexpr auto ENGINE_MMDB_ASN_PATH = "";
 constexpr auto ENGINE_MMDB_ASN_PATH_ENV = "WZE_MMDB_ASN_PATH";
@@ -78,6 +135,12 @@ constexpr auto ENGINE_QUEUE_FLOOD_ATTEMPTS_ENV = "WZE_QUEUE_FLOOD_ATTEMPTS";
 constexpr auto ENGINE_QUEUE_FLOOD_SLEEP = 100;
 constexpr auto ENGINE_QUEUE_FLOOD_SLEEP_ENV = "WZE_QUEUE_FLOOD_SLEEP";
 
+constexpr auto ENGINE_QUEUE_NUMA_SHARDS = false;
+constexpr auto ENGINE_QUEUE_NUMA_SHARDS_ENV = "WZE_QUEUE_NUMA_SHARDS";
+
+constexpr auto ENGINE_QUEUE_PRIORITY_LANES = "";
+constexpr auto ENGINE_QUEUE_PRIORITY_LANES_ENV = "WZE_QUEUE_PRIORITY_LANES";
+
 // RBAC Module
 constexpr auto ENGINE_RBAC_ROLE = "user-developer";
 
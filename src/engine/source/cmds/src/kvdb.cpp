@@ -18,10 +18,12 @@ struct Options
     std::string kvdbName {};
     std::uint32_t page {};
     std::uint32_t records {};
+    std::string cursor {};
     std::string kvdbInputFilePath {};
     std::string kvdbKey {};
     std::string kvdbValue {};
     std::string prefix {};
+    bool replace {false};
     int clientTimeout {};
 };
 
@@ -33,6 +35,37 @@ namespace cmd::kvdb
 namespace eKVDB = ::com::wazuh::api::engine::kvdb;
 namespace eEngine = ::com::wazuh::api::engine;
 
+namespace
+{
+/**
+ * @brief Print the entries of a dump or search response.
+ *
+ * The entries of the pages retrieved with a cursor are printed along with the cursor of the next page, if any.
+ *
+ * @tparam ResponseType Dump or search response.
+ * @param eResponse Response.
+ * @param withCursor True if the page was retrieved with a cursor.
+ */
+template<typename ResponseType>
+void printEntries(const ResponseType& eResponse, bool withCursor)
+{
+    const auto entries = eMessage::eRepeatedFieldToJson<eKVDB::Entry>(eResponse.entries());
+    if (!withCursor)
+    {
+        std::cout << std::get<std::string>(entries) << std::endl;
+        return;
+    }
+
+    json::Json output;
+    output.set("/entries", json::Json {std::get<std::string>(entries).c_str()});
+    if (eResponse.has_next_cursor())
+    {
+        output.setString(eResponse.next_cursor(), "/next_cursor");
+    }
+    std::cout << output.str() << std::endl;
+}
+} // namespace
+
 void runList(std::shared_ptr<apiclnt::Client> client, const std::string& kvdbName, bool loaded)
 {
     using RequestType = eKVDB::managerGet_Request;
@@ -89,10 +122,32 @@ void runCreate(std::shared_ptr<apiclnt::Client> client,
     utils::apiAdapter::fromWazuhResponse<ResponseType>(response);
 }
 
+void runImport(std::shared_ptr<apiclnt::Client> client,
+               const std::string& kvdbName,
+               const std::string& kvdbInputFilePath,
+               bool replace)
+{
+    using RequestType = eKVDB::managerImport_Request;
+    using ResponseType = eEngine::GenericStatus_Response;
+    const std::string command = "kvdb.manager/import";
+
+    // Prepare the request
+    RequestType eRequest;
+    eRequest.set_name(kvdbName);
+    eRequest.set_path(std::filesystem::absolute(kvdbInputFilePath).string());
+    eRequest.set_replace(replace);
+
+    // Call the API
+    const auto request = utils::apiAdapter::toWazuhRequest<RequestType>(command, details::ORIGIN_NAME, eRequest);
+    const auto response = client->send(request);
+    utils::apiAdapter::fromWazuhResponse<ResponseType>(response);
+}
+
 void runDump(std::shared_ptr<apiclnt::Client> client,
              const std::string& kvdbName,
              const unsigned int page,
-             const unsigned int records)
+             const unsigned int records,
+             const std::optional<std::string>& cursor)
 {
     using RequestType = eKVDB::managerDump_Request;
     using ResponseType = eKVDB::managerDump_Response;
@@ -102,7 +157,14 @@ void runDump(std::shared_ptr<apiclnt::Client> client,
     RequestType eRequest;
 
     eRequest.set_name(kvdbName);
-    eRequest.set_page(page);
+    if (cursor)
+    {
+        eRequest.set_cursor(cursor.value());
+    }
+    else
+    {
+        eRequest.set_page(page);
+    }
     eRequest.set_records(records);
 
     // Call the API
@@ -111,9 +173,7 @@ void runDump(std::shared_ptr<apiclnt::Client> client,
     const auto eResponse = utils::apiAdapter::fromWazuhResponse<ResponseType>(response);
 
     // Print the dump
-    const auto& dump = eResponse.entries();
-    const auto json = eMessage::eRepeatedFieldToJson<eKVDB::Entry>(dump);
-    std::cout << std::get<std::string>(json) << std::endl;
+    printEntries(eResponse, cursor.has_value());
 }
 
 void runDelete(std::shared_ptr<apiclnt::Client> client, const std::string& kvdbName)
@@ -217,7 +277,8 @@ void runSearch(std::shared_ptr<apiclnt::Client> client,
                const std::string& kvdbName,
                const std::string& prefix,
                const unsigned int page,
-               const unsigned int records)
+               const unsigned int records,
+               const std::optional<std::string>& cursor)
 {
     using RequestType = eKVDB::dbSearch_Request;
     using ResponseType = eKVDB::dbSearch_Response;
@@ -227,7 +288,14 @@ void runSearch(std::shared_ptr<apiclnt::Client> client,
     RequestType eRequest;
     eRequest.set_name(kvdbName);
     eRequest.set_prefix(prefix);
-    eRequest.set_page(page);
+    if (cursor)
+    {
+        eRequest.set_cursor(cursor.value());
+    }
+    else
+    {
+        eRequest.set_page(page);
+    }
     eRequest.set_records(records);
 
     // Call the API
@@ -236,9 +304,7 @@ void runSearch(std::shared_ptr<apiclnt::Client> client,
     const auto eResponse = utils::apiAdapter::fromWazuhResponse<ResponseType>(response);
 
     // Print the dump
-    const auto& dump = eResponse.entries();
-    const auto json = eMessage::eRepeatedFieldToJson<eKVDB::Entry>(dump);
-    std::cout << std::get<std::string>(json) << std::endl;
+    printEntries(eResponse, cursor.has_value());
 }
 
 void configure(const CLI::App_p& app)
@@ -290,6 +356,29 @@ void configure(const CLI::App_p& app)
             runCreate(client, options->kvdbName, options->kvdbInputFilePath);
         });
 
+    // KVDB import subcommand
+    auto import_subcommand = kvdbApp->add_subcommand(
+        details::API_KVDB_IMPORT_SUBCOMMAND, "Bulk imports a JSON file into a KeyValueDB named db-name, creating it.");
+    // import kvdb name
+    import_subcommand->add_option("-n, --name", options->kvdbName, "KVDB name to be imported into.")->required();
+    // import kvdb from file with path
+    import_subcommand
+        ->add_option("-p, --path",
+                     options->kvdbInputFilePath,
+                     "Path to the file to be imported.\n"
+                     "The file must be a JSON file with the following format: {\"key\": VALUE} "
+                     "where VALUE can be any JSON type.")
+        ->required()
+        ->check(CLI::ExistingFile);
+    import_subcommand->add_flag(
+        "--replace", options->replace, "Replace the whole content of the KVDB, the keys not in the file are removed.");
+    import_subcommand->callback(
+        [options]()
+        {
+            const auto client = std::make_shared<apiclnt::Client>(options->serverApiSock, options->clientTimeout);
+            runImport(client, options->kvdbName, options->kvdbInputFilePath, options->replace);
+        });
+
     // KVDB dump subcommand
     auto dump_subcommand = kvdbApp->add_subcommand(details::API_KVDB_DUMP_SUBCOMMAND,
                                                    "Dumps the full content of a DB named db-name to a JSON.");
@@ -299,11 +388,15 @@ void configure(const CLI::App_p& app)
         ->default_val(ENGINE_KVDB_CLI_PAGE);
     dump_subcommand->add_option("-r, --records", options->records, "Number of records per page.")
         ->default_val(ENGINE_KVDB_CLI_RECORDS);
+    auto dumpCursor = dump_subcommand->add_option(
+        "-c, --cursor", options->cursor, "Cursor returned with the previous page, empty for the first one.");
+    dumpCursor->excludes("--page");
     dump_subcommand->callback(
-        [options]()
+        [options, dumpCursor]()
         {
             const auto client = std::make_shared<apiclnt::Client>(options->serverApiSock, options->clientTimeout);
-            runDump(client, options->kvdbName, options->page, options->records);
+            const auto cursor = dumpCursor->count() > 0 ? std::make_optional(options->cursor) : std::nullopt;
+            runDump(client, options->kvdbName, options->page, options->records, cursor);
         });
 
     // KVDB delete subcommand
@@ -371,11 +464,15 @@ void configure(const CLI::App_p& app)
         ->default_val(ENGINE_KVDB_CLI_PAGE);
     search_subcommand->add_option("-r, --records", options->records, "Number of records per page.")
         ->default_val(ENGINE_KVDB_CLI_RECORDS);
+    auto searchCursor = search_subcommand->add_option(
+        "-c, --cursor", options->cursor, "Cursor returned with the previous page, empty for the first one.");
+    searchCursor->excludes("--page");
     search_subcommand->callback(
-        [options]()
+        [options, searchCursor]()
         {
             const auto client = std::make_shared<apiclnt::Client>(options->serverApiSock, options->clientTimeout);
-            runSearch(client, options->kvdbName, options->prefix, options->page, options->records);
+            const auto cursor = searchCursor->count() > 0 ? std::make_optional(options->cursor) : std::nullopt;
+            runSearch(client, options->kvdbName, options->prefix, options->page, options->records, cursor);
         });
 }
 
@@ -1,11 +1,15 @@
 #include "cmds/start.hpp"
 
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <csignal>
 #include <exception>
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <thread>
 #include <vector>
 
@@ -21,7 +25,9 @@
 #include <api/policy/policy.hpp>
 #include <api/router/handlers.hpp>
 #include <api/tester/handlers.hpp>
+#include <bk/profiler.hpp>
 #include <bk/rx/controller.hpp>
+#include <bk/vm/controller.hpp>
 #include <builder/builder.hpp>
 #include <cmds/details/stackExecutor.hpp>
 #include <defs/defs.hpp>
@@ -34,6 +40,8 @@
 #include <metrics/metricsManager.hpp>
 #include <parseEvent.hpp>
 #include <queue/concurrentQueue.hpp>
+#include <queue/priorityQueue.hpp>
+#include <queue/shardedQueue.hpp>
 #include <rbac/rbac.hpp>
 #include <router/orchestrator.hpp>
 #include <schemf/schema.hpp>
@@ -42,8 +50,10 @@
 #include <server/engineServer.hpp>
 #include <server/protocolHandlers/wStream.hpp>
 #include <sockiface/unixSocketFactory.hpp>
+#include <store/drivers/cachedDriver.hpp>
 #include <store/drivers/fileDriver.hpp>
 #include <store/store.hpp>
+#include <utils/stringUtils.hpp>
 #include <wdb/wdbManager.hpp>
 
 #include "base/utils/getExceptionStack.hpp"
@@ -58,6 +68,102 @@ struct QueueTraits : public moodycamel::ConcurrentQueueDefaultTraits
 };
 std::shared_ptr<engineserver::EngineServer> g_engineServer {};
 
+/**
+ * @brief Priority lanes of the event queue, parsed from the `queue_priority_lanes` option.
+ */
+struct PriorityLanes
+{
+    std::vector<std::size_t> m_weights;       ///< Weight of each lane, the last one is the default lane
+    std::array<std::size_t, 256> m_queueLane; ///< Lane of each queue id
+};
+
+/**
+ * @brief Parse the priority lanes, a comma separated list of `<queue ids>:<weight>`.
+ *
+ * Each entry is a lane with the events of the queue ids (the first character of the Wazuh protocol messages), and the
+ * `*` entry sets the weight of the default lane, where the other queues go (1 if not set).
+ * @param spec The lanes, i.e. `48:4,*:1`.
+ * @return PriorityLanes
+ * @throw std::runtime_error if the spec is invalid.
+ */
+PriorityLanes parsePriorityLanes(const std::string& spec)
+{
+    PriorityLanes lanes {};
+    std::size_t defaultWeight = 1;
+    std::vector<std::string> queues {};
+
+    for (const auto& entry : base::utils::string::split(spec, ','))
+    {
+        const auto sep = entry.rfind(':');
+        if (sep == std::string::npos || sep == 0 || sep + 1 == entry.size())
+        {
+            throw std::runtime_error(fmt::format("Invalid priority lane '{}', expected '<queue ids>:<weight>'", entry));
+        }
+
+        std::size_t weight {0};
+        try
+        {
+            weight = std::stoul(entry.substr(sep + 1));
+        }
+        catch (const std::exception&)
+        {
+        }
+        if (weight == 0)
+        {
+            throw std::runtime_error(
+                fmt::format("Invalid priority lane '{}', the weight must be a positive number", entry));
+        }
+
+        if (entry.substr(0, sep) == "*")
+        {
+            defaultWeight = weight;
+            continue;
+        }
+        queues.emplace_back(entry.substr(0, sep));
+        lanes.m_weights.emplace_back(weight);
+    }
+
+    lanes.m_weights.emplace_back(defaultWeight);
+    lanes.m_queueLane.fill(queues.size());
+    for (std::size_t lane = 0; lane < queues.size(); ++lane)
+    {
+        for (const auto queue : queues[lane])
+        {
+            lanes.m_queueLane[static_cast<unsigned char>(queue)] = lane;
+        }
+    }
+
+    return lanes;
+}
+
+/**
+ * @brief Parse the compression of the KVDBs, a comma separated list of `<db name>:<compression>`.
+ *
+ * The `*` entry sets the compression of the DBs not listed.
+ * @param spec The compressions, i.e. `*:lz4,geo_asn:none`.
+ * @param options The KVDB options to set.
+ * @throw std::runtime_error if the spec is invalid.
+ */
+void parseKVDBCompression(const std::string& spec, kvdbManager::KVDBManagerOptions& options)
+{
+    for (const auto& entry : base::utils::string::split(spec, ','))
+    {
+        const auto sep = entry.rfind(':');
+        if (sep == std::string::npos || sep == 0 || sep + 1 == entry.size())
+        {
+            throw std::runtime_error(
+                fmt::format("Invalid KVDB compression '{}', expected '<db name>:<compression>'", entry));
+        }
+
+        if (entry.substr(0, sep) == "*")
+        {
+            options.compression = entry.substr(sep + 1);
+            continue;
+        }
+        options.dbCompression[entry.substr(0, sep)] = entry.substr(sep + 1);
+    }
+}
+
 void sigintHandler(const int signum)
 {
     if (g_engineServer)
@@ -73,25 +179,53 @@ struct Options
     int serverThreads;
     std::string serverEventSock;
     int serverEventQueueSize;
+    int serverEventBatchSize;
     std::string serverApiSock;
     int serverApiQueueSize;
     int serverApiTimeout;
+    int serverApiWorkers;
+    int serverApiSlowWorkers;
     // Store
     std::string fileStorage;
+    bool storeCache;
     // KVDB
     std::string kvdbPath;
+    int kvdbCacheSize;
+    int kvdbBlockCacheSize;
+    int kvdbBloomBits;
+    bool kvdbPointLookup;
+    std::string kvdbCompression;
+    int kvdbStatisticsInterval;
+    // WDB
+    int wdbPoolSize;
+    int wdbCacheTTL;
+    // Builder
+    int builderThreads;
+    // Indexer outputs
+    std::string indexerUrl;
+    std::string indexerUser;
+    std::string indexerPassword;
+    std::string indexerCa;
+    std::string indexerQueueDir;
     // Orchestration
     int routerThreads;
+    int routerBatchSize;
+    bool routerPinWorkers;
+    std::string routerBackend;
+    int routerProfileRate;
     // Queue
     int queueSize;
     std::string queueFloodFile;
     int queueFloodAttempts;
     int queueFloodSleep;
     bool queueDropFlood;
+    bool queueNumaShards;
+    std::string queuePriorityLanes;
     // Loggin
     std::string level;
     std::string logOutput;
     bool logTruncate;
+    int logThreads;
     // TZ_DB
     std::string tzdbPath;
     bool tzdbAutoUpdate;
@@ -113,38 +247,70 @@ void runStart(ConfHandler confManager)
     const auto level = confManager->get<std::string>("server.log_level");
     const auto logOutput = confManager->get<std::string>("server.log_output");
     const auto logTruncate = confManager->get<bool>("server.log_truncate");
+    const auto logThreads = confManager->get<int>("server.log_threads");
 
     // Server config
     const auto serverThreads = confManager->get<int>("server.server_threads");
     const auto serverEventSock = confManager->get<std::string>("server.event_socket");
     const auto serverEventQueueSize = confManager->get<int>("server.event_queue_tasks");
+    const auto serverEventBatchSize = confManager->get<int>("server.event_batch_size");
     const auto serverApiSock = confManager->get<std::string>("server.api_socket");
     const auto serverApiQueueSize = confManager->get<int>("server.api_queue_tasks");
     const auto serverApiTimeout = confManager->get<int>("server.api_timeout");
+    const auto serverApiWorkers = confManager->get<int>("server.api_workers");
+    const auto serverApiSlowWorkers = confManager->get<int>("server.api_slow_workers");
 
     // Store config
     const auto fileStorage = confManager->get<std::string>("server.store_path");
+    const auto storeCache = confManager->get<bool>("server.store_cache");
 
     // Logging init
     logging::LoggingConfig logConfig;
     logConfig.level = logging::strToLevel(level);
     logConfig.truncate = logTruncate;
     logConfig.filePath = logOutput;
+    logConfig.dedicatedThreads = static_cast<uint32_t>(logThreads);
 
     exitHandler.add([]() { logging::stop(); });
     logging::start(logConfig);
 
-    LOG_DEBUG("Logging configuration: filePath='{}', level='{}', flushInterval={}ms.",
+    LOG_DEBUG("Logging configuration: filePath='{}', level='{}', flushInterval={}ms, dedicatedThreads={}.",
               logConfig.filePath,
               logging::levelToStr(logConfig.level),
-              logConfig.flushInterval);
+              logConfig.flushInterval,
+              logConfig.dedicatedThreads);
     LOG_INFO("Logging initialized.");
 
     // KVDB config
     const auto kvdbPath = confManager->get<std::string>("server.kvdb_path");
+    const auto kvdbCacheSize = confManager->get<int>("server.kvdb_cache_size");
+    const auto kvdbBlockCacheSize = confManager->get<int>("server.kvdb_block_cache_size");
+    const auto kvdbBloomBits = confManager->get<int>("server.kvdb_bloom_bits");
+    const auto kvdbPointLookup = confManager->get<bool>("server.kvdb_point_lookup");
+    const auto kvdbCompression = confManager->get<std::string>("server.kvdb_compression");
+    const auto kvdbStatisticsInterval = confManager->get<int>("server.kvdb_statistics_interval");
+
+    // WDB config
+    const auto wdbPoolSize = confManager->get<int>("server.wdb_pool_size");
+    const auto wdbCacheTTL = confManager->get<int>("server.wdb_cache_ttl");
+
+    // Builder config
+    const auto builderThreads = confManager->get<int>("server.builder_threads");
+
+    // Indexer outputs config
+    builder::IndexerConnection indexerConnection;
+    indexerConnection.url = confManager->get<std::string>("server.indexer_url");
+    indexerConnection.username = confManager->get<std::string>("server.indexer_user");
+    indexerConnection.password = confManager->get<std::string>("server.indexer_password");
+    indexerConnection.caFile = confManager->get<std::string>("server.indexer_ca");
+    indexerConnection.queueDir = confManager->get<std::string>("server.indexer_queue_dir");
 
     // Router Config
     const auto routerThreads = confManager->get<int>("server.router_threads");
+    const auto routerBatchSize = confManager->get<int>("server.router_batch_size");
+    const auto routerPinWorkers = confManager->get<bool>("server.router_pin_workers");
+    const auto routerBackend = confManager->get<std::string>("server.router_backend");
+    const auto routerProfileRate = confManager->get<int>("server.router_profile_rate");
 
     // Queue config
     const auto queueSize = confManager->get<int>("server.queue_size");
@@ -152,6 +318,8 @@ void runStart(ConfHandler confManager)
     const auto queueFloodAttempts = confManager->get<int>("server.queue_flood_attempts");
     const auto queueFloodSleep = confManager->get<int>("server.queue_flood_sleep");
     const auto queueDropFlood = confManager->get<bool>("server.queue_drop_flood");
+    const auto queueNumaShards = confManager->get<bool>("server.queue_numa_shards");
+    const auto queuePriorityLanes = confManager->get<std::string>("server.queue_priority_lanes");
 
     // TZDB config
     const auto tzdbPath = confManager->get<std::string>("server.tzdb_path");
@@ -193,6 +361,7 @@ void runStart(ConfHandler confManager)
     std::shared_ptr<wazuhdb::WDBManager> wdbManager;
     std::shared_ptr<rbac::RBAC> rbac;
     std::shared_ptr<api::policy::IPolicy> policyManager;
+    std::shared_ptr<bk::Profiler> profiler;
 
     try
     {
@@ -200,8 +369,12 @@ void runStart(ConfHandler confManager)
 
         // Store
         {
-            auto fileDriver = std::make_shared<store::drivers::FileDriver>(fileStorage);
-            store = std::make_shared<store::Store>(fileDriver);
+            std::shared_ptr<store::IDriver> driver = std::make_shared<store::drivers::FileDriver>(fileStorage);
+            if (storeCache)
+            {
+                driver = std::make_shared<store::drivers::CachedDriver>(driver, fileStorage);
+            }
+            store = std::make_shared<store::Store>(driver);
             LOG_INFO("Store initialized.");
         }
 
@@ -213,7 +386,12 @@ void runStart(ConfHandler confManager)
 
         // KVDB
         {
-            kvdbManager::KVDBManagerOptions kvdbOptions {kvdbPath, "kvdb"};
+            kvdbManager::KVDBManagerOptions kvdbOptions {kvdbPath, "kvdb", static_cast<std::size_t>(kvdbCacheSize)};
+            kvdbOptions.blockCacheSize = static_cast<std::size_t>(kvdbBlockCacheSize) << 20;
+            kvdbOptions.bloomBitsPerKey = kvdbBloomBits;
+            kvdbOptions.optimizeForPointLookup = kvdbPointLookup;
+            kvdbOptions.statisticsInterval = static_cast<std::size_t>(kvdbStatisticsInterval);
+            parseKVDBCompression(kvdbCompression, kvdbOptions);
             kvdbManager = std::make_shared<kvdbManager::KVDBManager>(kvdbOptions, metrics);
             kvdbManager->initialize();
             LOG_INFO("KVDB initialized.");
@@ -229,7 +407,7 @@ void runStart(ConfHandler confManager)
         {
             // TODO: This is a optional right now, but it be mandatory in the future
             auto geoDownloader = std::make_shared<geo::Downloader>();
-            geoManager = std::make_shared<geo::Manager>(store, geoDownloader);
+            geoManager = std::make_shared<geo::Manager>(store, geoDownloader, metrics);
             LOG_INFO("Geo initialized.");
         }
 
@@ -279,9 +457,14 @@ void runStart(ConfHandler confManager)
             builderDeps.kvdbScopeName = "builder";
             builderDeps.kvdbManager = kvdbManager;
             builderDeps.sockFactory = std::make_shared<sockiface::UnixSocketFactory>();
-            builderDeps.wdbManager =
-                std::make_shared<wazuhdb::WDBManager>(std::string(wazuhdb::WDB_SOCK_PATH), builderDeps.sockFactory);
+            wazuhdb::WDBPoolOptions wdbOptions;
+            wdbOptions.connections = static_cast<std::size_t>(wdbPoolSize);
+            wdbOptions.cacheTTL = std::chrono::milliseconds {wdbCacheTTL};
+            builderDeps.wdbManager = std::make_shared<wazuhdb::WDBManager>(
+                std::string(wazuhdb::WDB_SOCK_PATH), builderDeps.sockFactory, wdbOptions);
             builderDeps.geoManager = geoManager;
+            builderDeps.buildThreads = static_cast<std::size_t>(builderThreads);
+            builderDeps.indexer = indexerConnection;
             auto defs = std::make_shared<defs::DefinitionsBuilder>();
             builder = std::make_shared<builder::Builder>(store, schema, defs, builderDeps);
             LOG_INFO("Builder initialized.");
@@ -307,17 +490,96 @@ void runStart(ConfHandler confManager)
             using QEventType = base::queue::ConcurrentQueue<base::Event, QueueTraits>;
             using QTestType = base::queue::ConcurrentQueue<router::test::QueueType>;
 
-            std::shared_ptr<QEventType> eventQueue {};
+            std::shared_ptr<base::queue::iQueue<base::Event>> eventQueue {};
             std::shared_ptr<QTestType> testQueue {};
+            // The flooded events are spilled in the binary encoding and replayed once the queue drains, the segments
+            // left by older versions are JSON text
+            const QEventType::Serializer spillSerializer = [](const base::Event& event)
             {
-                auto scope = metrics->getMetricsScope("EventQueue");
-                auto scopeDelta = metrics->getMetricsScope("EventQueueDelta");
-                // TODO queueFloodFile, queueFloodAttempts, queueFloodSleep -> Move to Queue.flood options
-                eventQueue = std::make_shared<QEventType>(
-                    queueSize, scope, scopeDelta, queueFloodFile, queueFloodAttempts, queueFloodSleep, queueDropFlood);
+                return event->binary();
+            };
+            const QEventType::Parser replayParser = [](std::string_view record)
+            {
+                if (json::Json::isBinary(record))
+                {
+                    return std::make_shared<json::Json>(json::Json::fromBinary(record));
+                }
+                return std::make_shared<json::Json>(std::string(record).c_str());
+            };
+            const auto topology = queueNumaShards ? utils::numa::getTopology() : utils::numa::Topology {};
+            const auto makeEventQueue = [&](const std::string& name, const std::string& floodFile)
+                -> std::shared_ptr<base::queue::iQueue<base::Event>>
+            {
+                if (topology.size() <= 1)
+                {
+                    // TODO queueFloodFile, queueFloodAttempts, queueFloodSleep -> Move to Queue.flood options
+                    return std::make_shared<QEventType>(queueSize,
+                                                        metrics->getMetricsScope(name),
+                                                        metrics->getMetricsScope(name + "Delta"),
+                                                        floodFile,
+                                                        queueFloodAttempts,
+                                                        queueFloodSleep,
+                                                        queueDropFlood,
+                                                        replayParser,
+                                                        spillSerializer);
+                }
+
+                // One shard per NUMA node, each one with its own metrics scope and flood file
+                std::vector<std::shared_ptr<base::queue::iQueue<base::Event>>> shards {};
+                const auto shardSize = std::max(1, queueSize / static_cast<int>(topology.size()));
+                for (std::size_t node = 0; node < topology.size(); ++node)
+                {
+                    auto scope = metrics->getMetricsScope(fmt::format("{}Node{}", name, node));
+                    auto scopeDelta = metrics->getMetricsScope(fmt::format("{}Node{}Delta", name, node));
+                    auto shardFloodFile = floodFile.empty() ? floodFile : fmt::format("{}.node{}", floodFile, node);
+                    shards.emplace_back(std::make_shared<QEventType>(shardSize,
+                                                                     scope,
+                                                                     scopeDelta,
+                                                                     shardFloodFile,
+                                                                     queueFloodAttempts,
+                                                                     queueFloodSleep,
+                                                                     queueDropFlood,
+                                                                     replayParser,
+                                                                     spillSerializer));
+                }
+                return std::make_shared<base::queue::ShardedQueue<base::Event>>(
+                    std::move(shards), topology, metrics->getMetricsScope(name));
+            };
+
+            if (!queuePriorityLanes.empty())
+            {
+                // One queue per lane, the default lane keeps the names of the single queue
+                const auto lanes = parsePriorityLanes(queuePriorityLanes);
+                std::vector<base::queue::PriorityQueue<base::Event>::Lane> eventLanes {};
+                for (std::size_t lane = 0; lane < lanes.m_weights.size(); ++lane)
+                {
+                    const auto isDefault = lane + 1 == lanes.m_weights.size();
+                    auto name = isDefault ? std::string("EventQueue") : fmt::format("EventQueueLane{}", lane);
+                    auto floodFile = isDefault || queueFloodFile.empty()
+                                         ? queueFloodFile
+                                         : fmt::format("{}.lane{}", queueFloodFile, lane);
+                    eventLanes.push_back({makeEventQueue(name, floodFile), lanes.m_weights[lane]});
+                }
+
+                auto laneSelector = [queueLane = lanes.m_queueLane](const base::Event& event) -> std::size_t
+                {
+                    const auto queue = event->getInt(base::parseEvent::EVENT_QUEUE_ID);
+                    return queue ? queueLane[static_cast<unsigned char>(queue.value())] : queueLane.size();
+                };
+                eventQueue = std::make_shared<base::queue::PriorityQueue<base::Event>>(
+                    std::move(eventLanes), laneSelector, lanes.m_weights.size() - 1);
 
+                LOG_INFO("Event queue created with {} priority lanes.", lanes.m_weights.size());
+            }
+            else
+            {
+                eventQueue = makeEventQueue("EventQueue", queueFloodFile);
                 LOG_DEBUG("Event queue created.");
             }
+            if (topology.size() > 1)
+            {
+                LOG_INFO("Event queue split in {} NUMA shards.", topology.size());
+            }
             {
                 auto scope = metrics->getMetricsScope("TestQueue");
                 auto scopeDelta = metrics->getMetricsScope("TestQueueDelta");
@@ -325,13 +587,33 @@ void runStart(ConfHandler confManager)
                 LOG_DEBUG("Test queue created.");
             }
 
+            if (routerProfileRate > 0)
+            {
+                profiler = std::make_shared<bk::Profiler>(static_cast<std::size_t>(routerProfileRate));
+                LOG_INFO("Profiling one of every {} events.", routerProfileRate);
+            }
+
+            std::shared_ptr<bk::IControllerMaker> controllerMaker;
+            if (routerBackend == "vm")
+            {
+                controllerMaker = std::make_shared<bk::vm::ControllerMaker>(profiler);
+            }
+            else
+            {
+                controllerMaker = std::make_shared<bk::rx::ControllerMaker>(profiler);
+            }
+            LOG_DEBUG("Router backend: {}.", routerBackend);
+
             router::Orchestrator::Options config {.m_numThreads = routerThreads,
                                                   .m_wStore = store,
                                                   .m_builder = builder,
-                                                  .m_controllerMaker = std::make_shared<bk::rx::ControllerMaker>(),
+                                                  .m_controllerMaker = controllerMaker,
                                                   .m_prodQueue = eventQueue,
                                                   .m_testQueue = testQueue,
-                                                  .m_testTimeout = serverApiTimeout};
+                                                  .m_testTimeout = serverApiTimeout,
+                                                  .m_batchSize = routerBatchSize,
+                                                  .m_pinWorkers = routerPinWorkers,
+                                                  .m_metricsScope = metrics->getMetricsScope("router")};
 
             orchestrator = std::make_shared<router::Orchestrator>(config);
             orchestrator->start();
@@ -357,7 +639,7 @@ void runStart(ConfHandler confManager)
             LOG_DEBUG("Configuration manager API registered.");
 
             // Register Metrics
-            api::metrics::handlers::registerHandlers(metrics, api);
+            api::metrics::handlers::registerHandlers(metrics, api, profiler);
             LOG_DEBUG("Metrics API registered.");
 
             // KVDB
@@ -410,20 +692,56 @@ void runStart(ConfHandler confManager)
             apiClientFactory->setErrorResponse(base::utils::wazuhProtocol::WazuhResponse::unknownError().toString());
             apiClientFactory->setBusyResponse(base::utils::wazuhProtocol::WazuhResponse::busyServer().toString());
 
+            // The long-running commands have their own lane, so they cannot delay the rest (health checks, router...)
+            auto isSlowRequest = [](const std::string& request)
+            {
+                const auto command = api::Api::peekCommand(request);
+                for (const std::string_view prefix :
+                     {"tester.", "catalog.", "policy.", "kvdb.manager/dump", "kvdb.manager/import"})
+                {
+                    if (command.substr(0, prefix.size()) == prefix)
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            };
             auto apiEndpointCfg = std::make_shared<endpoint::UnixStream>(serverApiSock,
                                                                          apiClientFactory,
                                                                          apiMetricScope,
                                                                          apiMetricScopeDelta,
                                                                          serverApiQueueSize,
-                                                                         serverApiTimeout);
+                                                                         serverApiTimeout,
+                                                                         serverApiWorkers,
+                                                                         serverApiSlowWorkers,
+                                                                         isSlowRequest);
             server->addEndpoint("API", apiEndpointCfg);
 
             // Event Endpoint
             auto eventMetricScope = metrics->getMetricsScope("endpointEvent");
             auto eventMetricScopeDelta = metrics->getMetricsScope("endpointEventRate", true);
-            auto eventHandler = std::bind(&router::Orchestrator::pushEvent, orchestrator, std::placeholders::_1);
-            auto eventEndpointCfg = std::make_shared<endpoint::UnixDatagram>(
-                serverEventSock, eventHandler, eventMetricScope, eventMetricScopeDelta, serverEventQueueSize);
+            std::shared_ptr<endpoint::UnixDatagram> eventEndpointCfg {};
+            if (serverEventBatchSize > 1)
+            {
+                auto eventHandler = std::bind(&router::Orchestrator::pushEvents, orchestrator, std::placeholders::_1);
+                eventEndpointCfg = std::make_shared<endpoint::UnixDatagram>(serverEventSock,
+                                                                            eventHandler,
+                                                                            serverEventBatchSize,
+                                                                            eventMetricScope,
+                                                                            eventMetricScopeDelta,
+                                                                            serverEventQueueSize,
+                                                                            serverThreads);
+            }
+            else
+            {
+                auto eventHandler = std::bind(&router::Orchestrator::pushEvent, orchestrator, std::placeholders::_1);
+                eventEndpointCfg = std::make_shared<endpoint::UnixDatagram>(serverEventSock,
+                                                                            eventHandler,
+                                                                            eventMetricScope,
+                                                                            eventMetricScopeDelta,
+                                                                            serverEventQueueSize,
+                                                                            serverThreads);
+            }
             server->addEndpoint("EVENT", eventEndpointCfg);
             LOG_DEBUG("Server configured.");
         }
@@ -480,9 +798,19 @@ void configure(CLI::App_p app)
         ->default_val(ENGINE_LOG_TRUNCATE)
         ->envname(ENGINE_LOG_TRUNCATE_ENV);
 
+    serverApp
+        ->add_option("--log_threads",
+                     options->logThreads,
+                     "Sets the number of threads that write the logs, the callers only queue the messages (0 = the "
+                     "callers write them).")
+        ->default_val(ENGINE_LOG_THREADS)
+        ->check(CLI::NonNegativeNumber)
+        ->envname(ENGINE_LOG_THREADS_ENV);
+
     // Server module
     serverApp
-        ->add_option("--server_threads", options->serverThreads, "Sets the number of threads for server worker pool.")
+        ->add_option(
+            "--server_threads", options->serverThreads, "Sets the number of threads of the events server worker pool.")
         ->default_val(ENGINE_SRV_PULL_THREADS)
         ->check(CLI::Range(1, 128))
         ->envname(ENGINE_SRV_PULL_THREADS_ENV);
@@ -496,6 +824,14 @@ void configure(CLI::App_p app)
         ->default_val(ENGINE_SRV_EVENT_QUEUE_TASK)
         ->check(CLI::NonNegativeNumber)
         ->envname(ENGINE_SRV_EVENT_QUEUE_TASK_ENV);
+    serverApp
+        ->add_option("--event_batch_size",
+                     options->serverEventBatchSize,
+                     "Sets the maximum number of events received, parsed and queued at once by the events server (1 = "
+                     "no batching).")
+        ->default_val(ENGINE_SRV_EVENT_BATCH_SIZE)
+        ->check(CLI::Range(1, 1024))
+        ->envname(ENGINE_SRV_EVENT_BATCH_SIZE_ENV);
     serverApp->add_option("--api_socket", options->serverApiSock, "Sets the API server socket address.")
         ->default_val(ENGINE_SRV_API_SOCK)
         ->envname(ENGINE_SRV_API_SOCK_ENV);
@@ -511,6 +847,19 @@ void configure(CLI::App_p app)
         ->default_val(ENGINE_SRV_API_TIMEOUT)
         ->check(CLI::NonNegativeNumber)
         ->envname(ENGINE_SRV_API_TIMEOUT_ENV);
+    serverApp
+        ->add_option("--api_workers", options->serverApiWorkers, "Sets the number of threads of the API worker pool.")
+        ->default_val(ENGINE_SRV_API_WORKERS)
+        ->check(CLI::Range(1, 128))
+        ->envname(ENGINE_SRV_API_WORKERS_ENV);
+    serverApp
+        ->add_option("--api_slow_workers",
+                     options->serverApiSlowWorkers,
+                     "Sets the number of threads of the API worker pool for the long-running commands (tester, "
+                     "catalog, policy, kvdb dump and import). 0 = no separate pool.")
+        ->default_val(ENGINE_SRV_API_SLOW_WORKERS)
+        ->check(CLI::Range(0, 128))
+        ->envname(ENGINE_SRV_API_SLOW_WORKERS_ENV);
 
     // Store Module
     serverApp
@@ -519,12 +868,110 @@ void configure(CLI::App_p app)
         ->default_val(ENGINE_STORE_PATH)
         ->check(CLI::ExistingDirectory)
         ->envname(ENGINE_STORE_PATH_ENV);
+    serverApp
+        ->add_flag("--store_cache,!--no-store_cache",
+                   options->storeCache,
+                   "Keeps the assets read from the store in memory, dropped when the store files change.")
+        ->default_val(ENGINE_STORE_CACHE)
+        ->envname(ENGINE_STORE_CACHE_ENV);
 
     // KVDB Module
     serverApp->add_option("--kvdb_path", options->kvdbPath, "Sets the path to the KVDB folder.")
         ->default_val(ENGINE_KVDB_PATH)
         ->check(CLI::ExistingDirectory)
         ->envname(ENGINE_KVDB_PATH_ENV);
+    serverApp
+        ->add_option("--kvdb_cache_size",
+                     options->kvdbCacheSize,
+                     "Sets the number of values cached in memory for each KVDB (0 = no cache).")
+        ->default_val(ENGINE_KVDB_CACHE_SIZE)
+        ->check(CLI::NonNegativeNumber)
+        ->envname(ENGINE_KVDB_CACHE_SIZE_ENV);
+    serverApp
+        ->add_option("--kvdb_block_cache_size",
+                     options->kvdbBlockCacheSize,
+                     "Sets the size in MiB of the RocksDB block cache shared by all the KVDBs (0 = one per KVDB).")
+        ->default_val(ENGINE_KVDB_BLOCK_CACHE_SIZE)
+        ->check(CLI::NonNegativeNumber)
+        ->envname(ENGINE_KVDB_BLOCK_CACHE_SIZE_ENV);
+    serverApp
+        ->add_option("--kvdb_bloom_bits",
+                     options->kvdbBloomBits,
+                     "Sets the bits per key of the bloom filters of the KVDBs (0 = no bloom filter).")
+        ->default_val(ENGINE_KVDB_BLOOM_BITS)
+        ->check(CLI::Range(0, 64))
+        ->envname(ENGINE_KVDB_BLOOM_BITS_ENV);
+    serverApp
+        ->add_flag("--kvdb_point_lookup,!--no-kvdb_point_lookup",
+                   options->kvdbPointLookup,
+                   "Indexes the data blocks of the KVDBs by hash, to speed up the point lookups.")
+        ->default_val(ENGINE_KVDB_POINT_LOOKUP)
+        ->envname(ENGINE_KVDB_POINT_LOOKUP_ENV);
+    serverApp
+        ->add_option("--kvdb_compression",
+                     options->kvdbCompression,
+                     "Sets the compression of the KVDBs, a comma separated list of '<db name>:<compression>' "
+                     "(i.e. '*:lz4,geo_asn:none'), '*' sets the one of the other KVDBs. The compressions are none, "
+                     "snappy, zlib, lz4, lz4hc and zstd, if linked in RocksDB.")
+        ->default_val(ENGINE_KVDB_COMPRESSION)
+        ->envname(ENGINE_KVDB_COMPRESSION_ENV);
+    serverApp
+        ->add_option("--kvdb_statistics_interval",
+                     options->kvdbStatisticsInterval,
+                     "Sets the interval in seconds between the refreshes of the RocksDB metrics (0 = no statistics).")
+        ->default_val(ENGINE_KVDB_STATISTICS_INTERVAL)
+        ->check(CLI::NonNegativeNumber)
+        ->envname(ENGINE_KVDB_STATISTICS_INTERVAL_ENV);
+
+    // WDB
+    serverApp
+        ->add_option("--wdb_pool_size",
+                     options->wdbPoolSize,
+                     "Sets the number of wazuh-db connections shared by the workers (0 = one per helper).")
+        ->default_val(ENGINE_WDB_POOL_SIZE)
+        ->check(CLI::NonNegativeNumber)
+        ->envname(ENGINE_WDB_POOL_SIZE_ENV);
+    serverApp
+        ->add_option("--wdb_cache_ttl",
+                     options->wdbCacheTTL,
+                     "Sets the time in milliseconds the results of the read-only wazuh-db queries are cached "
+                     "(0 = no cache).")
+        ->default_val(ENGINE_WDB_CACHE_TTL)
+        ->check(CLI::NonNegativeNumber)
+        ->envname(ENGINE_WDB_CACHE_TTL_ENV);
+
+    // Builder
+    serverApp
+        ->add_option("--builder_threads",
+                     options->builderThreads,
+                     "Sets the number of threads compiling the assets of a policy (0 = one per core).")
+        ->default_val(ENGINE_BUILDER_THREADS)
+        ->check(CLI::NonNegativeNumber)
+        ->envname(ENGINE_BUILDER_THREADS_ENV);
+
+    // Indexer outputs
+    serverApp
+        ->add_option("--indexer_url",
+                     options->indexerUrl,
+                     "Sets the url of the indexer the indexer outputs send the events to (empty = no indexer outputs).")
+        ->default_val(ENGINE_INDEXER_URL)
+        ->envname(ENGINE_INDEXER_URL_ENV);
+    serverApp->add_option("--indexer_user", options->indexerUser, "Sets the user of the indexer.")
+        ->default_val(ENGINE_INDEXER_USER)
+        ->envname(ENGINE_INDEXER_USER_ENV);
+    serverApp->add_option("--indexer_password", options->indexerPassword, "Sets the password of the indexer user.")
+        ->default_val(ENGINE_INDEXER_PASSWORD)
+        ->envname(ENGINE_INDEXER_PASSWORD_ENV);
+    serverApp
+        ->add_option("--indexer_ca", options->indexerCa, "Sets the CA file verifying the indexer (empty = system CAs).")
+        ->default_val(ENGINE_INDEXER_CA)
+        ->envname(ENGINE_INDEXER_CA_ENV);
+    serverApp
+        ->add_option("--indexer_queue_dir",
+                     options->indexerQueueDir,
+                     "Sets the directory keeping the bulks not acknowledged by the indexer (empty = kept in memory).")
+        ->default_val(ENGINE_INDEXER_QUEUE_DIR)
+        ->envname(ENGINE_INDEXER_QUEUE_DIR_ENV);
 
     // TZ_DB Installation Path
     serverApp->add_option("--tzdb_path", options->tzdbPath, "Sets the install path to the time zone database.")
@@ -544,6 +991,36 @@ void configure(CLI::App_p app)
         ->default_val(ENGINE_ROUTER_THREADS)
         ->check(CLI::Range(1, 128))
         ->envname(ENGINE_ROUTER_THREADS_ENV);
+    serverApp
+        ->add_option("--router_batch_size",
+                     options->routerBatchSize,
+                     "Sets the maximum number of events dequeued and routed at once by each router thread (1 = no "
+                     "batching).")
+        ->default_val(ENGINE_ROUTER_BATCH_SIZE)
+        ->check(CLI::Range(1, 4096))
+        ->envname(ENGINE_ROUTER_BATCH_SIZE_ENV);
+    serverApp
+        ->add_flag("--router_pin_workers",
+                   options->routerPinWorkers,
+                   "Pins each router thread to a CPU, spreading the threads over the NUMA nodes.")
+        ->default_val(ENGINE_ROUTER_PIN_WORKERS)
+        ->envname(ENGINE_ROUTER_PIN_WORKERS_ENV);
+    serverApp
+        ->add_option("--router_backend",
+                     options->routerBackend,
+                     "Sets the backend that runs the policies: 'rx' (reactive streams) or 'vm' (flat program "
+                     "interpreter).")
+        ->default_val(ENGINE_ROUTER_BACKEND)
+        ->check(CLI::IsMember({"rx", "vm"}))
+        ->envname(ENGINE_ROUTER_BACKEND_ENV);
+    serverApp
+        ->add_option("--router_profile_rate",
+                     options->routerProfileRate,
+                     "Times the assets and helpers of one of every N events, queried with the metrics profile "
+                     "command (0 = disabled).")
+        ->default_val(ENGINE_ROUTER_PROFILE_RATE)
+        ->check(CLI::NonNegativeNumber)
+        ->envname(ENGINE_ROUTER_PROFILE_RATE_ENV);
 
     // Queue module
     serverApp
@@ -556,7 +1033,8 @@ void configure(CLI::App_p app)
     serverApp
         ->add_option("--queue_flood_file",
                      options->queueFloodFile,
-                     "Sets the path to the file where the flood events will be stored.")
+                     "Sets the path prefix of the segments where the flood events will be spilled, they are "
+                     "replayed when the queue drains.")
         ->default_val(ENGINE_QUEUE_FLOOD_FILE)
         ->envname(ENGINE_QUEUE_FLOOD_FILE_ENV);
 
@@ -580,6 +1058,24 @@ void configure(CLI::App_p app)
                         options->queueDropFlood,
                         "If enabled, the queue will drop the flood events instead of storing them in the file.");
 
+    serverApp
+        ->add_flag("--queue_numa_shards",
+                   options->queueNumaShards,
+                   "Splits the event queue in one shard per NUMA node. The events are queued in the shard of the node "
+                   "that receives them, and each shard floods to its own file (<queue_flood_file>.node<N>).")
+        ->default_val(ENGINE_QUEUE_NUMA_SHARDS)
+        ->envname(ENGINE_QUEUE_NUMA_SHARDS_ENV);
+
+    serverApp
+        ->add_option("--queue_priority_lanes",
+                     options->queuePriorityLanes,
+                     "Splits the event queue in weighted priority lanes, a comma separated list of "
+                     "'<queue ids>:<weight>' (i.e. '8:4,*:1'). The events of each lane are dequeued in proportion "
+                     "to its weight, '*' sets the weight of the lane of the other queues (1 by default). Each lane "
+                     "floods to its own file (<queue_flood_file>.lane<N>).")
+        ->default_val(ENGINE_QUEUE_PRIORITY_LANES)
+        ->envname(ENGINE_QUEUE_PRIORITY_LANES_ENV);
+
     // Start subcommand
     auto startApp = serverApp->add_subcommand("start", "Start a Wazuh engine instance");
 
@@ -1,6 +1,7 @@
 #ifndef _GEO_MANAGER_HPP
 #define _GEO_MANAGER_HPP
 
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <shared_mutex>
@@ -10,6 +11,13 @@
 #include <geo/imanager.hpp>
 #include <store/istore.hpp>
 
+namespace metricsManager
+{
+class IMetricsManager;
+template<typename T>
+class iHistogram;
+} // namespace metricsManager
+
 namespace geo
 {
 
@@ -34,13 +42,16 @@ private:
     std::shared_ptr<store::IStoreInternal> m_store; ///< The store used to store the MMDB hash.
     std::shared_ptr<IDownloader> m_downloader;      ///< The downloader used to download the MMDB database.
 
+    std::shared_ptr<metricsManager::iHistogram<uint64_t>> m_swapLatency; ///< Microseconds to publish an update
+
     /**
      * @brief Upsert the internal store entry for a database.
      *
      * @param path The path to the database.
+     * @param hash The MD5 hash of the database, computed from the file if empty.
      * @return base::OptError An error if the store entry could not be upserted.
      */
-    base::OptError upsertStoreEntry(const std::string& path);
+    base::OptError upsertStoreEntry(const std::string& path, const std::string& hash = "");
 
     /**
      * @brief Remove the internal store entry for a database.
@@ -69,19 +80,34 @@ private:
     base::OptError removeDbUnsafe(const std::string& path);
 
     /**
-     * @brief Write the MMDB database to the filesystem.
+     * @brief Replace an added database without blocking its lookups.
+     *
+     * The new database is opened next to the old one and published with an atomic swap. The old one is closed once
+     * the last locator looking it up moves to the new one.
      *
-     * @param path Path to store the database.
-     * @param content The content of the database.
-     * @return base::OptError An error if the database could not be written.
+     * @param entry The entry of the database.
+     * @param path The path of the database.
+     * @param tmpPath The path where the new database was downloaded, it is moved to path.
+     * @return base::OptError An error if the database could not be replaced, the old one is kept.
      */
-    base::OptError writeDb(const std::string& path, const std::string& content);
+    base::OptError swapDb(DbEntry& entry, const std::string& path, const std::string& tmpPath);
 
 public:
     virtual ~Manager() = default;
 
     Manager() = delete;
-    Manager(const std::shared_ptr<store::IStoreInternal>& store, const std::shared_ptr<IDownloader>& downloader);
+
+    /**
+     * @brief Construct a new Manager object
+     *
+     * @param store The store holding the MMDB hashes.
+     * @param downloader The downloader of the MMDB databases.
+     * @param metricsManager (Optional) Metrics manager, to record the latency of the database swaps.
+     * @throws std::runtime_error if the store or the downloader are null.
+     */
+    Manager(const std::shared_ptr<store::IStoreInternal>& store,
+            const std::shared_ptr<IDownloader>& downloader,
+            const std::shared_ptr<metricsManager::IMetricsManager>& metricsManager = nullptr);
 
     /**
      * @copydoc IManager::listDbs
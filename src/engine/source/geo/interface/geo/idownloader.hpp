@@ -15,6 +15,18 @@ public:
     virtual base::RespOrError<std::string> downloadHTTPS(const std::string& url) const = 0;
     virtual std::string computeMD5(const std::string& data) const = 0;
     virtual base::RespOrError<std::string> downloadMD5(const std::string& url) const = 0;
+
+    /**
+     * @brief Download a file to a path, verifying its MD5 hash. The file is not kept in memory.
+     *
+     * @param url The URL of the file.
+     * @param path The path to write the file to, overwritten if it exists.
+     * @param md5 The expected MD5 hash of the file.
+     * @return base::OptError An error if the file could not be downloaded or its hash does not match. The path is
+     * removed then.
+     */
+    virtual base::OptError
+    downloadFile(const std::string& url, const std::string& path, const std::string& md5) const = 0;
 };
 } // namespace geo
 
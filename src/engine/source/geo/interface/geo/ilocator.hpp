@@ -1,7 +1,14 @@
 #ifndef _GEO_ILOCATOR_HPP
 #define _GEO_ILOCATOR_HPP
 
+#include <cstdint>
+#include <limits>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
 
 #include <dotPath.hpp>
 #include <error.hpp>
@@ -9,6 +16,109 @@
 
 namespace geo
 {
+/**
+ * @brief Set of values looked up together for an IP, compiled once when the policy is built.
+ *
+ */
+class Fields
+{
+public:
+    /**
+     * @brief Expected type of a value, a value of another type is missing.
+     */
+    enum class Type
+    {
+        STRING,
+        UINT32,
+        DOUBLE
+    };
+
+    using Value = std::variant<std::monostate, std::string, uint32_t, double>; ///< std::monostate if missing
+    using Values = std::vector<Value>;                                         ///< Values in the order of the fields
+
+    static constexpr std::size_t ROOT = 0;                                           ///< Node of the record
+    static constexpr std::size_t NO_NODE = std::numeric_limits<std::size_t>::max(); ///< No field goes through it
+
+    Fields()
+        : m_nodes(1)
+    {
+    }
+
+    /**
+     * @brief Add a field.
+     *
+     * @param path The path to the value, the parts of the arrays are their indexes.
+     * @param type The expected type of the value.
+     * @return std::size_t The index of the value.
+     */
+    std::size_t add(const DotPath& path, Type type)
+    {
+        const auto index = m_fields.size();
+        m_fields.emplace_back(Field {path, type});
+
+        auto node = ROOT;
+        for (const auto& part : path.parts())
+        {
+            auto next = child(node, part);
+            if (next == NO_NODE)
+            {
+                next = m_nodes.size();
+                m_nodes[node].children.emplace_back(part, next);
+                m_nodes.emplace_back();
+            }
+            node = next;
+        }
+        m_nodes[node].fields.push_back(index);
+
+        return index;
+    }
+
+    std::size_t size() const { return m_fields.size(); }
+    const DotPath& path(std::size_t index) const { return m_fields[index].path; }
+    Type type(std::size_t index) const { return m_fields[index].type; }
+
+    /**
+     * @brief Get the node reached from another one through a part of a path.
+     *
+     * The paths of the fields are kept as a tree, so a record is decoded in a single walk.
+     * @param node The node, ROOT for the record.
+     * @param part The map key or the array index.
+     * @return std::size_t The child node, NO_NODE if no field goes through it.
+     */
+    std::size_t child(std::size_t node, std::string_view part) const
+    {
+        for (const auto& [key, next] : m_nodes[node].children)
+        {
+            if (key == part)
+            {
+                return next;
+            }
+        }
+        return NO_NODE;
+    }
+
+    /**
+     * @brief Get the indexes of the fields whose path ends at a node.
+     */
+    const std::vector<std::size_t>& fieldsAt(std::size_t node) const { return m_nodes[node].fields; }
+
+private:
+    struct Field
+    {
+        DotPath path; ///< Path to the value
+        Type type;    ///< Expected type of the value
+    };
+
+    struct Node
+    {
+        std::vector<std::pair<std::string, std::size_t>> children; ///< Parts of the paths and their nodes
+        std::vector<std::size_t> fields;                           ///< Fields ending at the node
+    };
+
+    std::vector<Field> m_fields; ///< The fields, by index
+    std::vector<Node> m_nodes;   ///< Tree of the paths, the first node is the root
+};
+
 /**
  * @brief Interface for querying data from a geo database.
  *
@@ -56,6 +166,56 @@ public:
      * @note this method not supported array or object type.
      */
     virtual base::RespOrError<json::Json> getAsJson(const std::string& ip, const DotPath& path) = 0;
+
+    /**
+     * @brief Get the values of a set of fields.
+     *
+     * The default implementation gets each value on its own, locators may cache them by IP.
+     *
+     * @param ip Target ip to query
+     * @param fields The fields to get.
+     * @return base::RespOrError<std::shared_ptr<const Fields::Values>> Either the values, missing if not found or not
+     * of the expected type, or an error if the IP could not be looked up.
+     */
+    virtual base::RespOrError<std::shared_ptr<const Fields::Values>>
+    getFields(const std::string& ip, const std::shared_ptr<const Fields>& fields)
+    {
+        auto values = std::make_shared<Fields::Values>(fields->size());
+        for (std::size_t i = 0; i < fields->size(); ++i)
+        {
+            switch (fields->type(i))
+            {
+                case Fields::Type::STRING:
+                {
+                    auto value = getString(ip, fields->path(i));
+                    if (!base::isError(value))
+                    {
+                        (*values)[i] = std::move(base::getResponse(value));
+                    }
+                    break;
+                }
+                case Fields::Type::UINT32:
+                {
+                    auto value = getUint32(ip, fields->path(i));
+                    if (!base::isError(value))
+                    {
+                        (*values)[i] = base::getResponse(value);
+                    }
+                    break;
+                }
+                case Fields::Type::DOUBLE:
+                {
+                    auto value = getDouble(ip, fields->path(i));
+                    if (!base::isError(value))
+                    {
+                        (*values)[i] = base::getResponse(value);
+                    }
+                    break;
+                }
+            }
+        }
+        return values;
+    }
 };
 
 } // namespace geo
@@ -1,32 +1,65 @@
 #ifndef _GEO_DBENTRY_HPP
 #define _GEO_DBENTRY_HPP
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
-#include <shared_mutex>
+#include <string>
 
+#include <fmt/format.h>
 #include <maxminddb.h>
 
+#include <error.hpp>
 #include <geo/imanager.hpp>
 
 namespace geo
 {
 
+/**
+ * @brief Open a MMDB database memory-mapped.
+ *
+ * @param path The path to the database.
+ * @return base::RespOrError<std::shared_ptr<MMDB_s>> The database, closed when the last reference is released, or an
+ * error if it could not be opened.
+ */
+inline base::RespOrError<std::shared_ptr<MMDB_s>> openMMDB(const std::string& path)
+{
+    auto mmdb = std::make_unique<MMDB_s>();
+    int status = MMDB_open(path.c_str(), MMDB_MODE_MMAP, mmdb.get());
+    if (MMDB_SUCCESS != status)
+    {
+        return base::Error {fmt::format("Cannot add database '{}': {}", path, MMDB_strerror(status))};
+    }
+
+    return std::shared_ptr<MMDB_s>(mmdb.release(),
+                                   [](MMDB_s* handle)
+                                   {
+                                       MMDB_close(handle);
+                                       delete handle;
+                                   });
+}
+
 /**
  * @brief Class to hold the needed information for a database.
+ *
+ * The database is published with an atomic pointer swap. Readers never lock it: each locator keeps a reference to the
+ * handle it looked up with, and only loads the published one when the generation changes. A replaced handle is closed
+ * once the last locator holding it moves to the new one.
  */
 class DbEntry
 {
 public:
-    std::string path;                  ///< The path to the database.
-    Type type;                         ///< The type of database.
-    mutable std::shared_mutex rwMutex; ///< Read-Write mutex for thread safety access to the MMDB database.
-    std::unique_ptr<MMDB_s> mmdb;      ///< The MMDB database.
+    std::string path;                 ///< The path to the database.
+    Type type;                        ///< The type of database.
+    std::shared_ptr<MMDB_s> mmdb;     ///< The MMDB database, only accessed with std::atomic_load/atomic_store.
+    std::atomic<uint64_t> generation; ///< Incremented each time a database is published.
 
     DbEntry(const std::string& path, Type type)
         : path(path)
         , type(type)
+        , mmdb()
+        , generation(0)
     {
-        mmdb = std::make_unique<MMDB_s>();
     }
 
     DbEntry(const DbEntry&) = delete;
@@ -34,13 +67,23 @@ public:
     DbEntry(DbEntry&&) = delete;
     DbEntry& operator=(DbEntry&&) = delete;
 
-    ~DbEntry()
+    /**
+     * @brief Publish a new database, the readers move to it on their next lookup.
+     *
+     * @param handle The opened database.
+     */
+    void publish(std::shared_ptr<MMDB_s> handle)
     {
-        if (mmdb != nullptr)
-        {
-            MMDB_close(mmdb.get());
-        }
+        std::atomic_store(&mmdb, std::move(handle));
+        generation.fetch_add(1, std::memory_order_release);
     }
+
+    /**
+     * @brief Get the published database.
+     *
+     * @return std::shared_ptr<MMDB_s>
+     */
+    std::shared_ptr<MMDB_s> load() const { return std::atomic_load(&mmdb); }
 };
 } // namespace geo
 #endif // _GEO_DBENTRY_HPP
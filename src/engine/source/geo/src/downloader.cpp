@@ -1,9 +1,17 @@
 #include "downloader.hpp"
 
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
 #include <curl/curl.h>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
 #include <iomanip>
 #include <openssl/evp.h>
 #include <sstream>
+#include <unistd.h>
+#include <vector>
 
 #include <fmt/format.h>
 
@@ -22,6 +30,332 @@ bool isMD5Hash(const std::string& str)
     // Check if the string has 32 characters and consists of hexadecimal digits
     return str.size() == 32 && std::all_of(str.begin(), str.end(), ::isxdigit);
 }
+
+// Number of ranges downloaded at once when the server supports them
+constexpr auto PARALLEL_RANGES = 4;
+// Smaller files are downloaded with a single request
+constexpr curl_off_t MIN_PARALLEL_SIZE = 8 * 1024 * 1024;
+// Size of the blocks read to hash a downloaded file
+constexpr std::size_t HASH_BLOCK_SIZE = 1024 * 1024;
+
+/**
+ * @brief Incremental MD5 hash, so the data is hashed as it is received.
+ */
+class MD5Hasher
+{
+private:
+    EVP_MD_CTX* m_ctx;
+    bool m_valid;
+
+public:
+    MD5Hasher()
+        : m_ctx(EVP_MD_CTX_new())
+        , m_valid(m_ctx && EVP_DigestInit_ex(m_ctx, EVP_md5(), nullptr) == 1)
+    {
+    }
+
+    ~MD5Hasher() { EVP_MD_CTX_free(m_ctx); }
+
+    MD5Hasher(const MD5Hasher&) = delete;
+    MD5Hasher& operator=(const MD5Hasher&) = delete;
+
+    void update(const void* data, std::size_t size)
+    {
+        m_valid = m_valid && EVP_DigestUpdate(m_ctx, data, size) == 1;
+    }
+
+    // Hex digest, empty on error
+    std::string final()
+    {
+        unsigned char digest[EVP_MAX_MD_SIZE];
+        unsigned int digest_len;
+
+        if (!m_valid || EVP_DigestFinal_ex(m_ctx, digest, &digest_len) != 1)
+        {
+            return "";
+        }
+
+        std::stringstream ss;
+        for (unsigned int i = 0; i < digest_len; ++i)
+        {
+            ss << std::hex << std::setw(2) << std::setfill('0') << (int)digest[i];
+        }
+
+        return ss.str();
+    }
+};
+
+void setCommonOptions(CURL* curl, const std::string& url)
+{
+    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 1L);
+    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 1L);
+    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+    // Fail on HTTP errors instead of saving the error page
+    curl_easy_setopt(curl, CURLOPT_FAILONERROR, 1L);
+}
+
+// Size of the file and whether its ranges can be downloaded separately
+struct FileProbe
+{
+    curl_off_t size = -1;
+    bool acceptRanges = false;
+    std::string url; // After the redirections
+};
+
+size_t probeHeaderCallback(char* buffer, size_t size, size_t nitems, FileProbe* probe)
+{
+    std::string header(buffer, size * nitems);
+    std::transform(header.begin(), header.end(), header.begin(), ::tolower);
+    if (header.rfind("accept-ranges:", 0) == 0 && header.find("bytes") != std::string::npos)
+    {
+        probe->acceptRanges = true;
+    }
+    return size * nitems;
+}
+
+base::RespOrError<FileProbe> probeFile(const std::string& url)
+{
+    FileProbe probe;
+
+    CURL* curl = curl_easy_init();
+    if (!curl)
+    {
+        return base::Error {"Cannot initialize curl"};
+    }
+
+    setCommonOptions(curl, url);
+    curl_easy_setopt(curl, CURLOPT_NOBODY, 1L);
+    curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, probeHeaderCallback);
+    curl_easy_setopt(curl, CURLOPT_HEADERDATA, &probe);
+
+    auto res = curl_easy_perform(curl);
+    if (res != CURLE_OK)
+    {
+        curl_easy_cleanup(curl);
+        return base::Error {fmt::format("Failed to get the size of '{}', error: {}", url, curl_easy_strerror(res))};
+    }
+
+    curl_easy_getinfo(curl, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &probe.size);
+    char* effectiveUrl = nullptr;
+    curl_easy_getinfo(curl, CURLINFO_EFFECTIVE_URL, &effectiveUrl);
+    probe.url = effectiveUrl ? effectiveUrl : url;
+
+    curl_easy_cleanup(curl);
+    return probe;
+}
+
+// Sequential download, hashed as it is written
+struct StreamWriter
+{
+    std::ofstream* file;
+    MD5Hasher* hasher;
+};
+
+size_t streamWriteCallback(char* data, size_t size, size_t nmemb, StreamWriter* writer)
+{
+    writer->file->write(data, size * nmemb);
+    if (!*writer->file)
+    {
+        return 0;
+    }
+    writer->hasher->update(data, size * nmemb);
+    return size * nmemb;
+}
+
+base::RespOrError<std::string> downloadStream(const std::string& url, const std::string& path)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        return base::Error {fmt::format("Cannot open file '{}'", path)};
+    }
+
+    MD5Hasher hasher;
+    StreamWriter writer {&file, &hasher};
+
+    CURL* curl = curl_easy_init();
+    if (!curl)
+    {
+        return base::Error {"Cannot initialize curl"};
+    }
+
+    setCommonOptions(curl, url);
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, streamWriteCallback);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &writer);
+
+    auto res = curl_easy_perform(curl);
+    curl_easy_cleanup(curl);
+    file.close();
+
+    if (res != CURLE_OK)
+    {
+        return base::Error {fmt::format("Failed to download file from '{}', error: {}", url, curl_easy_strerror(res))};
+    }
+    if (file.fail())
+    {
+        return base::Error {fmt::format("Cannot write to file '{}'", path)};
+    }
+
+    return hasher.final();
+}
+
+// Range of the file written at its offset, the ranges are written concurrently
+struct RangeWriter
+{
+    int fd;
+    curl_off_t offset; // Next byte to write
+    curl_off_t end;    // Last byte of the range
+    std::string range;
+};
+
+size_t rangeWriteCallback(char* data, size_t size, size_t nmemb, RangeWriter* writer)
+{
+    auto remaining = size * nmemb;
+
+    // A server ignoring the range would send more data than requested
+    if (writer->offset + static_cast<curl_off_t>(remaining) > writer->end + 1)
+    {
+        return 0;
+    }
+
+    while (remaining > 0)
+    {
+        auto written = pwrite(writer->fd, data, remaining, writer->offset);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return 0;
+        }
+        data += written;
+        remaining -= written;
+        writer->offset += written;
+    }
+
+    return size * nmemb;
+}
+
+base::OptError downloadRanges(const FileProbe& probe, const std::string& path)
+{
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0640);
+    if (fd < 0)
+    {
+        return base::Error {fmt::format("Cannot open file '{}': {}", path, strerror(errno))};
+    }
+
+    // Split the file in ranges, the last one takes the remainder
+    std::vector<RangeWriter> writers(PARALLEL_RANGES);
+    const auto rangeSize = probe.size / PARALLEL_RANGES;
+    for (int i = 0; i < PARALLEL_RANGES; ++i)
+    {
+        writers[i].fd = fd;
+        writers[i].offset = i * rangeSize;
+        writers[i].end = i == PARALLEL_RANGES - 1 ? probe.size - 1 : (i + 1) * rangeSize - 1;
+        writers[i].range = fmt::format("{}-{}", writers[i].offset, writers[i].end);
+    }
+
+    CURLM* multi = curl_multi_init();
+    std::vector<CURL*> handles;
+    base::OptError error = base::noError();
+
+    for (auto& writer : writers)
+    {
+        CURL* curl = curl_easy_init();
+        if (!curl)
+        {
+            error = base::Error {"Cannot initialize curl"};
+            break;
+        }
+        handles.push_back(curl);
+
+        setCommonOptions(curl, probe.url);
+        curl_easy_setopt(curl, CURLOPT_RANGE, writer.range.c_str());
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, rangeWriteCallback);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &writer);
+        curl_multi_add_handle(multi, curl);
+    }
+
+    if (!base::isError(error))
+    {
+        int running = 0;
+        do
+        {
+            auto mc = curl_multi_perform(multi, &running);
+            if (mc == CURLM_OK && running > 0)
+            {
+                mc = curl_multi_wait(multi, nullptr, 0, 1000, nullptr);
+            }
+            if (mc != CURLM_OK)
+            {
+                error = base::Error {fmt::format("Failed to download file from '{}', error: {}",
+                                                 probe.url,
+                                                 curl_multi_strerror(mc))};
+                break;
+            }
+        } while (running > 0);
+    }
+
+    int pending = 0;
+    while (auto msg = curl_multi_info_read(multi, &pending))
+    {
+        if (msg->msg == CURLMSG_DONE && msg->data.result != CURLE_OK && !base::isError(error))
+        {
+            error = base::Error {fmt::format(
+                "Failed to download file from '{}', error: {}", probe.url, curl_easy_strerror(msg->data.result))};
+        }
+    }
+
+    for (auto curl : handles)
+    {
+        long responseCode = 0;
+        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &responseCode);
+        if (responseCode != 206 && !base::isError(error))
+        {
+            error = base::Error {fmt::format("Server did not honor the ranges of '{}' ({})", probe.url, responseCode)};
+        }
+        curl_multi_remove_handle(multi, curl);
+        curl_easy_cleanup(curl);
+    }
+    curl_multi_cleanup(multi);
+
+    for (const auto& writer : writers)
+    {
+        if (writer.offset != writer.end + 1 && !base::isError(error))
+        {
+            error = base::Error {fmt::format("Incomplete range {} of '{}'", writer.range, probe.url)};
+        }
+    }
+
+    if (close(fd) != 0 && !base::isError(error))
+    {
+        error = base::Error {fmt::format("Cannot write to file '{}': {}", path, strerror(errno))};
+    }
+
+    return error;
+}
+
+// Hash a file reading it by blocks
+std::string hashFile(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+    {
+        return "";
+    }
+
+    MD5Hasher hasher;
+    std::vector<char> block(HASH_BLOCK_SIZE);
+    while (file)
+    {
+        file.read(block.data(), block.size());
+        hasher.update(block.data(), static_cast<std::size_t>(file.gcount()));
+    }
+
+    return file.bad() ? "" : hasher.final();
+}
 } // namespace
 
 namespace geo
@@ -74,46 +408,9 @@ base::RespOrError<std::string> Downloader::downloadHTTPS(const std::string& url)
 // Function to compute the MD5 hash of input data
 std::string Downloader::computeMD5(const std::string& data) const
 {
-    EVP_MD_CTX* ctx = EVP_MD_CTX_new();
-    if (!ctx)
-    {
-        // Handle error
-        return "";
-    }
-
-    if (EVP_DigestInit_ex(ctx, EVP_md5(), nullptr) != 1)
-    {
-        // Handle error
-        EVP_MD_CTX_free(ctx);
-        return "";
-    }
-
-    if (EVP_DigestUpdate(ctx, data.c_str(), data.size()) != 1)
-    {
-        // Handle error
-        EVP_MD_CTX_free(ctx);
-        return "";
-    }
-
-    unsigned char digest[EVP_MAX_MD_SIZE];
-    unsigned int digest_len;
-
-    if (EVP_DigestFinal_ex(ctx, digest, &digest_len) != 1)
-    {
-        // Handle error
-        EVP_MD_CTX_free(ctx);
-        return "";
-    }
-
-    EVP_MD_CTX_free(ctx);
-
-    std::stringstream ss;
-    for (unsigned int i = 0; i < digest_len; ++i)
-    {
-        ss << std::hex << std::setw(2) << std::setfill('0') << (int)digest[i];
-    }
-
-    return ss.str();
+    MD5Hasher hasher;
+    hasher.update(data.c_str(), data.size());
+    return hasher.final();
 }
 
 base::RespOrError<std::string> Downloader::downloadMD5(const std::string& url) const
@@ -139,4 +436,49 @@ base::RespOrError<std::string> Downloader::downloadMD5(const std::string& url) c
 
     return hash;
 }
+base::OptError Downloader::downloadFile(const std::string& url, const std::string& path, const std::string& md5) const
+{
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+
+    // Large files are downloaded by ranges in parallel when the server supports it, and hashed once written
+    std::string hash;
+    base::OptError error = base::noError();
+    auto probe = probeFile(url);
+    if (!base::isError(probe) && base::getResponse(probe).acceptRanges
+        && base::getResponse(probe).size >= MIN_PARALLEL_SIZE)
+    {
+        error = downloadRanges(base::getResponse(probe), path);
+        if (!base::isError(error))
+        {
+            hash = hashFile(path);
+        }
+    }
+    else
+    {
+        auto streamResp = downloadStream(url, path);
+        if (base::isError(streamResp))
+        {
+            error = base::getError(streamResp);
+        }
+        else
+        {
+            hash = base::getResponse(streamResp);
+        }
+    }
+
+    curl_global_cleanup();
+
+    if (!base::isError(error) && hash != md5)
+    {
+        error = base::Error {fmt::format("Hash mismatch for '{}'", url)};
+    }
+
+    if (base::isError(error))
+    {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+
+    return error;
+}
 } // namespace geo
@@ -4,7 +4,6 @@
 #include <cstdint>
 #include <iomanip>
 #include <iostream>
-#include <shared_mutex>
 #include <sstream>
 
 #include "dbEntry.hpp"
@@ -239,6 +238,103 @@ MMDB_entry_data_list_s* dumpEntryDataList(MMDB_entry_data_list_s* eDataList, jso
     return eDataList;
 }
 
+/**
+ * @brief Stores the value of a leaf entry in the fields whose path ends at the node, if it has their type.
+ *
+ * @param eData The entry data of the leaf.
+ * @param fields The fields looked up.
+ * @param node The node of the fields tree reached by the leaf.
+ * @param values The values of the fields.
+ */
+void setFieldValues(const MMDB_entry_data_s& eData,
+                    const geo::Fields& fields,
+                    std::size_t node,
+                    geo::Fields::Values& values)
+{
+    for (const auto index : fields.fieldsAt(node))
+    {
+        switch (fields.type(index))
+        {
+            case geo::Fields::Type::STRING:
+                if (eData.type == MMDB_DATA_TYPE_UTF8_STRING)
+                {
+                    values[index] = std::string {eData.utf8_string, eData.data_size};
+                }
+                break;
+            case geo::Fields::Type::UINT32:
+                if (eData.type == MMDB_DATA_TYPE_UINT32)
+                {
+                    values[index] = eData.uint32;
+                }
+                break;
+            case geo::Fields::Type::DOUBLE:
+                if (eData.type == MMDB_DATA_TYPE_DOUBLE)
+                {
+                    values[index] = eData.double_value;
+                }
+                break;
+        }
+    }
+}
+
+/**
+ * @brief Walks an entry of the MMDB entry data list, storing the values of the fields found in it.
+ *
+ * The whole record is decoded once, and the entries no field goes through are skipped.
+ *
+ * @param eDataList The entry to walk.
+ * @param fields The fields looked up.
+ * @param node The node of the fields tree reached by the entry, Fields::NO_NODE to skip it.
+ * @param values The values of the fields.
+ * @return The next node in the linked list after the entry.
+ */
+MMDB_entry_data_list_s* walkFields(MMDB_entry_data_list_s* eDataList,
+                                   const geo::Fields& fields,
+                                   std::size_t node,
+                                   geo::Fields::Values& values)
+{
+    const auto& eData = eDataList->entry_data;
+
+    switch (eData.type)
+    {
+        case MMDB_DATA_TYPE_MAP:
+        {
+            uint32_t size = eData.data_size;
+            for (eDataList = eDataList->next; size && eDataList; size--)
+            {
+                if (MMDB_DATA_TYPE_UTF8_STRING != eDataList->entry_data.type || eDataList->next == nullptr)
+                {
+                    return nullptr;
+                }
+
+                const std::string_view key {eDataList->entry_data.utf8_string, eDataList->entry_data.data_size};
+                const auto child = node == geo::Fields::NO_NODE ? geo::Fields::NO_NODE : fields.child(node, key);
+                eDataList = walkFields(eDataList->next, fields, child, values);
+            }
+            return eDataList;
+        }
+        case MMDB_DATA_TYPE_ARRAY:
+        {
+            uint32_t size = eData.data_size;
+            uint32_t index = 0;
+            for (eDataList = eDataList->next; size && eDataList; size--)
+            {
+                const auto child =
+                    node == geo::Fields::NO_NODE ? geo::Fields::NO_NODE : fields.child(node, std::to_string(index));
+                ++index;
+                eDataList = walkFields(eDataList, fields, child, values);
+            }
+            return eDataList;
+        }
+        default:
+            if (node != geo::Fields::NO_NODE)
+            {
+                setFieldValues(eData, fields, node, values);
+            }
+            return eDataList->next;
+    }
+}
+
 static const std::string TRANSLATE_ERROR = "Error translating IP address ";
 static const std::string LIBMMD_ERROR = "Error from libmaxminddb: ";
 
@@ -247,7 +343,58 @@ static const std::string LIBMMD_ERROR = "Error from libmaxminddb: ";
 namespace geo
 {
 
-base::OptError Locator::lookup(const std::string& ip, const std::shared_ptr<DbEntry>& entry)
+Locator::Locator(const std::shared_ptr<DbEntry>& dbEntry, std::size_t cacheSize)
+    : m_weakDbEntry(dbEntry)
+    , m_mmdb()
+    , m_generation(0)
+    , m_cachedIp()
+    , m_cachedResult()
+    , m_cacheSize(cacheSize)
+    , m_cachedValues()
+    , m_index()
+{
+    if (m_weakDbEntry.expired())
+    {
+        throw std::runtime_error("Cannot build a maxmind locator with an expired db entry");
+    }
+}
+
+void Locator::clearCache()
+{
+    m_cachedIp.clear();
+    m_cachedResult = MMDB_lookup_result_s {};
+    m_index.clear();
+    m_cachedValues.clear();
+}
+
+base::OptError Locator::syncDb()
+{
+    // Check if the database entry is still valid
+    auto entry = m_weakDbEntry.lock();
+    if (entry != nullptr)
+    {
+        const auto generation = entry->generation.load(std::memory_order_acquire);
+        if (m_mmdb == nullptr || generation != m_generation)
+        {
+            // The cached results point into the replaced database
+            clearCache();
+            m_mmdb = entry->load();
+            m_generation = generation;
+        }
+    }
+
+    if (entry == nullptr || m_mmdb == nullptr)
+    {
+        // Release the database so it is closed
+        clearCache();
+        m_mmdb.reset();
+        return base::Error {"Database is not available"};
+    }
+
+    return base::noError();
+}
+
+base::OptError Locator::lookup(const std::string& ip)
 {
     // Check if the IP address is the same as the cached one
     if (ip == m_cachedIp)
@@ -257,7 +404,7 @@ base::OptError Locator::lookup(const std::string& ip, const std::shared_ptr<DbEn
 
     // Lookup the IP address in the database
     int gai_error, mmdb_error;
-    MMDB_lookup_result_s result = MMDB_lookup_string(entry->mmdb.get(), ip.c_str(), &gai_error, &mmdb_error);
+    MMDB_lookup_result_s result = MMDB_lookup_string(m_mmdb.get(), ip.c_str(), &gai_error, &mmdb_error);
 
     if (0 != gai_error) // translation error
     {
@@ -296,26 +443,15 @@ base::RespOrError<MMDB_entry_data_s> Locator::getEData(const DotPath& path)
 
 base::RespOrError<std::string> Locator::getString(const std::string& ip, const DotPath& path)
 {
-    // Check if the database entry is still valid
-    auto entry = m_weakDbEntry.lock();
-    if (entry == nullptr)
+    // Move to the last published database
+    auto syncError = syncDb();
+    if (base::isError(syncError))
     {
-        return base::Error {"Database is not available"};
-    }
-
-    // Hold read lock on the map
-    std::shared_lock lock(entry->rwMutex);
-
-    // Check the entry is not expired while holding the lock
-    entry.reset();
-    entry = m_weakDbEntry.lock();
-    if (entry == nullptr)
-    {
-        return base::Error {"Database is not available"};
+        return base::getError(syncError);
     }
 
     // Lookup the IP address in the database
-    auto lookError = lookup(ip, entry);
+    auto lookError = lookup(ip);
     if (base::isError(lookError))
     {
         return base::getError(lookError);
@@ -340,26 +476,15 @@ base::RespOrError<std::string> Locator::getString(const std::string& ip, const D
 
 base::RespOrError<uint32_t> Locator::getUint32(const std::string& ip, const DotPath& path)
 {
-    // Check if the database entry is still valid
-    auto entry = m_weakDbEntry.lock();
-    if (entry == nullptr)
-    {
-        return base::Error {"Database is not available"};
-    }
-
-    // Hold read lock on the map
-    std::shared_lock lock(entry->rwMutex);
-
-    // Check the entry is not expired while holding the lock
-    entry.reset();
-    entry = m_weakDbEntry.lock();
-    if (entry == nullptr)
+    // Move to the last published database
+    auto syncError = syncDb();
+    if (base::isError(syncError))
     {
-        return base::Error {"Database is not available"};
+        return base::getError(syncError);
     }
 
     // Lookup the IP address in the database
-    auto lookError = lookup(ip, entry);
+    auto lookError = lookup(ip);
     if (base::isError(lookError))
     {
         return base::getError(lookError);
@@ -384,26 +509,15 @@ base::RespOrError<uint32_t> Locator::getUint32(const std::string& ip, const DotP
 
 base::RespOrError<double> Locator::getDouble(const std::string& ip, const DotPath& path)
 {
-    // Check if the database entry is still valid
-    auto entry = m_weakDbEntry.lock();
-    if (entry == nullptr)
+    // Move to the last published database
+    auto syncError = syncDb();
+    if (base::isError(syncError))
     {
-        return base::Error {"Database is not available"};
-    }
-
-    // Hold read lock on the map
-    std::shared_lock lock(entry->rwMutex);
-
-    // Check the entry is not expired while holding the lock
-    entry.reset();
-    entry = m_weakDbEntry.lock();
-    if (entry == nullptr)
-    {
-        return base::Error {"Database is not available"};
+        return base::getError(syncError);
     }
 
     // Lookup the IP address in the database
-    auto lookError = lookup(ip, entry);
+    auto lookError = lookup(ip);
     if (base::isError(lookError))
     {
         return base::getError(lookError);
@@ -428,26 +542,15 @@ base::RespOrError<double> Locator::getDouble(const std::string& ip, const DotPat
 
 base::RespOrError<json::Json> Locator::getAsJson(const std::string& ip, const DotPath& path)
 {
-    // Check if the database entry is still valid
-    auto entry = m_weakDbEntry.lock();
-    if (entry == nullptr)
-    {
-        return base::Error {"Database is not available"};
-    }
-
-    // Hold read lock on the map
-    std::shared_lock lock(entry->rwMutex);
-
-    // Check the entry is not expired while holding the lock
-    entry.reset();
-    entry = m_weakDbEntry.lock();
-    if (entry == nullptr)
+    // Move to the last published database
+    auto syncError = syncDb();
+    if (base::isError(syncError))
     {
-        return base::Error {"Database is not available"};
+        return base::getError(syncError);
     }
 
     // Lookup the IP address in the database
-    auto lookError = lookup(ip, entry);
+    auto lookError = lookup(ip);
     if (base::isError(lookError))
     {
         return base::getError(lookError);
@@ -483,4 +586,74 @@ base::RespOrError<json::Json> Locator::getAsJson(const std::string& ip, const Do
     return result;
 }
 
+base::RespOrError<std::shared_ptr<const Fields::Values>>
+Locator::getFields(const std::string& ip, const std::shared_ptr<const Fields>& fields)
+{
+    // Move to the last published database
+    auto syncError = syncDb();
+    if (base::isError(syncError))
+    {
+        return base::getError(syncError);
+    }
+
+    // Look for the values in the cache, only the same fields can be reused
+    const auto cached = m_index.find(ip);
+    if (cached != m_index.end() && cached->second->fields == fields)
+    {
+        m_cachedValues.splice(m_cachedValues.begin(), m_cachedValues, cached->second);
+        if (cached->second->values == nullptr)
+        {
+            return base::Error {"No data found for the IP address"};
+        }
+        return cached->second->values;
+    }
+
+    // Lookup the IP address in the database, translation errors are not cached
+    auto lookError = lookup(ip);
+    if (base::isError(lookError))
+    {
+        return base::getError(lookError);
+    }
+
+    std::shared_ptr<Fields::Values> values;
+    if (m_cachedResult.found_entry)
+    {
+        values = std::make_shared<Fields::Values>(fields->size());
+
+        // A single walk of the record decodes the values of all the fields
+        MMDB_entry_data_list_s* eDataList = nullptr;
+        if (MMDB_SUCCESS == MMDB_get_entry_data_list(&m_cachedResult.entry, &eDataList) && eDataList != nullptr)
+        {
+            walkFields(eDataList, *fields, Fields::ROOT, *values);
+        }
+        MMDB_free_entry_data_list(eDataList);
+    }
+
+    if (m_cacheSize > 0)
+    {
+        if (cached != m_index.end())
+        {
+            // Cached for other fields, replaced by the last ones looked up
+            const auto it = cached->second;
+            m_index.erase(cached);
+            m_cachedValues.erase(it);
+        }
+        else if (m_cachedValues.size() >= m_cacheSize)
+        {
+            m_index.erase(m_cachedValues.back().ip);
+            m_cachedValues.pop_back();
+        }
+
+        // The IPs not in the database are cached too, without values
+        m_cachedValues.push_front(CachedValues {ip, fields, values});
+        m_index.emplace(m_cachedValues.front().ip, m_cachedValues.begin());
+    }
+
+    if (values == nullptr)
+    {
+        return base::Error {"No data found for the IP address"};
+    }
+    return values;
+}
+
 } // namespace geo
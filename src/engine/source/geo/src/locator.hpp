@@ -1,6 +1,12 @@
 #ifndef _GEO_LOCATOR_HPP
 #define _GEO_LOCATOR_HPP
 
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <string_view>
+#include <unordered_map>
+
 #include <geo/ilocator.hpp>
 
 #include <maxminddb.h>
@@ -8,16 +14,49 @@
 namespace geo
 {
 
+constexpr std::size_t DEFAULT_LOCATOR_CACHE_SIZE = 1024; ///< IPs whose field values are cached by a locator
+
 class DbEntry; ///< Forward declaration
 
 class Locator final : public ILocator
 {
 private:
+    /**
+     * @brief Values of a set of fields looked up for an IP.
+     */
+    struct CachedValues
+    {
+        std::string ip;                               ///< The IP address.
+        std::shared_ptr<const Fields> fields;         ///< The fields looked up.
+        std::shared_ptr<const Fields::Values> values; ///< The values, nullptr if the IP is not in the database.
+    };
+    using CachedValuesList = std::list<CachedValues>;
+
     std::weak_ptr<DbEntry> m_weakDbEntry; ///< The weak pointer to the database entry.
+    std::shared_ptr<MMDB_s> m_mmdb;       ///< The database looked up, kept open while the results are cached.
+    uint64_t m_generation;                ///< Generation of the database looked up.
 
     std::string m_cachedIp;              ///< The cached IP address.
     MMDB_lookup_result_s m_cachedResult; ///< The cached lookup result.
 
+    std::size_t m_cacheSize;                                                  ///< Maximum number of cached IPs.
+    CachedValuesList m_cachedValues;                                          ///< Values, the most recently used first.
+    std::unordered_map<std::string_view, CachedValuesList::iterator> m_index; ///< Values by IP, owned by the list.
+
+    /**
+     * @brief Drops the cached results.
+     */
+    void clearCache();
+
+    /**
+     * @brief Moves to the database published by the entry if it changed, dropping the cached results.
+     *
+     * While the database is not replaced, only the weak reference and the generation are loaded, without locks.
+     *
+     * @return base::OptError An error if the database is no longer available.
+     */
+    base::OptError syncDb();
+
     /**
      * @brief Retrieves the entry data for a given dot path.
      *
@@ -27,13 +66,12 @@ private:
     base::RespOrError<MMDB_entry_data_s> getEData(const DotPath& path);
 
     /**
-     * @brief Looks up the given IP address in the database if it is not already cached.
+     * @brief Looks up the given IP address in the database if it is not already cached, once synced with syncDb.
      *
      * @param ip The IP address to look up.
-     * @param dbEntry The database entry to use for the lookup.
      * @return A base::OptError object containing an error message if the lookup failed.
      */
-    base::OptError lookup(const std::string& ip, const std::shared_ptr<DbEntry>& dbEntry);
+    base::OptError lookup(const std::string& ip);
 
 public:
     virtual ~Locator() = default;
@@ -44,15 +82,9 @@ public:
      * @brief Construct a new Locator object
      *
      * @param dbEntry The database entry to use for the locator.
+     * @param cacheSize Maximum number of IPs whose field values are cached, 0 disables the cache.
      */
-    Locator(const std::shared_ptr<DbEntry>& dbEntry)
-        : m_weakDbEntry(dbEntry)
-    {
-        if (m_weakDbEntry.expired())
-        {
-            throw std::runtime_error("Cannot build a maxmind locator with an expired db entry");
-        }
-    }
+    Locator(const std::shared_ptr<DbEntry>& dbEntry, std::size_t cacheSize = DEFAULT_LOCATOR_CACHE_SIZE);
 
     /**
      * @copydoc ILocator::getString
@@ -74,6 +106,14 @@ public:
      */
     base::RespOrError<json::Json> getAsJson(const std::string& ip, const DotPath& path) override;
 
+    /**
+     * @copydoc ILocator::getFields
+     *
+     * The values are cached by IP, in a LRU of the most recently looked up IPs.
+     */
+    base::RespOrError<std::shared_ptr<const Fields::Values>>
+    getFields(const std::string& ip, const std::shared_ptr<const Fields>& fields) override;
+
     /**
      * @brief Retrieves the cached IP address.
      *
@@ -87,6 +127,13 @@ public:
      * @return The cached lookup result.
      */
     inline const MMDB_lookup_result_s& getCachedResult() const { return m_cachedResult; }
+
+    /**
+     * @brief Retrieves the number of IPs whose field values are cached.
+     *
+     * @return The number of cached IPs.
+     */
+    inline std::size_t getCachedValuesSize() const { return m_cachedValues.size(); }
 };
 
 } // namespace geo
@@ -1,5 +1,6 @@
 #include "manager.hpp"
 
+#include <chrono>
 #include <filesystem>
 #include <fstream>
 #include <mutex>
@@ -8,6 +9,7 @@
 #include <maxminddb.h>
 
 #include <logging/logging.hpp>
+#include <metrics/iMetricsManager.hpp>
 #include <store/istore.hpp>
 
 #include "dbEntry.hpp"
@@ -15,9 +17,12 @@
 
 namespace geo
 {
-Manager::Manager(const std::shared_ptr<store::IStoreInternal>& store, const std::shared_ptr<IDownloader>& downloader)
+Manager::Manager(const std::shared_ptr<store::IStoreInternal>& store,
+                 const std::shared_ptr<IDownloader>& downloader,
+                 const std::shared_ptr<metricsManager::IMetricsManager>& metricsManager)
     : m_store(store)
     , m_downloader(downloader)
+    , m_swapLatency()
 {
     if (m_store == nullptr)
     {
@@ -29,6 +34,11 @@ Manager::Manager(const std::shared_ptr<store::IStoreInternal>& store, const std:
         throw std::runtime_error("Maxmindb manager needs a non-null downloader");
     }
 
+    if (metricsManager != nullptr)
+    {
+        m_swapLatency = metricsManager->getMetricsScope("Geo")->getHistogramUInteger("DbSwapLatency");
+    }
+
     // Load dbs from the internal store
     auto dbsResp = m_store->readInternalCol(INTERNAL_NAME);
     if (base::isError(dbsResp))
@@ -61,28 +71,32 @@ Manager::Manager(const std::shared_ptr<store::IStoreInternal>& store, const std:
     }
 }
 
-base::OptError Manager::upsertStoreEntry(const std::string& path)
+base::OptError Manager::upsertStoreEntry(const std::string& path, const std::string& hash)
 {
     std::filesystem::path dbPath(path);
 
-    // Open file and compute hash
-    auto file = std::ifstream(path, std::ios::binary);
-    if (!file.is_open())
+    auto dbHash = hash;
+    if (dbHash.empty())
     {
-        return base::Error {fmt::format("Cannot open file '{}'", path)};
-    }
+        // Open file and compute hash
+        auto file = std::ifstream(path, std::ios::binary);
+        if (!file.is_open())
+        {
+            return base::Error {fmt::format("Cannot open file '{}'", path)};
+        }
 
-    // Get content of the file to compute the hash
-    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        // Get content of the file to compute the hash
+        std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
 
-    auto hash = m_downloader->computeMD5(content);
-    file.close();
+        dbHash = m_downloader->computeMD5(content);
+        file.close();
+    }
 
     // Create and upsert the internal document
     auto internalName = base::Name({INTERNAL_NAME, dbPath.filename().string()});
     auto doc = store::Doc();
     doc.setString(path, PATH_PATH);
-    doc.setString(hash, HASH_PATH);
+    doc.setString(dbHash, HASH_PATH);
     doc.setString(typeName(m_dbs.at(dbPath.filename().string())->type), TYPE_PATH);
 
     return m_store->upsertInternalDoc(internalName, doc);
@@ -113,13 +127,14 @@ base::OptError Manager::addDbUnsafe(const std::string& path, Type type, bool ups
     }
 
     // Add the database
-    auto entry = std::make_shared<DbEntry>(path, type);
-    int status = MMDB_open(path.c_str(), MMDB_MODE_MMAP, entry->mmdb.get());
-    if (MMDB_SUCCESS != status)
+    auto handle = openMMDB(path);
+    if (base::isError(handle))
     {
-        return base::Error {fmt::format("Cannot add database '{}': {}", path, MMDB_strerror(status))};
+        return base::getError(handle);
     }
 
+    auto entry = std::make_shared<DbEntry>(path, type);
+    entry->publish(base::getResponse(handle));
     m_dbs.emplace(name, std::move(entry));
     m_dbTypes.emplace(type, name);
 
@@ -145,22 +160,8 @@ base::OptError Manager::removeDbUnsafe(const std::string& path)
         return base::Error {fmt::format("Database '{}' not found", name)};
     }
 
-    {
-        // We need to hold the entry so the lock is not released after the entry is removed
-        auto entry = m_dbs.at(name);
-
-        // Lock the database entry internal mutex for write
-        std::unique_lock<std::shared_mutex> lockEntry(entry->rwMutex);
-
-        // Remove the database
-        m_dbs.erase(name);
-
-        // Unlock the entry mutex
-        lockEntry.unlock();
-
-        // Freed the entry
-        entry.reset();
-    }
+    // Remove the database, it is closed once the locators looking it up release it
+    m_dbs.erase(name);
 
     // Remove the type from the map if it was the one in use
     for (auto it = m_dbTypes.begin(); it != m_dbTypes.end(); ++it)
@@ -175,36 +176,37 @@ base::OptError Manager::removeDbUnsafe(const std::string& path)
     return removeInternalEntry(path);
 }
 
-base::OptError Manager::writeDb(const std::string& path, const std::string& content)
+base::OptError Manager::swapDb(DbEntry& entry, const std::string& path, const std::string& tmpPath)
 {
-    auto filePath = std::filesystem::path(path);
+    // The new database was written next to the old one, still mapped by the readers
+    std::error_code ec;
+    const auto start = std::chrono::steady_clock::now();
 
-    // Create directories if they do not exist
-    try
-    {
-        std::filesystem::create_directories(filePath.parent_path());
-    }
-    catch (const std::exception& e)
+    auto handle = openMMDB(tmpPath);
+    if (base::isError(handle))
     {
-        return base::Error {fmt::format("Cannot create directories for '{}': {}", path, e.what())};
+        std::filesystem::remove(tmpPath, ec);
+        return base::getError(handle);
     }
 
-    // Write the content to the file
-    std::ofstream file(path, std::ios::binary);
-    if (!file.is_open())
-    {
-        return base::Error {fmt::format("Cannot open file '{}'", path)};
-    }
-    try
+    // The mappings keep the replaced file alive until the old database is closed
+    std::filesystem::rename(tmpPath, path, ec);
+    if (ec)
     {
-        file.write(content.c_str(), content.size());
-        file.close();
+        auto error = base::Error {fmt::format("Cannot replace database '{}': {}", path, ec.message())};
+        std::filesystem::remove(tmpPath, ec);
+        return error;
     }
-    catch (const std::exception& e)
+
+    entry.publish(base::getResponse(handle));
+
+    const auto latency =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    if (m_swapLatency)
     {
-        file.close();
-        return base::Error {fmt::format("Cannot write to file '{}': {}", path, e.what())};
+        m_swapLatency->recordValue(static_cast<uint64_t>(latency));
     }
+    LOG_DEBUG("Geo swapped database '{}' in {} us", path, latency);
 
     return base::noError();
 }
@@ -266,28 +268,29 @@ Manager::remoteUpsertDb(const std::string& path, Type type, const std::string& d
         }
     }
 
-    // Download the database while MAX_RETRIES if failed
-    std::string content;
+    // Create directories if they do not exist
+    try
+    {
+        std::filesystem::create_directories(std::filesystem::path(path).parent_path());
+    }
+    catch (const std::exception& e)
+    {
+        return base::Error {fmt::format("Cannot create directories for '{}': {}", path, e.what())};
+    }
+
+    // Download the database next to the current one, it is streamed to the file and checked against the hash
+    const auto tmpPath = path + ".tmp";
     base::OptError error;
     for (int i = 0; i < MAX_RETRIES; ++i)
     {
-        auto dbResp = m_downloader->downloadHTTPS(dbUrl);
-        if (base::isError(dbResp))
-        {
-            error = base::Error {
-                fmt::format("Cannot download database from '{}': {}", dbUrl, base::getError(dbResp).message)};
-            continue;
-        }
-
-        content = base::getResponse(dbResp);
-        auto computedHash = m_downloader->computeMD5(content);
-        if (computedHash == hash)
+        error = m_downloader->downloadFile(dbUrl, tmpPath, hash);
+        if (!base::isError(error))
         {
-            error = base::noError();
             break;
         }
 
-        error = base::Error {fmt::format("Hash mismatch for database '{}'", dbUrl)};
+        error = base::Error {
+            fmt::format("Cannot download database from '{}': {}", dbUrl, base::getError(error).message)};
     }
 
     if (base::isError(error))
@@ -295,35 +298,24 @@ Manager::remoteUpsertDb(const std::string& path, Type type, const std::string& d
         return error;
     }
 
-    // Write the database to the file
-    // If the database is already added, hold the internal mutex for write
+    // If the database is already added, open the new one alongside and swap them, the lookups never wait
     if (entry != m_dbs.end())
     {
-        std::unique_lock lockEntry(entry->second->rwMutex);
-        auto writeResp = writeDb(path, content);
-        if (base::isError(writeResp))
-        {
-            return base::getError(writeResp);
-        }
-
-        // Close the MMDB and reopen it
-        MMDB_close(entry->second->mmdb.get());
-        int status = MMDB_open(path.c_str(), MMDB_MODE_MMAP, entry->second->mmdb.get());
-        if (MMDB_SUCCESS != status)
+        auto swapError = swapDb(*entry->second, path, tmpPath);
+        if (base::isError(swapError))
         {
-            // Remove the database
-            lockEntry.unlock();
-            removeDbUnsafe(path);
-
-            return base::Error {fmt::format("Cannot add database '{}': {}", path, MMDB_strerror(status))};
+            return swapError;
         }
     }
     else
     {
-        auto writeResp = writeDb(path, content);
-        if (base::isError(writeResp))
+        std::error_code ec;
+        std::filesystem::rename(tmpPath, path, ec);
+        if (ec)
         {
-            return base::getError(writeResp);
+            auto renameError = base::Error {fmt::format("Cannot write database '{}': {}", path, ec.message())};
+            std::filesystem::remove(tmpPath, ec);
+            return renameError;
         }
 
         auto addResp = addDbUnsafe(path, type, false);
@@ -333,8 +325,8 @@ Manager::remoteUpsertDb(const std::string& path, Type type, const std::string& d
         }
     }
 
-    // Update the internal store
-    auto internalResp = upsertStoreEntry(path);
+    // Update the internal store, the hash was already checked
+    auto internalResp = upsertStoreEntry(path, hash);
     if (base::isError(internalResp))
     {
         LOG_WARNING("Cannot update internal store for '{}': {}", path, base::getError(internalResp).message);
@@ -191,6 +191,39 @@ TEST(LocatorInitTest, InitializeExpired)
     ASSERT_THROW(Locator(nullptr), std::runtime_error);
 }
 
+TEST(LocatorInitTest, NotPublished)
+{
+    auto dbEntry = std::make_shared<DbEntry>("path", Type::CITY);
+    Locator locator {dbEntry};
+    ASSERT_TRUE(base::isError(locator.getString(g_ipFullData, "test_map.test_str1")));
+}
+
+TEST(LocatorInitTest, GetAfterSwap)
+{
+    auto dbEntry = std::make_shared<DbEntry>(g_maxmindDbPath, Type::CITY);
+    auto first = openMMDB(g_maxmindDbPath);
+    ASSERT_FALSE(base::isError(first));
+    dbEntry->publish(base::getResponse(first));
+
+    Locator locator {dbEntry};
+    ASSERT_FALSE(base::isError(locator.getString(g_ipFullData, "test_map.test_str1")));
+    ASSERT_EQ(locator.getCachedResult().entry.mmdb, base::getResponse(first).get());
+
+    // Swap the database, the old one is kept open by the locator until it moves to the new one
+    auto second = openMMDB(g_maxmindDbPath);
+    ASSERT_FALSE(base::isError(second));
+    std::weak_ptr<MMDB_s> weakFirst = base::getResponse(first);
+    first = base::Error {"released"};
+    dbEntry->publish(base::getResponse(second));
+    ASSERT_FALSE(weakFirst.expired());
+
+    auto res = locator.getString(g_ipFullData, "test_map.test_str1");
+    ASSERT_FALSE(base::isError(res));
+    ASSERT_EQ(base::getResponse(res), "Wazuh");
+    ASSERT_EQ(locator.getCachedResult().entry.mmdb, base::getResponse(second).get());
+    ASSERT_TRUE(weakFirst.expired());
+}
+
 TEST_F(LocatorTest, Get)
 {
     testAllGetBehavesEqual(g_ipFullData, true);
@@ -347,3 +380,120 @@ TEST_F(LocatorTest, GetAsJson)
     expected.setBool(true);
     ASSERT_EQ(expected, base::getResponse<json::Json>(res));
 }
+
+/************************************************************
+ * Test the lookup of a set of fields
+ ************************************************************/
+namespace
+{
+std::shared_ptr<const Fields> getTestFields()
+{
+    auto fields = std::make_shared<Fields>();
+    fields->add("test_map.test_str1", Fields::Type::STRING);
+    fields->add("test_uint32", Fields::Type::UINT32);
+    fields->add("test_double", Fields::Type::DOUBLE);
+    fields->add("test_map.test_str1", Fields::Type::DOUBLE); // Wrong type
+    fields->add("not_found", Fields::Type::STRING);
+    return fields;
+}
+} // namespace
+
+TEST_F(LocatorTest, GetFields)
+{
+    auto fields = getTestFields();
+    decltype(locator->getFields({}, {})) res;
+    ASSERT_NO_THROW(res = locator->getFields(g_ipFullData, fields));
+    ASSERT_FALSE(base::isError(res));
+
+    const auto& values = *base::getResponse(res);
+    ASSERT_EQ(values.size(), fields->size());
+    ASSERT_EQ(std::get<std::string>(values[0]), "Wazuh");
+    ASSERT_EQ(std::get<uint32_t>(values[1]), 94043);
+    ASSERT_DOUBLE_EQ(std::get<double>(values[2]), 37.386);
+    ASSERT_TRUE(std::holds_alternative<std::monostate>(values[3]));
+    ASSERT_TRUE(std::holds_alternative<std::monostate>(values[4]));
+}
+
+TEST_F(LocatorTest, GetFieldsSingleWalk)
+{
+    // Fields sharing the path, array items and paths through values that are not maps
+    auto fields = std::make_shared<Fields>();
+    fields->add("test_array.1", Fields::Type::STRING);
+    fields->add("test_map.test_str2", Fields::Type::STRING);
+    fields->add("test_map.test_str1", Fields::Type::STRING);
+    fields->add("test_array.3", Fields::Type::STRING);
+    fields->add("test_uint32.inner", Fields::Type::UINT32);
+    fields->add("test_map.test_str1", Fields::Type::STRING);
+
+    auto res = locator->getFields(g_ipFullData, fields);
+    ASSERT_FALSE(base::isError(res));
+
+    const auto& values = *base::getResponse(res);
+    ASSERT_EQ(std::get<std::string>(values[0]), "b");
+    ASSERT_EQ(std::get<std::string>(values[1]), "Wazuh2");
+    ASSERT_EQ(std::get<std::string>(values[2]), "Wazuh");
+    ASSERT_TRUE(std::holds_alternative<std::monostate>(values[3]));
+    ASSERT_TRUE(std::holds_alternative<std::monostate>(values[4]));
+    ASSERT_EQ(std::get<std::string>(values[5]), "Wazuh");
+}
+
+TEST_F(LocatorTest, GetFieldsNotFound)
+{
+    auto fields = getTestFields();
+    ASSERT_TRUE(base::isError(locator->getFields(g_ipNotFound, fields)));
+    ASSERT_EQ(locator->getCachedValuesSize(), 1);
+
+    // Cached not found
+    ASSERT_TRUE(base::isError(locator->getFields(g_ipNotFound, fields)));
+    ASSERT_EQ(locator->getCachedValuesSize(), 1);
+}
+
+TEST_F(LocatorTest, GetFieldsInvalidIp)
+{
+    auto fields = getTestFields();
+    ASSERT_TRUE(base::isError(locator->getFields("1.2.3.256", fields)));
+    ASSERT_EQ(locator->getCachedValuesSize(), 0);
+}
+
+TEST_F(LocatorTest, GetFieldsRemovedFromManagerDb)
+{
+    auto fields = getTestFields();
+    ASSERT_FALSE(base::isError(locator->getFields(g_ipFullData, fields)));
+
+    removeDbs();
+    ASSERT_TRUE(base::isError(locator->getFields(g_ipFullData, fields)));
+}
+
+TEST_F(LocatorTest, GetFieldsCached)
+{
+    auto fields = getTestFields();
+    auto first = locator->getFields(g_ipFullData, fields);
+    ASSERT_FALSE(base::isError(first));
+
+    // Lookup of another IP in between, the values of the first one are still cached
+    ASSERT_FALSE(base::isError(locator->getFields(g_ipFullData2, fields)));
+    ASSERT_EQ(locator->getCachedValuesSize(), 2);
+
+    auto second = locator->getFields(g_ipFullData, fields);
+    ASSERT_FALSE(base::isError(second));
+    ASSERT_EQ(base::getResponse(first), base::getResponse(second));
+
+    // Other fields are looked up again, replacing the cached values of the IP
+    auto otherFields = getTestFields();
+    auto third = locator->getFields(g_ipFullData, otherFields);
+    ASSERT_FALSE(base::isError(third));
+    ASSERT_NE(base::getResponse(first), base::getResponse(third));
+    ASSERT_EQ(*base::getResponse(first), *base::getResponse(third));
+    ASSERT_EQ(locator->getCachedValuesSize(), 2);
+}
+
+TEST_F(LocatorTest, GetFieldsCacheEvicts)
+{
+    auto fields = getTestFields();
+    for (std::size_t i = 0; i < DEFAULT_LOCATOR_CACHE_SIZE + 1; ++i)
+    {
+        const auto ip = fmt::format("10.{}.{}.1", i / 256, i % 256);
+        ASSERT_TRUE(base::isError(locator->getFields(ip, fields)));
+    }
+    ASSERT_EQ(locator->getCachedValuesSize(), DEFAULT_LOCATOR_CACHE_SIZE);
+}
@@ -123,6 +123,17 @@ protected:
         return content;
     }
 
+    // Action of the downloadFile mock that stores the database content
+    static auto downloadContent(const std::string& content)
+    {
+        return [content](const std::string&, const std::string& path, const std::string&) -> base::OptError
+        {
+            std::ofstream ofs(path, std::ios::binary);
+            ofs.write(content.c_str(), content.size());
+            return base::noError();
+        };
+    }
+
     auto getEmptyManager()
     {
         EXPECT_CALL(*mockStore, readInternalCol(base::Name(INTERNAL_NAME)))
@@ -416,9 +427,8 @@ TEST_F(GeoManagerTest, RemoteUpsertDb)
     auto internalName = base::Name(INTERNAL_NAME) + base::Name(std::filesystem::path(dbFile).filename().string());
 
     EXPECT_CALL(*mockDownloader, downloadMD5(hashUrl)).WillOnce(testing::Return(base::RespOrError<std::string>(hash)));
-    EXPECT_CALL(*mockDownloader, downloadHTTPS(dbUrl))
-        .WillOnce(testing::Return(base::RespOrError<std::string>(content)));
-    EXPECT_CALL(*mockDownloader, computeMD5(content)).WillOnce(testing::Return(hash)).WillOnce(testing::Return(hash));
+    EXPECT_CALL(*mockDownloader, downloadFile(dbUrl, dbPath + ".tmp", hash))
+        .WillOnce(testing::Invoke(downloadContent(content)));
     EXPECT_CALL(*mockStore, upsertInternalDoc(internalName, testing::_)).WillOnce(testing::Return(storeOk()));
 
     base::OptError error;
@@ -456,6 +466,43 @@ TEST_F(GeoManagerTest, RemoteUpsertDbAlreadeyUpdated)
     ASSERT_EQ(manager.listDbs()[0].type, dbType);
 }
 
+TEST_F(GeoManagerTest, RemoteUpsertDbSwap)
+{
+    auto dbFile = getTmpDb();
+    auto dbPath = std::filesystem::path(dbFile).string();
+    auto dbType = Type::ASN;
+    auto hash = "newHash";
+    auto dbUrl = "dbUrl";
+    auto hashUrl = "hashUrl";
+    auto content = getContentDb(dbFile);
+    auto dbDoc = json::Json();
+    dbDoc.setString(dbPath, PATH_PATH);
+    dbDoc.setString(typeName(dbType), TYPE_PATH);
+    dbDoc.setString("hash", HASH_PATH);
+    auto internalName = base::Name(INTERNAL_NAME) + base::Name(std::filesystem::path(dbFile).filename().string());
+
+    auto manager = getManagerWithDb(dbPath, dbType);
+    auto locator = base::getResponse(manager.getLocator(dbType));
+    ASSERT_FALSE(base::isError(locator->getString("1.2.3.4", "test_map.test_str1")));
+
+    EXPECT_CALL(*mockDownloader, downloadMD5(hashUrl)).WillOnce(testing::Return(base::RespOrError<std::string>(hash)));
+    EXPECT_CALL(*mockStore, readInternalDoc(internalName)).WillOnce(testing::Return(storeReadDocResp(dbDoc)));
+    EXPECT_CALL(*mockDownloader, downloadFile(dbUrl, dbPath + ".tmp", hash))
+        .WillOnce(testing::Invoke(downloadContent(content)));
+    EXPECT_CALL(*mockStore, upsertInternalDoc(internalName, testing::_)).WillOnce(testing::Return(storeOk()));
+
+    base::OptError error;
+    ASSERT_NO_THROW(error = manager.remoteUpsertDb(dbPath, dbType, dbUrl, hashUrl));
+    ASSERT_FALSE(base::isError(error));
+    ASSERT_EQ(manager.listDbs().size(), 1);
+    ASSERT_FALSE(std::filesystem::exists(dbPath + ".tmp"));
+
+    // The locator moves to the new database
+    auto res = locator->getString("1.2.3.4", "test_map.test_str1");
+    ASSERT_FALSE(base::isError(res));
+    ASSERT_EQ(base::getResponse(res), "Wazuh");
+}
+
 TEST_F(GeoManagerTest, RemoteUpsertDbErrorTypeUsed)
 {
     auto dbFile = getTmpDb();
@@ -495,10 +542,9 @@ TEST_F(GeoManagerTest, RemoteUpsertDbFailOneDownload)
     auto internalName = base::Name(INTERNAL_NAME) + base::Name(std::filesystem::path(dbFile).filename().string());
 
     EXPECT_CALL(*mockDownloader, downloadMD5(hashUrl)).WillOnce(testing::Return(base::RespOrError<std::string>(hash)));
-    EXPECT_CALL(*mockDownloader, downloadHTTPS(dbUrl))
+    EXPECT_CALL(*mockDownloader, downloadFile(dbUrl, dbPath + ".tmp", hash))
         .WillOnce(testing::Return(base::Error {"error"}))
-        .WillOnce(testing::Return(base::RespOrError<std::string>(content)));
-    EXPECT_CALL(*mockDownloader, computeMD5(content)).WillOnce(testing::Return(hash)).WillOnce(testing::Return(hash));
+        .WillOnce(testing::Invoke(downloadContent(content)));
     EXPECT_CALL(*mockStore, upsertInternalDoc(internalName, testing::_)).WillOnce(testing::Return(storeOk()));
 
     base::OptError error;
@@ -523,13 +569,9 @@ TEST_F(GeoManagerTest, RemoteUpsertDbFailOneHash)
     auto internalName = base::Name(INTERNAL_NAME) + base::Name(std::filesystem::path(dbFile).filename().string());
 
     EXPECT_CALL(*mockDownloader, downloadMD5(hashUrl)).WillOnce(testing::Return(base::RespOrError<std::string>(hash)));
-    EXPECT_CALL(*mockDownloader, downloadHTTPS(dbUrl))
-        .WillOnce(testing::Return(base::RespOrError<std::string>(content)))
-        .WillOnce(testing::Return(base::RespOrError<std::string>(content)));
-    EXPECT_CALL(*mockDownloader, computeMD5(content))
-        .WillOnce(testing::Return("other_hash"))
-        .WillOnce(testing::Return(hash))
-        .WillOnce(testing::Return(hash));
+    EXPECT_CALL(*mockDownloader, downloadFile(dbUrl, dbPath + ".tmp", hash))
+        .WillOnce(testing::Return(base::Error {"Hash mismatch"}))
+        .WillOnce(testing::Invoke(downloadContent(content)));
     EXPECT_CALL(*mockStore, upsertInternalDoc(internalName, testing::_)).WillOnce(testing::Return(storeOk()));
 
     base::OptError error;
@@ -540,23 +582,39 @@ TEST_F(GeoManagerTest, RemoteUpsertDbFailOneHash)
     ASSERT_EQ(manager.listDbs()[0].type, dbType);
 }
 
-TEST_F(GeoManagerTest, RemoteUpsertDbErrorWriting)
+TEST_F(GeoManagerTest, RemoteUpsertDbFailAllDownloads)
 {
     auto manager = getEmptyManager();
 
     auto dbFile = getTmpDb();
+    auto dbType = Type::ASN;
+    auto dbPath = std::filesystem::path(dbFile).string();
+    auto hash = "hash";
+    auto dbUrl = "dbUrl";
+    auto hashUrl = "hashUrl";
+
+    EXPECT_CALL(*mockDownloader, downloadMD5(hashUrl)).WillOnce(testing::Return(base::RespOrError<std::string>(hash)));
+    EXPECT_CALL(*mockDownloader, downloadFile(dbUrl, dbPath + ".tmp", hash))
+        .Times(MAX_RETRIES)
+        .WillRepeatedly(testing::Return(base::Error {"error"}));
+
+    base::OptError error;
+    ASSERT_NO_THROW(error = manager.remoteUpsertDb(dbPath, dbType, dbUrl, hashUrl));
+    ASSERT_TRUE(base::isError(error));
+    ASSERT_EQ(manager.listDbs().size(), 0);
+}
+
+TEST_F(GeoManagerTest, RemoteUpsertDbErrorWriting)
+{
+    auto manager = getEmptyManager();
+
     auto dbType = Type::ASN;
     auto dbPath = "non_existent_file";
     auto hash = "hash";
     auto dbUrl = "dbUrl";
     auto hashUrl = "hashUrl";
-    auto content = getContentDb(dbFile);
-    auto internalName = base::Name(INTERNAL_NAME) + base::Name(std::filesystem::path(dbFile).filename().string());
 
     EXPECT_CALL(*mockDownloader, downloadMD5(hashUrl)).WillOnce(testing::Return(base::RespOrError<std::string>(hash)));
-    EXPECT_CALL(*mockDownloader, downloadHTTPS(dbUrl))
-        .WillOnce(testing::Return(base::RespOrError<std::string>(content)));
-    EXPECT_CALL(*mockDownloader, computeMD5(content)).WillOnce(testing::Return(hash));
 
     base::OptError error;
     ASSERT_NO_THROW(error = manager.remoteUpsertDb(dbPath, dbType, dbUrl, hashUrl));
@@ -578,9 +636,8 @@ TEST_F(GeoManagerTest, RemoteUpsertDbFailInternalStore)
     auto internalName = base::Name(INTERNAL_NAME) + base::Name(std::filesystem::path(dbFile).filename().string());
 
     EXPECT_CALL(*mockDownloader, downloadMD5(hashUrl)).WillOnce(testing::Return(base::RespOrError<std::string>(hash)));
-    EXPECT_CALL(*mockDownloader, downloadHTTPS(dbUrl))
-        .WillOnce(testing::Return(base::RespOrError<std::string>(content)));
-    EXPECT_CALL(*mockDownloader, computeMD5(content)).WillOnce(testing::Return(hash)).WillOnce(testing::Return(hash));
+    EXPECT_CALL(*mockDownloader, downloadFile(dbUrl, dbPath + ".tmp", hash))
+        .WillOnce(testing::Invoke(downloadContent(content)));
     EXPECT_CALL(*mockStore, upsertInternalDoc(internalName, testing::_)).WillOnce(testing::Return(storeError()));
 
     base::OptError error;
@@ -213,12 +213,13 @@ Parser getFilePathParser(const Params& params);
  * Returns a parser that consumes the input while
  * it is a valid JSON string.
  *
- * The parsing is done using rapidJSON doc parser.
+ * The parsing is done using rapidJSON doc parser. If paths are given only the values at those paths are loaded and
+ * mapped under the target field, the rest of the document is only validated.
  *
  * @param params.name name of the parser
  * @param params.targetField: field to store the parsed value, if not present, the value is ignored
  * @param params.stop List of end tokens
- * @param params.options list of field names
+ * @param params.options paths of the document to map, in dot notation, all the document if empty (optional)
  */
 Parser getJSONParser(const Params& params);
 
@@ -226,12 +227,14 @@ Parser getJSONParser(const Params& params);
  * Returns a parser that consumes the input while
  * it is a valid XML string.
  *
- * The parsing is done using pugixml doc parser.
+ * The parsing is done using pugixml doc parser. If paths are given only the elements on those paths are converted
+ * and mapped under the target field.
  *
  * @param params.name name of the parser
  * @param params.targetField: field to store the parsed value, if not present, the value is ignored
  * @param params.stop List of end tokens
- * @param params.options list of field names
+ * @param params.options the module ("default" or "windows"), followed by the paths of the converted document to map,
+ * in dot notation (optional)
  * @return
  */
 Parser getXMLParser(const Params& params);
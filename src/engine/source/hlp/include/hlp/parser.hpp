@@ -32,10 +32,58 @@ inline Mapper noMapper()
     };
 }
 using SemParser = std::function<std::variant<Mapper, base::Error>(std::string_view)>;
+
+/**
+ * @brief Token produced by the syntax pass, the parsed text and the semantic parser that converts it.
+ *
+ * The parsers own their semantic parser and the token only points to it, so the syntax pass does not copy any closure
+ * for the alternatives that are discarded later. The semantic parsers that are built while parsing are moved into the
+ * token. A token that points to its parser's semantic parser is only valid while the parser is alive.
+ */
 struct SemToken
 {
-    std::string_view parsed;
-    SemParser semParser;
+    std::string_view parsed;    ///< Text consumed by the parser
+    const SemParser* semParser; ///< Semantic parser owned by the parser, null if the token owns it
+    SemParser ownSemParser;     ///< Semantic parser built while parsing (optional)
+
+    SemToken()
+        : parsed()
+        , semParser(nullptr)
+        , ownSemParser()
+    {
+    }
+
+    SemToken(std::string_view parsed, const SemParser* semParser)
+        : parsed(parsed)
+        , semParser(semParser)
+        , ownSemParser()
+    {
+    }
+
+    SemToken(std::string_view parsed, SemParser&& semParser)
+        : parsed(parsed)
+        , semParser(nullptr)
+        , ownSemParser(std::move(semParser))
+    {
+    }
+
+    /**
+     * @brief Runs the semantic parser on the parsed text.
+     *
+     * @return std::variant<Mapper, base::Error> The mapper of the token or the semantic error.
+     */
+    std::variant<Mapper, base::Error> semParse() const
+    {
+        if (semParser != nullptr)
+        {
+            return (*semParser)(parsed);
+        }
+        if (ownSemParser)
+        {
+            return ownSemParser(parsed);
+        }
+        return noMapper();
+    }
 };
 
 /**
@@ -56,31 +104,22 @@ using Result = abs::Result<ResultT>;
 using Parser = abs::Parser<ResultT>;
 
 /**
- * @brief Runs three steps of parsing: syntax, semantic and mapping. Returns an error if any of the steps fails at any
- * point.
+ * @brief Runs the semantic and mapping steps of parsing on a successful syntax result. The event is only modified if
+ * every semantic parser succeeds.
  *
- * @param parser Parser to run
- * @param text Text to parse
+ * @param synRes Successful result of the syntax step
  * @param event Event to map to
  * @return std::optional<base::Error>
  */
-inline std::optional<base::Error> run(const Parser& parser, std::string_view text, json::Json& event)
+inline std::optional<base::Error> map(const Result& synRes, json::Json& event)
 {
-    // Syntax parsing
-    auto synRes = parser(text);
-    if (synRes.failure())
-    {
-        const auto error = fmt::format("Parser {} failed at: {}", synRes.trace(), synRes.remaining());
-        return base::Error {error};
-    }
-
-    // Semantinc parsing
+    // Semantic parsing, only the tokens of the winning alternatives are left in the result
     std::vector<Mapper> mappers;
     auto semVisitor = [&mappers](const Result& result, auto& recurRef) -> std::optional<base::Error>
     {
         if (result.hasValue())
         {
-            auto res = result.value().semParser(result.value().parsed);
+            auto res = result.value().semParse();
             if (std::holds_alternative<base::Error>(res))
             {
                 return std::get<base::Error>(res);
@@ -116,6 +155,28 @@ inline std::optional<base::Error> run(const Parser& parser, std::string_view tex
     return std::nullopt;
 }
 
+/**
+ * @brief Runs three steps of parsing: syntax, semantic and mapping. Returns an error if any of the steps fails at any
+ * point.
+ *
+ * @param parser Parser to run
+ * @param text Text to parse
+ * @param event Event to map to
+ * @return std::optional<base::Error>
+ */
+inline std::optional<base::Error> run(const Parser& parser, std::string_view text, json::Json& event)
+{
+    // Syntax parsing
+    auto synRes = parser(text);
+    if (synRes.failure())
+    {
+        const auto error = fmt::format("Parser {} failed at: {}", synRes.trace(), synRes.remaining());
+        return base::Error {error};
+    }
+
+    return map(synRes, event);
+}
+
 /**
  * @brief Combinators used by HLP.
  *
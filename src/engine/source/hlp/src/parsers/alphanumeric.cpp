@@ -56,7 +56,7 @@ Parser getAlphanumericParser(const Params& params)
             return abs::makeFailure<ResultT>(synR.remaining(), name);
         }
 
-        return abs::makeSuccess(SemToken {syntax::parsed(synR, txt), semP}, synR.remaining());
+        return abs::makeSuccess(SemToken {syntax::parsed(synR, txt), &semP}, synR.remaining());
     };
 }
 } // namespace hlp::parsers
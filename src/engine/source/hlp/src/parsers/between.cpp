@@ -6,6 +6,7 @@
 #include <fmt/format.h>
 
 #include "hlp.hpp"
+#include "scan.hpp"
 #include "syntax.hpp"
 
 namespace
@@ -39,7 +40,7 @@ syntax::Parser getSynParser(const std::string& startToken, const std::string& en
             return abs::makeFailure<syntax::ResultT>(input, {});
         }
 
-        auto endPos = input.find(endToken, startToken.size());
+        auto endPos = scan::find(input, endToken, startToken.size());
         if (endPos == std::string_view::npos)
         {
             return abs::makeFailure<syntax::ResultT>(input, {});
@@ -82,7 +83,7 @@ Parser getBetweenParser(const Params& params)
             return abs::makeFailure<ResultT>(synR.remaining(), name);
         }
 
-        return abs::makeSuccess(SemToken {syntax::parsed(synR, txt), semP}, synR.remaining());
+        return abs::makeSuccess(SemToken {syntax::parsed(synR, txt), &semP}, synR.remaining());
     };
 }
 } // namespace hlp::parsers
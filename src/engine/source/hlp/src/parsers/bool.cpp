@@ -68,13 +68,13 @@ Parser getBoolParser(const Params& params)
         const auto trueSynR = trueSynP(txt);
         if (trueSynR.success())
         {
-            return abs::makeSuccess(SemToken {syntax::parsed(trueSynR, txt), trueSemP}, trueSynR.remaining());
+            return abs::makeSuccess(SemToken {syntax::parsed(trueSynR, txt), &trueSemP}, trueSynR.remaining());
         }
 
         const auto falseSynR = falseSynP(txt);
         if (falseSynR.success())
         {
-            return abs::makeSuccess(SemToken {syntax::parsed(falseSynR, txt), falseSemP}, falseSynR.remaining());
+            return abs::makeSuccess(SemToken {syntax::parsed(falseSynR, txt), &falseSemP}, falseSynR.remaining());
         }
 
         return abs::makeFailure<ResultT>(txt, name);
@@ -1,5 +1,10 @@
+#include <array>
+#include <cctype>
 #include <chrono>
+#include <cstdint>
+#include <limits>
 #include <locale>
+#include <optional>
 #include <stdexcept>
 #include <string>
 #include <string_view>
@@ -50,8 +55,9 @@ SemParser getSemParser(std::string_view targetField,
         auto tp = date::sys_days(ymd) + fds.tod.to_duration();
 
         // Format to strict_date_optional_time
+        static const std::locale outLocale("en_US.UTF-8");
         std::ostringstream out {};
-        out.imbue(std::locale("en_US.UTF-8"));
+        out.imbue(outLocale);
 
         // If we have timezone information, transform it to UTC
         // else, assume we have UTC.
@@ -88,6 +94,388 @@ SemParser getSemParser(std::string_view targetField,
     };
 }
 
+// Abbreviated month names of the en_US locale, packed in lower case
+constexpr uint32_t monthKey(char a, char b, char c)
+{
+    return (static_cast<uint32_t>(a | 0x20) << 16) | (static_cast<uint32_t>(b | 0x20) << 8)
+           | static_cast<uint32_t>(c | 0x20);
+}
+
+constexpr std::array<uint32_t, 12> MONTH_KEYS {monthKey('j', 'a', 'n'),
+                                              monthKey('f', 'e', 'b'),
+                                              monthKey('m', 'a', 'r'),
+                                              monthKey('a', 'p', 'r'),
+                                              monthKey('m', 'a', 'y'),
+                                              monthKey('j', 'u', 'n'),
+                                              monthKey('j', 'u', 'l'),
+                                              monthKey('a', 'u', 'g'),
+                                              monthKey('s', 'e', 'p'),
+                                              monthKey('o', 'c', 't'),
+                                              monthKey('n', 'o', 'v'),
+                                              monthKey('d', 'e', 'c')};
+
+/**
+ * @brief Fixed layout of a date format, parsed without date::parse.
+ *
+ * The format is compiled once, when the parser is built, into a sequence of fixed-width
+ * fields. Only the numeric fields, the abbreviated month names, the numeric offsets and the
+ * literals are supported, which covers SYSLOG, ISO8601, HTTPDATE and NGINX_ERROR among others.
+ *
+ * The layout only accepts the inputs that date::parse accepts with the same result. Anything
+ * else (full month names, single digit seconds or years, more than 9 decimals...) is not
+ * rejected but left to date::parse, so both parsers always agree.
+ */
+class DateLayout
+{
+private:
+    enum class Field : uint8_t
+    {
+        LITERAL,
+        SPACE,
+        MONTH_NAME,
+        MONTH,
+        DAY,
+        YEAR,
+        HOUR,
+        MINUTE,
+        SECOND,
+        OFFSET,
+        OFFSET_COLON
+    };
+
+    struct Step
+    {
+        Field field;
+        char literal;
+    };
+
+    std::vector<Step> m_steps;
+    bool m_hasYear {false};
+
+    static bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+    static bool isAlpha(char c) { return (c | 0x20) >= 'a' && (c | 0x20) <= 'z'; }
+
+    // Read between min and max digits, like date::parse does for the numeric fields
+    static bool readNumber(std::string_view text, std::size_t& pos, std::size_t min, std::size_t max, unsigned& value)
+    {
+        std::size_t count = 0;
+        value = 0;
+
+        while (count < max && pos < text.size() && isDigit(text[pos]))
+        {
+            value = value * 10 + static_cast<unsigned>(text[pos] - '0');
+            ++pos;
+            ++count;
+        }
+
+        return count >= min;
+    }
+
+    static bool readMonthName(std::string_view text, std::size_t& pos, unsigned& month)
+    {
+        if (text.size() - pos < 3 || !isAlpha(text[pos]) || !isAlpha(text[pos + 1]) || !isAlpha(text[pos + 2]))
+        {
+            return false;
+        }
+
+        auto key = monthKey(text[pos], text[pos + 1], text[pos + 2]);
+        pos += 3;
+
+        // A full month name is left to date::parse
+        if (pos < text.size() && isAlpha(text[pos]))
+        {
+            return false;
+        }
+
+        for (std::size_t i = 0; i < MONTH_KEYS.size(); ++i)
+        {
+            if (MONTH_KEYS[i] == key)
+            {
+                month = static_cast<unsigned>(i + 1);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // Two digits and up to 9 decimals, the precision of the parsed fields
+    static bool readSeconds(std::string_view text, std::size_t& pos, std::chrono::nanoseconds& seconds)
+    {
+        unsigned value = 0;
+        if (!readNumber(text, pos, 2, 2, value) || (pos < text.size() && isDigit(text[pos])))
+        {
+            return false;
+        }
+
+        seconds = std::chrono::seconds {value};
+
+        if (pos < text.size() && text[pos] == '.')
+        {
+            ++pos;
+            auto begin = pos;
+            unsigned fraction = 0;
+
+            if (!readNumber(text, pos, 1, 9, fraction) || (pos < text.size() && isDigit(text[pos])))
+            {
+                return false;
+            }
+
+            for (auto digits = pos - begin; digits < 9; ++digits)
+            {
+                fraction *= 10;
+            }
+
+            seconds += std::chrono::nanoseconds {fraction};
+        }
+
+        return value < 60;
+    }
+
+    static bool readOffset(std::string_view text, std::size_t& pos, bool colon, std::chrono::minutes& offset)
+    {
+        if (pos >= text.size() || (text[pos] != '+' && text[pos] != '-'))
+        {
+            return false;
+        }
+
+        auto negative = text[pos++] == '-';
+        unsigned hours = 0;
+        unsigned minutes = 0;
+
+        if (!readNumber(text, pos, 2, 2, hours))
+        {
+            return false;
+        }
+
+        if (colon)
+        {
+            if (pos >= text.size() || text[pos] != ':')
+            {
+                return false;
+            }
+            ++pos;
+        }
+
+        if (!readNumber(text, pos, 2, 2, minutes) || hours > 23 || minutes > 59)
+        {
+            return false;
+        }
+
+        offset = std::chrono::minutes {hours * 60 + minutes};
+        if (negative)
+        {
+            offset = -offset;
+        }
+
+        return true;
+    }
+
+public:
+    /**
+     * @brief Compile a date format into a fixed layout.
+     *
+     * @param format Format in date::parse syntax.
+     * @return The layout, or std::nullopt if the format has specifiers not supported by the layout.
+     */
+    static std::optional<DateLayout> compile(std::string_view format)
+    {
+        DateLayout layout;
+        unsigned seen = 0;
+
+        auto add = [&](Field field) -> bool
+        {
+            auto bit = 1u << static_cast<unsigned>(field);
+            if (field != Field::LITERAL && field != Field::SPACE && (seen & bit) != 0)
+            {
+                return false;
+            }
+
+            seen |= bit;
+            layout.m_steps.push_back({field, '\0'});
+            return true;
+        };
+
+        auto literal = [&](char c)
+        {
+            layout.m_steps.push_back({Field::LITERAL, c});
+        };
+
+        for (std::size_t i = 0; i < format.size(); ++i)
+        {
+            auto c = format[i];
+
+            if (c != '%')
+            {
+                if (std::isspace(static_cast<unsigned char>(c)))
+                {
+                    add(Field::SPACE);
+                }
+                else
+                {
+                    literal(c);
+                }
+                continue;
+            }
+
+            if (++i == format.size())
+            {
+                return std::nullopt;
+            }
+
+            bool ok = true;
+            switch (format[i])
+            {
+                case 'b':
+                case 'h': ok = add(Field::MONTH_NAME); break;
+                case 'm': ok = add(Field::MONTH); break;
+                case 'd':
+                case 'e': ok = add(Field::DAY); break;
+                case 'Y': ok = add(Field::YEAR); break;
+                case 'H': ok = add(Field::HOUR); break;
+                case 'M': ok = add(Field::MINUTE); break;
+                case 'S': ok = add(Field::SECOND); break;
+                case 'z': ok = add(Field::OFFSET); break;
+                case '%': literal('%'); break;
+                case 'F':
+                    ok = add(Field::YEAR);
+                    literal('-');
+                    ok = ok && add(Field::MONTH);
+                    literal('-');
+                    ok = ok && add(Field::DAY);
+                    break;
+                case 'T':
+                case 'R':
+                    ok = add(Field::HOUR);
+                    literal(':');
+                    ok = ok && add(Field::MINUTE);
+                    if (format[i] == 'T')
+                    {
+                        literal(':');
+                        ok = ok && add(Field::SECOND);
+                    }
+                    break;
+                case 'E':
+                    ok = i + 1 < format.size() && format[++i] == 'z' && add(Field::OFFSET_COLON);
+                    break;
+                default: ok = false;
+            }
+
+            if (!ok)
+            {
+                return std::nullopt;
+            }
+        }
+
+        auto has = [&](Field field)
+        {
+            return (seen & (1u << static_cast<unsigned>(field))) != 0;
+        };
+
+        // Without a month and a day, the fields filled by date::parse can't be reproduced
+        if (!(has(Field::MONTH) || has(Field::MONTH_NAME)) || !has(Field::DAY)
+            || (has(Field::MONTH) && has(Field::MONTH_NAME)) || (has(Field::OFFSET) && has(Field::OFFSET_COLON)))
+        {
+            return std::nullopt;
+        }
+
+        layout.m_hasYear = has(Field::YEAR);
+        return layout;
+    }
+
+    /**
+     * @brief Parse a date with the layout.
+     *
+     * @param text Input text.
+     * @param fds Parsed fields, as date::parse fills them.
+     * @param offset Parsed UTC offset, 0 if the layout has none.
+     * @param pos Number of characters consumed.
+     * @return false if the input must be parsed by date::parse, which is not a failure.
+     */
+    bool parse(std::string_view text,
+               date::fields<std::chrono::nanoseconds>& fds,
+               std::chrono::minutes& offset,
+               std::size_t& pos) const
+    {
+        unsigned year = 0;
+        unsigned month = 0;
+        unsigned day = 0;
+        unsigned hours = 0;
+        unsigned minutes = 0;
+        std::chrono::nanoseconds seconds {0};
+        bool hasTime = false;
+        bool ok = true;
+
+        pos = 0;
+        for (const auto& step : m_steps)
+        {
+            switch (step.field)
+            {
+                case Field::LITERAL:
+                    ok = pos < text.size() && text[pos] == step.literal;
+                    ++pos;
+                    break;
+                case Field::SPACE:
+                    while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos])))
+                    {
+                        ++pos;
+                    }
+                    break;
+                case Field::MONTH_NAME: ok = readMonthName(text, pos, month); break;
+                case Field::MONTH: ok = readNumber(text, pos, 1, 2, month); break;
+                case Field::DAY: ok = readNumber(text, pos, 1, 2, day); break;
+                case Field::YEAR: ok = readNumber(text, pos, 4, 4, year); break;
+                case Field::HOUR:
+                    ok = readNumber(text, pos, 1, 2, hours) && hours < 24;
+                    hasTime = true;
+                    break;
+                case Field::MINUTE:
+                    ok = readNumber(text, pos, 1, 2, minutes) && minutes < 60;
+                    hasTime = true;
+                    break;
+                case Field::SECOND:
+                    ok = readSeconds(text, pos, seconds);
+                    hasTime = true;
+                    break;
+                case Field::OFFSET: ok = readOffset(text, pos, false, offset); break;
+                case Field::OFFSET_COLON: ok = readOffset(text, pos, true, offset); break;
+            }
+
+            if (!ok)
+            {
+                return false;
+            }
+        }
+
+        auto md = date::month {month} / date::day {day};
+        if (!md.ok())
+        {
+            return false;
+        }
+
+        if (m_hasYear)
+        {
+            fds.ymd = date::year {static_cast<int>(year)} / md;
+            if (!fds.ymd.ok())
+            {
+                return false;
+            }
+        }
+        else
+        {
+            // Not a year, as date::parse leaves it
+            fds.ymd = date::year {std::numeric_limits<short>::min()} / md;
+        }
+
+        fds.tod = date::hh_mm_ss<std::chrono::nanoseconds> {std::chrono::hours {hours} + std::chrono::minutes {minutes}
+                                                            + seconds};
+        fds.has_tod = hasTime;
+
+        return true;
+    }
+};
+
 /**
  * Supported formats, this will be injected by the config module in due time
  */
@@ -271,8 +659,29 @@ Parser getDateParser(const Params& params)
 
     const auto target = params.targetField.empty() ? std::string {} : params.targetField;
 
-    return [format, locale, name = params.name, target](std::string_view text)
+    // The month names of the layout are the english ones
+    std::optional<DateLayout> layout {};
+    if (localeStr == "en_US.UTF-8")
     {
+        layout = DateLayout::compile(format);
+    }
+
+    return [format, locale, layout, name = params.name, target](std::string_view text)
+    {
+        if (layout)
+        {
+            date::fields<std::chrono::nanoseconds> fds {};
+            std::chrono::minutes offset {0};
+            std::size_t pos = 0;
+
+            if (layout->parse(text, fds, offset, pos))
+            {
+                return abs::makeSuccess(
+                    SemToken {text.substr(0, pos), getSemParser(target, fds, std::string {}, name, offset)},
+                    text.substr(pos));
+            }
+        }
+
         auto ss = std::istringstream(std::string(text));
         ss.imbue(locale);
 
@@ -118,7 +118,7 @@ inline Parser dsvParserFunction(std::string name,
         {
             semP = getSemParser(std::move(doc), target);
         }
-        return abs::makeSuccess<ResultT>(SemToken {parsed, semP}, synR.remaining());
+        return abs::makeSuccess<ResultT>(SemToken {parsed, std::move(semP)}, synR.remaining());
     };
 }
 } // namespace
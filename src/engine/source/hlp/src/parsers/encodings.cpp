@@ -120,7 +120,7 @@ Parser getBinaryParser(const Params& params)
             return abs::makeFailure<ResultT>(synR.remaining(), name);
         }
 
-        return abs::makeSuccess(SemToken {syntax::parsed(synR, txt), semP}, synR.remaining());
+        return abs::makeSuccess(SemToken {syntax::parsed(synR, txt), &semP}, synR.remaining());
     };
 }
 } // namespace hlp::parsers
@@ -14,7 +14,7 @@ Parser getEofParser(const Params& params)
     {
         if (txt.empty())
         {
-            return abs::makeSuccess<ResultT>(SemToken {txt, semP}, txt);
+            return abs::makeSuccess<ResultT>(SemToken {txt, &semP}, txt);
         }
         else
         {
@@ -97,7 +97,7 @@ Parser getFilePathParser(const Params& params)
         }
 
         const auto parsed = syntax::parsed(synR, txt);
-        return abs::makeSuccess<ResultT>(SemToken {parsed, semP}, synR.remaining());
+        return abs::makeSuccess<ResultT>(SemToken {parsed, &semP}, synR.remaining());
     };
 }
 
@@ -41,7 +41,7 @@ Parser getIgnoreParser(const Params& params)
             return abs::makeFailure<ResultT>(synR.remaining(), name);
         }
 
-        return abs::makeSuccess(SemToken {syntax::parsed(synR, txt), semP}, synR.remaining());
+        return abs::makeSuccess(SemToken {syntax::parsed(synR, txt), &semP}, synR.remaining());
     };
 }
 } // namespace hlp::parsers
@@ -6,6 +6,8 @@
 #include <arpa/inet.h>
 #include <fmt/format.h>
 
+#include <utils/ipUtils.hpp>
+
 #include "hlp.hpp"
 #include "syntax.hpp"
 
@@ -26,13 +28,33 @@ SemParser getSemParser(const std::string& targetField)
 {
     return [targetField](std::string_view parsed) -> std::variant<Mapper, base::Error>
     {
-        struct in_addr ip;
-        struct in6_addr ip6;
-
-        if (!inet_pton(AF_INET, std::string(parsed).c_str(), &ip)
-            && !inet_pton(AF_INET6, std::string(parsed).c_str(), &ip6))
+        // The syntax parser only accepts colons in IPv6 addresses
+        if (parsed.find(':') == std::string_view::npos)
         {
-            return base::Error {"Invalid IPv4 or IPv6 address"};
+            uint32_t ip {};
+            if (!utils::ip::parseIPv4(parsed, ip))
+            {
+                return base::Error {"Invalid IPv4 or IPv6 address"};
+            }
+        }
+        else
+        {
+            // Longest syntax match: 7 groups of 4 hex digits and an IPv4 address
+            char buffer[64];
+            struct in6_addr ip6;
+
+            if (parsed.size() >= sizeof(buffer))
+            {
+                return base::Error {"Invalid IPv4 or IPv6 address"};
+            }
+
+            parsed.copy(buffer, parsed.size());
+            buffer[parsed.size()] = '\0';
+
+            if (inet_pton(AF_INET6, buffer, &ip6) != 1)
+            {
+                return base::Error {"Invalid IPv4 or IPv6 address"};
+            }
         }
 
         if (targetField.empty())
@@ -44,26 +66,113 @@ SemParser getSemParser(const std::string& targetField)
     };
 }
 
-syntax::Parser getSynParser()
+bool isDigit(char c)
 {
-    using namespace syntax::combinators;
+    return static_cast<unsigned>(c - '0') <= 9;
+}
 
-    // IPv4
-    auto digits = times(syntax::parsers::digit(), 1, 3);
-    auto dot = syntax::parsers::char_('.');
-    auto part = digits & dot;
-    auto ipv4 = repeat(part, 3) & digits;
+bool isHex(char c)
+{
+    return isDigit(c) || static_cast<unsigned>((c | 0x20) - 'a') <= 5;
+}
 
-    // IPv6
-    auto hexes = times(syntax::parsers::hex(), 0, 4);
-    auto colon = syntax::parsers::char_(':');
-    auto part6 = hexes & colon;
-    auto ipv6 = times(part6, 2, 7) & hexes;
+/**
+ * @brief Scan up to max characters of a class, returning how many were found.
+ */
+template<bool (*Accept)(char)>
+std::size_t scanClass(std::string_view text, std::size_t pos, std::size_t max)
+{
+    std::size_t count = 0;
+    while (count < max && pos + count < text.size() && Accept(text[pos + count]))
+    {
+        ++count;
+    }
+    return count;
+}
 
-    // Mixed
-    auto mixed = times(part6, 2, 6) & ipv4;
+/**
+ * @brief Scan an IPv4 address: four groups of 1 to 3 digits separated by dots.
+ *
+ * @return std::size_t Length of the address, 0 if there is none.
+ */
+std::size_t scanIPv4(std::string_view text, std::size_t pos)
+{
+    const auto begin = pos;
+    for (auto part = 0; part < 4; ++part)
+    {
+        auto digits = scanClass<isDigit>(text, pos, 3);
+        if (digits == 0)
+        {
+            return 0;
+        }
+        pos += digits;
+
+        if (part < 3)
+        {
+            if (pos >= text.size() || text[pos] != '.')
+            {
+                return 0;
+            }
+            ++pos;
+        }
+    }
 
-    return ipv4 | mixed | ipv6;
+    return pos - begin;
+}
+
+/**
+ * @brief Scan up to max IPv6 groups: 0 to 4 hex digits followed by a colon.
+ *
+ * @return std::pair<std::size_t, std::size_t> Number of groups and their length.
+ */
+std::pair<std::size_t, std::size_t> scanIPv6Groups(std::string_view text, std::size_t max)
+{
+    std::size_t groups = 0;
+    std::size_t pos = 0;
+
+    while (groups < max)
+    {
+        auto hexes = scanClass<isHex>(text, pos, 4);
+        if (pos + hexes >= text.size() || text[pos + hexes] != ':')
+        {
+            break;
+        }
+
+        pos += hexes + 1;
+        ++groups;
+    }
+
+    return {groups, pos};
+}
+
+/**
+ * @brief Length of the address at the beginning of the text, 0 if there is none.
+ *
+ * Same grammar as the combinators: ipv4 | mixed | ipv6, where
+ * ipv4 = (digit{1,3} '.'){3} digit{1,3}, mixed = (hex{0,4} ':'){2,6} ipv4 and ipv6 = (hex{0,4} ':'){2,7} hex{0,4}.
+ * The groups are scanned greedily, without backtracking, as the combinators do.
+ */
+std::size_t scanIP(std::string_view text)
+{
+    if (auto length = scanIPv4(text, 0); length != 0)
+    {
+        return length;
+    }
+
+    if (auto [groups, pos] = scanIPv6Groups(text, 6); groups >= 2)
+    {
+        if (auto length = scanIPv4(text, pos); length != 0)
+        {
+            return pos + length;
+        }
+    }
+
+    if (auto [groups, pos] = scanIPv6Groups(text, 7); groups >= 2)
+    {
+        return pos + scanClass<isHex>(text, pos, 4);
+    }
+
+    return 0;
 }
 
 } // namespace
@@ -77,23 +186,18 @@ Parser getIPParser(const Params& params)
         throw std::runtime_error("The IP parser does not accept any argument");
     }
 
-    syntax::Parser synP = getSynParser();
-
     auto target = params.targetField.empty() ? "" : params.targetField;
     auto semP = getSemParser(target);
 
-    return [name = params.name, synP, semP](std::string_view txt)
+    return [name = params.name, semP](std::string_view txt)
     {
-        auto synR = synP(txt);
-        if (synR.failure())
-        {
-            return abs::makeFailure<ResultT>(synR.remaining(), name);
-        }
-        else
+        auto length = scanIP(txt);
+        if (length == 0)
         {
-            auto parsed = syntax::parsed(synR, txt);
-            return abs::makeSuccess(SemToken {parsed, semP}, synR.remaining());
+            return abs::makeFailure<ResultT>(txt, name);
         }
+
+        return abs::makeSuccess(SemToken {txt.substr(0, length), &semP}, txt.substr(length));
     };
 }
 } // namespace hlp::parsers
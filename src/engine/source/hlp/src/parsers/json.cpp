@@ -1,10 +1,17 @@
+#include <algorithm>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 #include <fmt/format.h>
 #include <rapidjson/document.h>
+#include <rapidjson/encodedstream.h>
+#include <rapidjson/memorystream.h>
+#include <rapidjson/reader.h>
 #include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
 
 #include "hlp.hpp"
 #include "syntax.hpp"
@@ -14,6 +21,209 @@ namespace
 using namespace hlp;
 using namespace hlp::parser;
 
+using InputStream = rapidjson::EncodedInputStream<rapidjson::UTF8<>, rapidjson::MemoryStream>;
+using Values = std::vector<std::pair<std::string, json::Json>>;
+
+/**
+ * @brief SAX handler that only materializes the values found at some paths of the document.
+ *
+ * The whole document is read, to validate it, but the events are only written for the selected values, which are
+ * then loaded one by one.
+ */
+class PathFilter
+{
+private:
+    struct Frame
+    {
+        bool isArray;         ///< The container is an array
+        std::size_t index;    ///< Index of the next element of an array
+        std::size_t pathSize; ///< Size of the path of the container
+    };
+
+    const std::vector<std::string>& m_paths; ///< Selected paths, as JSON pointers
+    std::vector<Frame> m_frames;             ///< Containers from the root to the current value
+    std::string m_path;                      ///< Path of the current value
+    bool m_capturing;                        ///< A selected value is being written
+    std::size_t m_captureDepth;              ///< Depth of the selected value
+    std::string m_capturePath;               ///< Path of the selected value
+    rapidjson::StringBuffer m_buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> m_writer;
+    Values m_values; ///< Selected values found, by path
+
+    void beginValue()
+    {
+        if (!m_frames.empty() && m_frames.back().isArray)
+        {
+            m_path.resize(m_frames.back().pathSize);
+            m_path.append("/").append(std::to_string(m_frames.back().index++));
+        }
+
+        if (!m_capturing && std::find(m_paths.begin(), m_paths.end(), m_path) != m_paths.end())
+        {
+            m_capturing = true;
+            m_captureDepth = m_frames.size();
+            m_capturePath = m_path;
+            m_buffer.Clear();
+            m_writer.Reset(m_buffer);
+        }
+    }
+
+    bool endValue()
+    {
+        if (m_capturing && m_frames.size() == m_captureDepth)
+        {
+            m_values.emplace_back(m_capturePath, json::Json(m_buffer.GetString()));
+            m_capturing = false;
+        }
+        return true;
+    }
+
+    template<typename Write>
+    bool scalar(Write&& write)
+    {
+        beginValue();
+        if (m_capturing)
+        {
+            write();
+        }
+        return endValue();
+    }
+
+    void startContainer(bool isArray)
+    {
+        m_frames.push_back({isArray, 0, m_path.size()});
+    }
+
+    void endContainer()
+    {
+        m_path.resize(m_frames.back().pathSize);
+        m_frames.pop_back();
+    }
+
+public:
+    explicit PathFilter(const std::vector<std::string>& paths)
+        : m_paths(paths)
+        , m_frames()
+        , m_path()
+        , m_capturing(false)
+        , m_captureDepth(0)
+        , m_capturePath()
+        , m_buffer()
+        , m_writer(m_buffer)
+        , m_values()
+    {
+    }
+
+    Values&& values() { return std::move(m_values); }
+
+    bool Null()
+    {
+        return scalar([this]() { m_writer.Null(); });
+    }
+    bool Bool(bool b)
+    {
+        return scalar([this, b]() { m_writer.Bool(b); });
+    }
+    bool Int(int i)
+    {
+        return scalar([this, i]() { m_writer.Int(i); });
+    }
+    bool Uint(unsigned i)
+    {
+        return scalar([this, i]() { m_writer.Uint(i); });
+    }
+    bool Int64(int64_t i)
+    {
+        return scalar([this, i]() { m_writer.Int64(i); });
+    }
+    bool Uint64(uint64_t i)
+    {
+        return scalar([this, i]() { m_writer.Uint64(i); });
+    }
+    bool Double(double d)
+    {
+        return scalar([this, d]() { m_writer.Double(d); });
+    }
+    bool RawNumber(const char* str, rapidjson::SizeType length, bool copy)
+    {
+        return scalar([&]() { m_writer.RawNumber(str, length, copy); });
+    }
+    bool String(const char* str, rapidjson::SizeType length, bool copy)
+    {
+        return scalar([&]() { m_writer.String(str, length, copy); });
+    }
+
+    bool StartObject()
+    {
+        beginValue();
+        if (m_capturing)
+        {
+            m_writer.StartObject();
+        }
+        startContainer(false);
+        return true;
+    }
+
+    bool Key(const char* str, rapidjson::SizeType length, bool copy)
+    {
+        // Keys are escaped as in a JSON pointer
+        m_path.resize(m_frames.back().pathSize);
+        m_path.push_back('/');
+        for (rapidjson::SizeType i = 0; i < length; ++i)
+        {
+            if (str[i] == '~')
+            {
+                m_path.append("~0");
+            }
+            else if (str[i] == '/')
+            {
+                m_path.append("~1");
+            }
+            else
+            {
+                m_path.push_back(str[i]);
+            }
+        }
+
+        if (m_capturing)
+        {
+            m_writer.Key(str, length, copy);
+        }
+        return true;
+    }
+
+    bool EndObject(rapidjson::SizeType count)
+    {
+        endContainer();
+        if (m_capturing)
+        {
+            m_writer.EndObject(count);
+        }
+        return endValue();
+    }
+
+    bool StartArray()
+    {
+        beginValue();
+        if (m_capturing)
+        {
+            m_writer.StartArray();
+        }
+        startContainer(true);
+        return true;
+    }
+
+    bool EndArray(rapidjson::SizeType count)
+    {
+        endContainer();
+        if (m_capturing)
+        {
+            m_writer.EndArray(count);
+        }
+        return endValue();
+    }
+};
+
 Mapper getMapper(const json::Json& parsed, std::string_view targetField)
 {
     return [parsed, targetField](json::Json& event)
@@ -22,11 +232,49 @@ Mapper getMapper(const json::Json& parsed, std::string_view targetField)
     };
 }
 
-SemParser getSemParser(std::string_view targetField, json::Json&& parsed)
+Mapper getMapper(Values&& values, const std::string& targetField)
 {
-    return [targetField, parsed = std::move(parsed)](std::string_view)
+    return [values = std::move(values), targetField](json::Json& event)
     {
-        return getMapper(parsed, targetField);
+        for (const auto& [path, value] : values)
+        {
+            event.set(targetField + path, value);
+        }
+    };
+}
+
+SemParser getSemParser(const std::string& targetField)
+{
+    return [targetField](std::string_view parsed) -> std::variant<Mapper, base::Error>
+    {
+        rapidjson::MemoryStream ms(parsed.data(), parsed.size());
+        InputStream is(ms);
+        rapidjson::Document doc;
+        doc.ParseStream(is);
+        if (doc.HasParseError())
+        {
+            return base::Error {"Invalid JSON"};
+        }
+
+        return getMapper(json::Json(std::move(doc)), targetField);
+    };
+}
+
+SemParser getSemParser(const std::string& targetField, const std::vector<std::string>& paths)
+{
+    return [targetField, paths](std::string_view parsed) -> std::variant<Mapper, base::Error>
+    {
+        rapidjson::Reader reader;
+        rapidjson::MemoryStream ms(parsed.data(), parsed.size());
+        InputStream is(ms);
+        PathFilter filter(paths);
+
+        if (reader.Parse(is, filter).IsError())
+        {
+            return base::Error {"Invalid JSON"};
+        }
+
+        return getMapper(filter.values(), targetField);
     };
 }
 
@@ -36,34 +284,42 @@ namespace hlp::parsers
 
 Parser getJSONParser(const Params& params)
 {
-    if (!params.options.empty())
+    // Lazy mode, only the values at the given paths are mapped
+    std::vector<std::string> paths;
+    for (const auto& option : params.options)
     {
-        throw std::runtime_error(fmt::format("JSON parser do not accept arguments!"));
+        if (option.empty())
+        {
+            throw std::runtime_error(fmt::format("JSON parser paths must not be empty"));
+        }
+        paths.emplace_back(json::Json::formatJsonPath(option));
     }
 
     const auto target = params.targetField.empty() ? "" : params.targetField;
+    const auto semP = target.empty()   ? noSemParser()
+                      : paths.empty() ? getSemParser(target)
+                                      : getSemParser(target, paths);
 
-    return [name = params.name, target](std::string_view txt)
+    return [name = params.name, semP](std::string_view txt)
     {
         if (txt.empty())
         {
             return abs::makeFailure<ResultT>(txt, name);
         }
 
+        // Only validate the syntax, the document is loaded by the semantic parser of the winning alternative
         rapidjson::Reader reader;
-        const auto ssInput = std::string(txt);
-        rapidjson::StringStream ss(ssInput.c_str());
-        rapidjson::Document doc;
+        rapidjson::MemoryStream ms(txt.data(), txt.size());
+        InputStream is(ms);
+        rapidjson::BaseReaderHandler<> handler;
 
-        doc.ParseStream<rapidjson::kParseStopWhenDoneFlag>(ss);
-        if (doc.HasParseError())
+        if (reader.Parse<rapidjson::kParseStopWhenDoneFlag>(is, handler).IsError())
         {
             return abs::makeFailure<ResultT>(txt, name);
         }
-        const auto parsed = txt.substr(0, ss.Tell());
-        const auto remaining = txt.substr(ss.Tell());
-        const auto semP = target.empty() ? noSemParser() : getSemParser(target, json::Json(std::move(doc)));
-        return abs::makeSuccess<ResultT>(SemToken {parsed, semP}, remaining);
+        const auto parsed = txt.substr(0, is.Tell());
+        const auto remaining = txt.substr(is.Tell());
+        return abs::makeSuccess<ResultT>(SemToken {parsed, &semP}, remaining);
     };
 }
 } // namespace hlp::parsers
@@ -135,7 +135,7 @@ Parser getKVParser(const Params& params)
             return abs::makeFailure<ResultT>(txt.substr(end), name);
         }
 
-        const auto semP = targetField.empty() ? noSemParser() : getSemParser(std::move(doc), targetField);
+        auto semP = targetField.empty() ? noSemParser() : getSemParser(std::move(doc), targetField);
         return abs::makeSuccess<ResultT>(SemToken {kvInput, std::move(semP)}, remaining);
     };
 }
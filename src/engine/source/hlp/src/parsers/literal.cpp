@@ -58,7 +58,7 @@ Parser getLiteralParser(const Params& params)
         }
         else
         {
-            return abs::makeSuccess(SemToken {syntax::parsed(synR, txt), semP}, synR.remaining());
+            return abs::makeSuccess(SemToken {syntax::parsed(synR, txt), &semP}, synR.remaining());
         }
     };
 }
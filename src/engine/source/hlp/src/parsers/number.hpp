@@ -65,24 +65,59 @@ SemParser getSemParser(const std::string& targetField)
     };
 }
 
+inline std::size_t scanDigits(std::string_view text, std::size_t pos)
+{
+    const auto begin = pos;
+    while (pos < text.size() && static_cast<unsigned>(text[pos] - '0') <= 9)
+    {
+        ++pos;
+    }
+    return pos - begin;
+}
+
+/**
+ * @brief Single pass scanner with the grammar of the combinators:
+ * opt('-') & many1(digit) & opt('.') & many(digit) [& opt(('e' | 'E') & opt('+' | '-') & many1(digit))]
+ */
 template<class T>
 syntax::Parser getSynParser()
 {
-    using namespace syntax::combinators;
-    using namespace syntax::parsers;
-
-    if constexpr (std::is_integral_v<T>)
+    return [](std::string_view text) -> syntax::Result
     {
+        std::size_t pos = (!text.empty() && text[0] == '-') ? 1 : 0;
+
+        auto digits = scanDigits(text, pos);
+        if (digits == 0)
+        {
+            return abs::makeFailure<syntax::ResultT>(text.substr(pos), {});
+        }
+        pos += digits;
+
+        if (pos < text.size() && text[pos] == '.')
+        {
+            pos += 1 + scanDigits(text, pos + 1);
+        }
+
         // For int types exclude the possibility of scientific notation
-        const auto synP = opt(char_('-')) & many1(digit()) & opt(char_('.')) & many(digit());
-        return synP;
-    }
-    else
-    {
-        const auto synP = opt(char_('-')) & many1(digit()) & opt(char_('.')) & many(digit())
-                          & opt((char_('e') | char_('E')) & opt(char_('+') | char_('-')) & many1(digit()));
-        return synP;
-    }
+        if constexpr (!std::is_integral_v<T>)
+        {
+            if (pos < text.size() && (text[pos] == 'e' || text[pos] == 'E'))
+            {
+                auto exponent = pos + 1;
+                if (exponent < text.size() && (text[exponent] == '+' || text[exponent] == '-'))
+                {
+                    ++exponent;
+                }
+
+                if (auto expDigits = scanDigits(text, exponent); expDigits != 0)
+                {
+                    pos = exponent + expDigits;
+                }
+            }
+        }
+
+        return abs::makeSuccess<syntax::ResultT>(text.substr(pos));
+    };
 }
 } // namespace
 
@@ -110,7 +145,7 @@ Parser getNumericParser(const Params& params)
         }
         else
         {
-            return abs::makeSuccess(SemToken {syntax::parsed(synR, text), semP}, synR.remaining());
+            return abs::makeSuccess(SemToken {syntax::parsed(synR, text), &semP}, synR.remaining());
         }
     };
 }
@@ -1,6 +1,7 @@
 #include "parse_field.hpp"
 #include "fmt/format.h"
 #include "number.hpp"
+#include "scan.hpp"
 #include <iostream>
 #include <json/json.hpp>
 #include <string_view>
@@ -25,7 +26,9 @@ std::optional<Field> getField(std::string_view input,
     bool isEscaped = false;
     bool isQuoted = false;
 
-    for (auto i = 0ul; i < input.size(); i++)
+    // Any other character leaves the state unchanged, jump between the special ones
+    const scan::CharSet special {std::string {delimiter, quote, escape}};
+    for (auto i = scan::findAny(input, special); i != std::string_view::npos; i = scan::findAny(input, special, i + 1))
     {
         if (input[i] == delimiter && !quote_opened)
         {
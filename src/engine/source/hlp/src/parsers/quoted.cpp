@@ -6,6 +6,7 @@
 #include <fmt/format.h>
 
 #include "hlp.hpp"
+#include "scan.hpp"
 #include "syntax.hpp"
 
 namespace
@@ -33,7 +34,7 @@ SemParser getSemParser(const std::string& targetField, char escape)
 
 syntax::Parser getSynParser(char quote, char escape)
 {
-    return [quote, escape](std::string_view input)
+    return [quote, escape, special = scan::CharSet(std::string {quote, escape})](std::string_view input)
     {
         if (input.empty())
         {
@@ -45,41 +46,30 @@ syntax::Parser getSynParser(char quote, char escape)
             return abs::makeFailure<syntax::ResultT>(input, {});
         }
 
-        bool checkEscape = false;
-        bool closed = false;
-        auto it = input.begin() + 1;
-        for (; it < input.end(); ++it)
+        // Only the quote and escape characters change the state, jump between them
+        auto pos = scan::findAny(input, special, 1);
+        while (pos != std::string_view::npos)
         {
-            if (checkEscape)
+            if (input[pos] == escape)
             {
-                if (*it != quote && *it != escape)
+                if (pos + 1 >= input.size())
+                {
+                    break;
+                }
+                if (input[pos + 1] != quote && input[pos + 1] != escape)
                 {
                     return abs::makeFailure<syntax::ResultT>(input, {});
                 }
-                checkEscape = false;
-                continue;
+                pos = scan::findAny(input, special, pos + 2);
             }
-            else if (*it == escape)
+            else
             {
-                checkEscape = true;
-                continue;
-            }
-            else if (*it == quote)
-            {
-                ++it;
-                closed = true;
-                break;
+                // Closing quote
+                return abs::makeSuccess<syntax::ResultT>(input.substr(pos + 1));
             }
         }
 
-        if (closed)
-        {
-            return abs::makeSuccess<syntax::ResultT>(input.substr(it - input.begin()));
-        }
-        else
-        {
-            return abs::makeFailure<syntax::ResultT>(input, {});
-        }
+        return abs::makeFailure<syntax::ResultT>(input, {});
     };
 }
 
@@ -134,7 +124,7 @@ Parser getQuotedParser(const Params& params)
         }
 
         const auto parsed = syntax::parsed(synR, txt);
-        return abs::makeSuccess<ResultT>(SemToken {parsed, semP}, synR.remaining());
+        return abs::makeSuccess<ResultT>(SemToken {parsed, &semP}, synR.remaining());
     };
 }
 } // namespace hlp::parsers
@@ -65,7 +65,7 @@ Parser getTextParser(const Params& params)
         }
         else
         {
-            return abs::makeSuccess(SemToken {syntax::parsed(synR, txt), semP}, synR.remaining());
+            return abs::makeSuccess(SemToken {syntax::parsed(synR, txt), &semP}, synR.remaining());
         }
     };
 }
@@ -201,7 +201,7 @@ Parser getUriParser(const Params& params)
 
         const auto parsed = syntax::parsed(synR, txt);
 
-        return abs::makeSuccess<ResultT>(SemToken {parsed, semP}, synR.remaining());
+        return abs::makeSuccess<ResultT>(SemToken {parsed, &semP}, synR.remaining());
     };
 }
 
@@ -230,7 +230,7 @@ Parser getUAParser(const Params& params)
         }
 
         const auto parsed = syntax::parsed(synR, txt);
-        return abs::makeSuccess<ResultT>(SemToken {parsed, semP}, synR.remaining());
+        return abs::makeSuccess<ResultT>(SemToken {parsed, &semP}, synR.remaining());
     };
 }
 
@@ -264,7 +264,7 @@ Parser getFQDNParser(const Params& params)
 
         const auto parsed = syntax::parsed(synR, fqdnInput);
 
-        return abs::makeSuccess<ResultT>(SemToken {parsed, semP}, remaining);
+        return abs::makeSuccess<ResultT>(SemToken {parsed, &semP}, remaining);
     };
 }
 
@@ -1,6 +1,9 @@
+#include <algorithm>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 #include <fmt/format.h>
 #include <pugixml.hpp>
@@ -51,7 +54,26 @@ std::unordered_map<std::string_view, xmlModule> xmlModules = {
     {"windows", xmlWinModule},
 };
 
-void xmlToJson(pugi::xml_node& docXml, json::Json& docJson, const xmlModule& mod, const std::string& path = "")
+/**
+ * @brief Check if a path leads to one of the selected paths or is inside one of them.
+ */
+bool onSelectedPath(const std::string& path, const std::vector<std::string>& selected)
+{
+    const auto isPrefix = [](std::string_view prefix, std::string_view path)
+    {
+        return path.substr(0, prefix.size()) == prefix && (path.size() == prefix.size() || path[prefix.size()] == '/');
+    };
+
+    return std::any_of(selected.begin(),
+                       selected.end(),
+                       [&](const auto& other) { return isPrefix(path, other) || isPrefix(other, path); });
+}
+
+void xmlToJson(pugi::xml_node& docXml,
+               json::Json& docJson,
+               const xmlModule& mod,
+               const std::string& path = "",
+               const std::vector<std::string>& selected = {})
 {
     // TODO: add array support
     // Iterate over the xml generating the corresponding json
@@ -78,6 +100,12 @@ void xmlToJson(pugi::xml_node& docXml, json::Json& docJson, const xmlModule& mod
         {
             localPath += "/" + std::string {node.name()};
 
+            // Lazy mode, skip the elements that are not needed by the selected paths
+            if (!selected.empty() && !onSelectedPath(localPath, selected))
+            {
+                continue;
+            }
+
             // Check if the element already exists
             if (docJson.exists(localPath))
             {
@@ -121,7 +149,7 @@ void xmlToJson(pugi::xml_node& docXml, json::Json& docJson, const xmlModule& mod
         // Process children
         if (!node.first_child().empty())
         {
-            xmlToJson(node, docJson, mod, localPath);
+            xmlToJson(node, docJson, mod, localPath, selected);
         }
     }
 }
@@ -134,9 +162,30 @@ Mapper getMapper(const json::Json& parsed, std::string_view targetField)
     };
 }
 
-SemParser getSemParser(const std::string& targetField, xmlModule moduleFn)
+Mapper getMapper(json::Json&& parsed, const std::string& targetField, const std::vector<std::string>& selected)
 {
-    return [targetField, moduleFn](std::string_view parsed) -> std::variant<Mapper, base::Error>
+    std::vector<std::pair<std::string, json::Json>> values;
+    for (const auto& path : selected)
+    {
+        auto value = parsed.getJson(path);
+        if (value)
+        {
+            values.emplace_back(targetField + path, std::move(value.value()));
+        }
+    }
+
+    return [values = std::move(values)](json::Json& event)
+    {
+        for (const auto& [path, value] : values)
+        {
+            event.set(path, value);
+        }
+    };
+}
+
+SemParser getSemParser(const std::string& targetField, xmlModule moduleFn, const std::vector<std::string>& selected)
+{
+    return [targetField, moduleFn, selected](std::string_view parsed) -> std::variant<Mapper, base::Error>
     {
         json::Json jParsed;
         pugi::xml_document xmlDoc;
@@ -147,13 +196,18 @@ SemParser getSemParser(const std::string& targetField, xmlModule moduleFn)
         {
             return base::Error {"Invalid XML"};
         }
-        xmlToJson(xmlDoc, jParsed, moduleFn);
+        xmlToJson(xmlDoc, jParsed, moduleFn, "", selected);
 
         if (targetField.empty())
         {
             return noMapper();
         }
 
+        if (!selected.empty())
+        {
+            return getMapper(std::move(jParsed), targetField, selected);
+        }
+
         return getMapper(jParsed, targetField);
     };
 }
@@ -176,7 +230,7 @@ Parser getXMLParser(const Params& params)
     {
         moduleName = "default";
     }
-    else if (params.options.size() == 1)
+    else
     {
         moduleName = params.options[0];
         if (xmlModules.count(moduleName) == 0)
@@ -184,14 +238,21 @@ Parser getXMLParser(const Params& params)
             throw std::runtime_error(fmt::format("XML parser module {} not found.", moduleName));
         }
     }
-    else
+
+    // Lazy mode, only the values at the given paths are mapped
+    std::vector<std::string> selected;
+    for (auto it = params.options.begin() + (params.options.empty() ? 0 : 1); it != params.options.end(); ++it)
     {
-        throw std::runtime_error(fmt::format("XML parser requires 0 or 1 arguments."));
+        if (it->empty())
+        {
+            throw std::runtime_error(fmt::format("XML parser paths must not be empty."));
+        }
+        selected.emplace_back(json::Json::formatJsonPath(*it));
     }
 
     xmlModule moduleFn = xmlModules[moduleName];
     const auto target = params.targetField.empty() ? "" : params.targetField;
-    const auto semP = getSemParser(target, moduleFn);
+    const auto semP = getSemParser(target, moduleFn, selected);
     const auto synP = syntax::parsers::toEnd(params.stop);
 
     return [moduleFn, name = params.name, semP, synP](std::string_view txt)
@@ -204,7 +265,7 @@ Parser getXMLParser(const Params& params)
 
         const auto parsed = syntax::parsed(synR, txt);
 
-        return abs::makeSuccess<ResultT>(SemToken {parsed, semP}, synR.remaining());
+        return abs::makeSuccess<ResultT>(SemToken {parsed, &semP}, synR.remaining());
     };
 }
 } // namespace hlp::parsers
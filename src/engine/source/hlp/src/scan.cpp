@@ -0,0 +1,290 @@
+#include "scan.hpp"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HLP_SCAN_X86 1
+#define HLP_SCAN_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+namespace hlp::scan
+{
+
+namespace
+{
+constexpr std::size_t AVX2_MAX_CHARS = 4;   ///< Larger sets need too many comparisons, they use SSE4.2
+constexpr std::size_t SSE42_MAX_CHARS = 16; ///< Bytes of a PCMPESTRI set
+
+using FindFn = std::size_t (*)(std::string_view, std::string_view, std::size_t);
+
+/**
+ * @brief The kernels supported by the CPU, selected once.
+ */
+struct Kernels
+{
+    bool sse42;
+    bool avx2;
+    FindFn find;
+};
+
+const Kernels& kernels()
+{
+    static const Kernels selected = []()
+    {
+        Kernels k {detail::hasSSE42(), detail::hasAVX2(), detail::findScalar};
+#ifdef __SSE2__
+        k.find = detail::findSSE2;
+#endif
+        if (k.avx2)
+        {
+            k.find = detail::findAVX2;
+        }
+        return k;
+    }();
+    return selected;
+}
+
+inline std::size_t findChar(std::string_view input, char c, std::size_t pos)
+{
+    const auto* found = std::memchr(input.data() + pos, c, input.size() - pos);
+    return found ? static_cast<const char*>(found) - input.data() : std::string_view::npos;
+}
+
+/**
+ * @brief Check the candidates of a vector block, each bit of the mask is a position where the first and last bytes
+ * of the needle match.
+ */
+inline std::size_t checkCandidates(const char* block, uint32_t mask, std::string_view needle)
+{
+    while (mask != 0)
+    {
+        const auto bit = static_cast<std::size_t>(__builtin_ctz(mask));
+        if (std::memcmp(block + bit + 1, needle.data() + 1, needle.size() - 2) == 0)
+        {
+            return bit;
+        }
+        mask &= mask - 1;
+    }
+    return std::string_view::npos;
+}
+} // namespace
+
+namespace detail
+{
+
+std::size_t findAnyScalar(std::string_view input, const CharSet& set, std::size_t pos)
+{
+    for (auto i = pos; i < input.size(); ++i)
+    {
+        if (set.contains(input[i]))
+        {
+            return i;
+        }
+    }
+    return std::string_view::npos;
+}
+
+std::size_t findScalar(std::string_view input, std::string_view needle, std::size_t pos)
+{
+    return input.find(needle, pos);
+}
+
+#ifdef HLP_SCAN_X86
+
+bool hasSSE42()
+{
+    return __builtin_cpu_supports("sse4.2");
+}
+
+bool hasAVX2()
+{
+    return __builtin_cpu_supports("avx2");
+}
+
+HLP_SCAN_TARGET("sse4.2")
+std::size_t findAnySSE42(std::string_view input, const CharSet& set, std::size_t pos)
+{
+    const auto chars = set.chars();
+    if (chars.size() > SSE42_MAX_CHARS)
+    {
+        return findAnyScalar(input, set, pos);
+    }
+
+    char padded[SSE42_MAX_CHARS] {};
+    std::memcpy(padded, chars.data(), chars.size());
+    const auto needles = _mm_loadu_si128(reinterpret_cast<const __m128i*>(padded));
+    const auto needlesLen = static_cast<int>(chars.size());
+
+    auto i = pos;
+    for (; i + 16 <= input.size(); i += 16)
+    {
+        const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input.data() + i));
+        const auto index = _mm_cmpestri(
+            needles, needlesLen, block, 16, _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_LEAST_SIGNIFICANT);
+        if (index < 16)
+        {
+            return i + index;
+        }
+    }
+    return findAnyScalar(input, set, i);
+}
+
+HLP_SCAN_TARGET("avx2")
+std::size_t findAnyAVX2(std::string_view input, const CharSet& set, std::size_t pos)
+{
+    const auto chars = set.chars();
+    if (chars.size() > AVX2_MAX_CHARS || chars.empty())
+    {
+        return findAnySSE42(input, set, pos);
+    }
+
+    // Unused slots repeat the first byte
+    __m256i needles[AVX2_MAX_CHARS];
+    for (std::size_t n = 0; n < AVX2_MAX_CHARS; ++n)
+    {
+        needles[n] = _mm256_set1_epi8(chars[n < chars.size() ? n : 0]);
+    }
+
+    auto i = pos;
+    for (; i + 32 <= input.size(); i += 32)
+    {
+        const auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input.data() + i));
+        const auto eq = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(block, needles[0]), _mm256_cmpeq_epi8(block, needles[1])),
+            _mm256_or_si256(_mm256_cmpeq_epi8(block, needles[2]), _mm256_cmpeq_epi8(block, needles[3])));
+        const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(eq));
+        if (mask != 0)
+        {
+            return i + __builtin_ctz(mask);
+        }
+    }
+    return findAnyScalar(input, set, i);
+}
+
+HLP_SCAN_TARGET("sse2")
+std::size_t findSSE2(std::string_view input, std::string_view needle, std::size_t pos)
+{
+    const auto n = needle.size();
+    const auto first = _mm_set1_epi8(needle.front());
+    const auto last = _mm_set1_epi8(needle.back());
+
+    auto i = pos;
+    for (; i + n - 1 + 16 <= input.size(); i += 16)
+    {
+        const auto blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input.data() + i));
+        const auto blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input.data() + i + n - 1));
+        const auto eq = _mm_and_si128(_mm_cmpeq_epi8(blockFirst, first), _mm_cmpeq_epi8(blockLast, last));
+        const auto found = checkCandidates(input.data() + i, static_cast<uint32_t>(_mm_movemask_epi8(eq)), needle);
+        if (found != std::string_view::npos)
+        {
+            return i + found;
+        }
+    }
+    return findScalar(input, needle, i);
+}
+
+HLP_SCAN_TARGET("avx2")
+std::size_t findAVX2(std::string_view input, std::string_view needle, std::size_t pos)
+{
+    const auto n = needle.size();
+    const auto first = _mm256_set1_epi8(needle.front());
+    const auto last = _mm256_set1_epi8(needle.back());
+
+    auto i = pos;
+    for (; i + n - 1 + 32 <= input.size(); i += 32)
+    {
+        const auto blockFirst = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input.data() + i));
+        const auto blockLast = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input.data() + i + n - 1));
+        const auto eq = _mm256_and_si256(_mm256_cmpeq_epi8(blockFirst, first), _mm256_cmpeq_epi8(blockLast, last));
+        const auto found =
+            checkCandidates(input.data() + i, static_cast<uint32_t>(_mm256_movemask_epi8(eq)), needle);
+        if (found != std::string_view::npos)
+        {
+            return i + found;
+        }
+    }
+    return findScalar(input, needle, i);
+}
+
+#else
+
+bool hasSSE42()
+{
+    return false;
+}
+
+bool hasAVX2()
+{
+    return false;
+}
+
+std::size_t findAnySSE42(std::string_view input, const CharSet& set, std::size_t pos)
+{
+    return findAnyScalar(input, set, pos);
+}
+
+std::size_t findAnyAVX2(std::string_view input, const CharSet& set, std::size_t pos)
+{
+    return findAnyScalar(input, set, pos);
+}
+
+std::size_t findSSE2(std::string_view input, std::string_view needle, std::size_t pos)
+{
+    return findScalar(input, needle, pos);
+}
+
+std::size_t findAVX2(std::string_view input, std::string_view needle, std::size_t pos)
+{
+    return findScalar(input, needle, pos);
+}
+
+#endif // HLP_SCAN_X86
+
+} // namespace detail
+
+std::size_t findAny(std::string_view input, const CharSet& set, std::size_t pos)
+{
+    const auto chars = set.chars();
+    if (pos >= input.size() || chars.empty())
+    {
+        return std::string_view::npos;
+    }
+
+    if (chars.size() == 1)
+    {
+        return findChar(input, chars.front(), pos);
+    }
+
+    const auto& k = kernels();
+    if (k.avx2 && chars.size() <= AVX2_MAX_CHARS)
+    {
+        return detail::findAnyAVX2(input, set, pos);
+    }
+    if (k.sse42 && chars.size() <= SSE42_MAX_CHARS)
+    {
+        return detail::findAnySSE42(input, set, pos);
+    }
+    return detail::findAnyScalar(input, set, pos);
+}
+
+std::size_t find(std::string_view input, std::string_view needle, std::size_t pos)
+{
+    // Trivial cases, the kernels expect a needle of 2 bytes or more that fits in the input
+    if (pos > input.size() || needle.size() > input.size() - pos)
+    {
+        return std::string_view::npos;
+    }
+    if (needle.empty())
+    {
+        return pos;
+    }
+    if (needle.size() == 1)
+    {
+        return findChar(input, needle.front(), pos);
+    }
+
+    return kernels().find(input, needle, pos);
+}
+
+} // namespace hlp::scan
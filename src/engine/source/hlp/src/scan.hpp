@@ -0,0 +1,97 @@
+#ifndef _HLP_SCAN_HPP
+#define _HLP_SCAN_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Vectorized search kernels used by the parsers to find their delimiters.
+ *
+ * The kernels are picked at startup from the instruction sets supported by the CPU (AVX2, SSE4.2), the scalar
+ * versions are used on other architectures or when the CPU lacks them.
+ */
+namespace hlp::scan
+{
+
+/**
+ * @brief A set of bytes to look for.
+ */
+class CharSet
+{
+private:
+    std::array<uint64_t, 4> m_bitmap; ///< One bit per byte value, for the scalar search
+    std::string m_chars;              ///< Distinct bytes of the set, for the vectorized search
+
+public:
+    explicit CharSet(std::string_view chars)
+        : m_bitmap()
+        , m_chars()
+    {
+        m_bitmap.fill(0);
+        for (const auto c : chars)
+        {
+            if (!contains(c))
+            {
+                const auto byte = static_cast<unsigned char>(c);
+                m_bitmap[byte >> 6] |= uint64_t {1} << (byte & 63);
+                m_chars.push_back(c);
+            }
+        }
+    }
+
+    bool contains(char c) const
+    {
+        const auto byte = static_cast<unsigned char>(c);
+        return (m_bitmap[byte >> 6] >> (byte & 63)) & 1;
+    }
+
+    std::string_view chars() const { return m_chars; }
+};
+
+/**
+ * @brief Find the first byte of the input that belongs to the set.
+ *
+ * @param input The text to scan.
+ * @param set The bytes to look for.
+ * @param pos The position where the scan starts.
+ * @return std::size_t The position of the byte, std::string_view::npos if there is none.
+ */
+std::size_t findAny(std::string_view input, const CharSet& set, std::size_t pos = 0);
+
+/**
+ * @brief Find the first occurrence of a substring.
+ *
+ * Same result as std::string_view::find, the candidates are filtered comparing the first and last bytes of the
+ * needle on a whole vector at once.
+ * @param input The text to scan.
+ * @param needle The substring to look for.
+ * @param pos The position where the scan starts.
+ * @return std::size_t The position of the substring, std::string_view::npos if there is none.
+ */
+std::size_t find(std::string_view input, std::string_view needle, std::size_t pos = 0);
+
+namespace detail
+{
+/**
+ * @brief The kernels of each instruction set, exposed for testing purposes.
+ *
+ * The vectorized ones must only be called if the CPU supports them, and the substring ones with a needle of two
+ * bytes or more that fits in the input after `pos`.
+ */
+std::size_t findAnyScalar(std::string_view input, const CharSet& set, std::size_t pos);
+std::size_t findAnySSE42(std::string_view input, const CharSet& set, std::size_t pos);
+std::size_t findAnyAVX2(std::string_view input, const CharSet& set, std::size_t pos);
+std::size_t findScalar(std::string_view input, std::string_view needle, std::size_t pos);
+std::size_t findSSE2(std::string_view input, std::string_view needle, std::size_t pos);
+std::size_t findAVX2(std::string_view input, std::string_view needle, std::size_t pos);
+
+bool hasSSE42(); ///< The CPU supports SSE4.2
+bool hasAVX2();  ///< The CPU supports AVX2
+} // namespace detail
+
+} // namespace hlp::scan
+
+#endif // _HLP_SCAN_HPP
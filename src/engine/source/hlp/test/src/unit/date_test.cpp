@@ -77,6 +77,25 @@ INSTANTIATE_TEST_SUITE_P(
                16,
                initAndGetDateParser(),
                {NAME, TARGET, {}, {"%B %d %T", "en_US.UTF-8"}}),
+        // Inputs of a compiled layout left to date::parse
+        ParseT(SUCCESS,
+               "June 14 15:16:01",
+               j(fmt::format(R"({{"{}": "{}-06-14T15:16:01.000Z"}})", TARGET.substr(1), BUILD_YEAR)),
+               16,
+               initAndGetDateParser(),
+               {NAME, TARGET, {}, {"%b %d %T", "en_US.UTF-8"}}),
+        ParseT(SUCCESS,
+               "Jun  4 15:16:01 host",
+               j(fmt::format(R"({{"{}": "{}-06-04T15:16:01.000Z"}})", TARGET.substr(1), BUILD_YEAR)),
+               15,
+               initAndGetDateParser(),
+               {NAME, TARGET, {}, {"%b %d %T", "en_US.UTF-8"}}),
+        ParseT(SUCCESS,
+               "JUN 14 15:16:01.250",
+               j(fmt::format(R"({{"{}": "{}-06-14T15:16:01.250Z"}})", TARGET.substr(1), BUILD_YEAR)),
+               19,
+               initAndGetDateParser(),
+               {NAME, TARGET, {}, {"SYSLOG"}}),
         ParseT(SUCCESS,
                "2019-12-12",
                j(fmt::format(R"({{"{}": "2019-12-12T00:00:00.000Z"}})", TARGET.substr(1))),
@@ -45,7 +45,7 @@ void parseTest(
     {
         ASSERT_TRUE(result.success()) << result.trace() << "failed at: '" << result.remaining() << "'";
         ASSERT_TRUE(result.hasValue());
-        auto mapper = result.value().semParser(result.value().parsed);
+        auto mapper = result.value().semParse();
         ASSERT_TRUE(std::holds_alternative<hlp::parser::Mapper>(mapper))
             << "SemParser failed: " << std::get<base::Error>(mapper).message;
         auto event = json::Json {};
@@ -58,7 +58,7 @@ void parseTest(
         if (result.success())
         {
             ASSERT_TRUE(result.hasValue());
-            auto mapper = result.value().semParser(result.value().parsed);
+            auto mapper = result.value().semParse();
             ASSERT_TRUE(std::holds_alternative<base::Error>(mapper)) << "Parser succeeded";
         }
     }
@@ -105,3 +105,50 @@ TEST_P(HlpParseTest, NoMappingParse)
     auto parser = builder(params);
     parseTest(success, input, expected, index, parser);
 }
+
+// Only the tokens of the winning alternative are mapped
+TEST(HlpRunTest, MapsWinningAlternative)
+{
+    using namespace hlp::parser::combinator;
+
+    auto first = all({hlp::parsers::getLiteralParser({"literal", "/first", {}, {"a"}}),
+                      hlp::parsers::getLiteralParser({"literal", "/first", {}, {"x"}})});
+    auto second = hlp::parsers::getTextParser({"text", "/second", {""}, {}});
+    auto parser = choice(first, second);
+
+    auto event = json::Json {};
+    event.setObject();
+    auto error = hlp::parser::run(parser, "ay", event);
+    ASSERT_FALSE(error) << error.value().message;
+
+    auto expected = json::Json {R"({"second":"ay"})"};
+    ASSERT_EQ(event, expected);
+}
+
+// A token keeps the semantic parser it was built with, even after being copied
+TEST(HlpRunTest, SemTokenOwnsSemParser)
+{
+    hlp::parser::SemToken token;
+    {
+        hlp::parser::SemParser semP = [](std::string_view parsed) -> std::variant<hlp::parser::Mapper, base::Error>
+        {
+            return [parsed](json::Json& event)
+            {
+                event.setString(parsed, "/owned");
+            };
+        };
+        token = hlp::parser::SemToken {"value", std::move(semP)};
+    }
+    auto copy = token;
+
+    auto mapper = copy.semParse();
+    ASSERT_TRUE(std::holds_alternative<hlp::parser::Mapper>(mapper));
+    auto event = json::Json {};
+    event.setObject();
+    std::get<hlp::parser::Mapper>(mapper)(event);
+    ASSERT_EQ(event, json::Json {R"({"owned":"value"})"});
+
+    // An empty token maps nothing
+    auto emptyMapper = hlp::parser::SemToken {}.semParse();
+    ASSERT_TRUE(std::holds_alternative<hlp::parser::Mapper>(emptyMapper));
+}
@@ -111,6 +111,7 @@ INSTANTIATE_TEST_SUITE_P(
                getIPParser,
                {NAME, TARGET, {}, {}}),
         ParseT(FAILURE, "256.168.0.1", {}, 11, getIPParser, {NAME, TARGET, {}, {}}),
+        ParseT(FAILURE, "192.168.00.1", {}, 12, getIPParser, {NAME, TARGET, {}, {}}),
         ParseT(FAILURE, "100.500.0.1", {}, 11, getIPParser, {NAME, TARGET, {}, {}}),
         ParseT(FAILURE, "20.200.1000.1", {}, 0, getIPParser, {NAME, TARGET, {}, {}}),
         ParseT(FAILURE, "20.200.0.950", {}, 12, getIPParser, {NAME, TARGET, {}, {}}),
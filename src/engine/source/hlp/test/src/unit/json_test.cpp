@@ -8,7 +8,10 @@ static const std::string TARGET = "/TargetField";
 INSTANTIATE_TEST_SUITE_P(JSONBuild,
                          HlpBuildTest,
                          ::testing::Values(BuildT(SUCCESS, getJSONParser, {NAME, TARGET, {}, {}}),
-                                           BuildT(FAILURE, getJSONParser, {NAME, TARGET, {}, {"unexpected"}})));
+                                           BuildT(SUCCESS, getJSONParser, {NAME, TARGET, {}, {"user.name"}}),
+                                           BuildT(SUCCESS, getJSONParser, {NAME, TARGET, {}, {"user.name", "src.ip"}}),
+                                           BuildT(FAILURE, getJSONParser, {NAME, TARGET, {}, {""}}),
+                                           BuildT(FAILURE, getJSONParser, {NAME, TARGET, {}, {"user.name", ""}})));
 
 INSTANTIATE_TEST_SUITE_P(
     JSONParse,
@@ -83,4 +86,24 @@ INSTANTIATE_TEST_SUITE_P(
                 R"({"Actors":[{"name":"Tom Cruise","age":56,"Born At":"Syracuse, NY","Birthdate":"July 3, 1962","photo":"https://jsonformatterdotorg/img/tom-cruise.jpg","wife":null,"weight":67.5,"hasChildren":true,"hasGreyHair":false,"children":["Suri","Isabella Jane","Connor"]},{"name":"Robert Downey Jr.","age":53,"Born At":"New York City, NY","Birthdate":"April 4, 1965","photo":"https://jsonformatterdotorg/img/Robert-Downey-Jr.jpg","wife":"Susan Downey","weight":77.1,"hasChildren":true,"hasGreyHair":false,"children":["Indio Falconer","Avri Roel","Exton Elias"]}]})")),
             552,
             getJSONParser,
-            {NAME, TARGET, {}, {}})));
+            {NAME, TARGET, {}, {}}),
+        // Lazy mode, only the selected paths are mapped
+        ParseT(SUCCESS,
+               R"({"user":{"name":"john","id":7},"src":{"ip":"1.2.3.4","port":22},"tags":["a","b"]}left over)",
+               j(fmt::format(R"({{"{}":{}}})", TARGET.substr(1), R"({"user":{"name":"john"},"tags":["a","b"]})")),
+               81,
+               getJSONParser,
+               {NAME, TARGET, {}, {"user.name", "tags"}}),
+        ParseT(SUCCESS,
+               R"({"user":{"name":"john","id":7},"src":{"ip":"1.2.3.4","port":22}})",
+               j(fmt::format(R"({{"{}":{}}})", TARGET.substr(1), R"({"src":{"ip":"1.2.3.4","port":22}})")),
+               64,
+               getJSONParser,
+               {NAME, TARGET, {}, {"src", "src.ip", "missing"}}),
+        ParseT(SUCCESS,
+               R"({"user":{"name":"john"}})",
+               j("{}"),
+               24,
+               getJSONParser,
+               {NAME, TARGET, {}, {"missing"}}),
+        ParseT(FAILURE, R"({"user":{"name":"john"})", {}, 0, getJSONParser, {NAME, TARGET, {}, {"user.name"}})));
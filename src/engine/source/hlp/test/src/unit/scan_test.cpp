@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+
+#include "scan.hpp"
+
+using namespace hlp::scan;
+
+namespace
+{
+std::string randomText(std::mt19937& gen, std::size_t size, std::string_view alphabet)
+{
+    std::uniform_int_distribution<std::size_t> dis(0, alphabet.size() - 1);
+    std::string text;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        text.push_back(alphabet[dis(gen)]);
+    }
+    return text;
+}
+
+std::size_t naiveFindAny(std::string_view input, std::string_view chars, std::size_t pos)
+{
+    return pos >= input.size() ? std::string_view::npos : input.find_first_of(chars, pos);
+}
+} // namespace
+
+TEST(HlpScanTest, CharSet)
+{
+    CharSet set {"a,a\"\\"};
+    EXPECT_EQ(set.chars(), "a,\"\\");
+    EXPECT_TRUE(set.contains(','));
+    EXPECT_FALSE(set.contains('b'));
+
+    CharSet binary {std::string_view {"\0\xff", 2}};
+    EXPECT_TRUE(binary.contains('\0'));
+    EXPECT_TRUE(binary.contains('\xff'));
+    EXPECT_FALSE(binary.contains('\x7f'));
+}
+
+TEST(HlpScanTest, FindAny)
+{
+    const CharSet set {",=\""};
+    EXPECT_EQ(findAny("", set), std::string_view::npos);
+    EXPECT_EQ(findAny("abc", set), std::string_view::npos);
+    EXPECT_EQ(findAny("ab=c", set), 2);
+    EXPECT_EQ(findAny("ab=c,d", set, 3), 4);
+    EXPECT_EQ(findAny("ab=c", set, 10), std::string_view::npos);
+    EXPECT_EQ(findAny("abcdefghijklmnopqrstuvwxyz0123456789abcdefghij\"", set), 46);
+    EXPECT_EQ(findAny("abc", CharSet {""}), std::string_view::npos);
+    EXPECT_EQ(findAny("abc", CharSet {"c"}), 2);
+}
+
+TEST(HlpScanTest, Find)
+{
+    EXPECT_EQ(hlp::scan::find("", ""), 0);
+    EXPECT_EQ(hlp::scan::find("abc", ""), 0);
+    EXPECT_EQ(hlp::scan::find("abc", "", 3), 3);
+    EXPECT_EQ(hlp::scan::find("abc", "", 4), std::string_view::npos);
+    EXPECT_EQ(hlp::scan::find("abc", "abcd"), std::string_view::npos);
+    EXPECT_EQ(hlp::scan::find("abc", "c"), 2);
+    EXPECT_EQ(hlp::scan::find("abcabc", "bc", 2), 4);
+    EXPECT_EQ(hlp::scan::find("0123456789012345678901234567890123456789 end", " end"), 40);
+    EXPECT_EQ(hlp::scan::find("0123456789012345678901234567890123456789 end", " enx"), std::string_view::npos);
+}
+
+// Every kernel supported by the CPU gives the same result as the standard library
+TEST(HlpScanTest, KernelsMatchStandardLibrary)
+{
+    std::mt19937 gen(42);
+    const std::vector<std::string> sets {",\"", ",=\"\\", "abcdefg", "0123456789abcdefghij"};
+    const std::vector<std::string> needles {"ab", "aba", "abcab", "bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbba"};
+
+    for (std::size_t size = 0; size < 200; ++size)
+    {
+        const auto text = randomText(gen, size, size % 2 ? "abc,=\"\\" : "abcdefghijklmnopqrstuvwxyz0123456789");
+        for (std::size_t pos = 0; pos <= size; pos += 7)
+        {
+            for (const auto& chars : sets)
+            {
+                const CharSet set {chars};
+                const auto expected = naiveFindAny(text, chars, pos);
+                ASSERT_EQ(findAny(text, set, pos), expected) << text;
+                ASSERT_EQ(detail::findAnyScalar(text, set, pos), expected) << text;
+                if (detail::hasSSE42())
+                {
+                    ASSERT_EQ(detail::findAnySSE42(text, set, pos), expected) << text;
+                }
+                if (detail::hasAVX2())
+                {
+                    ASSERT_EQ(detail::findAnyAVX2(text, set, pos), expected) << text;
+                }
+            }
+
+            for (const auto& needle : needles)
+            {
+                const auto expected = text.find(needle, pos);
+                ASSERT_EQ(hlp::scan::find(text, needle, pos), expected) << text;
+                if (needle.size() > text.size() - pos)
+                {
+                    continue;
+                }
+                ASSERT_EQ(detail::findSSE2(text, needle, pos), expected) << text;
+                if (detail::hasAVX2())
+                {
+                    ASSERT_EQ(detail::findAVX2(text, needle, pos), expected) << text;
+                }
+            }
+        }
+    }
+}
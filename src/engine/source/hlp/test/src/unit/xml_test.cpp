@@ -13,7 +13,10 @@ INSTANTIATE_TEST_SUITE_P(
                       BuildT(SUCCESS, getXMLParser, {NAME, TARGET, {""}, {}}),
                       BuildT(SUCCESS, getXMLParser, {NAME, TARGET, {""}, {"windows"}}),
                       BuildT(FAILURE, getXMLParser, {NAME, TARGET, {""}, {"not_supported"}}),
-                      BuildT(FAILURE, getXMLParser, {NAME, TARGET, {""}, {"windows", "unexpected"}})));
+                      BuildT(SUCCESS, getXMLParser, {NAME, TARGET, {""}, {"windows", "System.EventID"}}),
+                      BuildT(SUCCESS, getXMLParser, {NAME, TARGET, {""}, {"default", "a.b", "c"}}),
+                      BuildT(FAILURE, getXMLParser, {NAME, TARGET, {""}, {"not_supported", "a.b"}}),
+                      BuildT(FAILURE, getXMLParser, {NAME, TARGET, {""}, {"windows", ""}})));
 
 INSTANTIATE_TEST_SUITE_P(
     XmlParse,
@@ -254,5 +257,18 @@ Name='IpAddress'>::1</Data><Data Name='IpPort'>0</Data></EventData>)",
 )")),
                1573,
                getXMLParser,
-               {NAME, TARGET, {""}})
+               {NAME, TARGET, {""}}),
+        // Lazy mode, only the selected elements are mapped
+        ParseT(SUCCESS,
+               R"(<root><a>1</a><b x="y">2</b><c><d>3</d></c></root>)",
+               j(fmt::format(R"({{"{}":{}}})", TARGET.substr(1), R"({"root":{"c":{"d":{"#text":"3"}}}})")),
+               50,
+               getXMLParser,
+               {NAME, TARGET, {""}, {"default", "root.c"}}),
+        ParseT(SUCCESS,
+               R"(<root><a>1</a><b x="y">2</b><c><d>3</d></c></root>)",
+               j(fmt::format(R"({{"{}":{}}})", TARGET.substr(1), R"({"root":{"a":{"#text":"1"},"b":{"@x":"y","#text":"2"}}})")),
+               50,
+               getXMLParser,
+               {NAME, TARGET, {""}, {"default", "root.a", "root.b"}})
                        ));
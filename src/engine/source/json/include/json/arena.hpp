@@ -0,0 +1,125 @@
+#ifndef _JSON_ARENA_HPP
+#define _JSON_ARENA_HPP
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <rapidjson/allocators.h>
+
+namespace json
+{
+
+/**
+ * @brief Pool of recycled memory chunks for the allocators of the json documents.
+ *
+ * Each document built while an arena is installed in the current thread takes a chunk from the arena, and its
+ * allocator serves the document tree from that chunk. When the document is destroyed the chunk goes back to the
+ * arena, so a thread that keeps building and dropping documents reuses the same memory instead of mallocing and
+ * freeing a new pool for each one. Documents that outgrow the chunk fall back to the regular allocator for the rest
+ * of the tree.
+ *
+ * Chunks can be released from any thread, and the arena lives as long as any of its chunks is in use.
+ */
+class Arena : public std::enable_shared_from_this<Arena>
+{
+public:
+    using Allocator = rapidjson::MemoryPoolAllocator<>;
+
+    /**
+     * @brief Returns the chunk of an allocator to its arena
+     */
+    struct Release
+    {
+        std::shared_ptr<Arena> arena; ///< Owner of the chunk
+
+        void operator()(Allocator* allocator) const;
+    };
+
+    using Lease = std::unique_ptr<Allocator, Release>; ///< Allocator placed on a chunk of the arena
+
+    static constexpr std::size_t DEFAULT_CHUNK_SIZE = 16 * 1024;  ///< Bytes per chunk
+    static constexpr std::size_t DEFAULT_MAX_FREE_CHUNKS = 1024; ///< Free chunks kept for reuse
+
+    /**
+     * @brief Installs an arena as the arena of the current thread while the scope is alive.
+     *
+     */
+    class Scope
+    {
+    private:
+        Arena* m_previous; ///< Arena installed before this scope
+
+    public:
+        explicit Scope(const std::shared_ptr<Arena>& arena);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    /**
+     * @brief Create a new arena.
+     *
+     * @param chunkSize Size of the chunks, must be big enough to hold the allocator bookkeeping.
+     * @param maxFreeChunks Maximum number of free chunks kept, the rest are released to the system.
+     * @return std::shared_ptr<Arena>
+     *
+     * @throws std::runtime_error If the chunk size is too small.
+     */
+    static std::shared_ptr<Arena> create(std::size_t chunkSize = DEFAULT_CHUNK_SIZE,
+                                         std::size_t maxFreeChunks = DEFAULT_MAX_FREE_CHUNKS);
+
+    /**
+     * @brief Lease an allocator from the arena installed in the current thread.
+     *
+     * @return Lease The allocator, or an empty lease if there is no arena installed.
+     */
+    static Lease leaseCurrent();
+
+    ~Arena();
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /**
+     * @brief Lease an allocator on a chunk of the arena.
+     *
+     * @return Lease The allocator, the chunk is recycled when the lease is released.
+     */
+    Lease lease();
+
+    /**
+     * @brief Get the number of free chunks.
+     *
+     * @return std::size_t
+     */
+    std::size_t freeChunks() const;
+
+    /**
+     * @brief Get the size of the chunks.
+     *
+     * @return std::size_t
+     */
+    std::size_t chunkSize() const { return m_chunkSize; }
+
+private:
+    Arena(std::size_t chunkSize, std::size_t maxFreeChunks);
+
+    /**
+     * @brief Take the chunk back, keeping it if there is room in the free list.
+     *
+     * @param chunk The chunk.
+     */
+    void recycle(void* chunk);
+
+    std::size_t m_chunkSize;     ///< Bytes per chunk
+    std::size_t m_maxFreeChunks; ///< Maximum free chunks kept
+    mutable std::mutex m_mutex;  ///< Protects the free list
+    std::vector<void*> m_free;   ///< Free chunks
+};
+
+} // namespace json
+
+#endif // _JSON_ARENA_HPP
@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <memory>
 #include <optional>
 #include <stdexcept>
 #include <string>
@@ -18,6 +19,7 @@
 #include <rapidjson/writer.h>
 
 #include <error.hpp>
+#include <json/arena.hpp>
 
 namespace json
 {
@@ -25,6 +27,51 @@ namespace json
 constexpr bool RECURSIVE {true};
 constexpr bool NOT_RECURSIVE {false};
 
+/**
+ * @brief Pointer path parsed once, to be reused on every access to the same field.
+ *
+ * Parsing a pointer path tokenizes the string and allocates the tokens, building the handle at build time keeps that
+ * work out of the per-event accessors. The handle is immutable and cheap to copy, so it can be captured by value and
+ * shared between threads.
+ */
+class PointerPath
+{
+private:
+    std::string m_path;                                  ///< Pointer path string
+    std::shared_ptr<const rapidjson::Pointer> m_pointer; ///< Parsed pointer
+
+public:
+    /**
+     * @brief Construct a pointer path to the root value.
+     *
+     */
+    PointerPath();
+
+    /**
+     * @brief Construct a new pointer path from its string.
+     *
+     * @param pointerPath The pointer path string (e.g. "/event/original").
+     *
+     * @throws std::runtime_error If the pointer path is invalid.
+     */
+    explicit PointerPath(std::string_view pointerPath);
+
+    /**
+     * @brief Get the pointer path string.
+     *
+     * @return const std::string&
+     */
+    const std::string& str() const { return m_path; }
+
+    /**
+     * @brief Get the parsed pointer.
+     *
+     * @return const rapidjson::Pointer&
+     */
+    const rapidjson::Pointer& pointer() const { return *m_pointer; }
+};
+
+
 class Json
 {
 public:
@@ -101,7 +148,8 @@ public:
     }
 
 private:
-    rapidjson::Document m_document;
+    Arena::Lease m_allocator;       ///< Arena allocator of the document, empty if the document owns its allocator
+    rapidjson::Document m_document; ///< The document, declared after its allocator so it is destroyed first
 
     /**
      * @brief Construct a new Json object form a rapidjason::Value.
@@ -142,8 +190,18 @@ private:
         }
     }
 
+    /**
+     * @brief Merge a copy of the source value into the value at the path.
+     */
     void merge(const bool isRecursive, const rapidjson::Value& source, std::string_view path);
 
+    /**
+     * @brief Merge the source value into the value at the path, moving its members out.
+     *
+     * The source must belong to this document and must not contain the destination.
+     */
+    void merge(const bool isRecursive, rapidjson::Value&& source, std::string_view path);
+
 public:
     /**
      * @brief Construct a new Json empty json object.
@@ -221,6 +279,13 @@ public:
      */
     Json& operator=(Json&& other) noexcept;
 
+    /**
+     * @brief Drop the content of the document, leaving it as null.
+     *
+     * The memory of the allocator is kept, so the document can be filled again without allocating a new pool.
+     */
+    void reset();
+
     /**
      * @brief Check if the Json contains a field with the given pointer path.
      *
@@ -232,6 +297,11 @@ public:
      */
     bool exists(std::string_view pointerPath) const;
 
+    /**
+     * @copydoc exists(std::string_view) const
+     */
+    bool exists(const PointerPath& pointerPath) const;
+
     /**
      * @brief Check if the Json contains a field with the given dot path, and if so, with
      * the given value.
@@ -245,6 +315,11 @@ public:
      */
     bool equals(std::string_view pointerPath, const Json& value) const;
 
+    /**
+     * @copydoc equals(std::string_view, const Json&) const
+     */
+    bool equals(const PointerPath& pointerPath, const Json& value) const;
+
     /**
      * @brief Check if basePointerPath field's value is equal to referencePointerPath
      * field's value. If basePointerPath or referencePointerPath is not found, returns
@@ -259,6 +334,11 @@ public:
      */
     bool equals(std::string_view basePointerPath, std::string_view referencePointerPath) const;
 
+    /**
+     * @copydoc equals(std::string_view, std::string_view) const
+     */
+    bool equals(const PointerPath& basePointerPath, const PointerPath& referencePointerPath) const;
+
     /**
      * @brief Set the value of the field with the given pointer path.
      * Overwrites previous value.
@@ -270,6 +350,11 @@ public:
      */
     void set(std::string_view pointerPath, const Json& value);
 
+    /**
+     * @copydoc set(std::string_view, const Json&)
+     */
+    void set(const PointerPath& pointerPath, const Json& value);
+
     /**
      * @brief Set the value of the base field with the value of the reference field.
      * Overwrites previous value. If reference field is not found, sets base field to
@@ -282,6 +367,11 @@ public:
      */
     void set(std::string_view basePointerPath, std::string_view referencePointerPath);
 
+    /**
+     * @copydoc set(std::string_view, std::string_view)
+     */
+    void set(const PointerPath& basePointerPath, const PointerPath& referencePointerPath);
+
     /************************************************************************************/
     // Getters
     /************************************************************************************/
@@ -299,6 +389,11 @@ public:
      */
     std::optional<std::string> getString(std::string_view path = "") const;
 
+    /**
+     * @copydoc getString(std::string_view) const
+     */
+    std::optional<std::string> getString(const PointerPath& path) const;
+
     /**
      * @brief get the value of the int field.
      * Overwrites previous value. If reference field is not found, sets base field to
@@ -312,6 +407,11 @@ public:
      */
     std::optional<int> getInt(std::string_view path = "") const;
 
+    /**
+     * @copydoc getInt(std::string_view) const
+     */
+    std::optional<int> getInt(const PointerPath& path) const;
+
     /**
      * @brief get the value of the int64 field.
      * Overwrites previous value. If reference field is not found, sets base field to
@@ -325,6 +425,11 @@ public:
      */
     std::optional<int64_t> getInt64(std::string_view path = "") const;
 
+    /**
+     * @copydoc getInt64(std::string_view) const
+     */
+    std::optional<int64_t> getInt64(const PointerPath& path) const;
+
     /**
      * @brief Get the value of the int or int64 field as int64.
      *
@@ -334,6 +439,11 @@ public:
      */
     std::optional<int64_t> getIntAsInt64(std::string_view path = "") const;
 
+    /**
+     * @copydoc getIntAsInt64(std::string_view) const
+     */
+    std::optional<int64_t> getIntAsInt64(const PointerPath& path) const;
+
     /**
      * @brief get the value of the float field.
      * Overwrites previous value. If reference field is not found, sets base field to
@@ -347,6 +457,11 @@ public:
      */
     std::optional<float_t> getFloat(std::string_view path = "") const;
 
+    /**
+     * @copydoc getFloat(std::string_view) const
+     */
+    std::optional<float_t> getFloat(const PointerPath& path) const;
+
     /**
      * @brief get the value of the double field.
      * Overwrites previous value. If reference field is not found, sets base field to
@@ -360,6 +475,11 @@ public:
      */
     std::optional<double_t> getDouble(std::string_view path = "") const;
 
+    /**
+     * @copydoc getDouble(std::string_view) const
+     */
+    std::optional<double_t> getDouble(const PointerPath& path) const;
+
     /**
      * @brief get the value of either a double or int field as a double.
      * Overwrites previous value. If reference field is not found, sets base field to
@@ -375,6 +495,11 @@ public:
      */
     std::optional<double> getNumberAsDouble(std::string_view path = "") const;
 
+    /**
+     * @copydoc getNumberAsDouble(std::string_view) const
+     */
+    std::optional<double> getNumberAsDouble(const PointerPath& path) const;
+
     /**
      * @brief get the value of the bool field.
      * Overwrites previous value. If reference field is not found, sets base field to
@@ -388,6 +513,11 @@ public:
      */
     std::optional<bool> getBool(std::string_view path = "") const;
 
+    /**
+     * @copydoc getBool(std::string_view) const
+     */
+    std::optional<bool> getBool(const PointerPath& path) const;
+
     /**
      * @brief get the value of the array field.
      * Overwrites previous value. If reference field is not found, sets base field to
@@ -401,6 +531,11 @@ public:
      */
     std::optional<std::vector<Json>> getArray(std::string_view path = "") const;
 
+    /**
+     * @copydoc getArray(std::string_view) const
+     */
+    std::optional<std::vector<Json>> getArray(const PointerPath& path) const;
+
     /**
      * @brief get the value of the object field.
      *
@@ -412,6 +547,11 @@ public:
      */
     std::optional<std::vector<std::tuple<std::string, Json>>> getObject(std::string_view path = "") const;
 
+    /**
+     * @copydoc getObject(std::string_view) const
+     */
+    std::optional<std::vector<std::tuple<std::string, Json>>> getObject(const PointerPath& path) const;
+
     /**
      * @brief Get Json prettyfied string.
      *
@@ -435,6 +575,35 @@ public:
      */
     std::optional<std::string> str(std::string_view path) const;
 
+    /**
+     * @brief Get the compact binary encoding of the Json.
+     *
+     * Tagged values with varint lengths, faster to encode and decode than the JSON text and usually smaller. Numbers
+     * keep their integer or floating point type and the encoding does not depend on the byte order of the host.
+     *
+     * @return std::string The encoded Json, see fromBinary.
+     */
+    std::string binary() const;
+
+    /**
+     * @brief Check if the data is a binary encoded Json.
+     *
+     * The first byte of the binary encoding is never valid as the first byte of a JSON text.
+     *
+     * @param data The data to check.
+     * @return true If the data was encoded with binary().
+     */
+    static bool isBinary(std::string_view data);
+
+    /**
+     * @brief Decode a binary encoded Json, straight into the document without an intermediate text.
+     *
+     * @param data The data encoded with binary().
+     * @return Json The decoded Json.
+     * @throws std::runtime_error If the data is not a valid binary encoded Json.
+     */
+    static Json fromBinary(std::string_view data);
+
     /**
      * @brief Get a copy of the Json object or nothing if the path not found.c++ diagram
      *
@@ -444,6 +613,11 @@ public:
      */
     std::optional<Json> getJson(std::string_view path = "") const;
 
+    /**
+     * @copydoc getJson(std::string_view) const
+     */
+    std::optional<Json> getJson(const PointerPath& path) const;
+
     friend std::ostream& operator<<(std::ostream& os, const Json& json);
 
     /************************************************************************************/
@@ -664,6 +838,11 @@ public:
      */
     void setNull(std::string_view path = "");
 
+    /**
+     * @copydoc setNull(std::string_view)
+     */
+    void setNull(const PointerPath& path);
+
     /**
      * @brief Set the Boolean object at the path.
      * Parents objects are created if they do not exist.
@@ -675,6 +854,11 @@ public:
      */
     void setBool(bool value, std::string_view path = "");
 
+    /**
+     * @copydoc setBool(bool, std::string_view)
+     */
+    void setBool(bool value, const PointerPath& path);
+
     /**
      * @brief Set the Integer object at the path.
      * Parents objects are created if they do not exist.
@@ -686,6 +870,11 @@ public:
      */
     void setInt(int value, std::string_view path = "");
 
+    /**
+     * @copydoc setInt(int, std::string_view)
+     */
+    void setInt(int value, const PointerPath& path);
+
     /**
      * @brief Set the Integer object at the path.
      * Parents objects are created if they do not exist.
@@ -697,6 +886,11 @@ public:
      */
     void setInt64(int64_t value, std::string_view path = "");
 
+    /**
+     * @copydoc setInt64(int64_t, std::string_view)
+     */
+    void setInt64(int64_t value, const PointerPath& path);
+
     /**
      * @brief Set the Double object at the path.
      * Parents objects are created if they do not exist.
@@ -708,6 +902,11 @@ public:
      */
     void setDouble(double_t value, std::string_view path = "");
 
+    /**
+     * @copydoc setDouble(double_t, std::string_view)
+     */
+    void setDouble(double_t value, const PointerPath& path);
+
     /**
      * @brief Set the Double object at the path.
      * Parents objects are created if they do not exist.
@@ -719,6 +918,11 @@ public:
      */
     void setFloat(float_t value, std::string_view path = "");
 
+    /**
+     * @copydoc setFloat(float_t, std::string_view)
+     */
+    void setFloat(float_t value, const PointerPath& path);
+
     /**
      * @brief Set the String object at the path.
      * Parents objects are created if they do not exist.
@@ -730,6 +934,11 @@ public:
      */
     void setString(std::string_view value, std::string_view path = "");
 
+    /**
+     * @copydoc setString(std::string_view, std::string_view)
+     */
+    void setString(std::string_view value, const PointerPath& path);
+
     /**
      * @brief Set the Array object at the path.
      * Parents objects are created if they do not exist.
@@ -740,6 +949,11 @@ public:
      */
     void setArray(std::string_view path = "");
 
+    /**
+     * @copydoc setArray(std::string_view)
+     */
+    void setArray(const PointerPath& path);
+
     /**
      * @brief Set the Object object at the path.
      * Parents objects are created if they do not exist.
@@ -750,6 +964,11 @@ public:
      */
     void setObject(std::string_view path = "");
 
+    /**
+     * @copydoc setObject(std::string_view)
+     */
+    void setObject(const PointerPath& path);
+
     /**
      * @brief Append string to the Array object at the path.
      * Parents objects are created if they do not exist.
@@ -798,12 +1017,29 @@ public:
      */
     void merge(const bool isRecursive, const Json& other, std::string_view path = "");
 
+    /**
+     * @brief Merge the Json Value at the path with the Json Value at a path of other Json.
+     *
+     * The source value is copied straight from the other Json, without copying it into an intermediate Json first.
+     * The other Json can be this one, the source value is kept.
+     *
+     * @param other The Json to merge from.
+     * @param otherPath The path to the value to merge in the other Json.
+     * @param path The path to the object.
+     *
+     * @throws std::runtime_error On the following conditions:
+     * - If either path are invalid or not found.
+     * - If either Json Values are not Object or Array.
+     * - If Json Values are not the same type.
+     */
+    void merge(const bool isRecursive, const Json& other, std::string_view otherPath, std::string_view path);
+
     /**
      * @brief Merge the Json Value at the path with the given Json Value at reference
      * path.
      *
      * Merges only first level of the Json Value.
-     * Reference value is deleted after merge.
+     * Reference value is deleted after merge, so its members are moved instead of copied.
      *
      * @param other The Json path pointing to the value to be merged.
      * @param path  The path to the object, default value is root object ("").
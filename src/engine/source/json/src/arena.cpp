@@ -0,0 +1,131 @@
+#include <json/arena.hpp>
+
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+namespace json
+{
+
+namespace
+{
+// The base allocator has no state, a single instance is shared by all the arena allocators
+rapidjson::CrtAllocator g_baseAllocator {};
+
+// The allocator is placed at the start of the chunk, the rest of the chunk is its first buffer
+constexpr std::size_t BUFFER_OFFSET =
+    (sizeof(Arena::Allocator) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+
+// Room needed by the allocator bookkeeping inside the buffer
+constexpr std::size_t MIN_BUFFER_SIZE = 256;
+
+// Arena installed in the current thread, if any
+thread_local Arena* g_currentArena {nullptr};
+} // namespace
+
+void Arena::Release::operator()(Allocator* allocator) const
+{
+    // Frees the overflow chunks the allocator took from the base allocator
+    allocator->~Allocator();
+    arena->recycle(allocator);
+}
+
+Arena::Scope::Scope(const std::shared_ptr<Arena>& arena)
+    : m_previous {g_currentArena}
+{
+    g_currentArena = arena.get();
+}
+
+Arena::Scope::~Scope()
+{
+    g_currentArena = m_previous;
+}
+
+std::shared_ptr<Arena> Arena::create(std::size_t chunkSize, std::size_t maxFreeChunks)
+{
+    if (chunkSize < BUFFER_OFFSET + MIN_BUFFER_SIZE)
+    {
+        throw std::runtime_error(fmt::format(
+            "Arena chunk size must be at least {} bytes, got {}", BUFFER_OFFSET + MIN_BUFFER_SIZE, chunkSize));
+    }
+
+    return std::shared_ptr<Arena>(new Arena(chunkSize, maxFreeChunks));
+}
+
+Arena::Lease Arena::leaseCurrent()
+{
+    if (g_currentArena == nullptr)
+    {
+        return Lease {nullptr, Release {}};
+    }
+
+    return g_currentArena->lease();
+}
+
+Arena::Arena(std::size_t chunkSize, std::size_t maxFreeChunks)
+    : m_chunkSize {chunkSize}
+    , m_maxFreeChunks {maxFreeChunks}
+    , m_mutex {}
+    , m_free {}
+{
+}
+
+Arena::~Arena()
+{
+    for (auto* chunk : m_free)
+    {
+        std::free(chunk);
+    }
+}
+
+Arena::Lease Arena::lease()
+{
+    void* chunk {nullptr};
+    {
+        std::lock_guard<std::mutex> lock {m_mutex};
+        if (!m_free.empty())
+        {
+            chunk = m_free.back();
+            m_free.pop_back();
+        }
+    }
+
+    if (chunk == nullptr)
+    {
+        chunk = std::malloc(m_chunkSize);
+        if (chunk == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+    }
+
+    auto* buffer = static_cast<char*>(chunk) + BUFFER_OFFSET;
+    auto* allocator = new (chunk)
+        Allocator(buffer, m_chunkSize - BUFFER_OFFSET, Allocator::kDefaultChunkCapacity, &g_baseAllocator);
+
+    return Lease {allocator, Release {shared_from_this()}};
+}
+
+void Arena::recycle(void* chunk)
+{
+    {
+        std::lock_guard<std::mutex> lock {m_mutex};
+        if (m_free.size() < m_maxFreeChunks)
+        {
+            m_free.push_back(chunk);
+            return;
+        }
+    }
+
+    std::free(chunk);
+}
+
+std::size_t Arena::freeChunks() const
+{
+    std::lock_guard<std::mutex> lock {m_mutex};
+    return m_free.size();
+}
+
+} // namespace json
@@ -1,6 +1,9 @@
 #include <json/json.hpp>
 
+#include <cstring>
 #include <exception>
+#include <limits>
+#include <type_traits>
 #include <unordered_set>
 
 #include "rapidjson/schema.h"
@@ -12,19 +15,409 @@ namespace
 {
 constexpr auto INVALID_POINTER_TYPE_MSG = "Invalid pointer path '{}'";
 constexpr auto PATH_NOT_FOUND_MSG = "Path '{}' not found";
+
+/**
+ * @brief Check if one of the pointer paths is the other one or one of its ancestors.
+ */
+bool pathsOverlap(std::string_view lhs, std::string_view rhs)
+{
+    const auto isWithin = [](std::string_view path, std::string_view ancestor)
+    {
+        return path.substr(0, ancestor.size()) == ancestor
+               && (path.size() == ancestor.size() || path[ancestor.size()] == '/');
+    };
+
+    return isWithin(lhs, rhs) || isWithin(rhs, lhs);
+}
+
+/**
+ * @brief Check that merging the source into the destination never meets two values of different types.
+ *
+ * A recursive merge looks into the members that are objects or arrays in both values, so the whole merge can be
+ * checked before modifying anything.
+ */
+bool canMerge(const bool isRecursive, const rapidjson::Value& source, const rapidjson::Value& destination)
+{
+    if (source.GetType() != destination.GetType())
+    {
+        return false;
+    }
+
+    if (isRecursive && destination.IsObject())
+    {
+        for (auto srcIt = source.MemberBegin(); srcIt != source.MemberEnd(); ++srcIt)
+        {
+            if (!srcIt->value.IsObject() && !srcIt->value.IsArray())
+            {
+                continue;
+            }
+
+            const auto dstIt = destination.FindMember(srcIt->name);
+            if (dstIt != destination.MemberEnd() && !canMerge(isRecursive, srcIt->value, dstIt->value))
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Find the destination of a merge and check that the source can be merged into it.
+ *
+ * @throws std::runtime_error If the path is invalid or not found, or the values can't be merged.
+ */
+rapidjson::Value& getMergeDestination(const bool isRecursive,
+                                      rapidjson::Document& document,
+                                      const rapidjson::Value& source,
+                                      std::string_view path)
+{
+    const auto pp = rapidjson::Pointer(path.data(), path.size());
+    if (!pp.IsValid())
+    {
+        throw std::runtime_error(fmt::format(INVALID_POINTER_TYPE_MSG, path));
+    }
+
+    auto* dstValue = pp.Get(document);
+    if (!dstValue)
+    {
+        throw std::runtime_error(fmt::format(PATH_NOT_FOUND_MSG, path));
+    }
+
+    if (dstValue->GetType() != source.GetType())
+    {
+        throw std::runtime_error("JSON objects of different types cannot be merged");
+    }
+
+    if (!dstValue->IsObject() && !dstValue->IsArray())
+    {
+        throw std::runtime_error("JSON elements must be both either objects or arrays to be merged");
+    }
+
+    if (!canMerge(isRecursive, source, *dstValue))
+    {
+        throw std::runtime_error("JSON objects of different types cannot be merged");
+    }
+
+    return *dstValue;
+}
+
+/**
+ * @brief Merge the source value into the destination value, moving or copying the source members.
+ *
+ * Objects are merged, arrays are appended with the values they don't contain yet. The values must have been checked
+ * with canMerge.
+ * @tparam Move Move the source members instead of copying them, the source is left unusable.
+ */
+template<bool Move>
+void mergeInto(const bool isRecursive,
+               std::conditional_t<Move, rapidjson::Value&, const rapidjson::Value&> source,
+               rapidjson::Value& destination,
+               rapidjson::Document::AllocatorType& allocator)
+{
+    const auto take = [&allocator](rapidjson::Value& to, auto& from)
+    {
+        if constexpr (Move)
+        {
+            to = from; // Moves
+        }
+        else
+        {
+            to.CopyFrom(from, allocator);
+        }
+    };
+
+    if (destination.IsObject())
+    {
+        for (auto srcIt = source.MemberBegin(); srcIt != source.MemberEnd(); ++srcIt)
+        {
+            const auto dstIt = destination.FindMember(srcIt->name);
+            if (dstIt != destination.MemberEnd())
+            {
+                if (isRecursive && (srcIt->value.IsObject() || srcIt->value.IsArray()))
+                {
+                    mergeInto<Move>(isRecursive, srcIt->value, dstIt->value, allocator);
+                }
+                else
+                {
+                    take(dstIt->value, srcIt->value);
+                }
+            }
+            else
+            {
+                rapidjson::Value name;
+                rapidjson::Value value;
+                take(name, srcIt->name);
+                take(value, srcIt->value);
+                destination.AddMember(name, value, allocator);
+            }
+        }
+    }
+    else
+    {
+        for (auto srcIt = source.Begin(); srcIt != source.End(); ++srcIt)
+        {
+            // Find if value is already in dstValue
+            // TODO: this is inefficient, but rapidjson does not provide a way
+            // to do it.
+            auto found = false;
+            for (auto dstIt = destination.Begin(); dstIt != destination.End(); ++dstIt)
+            {
+                if (*dstIt == *srcIt)
+                {
+                    found = true;
+                    break;
+                }
+            }
+            if (!found)
+            {
+                rapidjson::Value value;
+                take(value, *srcIt);
+                destination.PushBack(value, allocator);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Binary encoding of a Json: the magic byte followed by the root value.
+ *
+ * Each value is a tag byte followed by its payload: integers as (zigzag) varints, doubles as their 8 bytes in little
+ * endian order, strings as a varint length and their bytes, arrays as a varint count and their values, and objects
+ * as a varint count and their keys (as strings without tag) and values.
+ */
+constexpr uint8_t BINARY_MAGIC = 0xF5; ///< Not valid in UTF-8, so never the first byte of a JSON text
+constexpr std::size_t BINARY_MAX_DEPTH = 512;
+
+enum class BinaryTag : uint8_t
+{
+    Null,
+    False,
+    True,
+    Int,
+    Uint,
+    Double,
+    String,
+    Array,
+    Object
+};
+
+void putVarint(std::string& out, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        out.push_back(static_cast<char>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+void putString(std::string& out, const char* str, rapidjson::SizeType length)
+{
+    putVarint(out, length);
+    out.append(str, length);
+}
+
+void encodeValue(const rapidjson::Value& value, std::string& out)
+{
+    switch (value.GetType())
+    {
+        case rapidjson::kNullType: out.push_back(static_cast<char>(BinaryTag::Null)); break;
+        case rapidjson::kFalseType: out.push_back(static_cast<char>(BinaryTag::False)); break;
+        case rapidjson::kTrueType: out.push_back(static_cast<char>(BinaryTag::True)); break;
+        case rapidjson::kNumberType:
+            if (value.IsDouble())
+            {
+                const auto number = value.GetDouble();
+                uint64_t bits {0};
+                std::memcpy(&bits, &number, sizeof(bits));
+                out.push_back(static_cast<char>(BinaryTag::Double));
+                for (auto i = 0; i < 8; ++i)
+                {
+                    out.push_back(static_cast<char>(bits >> (8 * i)));
+                }
+            }
+            else if (value.IsInt64())
+            {
+                const auto number = value.GetInt64();
+                out.push_back(static_cast<char>(BinaryTag::Int));
+                putVarint(out, (static_cast<uint64_t>(number) << 1) ^ static_cast<uint64_t>(number >> 63));
+            }
+            else
+            {
+                out.push_back(static_cast<char>(BinaryTag::Uint));
+                putVarint(out, value.GetUint64());
+            }
+            break;
+        case rapidjson::kStringType:
+            out.push_back(static_cast<char>(BinaryTag::String));
+            putString(out, value.GetString(), value.GetStringLength());
+            break;
+        case rapidjson::kArrayType:
+            out.push_back(static_cast<char>(BinaryTag::Array));
+            putVarint(out, value.Size());
+            for (const auto& item : value.GetArray())
+            {
+                encodeValue(item, out);
+            }
+            break;
+        case rapidjson::kObjectType:
+            out.push_back(static_cast<char>(BinaryTag::Object));
+            putVarint(out, value.MemberCount());
+            for (const auto& member : value.GetObject())
+            {
+                putString(out, member.name.GetString(), member.name.GetStringLength());
+                encodeValue(member.value, out);
+            }
+            break;
+    }
+}
+
+/**
+ * @brief Generator for rapidjson::Document::Populate, replaying the binary encoding as SAX events.
+ */
+class BinaryReader
+{
+private:
+    std::string_view m_data;
+    std::size_t m_pos;
+    bool m_decoded;
+
+    bool varint(uint64_t& value)
+    {
+        value = 0;
+        for (auto shift = 0; shift < 64; shift += 7)
+        {
+            if (m_pos >= m_data.size())
+            {
+                return false;
+            }
+            const auto byte = static_cast<uint8_t>(m_data[m_pos++]);
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool string(const char*& str, rapidjson::SizeType& length)
+    {
+        uint64_t size {0};
+        if (!varint(size) || size > m_data.size() - m_pos || size > std::numeric_limits<rapidjson::SizeType>::max())
+        {
+            return false;
+        }
+        str = m_data.data() + m_pos;
+        length = static_cast<rapidjson::SizeType>(size);
+        m_pos += size;
+        return true;
+    }
+
+    template<typename Handler>
+    bool value(Handler& handler, std::size_t depth)
+    {
+        if (m_pos >= m_data.size() || depth > BINARY_MAX_DEPTH)
+        {
+            return false;
+        }
+
+        uint64_t number {0};
+        const char* str {nullptr};
+        rapidjson::SizeType length {0};
+        switch (static_cast<BinaryTag>(m_data[m_pos++]))
+        {
+            case BinaryTag::Null: return handler.Null();
+            case BinaryTag::False: return handler.Bool(false);
+            case BinaryTag::True: return handler.Bool(true);
+            case BinaryTag::Int:
+                return varint(number)
+                       && handler.Int64(static_cast<int64_t>(number >> 1) ^ -static_cast<int64_t>(number & 1));
+            case BinaryTag::Uint: return varint(number) && handler.Uint64(number);
+            case BinaryTag::Double:
+            {
+                if (m_data.size() - m_pos < 8)
+                {
+                    return false;
+                }
+                for (auto i = 0; i < 8; ++i)
+                {
+                    number |= static_cast<uint64_t>(static_cast<uint8_t>(m_data[m_pos++])) << (8 * i);
+                }
+                double dbl {0};
+                std::memcpy(&dbl, &number, sizeof(dbl));
+                return handler.Double(dbl);
+            }
+            case BinaryTag::String: return string(str, length) && handler.String(str, length, true);
+            case BinaryTag::Array:
+            {
+                // Each value takes at least one byte, a larger count can only be a corrupted one
+                if (!varint(number) || number > m_data.size() - m_pos || !handler.StartArray())
+                {
+                    return false;
+                }
+                for (uint64_t i = 0; i < number; ++i)
+                {
+                    if (!value(handler, depth + 1))
+                    {
+                        return false;
+                    }
+                }
+                return handler.EndArray(static_cast<rapidjson::SizeType>(number));
+            }
+            case BinaryTag::Object:
+            {
+                if (!varint(number) || number > m_data.size() - m_pos || !handler.StartObject())
+                {
+                    return false;
+                }
+                for (uint64_t i = 0; i < number; ++i)
+                {
+                    if (!string(str, length) || !handler.Key(str, length, true) || !value(handler, depth + 1))
+                    {
+                        return false;
+                    }
+                }
+                return handler.EndObject(static_cast<rapidjson::SizeType>(number));
+            }
+            default: return false;
+        }
+    }
+
+public:
+    explicit BinaryReader(std::string_view data)
+        : m_data {data}
+        , m_pos {1}
+        , m_decoded {false}
+    {
+    }
+
+    template<typename Handler>
+    bool operator()(Handler& handler)
+    {
+        m_decoded = value(handler, 0) && m_pos == m_data.size();
+        return m_decoded;
+    }
+
+    bool decoded() const { return m_decoded; }
+};
 } // namespace
 
 namespace json
 {
 
 Json::Json(const rapidjson::Value& value)
-    : m_document {rapidjson::Document()}
+    : m_allocator {Arena::leaseCurrent()}
+    , m_document {m_allocator.get()}
 {
     m_document.CopyFrom(value, m_document.GetAllocator());
 }
 
 Json::Json(const rapidjson::GenericObject<true, rapidjson::Value>& object)
-    : m_document {rapidjson::Document()}
+    : m_allocator {Arena::leaseCurrent()}
+    , m_document {m_allocator.get()}
 {
     m_document.SetObject();
     for (auto& [key, value] : object)
@@ -35,7 +428,8 @@ Json::Json(const rapidjson::GenericObject<true, rapidjson::Value>& object)
 }
 
 Json::Json()
-    : m_document {rapidjson::Document()} {};
+    : m_allocator {Arena::leaseCurrent()}
+    , m_document {m_allocator.get()} {};
 
 Json::Json(rapidjson::Document&& document)
 {
@@ -43,7 +437,8 @@ Json::Json(rapidjson::Document&& document)
 }
 
 Json::Json(const char* json)
-    : m_document {rapidjson::Document()}
+    : m_allocator {Arena::leaseCurrent()}
+    , m_document {m_allocator.get()}
 {
     rapidjson::ParseResult result = m_document.Parse(json);
     if (!result)
@@ -60,7 +455,8 @@ Json::Json(const char* json)
 }
 
 Json::Json(const Json& other)
-    : m_document {}
+    : m_allocator {Arena::leaseCurrent()}
+    , m_document {m_allocator.get()}
 {
     m_document.CopyFrom(other.m_document, m_document.GetAllocator());
 }
@@ -123,55 +519,71 @@ std::string Json::formatJsonPath(std::string_view dotPath, bool skipDot)
 }
 
 Json::Json(Json&& other) noexcept
-    : m_document {std::move(other.m_document)}
+    : m_allocator {std::move(other.m_allocator)}
+    , m_document {std::move(other.m_document)}
 {
 }
 
 Json& Json::operator=(Json&& other) noexcept
 {
+    // The previous tree is dropped before its allocator is released
     m_document = std::move(other.m_document);
+    m_allocator = std::move(other.m_allocator);
     return *this;
 }
 
-bool Json::exists(std::string_view ptrPath) const
+void Json::reset()
+{
+    m_document.SetNull();
+    m_document.GetAllocator().Clear();
+}
+
+PointerPath::PointerPath()
+    : m_path {}
+    , m_pointer {std::make_shared<const rapidjson::Pointer>()}
+{
+}
+
+PointerPath::PointerPath(std::string_view pointerPath)
+    : m_path {pointerPath}
+    , m_pointer {std::make_shared<const rapidjson::Pointer>(m_path.c_str(), m_path.size())}
 {
-    const auto fieldPtr = rapidjson::Pointer(ptrPath.data());
-    if (fieldPtr.IsValid())
+    if (!m_pointer->IsValid())
     {
-        return fieldPtr.Get(m_document) != nullptr;
+        throw std::runtime_error(fmt::format(INVALID_POINTER_TYPE_MSG, m_path));
     }
+}
+
+bool Json::exists(std::string_view ptrPath) const
+{
+    return exists(PointerPath(ptrPath));
+}
 
-    throw std::runtime_error(fmt::format("..", __func__, ptrPath));
+bool Json::exists(const PointerPath& ptrPath) const
+{
+    return ptrPath.pointer().Get(m_document) != nullptr;
 }
 
 bool Json::equals(std::string_view ptrPath, const Json& value) const
 {
-    const auto fieldPtr = rapidjson::Pointer(ptrPath.data());
-    if (fieldPtr.IsValid())
-    {
-        const auto got {fieldPtr.Get(m_document)};
-        return (got && *got == value.m_document);
-    }
+    return equals(PointerPath(ptrPath), value);
+}
 
-    throw std::runtime_error(fmt::format(INVALID_POINTER_TYPE_MSG, ptrPath));
+bool Json::equals(const PointerPath& ptrPath, const Json& value) const
+{
+    const auto got {ptrPath.pointer().Get(m_document)};
+    return (got && *got == value.m_document);
 }
 
 bool Json::equals(std::string_view basePtrPath, std::string_view referencePtrPath) const
 {
-    const auto fieldPtr = rapidjson::Pointer(basePtrPath.data());
-    const auto referencePtr = rapidjson::Pointer(referencePtrPath.data());
-
-    if (!fieldPtr.IsValid())
-    {
-        throw std::runtime_error(fmt::format(INVALID_POINTER_TYPE_MSG, basePtrPath));
-    }
-    if (!referencePtr.IsValid())
-    {
-        throw std::runtime_error(fmt::format(INVALID_POINTER_TYPE_MSG, referencePtrPath));
-    }
+    return equals(PointerPath(basePtrPath), PointerPath(referencePtrPath));
+}
 
-    const auto fieldValue {fieldPtr.Get(m_document)};
-    const auto referenceValue {referencePtr.Get(m_document)};
+bool Json::equals(const PointerPath& basePtrPath, const PointerPath& referencePtrPath) const
+{
+    const auto fieldValue {basePtrPath.pointer().Get(m_document)};
+    const auto referenceValue {referencePtrPath.pointer().Get(m_document)};
 
     return (fieldValue && referenceValue && *fieldValue == *referenceValue);
 }
@@ -179,261 +591,221 @@ bool Json::equals(std::string_view basePtrPath, std::string_view referencePtrPat
 // TODO Invert parameters to be consistent with other methods.
 void Json::set(std::string_view ptrPath, const Json& value)
 {
-    const auto fieldPtr = rapidjson::Pointer(ptrPath.data());
-    if (fieldPtr.IsValid())
-    {
-        fieldPtr.Set(m_document, value.m_document);
-    }
-    else
-    {
-        throw std::runtime_error(fmt::format(INVALID_POINTER_TYPE_MSG, ptrPath));
-    }
+    set(PointerPath(ptrPath), value);
 }
 
-void Json::set(std::string_view basePtrPath, std::string_view referencePtrPath)
+void Json::set(const PointerPath& ptrPath, const Json& value)
 {
-    const auto fieldPtr = rapidjson::Pointer(basePtrPath.data());
-    const auto referencePtr = rapidjson::Pointer(referencePtrPath.data());
+    ptrPath.pointer().Set(m_document, value.m_document);
+}
 
-    if (!fieldPtr.IsValid())
-    {
-        throw std::runtime_error(fmt::format(INVALID_POINTER_TYPE_MSG, basePtrPath));
-    }
-    if (!referencePtr.IsValid())
-    {
-        throw std::runtime_error(fmt::format(INVALID_POINTER_TYPE_MSG, referencePtrPath));
-    }
+void Json::set(std::string_view basePtrPath, std::string_view referencePtrPath)
+{
+    set(PointerPath(basePtrPath), PointerPath(referencePtrPath));
+}
 
-    const auto* reference = referencePtr.Get(m_document);
+void Json::set(const PointerPath& basePtrPath, const PointerPath& referencePtrPath)
+{
+    const auto* reference = referencePtrPath.pointer().Get(m_document);
     if (reference)
     {
-        fieldPtr.Set(m_document, *reference);
+        basePtrPath.pointer().Set(m_document, *reference);
     }
     else
     {
-        fieldPtr.Set(m_document, rapidjson::Value());
+        basePtrPath.pointer().Set(m_document, rapidjson::Value());
     }
 }
 
 std::optional<std::string> Json::getString(std::string_view path) const
 {
-    std::optional<std::string> retval {std::nullopt};
-    const auto pp = rapidjson::Pointer(path.data());
+    return getString(PointerPath(path));
+}
 
-    if (pp.IsValid())
+std::optional<std::string> Json::getString(const PointerPath& path) const
+{
+    const auto* value = path.pointer().Get(m_document);
+    if (value && value->IsString())
     {
-        const auto* value = pp.Get(m_document);
-        if (value && value->IsString())
-        {
-            retval = std::string {value->GetString()};
-        }
-        return retval;
+        return std::string {value->GetString()};
     }
 
-    throw std::runtime_error(fmt::format(INVALID_POINTER_TYPE_MSG, path));
+    return std::nullopt;
 }
 
 std::optional<int> Json::getInt(std::string_view path) const
 {
-    std::optional<int> retval {std::nullopt};
-    const auto pp = rapidjson::Pointer(path.data());
+    return getInt(PointerPath(path));
+}
 
-    if (pp.IsValid())
+std::optional<int> Json::getInt(const PointerPath& path) const
+{
+    const auto* value = path.pointer().Get(m_document);
+    if (value && value->IsInt())
     {
-        const auto* value = pp.Get(m_document);
-        if (value && value->IsInt())
-        {
-            retval = value->GetInt();
-        }
-        return retval;
+        return value->GetInt();
     }
 
-    throw std::runtime_error(fmt::format(INVALID_POINTER_TYPE_MSG, path));
+    return std::nullopt;
 }
 
 std::optional<int64_t> Json::getInt64(std::string_view path) const
 {
-    auto pp = rapidjson::Pointer(path.data());
+    return getInt64(PointerPath(path));
+}
 
-    if (pp.IsValid())
-    {
-        const auto* value = pp.Get(m_document);
-        if (value && value->IsInt64())
-        {
-            return value->GetInt64();
-        }
-        else
-        {
-            return std::nullopt;
-        }
-    }
-    else
+std::optional<int64_t> Json::getInt64(const PointerPath& path) const
+{
+    const auto* value = path.pointer().Get(m_document);
+    if (value && value->IsInt64())
     {
-        throw std::runtime_error(fmt::format("[Json::get(basePointerPath)] Invalid json path: '{}'", path));
+        return value->GetInt64();
     }
+
+    return std::nullopt;
 }
 
 std::optional<int64_t> Json::getIntAsInt64(std::string_view path) const
 {
-    auto pp = rapidjson::Pointer(path.data());
+    return getIntAsInt64(PointerPath(path));
+}
 
-    if (pp.IsValid())
+std::optional<int64_t> Json::getIntAsInt64(const PointerPath& path) const
+{
+    const auto* value = path.pointer().Get(m_document);
+    if (value && value->IsInt64())
     {
-        const auto* value = pp.Get(m_document);
-        if (value && value->IsInt64())
-        {
-            return value->GetInt64();
-        }
-        else if (value && value->IsInt())
-        {
-            return static_cast<int64_t>(value->GetInt());
-        }
-        else
-        {
-            return std::nullopt;
-        }
+        return value->GetInt64();
     }
-    else
+    else if (value && value->IsInt())
     {
-        throw std::runtime_error(fmt::format("[Json::get(basePointerPath)] Invalid json path: '{}'", path));
+        return static_cast<int64_t>(value->GetInt());
     }
+
+    return std::nullopt;
 }
 
 std::optional<float_t> Json::getFloat(std::string_view path) const
 {
-    auto pp = rapidjson::Pointer(path.data());
+    return getFloat(PointerPath(path));
+}
 
-    if (pp.IsValid())
-    {
-        const auto* value = pp.Get(m_document);
-        if (value && value->IsFloat())
-        {
-            return value->GetFloat();
-        }
-        else
-        {
-            return std::nullopt;
-        }
-    }
-    else
+std::optional<float_t> Json::getFloat(const PointerPath& path) const
+{
+    const auto* value = path.pointer().Get(m_document);
+    if (value && value->IsFloat())
     {
-        throw std::runtime_error(fmt::format("[Json::get(basePointerPath)] Invalid json path: '{}'", path));
+        return value->GetFloat();
     }
+
+    return std::nullopt;
 }
 
 std::optional<double_t> Json::getDouble(std::string_view path) const
 {
-    std::optional<double> retval {std::nullopt};
-    const auto pp = rapidjson::Pointer(path.data());
+    return getDouble(PointerPath(path));
+}
 
-    if (pp.IsValid())
+std::optional<double_t> Json::getDouble(const PointerPath& path) const
+{
+    const auto* value = path.pointer().Get(m_document);
+    if (value && value->IsDouble())
     {
-        const auto* value = pp.Get(m_document);
-        if (value && value->IsDouble())
-        {
-            retval = value->GetDouble();
-        }
-        return retval;
+        return value->GetDouble();
     }
 
-    throw std::runtime_error(fmt::format(INVALID_POINTER_TYPE_MSG, path));
+    return std::nullopt;
 }
 
 std::optional<double> Json::getNumberAsDouble(std::string_view path) const
+{
+    return getNumberAsDouble(PointerPath(path));
+}
+
+std::optional<double> Json::getNumberAsDouble(const PointerPath& path) const
 {
     std::optional<double> retval {std::nullopt};
-    const auto pp = rapidjson::Pointer(path.data());
 
-    if (pp.IsValid())
+    const auto* value = path.pointer().Get(m_document);
+    if (value && value->IsNumber())
     {
-        const auto* value = pp.Get(m_document);
-        if (value && value->IsNumber())
+        if (value->IsInt())
         {
-            if (value->IsInt())
-            {
-                retval = static_cast<double>(value->GetInt());
-            }
-            else if (value->IsInt64())
-            {
-                retval = static_cast<double>(value->GetInt64());
-            }
-            else if (value->IsDouble())
-            {
-                retval = value->GetDouble();
-            }
-            else if (value->IsFloat())
-            {
-                retval = value->GetFloat();
-            }
+            retval = static_cast<double>(value->GetInt());
+        }
+        else if (value->IsInt64())
+        {
+            retval = static_cast<double>(value->GetInt64());
+        }
+        else if (value->IsDouble())
+        {
+            retval = value->GetDouble();
+        }
+        else if (value->IsFloat())
+        {
+            retval = value->GetFloat();
         }
-        return retval;
     }
 
-    throw std::runtime_error(fmt::format(INVALID_POINTER_TYPE_MSG, path));
+    return retval;
 }
 
 std::optional<bool> Json::getBool(std::string_view path) const
 {
-    std::optional<bool> retval {std::nullopt};
-    const auto pp = rapidjson::Pointer(path.data());
+    return getBool(PointerPath(path));
+}
 
-    if (pp.IsValid())
+std::optional<bool> Json::getBool(const PointerPath& path) const
+{
+    const auto* value = path.pointer().Get(m_document);
+    if (value && value->IsBool())
     {
-        const auto* value = pp.Get(m_document);
-        if (value && value->IsBool())
-        {
-            retval = value->GetBool();
-        }
-        return retval;
+        return value->GetBool();
     }
 
-    throw std::runtime_error(fmt::format(INVALID_POINTER_TYPE_MSG, path));
+    return std::nullopt;
 }
 
 std::optional<std::vector<Json>> Json::getArray(std::string_view path) const
 {
-    std::optional<std::vector<Json>> retval {std::nullopt};
-    const auto pp = rapidjson::Pointer(path.data());
+    return getArray(PointerPath(path));
+}
 
-    if (pp.IsValid())
+std::optional<std::vector<Json>> Json::getArray(const PointerPath& path) const
+{
+    const auto* value = path.pointer().Get(m_document);
+    if (value && value->IsArray())
     {
-        const auto* value = pp.Get(m_document);
-        if (value && value->IsArray())
+        std::vector<Json> result;
+        for (const auto& item : value->GetArray())
         {
-            std::vector<Json> result;
-            for (const auto& item : value->GetArray())
-            {
-                result.push_back(Json(item));
-            }
-            retval = std::move(result);
+            result.push_back(Json(item));
         }
-        return retval;
+        return result;
     }
 
-    throw std::runtime_error(fmt::format(INVALID_POINTER_TYPE_MSG, path));
+    return std::nullopt;
 }
 
 std::optional<std::vector<std::tuple<std::string, Json>>> Json::getObject(std::string_view path) const
 {
-    std::optional<std::vector<std::tuple<std::string, Json>>> retval {std::nullopt};
-    const auto pp = rapidjson::Pointer(path.data());
+    return getObject(PointerPath(path));
+}
 
-    if (pp.IsValid())
+std::optional<std::vector<std::tuple<std::string, Json>>> Json::getObject(const PointerPath& path) const
+{
+    const auto* value = path.pointer().Get(m_document);
+    if (value && value->IsObject())
     {
-        const auto* value = pp.Get(m_document);
-        if (value && value->IsObject())
+        std::vector<std::tuple<std::string, Json>> result;
+        for (auto& [key, value] : value->GetObject())
         {
-            std::vector<std::tuple<std::string, Json>> result;
-            for (auto& [key, value] : value->GetObject())
-            {
-                result.emplace_back(std::make_tuple(key.GetString(), Json(value)));
-            }
-            retval = std::move(result);
+            result.emplace_back(std::make_tuple(key.GetString(), Json(value)));
         }
-        return retval;
+        return result;
     }
 
-    throw std::runtime_error(fmt::format(INVALID_POINTER_TYPE_MSG, path));
+    return std::nullopt;
 }
 
 std::string Json::prettyStr() const
@@ -453,6 +825,37 @@ std::string Json::str() const
     return buffer.GetString();
 }
 
+std::string Json::binary() const
+{
+    std::string out;
+    out.push_back(static_cast<char>(BINARY_MAGIC));
+    encodeValue(m_document, out);
+    return out;
+}
+
+bool Json::isBinary(std::string_view data)
+{
+    return !data.empty() && static_cast<uint8_t>(data[0]) == BINARY_MAGIC;
+}
+
+Json Json::fromBinary(std::string_view data)
+{
+    if (!isBinary(data))
+    {
+        throw std::runtime_error("Binary JSON document could not be decoded: missing header");
+    }
+
+    Json json;
+    BinaryReader reader {data};
+    json.m_document.Populate(reader);
+    if (!reader.decoded())
+    {
+        throw std::runtime_error("Binary JSON document could not be decoded: truncated or corrupted data");
+    }
+
+    return json;
+}
+
 std::optional<std::string> Json::str(std::string_view path) const
 {
     std::optional<std::string> retval {std::nullopt};
@@ -781,121 +1184,94 @@ Json::Type Json::type(std::string_view path) const
 
 void Json::setNull(std::string_view path)
 {
-    const auto pp = rapidjson::Pointer(path.data());
-
-    if (pp.IsValid())
-    {
-        pp.Set(m_document, rapidjson::Value().SetNull());
-        return;
-    }
+    setNull(PointerPath(path));
+}
 
-    throw std::runtime_error(fmt::format(INVALID_POINTER_TYPE_MSG, path));
+void Json::setNull(const PointerPath& path)
+{
+    path.pointer().Set(m_document, rapidjson::Value().SetNull());
 }
 
 void Json::setBool(bool value, std::string_view path)
 {
-    const auto pp = rapidjson::Pointer(path.data());
-
-    if (pp.IsValid())
-    {
-        pp.Set(m_document, value);
-        return;
-    }
+    setBool(value, PointerPath(path));
+}
 
-    throw std::runtime_error(fmt::format(INVALID_POINTER_TYPE_MSG, path));
+void Json::setBool(bool value, const PointerPath& path)
+{
+    path.pointer().Set(m_document, value);
 }
 
 void Json::setInt(int value, std::string_view path)
 {
-    const auto pp = rapidjson::Pointer(path.data());
-
-    if (pp.IsValid())
-    {
-        pp.Set(m_document, value);
-        return;
-    }
+    setInt(value, PointerPath(path));
+}
 
-    throw std::runtime_error(fmt::format(INVALID_POINTER_TYPE_MSG, path));
+void Json::setInt(int value, const PointerPath& path)
+{
+    path.pointer().Set(m_document, value);
 }
 
 void Json::setInt64(int64_t value, std::string_view path)
 {
-    auto pp = rapidjson::Pointer(path.data());
+    setInt64(value, PointerPath(path));
+}
 
-    if (pp.IsValid())
-    {
-        pp.Set(m_document, value);
-    }
-    else
-    {
-        throw std::runtime_error(fmt::format("[Json::setInt(basePointerPath)] Invalid json path: '{}'", path));
-    }
+void Json::setInt64(int64_t value, const PointerPath& path)
+{
+    path.pointer().Set(m_document, value);
 }
 
 void Json::setFloat(float_t value, std::string_view path)
 {
-    auto pp = rapidjson::Pointer(path.data());
+    setFloat(value, PointerPath(path));
+}
 
-    if (pp.IsValid())
-    {
-        pp.Set(m_document, value);
-    }
-    else
-    {
-        throw std::runtime_error(fmt::format("[Json::setDouble(basePointerPath)] Invalid json path: '{}'", path));
-    }
+void Json::setFloat(float_t value, const PointerPath& path)
+{
+    path.pointer().Set(m_document, value);
 }
 
 void Json::setDouble(double_t value, std::string_view path)
 {
-    const auto pp = rapidjson::Pointer(path.data());
-
-    if (pp.IsValid())
-    {
-        pp.Set(m_document, value);
-        return;
-    }
+    setDouble(value, PointerPath(path));
+}
 
-    throw std::runtime_error(fmt::format(INVALID_POINTER_TYPE_MSG, path));
+void Json::setDouble(double_t value, const PointerPath& path)
+{
+    path.pointer().Set(m_document, value);
 }
 
 void Json::setString(std::string_view value, std::string_view path)
 {
-    const auto pp = rapidjson::Pointer(path.data());
-
-    if (pp.IsValid())
-    {
-        pp.Set(m_document, std::string(value).c_str());
-        return;
-    }
+    setString(value, PointerPath(path));
+}
 
-    throw std::runtime_error(fmt::format(INVALID_POINTER_TYPE_MSG, path));
+void Json::setString(std::string_view value, const PointerPath& path)
+{
+    // Copy the value once, straight into the document allocator
+    rapidjson::Value strValue(value.data(), static_cast<rapidjson::SizeType>(value.size()), m_document.GetAllocator());
+    path.pointer().Set(m_document, strValue);
 }
 
 void Json::setArray(std::string_view path)
 {
-    const auto pp = rapidjson::Pointer(path.data());
-
-    if (pp.IsValid())
-    {
-        pp.Set(m_document, rapidjson::Value().SetArray());
-        return;
-    }
+    setArray(PointerPath(path));
+}
 
-    throw std::runtime_error(fmt::format(INVALID_POINTER_TYPE_MSG, path));
+void Json::setArray(const PointerPath& path)
+{
+    path.pointer().Set(m_document, rapidjson::Value().SetArray());
 }
 
 void Json::setObject(std::string_view path)
 {
-    const auto pp = rapidjson::Pointer(path.data());
-
-    if (pp.IsValid())
-    {
-        pp.Set(m_document, rapidjson::Value().SetObject());
-        return;
-    }
+    setObject(PointerPath(path));
+}
 
-    throw std::runtime_error(fmt::format(INVALID_POINTER_TYPE_MSG, path));
+void Json::setObject(const PointerPath& path)
+{
+    path.pointer().Set(m_document, rapidjson::Value().SetObject());
 }
 
 void Json::appendString(std::string_view value, std::string_view path)
@@ -988,95 +1364,71 @@ bool Json::erase(std::string_view path)
 
 void Json::merge(const bool isRecursive, const rapidjson::Value& source, std::string_view path)
 {
-    const auto pp = rapidjson::Pointer(path.data());
+    mergeInto<false>(isRecursive, source, getMergeDestination(isRecursive, m_document, source, path), m_document.GetAllocator());
+}
 
-    if (pp.IsValid())
+void Json::merge(const bool isRecursive, rapidjson::Value&& source, std::string_view path)
+{
+    mergeInto<true>(isRecursive, source, getMergeDestination(isRecursive, m_document, source, path), m_document.GetAllocator());
+}
+
+void Json::merge(const bool isRecursive, const Json& other, std::string_view path)
+{
+    if (&other == this)
     {
-        auto* dstValue = pp.Get(m_document);
-        if (dstValue)
-        {
-            if (dstValue->GetType() == source.GetType())
-            {
-                if (dstValue->IsObject())
-                {
-                    for (auto srcIt = source.MemberBegin(); srcIt != source.MemberEnd(); ++srcIt)
-                    {
-                        if (dstValue->HasMember(srcIt->name))
-                        {
-                            rapidjson::Value cpyValue {srcIt->value, m_document.GetAllocator()};
-                            if (isRecursive && (srcIt->value.IsObject() || srcIt->value.IsArray()))
-                            {
-                                std::string newPath {std::string(path) + "/" + srcIt->name.GetString()};
-                                merge(isRecursive, cpyValue, newPath);
-                            }
-                            else
-                            {
-                                dstValue->FindMember(srcIt->name)->value = cpyValue;
-                            }
-                        }
-                        else
-                        {
-                            rapidjson::Value cpyValue {srcIt->value, m_document.GetAllocator()};
-                            rapidjson::Value cpyName {srcIt->name, m_document.GetAllocator()};
-                            dstValue->AddMember(cpyName, cpyValue, m_document.GetAllocator());
-                        }
-                    }
-                }
-                else if (dstValue->IsArray())
-                {
-                    for (auto srcIt = source.Begin(); srcIt != source.End(); ++srcIt)
-                    {
-                        // Find if value is already in dstValue
-                        // TODO: this is inefficient, but rapidjson does not provide a way
-                        // to do it.
-                        auto found = false;
-                        for (auto dstIt = dstValue->Begin(); dstIt != dstValue->End(); ++dstIt)
-                        {
-                            if (*dstIt == *srcIt)
-                            {
-                                found = true;
-                                break;
-                            }
-                        }
-                        if (!found)
-                        {
-                            rapidjson::Value cpyValue {*srcIt, m_document.GetAllocator()};
-                            dstValue->PushBack(cpyValue, m_document.GetAllocator());
-                        }
-                    }
-                }
-                else
-                {
-                    throw std::runtime_error("JSON elements must be both either objects or arrays to be merged");
-                }
+        // The destination is part of the source
+        rapidjson::Value copy {m_document, m_document.GetAllocator()};
+        merge(isRecursive, std::move(copy), path);
+        return;
+    }
 
-                return;
-            }
+    merge(isRecursive, other.m_document, path);
+}
 
-            throw std::runtime_error("JSON objects of different types cannot be merged");
-        }
+void Json::merge(const bool isRecursive, const Json& other, std::string_view otherPath, std::string_view path)
+{
+    const auto pp = rapidjson::Pointer(otherPath.data(), otherPath.size());
+    if (!pp.IsValid())
+    {
+        throw std::runtime_error(fmt::format(INVALID_POINTER_TYPE_MSG, otherPath));
+    }
 
-        throw std::runtime_error(fmt::format(PATH_NOT_FOUND_MSG, path));
+    const auto* srcValue = pp.Get(other.m_document);
+    if (!srcValue)
+    {
+        throw std::runtime_error(fmt::format(PATH_NOT_FOUND_MSG, otherPath));
     }
 
-    throw std::runtime_error(fmt::format(INVALID_POINTER_TYPE_MSG, path));
-}
+    if (&other == this && pathsOverlap(otherPath, path))
+    {
+        rapidjson::Value copy {*srcValue, m_document.GetAllocator()};
+        merge(isRecursive, std::move(copy), path);
+        return;
+    }
 
-void Json::merge(const bool isRecursive, const Json& other, std::string_view path)
-{
-    merge(isRecursive, other.m_document, path);
+    merge(isRecursive, *srcValue, path);
 }
 
 void Json::merge(const bool isRecursive, std::string_view source, std::string_view path)
 {
-    const auto pp = rapidjson::Pointer(source.data());
+    const auto pp = rapidjson::Pointer(source.data(), source.size());
 
     if (pp.IsValid())
     {
         auto* srcValue = pp.Get(m_document);
         if (srcValue)
         {
-            merge(isRecursive, *srcValue, path);
+            // The source is deleted after the merge, so its members are moved instead of copied unless moving them
+            // would reallocate the source while it is read
+            if (pathsOverlap(source, path))
+            {
+                rapidjson::Value copy {*srcValue, m_document.GetAllocator()};
+                merge(isRecursive, std::move(copy), path);
+            }
+            else
+            {
+                merge(isRecursive, std::move(*srcValue), path);
+            }
             erase(source);
             return;
         }
@@ -1089,20 +1441,18 @@ void Json::merge(const bool isRecursive, std::string_view source, std::string_vi
 
 std::optional<Json> Json::getJson(std::string_view path) const
 {
-    std::optional<Json> retval {std::nullopt};
-    const auto pp = rapidjson::Pointer(path.data());
+    return getJson(PointerPath(path));
+}
 
-    if (pp.IsValid())
+std::optional<Json> Json::getJson(const PointerPath& path) const
+{
+    const auto* val = path.pointer().Get(m_document);
+    if (val)
     {
-        auto* val = pp.Get(m_document);
-        if (val)
-        {
-            retval = Json(*val);
-        }
-        return retval;
+        return Json(*val);
     }
 
-    throw std::runtime_error(fmt::format(INVALID_POINTER_TYPE_MSG, path));
+    return std::nullopt;
 }
 
 std::optional<base::Error> Json::validate(const Json& schema) const
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+
+#include <json/arena.hpp>
+#include <json/json.hpp>
+
+using namespace json;
+
+TEST(ArenaTest, Create)
+{
+    ASSERT_THROW(Arena::create(16), std::runtime_error);
+
+    auto arena = Arena::create(4096, 2);
+    ASSERT_EQ(arena->chunkSize(), 4096);
+    ASSERT_EQ(arena->freeChunks(), 0);
+}
+
+TEST(ArenaTest, LeaseRecyclesChunks)
+{
+    auto arena = Arena::create(4096, 2);
+    void* first {nullptr};
+    {
+        auto lease = arena->lease();
+        first = lease.get();
+        lease->Malloc(128);
+    }
+    ASSERT_EQ(arena->freeChunks(), 1);
+
+    {
+        auto lease = arena->lease();
+        ASSERT_EQ(lease.get(), first);
+        ASSERT_EQ(arena->freeChunks(), 0);
+
+        // The chunks over the limit are released
+        auto lease2 = arena->lease();
+        auto lease3 = arena->lease();
+    }
+    ASSERT_EQ(arena->freeChunks(), 2);
+}
+
+TEST(ArenaTest, NoArenaInstalled)
+{
+    ASSERT_FALSE(Arena::leaseCurrent());
+}
+
+TEST(ArenaTest, DocumentsUseTheThreadArena)
+{
+    auto arena = Arena::create(4096, 8);
+    {
+        Arena::Scope scope {arena};
+        ASSERT_TRUE(Arena::leaseCurrent());
+
+        Json doc {R"({"key": "value"})"};
+        doc.setString(std::string(8192, 'a'), "/big");
+        Json copy {doc};
+        ASSERT_EQ(arena->freeChunks(), 0);
+        ASSERT_EQ(copy, doc);
+    }
+    ASSERT_EQ(arena->freeChunks(), 2);
+    ASSERT_FALSE(Arena::leaseCurrent());
+}
+
+TEST(ArenaTest, DocumentsOutliveTheScope)
+{
+    Json doc;
+    {
+        auto arena = Arena::create(4096, 8);
+        Arena::Scope scope {arena};
+        Json tmp {R"({"key": "value"})"};
+        doc = std::move(tmp);
+    }
+
+    // The arena is kept alive by the chunk of the document, which can be released from another thread
+    ASSERT_EQ(doc.getString("/key"), "value");
+    std::thread([doc = std::move(doc)]() mutable { doc.setString("other", "/key"); }).join();
+}
+
+TEST(ArenaTest, NestedScopes)
+{
+    auto outer = Arena::create(4096, 8);
+    auto inner = Arena::create(4096, 8);
+
+    Arena::Scope outerScope {outer};
+    {
+        Arena::Scope innerScope {inner};
+        Json doc {R"({"key": "value"})"};
+    }
+    ASSERT_EQ(inner->freeChunks(), 1);
+
+    {
+        Json doc {R"({"key": "value"})"};
+    }
+    ASSERT_EQ(outer->freeChunks(), 1);
+}
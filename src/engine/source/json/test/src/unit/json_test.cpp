@@ -2172,6 +2172,70 @@ TEST_F(JsonSettersTest, MergeRefFailCases)
     ASSERT_THROW(jObjDst.merge(json::NOT_RECURSIVE, "/to_merge_obj", "/key1"), std::runtime_error);
 }
 
+TEST_F(JsonSettersTest, MergeRecursiveRefFailKeepsValues)
+{
+    Json jObjDst {R"({
+        "key1": {"key2": {"key3": "value3"}},
+        "to_merge": {"key0": "value0", "key1": {"key2": ["value4"]}}
+    })"};
+    const Json jObjExpected {jObjDst};
+
+    // Nested different types, nothing is moved
+    ASSERT_THROW(jObjDst.merge(json::RECURSIVE, "/to_merge"), std::runtime_error);
+    ASSERT_EQ(jObjDst, jObjExpected);
+}
+
+TEST_F(JsonSettersTest, MergeOtherPath)
+{
+    Json jObjDst {R"({
+        "key1": "value1",
+        "key2": {"key3": "value3"}
+    })"};
+
+    const Json jObjSrc {R"({
+        "source": {"key1": "newValue1", "key2": {"key4": "newValue4"}}
+    })"};
+
+    Json jObjExpected {R"({
+        "key1": "newValue1",
+        "key2": {"key3": "value3", "key4": "newValue4"}
+    })"};
+
+    ASSERT_NO_THROW(jObjDst.merge(json::RECURSIVE, jObjSrc, "/source", ""));
+    ASSERT_EQ(jObjDst, jObjExpected);
+    ASSERT_TRUE(jObjSrc.exists("/source/key2/key4"));
+
+    ASSERT_THROW(jObjDst.merge(json::RECURSIVE, jObjSrc, "/not_found", ""), std::runtime_error);
+    ASSERT_THROW(jObjDst.merge(json::RECURSIVE, jObjSrc, "/source", "/key1"), std::runtime_error);
+}
+
+TEST_F(JsonSettersTest, MergeSameDocumentPath)
+{
+    Json jObj {R"({
+        "key1": {"key2": "value2"},
+        "source": {"key3": "value3"}
+    })"};
+
+    Json jObjExpected {R"({
+        "key1": {"key2": "value2", "key3": "value3"},
+        "source": {"key3": "value3"}
+    })"};
+
+    // The source is kept
+    ASSERT_NO_THROW(jObj.merge(json::NOT_RECURSIVE, jObj, "/source", "/key1"));
+    ASSERT_EQ(jObj, jObjExpected);
+
+    jObjExpected = Json {R"({
+        "key1": {"key2": "value2", "key3": "value3"},
+        "source": {"key3": "value3"},
+        "key3": "value3"
+    })"};
+
+    // The destination contains the source
+    ASSERT_NO_THROW(jObj.merge(json::NOT_RECURSIVE, jObj, "/source", ""));
+    ASSERT_EQ(jObj, jObjExpected);
+}
+
 // json getJson test
 TEST_F(getJsonTest, getObjectOk)
 {
@@ -2605,3 +2669,97 @@ INSTANTIATE_TEST_SUITE_P(CheckDuplicateKey,
         "check": "$event == 2",
         "check": "$event.id == 2"
         })")));
+
+TEST_F(JsonRuntime, PointerPath)
+{
+    ASSERT_THROW(PointerPath("key"), std::runtime_error);
+    ASSERT_NO_THROW(PointerPath(""));
+    ASSERT_EQ(PointerPath("/key/key2").str(), "/key/key2");
+
+    // Copies share the parsed pointer
+    auto path = PointerPath("/key/key2");
+    auto copy = path;
+    ASSERT_EQ(&path.pointer(), &copy.pointer());
+}
+
+TEST_F(JsonRuntime, PointerPathAccessors)
+{
+    Json doc {R"({"str": "value", "int": 1, "int64": 8589934592, "double": 1.5, "bool": true, "obj": {"key": 1}})"};
+
+    ASSERT_TRUE(doc.exists(PointerPath("/obj/key")));
+    ASSERT_FALSE(doc.exists(PointerPath("/obj/key2")));
+    ASSERT_TRUE(doc.exists(PointerPath()));
+
+    ASSERT_EQ(doc.getString(PointerPath("/str")), "value");
+    ASSERT_EQ(doc.getInt(PointerPath("/int")), 1);
+    ASSERT_EQ(doc.getInt64(PointerPath("/int64")), 8589934592);
+    ASSERT_EQ(doc.getIntAsInt64(PointerPath("/int")), 1);
+    ASSERT_EQ(doc.getDouble(PointerPath("/double")), 1.5);
+    ASSERT_EQ(doc.getNumberAsDouble(PointerPath("/int")), 1.0);
+    ASSERT_EQ(doc.getBool(PointerPath("/bool")), true);
+    ASSERT_EQ(doc.getJson(PointerPath("/obj")), Json {R"({"key": 1})"});
+    ASSERT_FALSE(doc.getString(PointerPath("/int")));
+    ASSERT_FALSE(doc.getJson(PointerPath("/missing")));
+
+    ASSERT_TRUE(doc.equals(PointerPath("/int"), Json {"1"}));
+    ASSERT_TRUE(doc.equals(PointerPath("/int"), PointerPath("/obj/key")));
+    ASSERT_FALSE(doc.equals(PointerPath("/int"), PointerPath("/missing")));
+
+    doc.setString("new", PointerPath("/new/str"));
+    doc.setInt(2, PointerPath("/new/int"));
+    doc.setInt64(8589934593, PointerPath("/new/int64"));
+    doc.setDouble(2.5, PointerPath("/new/double"));
+    doc.setBool(false, PointerPath("/new/bool"));
+    doc.setNull(PointerPath("/new/null"));
+    doc.setArray(PointerPath("/new/array"));
+    doc.setObject(PointerPath("/new/object"));
+    doc.set(PointerPath("/new/json"), Json {R"({"key": 2})"});
+    doc.set(PointerPath("/new/ref"), PointerPath("/str"));
+    doc.set(PointerPath("/new/refNull"), PointerPath("/missing"));
+
+    ASSERT_EQ(doc.getJson("/new"),
+              Json {R"({"str": "new", "int": 2, "int64": 8589934593, "double": 2.5, "bool": false, "null": null,
+                       "array": [], "object": {}, "json": {"key": 2}, "ref": "value", "refNull": null})"});
+}
+
+TEST_F(JsonRuntime, Reset)
+{
+    Json doc {R"({"key": "value", "array": [1, 2, 3]})"};
+    doc.reset();
+    ASSERT_TRUE(doc.isNull());
+
+    doc.setString("other", "/key");
+    ASSERT_EQ(doc, Json {R"({"key": "other"})"});
+}
+
+TEST_F(JsonRuntime, BinaryRoundTrip)
+{
+    Json doc {R"({"str": "value", "int": -300, "int64": 8589934592, "uint": 18446744073709551615, "double": 1.5,
+                 "bool": true, "null": null, "array": [1, "two", [], {}], "obj": {"key": {"nested": "ñ"}}})"};
+
+    const auto encoded = doc.binary();
+    ASSERT_TRUE(Json::isBinary(encoded));
+    ASSERT_LT(encoded.size(), doc.str().size());
+
+    auto decoded = Json::fromBinary(encoded);
+    ASSERT_EQ(decoded, doc);
+    ASSERT_TRUE(decoded.isInt64("/int64"));
+    ASSERT_TRUE(decoded.isDouble("/double"));
+    ASSERT_EQ(decoded.str(), doc.str());
+
+    ASSERT_EQ(Json::fromBinary(Json {"\"scalar\""}.binary()), Json {"\"scalar\""});
+}
+
+TEST_F(JsonRuntime, BinaryInvalid)
+{
+    ASSERT_FALSE(Json::isBinary(""));
+    ASSERT_FALSE(Json::isBinary(R"({"key": "value"})"));
+    ASSERT_THROW(Json::fromBinary(R"({"key": "value"})"), std::runtime_error);
+
+    const auto encoded = Json {R"({"key": "value", "array": [1, 2, 3]})"}.binary();
+    for (std::size_t size = 0; size < encoded.size(); ++size)
+    {
+        ASSERT_THROW(Json::fromBinary(encoded.substr(0, size)), std::runtime_error);
+    }
+    ASSERT_THROW(Json::fromBinary(encoded + "x"), std::runtime_error);
+}
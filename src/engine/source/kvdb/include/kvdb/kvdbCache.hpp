@@ -0,0 +1,143 @@
+#ifndef _KVDB_CACHE_H
+#define _KVDB_CACHE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <json/json.hpp>
+
+namespace metricsManager
+{
+template<typename T>
+class iCounter;
+} // namespace metricsManager
+
+namespace kvdbManager
+{
+
+constexpr std::size_t DEFAULT_CACHE_SIZE = 4096; ///< Values cached per database, 0 disables the cache
+constexpr std::size_t DEFAULT_CACHE_SHARDS = 16; ///< Shards of a cache, each one with its own lock
+
+/**
+ * @brief Read-through LRU cache of the parsed values of a database, shared by all its handlers.
+ *
+ * The keys are spread over shards so concurrent lookups rarely contend. The writes of the handlers invalidate the
+ * keys they change; a lookup that missed only fills the cache if no invalidation happened in its shard since the
+ * miss, so a value read from the database before a write is never cached after it.
+ */
+class KVDBCache
+{
+public:
+    /**
+     * @brief Version of a shard, taken on a miss and checked when filling the cache.
+     */
+    using Ticket = uint64_t;
+
+    /**
+     * @brief Construct a new KVDBCache object
+     *
+     * @param capacity Maximum number of values, split evenly between the shards.
+     * @param shards Number of shards.
+     * @param hitCounter (Optional) Metric counting the lookups that found the value.
+     * @param missCounter (Optional) Metric counting the lookups that did not.
+     * @throws std::runtime_error if the capacity or the number of shards is 0.
+     */
+    KVDBCache(std::size_t capacity,
+              std::size_t shards = DEFAULT_CACHE_SHARDS,
+              std::shared_ptr<metricsManager::iCounter<uint64_t>> hitCounter = nullptr,
+              std::shared_ptr<metricsManager::iCounter<uint64_t>> missCounter = nullptr);
+
+    /**
+     * @brief Look up a value, moving it to the front of its shard.
+     *
+     * @param key Key of the value.
+     * @param ticket Set on a miss, to fill the cache once the value is read.
+     * @return std::optional<json::Json> The cached value, if any.
+     */
+    std::optional<json::Json> get(const std::string& key, Ticket& ticket);
+
+    /**
+     * @brief Check if a key is cached, without counting it as a lookup.
+     *
+     * @param key Key of the value.
+     * @return true if the key is cached.
+     */
+    bool contains(const std::string& key) const;
+
+    /**
+     * @brief Fill the cache after a miss, evicting the least recently used value of the shard if it is full.
+     *
+     * @param key Key of the value.
+     * @param value Value read from the database.
+     * @param ticket Ticket of the miss, the value is discarded if the shard was invalidated since.
+     */
+    void put(const std::string& key, const json::Json& value, Ticket ticket);
+
+    /**
+     * @brief Invalidate a key.
+     *
+     * @param key Key changed in the database.
+     */
+    void erase(const std::string& key);
+
+    /**
+     * @brief Invalidate all the keys.
+     */
+    void clear();
+
+    /**
+     * @brief Get the number of cached values.
+     *
+     * @return std::size_t
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Get the number of lookups that found the value.
+     *
+     * @return uint64_t
+     */
+    uint64_t hits() const { return m_hits.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Get the number of lookups that did not find the value.
+     *
+     * @return uint64_t
+     */
+    uint64_t misses() const { return m_misses.load(std::memory_order_relaxed); }
+
+private:
+    using Entries = std::list<std::pair<std::string, json::Json>>;
+
+    struct Shard
+    {
+        mutable std::mutex mutex;                                      ///< Protects the shard
+        Entries entries;                                               ///< Values, the most recently used first
+        std::unordered_map<std::string_view, Entries::iterator> index; ///< Values by key, keys owned by the entries
+        Ticket version {0};                                            ///< Incremented on each invalidation
+    };
+
+    std::vector<std::unique_ptr<Shard>> m_shards; ///< The shards
+    std::size_t m_shardCapacity;                  ///< Maximum number of values of a shard
+    std::atomic<uint64_t> m_hits;                 ///< Lookups that found the value
+    std::atomic<uint64_t> m_misses;               ///< Lookups that did not find the value
+
+    std::shared_ptr<metricsManager::iCounter<uint64_t>> m_hitCounter;  ///< Metric of the hits
+    std::shared_ptr<metricsManager::iCounter<uint64_t>> m_missCounter; ///< Metric of the misses
+
+    Shard& shardOf(std::string_view key) const;
+};
+
+} // namespace kvdbManager
+
+#endif // _KVDB_CACHE_H
@@ -0,0 +1,87 @@
+#ifndef _KVDB_EPOCH_H
+#define _KVDB_EPOCH_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace kvdbManager
+{
+
+constexpr std::size_t DEFAULT_EPOCH_SHARDS = 16; ///< Reader counters of an epoch, each one in its own cache line
+
+/**
+ * @brief Lifetime of an open RocksDB instance, as seen by its handlers.
+ *
+ * The handlers keep raw pointers to the DB and its Column Families and enter the epoch around each operation. Entering
+ * only touches a reader counter picked by the calling thread, so concurrent lookups don't bounce a shared refcount.
+ * Closing the epoch rejects new readers and waits for the in-flight ones, after that the DB can be released.
+ */
+class KVDBEpoch
+{
+public:
+    /**
+     * @brief Registration of a reader, it leaves the epoch when destroyed.
+     */
+    class Guard
+    {
+    public:
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+        Guard(Guard&& other) noexcept
+            : m_pReaders {other.m_pReaders}
+        {
+            other.m_pReaders = nullptr;
+        }
+
+        ~Guard()
+        {
+            if (m_pReaders)
+            {
+                m_pReaders->fetch_sub(1, std::memory_order_release);
+            }
+        }
+
+        /**
+         * @brief Whether the epoch was open, the DB can only be used if it was.
+         */
+        explicit operator bool() const { return m_pReaders != nullptr; }
+
+    private:
+        friend class KVDBEpoch;
+
+        explicit Guard(std::atomic<uint64_t>* readers)
+            : m_pReaders {readers}
+        {
+        }
+
+        std::atomic<uint64_t>* m_pReaders;
+    };
+
+    /**
+     * @brief Enter the epoch.
+     *
+     * @return Guard Valid while the epoch is open, empty if it was closed.
+     */
+    Guard enter();
+
+    /**
+     * @brief Close the epoch, blocks until the readers that entered it leave.
+     */
+    void close();
+
+private:
+    struct alignas(64) Shard
+    {
+        std::atomic<uint64_t> readers {0};
+    };
+
+    std::array<Shard, DEFAULT_EPOCH_SHARDS> m_shards;
+    std::atomic<bool> m_closed {false};
+};
+
+} // namespace kvdbManager
+
+#endif // _KVDB_EPOCH_H
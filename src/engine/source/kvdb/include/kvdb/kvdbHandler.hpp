@@ -3,6 +3,8 @@
 
 #include <kvdb/ikvdbhandler.hpp>
 #include <kvdb/ikvdbhandlercollection.hpp>
+#include <kvdb/kvdbCache.hpp>
+#include <kvdb/kvdbEpoch.hpp>
 
 #include <rocksdb/slice.h>
 
@@ -30,22 +32,32 @@ public:
     /**
      * @brief Construct a new KVDBHandler object
      *
+     * The DB and the Column Family are pinned for the life of the handler, they are only used while the epoch of the
+     * DB is open.
+     *
      * @param db Pointer to the RocksDB:DB instance.
      * @param cfHandle Pointer to the RocksDB:ColumnFamilyHandle instance.
+     * @param epoch Epoch of the open DB, closed before the DB is released.
+     * @param collection Collection that counts the handlers of the Manager.
      * @param dbName Name of the DB.
      * @param scopeName Name of the Scope.
+     * @param cache (Optional) Cache of the parsed values of the DB, shared by its handlers.
      *
      */
-    KVDBHandler(std::weak_ptr<rocksdb::DB> weakDB,
-                std::weak_ptr<rocksdb::ColumnFamilyHandle> weakCFHandle,
+    KVDBHandler(rocksdb::DB* db,
+                rocksdb::ColumnFamilyHandle* cfHandle,
+                std::shared_ptr<KVDBEpoch> epoch,
                 std::shared_ptr<IKVDBHandlerCollection> collection,
                 const std::string& dbName,
-                const std::string& scopeName)
-        : m_weakDB {weakDB}
-        , m_weakCFHandle {weakCFHandle}
+                const std::string& scopeName,
+                std::shared_ptr<KVDBCache> cache = nullptr)
+        : m_pDB {db}
+        , m_pCFHandle {cfHandle}
+        , m_spEpoch {std::move(epoch)}
         , m_dbName {dbName}
         , m_scopeName {scopeName}
         , m_spCollection {collection}
+        , m_spCache {cache}
     {
     }
 
@@ -91,6 +103,13 @@ public:
      */
     base::RespOrError<std::string> get(const std::string& key) override;
 
+    /**
+     * @copydoc IKVDBHandler::getJson
+     *
+     * The values are read through the cache of the DB, if any.
+     */
+    base::RespOrError<json::Json> getJson(const std::string& key) override;
+
     /**
      * @copydoc IKVDBHandler::dump
      *
@@ -105,18 +124,32 @@ public:
     base::RespOrError<std::list<std::pair<std::string, std::string>>>
     search(const std::string& filter, const unsigned int page, const unsigned int records) override;
 
+    /**
+     * @copydoc IKVDBHandler::scan
+     *
+     * The cursor is the last key of the previous page.
+     */
+    base::RespOrError<KVDBPage>
+    scan(const std::string& prefix, const std::string& cursor, const unsigned int records) override;
+
 protected:
     /**
-     *  @brief Weak Pointer to the RocksDB:ColumnFamilyHandle instance.
+     * @brief Pointer to the RocksDB:DB instance, valid while the epoch is open.
      *
      */
-    std::weak_ptr<rocksdb::ColumnFamilyHandle> m_weakCFHandle;
+    rocksdb::DB* m_pDB;
 
     /**
-     * @brief Weak Pointer to the RocksDB:DB instance.
+     *  @brief Pointer to the RocksDB:ColumnFamilyHandle instance, valid while the epoch is open.
      *
      */
-    std::weak_ptr<rocksdb::DB> m_weakDB;
+    rocksdb::ColumnFamilyHandle* m_pCFHandle;
+
+    /**
+     * @brief Epoch of the open DB.
+     *
+     */
+    std::shared_ptr<KVDBEpoch> m_spEpoch;
 
     /**
      * @brief Name of the Database. Kept reference to remove handler from collection.
@@ -136,27 +169,37 @@ protected:
      */
     std::shared_ptr<IKVDBHandlerCollection> m_spCollection;
 
+    /**
+     * @brief Cache of the parsed values of the DB, invalidated by the writes of any of its handlers.
+     *
+     */
+    std::shared_ptr<KVDBCache> m_spCache;
+
 private:
     /**
-     * @brief Function to page the content of iterator
+     * @brief Iterates the keys that start with the prefix, from the first key not lower than start.
      *
-     * @param page
-     * @param records
-     * @param filter
-     * @return base::RespOrError<std::list<std::pair<std::string, std::string>>>, base::Error>
+     * The iterator is bounded to the keys of the prefix, so the keys out of it are never read.
+     *
+     * @param prefix Prefix of the keys, empty to iterate all the keys.
+     * @param start Key where the iteration starts, must start with the prefix.
+     * @param visitor Called for each key-value pair, returns false to stop the iteration.
+     * @return base::OptError Specific error if the database can not be iterated.
      */
-    base::RespOrError<std::list<std::pair<std::string, std::string>>> pageContent(
-        const unsigned int page, const unsigned int records, const std::function<bool(const rocksdb::Slice&)>& filter);
+    base::OptError iterate(const std::string& prefix,
+                           const std::string& start,
+                           const std::function<bool(const rocksdb::Slice&, const rocksdb::Slice&)>& visitor);
 
     /**
      * @brief Function to page the content of iterator
      *
-     * @param page
-     * @param records
+     * @param page Page number, 0 for the first one.
+     * @param records Quantity of records for page, 0 to retrieve all the records.
+     * @param prefix Prefix of the keys, empty to retrieve all the keys.
      * @return base::RespOrError<std::list<std::pair<std::string, std::string>>>, base::Error>
      */
-    base::RespOrError<std::list<std::pair<std::string, std::string>>> pageContent(const unsigned int page,
-                                                                                  const unsigned int records);
+    base::RespOrError<std::list<std::pair<std::string, std::string>>>
+    pageContent(const unsigned int page, const unsigned int records, const std::string& prefix = "");
 };
 
 } // namespace kvdbManager
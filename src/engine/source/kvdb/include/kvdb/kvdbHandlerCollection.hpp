@@ -3,10 +3,9 @@
 
 #include <kvdb/ikvdbhandlercollection.hpp>
 
+#include <array>
 #include <map>
-#include <memory>
-#include <set>
-#include <shared_mutex>
+#include <mutex>
 
 #include <kvdb/kvdbHandler.hpp>
 #include <kvdb/refCounter.hpp>
@@ -14,68 +13,12 @@
 namespace kvdbManager
 {
 
-/**
- * @brief Helper class to manage the reference counters for a given DB.
- * This is used to track how many scopes are using a given DB.
- *
- */
-class KVDBHandlerInstance
-{
-public:
-    /**
-     * @brief Add a new scope to the reference counter.
-     *
-     * @param scopeName Name of the Scope.
-     *
-     */
-    void addScope(const std::string& scopeName);
-
-    /**
-     * @brief Remove a scope from the reference counter.
-     *
-     * @param scopeName Name of the Scope.
-     */
-    void removeScope(const std::string& scopeName);
-
-    /**
-     * @brief Returns if there are no scopes referencing this DB.
-     *
-     * @return true No scopes are referencing this DB.
-     * @return false Some scopes are referencing this DB.
-     */
-    bool emptyScopes(void);
-
-    /**
-     * @brief Get the list of scopes referencing this DB.
-     *
-     * @return std::vector<std::string> List of Scope names.
-     */
-    std::vector<std::string> getRefNames(void);
-
-    /**
-     * @brief Get the Ref Map object
-     *
-     * @return std::map<std::string, uint32_t> Map of DB names and their reference count.
-     */
-    std::map<std::string, uint32_t> getRefMap(void);
-
-private:
-    /**
-     * @brief Basically a wrapper to std::map<std::string, int> with some helper functions.
-     *
-     */
-    RefCounter m_scopeCounter;
-
-    /**
-     * @brief Mutex to protect the internal counter.
-     *
-     */
-    std::shared_mutex m_mutex;
-};
+constexpr std::size_t DEFAULT_COLLECTION_SHARDS = 16; ///< Shards of the collection, each one with its own lock
 
 /**
  * @brief Collection of KVDB Handlers for a given DB and the Scopes referencing them.
  *
+ * The DBs are spread over shards, so building many assets that open handlers to different DBs rarely contend.
  */
 class KVDBHandlerCollection : public IKVDBHandlerCollection
 {
@@ -117,16 +60,24 @@ public:
 
 private:
     /**
-     * @brief Internal map holding DB names and their KVDBHandlerInstance with extra info.
+     * @brief DBs of a shard and the scopes referencing them.
      *
      */
-    std::map<std::string, std::shared_ptr<KVDBHandlerInstance>> m_mapInstances;
+    struct Shard
+    {
+        std::map<std::string, RefCounter> instances;
+        std::mutex mutex;
+    };
 
     /**
-     * @brief Mutex to protect the internal map.
+     * @brief Get the shard of a DB.
      *
+     * @param dbName Name of the DB.
+     * @return Shard& The shard.
      */
-    std::shared_mutex m_mutex;
+    Shard& shard(const std::string& dbName);
+
+    std::array<Shard, DEFAULT_COLLECTION_SHARDS> m_shards;
 };
 
 } // namespace kvdbManager
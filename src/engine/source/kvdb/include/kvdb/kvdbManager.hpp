@@ -2,16 +2,23 @@
 #define _KVDB_MANAGER_H
 
 #include <atomic>
+#include <condition_variable>
 #include <filesystem>
 #include <map>
 #include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
 
+#include <rocksdb/cache.h>
 #include <rocksdb/db.h>
 #include <rocksdb/options.h>
 
 #include <error.hpp>
 
 #include <kvdb/ikvdbmanager.hpp>
+#include <kvdb/kvdbCache.hpp>
+#include <kvdb/kvdbEpoch.hpp>
 #include <kvdb/kvdbHandler.hpp>
 #include <kvdb/kvdbHandlerCollection.hpp>
 
@@ -19,6 +26,10 @@ namespace metricsManager
 {
 class IMetricsManager;
 class IMetricsScope;
+template<typename T>
+class iCounter;
+template<typename T>
+class iGauge;
 } // namespace metricsManager
 
 namespace kvdbManager
@@ -26,6 +37,11 @@ namespace kvdbManager
 
 constexpr static const char* DEFAULT_CF_NAME {"default"};
 
+constexpr std::size_t DEFAULT_BLOCK_CACHE_SIZE = 64 << 20; ///< Bytes of the block cache shared by the DBs
+constexpr int DEFAULT_BLOOM_BITS_PER_KEY = 10;             ///< About 1% of false positives
+constexpr static const char* DEFAULT_COMPRESSION {"none"}; ///< Only compression always linked in RocksDB
+constexpr std::size_t DEFAULT_STATISTICS_INTERVAL = 10;    ///< Seconds between refreshes of the RocksDB metrics
+
 /**
  * @brief Options for the KVDBManager.
  *
@@ -34,6 +50,13 @@ struct KVDBManagerOptions
 {
     std::filesystem::path dbStoragePath;
     std::string dbName;
+    std::size_t cacheSize {DEFAULT_CACHE_SIZE};                   ///< Parsed values cached per DB, 0 for none
+    std::size_t blockCacheSize {DEFAULT_BLOCK_CACHE_SIZE};        ///< Shared block cache, 0 for one per DB
+    int bloomBitsPerKey {DEFAULT_BLOOM_BITS_PER_KEY};             ///< Bits per key of the bloom filters, 0 for none
+    bool optimizeForPointLookup {true};                           ///< Index the data blocks by hash
+    std::string compression {DEFAULT_COMPRESSION};                ///< none, snappy, zlib, lz4, lz4hc or zstd
+    std::map<std::string, std::string> dbCompression {};          ///< Compression of specific DBs
+    std::size_t statisticsInterval {DEFAULT_STATISTICS_INTERVAL}; ///< Seconds, 0 disables the statistics
 };
 
 /**
@@ -54,6 +77,12 @@ public:
     KVDBManager(const KVDBManagerOptions& options,
                 const std::shared_ptr<metricsManager::IMetricsManager>& metricsManager);
 
+    /**
+     * @brief Destroy the KVDBManager object, stopping the statistics refresher if it is running.
+     *
+     */
+    ~KVDBManager();
+
     /**
      * @copydoc IKVDBManager::initialize
      *
@@ -121,6 +150,12 @@ public:
      */
     base::OptError loadDBFromJson(const std::string& name, const json::Json& content) override;
 
+    /**
+     * @copydoc IKVDBManager::importDB
+     *
+     */
+    base::OptError importDB(const std::string& name, const std::string& path, bool replace) override;
+
     /**
      * @copydoc IKVDBManager::existsDB
      *
@@ -134,6 +169,32 @@ private:
      */
     void initializeOptions();
 
+    /**
+     * @brief Get the options of the Column Family of a DB, with its compression.
+     *
+     * @param name Name of the DB.
+     * @return rocksdb::ColumnFamilyOptions
+     */
+    rocksdb::ColumnFamilyOptions columnFamilyOptions(const std::string& name) const;
+
+    /**
+     * @brief Start the thread copying the RocksDB statistics to the metrics, if enabled.
+     *
+     */
+    void startStatistics();
+
+    /**
+     * @brief Stop the thread copying the RocksDB statistics to the metrics.
+     *
+     */
+    void stopStatistics();
+
+    /**
+     * @brief Copy the RocksDB statistics to the metrics.
+     *
+     */
+    void refreshStatistics();
+
     /**
      * @brief Initialize the Main DB. Setup Filesystem, open RocksDB, create initial maps.
      *
@@ -154,6 +215,16 @@ private:
      */
     base::RespOrError<json::Json> getContentFromJsonFile(const std::string& path);
 
+    /**
+     * @brief Write the entries of a json object to a DB through an ingested SST file.
+     *
+     * @param name Name of the DB, it must exist.
+     * @param content Json object with the entries.
+     * @param replace Remove the entries of the DB that are not in the content.
+     * @return base::OptError Specific error.
+     */
+    base::OptError ingestJson(const std::string& name, const json::Json& content, bool replace);
+
     /**
      * @brief Create a Shared Column Family Shared Pointer with custom delete function.
      *
@@ -174,6 +245,22 @@ private:
      */
     std::shared_ptr<metricsManager::IMetricsScope> m_spMetricsScope;
 
+    /**
+     * @brief Get the cache of a DB, creating it on first use.
+     *
+     * @param name Name of the DB.
+     * @return std::shared_ptr<KVDBCache> The cache, nullptr if caching is disabled.
+     */
+    std::shared_ptr<KVDBCache> getCache(const std::string& name);
+
+    /**
+     * @brief Invalidate the values cached for a DB, if any.
+     *
+     * @param name Name of the DB.
+     * @param drop Release the cache too, the DB is being removed.
+     */
+    void invalidateCache(const std::string& name, bool drop);
+
     /**
      * @brief Create a Column Family object and store in map.
      *
@@ -194,11 +281,37 @@ private:
      */
     rocksdb::Options m_rocksDBOptions;
 
+    /**
+     * @brief Options of the Column Families, shared by all the DBs but the compression.
+     *
+     */
+    rocksdb::ColumnFamilyOptions m_cfOptions;
+
+    /**
+     * @brief Block cache shared by all the Column Families, nullptr if each one has its own.
+     *
+     */
+    std::shared_ptr<rocksdb::Cache> m_spBlockCache;
+
+    /**
+     * @brief Compression of the DBs, the default one and the ones set for specific DBs.
+     *
+     */
+    rocksdb::CompressionType m_compression;
+    std::map<std::string, rocksdb::CompressionType> m_dbCompression;
+
     /**
      * @brief Internal rocksdb::DB object. This is the main object through which all operations are done.
      *
      */
     std::shared_ptr<rocksdb::DB> m_pRocksDB;
+
+    /**
+     * @brief Epoch of the open DB, the handlers only use the DB while it is open.
+     *
+     */
+    std::shared_ptr<KVDBEpoch> m_spEpoch;
+
     /**
      * @brief Internal map of Column Family Handles.
      * This is the loaded CFs or KVDBs.
@@ -212,6 +325,41 @@ private:
      */
     std::shared_ptr<rocksdb::ColumnFamilyHandle> m_pDefaultCFHandle;
 
+    /**
+     * @brief Cache of the parsed values of each DB, shared by all the handlers of the DB.
+     *
+     */
+    std::map<std::string, std::shared_ptr<KVDBCache>> m_mapCaches;
+
+    /**
+     * @brief Syncronization object for the caches (m_mapCaches).
+     *
+     */
+    std::mutex m_mutexCaches;
+
+    /**
+     * @brief Metrics of the cache lookups, shared by all the DBs.
+     *
+     */
+    std::shared_ptr<metricsManager::iCounter<uint64_t>> m_spCacheHits;
+    std::shared_ptr<metricsManager::iCounter<uint64_t>> m_spCacheMisses;
+
+    /**
+     * @brief Metrics of the RocksDB statistics, by ticker, and of the usage of the block cache.
+     *
+     */
+    std::vector<std::pair<uint32_t, std::shared_ptr<metricsManager::iGauge<int64_t>>>> m_statisticsGauges;
+    std::shared_ptr<metricsManager::iGauge<int64_t>> m_spBlockCacheUsage;
+
+    /**
+     * @brief Thread refreshing the statistics metrics, and its stop signal.
+     *
+     */
+    std::thread m_statisticsThread;
+    std::mutex m_mutexStatistics;
+    std::condition_variable m_cvStatistics;
+    bool m_stopStatistics {false};
+
     /**
      * @brief Syncronization object for Scopes Collection (m_mapScopes).
      *
@@ -6,6 +6,7 @@
 #include <string>
 #include <utility>
 #include <variant>
+#include <vector>
 
 #include <error.hpp>
 #include <json/json.hpp>
@@ -13,6 +14,16 @@
 namespace kvdbManager
 {
 
+/**
+ * @brief Page of the content of a database, retrieved from a continuation cursor.
+ *
+ */
+struct KVDBPage
+{
+    std::vector<std::pair<std::string, std::string>> entries; ///< Key-value pairs of the page, ordered by key
+    std::string cursor; ///< Cursor of the next page, empty if this is the last one
+};
+
 /**
  * @brief Interface of KVDB Handler. Holds the basic operations to interact with the database.
  *
@@ -80,6 +91,24 @@ public:
      */
     virtual base::RespOrError<std::string> get(const std::string& key) = 0;
 
+    /**
+     * @brief Gets the value of a key parsed as Json.
+     *
+     * @param key Provided key.
+     * @return base::RespOrError<json::Json> Json value of the key. Specific error if it can not be read.
+     * @throws std::runtime_error if the value is not a valid Json.
+     */
+    virtual base::RespOrError<json::Json> getJson(const std::string& key)
+    {
+        auto value = get(key);
+        if (std::holds_alternative<base::Error>(value))
+        {
+            return std::get<base::Error>(value);
+        }
+
+        return json::Json {std::get<std::string>(value).c_str()};
+    }
+
     /**
      * @brief Retrieves all content with pagination from the database.
      *
@@ -131,6 +160,21 @@ public:
     {
         return search(prefix, 0, 0);
     };
+
+    /**
+     * @brief Retrieves a page of the content of the database whose keys start with the prefix, starting after the
+     * cursor returned with the previous page.
+     *
+     * Each page seeks directly to its first key, so walking the whole database costs the same as a single dump.
+     *
+     * @param prefix Filter value, empty to retrieve all the keys.
+     * @param cursor Opaque cursor returned with the previous page, empty to retrieve the first page.
+     * @param records Quantity of records for page, 0 to retrieve all the remaining records.
+     * @return base::RespOrError<KVDBPage> Page of key-value pairs and cursor of the next one. Specific error
+     * otherwise.
+     */
+    virtual base::RespOrError<KVDBPage>
+    scan(const std::string& prefix, const std::string& cursor, const unsigned int records) = 0;
 };
 
 } // namespace kvdbManager
@@ -92,6 +92,20 @@ public:
      */
     virtual base::OptError loadDBFromJson(const std::string& name, const json::Json& content) = 0;
 
+    /**
+     * @brief Bulk import a json file into a DB, creating the DB if it does not exist.
+     *
+     * The entries are written offline and ingested at once, so readers see either the old or the new content.
+     *
+     * @param name Name of the DB.
+     * @param path Path of the json file.
+     * @param replace Remove the entries of the DB that are not in the file.
+     * @return base::OptError If base::Error not exists the DB was imported successfully. Specific error
+     * otherwise.
+     *
+     */
+    virtual base::OptError importDB(const std::string& name, const std::string& path, bool replace) = 0;
+
     /**
      * @brief Checks if a DB exists.
      *
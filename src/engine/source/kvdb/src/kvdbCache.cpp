@@ -0,0 +1,150 @@
+#include <kvdb/kvdbCache.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+#include <metrics/iMetricsInstruments.hpp>
+
+namespace kvdbManager
+{
+
+KVDBCache::KVDBCache(std::size_t capacity,
+                     std::size_t shards,
+                     std::shared_ptr<metricsManager::iCounter<uint64_t>> hitCounter,
+                     std::shared_ptr<metricsManager::iCounter<uint64_t>> missCounter)
+    : m_shards()
+    , m_shardCapacity(0)
+    , m_hits(0)
+    , m_misses(0)
+    , m_hitCounter(std::move(hitCounter))
+    , m_missCounter(std::move(missCounter))
+{
+    if (capacity == 0 || shards == 0)
+    {
+        throw std::runtime_error("The KVDB cache needs a capacity and at least one shard");
+    }
+
+    // Small caches use fewer shards, so each one holds a value at least
+    shards = std::min(shards, capacity);
+    m_shardCapacity = (capacity + shards - 1) / shards;
+
+    m_shards.reserve(shards);
+    for (std::size_t i = 0; i < shards; ++i)
+    {
+        m_shards.emplace_back(std::make_unique<Shard>());
+    }
+}
+
+KVDBCache::Shard& KVDBCache::shardOf(std::string_view key) const
+{
+    return *m_shards[std::hash<std::string_view> {}(key) % m_shards.size()];
+}
+
+std::optional<json::Json> KVDBCache::get(const std::string& key, Ticket& ticket)
+{
+    auto& shard = shardOf(key);
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        const auto it = shard.index.find(key);
+        if (it != shard.index.end())
+        {
+            shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+            auto value = it->second->second;
+
+            m_hits.fetch_add(1, std::memory_order_relaxed);
+            if (m_hitCounter)
+            {
+                m_hitCounter->addValue(1UL);
+            }
+            return value;
+        }
+
+        ticket = shard.version;
+    }
+
+    m_misses.fetch_add(1, std::memory_order_relaxed);
+    if (m_missCounter)
+    {
+        m_missCounter->addValue(1UL);
+    }
+    return std::nullopt;
+}
+
+bool KVDBCache::contains(const std::string& key) const
+{
+    auto& shard = shardOf(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    return shard.index.find(key) != shard.index.end();
+}
+
+void KVDBCache::put(const std::string& key, const json::Json& value, Ticket ticket)
+{
+    auto& shard = shardOf(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    if (shard.version != ticket)
+    {
+        return;
+    }
+
+    const auto it = shard.index.find(key);
+    if (it != shard.index.end())
+    {
+        // Filled by a concurrent miss
+        it->second->second = value;
+        shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+        return;
+    }
+
+    if (shard.entries.size() >= m_shardCapacity)
+    {
+        shard.index.erase(shard.entries.back().first);
+        shard.entries.pop_back();
+    }
+
+    shard.entries.emplace_front(key, value);
+    shard.index.emplace(shard.entries.front().first, shard.entries.begin());
+}
+
+void KVDBCache::erase(const std::string& key)
+{
+    auto& shard = shardOf(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    ++shard.version;
+    const auto it = shard.index.find(key);
+    if (it != shard.index.end())
+    {
+        const auto entry = it->second;
+        shard.index.erase(it);
+        shard.entries.erase(entry);
+    }
+}
+
+void KVDBCache::clear()
+{
+    for (auto& shard : m_shards)
+    {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+
+        ++shard->version;
+        shard->index.clear();
+        shard->entries.clear();
+    }
+}
+
+std::size_t KVDBCache::size() const
+{
+    std::size_t total = 0;
+    for (const auto& shard : m_shards)
+    {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        total += shard->entries.size();
+    }
+    return total;
+}
+
+} // namespace kvdbManager
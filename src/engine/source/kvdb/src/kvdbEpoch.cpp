@@ -0,0 +1,47 @@
+#include <kvdb/kvdbEpoch.hpp>
+
+#include <thread>
+
+namespace kvdbManager
+{
+
+namespace
+{
+std::size_t threadShard()
+{
+    static std::atomic<std::size_t> nextShard {0};
+    thread_local const std::size_t shard = nextShard.fetch_add(1, std::memory_order_relaxed) % DEFAULT_EPOCH_SHARDS;
+
+    return shard;
+}
+} // namespace
+
+KVDBEpoch::Guard KVDBEpoch::enter()
+{
+    auto& readers = m_shards[threadShard()].readers;
+
+    // Pairs with close(): either it sees this reader or this reader sees the epoch closed
+    readers.fetch_add(1, std::memory_order_seq_cst);
+    if (m_closed.load(std::memory_order_seq_cst))
+    {
+        readers.fetch_sub(1, std::memory_order_release);
+        return Guard {nullptr};
+    }
+
+    return Guard {&readers};
+}
+
+void KVDBEpoch::close()
+{
+    m_closed.store(true, std::memory_order_seq_cst);
+
+    for (auto& shard : m_shards)
+    {
+        while (shard.readers.load(std::memory_order_acquire) != 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+} // namespace kvdbManager
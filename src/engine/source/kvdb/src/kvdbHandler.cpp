@@ -5,6 +5,31 @@
 #include <logging/logging.hpp>
 #include <rocksdb/db.h>
 
+namespace
+{
+/**
+ * @brief Get the first key greater than all the keys that start with the prefix.
+ *
+ * @param prefix Prefix of the keys.
+ * @return std::string Upper bound of the keys, empty if there is none.
+ */
+std::string prefixUpperBound(const std::string& prefix)
+{
+    auto bound = prefix;
+    while (!bound.empty() && static_cast<unsigned char>(bound.back()) == 0xFF)
+    {
+        bound.pop_back();
+    }
+
+    if (!bound.empty())
+    {
+        bound.back() = static_cast<char>(static_cast<unsigned char>(bound.back()) + 1);
+    }
+
+    return bound;
+}
+} // namespace
+
 namespace kvdbManager
 {
 
@@ -15,32 +40,26 @@ KVDBHandler::~KVDBHandler()
 
 std::optional<base::Error> KVDBHandler::set(const std::string& key, const std::string& value)
 {
-    auto pRocksDB = m_weakDB.lock();
-    if (pRocksDB)
+    const auto epochGuard = m_spEpoch->enter();
+    if (!epochGuard)
     {
-        auto pCFhandle = m_weakCFHandle.lock();
-        if (pCFhandle)
-        {
-            auto status =
-                pRocksDB->Put(rocksdb::WriteOptions(), pCFhandle.get(), rocksdb::Slice(key), rocksdb::Slice(value));
+        return base::Error {"Can not access RocksDB::DB"};
+    }
 
-            if (status.ok())
-            {
-                return std::nullopt;
-            }
-            else
-            {
-                std::string_view error = status.getState() != nullptr ? status.getState() : "Unknown";
-                return base::Error {fmt::format("Can not save value '{}' in key '{}'. Error: {}", value, key, error)};
-            }
-        }
-        else
-        {
-            return base::Error {"Can not access RocksDB Column Family Handle"};
-        }
+    auto status = m_pDB->Put(rocksdb::WriteOptions(), m_pCFHandle, rocksdb::Slice(key), rocksdb::Slice(value));
+
+    if (m_spCache)
+    {
+        m_spCache->erase(key);
+    }
+
+    if (status.ok())
+    {
+        return std::nullopt;
     }
 
-    return base::Error {"Can not access RocksDB::DB"};
+    std::string_view error = status.getState() != nullptr ? status.getState() : "Unknown";
+    return base::Error {fmt::format("Can not save value '{}' in key '{}'. Error: {}", value, key, error)};
 }
 
 std::optional<base::Error> KVDBHandler::set(const std::string& key, const json::Json& value)
@@ -55,107 +74,113 @@ std::optional<base::Error> KVDBHandler::add(const std::string& key)
 
 std::optional<base::Error> KVDBHandler::remove(const std::string& key)
 {
-    auto pRocksDB = m_weakDB.lock();
-    if (pRocksDB)
+    const auto epochGuard = m_spEpoch->enter();
+    if (!epochGuard)
     {
-        auto pCFhandle = m_weakCFHandle.lock();
-        if (pCFhandle)
-        {
-            auto status = pRocksDB->Delete(rocksdb::WriteOptions(), pCFhandle.get(), rocksdb::Slice(key));
+        return base::Error {"Can not access RocksDB::DB"};
+    }
 
-            if (status.ok())
-            {
-                return std::nullopt;
-            }
-            else
-            {
-                std::string_view error = status.getState() != nullptr ? status.getState() : "Unknown";
-                return base::Error {fmt::format("Can not remove key '{}'. Error: {}", key, error)};
-            }
-        }
-        else
-        {
-            return base::Error {"Can not access RocksDB Column Family Handle"};
-        }
+    auto status = m_pDB->Delete(rocksdb::WriteOptions(), m_pCFHandle, rocksdb::Slice(key));
+
+    if (m_spCache)
+    {
+        m_spCache->erase(key);
+    }
+
+    if (status.ok())
+    {
+        return std::nullopt;
     }
 
-    return base::Error {"Can not access RocksDB::DB"};
+    std::string_view error = status.getState() != nullptr ? status.getState() : "Unknown";
+    return base::Error {fmt::format("Can not remove key '{}'. Error: {}", key, error)};
 }
 
 std::variant<bool, base::Error> KVDBHandler::contains(const std::string& key)
 {
-    auto pRocksDB = m_weakDB.lock();
-    if (pRocksDB)
+    const auto epochGuard = m_spEpoch->enter();
+    if (!epochGuard)
     {
-        auto pCFhandle = m_weakCFHandle.lock();
-        if (pCFhandle)
-        {
-            try
-            {
-                std::string value; // mandatory to pass to KeyMayExist.
-                bool valueFound = false;
+        return base::Error {"Can not access RocksDB::DB"};
+    }
 
-                pRocksDB->KeyMayExist(
-                    rocksdb::ReadOptions(), pCFhandle.get(), rocksdb::Slice(key), &value, &valueFound);
+    // A cached key exists, the writes invalidate it before returning
+    if (m_spCache && m_spCache->contains(key))
+    {
+        return true;
+    }
 
-                // confirm exists
-                if (valueFound)
-                {
-                    auto status = pRocksDB->Get(rocksdb::ReadOptions(), pCFhandle.get(), rocksdb::Slice(key), &value);
+    try
+    {
+        std::string value; // mandatory to pass to KeyMayExist.
+        bool valueFound = false;
 
-                    if (!status.ok())
-                    {
-                        valueFound = false;
-                    }
-                }
+        m_pDB->KeyMayExist(rocksdb::ReadOptions(), m_pCFHandle, rocksdb::Slice(key), &value, &valueFound);
 
-                return valueFound;
-            }
-            catch (const std::exception& ex)
+        // confirm exists
+        if (valueFound)
+        {
+            auto status = m_pDB->Get(rocksdb::ReadOptions(), m_pCFHandle, rocksdb::Slice(key), &value);
+
+            if (!status.ok())
             {
-                return base::Error {fmt::format("Can not validate existance of key {}. Error: {}", key, ex.what())};
+                valueFound = false;
             }
         }
-        else
-        {
-            return base::Error {"Can not access RocksDB Column Family Handle"};
-        }
-    }
 
-    return base::Error {"Can not access RocksDB::DB"};
+        return valueFound;
+    }
+    catch (const std::exception& ex)
+    {
+        return base::Error {fmt::format("Can not validate existance of key {}. Error: {}", key, ex.what())};
+    }
 }
 
 std::variant<std::string, base::Error> KVDBHandler::get(const std::string& key)
 {
-    auto pRocksDB = m_weakDB.lock();
-    if (pRocksDB)
+    const auto epochGuard = m_spEpoch->enter();
+    if (!epochGuard)
     {
-        auto pCFhandle = m_weakCFHandle.lock();
-        if (pCFhandle)
-        {
-            std::string value;
-            auto status = pRocksDB->Get(rocksdb::ReadOptions(), pCFhandle.get(), rocksdb::Slice(key), &value);
+        return base::Error {"Can not access RocksDB::DB"};
+    }
 
-            if (status.ok())
-            {
-                return value;
-            }
-            else
-            {
-                bool isNotFound = status.IsNotFound() && value.empty();
-                std::string_view error = isNotFound                     ? "Key not found"
-                                         : status.getState() != nullptr ? status.getState()
-                                                                        : "Unknown";
-                return base::Error {fmt::format("Can not get key '{}'. Error: {}", key, error)};
-            }
-        }
-        else
-        {
-            return base::Error {"Can not access RocksDB Column Family Handle"};
-        }
+    std::string value;
+    auto status = m_pDB->Get(rocksdb::ReadOptions(), m_pCFHandle, rocksdb::Slice(key), &value);
+
+    if (status.ok())
+    {
+        return value;
     }
 
-    return base::Error {"Can not access RocksDB::DB"};
+    bool isNotFound = status.IsNotFound() && value.empty();
+    std::string_view error = isNotFound                     ? "Key not found"
+                             : status.getState() != nullptr ? status.getState()
+                                                            : "Unknown";
+    return base::Error {fmt::format("Can not get key '{}'. Error: {}", key, error)};
+}
+
+base::RespOrError<json::Json> KVDBHandler::getJson(const std::string& key)
+{
+    if (!m_spCache)
+    {
+        return IKVDBHandler::getJson(key);
+    }
+
+    KVDBCache::Ticket ticket {};
+    auto cached = m_spCache->get(key, ticket);
+    if (cached)
+    {
+        return std::move(cached.value());
+    }
+
+    // Malformed values throw and are not cached
+    auto value = IKVDBHandler::getJson(key);
+    if (std::holds_alternative<json::Json>(value))
+    {
+        m_spCache->put(key, std::get<json::Json>(value), ticket);
+    }
+
+    return value;
 }
 
 std::variant<std::list<std::pair<std::string, std::string>>, base::Error> KVDBHandler::dump(const unsigned int page,
@@ -167,66 +192,121 @@ std::variant<std::list<std::pair<std::string, std::string>>, base::Error> KVDBHa
 std::variant<std::list<std::pair<std::string, std::string>>, base::Error>
 KVDBHandler::search(const std::string& prefix, const unsigned int page, const unsigned int records)
 {
-    auto filter = [&prefix](const rocksdb::Slice& keyIter) -> bool
+    return pageContent(page, records, prefix);
+}
+
+base::RespOrError<KVDBPage>
+KVDBHandler::scan(const std::string& prefix, const std::string& cursor, const unsigned int records)
+{
+    if (!cursor.empty() && cursor.compare(0, prefix.size(), prefix) != 0)
     {
-        rocksdb::Slice slicePrefix(prefix);
+        return base::Error {
+            fmt::format("Database '{}': Invalid cursor '{}' for prefix '{}'", m_dbName, cursor, prefix)};
+    }
 
-        if (slicePrefix.empty())
-            return true;
-        else
-            return keyIter.starts_with(slicePrefix);
-    };
+    KVDBPage page;
+    if (records > 0)
+    {
+        page.entries.reserve(records);
+    }
 
-    return pageContent(page, records, filter);
+    auto error = iterate(prefix,
+                         cursor.empty() ? prefix : cursor,
+                         [&](const rocksdb::Slice& key, const rocksdb::Slice& value)
+                         {
+                             // The cursor was the last key of the previous page
+                             if (!cursor.empty() && key == rocksdb::Slice(cursor))
+                             {
+                                 return true;
+                             }
+
+                             // There are more keys after a full page
+                             if (records > 0 && page.entries.size() == records)
+                             {
+                                 page.cursor = page.entries.back().first;
+                                 return false;
+                             }
+
+                             page.entries.emplace_back(key.ToString(), value.ToString());
+                             return true;
+                         });
+
+    if (error)
+    {
+        return std::move(error.value());
+    }
+
+    return page;
 }
 
 std::variant<std::list<std::pair<std::string, std::string>>, base::Error>
-KVDBHandler::pageContent(const unsigned int page, const unsigned int records)
+KVDBHandler::pageContent(const unsigned int page, const unsigned int records, const std::string& prefix)
 {
-    return pageContent(page, records, {});
+    std::list<std::pair<std::string, std::string>> content;
+
+    const unsigned int fromRecords = page > 0 ? (page - 1) * records : 0;
+
+    unsigned int i = 0;
+    auto error = iterate(prefix,
+                         prefix,
+                         [&](const rocksdb::Slice& key, const rocksdb::Slice& value)
+                         {
+                             if (records > 0 && i >= fromRecords + records)
+                             {
+                                 return false;
+                             }
+
+                             // The skipped records are not copied
+                             if (i++ >= fromRecords)
+                             {
+                                 content.emplace_back(key.ToString(), value.ToString());
+                             }
+                             return true;
+                         });
+
+    if (error)
+    {
+        return std::move(error.value());
+    }
+
+    return content;
 }
 
-std::variant<std::list<std::pair<std::string, std::string>>, base::Error> KVDBHandler::pageContent(
-    const unsigned int page, const unsigned int records, const std::function<bool(const rocksdb::Slice&)>& filter)
+base::OptError KVDBHandler::iterate(const std::string& prefix,
+                                    const std::string& start,
+                                    const std::function<bool(const rocksdb::Slice&, const rocksdb::Slice&)>& visitor)
 {
-    auto pRocksDB = m_weakDB.lock();
-    if (pRocksDB)
+    const auto epochGuard = m_spEpoch->enter();
+    if (!epochGuard)
     {
-        auto pCFhandle = m_weakCFHandle.lock();
-        if (pCFhandle)
-        {
-            std::unique_ptr<rocksdb::Iterator> iter(pRocksDB->NewIterator(rocksdb::ReadOptions(), pCFhandle.get()));
-            std::list<std::pair<std::string, std::string>> content;
-
-            unsigned int fromRecords = (page - 1) * records;
-            unsigned int toRecords = fromRecords + records;
-
-            unsigned int i = 0;
-            for (iter->SeekToFirst(); iter->Valid() && i < toRecords; iter->Next())
-            {
-                if (!filter || filter(iter->key()))
-                {
-                    if (i >= fromRecords)
-                    {
-                        content.emplace_back(std::make_pair(iter->key().ToString(), iter->value().ToString()));
-                    }
-                    i++;
-                }
-            }
+        return base::Error {"Can not access RocksDB::DB"};
+    }
 
-            if (!iter->status().ok())
-            {
-                return base::Error {fmt::format(
-                    "Database '{}': Could not iterate over database: '{}'", m_dbName, iter->status().ToString())};
-            }
+    // No prefix extractor is configured, the iteration is bounded by the successor of the prefix instead
+    rocksdb::ReadOptions readOptions;
+    const auto upperBound = prefixUpperBound(prefix);
+    rocksdb::Slice upperBoundSlice(upperBound);
+    if (!upperBound.empty())
+    {
+        readOptions.iterate_upper_bound = &upperBoundSlice;
+    }
 
-            return content;
+    std::unique_ptr<rocksdb::Iterator> iter(m_pDB->NewIterator(readOptions, m_pCFHandle));
+    for (iter->Seek(start); iter->Valid(); iter->Next())
+    {
+        if (!visitor(iter->key(), iter->value()))
+        {
+            break;
         }
+    }
 
-        return base::Error {"Can not access RocksDB Column Family Handle"};
+    if (!iter->status().ok())
+    {
+        return base::Error {fmt::format(
+            "Database '{}': Could not iterate over database: '{}'", m_dbName, iter->status().ToString())};
     }
 
-    return base::Error {"Can not access RocksDB::DB"};
+    return std::nullopt;
 }
 
 } // namespace kvdbManager
@@ -1,108 +1,69 @@
-#include <fmt/format.h>
-
-#include <logging/logging.hpp>
+#include <algorithm>
+#include <functional>
 
 #include <kvdb/kvdbHandlerCollection.hpp>
 
 namespace kvdbManager
 {
 
-void KVDBHandlerCollection::addKVDBHandler(const std::string& dbName,
-                                           const std::string& scopeName)
+KVDBHandlerCollection::Shard& KVDBHandlerCollection::shard(const std::string& dbName)
 {
-    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return m_shards[std::hash<std::string> {}(dbName) % m_shards.size()];
+}
 
-    const auto it = m_mapInstances.find(dbName);
-    if (it != m_mapInstances.end())
-    {
-        auto& instance = it->second;
-        instance->addScope(scopeName);
-    }
-    else
-    {
-        auto spInstance = std::make_shared<KVDBHandlerInstance>();
-        spInstance->addScope(scopeName);
-        m_mapInstances.emplace(dbName, std::move(spInstance));
-    }
+void KVDBHandlerCollection::addKVDBHandler(const std::string& dbName, const std::string& scopeName)
+{
+    auto& dbShard = shard(dbName);
+    std::lock_guard<std::mutex> lock(dbShard.mutex);
+
+    dbShard.instances[dbName].addRef(scopeName);
 }
 
 void KVDBHandlerCollection::removeKVDBHandler(const std::string& dbName, const std::string& scopeName)
 {
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    auto& dbShard = shard(dbName);
+    std::lock_guard<std::mutex> lock(dbShard.mutex);
 
-    const auto it = m_mapInstances.find(dbName);
-    if (it != m_mapInstances.end())
+    const auto it = dbShard.instances.find(dbName);
+    if (it != dbShard.instances.end())
     {
-        auto& instance = it->second;
-        instance->removeScope(scopeName);
-        if (instance->emptyScopes())
+        it->second.removeRef(scopeName);
+        if (it->second.empty())
         {
-            m_mapInstances.erase(it);
+            dbShard.instances.erase(it);
         }
     }
 }
 
 std::vector<std::string> KVDBHandlerCollection::getDBNames()
 {
-    std::shared_lock<std::shared_mutex> lock(m_mutex);
-
     std::vector<std::string> dbNames;
-    dbNames.reserve(m_mapInstances.size());
 
-    for (const auto& instance : m_mapInstances)
+    for (auto& dbShard : m_shards)
     {
-        dbNames.push_back(instance.first);
+        std::lock_guard<std::mutex> lock(dbShard.mutex);
+        for (const auto& instance : dbShard.instances)
+        {
+            dbNames.push_back(instance.first);
+        }
     }
 
+    std::sort(dbNames.begin(), dbNames.end());
     return dbNames;
 }
 
 std::map<std::string, uint32_t> KVDBHandlerCollection::getRefMap(const std::string& dbName)
 {
-    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    auto& dbShard = shard(dbName);
+    std::lock_guard<std::mutex> lock(dbShard.mutex);
 
-    const auto it = m_mapInstances.find(dbName);
-    if (it != m_mapInstances.end())
+    const auto it = dbShard.instances.find(dbName);
+    if (it != dbShard.instances.end())
     {
-        return it->second->getRefMap();
+        return it->second.getRefMap();
     }
 
     return {};
 }
 
-void KVDBHandlerInstance::addScope(const std::string& scopeName)
-{
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
-
-    m_scopeCounter.addRef(scopeName);
-}
-
-void KVDBHandlerInstance::removeScope(const std::string& scopeName)
-{
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
-
-    m_scopeCounter.removeRef(scopeName);
-}
-
-bool KVDBHandlerInstance::emptyScopes()
-{
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
-
-    return m_scopeCounter.empty();
-}
-
-std::vector<std::string> KVDBHandlerInstance::getRefNames()
-{
-    std::shared_lock<std::shared_mutex> lock(m_mutex);
-
-    return m_scopeCounter.getRefNames();
-}
-
-std::map<std::string, uint32_t> KVDBHandlerInstance::getRefMap()
-{
-    std::shared_lock<std::shared_mutex> lock(m_mutex);
-
-    return m_scopeCounter.getRefMap();
-}
-
 } // namespace kvdbManager
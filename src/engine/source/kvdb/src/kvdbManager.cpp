@@ -1,10 +1,16 @@
+#include <algorithm>
+#include <chrono>
 #include <filesystem>
 #include <fmt/format.h>
 #include <fstream>
 #include <optional>
 
 #include "rocksdb/db.h"
+#include "rocksdb/filter_policy.h"
 #include "rocksdb/options.h"
+#include "rocksdb/sst_file_writer.h"
+#include "rocksdb/statistics.h"
+#include "rocksdb/table.h"
 
 #include <kvdb/kvdbManager.hpp>
 #include <logging/logging.hpp>
@@ -13,12 +19,58 @@
 namespace kvdbManager
 {
 
+namespace
+{
+rocksdb::CompressionType compressionFromStr(const std::string& name)
+{
+    static const std::map<std::string, rocksdb::CompressionType> compressions {
+        {"none", rocksdb::kNoCompression},
+        {"snappy", rocksdb::kSnappyCompression},
+        {"zlib", rocksdb::kZlibCompression},
+        {"lz4", rocksdb::kLZ4Compression},
+        {"lz4hc", rocksdb::kLZ4HCCompression},
+        {"zstd", rocksdb::kZSTD}};
+
+    const auto it = compressions.find(name);
+    if (it == compressions.end())
+    {
+        throw std::runtime_error(fmt::format("Unknown KVDB compression '{}'", name));
+    }
+    return it->second;
+}
+} // namespace
+
 KVDBManager::KVDBManager(const KVDBManagerOptions& options,
                          const std::shared_ptr<metricsManager::IMetricsManager>& metricsManager)
 {
     m_ManagerOptions = options;
     m_spMetricsScope = metricsManager->getMetricsScope("KVDB");
+    m_spCacheHits = m_spMetricsScope->getLocalCounterUInteger("CacheHits");
+    m_spCacheMisses = m_spMetricsScope->getLocalCounterUInteger("CacheMisses");
     m_kvdbHandlerCollection = std::make_shared<KVDBHandlerCollection>();
+
+    if (m_ManagerOptions.statisticsInterval > 0)
+    {
+        const std::vector<std::pair<uint32_t, std::string>> tickers {
+            {rocksdb::BLOCK_CACHE_HIT, "RocksDBBlockCacheHits"},
+            {rocksdb::BLOCK_CACHE_MISS, "RocksDBBlockCacheMisses"},
+            {rocksdb::BLOOM_FILTER_USEFUL, "RocksDBBloomFilterUseful"},
+            {rocksdb::MEMTABLE_HIT, "RocksDBMemtableHits"},
+            {rocksdb::MEMTABLE_MISS, "RocksDBMemtableMisses"},
+            {rocksdb::NUMBER_KEYS_READ, "RocksDBKeysRead"},
+            {rocksdb::NUMBER_KEYS_WRITTEN, "RocksDBKeysWritten"}};
+
+        for (const auto& [ticker, name] : tickers)
+        {
+            m_statisticsGauges.emplace_back(ticker, m_spMetricsScope->getGaugeInteger(name, 0));
+        }
+        m_spBlockCacheUsage = m_spMetricsScope->getGaugeInteger("RocksDBBlockCacheUsage", 0);
+    }
+}
+
+KVDBManager::~KVDBManager()
+{
+    stopStatistics();
 }
 
 void KVDBManager::initialize()
@@ -27,6 +79,7 @@ void KVDBManager::initialize()
     {
         initializeOptions();
         initializeMainDB();
+        startStatistics();
         m_isInitialized = true;
     }
 }
@@ -35,6 +88,7 @@ void KVDBManager::finalize()
 {
     if (m_isInitialized)
     {
+        stopStatistics();
         finalizeMainDB();
         m_isInitialized = false;
     }
@@ -46,6 +100,103 @@ void KVDBManager::initializeOptions()
     m_rocksDBOptions.IncreaseParallelism();
     m_rocksDBOptions.OptimizeLevelStyleCompaction();
     m_rocksDBOptions.create_if_missing = true;
+    if (m_ManagerOptions.statisticsInterval > 0)
+    {
+        m_rocksDBOptions.statistics = rocksdb::CreateDBStatistics();
+    }
+
+    // Almost all the reads are point lookups, so the same tuning as OptimizeForPointLookup but with a block cache
+    // shared by all the Column Families, sized once for the whole engine
+    rocksdb::BlockBasedTableOptions tableOptions;
+    m_spBlockCache = m_ManagerOptions.blockCacheSize > 0 ? rocksdb::NewLRUCache(m_ManagerOptions.blockCacheSize)
+                                                         : nullptr;
+    if (m_spBlockCache)
+    {
+        tableOptions.block_cache = m_spBlockCache;
+    }
+    if (m_ManagerOptions.bloomBitsPerKey > 0)
+    {
+        tableOptions.filter_policy.reset(rocksdb::NewBloomFilterPolicy(m_ManagerOptions.bloomBitsPerKey));
+    }
+    if (m_ManagerOptions.optimizeForPointLookup)
+    {
+        tableOptions.data_block_index_type = rocksdb::BlockBasedTableOptions::kDataBlockBinaryAndHash;
+        tableOptions.data_block_hash_table_util_ratio = 0.75;
+    }
+
+    // The Column Family part of the options keeps the compaction tuning
+    m_cfOptions = rocksdb::ColumnFamilyOptions(m_rocksDBOptions);
+    m_cfOptions.table_factory.reset(rocksdb::NewBlockBasedTableFactory(tableOptions));
+    if (m_ManagerOptions.optimizeForPointLookup)
+    {
+        m_cfOptions.memtable_prefix_bloom_size_ratio = 0.02;
+        m_cfOptions.memtable_whole_key_filtering = true;
+    }
+
+    m_compression = compressionFromStr(m_ManagerOptions.compression);
+    m_dbCompression.clear();
+    for (const auto& [name, compression] : m_ManagerOptions.dbCompression)
+    {
+        m_dbCompression.emplace(name, compressionFromStr(compression));
+    }
+}
+
+rocksdb::ColumnFamilyOptions KVDBManager::columnFamilyOptions(const std::string& name) const
+{
+    auto cfOptions = m_cfOptions;
+
+    const auto it = m_dbCompression.find(name);
+    cfOptions.compression = it != m_dbCompression.end() ? it->second : m_compression;
+    // The compression per level set by the compaction tuning would override it
+    cfOptions.compression_per_level.clear();
+
+    return cfOptions;
+}
+
+void KVDBManager::startStatistics()
+{
+    if (!m_rocksDBOptions.statistics)
+    {
+        return;
+    }
+
+    m_stopStatistics = false;
+    m_statisticsThread = std::thread(
+        [this]()
+        {
+            const std::chrono::seconds interval(m_ManagerOptions.statisticsInterval);
+            std::unique_lock<std::mutex> lock(m_mutexStatistics);
+            while (!m_cvStatistics.wait_for(lock, interval, [this]() { return m_stopStatistics; }))
+            {
+                refreshStatistics();
+            }
+        });
+}
+
+void KVDBManager::stopStatistics()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutexStatistics);
+        m_stopStatistics = true;
+    }
+    m_cvStatistics.notify_all();
+
+    if (m_statisticsThread.joinable())
+    {
+        m_statisticsThread.join();
+    }
+}
+
+void KVDBManager::refreshStatistics()
+{
+    for (const auto& [ticker, gauge] : m_statisticsGauges)
+    {
+        gauge->setValue(static_cast<int64_t>(m_rocksDBOptions.statistics->getTickerCount(ticker)));
+    }
+    if (m_spBlockCache)
+    {
+        m_spBlockCacheUsage->setValue(static_cast<int64_t>(m_spBlockCache->GetUsage()));
+    }
 }
 
 void KVDBManager::initializeMainDB()
@@ -72,15 +223,15 @@ void KVDBManager::initializeMainDB()
                 hasDefaultCF = true;
             }
 
-            auto newDescriptor = rocksdb::ColumnFamilyDescriptor(cfName, rocksdb::ColumnFamilyOptions());
+            auto newDescriptor = rocksdb::ColumnFamilyDescriptor(cfName, columnFamilyOptions(cfName));
             cfDescriptors.push_back(newDescriptor);
         }
     }
 
     if (!hasDefaultCF)
     {
-        auto newDescriptor =
-            rocksdb::ColumnFamilyDescriptor(rocksdb::kDefaultColumnFamilyName, rocksdb::ColumnFamilyOptions());
+        auto newDescriptor = rocksdb::ColumnFamilyDescriptor(rocksdb::kDefaultColumnFamilyName,
+                                                             columnFamilyOptions(rocksdb::kDefaultColumnFamilyName));
         cfDescriptors.push_back(newDescriptor);
     }
 
@@ -90,6 +241,7 @@ void KVDBManager::initializeMainDB()
     if (statusOpen.ok())
     {
         m_pRocksDB = std::shared_ptr<rocksdb::DB>(rawRocksDBPtr);
+        m_spEpoch = std::make_shared<KVDBEpoch>();
 
         // rocksdb::DB::Open returns two vectors.
         // One with the descriptors containing the names of the DBs. (cfDescriptors)
@@ -117,6 +269,17 @@ void KVDBManager::initializeMainDB()
 
 void KVDBManager::finalizeMainDB()
 {
+    // The handlers still alive stop using the DB before it is released
+    if (m_spEpoch)
+    {
+        m_spEpoch->close();
+        m_spEpoch.reset();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutexCaches);
+        m_mapCaches.clear();
+    }
     m_mapCFHandles.clear();
     m_pDefaultCFHandle.reset();
     m_pRocksDB.reset();
@@ -125,24 +288,58 @@ void KVDBManager::finalizeMainDB()
 base::RespOrError<std::shared_ptr<IKVDBHandler>> KVDBManager::getKVDBHandler(const std::string& dbName,
                                                                              const std::string& scopeName)
 {
-    std::shared_ptr<rocksdb::ColumnFamilyHandle> cfHandle;
-
-    if (m_mapCFHandles.count(dbName))
-    {
-        cfHandle = m_mapCFHandles[dbName];
-    }
-    else
+    const auto it = m_mapCFHandles.find(dbName);
+    if (it == m_mapCFHandles.end())
     {
         return base::Error {fmt::format("The DB '{}' does not exists.", dbName)};
     }
 
     m_kvdbHandlerCollection->addKVDBHandler(dbName, scopeName);
 
-    auto kvdbHandler = std::make_shared<KVDBHandler>(m_pRocksDB, cfHandle, m_kvdbHandlerCollection, dbName, scopeName);
+    // The DB can't be deleted while it has handlers, they use the Column Family without pinning it
+    auto kvdbHandler = std::make_shared<KVDBHandler>(m_pRocksDB.get(),
+                                                     it->second.get(),
+                                                     m_spEpoch,
+                                                     m_kvdbHandlerCollection,
+                                                     dbName,
+                                                     scopeName,
+                                                     getCache(dbName));
 
     return kvdbHandler;
 }
 
+std::shared_ptr<KVDBCache> KVDBManager::getCache(const std::string& name)
+{
+    if (m_ManagerOptions.cacheSize == 0)
+    {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutexCaches);
+    auto& cache = m_mapCaches[name];
+    if (!cache)
+    {
+        cache = std::make_shared<KVDBCache>(
+            m_ManagerOptions.cacheSize, DEFAULT_CACHE_SHARDS, m_spCacheHits, m_spCacheMisses);
+    }
+
+    return cache;
+}
+
+void KVDBManager::invalidateCache(const std::string& name, bool drop)
+{
+    std::lock_guard<std::mutex> lock(m_mutexCaches);
+    auto it = m_mapCaches.find(name);
+    if (it != m_mapCaches.end())
+    {
+        it->second->clear();
+        if (drop)
+        {
+            m_mapCaches.erase(it);
+        }
+    }
+}
+
 std::vector<std::string> KVDBManager::listDBs(const bool loaded)
 {
     std::vector<std::string> spaces;
@@ -176,6 +373,7 @@ base::OptError KVDBManager::deleteDB(const std::string& name)
             if (opStatus.ok())
             {
                 m_mapCFHandles.erase(it);
+                invalidateCache(name, true);
             }
             else
             {
@@ -217,11 +415,14 @@ base::OptError KVDBManager::loadDBFromJson(const std::string& name, const json::
         const auto status = m_pRocksDB->Put(rocksdb::WriteOptions(), cfHandle.get(), key, value.str());
         if (!status.ok())
         {
+            invalidateCache(name, false);
             return base::Error {fmt::format(
                 "An error occurred while inserting data key {}, value {}: ", key, value.str(), status.ToString())};
         }
     }
 
+    invalidateCache(name, false);
+
     return std::nullopt;
 }
 
@@ -242,7 +443,7 @@ base::OptError KVDBManager::createDB(const std::string& name, const std::string&
         return errorCreate;
     }
 
-    auto errorLoad = loadDBFromJson(name, content);
+    auto errorLoad = ingestJson(name, content, false);
 
     if (errorLoad)
     {
@@ -257,6 +458,92 @@ base::OptError KVDBManager::createDB(const std::string& name, const std::string&
     return std::nullopt;
 }
 
+base::OptError KVDBManager::importDB(const std::string& name, const std::string& path, bool replace)
+{
+    auto result = getContentFromJsonFile(path);
+
+    if (std::holds_alternative<base::Error>(result))
+    {
+        return std::get<base::Error>(result);
+    }
+
+    auto errorCreate = createDB(name);
+
+    if (errorCreate)
+    {
+        return errorCreate;
+    }
+
+    return ingestJson(name, std::get<json::Json>(result), replace);
+}
+
+base::OptError KVDBManager::ingestJson(const std::string& name, const json::Json& content, bool replace)
+{
+    std::shared_ptr<rocksdb::ColumnFamilyHandle> cfHandle;
+
+    if (m_mapCFHandles.count(name))
+    {
+        cfHandle = m_mapCFHandles[name];
+    }
+
+    if (!cfHandle)
+    {
+        return base::Error {fmt::format("The DB '{}' does not exists.", name)};
+    }
+
+    auto entries = content.getObject().value();
+
+    // The SST file needs the keys in increasing order, a repeated key keeps its last value as with Put
+    std::stable_sort(entries.begin(),
+                     entries.end(),
+                     [](const auto& lhs, const auto& rhs) { return std::get<0>(lhs) < std::get<0>(rhs); });
+
+    if (entries.empty() && !replace)
+    {
+        return std::nullopt;
+    }
+
+    const auto sstPath = m_ManagerOptions.dbStoragePath / fmt::format("{}.import.sst", name);
+    rocksdb::SstFileWriter writer(rocksdb::EnvOptions(), rocksdb::Options(m_rocksDBOptions, columnFamilyOptions(name)));
+
+    auto status = writer.Open(sstPath.string());
+    if (status.ok() && replace)
+    {
+        // Same sequence number as the entries of the file, so it only deletes the entries already in the DB
+        status = writer.DeleteRange("", "\xff");
+    }
+    for (auto it = entries.begin(); status.ok() && it != entries.end(); ++it)
+    {
+        const auto next = std::next(it);
+        if (next == entries.end() || std::get<0>(*next) != std::get<0>(*it))
+        {
+            status = writer.Put(std::get<0>(*it), std::get<1>(*it).str());
+        }
+    }
+    if (status.ok())
+    {
+        status = writer.Finish();
+    }
+
+    if (status.ok())
+    {
+        rocksdb::IngestExternalFileOptions options;
+        options.move_files = true;
+        status = m_pRocksDB->IngestExternalFile(cfHandle.get(), {sstPath.string()}, options);
+    }
+
+    std::error_code ec;
+    std::filesystem::remove(sstPath, ec);
+    invalidateCache(name, false);
+
+    if (!status.ok())
+    {
+        return base::Error {fmt::format("Could not import the DB '{}', RocksDB Status: {}", name, status.ToString())};
+    }
+
+    return std::nullopt;
+}
+
 base::OptError KVDBManager::createDB(const std::string& name)
 {
     if (existsDB(name))
@@ -344,7 +631,7 @@ uint32_t KVDBManager::getKVDBHandlersCount(const std::string& dbName) const
 base::OptError KVDBManager::createColumnFamily(const std::string& name)
 {
     rocksdb::ColumnFamilyHandle* cfHandle {nullptr};
-    rocksdb::Status s {m_pRocksDB->CreateColumnFamily(rocksdb::ColumnFamilyOptions(), name, &cfHandle)};
+    rocksdb::Status s {m_pRocksDB->CreateColumnFamily(columnFamilyOptions(name), name, &cfHandle)};
 
     if (s.ok())
     {
@@ -57,6 +57,11 @@ inline base::RespOrError<std::list<std::pair<std::string, std::string>>> kvdbDum
     return std::list<std::pair<std::string, std::string>>();
 }
 
+inline base::RespOrError<kvdbManager::KVDBPage> kvdbScanOk()
+{
+    return kvdbManager::KVDBPage();
+}
+
 /******************************************************************************/
 // Mock classes
 /******************************************************************************/
@@ -82,6 +87,10 @@ public:
                 search,
                 (const std::string& prefix),
                 ());
+    MOCK_METHOD((base::RespOrError<kvdbManager::KVDBPage>),
+                scan,
+                (const std::string& prefix, const std::string& cursor, const unsigned int records),
+                (override));
 };
 
 } // namespace kvdb::mocks
@@ -240,6 +240,76 @@ TEST_F(KVDBHandlerTest, GetKeyWithoutValue)
     ASSERT_EQ(std::get<std::string>(resultGet), "");
 }
 
+TEST_F(KVDBHandlerTest, GetJsonInvalidatedByOtherHandler)
+{
+    ASSERT_FALSE(m_kvdbManager->createDB("GetJsonInvalidated"));
+    auto resultReader = m_kvdbManager->getKVDBHandler("GetJsonInvalidated", "scope1");
+    auto resultWriter = m_kvdbManager->getKVDBHandler("GetJsonInvalidated", "scope2");
+    ASSERT_FALSE(std::holds_alternative<base::Error>(resultReader));
+    ASSERT_FALSE(std::holds_alternative<base::Error>(resultWriter));
+    auto reader = std::move(std::get<std::shared_ptr<kvdbManager::IKVDBHandler>>(resultReader));
+    auto writer = std::move(std::get<std::shared_ptr<kvdbManager::IKVDBHandler>>(resultWriter));
+
+    ASSERT_TRUE(std::holds_alternative<base::Error>(reader->getJson("key1")));
+
+    ASSERT_EQ(writer->set("key1", json::Json {R"({"a":1})"}), std::nullopt);
+    for (auto i = 0; i < 2; ++i)
+    {
+        auto result = reader->getJson("key1");
+        ASSERT_TRUE(std::holds_alternative<json::Json>(result));
+        ASSERT_EQ(std::get<json::Json>(result), json::Json {R"({"a":1})"});
+    }
+
+    ASSERT_EQ(writer->set("key1", json::Json {R"({"a":2})"}), std::nullopt);
+    auto result = reader->getJson("key1");
+    ASSERT_TRUE(std::holds_alternative<json::Json>(result));
+    ASSERT_EQ(std::get<json::Json>(result), json::Json {R"({"a":2})"});
+
+    ASSERT_EQ(writer->remove("key1"), std::nullopt);
+    ASSERT_TRUE(std::holds_alternative<base::Error>(reader->getJson("key1")));
+}
+
+TEST_F(KVDBHandlerTest, GetJsonMalformedValue)
+{
+    ASSERT_FALSE(m_kvdbManager->createDB("GetJsonMalformed"));
+    auto resultHandler = m_kvdbManager->getKVDBHandler("GetJsonMalformed", "scope1");
+    ASSERT_FALSE(std::holds_alternative<base::Error>(resultHandler));
+    auto handler = std::move(std::get<std::shared_ptr<kvdbManager::IKVDBHandler>>(resultHandler));
+
+    ASSERT_EQ(handler->set("key1", "not json"), std::nullopt);
+    ASSERT_THROW(handler->getJson("key1"), std::runtime_error);
+    ASSERT_THROW(handler->getJson("key1"), std::runtime_error);
+}
+
+TEST_F(KVDBHandlerTest, GetJsonReloadedDB)
+{
+    ASSERT_FALSE(m_kvdbManager->createDB("GetJsonReloaded"));
+    auto resultHandler = m_kvdbManager->getKVDBHandler("GetJsonReloaded", "scope1");
+    ASSERT_FALSE(std::holds_alternative<base::Error>(resultHandler));
+    auto handler = std::move(std::get<std::shared_ptr<kvdbManager::IKVDBHandler>>(resultHandler));
+
+    ASSERT_EQ(handler->set("key1", json::Json {"1"}), std::nullopt);
+    ASSERT_EQ(std::get<json::Json>(handler->getJson("key1")), json::Json {"1"});
+
+    ASSERT_FALSE(m_kvdbManager->loadDBFromJson("GetJsonReloaded", json::Json {R"({"key1": 2})"}));
+    ASSERT_EQ(std::get<json::Json>(handler->getJson("key1")), json::Json {"2"});
+}
+
+TEST_F(KVDBHandlerTest, UseAfterFinalize)
+{
+    ASSERT_FALSE(m_kvdbManager->createDB("UseAfterFinalize"));
+    auto resultHandler = m_kvdbManager->getKVDBHandler("UseAfterFinalize", "scope1");
+    ASSERT_FALSE(std::holds_alternative<base::Error>(resultHandler));
+    auto handler = std::move(std::get<std::shared_ptr<kvdbManager::IKVDBHandler>>(resultHandler));
+    ASSERT_EQ(handler->set("key1", "value1"), std::nullopt);
+
+    m_kvdbManager->finalize();
+
+    ASSERT_TRUE(std::holds_alternative<base::Error>(handler->get("key1")));
+    ASSERT_TRUE(handler->set("key1", "value2").has_value());
+    ASSERT_TRUE(std::holds_alternative<base::Error>(handler->dump(1, 10)));
+}
+
 TEST_F(KVDBHandlerTest, DumpOkValidateOrder)
 {
     ASSERT_FALSE(m_kvdbManager->createDB("DumpOkValidateOrder"));
@@ -292,6 +362,96 @@ TEST_F(KVDBHandlerTest, DumpWihoutKeys)
     ASSERT_EQ(result.size(), 0);
 }
 
+TEST_F(KVDBHandlerTest, DumpAllContent)
+{
+    ASSERT_FALSE(m_kvdbManager->createDB("DumpAllContent"));
+    auto resultHandler = m_kvdbManager->getKVDBHandler("DumpAllContent", "scope1");
+    ASSERT_FALSE(std::holds_alternative<base::Error>(resultHandler));
+    auto handler = std::move(std::get<std::shared_ptr<kvdbManager::IKVDBHandler>>(resultHandler));
+
+    for (auto i = 0; i < 20; i++)
+    {
+        ASSERT_EQ(handler->set(fmt::format("key{:02}", i), "value"), std::nullopt);
+    }
+
+    const auto resultDump = handler->dump();
+    ASSERT_FALSE(std::holds_alternative<base::Error>(resultDump));
+    ASSERT_EQ(std::get<std::list<std::pair<std::string, std::string>>>(resultDump).size(), 20);
+
+    const auto resultSearch = handler->search("key1");
+    ASSERT_FALSE(std::holds_alternative<base::Error>(resultSearch));
+    ASSERT_EQ(std::get<std::list<std::pair<std::string, std::string>>>(resultSearch).size(), 10);
+}
+
+TEST_F(KVDBHandlerTest, ScanWithCursor)
+{
+    ASSERT_FALSE(m_kvdbManager->createDB("ScanWithCursor"));
+    auto resultHandler = m_kvdbManager->getKVDBHandler("ScanWithCursor", "scope1");
+    ASSERT_FALSE(std::holds_alternative<base::Error>(resultHandler));
+    auto handler = std::move(std::get<std::shared_ptr<kvdbManager::IKVDBHandler>>(resultHandler));
+
+    for (auto i = 0; i < 23; i++)
+    {
+        ASSERT_EQ(handler->set(fmt::format("key{:02}", i), fmt::format("value{}", i)), std::nullopt);
+    }
+
+    std::string cursor;
+    auto expected = 0;
+    auto pages = 0;
+    do
+    {
+        const auto result = handler->scan("", cursor, 5);
+        ASSERT_FALSE(std::holds_alternative<base::Error>(result));
+        const auto& page = std::get<kvdbManager::KVDBPage>(result);
+        ASSERT_LE(page.entries.size(), 5);
+        for (const auto& [key, value] : page.entries)
+        {
+            ASSERT_EQ(key, fmt::format("key{:02}", expected));
+            ASSERT_EQ(value, fmt::format("value{}", expected));
+            expected++;
+        }
+        cursor = page.cursor;
+        pages++;
+    } while (!cursor.empty());
+
+    ASSERT_EQ(expected, 23);
+    ASSERT_EQ(pages, 5);
+}
+
+TEST_F(KVDBHandlerTest, ScanWithPrefix)
+{
+    ASSERT_FALSE(m_kvdbManager->createDB("ScanWithPrefix"));
+    auto resultHandler = m_kvdbManager->getKVDBHandler("ScanWithPrefix", "scope1");
+    ASSERT_FALSE(std::holds_alternative<base::Error>(resultHandler));
+    auto handler = std::move(std::get<std::shared_ptr<kvdbManager::IKVDBHandler>>(resultHandler));
+
+    for (const auto& key : {"a1", "b1", "b2", "b3", "c1"})
+    {
+        ASSERT_EQ(handler->set(key, "value"), std::nullopt);
+    }
+
+    auto result = handler->scan("b", "", 2);
+    ASSERT_FALSE(std::holds_alternative<base::Error>(result));
+    auto page = std::get<kvdbManager::KVDBPage>(result);
+    ASSERT_EQ(page.entries.size(), 2);
+    ASSERT_EQ(page.entries.front().first, "b1");
+    ASSERT_EQ(page.cursor, "b2");
+
+    result = handler->scan("b", page.cursor, 2);
+    ASSERT_FALSE(std::holds_alternative<base::Error>(result));
+    page = std::get<kvdbManager::KVDBPage>(result);
+    ASSERT_EQ(page.entries.size(), 1);
+    ASSERT_EQ(page.entries.front().first, "b3");
+    ASSERT_TRUE(page.cursor.empty());
+
+    // All the remaining records
+    result = handler->scan("", "a1", 0);
+    ASSERT_FALSE(std::holds_alternative<base::Error>(result));
+    ASSERT_EQ(std::get<kvdbManager::KVDBPage>(result).entries.size(), 4);
+
+    ASSERT_TRUE(std::holds_alternative<base::Error>(handler->scan("b", "c1", 2)));
+}
+
 TEST_P(DumpWithMultiplePages, Dump)
 {
     auto [inserts, page, records, expected] = GetParam();
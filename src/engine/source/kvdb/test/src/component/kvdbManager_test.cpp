@@ -1,4 +1,5 @@
 #include <filesystem>
+#include <fstream>
 #include <gtest/gtest.h>
 #include <iostream>
 #include <random>
@@ -38,6 +39,20 @@ void Setup(const std::string& kvdbPath)
     }
 }
 
+std::string writeJsonFile(const std::string& kvdbPath, const std::string& name, const std::string& content)
+{
+    const auto path = std::filesystem::path(kvdbPath) / name;
+    std::ofstream(path) << content;
+    return path.string();
+}
+
+std::list<std::pair<std::string, std::string>> dumpDB(std::shared_ptr<kvdbManager::IKVDBManager> manager,
+                                                      const std::string& name)
+{
+    auto handler = std::get<std::shared_ptr<kvdbManager::IKVDBHandler>>(manager->getKVDBHandler(name, "test"));
+    return std::get<std::list<std::pair<std::string, std::string>>>(handler->dump());
+}
+
 void TearDown(const std::string& kvdbPath)
 {
     if (std::filesystem::exists(kvdbPath))
@@ -185,4 +200,130 @@ TEST_F(KVDBManagerTest, DeleteDataBaseWithRestart)
     dbList = m_kvdbManager->listDBs(true);
     ASSERT_EQ(dbList.size(), 0);
 }
-} // namespace
\ No newline at end of file
+
+TEST_F(KVDBManagerTest, CreateDBFromFile)
+{
+    const auto path = writeJsonFile(kvdbPath, "create.json", R"({"k2": {"a": 1}, "k1": "v1", "k3": [1, 2]})");
+    ASSERT_EQ(m_kvdbManager->createDB("CreateDBFromFile", path), std::nullopt);
+
+    const std::list<std::pair<std::string, std::string>> expected {
+        {"k1", R"("v1")"}, {"k2", R"({"a":1})"}, {"k3", "[1,2]"}};
+    ASSERT_EQ(dumpDB(m_kvdbManager, "CreateDBFromFile"), expected);
+}
+
+TEST_F(KVDBManagerTest, ImportDBCreates)
+{
+    const auto path = writeJsonFile(kvdbPath, "import.json", R"({"k1": "v1"})");
+    ASSERT_EQ(m_kvdbManager->importDB("ImportDBCreates", path, false), std::nullopt);
+    ASSERT_TRUE(m_kvdbManager->existsDB("ImportDBCreates"));
+
+    const std::list<std::pair<std::string, std::string>> expected {{"k1", R"("v1")"}};
+    ASSERT_EQ(dumpDB(m_kvdbManager, "ImportDBCreates"), expected);
+}
+
+TEST_F(KVDBManagerTest, ImportDBMerge)
+{
+    ASSERT_EQ(m_kvdbManager->createDB("ImportDBMerge"), std::nullopt);
+    auto handler =
+        std::get<std::shared_ptr<kvdbManager::IKVDBHandler>>(m_kvdbManager->getKVDBHandler("ImportDBMerge", "test"));
+    ASSERT_EQ(handler->set("k0", "\"old\""), std::nullopt);
+    ASSERT_EQ(handler->set("k1", "\"old\""), std::nullopt);
+
+    const auto path = writeJsonFile(kvdbPath, "import.json", R"({"k2": "new", "k1": "new"})");
+    ASSERT_EQ(m_kvdbManager->importDB("ImportDBMerge", path, false), std::nullopt);
+
+    const std::list<std::pair<std::string, std::string>> expected {
+        {"k0", R"("old")"}, {"k1", R"("new")"}, {"k2", R"("new")"}};
+    ASSERT_EQ(dumpDB(m_kvdbManager, "ImportDBMerge"), expected);
+}
+
+TEST_F(KVDBManagerTest, ImportDBReplace)
+{
+    ASSERT_EQ(m_kvdbManager->createDB("ImportDBReplace"), std::nullopt);
+    auto handler =
+        std::get<std::shared_ptr<kvdbManager::IKVDBHandler>>(m_kvdbManager->getKVDBHandler("ImportDBReplace", "test"));
+    ASSERT_EQ(handler->set("k0", "\"old\""), std::nullopt);
+    ASSERT_EQ(handler->set("k1", "\"old\""), std::nullopt);
+    // Cached before the import, it must not be served after it
+    ASSERT_EQ(std::get<json::Json>(handler->getJson("k1")), json::Json {R"("old")"});
+
+    const auto path = writeJsonFile(kvdbPath, "import.json", R"({"k2": "new", "k1": "new"})");
+    ASSERT_EQ(m_kvdbManager->importDB("ImportDBReplace", path, true), std::nullopt);
+
+    const std::list<std::pair<std::string, std::string>> expected {{"k1", R"("new")"}, {"k2", R"("new")"}};
+    ASSERT_EQ(dumpDB(m_kvdbManager, "ImportDBReplace"), expected);
+    ASSERT_EQ(std::get<json::Json>(handler->getJson("k1")), json::Json {R"("new")"});
+    ASSERT_FALSE(std::get<bool>(handler->contains("k0")));
+}
+
+TEST_F(KVDBManagerTest, ImportDBReplaceEmpty)
+{
+    ASSERT_EQ(m_kvdbManager->createDB("ImportDBReplaceEmpty"), std::nullopt);
+    auto handler = std::get<std::shared_ptr<kvdbManager::IKVDBHandler>>(
+        m_kvdbManager->getKVDBHandler("ImportDBReplaceEmpty", "test"));
+    ASSERT_EQ(handler->set("k0", "\"old\""), std::nullopt);
+
+    const auto path = writeJsonFile(kvdbPath, "import.json", "{}");
+    ASSERT_EQ(m_kvdbManager->importDB("ImportDBReplaceEmpty", path, true), std::nullopt);
+    ASSERT_TRUE(dumpDB(m_kvdbManager, "ImportDBReplaceEmpty").empty());
+}
+
+TEST_F(KVDBManagerTest, ImportDBInvalidFile)
+{
+    ASSERT_TRUE(m_kvdbManager->importDB("ImportDBInvalidFile", kvdbPath + "missing.json", false).has_value());
+
+    const auto path = writeJsonFile(kvdbPath, "import.json", "[1, 2]");
+    ASSERT_TRUE(m_kvdbManager->importDB("ImportDBInvalidFile", path, false).has_value());
+    ASSERT_FALSE(m_kvdbManager->existsDB("ImportDBInvalidFile"));
+}
+
+TEST_F(KVDBManagerTest, ReopenWithOtherOptions)
+{
+    m_kvdbManager->finalize();
+
+    kvdbManager::KVDBManagerOptions tunedOptions {kvdbPath, KVDB_DB_FILENAME};
+    tunedOptions.blockCacheSize = 1 << 20;
+    tunedOptions.bloomBitsPerKey = 16;
+    tunedOptions.optimizeForPointLookup = true;
+    tunedOptions.dbCompression = {{"ReopenWithOtherOptions", "none"}};
+    tunedOptions.statisticsInterval = 1;
+    m_kvdbManager = std::make_shared<kvdbManager::KVDBManager>(tunedOptions, metricsManager);
+    m_kvdbManager->initialize();
+
+    ASSERT_EQ(m_kvdbManager->createDB("ReopenWithOtherOptions"), std::nullopt);
+    {
+        auto handler = std::get<std::shared_ptr<kvdbManager::IKVDBHandler>>(
+            m_kvdbManager->getKVDBHandler("ReopenWithOtherOptions", "test"));
+        ASSERT_EQ(handler->set("k1", "\"v1\""), std::nullopt);
+        ASSERT_EQ(std::get<std::string>(handler->get("k1")), "\"v1\"");
+    }
+    m_kvdbManager->finalize();
+
+    // The existing Column Families are opened with the new options
+    kvdbManager::KVDBManagerOptions plainOptions {kvdbPath, KVDB_DB_FILENAME};
+    plainOptions.blockCacheSize = 0;
+    plainOptions.bloomBitsPerKey = 0;
+    plainOptions.optimizeForPointLookup = false;
+    plainOptions.statisticsInterval = 0;
+    m_kvdbManager = std::make_shared<kvdbManager::KVDBManager>(plainOptions, metricsManager);
+    m_kvdbManager->initialize();
+
+    auto handler = std::get<std::shared_ptr<kvdbManager::IKVDBHandler>>(
+        m_kvdbManager->getKVDBHandler("ReopenWithOtherOptions", "test"));
+    ASSERT_EQ(std::get<std::string>(handler->get("k1")), "\"v1\"");
+    ASSERT_FALSE(std::get<bool>(handler->contains("k2")));
+}
+
+TEST_F(KVDBManagerTest, UnknownCompression)
+{
+    kvdbManager::KVDBManagerOptions options {kvdbPath + "unknown/", KVDB_DB_FILENAME};
+    options.compression = "brotli";
+    auto manager = std::make_shared<kvdbManager::KVDBManager>(options, metricsManager);
+    ASSERT_THROW(manager->initialize(), std::runtime_error);
+
+    options.compression = kvdbManager::DEFAULT_COMPRESSION;
+    options.dbCompression = {{"db", "brotli"}};
+    manager = std::make_shared<kvdbManager::KVDBManager>(options, metricsManager);
+    ASSERT_THROW(manager->initialize(), std::runtime_error);
+}
+} // namespace
@@ -0,0 +1,143 @@
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <kvdb/kvdbCache.hpp>
+
+using namespace kvdbManager;
+
+TEST(KVDBCacheTest, InvalidSize)
+{
+    EXPECT_THROW(KVDBCache(0), std::runtime_error);
+    EXPECT_THROW(KVDBCache(10, 0), std::runtime_error);
+    EXPECT_NO_THROW(KVDBCache(1));
+}
+
+TEST(KVDBCacheTest, MissThenHit)
+{
+    KVDBCache cache(10);
+    KVDBCache::Ticket ticket {};
+
+    ASSERT_FALSE(cache.get("key", ticket));
+    EXPECT_FALSE(cache.contains("key"));
+    cache.put("key", json::Json {R"({"a":1})"}, ticket);
+
+    auto value = cache.get("key", ticket);
+    ASSERT_TRUE(value);
+    EXPECT_EQ(value.value().str(), R"({"a":1})");
+    EXPECT_TRUE(cache.contains("key"));
+
+    EXPECT_EQ(cache.hits(), 1);
+    EXPECT_EQ(cache.misses(), 1);
+    EXPECT_EQ(cache.size(), 1);
+}
+
+TEST(KVDBCacheTest, EraseInvalidates)
+{
+    KVDBCache cache(10);
+    KVDBCache::Ticket ticket {};
+
+    cache.get("key", ticket);
+    cache.put("key", json::Json {"1"}, ticket);
+    cache.erase("key");
+
+    EXPECT_FALSE(cache.get("key", ticket));
+    EXPECT_EQ(cache.size(), 0);
+}
+
+TEST(KVDBCacheTest, StaleFillIsDiscarded)
+{
+    KVDBCache cache(10, 1);
+    KVDBCache::Ticket ticket {};
+
+    // The value is read from the DB, then a write invalidates the key before the cache is filled
+    ASSERT_FALSE(cache.get("key", ticket));
+    cache.erase("key");
+    cache.put("key", json::Json {"\"old\""}, ticket);
+    EXPECT_FALSE(cache.contains("key"));
+
+    // Same with a clear
+    ASSERT_FALSE(cache.get("key", ticket));
+    cache.clear();
+    cache.put("key", json::Json {"\"old\""}, ticket);
+    EXPECT_FALSE(cache.contains("key"));
+
+    ASSERT_FALSE(cache.get("key", ticket));
+    cache.put("key", json::Json {"\"new\""}, ticket);
+    EXPECT_TRUE(cache.contains("key"));
+}
+
+TEST(KVDBCacheTest, EvictsLeastRecentlyUsed)
+{
+    KVDBCache cache(2, 1);
+    KVDBCache::Ticket ticket {};
+
+    for (const auto& key : {"a", "b"})
+    {
+        cache.get(key, ticket);
+        cache.put(key, json::Json {"1"}, ticket);
+    }
+
+    // "a" is used, so "b" is the one evicted
+    ASSERT_TRUE(cache.get("a", ticket));
+    cache.get("c", ticket);
+    cache.put("c", json::Json {"1"}, ticket);
+
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_TRUE(cache.contains("a"));
+    EXPECT_FALSE(cache.contains("b"));
+    EXPECT_TRUE(cache.contains("c"));
+}
+
+TEST(KVDBCacheTest, Clear)
+{
+    KVDBCache cache(1000);
+    KVDBCache::Ticket ticket {};
+
+    for (auto i = 0; i < 50; ++i)
+    {
+        const auto key = std::to_string(i);
+        cache.get(key, ticket);
+        cache.put(key, json::Json {"1"}, ticket);
+    }
+    EXPECT_EQ(cache.size(), 50);
+
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0);
+}
+
+TEST(KVDBCacheTest, Concurrent)
+{
+    KVDBCache cache(64, 4);
+    std::vector<std::thread> threads;
+
+    for (auto t = 0; t < 4; ++t)
+    {
+        threads.emplace_back(
+            [&cache, t]()
+            {
+                KVDBCache::Ticket ticket {};
+                for (auto i = 0; i < 10000; ++i)
+                {
+                    const auto key = std::to_string((i * 7 + t) % 128);
+                    if (!cache.get(key, ticket))
+                    {
+                        cache.put(key, json::Json {key.c_str()}, ticket);
+                    }
+                    if (i % 100 == 0)
+                    {
+                        cache.erase(key);
+                    }
+                }
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_LE(cache.size(), 64);
+    EXPECT_EQ(cache.hits() + cache.misses(), 40000);
+}
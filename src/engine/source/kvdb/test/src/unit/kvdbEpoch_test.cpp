@@ -0,0 +1,52 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <kvdb/kvdbEpoch.hpp>
+
+using namespace kvdbManager;
+
+TEST(KVDBEpochTest, EnterOpen)
+{
+    KVDBEpoch epoch;
+    const auto first = epoch.enter();
+    const auto second = epoch.enter();
+    EXPECT_TRUE(first);
+    EXPECT_TRUE(second);
+}
+
+TEST(KVDBEpochTest, EnterClosed)
+{
+    KVDBEpoch epoch;
+    epoch.close();
+    EXPECT_FALSE(epoch.enter());
+}
+
+TEST(KVDBEpochTest, CloseWaitsReaders)
+{
+    KVDBEpoch epoch;
+    std::atomic<bool> entered {false};
+    std::atomic<bool> left {false};
+
+    std::thread reader(
+        [&]()
+        {
+            const auto guard = epoch.enter();
+            entered = true;
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            left = true;
+        });
+
+    while (!entered)
+    {
+        std::this_thread::yield();
+    }
+
+    epoch.close();
+    EXPECT_TRUE(left);
+    EXPECT_FALSE(epoch.enter());
+
+    reader.join();
+}
@@ -1,6 +1,9 @@
 #ifndef _LOGICEXPR_EVALUATOR_H
 #define _LOGICEXPR_EVALUATOR_H
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <stack>
@@ -16,6 +19,9 @@
 namespace logicexpr::evaluator
 {
 
+constexpr double DEFAULT_TERM_COST = 1.0;            ///< Cost of a term whose cost is unknown
+constexpr std::size_t DEFAULT_REORDER_PERIOD = 1024; ///< Evaluations between two reorders of the operands
+
 /**
  * @brief Expression type
  *
@@ -44,6 +50,7 @@ public:
     ExpressionType m_type;
     FunctionType m_function;
     std::shared_ptr<ThisType> m_left, m_right;
+    double m_cost {DEFAULT_TERM_COST}; ///< Static cost of evaluating a term, relative to the other terms
 
     /**
      * @brief Get the Ptr object
@@ -211,6 +218,258 @@ typename Expression<Event>::FunctionType getDijstraEvaluator(const std::shared_p
     };
 }
 
+namespace detail
+{
+/**
+ * @brief Short-circuit evaluator that reorders the operands of AND and OR to evaluate the cheapest and most decisive
+ * first.
+ *
+ * Nested operators of the same type are flattened, so `a AND (b AND c)` has three operands that can be ordered freely.
+ * The operands of an AND are sorted by `cost / P(false)` and the ones of an OR by `cost / P(true)`, which minimizes
+ * the expected cost when the operands are independent. The probabilities are the pass rates observed while
+ * evaluating, so the order starts from the static costs and follows the traffic, counts are halved on each reorder
+ * so old traffic fades out.
+ *
+ * The terms must not have side effects, as the order they run in changes. The statistics are not synchronized, an
+ * evaluator must be used from one thread at a time.
+ *
+ * @tparam Event
+ */
+template<typename Event>
+class AdaptiveEvaluator
+{
+private:
+    struct Node
+    {
+        ExpressionType type;                           ///< Type of the node
+        typename Expression<Event>::FunctionType term; ///< Evaluation function, terms only
+        std::vector<std::size_t> operands;             ///< Operands, in evaluation order
+        double cost;                                   ///< Expected cost of evaluating the node
+        uint64_t evaluations;                          ///< Times the node was evaluated
+        uint64_t passes;                               ///< Times the node evaluated to true
+    };
+
+    std::vector<Node> m_nodes;   ///< The nodes, each one is stored before its operands
+    std::size_t m_reorderPeriod; ///< Evaluations between two reorders, 0 to only order by static costs
+    std::size_t m_untilReorder;  ///< Evaluations left before the next reorder
+
+    std::size_t compile(const std::shared_ptr<const Expression<Event>>& expression)
+    {
+        if (!expression)
+        {
+            throw std::runtime_error("Engine logic expression evaluator got an empty expression.");
+        }
+
+        const auto index = m_nodes.size();
+        m_nodes.push_back({expression->m_type, nullptr, {}, 0, 0, 0});
+
+        switch (expression->m_type)
+        {
+            case ExpressionType::TERM:
+                m_nodes[index].term = expression->m_function;
+                m_nodes[index].cost = expression->m_cost;
+                break;
+            case ExpressionType::NOT:
+            {
+                const auto operand = compile(expression->m_left);
+                m_nodes[index].operands.push_back(operand);
+                break;
+            }
+            case ExpressionType::AND:
+            case ExpressionType::OR: flatten(index, expression); break;
+            default: throw std::runtime_error("Engine logic expression evaluator got unknown operator type.");
+        }
+
+        return index;
+    }
+
+    void flatten(std::size_t index, const std::shared_ptr<const Expression<Event>>& expression)
+    {
+        for (const auto& side : {expression->m_left, expression->m_right})
+        {
+            if (side && side->m_type == m_nodes[index].type)
+            {
+                flatten(index, side);
+            }
+            else
+            {
+                const auto operand = compile(side);
+                m_nodes[index].operands.push_back(operand);
+            }
+        }
+    }
+
+    /**
+     * @brief Probability of a node evaluating to true, with Laplace smoothing so unseen nodes start at 1/2.
+     */
+    double passRate(const Node& node) const
+    {
+        return (static_cast<double>(node.passes) + 1) / (static_cast<double>(node.evaluations) + 2);
+    }
+
+    /**
+     * @brief Sort the operands of every operator and update their expected costs, from the leaves up.
+     */
+    void reorder()
+    {
+        // Operands are stored after their operator, a reverse walk visits them first
+        for (auto it = m_nodes.rbegin(); it != m_nodes.rend(); ++it)
+        {
+            auto& node = *it;
+            if (node.type == ExpressionType::NOT)
+            {
+                node.cost = m_nodes[node.operands.front()].cost;
+            }
+            else if (node.type == ExpressionType::AND || node.type == ExpressionType::OR)
+            {
+                const auto isAnd = node.type == ExpressionType::AND;
+                // Probability of an operand deciding the result, so the rest is not evaluated
+                auto decides = [&](std::size_t operand)
+                {
+                    const auto pass = passRate(m_nodes[operand]);
+                    return isAnd ? 1 - pass : pass;
+                };
+
+                std::stable_sort(node.operands.begin(),
+                                 node.operands.end(),
+                                 [&](std::size_t a, std::size_t b)
+                                 { return m_nodes[a].cost * decides(b) < m_nodes[b].cost * decides(a); });
+
+                // Expected cost, each operand only runs if the previous ones did not decide
+                node.cost = 0;
+                double reached = 1;
+                for (const auto operand : node.operands)
+                {
+                    node.cost += reached * m_nodes[operand].cost;
+                    reached *= 1 - decides(operand);
+                }
+            }
+        }
+
+        for (auto& node : m_nodes)
+        {
+            node.evaluations /= 2;
+            node.passes /= 2;
+        }
+    }
+
+    bool evaluate(std::size_t index, const Event& event)
+    {
+        auto& node = m_nodes[index];
+        bool result {false};
+
+        switch (node.type)
+        {
+            case ExpressionType::TERM: result = node.term(event); break;
+            case ExpressionType::NOT: result = !evaluate(node.operands.front(), event); break;
+            case ExpressionType::AND:
+                result = true;
+                for (const auto operand : node.operands)
+                {
+                    if (!evaluate(operand, event))
+                    {
+                        result = false;
+                        break;
+                    }
+                }
+                break;
+            case ExpressionType::OR:
+                for (const auto operand : node.operands)
+                {
+                    if (evaluate(operand, event))
+                    {
+                        result = true;
+                        break;
+                    }
+                }
+                break;
+            default: throw std::runtime_error("Engine logic expression evaluator got unknown operator type.");
+        }
+
+        ++node.evaluations;
+        node.passes += result ? 1 : 0;
+        return result;
+    }
+
+public:
+    AdaptiveEvaluator(const std::shared_ptr<const Expression<Event>>& expression, std::size_t reorderPeriod)
+        : m_nodes()
+        , m_reorderPeriod(reorderPeriod)
+        , m_untilReorder(reorderPeriod)
+    {
+        compile(expression);
+        reorder();
+    }
+
+    bool operator()(const Event& event)
+    {
+        const auto result = evaluate(0, event);
+        if (m_reorderPeriod != 0 && --m_untilReorder == 0)
+        {
+            reorder();
+            m_untilReorder = m_reorderPeriod;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Get the terms in the order they are evaluated when none short-circuits, by their position in the
+     * expression (pre-order, from 0). Exposed for testing purposes.
+     *
+     * @return std::vector<std::size_t>
+     */
+    std::vector<std::size_t> termOrder() const
+    {
+        // Position of each term in the original expression, the nodes were compiled in pre-order
+        std::vector<std::size_t> position(m_nodes.size());
+        std::size_t terms = 0;
+        for (std::size_t i = 0; i < m_nodes.size(); ++i)
+        {
+            if (m_nodes[i].type == ExpressionType::TERM)
+            {
+                position[i] = terms++;
+            }
+        }
+
+        std::vector<std::size_t> order;
+        std::function<void(std::size_t)> visit = [&](std::size_t index)
+        {
+            if (m_nodes[index].type == ExpressionType::TERM)
+            {
+                order.push_back(position[index]);
+            }
+            for (const auto operand : m_nodes[index].operands)
+            {
+                visit(operand);
+            }
+        };
+        visit(0);
+        return order;
+    }
+};
+} // namespace detail
+
+/**
+ * @brief Get a short-circuit evaluator function that reorders the operands of AND and OR by their costs and the pass
+ * rates observed, see detail::AdaptiveEvaluator.
+ *
+ * @tparam Event
+ * @param expression root expression, the cost of each term is taken from Expression::m_cost
+ * @param reorderPeriod evaluations between two reorders, 0 to only order by the static costs
+ * @return Expression<Event>::FunctionType
+ */
+template<typename Event>
+typename Expression<Event>::FunctionType
+getAdaptiveEvaluator(const std::shared_ptr<const Expression<Event>>& expression,
+                     std::size_t reorderPeriod = DEFAULT_REORDER_PERIOD)
+{
+    auto evaluator = std::make_shared<detail::AdaptiveEvaluator<Event>>(expression, reorderPeriod);
+    return [evaluator](Event event) -> bool
+    {
+        return (*evaluator)(event);
+    };
+}
+
 } // namespace logicexpr::evaluator
 
 #endif // _LOGICEXPR_EVALUATOR_H
@@ -14,28 +14,26 @@
 namespace logicexpr
 {
 
+namespace detail
+{
 /**
- * @brief Generate evaluation function from a string logic expression.
- * This function parses the string and generates a token tree, then uses the
- * provided builder to generate the expression tree with all term's functions.
- * Finally generates the function from built expression tree.
+ * @brief Parse a string logic expression and build its evaluator::Expression tree.
  *
  * @tparam Event Type of the event to be evaluated.
  * @param expression String logic expression.
- * @param termBuilder Builder to generate the term's evaluation function from
- * its description.
+ * @param termBuilder Builder to generate the term's evaluation function from its description.
  * @param termParser Parser to parse the term's of the expression.
- * @return std::function<bool(Event)> Evaluation function.
+ * @param termCost Function returning the static cost of a term from its description.
+ * @return std::shared_ptr<evaluator::Expression<Event>> Root of the expression tree.
  */
-template<typename Event, typename TermType, typename TermBuilder, typename TermParser>
-std::function<bool(Event)>
-buildDijstraEvaluator(const std::string& expression, TermBuilder&& termBuilder, TermParser&& termParser)
+template<typename Event, typename TermType, typename TermBuilder, typename TermParser, typename TermCost>
+std::shared_ptr<evaluator::Expression<Event>>
+buildExpression(const std::string& expression, TermBuilder&& termBuilder, TermParser&& termParser, TermCost&& termCost)
 {
-
     // visitor to generate an evaluator::Expression tree from a
     // parser::Expression tree and a term builder function.
-    auto visit = [termBuilder](const std::shared_ptr<const parser::Expression>& tokenExpr,
-                               auto& visitRef) -> std::shared_ptr<evaluator::Expression<Event>>
+    auto visit = [termBuilder, termCost](const std::shared_ptr<const parser::Expression>& tokenExpr,
+                                         auto& visitRef) -> std::shared_ptr<evaluator::Expression<Event>>
     {
         auto builtExpr = evaluator::Expression<Event>::create();
 
@@ -43,6 +41,7 @@ buildDijstraEvaluator(const std::string& expression, TermBuilder&& termBuilder,
         {
             auto termToken = tokenExpr->m_token->getPtr<parser::TermToken<TermType>>();
             builtExpr->m_type = evaluator::ExpressionType::TERM;
+            builtExpr->m_cost = termCost(termToken->buildToken());
             builtExpr->m_function = termBuilder(termToken->buildToken());
             return builtExpr;
         }
@@ -74,14 +73,66 @@ buildDijstraEvaluator(const std::string& expression, TermBuilder&& termBuilder,
             fmt::format("Engine logic expression: Unexpected token type of token '{}'", tokenExpr->m_token->text()));
     };
 
-    // Parse, build and return the evaluator function.
     auto tokenExpression = parser::parse(expression, std::forward<TermParser>(termParser));
-    auto builtExprPtr = visit(tokenExpression, visit);
+    return visit(tokenExpression, visit);
+}
+} // namespace detail
+
+/**
+ * @brief Generate evaluation function from a string logic expression.
+ * This function parses the string and generates a token tree, then uses the
+ * provided builder to generate the expression tree with all term's functions.
+ * Finally generates the function from built expression tree.
+ *
+ * @tparam Event Type of the event to be evaluated.
+ * @param expression String logic expression.
+ * @param termBuilder Builder to generate the term's evaluation function from
+ * its description.
+ * @param termParser Parser to parse the term's of the expression.
+ * @return std::function<bool(Event)> Evaluation function.
+ */
+template<typename Event, typename TermType, typename TermBuilder, typename TermParser>
+std::function<bool(Event)>
+buildDijstraEvaluator(const std::string& expression, TermBuilder&& termBuilder, TermParser&& termParser)
+{
+    // Parse, build and return the evaluator function.
+    auto noCost = [](TermType&)
+    {
+        return evaluator::DEFAULT_TERM_COST;
+    };
+    auto builtExprPtr = detail::buildExpression<Event, TermType>(
+        expression, std::forward<TermBuilder>(termBuilder), std::forward<TermParser>(termParser), noCost);
     auto evaluatorFunction = evaluator::getDijstraEvaluator<Event>(builtExprPtr);
 
     return evaluatorFunction;
 }
 
+/**
+ * @brief Generate a short-circuit evaluation function from a string logic expression, that evaluates the operands of
+ * AND and OR in the order expected to be the cheapest, see evaluator::getAdaptiveEvaluator.
+ *
+ * @tparam Event Type of the event to be evaluated.
+ * @param expression String logic expression.
+ * @param termBuilder Builder to generate the term's evaluation function from its description.
+ * @param termParser Parser to parse the term's of the expression.
+ * @param termCost Function returning the static cost of a term from its description, called before the builder.
+ * @param reorderPeriod Evaluations between two reorders based on the observed pass rates, 0 to disable them.
+ * @return std::function<bool(Event)> Evaluation function.
+ */
+template<typename Event, typename TermType, typename TermBuilder, typename TermParser, typename TermCost>
+std::function<bool(Event)> buildAdaptiveEvaluator(const std::string& expression,
+                                                  TermBuilder&& termBuilder,
+                                                  TermParser&& termParser,
+                                                  TermCost&& termCost,
+                                                  std::size_t reorderPeriod = evaluator::DEFAULT_REORDER_PERIOD)
+{
+    auto builtExprPtr = detail::buildExpression<Event, TermType>(expression,
+                                                                 std::forward<TermBuilder>(termBuilder),
+                                                                 std::forward<TermParser>(termParser),
+                                                                 std::forward<TermCost>(termCost));
+    return evaluator::getAdaptiveEvaluator<Event>(builtExprPtr, reorderPeriod);
+}
+
 } // namespace logicexpr
 
 #endif // _LOGIC_EXPRESSION_H
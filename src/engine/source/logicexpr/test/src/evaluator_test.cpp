@@ -107,3 +107,114 @@ TEST(LogicExpressionEvaluator, getDijstraEvaluatorSingleTerm)
     EXPECT_TRUE(evaluator(6));
     EXPECT_FALSE(evaluator(7));
 }
+
+TEST(LogicExpressionEvaluator, getAdaptiveEvaluator)
+{
+    // Same expression as getDijstraEvaluator: (i>1) and (pair or not i>5)
+    auto root = Expression<int>::create(ExpressionType::AND);
+    root->m_left = Expression<int>::create([](int i) { return i > 1; });
+    root->m_right = Expression<int>::create(ExpressionType::OR);
+    root->m_right->m_left = Expression<int>::create([](int i) { return i % 2 == 0; });
+    root->m_right->m_right = Expression<int>::create(ExpressionType::NOT);
+    root->m_right->m_right->m_left = Expression<int>::create([](int i) { return i > 5; });
+
+    for (const std::size_t period : {0, 1, 3})
+    {
+        std::function<bool(int)> evaluator;
+        ASSERT_NO_THROW(evaluator = getAdaptiveEvaluator<int>(root, period));
+
+        for (auto round = 0; round < 3; ++round)
+        {
+            EXPECT_FALSE(evaluator(0));
+            EXPECT_FALSE(evaluator(1));
+            EXPECT_TRUE(evaluator(2));
+            EXPECT_TRUE(evaluator(3));
+            EXPECT_TRUE(evaluator(4));
+            EXPECT_TRUE(evaluator(5));
+            EXPECT_TRUE(evaluator(6));
+            EXPECT_FALSE(evaluator(7));
+        }
+    }
+}
+
+TEST(LogicExpressionEvaluator, getAdaptiveEvaluatorSingleTerm)
+{
+    auto root = Expression<int>::create([](int i) { return i % 2 == 0; });
+    std::function<bool(int)> evaluator;
+    ASSERT_NO_THROW(evaluator = getAdaptiveEvaluator<int>(root));
+
+    EXPECT_TRUE(evaluator(0));
+    EXPECT_FALSE(evaluator(1));
+
+    root = Expression<int>::create(ExpressionType::NOT);
+    root->m_left = Expression<int>::create([](int i) { return i % 2 == 0; });
+    ASSERT_NO_THROW(evaluator = getAdaptiveEvaluator<int>(root));
+
+    EXPECT_FALSE(evaluator(0));
+    EXPECT_TRUE(evaluator(1));
+}
+
+TEST(LogicExpressionEvaluator, getAdaptiveEvaluatorEmpty)
+{
+    auto root = Expression<int>::create(ExpressionType::AND);
+    root->m_left = Expression<int>::create([](int) { return true; });
+    EXPECT_THROW(getAdaptiveEvaluator<int>(root), std::runtime_error);
+}
+
+TEST(LogicExpressionEvaluator, AdaptiveEvaluatorShortCircuits)
+{
+    // a AND b AND c, the cheapest first
+    std::vector<int> calls(3, 0);
+    auto term = [&calls](std::size_t n, bool value, double cost)
+    {
+        auto expr = Expression<int>::create(
+            [&calls, n, value](int)
+            {
+                ++calls[n];
+                return value;
+            });
+        expr->m_cost = cost;
+        return expr;
+    };
+
+    auto root = Expression<int>::create(ExpressionType::AND);
+    root->m_left = term(0, true, 10);
+    root->m_right = Expression<int>::create(ExpressionType::AND);
+    root->m_right->m_left = term(1, false, 5);
+    root->m_right->m_right = term(2, true, 1);
+
+    detail::AdaptiveEvaluator<int> evaluator(root, 0);
+    EXPECT_EQ(evaluator.termOrder(), (std::vector<std::size_t> {2, 1, 0}));
+
+    EXPECT_FALSE(evaluator(0));
+    EXPECT_EQ(calls, (std::vector<int> {0, 1, 1}));
+}
+
+TEST(LogicExpressionEvaluator, AdaptiveEvaluatorLearnsPassRates)
+{
+    // Same cost, the AND must evaluate first the term that fails the most
+    auto root = Expression<int>::create(ExpressionType::AND);
+    root->m_left = Expression<int>::create([](int i) { return i % 10 != 0; });
+    root->m_right = Expression<int>::create([](int i) { return i % 10 == 0; });
+
+    detail::AdaptiveEvaluator<int> evaluator(root, 100);
+    EXPECT_EQ(evaluator.termOrder(), (std::vector<std::size_t> {0, 1}));
+
+    for (auto i = 0; i < 100; ++i)
+    {
+        evaluator(i);
+    }
+    EXPECT_EQ(evaluator.termOrder(), (std::vector<std::size_t> {1, 0}));
+
+    // Same cost, the OR must evaluate first the term that passes the most
+    root = Expression<int>::create(ExpressionType::OR);
+    root->m_left = Expression<int>::create([](int i) { return i % 10 == 0; });
+    root->m_right = Expression<int>::create([](int i) { return i % 10 != 0; });
+
+    detail::AdaptiveEvaluator<int> orEvaluator(root, 100);
+    for (auto i = 0; i < 100; ++i)
+    {
+        orEvaluator(i);
+    }
+    EXPECT_EQ(orEvaluator.termOrder(), (std::vector<std::size_t> {1, 0}));
+}
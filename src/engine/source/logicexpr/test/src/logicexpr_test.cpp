@@ -1,3 +1,5 @@
+#include <map>
+
 #include <logicexpr/logicexpr.hpp>
 
 #include "gtest/gtest.h"
@@ -75,3 +77,55 @@ TEST(LogicExpression, buildDijstraEvaluator)
     EXPECT_TRUE(evaluator(6));
     EXPECT_FALSE(evaluator(7));
 }
+
+TEST(LogicExpression, buildAdaptiveEvaluator)
+{
+    // True if: (even or odd and not i>5) and i>1
+    // tldr: true if 3,5 or even>1
+    std::map<std::string, std::function<bool(int)>> terms {{"even", [](int i) { return i % 2 == 0; }},
+                                                           {"odd", [](int i) { return i % 2 != 0; }},
+                                                           {"great5", [](int i) { return i > 5; }},
+                                                           {"great1", [](int i) { return i > 1; }}};
+    auto fakeTermBuilder = [&terms](std::string s) -> std::function<bool(int)>
+    {
+        return terms.at(s);
+    };
+    std::vector<std::string> costed;
+    auto fakeTermCost = [&costed](std::string& s) -> double
+    {
+        costed.push_back(s);
+        return s == "great1" ? 1.0 : 10.0;
+    };
+
+    parsec::Parser<std::string> termP = [](std::string_view text, size_t pos) -> parsec::Result<std::string>
+    {
+        auto end = text.find_first_of(" ()", pos);
+        if (end == std::string_view::npos)
+        {
+            end = text.size();
+        }
+        if (std::isupper(text[pos]) || text[pos] == '(' || text[pos] == ')')
+        {
+            return parsec::makeError<std::string>("Unexpected token", pos);
+        }
+        return parsec::makeSuccess<std::string>(std::string {text.substr(pos, end - pos)}, end);
+    };
+
+    auto expression = "(even OR odd AND NOT great5) AND great1";
+    std::function<bool(int)> evaluator;
+    EXPECT_NO_THROW((evaluator = buildAdaptiveEvaluator<int, std::string>(
+                         expression, fakeTermBuilder, termP, fakeTermCost, 2)));
+    EXPECT_EQ(costed.size(), 4);
+
+    for (auto round = 0; round < 3; ++round)
+    {
+        EXPECT_FALSE(evaluator(0));
+        EXPECT_FALSE(evaluator(1));
+        EXPECT_TRUE(evaluator(2));
+        EXPECT_TRUE(evaluator(3));
+        EXPECT_TRUE(evaluator(4));
+        EXPECT_TRUE(evaluator(5));
+        EXPECT_TRUE(evaluator(6));
+        EXPECT_FALSE(evaluator(7));
+    }
+}
@@ -7,12 +7,15 @@
 #include <string_view>
 #include <unordered_map>
 #include <variant>
+#include <vector>
 
 #include <hlp/hlp.hpp>
 #include <json/json.hpp>
 #include <parsec/parsec.hpp>
 #include <schemf/ischema.hpp>
 
+#include "parserTrie.hpp"
+
 namespace hlp
 {
 /**
@@ -388,6 +391,9 @@ private:
     Hlp buildChoiceParser(const parser::Choice& choice, const std::vector<std::string>& endTokens = {}) const;
     Hlp buildGroupOptParser(const parser::Group& group, size_t recurLvl) const;
 
+    // build the parsers of each token, with the keys that identify them
+    std::vector<ParserStep> buildSteps(const std::list<parser::ParserInfo>& parserInfos, size_t recurLvl) const;
+
     // build the parsers while adding the target field to the json
     Hlp buildParsers(const std::list<parser::ParserInfo>& parserInfos, size_t recurLvl) const;
 
@@ -426,6 +432,17 @@ public:
      * @throws std::runtime_error if errors occur while building the parser
      */
     Hlp build(std::string_view logpar) const;
+
+    /**
+     * @brief Build the parsers of several logpar expressions in a prefix tree
+     *
+     * The steps that consecutive expressions have in common are parsed once, see ParserTrie.
+     *
+     * @param logpars the logpar expressions, in the order they are tried
+     * @return ParserTrie the parsers
+     * @throws std::runtime_error if errors occur while building any of the parsers
+     */
+    ParserTrie buildTrie(const std::vector<std::string>& logpars) const;
 };
 } // namespace logpar
 } // namespace hlp
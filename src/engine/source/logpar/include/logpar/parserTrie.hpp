@@ -0,0 +1,121 @@
+#ifndef _LOGPAR_PARSER_TRIE_HPP
+#define _LOGPAR_PARSER_TRIE_HPP
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include <hlp/hlp.hpp>
+#include <json/json.hpp>
+
+namespace hlp::logpar
+{
+
+/**
+ * @brief A step of a compiled logpar expression, the parser of one of its tokens.
+ *
+ */
+struct ParserStep
+{
+    std::string key;            ///< Two steps with the same key are built the same way and parse the same text
+    std::string label;          ///< Readable description of the step
+    hlp::parser::Parser parser; ///< Parser of the step
+};
+
+/**
+ * @brief Several logpar expressions compiled in a prefix tree, so their common steps are parsed once.
+ *
+ * The expressions are tried in order and the first one that parses the whole text and maps without errors wins, as
+ * if each expression was run after the other. To keep that order an expression only shares the steps of the
+ * expression added right before it; the text then branches to the steps that differ.
+ */
+class ParserTrie
+{
+private:
+    static constexpr std::size_t ROOT = 0;
+
+    struct Node
+    {
+        ParserStep step;                       ///< Step parsed when entering the node, empty for the root
+        std::vector<std::size_t> children;     ///< Next steps, in the order of their expressions
+        std::optional<std::size_t> expression; ///< Expression that ends on the node
+    };
+
+    /**
+     * @brief Furthest failure of a search, reported if no expression matches.
+     */
+    struct Failure
+    {
+        std::string_view remaining; ///< Text left when the failure happened
+        std::string message;        ///< The error
+    };
+
+    std::vector<Node> m_nodes;              ///< The nodes, the root first
+    std::vector<std::string> m_expressions; ///< The expressions, in the order they were added
+
+    /**
+     * @brief Depth first search of the first expression that matches below a node.
+     *
+     * @param node Node where the search starts.
+     * @param input Text left to parse.
+     * @param path Results of the steps parsed from the root to the node.
+     * @param event Event to map to, only modified by the matching expression.
+     * @param failure Furthest failure found so far.
+     * @return std::optional<std::size_t> The matching expression, if any.
+     */
+    std::optional<std::size_t> search(std::size_t node,
+                                      std::string_view input,
+                                      hlp::parser::Result::Nested& path,
+                                      json::Json& event,
+                                      Failure& failure) const;
+
+public:
+    ParserTrie();
+
+    /**
+     * @brief Add an expression after the ones already added.
+     *
+     * @param expression The logpar expression, used in traces.
+     * @param steps The steps of the expression, the last one must only match the end of the input.
+     * @throws std::runtime_error if the expression has no steps.
+     */
+    void add(const std::string& expression, std::vector<ParserStep>&& steps);
+
+    /**
+     * @brief Parse the text with the first expression that matches and map it to the event.
+     *
+     * @param text Text to parse.
+     * @param event Event to map to.
+     * @return std::variant<std::size_t, base::Error> The index of the expression that matched or the error of the
+     * furthest failure.
+     */
+    std::variant<std::size_t, base::Error> run(std::string_view text, json::Json& event) const;
+
+    /**
+     * @brief Get the expressions, in the order they were added.
+     *
+     * @return const std::vector<std::string>&
+     */
+    const std::vector<std::string>& expressions() const { return m_expressions; }
+
+    /**
+     * @brief Get the number of steps in the tree, the root excluded.
+     *
+     * @return std::size_t
+     */
+    std::size_t steps() const { return m_nodes.size() - 1; }
+
+    /**
+     * @brief Get the Graphviz representation of the tree.
+     *
+     * @return std::string
+     */
+    std::string toGraphvizStr() const;
+};
+
+} // namespace hlp::logpar
+
+#endif // _LOGPAR_PARSER_TRIE_HPP
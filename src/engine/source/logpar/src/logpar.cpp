@@ -283,6 +283,92 @@ parsec::Parser<std::list<ParserInfo>> pLogpar()
 
 namespace hlp::logpar
 {
+namespace
+{
+// Prefix the strings with their size so the keys can not collide
+std::string sized(std::string_view value)
+{
+    return fmt::format("{}:{}", value.size(), value);
+}
+
+std::string fieldKey(const parser::Field& field)
+{
+    std::string key = fmt::format("F{}{}{}", field.optional ? "?" : "", sized(field.name.value), field.args.size());
+    for (const auto& arg : field.args)
+    {
+        key += sized(arg);
+    }
+    return key;
+}
+
+std::string infoKey(const parser::ParserInfo& info)
+{
+    if (std::holds_alternative<parser::Literal>(info))
+    {
+        return "L" + sized(std::get<parser::Literal>(info).value);
+    }
+    if (std::holds_alternative<parser::Field>(info))
+    {
+        return fieldKey(std::get<parser::Field>(info));
+    }
+    if (std::holds_alternative<parser::Choice>(info))
+    {
+        const auto& choice = std::get<parser::Choice>(info);
+        return "C" + fieldKey(choice.left) + fieldKey(choice.right);
+    }
+
+    const auto& group = std::get<parser::Group>(info);
+    auto key = fmt::format("G{}(", group.children.size());
+    for (const auto& child : group.children)
+    {
+        key += infoKey(child);
+    }
+    return key + ")";
+}
+
+std::string infoLabel(const parser::ParserInfo& info)
+{
+    if (std::holds_alternative<parser::Literal>(info))
+    {
+        return std::get<parser::Literal>(info).value;
+    }
+    if (std::holds_alternative<parser::Field>(info))
+    {
+        return std::get<parser::Field>(info).toStr();
+    }
+    if (std::holds_alternative<parser::Choice>(info))
+    {
+        const auto& choice = std::get<parser::Choice>(info);
+        return fmt::format("{}{}{}", choice.left.toStr(), syntax::EXPR_OPT, choice.right.toStr());
+    }
+
+    std::string label {"(?"};
+    for (const auto& child : std::get<parser::Group>(info).children)
+    {
+        label += infoLabel(child);
+    }
+    return label + ")";
+}
+
+/**
+ * @brief Key of a step, the parser of a step depends on its tokens and on the end tokens it is built with.
+ */
+std::string stepKey(const std::vector<parser::ParserInfo>& infos, const std::vector<std::string>& endTokens)
+{
+    std::string key;
+    for (const auto& info : infos)
+    {
+        key += infoKey(info);
+    }
+    key += fmt::format("|{}", endTokens.size());
+    for (const auto& endToken : endTokens)
+    {
+        key += sized(endToken);
+    }
+    return key;
+}
+} // namespace
+
 Logpar::Logpar(const json::Json& ecsFieldTypes,
                const std::shared_ptr<schemf::ISchema>& schema,
                size_t maxGroupRecursion,
@@ -450,14 +536,14 @@ Logpar::Hlp Logpar::buildGroupOptParser(const parser::Group& group, size_t recur
     return hlp::parser::combinator::opt(p);
 }
 
-Logpar::Hlp Logpar::buildParsers(const std::list<parser::ParserInfo>& parserInfos, size_t recurLvl) const
+std::vector<ParserStep> Logpar::buildSteps(const std::list<parser::ParserInfo>& parserInfos, size_t recurLvl) const
 {
     if (recurLvl > m_maxGroupRecursion)
     {
         throw std::runtime_error("Max group recursion level reached");
     }
 
-    std::vector<Logpar::Hlp> parsers;
+    std::vector<ParserStep> steps;
     for (auto parserInfo = parserInfos.begin(); parserInfo != parserInfos.end(); ++parserInfo)
     {
         auto groupEndToken = [](const parser::Group& group, auto& ref) -> std::list<std::string>
@@ -565,7 +651,9 @@ Logpar::Hlp Logpar::buildParsers(const std::list<parser::ParserInfo>& parserInfo
                 auto endToken2 = std::vector<std::string>(listEndToken2.begin(), listEndToken2.end());
                 auto choice2 = buildFieldParser(std::get<parser::Field>(*parserInfo), endToken2);
 
-                parsers.emplace_back(hlp::parser::combinator::choice(choice1, choice2));
+                steps.push_back({stepKey({*parserInfo, *next}, endToken2),
+                                 infoLabel(*parserInfo) + infoLabel(*next),
+                                 hlp::parser::combinator::choice(choice1, choice2)});
                 // Skip group
                 ++parserInfo;
                 continue;
@@ -576,12 +664,16 @@ Logpar::Hlp Logpar::buildParsers(const std::list<parser::ParserInfo>& parserInfo
             // TODO: this is a temporary fix to get as a vector
             std::vector<std::string> endTokens(listEndTokens.begin(), listEndTokens.end());
 
-            parsers.emplace_back(buildFieldParser(std::get<parser::Field>(*parserInfo), endTokens));
+            steps.push_back({stepKey({*parserInfo}, endTokens),
+                             infoLabel(*parserInfo),
+                             buildFieldParser(std::get<parser::Field>(*parserInfo), endTokens)});
         }
         // Literal
         else if (std::holds_alternative<parser::Literal>(*parserInfo))
         {
-            parsers.emplace_back(buildLiteralParser(std::get<parser::Literal>(*parserInfo)));
+            steps.push_back({stepKey({*parserInfo}, {}),
+                             infoLabel(*parserInfo),
+                             buildLiteralParser(std::get<parser::Literal>(*parserInfo))});
         }
         // Choice
         else if (std::holds_alternative<parser::Choice>(*parserInfo))
@@ -590,7 +682,9 @@ Logpar::Hlp Logpar::buildParsers(const std::list<parser::ParserInfo>& parserInfo
             // TODO: this is a temporary fix to get as a vector
             std::vector<std::string> endTokens(listEndTokens.begin(), listEndTokens.end());
 
-            parsers.emplace_back(buildChoiceParser(std::get<parser::Choice>(*parserInfo), endTokens));
+            steps.push_back({stepKey({*parserInfo}, endTokens),
+                             infoLabel(*parserInfo),
+                             buildChoiceParser(std::get<parser::Choice>(*parserInfo), endTokens)});
         }
         // Group
         else if (std::holds_alternative<parser::Group>(*parserInfo))
@@ -609,7 +703,9 @@ Logpar::Hlp Logpar::buildParsers(const std::list<parser::ParserInfo>& parserInfo
             }
 
             // Recursively calls buildParsers
-            parsers.emplace_back(buildGroupOptParser(std::get<parser::Group>(*parserInfo), recurLvl + 1));
+            steps.push_back({stepKey({*parserInfo}, {}),
+                             infoLabel(*parserInfo),
+                             buildGroupOptParser(std::get<parser::Group>(*parserInfo), recurLvl + 1)});
         }
         else
         {
@@ -617,10 +713,21 @@ Logpar::Hlp Logpar::buildParsers(const std::list<parser::ParserInfo>& parserInfo
         }
     }
 
-    // return parsers;
-    auto p = hlp::parser::combinator::all(parsers);
+    return steps;
+}
 
-    return p;
+Logpar::Hlp Logpar::buildParsers(const std::list<parser::ParserInfo>& parserInfos, size_t recurLvl) const
+{
+    auto steps = buildSteps(parserInfos, recurLvl);
+
+    std::vector<Logpar::Hlp> parsers;
+    parsers.reserve(steps.size());
+    for (auto& step : steps)
+    {
+        parsers.emplace_back(std::move(step.parser));
+    }
+
+    return hlp::parser::combinator::all(parsers);
 }
 
 void Logpar::registerBuilder(ParserType type, const ParserBuilder& builder)
@@ -647,4 +754,23 @@ Logpar::Hlp Logpar::build(std::string_view logpar) const
     return hlp::parser::combinator::all({p, hlp::parsers::getEofParser({.name = "EOF"})});
 }
 
+ParserTrie Logpar::buildTrie(const std::vector<std::string>& logpars) const
+{
+    ParserTrie trie;
+    for (const auto& logpar : logpars)
+    {
+        auto result = parser::pLogpar()(logpar, 0);
+        if (result.failure())
+        {
+            throw std::runtime_error(parsec::formatTrace(logpar, result.trace(), 1));
+        }
+
+        auto steps = buildSteps(result.value(), 0);
+        steps.push_back({"EOF", "EOF", hlp::parsers::getEofParser({.name = "EOF"})});
+        trie.add(logpar, std::move(steps));
+    }
+
+    return trie;
+}
+
 } // namespace hlp::logpar
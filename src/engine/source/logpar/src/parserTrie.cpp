@@ -0,0 +1,163 @@
+#include "parserTrie.hpp"
+
+#include <sstream>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+namespace hlp::logpar
+{
+
+namespace
+{
+std::string escapeLabel(std::string_view label)
+{
+    std::string escaped;
+    escaped.reserve(label.size());
+    for (const auto c : label)
+    {
+        if (c == '"' || c == '\\')
+        {
+            escaped.push_back('\\');
+        }
+        escaped.push_back(c);
+    }
+    return escaped;
+}
+} // namespace
+
+ParserTrie::ParserTrie()
+    : m_nodes(1)
+    , m_expressions()
+{
+}
+
+void ParserTrie::add(const std::string& expression, std::vector<ParserStep>&& steps)
+{
+    if (steps.empty())
+    {
+        throw std::runtime_error(fmt::format("Expression '{}' has no steps", expression));
+    }
+
+    auto current = ROOT;
+    for (auto& step : steps)
+    {
+        // Only the last branch is shared, so the expressions keep their order in a depth first search
+        const auto& children = m_nodes[current].children;
+        if (!children.empty() && m_nodes[children.back()].step.key == step.key)
+        {
+            current = children.back();
+            continue;
+        }
+
+        m_nodes.push_back(Node {std::move(step), {}, std::nullopt});
+        m_nodes[current].children.push_back(m_nodes.size() - 1);
+        current = m_nodes.size() - 1;
+    }
+
+    // A repeated expression never wins, the first one matches the same text
+    if (!m_nodes[current].expression)
+    {
+        m_nodes[current].expression = m_expressions.size();
+    }
+    m_expressions.push_back(expression);
+}
+
+std::optional<std::size_t> ParserTrie::search(std::size_t node,
+                                              std::string_view input,
+                                              hlp::parser::Result::Nested& path,
+                                              json::Json& event,
+                                              Failure& failure) const
+{
+    for (const auto childIndex : m_nodes[node].children)
+    {
+        const auto& child = m_nodes[childIndex];
+        auto result = child.step.parser(input);
+        if (result.failure())
+        {
+            if (failure.message.empty() || result.remaining().size() < failure.remaining.size())
+            {
+                failure.remaining = result.remaining();
+                failure.message = fmt::format("Parser {} failed at: {}", result.trace(), result.remaining());
+            }
+            continue;
+        }
+
+        const auto remaining = result.remaining();
+        path.emplace_back(std::move(result));
+
+        if (child.expression)
+        {
+            auto nested = path;
+            const auto synRes = hlp::abs::makeSuccess<hlp::parser::ResultT>(remaining, std::move(nested));
+            auto error = hlp::parser::map(synRes, event);
+            if (!error)
+            {
+                return child.expression;
+            }
+            failure.remaining = remaining;
+            failure.message = std::move(error.value().message);
+        }
+
+        auto found = search(childIndex, remaining, path, event, failure);
+        if (found)
+        {
+            return found;
+        }
+        path.pop_back();
+    }
+
+    return std::nullopt;
+}
+
+std::variant<std::size_t, base::Error> ParserTrie::run(std::string_view text, json::Json& event) const
+{
+    hlp::parser::Result::Nested path;
+    Failure failure {text, {}};
+
+    auto found = search(ROOT, text, path, event, failure);
+    if (found)
+    {
+        return found.value();
+    }
+
+    if (failure.message.empty())
+    {
+        failure.message = "No expression to parse with";
+    }
+    return base::Error {failure.message};
+}
+
+std::string ParserTrie::toGraphvizStr() const
+{
+    std::stringstream ss;
+    ss << "digraph ParserTrie {\n";
+    ss << "    node [shape=box];\n";
+    ss << "    n0 [label=\"root\", shape=Mdiamond];\n";
+    for (std::size_t i = 1; i < m_nodes.size(); ++i)
+    {
+        const auto& node = m_nodes[i];
+        if (node.expression)
+        {
+            ss << fmt::format("    n{} [label=\"{}\", peripheries=2, xlabel=\"{}\"];\n",
+                              i,
+                              escapeLabel(node.step.label),
+                              escapeLabel(m_expressions[node.expression.value()]));
+        }
+        else
+        {
+            ss << fmt::format("    n{} [label=\"{}\"];\n", i, escapeLabel(node.step.label));
+        }
+    }
+    for (std::size_t i = 0; i < m_nodes.size(); ++i)
+    {
+        for (const auto child : m_nodes[i].children)
+        {
+            ss << fmt::format("    n{} -> n{};\n", i, child);
+        }
+    }
+    ss << "}\n";
+    return ss.str();
+}
+
+} // namespace hlp::logpar
@@ -146,6 +146,103 @@ INSTANTIATE_TEST_SUITE_P(
         BuildParseT(false, "[date] <~host> <text>(?|<~opt/text>|):<~>", "[date] host text|opt|:", {}),
         BuildParseT(false, "[date] <~host> <text>(?|<~opt/text>|):<~>", "[date] host text|opt|left over", {})));
 
+// Expressions, text, index of the expression that matches (-1 for none) and the expected event
+using BuildTrieParseT = std::tuple<std::vector<std::string>, std::string, int, json::Json>;
+class LogparBuildTrieParseTest
+    : public ::testing::TestWithParam<BuildTrieParseT>
+    , public logpar_test::LogparPBase
+{
+protected:
+    void SetUp() override { init(); }
+};
+
+TEST_P(LogparBuildTrieParseTest, BuildParse)
+{
+    auto [expressions, text, expectedIndex, expected] = GetParam();
+    auto trie = logpar->buildTrie(expressions);
+
+    // Same result as trying each expression after the other
+    int sequentialIndex = -1;
+    json::Json sequentialEvent;
+    for (auto i = 0; i < static_cast<int>(expressions.size()) && sequentialIndex == -1; ++i)
+    {
+        json::Json event;
+        if (!hlp::parser::run(logpar->build(expressions[i]), text, event))
+        {
+            sequentialIndex = i;
+            sequentialEvent = event;
+        }
+    }
+    ASSERT_EQ(sequentialIndex, expectedIndex);
+
+    json::Json event;
+    auto res = trie.run(text, event);
+    if (expectedIndex >= 0)
+    {
+        ASSERT_TRUE(std::holds_alternative<size_t>(res)) << std::get<base::Error>(res).message;
+        ASSERT_EQ(std::get<size_t>(res), static_cast<size_t>(expectedIndex));
+        ASSERT_EQ(event, expected);
+        ASSERT_EQ(event, sequentialEvent);
+    }
+    else
+    {
+        ASSERT_TRUE(std::holds_alternative<base::Error>(res));
+        ASSERT_EQ(event, json::Json {});
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    BuildParse,
+    LogparBuildTrieParseTest,
+    ::testing::Values(
+        BuildTrieParseT({"literal"}, "literal", 0, {}),
+        BuildTrieParseT({"lit<text>", "lot<text>"}, "zzz", -1, {}),
+        BuildTrieParseT({"lit<text>:<~a/long>", "lit<text>:<~b/text>"},
+                        "literal:1",
+                        0,
+                        logpar_test::J(R"({"text":"eral","~a":1})")),
+        BuildTrieParseT({"lit<text>:<~a/long>", "lit<text>:<~b/text>"},
+                        "literal:x",
+                        1,
+                        logpar_test::J(R"({"text":"eral","~b":"x"})")),
+        BuildTrieParseT({"a<~x/text>", "<~y/text>", "a<~z/text>"}, "abc", 0, logpar_test::J(R"({"~x":"bc"})")),
+        BuildTrieParseT({"a<~x/long>", "<~y/text>", "a<~z/text>"}, "abc", 1, logpar_test::J(R"({"~y":"abc"})")),
+        BuildTrieParseT({"a<~x/long>", "a<~x/long>", "a<~z/text>"}, "abc", 2, logpar_test::J(R"({"~z":"bc"})")),
+        BuildTrieParseT({"<~p/long>: <~h/text> sshd: <text>", "<~p/long>: <~h/text> cron: <text>"},
+                        "13: host cron: message",
+                        1,
+                        logpar_test::J(R"({"~p":13,"~h":"host","text":"message"})")),
+        BuildTrieParseT({"lit<text>:(?<~opt/text>)", "lit<text>"},
+                        "literal:optional",
+                        0,
+                        logpar_test::J(R"({"text":"eral","~opt":"optional"})"))));
+
+class LogparBuildTrieTest
+    : public ::testing::Test
+    , public logpar_test::LogparPBase
+{
+protected:
+    void SetUp() override { init(); }
+};
+
+TEST_F(LogparBuildTrieTest, SharesPrefixes)
+{
+    // <~p/long>, ": ", <~h/text>, " sshd: ", <text> and EOF, the host ends on a different token so it is not shared
+    auto trie = logpar->buildTrie({"<~p/long>: <~h/text> sshd: <text>", "<~p/long>: <~h/text> cron: <text>"});
+    ASSERT_EQ(trie.steps(), 10);
+    ASSERT_EQ(trie.expressions().size(), 2);
+
+    // Not consecutive, nothing is shared
+    trie = logpar->buildTrie({"a<~x/text>", "b<~x/text>", "a<~x/text>"});
+    ASSERT_EQ(trie.steps(), 9);
+
+    const auto graph = trie.toGraphvizStr();
+    ASSERT_EQ(graph.find("digraph ParserTrie {"), 0);
+    ASSERT_NE(graph.find("n0 -> n1;"), std::string::npos);
+
+    ASSERT_THROW(logpar->buildTrie({"lit", "lit(?lit"}), std::runtime_error);
+}
+
 using FieldParserT = std::tuple<bool, std::string, std::string, bool, std::list<std::string>, bool, size_t>;
 class LogparFieldParserTest : public ::testing::TestWithParam<FieldParserT>
 {
@@ -1,9 +1,11 @@
 #ifndef _METRICS_DATAHUB_H
 #define _METRICS_DATAHUB_H
 
-#include <map>
+#include <array>
+#include <atomic>
+#include <memory>
 #include <mutex>
-#include <variant>
+#include <unordered_map>
 
 #include <json/json.hpp>
 #include <metrics/iDataHub.hpp>
@@ -14,37 +16,107 @@ namespace metricsManager
 class DataHub : public IDataHub
 {
 public:
+    DataHub() = default;
+    ~DataHub();
+
+    DataHub(const DataHub&) = delete;
+    DataHub& operator=(const DataHub&) = delete;
+
     /**
-     * @brief Get a copy of the resource data in JSON object.
+     * @brief Get the resource data in JSON object.
      *
      * @param scope Name of the resource scope.
-     * @return Copy of resource data in JSON object.
+     * @return Resource data in JSON object, null if not set.
      */
     json::Json getResource(const std::string& scope);
 
     /**
-     * @copydoc IDataHub.setResource
+     * @copydoc IDataHub::getResourceId
+     */
+    std::size_t getResourceId(const std::string& scope) override;
+
+    /**
+     * @copydoc IDataHub::setResource
      */
-    void setResource(const std::string& scope, const json::Json& object) override;
+    void setResource(std::size_t id, ResourceData&& data) override;
 
     /**
      * @brief Gets a json representation of the contained resources.
      *
-     * @return JSON object with the information.
+     * @return JSON object with the information, null if there is none.
      */
     json::Json getAllResources();
 
 private:
     /**
-     * @brief Map of strings to json objects containing resources
+     * @brief Double-buffered data of a resource. The writer fills the buffer not published and then publishes it, the
+     * readers only count themselves in the buffer they serialize, so they never wait for the writer nor for each
+     * other. The writer only waits for the readers still serializing the buffer it is going to overwrite.
+     */
+    struct Resource
+    {
+        std::string name;
+        std::array<ResourceData, 2> buffers;
+        std::atomic<int> current {-1};                   ///< Buffer published, -1 if none
+        std::array<std::atomic<uint32_t>, 2> readers {}; ///< Readers of each buffer
+        std::mutex writerMutex;                          ///< Serializes the writers of the resource
+    };
+
+    /**
+     * @brief Number of resources in the first chunk, each chunk doubles the previous one.
+     */
+    static constexpr std::size_t FIRST_CHUNK_SIZE = 64;
+
+    /**
+     * @brief Maximum number of chunks.
+     */
+    static constexpr std::size_t MAX_CHUNKS = 32;
+
+    /**
+     * @brief Resources indexed by ID, in chunks that are never moved, so they are read without locks while new
+     * resources are registered.
+     */
+    std::array<std::atomic<Resource*>, MAX_CHUNKS> m_chunks {};
+
+    /**
+     * @brief Number of resources registered.
+     */
+    std::atomic<std::size_t> m_size {0};
+
+    /**
+     * @brief IDs of the resources by name.
+     */
+    std::unordered_map<std::string, std::size_t> m_ids;
+
+    /**
+     * @brief Protects the registration of the resources.
+     */
+    std::mutex m_idsMutex;
+
+    /**
+     * @brief Get the chunk of a resource.
+     *
+     * @param id ID of the resource.
+     * @param offset Position of the resource in the chunk.
+     * @return Index of the chunk.
+     */
+    static std::size_t chunkOf(std::size_t id, std::size_t& offset);
+
+    /**
+     * @brief Get a registered resource.
+     *
+     * @param id ID of the resource.
+     * @return Resource.
      */
-    std::map<std::string, json::Json> m_resources;
+    Resource& resource(std::size_t id) const;
 
     /**
-     * @brief Synchronization object
+     * @brief Serialize the data published of a resource.
      *
+     * @param resource Resource.
+     * @return Resource data in JSON object, null if not set.
      */
-    std::mutex m_mutex;
+    static json::Json read(Resource& resource);
 };
 } // namespace metricsManager
 
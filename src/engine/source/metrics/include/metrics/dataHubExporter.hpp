@@ -6,9 +6,11 @@
 #include "opentelemetry/sdk/metrics/instruments.h"
 #include "opentelemetry/sdk/metrics/push_metric_exporter.h"
 #include "opentelemetry/version.h"
+#include <functional>
 #include <iostream>
 #include <json/json.hpp>
 #include <string>
+#include <unordered_map>
 
 #include <metrics/iDataHub.hpp>
 
@@ -30,10 +32,12 @@ public:
      *
      * @param dataHub Interface to DataHub container
      * @param aggregation_temporality How new samples are processed with existing ones.
+     * @param onExport Called after each export, to push into the DataHub the data not kept by OpenTelemetry.
      */
     explicit DataHubExporter(std::shared_ptr<metricsManager::IDataHub> dataHub,
                              sdk::metrics::AggregationTemporality aggregationTemporality =
-                                 sdk::metrics::AggregationTemporality::kCumulative) noexcept;
+                                 sdk::metrics::AggregationTemporality::kCumulative,
+                             std::function<void()> onExport = nullptr) noexcept;
 
     /**
      * @brief Export the registered instruments samples in the provider
@@ -76,6 +80,11 @@ private:
      */
     std::shared_ptr<metricsManager::IDataHub> m_dataHub;
 
+    /**
+     * @brief IDs of the scopes in the DataHub.
+     */
+    std::unordered_map<std::string, std::size_t> m_resourceIds;
+
     /**
      * @brief Control variable to flag shutdown cycle.
      */
@@ -91,6 +100,11 @@ private:
      */
     sdk::metrics::AggregationTemporality aggregationTemporality_;
 
+    /**
+     * @brief Called after each export, null if none.
+     */
+    std::function<void()> m_onExport;
+
     /**
      * @brief Check if the program is in the process of shutting down.
      */
@@ -103,9 +117,9 @@ private:
                                             const sdk::metrics::ResourceMetrics& data);
 
     /**
-     * @brief Print point data in JSON format.
+     * @brief Convert point data to the DataHub format.
      */
-    void printPointData(json::Json& jsonObj, const opentelemetry::sdk::metrics::PointType& pointdata);
+    static metricsManager::MetricPoint toMetricPoint(const opentelemetry::sdk::metrics::PointType& pointdata);
 
     /**
      * @brief Print point attributes in JSON format.
@@ -1,12 +1,68 @@
 #ifndef _I_METRICS_DATAHUB_H
 #define _I_METRICS_DATAHUB_H
 
-#include <json/json.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <optional>
 #include <string>
+#include <variant>
+#include <vector>
 
 namespace metricsManager
 {
 
+/**
+ * @brief Value recorded by an instrument, integer or double.
+ */
+using MetricValue = std::variant<int64_t, double>;
+
+/**
+ * @brief Point of a metric record, with the fields of the OpenTelemetry point data of its type.
+ */
+struct MetricPoint
+{
+    enum class Type
+    {
+        Sum,
+        Histogram,
+        LastValue
+    };
+
+    Type type {Type::Sum};
+    MetricValue value {int64_t {0}}; ///< Value of the sum and last value points, sum of the histogram points
+    uint64_t count {0};              ///< Histogram: number of values recorded
+    std::optional<MetricValue> min;  ///< Histogram: minimum value recorded, if kept
+    std::optional<MetricValue> max;  ///< Histogram: maximum value recorded, if kept
+    std::vector<double> buckets;     ///< Histogram: boundaries of the buckets
+    std::vector<uint64_t> counts;    ///< Histogram: values recorded per bucket
+    int64_t timestamp {0};           ///< Last value: time of the sample
+    bool valid {false};              ///< Last value: the sample is valid
+};
+
+/**
+ * @brief Record of an instrument in an export.
+ */
+struct MetricRecord
+{
+    std::time_t time {0}; ///< End of the collection period
+    std::string instrumentName;
+    std::string description;
+    std::string unit;
+    std::string type;
+    std::vector<MetricPoint> points;
+};
+
+/**
+ * @brief Data of a resource, as exported. It is serialized to JSON only when read.
+ */
+struct ResourceData
+{
+    std::string schema;
+    std::string version;
+    std::vector<MetricRecord> records;
+};
+
 /**
  * @brief Inteface for DataHub Container
  */
@@ -14,12 +70,20 @@ class IDataHub
 {
 public:
     /**
-     * @brief Updates the data of the referenced object.
+     * @brief Get the interned ID of a resource, registered if needed. The writers keep it to update the resource.
      *
      * @param scope Name of the resource scope.
-     * @param object JSON object with updated information.
+     * @return ID of the resource.
+     */
+    virtual std::size_t getResourceId(const std::string& scope) = 0;
+
+    /**
+     * @brief Updates the data of the referenced object.
+     *
+     * @param id ID of the resource, from getResourceId().
+     * @param data Updated information.
      */
-    virtual void setResource(const std::string& scope, const json::Json& object) = 0;
+    virtual void setResource(std::size_t id, ResourceData&& data) = 0;
 };
 
 } // namespace metricsManager
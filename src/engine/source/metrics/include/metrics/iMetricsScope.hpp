@@ -1,6 +1,9 @@
 #ifndef _I_METRICS_SCOPE_H
 #define _I_METRICS_SCOPE_H
 
+#include <memory>
+#include <string>
+
 #include <metrics/iMetricsInstruments.hpp>
 
 namespace metricsManager
@@ -74,6 +77,56 @@ public:
    * @return A shared pointer to the gauge.
    */
   virtual std::shared_ptr<iGauge<double>> getGaugeDouble(const std::string& name, double defaultValue) = 0;
+
+  /**
+   * @brief Gets an unsigned integer counter for the hot paths, each thread adds to its own slot without locks and
+   * the slots are summed when the scope is exported.
+   *
+   * Falls back to a regular counter if the scope has no local instruments.
+   *
+   * @param name The name of the counter.
+   * @return A shared pointer to the counter.
+   */
+  virtual std::shared_ptr<iCounter<uint64_t>> getLocalCounterUInteger(const std::string& name)
+  {
+    return getCounterUInteger(name);
+  }
+
+  /**
+   * @brief Gets an integer up-down counter for the hot paths, see getLocalCounterUInteger.
+   *
+   * @param name The name of the counter.
+   * @return A shared pointer to the counter.
+   */
+  virtual std::shared_ptr<iCounter<int64_t>> getLocalUpDownCounterInteger(const std::string& name)
+  {
+    return getUpDownCounterInteger(name);
+  }
+
+  /**
+   * @brief Gets an unsigned integer histogram for the hot paths, each thread records into its own slot without locks
+   * and the slots are merged when the scope is exported.
+   *
+   * Falls back to a regular histogram if the scope has no local instruments.
+   *
+   * @param name The name of the histogram.
+   * @return A shared pointer to the histogram.
+   */
+  virtual std::shared_ptr<iHistogram<uint64_t>> getLocalHistogramUInteger(const std::string& name)
+  {
+    return getHistogramUInteger(name);
+  }
+
+  /**
+   * @brief Gets a double histogram for the hot paths, see getLocalHistogramUInteger.
+   *
+   * @param name The name of the histogram.
+   * @return A shared pointer to the histogram.
+   */
+  virtual std::shared_ptr<iHistogram<double>> getLocalHistogramDouble(const std::string& name)
+  {
+    return getHistogramDouble(name);
+  }
 };
 
 } // namespace metricsManager
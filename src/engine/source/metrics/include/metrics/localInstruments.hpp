@@ -0,0 +1,325 @@
+#ifndef _METRICS_LOCAL_INSTRUMENTS_H
+#define _METRICS_LOCAL_INSTRUMENTS_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "opentelemetry/metrics/async_instruments.h"
+
+#include <metrics/iMetricsInstruments.hpp>
+#include <metrics/metricsInstruments.hpp>
+
+namespace metricsManager
+{
+
+namespace detail
+{
+
+constexpr std::size_t CACHE_LINE_SIZE = 64; ///< Size of the cache lines, the slots of two threads never share one
+
+/**
+ * @brief Per-thread slots of a local instrument.
+ *
+ * Each thread that records into the instrument gets its own slot the first time, reachable afterwards through a
+ * thread-local table indexed by the id of the instrument, so recording takes no lock. The slots are owned by the
+ * instrument and outlive their threads, so the values recorded are never lost.
+ *
+ * @tparam Slot Type of the slot.
+ */
+template<typename Slot>
+class LocalSlots
+{
+private:
+    const std::size_t m_id;                     ///< Index of the instrument in the thread-local tables
+    mutable std::mutex m_mutex;                 ///< Protects the list of slots, not their values
+    std::vector<std::unique_ptr<Slot>> m_slots; ///< Slots of the threads that recorded into the instrument
+
+    static std::size_t nextId()
+    {
+        // The ids are never reused, so a stale entry in a thread-local table is never reached
+        static std::atomic<std::size_t> next {0};
+        return next.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static std::vector<void*>& threadSlots()
+    {
+        thread_local std::vector<void*> slots;
+        return slots;
+    }
+
+    Slot& addLocal()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_slots.push_back(std::make_unique<Slot>());
+
+        auto& slots = threadSlots();
+        if (slots.size() <= m_id)
+        {
+            slots.resize(m_id + 1, nullptr);
+        }
+        slots[m_id] = m_slots.back().get();
+        return *m_slots.back();
+    }
+
+public:
+    LocalSlots()
+        : m_id(nextId())
+    {
+    }
+
+    LocalSlots(const LocalSlots&) = delete;
+    LocalSlots& operator=(const LocalSlots&) = delete;
+
+    /**
+     * @brief Get the slot of the calling thread, created if needed.
+     *
+     * @return Slot&
+     */
+    Slot& local()
+    {
+        auto& slots = threadSlots();
+        if (m_id < slots.size() && slots[m_id] != nullptr)
+        {
+            return *static_cast<Slot*>(slots[m_id]);
+        }
+        return addLocal();
+    }
+
+    /**
+     * @brief Visit all the slots. The values may be being updated by their threads.
+     *
+     * @param visitor Function called with each slot.
+     */
+    template<typename Visitor>
+    void forEach(Visitor&& visitor) const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& slot : m_slots)
+        {
+            visitor(*slot);
+        }
+    }
+};
+
+/**
+ * @brief Add to a value only written by the calling thread.
+ *
+ * The load and store are relaxed, so no atomic read-modify-write is needed, they only keep the concurrent reads of
+ * the exporter well-defined.
+ */
+template<typename U>
+inline void localAdd(std::atomic<U>& value, U delta)
+{
+    value.store(value.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+}
+
+} // namespace detail
+
+/**
+ * @brief Counter for the hot paths, each thread adds to its own cache-line padded slot without locks or atomic
+ * read-modify-write operations.
+ *
+ * The slots are summed when the scope is exported, through an observable counter of OpenTelemetry, so the counter is
+ * exported as any other counter (as a monotonic counter or as an up-down counter).
+ *
+ * @tparam U Value type of the counter.
+ */
+template<typename U>
+class LocalCounter : public iCounter<U>, public Instrument
+{
+private:
+    struct alignas(detail::CACHE_LINE_SIZE) Slot
+    {
+        std::atomic<U> value {0};
+    };
+
+    detail::LocalSlots<Slot> m_slots; ///< Per-thread values
+
+    OTstd::shared_ptr<OTMetrics::ObservableInstrument> m_instrument; ///< Observable instrument reading the sum
+    OTMetrics::ObservableCallbackPtr m_callback {nullptr};          ///< Callback registered in the instrument
+
+public:
+    /**
+     * @brief Construct a new Local Counter object
+     *
+     * @param ptr A shared pointer to the observable instrument created with the OpenTelemetry MeterProvider Meter.
+     */
+    LocalCounter(OTstd::shared_ptr<OTMetrics::ObservableInstrument> ptr)
+        : m_instrument {std::move(ptr)}
+    {
+    }
+
+    /**
+     * @brief Registers the callback that observes the sum of the counter.
+     *
+     * @param callback The callback function, called with this counter as state.
+     */
+    void AddCallback(OTMetrics::ObservableCallbackPtr callback)
+    {
+        m_callback = callback;
+        m_instrument->AddCallback(callback, static_cast<void*>(this));
+    }
+
+    /**
+     * @brief Destroy the Local Counter object and removes the internal callback.
+     */
+    ~LocalCounter()
+    {
+        if (m_callback != nullptr)
+        {
+            m_instrument->RemoveCallback(m_callback, static_cast<void*>(this));
+        }
+    }
+
+    /**
+     * @brief Adds a value to the slot of the calling thread.
+     *
+     * @param value The value itself.
+     */
+    void addValue(const U& value) override
+    {
+        if (getEnabledStatus())
+        {
+            detail::localAdd(m_slots.local().value, value);
+        }
+    }
+
+    /**
+     * @brief Get the sum of the values added by all the threads.
+     *
+     * @return U
+     */
+    U sum() const
+    {
+        U total {0};
+        m_slots.forEach([&total](const Slot& slot) { total += slot.value.load(std::memory_order_relaxed); });
+        return total;
+    }
+};
+
+/**
+ * @brief Snapshot of a local histogram, merged from the slots of all the threads.
+ *
+ * @tparam U Value type of the histogram.
+ */
+template<typename U>
+struct LocalHistogramPoint
+{
+    uint64_t count {0};           ///< Number of values recorded
+    U sum {0};                    ///< Sum of the values recorded
+    U min {0};                    ///< Minimum value recorded, 0 if none
+    U max {0};                    ///< Maximum value recorded, 0 if none
+    std::vector<uint64_t> counts; ///< Values recorded per bucket
+};
+
+/**
+ * @brief Histogram for the hot paths, each thread records into its own cache-line padded slot without locks or atomic
+ * read-modify-write operations.
+ *
+ * Uses the default boundaries of the OpenTelemetry histograms, a value is counted in the first bucket whose upper
+ * boundary is greater or equal. The slots are merged when the scope is exported.
+ *
+ * @tparam U Value type of the histogram.
+ */
+template<typename U>
+class LocalHistogram : public iHistogram<U>, public Instrument
+{
+public:
+    static constexpr std::size_t BOUNDARIES = 15; ///< Number of boundaries, there is one more bucket
+
+    /**
+     * @brief Get the upper boundaries of the buckets, the last bucket has no upper boundary.
+     *
+     * @return const std::vector<double>&
+     */
+    static const std::vector<double>& boundaries()
+    {
+        static const std::vector<double> values {
+            0.0, 5.0, 10.0, 25.0, 50.0, 75.0, 100.0, 250.0, 500.0, 750.0, 1000.0, 2500.0, 5000.0, 7500.0, 10000.0};
+        return values;
+    }
+
+private:
+    struct alignas(detail::CACHE_LINE_SIZE) Slot
+    {
+        std::atomic<uint64_t> count {0};
+        std::atomic<U> sum {0};
+        std::atomic<U> min {std::numeric_limits<U>::max()};
+        std::atomic<U> max {std::numeric_limits<U>::lowest()};
+        std::atomic<uint64_t> counts[BOUNDARIES + 1] {};
+    };
+
+    detail::LocalSlots<Slot> m_slots; ///< Per-thread values
+
+public:
+    LocalHistogram() = default;
+
+    /**
+     * @brief Records a value into the slot of the calling thread.
+     *
+     * @param value The value itself.
+     */
+    void recordValue(const U& value) override
+    {
+        if (!getEnabledStatus())
+        {
+            return;
+        }
+
+        auto& slot = m_slots.local();
+        const auto& bounds = boundaries();
+        const auto bucket =
+            std::lower_bound(bounds.begin(), bounds.end(), static_cast<double>(value)) - bounds.begin();
+        detail::localAdd(slot.counts[bucket], uint64_t {1});
+        detail::localAdd(slot.count, uint64_t {1});
+        detail::localAdd(slot.sum, value);
+        if (value < slot.min.load(std::memory_order_relaxed))
+        {
+            slot.min.store(value, std::memory_order_relaxed);
+        }
+        if (value > slot.max.load(std::memory_order_relaxed))
+        {
+            slot.max.store(value, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Merge the values recorded by all the threads.
+     *
+     * @return LocalHistogramPoint<U>
+     */
+    LocalHistogramPoint<U> snapshot() const
+    {
+        LocalHistogramPoint<U> point;
+        point.counts.assign(BOUNDARIES + 1, 0);
+        auto min = std::numeric_limits<U>::max();
+        auto max = std::numeric_limits<U>::lowest();
+        m_slots.forEach(
+            [&](const Slot& slot)
+            {
+                point.count += slot.count.load(std::memory_order_relaxed);
+                point.sum += slot.sum.load(std::memory_order_relaxed);
+                min = std::min(min, slot.min.load(std::memory_order_relaxed));
+                max = std::max(max, slot.max.load(std::memory_order_relaxed));
+                for (std::size_t i = 0; i <= BOUNDARIES; ++i)
+                {
+                    point.counts[i] += slot.counts[i].load(std::memory_order_relaxed);
+                }
+            });
+        if (point.count > 0)
+        {
+            point.min = min;
+            point.max = max;
+        }
+        return point;
+    }
+};
+
+} // namespace metricsManager
+
+#endif // _METRICS_LOCAL_INSTRUMENTS_H
@@ -1,6 +1,8 @@
 #ifndef _METRICS_SCOPE_H
 #define _METRICS_SCOPE_H
 
+#include <map>
+#include <mutex>
 #include <string>
 
 #include "opentelemetry/sdk/metrics/meter_provider.h"
@@ -10,6 +12,7 @@
 #include <metrics/dataHubExporter.hpp>
 #include <metrics/iMetricsScope.hpp>
 #include <metrics/instrumentCollection.hpp>
+#include <metrics/localInstruments.hpp>
 #include <metrics/metricsInstruments.hpp>
 
 namespace metricsManager
@@ -80,6 +83,26 @@ public:
      */
     std::shared_ptr<iGauge<double>> getGaugeDouble(const std::string& name, double defaultValue) override;
 
+    /**
+     * @copydoc IMetricsScope::getLocalCounterUInteger()
+     */
+    std::shared_ptr<iCounter<uint64_t>> getLocalCounterUInteger(const std::string& name) override;
+
+    /**
+     * @copydoc IMetricsScope::getLocalUpDownCounterInteger()
+     */
+    std::shared_ptr<iCounter<int64_t>> getLocalUpDownCounterInteger(const std::string& name) override;
+
+    /**
+     * @copydoc IMetricsScope::getLocalHistogramUInteger()
+     */
+    std::shared_ptr<iHistogram<uint64_t>> getLocalHistogramUInteger(const std::string& name) override;
+
+    /**
+     * @copydoc IMetricsScope::getLocalHistogramDouble()
+     */
+    std::shared_ptr<iHistogram<double>> getLocalHistogramDouble(const std::string& name) override;
+
     /**
      * @brief Sets the enabled status of the specified instrument.
      *
@@ -103,6 +126,38 @@ private:
      */
     std::shared_ptr<DataHub> m_dataHub;
 
+    /**
+     * @brief Local histogram, its ID in the DataHub and the snapshot last exported, to export the deltas.
+     */
+    template<typename U>
+    struct LocalHistogramEntry
+    {
+        std::shared_ptr<LocalHistogram<U>> histogram;
+        std::size_t resourceId {0};
+        LocalHistogramPoint<U> exported;
+    };
+
+    /**
+     * @brief Protects the local histograms, merged by the thread of the exporter. Declared before the provider, whose
+     * last export may run while it is destroyed.
+     */
+    std::mutex m_localMutex;
+
+    /**
+     * @brief Unsigned integer local histograms, merged into the DataHub on each export.
+     */
+    std::map<std::string, LocalHistogramEntry<uint64_t>> m_local_histogram_integer;
+
+    /**
+     * @brief Double local histograms, merged into the DataHub on each export.
+     */
+    std::map<std::string, LocalHistogramEntry<double>> m_local_histogram_double;
+
+    /**
+     * @brief Aggregation temporality is Delta.
+     */
+    bool m_delta {false};
+
     /**
      * @brief Provider of Instruments. Binds the instruments to the exporters.
      */
@@ -160,6 +215,18 @@ private:
      */
     InstrumentCollection<Gauge<double>, OTstd::shared_ptr<OTMetrics::ObservableInstrument>> m_collection_gauge_double;
 
+    /**
+     * @brief Collection of unsigned integer local counters, summed by OpenTelemetry observable counters.
+     */
+    InstrumentCollection<LocalCounter<uint64_t>, OTstd::shared_ptr<OTMetrics::ObservableInstrument>>
+        m_collection_local_counter_integer;
+
+    /**
+     * @brief Collection of integer local up-down counters, summed by OpenTelemetry observable up-down counters.
+     */
+    InstrumentCollection<LocalCounter<int64_t>, OTstd::shared_ptr<OTMetrics::ObservableInstrument>>
+        m_collection_local_updowncounter_integer;
+
     /**
      * @brief Mapping of instruments indexed by name.
      */
@@ -197,6 +264,31 @@ private:
      * @param id Identification of instrument.
      */
     static void FetcherDouble(OTMetrics::ObserverResult observer_result, void *id);
+
+    /**
+     * @brief Callback for the Observable instruments of the local counters.
+     *
+     * @param observer_result Internals Open Telemetry holding the observer result.
+     * @param id Identification of instrument.
+     */
+    template<typename U>
+    static void FetcherLocal(OTMetrics::ObserverResult observer_result, void *id);
+
+    /**
+     * @brief Get a local histogram, created if needed.
+     *
+     * @param histograms Local histograms of the type.
+     * @param name Name of the histogram.
+     */
+    template<typename U>
+    std::shared_ptr<LocalHistogram<U>> getLocalHistogram(std::map<std::string, LocalHistogramEntry<U>>& histograms,
+                                                         const std::string& name);
+
+    /**
+     * @brief Merge the local histograms and set them in the DataHub, in the format of the exported histograms.
+     * Called by the exporter after each export.
+     */
+    void exportLocalHistograms();
 };
 
 } // namespace metricsManager
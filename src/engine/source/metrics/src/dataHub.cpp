@@ -1,41 +1,256 @@
 #include <metrics/dataHub.hpp>
+
+#include <stdexcept>
 #include <thread>
-#include <mutex>
-#include <iostream>
-#include <fmt/format.h>
-#include <metrics/dataHub.hpp>
 
-namespace metricsManager
+namespace
 {
+std::string timeToString(std::time_t time)
+{
+    struct tm tmBuf = {};
+    char buf[100];
+    if (gmtime_r(&time, &tmBuf) == nullptr || std::strftime(buf, sizeof(buf), "%c", &tmBuf) == 0)
+    {
+        return "";
+    }
+    return buf;
+}
 
-json::Json DataHub::getResource(const std::string& scope)
+json::Json valueToJson(const metricsManager::MetricValue& value)
 {
-    const std::lock_guard<std::mutex> lock(m_mutex);
-    auto foundRes = m_resources.find(scope);
-    if (m_resources.end() == foundRes)
+    json::Json jValue;
+    if (std::holds_alternative<double>(value))
     {
-        return json::Json();
+        jValue.setDouble(std::get<double>(value));
     }
     else
     {
-        return m_resources[scope];
+        jValue.setInt64(std::get<int64_t>(value));
     }
+    return jValue;
 }
 
-void DataHub::setResource(const std::string& scope, const json::Json& object)
+json::Json pointToJson(const metricsManager::MetricPoint& point)
 {
-    const std::lock_guard<std::mutex> lock(m_mutex);
-    m_resources[scope] = json::Json {object};
+    using Type = metricsManager::MetricPoint::Type;
+
+    json::Json jPoint;
+
+    switch (point.type)
+    {
+        case Type::Sum:
+            jPoint.setString("SumPointData", "/type");
+            jPoint.set("/value", valueToJson(point.value));
+            break;
+
+        case Type::Histogram:
+            jPoint.setString("HistogramPointData", "/type");
+            jPoint.setInt64(static_cast<int64_t>(point.count), "/count");
+            jPoint.set("/sum", valueToJson(point.value));
+            if (point.min)
+            {
+                jPoint.set("/min", valueToJson(*point.min));
+            }
+            if (point.max)
+            {
+                jPoint.set("/max", valueToJson(*point.max));
+            }
+            jPoint.setArray("/buckets");
+            for (auto bound : point.buckets)
+            {
+                json::Json jValue;
+                jValue.setDouble(bound);
+                jPoint.appendJson(jValue, "/buckets");
+            }
+            jPoint.setArray("/counts");
+            for (auto count : point.counts)
+            {
+                json::Json jValue;
+                jValue.setInt64(static_cast<int64_t>(count));
+                jPoint.appendJson(jValue, "/counts");
+            }
+            break;
+
+        case Type::LastValue:
+            jPoint.setString("LastValuePointData", "/type");
+            jPoint.setString(std::to_string(point.timestamp), "/timestamp");
+            jPoint.setBool(point.valid, "/valid");
+            jPoint.set("/value", valueToJson(point.value));
+            break;
+    }
+
+    return jPoint;
 }
 
-json::Json DataHub::getAllResources()
+json::Json resourceToJson(const metricsManager::ResourceData& data)
+{
+    json::Json jMetricData;
+
+    jMetricData.setString(data.schema, "/schema");
+    jMetricData.setString(data.version, "/version");
+    jMetricData.setArray("/records");
+
+    for (const auto& record : data.records)
+    {
+        json::Json jRecord;
+
+        jRecord.setString(timeToString(record.time), "/start_time");
+        jRecord.setString(record.instrumentName, "/instrument_name");
+        jRecord.setString(record.description, "/instrument_description");
+        jRecord.setString(record.unit, "/unit");
+        jRecord.setString(record.type, "/type");
+        jRecord.setArray("/attributes");
+
+        for (const auto& point : record.points)
+        {
+            jRecord.appendJson(pointToJson(point), "/attributes");
+        }
+
+        jMetricData.appendJson(jRecord, "/records");
+    }
+
+    return jMetricData;
+}
+} // namespace
+
+namespace metricsManager
+{
+
+DataHub::~DataHub()
+{
+    for (auto& chunk : m_chunks)
+    {
+        delete[] chunk.load();
+    }
+}
+
+std::size_t DataHub::chunkOf(std::size_t id, std::size_t& offset)
+{
+    auto chunk = std::size_t {0};
+    offset = id;
+    while (offset >= FIRST_CHUNK_SIZE << chunk)
+    {
+        offset -= FIRST_CHUNK_SIZE << chunk;
+        ++chunk;
+    }
+    return chunk;
+}
+
+DataHub::Resource& DataHub::resource(std::size_t id) const
+{
+    std::size_t offset;
+    const auto chunk = chunkOf(id, offset);
+    return m_chunks[chunk].load(std::memory_order_acquire)[offset];
+}
+
+std::size_t DataHub::getResourceId(const std::string& scope)
 {
-    const std::lock_guard<std::mutex> lock(m_mutex);
+    const std::lock_guard<std::mutex> lock(m_idsMutex);
 
+    auto foundId = m_ids.find(scope);
+    if (m_ids.end() != foundId)
+    {
+        return foundId->second;
+    }
+
+    const auto id = m_size.load(std::memory_order_relaxed);
+
+    std::size_t offset;
+    const auto chunk = chunkOf(id, offset);
+    if (chunk >= MAX_CHUNKS)
+    {
+        throw std::runtime_error("Too many metrics resources");
+    }
+    if (offset == 0)
+    {
+        m_chunks[chunk].store(new Resource[FIRST_CHUNK_SIZE << chunk], std::memory_order_release);
+    }
+
+    resource(id).name = scope;
+    m_ids.emplace(scope, id);
+
+    // The readers only reach the resource once it is complete
+    m_size.store(id + 1, std::memory_order_release);
+
+    return id;
+}
+
+void DataHub::setResource(std::size_t id, ResourceData&& data)
+{
+    auto& target = resource(id);
+    const std::lock_guard<std::mutex> lock(target.writerMutex);
+
+    const auto current = target.current.load();
+    const auto next = current == 0 ? 1 : 0;
+
+    // Wait for the readers of the previous data, the serialization of a resource is short
+    while (target.readers[next].load() != 0)
+    {
+        std::this_thread::yield();
+    }
+
+    target.buffers[next] = std::move(data);
+    target.current.store(next);
+}
+
+json::Json DataHub::read(Resource& resource)
+{
+    int current;
+
+    while (true)
+    {
+        current = resource.current.load();
+        if (current < 0)
+        {
+            return json::Json();
+        }
+
+        resource.readers[current].fetch_add(1);
+
+        // The writer may have started overwriting it before the reader was counted
+        if (resource.current.load() == current)
+        {
+            break;
+        }
+
+        resource.readers[current].fetch_sub(1);
+    }
+
+    auto jData = resourceToJson(resource.buffers[current]);
+    resource.readers[current].fetch_sub(1);
+
+    return jData;
+}
+
+json::Json DataHub::getResource(const std::string& scope)
+{
+    std::size_t id;
+    {
+        const std::lock_guard<std::mutex> lock(m_idsMutex);
+        auto foundId = m_ids.find(scope);
+        if (m_ids.end() == foundId)
+        {
+            return json::Json();
+        }
+        id = foundId->second;
+    }
+
+    return read(resource(id));
+}
+
+json::Json DataHub::getAllResources()
+{
     json::Json retValue;
 
-    for (auto &r : m_resources) {
-        retValue.set("/" + r.first, r.second);
+    const auto size = m_size.load(std::memory_order_acquire);
+    for (std::size_t id = 0; id < size; ++id)
+    {
+        auto& target = resource(id);
+        auto jData = read(target);
+        if (!jData.isNull())
+        {
+            retValue.set("/" + target.name, jData);
+        }
     }
 
     return retValue;
@@ -1,5 +1,9 @@
 #include <metrics/metricsScope.hpp>
 
+#include <chrono>
+#include <ctime>
+#include <type_traits>
+
 using OTSDKMetricExporter = opentelemetry::sdk::metrics::PushMetricExporter;
 using OTSDKMetricReader = opentelemetry::sdk::metrics::MetricReader;
 using OTDataHubExporter = opentelemetry::exporter::metrics::DataHubExporter;
@@ -9,16 +13,34 @@ using OTGaugeInteger = opentelemetry::nostd::shared_ptr<opentelemetry::metrics::
 using OTGaugeDouble = opentelemetry::nostd::shared_ptr<opentelemetry::metrics::ObserverResultT<double>>;
 using OTTemporality = opentelemetry::v1::sdk::metrics::AggregationTemporality;
 
+namespace
+{
+template<typename U>
+metricsManager::MetricValue toMetricValue(U value)
+{
+    if constexpr (std::is_floating_point_v<U>)
+    {
+        return static_cast<double>(value);
+    }
+    else
+    {
+        return static_cast<int64_t>(value);
+    }
+}
+} // namespace
+
 namespace metricsManager
 {
 
 void MetricsScope::initialize(bool delta, int exporterIntervalMS, int exporterTimeoutMS)
 {
     m_dataHub = std::make_shared<DataHub>();
+    m_delta = delta;
 
     // Create Exporter
     OTTemporality temporality = delta?(OTTemporality::kDelta):(OTTemporality::kCumulative);
-    std::unique_ptr<OTSDKMetricExporter> metricExporter(new OTDataHubExporter(m_dataHub, temporality));
+    std::unique_ptr<OTSDKMetricExporter> metricExporter(
+        new OTDataHubExporter(m_dataHub, temporality, [this]() { exportLocalHistograms(); }));
 
     // Create Reader
     OTSDKPerodicMetricReaderOptions options;
@@ -182,6 +204,138 @@ std::shared_ptr<iGauge<double>> MetricsScope::getGaugeDouble(const std::string&
     return retValue;
 }
 
+std::shared_ptr<iCounter<uint64_t>> MetricsScope::getLocalCounterUInteger(const std::string& name)
+{
+    auto retValue = m_collection_local_counter_integer.getInstrument(
+        name,
+        [&]()
+        {
+            auto meter = m_meterProvider->GetMeter(name);
+            return meter->CreateInt64ObservableCounter(name);
+        },
+        [&](const std::shared_ptr<LocalCounter<uint64_t>>& counter)
+        {
+            counter->AddCallback(MetricsScope::FetcherLocal<uint64_t>);
+        });
+
+    registerInstrument(name, retValue);
+
+    return retValue;
+}
+
+std::shared_ptr<iCounter<int64_t>> MetricsScope::getLocalUpDownCounterInteger(const std::string& name)
+{
+    auto retValue = m_collection_local_updowncounter_integer.getInstrument(
+        name,
+        [&]()
+        {
+            auto meter = m_meterProvider->GetMeter(name);
+            return meter->CreateInt64ObservableUpDownCounter(name);
+        },
+        [&](const std::shared_ptr<LocalCounter<int64_t>>& counter)
+        {
+            counter->AddCallback(MetricsScope::FetcherLocal<int64_t>);
+        });
+
+    registerInstrument(name, retValue);
+
+    return retValue;
+}
+
+template<typename U>
+std::shared_ptr<LocalHistogram<U>>
+MetricsScope::getLocalHistogram(std::map<std::string, LocalHistogramEntry<U>>& histograms, const std::string& name)
+{
+    std::shared_ptr<LocalHistogram<U>> retValue;
+    {
+        const std::lock_guard<std::mutex> lock(m_localMutex);
+        auto& entry = histograms[name];
+        if (!entry.histogram)
+        {
+            entry.histogram = std::make_shared<LocalHistogram<U>>();
+            entry.resourceId = m_dataHub->getResourceId(name);
+            entry.exported.counts.assign(LocalHistogram<U>::BOUNDARIES + 1, 0);
+        }
+        retValue = entry.histogram;
+    }
+
+    registerInstrument(name, retValue);
+
+    return retValue;
+}
+
+std::shared_ptr<iHistogram<uint64_t>> MetricsScope::getLocalHistogramUInteger(const std::string& name)
+{
+    return getLocalHistogram(m_local_histogram_integer, name);
+}
+
+std::shared_ptr<iHistogram<double>> MetricsScope::getLocalHistogramDouble(const std::string& name)
+{
+    return getLocalHistogram(m_local_histogram_double, name);
+}
+
+void MetricsScope::exportLocalHistograms()
+{
+    const auto exportAll = [this](auto& histograms)
+    {
+        for (auto& [name, entry] : histograms)
+        {
+            auto point = entry.histogram->snapshot();
+            if (m_delta)
+            {
+                // Only the values recorded since the last export, the minimum and maximum cannot be subtracted
+                auto current = point;
+                point.count -= entry.exported.count;
+                point.sum -= entry.exported.sum;
+                for (std::size_t i = 0; i < point.counts.size(); ++i)
+                {
+                    point.counts[i] -= entry.exported.counts[i];
+                }
+                entry.exported = std::move(current);
+            }
+            if (point.count == 0)
+            {
+                continue;
+            }
+
+            MetricPoint metricPoint;
+            metricPoint.type = MetricPoint::Type::Histogram;
+            metricPoint.count = point.count;
+            metricPoint.value = toMetricValue(point.sum);
+            if (!m_delta)
+            {
+                metricPoint.min = toMetricValue(point.min);
+                metricPoint.max = toMetricValue(point.max);
+            }
+            metricPoint.buckets = LocalHistogram<double>::boundaries();
+            metricPoint.counts = std::move(point.counts);
+
+            ResourceData metricData;
+            auto& record = metricData.records.emplace_back();
+            record.time = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+            record.instrumentName = name;
+            record.type = "Histogram";
+            record.points.push_back(std::move(metricPoint));
+
+            m_dataHub->setResource(entry.resourceId, std::move(metricData));
+        }
+    };
+
+    const std::lock_guard<std::mutex> lock(m_localMutex);
+    exportAll(m_local_histogram_integer);
+    exportAll(m_local_histogram_double);
+}
+
+template<typename U>
+void MetricsScope::FetcherLocal(opentelemetry::metrics::ObserverResult observer_result, void* id)
+{
+    if (opentelemetry::nostd::holds_alternative<OTGaugeInteger>(observer_result))
+    {
+        auto* counter = static_cast<LocalCounter<U>*>(id);
+        opentelemetry::nostd::get<OTGaugeInteger>(observer_result)->Observe(static_cast<int64_t>(counter->sum()));
+    }
+}
+
 void MetricsScope::FetcherInteger(opentelemetry::metrics::ObserverResult observer_result, void* id)
 {
     if (opentelemetry::nostd::holds_alternative<OTGaugeInteger>(observer_result))
@@ -44,9 +44,24 @@ TEST_F(DataHubExporterTest, SuccessExport)
     data.scope_metric_data_ = std::vector<sdk::metrics::ScopeMetrics>{
     {scope.get(), std::vector<sdk::metrics::MetricData>{metric_data}}};
 
-    EXPECT_CALL(*m_spMockDataHubExporter, setResource(testing::_, testing::_));
+    EXPECT_CALL(*m_spMockDataHubExporter, getResourceId("library_name")).WillOnce(testing::Return(3));
+    EXPECT_CALL(*m_spMockDataHubExporter, setResource(3, testing::_))
+        .WillOnce(
+            [](std::size_t, metricsManager::ResourceData&& resourceData)
+            {
+                ASSERT_EQ(resourceData.version, "1.2.0");
+                ASSERT_EQ(resourceData.records.size(), 1);
+                ASSERT_EQ(resourceData.records[0].instrumentName, "library_name");
+                ASSERT_EQ(resourceData.records[0].type, "Counter");
+                ASSERT_EQ(resourceData.records[0].points.size(), 2);
+                ASSERT_EQ(std::get<double>(resourceData.records[0].points[1].value), 20.0);
+            });
 
     ASSERT_EQ(m_spDataHubExporter->Export(data), sdk::common::ExportResult::kSuccess);
+
+    // The ID of the scope is only requested once
+    EXPECT_CALL(*m_spMockDataHubExporter, setResource(3, testing::_));
+    ASSERT_EQ(m_spDataHubExporter->Export(data), sdk::common::ExportResult::kSuccess);
 }
 
 TEST_F(DataHubExporterTest, SuccessExportWithoutSetResource)
@@ -1,7 +1,24 @@
 #include <gtest/gtest.h>
 
+#include <thread>
+
 #include <metrics/dataHub.hpp>
 
+namespace
+{
+metricsManager::ResourceData counterData(const std::string& name, int64_t value)
+{
+    metricsManager::ResourceData data;
+    auto& record = data.records.emplace_back();
+    record.instrumentName = name;
+    record.type = "Counter";
+    auto& point = record.points.emplace_back();
+    point.type = metricsManager::MetricPoint::Type::Sum;
+    point.value = value;
+    return data;
+}
+} // namespace
+
 // Define a fixture class for DataHub tests
 class DataHubTest : public ::testing::Test
 {
@@ -11,14 +28,14 @@ protected:
 
 TEST_F(DataHubTest, GetResource_ExistingScope_ReturnsValidResource)
 {
-    json::Json resourceJson;
-    // Initialize resourceJson with some data
-
-    dataHub.setResource("test_scope", resourceJson);
+    dataHub.setResource(dataHub.getResourceId("test_scope"), counterData("test_scope", 10));
 
     auto retrievedResource = dataHub.getResource("test_scope");
 
-    ASSERT_EQ(retrievedResource, resourceJson);
+    ASSERT_EQ(retrievedResource.getString("/records/0/instrument_name").value(), "test_scope");
+    ASSERT_EQ(retrievedResource.getString("/records/0/type").value(), "Counter");
+    ASSERT_EQ(retrievedResource.getString("/records/0/attributes/0/type").value(), "SumPointData");
+    ASSERT_EQ(retrievedResource.getInt64("/records/0/attributes/0/value").value(), 10);
 }
 
 TEST_F(DataHubTest, GetResource_NonExistingScope_ReturnsEmptyJson)
@@ -28,28 +45,73 @@ TEST_F(DataHubTest, GetResource_NonExistingScope_ReturnsEmptyJson)
     ASSERT_TRUE(retrievedResource.isNull());
 }
 
-TEST_F(DataHubTest, SetResource_ValidScope_ResourceAdded)
+TEST_F(DataHubTest, GetResource_NotSetScope_ReturnsEmptyJson)
 {
-    json::Json resourceJson;
-    // Initialize resourceJson with some data
+    dataHub.getResourceId("new_scope");
 
-    dataHub.setResource("new_scope", resourceJson);
+    ASSERT_TRUE(dataHub.getResource("new_scope").isNull());
+    ASSERT_TRUE(dataHub.getAllResources().isNull());
+}
 
-    json::Json retrievedResource = dataHub.getResource("new_scope");
+TEST_F(DataHubTest, GetResourceId_SameScope_ReturnsSameId)
+{
+    auto id = dataHub.getResourceId("scope1");
 
-    ASSERT_EQ(retrievedResource, resourceJson);
+    ASSERT_EQ(dataHub.getResourceId("scope1"), id);
+    ASSERT_NE(dataHub.getResourceId("scope2"), id);
 }
 
-TEST_F(DataHubTest, GetAllResources_ReturnsAllResources)
+TEST_F(DataHubTest, SetResource_ValidScope_ResourceUpdated)
 {
-    json::Json resourceJson1, resourceJson2;
-    // Initialize resourceJson1 and resourceJson2 with some data
+    auto id = dataHub.getResourceId("new_scope");
 
-    dataHub.setResource("scope1", resourceJson1);
-    dataHub.setResource("scope2", resourceJson2);
+    dataHub.setResource(id, counterData("new_scope", 1));
+    dataHub.setResource(id, counterData("new_scope", 2));
+    dataHub.setResource(id, counterData("new_scope", 3));
+
+    ASSERT_EQ(dataHub.getResource("new_scope").getInt64("/records/0/attributes/0/value").value(), 3);
+}
+
+TEST_F(DataHubTest, GetAllResources_ReturnsAllResources)
+{
+    // More resources than the first chunk
+    for (int i = 0; i < 100; ++i)
+    {
+        auto name = "scope" + std::to_string(i);
+        dataHub.setResource(dataHub.getResourceId(name), counterData(name, i));
+    }
 
     auto allResources = dataHub.getAllResources();
 
     ASSERT_TRUE(allResources.exists("/scope1"));
     ASSERT_TRUE(allResources.exists("/scope2"));
+    ASSERT_EQ(allResources.getInt64("/scope99/records/0/attributes/0/value").value(), 99);
+}
+
+TEST_F(DataHubTest, SetResource_ConcurrentReaders_ReadConsistentData)
+{
+    auto id = dataHub.getResourceId("scope");
+    dataHub.setResource(id, counterData("scope", 0));
+
+    std::atomic<bool> done {false};
+    std::thread reader(
+        [&]()
+        {
+            int64_t last = 0;
+            while (!done)
+            {
+                auto value = dataHub.getResource("scope").getInt64("/records/0/attributes/0/value").value();
+                ASSERT_GE(value, last);
+                last = value;
+            }
+        });
+
+    for (int64_t i = 1; i <= 1000; ++i)
+    {
+        dataHub.setResource(id, counterData("scope", i));
+    }
+    done = true;
+    reader.join();
+
+    ASSERT_EQ(dataHub.getResource("scope").getInt64("/records/0/attributes/0/value").value(), 1000);
 }
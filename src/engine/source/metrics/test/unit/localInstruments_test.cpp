@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include <metrics/localInstruments.hpp>
+
+using namespace metricsManager;
+
+TEST(LocalSlotsTest, SlotPerThread)
+{
+    struct Slot
+    {
+        int value {0};
+    };
+    detail::LocalSlots<Slot> slots;
+
+    ++slots.local().value;
+    ++slots.local().value;
+    std::thread([&slots]() { slots.local().value += 10; }).join();
+
+    std::vector<int> values;
+    slots.forEach([&values](const Slot& slot) { values.push_back(slot.value); });
+    ASSERT_EQ(values, (std::vector<int> {2, 10}));
+}
+
+TEST(LocalSlotsTest, InstrumentsDoNotShareSlots)
+{
+    struct Slot
+    {
+        int value {0};
+    };
+    detail::LocalSlots<Slot> first;
+    detail::LocalSlots<Slot> second;
+
+    first.local().value = 1;
+    second.local().value = 2;
+    ASSERT_EQ(first.local().value, 1);
+    ASSERT_EQ(second.local().value, 2);
+}
+
+TEST(LocalHistogramTest, Buckets)
+{
+    LocalHistogram<uint64_t> histogram;
+    histogram.recordValue(0);
+    histogram.recordValue(5);
+    histogram.recordValue(6);
+    histogram.recordValue(20000);
+
+    auto point = histogram.snapshot();
+    ASSERT_EQ(point.count, 4);
+    ASSERT_EQ(point.sum, 20011);
+    ASSERT_EQ(point.min, 0);
+    ASSERT_EQ(point.max, 20000);
+    ASSERT_EQ(point.counts, (std::vector<uint64_t> {1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1}));
+}
+
+TEST(LocalHistogramTest, Empty)
+{
+    LocalHistogram<double> histogram;
+
+    auto point = histogram.snapshot();
+    ASSERT_EQ(point.count, 0);
+    ASSERT_EQ(point.min, 0.0);
+    ASSERT_EQ(point.max, 0.0);
+    ASSERT_EQ(point.counts.size(), LocalHistogram<double>::BOUNDARIES + 1);
+}
+
+TEST(LocalHistogramTest, MergeThreads)
+{
+    LocalHistogram<double> histogram;
+
+    std::vector<std::thread> threads;
+    for (auto t = 0; t < 4; ++t)
+    {
+        threads.emplace_back(
+            [&histogram, t]()
+            {
+                for (auto i = 0; i < 1000; ++i)
+                {
+                    histogram.recordValue(t * 100.0 + 1.0);
+                }
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    auto point = histogram.snapshot();
+    ASSERT_EQ(point.count, 4000);
+    ASSERT_DOUBLE_EQ(point.sum, 1000 * (1.0 + 101.0 + 201.0 + 301.0));
+    ASSERT_DOUBLE_EQ(point.min, 1.0);
+    ASSERT_DOUBLE_EQ(point.max, 301.0);
+    ASSERT_EQ(point.counts[1], 1000);
+    ASSERT_EQ(point.counts[7], 2000);
+    ASSERT_EQ(point.counts[8], 1000);
+}
+
+TEST(LocalHistogramTest, Disabled)
+{
+    LocalHistogram<uint64_t> histogram;
+    histogram.setEnabledStatus(false);
+    histogram.recordValue(1);
+
+    ASSERT_EQ(histogram.snapshot().count, 0);
+}
@@ -117,4 +117,79 @@ TEST_F(MetricsScopeTest, MetricsGauge)
     EXPECT_EQ(expected, subArrayGauge[0]);
 }
 
+TEST_F(MetricsScopeTest, MetricsLocalCounter)
+{
+    auto counter = m_spMetricsScope->getLocalCounterUInteger("localCounter_0");
+    std::vector<std::thread> threads;
+    for (auto t = 0; t < 4; ++t)
+    {
+        threads.emplace_back(
+            [&counter]()
+            {
+                for (auto i = 0; i < 1000; ++i)
+                {
+                    counter->addValue(1);
+                }
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(2000));
+    auto arrayCounter =
+        m_spMetricsScope->getAllMetrics().getJson("/localCounter_0").value().getArray("/records").value();
+    arrayCounter[0].erase("/start_time");
+
+    auto expected = json::Json {R"({
+        "instrument_name":"localCounter_0",
+        "instrument_description":"",
+        "unit":"",
+        "type":"ObservableCounter",
+        "attributes":[
+            {"type":"SumPointData",
+            "value":4000}
+            ]})"};
+
+    EXPECT_EQ(expected, arrayCounter[0]);
+}
+
+TEST_F(MetricsScopeTest, MetricsLocalHistogram)
+{
+    auto histogram = m_spMetricsScope->getLocalHistogramUInteger("localHistogram_0");
+    histogram->recordValue(1);
+    std::thread([&histogram]() { histogram->recordValue(30); }).join();
+    std::this_thread::sleep_for(std::chrono::milliseconds(2000));
+    auto arrayHistogram =
+        m_spMetricsScope->getAllMetrics().getJson("/localHistogram_0").value().getArray("/records").value();
+    arrayHistogram[0].erase("/start_time");
+
+    auto expected = json::Json {R"({
+        "instrument_name":"localHistogram_0",
+        "instrument_description":"",
+        "unit":"",
+        "type":"Histogram",
+        "attributes":[
+            {"type":"HistogramPointData",
+            "count":2,
+            "sum":31,
+            "min":1,
+            "max":30,
+            "buckets":[0.0,5.0,10.0,25.0,50.0,75.0,100.0,250.0,500.0,750.0,1000.0,2500.0,5000.0,7500.0,10000.0],
+            "counts":[0,1,0,0,1,0,0,0,0,0,0,0,0,0,0,0]
+            }]})"};
+
+    EXPECT_EQ(expected, arrayHistogram[0]);
+}
+
+TEST_F(MetricsScopeTest, LocalInstrumentsEnabledStatus)
+{
+    auto histogram = m_spMetricsScope->getLocalHistogramDouble("localHistogram_1");
+    ASSERT_TRUE(m_spMetricsScope->setEnabledStatus("localHistogram_1", false));
+    histogram->recordValue(1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2000));
+
+    EXPECT_TRUE(m_spMetricsScope->getAllMetrics("localHistogram_1").isNull());
+}
+
 OPENTELEMETRY_END_NAMESPACE
@@ -8,7 +8,8 @@
 class MockDataHubExporter : public metricsManager::IDataHub
 {
 public:
-    MOCK_METHOD(void, setResource, (const std::string&, const json::Json&), (override));
+    MOCK_METHOD(std::size_t, getResourceId, (const std::string&), (override));
+    MOCK_METHOD(void, setResource, (std::size_t, metricsManager::ResourceData&&), (override));
 };
 
 #endif //_MOCK_DATA_HUB_EXPORTER_HPP
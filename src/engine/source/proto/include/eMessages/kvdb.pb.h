@@ -87,6 +87,9 @@ extern managerGet_RequestDefaultTypeInternal _managerGet_Request_default_instanc
 class managerGet_Response;
 struct managerGet_ResponseDefaultTypeInternal;
 extern managerGet_ResponseDefaultTypeInternal _managerGet_Response_default_instance_;
+class managerImport_Request;
+struct managerImport_RequestDefaultTypeInternal;
+extern managerImport_RequestDefaultTypeInternal _managerImport_Request_default_instance_;
 class managerPost_Request;
 struct managerPost_RequestDefaultTypeInternal;
 extern managerPost_RequestDefaultTypeInternal _managerPost_Request_default_instance_;
@@ -108,6 +111,7 @@ template<> ::com::wazuh::api::engine::kvdb::managerDump_Request* Arena::CreateMa
 template<> ::com::wazuh::api::engine::kvdb::managerDump_Response* Arena::CreateMaybeMessage<::com::wazuh::api::engine::kvdb::managerDump_Response>(Arena*);
 template<> ::com::wazuh::api::engine::kvdb::managerGet_Request* Arena::CreateMaybeMessage<::com::wazuh::api::engine::kvdb::managerGet_Request>(Arena*);
 template<> ::com::wazuh::api::engine::kvdb::managerGet_Response* Arena::CreateMaybeMessage<::com::wazuh::api::engine::kvdb::managerGet_Response>(Arena*);
+template<> ::com::wazuh::api::engine::kvdb::managerImport_Request* Arena::CreateMaybeMessage<::com::wazuh::api::engine::kvdb::managerImport_Request>(Arena*);
 template<> ::com::wazuh::api::engine::kvdb::managerPost_Request* Arena::CreateMaybeMessage<::com::wazuh::api::engine::kvdb::managerPost_Request>(Arena*);
 PROTOBUF_NAMESPACE_CLOSE
 namespace com {
@@ -786,6 +790,7 @@ class dbSearch_Request final :
   enum : int {
     kNameFieldNumber = 1,
     kPrefixFieldNumber = 2,
+    kCursorFieldNumber = 5,
     kPageFieldNumber = 3,
     kRecordsFieldNumber = 4,
   };
@@ -825,6 +830,24 @@ class dbSearch_Request final :
   std::string* _internal_mutable_prefix();
   public:
 
+  // optional string cursor = 5;
+  bool has_cursor() const;
+  private:
+  bool _internal_has_cursor() const;
+  public:
+  void clear_cursor();
+  const std::string& cursor() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_cursor(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_cursor();
+  PROTOBUF_NODISCARD std::string* release_cursor();
+  void set_allocated_cursor(std::string* cursor);
+  private:
+  const std::string& _internal_cursor() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_cursor(const std::string& value);
+  std::string* _internal_mutable_cursor();
+  public:
+
   // optional uint32 page = 3;
   bool has_page() const;
   private:
@@ -863,6 +886,7 @@ class dbSearch_Request final :
     mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
     ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr name_;
     ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr prefix_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr cursor_;
     uint32_t page_;
     uint32_t records_;
   };
@@ -994,6 +1018,7 @@ class dbSearch_Response final :
   enum : int {
     kEntriesFieldNumber = 3,
     kErrorFieldNumber = 2,
+    kNextCursorFieldNumber = 4,
     kStatusFieldNumber = 1,
   };
   // repeated .com.wazuh.api.engine.kvdb.Entry entries = 3;
@@ -1032,6 +1057,24 @@ class dbSearch_Response final :
   std::string* _internal_mutable_error();
   public:
 
+  // optional string next_cursor = 4;
+  bool has_next_cursor() const;
+  private:
+  bool _internal_has_next_cursor() const;
+  public:
+  void clear_next_cursor();
+  const std::string& next_cursor() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_next_cursor(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_next_cursor();
+  PROTOBUF_NODISCARD std::string* release_next_cursor();
+  void set_allocated_next_cursor(std::string* next_cursor);
+  private:
+  const std::string& _internal_next_cursor() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_next_cursor(const std::string& value);
+  std::string* _internal_mutable_next_cursor();
+  public:
+
   // .com.wazuh.api.engine.ReturnStatus status = 1;
   void clear_status();
   ::com::wazuh::api::engine::ReturnStatus status() const;
@@ -1053,6 +1096,7 @@ class dbSearch_Response final :
     mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
     ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::com::wazuh::api::engine::kvdb::Entry > entries_;
     ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr error_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr next_cursor_;
     int status_;
   };
   union { Impl_ _impl_; };
@@ -1958,6 +2002,199 @@ class managerPost_Request final :
 };
 // -------------------------------------------------------------------
 
+class managerImport_Request final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:com.wazuh.api.engine.kvdb.managerImport_Request) */ {
+ public:
+  inline managerImport_Request() : managerImport_Request(nullptr) {}
+  ~managerImport_Request() override;
+  explicit PROTOBUF_CONSTEXPR managerImport_Request(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  managerImport_Request(const managerImport_Request& from);
+  managerImport_Request(managerImport_Request&& from) noexcept
+    : managerImport_Request() {
+    *this = ::std::move(from);
+  }
+
+  inline managerImport_Request& operator=(const managerImport_Request& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline managerImport_Request& operator=(managerImport_Request&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const managerImport_Request& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const managerImport_Request* internal_default_instance() {
+    return reinterpret_cast<const managerImport_Request*>(
+               &_managerImport_Request_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    10;
+
+  friend void swap(managerImport_Request& a, managerImport_Request& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(managerImport_Request* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(managerImport_Request* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  managerImport_Request* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<managerImport_Request>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const managerImport_Request& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const managerImport_Request& from) {
+    managerImport_Request::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(managerImport_Request* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "com.wazuh.api.engine.kvdb.managerImport_Request";
+  }
+  protected:
+  explicit managerImport_Request(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kNameFieldNumber = 1,
+    kPathFieldNumber = 2,
+    kReplaceFieldNumber = 3,
+  };
+  // optional string name = 1;
+  bool has_name() const;
+  private:
+  bool _internal_has_name() const;
+  public:
+  void clear_name();
+  const std::string& name() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_name(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_name();
+  PROTOBUF_NODISCARD std::string* release_name();
+  void set_allocated_name(std::string* name);
+  private:
+  const std::string& _internal_name() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_name(const std::string& value);
+  std::string* _internal_mutable_name();
+  public:
+
+  // optional string path = 2;
+  bool has_path() const;
+  private:
+  bool _internal_has_path() const;
+  public:
+  void clear_path();
+  const std::string& path() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_path(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_path();
+  PROTOBUF_NODISCARD std::string* release_path();
+  void set_allocated_path(std::string* path);
+  private:
+  const std::string& _internal_path() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_path(const std::string& value);
+  std::string* _internal_mutable_path();
+  public:
+
+  // optional bool replace = 3;
+  bool has_replace() const;
+  private:
+  bool _internal_has_replace() const;
+  public:
+  void clear_replace();
+  bool replace() const;
+  void set_replace(bool value);
+  private:
+  bool _internal_replace() const;
+  void _internal_set_replace(bool value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:com.wazuh.api.engine.kvdb.managerImport_Request)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr name_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr path_;
+    bool replace_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_kvdb_2eproto;
+};
+// -------------------------------------------------------------------
+
 class managerDelete_Request final :
     public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:com.wazuh.api.engine.kvdb.managerDelete_Request) */ {
  public:
@@ -2006,7 +2243,7 @@ class managerDelete_Request final :
                &_managerDelete_Request_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
-    10;
+    11;
 
   friend void swap(managerDelete_Request& a, managerDelete_Request& b) {
     a.Swap(&b);
@@ -2164,7 +2401,7 @@ class managerDump_Request final :
                &_managerDump_Request_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
-    11;
+    12;
 
   friend void swap(managerDump_Request& a, managerDump_Request& b) {
     a.Swap(&b);
@@ -2238,6 +2475,7 @@ class managerDump_Request final :
 
   enum : int {
     kNameFieldNumber = 1,
+    kCursorFieldNumber = 4,
     kPageFieldNumber = 2,
     kRecordsFieldNumber = 3,
   };
@@ -2259,6 +2497,24 @@ class managerDump_Request final :
   std::string* _internal_mutable_name();
   public:
 
+  // optional string cursor = 4;
+  bool has_cursor() const;
+  private:
+  bool _internal_has_cursor() const;
+  public:
+  void clear_cursor();
+  const std::string& cursor() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_cursor(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_cursor();
+  PROTOBUF_NODISCARD std::string* release_cursor();
+  void set_allocated_cursor(std::string* cursor);
+  private:
+  const std::string& _internal_cursor() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_cursor(const std::string& value);
+  std::string* _internal_mutable_cursor();
+  public:
+
   // optional uint32 page = 2;
   bool has_page() const;
   private:
@@ -2296,6 +2552,7 @@ class managerDump_Request final :
     ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
     mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
     ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr name_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr cursor_;
     uint32_t page_;
     uint32_t records_;
   };
@@ -2352,7 +2609,7 @@ class managerDump_Response final :
                &_managerDump_Response_default_instance_);
   }
   static constexpr int kIndexInFileMessages =
-    12;
+    13;
 
   friend void swap(managerDump_Response& a, managerDump_Response& b) {
     a.Swap(&b);
@@ -2427,6 +2684,7 @@ class managerDump_Response final :
   enum : int {
     kEntriesFieldNumber = 3,
     kErrorFieldNumber = 2,
+    kNextCursorFieldNumber = 4,
     kStatusFieldNumber = 1,
   };
   // repeated .com.wazuh.api.engine.kvdb.Entry entries = 3;
@@ -2465,6 +2723,24 @@ class managerDump_Response final :
   std::string* _internal_mutable_error();
   public:
 
+  // optional string next_cursor = 4;
+  bool has_next_cursor() const;
+  private:
+  bool _internal_has_next_cursor() const;
+  public:
+  void clear_next_cursor();
+  const std::string& next_cursor() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_next_cursor(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_next_cursor();
+  PROTOBUF_NODISCARD std::string* release_next_cursor();
+  void set_allocated_next_cursor(std::string* next_cursor);
+  private:
+  const std::string& _internal_next_cursor() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_next_cursor(const std::string& value);
+  std::string* _internal_mutable_next_cursor();
+  public:
+
   // .com.wazuh.api.engine.ReturnStatus status = 1;
   void clear_status();
   ::com::wazuh::api::engine::ReturnStatus status() const;
@@ -2486,6 +2762,7 @@ class managerDump_Response final :
     mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
     ::PROTOBUF_NAMESPACE_ID::RepeatedPtrField< ::com::wazuh::api::engine::kvdb::Entry > entries_;
     ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr error_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr next_cursor_;
     int status_;
   };
   union { Impl_ _impl_; };
@@ -3118,7 +3395,7 @@ inline void dbSearch_Request::set_allocated_prefix(std::string* prefix) {
 
 // optional uint32 page = 3;
 inline bool dbSearch_Request::_internal_has_page() const {
-  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000008u) != 0;
   return value;
 }
 inline bool dbSearch_Request::has_page() const {
@@ -3126,7 +3403,7 @@ inline bool dbSearch_Request::has_page() const {
 }
 inline void dbSearch_Request::clear_page() {
   _impl_.page_ = 0u;
-  _impl_._has_bits_[0] &= ~0x00000004u;
+  _impl_._has_bits_[0] &= ~0x00000008u;
 }
 inline uint32_t dbSearch_Request::_internal_page() const {
   return _impl_.page_;
@@ -3136,7 +3413,7 @@ inline uint32_t dbSearch_Request::page() const {
   return _internal_page();
 }
 inline void dbSearch_Request::_internal_set_page(uint32_t value) {
-  _impl_._has_bits_[0] |= 0x00000004u;
+  _impl_._has_bits_[0] |= 0x00000008u;
   _impl_.page_ = value;
 }
 inline void dbSearch_Request::set_page(uint32_t value) {
@@ -3146,7 +3423,7 @@ inline void dbSearch_Request::set_page(uint32_t value) {
 
 // optional uint32 records = 4;
 inline bool dbSearch_Request::_internal_has_records() const {
-  bool value = (_impl_._has_bits_[0] & 0x00000008u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000010u) != 0;
   return value;
 }
 inline bool dbSearch_Request::has_records() const {
@@ -3154,7 +3431,7 @@ inline bool dbSearch_Request::has_records() const {
 }
 inline void dbSearch_Request::clear_records() {
   _impl_.records_ = 0u;
-  _impl_._has_bits_[0] &= ~0x00000008u;
+  _impl_._has_bits_[0] &= ~0x00000010u;
 }
 inline uint32_t dbSearch_Request::_internal_records() const {
   return _impl_.records_;
@@ -3164,7 +3441,7 @@ inline uint32_t dbSearch_Request::records() const {
   return _internal_records();
 }
 inline void dbSearch_Request::_internal_set_records(uint32_t value) {
-  _impl_._has_bits_[0] |= 0x00000008u;
+  _impl_._has_bits_[0] |= 0x00000010u;
   _impl_.records_ = value;
 }
 inline void dbSearch_Request::set_records(uint32_t value) {
@@ -3172,6 +3449,74 @@ inline void dbSearch_Request::set_records(uint32_t value) {
   // @@protoc_insertion_point(field_set:com.wazuh.api.engine.kvdb.dbSearch_Request.records)
 }
 
+// optional string cursor = 5;
+inline bool dbSearch_Request::_internal_has_cursor() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
+  return value;
+}
+inline bool dbSearch_Request::has_cursor() const {
+  return _internal_has_cursor();
+}
+inline void dbSearch_Request::clear_cursor() {
+  _impl_.cursor_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000004u;
+}
+inline const std::string& dbSearch_Request::cursor() const {
+  // @@protoc_insertion_point(field_get:com.wazuh.api.engine.kvdb.dbSearch_Request.cursor)
+  return _internal_cursor();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void dbSearch_Request::set_cursor(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000004u;
+ _impl_.cursor_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:com.wazuh.api.engine.kvdb.dbSearch_Request.cursor)
+}
+inline std::string* dbSearch_Request::mutable_cursor() {
+  std::string* _s = _internal_mutable_cursor();
+  // @@protoc_insertion_point(field_mutable:com.wazuh.api.engine.kvdb.dbSearch_Request.cursor)
+  return _s;
+}
+inline const std::string& dbSearch_Request::_internal_cursor() const {
+  return _impl_.cursor_.Get();
+}
+inline void dbSearch_Request::_internal_set_cursor(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000004u;
+  _impl_.cursor_.Set(value, GetArenaForAllocation());
+}
+inline std::string* dbSearch_Request::_internal_mutable_cursor() {
+  _impl_._has_bits_[0] |= 0x00000004u;
+  return _impl_.cursor_.Mutable(GetArenaForAllocation());
+}
+inline std::string* dbSearch_Request::release_cursor() {
+  // @@protoc_insertion_point(field_release:com.wazuh.api.engine.kvdb.dbSearch_Request.cursor)
+  if (!_internal_has_cursor()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000004u;
+  auto* p = _impl_.cursor_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.cursor_.IsDefault()) {
+    _impl_.cursor_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void dbSearch_Request::set_allocated_cursor(std::string* cursor) {
+  if (cursor != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000004u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000004u;
+  }
+  _impl_.cursor_.SetAllocated(cursor, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.cursor_.IsDefault()) {
+    _impl_.cursor_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:com.wazuh.api.engine.kvdb.dbSearch_Request.cursor)
+}
+
 // -------------------------------------------------------------------
 
 // dbSearch_Response
@@ -3304,6 +3649,74 @@ dbSearch_Response::entries() const {
   return _impl_.entries_;
 }
 
+// optional string next_cursor = 4;
+inline bool dbSearch_Response::_internal_has_next_cursor() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool dbSearch_Response::has_next_cursor() const {
+  return _internal_has_next_cursor();
+}
+inline void dbSearch_Response::clear_next_cursor() {
+  _impl_.next_cursor_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline const std::string& dbSearch_Response::next_cursor() const {
+  // @@protoc_insertion_point(field_get:com.wazuh.api.engine.kvdb.dbSearch_Response.next_cursor)
+  return _internal_next_cursor();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void dbSearch_Response::set_next_cursor(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000002u;
+ _impl_.next_cursor_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:com.wazuh.api.engine.kvdb.dbSearch_Response.next_cursor)
+}
+inline std::string* dbSearch_Response::mutable_next_cursor() {
+  std::string* _s = _internal_mutable_next_cursor();
+  // @@protoc_insertion_point(field_mutable:com.wazuh.api.engine.kvdb.dbSearch_Response.next_cursor)
+  return _s;
+}
+inline const std::string& dbSearch_Response::_internal_next_cursor() const {
+  return _impl_.next_cursor_.Get();
+}
+inline void dbSearch_Response::_internal_set_next_cursor(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.next_cursor_.Set(value, GetArenaForAllocation());
+}
+inline std::string* dbSearch_Response::_internal_mutable_next_cursor() {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  return _impl_.next_cursor_.Mutable(GetArenaForAllocation());
+}
+inline std::string* dbSearch_Response::release_next_cursor() {
+  // @@protoc_insertion_point(field_release:com.wazuh.api.engine.kvdb.dbSearch_Response.next_cursor)
+  if (!_internal_has_next_cursor()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000002u;
+  auto* p = _impl_.next_cursor_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.next_cursor_.IsDefault()) {
+    _impl_.next_cursor_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void dbSearch_Response::set_allocated_next_cursor(std::string* next_cursor) {
+  if (next_cursor != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000002u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000002u;
+  }
+  _impl_.next_cursor_.SetAllocated(next_cursor, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.next_cursor_.IsDefault()) {
+    _impl_.next_cursor_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:com.wazuh.api.engine.kvdb.dbSearch_Response.next_cursor)
+}
+
 // -------------------------------------------------------------------
 
 // dbDelete_Request
@@ -4007,6 +4420,174 @@ inline void managerPost_Request::set_allocated_path(std::string* path) {
 
 // -------------------------------------------------------------------
 
+// managerImport_Request
+
+// optional string name = 1;
+inline bool managerImport_Request::_internal_has_name() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool managerImport_Request::has_name() const {
+  return _internal_has_name();
+}
+inline void managerImport_Request::clear_name() {
+  _impl_.name_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline const std::string& managerImport_Request::name() const {
+  // @@protoc_insertion_point(field_get:com.wazuh.api.engine.kvdb.managerImport_Request.name)
+  return _internal_name();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void managerImport_Request::set_name(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000001u;
+ _impl_.name_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:com.wazuh.api.engine.kvdb.managerImport_Request.name)
+}
+inline std::string* managerImport_Request::mutable_name() {
+  std::string* _s = _internal_mutable_name();
+  // @@protoc_insertion_point(field_mutable:com.wazuh.api.engine.kvdb.managerImport_Request.name)
+  return _s;
+}
+inline const std::string& managerImport_Request::_internal_name() const {
+  return _impl_.name_.Get();
+}
+inline void managerImport_Request::_internal_set_name(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.name_.Set(value, GetArenaForAllocation());
+}
+inline std::string* managerImport_Request::_internal_mutable_name() {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  return _impl_.name_.Mutable(GetArenaForAllocation());
+}
+inline std::string* managerImport_Request::release_name() {
+  // @@protoc_insertion_point(field_release:com.wazuh.api.engine.kvdb.managerImport_Request.name)
+  if (!_internal_has_name()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  auto* p = _impl_.name_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.name_.IsDefault()) {
+    _impl_.name_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void managerImport_Request::set_allocated_name(std::string* name) {
+  if (name != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000001u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  _impl_.name_.SetAllocated(name, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.name_.IsDefault()) {
+    _impl_.name_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:com.wazuh.api.engine.kvdb.managerImport_Request.name)
+}
+
+// optional string path = 2;
+inline bool managerImport_Request::_internal_has_path() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool managerImport_Request::has_path() const {
+  return _internal_has_path();
+}
+inline void managerImport_Request::clear_path() {
+  _impl_.path_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline const std::string& managerImport_Request::path() const {
+  // @@protoc_insertion_point(field_get:com.wazuh.api.engine.kvdb.managerImport_Request.path)
+  return _internal_path();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void managerImport_Request::set_path(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000002u;
+ _impl_.path_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:com.wazuh.api.engine.kvdb.managerImport_Request.path)
+}
+inline std::string* managerImport_Request::mutable_path() {
+  std::string* _s = _internal_mutable_path();
+  // @@protoc_insertion_point(field_mutable:com.wazuh.api.engine.kvdb.managerImport_Request.path)
+  return _s;
+}
+inline const std::string& managerImport_Request::_internal_path() const {
+  return _impl_.path_.Get();
+}
+inline void managerImport_Request::_internal_set_path(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.path_.Set(value, GetArenaForAllocation());
+}
+inline std::string* managerImport_Request::_internal_mutable_path() {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  return _impl_.path_.Mutable(GetArenaForAllocation());
+}
+inline std::string* managerImport_Request::release_path() {
+  // @@protoc_insertion_point(field_release:com.wazuh.api.engine.kvdb.managerImport_Request.path)
+  if (!_internal_has_path()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000002u;
+  auto* p = _impl_.path_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.path_.IsDefault()) {
+    _impl_.path_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void managerImport_Request::set_allocated_path(std::string* path) {
+  if (path != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000002u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000002u;
+  }
+  _impl_.path_.SetAllocated(path, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.path_.IsDefault()) {
+    _impl_.path_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:com.wazuh.api.engine.kvdb.managerImport_Request.path)
+}
+
+// optional bool replace = 3;
+inline bool managerImport_Request::_internal_has_replace() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
+  return value;
+}
+inline bool managerImport_Request::has_replace() const {
+  return _internal_has_replace();
+}
+inline void managerImport_Request::clear_replace() {
+  _impl_.replace_ = false;
+  _impl_._has_bits_[0] &= ~0x00000004u;
+}
+inline bool managerImport_Request::_internal_replace() const {
+  return _impl_.replace_;
+}
+inline bool managerImport_Request::replace() const {
+  // @@protoc_insertion_point(field_get:com.wazuh.api.engine.kvdb.managerImport_Request.replace)
+  return _internal_replace();
+}
+inline void managerImport_Request::_internal_set_replace(bool value) {
+  _impl_._has_bits_[0] |= 0x00000004u;
+  _impl_.replace_ = value;
+}
+inline void managerImport_Request::set_replace(bool value) {
+  _internal_set_replace(value);
+  // @@protoc_insertion_point(field_set:com.wazuh.api.engine.kvdb.managerImport_Request.replace)
+}
+
+// -------------------------------------------------------------------
+
 // managerDelete_Request
 
 // optional string name = 1;
@@ -4151,7 +4732,7 @@ inline void managerDump_Request::set_allocated_name(std::string* name) {
 
 // optional uint32 page = 2;
 inline bool managerDump_Request::_internal_has_page() const {
-  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
   return value;
 }
 inline bool managerDump_Request::has_page() const {
@@ -4159,7 +4740,7 @@ inline bool managerDump_Request::has_page() const {
 }
 inline void managerDump_Request::clear_page() {
   _impl_.page_ = 0u;
-  _impl_._has_bits_[0] &= ~0x00000002u;
+  _impl_._has_bits_[0] &= ~0x00000004u;
 }
 inline uint32_t managerDump_Request::_internal_page() const {
   return _impl_.page_;
@@ -4169,7 +4750,7 @@ inline uint32_t managerDump_Request::page() const {
   return _internal_page();
 }
 inline void managerDump_Request::_internal_set_page(uint32_t value) {
-  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_._has_bits_[0] |= 0x00000004u;
   _impl_.page_ = value;
 }
 inline void managerDump_Request::set_page(uint32_t value) {
@@ -4179,7 +4760,7 @@ inline void managerDump_Request::set_page(uint32_t value) {
 
 // optional uint32 records = 3;
 inline bool managerDump_Request::_internal_has_records() const {
-  bool value = (_impl_._has_bits_[0] & 0x00000004u) != 0;
+  bool value = (_impl_._has_bits_[0] & 0x00000008u) != 0;
   return value;
 }
 inline bool managerDump_Request::has_records() const {
@@ -4187,7 +4768,7 @@ inline bool managerDump_Request::has_records() const {
 }
 inline void managerDump_Request::clear_records() {
   _impl_.records_ = 0u;
-  _impl_._has_bits_[0] &= ~0x00000004u;
+  _impl_._has_bits_[0] &= ~0x00000008u;
 }
 inline uint32_t managerDump_Request::_internal_records() const {
   return _impl_.records_;
@@ -4197,7 +4778,7 @@ inline uint32_t managerDump_Request::records() const {
   return _internal_records();
 }
 inline void managerDump_Request::_internal_set_records(uint32_t value) {
-  _impl_._has_bits_[0] |= 0x00000004u;
+  _impl_._has_bits_[0] |= 0x00000008u;
   _impl_.records_ = value;
 }
 inline void managerDump_Request::set_records(uint32_t value) {
@@ -4205,6 +4786,74 @@ inline void managerDump_Request::set_records(uint32_t value) {
   // @@protoc_insertion_point(field_set:com.wazuh.api.engine.kvdb.managerDump_Request.records)
 }
 
+// optional string cursor = 4;
+inline bool managerDump_Request::_internal_has_cursor() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool managerDump_Request::has_cursor() const {
+  return _internal_has_cursor();
+}
+inline void managerDump_Request::clear_cursor() {
+  _impl_.cursor_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline const std::string& managerDump_Request::cursor() const {
+  // @@protoc_insertion_point(field_get:com.wazuh.api.engine.kvdb.managerDump_Request.cursor)
+  return _internal_cursor();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void managerDump_Request::set_cursor(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000002u;
+ _impl_.cursor_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:com.wazuh.api.engine.kvdb.managerDump_Request.cursor)
+}
+inline std::string* managerDump_Request::mutable_cursor() {
+  std::string* _s = _internal_mutable_cursor();
+  // @@protoc_insertion_point(field_mutable:com.wazuh.api.engine.kvdb.managerDump_Request.cursor)
+  return _s;
+}
+inline const std::string& managerDump_Request::_internal_cursor() const {
+  return _impl_.cursor_.Get();
+}
+inline void managerDump_Request::_internal_set_cursor(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.cursor_.Set(value, GetArenaForAllocation());
+}
+inline std::string* managerDump_Request::_internal_mutable_cursor() {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  return _impl_.cursor_.Mutable(GetArenaForAllocation());
+}
+inline std::string* managerDump_Request::release_cursor() {
+  // @@protoc_insertion_point(field_release:com.wazuh.api.engine.kvdb.managerDump_Request.cursor)
+  if (!_internal_has_cursor()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000002u;
+  auto* p = _impl_.cursor_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.cursor_.IsDefault()) {
+    _impl_.cursor_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void managerDump_Request::set_allocated_cursor(std::string* cursor) {
+  if (cursor != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000002u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000002u;
+  }
+  _impl_.cursor_.SetAllocated(cursor, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.cursor_.IsDefault()) {
+    _impl_.cursor_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:com.wazuh.api.engine.kvdb.managerDump_Request.cursor)
+}
+
 // -------------------------------------------------------------------
 
 // managerDump_Response
@@ -4337,6 +4986,74 @@ managerDump_Response::entries() const {
   return _impl_.entries_;
 }
 
+// optional string next_cursor = 4;
+inline bool managerDump_Response::_internal_has_next_cursor() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool managerDump_Response::has_next_cursor() const {
+  return _internal_has_next_cursor();
+}
+inline void managerDump_Response::clear_next_cursor() {
+  _impl_.next_cursor_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline const std::string& managerDump_Response::next_cursor() const {
+  // @@protoc_insertion_point(field_get:com.wazuh.api.engine.kvdb.managerDump_Response.next_cursor)
+  return _internal_next_cursor();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void managerDump_Response::set_next_cursor(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000002u;
+ _impl_.next_cursor_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:com.wazuh.api.engine.kvdb.managerDump_Response.next_cursor)
+}
+inline std::string* managerDump_Response::mutable_next_cursor() {
+  std::string* _s = _internal_mutable_next_cursor();
+  // @@protoc_insertion_point(field_mutable:com.wazuh.api.engine.kvdb.managerDump_Response.next_cursor)
+  return _s;
+}
+inline const std::string& managerDump_Response::_internal_next_cursor() const {
+  return _impl_.next_cursor_.Get();
+}
+inline void managerDump_Response::_internal_set_next_cursor(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.next_cursor_.Set(value, GetArenaForAllocation());
+}
+inline std::string* managerDump_Response::_internal_mutable_next_cursor() {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  return _impl_.next_cursor_.Mutable(GetArenaForAllocation());
+}
+inline std::string* managerDump_Response::release_next_cursor() {
+  // @@protoc_insertion_point(field_release:com.wazuh.api.engine.kvdb.managerDump_Response.next_cursor)
+  if (!_internal_has_next_cursor()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000002u;
+  auto* p = _impl_.next_cursor_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.next_cursor_.IsDefault()) {
+    _impl_.next_cursor_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void managerDump_Response::set_allocated_next_cursor(std::string* next_cursor) {
+  if (next_cursor != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000002u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000002u;
+  }
+  _impl_.next_cursor_.SetAllocated(next_cursor, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.next_cursor_.IsDefault()) {
+    _impl_.next_cursor_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:com.wazuh.api.engine.kvdb.managerDump_Response.next_cursor)
+}
+
 #ifdef __GNUC__
   #pragma GCC diagnostic pop
 #endif  // __GNUC__
@@ -4364,6 +5081,8 @@ managerDump_Response::entries() const {
 
 // -------------------------------------------------------------------
 
+// -------------------------------------------------------------------
+
 
 // @@protoc_insertion_point(namespace_scope)
 
@@ -76,6 +76,12 @@ extern List_RequestDefaultTypeInternal _List_Request_default_instance_;
 class List_Response;
 struct List_ResponseDefaultTypeInternal;
 extern List_ResponseDefaultTypeInternal _List_Response_default_instance_;
+class Profile_Request;
+struct Profile_RequestDefaultTypeInternal;
+extern Profile_RequestDefaultTypeInternal _Profile_Request_default_instance_;
+class Profile_Response;
+struct Profile_ResponseDefaultTypeInternal;
+extern Profile_ResponseDefaultTypeInternal _Profile_Response_default_instance_;
 class Test_Request;
 struct Test_RequestDefaultTypeInternal;
 extern Test_RequestDefaultTypeInternal _Test_Request_default_instance_;
@@ -96,6 +102,8 @@ template<> ::com::wazuh::api::engine::metrics::Get_Request* Arena::CreateMaybeMe
 template<> ::com::wazuh::api::engine::metrics::Get_Response* Arena::CreateMaybeMessage<::com::wazuh::api::engine::metrics::Get_Response>(Arena*);
 template<> ::com::wazuh::api::engine::metrics::List_Request* Arena::CreateMaybeMessage<::com::wazuh::api::engine::metrics::List_Request>(Arena*);
 template<> ::com::wazuh::api::engine::metrics::List_Response* Arena::CreateMaybeMessage<::com::wazuh::api::engine::metrics::List_Response>(Arena*);
+template<> ::com::wazuh::api::engine::metrics::Profile_Request* Arena::CreateMaybeMessage<::com::wazuh::api::engine::metrics::Profile_Request>(Arena*);
+template<> ::com::wazuh::api::engine::metrics::Profile_Response* Arena::CreateMaybeMessage<::com::wazuh::api::engine::metrics::Profile_Response>(Arena*);
 template<> ::com::wazuh::api::engine::metrics::Test_Request* Arena::CreateMaybeMessage<::com::wazuh::api::engine::metrics::Test_Request>(Arena*);
 template<> ::com::wazuh::api::engine::metrics::Test_Response* Arena::CreateMaybeMessage<::com::wazuh::api::engine::metrics::Test_Response>(Arena*);
 PROTOBUF_NAMESPACE_CLOSE
@@ -1781,6 +1789,363 @@ class Test_Response final :
   union { Impl_ _impl_; };
   friend struct ::TableStruct_metrics_2eproto;
 };
+// -------------------------------------------------------------------
+
+class Profile_Request final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:com.wazuh.api.engine.metrics.Profile_Request) */ {
+ public:
+  inline Profile_Request() : Profile_Request(nullptr) {}
+  ~Profile_Request() override;
+  explicit PROTOBUF_CONSTEXPR Profile_Request(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  Profile_Request(const Profile_Request& from);
+  Profile_Request(Profile_Request&& from) noexcept
+    : Profile_Request() {
+    *this = ::std::move(from);
+  }
+
+  inline Profile_Request& operator=(const Profile_Request& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline Profile_Request& operator=(Profile_Request&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const Profile_Request& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const Profile_Request* internal_default_instance() {
+    return reinterpret_cast<const Profile_Request*>(
+               &_Profile_Request_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    10;
+
+  friend void swap(Profile_Request& a, Profile_Request& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(Profile_Request* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(Profile_Request* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  Profile_Request* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<Profile_Request>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const Profile_Request& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const Profile_Request& from) {
+    Profile_Request::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(Profile_Request* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "com.wazuh.api.engine.metrics.Profile_Request";
+  }
+  protected:
+  explicit Profile_Request(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kLimitFieldNumber = 1,
+    kResetFieldNumber = 2,
+  };
+  // optional uint32 limit = 1;
+  bool has_limit() const;
+  private:
+  bool _internal_has_limit() const;
+  public:
+  void clear_limit();
+  uint32_t limit() const;
+  void set_limit(uint32_t value);
+  private:
+  uint32_t _internal_limit() const;
+  void _internal_set_limit(uint32_t value);
+  public:
+
+  // optional bool reset = 2;
+  bool has_reset() const;
+  private:
+  bool _internal_has_reset() const;
+  public:
+  void clear_reset();
+  bool reset() const;
+  void set_reset(bool value);
+  private:
+  bool _internal_reset() const;
+  void _internal_set_reset(bool value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:com.wazuh.api.engine.metrics.Profile_Request)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    uint32_t limit_;
+    bool reset_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_metrics_2eproto;
+};
+// -------------------------------------------------------------------
+
+class Profile_Response final :
+    public ::PROTOBUF_NAMESPACE_ID::Message /* @@protoc_insertion_point(class_definition:com.wazuh.api.engine.metrics.Profile_Response) */ {
+ public:
+  inline Profile_Response() : Profile_Response(nullptr) {}
+  ~Profile_Response() override;
+  explicit PROTOBUF_CONSTEXPR Profile_Response(::PROTOBUF_NAMESPACE_ID::internal::ConstantInitialized);
+
+  Profile_Response(const Profile_Response& from);
+  Profile_Response(Profile_Response&& from) noexcept
+    : Profile_Response() {
+    *this = ::std::move(from);
+  }
+
+  inline Profile_Response& operator=(const Profile_Response& from) {
+    CopyFrom(from);
+    return *this;
+  }
+  inline Profile_Response& operator=(Profile_Response&& from) noexcept {
+    if (this == &from) return *this;
+    if (GetOwningArena() == from.GetOwningArena()
+  #ifdef PROTOBUF_FORCE_COPY_IN_MOVE
+        && GetOwningArena() != nullptr
+  #endif  // !PROTOBUF_FORCE_COPY_IN_MOVE
+    ) {
+      InternalSwap(&from);
+    } else {
+      CopyFrom(from);
+    }
+    return *this;
+  }
+
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* descriptor() {
+    return GetDescriptor();
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Descriptor* GetDescriptor() {
+    return default_instance().GetMetadata().descriptor;
+  }
+  static const ::PROTOBUF_NAMESPACE_ID::Reflection* GetReflection() {
+    return default_instance().GetMetadata().reflection;
+  }
+  static const Profile_Response& default_instance() {
+    return *internal_default_instance();
+  }
+  static inline const Profile_Response* internal_default_instance() {
+    return reinterpret_cast<const Profile_Response*>(
+               &_Profile_Response_default_instance_);
+  }
+  static constexpr int kIndexInFileMessages =
+    11;
+
+  friend void swap(Profile_Response& a, Profile_Response& b) {
+    a.Swap(&b);
+  }
+  inline void Swap(Profile_Response* other) {
+    if (other == this) return;
+  #ifdef PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() != nullptr &&
+        GetOwningArena() == other->GetOwningArena()) {
+   #else  // PROTOBUF_FORCE_COPY_IN_SWAP
+    if (GetOwningArena() == other->GetOwningArena()) {
+  #endif  // !PROTOBUF_FORCE_COPY_IN_SWAP
+      InternalSwap(other);
+    } else {
+      ::PROTOBUF_NAMESPACE_ID::internal::GenericSwap(this, other);
+    }
+  }
+  void UnsafeArenaSwap(Profile_Response* other) {
+    if (other == this) return;
+    GOOGLE_DCHECK(GetOwningArena() == other->GetOwningArena());
+    InternalSwap(other);
+  }
+
+  // implements Message ----------------------------------------------
+
+  Profile_Response* New(::PROTOBUF_NAMESPACE_ID::Arena* arena = nullptr) const final {
+    return CreateMaybeMessage<Profile_Response>(arena);
+  }
+  using ::PROTOBUF_NAMESPACE_ID::Message::CopyFrom;
+  void CopyFrom(const Profile_Response& from);
+  using ::PROTOBUF_NAMESPACE_ID::Message::MergeFrom;
+  void MergeFrom( const Profile_Response& from) {
+    Profile_Response::MergeImpl(*this, from);
+  }
+  private:
+  static void MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF_NAMESPACE_ID::Message& from_msg);
+  public:
+  PROTOBUF_ATTRIBUTE_REINITIALIZES void Clear() final;
+  bool IsInitialized() const final;
+
+  size_t ByteSizeLong() const final;
+  const char* _InternalParse(const char* ptr, ::PROTOBUF_NAMESPACE_ID::internal::ParseContext* ctx) final;
+  uint8_t* _InternalSerialize(
+      uint8_t* target, ::PROTOBUF_NAMESPACE_ID::io::EpsCopyOutputStream* stream) const final;
+  int GetCachedSize() const final { return _impl_._cached_size_.Get(); }
+
+  private:
+  void SharedCtor(::PROTOBUF_NAMESPACE_ID::Arena* arena, bool is_message_owned);
+  void SharedDtor();
+  void SetCachedSize(int size) const final;
+  void InternalSwap(Profile_Response* other);
+
+  private:
+  friend class ::PROTOBUF_NAMESPACE_ID::internal::AnyMetadata;
+  static ::PROTOBUF_NAMESPACE_ID::StringPiece FullMessageName() {
+    return "com.wazuh.api.engine.metrics.Profile_Response";
+  }
+  protected:
+  explicit Profile_Response(::PROTOBUF_NAMESPACE_ID::Arena* arena,
+                       bool is_message_owned = false);
+  public:
+
+  static const ClassData _class_data_;
+  const ::PROTOBUF_NAMESPACE_ID::Message::ClassData*GetClassData() const final;
+
+  ::PROTOBUF_NAMESPACE_ID::Metadata GetMetadata() const final;
+
+  // nested types ----------------------------------------------------
+
+  // accessors -------------------------------------------------------
+
+  enum : int {
+    kErrorFieldNumber = 2,
+    kValueFieldNumber = 3,
+    kStatusFieldNumber = 1,
+  };
+  // optional string error = 2;
+  bool has_error() const;
+  private:
+  bool _internal_has_error() const;
+  public:
+  void clear_error();
+  const std::string& error() const;
+  template <typename ArgT0 = const std::string&, typename... ArgT>
+  void set_error(ArgT0&& arg0, ArgT... args);
+  std::string* mutable_error();
+  PROTOBUF_NODISCARD std::string* release_error();
+  void set_allocated_error(std::string* error);
+  private:
+  const std::string& _internal_error() const;
+  inline PROTOBUF_ALWAYS_INLINE void _internal_set_error(const std::string& value);
+  std::string* _internal_mutable_error();
+  public:
+
+  // optional .google.protobuf.Value value = 3;
+  bool has_value() const;
+  private:
+  bool _internal_has_value() const;
+  public:
+  void clear_value();
+  const ::PROTOBUF_NAMESPACE_ID::Value& value() const;
+  PROTOBUF_NODISCARD ::PROTOBUF_NAMESPACE_ID::Value* release_value();
+  ::PROTOBUF_NAMESPACE_ID::Value* mutable_value();
+  void set_allocated_value(::PROTOBUF_NAMESPACE_ID::Value* value);
+  private:
+  const ::PROTOBUF_NAMESPACE_ID::Value& _internal_value() const;
+  ::PROTOBUF_NAMESPACE_ID::Value* _internal_mutable_value();
+  public:
+  void unsafe_arena_set_allocated_value(
+      ::PROTOBUF_NAMESPACE_ID::Value* value);
+  ::PROTOBUF_NAMESPACE_ID::Value* unsafe_arena_release_value();
+
+  // .com.wazuh.api.engine.ReturnStatus status = 1;
+  void clear_status();
+  ::com::wazuh::api::engine::ReturnStatus status() const;
+  void set_status(::com::wazuh::api::engine::ReturnStatus value);
+  private:
+  ::com::wazuh::api::engine::ReturnStatus _internal_status() const;
+  void _internal_set_status(::com::wazuh::api::engine::ReturnStatus value);
+  public:
+
+  // @@protoc_insertion_point(class_scope:com.wazuh.api.engine.metrics.Profile_Response)
+ private:
+  class _Internal;
+
+  template <typename T> friend class ::PROTOBUF_NAMESPACE_ID::Arena::InternalHelper;
+  typedef void InternalArenaConstructable_;
+  typedef void DestructorSkippable_;
+  struct Impl_ {
+    ::PROTOBUF_NAMESPACE_ID::internal::HasBits<1> _has_bits_;
+    mutable ::PROTOBUF_NAMESPACE_ID::internal::CachedSize _cached_size_;
+    ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr error_;
+    ::PROTOBUF_NAMESPACE_ID::Value* value_;
+    int status_;
+  };
+  union { Impl_ _impl_; };
+  friend struct ::TableStruct_metrics_2eproto;
+};
 // ===================================================================
 
 
@@ -2972,6 +3337,245 @@ Test_Response::mutable_content() {
   return &_impl_.content_;
 }
 
+// -------------------------------------------------------------------
+
+// Profile_Request
+
+// optional uint32 limit = 1;
+inline bool Profile_Request::_internal_has_limit() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool Profile_Request::has_limit() const {
+  return _internal_has_limit();
+}
+inline void Profile_Request::clear_limit() {
+  _impl_.limit_ = 0u;
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline uint32_t Profile_Request::_internal_limit() const {
+  return _impl_.limit_;
+}
+inline uint32_t Profile_Request::limit() const {
+  // @@protoc_insertion_point(field_get:com.wazuh.api.engine.metrics.Profile_Request.limit)
+  return _internal_limit();
+}
+inline void Profile_Request::_internal_set_limit(uint32_t value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.limit_ = value;
+}
+inline void Profile_Request::set_limit(uint32_t value) {
+  _internal_set_limit(value);
+  // @@protoc_insertion_point(field_set:com.wazuh.api.engine.metrics.Profile_Request.limit)
+}
+
+// optional bool reset = 2;
+inline bool Profile_Request::_internal_has_reset() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool Profile_Request::has_reset() const {
+  return _internal_has_reset();
+}
+inline void Profile_Request::clear_reset() {
+  _impl_.reset_ = false;
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline bool Profile_Request::_internal_reset() const {
+  return _impl_.reset_;
+}
+inline bool Profile_Request::reset() const {
+  // @@protoc_insertion_point(field_get:com.wazuh.api.engine.metrics.Profile_Request.reset)
+  return _internal_reset();
+}
+inline void Profile_Request::_internal_set_reset(bool value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.reset_ = value;
+}
+inline void Profile_Request::set_reset(bool value) {
+  _internal_set_reset(value);
+  // @@protoc_insertion_point(field_set:com.wazuh.api.engine.metrics.Profile_Request.reset)
+}
+
+// -------------------------------------------------------------------
+
+// Profile_Response
+
+// .com.wazuh.api.engine.ReturnStatus status = 1;
+inline void Profile_Response::clear_status() {
+  _impl_.status_ = 0;
+}
+inline ::com::wazuh::api::engine::ReturnStatus Profile_Response::_internal_status() const {
+  return static_cast< ::com::wazuh::api::engine::ReturnStatus >(_impl_.status_);
+}
+inline ::com::wazuh::api::engine::ReturnStatus Profile_Response::status() const {
+  // @@protoc_insertion_point(field_get:com.wazuh.api.engine.metrics.Profile_Response.status)
+  return _internal_status();
+}
+inline void Profile_Response::_internal_set_status(::com::wazuh::api::engine::ReturnStatus value) {
+  
+  _impl_.status_ = value;
+}
+inline void Profile_Response::set_status(::com::wazuh::api::engine::ReturnStatus value) {
+  _internal_set_status(value);
+  // @@protoc_insertion_point(field_set:com.wazuh.api.engine.metrics.Profile_Response.status)
+}
+
+// optional string error = 2;
+inline bool Profile_Response::_internal_has_error() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000001u) != 0;
+  return value;
+}
+inline bool Profile_Response::has_error() const {
+  return _internal_has_error();
+}
+inline void Profile_Response::clear_error() {
+  _impl_.error_.ClearToEmpty();
+  _impl_._has_bits_[0] &= ~0x00000001u;
+}
+inline const std::string& Profile_Response::error() const {
+  // @@protoc_insertion_point(field_get:com.wazuh.api.engine.metrics.Profile_Response.error)
+  return _internal_error();
+}
+template <typename ArgT0, typename... ArgT>
+inline PROTOBUF_ALWAYS_INLINE
+void Profile_Response::set_error(ArgT0&& arg0, ArgT... args) {
+ _impl_._has_bits_[0] |= 0x00000001u;
+ _impl_.error_.Set(static_cast<ArgT0 &&>(arg0), args..., GetArenaForAllocation());
+  // @@protoc_insertion_point(field_set:com.wazuh.api.engine.metrics.Profile_Response.error)
+}
+inline std::string* Profile_Response::mutable_error() {
+  std::string* _s = _internal_mutable_error();
+  // @@protoc_insertion_point(field_mutable:com.wazuh.api.engine.metrics.Profile_Response.error)
+  return _s;
+}
+inline const std::string& Profile_Response::_internal_error() const {
+  return _impl_.error_.Get();
+}
+inline void Profile_Response::_internal_set_error(const std::string& value) {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  _impl_.error_.Set(value, GetArenaForAllocation());
+}
+inline std::string* Profile_Response::_internal_mutable_error() {
+  _impl_._has_bits_[0] |= 0x00000001u;
+  return _impl_.error_.Mutable(GetArenaForAllocation());
+}
+inline std::string* Profile_Response::release_error() {
+  // @@protoc_insertion_point(field_release:com.wazuh.api.engine.metrics.Profile_Response.error)
+  if (!_internal_has_error()) {
+    return nullptr;
+  }
+  _impl_._has_bits_[0] &= ~0x00000001u;
+  auto* p = _impl_.error_.Release();
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.error_.IsDefault()) {
+    _impl_.error_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  return p;
+}
+inline void Profile_Response::set_allocated_error(std::string* error) {
+  if (error != nullptr) {
+    _impl_._has_bits_[0] |= 0x00000001u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000001u;
+  }
+  _impl_.error_.SetAllocated(error, GetArenaForAllocation());
+#ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  if (_impl_.error_.IsDefault()) {
+    _impl_.error_.Set("", GetArenaForAllocation());
+  }
+#endif // PROTOBUF_FORCE_COPY_DEFAULT_STRING
+  // @@protoc_insertion_point(field_set_allocated:com.wazuh.api.engine.metrics.Profile_Response.error)
+}
+
+// optional .google.protobuf.Value value = 3;
+inline bool Profile_Response::_internal_has_value() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  PROTOBUF_ASSUME(!value || _impl_.value_ != nullptr);
+  return value;
+}
+inline bool Profile_Response::has_value() const {
+  return _internal_has_value();
+}
+inline const ::PROTOBUF_NAMESPACE_ID::Value& Profile_Response::_internal_value() const {
+  const ::PROTOBUF_NAMESPACE_ID::Value* p = _impl_.value_;
+  return p != nullptr ? *p : reinterpret_cast<const ::PROTOBUF_NAMESPACE_ID::Value&>(
+      ::PROTOBUF_NAMESPACE_ID::_Value_default_instance_);
+}
+inline const ::PROTOBUF_NAMESPACE_ID::Value& Profile_Response::value() const {
+  // @@protoc_insertion_point(field_get:com.wazuh.api.engine.metrics.Profile_Response.value)
+  return _internal_value();
+}
+inline void Profile_Response::unsafe_arena_set_allocated_value(
+    ::PROTOBUF_NAMESPACE_ID::Value* value) {
+  if (GetArenaForAllocation() == nullptr) {
+    delete reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(_impl_.value_);
+  }
+  _impl_.value_ = value;
+  if (value) {
+    _impl_._has_bits_[0] |= 0x00000002u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000002u;
+  }
+  // @@protoc_insertion_point(field_unsafe_arena_set_allocated:com.wazuh.api.engine.metrics.Profile_Response.value)
+}
+inline ::PROTOBUF_NAMESPACE_ID::Value* Profile_Response::release_value() {
+  _impl_._has_bits_[0] &= ~0x00000002u;
+  ::PROTOBUF_NAMESPACE_ID::Value* temp = _impl_.value_;
+  _impl_.value_ = nullptr;
+#ifdef PROTOBUF_FORCE_COPY_IN_RELEASE
+  auto* old =  reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(temp);
+  temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  if (GetArenaForAllocation() == nullptr) { delete old; }
+#else  // PROTOBUF_FORCE_COPY_IN_RELEASE
+  if (GetArenaForAllocation() != nullptr) {
+    temp = ::PROTOBUF_NAMESPACE_ID::internal::DuplicateIfNonNull(temp);
+  }
+#endif  // !PROTOBUF_FORCE_COPY_IN_RELEASE
+  return temp;
+}
+inline ::PROTOBUF_NAMESPACE_ID::Value* Profile_Response::unsafe_arena_release_value() {
+  // @@protoc_insertion_point(field_release:com.wazuh.api.engine.metrics.Profile_Response.value)
+  _impl_._has_bits_[0] &= ~0x00000002u;
+  ::PROTOBUF_NAMESPACE_ID::Value* temp = _impl_.value_;
+  _impl_.value_ = nullptr;
+  return temp;
+}
+inline ::PROTOBUF_NAMESPACE_ID::Value* Profile_Response::_internal_mutable_value() {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  if (_impl_.value_ == nullptr) {
+    auto* p = CreateMaybeMessage<::PROTOBUF_NAMESPACE_ID::Value>(GetArenaForAllocation());
+    _impl_.value_ = p;
+  }
+  return _impl_.value_;
+}
+inline ::PROTOBUF_NAMESPACE_ID::Value* Profile_Response::mutable_value() {
+  ::PROTOBUF_NAMESPACE_ID::Value* _msg = _internal_mutable_value();
+  // @@protoc_insertion_point(field_mutable:com.wazuh.api.engine.metrics.Profile_Response.value)
+  return _msg;
+}
+inline void Profile_Response::set_allocated_value(::PROTOBUF_NAMESPACE_ID::Value* value) {
+  ::PROTOBUF_NAMESPACE_ID::Arena* message_arena = GetArenaForAllocation();
+  if (message_arena == nullptr) {
+    delete reinterpret_cast< ::PROTOBUF_NAMESPACE_ID::MessageLite*>(_impl_.value_);
+  }
+  if (value) {
+    ::PROTOBUF_NAMESPACE_ID::Arena* submessage_arena =
+        ::PROTOBUF_NAMESPACE_ID::Arena::InternalGetOwningArena(
+                reinterpret_cast<::PROTOBUF_NAMESPACE_ID::MessageLite*>(value));
+    if (message_arena != submessage_arena) {
+      value = ::PROTOBUF_NAMESPACE_ID::internal::GetOwnedMessage(
+          message_arena, value, submessage_arena);
+    }
+    _impl_._has_bits_[0] |= 0x00000002u;
+  } else {
+    _impl_._has_bits_[0] &= ~0x00000002u;
+  }
+  _impl_.value_ = value;
+  // @@protoc_insertion_point(field_set_allocated:com.wazuh.api.engine.metrics.Profile_Response.value)
+}
+
 #ifdef __GNUC__
   #pragma GCC diagnostic pop
 #endif  // __GNUC__
@@ -2993,6 +3597,10 @@ Test_Response::mutable_content() {
 
 // -------------------------------------------------------------------
 
+// -------------------------------------------------------------------
+
+// -------------------------------------------------------------------
+
 
 // @@protoc_insertion_point(namespace_scope)
 
@@ -33,7 +33,8 @@ PROTOBUF_CONSTEXPR EntryPost::EntryPost(
   , /*decltype(_impl_.policy_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
   , /*decltype(_impl_.filter_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
   , /*decltype(_impl_.description_)*/{&::_pbi::fixed_address_empty_string, ::_pbi::ConstantInitialized{}}
-  , /*decltype(_impl_.priority_)*/0u} {}
+  , /*decltype(_impl_.priority_)*/0u
+  , /*decltype(_impl_.shadow_rate_)*/0} {}
 struct EntryPostDefaultTypeInternal {
   PROTOBUF_CONSTEXPR EntryPostDefaultTypeInternal()
       : _instance(::_pbi::ConstantInitialized{}) {}
@@ -54,7 +55,8 @@ PROTOBUF_CONSTEXPR Entry::Entry(
   , /*decltype(_impl_.priority_)*/0u
   , /*decltype(_impl_.policy_sync_)*/0
   , /*decltype(_impl_.entry_status_)*/0
-  , /*decltype(_impl_.uptime_)*/0u} {}
+  , /*decltype(_impl_.uptime_)*/0u
+  , /*decltype(_impl_.shadow_rate_)*/0} {}
 struct EntryDefaultTypeInternal {
   PROTOBUF_CONSTEXPR EntryDefaultTypeInternal()
       : _instance(::_pbi::ConstantInitialized{}) {}
@@ -273,11 +275,13 @@ const uint32_t TableStruct_router_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE(p
   PROTOBUF_FIELD_OFFSET(::com::wazuh::api::engine::router::EntryPost, _impl_.filter_),
   PROTOBUF_FIELD_OFFSET(::com::wazuh::api::engine::router::EntryPost, _impl_.priority_),
   PROTOBUF_FIELD_OFFSET(::com::wazuh::api::engine::router::EntryPost, _impl_.description_),
+  PROTOBUF_FIELD_OFFSET(::com::wazuh::api::engine::router::EntryPost, _impl_.shadow_rate_),
   ~0u,
   ~0u,
   ~0u,
   ~0u,
   0,
+  1,
   PROTOBUF_FIELD_OFFSET(::com::wazuh::api::engine::router::Entry, _impl_._has_bits_),
   PROTOBUF_FIELD_OFFSET(::com::wazuh::api::engine::router::Entry, _internal_metadata_),
   ~0u,  // no _extensions_
@@ -292,6 +296,7 @@ const uint32_t TableStruct_router_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE(p
   PROTOBUF_FIELD_OFFSET(::com::wazuh::api::engine::router::Entry, _impl_.policy_sync_),
   PROTOBUF_FIELD_OFFSET(::com::wazuh::api::engine::router::Entry, _impl_.entry_status_),
   PROTOBUF_FIELD_OFFSET(::com::wazuh::api::engine::router::Entry, _impl_.uptime_),
+  PROTOBUF_FIELD_OFFSET(::com::wazuh::api::engine::router::Entry, _impl_.shadow_rate_),
   ~0u,
   ~0u,
   ~0u,
@@ -300,6 +305,7 @@ const uint32_t TableStruct_router_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE(p
   ~0u,
   ~0u,
   ~0u,
+  1,
   PROTOBUF_FIELD_OFFSET(::com::wazuh::api::engine::router::RoutePost_Request, _impl_._has_bits_),
   PROTOBUF_FIELD_OFFSET(::com::wazuh::api::engine::router::RoutePost_Request, _internal_metadata_),
   ~0u,  // no _extensions_
@@ -418,22 +424,22 @@ const uint32_t TableStruct_router_2eproto::offsets[] PROTOBUF_SECTION_VARIABLE(p
   ~0u,  // no _inlined_string_donated_
 };
 static const ::_pbi::MigrationSchema schemas[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) = {
-  { 0, 11, -1, sizeof(::com::wazuh::api::engine::router::EntryPost)},
-  { 16, 30, -1, sizeof(::com::wazuh::api::engine::router::Entry)},
-  { 38, 45, -1, sizeof(::com::wazuh::api::engine::router::RoutePost_Request)},
-  { 46, -1, -1, sizeof(::com::wazuh::api::engine::router::RouteDelete_Request)},
-  { 53, -1, -1, sizeof(::com::wazuh::api::engine::router::RouteGet_Request)},
-  { 60, 69, -1, sizeof(::com::wazuh::api::engine::router::RouteGet_Response)},
-  { 72, -1, -1, sizeof(::com::wazuh::api::engine::router::RouteReload_Request)},
-  { 79, -1, -1, sizeof(::com::wazuh::api::engine::router::RoutePatchPriority_Request)},
-  { 87, -1, -1, sizeof(::com::wazuh::api::engine::router::TableGet_Request)},
-  { 93, 102, -1, sizeof(::com::wazuh::api::engine::router::TableGet_Response)},
-  { 105, -1, -1, sizeof(::com::wazuh::api::engine::router::QueuePost_Request)},
-  { 112, -1, -1, sizeof(::com::wazuh::api::engine::router::EpsUpdate_Request)},
-  { 120, -1, -1, sizeof(::com::wazuh::api::engine::router::EpsGet_Request)},
-  { 126, 137, -1, sizeof(::com::wazuh::api::engine::router::EpsGet_Response)},
-  { 142, -1, -1, sizeof(::com::wazuh::api::engine::router::EpsEnable_Request)},
-  { 148, -1, -1, sizeof(::com::wazuh::api::engine::router::EpsDisable_Request)},
+  { 0, 12, -1, sizeof(::com::wazuh::api::engine::router::EntryPost)},
+  { 18, 33, -1, sizeof(::com::wazuh::api::engine::router::Entry)},
+  { 42, 49, -1, sizeof(::com::wazuh::api::engine::router::RoutePost_Request)},
+  { 50, -1, -1, sizeof(::com::wazuh::api::engine::router::RouteDelete_Request)},
+  { 57, -1, -1, sizeof(::com::wazuh::api::engine::router::RouteGet_Request)},
+  { 64, 73, -1, sizeof(::com::wazuh::api::engine::router::RouteGet_Response)},
+  { 76, -1, -1, sizeof(::com::wazuh::api::engine::router::RouteReload_Request)},
+  { 83, -1, -1, sizeof(::com::wazuh::api::engine::router::RoutePatchPriority_Request)},
+  { 91, -1, -1, sizeof(::com::wazuh::api::engine::router::TableGet_Request)},
+  { 97, 106, -1, sizeof(::com::wazuh::api::engine::router::TableGet_Response)},
+  { 109, -1, -1, sizeof(::com::wazuh::api::engine::router::QueuePost_Request)},
+  { 116, -1, -1, sizeof(::com::wazuh::api::engine::router::EpsUpdate_Request)},
+  { 124, -1, -1, sizeof(::com::wazuh::api::engine::router::EpsGet_Request)},
+  { 130, 141, -1, sizeof(::com::wazuh::api::engine::router::EpsGet_Response)},
+  { 146, -1, -1, sizeof(::com::wazuh::api::engine::router::EpsEnable_Request)},
+  { 152, -1, -1, sizeof(::com::wazuh::api::engine::router::EpsDisable_Request)},
 };
 
 static const ::_pb::Message* const file_default_instances[] = {
@@ -457,50 +463,52 @@ static const ::_pb::Message* const file_default_instances[] = {
 
 const char descriptor_table_protodef_router_2eproto[] PROTOBUF_SECTION_VARIABLE(protodesc_cold) =
   "\n\014router.proto\022\033com.wazuh.api.engine.rou"
-  "ter\032\014engine.proto\"u\n\tEntryPost\022\014\n\004name\030\001"
-  " \001(\t\022\016\n\006policy\030\002 \001(\t\022\016\n\006filter\030\003 \001(\t\022\020\n\010"
-  "priority\030\004 \001(\r\022\030\n\013description\030\005 \001(\tH\000\210\001\001"
-  "B\016\n\014_description\"\363\001\n\005Entry\022\014\n\004name\030\001 \001(\t"
-  "\022\016\n\006policy\030\002 \001(\t\022\016\n\006filter\030\003 \001(\t\022\020\n\010prio"
-  "rity\030\004 \001(\r\022\030\n\013description\030\005 \001(\tH\000\210\001\001\0226\n\013"
-  "policy_sync\030\006 \001(\0162!.com.wazuh.api.engine"
-  ".router.Sync\0228\n\014entry_status\030\007 \001(\0162\".com"
-  ".wazuh.api.engine.router.State\022\016\n\006uptime"
-  "\030\010 \001(\rB\016\n\014_description\"Y\n\021RoutePost_Requ"
-  "est\022:\n\005route\030\001 \001(\0132&.com.wazuh.api.engin"
-  "e.router.EntryPostH\000\210\001\001B\010\n\006_route\"#\n\023Rou"
-  "teDelete_Request\022\014\n\004name\030\001 \001(\t\" \n\020RouteG"
-  "et_Request\022\014\n\004name\030\001 \001(\t\"\247\001\n\021RouteGet_Re"
-  "sponse\0222\n\006status\030\001 \001(\0162\".com.wazuh.api.e"
-  "ngine.ReturnStatus\022\022\n\005error\030\002 \001(\tH\000\210\001\001\0226"
-  "\n\005route\030\003 \001(\0132\".com.wazuh.api.engine.rou"
-  "ter.EntryH\001\210\001\001B\010\n\006_errorB\010\n\006_route\"#\n\023Ro"
-  "uteReload_Request\022\014\n\004name\030\001 \001(\t\"<\n\032Route"
-  "PatchPriority_Request\022\014\n\004name\030\001 \001(\t\022\020\n\010p"
-  "riority\030\002 \001(\r\"\022\n\020TableGet_Request\"\230\001\n\021Ta"
-  "bleGet_Response\0222\n\006status\030\001 \001(\0162\".com.wa"
-  "zuh.api.engine.ReturnStatus\022\022\n\005error\030\002 \001"
-  "(\tH\000\210\001\001\0221\n\005table\030\003 \003(\0132\".com.wazuh.api.e"
-  "ngine.router.EntryB\010\n\006_error\"5\n\021QueuePos"
-  "t_Request\022\023\n\013wazuh_event\030\001 \001(\tJ\004\010\002\020\003R\005ev"
-  "ent\":\n\021EpsUpdate_Request\022\013\n\003eps\030\001 \001(\r\022\030\n"
-  "\020refresh_interval\030\002 \001(\r\"\020\n\016EpsGet_Reques"
-  "t\"\233\001\n\017EpsGet_Response\0222\n\006status\030\001 \001(\0162\"."
-  "com.wazuh.api.engine.ReturnStatus\022\022\n\005err"
-  "or\030\002 \001(\tH\000\210\001\001\022\013\n\003eps\030\003 \001(\r\022\030\n\020refresh_in"
-  "terval\030\004 \001(\r\022\017\n\007enabled\030\005 \001(\010B\010\n\006_error\""
-  "\023\n\021EpsEnable_Request\"\024\n\022EpsDisable_Reque"
-  "st*5\n\005State\022\021\n\rSTATE_UNKNOWN\020\000\022\014\n\010DISABL"
-  "ED\020\001\022\013\n\007ENABLED\020\002*>\n\004Sync\022\020\n\014SYNC_UNKNOW"
-  "N\020\000\022\013\n\007UPDATED\020\001\022\014\n\010OUTDATED\020\002\022\t\n\005ERROR\020"
-  "\003b\006proto3"
+  "ter\032\014engine.proto\"\237\001\n\tEntryPost\022\014\n\004name\030"
+  "\001 \001(\t\022\016\n\006policy\030\002 \001(\t\022\016\n\006filter\030\003 \001(\t\022\020\n"
+  "\010priority\030\004 \001(\r\022\030\n\013description\030\005 \001(\tH\000\210\001"
+  "\001\022\030\n\013shadow_rate\030\006 \001(\002H\001\210\001\001B\016\n\014_descript"
+  "ionB\016\n\014_shadow_rate\"\235\002\n\005Entry\022\014\n\004name\030\001 "
+  "\001(\t\022\016\n\006policy\030\002 \001(\t\022\016\n\006filter\030\003 \001(\t\022\020\n\010p"
+  "riority\030\004 \001(\r\022\030\n\013description\030\005 \001(\tH\000\210\001\001\022"
+  "6\n\013policy_sync\030\006 \001(\0162!.com.wazuh.api.eng"
+  "ine.router.Sync\0228\n\014entry_status\030\007 \001(\0162\"."
+  "com.wazuh.api.engine.router.State\022\016\n\006upt"
+  "ime\030\010 \001(\r\022\030\n\013shadow_rate\030\t \001(\002H\001\210\001\001B\016\n\014_"
+  "descriptionB\016\n\014_shadow_rate\"Y\n\021RoutePost"
+  "_Request\022:\n\005route\030\001 \001(\0132&.com.wazuh.api."
+  "engine.router.EntryPostH\000\210\001\001B\010\n\006_route\"#"
+  "\n\023RouteDelete_Request\022\014\n\004name\030\001 \001(\t\" \n\020R"
+  "outeGet_Request\022\014\n\004name\030\001 \001(\t\"\247\001\n\021RouteG"
+  "et_Response\0222\n\006status\030\001 \001(\0162\".com.wazuh."
+  "api.engine.ReturnStatus\022\022\n\005error\030\002 \001(\tH\000"
+  "\210\001\001\0226\n\005route\030\003 \001(\0132\".com.wazuh.api.engin"
+  "e.router.EntryH\001\210\001\001B\010\n\006_errorB\010\n\006_route\""
+  "#\n\023RouteReload_Request\022\014\n\004name\030\001 \001(\t\"<\n\032"
+  "RoutePatchPriority_Request\022\014\n\004name\030\001 \001(\t"
+  "\022\020\n\010priority\030\002 \001(\r\"\022\n\020TableGet_Request\"\230"
+  "\001\n\021TableGet_Response\0222\n\006status\030\001 \001(\0162\".c"
+  "om.wazuh.api.engine.ReturnStatus\022\022\n\005erro"
+  "r\030\002 \001(\tH\000\210\001\001\0221\n\005table\030\003 \003(\0132\".com.wazuh."
+  "api.engine.router.EntryB\010\n\006_error\"5\n\021Que"
+  "uePost_Request\022\023\n\013wazuh_event\030\001 \001(\tJ\004\010\002\020"
+  "\003R\005event\":\n\021EpsUpdate_Request\022\013\n\003eps\030\001 \001"
+  "(\r\022\030\n\020refresh_interval\030\002 \001(\r\"\020\n\016EpsGet_R"
+  "equest\"\233\001\n\017EpsGet_Response\0222\n\006status\030\001 \001"
+  "(\0162\".com.wazuh.api.engine.ReturnStatus\022\022"
+  "\n\005error\030\002 \001(\tH\000\210\001\001\022\013\n\003eps\030\003 \001(\r\022\030\n\020refre"
+  "sh_interval\030\004 \001(\r\022\017\n\007enabled\030\005 \001(\010B\010\n\006_e"
+  "rror\"\023\n\021EpsEnable_Request\"\024\n\022EpsDisable_"
+  "Request*5\n\005State\022\021\n\rSTATE_UNKNOWN\020\000\022\014\n\010D"
+  "ISABLED\020\001\022\013\n\007ENABLED\020\002*>\n\004Sync\022\020\n\014SYNC_U"
+  "NKNOWN\020\000\022\013\n\007UPDATED\020\001\022\014\n\010OUTDATED\020\002\022\t\n\005E"
+  "RROR\020\003b\006proto3"
   ;
 static const ::_pbi::DescriptorTable* const descriptor_table_router_2eproto_deps[1] = {
   &::descriptor_table_engine_2eproto,
 };
 static ::_pbi::once_flag descriptor_table_router_2eproto_once;
 const ::_pbi::DescriptorTable descriptor_table_router_2eproto = {
-    false, false, 1489, descriptor_table_protodef_router_2eproto,
+    false, false, 1574, descriptor_table_protodef_router_2eproto,
     "router.proto",
     &descriptor_table_router_2eproto_once, descriptor_table_router_2eproto_deps, 1, 16,
     schemas, file_default_instances, TableStruct_router_2eproto::offsets,
@@ -558,6 +566,9 @@ class EntryPost::_Internal {
   static void set_has_description(HasBits* has_bits) {
     (*has_bits)[0] |= 1u;
   }
+  static void set_has_shadow_rate(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
 };
 
 EntryPost::EntryPost(::PROTOBUF_NAMESPACE_ID::Arena* arena,
@@ -576,7 +587,8 @@ EntryPost::EntryPost(const EntryPost& from)
     , decltype(_impl_.policy_){}
     , decltype(_impl_.filter_){}
     , decltype(_impl_.description_){}
-    , decltype(_impl_.priority_){}};
+    , decltype(_impl_.priority_){}
+    , decltype(_impl_.shadow_rate_){}};
 
   _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
   _impl_.name_.InitDefault();
@@ -611,7 +623,9 @@ EntryPost::EntryPost(const EntryPost& from)
     _this->_impl_.description_.Set(from._internal_description(), 
       _this->GetArenaForAllocation());
   }
-  _this->_impl_.priority_ = from._impl_.priority_;
+  ::memcpy(&_impl_.priority_, &from._impl_.priority_,
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.shadow_rate_) -
+    reinterpret_cast<char*>(&_impl_.priority_)) + sizeof(_impl_.shadow_rate_));
   // @@protoc_insertion_point(copy_constructor:com.wazuh.api.engine.router.EntryPost)
 }
 
@@ -627,6 +641,7 @@ inline void EntryPost::SharedCtor(
     , decltype(_impl_.filter_){}
     , decltype(_impl_.description_){}
     , decltype(_impl_.priority_){0u}
+    , decltype(_impl_.shadow_rate_){0}
   };
   _impl_.name_.InitDefault();
   #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
@@ -681,6 +696,7 @@ void EntryPost::Clear() {
     _impl_.description_.ClearNonDefaultToEmpty();
   }
   _impl_.priority_ = 0u;
+  _impl_.shadow_rate_ = 0;
   _impl_._has_bits_.Clear();
   _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
 }
@@ -740,6 +756,15 @@ const char* EntryPost::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx
         } else
           goto handle_unusual;
         continue;
+      // optional float shadow_rate = 6;
+      case 6:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 53)) {
+          _Internal::set_has_shadow_rate(&has_bits);
+          _impl_.shadow_rate_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<float>(ptr);
+          ptr += sizeof(float);
+        } else
+          goto handle_unusual;
+        continue;
       default:
         goto handle_unusual;
     }  // switch
@@ -816,6 +841,12 @@ uint8_t* EntryPost::_InternalSerialize(
         5, this->_internal_description(), target);
   }
 
+  // optional float shadow_rate = 6;
+  if (_internal_has_shadow_rate()) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteFloatToArray(6, this->_internal_shadow_rate(), target);
+  }
+
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
     target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
         _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
@@ -866,6 +897,11 @@ size_t EntryPost::ByteSizeLong() const {
     total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_priority());
   }
 
+  // optional float shadow_rate = 6;
+  if (cached_has_bits & 0x00000002u) {
+    total_size += 1 + 4;
+  }
+
   return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
@@ -899,6 +935,9 @@ void EntryPost::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROT
   if (from._internal_priority() != 0) {
     _this->_internal_set_priority(from._internal_priority());
   }
+  if (from._internal_has_shadow_rate()) {
+    _this->_internal_set_shadow_rate(from._internal_shadow_rate());
+  }
   _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
@@ -935,7 +974,12 @@ void EntryPost::InternalSwap(EntryPost* other) {
       &_impl_.description_, lhs_arena,
       &other->_impl_.description_, rhs_arena
   );
-  swap(_impl_.priority_, other->_impl_.priority_);
+  ::PROTOBUF_NAMESPACE_ID::internal::memswap<
+      PROTOBUF_FIELD_OFFSET(EntryPost, _impl_.shadow_rate_)
+      + sizeof(EntryPost::_impl_.shadow_rate_)
+      - PROTOBUF_FIELD_OFFSET(EntryPost, _impl_.priority_)>(
+          reinterpret_cast<char*>(&_impl_.priority_),
+          reinterpret_cast<char*>(&other->_impl_.priority_));
 }
 
 ::PROTOBUF_NAMESPACE_ID::Metadata EntryPost::GetMetadata() const {
@@ -952,6 +996,9 @@ class Entry::_Internal {
   static void set_has_description(HasBits* has_bits) {
     (*has_bits)[0] |= 1u;
   }
+  static void set_has_shadow_rate(HasBits* has_bits) {
+    (*has_bits)[0] |= 2u;
+  }
 };
 
 Entry::Entry(::PROTOBUF_NAMESPACE_ID::Arena* arena,
@@ -973,7 +1020,8 @@ Entry::Entry(const Entry& from)
     , decltype(_impl_.priority_){}
     , decltype(_impl_.policy_sync_){}
     , decltype(_impl_.entry_status_){}
-    , decltype(_impl_.uptime_){}};
+    , decltype(_impl_.uptime_){}
+    , decltype(_impl_.shadow_rate_){}};
 
   _internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
   _impl_.name_.InitDefault();
@@ -1009,8 +1057,8 @@ Entry::Entry(const Entry& from)
       _this->GetArenaForAllocation());
   }
   ::memcpy(&_impl_.priority_, &from._impl_.priority_,
-    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.uptime_) -
-    reinterpret_cast<char*>(&_impl_.priority_)) + sizeof(_impl_.uptime_));
+    static_cast<size_t>(reinterpret_cast<char*>(&_impl_.shadow_rate_) -
+    reinterpret_cast<char*>(&_impl_.priority_)) + sizeof(_impl_.shadow_rate_));
   // @@protoc_insertion_point(copy_constructor:com.wazuh.api.engine.router.Entry)
 }
 
@@ -1029,6 +1077,7 @@ inline void Entry::SharedCtor(
     , decltype(_impl_.policy_sync_){0}
     , decltype(_impl_.entry_status_){0}
     , decltype(_impl_.uptime_){0u}
+    , decltype(_impl_.shadow_rate_){0}
   };
   _impl_.name_.InitDefault();
   #ifdef PROTOBUF_FORCE_COPY_DEFAULT_STRING
@@ -1085,6 +1134,7 @@ void Entry::Clear() {
   ::memset(&_impl_.priority_, 0, static_cast<size_t>(
       reinterpret_cast<char*>(&_impl_.uptime_) -
       reinterpret_cast<char*>(&_impl_.priority_)) + sizeof(_impl_.uptime_));
+  _impl_.shadow_rate_ = 0;
   _impl_._has_bits_.Clear();
   _internal_metadata_.Clear<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>();
 }
@@ -1170,6 +1220,15 @@ const char* Entry::_InternalParse(const char* ptr, ::_pbi::ParseContext* ctx) {
         } else
           goto handle_unusual;
         continue;
+      // optional float shadow_rate = 9;
+      case 9:
+        if (PROTOBUF_PREDICT_TRUE(static_cast<uint8_t>(tag) == 77)) {
+          _Internal::set_has_shadow_rate(&has_bits);
+          _impl_.shadow_rate_ = ::PROTOBUF_NAMESPACE_ID::internal::UnalignedLoad<float>(ptr);
+          ptr += sizeof(float);
+        } else
+          goto handle_unusual;
+        continue;
       default:
         goto handle_unusual;
     }  // switch
@@ -1266,6 +1325,12 @@ uint8_t* Entry::_InternalSerialize(
     target = ::_pbi::WireFormatLite::WriteUInt32ToArray(8, this->_internal_uptime(), target);
   }
 
+  // optional float shadow_rate = 9;
+  if (_internal_has_shadow_rate()) {
+    target = stream->EnsureSpace(target);
+    target = ::_pbi::WireFormatLite::WriteFloatToArray(9, this->_internal_shadow_rate(), target);
+  }
+
   if (PROTOBUF_PREDICT_FALSE(_internal_metadata_.have_unknown_fields())) {
     target = ::_pbi::WireFormat::InternalSerializeUnknownFieldsToArray(
         _internal_metadata_.unknown_fields<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(::PROTOBUF_NAMESPACE_ID::UnknownFieldSet::default_instance), target, stream);
@@ -1333,6 +1398,11 @@ size_t Entry::ByteSizeLong() const {
     total_size += ::_pbi::WireFormatLite::UInt32SizePlusOne(this->_internal_uptime());
   }
 
+  // optional float shadow_rate = 9;
+  if (cached_has_bits & 0x00000002u) {
+    total_size += 1 + 4;
+  }
+
   return MaybeComputeUnknownFieldsSize(total_size, &_impl_._cached_size_);
 }
 
@@ -1375,6 +1445,9 @@ void Entry::MergeImpl(::PROTOBUF_NAMESPACE_ID::Message& to_msg, const ::PROTOBUF
   if (from._internal_uptime() != 0) {
     _this->_internal_set_uptime(from._internal_uptime());
   }
+  if (from._internal_has_shadow_rate()) {
+    _this->_internal_set_shadow_rate(from._internal_shadow_rate());
+  }
   _this->_internal_metadata_.MergeFrom<::PROTOBUF_NAMESPACE_ID::UnknownFieldSet>(from._internal_metadata_);
 }
 
@@ -1412,8 +1485,8 @@ void Entry::InternalSwap(Entry* other) {
       &other->_impl_.description_, rhs_arena
   );
   ::PROTOBUF_NAMESPACE_ID::internal::memswap<
-      PROTOBUF_FIELD_OFFSET(Entry, _impl_.uptime_)
-      + sizeof(Entry::_impl_.uptime_)
+      PROTOBUF_FIELD_OFFSET(Entry, _impl_.shadow_rate_)
+      + sizeof(Entry::_impl_.shadow_rate_)
       - PROTOBUF_FIELD_OFFSET(Entry, _impl_.priority_)>(
           reinterpret_cast<char*>(&_impl_.priority_),
           reinterpret_cast<char*>(&other->_impl_.priority_));
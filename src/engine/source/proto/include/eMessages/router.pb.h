@@ -310,6 +310,7 @@ class EntryPost final :
     kFilterFieldNumber = 3,
     kDescriptionFieldNumber = 5,
     kPriorityFieldNumber = 4,
+    kShadowRateFieldNumber = 6,
   };
   // string name = 1;
   void clear_name();
@@ -380,6 +381,19 @@ class EntryPost final :
   void _internal_set_priority(uint32_t value);
   public:
 
+  // optional float shadow_rate = 6;
+  bool has_shadow_rate() const;
+  private:
+  bool _internal_has_shadow_rate() const;
+  public:
+  void clear_shadow_rate();
+  float shadow_rate() const;
+  void set_shadow_rate(float value);
+  private:
+  float _internal_shadow_rate() const;
+  void _internal_set_shadow_rate(float value);
+  public:
+
   // @@protoc_insertion_point(class_scope:com.wazuh.api.engine.router.EntryPost)
  private:
   class _Internal;
@@ -395,6 +409,7 @@ class EntryPost final :
     ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr filter_;
     ::PROTOBUF_NAMESPACE_ID::internal::ArenaStringPtr description_;
     uint32_t priority_;
+    float shadow_rate_;
   };
   union { Impl_ _impl_; };
   friend struct ::TableStruct_router_2eproto;
@@ -530,6 +545,7 @@ class Entry final :
     kPolicySyncFieldNumber = 6,
     kEntryStatusFieldNumber = 7,
     kUptimeFieldNumber = 8,
+    kShadowRateFieldNumber = 9,
   };
   // string name = 1;
   void clear_name();
@@ -627,6 +643,19 @@ class Entry final :
   void _internal_set_uptime(uint32_t value);
   public:
 
+  // optional float shadow_rate = 9;
+  bool has_shadow_rate() const;
+  private:
+  bool _internal_has_shadow_rate() const;
+  public:
+  void clear_shadow_rate();
+  float shadow_rate() const;
+  void set_shadow_rate(float value);
+  private:
+  float _internal_shadow_rate() const;
+  void _internal_set_shadow_rate(float value);
+  public:
+
   // @@protoc_insertion_point(class_scope:com.wazuh.api.engine.router.Entry)
  private:
   class _Internal;
@@ -645,6 +674,7 @@ class Entry final :
     int policy_sync_;
     int entry_status_;
     uint32_t uptime_;
+    float shadow_rate_;
   };
   union { Impl_ _impl_; };
   friend struct ::TableStruct_router_2eproto;
@@ -3043,6 +3073,34 @@ inline void EntryPost::set_allocated_description(std::string* description) {
   // @@protoc_insertion_point(field_set_allocated:com.wazuh.api.engine.router.EntryPost.description)
 }
 
+// optional float shadow_rate = 6;
+inline bool EntryPost::_internal_has_shadow_rate() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool EntryPost::has_shadow_rate() const {
+  return _internal_has_shadow_rate();
+}
+inline void EntryPost::clear_shadow_rate() {
+  _impl_.shadow_rate_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline float EntryPost::_internal_shadow_rate() const {
+  return _impl_.shadow_rate_;
+}
+inline float EntryPost::shadow_rate() const {
+  // @@protoc_insertion_point(field_get:com.wazuh.api.engine.router.EntryPost.shadow_rate)
+  return _internal_shadow_rate();
+}
+inline void EntryPost::_internal_set_shadow_rate(float value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.shadow_rate_ = value;
+}
+inline void EntryPost::set_shadow_rate(float value) {
+  _internal_set_shadow_rate(value);
+  // @@protoc_insertion_point(field_set:com.wazuh.api.engine.router.EntryPost.shadow_rate)
+}
+
 // -------------------------------------------------------------------
 
 // Entry
@@ -3345,6 +3403,34 @@ inline void Entry::set_uptime(uint32_t value) {
   // @@protoc_insertion_point(field_set:com.wazuh.api.engine.router.Entry.uptime)
 }
 
+// optional float shadow_rate = 9;
+inline bool Entry::_internal_has_shadow_rate() const {
+  bool value = (_impl_._has_bits_[0] & 0x00000002u) != 0;
+  return value;
+}
+inline bool Entry::has_shadow_rate() const {
+  return _internal_has_shadow_rate();
+}
+inline void Entry::clear_shadow_rate() {
+  _impl_.shadow_rate_ = 0;
+  _impl_._has_bits_[0] &= ~0x00000002u;
+}
+inline float Entry::_internal_shadow_rate() const {
+  return _impl_.shadow_rate_;
+}
+inline float Entry::shadow_rate() const {
+  // @@protoc_insertion_point(field_get:com.wazuh.api.engine.router.Entry.shadow_rate)
+  return _internal_shadow_rate();
+}
+inline void Entry::_internal_set_shadow_rate(float value) {
+  _impl_._has_bits_[0] |= 0x00000002u;
+  _impl_.shadow_rate_ = value;
+}
+inline void Entry::set_shadow_rate(float value) {
+  _internal_set_shadow_rate(value);
+  // @@protoc_insertion_point(field_set:com.wazuh.api.engine.router.Entry.shadow_rate)
+}
+
 // -------------------------------------------------------------------
 
 // RoutePost_Request
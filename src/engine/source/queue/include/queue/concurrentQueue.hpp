@@ -1,18 +1,21 @@
 #ifndef _QUEUE_CONCURRENTQUEUE_HPP
 #define _QUEUE_CONCURRENTQUEUE_HPP
 
-#include <cstring>
-#include <fcntl.h>
-#include <filesystem>
-#include <fstream>
-#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iterator>
 #include <memory>
-#include <mutex>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <type_traits>
+#include <vector>
 
 #include <blockingconcurrentqueue.h>
 #include <queue/iqueue.hpp>
+#include <queue/spillFile.hpp>
 
 #include <logging/logging.hpp>
 #include <metrics/iMetricsManager.hpp>
@@ -22,6 +25,8 @@ namespace base::queue
 {
 
 constexpr int64_t WAIT_DEQUEUE_TIMEOUT_USEC = 1 * 100000; ///< Timeout for the wait_dequeue_timed method
+constexpr int64_t REPLAY_INTERVAL_USEC = 10000;            ///< Sleep of the replayer while there is nothing to replay
+constexpr std::size_t REPLAY_BATCH_SIZE = 1024;            ///< Maximum number of events replayed at once
 
 // Check if T has a str method
 template<typename T, typename = std::void_t<>>
@@ -36,73 +41,6 @@ struct has_str_method<T, std::void_t<decltype(std::declval<T>()->str())>> : std:
 
 template<typename T>
 inline constexpr bool has_str_method_v = has_str_method<T>::value;
-/**
- * @brief Provides a wrapper for the flooding file
- *
- * @warning this is thread safe for the write operation
- */
-class FloodingFile
-{
-private:
-    std::ofstream m_file; ///< File stream for the flooding file
-    std::string m_error;  ///< Error message if the file is not good
-    std::mutex m_mutex;   ///< Mutex for the write operation
-
-public:
-    /**
-     * @brief Construct a new FloodingFile object
-     *
-     * The file will be opened in append mode, and the file pointer will be set at the end of the file.
-     * @param path (const std::string&) Path to the flooding file
-     */
-    explicit FloodingFile(const std::string& path)
-        : m_file(path, std::ios::out | std::ios::app | std::ios::ate)
-        , m_error {}
-        , m_mutex {}
-    {
-        if (!m_file.good())
-        {
-            m_error = strerror(errno);
-        }
-    }
-
-    /**
-     * @brief Checks if the file is open and ready to write
-     *
-     * @return std::optional<std::string> containing an error message if the file is not good
-     */
-    std::optional<std::string> getError() const
-    {
-        if (m_file.good())
-        {
-            return std::nullopt;
-        }
-        else if (m_error.empty())
-        {
-            return "Unknown error";
-        }
-        return m_error;
-    }
-
-    /**
-     * @brief Writes a message to the flooding file
-     *
-     * @param message (const std::string&) Message to write
-     *
-     * @return true if the write operation was successful, false otherwise
-     */
-    bool write(const std::string& message)
-    {
-        if (m_file.is_open())
-        {
-            std::lock_guard<std::mutex> lock {m_mutex};
-            m_file << message << std::endl;
-            return true;
-        }
-        return false;
-    }
-};
-
 /**
  * @brief A thread-safe queue that can be used to pass messages between threads.
  *
@@ -110,12 +48,17 @@ public:
  * It provides a simple interface to use the queue.
  * It also provides a way to flood the queue when it is full.
  * The queue will be flooded when the push method is called and the queue is full
- * and the pathFloodedFile is provided.
+ * and the pathFloodedFile is provided. The flooded elements are spilled to disk (see SpillFile) and, if a parser is
+ * provided, a background thread replays them into the queue once it drains below half its capacity.
  * @tparam T The type of the data to be stored in the queue.
  */
 template<typename T, typename D = moodycamel::ConcurrentQueueDefaultTraits>
 class ConcurrentQueue : public iQueue<T>
 {
+public:
+    using Parser = std::function<T(std::string_view)>;         ///< Builds an element from its spilled record
+    using Serializer = std::function<std::string(const T&)>; ///< Builds the spilled record of an element
+
 private:
     static_assert(std::is_base_of_v<moodycamel::ConcurrentQueueDefaultTraits, D>,
                   "The template parameter D must be a subclass of ConcurrentQueueDefaultTraits");
@@ -126,6 +69,9 @@ private:
         std::shared_ptr<metricsManager::iCounter<uint64_t>> m_queued;   ///< Counter for the queued events
         std::shared_ptr<metricsManager::iCounter<uint64_t>> m_flooded;  ///< Counter for the flooded events
         std::shared_ptr<metricsManager::iCounter<uint64_t>> m_consumed; ///< Counter for the consumed events
+        std::shared_ptr<metricsManager::iCounter<uint64_t>> m_replayed; ///< Counter for the replayed events
+        std::shared_ptr<metricsManager::iHistogram<uint64_t>> m_batchSize; ///< Size of the bulk dequeues
+        std::shared_ptr<metricsManager::iHistogram<double>> m_batchFill;   ///< Fill ratio of the bulk dequeues
 
         std::shared_ptr<metricsManager::IMetricsScope> m_metricsScopeDelta;       ///< Metrics scope for the queue
         std::shared_ptr<metricsManager::iCounter<uint64_t>> m_consumendPerSecond; ///< Counter for the used queue
@@ -133,14 +79,74 @@ private:
 
     moodycamel::BlockingConcurrentQueue<T, D> m_queue {}; ///< The queue itself.
 
-    std::shared_ptr<FloodingFile> m_floodingFile; ///< The flooding file.
-    std::size_t m_maxAttempts;                    ///< The maximum number of attempts to push an element to the queue.
-    std::chrono::microseconds m_waitTime;         ///< The time to wait for the queue to be not full.
+    std::shared_ptr<SpillFile> m_spillFile; ///< The spill file of the flooded elements.
+    std::size_t m_maxAttempts;              ///< The maximum number of attempts to push an element to the queue.
+    std::chrono::microseconds m_waitTime;   ///< The time to wait for the queue to be not full.
     bool m_discard; ///< If true, the queue will discard the events when it is full instead of flooding the file or
                     ///< blocking.
+    std::size_t m_capacity; ///< The capacity of the queue.
+
+    Parser m_parser;              ///< Parser of the spilled elements, no replay if null
+    Serializer m_serializer;      ///< Serializer of the spilled elements, `str()` if null
+    std::atomic_bool m_replaying; ///< The replayer is running
+    std::thread m_replayer;       ///< Thread replaying the spilled elements
 
     Metrics m_metrics; ///< Metrics for the queue
 
+    /**
+     * @brief Feed the spilled elements back into the queue while it is below half its capacity.
+     *
+     * The spilled elements that cannot be parsed are discarded, the ones read when the replayer is stopped are spilled
+     * again.
+     */
+    void replay()
+    {
+        std::vector<std::string> records;
+        while (m_replaying.load(std::memory_order_relaxed))
+        {
+            const auto size = m_queue.size_approx();
+            if (size >= m_capacity / 2 || m_spillFile->empty())
+            {
+                m_spillFile->flush();
+                std::this_thread::sleep_for(std::chrono::microseconds(REPLAY_INTERVAL_USEC));
+                continue;
+            }
+
+            records.clear();
+            m_spillFile->read(records, std::min(REPLAY_BATCH_SIZE, m_capacity - size));
+            for (std::size_t i = 0; i < records.size(); ++i)
+            {
+                T element {};
+                try
+                {
+                    element = m_parser(records[i]);
+                }
+                catch (const std::exception& e)
+                {
+                    LOG_WARNING("Discarding a spilled event that cannot be parsed: {}", e.what());
+                    continue;
+                }
+
+                while (!m_queue.try_enqueue(std::move(element)))
+                {
+                    if (!m_replaying.load(std::memory_order_relaxed))
+                    {
+                        for (; i < records.size(); ++i)
+                        {
+                            m_spillFile->write(records[i]);
+                        }
+                        return;
+                    }
+                    std::this_thread::sleep_for(m_waitTime);
+                }
+
+                m_metrics.m_queued->addValue(1UL);
+                m_metrics.m_used->addValue(1);
+                m_metrics.m_replayed->addValue(1UL);
+            }
+        }
+    }
+
     template<typename U = T>
     std::enable_if_t<has_str_method_v<U>, void> pushWithStr(U&& element)
     {
@@ -159,7 +165,7 @@ private:
             return;
         }
 
-        if (!m_floodingFile)
+        if (!m_spillFile)
         {
             while (!m_queue.try_enqueue(std::move(element))) // TODO Wait whats? Move more than once?
             {
@@ -184,7 +190,7 @@ private:
             }
             if (element != nullptr)
             {
-                m_floodingFile->write(element->str());
+                m_spillFile->write(m_serializer ? m_serializer(element) : element->str());
             }
 
             m_metrics.m_flooded->addValue(1UL);
@@ -208,6 +214,11 @@ public:
      * @param maxAttempts The maximum number of attempts to push an element to the queue. (ignored if
      * pathFloodedFile is not provided)
      * @param waitTime The time to wait for the queue to be not full. (ignored if pathFloodedFile is not provided)
+     * @param discard If true, the elements are discarded when the queue is full instead of flooded.
+     * @param parser Builds an element from its spilled record, the spilled elements are replayed into the queue if
+     * provided. (ignored if pathFloodedFile is not provided)
+     * @param serializer Builds the spilled record of an element, the record is its `str()` if not provided. (ignored
+     * if pathFloodedFile is not provided)
      *
      * @throw std::runtime_error if the capacity is less than or equal to 0
      * @throw std::runtime_error if the pathFloodedFile is provided and the maxAttempts is less than or equal to 0
@@ -221,9 +232,15 @@ public:
                              const std::string& pathFloodedFile = {},
                              const int maxAttempts = -1,
                              const int waitTime = -1,
-                             const bool discard = false)
-        : m_floodingFile {nullptr}
+                             const bool discard = false,
+                             Parser parser = nullptr,
+                             Serializer serializer = nullptr)
+        : m_spillFile {nullptr}
         , m_discard {discard}
+        , m_capacity {0}
+        , m_parser {std::move(parser)}
+        , m_serializer {std::move(serializer)}
+        , m_replaying {false}
     {
         if (capacity <= 0)
         {
@@ -231,6 +248,7 @@ public:
         }
 
         m_queue = moodycamel::BlockingConcurrentQueue<T, D>(capacity);
+        m_capacity = static_cast<std::size_t>(capacity);
 
         // Verify if the pathFloodedFile is provided
         if (!pathFloodedFile.empty())
@@ -248,15 +266,15 @@ public:
             m_waitTime = std::chrono::microseconds(waitTime);
             m_maxAttempts = maxAttempts;
 
-            m_floodingFile = std::make_shared<FloodingFile>(pathFloodedFile);
-            if (m_floodingFile->getError())
+            try
             {
-                throw std::runtime_error("Error opening the flooding file: " + m_floodingFile->getError().value());
+                m_spillFile = std::make_shared<SpillFile>(pathFloodedFile, metricsScope);
             }
-            else
+            catch (const std::exception& e)
             {
-                LOG_INFO("The queue will be flooded in the file: {}", pathFloodedFile);
+                throw std::runtime_error(std::string("Error opening the flooding file: ") + e.what());
             }
+            LOG_INFO("The queue will be flooded in the file: {}", pathFloodedFile);
         }
         else
         {
@@ -264,13 +282,40 @@ public:
         }
 
         m_metrics.m_metricsScope = std::move(metricsScope);
-        m_metrics.m_queued = m_metrics.m_metricsScope->getCounterUInteger("QueuedEvents");
-        m_metrics.m_used = m_metrics.m_metricsScope->getUpDownCounterInteger("UsedQueue");
-        m_metrics.m_consumed = m_metrics.m_metricsScope->getCounterUInteger("ConsumedEvents");
-        m_metrics.m_flooded = m_metrics.m_metricsScope->getCounterUInteger("FloodedEvents");
+        m_metrics.m_queued = m_metrics.m_metricsScope->getLocalCounterUInteger("QueuedEvents");
+        m_metrics.m_used = m_metrics.m_metricsScope->getLocalUpDownCounterInteger("UsedQueue");
+        m_metrics.m_consumed = m_metrics.m_metricsScope->getLocalCounterUInteger("ConsumedEvents");
+        m_metrics.m_flooded = m_metrics.m_metricsScope->getLocalCounterUInteger("FloodedEvents");
+        m_metrics.m_batchSize = m_metrics.m_metricsScope->getLocalHistogramUInteger("DequeueBatchSize");
+        m_metrics.m_batchFill = m_metrics.m_metricsScope->getLocalHistogramDouble("DequeueBatchFillRatio");
+
+        m_metrics.m_replayed = m_metrics.m_metricsScope->getLocalCounterUInteger("ReplayedEvents");
 
         m_metrics.m_metricsScopeDelta = std::move(metricsScopeDelta);
-        m_metrics.m_consumendPerSecond = m_metrics.m_metricsScopeDelta->getCounterUInteger("ConsumedEventsPerSecond");
+        m_metrics.m_consumendPerSecond =
+            m_metrics.m_metricsScopeDelta->getLocalCounterUInteger("ConsumedEventsPerSecond");
+
+        if (m_spillFile && m_parser)
+        {
+            m_replaying.store(true);
+            m_replayer = std::thread(&ConcurrentQueue::replay, this);
+        }
+        else if (m_spillFile)
+        {
+            LOG_INFO("No parser provided, the flooded events will not be replayed.");
+        }
+    }
+
+    /**
+     * @brief Stops the replayer, the elements still spilled are kept on disk.
+     */
+    ~ConcurrentQueue() override
+    {
+        m_replaying.store(false);
+        if (m_replayer.joinable())
+        {
+            m_replayer.join();
+        }
     }
 
     void push(T&& element) override
@@ -285,6 +330,37 @@ public:
         }
     }
 
+    /**
+     * @brief Pushes the elements to the queue with a single bulk enqueue.
+     *
+     * @param elements The elements to be pushed, they will be moved and the vector is left empty.
+     * @note If there is no room for all the elements, they are pushed one by one, waiting, flooding or discarding as
+     * the push method does.
+     * @note The metrics are updated once per call if the bulk enqueue succeeds.
+     */
+    void pushBulk(std::vector<T>& elements) override
+    {
+        if (elements.empty())
+        {
+            return;
+        }
+
+        if (m_queue.try_enqueue_bulk(std::make_move_iterator(elements.begin()), elements.size()))
+        {
+            m_metrics.m_queued->addValue(elements.size());
+            m_metrics.m_used->addValue(static_cast<int64_t>(elements.size()));
+        }
+        else
+        {
+            for (auto& element : elements)
+            {
+                push(std::move(element));
+            }
+        }
+
+        elements.clear();
+    }
+
     /**
      * @brief Pushes a new element to the queue.
      *
@@ -349,6 +425,40 @@ public:
         return result;
     }
 
+    /**
+     * @brief Pops up to max elements from the queue using a single bulk dequeue.
+     *
+     * @param elements The vector where the popped elements will be appended.
+     * @param max The maximum number of elements to pop.
+     * @param timeout The timeout in microseconds to wait for the first element.
+     * @return std::size_t The number of elements popped.
+     * @note The metrics are updated once per call, not once per element.
+     */
+    std::size_t
+    waitPopBulk(std::vector<T>& elements, std::size_t max, int64_t timeout = WAIT_DEQUEUE_TIMEOUT_USEC) override
+    {
+        if (max == 0)
+        {
+            return 0;
+        }
+
+        const auto offset = elements.size();
+        elements.resize(offset + max);
+        const auto count = m_queue.wait_dequeue_bulk_timed(elements.begin() + offset, max, timeout);
+        elements.resize(offset + count);
+
+        if (count > 0)
+        {
+            m_metrics.m_consumed->addValue(count);
+            m_metrics.m_used->addValue(-static_cast<int64_t>(count));
+            m_metrics.m_consumendPerSecond->addValue(count);
+            m_metrics.m_batchSize->recordValue(count);
+            m_metrics.m_batchFill->recordValue(static_cast<double>(count) / static_cast<double>(max));
+        }
+
+        return count;
+    }
+
     /**
      * @brief Checks if the queue is empty.
      *
@@ -0,0 +1,333 @@
+#ifndef _QUEUE_PRIORITYQUEUE_HPP
+#define _QUEUE_PRIORITYQUEUE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <queue/concurrentQueue.hpp>
+#include <queue/iqueue.hpp>
+
+namespace base::queue
+{
+
+constexpr int64_t LANE_WAIT_SLICE_USEC = 1000; ///< Time waited on a lane before checking the others again
+
+/**
+ * @brief A queue split in weighted priority lanes.
+ *
+ * Each element is pushed to the lane returned by the lane selector (e.g. from the queue of the event), and the lanes
+ * are drained with weighted fair scheduling: a lane with weight W gets W pops out of every W + (sum of the other
+ * weights), interleaved with the other lanes. The share of an empty lane is given to the lanes with elements, so a
+ * flooded lane can use all the workers while the others are idle, but cannot starve them.
+ *
+ * Each lane is a queue of its own, with its own size, metrics and flood file.
+ *
+ * @tparam T The type of the data to be stored in the queue.
+ */
+template<typename T>
+class PriorityQueue : public iQueue<T>
+{
+public:
+    using LaneSelector = std::function<std::size_t(const T&)>; ///< Returns the lane of an element
+
+    /**
+     * @brief A lane of the queue
+     */
+    struct Lane
+    {
+        std::shared_ptr<iQueue<T>> m_queue; ///< Queue of the lane
+        std::size_t m_weight;               ///< Share of the pops given to the lane
+    };
+
+private:
+    std::vector<Lane> m_lanes;         ///< The lanes
+    std::size_t m_totalWeight;         ///< Sum of the weights of the lanes
+    std::vector<std::size_t> m_slots;  ///< Interleaved schedule, each lane appears as many times as its weight
+    std::atomic<std::size_t> m_ticket; ///< Next slot of the schedule
+    LaneSelector m_selector;           ///< Lane of each element
+    std::size_t m_defaultLane;         ///< Lane of the elements with an unknown lane
+
+    /**
+     * @brief Get the lane of an element, the default lane if the selector returns an unknown lane.
+     */
+    std::size_t laneOf(const T& element) const
+    {
+        const auto lane = m_selector(element);
+        return lane < m_lanes.size() ? lane : m_defaultLane;
+    }
+
+    /**
+     * @brief Pop an element following the schedule, without waiting.
+     *
+     * The lane of the next slot is tried first, then the remaining lanes in order.
+     * @param element A reference to store the popped element.
+     * @return true if an element was popped.
+     */
+    bool popScheduled(T& element)
+    {
+        const auto first = m_slots[m_ticket.fetch_add(1, std::memory_order_relaxed) % m_slots.size()];
+        for (std::size_t i = 0; i < m_lanes.size(); ++i)
+        {
+            if (m_lanes[(first + i) % m_lanes.size()].m_queue->tryPop(element))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Pop up to max elements following the schedule, without waiting.
+     *
+     * Each lane gets its weighted share of max, starting by the lane of the next slot, and the share left by the
+     * lanes without enough elements goes to the others.
+     * @param elements The vector where the popped elements will be appended.
+     * @param max The maximum number of elements to pop.
+     * @return std::size_t The number of elements popped.
+     */
+    std::size_t popBulkScheduled(std::vector<T>& elements, std::size_t max)
+    {
+        const auto first = m_slots[m_ticket.fetch_add(1, std::memory_order_relaxed) % m_slots.size()];
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < m_lanes.size() && count < max; ++i)
+        {
+            const auto& lane = m_lanes[(first + i) % m_lanes.size()];
+            const auto share = std::max<std::size_t>(1, max * lane.m_weight / m_totalWeight);
+            count += lane.m_queue->waitPopBulk(elements, std::min(share, max - count), 0);
+        }
+        for (std::size_t i = 0; i < m_lanes.size() && count < max; ++i)
+        {
+            count += m_lanes[(first + i) % m_lanes.size()].m_queue->waitPopBulk(elements, max - count, 0);
+        }
+        return count;
+    }
+
+    /**
+     * @brief Wait until a lane may have elements or the timeout is reached.
+     *
+     * The lane of the next slot is waited on in short slices, so the elements pushed to the other lanes are not
+     * delayed by the whole timeout.
+     * @param elements The vector where the popped elements will be appended.
+     * @param max The maximum number of elements to pop.
+     * @param timeout The timeout in microseconds.
+     * @return std::size_t The number of elements popped.
+     */
+    std::size_t waitScheduled(std::vector<T>& elements, std::size_t max, int64_t timeout)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(timeout);
+        while (true)
+        {
+            if (auto count = popBulkScheduled(elements, max); count > 0)
+            {
+                return count;
+            }
+
+            const auto left = std::chrono::duration_cast<std::chrono::microseconds>(
+                                  deadline - std::chrono::steady_clock::now())
+                                  .count();
+            if (left <= 0)
+            {
+                return 0;
+            }
+
+            const auto lane = m_slots[m_ticket.load(std::memory_order_relaxed) % m_slots.size()];
+            if (auto count =
+                    m_lanes[lane].m_queue->waitPopBulk(elements, max, std::min<int64_t>(left, LANE_WAIT_SLICE_USEC));
+                count > 0)
+            {
+                return count;
+            }
+        }
+    }
+
+public:
+    /**
+     * @brief Construct a new Priority Queue object
+     *
+     * @param lanes The lanes, with their weights.
+     * @param selector Returns the lane of each element.
+     * @param defaultLane (Optional) The lane of the elements the selector returns an unknown lane for.
+     *
+     * @throw std::runtime_error if there are no lanes, a lane is null, a weight is 0, the default lane does not exist
+     * or there is no selector.
+     */
+    PriorityQueue(std::vector<Lane> lanes, LaneSelector selector, std::size_t defaultLane = 0)
+        : m_lanes(std::move(lanes))
+        , m_totalWeight(0)
+        , m_slots()
+        , m_ticket(0)
+        , m_selector(std::move(selector))
+        , m_defaultLane(defaultLane)
+    {
+        if (m_lanes.empty())
+        {
+            throw std::runtime_error("The priority queue needs at least one lane");
+        }
+
+        if (!m_selector)
+        {
+            throw std::runtime_error("The priority queue needs a lane selector");
+        }
+
+        if (m_defaultLane >= m_lanes.size())
+        {
+            throw std::runtime_error("The default lane of the priority queue does not exist");
+        }
+
+        for (const auto& lane : m_lanes)
+        {
+            if (!lane.m_queue)
+            {
+                throw std::runtime_error("The lanes of the queue cannot be null");
+            }
+            if (lane.m_weight == 0)
+            {
+                throw std::runtime_error("The weights of the lanes must be greater than 0");
+            }
+            m_totalWeight += lane.m_weight;
+        }
+
+        // Smooth weighted round robin, the slots of each lane are spread over the schedule instead of grouped
+        std::vector<int64_t> current(m_lanes.size(), 0);
+        m_slots.reserve(m_totalWeight);
+        for (std::size_t slot = 0; slot < m_totalWeight; ++slot)
+        {
+            std::size_t best = 0;
+            for (std::size_t lane = 0; lane < m_lanes.size(); ++lane)
+            {
+                current[lane] += static_cast<int64_t>(m_lanes[lane].m_weight);
+                if (current[lane] > current[best])
+                {
+                    best = lane;
+                }
+            }
+            current[best] -= static_cast<int64_t>(m_totalWeight);
+            m_slots.push_back(best);
+        }
+    }
+
+    void push(T&& element) override
+    {
+        const auto lane = laneOf(element);
+        m_lanes[lane].m_queue->push(std::move(element));
+    }
+
+    /**
+     * @brief Push the elements to their lanes, a bulk push per lane.
+     *
+     * @param elements The elements to push, they are moved and the vector is left empty.
+     */
+    void pushBulk(std::vector<T>& elements) override
+    {
+        if (m_lanes.size() == 1)
+        {
+            m_lanes.front().m_queue->pushBulk(elements);
+            return;
+        }
+
+        std::vector<std::vector<T>> byLane(m_lanes.size());
+        for (auto& element : elements)
+        {
+            const auto lane = laneOf(element);
+            byLane[lane].emplace_back(std::move(element));
+        }
+        elements.clear();
+
+        for (std::size_t lane = 0; lane < m_lanes.size(); ++lane)
+        {
+            if (!byLane[lane].empty())
+            {
+                m_lanes[lane].m_queue->pushBulk(byLane[lane]);
+            }
+        }
+    }
+
+    bool tryPush(const T& element) override { return m_lanes[laneOf(element)].m_queue->tryPush(element); }
+
+    bool waitPop(T& element, int64_t timeout = WAIT_DEQUEUE_TIMEOUT_USEC) override
+    {
+        if (popScheduled(element))
+        {
+            return true;
+        }
+
+        std::vector<T> elements {};
+        if (waitScheduled(elements, 1, timeout) == 0)
+        {
+            return false;
+        }
+        element = std::move(elements.front());
+        return true;
+    }
+
+    bool tryPop(T& element) override { return popScheduled(element); }
+
+    /**
+     * @brief Pops up to max elements, each lane gets its weighted share of them.
+     *
+     * @param elements The vector where the popped elements will be appended.
+     * @param max The maximum number of elements to pop.
+     * @param timeout The timeout in microseconds to wait for the first element.
+     * @return std::size_t The number of elements popped.
+     */
+    std::size_t
+    waitPopBulk(std::vector<T>& elements, std::size_t max, int64_t timeout = WAIT_DEQUEUE_TIMEOUT_USEC) override
+    {
+        if (max == 0)
+        {
+            return 0;
+        }
+
+        return waitScheduled(elements, max, timeout);
+    }
+
+    /**
+     * @brief Checks if all the lanes are empty.
+     *
+     * @note The size is approximate.
+     */
+    bool empty() const override
+    {
+        return std::all_of(m_lanes.begin(), m_lanes.end(), [](const auto& lane) { return lane.m_queue->empty(); });
+    }
+
+    /**
+     * @brief Gets the number of elements of all the lanes.
+     *
+     * @note The size is approximate.
+     */
+    size_t size() const override
+    {
+        size_t size = 0;
+        for (const auto& lane : m_lanes)
+        {
+            size += lane.m_queue->size();
+        }
+        return size;
+    }
+
+    /**
+     * @brief Gets the number of lanes.
+     *
+     * @return std::size_t
+     */
+    std::size_t lanes() const { return m_lanes.size(); }
+
+    /**
+     * @brief Gets the number of elements of a lane.
+     *
+     * @param lane The lane index.
+     * @note The size is approximate.
+     * @throw std::out_of_range if the lane does not exist.
+     */
+    size_t laneSize(std::size_t lane) const { return m_lanes.at(lane).m_queue->size(); }
+};
+
+} // namespace base::queue
+
+#endif // _QUEUE_PRIORITYQUEUE_HPP
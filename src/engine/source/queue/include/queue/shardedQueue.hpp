@@ -0,0 +1,299 @@
+#ifndef _QUEUE_SHARDEDQUEUE_HPP
+#define _QUEUE_SHARDEDQUEUE_HPP
+
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <queue/concurrentQueue.hpp>
+#include <queue/iqueue.hpp>
+
+#include <metrics/iMetricsScope.hpp>
+#include <utils/numaUtils.hpp>
+
+namespace base::queue
+{
+
+/**
+ * @brief A queue split in shards, one per group of CPUs (usually a NUMA node).
+ *
+ * The elements are pushed to the shard of the CPU the producer is running on, and consumed from the shard of the CPU
+ * the consumer is running on, so producers and consumers pinned to the same node do not share memory with the
+ * other nodes. A consumer only takes elements from the other shards when its own shard is empty.
+ *
+ * Each shard is a queue of its own, with its own metrics (i.e. its depth).
+ *
+ * @tparam T The type of the data to be stored in the queue.
+ */
+template<typename T>
+class ShardedQueue : public iQueue<T>
+{
+public:
+    using CurrentCpu = std::function<int()>; ///< Returns the CPU of the calling thread, -1 if unknown
+
+private:
+    std::vector<std::shared_ptr<iQueue<T>>> m_shards; ///< The shards
+    std::vector<std::size_t> m_cpuShard;              ///< Shard of each CPU
+    CurrentCpu m_currentCpu;                          ///< CPU of the calling thread
+
+    struct Metrics
+    {
+        std::shared_ptr<metricsManager::iCounter<uint64_t>> m_stolen; ///< Elements consumed from a remote shard
+    };
+    Metrics m_metrics; ///< Metrics of the sharded queue, the instruments are null if no metrics scope is provided
+
+    /**
+     * @brief Get the shard of the calling thread
+     *
+     * @return std::size_t
+     */
+    std::size_t localShard() const
+    {
+        const auto cpu = m_currentCpu();
+        if (cpu < 0 || static_cast<std::size_t>(cpu) >= m_cpuShard.size())
+        {
+            return 0;
+        }
+        return m_cpuShard[cpu];
+    }
+
+    void addStolen(std::size_t count) const
+    {
+        if (m_metrics.m_stolen && count > 0)
+        {
+            m_metrics.m_stolen->addValue(count);
+        }
+    }
+
+    /**
+     * @brief Pop an element from the first non empty remote shard, without waiting.
+     *
+     * @param element A reference to store the popped element.
+     * @param local The shard of the caller.
+     * @return true if an element was popped.
+     */
+    bool steal(T& element, std::size_t local)
+    {
+        for (std::size_t i = 1; i < m_shards.size(); ++i)
+        {
+            if (m_shards[(local + i) % m_shards.size()]->tryPop(element))
+            {
+                addStolen(1);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Pop up to max elements from the first non empty remote shard, without waiting.
+     *
+     * @param elements The vector where the popped elements will be appended.
+     * @param max The maximum number of elements to pop.
+     * @param local The shard of the caller.
+     * @return std::size_t The number of elements popped.
+     */
+    std::size_t stealBulk(std::vector<T>& elements, std::size_t max, std::size_t local)
+    {
+        for (std::size_t i = 1; i < m_shards.size(); ++i)
+        {
+            const auto count = m_shards[(local + i) % m_shards.size()]->waitPopBulk(elements, max, 0);
+            if (count > 0)
+            {
+                addStolen(count);
+                return count;
+            }
+        }
+        return 0;
+    }
+
+public:
+    /**
+     * @brief Construct a new Sharded Queue object
+     *
+     * @param shards The shards, one per group of CPUs.
+     * @param shardCpus The CPUs of each shard, the CPUs not listed use the first shard.
+     * @param metricsScope (Optional) The metrics scope for the counters of the sharded queue.
+     * @param currentCpu (Optional) Returns the CPU of the calling thread.
+     *
+     * @throw std::runtime_error if there are no shards, a shard is null or the CPUs do not match the shards.
+     */
+    ShardedQueue(std::vector<std::shared_ptr<iQueue<T>>> shards,
+                 const utils::numa::Topology& shardCpus,
+                 const std::shared_ptr<metricsManager::IMetricsScope>& metricsScope = nullptr,
+                 CurrentCpu currentCpu = utils::numa::currentCpu)
+        : m_shards(std::move(shards))
+        , m_cpuShard()
+        , m_currentCpu(std::move(currentCpu))
+        , m_metrics()
+    {
+        if (m_shards.empty())
+        {
+            throw std::runtime_error("The sharded queue needs at least one shard");
+        }
+
+        if (shardCpus.size() != m_shards.size())
+        {
+            throw std::runtime_error("The sharded queue needs the CPUs of each shard");
+        }
+
+        for (std::size_t shard = 0; shard < m_shards.size(); ++shard)
+        {
+            if (!m_shards[shard])
+            {
+                throw std::runtime_error("The shards of the queue cannot be null");
+            }
+
+            for (const auto cpu : shardCpus[shard])
+            {
+                if (cpu < 0)
+                {
+                    continue;
+                }
+                if (static_cast<std::size_t>(cpu) >= m_cpuShard.size())
+                {
+                    m_cpuShard.resize(cpu + 1, 0);
+                }
+                m_cpuShard[cpu] = shard;
+            }
+        }
+
+        if (metricsScope)
+        {
+            m_metrics.m_stolen = metricsScope->getLocalCounterUInteger("StolenEvents");
+        }
+    }
+
+    void push(T&& element) override { m_shards[localShard()]->push(std::move(element)); }
+
+    void pushBulk(std::vector<T>& elements) override { m_shards[localShard()]->pushBulk(elements); }
+
+    /**
+     * @brief Tries to push an element to the local shard, or to any other shard if it is full.
+     *
+     * @param element The element to be pushed, it will be copied.
+     * @return true if the element was pushed.
+     * @return false if all the shards are full.
+     */
+    bool tryPush(const T& element) override
+    {
+        const auto local = localShard();
+        for (std::size_t i = 0; i < m_shards.size(); ++i)
+        {
+            if (m_shards[(local + i) % m_shards.size()]->tryPush(element))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Pops an element from the local shard, or from a remote shard if the local one is empty.
+     *
+     * Only the local shard is waited on, the remote shards are checked before and after waiting.
+     * @param element The element to be popped, it will be modified.
+     * @param timeout The timeout in microseconds.
+     * @return true if the element was popped.
+     * @return false if the timeout was reached.
+     */
+    bool waitPop(T& element, int64_t timeout = WAIT_DEQUEUE_TIMEOUT_USEC) override
+    {
+        const auto local = localShard();
+        auto& shard = m_shards[local];
+        return shard->tryPop(element) || steal(element, local) || shard->waitPop(element, timeout)
+               || steal(element, local);
+    }
+
+    bool tryPop(T& element) override
+    {
+        const auto local = localShard();
+        return m_shards[local]->tryPop(element) || steal(element, local);
+    }
+
+    /**
+     * @brief Pops up to max elements from the local shard, or from a remote shard if the local one is empty.
+     *
+     * @param elements The vector where the popped elements will be appended.
+     * @param max The maximum number of elements to pop.
+     * @param timeout The timeout in microseconds to wait for the first element of the local shard.
+     * @return std::size_t The number of elements popped.
+     */
+    std::size_t
+    waitPopBulk(std::vector<T>& elements, std::size_t max, int64_t timeout = WAIT_DEQUEUE_TIMEOUT_USEC) override
+    {
+        if (max == 0)
+        {
+            return 0;
+        }
+
+        const auto local = localShard();
+        auto& shard = m_shards[local];
+        if (auto count = shard->waitPopBulk(elements, max, 0); count > 0)
+        {
+            return count;
+        }
+        if (auto count = stealBulk(elements, max, local); count > 0)
+        {
+            return count;
+        }
+        if (auto count = shard->waitPopBulk(elements, max, timeout); count > 0)
+        {
+            return count;
+        }
+        return stealBulk(elements, max, local);
+    }
+
+    /**
+     * @brief Checks if all the shards are empty.
+     *
+     * @note The size is approximate.
+     */
+    bool empty() const override
+    {
+        for (const auto& shard : m_shards)
+        {
+            if (!shard->empty())
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Gets the number of elements of all the shards.
+     *
+     * @note The size is approximate.
+     */
+    size_t size() const override
+    {
+        size_t size = 0;
+        for (const auto& shard : m_shards)
+        {
+            size += shard->size();
+        }
+        return size;
+    }
+
+    /**
+     * @brief Gets the number of shards.
+     *
+     * @return std::size_t
+     */
+    std::size_t shards() const { return m_shards.size(); }
+
+    /**
+     * @brief Gets the number of elements of a shard.
+     *
+     * @param shard The shard index.
+     * @note The size is approximate.
+     * @throw std::out_of_range if the shard does not exist.
+     */
+    size_t shardSize(std::size_t shard) const { return m_shards.at(shard)->size(); }
+};
+
+} // namespace base::queue
+
+#endif // _QUEUE_SHARDEDQUEUE_HPP
@@ -0,0 +1,132 @@
+#ifndef _QUEUE_SPILLFILE_HPP
+#define _QUEUE_SPILLFILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <metrics/iMetricsScope.hpp>
+
+namespace base::queue
+{
+
+constexpr std::size_t SPILL_SEGMENT_SIZE = 64 * 1024 * 1024; ///< Default maximum size of a segment, in bytes
+constexpr std::size_t SPILL_BATCH_SIZE = 64 * 1024;          ///< Default size of the write batches, in bytes
+
+/**
+ * @brief Append-only overflow storage for the records that do not fit in a queue.
+ *
+ * The records are stored in binary segments named `<path>.<sequence>`, each record is a header with its size and
+ * spill time followed by its data. The writes are buffered and flushed in batches, so spilling a record does not
+ * flush the file. The records are read back in order and each segment is removed once it is read, the segments
+ * left by a previous run are read before the new ones.
+ *
+ * @warning The write and flush operations are thread safe, but there must be a single reader.
+ */
+class SpillFile
+{
+private:
+    struct Metrics
+    {
+        std::shared_ptr<metricsManager::iCounter<uint64_t>> m_spilledBytes; ///< Bytes written to the segments
+        std::shared_ptr<metricsManager::iHistogram<uint64_t>> m_replayLag;  ///< Milliseconds from spill to read
+        std::shared_ptr<metricsManager::iGauge<int64_t>> m_segments;        ///< Segments on disk
+    };
+
+    std::string m_path;        ///< Path prefix of the segments
+    std::size_t m_segmentSize; ///< Size from which a new segment is started
+    std::size_t m_batchSize;   ///< Size of the buffer that triggers a flush
+
+    mutable std::mutex m_mutex;                 ///< Protects the writer and the segment table
+    std::map<uint64_t, std::size_t> m_segments; ///< Sequence -> flushed size of the segments on disk
+    uint64_t m_writeSequence;                   ///< Segment being written
+    int m_writeFd;                              ///< Descriptor of the segment being written
+    std::size_t m_writeOffset;                  ///< Bytes flushed to the segment being written
+    std::string m_buffer;                       ///< Records not flushed yet
+
+    uint64_t m_readSequence;  ///< Segment being read
+    int m_readFd;             ///< Descriptor of the segment being read, -1 if closed
+    std::size_t m_readOffset; ///< Bytes read from the segment being read
+    std::string m_readBuffer; ///< Data read from the segment and not consumed yet
+    std::size_t m_readPos;    ///< Position of the next record in the read buffer
+
+    Metrics m_metrics; ///< Metrics of the spill file, the instruments are null if no metrics scope is provided
+
+    std::string segmentPath(uint64_t sequence) const;
+    void openWriteSegment();
+    bool flushLocked();
+    void removeSegment(uint64_t sequence);
+    void updateSegments() const;
+
+public:
+    /**
+     * @brief Construct a new Spill File object
+     *
+     * @param path Path prefix of the segments, the existing segments are kept to be read.
+     * @param metricsScope (Optional) The metrics scope for the spilled bytes, the replay lag and the segments.
+     * @param segmentSize (Optional) Size from which a new segment is started.
+     * @param batchSize (Optional) Size of the buffered records that triggers a flush.
+     *
+     * @throw std::runtime_error if the sizes are 0 or the segment cannot be opened.
+     */
+    explicit SpillFile(const std::string& path,
+                       const std::shared_ptr<metricsManager::IMetricsScope>& metricsScope = nullptr,
+                       std::size_t segmentSize = SPILL_SEGMENT_SIZE,
+                       std::size_t batchSize = SPILL_BATCH_SIZE);
+
+    /**
+     * @brief Flush the buffered records and close the segments.
+     */
+    ~SpillFile();
+
+    SpillFile(const SpillFile&) = delete;
+    SpillFile& operator=(const SpillFile&) = delete;
+
+    /**
+     * @brief Append a record, it is flushed with the next batch.
+     *
+     * @param record The record.
+     * @return true if the record was stored, false if a flush failed.
+     */
+    bool write(std::string_view record);
+
+    /**
+     * @brief Flush the buffered records to the segment.
+     *
+     * @return true if the records were flushed.
+     */
+    bool flush();
+
+    /**
+     * @brief Read the oldest records, removing the segments already read.
+     *
+     * The buffered records are flushed when the reader reaches the segment being written.
+     * @param records The vector where the records will be appended.
+     * @param max The maximum number of records to read.
+     * @return std::size_t The number of records read.
+     */
+    std::size_t read(std::vector<std::string>& records, std::size_t max);
+
+    /**
+     * @brief Checks if all the records were read.
+     *
+     * @return true if there are no records to read.
+     */
+    bool empty() const;
+
+    /**
+     * @brief Get the number of segments on disk.
+     *
+     * @return std::size_t
+     */
+    std::size_t segments() const;
+};
+
+} // namespace base::queue
+
+#endif // _QUEUE_SPILLFILE_HPP
@@ -1,7 +1,9 @@
 #ifndef _QUEUE_IQUEUE_HPP
 #define _QUEUE_IQUEUE_HPP
 
-
+#include <cstddef>
+#include <cstdint>
+#include <vector>
 
 namespace base::queue
 {
@@ -30,6 +32,14 @@ public:
      */
     virtual void push(T&& element) = 0;
 
+    /**
+     * @brief Push the elements into the queue in a single operation.
+     *
+     * If the elements do not fit at once, they are pushed one by one as push does.
+     * @param elements The elements to push, they are moved and the vector is left empty.
+     */
+    virtual void pushBulk(std::vector<T>& elements) = 0;
+
     /**
      * @brief Try to push an element into the queue
      *
@@ -54,6 +64,17 @@ public:
      */
     virtual bool tryPop(T& element) = 0;
 
+    /**
+     * @brief Wait for and pop up to max elements from the queue in a single operation.
+     *
+     * The popped elements are appended to the end of elements.
+     * @param elements A reference to the vector where the popped elements will be appended.
+     * @param max The maximum number of elements to pop.
+     * @param timeout (Optional) The maximum time to wait for the first element (in microseconds).
+     * @return The number of elements popped, 0 if the timeout was reached.
+     */
+    virtual std::size_t waitPopBulk(std::vector<T>& elements, std::size_t max, int64_t timeout = 0) = 0;
+
     /**
      * @brief Check if the queue is empty.
      *
@@ -0,0 +1,418 @@
+#include <queue/spillFile.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <fmt/format.h>
+
+#include <logging/logging.hpp>
+
+namespace base::queue
+{
+
+namespace
+{
+constexpr std::size_t HEADER_SIZE = sizeof(uint32_t) + sizeof(int64_t); ///< Record size and spill time
+
+int64_t nowMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+} // namespace
+
+std::string SpillFile::segmentPath(uint64_t sequence) const
+{
+    return fmt::format("{}.{:010}", m_path, sequence);
+}
+
+void SpillFile::openWriteSegment()
+{
+    const auto path = segmentPath(m_writeSequence);
+    m_writeFd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0640);
+    m_writeOffset = 0;
+    if (m_writeFd < 0)
+    {
+        LOG_ERROR("Cannot open the spill segment '{}': {}", path, std::strerror(errno));
+        return;
+    }
+
+    m_segments[m_writeSequence] = 0;
+    updateSegments();
+}
+
+bool SpillFile::flushLocked()
+{
+    if (m_buffer.empty())
+    {
+        return true;
+    }
+
+    if (m_writeFd < 0)
+    {
+        m_buffer.clear();
+        return false;
+    }
+
+    std::size_t written = 0;
+    while (written < m_buffer.size())
+    {
+        const auto res = ::write(m_writeFd, m_buffer.data() + written, m_buffer.size() - written);
+        if (res < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            LOG_ERROR("Cannot write the spill segment '{}': {}", segmentPath(m_writeSequence), std::strerror(errno));
+            break;
+        }
+        written += static_cast<std::size_t>(res);
+    }
+
+    m_writeOffset += written;
+    m_segments[m_writeSequence] = m_writeOffset;
+    const auto flushed = written == m_buffer.size();
+    m_buffer.clear();
+
+    return flushed;
+}
+
+void SpillFile::removeSegment(uint64_t sequence)
+{
+    std::error_code ec;
+    std::filesystem::remove(segmentPath(sequence), ec);
+    if (ec)
+    {
+        LOG_WARNING("Cannot remove the spill segment '{}': {}", segmentPath(sequence), ec.message());
+    }
+    m_segments.erase(sequence);
+    updateSegments();
+}
+
+void SpillFile::updateSegments() const
+{
+    if (m_metrics.m_segments)
+    {
+        m_metrics.m_segments->setValue(static_cast<int64_t>(m_segments.size()));
+    }
+}
+
+SpillFile::SpillFile(const std::string& path,
+                     const std::shared_ptr<metricsManager::IMetricsScope>& metricsScope,
+                     std::size_t segmentSize,
+                     std::size_t batchSize)
+    : m_path(path)
+    , m_segmentSize(segmentSize)
+    , m_batchSize(batchSize)
+    , m_mutex()
+    , m_segments()
+    , m_writeSequence(0)
+    , m_writeFd(-1)
+    , m_writeOffset(0)
+    , m_buffer()
+    , m_readSequence(0)
+    , m_readFd(-1)
+    , m_readOffset(0)
+    , m_readBuffer()
+    , m_readPos(0)
+    , m_metrics()
+{
+    if (m_segmentSize == 0 || m_batchSize == 0)
+    {
+        throw std::runtime_error("The spill segment and batch sizes must be greater than 0");
+    }
+
+    if (metricsScope)
+    {
+        m_metrics.m_spilledBytes = metricsScope->getCounterUInteger("SpilledBytes");
+        m_metrics.m_replayLag = metricsScope->getHistogramUInteger("SpillReplayLagMs");
+        m_metrics.m_segments = metricsScope->getGaugeInteger("SpillSegments", 0);
+    }
+
+    // The segments left by a previous run are read first
+    const std::filesystem::path fsPath {m_path};
+    const auto prefix = fsPath.filename().string() + ".";
+    const auto dir = fsPath.has_parent_path() ? fsPath.parent_path() : std::filesystem::path {"."};
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(dir, ec))
+    {
+        const auto name = entry.path().filename().string();
+        if (name.size() <= prefix.size() || name.compare(0, prefix.size(), prefix) != 0)
+        {
+            continue;
+        }
+
+        uint64_t sequence {0};
+        const auto* begin = name.data() + prefix.size();
+        const auto* end = name.data() + name.size();
+        auto [ptr, err] = std::from_chars(begin, end, sequence);
+        if (err != std::errc() || ptr != end)
+        {
+            continue;
+        }
+
+        std::error_code sizeEc;
+        const auto size = std::filesystem::file_size(entry.path(), sizeEc);
+        if (!sizeEc)
+        {
+            m_segments.emplace(sequence, static_cast<std::size_t>(size));
+        }
+    }
+
+    if (!m_segments.empty())
+    {
+        m_readSequence = m_segments.begin()->first;
+        m_writeSequence = m_segments.rbegin()->first + 1;
+        LOG_INFO("Found {} spill segments in '{}', they will be replayed", m_segments.size(), m_path);
+    }
+
+    openWriteSegment();
+    if (m_writeFd < 0)
+    {
+        throw std::runtime_error(fmt::format("Cannot open the spill segment '{}'", segmentPath(m_writeSequence)));
+    }
+}
+
+SpillFile::~SpillFile()
+{
+    std::lock_guard lock {m_mutex};
+    flushLocked();
+
+    if (m_readFd >= 0)
+    {
+        ::close(m_readFd);
+    }
+    if (m_writeFd >= 0)
+    {
+        ::close(m_writeFd);
+    }
+
+    // Nothing left to replay in the last segment
+    const auto fullyRead = m_readSequence == m_writeSequence && m_readOffset == m_writeOffset;
+    if (m_writeOffset == 0 || fullyRead)
+    {
+        std::error_code ec;
+        std::filesystem::remove(segmentPath(m_writeSequence), ec);
+    }
+}
+
+bool SpillFile::write(std::string_view record)
+{
+    const uint32_t recordSize = static_cast<uint32_t>(record.size());
+    const auto spillTime = nowMs();
+
+    std::lock_guard lock {m_mutex};
+
+    // Start a new segment if the record does not fit in the current one
+    const auto used = m_writeOffset + m_buffer.size();
+    if (used > 0 && used + HEADER_SIZE + record.size() > m_segmentSize)
+    {
+        flushLocked();
+        if (m_writeFd >= 0)
+        {
+            ::close(m_writeFd);
+        }
+        ++m_writeSequence;
+        openWriteSegment();
+    }
+
+    if (m_writeFd < 0)
+    {
+        return false;
+    }
+
+    m_buffer.append(reinterpret_cast<const char*>(&recordSize), sizeof(recordSize));
+    m_buffer.append(reinterpret_cast<const char*>(&spillTime), sizeof(spillTime));
+    m_buffer.append(record);
+
+    if (m_metrics.m_spilledBytes)
+    {
+        m_metrics.m_spilledBytes->addValue(HEADER_SIZE + record.size());
+    }
+
+    if (m_buffer.size() >= m_batchSize)
+    {
+        return flushLocked();
+    }
+
+    return true;
+}
+
+bool SpillFile::flush()
+{
+    std::lock_guard lock {m_mutex};
+    return flushLocked();
+}
+
+std::size_t SpillFile::read(std::vector<std::string>& records, std::size_t max)
+{
+    std::size_t count = 0;
+    while (count < max)
+    {
+        // Consume the complete records already read
+        while (count < max && m_readBuffer.size() - m_readPos >= HEADER_SIZE)
+        {
+            uint32_t recordSize {0};
+            int64_t spillTime {0};
+            std::memcpy(&recordSize, m_readBuffer.data() + m_readPos, sizeof(recordSize));
+            std::memcpy(&spillTime, m_readBuffer.data() + m_readPos + sizeof(recordSize), sizeof(spillTime));
+            if (m_readBuffer.size() - m_readPos - HEADER_SIZE < recordSize)
+            {
+                break;
+            }
+
+            records.emplace_back(m_readBuffer, m_readPos + HEADER_SIZE, recordSize);
+            m_readPos += HEADER_SIZE + recordSize;
+            ++count;
+
+            if (m_metrics.m_replayLag)
+            {
+                m_metrics.m_replayLag->recordValue(static_cast<uint64_t>(std::max<int64_t>(0, nowMs() - spillTime)));
+            }
+        }
+
+        if (m_readPos == m_readBuffer.size())
+        {
+            m_readBuffer.clear();
+            m_readPos = 0;
+        }
+
+        if (count == max)
+        {
+            break;
+        }
+
+        // Get how much of the segment can be read
+        std::size_t end {0};
+        bool sealed {false};
+        {
+            std::lock_guard lock {m_mutex};
+            if (m_readSequence == m_writeSequence)
+            {
+                flushLocked();
+                end = m_writeOffset;
+            }
+            else
+            {
+                auto it = m_segments.find(m_readSequence);
+                end = it == m_segments.end() ? 0 : it->second;
+                sealed = true;
+            }
+        }
+
+        if (m_readOffset < end)
+        {
+            if (m_readFd < 0)
+            {
+                const auto path = segmentPath(m_readSequence);
+                m_readFd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+                if (m_readFd < 0)
+                {
+                    LOG_WARNING("Cannot open the spill segment '{}': {}", path, std::strerror(errno));
+                    m_readOffset = end;
+                    continue;
+                }
+            }
+
+            // Keep the partial record and append the next chunk
+            if (m_readPos > 0)
+            {
+                m_readBuffer.erase(0, m_readPos);
+                m_readPos = 0;
+            }
+            const auto chunk = std::min(end - m_readOffset, std::max(m_batchSize, HEADER_SIZE));
+            const auto offset = m_readBuffer.size();
+            m_readBuffer.resize(offset + chunk);
+            const auto res = ::pread(m_readFd, m_readBuffer.data() + offset, chunk, static_cast<off_t>(m_readOffset));
+            if (res < 0 && errno == EINTR)
+            {
+                m_readBuffer.resize(offset);
+                continue;
+            }
+            if (res <= 0)
+            {
+                LOG_WARNING(
+                    "Cannot read the spill segment '{}': {}", segmentPath(m_readSequence), std::strerror(errno));
+                m_readBuffer.resize(offset);
+                m_readOffset = end;
+                continue;
+            }
+
+            m_readBuffer.resize(offset + static_cast<std::size_t>(res));
+            m_readOffset += static_cast<std::size_t>(res);
+            continue;
+        }
+
+        if (!sealed)
+        {
+            // Caught up with the writer, start a new segment so the read one can be removed
+            std::lock_guard lock {m_mutex};
+            if (m_readSequence == m_writeSequence && m_buffer.empty() && m_readOffset == m_writeOffset
+                && m_writeOffset > 0 && m_readBuffer.empty())
+            {
+                if (m_readFd >= 0)
+                {
+                    ::close(m_readFd);
+                    m_readFd = -1;
+                }
+                if (m_writeFd >= 0)
+                {
+                    ::close(m_writeFd);
+                }
+                removeSegment(m_writeSequence);
+                ++m_writeSequence;
+                openWriteSegment();
+                m_readSequence = m_writeSequence;
+                m_readOffset = 0;
+            }
+            break;
+        }
+
+        // The segment is read, move to the next one
+        if (m_readBuffer.size() > m_readPos)
+        {
+            LOG_WARNING("Discarding a truncated record at the end of the spill segment '{}'",
+                        segmentPath(m_readSequence));
+        }
+        m_readBuffer.clear();
+        m_readPos = 0;
+        if (m_readFd >= 0)
+        {
+            ::close(m_readFd);
+            m_readFd = -1;
+        }
+        m_readOffset = 0;
+
+        std::lock_guard lock {m_mutex};
+        removeSegment(m_readSequence);
+        auto next = m_segments.upper_bound(m_readSequence);
+        m_readSequence = next == m_segments.end() ? m_writeSequence : next->first;
+    }
+
+    return count;
+}
+
+bool SpillFile::empty() const
+{
+    std::lock_guard lock {m_mutex};
+    return m_readSequence == m_writeSequence && m_readOffset == m_writeOffset && m_buffer.empty()
+           && m_readPos == m_readBuffer.size();
+}
+
+std::size_t SpillFile::segments() const
+{
+    std::lock_guard lock {m_mutex};
+    return m_segments.size();
+}
+
+} // namespace base::queue
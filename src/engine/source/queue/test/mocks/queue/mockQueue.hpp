@@ -13,9 +13,11 @@ class MockQueue : public iQueue<T>
 {
 public:
     MOCK_METHOD(void, push, (T&& element), (override));
+    MOCK_METHOD(void, pushBulk, (std::vector<T> & elements), (override));
     MOCK_METHOD(bool, tryPush, (const T& element), (override));
     MOCK_METHOD(bool, waitPop, (T& element, int64_t timeout), (override));
     MOCK_METHOD(bool, tryPop, (T& element), (override));
+    MOCK_METHOD(std::size_t, waitPopBulk, (std::vector<T> & elements, std::size_t max, int64_t timeout), (override));
     MOCK_METHOD(bool, empty, (), (const, override));
     MOCK_METHOD(size_t, size, (), (const, override));
 };
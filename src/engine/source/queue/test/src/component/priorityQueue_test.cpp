@@ -0,0 +1,170 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <queue/priorityQueue.hpp>
+
+#include "fakeMetric.hpp" // TODO Remove after implementing metrics mocks
+
+using namespace base::queue;
+
+namespace
+{
+// The queue needs elements with a ->str() method to flood them
+struct Value
+{
+    int lane;
+    int value;
+
+    Value(int l, int v)
+        : lane(l)
+        , value(v)
+    {
+    }
+
+    std::string str() const { return std::to_string(value); }
+};
+
+using Element = std::shared_ptr<Value>;
+using LaneQueue = ConcurrentQueue<Element>;
+using Queue = PriorityQueue<Element>;
+
+std::shared_ptr<LaneQueue> makeLane()
+{
+    return std::make_shared<LaneQueue>(64, std::make_shared<FakeMetricScope>(), std::make_shared<FakeMetricScope>());
+}
+
+std::size_t selectLane(const Element& element)
+{
+    return static_cast<std::size_t>(element->lane);
+}
+
+class PriorityQueueTest : public ::testing::Test
+{
+protected:
+    std::shared_ptr<Queue> m_queue;
+
+    void SetUp() override
+    {
+        logging::testInit();
+        // Lane 0 gets 3 out of every 4 pops, the unknown lanes go to lane 1
+        m_queue = std::make_shared<Queue>(std::vector<Queue::Lane> {{makeLane(), 3}, {makeLane(), 1}}, selectLane, 1);
+    }
+
+    void fill(int lane, int count)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            m_queue->push(std::make_shared<Value>(lane, i));
+        }
+    }
+};
+} // namespace
+
+TEST(PriorityQueueConstructTest, Invalid)
+{
+    auto lane = makeLane();
+
+    ASSERT_THROW(Queue({}, selectLane), std::runtime_error);
+    ASSERT_THROW(Queue({{lane, 1}}, nullptr), std::runtime_error);
+    ASSERT_THROW(Queue({{lane, 1}, {nullptr, 1}}, selectLane), std::runtime_error);
+    ASSERT_THROW(Queue({{lane, 0}}, selectLane), std::runtime_error);
+    ASSERT_THROW(Queue({{lane, 1}}, selectLane, 1), std::runtime_error);
+    ASSERT_NO_THROW(Queue({{lane, 1}}, selectLane));
+}
+
+TEST_F(PriorityQueueTest, PushToLane)
+{
+    m_queue->push(std::make_shared<Value>(0, 1));
+    ASSERT_TRUE(m_queue->tryPush(std::make_shared<Value>(1, 2)));
+    m_queue->push(std::make_shared<Value>(42, 3));
+
+    std::vector<Element> bulk {std::make_shared<Value>(0, 4), std::make_shared<Value>(1, 5)};
+    m_queue->pushBulk(bulk);
+    ASSERT_TRUE(bulk.empty());
+
+    ASSERT_EQ(m_queue->lanes(), 2);
+    ASSERT_EQ(m_queue->laneSize(0), 2);
+    ASSERT_EQ(m_queue->laneSize(1), 3);
+    ASSERT_EQ(m_queue->size(), 5);
+    ASSERT_FALSE(m_queue->empty());
+    ASSERT_THROW(m_queue->laneSize(2), std::out_of_range);
+}
+
+TEST_F(PriorityQueueTest, WeightedPop)
+{
+    fill(0, 32);
+    fill(1, 32);
+
+    std::array<int, 2> popped {0, 0};
+    for (int i = 0; i < 16; ++i)
+    {
+        Element element {};
+        ASSERT_TRUE(m_queue->tryPop(element));
+        ++popped[element->lane];
+    }
+    ASSERT_EQ(popped[0], 12);
+    ASSERT_EQ(popped[1], 4);
+}
+
+TEST_F(PriorityQueueTest, WeightedPopBulk)
+{
+    fill(0, 32);
+    fill(1, 32);
+
+    std::vector<Element> batch {};
+    ASSERT_EQ(m_queue->waitPopBulk(batch, 16, 0), 16);
+    const auto fromLane0 = std::count_if(batch.begin(), batch.end(), [](const auto& e) { return e->lane == 0; });
+    ASSERT_EQ(fromLane0, 12);
+}
+
+TEST_F(PriorityQueueTest, FloodedLaneDoesNotStarveOthers)
+{
+    // The low priority lane is flooded, the events of the high priority lane keep their share
+    fill(1, 60);
+    fill(0, 3);
+
+    std::vector<Element> batch {};
+    ASSERT_EQ(m_queue->waitPopBulk(batch, 4, 0), 4);
+    const auto fromLane0 = std::count_if(batch.begin(), batch.end(), [](const auto& e) { return e->lane == 0; });
+    ASSERT_EQ(fromLane0, 3);
+}
+
+TEST_F(PriorityQueueTest, IdleLaneShareGoesToOthers)
+{
+    fill(1, 20);
+
+    std::vector<Element> batch {};
+    ASSERT_EQ(m_queue->waitPopBulk(batch, 16, 0), 16);
+
+    Element element {};
+    ASSERT_TRUE(m_queue->waitPop(element, 0));
+    ASSERT_EQ(element->lane, 1);
+}
+
+TEST_F(PriorityQueueTest, WaitForAnyLane)
+{
+    Element element {};
+    ASSERT_FALSE(m_queue->waitPop(element, 1000));
+
+    std::thread producer(
+        [this]()
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            m_queue->push(std::make_shared<Value>(0, 1));
+            m_queue->push(std::make_shared<Value>(1, 2));
+        });
+
+    std::vector<Element> batch {};
+    while (batch.size() < 2)
+    {
+        m_queue->waitPopBulk(batch, 2, 100000);
+    }
+    producer.join();
+
+    ASSERT_TRUE(m_queue->empty());
+    ASSERT_EQ(m_queue->waitPopBulk(batch, 2, 0), 0);
+}
@@ -1,3 +1,8 @@
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include <queue/concurrentQueue.hpp>
@@ -33,29 +38,6 @@ protected:
 
     void TearDown() override {}
 };
-TEST(FloodingFileTest, CanOpenAndWriteToFile)
-{
-    std::string filename = "testfile.txt";
-    {
-        FloodingFile ff(filename);
-        ASSERT_FALSE(ff.getError().has_value());
-        ASSERT_TRUE(ff.write("This is a test message"));
-    }
-    std::ifstream testfile(filename);
-    std::string line;
-    std::getline(testfile, line);
-    ASSERT_EQ(line, "This is a test message");
-    testfile.close();
-    std::filesystem::remove(filename);
-}
-
-TEST(FloodingFileTest, CannotOpenFile)
-{
-    std::string invalid_path = "/nonexistent_dir/nonexistent_file.txt";
-    FloodingFile ff(invalid_path);
-    ASSERT_TRUE(ff.getError().has_value());
-    ASSERT_FALSE(ff.write("This should fail"));
-}
 
 TEST_F(ConcurrentQueueTest, CanConstruct)
 {
@@ -93,31 +75,94 @@ TEST_F(ConcurrentQueueTest, CanPushAndPop)
 
 TEST_F(ConcurrentQueueTest, FloodsWhenFull)
 {
-    std::string flood_file = "floodfile.txt";
-    // 32 is the size of one block in the queue, for 1 producer and 1 consumer thread
-    // the queue has 1 block, so it will flood after 32 pushes
-    ConcurrentQueue<std::shared_ptr<Dummy>> cq(
-        32, std::make_shared<FakeMetricScope>(), std::make_shared<FakeMetricScope>(), flood_file, 3, 500);
+    std::string flood_file = "floodfile";
+    {
+        // 32 is the size of one block in the queue, for 1 producer and 1 consumer thread
+        // the queue has 1 block, so it will flood after 32 pushes
+        ConcurrentQueue<std::shared_ptr<Dummy>> cq(
+            32, std::make_shared<FakeMetricScope>(), std::make_shared<FakeMetricScope>(), flood_file, 3, 500);
+
+        for (int i = 0; i < 35; i++)
+        {
+            cq.push(std::make_shared<Dummy>(i));
+        }
+
+        ASSERT_FALSE(cq.empty());
+        ASSERT_EQ(cq.size(), 32);
+    }
+
+    // Without parser the flooded events are kept in the spill file
+    SpillFile spill(flood_file);
+    std::vector<std::string> records;
+    ASSERT_EQ(spill.read(records, 10), 3);
+    ASSERT_EQ(records[0], "Dummy: 32");
+    ASSERT_EQ(records[2], "Dummy: 34");
+    ASSERT_TRUE(spill.empty());
+}
+
+TEST_F(ConcurrentQueueTest, FloodsWithSerializer)
+{
+    std::string flood_file = "floodfile_serializer";
+    {
+        ConcurrentQueue<std::shared_ptr<Dummy>> cq(32,
+                                                   std::make_shared<FakeMetricScope>(),
+                                                   std::make_shared<FakeMetricScope>(),
+                                                   flood_file,
+                                                   3,
+                                                   500,
+                                                   false,
+                                                   nullptr,
+                                                   [](const std::shared_ptr<Dummy>& dummy)
+                                                   { return std::to_string(dummy->value); });
+
+        for (int i = 0; i < 33; i++)
+        {
+            cq.push(std::make_shared<Dummy>(i));
+        }
+    }
+
+    SpillFile spill(flood_file);
+    std::vector<std::string> records;
+    ASSERT_EQ(spill.read(records, 10), 1);
+    ASSERT_EQ(records[0], "32");
+}
+
+TEST_F(ConcurrentQueueTest, ReplaysFloodedWhenDrained)
+{
+    std::string flood_file = "floodfile_replay";
+    ConcurrentQueue<std::shared_ptr<Dummy>> cq(32,
+                                               std::make_shared<FakeMetricScope>(),
+                                               std::make_shared<FakeMetricScope>(),
+                                               flood_file,
+                                               3,
+                                               500,
+                                               false,
+                                               [](std::string_view str)
+                                               {
+                                                   // "Dummy: <value>"
+                                                   return std::make_shared<Dummy>(std::stoi(std::string(str.substr(7))));
+                                               });
 
     for (int i = 0; i < 35; i++)
     {
         cq.push(std::make_shared<Dummy>(i));
     }
 
-    ASSERT_FALSE(cq.empty());
-    ASSERT_EQ(cq.size(), 32);
-
-    std::ifstream floodfile(flood_file);
-    int num_flooded = 0;
-    std::string line;
-    while (std::getline(floodfile, line))
+    // The flooded events are queued again once the queue is drained
+    std::vector<int> values;
+    auto d = std::make_shared<Dummy>(0);
+    while (values.size() < 35 && cq.waitPop(d, 1000000))
     {
-        num_flooded++;
+        values.emplace_back(d->value);
     }
 
-    ASSERT_EQ(num_flooded, 3);
-    floodfile.close();
-    std::filesystem::remove(flood_file);
+    // The replayed events may be interleaved with the queued ones
+    ASSERT_EQ(values.size(), 35);
+    std::sort(values.begin(), values.end());
+    for (int i = 0; i < 35; i++)
+    {
+        ASSERT_EQ(values[i], i);
+    }
 }
 
 TEST_F(ConcurrentQueueTest, Timeout)
@@ -128,3 +173,79 @@ TEST_F(ConcurrentQueueTest, Timeout)
     ASSERT_FALSE(cq.waitPop(d, 0));
     ASSERT_EQ(d->value, 0);
 }
+
+TEST_F(ConcurrentQueueTest, WaitPopBulk)
+{
+    ConcurrentQueue<std::shared_ptr<Dummy>> cq(
+        32, std::make_shared<FakeMetricScope>(), std::make_shared<FakeMetricScope>());
+    for (int i = 0; i < 5; i++)
+    {
+        cq.push(std::make_shared<Dummy>(i));
+    }
+
+    std::vector<std::shared_ptr<Dummy>> batch;
+    ASSERT_EQ(cq.waitPopBulk(batch, 3), 3);
+    ASSERT_EQ(batch.size(), 3);
+    ASSERT_EQ(batch[0]->value, 0);
+    ASSERT_EQ(batch[2]->value, 2);
+
+    // Elements are appended to the existing ones
+    ASSERT_EQ(cq.waitPopBulk(batch, 10), 2);
+    ASSERT_EQ(batch.size(), 5);
+    ASSERT_EQ(batch[4]->value, 4);
+    ASSERT_TRUE(cq.empty());
+}
+
+TEST_F(ConcurrentQueueTest, WaitPopBulkTimeout)
+{
+    ConcurrentQueue<std::shared_ptr<Dummy>> cq(
+        2, std::make_shared<FakeMetricScope>(), std::make_shared<FakeMetricScope>());
+    std::vector<std::shared_ptr<Dummy>> batch;
+    ASSERT_EQ(cq.waitPopBulk(batch, 8, 0), 0);
+    ASSERT_TRUE(batch.empty());
+    ASSERT_EQ(cq.waitPopBulk(batch, 0, 0), 0);
+}
+
+TEST_F(ConcurrentQueueTest, PushBulk)
+{
+    ConcurrentQueue<std::shared_ptr<Dummy>> cq(
+        32, std::make_shared<FakeMetricScope>(), std::make_shared<FakeMetricScope>());
+    std::vector<std::shared_ptr<Dummy>> elements;
+    for (int i = 0; i < 5; i++)
+    {
+        elements.emplace_back(std::make_shared<Dummy>(i));
+    }
+
+    cq.pushBulk(elements);
+    ASSERT_TRUE(elements.empty());
+    ASSERT_EQ(cq.size(), 5);
+
+    std::vector<std::shared_ptr<Dummy>> batch;
+    ASSERT_EQ(cq.waitPopBulk(batch, 5), 5);
+    ASSERT_EQ(batch[0]->value, 0);
+    ASSERT_EQ(batch[4]->value, 4);
+}
+
+TEST_F(ConcurrentQueueTest, PushBulkFloodsWhenFull)
+{
+    std::string floodFile = "testfile_bulk";
+    {
+        ConcurrentQueue<std::shared_ptr<Dummy>> cq(
+            1, std::make_shared<FakeMetricScope>(), std::make_shared<FakeMetricScope>(), floodFile, 1, 1);
+        std::vector<std::shared_ptr<Dummy>> elements;
+        for (int i = 0; i < 256; i++)
+        {
+            elements.emplace_back(std::make_shared<Dummy>(i));
+        }
+
+        // The bulk does not fit, the elements are pushed one by one and the rest are flooded
+        cq.pushBulk(elements);
+        ASSERT_TRUE(elements.empty());
+        ASSERT_FALSE(cq.empty());
+    }
+
+    SpillFile spill(floodFile);
+    std::vector<std::string> records;
+    ASSERT_GT(spill.read(records, 256), 0);
+    ASSERT_EQ(records.back(), "Dummy: 255");
+}
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include <queue/shardedQueue.hpp>
+
+#include "fakeMetric.hpp" // TODO Remove after implementing metrics mocks
+
+using namespace base::queue;
+
+namespace
+{
+// The queue needs elements with a ->str() method to flood them
+struct Value
+{
+    int value;
+
+    Value(int v)
+        : value(v)
+    {
+    }
+
+    std::string str() const { return std::to_string(value); }
+};
+
+using Element = std::shared_ptr<Value>;
+using Shard = ConcurrentQueue<Element>;
+
+class ShardedQueueTest : public ::testing::Test
+{
+protected:
+    int m_cpu {0}; ///< CPU reported for the calling thread
+    std::shared_ptr<ShardedQueue<Element>> m_queue;
+
+    void SetUp() override
+    {
+        logging::testInit();
+
+        std::vector<std::shared_ptr<iQueue<Element>>> shards {};
+        for (auto i = 0; i < 2; ++i)
+        {
+            shards.emplace_back(
+                std::make_shared<Shard>(16, std::make_shared<FakeMetricScope>(), std::make_shared<FakeMetricScope>()));
+        }
+        m_queue = std::make_shared<ShardedQueue<Element>>(
+            std::move(shards), utils::numa::Topology {{0, 1}, {2, 3}}, nullptr, [this]() { return m_cpu; });
+    }
+};
+} // namespace
+
+TEST(ShardedQueueConstructTest, Invalid)
+{
+    using Queue = ShardedQueue<Element>;
+    auto shard = std::make_shared<Shard>(16, std::make_shared<FakeMetricScope>(), std::make_shared<FakeMetricScope>());
+
+    ASSERT_THROW(Queue({}, {}), std::runtime_error);
+    ASSERT_THROW(Queue({shard}, {}), std::runtime_error);
+    ASSERT_THROW(Queue({shard, nullptr}, {{0}, {1}}), std::runtime_error);
+    ASSERT_NO_THROW(Queue({shard}, {{0}}));
+}
+
+TEST_F(ShardedQueueTest, PushToLocalShard)
+{
+    m_cpu = 3;
+    m_queue->push(std::make_shared<Value>(1));
+    ASSERT_TRUE(m_queue->tryPush(std::make_shared<Value>(2)));
+
+    ASSERT_EQ(m_queue->shards(), 2);
+    ASSERT_EQ(m_queue->shardSize(0), 0);
+    ASSERT_EQ(m_queue->shardSize(1), 2);
+    ASSERT_EQ(m_queue->size(), 2);
+    ASSERT_FALSE(m_queue->empty());
+
+    // Unknown CPUs use the first shard
+    m_cpu = 42;
+    m_queue->push(std::make_shared<Value>(3));
+    m_cpu = -1;
+    m_queue->push(std::make_shared<Value>(4));
+    ASSERT_EQ(m_queue->shardSize(0), 2);
+}
+
+TEST_F(ShardedQueueTest, PopLocalFirst)
+{
+    m_cpu = 0;
+    m_queue->push(std::make_shared<Value>(1));
+    m_cpu = 2;
+    m_queue->push(std::make_shared<Value>(2));
+
+    Element element {};
+    ASSERT_TRUE(m_queue->tryPop(element));
+    ASSERT_EQ(element->value, 2);
+    ASSERT_EQ(m_queue->shardSize(0), 1);
+}
+
+TEST_F(ShardedQueueTest, StealWhenLocalIsEmpty)
+{
+    m_cpu = 0;
+    m_queue->push(std::make_shared<Value>(1));
+    m_queue->push(std::make_shared<Value>(2));
+
+    m_cpu = 2;
+    Element element {};
+    ASSERT_TRUE(m_queue->waitPop(element, 0));
+    ASSERT_EQ(element->value, 1);
+
+    std::vector<Element> batch {};
+    ASSERT_EQ(m_queue->waitPopBulk(batch, 4, 0), 1);
+    ASSERT_EQ(batch[0]->value, 2);
+
+    ASSERT_TRUE(m_queue->empty());
+    ASSERT_FALSE(m_queue->tryPop(element));
+    ASSERT_EQ(m_queue->waitPopBulk(batch, 4, 1000), 0);
+}
@@ -0,0 +1,152 @@
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <queue/spillFile.hpp>
+
+#include "fakeMetric.hpp"
+
+using namespace base::queue;
+
+class SpillFileTest : public ::testing::Test
+{
+protected:
+    std::filesystem::path m_dir;
+
+    void SetUp() override
+    {
+        logging::testInit();
+        m_dir = std::filesystem::temp_directory_path() / "engine_spill_test";
+        std::filesystem::remove_all(m_dir);
+        std::filesystem::create_directories(m_dir);
+    }
+
+    void TearDown() override { std::filesystem::remove_all(m_dir); }
+
+    std::string path() const { return (m_dir / "spill").string(); }
+};
+
+TEST_F(SpillFileTest, InvalidSizes)
+{
+    ASSERT_THROW(SpillFile(path(), nullptr, 0, 1), std::runtime_error);
+    ASSERT_THROW(SpillFile(path(), nullptr, 1, 0), std::runtime_error);
+}
+
+TEST_F(SpillFileTest, CannotOpen)
+{
+    ASSERT_THROW(SpillFile("/nonexistent_dir/nonexistent_file", std::make_shared<FakeMetricScope>()),
+                 std::runtime_error);
+}
+
+TEST_F(SpillFileTest, WriteAndRead)
+{
+    SpillFile spill(path(), std::make_shared<FakeMetricScope>());
+    ASSERT_TRUE(spill.empty());
+
+    ASSERT_TRUE(spill.write("first"));
+    ASSERT_TRUE(spill.write(""));
+    ASSERT_TRUE(spill.write("third"));
+    ASSERT_FALSE(spill.empty());
+
+    // The buffered records are flushed when the reader reaches them
+    std::vector<std::string> records;
+    ASSERT_EQ(spill.read(records, 2), 2);
+    ASSERT_EQ(spill.read(records, 10), 1);
+    ASSERT_EQ(records, (std::vector<std::string> {"first", "", "third"}));
+    ASSERT_TRUE(spill.empty());
+    ASSERT_EQ(spill.read(records, 10), 0);
+}
+
+TEST_F(SpillFileTest, RotatesSegments)
+{
+    SpillFile spill(path(), nullptr, 64, 16);
+    for (int i = 0; i < 20; i++)
+    {
+        ASSERT_TRUE(spill.write("record " + std::to_string(i)));
+    }
+    ASSERT_GT(spill.segments(), 1);
+
+    std::vector<std::string> records;
+    ASSERT_EQ(spill.read(records, 100), 20);
+    ASSERT_EQ(records.front(), "record 0");
+    ASSERT_EQ(records.back(), "record 19");
+
+    // Only the segment being written is left
+    ASSERT_EQ(spill.segments(), 1);
+    ASSERT_TRUE(spill.empty());
+}
+
+TEST_F(SpillFileTest, RecordBiggerThanSegment)
+{
+    SpillFile spill(path(), nullptr, 16, 8);
+    const std::string big(100, 'x');
+    ASSERT_TRUE(spill.write("small"));
+    ASSERT_TRUE(spill.write(big));
+    ASSERT_TRUE(spill.write("small"));
+
+    std::vector<std::string> records;
+    ASSERT_EQ(spill.read(records, 10), 3);
+    ASSERT_EQ(records[1], big);
+}
+
+TEST_F(SpillFileTest, KeepsSegmentsAcrossInstances)
+{
+    {
+        SpillFile spill(path());
+        ASSERT_TRUE(spill.write("old 0"));
+        ASSERT_TRUE(spill.write("old 1"));
+    }
+
+    SpillFile spill(path());
+    ASSERT_FALSE(spill.empty());
+    ASSERT_TRUE(spill.write("new 0"));
+
+    std::vector<std::string> records;
+    ASSERT_EQ(spill.read(records, 10), 3);
+    ASSERT_EQ(records, (std::vector<std::string> {"old 0", "old 1", "new 0"}));
+    ASSERT_TRUE(spill.empty());
+}
+
+TEST_F(SpillFileTest, RemovesReadSegments)
+{
+    {
+        SpillFile spill(path());
+        ASSERT_TRUE(spill.write("record"));
+        std::vector<std::string> records;
+        ASSERT_EQ(spill.read(records, 10), 1);
+    }
+
+    ASSERT_TRUE(std::filesystem::is_empty(m_dir));
+}
+
+TEST_F(SpillFileTest, ConcurrentWriters)
+{
+    SpillFile spill(path(), nullptr, 4096, 256);
+
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 4; t++)
+    {
+        writers.emplace_back(
+            [&spill, t]()
+            {
+                for (int i = 0; i < 1000; i++)
+                {
+                    spill.write("writer " + std::to_string(t) + " record " + std::to_string(i));
+                }
+            });
+    }
+    for (auto& writer : writers)
+    {
+        writer.join();
+    }
+
+    std::vector<std::string> records;
+    while (spill.read(records, 512) > 0)
+    {
+    }
+    ASSERT_EQ(records.size(), 4000);
+    ASSERT_TRUE(spill.empty());
+}
@@ -1,6 +1,7 @@
 #ifndef _RBAC_PERMISSION_HPP
 #define _RBAC_PERMISSION_HPP
 
+#include <bitset>
 #include <string>
 #include <variant>
 
@@ -14,8 +15,16 @@ namespace detail
 {
 auto constexpr OP_JPATH = "/operation";
 auto constexpr RES_JPATH = "/resource";
+
+auto constexpr OPERATIONS_COUNT = static_cast<std::size_t>(Operation::WRITE) + 1;
+auto constexpr RESOURCES_COUNT = static_cast<std::size_t>(Resource::ASSET) + 1;
 } // namespace detail
 
+/**
+ * @brief Set of permissions, with a bit per permission (see Permission::index()).
+ */
+using PermissionSet = std::bitset<detail::RESOURCES_COUNT * detail::OPERATIONS_COUNT>;
+
 class Permission
 {
 private:
@@ -38,6 +47,14 @@ public:
 
     const Operation& getOperation() const { return m_operation; }
 
+    /**
+     * @brief Index of the permission in a PermissionSet.
+     */
+    std::size_t index() const
+    {
+        return static_cast<std::size_t>(m_resource) * detail::OPERATIONS_COUNT + static_cast<std::size_t>(m_operation);
+    }
+
     std::string getName() const { return std::string(resToStr(m_resource)) + "." + std::string(opToStr(m_operation)); }
 
     friend inline bool operator==(const Permission& lhs, const Permission& rhs)
@@ -2,8 +2,10 @@
 #define _RBAC_RBAC_HPP
 
 #include <map>
+#include <memory>
 #include <optional>
 #include <stdexcept>
+#include <unordered_map>
 
 #include <fmt/format.h>
 
@@ -33,6 +35,12 @@ private:
     std::map<std::string, Role> m_roles;
     // std::unordered_map<std::string, Subject> m_subjects;
 
+    /**
+     * @brief Permissions of each role, resolved once the model is loaded and shared by all the authorization
+     * functions.
+     */
+    std::shared_ptr<const std::unordered_map<std::string, PermissionSet>> m_rolePermissions;
+
     std::weak_ptr<store::IStoreInternal> m_store;
 
     base::OptError loadModel()
@@ -112,6 +120,16 @@ private:
         m_roles[defaultModel::ROLE_SYSTEM] = Role(defaultModel::ROLE_SYSTEM, permissions);
     }
 
+    void compilePermissions()
+    {
+        auto rolePermissions = std::make_shared<std::unordered_map<std::string, PermissionSet>>();
+        for (const auto& [roleName, role] : m_roles)
+        {
+            rolePermissions->emplace(roleName, role.getPermissionSet());
+        }
+        m_rolePermissions = std::move(rolePermissions);
+    }
+
 public:
     RBAC(std::weak_ptr<store::IStoreInternal> store)
         : m_store(store)
@@ -128,26 +146,23 @@ public:
                 LOG_WARNING("Could not save RBAC model: {}", saveError->message);
             }
         }
+
+        compilePermissions();
     }
 
     AuthFn getAuthFn(Resource res, Operation op) const override
     {
-        auto permission = Permission(res, op);
+        auto permissionIndex = Permission(res, op).index();
 
-        return [permission, roles = m_roles](const std::string& roleName)
+        return [permissionIndex, rolePermissions = m_rolePermissions](const std::string& roleName)
         {
-            auto role = roles.find(roleName);
-            if (role == roles.end())
-            {
-                return false;
-            }
-
-            if (role->second.getPermissions().find(permission) == role->second.getPermissions().end())
+            auto role = rolePermissions->find(roleName);
+            if (role == rolePermissions->end())
             {
                 return false;
             }
 
-            return true;
+            return role->second.test(permissionIndex);
         };
     }
 
@@ -35,6 +35,19 @@ public:
 
     const std::set<Permission>& getPermissions() const { return m_permissions; }
 
+    /**
+     * @brief Get the permissions of the role as a set of bits, to check them without lookups.
+     */
+    PermissionSet getPermissionSet() const
+    {
+        PermissionSet permissionSet;
+        for (const auto& permission : m_permissions)
+        {
+            permissionSet.set(permission.index());
+        }
+        return permissionSet;
+    }
+
     friend inline bool operator==(const Role& lhs, const Role& rhs)
     {
         return lhs.m_name == rhs.m_name && lhs.m_permissions == rhs.m_permissions;
@@ -186,4 +186,22 @@ INSTANTIATE_TEST_SUITE_P(RBAC,
                                            AuthInput {false, BAD_ROLE, BAD_RESOURCE, OK_OPERATION},
                                            AuthInput {false, BAD_ROLE, OK_RESOURCE, BAD_OPERATION},
                                            AuthInput {false, OK_ROLE, BAD_RESOURCE, BAD_OPERATION},
-                                           AuthInput {false, BAD_ROLE, BAD_RESOURCE, BAD_OPERATION}));
+                                           AuthInput {false, BAD_ROLE, BAD_RESOURCE, BAD_OPERATION},
+                                           AuthInput {true, "role2", Resource::ASSET, Operation::WRITE},
+                                           AuthInput {false, "role2", Resource::SYSTEM_ASSET, Operation::READ},
+                                           AuthInput {true, "role3", Resource::SYSTEM_ASSET, Operation::WRITE},
+                                           AuthInput {false, "role3", Resource::UNKNOWN, Operation::READ},
+                                           AuthInput {false, "", OK_RESOURCE, OK_OPERATION}));
+
+TEST_F(RBACTest, AuthFnOutlivesRBAC)
+{
+    EXPECT_CALL(*mockStore, readInternalDoc(testing::Eq(base::Name {detail::MODEL_NAME})))
+        .WillOnce(::testing::Return(storeReadDocResp(MODEL_JSON)));
+
+    auto rbac = std::make_shared<RBAC>(mockStore);
+    auto authFn = rbac->getAuthFn(OK_RESOURCE, OK_OPERATION);
+    rbac.reset();
+
+    EXPECT_TRUE(authFn(OK_ROLE));
+    EXPECT_FALSE(authFn(BAD_ROLE));
+}
@@ -4,9 +4,12 @@
 #include <list>
 #include <memory>
 #include <shared_mutex>
+#include <string>
+#include <vector>
 
 #include <bk/icontroller.hpp>
 #include <builder/ibuilder.hpp>
+#include <metrics/iMetricsScope.hpp>
 #include <parseEvent.hpp>
 #include <queue/iqueue.hpp>
 #include <store/istore.hpp>
@@ -24,6 +27,7 @@ using TestQueueType = base::queue::iQueue<test::QueueType>;
 class IWorker;
 class EnvironmentBuilder;
 class EntryConverter;
+class EventPool;
 
 // Change name to syncronizer
 class Orchestrator
@@ -47,12 +51,15 @@ protected:
     std::shared_ptr<ProdQueueType> m_eventQueue;      ///< The event queue
     std::shared_ptr<TestQueueType> m_testQueue;       ///< The test queue
     std::shared_ptr<EnvironmentBuilder> m_envBuilder; ///< The environment builder
+    std::shared_ptr<EventPool> m_eventPool;           ///< Pool of recycled production events
 
     // Configuration options
     std::weak_ptr<store::IStoreInternal> m_wStore; ///< Read and store configurations
     base::Name m_storeTesterName;                  ///< Path of internal configuration state for testers
     base::Name m_storeRouterName;                  ///< Path of internal configuration state for routers
     std::size_t m_testTimeout;                     ///< Timeout for the tests
+    std::size_t m_batchSize;                       ///< Events dequeued at once by each worker
+    std::shared_ptr<metricsManager::IMetricsScope> m_metricsScope; ///< Metrics scope for the workers (optional)
 
     using WorkerOp = std::function<base::OptError(const std::shared_ptr<IWorker>&)>;
     base::OptError forEachWorker(const WorkerOp& f); ///< Apply the function f to each worker
@@ -98,6 +105,12 @@ public:
 
         int m_testTimeout; ///< Timeout for handlers of testers
 
+        int m_batchSize {1}; ///< Maximum events dequeued and routed at once by each worker (1 = no batching)
+
+        bool m_pinWorkers {false}; ///< Pin each worker to a CPU, spreading the workers over the NUMA nodes
+
+        std::shared_ptr<metricsManager::IMetricsScope> m_metricsScope {}; ///< Metrics scope for routing (optional)
+
         void validate() const; ///< Validate the configuration options if is invalid throw an  std::runtime_error
     };
 
@@ -120,19 +133,15 @@ public:
      *
      * @param eventStr The event to push
      */
-    void pushEvent(const std::string& eventStr)
-    {
-        base::Event event;
-        try
-        {
-            event = base::parseEvent::parseWazuhEvent(eventStr);
-            m_eventQueue->push(std::move(event));
-        }
-        catch (const std::exception& e)
-        {
-            LOG_WARNING("Error parsing event: '{}' (discarding...)", e.what());
-        }
-    }
+    void pushEvent(const std::string& eventStr);
+
+    /**
+     * @brief Parse a batch of events and push them to the event queue at once
+     *
+     * The events that cannot be parsed are discarded.
+     * @param eventsStr The events to push
+     */
+    void pushEvents(const std::vector<std::string>& eventsStr);
 
     /**************************************************************************
      * IRouterAPI
@@ -51,6 +51,7 @@ private:
     base::Name m_filter;                      ///< Filter of the environment
     std::size_t m_priority;                   ///< Priority of the environment
     std::optional<std::string> m_description; ///< Description of the environment
+    float m_shadowRate;                       ///< Fraction of the events cloned into a shadow entry, 0 if routed
 
     static constexpr std::size_t MAX_PRIORITY = 1000; ///< Max priority of the environment
 
@@ -71,6 +72,7 @@ public:
         , m_description {}
         , m_filter {std::move(filter)}
         , m_priority {priority}
+        , m_shadowRate {0}
     {
     }
 
@@ -101,6 +103,10 @@ public:
         {
             return base::Error {"Priority cannot be greater than 1000"};
         }
+        if (!(m_shadowRate >= 0 && m_shadowRate <= 1))
+        {
+            return base::Error {"Shadow rate must be between 0 and 1"};
+        }
         return base::OptError {};
     }
 
@@ -117,6 +123,14 @@ public:
     std::size_t priority() const { return m_priority; }
     void priority(std::size_t priority) { m_priority = priority; }
 
+    /**
+     * @brief A shadow entry does not take part in the routing, it gets a clone of a fraction of the events and its
+     * results are discarded. Changing its priority promotes it to a regular entry.
+     */
+    bool isShadow() const { return m_shadowRate > 0; }
+    float shadowRate() const { return m_shadowRate; }
+    void shadowRate(float shadowRate) { m_shadowRate = shadowRate; }
+
     static std::size_t maxPriority() { return MAX_PRIORITY; }
 };
 
@@ -20,6 +20,7 @@ EntryConverter::EntryConverter(const prod::Entry& entry)
     , m_description {entry.description()}
     , m_filter {entry.filter()}
     , m_priority {entry.priority()}
+    , m_shadowRate {entry.isShadow() ? std::optional<double> {entry.shadowRate()} : std::nullopt}
 {
 }
 
@@ -39,6 +40,7 @@ EntryConverter::EntryConverter(const json::Json& jEntry)
     m_lastUse = jEntry.getInt64(LAST_USE_PATH);
     m_filter = jEntry.getString(FILTER_PATH);
     m_priority = jEntry.getInt64(PRIORITY_PATH);
+    m_shadowRate = jEntry.getNumberAsDouble(SHADOW_RATE_PATH);
 }
 
 const std::string& EntryConverter::name() const
@@ -94,6 +96,11 @@ EntryConverter::operator json::Json() const
         jEntry.setInt64(static_cast<int64_t>(m_priority.value()), PRIORITY_PATH);
     }
 
+    if (m_shadowRate)
+    {
+        jEntry.setDouble(m_shadowRate.value(), SHADOW_RATE_PATH);
+    }
+
     return jEntry;
 }
 
@@ -127,6 +134,10 @@ EntryConverter::operator prod::EntryPost() const
     {
         entryPost.description(m_description.value());
     }
+    if (m_shadowRate)
+    {
+        entryPost.shadowRate(static_cast<float>(m_shadowRate.value()));
+    }
 
     return entryPost;
 }
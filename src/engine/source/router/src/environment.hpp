@@ -8,6 +8,8 @@
 
 #include <router/types.hpp>
 
+#include "filterProgram.hpp"
+
 namespace router
 {
 
@@ -16,6 +18,7 @@ class Environment
 
 private:
     base::Expression m_filter;                     ///< Filter of the route
+    internal::FilterProgram m_program;             ///< Filter compiled to read-only operations
     std::shared_ptr<bk::IController> m_controller; ///< Controller of the policy
     std::string m_hash;                            ///< Hash of the current policy (controller)
 
@@ -40,6 +43,7 @@ public:
      */
     Environment(base::Expression&& filter, std::shared_ptr<bk::IController>&& controller, std::string&& hash)
         : m_filter {filter}
+        , m_program {m_filter}
         , m_controller {controller}
         , m_hash {hash}
     {
@@ -54,6 +58,8 @@ public:
     /**
      * @brief Check if an event should be accepted by the environment (if the filter is true)
      *
+     * The filter is evaluated in place, the event is neither copied nor modified.
+     *
      * @param event Event to check
      * @return true
      * @return false
@@ -80,7 +86,17 @@ public:
      *
      * @param filter
      */
-    void setFilter(base::Expression&& filter) { m_filter = std::move(filter); }
+    void setFilter(base::Expression&& filter)
+    {
+        m_program = internal::FilterProgram(filter);
+        m_filter = std::move(filter);
+    }
+
+    /**
+     * @brief Get the filter of the environment
+     *
+     */
+    const base::Expression& filter() const { return m_filter; }
 
     /**
      * @brief Set the Controller object
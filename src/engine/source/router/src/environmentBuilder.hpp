@@ -73,12 +73,13 @@ public:
      * @brief Get the Controller object for a given policy.
      *
      * @param policyName The name of the policy.
-     * @param builder The builder used to construct the policy.
+     * @param cache (Optional) The assets compiled by the previous builds of the caller.
      * @return std::shared_ptr<bk::IController> The constructed controller.
      * @throws std::runtime_error if the policy has no assets or if the backend cannot be built. // TODO Move to
      * base::Error
      */
-    auto makeController(const base::Name& policyName) -> std::pair<std::shared_ptr<bk::IController>, std::string>
+    auto makeController(const base::Name& policyName, const std::shared_ptr<builder::AssetCache>& cache = nullptr)
+        -> std::pair<std::shared_ptr<bk::IController>, std::string>
     {
         if (policyName.parts().size() == 0 || policyName.parts()[0] != "policy")
         {
@@ -91,7 +92,7 @@ public:
             throw std::runtime_error {"The builder is not available"};
         }
 
-        auto policy = builder->buildPolicy(policyName);
+        auto policy = cache ? builder->buildPolicy(policyName, cache) : builder->buildPolicy(policyName);
         if (policy->assets().empty())
         {
             throw std::runtime_error {fmt::format("Policy '{}' has no assets", policyName)};
@@ -112,16 +113,19 @@ public:
      *
      * @param policyName The name of the policy.
      * @param filterName The name of the filter.
+     * @param cache (Optional) The assets compiled by the previous builds of the caller.
      * @return Environment The created environment.
      * @throws std::runtime_error if failed to create the environment. // TODO CHange to base::Error
      */
-    std::unique_ptr<Environment> create(const base::Name& policyName, const base::Name& filterName)
+    std::unique_ptr<Environment> create(const base::Name& policyName,
+                                        const base::Name& filterName,
+                                        const std::shared_ptr<builder::AssetCache>& cache = nullptr)
     {
         std::shared_ptr<bk::IController> controller = nullptr;
         try
         {
             std::string hash {};
-            std::tie(controller, hash) = makeController(policyName);
+            std::tie(controller, hash) = makeController(policyName, cache);
             auto expression = getExpression(filterName);
             return std::make_unique<Environment>(std::move(expression), std::move(controller), std::move(hash));
         }
@@ -1,8 +1,10 @@
 #ifndef _ROUTER_EPS_COUNTER_HPP
 #define _ROUTER_EPS_COUNTER_HPP
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <thread>
 
 namespace router
 {
@@ -11,18 +13,22 @@ constexpr auto DEFAULT_INTERVAL = 10;
 constexpr auto DEFAULT_STATE = false;
 
 /**
- * @brief Class to count events per second and reset the counter after a given interval
+ * @brief Token bucket that limits the events processed per interval
  *
+ * The bucket is refilled with `eps * interval` credits at the start of each interval, the credits not used in an
+ * interval are lost. The workers take the credits in blocks, so the shared state is only touched once per block
+ * instead of once per event, and the workers that find the bucket empty sleep until the next refill.
  */
 class Orchestrator::EpsCounter
 {
 private:
-    std::atomic_uint m_count;     ///< Counter for the number of events
-    std::atomic_bool m_canReset;  ///< Flag to ensure only one thread resets the counter
-    std::atomic_uint m_limit;     ///< Limit for the number of events per interval
-    std::atomic_ulong m_interval; ///< Interval windows size in nanoseconds
-    std::chrono::time_point<std::chrono::steady_clock> m_lastReset; ///< Last time the counter was reset
-    std::atomic_bool active;                                        ///< Flag to indicate if the counter is active
+    using Clock = std::chrono::steady_clock;
+
+    std::atomic_int64_t m_available;  ///< Credits left in the current interval
+    std::atomic_int64_t m_nextRefill; ///< Time of the next refill, in nanoseconds since the clock epoch
+    std::atomic_uint m_limit;         ///< Limit for the number of events per interval
+    std::atomic_ulong m_interval;     ///< Interval windows size in nanoseconds
+    std::atomic_bool active;          ///< Flag to indicate if the counter is active
 
     void checkSettings(uint eps, uint intervalSec)
     {
@@ -37,13 +43,38 @@ private:
         }
     }
 
+    static int64_t now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+    }
+
+    /**
+     * @brief Refill the bucket if the current interval is over
+     *
+     * Only the thread that moves the refill time forward refills the bucket.
+     */
+    void refill()
+    {
+        const auto current = now();
+        auto next = m_nextRefill.load(std::memory_order_acquire);
+        if (current < next)
+        {
+            return;
+        }
+
+        const auto interval = static_cast<int64_t>(m_interval.load(std::memory_order_relaxed));
+        if (m_nextRefill.compare_exchange_strong(next, current + interval, std::memory_order_acq_rel))
+        {
+            m_available.store(m_limit.load(std::memory_order_relaxed), std::memory_order_release);
+        }
+    }
+
 public:
     EpsCounter()
-        : m_count(0)
-        , m_canReset(true)
+        : m_available(DEFAULT_EPS * DEFAULT_INTERVAL)
+        , m_nextRefill(now() + static_cast<int64_t>(1e9 * DEFAULT_INTERVAL))
         , m_limit(DEFAULT_EPS * DEFAULT_INTERVAL)
         , m_interval(1e9 * DEFAULT_INTERVAL)
-        , m_lastReset(std::chrono::steady_clock::now())
         , active(DEFAULT_STATE)
     {
     }
@@ -55,46 +86,54 @@ public:
      * @param intervalSec Interval window size in seconds
      */
     EpsCounter(uint eps, uint intervalSec, bool state)
-        : m_count(0)
-        , m_lastReset(std::chrono::steady_clock::now())
-        , m_canReset(true)
+        : m_available(0)
+        , m_nextRefill(0)
+        , m_limit(0)
+        , m_interval(0)
         , active(state)
     {
         checkSettings(eps, intervalSec);
         m_limit.store(eps * intervalSec, std::memory_order_relaxed);
         m_interval.store(1e9 * intervalSec, std::memory_order_relaxed);
+        m_available.store(eps * intervalSec, std::memory_order_relaxed);
+        m_nextRefill.store(now() + static_cast<int64_t>(1e9 * intervalSec), std::memory_order_relaxed);
     }
 
-    bool limitReached()
+    /**
+     * @brief Take up to `wanted` credits from the bucket
+     *
+     * @param wanted The number of events the caller wants to process
+     * @return std::size_t The credits granted, 0 if the bucket is empty until the next refill
+     */
+    std::size_t acquire(std::size_t wanted)
     {
-        // Preemptively check the limit, only then check and reset the counter
-        auto current = m_count.fetch_add(1, std::memory_order_relaxed);
-        if (++current <= m_limit.load(std::memory_order_relaxed))
-        {
-            return false;
-        }
-
-        auto now = std::chrono::steady_clock::now();
-        auto especulativeElapsedTime = std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_lastReset).count();
+        refill();
 
-        if (especulativeElapsedTime >= m_interval.load(std::memory_order_relaxed))
+        auto available = m_available.load(std::memory_order_relaxed);
+        while (available > 0)
         {
-            // Ensure only one thread resets the counter
-            bool expected = true;
-            if (m_canReset.compare_exchange_strong(expected, false, std::memory_order_acquire))
+            const auto granted = std::min(available, static_cast<int64_t>(wanted));
+            if (m_available.compare_exchange_weak(available, available - granted, std::memory_order_relaxed))
             {
-                auto realElapsedTime = std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_lastReset).count();
-                if (realElapsedTime >= m_interval.load(std::memory_order_relaxed))
-                {
-                    m_lastReset = now;
-                    m_count.store(0, std::memory_order_relaxed);
-                }
-
-                m_canReset.store(true, std::memory_order_release);
+                return static_cast<std::size_t>(granted);
             }
         }
 
-        return true;
+        return 0;
+    }
+
+    /**
+     * @brief Sleep until the next refill of the bucket, or up to maxWait
+     *
+     * @param maxWait The maximum time to sleep
+     */
+    void waitRefill(std::chrono::microseconds maxWait) const
+    {
+        const auto remaining = std::chrono::nanoseconds(m_nextRefill.load(std::memory_order_relaxed) - now());
+        if (remaining.count() > 0)
+        {
+            std::this_thread::sleep_for(std::min<std::chrono::nanoseconds>(remaining, maxWait));
+        }
     }
 
     void stop() { active.store(false, std::memory_order_relaxed); }
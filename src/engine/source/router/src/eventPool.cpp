@@ -0,0 +1,55 @@
+#include "eventPool.hpp"
+
+#include <json/json.hpp>
+
+namespace router
+{
+
+EventPool::EventPool(std::size_t capacity, const std::shared_ptr<metricsManager::IMetricsScope>& metricsScope)
+    : m_free(capacity)
+    , m_capacity(capacity)
+    , m_metrics()
+{
+    if (metricsScope)
+    {
+        m_metrics.m_hits = metricsScope->getLocalCounterUInteger("EventPoolHits");
+        m_metrics.m_misses = metricsScope->getLocalCounterUInteger("EventPoolMisses");
+    }
+}
+
+base::Event EventPool::acquire()
+{
+    base::Event event {};
+    if (m_free.try_dequeue(event))
+    {
+        if (m_metrics.m_hits)
+        {
+            m_metrics.m_hits->addValue(1UL);
+        }
+        return event;
+    }
+
+    if (m_metrics.m_misses)
+    {
+        m_metrics.m_misses->addValue(1UL);
+    }
+    return std::make_shared<json::Json>();
+}
+
+void EventPool::recycle(base::Event&& event)
+{
+    // Outputs or tests may still hold the event
+    if (!event || event.use_count() != 1 || m_free.size_approx() >= m_capacity)
+    {
+        event = nullptr;
+        return;
+    }
+
+    event->reset();
+    if (!m_free.try_enqueue(std::move(event)))
+    {
+        event = nullptr;
+    }
+}
+
+} // namespace router
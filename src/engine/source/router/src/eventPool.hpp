@@ -0,0 +1,74 @@
+#ifndef _ROUTER_EVENT_POOL_HPP
+#define _ROUTER_EVENT_POOL_HPP
+
+#include <cstddef>
+#include <memory>
+
+#include <concurrentqueue.h>
+
+#include <baseTypes.hpp>
+#include <metrics/iMetricsScope.hpp>
+
+namespace router
+{
+
+constexpr std::size_t DEFAULT_EVENT_POOL_SIZE = 1024; ///< Maximum number of idle events kept by the pool
+
+/**
+ * @brief Pool of recycled events.
+ *
+ * The endpoints take the events from the pool to parse the incoming messages, and the workers give them back once
+ * they leave the policy. A recycled event keeps its control block, its json object and the memory of its document,
+ * so steady traffic does not allocate new events. The idle events are kept in a lock-free queue, shared by all the
+ * producers and workers.
+ */
+class EventPool
+{
+private:
+    moodycamel::ConcurrentQueue<base::Event> m_free; ///< Idle events, with an empty document
+    std::size_t m_capacity;                          ///< Maximum number of idle events
+
+    struct Metrics
+    {
+        std::shared_ptr<metricsManager::iCounter<uint64_t>> m_hits;   ///< Events taken from the pool
+        std::shared_ptr<metricsManager::iCounter<uint64_t>> m_misses; ///< Events allocated because the pool was empty
+    };
+    Metrics m_metrics; ///< Pool metrics, the instruments are null if no metrics scope is provided
+
+public:
+    /**
+     * @brief Construct a new Event Pool
+     *
+     * @param capacity Maximum number of idle events kept, the events recycled beyond it are released.
+     * @param metricsScope (Optional) The metrics scope for the pool counters.
+     */
+    explicit EventPool(std::size_t capacity = DEFAULT_EVENT_POOL_SIZE,
+                       const std::shared_ptr<metricsManager::IMetricsScope>& metricsScope = nullptr);
+
+    /**
+     * @brief Get an empty event, recycled if available.
+     *
+     * @return base::Event
+     */
+    base::Event acquire();
+
+    /**
+     * @brief Give an event back to the pool.
+     *
+     * The event is only kept if nobody else holds a reference to it and the pool is not full.
+     *
+     * @param event The event, it is left as nullptr.
+     */
+    void recycle(base::Event&& event);
+
+    /**
+     * @brief Get the approximate number of idle events.
+     *
+     * @return std::size_t
+     */
+    std::size_t size() const { return m_free.size_approx(); }
+};
+
+} // namespace router
+
+#endif // _ROUTER_EVENT_POOL_HPP
@@ -0,0 +1,229 @@
+#include "filterProgram.hpp"
+
+#include <stdexcept>
+
+namespace router::internal
+{
+
+std::optional<HelperTerm> parseHelperTerm(const std::string& name)
+{
+    const auto fieldEnd = name.find(": ");
+    if (fieldEnd == std::string::npos || fieldEnd == 0)
+    {
+        return std::nullopt;
+    }
+
+    // Helpers without arguments are named without parentheses
+    const auto argsBegin = name.find('(', fieldEnd);
+    if (argsBegin == std::string::npos)
+    {
+        return HelperTerm {json::Json::formatJsonPath(name.substr(0, fieldEnd)), name.substr(fieldEnd + 2), {}};
+    }
+
+    if (name.back() != ')')
+    {
+        return std::nullopt;
+    }
+
+    return HelperTerm {json::Json::formatJsonPath(name.substr(0, fieldEnd)),
+                       name.substr(fieldEnd + 2, argsBegin - fieldEnd - 2),
+                       name.substr(argsBegin + 1, name.size() - argsBegin - 2)};
+}
+
+FilterProgram::FilterProgram(const base::Expression& filter)
+    : m_root {compile(filter, m_fallbacks)}
+{
+}
+
+std::optional<FilterProgram::Node> FilterProgram::compileTerm(const std::string& name)
+{
+    auto term = parseHelperTerm(name);
+    if (!term)
+    {
+        return std::nullopt;
+    }
+
+    Node node;
+    if (term->helper == "exists" || term->helper == "not_exists")
+    {
+        if (!term->args.empty())
+        {
+            return std::nullopt;
+        }
+        node.code = term->helper == "exists" ? OpCode::EXISTS : OpCode::NOT_EXISTS;
+        node.path = json::PointerPath(term->jsonPath);
+        return node;
+    }
+
+    if (term->helper != "filter" && term->helper != "int_equal" && term->helper != "string_equal")
+    {
+        return std::nullopt;
+    }
+
+    if (term->args.empty())
+    {
+        return std::nullopt;
+    }
+
+    // Only `filter` compares references without checking their type
+    if (term->args[0] == '$')
+    {
+        if (term->helper != "filter" || term->args.find(", ") != std::string::npos)
+        {
+            return std::nullopt;
+        }
+        node.code = OpCode::EQUALS_REF;
+        node.path = json::PointerPath(term->jsonPath);
+        node.refPath = json::PointerPath(json::Json::formatJsonPath(term->args.substr(1)));
+        return node;
+    }
+
+    try
+    {
+        node.value = json::Json(term->args.c_str());
+    }
+    catch (const std::exception&)
+    {
+        // More than one argument or not a literal
+        return std::nullopt;
+    }
+
+    node.path = json::PointerPath(term->jsonPath);
+    if (term->helper == "int_equal")
+    {
+        // Same accessor as the helper, a double with an integral value is not an integer
+        auto value = node.value.getIntAsInt64();
+        if (!value)
+        {
+            return std::nullopt;
+        }
+        node.code = OpCode::INT_EQUAL;
+        node.intValue = value.value();
+    }
+    else if (term->helper == "string_equal")
+    {
+        // Comparing the json values checks that the field is a string without copying it
+        if (!node.value.isString())
+        {
+            return std::nullopt;
+        }
+        node.code = OpCode::EQUALS;
+    }
+    else
+    {
+        node.code = OpCode::EQUALS;
+    }
+
+    return node;
+}
+
+FilterProgram::Node FilterProgram::compile(const base::Expression& expression, std::size_t& fallbacks)
+{
+    Node node;
+    if (expression == nullptr)
+    {
+        node.code = OpCode::ACCEPT;
+        return node;
+    }
+
+    if (expression->isTerm())
+    {
+        if (auto compiled = compileTerm(expression->getName()); compiled)
+        {
+            return std::move(compiled.value());
+        }
+
+        ++fallbacks;
+        node.code = OpCode::TERM;
+        node.term = expression;
+        return node;
+    }
+
+    if (!expression->isOperation())
+    {
+        throw std::runtime_error("Unsupported expression type");
+    }
+
+    if (expression->isAnd())
+    {
+        node.code = OpCode::AND;
+    }
+    else if (expression->isOr())
+    {
+        node.code = OpCode::OR;
+    }
+    else if (expression->isImplication())
+    {
+        node.code = OpCode::IMPLICATION;
+    }
+    else if (expression->isBroadcast() || expression->isChain())
+    {
+        node.code = OpCode::BROADCAST;
+    }
+    else
+    {
+        throw std::runtime_error("Unsupported operation type");
+    }
+
+    const auto& operands = expression->getPtr<base::Operation>()->getOperands();
+    node.children.reserve(operands.size());
+    for (const auto& operand : operands)
+    {
+        node.children.emplace_back(compile(operand, fallbacks));
+    }
+
+    return node;
+}
+
+bool FilterProgram::eval(const Node& node, const base::Event& event)
+{
+    switch (node.code)
+    {
+        case OpCode::ACCEPT: return true;
+        case OpCode::EXISTS: return event->exists(node.path);
+        case OpCode::NOT_EXISTS: return !event->exists(node.path);
+        case OpCode::EQUALS: return event->equals(node.path, node.value);
+        case OpCode::EQUALS_REF: return event->equals(node.path, node.refPath);
+        case OpCode::INT_EQUAL:
+        {
+            const auto value = event->getIntAsInt64(node.path);
+            return value && value.value() == node.intValue;
+        }
+        case OpCode::TERM: return node.term->getPtr<base::Term<base::EngineOp>>()->getFn()(event).success();
+        case OpCode::AND:
+            for (const auto& child : node.children)
+            {
+                if (!eval(child, event))
+                {
+                    return false;
+                }
+            }
+            return true;
+        case OpCode::OR:
+            for (const auto& child : node.children)
+            {
+                if (eval(child, event))
+                {
+                    return true;
+                }
+            }
+            return false;
+        case OpCode::IMPLICATION:
+            if (eval(node.children[0], event))
+            {
+                eval(node.children[1], event);
+                return true;
+            }
+            return false;
+        case OpCode::BROADCAST:
+            for (const auto& child : node.children)
+            {
+                eval(child, event);
+            }
+            return true;
+    }
+
+    return false;
+}
+
+} // namespace router::internal
@@ -0,0 +1,108 @@
+#ifndef _ROUTER_FILTER_PROGRAM_HPP
+#define _ROUTER_FILTER_PROGRAM_HPP
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <baseTypes.hpp>
+#include <expression.hpp>
+#include <json/json.hpp>
+
+namespace router::internal
+{
+
+/**
+ * @brief Helper term of a filter, parsed from the name of the term "<field>: <helper>(<args>)"
+ */
+struct HelperTerm
+{
+    std::string jsonPath; ///< Pointer path of the target field
+    std::string helper;   ///< Name of the helper
+    std::string args;     ///< Arguments as formatted by the builder, empty if the helper has none
+};
+
+/**
+ * @brief Parse the name of a helper term.
+ *
+ * @param name Name of the term.
+ * @return std::optional<HelperTerm> The parsed term, or std::nullopt if the name is not a helper term.
+ */
+std::optional<HelperTerm> parseHelperTerm(const std::string& name);
+
+/**
+ * @brief Route filter compiled to a read-only program over the event.
+ *
+ * The helpers that only read the event (`exists`, `not_exists`, and `filter`, `int_equal` and `string_equal` against a
+ * literal) are compiled to operations with their pointer paths and values prebuilt, so they are evaluated in place
+ * over the event without copying it, building results or allocating. Any other term is kept as is and evaluated
+ * through its operation.
+ */
+class FilterProgram
+{
+private:
+    enum class OpCode : uint8_t
+    {
+        ACCEPT,      ///< Empty filter
+        EXISTS,      ///< The field exists
+        NOT_EXISTS,  ///< The field does not exist
+        EQUALS,      ///< The field is equal to the value
+        EQUALS_REF,  ///< The field is equal to the referenced field
+        INT_EQUAL,   ///< The field is an integer equal to the value
+        TERM,        ///< Term that could not be compiled
+        AND,         ///< All the children are true
+        OR,          ///< Any of the children is true
+        IMPLICATION, ///< The first child is true, the second one is evaluated but ignored
+        BROADCAST,   ///< All the children are evaluated, always true
+    };
+
+    struct Node
+    {
+        OpCode code {OpCode::ACCEPT};
+        json::PointerPath path;     ///< Target field
+        json::PointerPath refPath;  ///< Referenced field (EQUALS_REF)
+        json::Json value;           ///< Expected value (EQUALS)
+        int64_t intValue {0};       ///< Expected value (INT_EQUAL)
+        base::Expression term;      ///< Original term (TERM)
+        std::vector<Node> children; ///< Operands (AND, OR, IMPLICATION, BROADCAST)
+    };
+
+    std::size_t m_fallbacks {}; ///< Number of terms that could not be compiled, counted while compiling m_root
+    Node m_root;                ///< Root of the program
+
+    static Node compile(const base::Expression& expression, std::size_t& fallbacks);
+    static std::optional<Node> compileTerm(const std::string& name);
+    static bool eval(const Node& node, const base::Event& event);
+
+public:
+    FilterProgram() = default;
+
+    /**
+     * @brief Compile a filter expression.
+     *
+     * @param filter Filter of the route, a null expression accepts every event.
+     *
+     * @throw std::runtime_error If the expression has an unsupported operation type.
+     */
+    explicit FilterProgram(const base::Expression& filter);
+
+    /**
+     * @brief Evaluate the filter on an event
+     *
+     * @param event Event to evaluate, it is never modified nor copied by the compiled operations.
+     * @return true If the event is accepted
+     */
+    bool eval(const base::Event& event) const { return eval(m_root, event); }
+
+    /**
+     * @brief Number of terms evaluated through their original operation
+     *
+     * The evaluation is allocation-free only when there are none.
+     */
+    std::size_t fallbacks() const { return m_fallbacks; }
+};
+
+} // namespace router::internal
+
+#endif // _ROUTER_FILTER_PROGRAM_HPP
@@ -4,6 +4,7 @@
 #include <list>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <router/types.hpp>
 
@@ -81,6 +82,14 @@ public:
      * @param event The event to be ingested.
      */
     virtual void ingest(base::Event&& event) = 0;
+
+    /**
+     * @brief Ingest a batch of events into the router.
+     *
+     * The route table is locked once for the whole batch. The events are consumed (left as nullptr).
+     * @param events The events to be ingested.
+     */
+    virtual void ingestBatch(std::vector<base::Event>& events) = 0;
 };
 
 } // namespace router
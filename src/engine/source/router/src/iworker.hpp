@@ -1,6 +1,8 @@
 #ifndef ROUTER_IWORKER_HPP
 #define ROUTER_IWORKER_HPP
 
+#include <cstddef>
+#include <functional>
 #include <memory>
 
 #include "irouter.hpp"
@@ -12,14 +14,17 @@ namespace router
 class IWorker
 {
 public:
-    using EpsLimit = std::function<bool()>;
+    /**
+     * @brief Grants up to the requested number of production events to be processed, 0 if none can be processed now
+     */
+    using EpsLimit = std::function<std::size_t(std::size_t)>;
 
     virtual ~IWorker() = default;
 
     /**
      * @brief Start the worker
      *
-     * @param epsCounter The counter to measure the events per second
+     * @param epsLimit The limiter that grants the events per second
      */
     virtual void start(const EpsLimit& epsLimit) = 0;
 
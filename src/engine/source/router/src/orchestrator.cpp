@@ -4,6 +4,8 @@
 #include "epsCounter.hpp"
 #include "worker.hpp"
 
+#include <utils/numaUtils.hpp>
+
 namespace router
 {
 
@@ -23,6 +25,15 @@ void validatePointer(const T& ptr, const std::string& name)
     else if (!ptr)
         throw std::runtime_error {"Configuration error: " + name + " cannot be empty"};
 }
+
+/**
+ * @brief Get the CPU of a worker, spreading the workers over the NUMA nodes first and over the CPUs of each node next
+ */
+int workerCpu(const utils::numa::Topology& topology, std::size_t worker)
+{
+    const auto& cpus = topology[worker % topology.size()];
+    return cpus[(worker / topology.size()) % cpus.size()];
+}
 } // namespace
 
 // Private
@@ -213,6 +224,10 @@ void Orchestrator::Options::validate() const
     {
         throw std::runtime_error {"Configuration error: testTimeout must be greater than 0"};
     }
+    if (m_batchSize < 1 || m_batchSize > 4096)
+    {
+        throw std::runtime_error {"Configuration error: batchSize must be between 1 and 4096"};
+    }
 }
 
 base::OptError Orchestrator::addWorker(std::shared_ptr<IWorker> worker)
@@ -253,6 +268,9 @@ Orchestrator::Orchestrator(const Options& opt)
 
     m_envBuilder = std::make_shared<EnvironmentBuilder>(opt.m_builder, opt.m_controllerMaker);
     m_testTimeout = opt.m_testTimeout;
+    m_batchSize = opt.m_batchSize;
+    m_metricsScope = opt.m_metricsScope;
+    m_eventPool = std::make_shared<EventPool>(DEFAULT_EVENT_POOL_SIZE, m_metricsScope);
     m_wStore = opt.m_wStore;
 
     // Get the initial states from the store
@@ -266,9 +284,12 @@ Orchestrator::Orchestrator(const Options& opt)
     auto testerEntries = getEntriesFromStore(store, m_storeTesterName);
 
     // Create the workers
+    const auto topology = opt.m_pinWorkers ? utils::numa::getTopology() : utils::numa::Topology {};
     for (std::size_t i = 0; i < opt.m_numThreads; ++i)
     {
-        auto worker = std::make_shared<Worker>(m_envBuilder, m_eventQueue, m_testQueue);
+        const auto cpu = topology.empty() ? NO_CPU_AFFINITY : workerCpu(topology, i);
+        auto worker = std::make_shared<Worker>(
+            m_envBuilder, m_eventQueue, m_testQueue, m_batchSize, m_metricsScope, m_eventPool, cpu);
         auto error = initWorker(worker, routerEntries, testerEntries);
         if (error)
         {
@@ -284,13 +305,20 @@ Orchestrator::Orchestrator(const Options& opt)
 void Orchestrator::start()
 {
     std::shared_lock lock {m_syncMutex};
-    IWorker::EpsLimit epsLimit = [epsCounter = m_epsCounter]() -> bool
+    IWorker::EpsLimit epsLimit = [epsCounter = m_epsCounter](std::size_t wanted) -> std::size_t
     {
-        if (epsCounter->isActive())
+        if (!epsCounter->isActive())
         {
-            return epsCounter->limitReached();
+            return wanted;
         }
-        return false;
+
+        const auto granted = epsCounter->acquire(wanted);
+        if (granted == 0)
+        {
+            // Sleep until the next refill instead of spinning, waking up in time to serve the test queue
+            epsCounter->waitRefill(std::chrono::microseconds(WAIT_DEQUEUE_TIMEOUT_USEC));
+        }
+        return granted;
     };
 
     for (const auto& worker : m_workers)
@@ -309,6 +337,40 @@ void Orchestrator::stop()
     }
 }
 
+void Orchestrator::pushEvent(const std::string& eventStr)
+{
+    try
+    {
+        auto event = m_eventPool ? m_eventPool->acquire() : std::make_shared<json::Json>();
+        event = base::parseEvent::parseWazuhEvent(eventStr, std::move(event));
+        m_eventQueue->push(std::move(event));
+    }
+    catch (const std::exception& e)
+    {
+        LOG_WARNING_RATE_LIMITED("Error parsing event: '{}' (discarding...)", e.what());
+    }
+}
+
+void Orchestrator::pushEvents(const std::vector<std::string>& eventsStr)
+{
+    std::vector<base::Event> events {};
+    events.reserve(eventsStr.size());
+    for (const auto& eventStr : eventsStr)
+    {
+        try
+        {
+            auto event = m_eventPool ? m_eventPool->acquire() : std::make_shared<json::Json>();
+            events.emplace_back(base::parseEvent::parseWazuhEvent(eventStr, std::move(event)));
+        }
+        catch (const std::exception& e)
+        {
+            LOG_WARNING_RATE_LIMITED("Error parsing event: '{}' (discarding...)", e.what());
+        }
+    }
+
+    m_eventQueue->pushBulk(events);
+}
+
 /**************************************************************************
  * IRouterAPI
  *************************************************************************/
@@ -415,7 +477,7 @@ base::OptError Orchestrator::postStrEvent(std::string_view event)
     base::OptError err = std::nullopt;
     try
     {
-        base::Event ev = base::parseEvent::parseWazuhEvent(event.data());
+        base::Event ev = base::parseEvent::parseWazuhEvent(event);
         this->postEvent(std::move(ev));
     }
     catch (const std::exception& e)
@@ -594,7 +656,7 @@ std::future<base::RespOrError<test::Output>> Orchestrator::ingestTest(std::strin
 
     try
     {
-        base::Event ev = base::parseEvent::parseWazuhEvent(event.data());
+        base::Event ev = base::parseEvent::parseWazuhEvent(event);
         return this->ingestTest(std::move(ev), opt);
     }
     catch (const std::exception& e)
@@ -637,7 +699,7 @@ base::OptError Orchestrator::ingestTest(std::string_view event,
 {
     try
     {
-        base::Event ev = base::parseEvent::parseWazuhEvent(event.data());
+        base::Event ev = base::parseEvent::parseWazuhEvent(event);
         this->ingestTest(std::move(ev), opt, callbackFn);
     }
     catch (const std::exception& e)
@@ -0,0 +1,138 @@
+#include "routeIndex.hpp"
+
+#include <array>
+
+#include <json/json.hpp>
+
+#include "filterProgram.hpp"
+
+namespace
+{
+/**
+ * @brief Helpers that test the target field for equality against their only argument
+ */
+constexpr std::array<std::string_view, 3> EQUALITY_HELPERS = {"filter", "int_equal", "string_equal"};
+
+/**
+ * @brief Get the typed key of a json value
+ *
+ * @param value The value
+ * @return std::optional<std::string> The key, or std::nullopt if the value cannot be indexed
+ */
+std::optional<std::string> valueKey(const json::Json& value)
+{
+    if (value.isString())
+    {
+        return "s" + value.getString().value();
+    }
+
+    if (value.isInt64())
+    {
+        return "i" + std::to_string(value.getIntAsInt64().value());
+    }
+
+    if (value.isBool())
+    {
+        return value.getBool().value() ? "btrue" : "bfalse";
+    }
+
+    return std::nullopt;
+}
+
+/**
+ * @brief Parse the name of a helper term "<field>: <helper>(<args>)" into an equality predicate
+ */
+std::optional<router::internal::EqualityPredicate> parseTerm(const std::string& name)
+{
+    auto term = router::internal::parseHelperTerm(name);
+    if (!term
+        || std::find(EQUALITY_HELPERS.begin(), EQUALITY_HELPERS.end(), term->helper) == EQUALITY_HELPERS.end())
+    {
+        return std::nullopt;
+    }
+
+    // References are resolved at runtime, only literals can be indexed
+    const auto& arg = term->args;
+    if (arg.empty() || arg[0] == '$')
+    {
+        return std::nullopt;
+    }
+
+    std::optional<std::string> key;
+    try
+    {
+        key = valueKey(json::Json(arg.c_str()));
+    }
+    catch (const std::exception&)
+    {
+        // More than one argument or not a literal
+        return std::nullopt;
+    }
+
+    if (!key)
+    {
+        return std::nullopt;
+    }
+
+    return router::internal::EqualityPredicate {std::move(term->jsonPath), std::move(key.value())};
+}
+
+void extract(const base::Expression& expression, std::vector<router::internal::EqualityPredicate>& predicates)
+{
+    if (expression == nullptr)
+    {
+        return;
+    }
+
+    if (expression->isTerm())
+    {
+        if (auto predicate = parseTerm(expression->getName()); predicate)
+        {
+            predicates.emplace_back(std::move(predicate.value()));
+        }
+    }
+    else if (expression->isAnd())
+    {
+        for (const auto& operand : expression->getPtr<base::And>()->getOperands())
+        {
+            extract(operand, predicates);
+        }
+    }
+}
+} // namespace
+
+namespace router::internal
+{
+
+std::vector<EqualityPredicate> extractEqualityPredicates(const base::Expression& filter)
+{
+    std::vector<EqualityPredicate> predicates;
+    extract(filter, predicates);
+    return predicates;
+}
+
+KeyResult eventKey(const base::Event& event, const std::string& jsonPath, std::string& key)
+{
+    // Same encoding as valueKey, without copying the value out of the event
+    if (event->isString(jsonPath))
+    {
+        key = "s" + event->getString(jsonPath).value();
+        return KeyResult::FOUND;
+    }
+
+    if (event->isInt64(jsonPath))
+    {
+        key = "i" + std::to_string(event->getIntAsInt64(jsonPath).value());
+        return KeyResult::FOUND;
+    }
+
+    if (event->isBool(jsonPath))
+    {
+        key = event->getBool(jsonPath).value() ? "btrue" : "bfalse";
+        return KeyResult::FOUND;
+    }
+
+    return event->exists(jsonPath) ? KeyResult::UNINDEXED : KeyResult::MISSING;
+}
+
+} // namespace router::internal
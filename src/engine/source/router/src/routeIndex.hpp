@@ -0,0 +1,187 @@
+#ifndef _ROUTER_ROUTE_INDEX_HPP
+#define _ROUTER_ROUTE_INDEX_HPP
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <baseTypes.hpp>
+#include <expression.hpp>
+
+namespace router::internal
+{
+
+/**
+ * @brief Equality predicate (field == value) that must hold for a filter to accept an event
+ */
+struct EqualityPredicate
+{
+    std::string jsonPath; ///< Pointer path of the field
+    std::string key;      ///< Typed key of the expected value (see valueKey)
+};
+
+/**
+ * @brief Extract the equality predicates that are necessary conditions of the filter.
+ *
+ * Only the terms reachable from the root through conjunctions are considered, and only the helpers that test
+ * equality against a literal value (`filter`, `int_equal` and `string_equal`).
+ *
+ * @param filter The filter expression.
+ * @return std::vector<EqualityPredicate> The predicates found (can be empty).
+ */
+std::vector<EqualityPredicate> extractEqualityPredicates(const base::Expression& filter);
+
+/**
+ * @brief Result of getting the typed key of a field in an event
+ */
+enum class KeyResult
+{
+    FOUND,     ///< The field exists and has an indexable value
+    MISSING,   ///< The field does not exist
+    UNINDEXED, ///< The field exists but its value cannot be indexed (e.g. a double or an object)
+};
+
+/**
+ * @brief Get the typed key of the value of a field in the event.
+ *
+ * @param event The event.
+ * @param jsonPath The pointer path of the field.
+ * @param key Output key, only set if the result is KeyResult::FOUND.
+ * @return KeyResult
+ */
+KeyResult eventKey(const base::Event& event, const std::string& jsonPath, std::string& key);
+
+/**
+ * @brief Discrimination index over the route filters.
+ *
+ * The index selects the field that is tested for equality by the largest number of routes, and maps each value of
+ * that field to the routes that can accept it, in priority order. Routes that do not test the field are candidates
+ * for every value. The candidate filters must still be evaluated, the index only discards the routes that cannot
+ * accept the event.
+ *
+ * @tparam T The type of the routes.
+ */
+template<typename T>
+class RouteIndex
+{
+private:
+    std::string m_jsonPath;                                          ///< Discriminating field, empty if no index
+    std::vector<const T*> m_all;                                     ///< All the routes in priority order
+    std::vector<const T*> m_wildcards;                               ///< Routes that do not test the field
+    std::unordered_map<std::string, std::vector<const T*>> m_bucket; ///< Candidates by value of the field
+
+public:
+    /**
+     * @brief Rebuild the index.
+     *
+     * @param routes The routes in priority order, with the equality predicates of their filters.
+     */
+    void build(const std::vector<std::pair<const T*, std::vector<EqualityPredicate>>>& routes)
+    {
+        m_jsonPath.clear();
+        m_all.clear();
+        m_wildcards.clear();
+        m_bucket.clear();
+
+        // Select the field tested by more routes
+        std::unordered_map<std::string, std::size_t> fieldCount;
+        std::size_t maxCount = 0;
+        for (const auto& [route, predicates] : routes)
+        {
+            m_all.push_back(route);
+            std::vector<std::string> seen;
+            for (const auto& predicate : predicates)
+            {
+                if (std::find(seen.begin(), seen.end(), predicate.jsonPath) != seen.end())
+                {
+                    continue;
+                }
+                seen.push_back(predicate.jsonPath);
+
+                auto count = ++fieldCount[predicate.jsonPath];
+                if (count > maxCount)
+                {
+                    maxCount = count;
+                    m_jsonPath = predicate.jsonPath;
+                }
+            }
+        }
+
+        // An index on a field tested by a single route does not discard anything worth the lookup
+        if (maxCount < 2)
+        {
+            m_jsonPath.clear();
+            return;
+        }
+
+        // Classify the routes, keeping the priority order in each bucket
+        std::vector<std::pair<const T*, std::optional<std::string>>> classified;
+        for (const auto& [route, predicates] : routes)
+        {
+            auto it = std::find_if(predicates.begin(),
+                                   predicates.end(),
+                                   [this](const auto& predicate) { return predicate.jsonPath == m_jsonPath; });
+            if (it == predicates.end())
+            {
+                classified.emplace_back(route, std::nullopt);
+                m_wildcards.push_back(route);
+            }
+            else
+            {
+                classified.emplace_back(route, it->key);
+                m_bucket.try_emplace(it->key);
+            }
+        }
+
+        for (auto& [key, candidates] : m_bucket)
+        {
+            for (const auto& [route, routeKey] : classified)
+            {
+                if (!routeKey || routeKey.value() == key)
+                {
+                    candidates.push_back(route);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Get the routes that can accept the event, in priority order.
+     *
+     * @param event The event.
+     * @return const std::vector<const T*>& The candidate routes.
+     */
+    const std::vector<const T*>& candidates(const base::Event& event) const
+    {
+        if (m_jsonPath.empty())
+        {
+            return m_all;
+        }
+
+        std::string key;
+        switch (eventKey(event, m_jsonPath, key))
+        {
+            case KeyResult::MISSING: return m_wildcards;
+            case KeyResult::FOUND:
+            {
+                auto it = m_bucket.find(key);
+                return it == m_bucket.end() ? m_wildcards : it->second;
+            }
+            default: return m_all;
+        }
+    }
+
+    /**
+     * @brief Get the discriminating field of the index
+     *
+     * @return const std::string& The pointer path of the field, empty if the index is not used.
+     */
+    const std::string& field() const { return m_jsonPath; }
+};
+
+} // namespace router::internal
+
+#endif // _ROUTER_ROUTE_INDEX_HPP
@@ -20,13 +20,71 @@ int64_t getStartTime()
 namespace router
 {
 
+void Router::initMetrics(const std::shared_ptr<metricsManager::IMetricsScope>& metricsScope)
+{
+    m_metricsScope = metricsScope;
+    if (metricsScope)
+    {
+        m_metrics.m_routedEvents = metricsScope->getLocalCounterUInteger("RoutedEvents");
+        m_metrics.m_evaluatedFilters = metricsScope->getLocalCounterUInteger("EvaluatedFilters");
+    }
+}
+
+std::shared_ptr<Router::ShadowState> Router::makeShadowState(const std::string& name, double rate) const
+{
+    auto state = std::make_shared<ShadowState>(rate);
+    if (m_metricsScope)
+    {
+        state->m_events = m_metricsScope->getLocalCounterUInteger(fmt::format("Shadow.{}.Events", name));
+        state->m_latency = m_metricsScope->getLocalHistogramUInteger(fmt::format("Shadow.{}.LatencyUs", name));
+    }
+
+    return state;
+}
+
+void Router::publish()
+{
+    auto snapshot = std::make_shared<Snapshot>();
+    snapshot->routes.reserve(m_table.size());
+    for (const auto& entry : m_table)
+    {
+        if (entry.environment() == nullptr)
+        {
+            continue;
+        }
+
+        if (entry.shadow())
+        {
+            snapshot->shadows.push_back({entry.environment(), entry.status(), entry.shadow()});
+            continue;
+        }
+        snapshot->routes.push_back({entry.environment(), entry.status()});
+    }
+
+    // The index points to the routes of the snapshot, which are not modified after this point
+    std::vector<std::pair<const SnapshotRoute*, std::vector<internal::EqualityPredicate>>> indexed;
+    indexed.reserve(snapshot->routes.size());
+    for (const auto& route : snapshot->routes)
+    {
+        indexed.emplace_back(&route, internal::extractEqualityPredicates(route.environment->filter()));
+    }
+    snapshot->index.build(indexed);
+
+    if (!snapshot->index.field().empty())
+    {
+        LOG_DEBUG("Router: route selection index built over field '{}'", snapshot->index.field());
+    }
+
+    std::atomic_store(&m_snapshot, std::shared_ptr<const Snapshot>(std::move(snapshot)));
+}
+
 base::OptError Router::addEntry(const prod::EntryPost& entryPost, bool ignoreFail)
 {
     // Create the environment
     auto entry = RuntimeEntry(entryPost);
     try
     {
-        auto uniqueEnv = m_envBuilder->create(entry.policy(), entry.filter());
+        auto uniqueEnv = m_envBuilder->create(entry.policy(), entry.filter(), m_assetCache);
         entry.hash(uniqueEnv->hash());
         entry.environment() = std::move(uniqueEnv);
     }
@@ -41,10 +99,14 @@ base::OptError Router::addEntry(const prod::EntryPost& entryPost, bool ignoreFai
     }
         entry.status(env::State::DISABLED); // It is disabled until all routes are ready
         entry.lastUpdate(getStartTime());
+    if (entry.isShadow())
+    {
+        entry.shadow() = makeShadowState(entry.name(), entry.shadowRate());
+    }
 
     // Add the entry to the table
     {
-        std::unique_lock<std::shared_mutex> lock {m_mutex};
+        std::unique_lock lock {m_mutex};
         if (m_table.nameExists(entryPost.name()))
         {
             return base::Error {"The name of the route is already in use"};
@@ -55,10 +117,10 @@ base::OptError Router::addEntry(const prod::EntryPost& entryPost, bool ignoreFai
             return base::Error {"The priority of the route  is already in use"};
         }
         m_table.insert(entryPost.name(), entryPost.priority(), std::move(entry));
+        publish();
     }
 
     return std::nullopt;
-    ;
 }
 
 base::OptError Router::removeEntry(const std::string& name)
@@ -69,30 +131,49 @@ base::OptError Router::removeEntry(const std::string& name)
         return base::Error {"The route not exist"};
     }
     m_table.erase(name);
+    publish();
     return std::nullopt;
 }
 
 base::OptError Router::rebuildEntry(const std::string& name)
 {
-    std::unique_lock lock {m_mutex};
-    if (!m_table.nameExists(name))
+    base::Name policy;
+    base::Name filter;
     {
-        return base::Error {"The route not exist"};
+        std::unique_lock lock {m_mutex};
+        if (!m_table.nameExists(name))
+        {
+            return base::Error {"The route not exist"};
+        }
+        const auto& entry = m_table.get(name);
+        policy = entry.policy();
+        filter = entry.filter();
     }
-    auto& entry = m_table.get(name);
+
+    // Build the policy outside the lock, the workers keep using the current environment meanwhile
+    std::shared_ptr<Environment> newEnv;
     try
     {
-        auto uniqueEnv = m_envBuilder->create(entry.policy(), entry.filter());
-        entry.environment() = std::move(uniqueEnv);
-        entry.lastUpdate(getStartTime());
-        entry.hash(entry.environment()->hash());
-        // Mantaing the status of the environment
+        newEnv = m_envBuilder->create(policy, filter, m_assetCache);
     }
     catch (const std::exception& e)
     {
         return base::Error {fmt::format("Failed to reload the route: {}", e.what())};
     }
 
+    std::unique_lock lock {m_mutex};
+    if (!m_table.nameExists(name))
+    {
+        // Removed while it was being rebuilt
+        return base::Error {"The route not exist"};
+    }
+    auto& entry = m_table.get(name);
+    entry.environment() = std::move(newEnv);
+    entry.lastUpdate(getStartTime());
+    entry.hash(entry.environment()->hash());
+    // Mantaing the status of the environment
+    publish();
+
     return std::nullopt;
 }
 
@@ -109,6 +190,7 @@ base::OptError Router::enableEntry(const std::string& name)
         return base::Error {"The route is not buided"};
     }
     entry.status(env::State::ENABLED);
+    publish();
     return {};
 }
 
@@ -138,14 +220,23 @@ base::OptError Router::changePriority(const std::string& name, size_t priority)
         return base::Error {"Failed to change the priority, it is already in use"};
     }
     // Sync the priority
-    m_table.get(name).priority(priority);
+    auto& entry = m_table.get(name);
+    entry.priority(priority);
+    if (entry.isShadow())
+    {
+        // The shadow is promoted, from now on it takes part in the routing
+        entry.shadowRate(0);
+        entry.shadow() = nullptr;
+        LOG_INFO("Router: shadow route '{}' promoted with priority {}", name, priority);
+    }
+    publish();
 
     return {};
 }
 
 std::list<prod::Entry> Router::getEntries() const
 {
-    std::shared_lock lock {m_mutex};
+    std::unique_lock lock {m_mutex};
     std::list<prod::Entry> entries;
 
     for (const auto& entry : m_table)
@@ -157,7 +248,7 @@ std::list<prod::Entry> Router::getEntries() const
 
 base::RespOrError<prod::Entry> Router::getEntry(const std::string& name) const
 {
-    std::shared_lock lock {m_mutex};
+    std::unique_lock lock {m_mutex};
     if (!m_table.nameExists(name))
     {
         return base::Error {"The route not exist"};
@@ -165,23 +256,126 @@ base::RespOrError<prod::Entry> Router::getEntry(const std::string& name) const
     return m_table.get(name);
 }
 
+void Router::shadow(const SnapshotShadow& shadow, const base::Event& event) const
+{
+    // The json of the event can't be shared, the policies modify it
+    base::Event clone;
+    std::chrono::steady_clock::duration elapsed {};
+    try
+    {
+        if (!shadow.environment->isAccepted(event))
+        {
+            return;
+        }
+
+        clone = std::make_shared<json::Json>(*event);
+        const auto start = std::chrono::steady_clock::now();
+        clone = shadow.environment->ingestGet(std::move(clone));
+        elapsed = std::chrono::steady_clock::now() - start;
+    }
+    catch (const std::exception& e)
+    {
+        // A failing shadow never affects the routing
+        LOG_WARNING_RATE_LIMITED("Router: shadow route failed: {}", e.what());
+        return;
+    }
+
+    if (m_eventPool && clone)
+    {
+        m_eventPool->recycle(std::move(clone));
+    }
+
+    if (shadow.state->m_events)
+    {
+        shadow.state->m_events->addValue(1UL);
+        shadow.state->m_latency->recordValue(
+            static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()));
+    }
+}
+
+std::size_t Router::route(const Snapshot& snapshot, base::Event& event) const
+{
+    // The shadows get the event as it arrived, before a route modifies it
+    for (const auto& entry : snapshot.shadows)
+    {
+        if (entry.status == env::State::ENABLED && entry.state->sample())
+        {
+            shadow(entry, event);
+        }
+    }
+
+    std::size_t evaluated = 0;
+    for (const auto* route : snapshot.index.candidates(event))
+    {
+        if (route->status != env::State::ENABLED)
+        {
+            continue;
+        }
+
+        ++evaluated;
+        if (route->environment->isAccepted(event))
+        {
+            if (m_eventPool)
+            {
+                // Get the event back to recycle it
+                event = route->environment->ingestGet(std::move(event));
+            }
+            else
+            {
+                route->environment->ingest(std::move(event));
+                event = nullptr;
+            }
+            return evaluated;
+        }
+    }
+
+    LOG_WARNING_RATE_LIMITED("Event not processed: {}", event->str());
+    return evaluated;
+}
+
+void Router::release(base::Event& event)
+{
+    if (m_eventPool)
+    {
+        m_eventPool->recycle(std::move(event));
+    }
+    event = nullptr;
+}
+
 void Router::ingest(base::Event&& event)
 {
-    std::shared_lock lock {m_mutex};
+    const auto current = snapshot();
+    auto evaluated = route(*current, event);
+    release(event);
 
-    for (const auto& entry : m_table)
+    if (m_metrics.m_routedEvents)
+    {
+        m_metrics.m_routedEvents->addValue(1UL);
+        m_metrics.m_evaluatedFilters->addValue(evaluated);
+    }
+}
+
+void Router::ingestBatch(std::vector<base::Event>& events)
+{
+    // The whole batch is routed with the same snapshot
+    const auto current = snapshot();
+
+    std::size_t routed = 0;
+    std::size_t evaluated = 0;
+    for (auto& event : events)
     {
-        if (entry.status() == env::State::ENABLED && entry.environment()->isAccepted(event))
+        if (event)
         {
-            entry.environment()->ingest(std::move(event));
-            event = nullptr;
-            break;
+            evaluated += route(*current, event);
+            release(event);
+            ++routed;
         }
     }
 
-    if (event)
+    if (m_metrics.m_routedEvents && routed > 0)
     {
-        LOG_WARNING("Event not processed: {}", event->str());
+        m_metrics.m_routedEvents->addValue(routed);
+        m_metrics.m_evaluatedFilters->addValue(evaluated);
     }
 }
 
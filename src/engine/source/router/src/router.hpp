@@ -1,13 +1,19 @@
 #ifndef _ROUTER_ROUTER_HPP
 #define _ROUTER_ROUTER_HPP
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
-#include <shared_mutex>
+#include <mutex>
+#include <vector>
 
 #include <builder/ibuilder.hpp>
+#include <metrics/iMetricsScope.hpp>
 
-#include "table.hpp"
+#include "eventPool.hpp"
 #include "irouter.hpp"
+#include "routeIndex.hpp"
+#include "table.hpp"
 
 namespace router
 {
@@ -18,42 +24,191 @@ namespace router
 class Router : public IRouter
 {
 private:
+    /**
+     * @brief Sampling and metrics of a shadow entry, kept across the snapshots.
+     */
+    class ShadowState
+    {
+    private:
+        double m_rate;                      ///< Fraction of the events cloned
+        std::atomic<uint64_t> m_seen {0};   ///< Events seen by the shadow
+
+    public:
+        std::shared_ptr<metricsManager::iCounter<uint64_t>> m_events;    ///< Events cloned into the shadow
+        std::shared_ptr<metricsManager::iHistogram<uint64_t>> m_latency; ///< Time to process a clone, in microseconds
+
+        explicit ShadowState(double rate)
+            : m_rate(rate)
+        {
+        }
+
+        /**
+         * @brief Whether the next event is cloned, spreads the sampled events evenly.
+         */
+        bool sample()
+        {
+            const auto seen = m_seen.fetch_add(1, std::memory_order_relaxed);
+            return static_cast<uint64_t>((seen + 1) * m_rate) != static_cast<uint64_t>(seen * m_rate);
+        }
+    };
+
     class RuntimeEntry : public prod::Entry
     {
     private:
-        std::unique_ptr<Environment> m_env; ///< The environment associated with the entry.
+        std::shared_ptr<Environment> m_env;    ///< The environment associated with the entry.
+        std::shared_ptr<ShadowState> m_shadow; ///< Sampling of the entry if it is a shadow, null otherwise.
 
     public:
         explicit RuntimeEntry(const prod::EntryPost& entry)
             : prod::Entry(entry) {};
 
-        const std::unique_ptr<Environment>& environment() const { return m_env; }
-        std::unique_ptr<Environment>& environment() { return m_env; }
+        const std::shared_ptr<Environment>& environment() const { return m_env; }
+        std::shared_ptr<Environment>& environment() { return m_env; }
+
+        const std::shared_ptr<ShadowState>& shadow() const { return m_shadow; }
+        std::shared_ptr<ShadowState>& shadow() { return m_shadow; }
+    };
+
+    /**
+     * @brief Route as seen by the workers, a read-only copy of the routing data of an entry.
+     */
+    struct SnapshotRoute
+    {
+        std::shared_ptr<const Environment> environment; ///< Shared with the entry, alive while the snapshot is used
+        env::State status;                              ///< Status of the entry when the snapshot was published
+    };
+
+    /**
+     * @brief Shadow entry as seen by the workers.
+     */
+    struct SnapshotShadow
+    {
+        std::shared_ptr<const Environment> environment; ///< Shared with the entry, alive while the snapshot is used
+        env::State status;                              ///< Status of the entry when the snapshot was published
+        std::shared_ptr<ShadowState> state;             ///< Shared with the entry
+    };
+
+    /**
+     * @brief Immutable view of the route table used in the hot path.
+     *
+     * A new snapshot is published after every change of the table, so the workers never wait for the API calls.
+     */
+    struct Snapshot
+    {
+        std::vector<SnapshotRoute> routes;         ///< Routes in priority order
+        internal::RouteIndex<SnapshotRoute> index; ///< Route selection index over the routes filters
+        std::vector<SnapshotShadow> shadows;       ///< Shadow entries, not part of the routing
+    };
+
+    internal::Table<RuntimeEntry> m_table;      ///< Internal table for managing Production Environments.
+    mutable std::mutex m_mutex;                 ///< Mutex for the table, only taken by the API calls.
+    std::shared_ptr<const Snapshot> m_snapshot; ///< Last published snapshot (accessed atomically).
+
+    struct Metrics
+    {
+        std::shared_ptr<metricsManager::iCounter<uint64_t>> m_routedEvents;     ///< Events routed
+        std::shared_ptr<metricsManager::iCounter<uint64_t>> m_evaluatedFilters; ///< Filters evaluated routing them
     };
+    Metrics m_metrics; ///< Router metrics, the instruments are null if no metrics scope is provided
+    std::shared_ptr<metricsManager::IMetricsScope> m_metricsScope; ///< Scope of the shadow metrics (optional)
+
+    std::shared_ptr<EventPool> m_eventPool; ///< Pool the routed events are given back to (optional)
+
+    /**
+     * @brief Build a snapshot of the table and publish it for the workers.
+     *
+     * @warning The caller must hold the table mutex.
+     */
+    void publish();
+
+    /**
+     * @brief Get the last published snapshot.
+     */
+    std::shared_ptr<const Snapshot> snapshot() const { return std::atomic_load(&m_snapshot); }
+
+    /**
+     * @brief Initialize the metrics instruments if a metrics scope is provided
+     */
+    void initMetrics(const std::shared_ptr<metricsManager::IMetricsScope>& metricsScope);
+
+    /**
+     * @brief Route the event to the first enabled route of the snapshot that accepts it.
+     *
+     * @param snapshot The snapshot of the route table.
+     * @param event The event to be routed. If it was processed, it is left as nullptr, or as the processed event when
+     * there is an event pool to give it back to.
+     * @return std::size_t The number of filters evaluated.
+     */
+    std::size_t route(const Snapshot& snapshot, base::Event& event) const;
 
-    internal::Table<RuntimeEntry> m_table; ///< Internal table for managing Production Environments.
-    mutable std::shared_mutex m_mutex;     ///< Mutex for the table.
+    /**
+     * @brief Process a clone of the event in a shadow entry, if its filter accepts it. The result is discarded.
+     *
+     * @param shadow The shadow entry.
+     * @param event The event, it is not modified.
+     */
+    void shadow(const SnapshotShadow& shadow, const base::Event& event) const;
+
+    /**
+     * @brief Create the sampling and metrics of a shadow entry.
+     *
+     * @param name Name of the entry.
+     * @param rate Fraction of the events cloned.
+     */
+    std::shared_ptr<ShadowState> makeShadowState(const std::string& name, double rate) const;
+
+    /**
+     * @brief Drop a routed event, giving it back to the event pool if there is one.
+     *
+     * @param event The event, it is left as nullptr.
+     */
+    void release(base::Event& event);
 
-    std::shared_ptr<EnvironmentBuilder> m_envBuilder; ///< Environment builder for create new entries
+    std::shared_ptr<EnvironmentBuilder> m_envBuilder;   ///< Environment builder for create new entries
+    std::shared_ptr<builder::AssetCache> m_assetCache; ///< Assets compiled for the entries, all run by this router
 
 public:
     /**
      * @brief Constructs a Router with the specified environment builder.
      * @param envBuilder The shared pointer to the EnvironmentBuilder.
+     * @param metricsScope (Optional) The metrics scope for the routing counters.
+     * @param eventPool (Optional) The pool the events are given back to once routed.
+     * @param assetCache (Optional) The compiled assets, shared with the tester run by the same thread. A new cache is
+     * used if null.
      */
-    Router(const std::shared_ptr<EnvironmentBuilder>& envBuilder)
+    Router(const std::shared_ptr<EnvironmentBuilder>& envBuilder,
+           const std::shared_ptr<metricsManager::IMetricsScope>& metricsScope = nullptr,
+           const std::shared_ptr<EventPool>& eventPool = nullptr,
+           const std::shared_ptr<builder::AssetCache>& assetCache = nullptr)
         : m_table()
         , m_mutex()
-        , m_envBuilder(envBuilder) {};
+        , m_snapshot(std::make_shared<const Snapshot>())
+        , m_eventPool(eventPool)
+        , m_envBuilder(envBuilder)
+        , m_assetCache(assetCache ? assetCache : std::make_shared<builder::AssetCache>())
+    {
+        initMetrics(metricsScope);
+    };
 
     /**
      * @brief Constructs a Router with the specified builder.
      * @param builder The shared pointer to the IBuilder interface.
+     * @param metricsScope (Optional) The metrics scope for the routing counters.
+     * @param eventPool (Optional) The pool the events are given back to once routed.
      */
-    Router(const std::weak_ptr<builder::IBuilder>& builder, std::shared_ptr<bk::IControllerMaker> controllerMaker)
+    Router(const std::weak_ptr<builder::IBuilder>& builder,
+           std::shared_ptr<bk::IControllerMaker> controllerMaker,
+           const std::shared_ptr<metricsManager::IMetricsScope>& metricsScope = nullptr,
+           const std::shared_ptr<EventPool>& eventPool = nullptr)
         : m_table()
         , m_mutex()
-        , m_envBuilder(std::make_shared<EnvironmentBuilder>(builder, controllerMaker)) {};
+        , m_snapshot(std::make_shared<const Snapshot>())
+        , m_eventPool(eventPool)
+        , m_envBuilder(std::make_shared<EnvironmentBuilder>(builder, controllerMaker))
+        , m_assetCache(std::make_shared<builder::AssetCache>())
+    {
+        initMetrics(metricsScope);
+    };
 
     /**
      * @copydoc IRouter::addEntry
@@ -94,6 +249,11 @@ public:
      * @copydoc IRouter::ingest
      */
     void ingest(base::Event&& event) override;
+
+    /**
+     * @copydoc IRouter::ingestBatch
+     */
+    void ingestBatch(std::vector<base::Event>& events) override;
 };
 
 } // namespace router
@@ -66,12 +66,25 @@ private:
     std::shared_ptr<bk::IController> createController(const base::Name& policy);
 
     std::shared_ptr<EnvironmentBuilder> m_envBuilder;      ///< Shared pointer to the controller builder.
+    std::shared_ptr<builder::AssetCache> m_assetCache;     ///< Assets compiled for the entries, all run by this thread
     std::unordered_map<std::string, RuntimeEntry> m_table; ///< Internal table for managing Testing Environments.
     mutable std::shared_mutex m_mutex;                     ///< Mutex for the table.
 
 public:
-    Tester(const std::shared_ptr<EnvironmentBuilder>& envBuilder)
-        : m_envBuilder(envBuilder) {};
+    /**
+     * @brief Construct a new Tester.
+     *
+     * The sessions reuse the compiled assets of the cache, so only the assets not compiled yet or whose document
+     * changed are compiled for a new session. When the cache is shared with the router run by the same thread, the
+     * sessions of the production policy compile nothing.
+     *
+     * @param envBuilder The environment builder.
+     * @param assetCache (Optional) The compiled assets. A new cache is used if null.
+     */
+    Tester(const std::shared_ptr<EnvironmentBuilder>& envBuilder,
+           const std::shared_ptr<builder::AssetCache>& assetCache = nullptr)
+        : m_envBuilder(envBuilder)
+        , m_assetCache(assetCache ? assetCache : std::make_shared<builder::AssetCache>()) {};
 
     /**
      * @copydoc ITester::addEntry
@@ -1,10 +1,72 @@
 #include "worker.hpp"
 
+#include <algorithm>
+
 #include <logging/logging.hpp>
+#include <utils/numaUtils.hpp>
 
 namespace router
 {
 
+void Worker::processTestQueue()
+{
+    test::QueueType testEvent {};
+    if (m_tQueue->tryPop(testEvent) && testEvent != nullptr)
+    {
+        auto& [event, opt, callback] = *testEvent;
+        auto output = m_tester->ingestTest(std::move(event), opt);
+        try
+        {
+            callback(std::move(output));
+        }
+        catch (const std::exception& e)
+        {
+            LOG_ERROR("Error when executing API callback: ", e.what());
+        }
+    }
+}
+
+std::size_t Worker::reserveCredits(const EpsLimit& epsLimit, std::size_t wanted)
+{
+    if (m_credits < wanted)
+    {
+        m_credits += epsLimit(std::max(EPS_CREDIT_BLOCK, wanted) - m_credits);
+    }
+
+    return m_credits;
+}
+
+void Worker::processEvent(const EpsLimit& epsLimit)
+{
+    if (reserveCredits(epsLimit, 1) == 0)
+    {
+        return;
+    }
+
+    base::Event event {};
+    if (m_rQueue->waitPop(event, WAIT_DEQUEUE_TIMEOUT_USEC) && event != nullptr)
+    {
+        --m_credits;
+        m_router->ingest(std::move(event));
+    }
+}
+
+void Worker::processBatch(const EpsLimit& epsLimit, std::vector<base::Event>& batch)
+{
+    const auto allowed = std::min(reserveCredits(epsLimit, m_batchSize), m_batchSize);
+    if (allowed == 0)
+    {
+        return;
+    }
+
+    batch.clear();
+    if (const auto count = m_rQueue->waitPopBulk(batch, allowed, WAIT_DEQUEUE_TIMEOUT_USEC); count > 0)
+    {
+        m_credits -= count;
+        m_router->ingestBatch(batch);
+    }
+}
+
 void Worker::start(const EpsLimit& epsLimit)
 {
     if (m_isRunning)
@@ -17,30 +79,43 @@ void Worker::start(const EpsLimit& epsLimit)
         [this, epsLimit]()
         {
             std::size_t tID = std::hash<std::thread::id> {}(std::this_thread::get_id());
-            LOG_DEBUG("Router Worker {} started", tID);
-            while (m_isRunning)
+            LOG_DEBUG("Router Worker {} started (batch size {})", tID, m_batchSize);
+
+            // Keep the worker on one CPU, so it consumes from the queue shard of its NUMA node
+            if (m_cpu != NO_CPU_AFFINITY)
             {
-                // Process test queue
-                test::QueueType testEvent {};
-                if (m_tQueue->tryPop(testEvent) && testEvent != nullptr)
+                if (auto error = utils::numa::pinCurrentThread(m_cpu); error)
+                {
+                    LOG_WARNING("Router Worker {}: {}", tID, error->message);
+                }
+                else
                 {
-                    auto& [event, opt, callback] = *testEvent;
-                    auto output = m_tester->ingestTest(std::move(event), opt);
-                    try
-                    {
-                        callback(std::move(output));
-                    }
-                    catch (const std::exception& e)
-                    {
-                        LOG_ERROR("Error when executing API callback: ", e.what());
-                    }
+                    LOG_DEBUG("Router Worker {} pinned to CPU {}", tID, m_cpu);
                 }
+            }
+
+            // Documents built while routing (outputs, helper results, ...) reuse the worker chunks
+            json::Arena::Scope arenaScope {m_arena};
+
+            std::vector<base::Event> batch {};
+            if (m_batchSize > 1)
+            {
+                batch.reserve(m_batchSize);
+            }
+
+            while (m_isRunning)
+            {
+                // Process test queue
+                processTestQueue();
 
                 // Process production queue
-                base::Event event {};
-                if (!epsLimit() && m_rQueue->waitPop(event, WAIT_DEQUEUE_TIMEOUT_USEC) && event != nullptr)
+                if (m_batchSize > 1)
+                {
+                    processBatch(epsLimit, batch);
+                }
+                else
                 {
-                    m_router->ingest(std::move(event));
+                    processEvent(epsLimit);
                 }
             }
             LOG_DEBUG("Router Worker {} finished", tID);
@@ -4,7 +4,9 @@
 #include <atomic>
 #include <memory>
 #include <thread>
+#include <vector>
 
+#include <json/arena.hpp>
 #include <queue/iqueue.hpp>
 
 #include <router/types.hpp>
@@ -18,30 +20,87 @@ namespace router
 {
 
 constexpr auto WAIT_DEQUEUE_TIMEOUT_USEC = 1 * 100000;
+constexpr std::size_t DEFAULT_BATCH_SIZE = 1; ///< Events dequeued at once by the worker (1 = batch mode disabled)
+constexpr int NO_CPU_AFFINITY = -1;           ///< The worker thread is not pinned to any CPU
+constexpr std::size_t EPS_CREDIT_BLOCK = 64;  ///< EPS credits reserved at once by the worker
 
 class Worker : public IWorker
 {
 private:
-    std::shared_ptr<IRouter> m_router; ///< The router instance
-    std::shared_ptr<ITester> m_tester; ///< The tester instance
-    std::atomic_bool m_isRunning;      ///< Flag to know if the worker is running
-    std::thread m_thread;              ///< The thread for the worker
+    std::shared_ptr<builder::AssetCache> m_assetCache; ///< The assets compiled for the router and the tester
+
+    std::shared_ptr<IRouter> m_router;    ///< The router instance
+    std::shared_ptr<ITester> m_tester;    ///< The tester instance
+    std::atomic_bool m_isRunning;         ///< Flag to know if the worker is running
+    std::thread m_thread;                 ///< The thread for the worker
+    std::size_t m_batchSize;              ///< Maximum number of events dequeued at once
+    std::shared_ptr<json::Arena> m_arena; ///< Arena for the documents built by the worker thread
+    int m_cpu;                            ///< CPU the worker thread is pinned to, NO_CPU_AFFINITY if none
+    std::size_t m_credits;                ///< EPS credits reserved and not used yet (worker thread only)
 
     std::shared_ptr<base::queue::iQueue<base::Event>> m_rQueue;     ///< The router queue
     std::shared_ptr<base::queue::iQueue<test::QueueType>> m_tQueue; ///< The tester queue
 
+    /**
+     * @brief Process the test queue, if there is a pending test event
+     */
+    void processTestQueue();
+
+    /**
+     * @brief Reserve EPS credits until the worker holds at least `wanted`, taking them in blocks
+     *
+     * @param epsLimit The EPS limit function
+     * @param wanted The credits needed
+     * @return std::size_t The credits held, 0 if the limit has been reached
+     */
+    std::size_t reserveCredits(const EpsLimit& epsLimit, std::size_t wanted);
+
+    /**
+     * @brief Process one event of the production queue
+     *
+     * @param epsLimit The EPS limit function
+     */
+    void processEvent(const EpsLimit& epsLimit);
+
+    /**
+     * @brief Process a batch of events of the production queue
+     *
+     * @param epsLimit The EPS limit function
+     * @param batch Reusable buffer for the batch
+     */
+    void processBatch(const EpsLimit& epsLimit, std::vector<base::Event>& batch);
+
 public:
     /**
      * @brief Construct a new Worker object
      *
+     * The router and the tester are run by the worker thread, so they share the compiled assets: the test sessions
+     * only compile the assets that differ from the ones of the production routes.
+     *
+     * @param envBuilder The environment builder
+     * @param rQueue The router queue
+     * @param tQueue The tester queue
+     * @param batchSize Maximum number of production events dequeued and routed at once
+     * @param metricsScope (Optional) The metrics scope for the router counters
+     * @param eventPool (Optional) The pool the production events are given back to once routed
+     * @param cpu (Optional) The CPU the worker thread is pinned to
      */
     Worker(std::shared_ptr<EnvironmentBuilder> envBuilder,
            std::shared_ptr<base::queue::iQueue<base::Event>> rQueue,
-           std::shared_ptr<base::queue::iQueue<test::QueueType>> tQueue)
-        : m_router(std::make_shared<Router>(envBuilder))
-        , m_tester(std::make_shared<Tester>(envBuilder))
+           std::shared_ptr<base::queue::iQueue<test::QueueType>> tQueue,
+           std::size_t batchSize = DEFAULT_BATCH_SIZE,
+           const std::shared_ptr<metricsManager::IMetricsScope>& metricsScope = nullptr,
+           const std::shared_ptr<EventPool>& eventPool = nullptr,
+           int cpu = NO_CPU_AFFINITY)
+        : m_assetCache(std::make_shared<builder::AssetCache>())
+        , m_router(std::make_shared<Router>(envBuilder, metricsScope, eventPool, m_assetCache))
+        , m_tester(std::make_shared<Tester>(envBuilder, m_assetCache))
         , m_isRunning(false)
         , m_thread()
+        , m_batchSize(batchSize)
+        , m_arena(json::Arena::create())
+        , m_cpu(cpu)
+        , m_credits(0)
         , m_rQueue(rQueue)
         , m_tQueue(tQueue)
     {
@@ -49,6 +108,11 @@ public:
         {
             throw std::logic_error("Invalid queues for the worker");
         }
+
+        if (m_batchSize == 0)
+        {
+            throw std::logic_error("Invalid batch size for the worker");
+        }
     }
 
     ~Worker() { stop(); }
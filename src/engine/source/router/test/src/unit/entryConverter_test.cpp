@@ -9,6 +9,7 @@ TEST(EntryConverter, prodEntryConverter)
     // Chcek if can be converted to json and back to prod::EntryPost
     ::prod::EntryPost entryPost("name", "policy/test/0", "filter/test/0", 1);
     entryPost.description("description");
+    entryPost.shadowRate(0.25);
 
     ::prod::Entry entry(entryPost);
     EntryConverter entryConverter(entry);
@@ -22,6 +23,7 @@ TEST(EntryConverter, prodEntryConverter)
     EXPECT_EQ(entryPost.name(), entryPost2.name());
     EXPECT_EQ(entryPost.policy(), entryPost2.policy());
     EXPECT_EQ(entryPost.priority(), entryPost2.priority());
+    EXPECT_EQ(entryPost.shadowRate(), entryPost2.shadowRate());
 }
 
 
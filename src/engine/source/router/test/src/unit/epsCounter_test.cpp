@@ -67,92 +67,81 @@ TEST(EpsCounter, ChangeSettings)
     EXPECT_THROW(counter.changeSettings(0, 0), std::runtime_error);
 }
 
-TEST(EpsCounter, LimitReachedSingleThread)
+TEST(EpsCounter, AcquireSingleThread)
 {
     auto counter = T::EpsCounter(1, 1, true);
-    EXPECT_EQ(counter.limitReached(), false);
-    EXPECT_EQ(counter.limitReached(), true);
+    EXPECT_EQ(counter.acquire(1), 1);
+    EXPECT_EQ(counter.acquire(1), 0);
     std::this_thread::sleep_for(std::chrono::seconds(1));
-    EXPECT_EQ(counter.limitReached(), true);
-    EXPECT_EQ(counter.limitReached(), false);
+    EXPECT_EQ(counter.acquire(1), 1);
+    EXPECT_EQ(counter.acquire(1), 0);
+    EXPECT_EQ(counter.acquire(1), 0);
     std::this_thread::sleep_for(std::chrono::seconds(1));
-    EXPECT_EQ(counter.limitReached(), true);
-    EXPECT_EQ(counter.limitReached(), false);
-    EXPECT_EQ(counter.limitReached(), true);
-    EXPECT_EQ(counter.limitReached(), true);
-    EXPECT_EQ(counter.limitReached(), true);
-    std::this_thread::sleep_for(std::chrono::seconds(1));
-    EXPECT_EQ(counter.limitReached(), true);
-    EXPECT_EQ(counter.limitReached(), false);
-    EXPECT_EQ(counter.limitReached(), true);
-    EXPECT_EQ(counter.limitReached(), true);
-    EXPECT_EQ(counter.limitReached(), true);
+    EXPECT_EQ(counter.acquire(1), 1);
+    EXPECT_EQ(counter.acquire(1), 0);
 }
 
-TEST(EpsCounter, LimitReachedMultipleThreads)
+TEST(EpsCounter, AcquireBlocks)
 {
-    auto nThreads = 5;
-    auto counter = std::make_shared<T::EpsCounter>(nThreads, 1, true);
-    auto results = std::make_shared<std::vector<std::vector<bool>>>();
-
-    for (auto i = 0; i < nThreads; i++)
-    {
-        results->emplace_back(std::vector<bool>());
-    }
-    std::vector<std::thread> threads;
-    auto testFn = [](decltype(counter) counter, decltype(results) results, int i)
-    {
-        return [counter, results, i]()
-        {
-            results->at(i).emplace_back(counter->limitReached());
-        };
-    };
+    auto counter = T::EpsCounter(10, 1, true);
+    EXPECT_EQ(counter.acquire(4), 4);
+    EXPECT_EQ(counter.acquire(4), 4);
+    EXPECT_EQ(counter.acquire(4), 2);
+    EXPECT_EQ(counter.acquire(4), 0);
+    std::this_thread::sleep_for(std::chrono::seconds(1));
 
-    for (auto i = 0; i < nThreads; i++)
-    {
-        threads.emplace_back(std::thread(testFn(counter, results, i)));
-    }
+    // The credits not used are lost on refill
+    EXPECT_EQ(counter.acquire(20), 10);
+}
 
-    for (auto i = 0; i < nThreads; i++)
-    {
-        threads.at(i).join();
-    }
+TEST(EpsCounter, WaitRefill)
+{
+    auto counter = T::EpsCounter(1, 1, true);
+    EXPECT_EQ(counter.acquire(1), 1);
+
+    // Capped by the maximum wait
+    auto start = std::chrono::steady_clock::now();
+    counter.waitRefill(std::chrono::milliseconds(10));
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_LT(elapsed, std::chrono::milliseconds(500));
+    EXPECT_EQ(counter.acquire(1), 0);
+
+    // Sleeps until the refill
+    counter.waitRefill(std::chrono::seconds(2));
+    EXPECT_EQ(counter.acquire(1), 1);
+}
 
-    for (auto i = 0; i < nThreads; i++)
+TEST(EpsCounter, AcquireMultipleThreads)
+{
+    auto nThreads = 5;
+    auto run = [nThreads](uint eps)
     {
-        for (auto res : results->at(i))
+        auto counter = std::make_shared<T::EpsCounter>(eps, 1, true);
+        std::vector<std::size_t> results(nThreads, 0);
+        std::vector<std::thread> threads;
+        for (auto i = 0; i < nThreads; i++)
         {
-            EXPECT_EQ(res, false);
+            threads.emplace_back([counter, &results, i]() { results[i] = counter->acquire(1); });
         }
-    }
-
-    counter = std::make_shared<T::EpsCounter>(nThreads - 1, 1, true);
-    results = std::make_shared<std::vector<std::vector<bool>>>();
-    for (auto i = 0; i < nThreads; i++)
-    {
-        results->emplace_back(std::vector<bool>());
-    }
-    for (auto i = 0; i < nThreads; i++)
-    {
-        threads.at(i) = std::thread(testFn(counter, results, i));
-    }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        return results;
+    };
 
-    for (auto i = 0; i < nThreads; i++)
+    for (auto res : run(nThreads))
     {
-        threads.at(i).join();
+        EXPECT_EQ(res, 1);
     }
 
-    auto trueCount = 0;
-    for (auto i = 0; i < nThreads; i++)
+    auto denied = 0;
+    for (auto res : run(nThreads - 1))
     {
-        for (auto res : results->at(i))
+        if (res == 0)
         {
-            if (res)
-            {
-                trueCount++;
-            }
+            denied++;
         }
     }
-
-    EXPECT_EQ(trueCount, 1);
+    EXPECT_EQ(denied, 1);
 }
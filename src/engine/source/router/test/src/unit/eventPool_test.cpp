@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+
+#include <json/json.hpp>
+
+#include "eventPool.hpp"
+
+using namespace router;
+
+TEST(EventPoolTest, AcquireRecycle)
+{
+    EventPool pool {2};
+    ASSERT_EQ(pool.size(), 0);
+
+    auto event = pool.acquire();
+    ASSERT_NE(event, nullptr);
+    event->setString("value", "/key");
+    const auto* raw = event.get();
+
+    pool.recycle(std::move(event));
+    ASSERT_EQ(event, nullptr);
+    ASSERT_EQ(pool.size(), 1);
+
+    // The recycled event comes back empty
+    event = pool.acquire();
+    ASSERT_EQ(event.get(), raw);
+    ASSERT_TRUE(event->isNull());
+    ASSERT_EQ(pool.size(), 0);
+}
+
+TEST(EventPoolTest, SharedEventsAreNotRecycled)
+{
+    EventPool pool {2};
+    auto event = pool.acquire();
+    auto copy = event;
+
+    pool.recycle(std::move(event));
+    ASSERT_EQ(event, nullptr);
+    ASSERT_EQ(pool.size(), 0);
+    ASSERT_EQ(copy.use_count(), 1);
+
+    pool.recycle(nullptr);
+    ASSERT_EQ(pool.size(), 0);
+}
+
+TEST(EventPoolTest, Capacity)
+{
+    EventPool pool {1};
+    auto event1 = pool.acquire();
+    auto event2 = pool.acquire();
+
+    pool.recycle(std::move(event1));
+    pool.recycle(std::move(event2));
+    ASSERT_EQ(pool.size(), 1);
+}
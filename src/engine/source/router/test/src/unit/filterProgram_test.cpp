@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <new>
+
+#include "filterProgram.hpp"
+
+using namespace router::internal;
+
+namespace
+{
+// Allocations made by this thread while counting, to assert that the compiled filters do not allocate
+thread_local bool g_countAllocations = false;
+thread_local std::size_t g_allocations = 0;
+
+class AllocationCounter
+{
+public:
+    AllocationCounter()
+    {
+        g_allocations = 0;
+        g_countAllocations = true;
+    }
+    ~AllocationCounter() { g_countAllocations = false; }
+    std::size_t count() const { return g_allocations; }
+};
+
+base::Expression term(const std::string& name, bool result = true)
+{
+    return base::Term<base::EngineOp>::create(name,
+                                              [result](base::Event e)
+                                              {
+                                                  return result ? base::result::makeSuccess(e, "")
+                                                                : base::result::makeFailure(e, "");
+                                              });
+}
+
+base::Expression filter(std::vector<base::Expression> terms)
+{
+    return base::And::create("filter/test/0", {base::And::create("condition", std::move(terms))});
+}
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    if (g_countAllocations)
+    {
+        ++g_allocations;
+    }
+
+    if (auto* ptr = std::malloc(size == 0 ? 1 : size))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc {};
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+TEST(FilterProgramTest, ParseHelperTerm)
+{
+    auto term = parseHelperTerm("agent.id: string_equal(\"001\")");
+    ASSERT_TRUE(term);
+    EXPECT_EQ(term->jsonPath, "/agent/id");
+    EXPECT_EQ(term->helper, "string_equal");
+    EXPECT_EQ(term->args, "\"001\"");
+
+    term = parseHelperTerm("agent.id: exists");
+    ASSERT_TRUE(term);
+    EXPECT_EQ(term->helper, "exists");
+    EXPECT_TRUE(term->args.empty());
+
+    EXPECT_FALSE(parseHelperTerm("AcceptAll"));
+    EXPECT_FALSE(parseHelperTerm("agent.id: int_equal(1"));
+}
+
+TEST(FilterProgramTest, NullFilterAccepts)
+{
+    FilterProgram program(nullptr);
+    EXPECT_TRUE(program.eval(std::make_shared<json::Json>(R"({})")));
+}
+
+TEST(FilterProgramTest, CompiledHelpers)
+{
+    FilterProgram program(filter({term("wazuh.queue: filter(49)", false),
+                                  term("wazuh.origin: filter($wazuh.location)", false),
+                                  term("agent.id: string_equal(\"001\")", false),
+                                  term("agent.version: int_equal(4)", false),
+                                  term("agent.name: exists", false),
+                                  term("agent.groups: not_exists", false)}));
+    EXPECT_EQ(program.fallbacks(), 0);
+
+    auto event = std::make_shared<json::Json>(
+        R"({"wazuh": {"queue": 49, "origin": "x", "location": "x"}, "agent": {"id": "001", "version": 4, "name": "a"}})");
+    EXPECT_TRUE(program.eval(event));
+
+    event->setString("y", "/wazuh/location");
+    EXPECT_FALSE(program.eval(event));
+    event->setString("x", "/wazuh/location");
+
+    event->setInt(1, "/agent/id");
+    EXPECT_FALSE(program.eval(event));
+    event->setString("001", "/agent/id");
+
+    event->setDouble(4.0, "/agent/version");
+    EXPECT_FALSE(program.eval(event));
+    event->setInt(4, "/agent/version");
+
+    event->setArray("/agent/groups");
+    EXPECT_FALSE(program.eval(event));
+    event->erase("/agent/groups");
+
+    event->erase("/agent/name");
+    EXPECT_FALSE(program.eval(event));
+}
+
+TEST(FilterProgramTest, CompiledHelpersDoNotAllocate)
+{
+    FilterProgram program(base::Or::create("or",
+                                           {filter({term("wazuh.queue: filter(50)"), term("agent.id: exists")}),
+                                            filter({term("wazuh.queue: int_equal(49)"),
+                                                    term("agent.id: string_equal(\"001\")"),
+                                                    term("wazuh.origin: filter($wazuh.location)")})}));
+    ASSERT_EQ(program.fallbacks(), 0);
+
+    auto event = std::make_shared<json::Json>(
+        R"({"wazuh": {"queue": 49, "origin": "x", "location": "x"}, "agent": {"id": "001"}})");
+
+    bool accepted = false;
+    std::size_t allocations = 0;
+    {
+        AllocationCounter counter;
+        accepted = program.eval(event);
+        allocations = counter.count();
+    }
+    EXPECT_TRUE(accepted);
+    EXPECT_EQ(allocations, 0);
+}
+
+TEST(FilterProgramTest, FallbackTerms)
+{
+    FilterProgram accept(filter({term("wazuh.queue: filter(49)"), term("wazuh.location: starts_with(\"/var\")")}));
+    FilterProgram reject(filter({term("wazuh.queue: filter(49)"), term("AcceptAll", false)}));
+    FilterProgram refs(filter({term("agent.id: string_equal($other.id)", false)}));
+    EXPECT_EQ(accept.fallbacks(), 1);
+    EXPECT_EQ(reject.fallbacks(), 1);
+    EXPECT_EQ(refs.fallbacks(), 1);
+
+    auto event = std::make_shared<json::Json>(R"({"wazuh": {"queue": 49}})");
+    EXPECT_TRUE(accept.eval(event));
+    EXPECT_FALSE(reject.eval(event));
+    EXPECT_FALSE(refs.eval(event));
+}
+
+TEST(FilterProgramTest, Operations)
+{
+    auto implication = base::Implication::create("implication", term("agent.id: exists"), term("AcceptAll", false));
+    auto broadcast = base::Broadcast::create("broadcast", {term("AcceptAll", false)});
+    auto chain = base::Chain::create("chain", {term("agent.id: exists")});
+
+    auto event = std::make_shared<json::Json>(R"({"agent": {"id": "001"}})");
+    EXPECT_TRUE(FilterProgram(implication).eval(event));
+    EXPECT_TRUE(FilterProgram(broadcast).eval(event));
+    EXPECT_TRUE(FilterProgram(chain).eval(event));
+
+    event->erase("/agent/id");
+    EXPECT_FALSE(FilterProgram(implication).eval(event));
+}
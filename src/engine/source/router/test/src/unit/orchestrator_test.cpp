@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 
+#include <queue/mockQueue.hpp>
 #include <store/mockStore.hpp>
 
 #include <router/orchestrator.hpp>
@@ -34,6 +35,8 @@ public:
     }
 
 
+    void setEventQueue(std::shared_ptr<ProdQueueType> queue) { m_eventQueue = std::move(queue); }
+
     auto addMockWorker() -> std::shared_ptr<MockWorker>
     {
         auto workerMock = std::make_shared<MockWorker>();
@@ -863,3 +866,22 @@ TEST_F(OrchestratorTest, postStrEventFailtureInProtocol)
 {
     EXPECT_TRUE(base::isError(m_orchestrator->postStrEvent("message:1:any")));
 }
+
+TEST_F(OrchestratorTest, pushEventsBulk)
+{
+    auto queue = std::make_shared<queue::mocks::MockQueue<base::Event>>();
+    m_orchestrator->setEventQueue(queue);
+
+    // The events that cannot be parsed are discarded, the rest are pushed at once
+    EXPECT_CALL(*queue, pushBulk(testing::_))
+        .WillOnce(testing::Invoke(
+            [](std::vector<base::Event>& events)
+            {
+                ASSERT_EQ(events.size(), 2);
+                EXPECT_EQ(events[0]->getString("/event/original"), "first");
+                EXPECT_EQ(events[1]->getString("/event/original"), "second");
+                events.clear();
+            }));
+
+    m_orchestrator->pushEvents({"1:location:first", "invalid", "1:location:second"});
+}
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include "routeIndex.hpp"
+
+using namespace router::internal;
+
+namespace
+{
+base::Expression term(const std::string& name)
+{
+    return base::Term<base::EngineOp>::create(name, [](base::Event e) { return base::result::makeSuccess(e, ""); });
+}
+
+base::Expression filter(std::vector<base::Expression> terms)
+{
+    return base::And::create("filter/test/0", {base::And::create("condition", std::move(terms))});
+}
+
+struct Route
+{
+    std::string name;
+};
+} // namespace
+
+TEST(RouteIndexTest, ExtractEqualityPredicates)
+{
+    auto expr = filter({term("wazuh.queue: filter(49)"),
+                        term("agent.id: string_equal(\"001\")"),
+                        term("wazuh.location: starts_with(\"/var/log\")"),
+                        term("agent.name: filter($other.field)"),
+                        term("AcceptAll")});
+
+    auto predicates = extractEqualityPredicates(expr);
+    ASSERT_EQ(predicates.size(), 2);
+    EXPECT_EQ(predicates[0].jsonPath, "/wazuh/queue");
+    EXPECT_EQ(predicates[0].key, "i49");
+    EXPECT_EQ(predicates[1].jsonPath, "/agent/id");
+    EXPECT_EQ(predicates[1].key, "s001");
+}
+
+TEST(RouteIndexTest, ExtractIgnoresDisjunctions)
+{
+    auto expr = base::Or::create("or", {term("wazuh.queue: filter(49)"), term("wazuh.queue: filter(50)")});
+    EXPECT_TRUE(extractEqualityPredicates(expr).empty());
+    EXPECT_TRUE(extractEqualityPredicates(nullptr).empty());
+}
+
+TEST(RouteIndexTest, Candidates)
+{
+    Route r1 {"r1"}, r2 {"r2"}, r3 {"r3"};
+    RouteIndex<Route> index;
+    index.build({{&r1, {{"/wazuh/queue", "i49"}}}, {&r2, {}}, {&r3, {{"/wazuh/queue", "i50"}}}});
+    ASSERT_EQ(index.field(), "/wazuh/queue");
+
+    auto event = std::make_shared<json::Json>(R"({"wazuh": {"queue": 49}})");
+    EXPECT_EQ(index.candidates(event), (std::vector<const Route*> {&r1, &r2}));
+
+    event = std::make_shared<json::Json>(R"({"wazuh": {"queue": 50}})");
+    EXPECT_EQ(index.candidates(event), (std::vector<const Route*> {&r2, &r3}));
+
+    // Unknown value and missing field: only the routes that do not test the field
+    event = std::make_shared<json::Json>(R"({"wazuh": {"queue": 51}})");
+    EXPECT_EQ(index.candidates(event), (std::vector<const Route*> {&r2}));
+    event = std::make_shared<json::Json>(R"({"wazuh": {}})");
+    EXPECT_EQ(index.candidates(event), (std::vector<const Route*> {&r2}));
+
+    // Values that cannot be indexed fall back to all the routes
+    event = std::make_shared<json::Json>(R"({"wazuh": {"queue": 49.0}})");
+    EXPECT_EQ(index.candidates(event), (std::vector<const Route*> {&r1, &r2, &r3}));
+}
+
+TEST(RouteIndexTest, NoIndexWithoutSharedField)
+{
+    Route r1 {"r1"}, r2 {"r2"};
+    RouteIndex<Route> index;
+    index.build({{&r1, {{"/wazuh/queue", "i49"}}}, {&r2, {{"/agent/id", "s001"}}}});
+    EXPECT_TRUE(index.field().empty());
+
+    auto event = std::make_shared<json::Json>(R"({"wazuh": {"queue": 50}})");
+    EXPECT_EQ(index.candidates(event), (std::vector<const Route*> {&r1, &r2}));
+}
@@ -328,6 +328,17 @@ TEST_F(RouterTest, ChangePriorityAlreadyInUse)
     EXPECT_FALSE(changePriority(ENVIRONMENT_NAME, PRIORITY + 1));
 }
 
+TEST_F(RouterTest, ChangePriorityPromotesShadow)
+{
+    auto entryPost = router::prod::EntryPost {ENVIRONMENT_NAME, POLICY_NAME, FILTER_NAME, PRIORITY};
+    entryPost.shadowRate(0.5);
+    addEntry(entryPost);
+    EXPECT_TRUE(std::get<router::prod::Entry>(m_router->getEntry(ENVIRONMENT_NAME)).isShadow());
+
+    EXPECT_TRUE(changePriority(ENVIRONMENT_NAME, PRIORITY + 1));
+    EXPECT_FALSE(std::get<router::prod::Entry>(m_router->getEntry(ENVIRONMENT_NAME)).isShadow());
+}
+
 TEST_F(RouterTest, GetEntryNameNotFound)
 {
     EXPECT_FALSE(getEntry(ENVIRONMENT_NAME));
@@ -367,3 +378,74 @@ TEST_F(RouterTest, IngestSuccess)
 
     EXPECT_TRUE(ingestEvent());
 }
+
+TEST_F(RouterTest, IngestRecyclesEvents)
+{
+    auto eventPool = std::make_shared<router::EventPool>();
+    auto environmentBuilder = std::make_shared<router::EnvironmentBuilder>(m_mockBuilder, m_mockControllerMaker);
+    m_router = std::make_shared<router::Router>(environmentBuilder, nullptr, eventPool);
+
+    auto entryPost = router::prod::EntryPost {ENVIRONMENT_NAME, POLICY_NAME, FILTER_NAME, PRIORITY};
+    addEntry(entryPost);
+    enableEntry(ENVIRONMENT_NAME);
+
+    // The processed event is taken back from the controller and given to the pool
+    EXPECT_CALL(*m_mockController, ingestGet(testing::_))
+        .WillOnce(testing::Invoke([](base::Event&& event) { return std::move(event); }));
+    m_router->ingest(std::make_shared<json::Json>(R"({"key": "value"})"));
+
+    EXPECT_EQ(eventPool->size(), 1);
+    EXPECT_TRUE(eventPool->acquire()->isNull());
+}
+
+TEST_F(RouterTest, IngestShadowSample)
+{
+    auto entryPost = router::prod::EntryPost {ENVIRONMENT_NAME, POLICY_NAME, FILTER_NAME, PRIORITY};
+    addEntry(entryPost, false);
+    auto shadowPost = router::prod::EntryPost {ENVIRONMENT_NAME + "shadow", POLICY_NAME, FILTER_NAME, PRIORITY + 1};
+    shadowPost.shadowRate(0.5);
+    addEntry(shadowPost, false);
+    stopControllerCall(2);
+
+    enableEntry(ENVIRONMENT_NAME);
+    enableEntry(ENVIRONMENT_NAME + "shadow");
+
+    // Every event is routed, half of them are also cloned into the shadow and left untouched by it
+    EXPECT_CALL(*m_mockController, ingest(testing::_)).Times(4);
+    EXPECT_CALL(*m_mockController, ingestGet(testing::_))
+        .Times(2)
+        .WillRepeatedly(testing::Invoke(
+            [](base::Event&& event)
+            {
+                event->setString("shadow", "/key");
+                return std::move(event);
+            }));
+
+    for (auto i = 0; i < 4; ++i)
+    {
+        auto event = std::make_shared<json::Json>(R"({"key": "value"})");
+        auto original = event;
+        m_router->ingest(std::move(event));
+        EXPECT_EQ(original->getString("/key"), "value");
+    }
+}
+
+TEST_F(RouterTest, IngestBatchSuccess)
+{
+    auto entryPost = router::prod::EntryPost {ENVIRONMENT_NAME, POLICY_NAME, FILTER_NAME, PRIORITY};
+    addEntry(entryPost);
+
+    enableEntry(ENVIRONMENT_NAME);
+
+    std::vector<base::Event> batch {std::make_shared<json::Json>(R"({"key": "value1"})"),
+                                    nullptr,
+                                    std::make_shared<json::Json>(R"({"key": "value2"})")};
+    EXPECT_CALL(*m_mockController, ingest(testing::_)).Times(2);
+
+    m_router->ingestBatch(batch);
+
+    for (const auto& event : batch)
+    {
+        EXPECT_EQ(event, nullptr);
+    }
+}
@@ -4,6 +4,7 @@
 #include <experimental/propagate_const>
 #include <map>
 #include <string>
+#include <unordered_map>
 
 #include <schemf/field.hpp>
 #include <schemf/ischema.hpp>
@@ -21,9 +22,27 @@ private:
     std::map<std::string, Field> m_fields; ///< First level fields of the schema.
     class Validator;
     std::experimental::propagate_const<std::unique_ptr<Validator>> m_validator;
+    /// Handles of all the fields by path, resolved when the fields are added.
+    std::unordered_map<std::string, std::shared_ptr<const FieldHandle>> m_handles;
 
     Field get(const DotPath& name) const;
 
+    /**
+     * @brief Get the handle of a field added to the schema.
+     *
+     * @param name Dot-separated path to the field.
+     * @return const FieldHandle* nullptr if not added (i.e. not in the schema or an array item).
+     */
+    const FieldHandle* indexed(const DotPath& name) const;
+
+    /**
+     * @brief Resolve the handles of a field and its properties.
+     *
+     * @param name Dot-separated path to the field.
+     * @param field The field.
+     */
+    void indexField(const DotPath& name, const Field& field);
+
     /**
      * @brief Convert a field JSON entry to a Schema Field object.
      *
@@ -71,12 +90,12 @@ public:
     /**
      * @copydoc ISchema::getType
      */
-    inline Type getType(const DotPath& name) const override { return get(name).type(); }
+    Type getType(const DotPath& name) const override;
 
     /**
      * @copydoc ISchema::getJsonType
      */
-    inline json::Json::Type getJsonType(const DotPath& name) const override { return typeToJType(get(name).type()); }
+    json::Json::Type getJsonType(const DotPath& name) const override;
 
     /**
      * @copydoc ISchema::hasField
@@ -86,7 +105,7 @@ public:
     /**
      * @copydoc ISchema::isArray
      */
-    inline bool isArray(const DotPath& name) const override { return get(name).isArray(); }
+    bool isArray(const DotPath& name) const override;
 
     /**
      * @brief Load a schema from a JSON object, adding each field to the schema.
@@ -99,6 +118,17 @@ public:
      * @copydoc IValidator::validate
      */
     base::RespOrError<ValidationResult> validate(const DotPath& name, const ValidationToken& token) const override;
+
+    /**
+     * @copydoc IValidator::getField
+     */
+    std::shared_ptr<const FieldHandle> getField(const DotPath& name) const override;
+
+    /**
+     * @copydoc IValidator::validateField
+     */
+    base::RespOrError<ValidationResult> validateField(const FieldHandle& field,
+                                                      const ValidationToken& token) const override;
 };
 } // namespace schemf
 
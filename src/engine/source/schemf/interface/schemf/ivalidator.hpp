@@ -183,6 +183,60 @@ inline ValueValidator asArray(const ValueValidator& validator)
     };
 }
 
+/**
+ * @brief A schema field resolved once, holding its types and the validator of its values.
+ *
+ * Builders can keep the handle instead of the field name, so the later queries, the validation of the operations
+ * and the runtime validation do not look the field up again. The handle stays valid if the field is removed from the
+ * schema.
+ *
+ */
+class FieldHandle
+{
+private:
+    DotPath m_path;              ///< Path of the field.
+    Type m_type;                 ///< Schema type of the field.
+    json::Json::Type m_jsonType; ///< JSON type of the field.
+    bool m_isArray;              ///< Whether the field is an array.
+    ValueValidator m_validator;  ///< Validator for the values of the field, arrays included.
+
+public:
+    /**
+     * @brief Construct a new Field Handle.
+     *
+     * @param path Path of the field.
+     * @param type Schema type of the field.
+     * @param isArray Whether the field is an array.
+     * @param validator Validator for the values of the field (already wrapped with asArray if the field is an
+     * array), or nullptr if the values need no validation.
+     */
+    FieldHandle(const DotPath& path, Type type, bool isArray, const ValueValidator& validator)
+        : m_path(path)
+        , m_type(type)
+        , m_jsonType(typeToJType(type))
+        , m_isArray(isArray)
+        , m_validator(validator)
+    {
+    }
+
+    const DotPath& path() const { return m_path; }
+    Type type() const { return m_type; }
+    json::Json::Type jsonType() const { return m_jsonType; }
+    bool isArray() const { return m_isArray; }
+    const ValueValidator& validator() const { return m_validator; }
+
+    /**
+     * @brief Validate a value of the field.
+     *
+     * @param value The value.
+     * @return base::OptError
+     */
+    base::OptError validate(const json::Json& value) const
+    {
+        return m_validator ? m_validator(value) : base::noError();
+    }
+};
+
 /**
  * @brief Result of a build-time validation.
  *
@@ -222,6 +276,24 @@ public:
      * @return base::OptError
      */
     virtual base::RespOrError<ValidationResult> validate(const DotPath& name, const ValidationToken& token) const = 0;
+
+    /**
+     * @brief Get a handle to a field, resolving the field only once.
+     *
+     * @param name Name of the field.
+     * @return std::shared_ptr<const FieldHandle> The handle, or nullptr if the field is not in the schema.
+     */
+    virtual std::shared_ptr<const FieldHandle> getField(const DotPath& name) const = 0;
+
+    /**
+     * @brief Check if an operation is valid for a field already resolved.
+     *
+     * @param field Handle of the field.
+     * @param token Information about the operation intent on the field.
+     * @return base::RespOrError<ValidationResult>
+     */
+    virtual base::RespOrError<ValidationResult> validateField(const FieldHandle& field,
+                                                              const ValidationToken& token) const = 0;
 };
 
 /**
@@ -263,12 +335,13 @@ inline ValidationToken isNotArrayToken()
  */
 inline ValidationToken tokenFromReference(const DotPath& reference, const IValidator& validator)
 {
-    if (!validator.hasField(reference))
+    auto field = validator.getField(reference);
+    if (!field)
     {
         return runtimeValidation();
     }
 
-    return STypeToken::create(validator.getType(reference), validator.isArray(reference));
+    return STypeToken::create(field->type(), field->isArray());
 }
 
 } // namespace schemf
@@ -9,7 +9,7 @@ namespace schemf
 {
 
 Schema::Schema()
-    : m_validator(std::make_unique<Validator>(*this))
+    : m_validator(std::make_unique<Validator>())
 {
 }
 
@@ -32,6 +32,7 @@ void Schema::addField(const DotPath& name, const Field& field)
         if (entry == current->end())
         {
             current->emplace(*it, Field({.type = Type::OBJECT}));
+            indexField(DotPath(name.cbegin(), it + 1), current->at(*it));
             current = &current->at(*it).properties();
         }
         else
@@ -52,6 +53,27 @@ void Schema::addField(const DotPath& name, const Field& field)
     }
 
     current->emplace(name.parts().back(), field);
+    indexField(name, field);
+}
+
+void Schema::indexField(const DotPath& name, const Field& field)
+{
+    m_handles.insert_or_assign(name.str(), m_validator->makeHandle(name, field.type(), field.isArray()));
+    if (!hasProperties(field.type()))
+    {
+        return;
+    }
+
+    for (const auto& [key, property] : field.properties())
+    {
+        indexField(DotPath(name.str() + "." + key), property);
+    }
+}
+
+const FieldHandle* Schema::indexed(const DotPath& name) const
+{
+    auto it = m_handles.find(name.str());
+    return it == m_handles.end() ? nullptr : it->second.get();
 }
 
 void Schema::removeField(const DotPath& name)
@@ -81,6 +103,14 @@ void Schema::removeField(const DotPath& name)
     }
 
     current->erase(entry);
+
+    // Drop the handles of the field and its properties, the ones handed out stay valid
+    const auto prefix = name.str() + ".";
+    for (auto it = m_handles.begin(); it != m_handles.end();)
+    {
+        it = it->first == name.str() || it->first.compare(0, prefix.size(), prefix) == 0 ? m_handles.erase(it)
+                                                                                          : std::next(it);
+    }
 }
 
 Field Schema::get(const DotPath& name) const
@@ -134,8 +164,31 @@ Field Schema::get(const DotPath& name) const
     return *target;
 }
 
+Type Schema::getType(const DotPath& name) const
+{
+    const auto* handle = indexed(name);
+    return handle ? handle->type() : get(name).type();
+}
+
+json::Json::Type Schema::getJsonType(const DotPath& name) const
+{
+    const auto* handle = indexed(name);
+    return handle ? handle->jsonType() : typeToJType(get(name).type());
+}
+
+bool Schema::isArray(const DotPath& name) const
+{
+    const auto* handle = indexed(name);
+    return handle ? handle->isArray() : get(name).isArray();
+}
+
 bool Schema::hasField(const DotPath& name) const
 {
+    if (indexed(name))
+    {
+        return true;
+    }
+
     const auto* current = &m_fields;
     auto isParentSchema = false;
     for (auto it = name.cbegin(); it != name.cend(); ++it)
@@ -237,8 +290,40 @@ void Schema::load(const json::Json& json)
     }
 }
 
+std::shared_ptr<const FieldHandle> Schema::getField(const DotPath& name) const
+{
+    auto it = m_handles.find(name.str());
+    if (it != m_handles.end())
+    {
+        return it->second;
+    }
+
+    // Array items are not indexed
+    if (!hasField(name))
+    {
+        return nullptr;
+    }
+
+    auto field = get(name);
+    return m_validator->makeHandle(name, field.type(), field.isArray());
+}
+
 base::RespOrError<ValidationResult> Schema::validate(const DotPath& name, const ValidationToken& token) const
 {
-    return m_validator->validate(name, token);
+    auto field = getField(name);
+
+    // If not a schema field, allways return success with no runtime validator
+    if (!field)
+    {
+        return ValidationResult();
+    }
+
+    return m_validator->validate(*field, token);
+}
+
+base::RespOrError<ValidationResult> Schema::validateField(const FieldHandle& field,
+                                                          const ValidationToken& token) const
+{
+    return m_validator->validate(field, token);
 }
 } // namespace schemf
@@ -84,25 +84,37 @@ void Schema::Validator::registerCompatibles()
                           ValidationInfo {json::Json::Type::Object, validators::getObjectValidator(), {}});
 }
 
-base::RespOrError<ValidationResult> Schema::Validator::validate(const DotPath& name, const JTypeToken& token) const
+std::shared_ptr<const FieldHandle> Schema::Validator::makeHandle(const DotPath& name, Type type, bool isArray) const
 {
-    const auto& entry = m_compatibles.at(m_schema.getType(name));
+    ValueValidator validator;
+    auto entry = m_compatibles.find(type);
+    if (entry != m_compatibles.end())
+    {
+        validator = isArray ? asArray(entry->second.validator) : entry->second.validator;
+    }
+
+    return std::make_shared<const FieldHandle>(name, type, isArray, validator);
+}
+
+base::RespOrError<ValidationResult> Schema::Validator::validate(const FieldHandle& field, const JTypeToken& token) const
+{
+    const auto& entry = m_compatibles.at(field.type());
 
     if (entry.type != token.type())
     {
         return base::Error {fmt::format("Operation expects a JSON type '{}', but field '{}' is of JSON type '{}'",
                                         json::Json::typeToStr(token.type()),
-                                        name,
+                                        field.path(),
                                         json::Json::typeToStr(entry.type))};
     }
 
     // When validating json types, if the schema type has a validator, use it.
-    return ValidationResult(token.isArray() ? asArray(entry.validator) : entry.validator);
+    return ValidationResult(field.validator());
 }
 
-base::RespOrError<ValidationResult> Schema::Validator::validate(const DotPath& name, const STypeToken& token) const
+base::RespOrError<ValidationResult> Schema::Validator::validate(const FieldHandle& field, const STypeToken& token) const
 {
-    auto sType = m_schema.getType(name);
+    auto sType = field.type();
     // If same schema type return success with no runtime validator
     if (sType == token.type())
     {
@@ -117,7 +129,7 @@ base::RespOrError<ValidationResult> Schema::Validator::validate(const DotPath& n
     {
         if (compatible->second)
         {
-            return ValidationResult(token.isArray() ? asArray(entry.validator) : entry.validator);
+            return ValidationResult(field.validator());
         }
 
         return ValidationResult();
@@ -126,75 +138,56 @@ base::RespOrError<ValidationResult> Schema::Validator::validate(const DotPath& n
     return base::Error {
         fmt::format("Operation expects schema type '{}', but field '{}' is of incompatible schema type '{}'",
                     typeToStr(token.type()),
-                    name,
+                    field.path(),
                     typeToStr(sType))};
 }
 
-base::RespOrError<ValidationResult> Schema::Validator::validate(const DotPath& name, const ValueToken& token) const
+base::RespOrError<ValidationResult> Schema::Validator::validate(const FieldHandle& field, const ValueToken& token) const
 {
-    const auto& entry = m_compatibles.at(m_schema.getType(name));
-
     // When validating json values, if the schema type has a validator, validate the value
-    if (entry.validator)
+    auto res = field.validate(token.value());
+    if (base::isError(res))
     {
-        auto validator = token.isArray() ? asArray(entry.validator) : entry.validator;
-        auto res = validator(token.value());
-
-        if (base::isError(res))
-        {
-            return base::Error {fmt::format("Field '{}' value validation failed: {}", name, res.value().message)};
-        }
+        return base::Error {fmt::format("Field '{}' value validation failed: {}", field.path(), res.value().message)};
     }
 
     // If the value is valid, return success with no runtime validator
     return ValidationResult();
 }
 
-base::RespOrError<ValidationResult> Schema::Validator::validate(const DotPath& name, const ValidationToken& token) const
+base::RespOrError<ValidationResult> Schema::Validator::validate(const FieldHandle& field,
+                                                                const ValidationToken& token) const
 {
-
-    // If not a schema field, allways return success with no runtime validator
-    if (!m_schema.hasField(name))
-    {
-        return ValidationResult();
-    }
-
     // If no token, runtime validation only
     if (!token)
     {
-        auto sType = m_schema.getType(name);
-        const auto& entry = m_compatibles.at(sType);
-        auto validator = m_schema.isArray(name) ? asArray(entry.validator) : entry.validator;
-        return ValidationResult(validator);
+        return ValidationResult(field.validator());
     }
 
     // If array missmatch, return error
-    if (m_schema.isArray(name) != token->isArray())
+    if (field.isArray() != token->isArray())
     {
         return base::Error {fmt::format("Operation expects {}, but field '{}' is{}",
                                         token->isArray() ? "an array" : "a non-array",
-                                        name,
-                                        m_schema.isArray(name) ? "" : " not")};
+                                        field.path(),
+                                        field.isArray() ? "" : " not")};
     }
 
     // Call the appropriate validation function based on the token type
     if (token->isJType())
     {
-        return validate(name, *std::static_pointer_cast<JTypeToken>(token));
+        return validate(field, *std::static_pointer_cast<JTypeToken>(token));
     }
     if (token->isSType())
     {
-        return validate(name, *std::static_pointer_cast<STypeToken>(token));
+        return validate(field, *std::static_pointer_cast<STypeToken>(token));
     }
     if (token->isValue())
     {
-        return validate(name, *std::static_pointer_cast<ValueToken>(token));
+        return validate(field, *std::static_pointer_cast<ValueToken>(token));
     }
 
     // Base token do not perform build validation aside from array missmatch, return success with runtime validator
-    auto sType = m_schema.getType(name);
-    const auto& entry = m_compatibles.at(sType);
-    auto validator = m_schema.isArray(name) ? asArray(entry.validator) : entry.validator;
-    return ValidationResult(validator);
+    return ValidationResult(field.validator());
 }
 } // namespace schemf
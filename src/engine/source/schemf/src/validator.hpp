@@ -20,22 +20,27 @@ class Schema::Validator
 {
 private:
     std::unordered_map<schemf::Type, ValidationInfo> m_compatibles;
-    const Schema& m_schema;
 
     void registerCompatibles();
 
-    base::RespOrError<ValidationResult> validate(const DotPath& name, const JTypeToken& token) const;
-    base::RespOrError<ValidationResult> validate(const DotPath& name, const STypeToken& token) const;
-    base::RespOrError<ValidationResult> validate(const DotPath& name, const ValueToken& token) const;
+    base::RespOrError<ValidationResult> validate(const FieldHandle& field, const JTypeToken& token) const;
+    base::RespOrError<ValidationResult> validate(const FieldHandle& field, const STypeToken& token) const;
+    base::RespOrError<ValidationResult> validate(const FieldHandle& field, const ValueToken& token) const;
 
 public:
     ~Validator() = default;
-    Validator(const Schema& schema)
-        : m_schema(schema)
-    {
-        registerCompatibles();
-    }
+    Validator() { registerCompatibles(); }
 
-    base::RespOrError<ValidationResult> validate(const DotPath& name, const ValidationToken& token) const;
+    /**
+     * @brief Resolve the validation of a field.
+     *
+     * @param name Dot-separated path to the field.
+     * @param type Schema type of the field.
+     * @param isArray Whether the field is an array.
+     * @return std::shared_ptr<const FieldHandle>
+     */
+    std::shared_ptr<const FieldHandle> makeHandle(const DotPath& name, Type type, bool isArray) const;
+
+    base::RespOrError<ValidationResult> validate(const FieldHandle& field, const ValidationToken& token) const;
 };
 } // namespace schemf
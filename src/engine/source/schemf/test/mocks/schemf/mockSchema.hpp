@@ -19,6 +19,11 @@ public:
                 validate,
                 (const DotPath& name, const ValidationToken& token),
                 (const, override));
+    MOCK_METHOD(std::shared_ptr<const FieldHandle>, getField, (const DotPath& name), (const, override));
+    MOCK_METHOD(base::RespOrError<ValidationResult>,
+                validateField,
+                (const FieldHandle& field, const ValidationToken& token),
+                (const, override));
 };
 } // namespace schemf::mocks
 
@@ -164,3 +164,71 @@ TEST(SchemaTest, ArrayItem)
     ASSERT_THROW(schema.getType("a.n"), std::runtime_error);
     ASSERT_THROW(schema.getJsonType("a.n"), std::runtime_error);
 }
+
+TEST(SchemaTest, FieldHandle)
+{
+    Schema schema;
+    schema.addField("a.b", {Type::IP});
+    schema.addField("c", {Type::LONG, true});
+
+    auto parent = schema.getField("a");
+    ASSERT_NE(parent, nullptr);
+    ASSERT_EQ(parent->type(), Type::OBJECT);
+
+    auto ip = schema.getField("a.b");
+    ASSERT_NE(ip, nullptr);
+    ASSERT_EQ(ip->path(), DotPath("a.b"));
+    ASSERT_EQ(ip->type(), Type::IP);
+    ASSERT_EQ(ip->jsonType(), json::Json::Type::String);
+    ASSERT_FALSE(ip->isArray());
+    ASSERT_FALSE(base::isError(ip->validate(json::Json {R"("192.168.0.1")"})));
+    ASSERT_TRUE(base::isError(ip->validate(json::Json {R"("not an ip")"})));
+
+    // Resolved once, the same handle is returned
+    ASSERT_EQ(ip, schema.getField("a.b"));
+
+    auto longs = schema.getField("c");
+    ASSERT_NE(longs, nullptr);
+    ASSERT_TRUE(longs->isArray());
+    ASSERT_FALSE(base::isError(longs->validate(json::Json {R"([1, 2])"})));
+    ASSERT_TRUE(base::isError(longs->validate(json::Json {R"(1)"})));
+
+    // Array items are resolved on demand
+    auto item = schema.getField("c.0");
+    ASSERT_NE(item, nullptr);
+    ASSERT_EQ(item->type(), Type::LONG);
+    ASSERT_FALSE(item->isArray());
+
+    ASSERT_EQ(schema.getField("d"), nullptr);
+}
+
+TEST(SchemaTest, FieldHandleAfterRemove)
+{
+    Schema schema;
+    schema.addField("a.b.c", {Type::KEYWORD});
+    auto handle = schema.getField("a.b.c");
+
+    schema.removeField("a.b");
+    ASSERT_THROW(schema.getField("a.b"), std::runtime_error);
+    ASSERT_THROW(schema.getField("a.b.c"), std::runtime_error);
+
+    // The handle outlives the field
+    ASSERT_EQ(handle->type(), Type::KEYWORD);
+    ASSERT_NE(schema.getField("a"), nullptr);
+}
+
+TEST(SchemaTest, ValidateField)
+{
+    Schema schema;
+    schema.addField("a", {Type::INTEGER});
+    auto handle = schema.getField("a");
+
+    auto result = schema.validateField(*handle, STypeToken::create(Type::LONG));
+    ASSERT_FALSE(base::isError(result));
+    ASSERT_TRUE(base::getResponse<ValidationResult>(result).needsRuntimeValidation());
+
+    ASSERT_TRUE(base::isError(schema.validateField(*handle, STypeToken::create(Type::KEYWORD))));
+    ASSERT_TRUE(base::isError(schema.validateField(*handle, isArrayToken())));
+    ASSERT_FALSE(base::isError(schema.validateField(*handle, ValueToken::create(json::Json {"1"}))));
+    ASSERT_TRUE(base::isError(schema.validateField(*handle, ValueToken::create(json::Json {R"("1")"}))));
+}
@@ -3,10 +3,16 @@
 
 #include <functional>
 #include <memory>
+#include <string>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/uio.h>
 
 #include <metrics/iMetricsManager.hpp>
 
 #include <server/endpoint.hpp>
+#include <server/workerPool.hpp>
 
 namespace engineserver::endpoint
 {
@@ -18,12 +24,15 @@ namespace engineserver::endpoint
  *
  * If the taskQueueSize is set to 0, the callback function will be called in the same thread as the one that received
  * the message. If the taskQueueSize is set to a value greater than 0, the callback function will be called in a
- * thread from a thread pool. If the queue is full, the handle will be paused and the message will enqueue until a slot
- * is available. If the client is configured as blocking, the client will be blocked until a slot in the queue is
- * available. If the client is configured as non-blocking, the client will receive a "Resource temporarily unavailable"
- * error. The size of the thread pool is defined by the taskQueueSize parameter.
+ * thread from the worker pool of the endpoint. If the queue is full, the handle will be paused and the message will
+ * enqueue until a slot is available. If the client is configured as blocking, the client will be blocked until a slot
+ * in the queue is available. If the client is configured as non-blocking, the client will receive a "Resource temporarily unavailable"
+ * error. The size of the queue is defined by the taskQueueSize parameter and the threads by the workers parameter.
+ *
+ * In batch mode, each time the socket is readable the endpoint drains up to batchSize datagrams with a single
+ * recvmmsg call and the batch callback is called once with all of them, as a single task if the thread pool is used.
  *
- * @note The thread pool is shared between all the endpoints.
+ * @note The worker pool is not shared with libuv nor with other endpoints, it lives while the endpoint is bound.
  * @note Currently responses are not implemented, so the callback function must not return a string.
  */
 class UnixDatagram : public Endpoint
@@ -33,6 +42,18 @@ private:
     std::shared_ptr<uvw::UDPHandle> m_handle;      ///< Handle to the socket
     int m_bufferSize;                              ///< Size of the receive buffer
 
+    std::function<void(const std::vector<std::string>&)> m_batchCallback; ///< Callback for a batch of messages
+
+    std::size_t m_batchSize;             ///< Maximum messages received at once (1 = no batching)
+    int m_socketFd;                      ///< Socket file descriptor, -1 if not bound
+    std::vector<char> m_batchBuffer;     ///< Receive buffers of the batch
+    std::vector<iovec> m_batchIovecs;    ///< Receive vectors of the batch
+    std::vector<mmsghdr> m_batchHeaders; ///< Receive headers of the batch
+
+    std::size_t m_workers;                           ///< Threads of the worker pool
+    std::unique_ptr<WorkerPool> m_pool;              ///< Runs the callbacks, null if synchronous or not bound
+    std::shared_ptr<uvw::AsyncHandle> m_resumeAsync; ///< Resumes listening from the worker pool
+
     struct Metric {
         std::shared_ptr<metricsManager::IMetricsScope> m_metricsScope;     ///< Metrics scope for the endpoint
         std::shared_ptr<metricsManager::iCounter<uint64_t>> m_byteRecv;    ///< Counter for the total requests
@@ -54,6 +75,29 @@ private:
      */
     int bindUnixDatagramSocket(int& bufferSize);
 
+    /**
+     * @brief Validate the configuration and create the metrics instruments.
+     *
+     * @throw std::runtime_error if the address or the workers are not valid.
+     */
+    void init(std::shared_ptr<metricsManager::IMetricsScope> metricsScope,
+              std::shared_ptr<metricsManager::IMetricsScope> metricsScopeDelta);
+
+    /**
+     * @brief Run a task in the loop thread, or in the worker pool if there is a task queue.
+     *
+     * @param task The task, the exceptions are logged.
+     */
+    void dispatch(std::function<void()>&& task);
+
+    /**
+     * @brief Receive the pending messages of the socket, without blocking, until the batch is full.
+     *
+     * @param batch The batch where the messages are appended.
+     * @return std::size_t The bytes received.
+     */
+    std::size_t receiveBatch(std::vector<std::string>& batch);
+
 public:
     /**
      * @brief Create a Unix Datagram object
@@ -62,13 +106,34 @@ public:
      * @param callback Callback function to be called when a message is received
      * @param metricsScope Metrics scope for the endpoint
      * @param metricsScopeDelta Metrics scope for the endpoint rate
-     * @param taskQueueSize Size of the queue of tasks to be processed by the thread pool
+     * @param taskQueueSize Size of the queue of tasks to be processed by the worker pool
+     * @param workers Threads of the worker pool, unused if taskQueueSize is 0
      */
     UnixDatagram(const std::string& address,
                  const std::function<void(const std::string&)>& callback,
                  std::shared_ptr<metricsManager::IMetricsScope> metricsScope,
                  std::shared_ptr<metricsManager::IMetricsScope> metricsScopeDelta,
-                 const std::size_t taskQueueSize = 0);
+                 const std::size_t taskQueueSize = 0,
+                 std::size_t workers = 1);
+
+    /**
+     * @brief Create a Unix Datagram object in batch mode
+     *
+     * @param address Path to the socket
+     * @param batchCallback Callback function to be called with the messages received at once
+     * @param batchSize Maximum number of messages received at once
+     * @param metricsScope Metrics scope for the endpoint
+     * @param metricsScopeDelta Metrics scope for the endpoint rate
+     * @param taskQueueSize Size of the queue of tasks to be processed by the worker pool
+     * @param workers Threads of the worker pool, unused if taskQueueSize is 0
+     */
+    UnixDatagram(const std::string& address,
+                 const std::function<void(const std::vector<std::string>&)>& batchCallback,
+                 std::size_t batchSize,
+                 std::shared_ptr<metricsManager::IMetricsScope> metricsScope,
+                 std::shared_ptr<metricsManager::IMetricsScope> metricsScopeDelta,
+                 const std::size_t taskQueueSize = 0,
+                 std::size_t workers = 1);
 
     /**
      * @brief Construct a new Unix Datagram object
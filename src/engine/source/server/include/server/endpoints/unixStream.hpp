@@ -3,11 +3,13 @@
 
 #include <atomic>
 #include <functional>
+#include <memory>
 
 #include <metrics/iMetricsManager.hpp>
 
 #include <server/endpoint.hpp>
 #include <server/protocolHandler.hpp>
+#include <server/workerPool.hpp>
 
 namespace engineserver::endpoint
 {
@@ -19,12 +21,14 @@ namespace engineserver::endpoint
  *
  * If the taskQueueSize is set to 0, the callback function will be called in the same thread as the one that received
  * the message. If the taskQueueSize is set to a value greater than 0, the callback function will be enqueued and
- * called in a thread from a thread pool when a slot is available
+ * called in a thread from the worker pool of the endpoint when a slot is available
  * If the queue is full, drop the message and respond with an error from the protocol handler,
  * "resource temporarily unavailable"
  *
- * @note The thread pool is shared between all the endpoints.
- * @note Currently responses are not implemented, so the callback function must not return a string.
+ * The requests classified as slow (e.g. long-running API commands) can be sent to a separate pool, with its own
+ * threads and queue, so they cannot delay the rest of the requests.
+ *
+ * @note Each endpoint has its own worker pools, they are not shared with libuv nor with other endpoints.
  */
 class UnixStream : public Endpoint
 {
@@ -41,11 +45,17 @@ private:
         std::shared_ptr<metricsManager::iHistogram<uint64_t>> m_queueSize;     ///< Histogram for the queue size
         std::shared_ptr<metricsManager::iCounter<int64_t>> m_connectedClients; ///< Counter for the current clients
         std::shared_ptr<metricsManager::iCounter<uint64_t>> m_serverBusy;      ///< Counter for the server busy
+        std::shared_ptr<metricsManager::iHistogram<uint64_t>> m_slowQueueSize; ///< Histogram for the slow queue size
+        std::shared_ptr<metricsManager::iCounter<uint64_t>> m_slowServerBusy;  ///< Counter for the slow lane busy
 
         std::shared_ptr<metricsManager::IMetricsScope> m_metricsScopeDelta;     ///< Metrics scope for the endpoint rate
         std::shared_ptr<metricsManager::iCounter<uint64_t>> m_requestPerSecond; ///< Counter for the requests per second
     };
     Metric m_metric; ///< Metrics for the endpoint
+
+    std::function<bool(const std::string&)> m_isSlowRequest; ///< Classifies the requests of the slow lane, may be empty
+    std::unique_ptr<WorkerPool> m_pool;                      ///< Runs the requests, null if synchronous
+    std::unique_ptr<WorkerPool> m_slowPool;                  ///< Runs the slow requests, null if no slow lane
     /**
      * @brief Create a client
      *
@@ -80,8 +90,9 @@ private:
      * @param asyncs Array of AsyncHandler instance that will be used to send the event using send()
      * @param protocolHandler Protocol handler to process the message
      * @param request Message to be processed
+     * @return true if the task was enqueued, false if the queue of its lane is full
      */
-    void createAndEnqueueTask(std::weak_ptr<uvw::PipeHandle> wClient,
+    bool createAndEnqueueTask(std::weak_ptr<uvw::PipeHandle> wClient,
                               std::shared_ptr<std::vector<std::weak_ptr<uvw::AsyncHandle>>> asyncs,
                               std::shared_ptr<ProtocolHandler> protocolHandler,
                               std::string&& request);
@@ -117,15 +128,21 @@ public:
      * @param factory Factory to create protocol handlers for each client
      * @param metricsScope Metrics scope for the endpoint
      * @param metricsScopeDelta Metrics scope for the endpoint rate
-     * @param taskQueueSize Size of the queue of tasks to be processed by the thread pool
+     * @param taskQueueSize Size of the queue of tasks to be processed by the worker pool, of each lane
      * @param timeout Timeout for the connection in milliseconds
+     * @param workers Threads of the worker pool, unused if taskQueueSize is 0
+     * @param slowWorkers Threads of the slow lane, 0 to run all the requests in the same pool
+     * @param isSlowRequest Returns true for the requests of the slow lane, required if slowWorkers is greater than 0
      */
     UnixStream(const std::string& address,
                std::shared_ptr<ProtocolHandlerFactory> factory,
                std::shared_ptr<metricsManager::IMetricsScope> metricsScope,
                std::shared_ptr<metricsManager::IMetricsScope> metricsScopeDelta,
                const std::size_t taskQueueSize = 0,
-               std::size_t timeout = 5000);
+               std::size_t timeout = 5000,
+               std::size_t workers = 1,
+               std::size_t slowWorkers = 0,
+               std::function<bool(const std::string&)> isSlowRequest = nullptr);
     ~UnixStream();
 
     /**
@@ -0,0 +1,91 @@
+#ifndef _SERVER_WORKER_POOL_HPP
+#define _SERVER_WORKER_POOL_HPP
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace engineserver
+{
+/**
+ * @brief Fixed pool of threads with a bounded queue of tasks, owned by an endpoint.
+ *
+ * Each endpoint runs its tasks in its own pool instead of the thread pool of libuv, which is shared by all the loop
+ * handles, so a slow endpoint (or a slow kind of request) cannot delay the others. When the queue is full the tasks are
+ * refused, the endpoint decides how to apply the backpressure.
+ *
+ * The exceptions thrown by the tasks are logged. The tasks still queued when the pool is stopped are dropped.
+ */
+class WorkerPool
+{
+private:
+    std::string m_name;                        ///< Name of the pool, for the logs
+    std::size_t m_capacity;                    ///< Maximum tasks queued or running
+    mutable std::mutex m_mutex;                ///< Protects the queue
+    std::condition_variable m_cv;              ///< Wakes the threads when a task is queued or the pool stops
+    std::deque<std::function<void()>> m_tasks; ///< Tasks queued
+    std::size_t m_running {0};                 ///< Tasks being run
+    bool m_stopping {false};                   ///< The pool refuses new tasks
+    std::vector<std::thread> m_threads;        ///< Threads of the pool
+
+    void work();
+
+public:
+    /**
+     * @brief Construct a new Worker Pool and start its threads.
+     *
+     * @param name Name of the pool, for the logs.
+     * @param threads Number of threads.
+     * @param capacity Maximum tasks queued or running, the rest are refused.
+     * @throw std::runtime_error if the threads or the capacity are 0.
+     */
+    WorkerPool(const std::string& name, std::size_t threads, std::size_t capacity);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /**
+     * @brief Queue a task, unless the pool is full or stopped.
+     *
+     * @param task Task to run in a thread of the pool.
+     * @return true if the task was queued.
+     * @note Thread safe.
+     */
+    bool trySubmit(std::function<void()>&& task);
+
+    /**
+     * @brief Get the number of tasks queued or running.
+     *
+     * @return std::size_t
+     */
+    std::size_t pending() const;
+
+    /**
+     * @brief Get the maximum number of tasks queued or running.
+     *
+     * @return std::size_t
+     */
+    std::size_t capacity() const { return m_capacity; }
+
+    /**
+     * @brief Get the number of threads.
+     *
+     * @return std::size_t
+     */
+    std::size_t threads() const { return m_threads.size(); }
+
+    /**
+     * @brief Refuse new tasks, drop the queued ones and wait for the running ones. Idempotent.
+     *
+     * @note Must not be called from a task of the pool.
+     */
+    void stop();
+};
+} // namespace engineserver
+
+#endif // _SERVER_WORKER_POOL_HPP
@@ -1,5 +1,6 @@
 #include <server/endpoints/unixDatagram.hpp>
 
+#include <algorithm>
 #include <cstring>      // Unix  socket datagram bind
 #include <fcntl.h>      // Unix socket datagram bind
 #include <sys/socket.h> // Unix socket datagram bind
@@ -12,6 +13,7 @@
 namespace
 {
 constexpr unsigned int MAX_MSG_SIZE {65536 + 512}; ///< Maximum message size (TODO: I think this should be 65507)
+constexpr std::size_t MAX_BATCH_SIZE {1024};       ///< Maximum messages received at once in batch mode
 } // namespace
 
 namespace engineserver::endpoint
@@ -20,20 +22,71 @@ UnixDatagram::UnixDatagram(const std::string& address,
                            const std::function<void(const std::string&)>& callback,
                            std::shared_ptr<metricsManager::IMetricsScope> metricsScope,
                            std::shared_ptr<metricsManager::IMetricsScope> metricsScopeDelta,
-                           const std::size_t taskQueueSize)
+                           const std::size_t taskQueueSize,
+                           std::size_t workers)
     : Endpoint(address, taskQueueSize)
     , m_callback(callback)
     , m_handle(nullptr)
     , m_bufferSize(-1)
+    , m_batchCallback()
+    , m_batchSize(1)
+    , m_socketFd(-1)
+    , m_workers(workers)
 {
-    if (address.empty())
+    if (!callback)
+    {
+        throw std::runtime_error("Callback must be set");
+    }
+
+    init(std::move(metricsScope), std::move(metricsScopeDelta));
+}
+
+UnixDatagram::UnixDatagram(const std::string& address,
+                           const std::function<void(const std::vector<std::string>&)>& batchCallback,
+                           std::size_t batchSize,
+                           std::shared_ptr<metricsManager::IMetricsScope> metricsScope,
+                           std::shared_ptr<metricsManager::IMetricsScope> metricsScopeDelta,
+                           const std::size_t taskQueueSize,
+                           std::size_t workers)
+    : Endpoint(address, taskQueueSize)
+    , m_callback()
+    , m_handle(nullptr)
+    , m_bufferSize(-1)
+    , m_batchCallback(batchCallback)
+    , m_batchSize(batchSize)
+    , m_socketFd(-1)
+    , m_workers(workers)
+{
+    if (!batchCallback)
+    {
+        throw std::runtime_error("Callback must be set");
+    }
+
+    if (batchSize < 1 || batchSize > MAX_BATCH_SIZE)
+    {
+        throw std::runtime_error(fmt::format("Batch size must be between 1 and {}", MAX_BATCH_SIZE));
+    }
+
+    init(std::move(metricsScope), std::move(metricsScopeDelta));
+
+    // The first message of each batch is received by the handle, the rest by recvmmsg
+    const auto extra = m_batchSize - 1;
+    m_batchBuffer.resize(extra * MAX_MSG_SIZE);
+    m_batchIovecs.resize(extra);
+    m_batchHeaders.resize(extra);
+}
+
+void UnixDatagram::init(std::shared_ptr<metricsManager::IMetricsScope> metricsScope,
+                        std::shared_ptr<metricsManager::IMetricsScope> metricsScopeDelta)
+{
+    if (m_address.empty())
     {
         throw std::runtime_error("Address must not be empty");
     }
 
-    if (address.length() >= sizeof(sockaddr_un::sun_path))
+    if (m_address.length() >= sizeof(sockaddr_un::sun_path))
     {
-        auto msg = fmt::format("Path '{}' too long, maximum length is {} ", address, sizeof(sockaddr_un::sun_path));
+        auto msg = fmt::format("Path '{}' too long, maximum length is {} ", m_address, sizeof(sockaddr_un::sun_path));
         throw std::runtime_error(msg);
     }
 
@@ -42,21 +95,20 @@ UnixDatagram::UnixDatagram(const std::string& address,
         throw std::runtime_error("Address must start with '/'");
     }
 
-    if (!callback)
+    if (0 < m_taskQueueSize && 0 == m_workers)
     {
-        throw std::runtime_error("Callback must be set");
+        throw std::runtime_error("Workers must be greater than 0");
     }
 
     m_metric.m_metricsScope = std::move(metricsScope);
-    m_metric.m_byteRecv = m_metric.m_metricsScope->getCounterUInteger("BytesReceived");
-    m_metric.m_busyQueue = m_metric.m_metricsScope->getCounterUInteger("ServerBusy");
-    m_metric.m_queueSize = m_metric.m_metricsScope->getHistogramUInteger("UsedQueueHistory");
-    m_metric.m_eventSize = m_metric.m_metricsScope->getHistogramUInteger("EventSizeHistory");
+    m_metric.m_byteRecv = m_metric.m_metricsScope->getLocalCounterUInteger("BytesReceived");
+    m_metric.m_busyQueue = m_metric.m_metricsScope->getLocalCounterUInteger("ServerBusy");
+    m_metric.m_queueSize = m_metric.m_metricsScope->getLocalHistogramUInteger("UsedQueueHistory");
+    m_metric.m_eventSize = m_metric.m_metricsScope->getLocalHistogramUInteger("EventSizeHistory");
 
     m_metric.m_metricsScopeDelta = std::move(metricsScopeDelta);
-    m_metric.m_byteRecvPerSecond = m_metric.m_metricsScopeDelta->getCounterUInteger("BytesReceivedPerSeconds");
-    m_metric.m_eventPerSecond = m_metric.m_metricsScopeDelta->getCounterUInteger("EventsReceivedPerSeconds");
-
+    m_metric.m_byteRecvPerSecond = m_metric.m_metricsScopeDelta->getLocalCounterUInteger("BytesReceivedPerSeconds");
+    m_metric.m_eventPerSecond = m_metric.m_metricsScopeDelta->getLocalCounterUInteger("EventsReceivedPerSeconds");
 }
 
 UnixDatagram::~UnixDatagram()
@@ -64,6 +116,11 @@ UnixDatagram::~UnixDatagram()
     if (isBound())
     {
         // Close
+        if (m_pool)
+        {
+            m_pool->stop();
+            m_resumeAsync->close();
+        }
         m_handle->close();
         m_handle = nullptr;
         unlink(m_address.c_str());
@@ -85,6 +142,23 @@ void UnixDatagram::bind(std::shared_ptr<uvw::Loop> loop)
     m_handle->on<uvw::UDPDataEvent>(
         [this](const uvw::UDPDataEvent& event, uvw::UDPHandle& handle)
         {
+            if (m_batchSize > 1)
+            {
+                // Drain the socket and update the metrics once for all the batch
+                std::vector<std::string> batch {};
+                batch.reserve(m_batchSize);
+                batch.emplace_back(event.data.get(), event.length);
+                m_metric.m_eventSize->recordValue(event.length);
+                const auto bytes = event.length + receiveBatch(batch);
+
+                m_metric.m_byteRecv->addValue(bytes);
+                m_metric.m_byteRecvPerSecond->addValue(bytes);
+                m_metric.m_eventPerSecond->addValue(batch.size());
+
+                dispatch([this, batch = std::move(batch)]() { m_batchCallback(batch); });
+                return;
+            }
+
             // Get the data
             auto data = std::string {event.data.get(), event.length};
 
@@ -94,74 +168,7 @@ void UnixDatagram::bind(std::shared_ptr<uvw::Loop> loop)
             m_metric.m_eventPerSecond->addValue(1UL);
             m_metric.m_eventSize->recordValue(event.length);
 
-            // Call the callback if is synchronous
-            if (0 == m_taskQueueSize)
-            {
-                try
-                {
-                    m_callback(data);
-                }
-                catch (const std::exception& e)
-                {
-                    LOG_WARNING("[Endpoint: {}] Error calling the callback: {}", m_address, e.what());
-                }
-
-                return;
-            }
-
-            // Call the callback if is asynchronous, (TODO: Should be decrement the size of the workers?)
-            if (++m_currentTaskQueueSize >= m_taskQueueSize)
-
-            {
-                LOG_WARNING("[Endpoint: {}] Queue is full, pause listening.", m_address);
-                pause();
-                // Update metric
-                m_metric.m_busyQueue->addValue(1UL);
-            }
-            m_metric.m_queueSize->recordValue(m_currentTaskQueueSize.load());
-
-            // Create a job to the worker thread
-            std::shared_ptr<std::string> dataPtr {std::make_shared<std::string>(std::move(data))};
-            auto workerJob = m_loop->resource<uvw::WorkReq>(
-                [this, dataPtr]()
-                {
-                    try
-                    {
-                        m_callback(*dataPtr);
-                    }
-                    catch (const std::exception& e)
-                    {
-                        LOG_WARNING("[Endpoint: {}] Error calling the callback: {}", m_address, e.what());
-                    }
-                });
-
-            // Listen for the job completion
-            workerJob->on<uvw::WorkEvent>(
-                [this](const uvw::WorkEvent&, uvw::WorkReq& work)
-                {
-                    m_currentTaskQueueSize--;
-                    if (resume())
-                    {
-                        LOG_WARNING("[Endpoint: {}] Resume listening.", m_address);
-                    }
-                    m_metric.m_queueSize->recordValue(m_currentTaskQueueSize.load());
-
-                });
-
-            workerJob->on<uvw::ErrorEvent>(
-                [this](const uvw::ErrorEvent& error, uvw::WorkReq& work)
-                {
-                    LOG_WARNING(
-                        "[Endpoint: {}] Error calling the callback: {}", m_address, error.what(), error.code());
-                    m_currentTaskQueueSize--;
-                    if (resume())
-                    {
-                        LOG_WARNING("[Endpoint: {}] Resume listening.", m_address);
-                    }
-                    m_metric.m_queueSize->recordValue(m_currentTaskQueueSize.load());
-
-                });
-            workerJob->queue();
+            dispatch([this, data = std::move(data)]() mutable { m_callback(data); });
         });
 
     // Listen for errors
@@ -182,20 +189,138 @@ void UnixDatagram::bind(std::shared_ptr<uvw::Loop> loop)
             // Log the error
             LOG_INFO("[Endpoint: {}] Closed.", m_address);
         });
+    // Worker pool, resumes listening from the loop thread when a slot is available
+    if (0 < m_taskQueueSize)
+    {
+        m_pool = std::make_unique<WorkerPool>(m_address, m_workers, m_taskQueueSize);
+        m_resumeAsync = m_loop->resource<uvw::AsyncHandle>();
+        m_resumeAsync->on<uvw::AsyncEvent>(
+            [this](const uvw::AsyncEvent&, uvw::AsyncHandle&)
+            {
+                if (m_currentTaskQueueSize < m_taskQueueSize && resume())
+                {
+                    LOG_WARNING("[Endpoint: {}] Resume listening.", m_address);
+                }
+            });
+    }
+
     // Bind the socket
-    auto socketFd = bindUnixDatagramSocket(m_bufferSize);
-    m_handle->open(socketFd);
+    m_socketFd = bindUnixDatagramSocket(m_bufferSize);
+    m_handle->open(m_socketFd);
     resume();
 }
 
+void UnixDatagram::dispatch(std::function<void()>&& task)
+{
+    // Call the callback if is synchronous
+    if (0 == m_taskQueueSize)
+    {
+        try
+        {
+            task();
+        }
+        catch (const std::exception& e)
+        {
+            LOG_WARNING("[Endpoint: {}] Error calling the callback: {}", m_address, e.what());
+        }
+
+        return;
+    }
+
+    // Call the callback if is asynchronous, (TODO: Should be decrement the size of the workers?)
+    if (++m_currentTaskQueueSize >= m_taskQueueSize)
+
+    {
+        LOG_WARNING("[Endpoint: {}] Queue is full, pause listening.", m_address);
+        pause();
+        // Update metric
+        m_metric.m_busyQueue->addValue(1UL);
+    }
+    m_metric.m_queueSize->recordValue(m_currentTaskQueueSize.load());
+
+    // Queue the task in the worker pool, it cannot be full because the handle is paused before
+    auto job = [this, task = std::move(task)]()
+    {
+        try
+        {
+            task();
+        }
+        catch (const std::exception& e)
+        {
+            LOG_WARNING("[Endpoint: {}] Error calling the callback: {}", m_address, e.what());
+        }
+
+        // Only wake the loop if the handle may be paused
+        if (m_currentTaskQueueSize-- >= m_taskQueueSize)
+        {
+            m_resumeAsync->send();
+        }
+        m_metric.m_queueSize->recordValue(m_currentTaskQueueSize.load());
+    };
+
+    if (!m_pool->trySubmit(std::move(job)))
+    {
+        LOG_WARNING("[Endpoint: {}] Worker pool stopped, discarding the message.", m_address);
+        --m_currentTaskQueueSize;
+    }
+}
+
+std::size_t UnixDatagram::receiveBatch(std::vector<std::string>& batch)
+{
+    const auto wanted = std::min(m_batchSize - batch.size(), m_batchHeaders.size());
+    if (wanted == 0 || m_socketFd < 0)
+    {
+        return 0;
+    }
+
+    for (std::size_t i = 0; i < wanted; ++i)
+    {
+        m_batchIovecs[i].iov_base = m_batchBuffer.data() + i * MAX_MSG_SIZE;
+        m_batchIovecs[i].iov_len = MAX_MSG_SIZE;
+        m_batchHeaders[i] = {};
+        m_batchHeaders[i].msg_hdr.msg_iov = &m_batchIovecs[i];
+        m_batchHeaders[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    const auto received = recvmmsg(m_socketFd, m_batchHeaders.data(), wanted, MSG_DONTWAIT, nullptr);
+    if (received < 0)
+    {
+        if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+        {
+            LOG_WARNING("[Endpoint: {}] Cannot receive the batch: {} ({})", m_address, strerror(errno), errno);
+        }
+        return 0;
+    }
+
+    std::size_t bytes = 0;
+    for (int i = 0; i < received; ++i)
+    {
+        const auto length = m_batchHeaders[i].msg_len;
+        batch.emplace_back(m_batchBuffer.data() + i * MAX_MSG_SIZE, length);
+        m_metric.m_eventSize->recordValue(length);
+        bytes += length;
+    }
+
+    return bytes;
+}
+
 void UnixDatagram::close()
 {
     if (isBound())
     {
+        if (m_pool)
+        {
+            // Wait for the running tasks, they may wake the loop with the async handle
+            m_pool->stop();
+            m_pool.reset();
+            m_resumeAsync->close();
+            m_resumeAsync.reset();
+        }
         m_handle->close();
         m_handle.reset();
         m_loop.reset();
         m_running = false;
+        m_socketFd = -1;
     }
 }
 
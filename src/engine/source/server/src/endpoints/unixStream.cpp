@@ -13,11 +13,15 @@ UnixStream::UnixStream(const std::string& address,
                        std::shared_ptr<metricsManager::IMetricsScope> metricsScope,
                        std::shared_ptr<metricsManager::IMetricsScope> metricsScopeDelta,
                        const std::size_t taskQueueSize,
-                       std::size_t timeout)
+                       std::size_t timeout,
+                       std::size_t workers,
+                       std::size_t slowWorkers,
+                       std::function<bool(const std::string&)> isSlowRequest)
     : Endpoint(address, taskQueueSize)
     , m_handle(nullptr)
     , m_timeout(timeout)
     , m_factory(std::move(factory))
+    , m_isSlowRequest(std::move(isSlowRequest))
 {
     if (0 == m_timeout)
     {
@@ -50,15 +54,31 @@ UnixStream::UnixStream(const std::string& address,
         throw std::runtime_error("Address must start with '/'");
     }
 
+    if (0 < slowWorkers && !m_isSlowRequest)
+    {
+        throw std::runtime_error("The slow lane needs a request classifier");
+    }
+
+    if (0 < m_taskQueueSize)
+    {
+        m_pool = std::make_unique<WorkerPool>(m_address, workers, m_taskQueueSize);
+        if (0 < slowWorkers)
+        {
+            m_slowPool = std::make_unique<WorkerPool>(m_address + " (slow)", slowWorkers, m_taskQueueSize);
+        }
+    }
+
     m_metric.m_metricsScope = std::move(metricsScope);
-    m_metric.m_totalRequest = m_metric.m_metricsScope->getCounterUInteger("TotalRequest");
-    m_metric.m_responseTime = m_metric.m_metricsScope->getHistogramUInteger("ResponseTime");
-    m_metric.m_queueSize = m_metric.m_metricsScope->getHistogramUInteger("QueueSize");
+    m_metric.m_totalRequest = m_metric.m_metricsScope->getLocalCounterUInteger("TotalRequest");
+    m_metric.m_responseTime = m_metric.m_metricsScope->getLocalHistogramUInteger("ResponseTime");
+    m_metric.m_queueSize = m_metric.m_metricsScope->getLocalHistogramUInteger("QueueSize");
     m_metric.m_connectedClients = m_metric.m_metricsScope->getUpDownCounterInteger("ConnectedClients");
-    m_metric.m_serverBusy = m_metric.m_metricsScope->getCounterUInteger("ServerBusy");
+    m_metric.m_serverBusy = m_metric.m_metricsScope->getLocalCounterUInteger("ServerBusy");
+    m_metric.m_slowQueueSize = m_metric.m_metricsScope->getLocalHistogramUInteger("SlowQueueSize");
+    m_metric.m_slowServerBusy = m_metric.m_metricsScope->getLocalCounterUInteger("SlowServerBusy");
 
     m_metric.m_metricsScopeDelta = std::move(metricsScopeDelta);
-    m_metric.m_requestPerSecond = m_metric.m_metricsScopeDelta->getCounterUInteger("RequestPerSecond");
+    m_metric.m_requestPerSecond = m_metric.m_metricsScopeDelta->getLocalCounterUInteger("RequestPerSecond");
 }
 
 UnixStream::~UnixStream()
@@ -243,36 +263,41 @@ void UnixStream::processMessages(std::weak_ptr<uvw::PipeHandle> wClient,
 
             continue;
         }
-        // Send the message to the queue worker (#TODO: Should be add the size of the worker?)
-        if (m_currentTaskQueueSize >= m_taskQueueSize)
+        // Send the message to the worker pool of its lane, answer busy if the queue is full
+        if (createAndEnqueueTask(wClient, asyncs, protocolHandler, std::move(request)))
         {
-            auto responseTimer = base::chrono::Timer();
-            LOG_DEBUG("[Endpoint: {}] endpoint: No queue worker available, disarting...", m_address);
-            auto [buffer, size] = protocolHandler->getBusyResponse();
-            auto client = wClient.lock();
-            if (!client)
-            {
-                LOG_WARNING("[Endpoint: {}] endpoint: Client already closed", m_address);
-                return;
-            }
-            client->write(std::move(buffer), size);
-
-            auto elapsedTime = responseTimer.elapsed<std::chrono::milliseconds>();
-            m_metric.m_responseTime->recordValue(static_cast<uint64_t>(elapsedTime));
-            m_metric.m_serverBusy->addValue(1L);
             continue;
         }
 
-        createAndEnqueueTask(wClient, asyncs, protocolHandler, std::move(request));
+        auto responseTimer = base::chrono::Timer();
+        LOG_DEBUG("[Endpoint: {}] endpoint: No queue worker available, disarting...", m_address);
+        auto [buffer, size] = protocolHandler->getBusyResponse();
+        auto client = wClient.lock();
+        if (!client)
+        {
+            LOG_WARNING("[Endpoint: {}] endpoint: Client already closed", m_address);
+            return;
+        }
+        client->write(std::move(buffer), size);
+
+        auto elapsedTime = responseTimer.elapsed<std::chrono::milliseconds>();
+        m_metric.m_responseTime->recordValue(static_cast<uint64_t>(elapsedTime));
     }
 }
 
-void UnixStream::createAndEnqueueTask(std::weak_ptr<uvw::PipeHandle> wClient,
+bool UnixStream::createAndEnqueueTask(std::weak_ptr<uvw::PipeHandle> wClient,
                                       std::shared_ptr<std::vector<std::weak_ptr<uvw::AsyncHandle>>> asyncs,
                                       std::shared_ptr<ProtocolHandler> protocolHandler,
                                       std::string&& request)
 {
-    ++m_currentTaskQueueSize;
+    const bool slow = m_slowPool && m_isSlowRequest(request);
+    auto& pool = slow ? *m_slowPool : *m_pool;
+    auto queueSize = slow ? m_metric.m_slowQueueSize : m_metric.m_queueSize;
+    if (pool.pending() >= pool.capacity())
+    {
+        (slow ? m_metric.m_slowServerBusy : m_metric.m_serverBusy)->addValue(1L);
+        return false;
+    }
 
     auto response = std::make_shared<std::string>();
     auto responseTimer = std::make_shared<base::chrono::Timer>();
@@ -351,32 +376,30 @@ void UnixStream::createAndEnqueueTask(std::weak_ptr<uvw::PipeHandle> wClient,
         async->send();
     };
 
-    // Create a new queue worker for the request
-    auto work = m_loop->resource<uvw::WorkReq>([request, callbackFn, protocolHandler, address = m_address]()
-                                               { protocolHandler->onMessage(request, callbackFn); });
-
-    // On error
-    work->on<uvw::ErrorEvent>(
-        [address = m_address, metric = m_metric, &currentTaskQueueSize = m_currentTaskQueueSize](
-            const uvw::ErrorEvent& error, uvw::WorkReq& worker)
-        {
-            LOG_ERROR("[Endpoint: {}] endpoint: Error processing message: {}", address, error.what());
-            --currentTaskQueueSize;
-            metric.m_queueSize->recordValue(currentTaskQueueSize.load());
-        });
-
-    // On finish
-    work->on<uvw::WorkEvent>(
-        [address = m_address, metric = m_metric, &currentTaskQueueSize = m_currentTaskQueueSize](const uvw::WorkEvent&,
-                                                                                                 uvw::WorkReq& work)
+    // Run the request in the worker pool, the pool is only filled from the loop thread so it cannot be full here
+    ++m_currentTaskQueueSize;
+    pool.trySubmit(
+        [request = std::move(request),
+         callbackFn,
+         protocolHandler,
+         queueSize,
+         address = m_address,
+         &pool,
+         &currentTaskQueueSize = m_currentTaskQueueSize]()
         {
+            try
+            {
+                protocolHandler->onMessage(request, callbackFn);
+            }
+            catch (const std::exception& e)
+            {
+                LOG_ERROR("[Endpoint: {}] endpoint: Error processing message: {}", address, e.what());
+            }
             --currentTaskQueueSize;
-            metric.m_queueSize->recordValue(currentTaskQueueSize.load());
-            LOG_DEBUG("[Endpoint: {}] endpoint: Finish", address);
+            queueSize->recordValue(pool.pending() - 1);
         });
-
-    work->queue();
-    m_metric.m_queueSize->recordValue(m_currentTaskQueueSize.load());
+    queueSize->recordValue(pool.pending());
+    return true;
 }
 
 std::shared_ptr<uvw::TimerHandle> UnixStream::createTimer(std::weak_ptr<uvw::PipeHandle> wClient,
@@ -0,0 +1,110 @@
+#include <server/workerPool.hpp>
+
+#include <stdexcept>
+
+#include <logging/logging.hpp>
+
+namespace engineserver
+{
+WorkerPool::WorkerPool(const std::string& name, std::size_t threads, std::size_t capacity)
+    : m_name(name)
+    , m_capacity(capacity)
+{
+    if (0 == threads)
+    {
+        throw std::runtime_error("Worker pool threads must be greater than 0");
+    }
+
+    if (0 == capacity)
+    {
+        throw std::runtime_error("Worker pool capacity must be greater than 0");
+    }
+
+    m_threads.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i)
+    {
+        m_threads.emplace_back(&WorkerPool::work, this);
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    stop();
+}
+
+void WorkerPool::work()
+{
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock lock(m_mutex);
+            m_cv.wait(lock, [this]() { return m_stopping || !m_tasks.empty(); });
+            if (m_stopping)
+            {
+                return;
+            }
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+            ++m_running;
+        }
+
+        try
+        {
+            task();
+        }
+        catch (const std::exception& e)
+        {
+            LOG_WARNING("[Worker pool: {}] Error running a task: {}", m_name, e.what());
+        }
+
+        std::lock_guard lock(m_mutex);
+        --m_running;
+    }
+}
+
+bool WorkerPool::trySubmit(std::function<void()>&& task)
+{
+    {
+        std::lock_guard lock(m_mutex);
+        if (m_stopping || m_tasks.size() + m_running >= m_capacity)
+        {
+            return false;
+        }
+        m_tasks.push_back(std::move(task));
+    }
+    m_cv.notify_one();
+    return true;
+}
+
+std::size_t WorkerPool::pending() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_tasks.size() + m_running;
+}
+
+void WorkerPool::stop()
+{
+    std::deque<std::function<void()>> dropped;
+    {
+        std::lock_guard lock(m_mutex);
+        if (m_stopping)
+        {
+            return;
+        }
+        m_stopping = true;
+        dropped.swap(m_tasks);
+    }
+    m_cv.notify_all();
+
+    for (auto& thread : m_threads)
+    {
+        thread.join();
+    }
+
+    if (!dropped.empty())
+    {
+        LOG_DEBUG("[Worker pool: {}] Stopped, {} tasks dropped", m_name, dropped.size());
+    }
+}
+} // namespace engineserver
@@ -435,3 +435,44 @@ TEST_F(UnixDatagramTest, StopWhenBufferIsFull)
     close(clientFD);
     loopThread.join();
 }
+
+TEST_F(UnixDatagramTest, InvalidBatchSize)
+{
+    auto callback = [](const std::vector<std::string>&) {};
+    ASSERT_THROW(UnixDatagram(socketPath,
+                              callback,
+                              0,
+                              std::make_shared<FakeMetricScope>(),
+                              std::make_shared<FakeMetricScope>()),
+                 std::runtime_error);
+    ASSERT_NO_THROW(UnixDatagram(socketPath,
+                                 callback,
+                                 16,
+                                 std::make_shared<FakeMetricScope>(),
+                                 std::make_shared<FakeMetricScope>()));
+}
+
+TEST_F(UnixDatagramTest, ReceiveBatch)
+{
+    std::vector<std::vector<std::string>> batches;
+    UnixDatagram endpoint(
+        socketPath,
+        [&](const std::vector<std::string>& batch) { batches.emplace_back(batch); },
+        8,
+        std::make_shared<FakeMetricScope>(),
+        std::make_shared<FakeMetricScope>());
+    endpoint.bind(loop);
+
+    auto clientFD = getSendFD(socketPath);
+    sendUnixDatagram(clientFD, "first");
+    sendUnixDatagram(clientFD, "second");
+    sendUnixDatagram(clientFD, "third");
+    close(clientFD);
+
+    loop->run<uvw::Loop::Mode::ONCE>();
+
+    // All the pending messages are delivered at once
+    ASSERT_EQ(batches.size(), 1);
+    ASSERT_EQ(batches[0], (std::vector<std::string> {"first", "second", "third"}));
+    endpoint.close();
+}
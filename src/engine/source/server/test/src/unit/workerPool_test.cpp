@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include <logging/logging.hpp>
+#include <server/workerPool.hpp>
+
+using engineserver::WorkerPool;
+
+class WorkerPoolTest : public ::testing::Test
+{
+protected:
+    void SetUp() override { logging::testInit(); }
+
+    // Blocks the tasks of the pool until released
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_released {false};
+
+    std::function<void()> blockingTask()
+    {
+        return [this]()
+        {
+            std::unique_lock lock(m_mutex);
+            m_cv.wait(lock, [this]() { return m_released; });
+        };
+    }
+
+    void release()
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_released = true;
+        }
+        m_cv.notify_all();
+    }
+};
+
+TEST_F(WorkerPoolTest, InvalidParameters)
+{
+    ASSERT_THROW(WorkerPool("test", 0, 1), std::runtime_error);
+    ASSERT_THROW(WorkerPool("test", 1, 0), std::runtime_error);
+}
+
+TEST_F(WorkerPoolTest, RunTasks)
+{
+    std::atomic<int> done {0};
+    {
+        WorkerPool pool("test", 4, 1000);
+        ASSERT_EQ(pool.threads(), 4);
+        ASSERT_EQ(pool.capacity(), 1000);
+        for (auto i = 0; i < 1000; ++i)
+        {
+            ASSERT_TRUE(pool.trySubmit([&done]() { ++done; }));
+        }
+        while (pool.pending() != 0)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    ASSERT_EQ(done, 1000);
+}
+
+TEST_F(WorkerPoolTest, RefuseWhenFull)
+{
+    WorkerPool pool("test", 1, 2);
+    ASSERT_TRUE(pool.trySubmit(blockingTask()));
+    ASSERT_TRUE(pool.trySubmit(blockingTask()));
+    ASSERT_EQ(pool.pending(), 2);
+    ASSERT_FALSE(pool.trySubmit([]() {}));
+
+    release();
+    while (pool.pending() != 0)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_TRUE(pool.trySubmit([]() {}));
+}
+
+TEST_F(WorkerPoolTest, TaskException)
+{
+    WorkerPool pool("test", 1, 2);
+    ASSERT_TRUE(pool.trySubmit([]() { throw std::runtime_error("error"); }));
+
+    std::atomic<bool> done {false};
+    ASSERT_TRUE(pool.trySubmit([&done]() { done = true; }));
+    while (!done)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+TEST_F(WorkerPoolTest, StopDropsQueued)
+{
+    std::atomic<int> done {0};
+    WorkerPool pool("test", 1, 10);
+    ASSERT_TRUE(pool.trySubmit(blockingTask()));
+    // Wait for the thread to take the blocking task
+    while (pool.pending() != 1)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ASSERT_TRUE(pool.trySubmit([&done]() { ++done; }));
+
+    // The queued task is dropped as soon as the pool stops, before waiting for the running one
+    std::thread releaser(
+        [this]()
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            release();
+        });
+    pool.stop();
+    releaser.join();
+
+    ASSERT_EQ(done, 0);
+    ASSERT_FALSE(pool.trySubmit([]() {}));
+    pool.stop();
+}
@@ -0,0 +1,158 @@
+#ifndef _SOCKIFACE_COALESCING_SENDER_HPP
+#define _SOCKIFACE_COALESCING_SENDER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <sockiface/isockHandler.hpp>
+
+namespace sockiface
+{
+
+constexpr std::chrono::milliseconds COALESCING_WINDOW {1000}; ///< Default window in which identical messages coalesce
+constexpr std::size_t COALESCING_CAPACITY {4096};             ///< Default number of messages waiting to be sent
+
+/**
+ * @brief Asynchronous sender in front of another socket handler.
+ *
+ * The messages are queued and sent in batches by a dedicated thread, which owns the connection of the underlying
+ * handler and keeps it open between batches, so the callers never wait on the peer. A message identical to one queued
+ * less than a window ago is coalesced with it and not sent again.
+ *
+ * When the queue is full the messages are rejected, the callers are never blocked. The messages still queued when the
+ * sender is destroyed are sent before the thread exits.
+ */
+class CoalescingSender : public ISockHandler
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+private:
+    std::shared_ptr<ISockHandler> m_handler; ///< Underlying handler, used under m_handlerMutex
+    std::chrono::milliseconds m_window;      ///< Window in which identical messages coalesce
+    std::size_t m_capacity;                  ///< Maximum number of messages waiting to be sent
+
+    mutable std::mutex m_mutex;                                  ///< Protects the queue and the recent messages
+    std::condition_variable m_cv;                                ///< Wakes the sending thread
+    std::condition_variable m_idle;                              ///< Signals the end of a batch
+    std::vector<std::string> m_queue;                            ///< Messages waiting to be sent
+    std::unordered_map<std::string, Clock::time_point> m_recent; ///< Messages queued within the window
+    bool m_sending {false};                                      ///< A batch is being sent
+    bool m_stop {false};                                         ///< The sending thread must exit
+
+    std::mutex m_handlerMutex; ///< Serializes the use of the underlying handler
+
+    std::atomic<uint64_t> m_coalesced {0}; ///< Messages coalesced with a recent one
+    std::atomic<uint64_t> m_rejected {0};  ///< Messages rejected because the queue was full
+    std::atomic<uint64_t> m_failed {0};    ///< Messages the underlying handler could not send
+
+    std::thread m_thread; ///< Sending thread
+
+    void run();
+    void sendBatch(const std::vector<std::string>& batch);
+    void pruneRecent(Clock::time_point now);
+
+public:
+    /**
+     * @brief Construct a new Coalescing Sender.
+     *
+     * @param handler Underlying handler.
+     * @param window Window in which identical messages coalesce, 0 to never coalesce.
+     * @param capacity Maximum number of messages waiting to be sent.
+     * @throw std::runtime_error if the handler is null or the capacity is 0.
+     */
+    explicit CoalescingSender(std::shared_ptr<ISockHandler> handler,
+                              std::chrono::milliseconds window = COALESCING_WINDOW,
+                              std::size_t capacity = COALESCING_CAPACITY);
+    ~CoalescingSender();
+
+    CoalescingSender(const CoalescingSender&) = delete;
+    CoalescingSender& operator=(const CoalescingSender&) = delete;
+
+    /**
+     * @copydoc ISockHandler::getMaxMsgSize
+     */
+    uint32_t getMaxMsgSize() const noexcept override { return m_handler->getMaxMsgSize(); }
+
+    /**
+     * @copydoc ISockHandler::getPath
+     */
+    std::string getPath() const noexcept override { return m_handler->getPath(); }
+
+    /**
+     * @copydoc ISockHandler::socketConnect
+     */
+    void socketConnect() override;
+
+    /**
+     * @copydoc ISockHandler::socketDisconnect
+     */
+    void socketDisconnect() override;
+
+    /**
+     * @copydoc ISockHandler::isConnected
+     */
+    bool isConnected() const noexcept override { return m_handler->isConnected(); }
+
+    /**
+     * @brief Queue a message to be sent, or coalesce it with an identical one queued within the window.
+     *
+     * @param msg message to send.
+     *
+     * @return SendRetval::SUCCESS if the message was queued or coalesced.
+     * @return SendRetval::SIZE_ZERO if msg is empty.
+     * @return SendRetval::SOCKET_ERROR if the queue is full.
+     *
+     * @note The errors of the underlying handler are logged by the sending thread, they are not seen by the caller.
+     */
+    SendRetval sendMsg(const std::string& msg) override;
+
+    /**
+     * @copydoc ISockHandler::recvMsg
+     */
+    std::vector<char> recvMsg() override;
+
+    /**
+     * @brief Wait until all the queued messages have been sent.
+     */
+    void flush();
+
+    /**
+     * @brief Get the number of messages waiting to be sent.
+     *
+     * @return std::size_t
+     */
+    std::size_t pending() const;
+
+    /**
+     * @brief Get the number of messages coalesced with a recent one.
+     *
+     * @return uint64_t
+     */
+    uint64_t coalesced() const { return m_coalesced.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Get the number of messages rejected because the queue was full.
+     *
+     * @return uint64_t
+     */
+    uint64_t rejected() const { return m_rejected.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Get the number of messages the underlying handler could not send.
+     *
+     * @return uint64_t
+     */
+    uint64_t failed() const { return m_failed.load(std::memory_order_relaxed); }
+};
+
+} // namespace sockiface
+
+#endif // _SOCKIFACE_COALESCING_SENDER_HPP
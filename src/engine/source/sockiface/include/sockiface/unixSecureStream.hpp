@@ -44,6 +44,32 @@ private:
      */
     ssize_t recvWaitAll(void* buf, size_t size) const noexcept;
 
+    /**
+     * @brief Receive the header of a message and validate its size.
+     *
+     * @return uint32_t size of the payload.
+     * @throws std::runtime_error as \ref recvMsg.
+     */
+    uint32_t recvHeader();
+
+    /**
+     * @brief Receive the payload of a message.
+     *
+     * @param buf buffer to store the payload.
+     * @param size size of the payload.
+     * @throws std::runtime_error as \ref recvMsg.
+     */
+    void recvPayload(char* buf, uint32_t size);
+
+    /**
+     * @brief Check the result of a receive, disconnecting the socket on failure.
+     *
+     * @param rcvBytes bytes received or \ref SOCKET_ERROR.
+     * @throws RecoverableError if the connection is reset or closed by the peer.
+     * @throws std::runtime_error on any other error.
+     */
+    void checkRecv(ssize_t rcvBytes);
+
 public:
     /**
      * @brief Create a unixSecureStream object linked to a UNIX socket located at `path`.
@@ -71,6 +97,11 @@ public:
      * @copydoc ISockHandler::recvMsg
     */
     std::vector<char> recvMsg() override;
+
+    /**
+     * @copydoc ISockHandler::recvView
+    */
+    std::string_view recvView(std::vector<char>& buffer) override;
 };
 } // namespace base::utils::socketInterface
 
@@ -3,6 +3,7 @@
 
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace sockiface
@@ -123,6 +124,27 @@ public:
     {
         return std::string(recvMsg().data());
     }
+
+    /**
+     * @brief Receive a message from the socket into a buffer reused by the caller.
+     *
+     * The buffer grows to fit the message and is never shrunk, so a buffer kept across calls
+     * stops allocating once it has the size of the largest message.
+     * @param buffer buffer to store the message, terminated by an '\0' character.
+     * @return view of the message in the buffer, up to the first '\0' character (like \ref recvString).
+     * It's valid until the next call with the same buffer.
+     *
+     * @throws recoverableError if connection is reset by peer (ECONNRESET), timeout
+     * or disconnected (errno is not set).
+     * @note This method does not try to connect if the socket is not connected.
+     * @warning this method blocks until the message is received or the socket is
+     * disconnected.
+     */
+    virtual std::string_view recvView(std::vector<char>& buffer)
+    {
+        buffer = recvMsg();
+        return std::string_view(buffer.data());
+    }
 };
 
 } // namespace sockiface
@@ -0,0 +1,210 @@
+#include "coalescingSender.hpp"
+
+#include <fmt/format.h>
+#include <logging/logging.hpp>
+
+namespace sockiface
+{
+
+CoalescingSender::CoalescingSender(std::shared_ptr<ISockHandler> handler,
+                                   std::chrono::milliseconds window,
+                                   std::size_t capacity)
+    : m_handler(std::move(handler))
+    , m_window(window)
+    , m_capacity(capacity)
+{
+    if (!m_handler)
+    {
+        throw std::runtime_error("Coalescing sender needs an underlying socket handler");
+    }
+    if (m_capacity == 0)
+    {
+        throw std::runtime_error("Coalescing sender capacity must be greater than 0");
+    }
+
+    m_queue.reserve(m_capacity);
+    m_thread = std::thread(&CoalescingSender::run, this);
+}
+
+CoalescingSender::~CoalescingSender()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_one();
+    m_thread.join();
+}
+
+void CoalescingSender::pruneRecent(Clock::time_point now)
+{
+    for (auto it = m_recent.begin(); it != m_recent.end();)
+    {
+        it = now - it->second >= m_window ? m_recent.erase(it) : std::next(it);
+    }
+}
+
+void CoalescingSender::run()
+{
+    std::vector<std::string> batch;
+    batch.reserve(m_capacity);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        // Woken at least once per window to forget the messages that no longer coalesce
+        const auto ready = [this]()
+        {
+            return m_stop || !m_queue.empty();
+        };
+        if (m_window.count() > 0)
+        {
+            m_cv.wait_for(lock, m_window, ready);
+        }
+        else
+        {
+            m_cv.wait(lock, ready);
+        }
+        pruneRecent(Clock::now());
+
+        if (m_queue.empty())
+        {
+            if (m_stop)
+            {
+                return;
+            }
+            continue;
+        }
+
+        batch.swap(m_queue);
+        m_sending = true;
+        lock.unlock();
+
+        sendBatch(batch);
+        batch.clear();
+
+        lock.lock();
+        m_sending = false;
+        m_idle.notify_all();
+    }
+}
+
+void CoalescingSender::sendBatch(const std::vector<std::string>& batch)
+{
+    std::lock_guard<std::mutex> lock(m_handlerMutex);
+
+    std::size_t failed = 0;
+    std::string lastError;
+    for (const auto& msg : batch)
+    {
+        // A broken connection is reopened once, the peer may have been restarted
+        for (auto attempt = 0; attempt < 2; ++attempt)
+        {
+            try
+            {
+                const auto result = m_handler->sendMsg(msg);
+                if (result != SendRetval::SUCCESS)
+                {
+                    ++failed;
+                    lastError = fmt::format("send result {}", static_cast<int>(result));
+                }
+                break;
+            }
+            catch (const RecoverableError& e)
+            {
+                m_handler->socketDisconnect();
+                if (attempt == 1)
+                {
+                    ++failed;
+                    lastError = e.what();
+                }
+            }
+            catch (const std::exception& e)
+            {
+                ++failed;
+                lastError = e.what();
+                break;
+            }
+        }
+    }
+
+    if (failed > 0)
+    {
+        m_failed.fetch_add(failed, std::memory_order_relaxed);
+        LOG_WARNING("Engine coalescing sender: {} of {} messages could not be sent to '{}': {}.",
+                    failed,
+                    batch.size(),
+                    m_handler->getPath(),
+                    lastError);
+    }
+}
+
+void CoalescingSender::socketConnect()
+{
+    std::lock_guard<std::mutex> lock(m_handlerMutex);
+    m_handler->socketConnect();
+}
+
+void CoalescingSender::socketDisconnect()
+{
+    std::lock_guard<std::mutex> lock(m_handlerMutex);
+    m_handler->socketDisconnect();
+}
+
+ISockHandler::SendRetval CoalescingSender::sendMsg(const std::string& msg)
+{
+    if (msg.empty())
+    {
+        return SendRetval::SIZE_ZERO;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const auto now = Clock::now();
+        if (m_window.count() > 0)
+        {
+            auto it = m_recent.find(msg);
+            if (it != m_recent.end() && now - it->second < m_window)
+            {
+                m_coalesced.fetch_add(1, std::memory_order_relaxed);
+                return SendRetval::SUCCESS;
+            }
+        }
+
+        if (m_queue.size() >= m_capacity)
+        {
+            m_rejected.fetch_add(1, std::memory_order_relaxed);
+            return SendRetval::SOCKET_ERROR;
+        }
+
+        m_queue.emplace_back(msg);
+        // The recent messages are bounded as the queue, the rest are sent without coalescing
+        if (m_window.count() > 0 && m_recent.size() < m_capacity)
+        {
+            m_recent.insert_or_assign(msg, now);
+        }
+    }
+    m_cv.notify_one();
+
+    return SendRetval::SUCCESS;
+}
+
+std::vector<char> CoalescingSender::recvMsg()
+{
+    std::lock_guard<std::mutex> lock(m_handlerMutex);
+    return m_handler->recvMsg();
+}
+
+void CoalescingSender::flush()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this]() { return m_queue.empty() && !m_sending; });
+}
+
+std::size_t CoalescingSender::pending() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_queue.size();
+}
+
+} // namespace sockiface
@@ -51,10 +51,41 @@ ISockHandler::SendRetval unixSecureStream::sendMsg(const std::string& msg)
     }
     else
     {
+        // Header, payload and null terminator in a single write, without copying the payload
+        const char terminator {'\0'};
         payloadSize++; // send the null terminator
-        // MSG_NOSIGNAL prevent broken pipe signal
-        auto success {send(getFD(), &payloadSize, HEADER_SIZE, MSG_NOSIGNAL) == HEADER_SIZE};
-        success = success && (send(getFD(), msg.c_str(), payloadSize, MSG_NOSIGNAL) == payloadSize);
+        iovec iov[] {{&payloadSize, HEADER_SIZE},
+                     {const_cast<char*>(msg.data()), msg.size()},
+                     {const_cast<char*>(&terminator), sizeof(terminator)}};
+        msghdr hdr {};
+        hdr.msg_iov = iov;
+        hdr.msg_iovlen = sizeof(iov) / sizeof(iov[0]);
+
+        auto pending {HEADER_SIZE + payloadSize};
+        auto success {true};
+        while (success && 0 < pending)
+        {
+            // MSG_NOSIGNAL prevent broken pipe signal
+            const auto sent {sendmsg(getFD(), &hdr, MSG_NOSIGNAL)};
+            success = 0 < sent;
+            if (success)
+            {
+                // Skip what has been written on a partial write
+                pending -= sent;
+                auto written {static_cast<size_t>(sent)};
+                while (0 < pending && hdr.msg_iov->iov_len <= written)
+                {
+                    written -= hdr.msg_iov->iov_len;
+                    hdr.msg_iov++;
+                    hdr.msg_iovlen--;
+                }
+                if (0 < pending)
+                {
+                    hdr.msg_iov->iov_base = static_cast<char*>(hdr.msg_iov->iov_base) + written;
+                    hdr.msg_iov->iov_len -= written;
+                }
+            }
+        }
 
         if (success)
         {
@@ -75,49 +106,77 @@ ISockHandler::SendRetval unixSecureStream::sendMsg(const std::string& msg)
     return result;
 }
 
-std::vector<char> unixSecureStream::recvMsg()
+void unixSecureStream::checkRecv(const ssize_t rcvBytes)
 {
-    // Check recive msg
-    const auto checkRcv = [this](const ssize_t rcvBytes)
+    if (0 > rcvBytes)
     {
-        if (0 > rcvBytes)
+        const auto msg {fmt::format("Engine Unix Stream socket utils: recvMsg(): {} ({})", strerror(errno), errno)};
+        socketDisconnect();
+        if (ECONNRESET == errno)
         {
-            const auto msg {fmt::format("Engine Unix Stream socket utils: recvMsg(): {} ({})", strerror(errno), errno)};
-            socketDisconnect();
-            if (ECONNRESET == errno)
-            {
 
-                throw RecoverableError(msg);
-            }
-            throw std::runtime_error(msg);
+            throw RecoverableError(msg);
         }
-        else if (0 == rcvBytes)
-        {
-            // Remote disconect recoverable case
-            socketDisconnect();
-            // errno is not set
-            throw RecoverableError("Engine Unix Stream socket utils: recvMsg(): Socket disconnected.");
-        }
-    };
+        throw std::runtime_error(msg);
+    }
+    else if (0 == rcvBytes)
+    {
+        // Remote disconect recoverable case
+        socketDisconnect();
+        // errno is not set
+        throw RecoverableError("Engine Unix Stream socket utils: recvMsg(): Socket disconnected.");
+    }
+}
 
+uint32_t unixSecureStream::recvHeader()
+{
     uint32_t msgSize; // Message size (Header readed)
-    auto recvb {recvWaitAll(&msgSize, sizeof(msgSize))};
-    checkRcv(recvb);
+    checkRecv(recvWaitAll(&msgSize, sizeof(msgSize)));
 
     if (getMaxMsgSize() < msgSize)
     {
         socketDisconnect();
-        std::runtime_error(
+        throw std::runtime_error(
             fmt::format("Engine Unix Stream socket utils: recvMsg(): Message size too long ({}).", msgSize));
     }
 
+    return msgSize;
+}
+
+void unixSecureStream::recvPayload(char* buf, const uint32_t size)
+{
+    if (0 < size)
+    {
+        checkRecv(recvWaitAll(buf, size));
+    }
+}
+
+std::vector<char> unixSecureStream::recvMsg()
+{
+    const auto msgSize {recvHeader()};
+
     std::vector<char> recvMsg;
     recvMsg.resize(msgSize + 1, '\0');
 
-    recvb = recvWaitAll(&(recvMsg[0]), msgSize);
-    checkRcv(recvb);
+    recvPayload(recvMsg.data(), msgSize);
 
     return recvMsg;
 }
 
+std::string_view unixSecureStream::recvView(std::vector<char>& buffer)
+{
+    const auto msgSize {recvHeader()};
+
+    // Grow only, the capacity is kept for the next messages
+    if (buffer.size() < msgSize + 1)
+    {
+        buffer.resize(msgSize + 1);
+    }
+
+    recvPayload(buffer.data(), msgSize);
+    buffer[msgSize] = '\0';
+
+    return std::string_view(buffer.data());
+}
+
 } // namespace sockiface
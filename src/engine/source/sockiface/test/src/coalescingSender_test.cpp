@@ -0,0 +1,154 @@
+#include <gtest/gtest.h>
+
+#include <future>
+#include <thread>
+
+#include <logging/logging.hpp>
+#include <sockiface/coalescingSender.hpp>
+#include <sockiface/mockSockHandler.hpp>
+
+using namespace sockiface;
+using namespace sockiface::mocks;
+using testing::Return;
+
+class CoalescingSenderTest : public ::testing::Test
+{
+protected:
+    std::shared_ptr<MockSockHandler> m_handler;
+
+    void SetUp() override
+    {
+        logging::testInit();
+        m_handler = std::make_shared<MockSockHandler>();
+    }
+};
+
+TEST_F(CoalescingSenderTest, Build)
+{
+    ASSERT_THROW(CoalescingSender(nullptr), std::runtime_error);
+    ASSERT_THROW(CoalescingSender(m_handler, COALESCING_WINDOW, 0), std::runtime_error);
+    ASSERT_NO_THROW(CoalescingSender {m_handler});
+}
+
+TEST_F(CoalescingSenderTest, SendsQueued)
+{
+    EXPECT_CALL(*m_handler, sendMsg("first")).WillOnce(Return(successSendMsgRes()));
+    EXPECT_CALL(*m_handler, sendMsg("second")).WillOnce(Return(successSendMsgRes()));
+
+    CoalescingSender sender(m_handler);
+    ASSERT_EQ(sender.sendMsg("first"), successSendMsgRes());
+    ASSERT_EQ(sender.sendMsg("second"), successSendMsgRes());
+    ASSERT_EQ(sender.sendMsg(""), sizeZeroSendMsgRes());
+    sender.flush();
+    ASSERT_EQ(sender.pending(), 0);
+}
+
+TEST_F(CoalescingSenderTest, CoalescesWithinWindow)
+{
+    EXPECT_CALL(*m_handler, sendMsg("query")).WillOnce(Return(successSendMsgRes()));
+    EXPECT_CALL(*m_handler, sendMsg("other")).WillOnce(Return(successSendMsgRes()));
+
+    CoalescingSender sender(m_handler, std::chrono::seconds(60));
+    for (auto i = 0; i < 5; ++i)
+    {
+        ASSERT_EQ(sender.sendMsg("query"), successSendMsgRes());
+        sender.flush();
+    }
+    ASSERT_EQ(sender.sendMsg("other"), successSendMsgRes());
+    sender.flush();
+    ASSERT_EQ(sender.coalesced(), 4);
+}
+
+TEST_F(CoalescingSenderTest, WindowExpires)
+{
+    EXPECT_CALL(*m_handler, sendMsg("query")).Times(2).WillRepeatedly(Return(successSendMsgRes()));
+
+    CoalescingSender sender(m_handler, std::chrono::milliseconds(20));
+    ASSERT_EQ(sender.sendMsg("query"), successSendMsgRes());
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ASSERT_EQ(sender.sendMsg("query"), successSendMsgRes());
+    sender.flush();
+    ASSERT_EQ(sender.coalesced(), 0);
+}
+
+TEST_F(CoalescingSenderTest, NoWindowNoCoalescing)
+{
+    EXPECT_CALL(*m_handler, sendMsg("query")).Times(3).WillRepeatedly(Return(successSendMsgRes()));
+
+    CoalescingSender sender(m_handler, std::chrono::milliseconds(0));
+    for (auto i = 0; i < 3; ++i)
+    {
+        ASSERT_EQ(sender.sendMsg("query"), successSendMsgRes());
+    }
+    sender.flush();
+    ASSERT_EQ(sender.coalesced(), 0);
+}
+
+TEST_F(CoalescingSenderTest, FullQueueRejects)
+{
+    std::promise<void> started;
+    std::promise<void> release;
+    auto released = release.get_future().share();
+
+    EXPECT_CALL(*m_handler, sendMsg("blocked"))
+        .WillOnce(
+            [&started, released](const std::string&)
+            {
+                started.set_value();
+                released.wait();
+                return successSendMsgRes();
+            });
+    EXPECT_CALL(*m_handler, sendMsg("m0")).WillOnce(Return(successSendMsgRes()));
+    EXPECT_CALL(*m_handler, sendMsg("m1")).WillOnce(Return(successSendMsgRes()));
+
+    CoalescingSender sender(m_handler, COALESCING_WINDOW, 2);
+    ASSERT_EQ(sender.sendMsg("blocked"), successSendMsgRes());
+    started.get_future().wait();
+
+    // The caller is not blocked by the peer
+    ASSERT_EQ(sender.sendMsg("m0"), successSendMsgRes());
+    ASSERT_EQ(sender.sendMsg("m1"), successSendMsgRes());
+    ASSERT_EQ(sender.sendMsg("m2"), socketErrorSendMsgRes());
+    ASSERT_EQ(sender.pending(), 2);
+    ASSERT_EQ(sender.rejected(), 1);
+
+    release.set_value();
+    sender.flush();
+}
+
+TEST_F(CoalescingSenderTest, ReconnectsOnce)
+{
+    EXPECT_CALL(*m_handler, sendMsg("query"))
+        .WillOnce(testing::Throw(ISockHandler::RecoverableError("broken pipe")))
+        .WillOnce(Return(successSendMsgRes()));
+    EXPECT_CALL(*m_handler, socketDisconnect()).Times(1);
+
+    CoalescingSender sender(m_handler);
+    ASSERT_EQ(sender.sendMsg("query"), successSendMsgRes());
+    sender.flush();
+    ASSERT_EQ(sender.failed(), 0);
+}
+
+TEST_F(CoalescingSenderTest, ErrorsCounted)
+{
+    EXPECT_CALL(*m_handler, sendMsg("error")).WillOnce(Return(socketErrorSendMsgRes()));
+    EXPECT_CALL(*m_handler, sendMsg("throw")).WillOnce(testing::Throw(std::runtime_error("not connected")));
+    EXPECT_CALL(*m_handler, getPath()).WillRepeatedly(Return("/tmp/coalescingSender_test.sock"));
+
+    CoalescingSender sender(m_handler);
+    ASSERT_EQ(sender.sendMsg("error"), successSendMsgRes());
+    ASSERT_EQ(sender.sendMsg("throw"), successSendMsgRes());
+    sender.flush();
+    ASSERT_EQ(sender.failed(), 2);
+}
+
+TEST_F(CoalescingSenderTest, DestructionSendsPending)
+{
+    EXPECT_CALL(*m_handler, sendMsg(testing::_)).Times(100).WillRepeatedly(Return(successSendMsgRes()));
+
+    CoalescingSender sender(m_handler);
+    for (auto i = 0; i < 100; ++i)
+    {
+        ASSERT_EQ(sender.sendMsg(std::to_string(i)), successSendMsgRes());
+    }
+}
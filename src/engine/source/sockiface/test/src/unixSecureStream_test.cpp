@@ -1,5 +1,6 @@
 #include <filesystem>
 #include <iostream>
+#include <thread>
 #include <unistd.h>
 
 #include <gtest/gtest.h>
@@ -328,6 +329,65 @@ TEST_F(unixSecureStreamSocket, SendAndReceiveMessage)
     unlink(m_streamSockPath.data());
 }
 
+TEST_F(unixSecureStreamSocket, ReceiveViewReusesBuffer)
+{
+    unixSecureStream uStream(m_streamSockPath);
+
+    auto acceptSocketFd {testBindUnixSocket(m_streamSockPath, SOCK_STREAM)};
+    ASSERT_GT(acceptSocketFd, 0);
+
+    ASSERT_NO_THROW(uStream.socketConnect());
+
+    auto serverSocketFD {testAcceptConnection(acceptSocketFd)};
+    ASSERT_GT(serverSocketFD, 0);
+
+    const std::string longMsg(60000, 'x');
+    ASSERT_EQ(testSendMsg(serverSocketFD, longMsg), CommRetval::SUCCESS);
+    ASSERT_EQ(testSendMsg(serverSocketFD, TEST_SEND_MESSAGE.data()), CommRetval::SUCCESS);
+
+    std::vector<char> buffer;
+    ASSERT_EQ(uStream.recvView(buffer), longMsg);
+    const auto data {buffer.data()};
+
+    // The shorter message is received in the same memory
+    ASSERT_EQ(uStream.recvView(buffer), TEST_SEND_MESSAGE);
+    ASSERT_EQ(buffer.data(), data);
+
+    close(acceptSocketFd);
+    close(serverSocketFD);
+
+    unlink(m_streamSockPath.data());
+}
+
+TEST_F(unixSecureStreamSocket, SendLargerThanSocketBuffer)
+{
+    // Sent in several writes
+    const std::string msg(4 * 1024 * 1024, 'x');
+    unixSecureStream uStream(m_streamSockPath, msg.size());
+
+    const int acceptSocketFD {testBindUnixSocket(m_streamSockPath, SOCK_STREAM)};
+    ASSERT_GT(acceptSocketFD, 0);
+
+    ASSERT_NO_THROW(uStream.socketConnect());
+
+    const int serverSocketFD {testAcceptConnection(acceptSocketFD)};
+    ASSERT_GT(serverSocketFD, 0);
+
+    std::string payload;
+    std::thread server([&]() { payload = testRecvString(serverSocketFD, SOCK_STREAM); });
+
+    ASSERT_EQ(uStream.sendMsg(msg), ISockHandler::SendRetval::SUCCESS);
+    server.join();
+
+    ASSERT_EQ(payload.size(), msg.size() + 1);
+    ASSERT_STREQ(payload.c_str(), msg.c_str());
+
+    close(acceptSocketFD);
+    close(serverSocketFD);
+
+    unlink(m_streamSockPath.data());
+}
+
 TEST_F(unixSecureStreamSocket, SendLongestMessage)
 {
     unixSecureStream uStream(m_streamSockPath);
@@ -0,0 +1,151 @@
+#ifndef _CACHED_DRIVER_H
+#define _CACHED_DRIVER_H
+
+#include <store/idriver.hpp>
+
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace store::drivers
+{
+
+/**
+ * @brief Caching driver for the store.
+ *
+ * Sits in front of another driver and keeps in memory the documents and collections read from it, so repeated reads
+ * do not reach the underlying storage. The writes go to the underlying driver and drop the cached entries they
+ * change: the document, the collections containing it and the root.
+ *
+ * When a watch path is given (the base path of a FileDriver), the files changed out of the store are detected with
+ * inotify and drop the whole cache. The writes made through the store are seen by the watcher as well, they are
+ * expected to be far less frequent than the reads.
+ *
+ * Thread-safe if the underlying driver is.
+ */
+class CachedDriver : public IDriver
+{
+private:
+    std::shared_ptr<IDriver> m_driver; ///< Underlying driver
+
+    mutable std::shared_mutex m_mutex;                  ///< Protects the cache
+    mutable std::unordered_map<base::Name, Doc> m_docs; ///< Documents read
+    mutable std::unordered_map<base::Name, Col> m_cols; ///< Collections read
+    mutable std::optional<Col> m_root;                  ///< Root collection read
+    uint64_t m_generation {0};                          ///< Incremented by each invalidation
+
+    int m_inotifyFd {-1};                                  ///< Watches the files, -1 if not watching
+    int m_wakeFd[2] {-1, -1};                              ///< Pipe waking the watcher to stop it
+    std::unordered_map<int, std::filesystem::path> m_dirs; ///< Watched directories by watch descriptor
+    std::thread m_watcher;                                 ///< Reads the inotify events
+
+    /**
+     * @brief Cache a value read from the underlying driver, unless the cache was invalidated while reading it.
+     */
+    template<typename T, typename Cache>
+    void cacheRead(uint64_t generation, Cache& cache, const base::Name& name, const T& value) const;
+
+    uint64_t generation() const;
+
+    void invalidateDoc(const base::Name& name, bool containers);
+    void invalidateCol(const base::Name& name);
+
+    void addWatch(const std::filesystem::path& path);
+    void watch();
+
+public:
+    /**
+     * @brief Construct a new Cached Driver object.
+     *
+     * @param driver Underlying driver.
+     * @param watchPath Directory where the underlying driver keeps the documents, watched for changes made out of the
+     * store. Not watched if empty.
+     * @throw std::runtime_error if the driver is null or the directory cannot be watched.
+     */
+    explicit CachedDriver(std::shared_ptr<IDriver> driver,
+                          const std::optional<std::filesystem::path>& watchPath = std::nullopt);
+    ~CachedDriver();
+
+    CachedDriver(const CachedDriver&) = delete;
+    CachedDriver& operator=(const CachedDriver&) = delete;
+
+    /**
+     * @brief Drop all the cached documents and collections.
+     */
+    void invalidate();
+
+    /**
+     * @brief Get the number of cached documents.
+     *
+     * @return std::size_t
+     */
+    std::size_t cachedDocs() const;
+
+    /**
+     * @brief Get the number of cached collections, without the root.
+     *
+     * @return std::size_t
+     */
+    std::size_t cachedCols() const;
+
+    /**
+     * @copydoc IDriver::createDoc
+     */
+    base::OptError createDoc(const base::Name& name, const Doc& content) override;
+
+    /**
+     * @copydoc IDriver::readDoc
+     */
+    base::RespOrError<Doc> readDoc(const base::Name& name) const override;
+
+    /**
+     * @copydoc IDriver::updateDoc
+     */
+    base::OptError updateDoc(const base::Name& name, const Doc& content) override;
+
+    /**
+     * @copydoc IDriver::upsertDoc
+     */
+    base::OptError upsertDoc(const base::Name& name, const Doc& content) override;
+
+    /**
+     * @copydoc IDriver::deleteDoc
+     */
+    base::OptError deleteDoc(const base::Name& name) override;
+
+    /**
+     * @copydoc IDriver::readCol
+     */
+    base::RespOrError<Col> readCol(const base::Name& name) const override;
+
+    /**
+     * @copydoc IDriver::readRoot
+     */
+    base::RespOrError<Col> readRoot() const override;
+
+    /**
+     * @copydoc IDriver::deleteCol
+     */
+    base::OptError deleteCol(const base::Name& name) override;
+
+    /**
+     * @copydoc IDriver::exists
+     */
+    bool exists(const base::Name& name) const override;
+
+    /**
+     * @copydoc IDriver::existsDoc
+     */
+    bool existsDoc(const base::Name& name) const override;
+
+    /**
+     * @copydoc IDriver::existsCol
+     */
+    bool existsCol(const base::Name& name) const override;
+};
+} // namespace store::drivers
+
+#endif // _CACHED_DRIVER_H
@@ -0,0 +1,384 @@
+#include "store/drivers/cachedDriver.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <fmt/format.h>
+#include <logging/logging.hpp>
+
+namespace
+{
+constexpr uint32_t WATCH_EVENTS = IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_FROM | IN_MOVED_TO
+                                  | IN_DELETE_SELF | IN_MOVE_SELF;
+
+bool isPrefix(const base::Name& prefix, const base::Name& name)
+{
+    const auto& prefixParts = prefix.parts();
+    const auto& parts = name.parts();
+    return prefixParts.size() <= parts.size() && std::equal(prefixParts.begin(), prefixParts.end(), parts.begin());
+}
+} // namespace
+
+namespace store::drivers
+{
+CachedDriver::CachedDriver(std::shared_ptr<IDriver> driver, const std::optional<std::filesystem::path>& watchPath)
+    : m_driver(std::move(driver))
+{
+    if (!m_driver)
+    {
+        throw std::runtime_error("Cached store driver needs an underlying driver");
+    }
+
+    if (!watchPath)
+    {
+        return;
+    }
+
+    LOG_DEBUG("Engine cached driver watching path '{}'.", watchPath->string());
+
+    m_inotifyFd = inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+    if (m_inotifyFd == -1)
+    {
+        throw std::runtime_error(fmt::format("Path '{}' cannot be watched: {}", watchPath->string(), strerror(errno)));
+    }
+    if (pipe2(m_wakeFd, O_CLOEXEC) == -1)
+    {
+        const auto error = errno;
+        close(m_inotifyFd);
+        throw std::runtime_error(fmt::format("Path '{}' cannot be watched: {}", watchPath->string(), strerror(error)));
+    }
+
+    try
+    {
+        addWatch(*watchPath);
+    }
+    catch (...)
+    {
+        close(m_inotifyFd);
+        close(m_wakeFd[0]);
+        close(m_wakeFd[1]);
+        throw;
+    }
+
+    m_watcher = std::thread(&CachedDriver::watch, this);
+}
+
+CachedDriver::~CachedDriver()
+{
+    if (m_watcher.joinable())
+    {
+        const char stop = 0;
+        if (write(m_wakeFd[1], &stop, sizeof(stop)) == -1)
+        {
+            LOG_WARNING("Engine cached driver could not stop the watcher: {}.", strerror(errno));
+        }
+        m_watcher.join();
+        close(m_inotifyFd);
+        close(m_wakeFd[0]);
+        close(m_wakeFd[1]);
+    }
+}
+
+void CachedDriver::addWatch(const std::filesystem::path& path)
+{
+    const auto wd = inotify_add_watch(m_inotifyFd, path.c_str(), WATCH_EVENTS | IN_ONLYDIR);
+    if (wd == -1)
+    {
+        throw std::runtime_error(fmt::format("Path '{}' cannot be watched: {}", path.string(), strerror(errno)));
+    }
+    m_dirs[wd] = path;
+
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(path, ec))
+    {
+        if (entry.is_directory(ec))
+        {
+            addWatch(entry.path());
+        }
+    }
+}
+
+void CachedDriver::watch()
+{
+    alignas(inotify_event) char buffer[4096];
+    pollfd fds[2] {{m_inotifyFd, POLLIN, 0}, {m_wakeFd[0], POLLIN, 0}};
+
+    while (true)
+    {
+        if (poll(fds, 2, -1) == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            LOG_ERROR("Engine cached driver stopped watching the store: {}.", strerror(errno));
+            return;
+        }
+        if (fds[1].revents != 0)
+        {
+            return;
+        }
+
+        bool changed = false;
+        ssize_t len;
+        while ((len = read(m_inotifyFd, buffer, sizeof(buffer))) > 0)
+        {
+            for (auto ptr = buffer; ptr < buffer + len;)
+            {
+                const auto* event = reinterpret_cast<const inotify_event*>(ptr);
+                ptr += sizeof(inotify_event) + event->len;
+
+                if (event->mask & IN_IGNORED)
+                {
+                    m_dirs.erase(event->wd);
+                    continue;
+                }
+                changed = true;
+
+                // Watch the new directories, the files moved in with them are already dropped with the cache
+                auto dir = m_dirs.find(event->wd);
+                if ((event->mask & IN_ISDIR) && (event->mask & (IN_CREATE | IN_MOVED_TO)) && dir != m_dirs.end())
+                {
+                    try
+                    {
+                        addWatch(dir->second / event->name);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        LOG_WARNING("Engine cached driver: {}.", e.what());
+                    }
+                }
+            }
+        }
+
+        if (changed)
+        {
+            LOG_TRACE("Engine cached driver: store changed on disk, dropping the cache.");
+            invalidate();
+        }
+    }
+}
+
+uint64_t CachedDriver::generation() const
+{
+    std::shared_lock lock(m_mutex);
+    return m_generation;
+}
+
+template<typename T, typename Cache>
+void CachedDriver::cacheRead(uint64_t generation, Cache& cache, const base::Name& name, const T& value) const
+{
+    std::unique_lock lock(m_mutex);
+    if (generation == m_generation)
+    {
+        cache.try_emplace(name, value);
+    }
+}
+
+void CachedDriver::invalidate()
+{
+    std::unique_lock lock(m_mutex);
+    m_docs.clear();
+    m_cols.clear();
+    m_root.reset();
+    ++m_generation;
+}
+
+void CachedDriver::invalidateDoc(const base::Name& name, bool containers)
+{
+    std::unique_lock lock(m_mutex);
+    ++m_generation;
+    m_docs.erase(name);
+    if (!containers)
+    {
+        return;
+    }
+
+    // The collections listing the document
+    std::vector<std::string> parts;
+    for (auto it = name.parts().begin(); it + 1 < name.parts().end(); ++it)
+    {
+        parts.push_back(*it);
+        m_cols.erase(base::Name(parts));
+    }
+    m_root.reset();
+}
+
+void CachedDriver::invalidateCol(const base::Name& name)
+{
+    std::unique_lock lock(m_mutex);
+    ++m_generation;
+
+    // The collection, its content and the collections containing it
+    for (auto it = m_docs.begin(); it != m_docs.end();)
+    {
+        it = isPrefix(name, it->first) ? m_docs.erase(it) : std::next(it);
+    }
+    for (auto it = m_cols.begin(); it != m_cols.end();)
+    {
+        it = isPrefix(name, it->first) || isPrefix(it->first, name) ? m_cols.erase(it) : std::next(it);
+    }
+    m_root.reset();
+}
+
+std::size_t CachedDriver::cachedDocs() const
+{
+    std::shared_lock lock(m_mutex);
+    return m_docs.size();
+}
+
+std::size_t CachedDriver::cachedCols() const
+{
+    std::shared_lock lock(m_mutex);
+    return m_cols.size();
+}
+
+base::OptError CachedDriver::createDoc(const base::Name& name, const Doc& content)
+{
+    auto error = m_driver->createDoc(name, content);
+    invalidateDoc(name, true);
+    return error;
+}
+
+base::RespOrError<Doc> CachedDriver::readDoc(const base::Name& name) const
+{
+    {
+        std::shared_lock lock(m_mutex);
+        auto it = m_docs.find(name);
+        if (it != m_docs.end())
+        {
+            return it->second;
+        }
+    }
+
+    const auto gen = generation();
+    auto result = m_driver->readDoc(name);
+    if (!base::isError(result))
+    {
+        cacheRead(gen, m_docs, name, base::getResponse<Doc>(result));
+    }
+
+    return result;
+}
+
+base::OptError CachedDriver::updateDoc(const base::Name& name, const Doc& content)
+{
+    auto error = m_driver->updateDoc(name, content);
+    invalidateDoc(name, false);
+    return error;
+}
+
+base::OptError CachedDriver::upsertDoc(const base::Name& name, const Doc& content)
+{
+    auto error = m_driver->upsertDoc(name, content);
+    invalidateDoc(name, true);
+    return error;
+}
+
+base::OptError CachedDriver::deleteDoc(const base::Name& name)
+{
+    auto error = m_driver->deleteDoc(name);
+    invalidateDoc(name, true);
+    return error;
+}
+
+base::RespOrError<Col> CachedDriver::readCol(const base::Name& name) const
+{
+    {
+        std::shared_lock lock(m_mutex);
+        auto it = m_cols.find(name);
+        if (it != m_cols.end())
+        {
+            return it->second;
+        }
+    }
+
+    const auto gen = generation();
+    auto result = m_driver->readCol(name);
+    if (!base::isError(result))
+    {
+        cacheRead(gen, m_cols, name, base::getResponse<Col>(result));
+    }
+
+    return result;
+}
+
+base::RespOrError<Col> CachedDriver::readRoot() const
+{
+    uint64_t gen;
+    {
+        std::shared_lock lock(m_mutex);
+        if (m_root)
+        {
+            return m_root.value();
+        }
+        gen = m_generation;
+    }
+
+    auto result = m_driver->readRoot();
+    if (!base::isError(result))
+    {
+        std::unique_lock lock(m_mutex);
+        if (gen == m_generation)
+        {
+            m_root = base::getResponse<Col>(result);
+        }
+    }
+
+    return result;
+}
+
+base::OptError CachedDriver::deleteCol(const base::Name& name)
+{
+    auto error = m_driver->deleteCol(name);
+    invalidateCol(name);
+    return error;
+}
+
+bool CachedDriver::exists(const base::Name& name) const
+{
+    {
+        std::shared_lock lock(m_mutex);
+        if (m_docs.find(name) != m_docs.end() || m_cols.find(name) != m_cols.end())
+        {
+            return true;
+        }
+    }
+
+    return m_driver->exists(name);
+}
+
+bool CachedDriver::existsDoc(const base::Name& name) const
+{
+    {
+        std::shared_lock lock(m_mutex);
+        if (m_docs.find(name) != m_docs.end())
+        {
+            return true;
+        }
+    }
+
+    return m_driver->existsDoc(name);
+}
+
+bool CachedDriver::existsCol(const base::Name& name) const
+{
+    {
+        std::shared_lock lock(m_mutex);
+        if (m_cols.find(name) != m_cols.end())
+        {
+            return true;
+        }
+    }
+
+    return m_driver->existsCol(name);
+}
+
+} // namespace store::drivers
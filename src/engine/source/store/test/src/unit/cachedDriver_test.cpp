@@ -0,0 +1,260 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+#include <logging/logging.hpp>
+#include <store/drivers/cachedDriver.hpp>
+#include <store/drivers/fileDriver.hpp>
+#include <store/mockDriver.hpp>
+
+using namespace store::drivers;
+using namespace store::mocks;
+using testing::Return;
+
+static const base::Name DOC_NAME({"type", "name", "version"});
+static const base::Name COL_NAME(std::vector<std::string> {"type", "name"});
+static const json::Json DOC {R"({"key": "value"})"};
+static const json::Json DOC2 {R"({"key": "value2"})"};
+
+class CachedDriverTest : public ::testing::Test
+{
+protected:
+    std::shared_ptr<MockDriver> m_mock;
+    std::shared_ptr<CachedDriver> m_driver;
+
+    void SetUp() override
+    {
+        logging::testInit();
+        m_mock = std::make_shared<MockDriver>();
+        m_driver = std::make_shared<CachedDriver>(m_mock);
+    }
+};
+
+TEST(CachedDriverBuildTest, NullDriver)
+{
+    ASSERT_THROW(CachedDriver(nullptr), std::runtime_error);
+}
+
+TEST_F(CachedDriverTest, ReadDocOnce)
+{
+    EXPECT_CALL(*m_mock, readDoc(DOC_NAME)).WillOnce(Return(driverReadDocResp(DOC)));
+
+    for (auto i = 0; i < 3; ++i)
+    {
+        auto result = m_driver->readDoc(DOC_NAME);
+        ASSERT_FALSE(base::isError(result));
+        ASSERT_EQ(base::getResponse<store::Doc>(result), DOC);
+    }
+    ASSERT_EQ(m_driver->cachedDocs(), 1);
+
+    // Known from the cache
+    ASSERT_TRUE(m_driver->existsDoc(DOC_NAME));
+    ASSERT_TRUE(m_driver->exists(DOC_NAME));
+}
+
+TEST_F(CachedDriverTest, ErrorsNotCached)
+{
+    EXPECT_CALL(*m_mock, readDoc(DOC_NAME))
+        .WillOnce(Return(driverReadError<store::Doc>()))
+        .WillOnce(Return(driverReadDocResp(DOC)));
+    EXPECT_CALL(*m_mock, readCol(COL_NAME))
+        .WillOnce(Return(driverReadError<store::Col>()))
+        .WillOnce(Return(driverReadColResp(DOC_NAME)));
+
+    ASSERT_TRUE(base::isError(m_driver->readDoc(DOC_NAME)));
+    ASSERT_FALSE(base::isError(m_driver->readDoc(DOC_NAME)));
+    ASSERT_TRUE(base::isError(m_driver->readCol(COL_NAME)));
+    ASSERT_FALSE(base::isError(m_driver->readCol(COL_NAME)));
+    ASSERT_EQ(m_driver->cachedDocs(), 1);
+    ASSERT_EQ(m_driver->cachedCols(), 1);
+}
+
+TEST_F(CachedDriverTest, ReadColAndRootOnce)
+{
+    EXPECT_CALL(*m_mock, readCol(COL_NAME)).WillOnce(Return(driverReadColResp(DOC_NAME)));
+    EXPECT_CALL(*m_mock, readRoot()).WillOnce(Return(driverReadColResp(base::Name("type"))));
+
+    for (auto i = 0; i < 3; ++i)
+    {
+        auto col = m_driver->readCol(COL_NAME);
+        ASSERT_FALSE(base::isError(col));
+        ASSERT_EQ(base::getResponse<store::Col>(col), store::Col {DOC_NAME});
+
+        auto root = m_driver->readRoot();
+        ASSERT_FALSE(base::isError(root));
+        ASSERT_EQ(base::getResponse<store::Col>(root), store::Col {base::Name("type")});
+    }
+    ASSERT_TRUE(m_driver->existsCol(COL_NAME));
+}
+
+TEST_F(CachedDriverTest, UpdateDropsDoc)
+{
+    EXPECT_CALL(*m_mock, readDoc(DOC_NAME))
+        .WillOnce(Return(driverReadDocResp(DOC)))
+        .WillOnce(Return(driverReadDocResp(DOC2)));
+    EXPECT_CALL(*m_mock, readCol(COL_NAME)).WillOnce(Return(driverReadColResp(DOC_NAME)));
+    EXPECT_CALL(*m_mock, updateDoc(DOC_NAME, DOC2)).WillOnce(Return(driverOk()));
+
+    m_driver->readDoc(DOC_NAME);
+    m_driver->readCol(COL_NAME);
+    ASSERT_FALSE(m_driver->updateDoc(DOC_NAME, DOC2));
+
+    // The collection did not change
+    ASSERT_EQ(m_driver->cachedCols(), 1);
+    ASSERT_EQ(base::getResponse<store::Doc>(m_driver->readDoc(DOC_NAME)), DOC2);
+    m_driver->readCol(COL_NAME);
+}
+
+TEST_F(CachedDriverTest, CreateAndDeleteDropContainers)
+{
+    const base::Name other({"type", "other", "version"});
+    EXPECT_CALL(*m_mock, readDoc(DOC_NAME)).WillRepeatedly(Return(driverReadDocResp(DOC)));
+    EXPECT_CALL(*m_mock, readDoc(other)).WillOnce(Return(driverReadDocResp(DOC)));
+    EXPECT_CALL(*m_mock, readCol(COL_NAME)).Times(3).WillRepeatedly(Return(driverReadColResp(DOC_NAME)));
+    EXPECT_CALL(*m_mock, readCol(base::Name("type"))).Times(3).WillRepeatedly(Return(driverReadColResp(COL_NAME)));
+    EXPECT_CALL(*m_mock, readRoot()).Times(3).WillRepeatedly(Return(driverReadColResp(base::Name("type"))));
+    EXPECT_CALL(*m_mock, createDoc(DOC_NAME, DOC)).WillOnce(Return(driverOk()));
+    EXPECT_CALL(*m_mock, deleteDoc(DOC_NAME)).WillOnce(Return(driverOk()));
+
+    const auto readAll = [this, &other]()
+    {
+        m_driver->readDoc(DOC_NAME);
+        m_driver->readDoc(other);
+        m_driver->readCol(COL_NAME);
+        m_driver->readCol(base::Name("type"));
+        m_driver->readRoot();
+    };
+
+    readAll();
+    ASSERT_FALSE(m_driver->createDoc(DOC_NAME, DOC));
+    ASSERT_EQ(m_driver->cachedDocs(), 1);
+    ASSERT_EQ(m_driver->cachedCols(), 0);
+
+    readAll();
+    ASSERT_FALSE(m_driver->deleteDoc(DOC_NAME));
+    ASSERT_EQ(m_driver->cachedDocs(), 1);
+    ASSERT_EQ(m_driver->cachedCols(), 0);
+
+    readAll();
+}
+
+TEST_F(CachedDriverTest, DeleteColDropsContent)
+{
+    const base::Name other({"other", "name", "version"});
+    EXPECT_CALL(*m_mock, readDoc(DOC_NAME)).Times(2).WillRepeatedly(Return(driverReadDocResp(DOC)));
+    EXPECT_CALL(*m_mock, readDoc(other)).WillOnce(Return(driverReadDocResp(DOC)));
+    EXPECT_CALL(*m_mock, readCol(COL_NAME)).Times(2).WillRepeatedly(Return(driverReadColResp(DOC_NAME)));
+    EXPECT_CALL(*m_mock, deleteCol(COL_NAME)).WillOnce(Return(driverOk()));
+
+    m_driver->readDoc(DOC_NAME);
+    m_driver->readDoc(other);
+    m_driver->readCol(COL_NAME);
+    ASSERT_FALSE(m_driver->deleteCol(COL_NAME));
+    ASSERT_EQ(m_driver->cachedDocs(), 1);
+    ASSERT_EQ(m_driver->cachedCols(), 0);
+
+    m_driver->readDoc(DOC_NAME);
+    m_driver->readDoc(other);
+    m_driver->readCol(COL_NAME);
+}
+
+TEST_F(CachedDriverTest, FailedWriteDropsDoc)
+{
+    EXPECT_CALL(*m_mock, readDoc(DOC_NAME)).Times(2).WillRepeatedly(Return(driverReadDocResp(DOC)));
+    EXPECT_CALL(*m_mock, updateDoc(DOC_NAME, DOC2)).WillOnce(Return(driverError()));
+
+    m_driver->readDoc(DOC_NAME);
+    ASSERT_TRUE(m_driver->updateDoc(DOC_NAME, DOC2));
+    m_driver->readDoc(DOC_NAME);
+}
+
+TEST_F(CachedDriverTest, Invalidate)
+{
+    EXPECT_CALL(*m_mock, readDoc(DOC_NAME)).Times(2).WillRepeatedly(Return(driverReadDocResp(DOC)));
+
+    m_driver->readDoc(DOC_NAME);
+    m_driver->invalidate();
+    ASSERT_EQ(m_driver->cachedDocs(), 0);
+    m_driver->readDoc(DOC_NAME);
+}
+
+TEST_F(CachedDriverTest, ConcurrentReads)
+{
+    EXPECT_CALL(*m_mock, readDoc(DOC_NAME)).WillRepeatedly(Return(driverReadDocResp(DOC)));
+
+    std::vector<std::thread> threads;
+    for (auto t = 0; t < 4; ++t)
+    {
+        threads.emplace_back(
+            [this]()
+            {
+                for (auto i = 0; i < 1000; ++i)
+                {
+                    auto result = m_driver->readDoc(DOC_NAME);
+                    ASSERT_FALSE(base::isError(result));
+                    if (i % 100 == 0)
+                    {
+                        m_driver->invalidate();
+                    }
+                }
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+class CachedDriverWatchTest : public ::testing::Test
+{
+protected:
+    std::filesystem::path m_path;
+
+    void SetUp() override
+    {
+        logging::testInit();
+        m_path = std::filesystem::path("/tmp/cachedDriver_test") / std::to_string(getpid());
+        std::filesystem::create_directories(m_path);
+    }
+
+    void TearDown() override { std::filesystem::remove_all(m_path); }
+
+    // Wait for the watcher to drop the cache
+    static bool waitDropped(const CachedDriver& driver)
+    {
+        for (auto i = 0; i < 200 && driver.cachedDocs() != 0; ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return driver.cachedDocs() == 0;
+    }
+};
+
+TEST_F(CachedDriverWatchTest, UnknownPath)
+{
+    auto fileDriver = std::make_shared<FileDriver>(m_path);
+    ASSERT_THROW(CachedDriver(fileDriver, m_path / "unknown"), std::runtime_error);
+}
+
+TEST_F(CachedDriverWatchTest, OutOfBandEdit)
+{
+    auto fileDriver = std::make_shared<FileDriver>(m_path);
+    CachedDriver driver(fileDriver, m_path);
+    ASSERT_FALSE(driver.createDoc(DOC_NAME, DOC));
+    // Let the watcher see the events of the creation
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    ASSERT_EQ(base::getResponse<store::Doc>(driver.readDoc(DOC_NAME)), DOC);
+    ASSERT_EQ(driver.cachedDocs(), 1);
+
+    // Edited in a directory created after the watch started
+    {
+        std::ofstream file(m_path / "type" / "name" / "version");
+        file << DOC2.str();
+    }
+    ASSERT_TRUE(waitDropped(driver));
+    ASSERT_EQ(base::getResponse<store::Doc>(driver.readDoc(DOC_NAME)), DOC2);
+}
@@ -6,6 +6,7 @@
 #include <map>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include <sockiface/isockHandler.hpp>
 #include <wdb/iwdbHandler.hpp>
@@ -18,6 +19,15 @@ constexpr std::string_view WDB_SOCK_PATH {"/var/ossec/queue/db/wdb"};
 
 constexpr auto SOCKET_NOT_CONNECTED {-1}; ///< Socket not connected (status)
 
+/**
+ * @brief Parse a query result
+ *
+ * @param result Result of the query
+ * @return std::tuple<QueryResultCodes, std::optional<std::string>> Tuple with the
+ * code and the optional data (payload)
+ */
+std::tuple<QueryResultCodes, std::optional<std::string>> parseQueryResult(const std::string& result) noexcept;
+
 /**
  * @brief WazuhDB class
  *
@@ -30,6 +40,7 @@ class WDBHandler final : public IWDBHandler
 private:
     // State and configuration
     std::shared_ptr<sockiface::ISockHandler> m_socket; ///< Socket to the wdb
+    std::vector<char> m_recvBuffer;                    ///< Reused to receive the results
 
 public:
     /** @brief Create a WazuhDB object from a path
@@ -8,6 +8,7 @@
 #include <wdb/iwdbManager.hpp>
 
 #include "wdbHandler.hpp"
+#include "wdbPool.hpp"
 
 namespace wazuhdb
 {
@@ -17,6 +18,7 @@ class WDBManager final : public IWDBManager
 private:
     std::string m_sockPath;
     std::shared_ptr<sockiface::ISockFactory> m_sockFactory;
+    std::shared_ptr<WDBPool> m_pool; ///< Connections shared by the handlers, if any
 
 public:
     using sockProtocol = sockiface::ISockHandler::Protocol;
@@ -24,17 +26,35 @@ public:
     WDBManager(const std::string& sockPath, std::shared_ptr<sockiface::ISockFactory> sockFactory)
         : m_sockPath(sockPath)
         , m_sockFactory(sockFactory)
+        , m_pool()
     {
     }
 
-    ~WDBManager() = default;
-
-    /** @brief Create a WazuhDB connection handler from a path
+    /** @brief Create a manager whose handlers share a pool of connections
      *
      * @param sockPath Path to the wdb socket
+     * @param sockFactory Factory of the sockets
+     * @param poolOptions Options of the pool, 0 connections gives each handler its own connection
+     */
+    WDBManager(const std::string& sockPath,
+               std::shared_ptr<sockiface::ISockFactory> sockFactory,
+               const WDBPoolOptions& poolOptions)
+        : m_sockPath(sockPath)
+        , m_sockFactory(sockFactory)
+        , m_pool(poolOptions.connections > 0 ? std::make_shared<WDBPool>(sockPath, sockFactory, poolOptions) : nullptr)
+    {
+    }
+
+    ~WDBManager() = default;
+
+    /** @brief Create a WazuhDB connection handler, over the pool if any
      */
     std::shared_ptr<IWDBHandler> connection() override
     {
+        if (m_pool)
+        {
+            return std::make_shared<WDBPooledHandler>(m_pool);
+        }
         auto socket = m_sockFactory->getHandler(sockProtocol::STREAM, m_sockPath);
         return std::make_shared<WDBHandler>(socket);
     }
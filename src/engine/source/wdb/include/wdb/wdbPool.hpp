@@ -0,0 +1,202 @@
+#ifndef _WDB_WDB_POOL_HPP
+#define _WDB_WDB_POOL_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <sockiface/isockFactory.hpp>
+#include <wdb/iwdbHandler.hpp>
+
+namespace wazuhdb
+{
+
+constexpr std::size_t DEFAULT_POOL_CONNECTIONS = 4;           ///< Connections shared by all the handlers
+constexpr std::chrono::milliseconds DEFAULT_CACHE_TTL {1000}; ///< Time a read-only result is cached, 0 disables it
+constexpr std::size_t DEFAULT_QUERY_CACHE_SIZE = 1024;        ///< Read-only results cached
+
+/**
+ * @brief Options of a WazuhDB connection pool.
+ */
+struct WDBPoolOptions
+{
+    std::size_t connections {DEFAULT_POOL_CONNECTIONS};    ///< Connections to the wdb socket
+    std::chrono::milliseconds cacheTTL {DEFAULT_CACHE_TTL}; ///< Time a read-only result is cached, 0 disables it
+    std::size_t cacheSize {DEFAULT_QUERY_CACHE_SIZE};      ///< Read-only results cached
+};
+
+/**
+ * @brief Persistent connections to the wdb socket, shared by the handlers of all the workers.
+ *
+ * The queries are spread over the connections. WazuhDB answers the queries of a connection in the order they were
+ * sent, so a query is sent as soon as the previous one left, without waiting for its result, and the results are
+ * matched to the queries in the same order. When a connection fails, the queries waiting on it fail and the next query
+ * reconnects it.
+ *
+ * The results of the read-only queries (get, select and sql select commands) are cached for a short time.
+ */
+class WDBPool
+{
+public:
+    /**
+     * @brief Construct a new WDBPool object, the connections are opened by the first query sent on them.
+     *
+     * @param sockPath Path to the wdb socket
+     * @param sockFactory Factory of the sockets
+     * @param options The options
+     * @throw std::runtime_error if the number of connections is 0
+     */
+    WDBPool(const std::string& sockPath,
+            std::shared_ptr<sockiface::ISockFactory> sockFactory,
+            const WDBPoolOptions& options = {});
+
+    /**
+     * @brief Connect all the connections
+     *
+     * @throw std::runtime_error if cannot connect to the wdb socket
+     */
+    void connect();
+
+    /**
+     * @brief perform a query to the wdb socket, using the cached result of a read-only query if not expired
+     *
+     * @param query Query to perform
+     * @return std::string Result of the query. Empty if the query is empty or too long.
+     *
+     * @throw socketinterface::RecoverableError if cannot perform the query because the
+     * remote socket is closed (EPIPE, ECONNRESET or gracefully closed), or the connection failed
+     * while the query waited for its result.
+     * @throw std::runtime_error if cannot perform the query because of other reasons.
+     */
+    std::string query(const std::string& query);
+
+    /**
+     * @brief Get the maximum size of a query
+     *
+     * @return size_t
+     */
+    size_t getQueryMaxSize() const noexcept;
+
+    /**
+     * @brief Get the number of cached results
+     *
+     * @return std::size_t
+     */
+    std::size_t getCacheSize() const;
+
+    /**
+     * @brief Drop all the cached results
+     */
+    void clearCache();
+
+    /**
+     * @brief Check if a query only reads from WazuhDB, so its result can be cached
+     *
+     * @param query The query, `<global|mitre|task> <command> ...` or `agent <id> <command> ...`
+     * @return true if the command is a get, select or sql select one
+     */
+    static bool isReadOnly(std::string_view query);
+
+private:
+    struct Connection
+    {
+        std::shared_ptr<sockiface::ISockHandler> socket; ///< Socket to the wdb
+        std::vector<char> recvBuffer;                    ///< Reused to receive the results
+        std::mutex sendMutex;                            ///< Serializes the sends
+        std::mutex mutex;                                ///< Protects the state below
+        std::condition_variable cv;                      ///< Wakes the queries waiting for their result
+        uint64_t sent {0};                               ///< Queries sent since the reconnection
+        uint64_t received {0};                           ///< Results received since the reconnection
+        std::size_t pending {0};                         ///< Queries sent or sending, not answered yet
+        bool broken {false};                             ///< The connection failed, the pending queries fail
+    };
+
+    struct CachedResult
+    {
+        std::string result;                            ///< Result of the query
+        std::chrono::steady_clock::time_point expires; ///< When the result stops being used
+    };
+
+    std::vector<std::unique_ptr<Connection>> m_connections; ///< The connections
+    std::atomic<std::size_t> m_next;                        ///< Next connection to use
+    WDBPoolOptions m_options;                               ///< The options
+
+    mutable std::mutex m_cacheMutex;                       ///< Protects the cache
+    std::unordered_map<std::string, CachedResult> m_cache; ///< Results of the read-only queries
+
+    std::string pipelinedQuery(Connection& conn, const std::string& query);
+    void markBroken(Connection& conn);
+    std::optional<std::string> getCached(const std::string& query);
+    void putCached(const std::string& query, const std::string& result);
+};
+
+/**
+ * @brief WazuhDB handler performing its queries through a shared pool.
+ *
+ * Thread-safe, the connection state lives in the pool.
+ */
+class WDBPooledHandler final : public IWDBHandler
+{
+private:
+    std::shared_ptr<WDBPool> m_pool; ///< The shared connections
+
+public:
+    /** @brief Create a handler over a pool
+     *
+     * @param pool The connection pool
+     */
+    explicit WDBPooledHandler(std::shared_ptr<WDBPool> pool)
+        : m_pool(std::move(pool)) {};
+
+    /**
+     * @copydoc WDBPool::connect
+     */
+    void connect() override { m_pool->connect(); };
+
+    /**
+     * @copydoc WDBPool::query
+     */
+    std::string query(const std::string& query) override { return m_pool->query(query); };
+
+    /**
+     * @brief Try to perform a query `attempts` times, the failed connection is reconnected by the next attempt
+     *
+     * @param query Query to perform
+     * @param attempts Number of attempts to perform the query
+     * @return std::string Result of the query. Empty if the query fail (And log the
+     * error).
+     */
+    std::string tryQuery(const std::string& query, uint attempts) noexcept override;
+
+    /**
+     * @copydoc WDBHandler::parseResult
+     */
+    std::tuple<QueryResultCodes, std::optional<std::string>>
+    parseResult(const std::string& result) const noexcept override;
+
+    /**
+     * @copydoc WDBHandler::queryAndParseResult
+     */
+    std::tuple<QueryResultCodes, std::optional<std::string>> queryAndParseResult(const std::string& query) override;
+
+    /**
+     * @copydoc WDBHandler::tryQueryAndParseResult
+     */
+    std::tuple<QueryResultCodes, std::optional<std::string>>
+    tryQueryAndParseResult(const std::string& query, const unsigned int attempts) noexcept override;
+
+    size_t getQueryMaxSize() const noexcept override { return m_pool->getQueryMaxSize(); };
+};
+
+} // namespace wazuhdb
+
+#endif // _WDB_WDB_POOL_HPP
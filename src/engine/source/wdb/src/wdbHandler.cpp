@@ -33,7 +33,7 @@ std::string WDBHandler::query(const std::string& query)
     if (SendRetval::SUCCESS == sendStatus)
     {
         // Receive the result, throw runtime_error if cannot receive
-        result = m_socket->recvString();
+        result = m_socket->recvView(m_recvBuffer);
     }
     else if (SendRetval::SOCKET_ERROR == sendStatus)
     {
@@ -52,8 +52,7 @@ std::string WDBHandler::query(const std::string& query)
     return result;
 }
 
-std::tuple<QueryResultCodes, std::optional<std::string>>
-WDBHandler::parseResult(const std::string& result) const noexcept
+std::tuple<QueryResultCodes, std::optional<std::string>> parseQueryResult(const std::string& result) noexcept
 {
 
     QueryResultCodes code {QueryResultCodes::OK};
@@ -86,6 +85,12 @@ WDBHandler::parseResult(const std::string& result) const noexcept
     return std::make_tuple(code, std::move(payload));
 }
 
+std::tuple<QueryResultCodes, std::optional<std::string>>
+WDBHandler::parseResult(const std::string& result) const noexcept
+{
+    return parseQueryResult(result);
+}
+
 std::string WDBHandler::tryQuery(const std::string& query, uint attempts) noexcept
 {
 
@@ -0,0 +1,349 @@
+#include "wdbPool.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include <strings.h>
+
+#include <fmt/format.h>
+
+#include <logging/logging.hpp>
+
+#include "wdbHandler.hpp"
+
+namespace wazuhdb
+{
+
+using RecoverableError = sockiface::ISockHandler::RecoverableError;
+using SendRetval = sockiface::ISockHandler::SendRetval;
+
+namespace
+{
+/**
+ * @brief Take the next space separated word of a query
+ */
+std::string_view nextWord(std::string_view query, std::size_t& pos)
+{
+    const auto begin = query.find_first_not_of(' ', pos);
+    if (begin == std::string_view::npos)
+    {
+        pos = query.size();
+        return {};
+    }
+    const auto end = std::min(query.find(' ', begin), query.size());
+    pos = end;
+    return query.substr(begin, end - begin);
+}
+
+bool startsWith(std::string_view str, std::string_view prefix)
+{
+    return str.substr(0, prefix.size()) == prefix;
+}
+} // namespace
+
+WDBPool::WDBPool(const std::string& sockPath,
+                 std::shared_ptr<sockiface::ISockFactory> sockFactory,
+                 const WDBPoolOptions& options)
+    : m_connections()
+    , m_next(0)
+    , m_options(options)
+    , m_cacheMutex()
+    , m_cache()
+{
+    if (options.connections == 0)
+    {
+        throw std::runtime_error("Engine WDB: The connection pool needs at least one connection");
+    }
+
+    for (std::size_t i = 0; i < options.connections; ++i)
+    {
+        auto conn = std::make_unique<Connection>();
+        conn->socket = sockFactory->getHandler(sockiface::ISockHandler::Protocol::STREAM, sockPath);
+        m_connections.emplace_back(std::move(conn));
+    }
+}
+
+void WDBPool::connect()
+{
+    for (auto& conn : m_connections)
+    {
+        std::lock_guard<std::mutex> sendLock(conn->sendMutex);
+        std::unique_lock<std::mutex> lock(conn->mutex);
+        conn->cv.wait(lock, [&conn]() { return conn->pending == 0; });
+        conn->socket->socketConnect();
+        conn->broken = false;
+        conn->sent = 0;
+        conn->received = 0;
+    }
+}
+
+size_t WDBPool::getQueryMaxSize() const noexcept
+{
+    return m_connections.front()->socket->getMaxMsgSize();
+}
+
+std::string WDBPool::query(const std::string& query)
+{
+    if (0 == query.length())
+    {
+        LOG_WARNING("Engine WDB: The query to send is empty.");
+        return {};
+    }
+    else if (query.length() > getQueryMaxSize())
+    {
+        LOG_WARNING("Engine WDB: The query to send is too long: {} characters (Maximum allowed size is {} characters).",
+                    query.length(),
+                    getQueryMaxSize());
+        return {};
+    }
+
+    const auto cacheable = m_options.cacheTTL.count() > 0 && m_options.cacheSize > 0 && isReadOnly(query);
+    if (cacheable)
+    {
+        if (auto cached = getCached(query))
+        {
+            return std::move(cached.value());
+        }
+    }
+
+    auto& conn = *m_connections[m_next.fetch_add(1, std::memory_order_relaxed) % m_connections.size()];
+    auto result = pipelinedQuery(conn, query);
+
+    // Only the successful results are cached, the errors are retried
+    if (cacheable && (result == "ok" || startsWith(result, "ok ")))
+    {
+        putCached(query, result);
+    }
+
+    return result;
+}
+
+std::string WDBPool::pipelinedQuery(Connection& conn, const std::string& query)
+{
+    uint64_t ticket {0};
+    {
+        std::lock_guard<std::mutex> sendLock(conn.sendMutex);
+        {
+            std::unique_lock<std::mutex> lock(conn.mutex);
+            if (conn.broken)
+            {
+                // Let the queries of the failed connection leave before reusing it
+                conn.cv.wait(lock, [&conn]() { return conn.pending == 0; });
+                conn.socket->socketDisconnect();
+                conn.broken = false;
+                conn.sent = 0;
+                conn.received = 0;
+            }
+            ticket = conn.sent;
+            ++conn.pending;
+        }
+
+        // Send the query (connect if not connected), throw runtime_error if cannot send
+        SendRetval sendStatus;
+        try
+        {
+            sendStatus = conn.socket->sendMsg(query);
+        }
+        catch (...)
+        {
+            markBroken(conn);
+            throw;
+        }
+
+        if (SendRetval::SUCCESS != sendStatus)
+        {
+            markBroken(conn);
+            if (SendRetval::SOCKET_ERROR == sendStatus)
+            {
+                throw std::runtime_error(
+                    fmt::format("Engine WDB: sendMsg() method failed: {} ({})", strerror(errno), errno));
+            }
+            // SIZE_ZERO, SIZE_TOO_LONG never reach here
+            throw std::logic_error(
+                fmt::format("Engine WDB: sendMsg() method reached a condition that should never happen "
+                            "(Query status = {})",
+                            sendStatus == SendRetval::SIZE_ZERO ? 1 : 2));
+        }
+
+        std::lock_guard<std::mutex> lock(conn.mutex);
+        ++conn.sent;
+    }
+
+    // Wait for the results of the queries sent before
+    {
+        std::unique_lock<std::mutex> lock(conn.mutex);
+        conn.cv.wait(lock, [&conn, ticket]() { return conn.broken || conn.received == ticket; });
+        if (conn.broken)
+        {
+            --conn.pending;
+            conn.cv.notify_all();
+            throw RecoverableError("Engine WDB: The connection failed while waiting for the query result");
+        }
+    }
+
+    // Only this query reads until the received count moves on
+    std::string result;
+    try
+    {
+        result = conn.socket->recvView(conn.recvBuffer);
+    }
+    catch (...)
+    {
+        markBroken(conn);
+        throw;
+    }
+
+    std::lock_guard<std::mutex> lock(conn.mutex);
+    ++conn.received;
+    --conn.pending;
+    conn.cv.notify_all();
+
+    return result;
+}
+
+void WDBPool::markBroken(Connection& conn)
+{
+    std::lock_guard<std::mutex> lock(conn.mutex);
+    conn.broken = true;
+    --conn.pending;
+    conn.cv.notify_all();
+}
+
+std::optional<std::string> WDBPool::getCached(const std::string& query)
+{
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    auto it = m_cache.find(query);
+    if (it == m_cache.end())
+    {
+        return std::nullopt;
+    }
+    if (it->second.expires <= std::chrono::steady_clock::now())
+    {
+        m_cache.erase(it);
+        return std::nullopt;
+    }
+    return it->second.result;
+}
+
+void WDBPool::putCached(const std::string& query, const std::string& result)
+{
+    const auto now = std::chrono::steady_clock::now();
+
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    if (m_cache.size() >= m_options.cacheSize && m_cache.find(query) == m_cache.end())
+    {
+        // Drop the expired results, or any result if none expired
+        for (auto it = m_cache.begin(); it != m_cache.end();)
+        {
+            it = it->second.expires <= now ? m_cache.erase(it) : std::next(it);
+        }
+        if (m_cache.size() >= m_options.cacheSize)
+        {
+            m_cache.erase(m_cache.begin());
+        }
+    }
+    m_cache.insert_or_assign(query, CachedResult {result, now + m_options.cacheTTL});
+}
+
+std::size_t WDBPool::getCacheSize() const
+{
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    return m_cache.size();
+}
+
+void WDBPool::clearCache()
+{
+    std::lock_guard<std::mutex> lock(m_cacheMutex);
+    m_cache.clear();
+}
+
+bool WDBPool::isReadOnly(std::string_view query)
+{
+    std::size_t pos = 0;
+    const auto target = nextWord(query, pos);
+    if (target == "agent")
+    {
+        // Agent id
+        nextWord(query, pos);
+    }
+    else if (target != "global" && target != "mitre" && target != "task")
+    {
+        return false;
+    }
+
+    const auto command = nextWord(query, pos);
+    if (command == "get" || command == "select" || startsWith(command, "get-") || startsWith(command, "select-"))
+    {
+        return true;
+    }
+
+    if (command == "sql")
+    {
+        // A single select statement
+        const auto statement = nextWord(query, pos);
+        return statement.size() == 6 && strncasecmp(statement.data(), "select", 6) == 0
+               && query.find(';') == std::string_view::npos;
+    }
+
+    return false;
+}
+
+std::string WDBPooledHandler::tryQuery(const std::string& query, uint attempts) noexcept
+{
+    std::string result {};
+    std::optional<std::string> disconnectError {};
+
+    for (unsigned int i {0}; i < attempts; i++)
+    {
+        try
+        {
+            result = m_pool->query(query);
+            break;
+        }
+        catch (const RecoverableError& e)
+        {
+            // The pool reconnects the connection on the next attempt
+            LOG_DEBUG("Engine WDB: Query failed (attempt {}): {}.", i, e.what());
+            disconnectError = e.what();
+        }
+        catch (const std::exception& e)
+        {
+            LOG_WARNING("Engine WDB: WDBPooledHandler::tryQuery() method failed in an irrecuperable way: {}.",
+                        e.what());
+            break;
+        }
+        catch (...)
+        {
+            LOG_WARNING(
+                "Engine WDB: WDBPooledHandler::tryQuery() method failed in an irrecuperable way: unknown error.");
+            break;
+        }
+    }
+
+    if (0 == result.length() && disconnectError.has_value())
+    {
+        LOG_WARNING("Engine WDB: WDBPooledHandler::tryQuery() method failed: {}.", disconnectError.value());
+    }
+
+    return result;
+}
+
+std::tuple<QueryResultCodes, std::optional<std::string>>
+WDBPooledHandler::parseResult(const std::string& result) const noexcept
+{
+    return parseQueryResult(result);
+}
+
+std::tuple<QueryResultCodes, std::optional<std::string>> WDBPooledHandler::queryAndParseResult(const std::string& q)
+{
+    return parseQueryResult(query(q));
+}
+
+std::tuple<QueryResultCodes, std::optional<std::string>>
+WDBPooledHandler::tryQueryAndParseResult(const std::string& q, const uint attempts) noexcept
+{
+    return parseQueryResult(tryQuery(q, attempts));
+}
+
+} // namespace wazuhdb
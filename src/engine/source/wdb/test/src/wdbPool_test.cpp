@@ -0,0 +1,345 @@
+#include <wdb/wdbManager.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include <logging/logging.hpp>
+#include <sockiface/mockSockFactory.hpp>
+#include <sockiface/mockSockHandler.hpp>
+
+using namespace wazuhdb;
+using namespace sockiface::mocks;
+
+namespace
+{
+constexpr const char* TEST_DUMMY_PATH {"/dummy/path"};
+constexpr const char* TEST_READ_QUERY {"global get-agent-info 1"};
+constexpr const char* TEST_WRITE_QUERY {"global update-keepalive 1"};
+
+/**
+ * @brief Fake wazuh-db connection answering the queries in order with `ok <query>`
+ */
+struct EchoServer
+{
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<std::string> queued;
+    std::size_t sent {0};
+    std::size_t maxInFlight {0};
+
+    void install(MockSockHandler& sock)
+    {
+        EXPECT_CALL(sock, getMaxMsgSize()).WillRepeatedly(testing::Return(1024));
+        EXPECT_CALL(sock, sendMsg(testing::_))
+            .WillRepeatedly(testing::Invoke(
+                [this](const std::string& msg)
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    queued.push_back(msg);
+                    ++sent;
+                    maxInFlight = std::max(maxInFlight, queued.size());
+                    cv.notify_all();
+                    return successSendMsgRes();
+                }));
+        EXPECT_CALL(sock, recvMsg())
+            .WillRepeatedly(testing::Invoke(
+                [this]()
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    cv.wait(lock, [this]() { return !queued.empty(); });
+                    auto msg = std::move(queued.front());
+                    queued.pop_front();
+                    return recvMsgRes("ok " + msg);
+                }));
+    }
+};
+
+std::vector<std::shared_ptr<MockSockHandler>> expectSockets(MockSockFactory& factory, std::size_t count)
+{
+    std::vector<std::shared_ptr<MockSockHandler>> sockets;
+    testing::Sequence seq;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        sockets.emplace_back(std::make_shared<MockSockHandler>());
+        EXPECT_CALL(factory, getHandler(sockiface::ISockHandler::Protocol::STREAM, TEST_DUMMY_PATH))
+            .InSequence(seq)
+            .WillOnce(testing::Return(sockets.back()));
+    }
+    return sockets;
+}
+} // namespace
+
+class WDBPoolTest : public ::testing::Test
+{
+protected:
+    std::shared_ptr<MockSockFactory> m_factory;
+
+    void SetUp() override
+    {
+        logging::testInit();
+        m_factory = std::make_shared<MockSockFactory>();
+    }
+};
+
+TEST_F(WDBPoolTest, NoConnections)
+{
+    WDBPoolOptions options;
+    options.connections = 0;
+    ASSERT_THROW(WDBPool(TEST_DUMMY_PATH, m_factory, options), std::runtime_error);
+}
+
+TEST_F(WDBPoolTest, ManagerWithoutPool)
+{
+    WDBPoolOptions options;
+    options.connections = 0;
+    auto sockets = expectSockets(*m_factory, 2);
+    WDBManager manager(TEST_DUMMY_PATH, m_factory, options);
+
+    // One connection per handler
+    ASSERT_NE(std::dynamic_pointer_cast<WDBHandler>(manager.connection()), nullptr);
+    ASSERT_NE(std::dynamic_pointer_cast<WDBHandler>(manager.connection()), nullptr);
+}
+
+TEST_F(WDBPoolTest, ManagerSharesPool)
+{
+    WDBPoolOptions options;
+    options.connections = 2;
+    auto sockets = expectSockets(*m_factory, 2);
+    WDBManager manager(TEST_DUMMY_PATH, m_factory, options);
+
+    // No more sockets are created by the handlers
+    for (auto i = 0; i < 4; ++i)
+    {
+        ASSERT_NE(std::dynamic_pointer_cast<WDBPooledHandler>(manager.connection()), nullptr);
+    }
+}
+
+TEST_F(WDBPoolTest, QueriesSpreadOverConnections)
+{
+    WDBPoolOptions options;
+    options.connections = 2;
+    auto sockets = expectSockets(*m_factory, 2);
+    EchoServer servers[2];
+    servers[0].install(*sockets[0]);
+    servers[1].install(*sockets[1]);
+    WDBPool pool(TEST_DUMMY_PATH, m_factory, options);
+
+    for (auto i = 0; i < 4; ++i)
+    {
+        ASSERT_EQ(pool.query(TEST_WRITE_QUERY), std::string("ok ") + TEST_WRITE_QUERY);
+    }
+    ASSERT_EQ(servers[0].sent, 2);
+    ASSERT_EQ(servers[1].sent, 2);
+}
+
+TEST_F(WDBPoolTest, EmptyAndTooLongQuery)
+{
+    WDBPoolOptions options;
+    options.connections = 1;
+    auto sockets = expectSockets(*m_factory, 1);
+    EXPECT_CALL(*sockets[0], getMaxMsgSize()).WillRepeatedly(testing::Return(4));
+    EXPECT_CALL(*sockets[0], sendMsg(testing::_)).Times(0);
+    WDBPool pool(TEST_DUMMY_PATH, m_factory, options);
+
+    ASSERT_EQ(pool.query(""), "");
+    ASSERT_EQ(pool.query("too long"), "");
+}
+
+TEST_F(WDBPoolTest, PipelinedResultsMatchQueries)
+{
+    constexpr auto threads = 8;
+    constexpr auto perThread = 200;
+
+    WDBPoolOptions options;
+    options.connections = 1;
+    options.cacheTTL = std::chrono::milliseconds {0};
+    auto sockets = expectSockets(*m_factory, 1);
+    EchoServer server;
+    server.install(*sockets[0]);
+    auto pool = std::make_shared<WDBPool>(TEST_DUMMY_PATH, m_factory, options);
+
+    std::vector<std::thread> workers;
+    std::atomic<int> mismatches {0};
+    for (auto t = 0; t < threads; ++t)
+    {
+        workers.emplace_back(
+            [pool, t, &mismatches]()
+            {
+                std::shared_ptr<IWDBHandler> handler = std::make_shared<WDBPooledHandler>(pool);
+                for (auto i = 0; i < perThread; ++i)
+                {
+                    const auto query = fmt::format("global get-agent-info {}-{}", t, i);
+                    auto [code, payload] = handler->tryQueryAndParseResult(query);
+                    if (code != QueryResultCodes::OK || payload.value_or("") != query)
+                    {
+                        ++mismatches;
+                    }
+                }
+            });
+    }
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    ASSERT_EQ(mismatches, 0);
+    ASSERT_EQ(server.sent, threads * perThread);
+}
+
+TEST_F(WDBPoolTest, SendsWithoutWaitingForResults)
+{
+    WDBPoolOptions options;
+    options.connections = 1;
+    auto sockets = expectSockets(*m_factory, 1);
+    EchoServer server;
+    server.install(*sockets[0]);
+
+    // The first result is only read once the second query was sent
+    EXPECT_CALL(*sockets[0], recvMsg())
+        .WillRepeatedly(testing::Invoke(
+            [&server]()
+            {
+                std::unique_lock<std::mutex> lock(server.mutex);
+                server.cv.wait_for(lock, std::chrono::seconds {5}, [&server]() { return server.sent >= 2; });
+                auto msg = std::move(server.queued.front());
+                server.queued.pop_front();
+                return recvMsgRes("ok " + msg);
+            }));
+    WDBPool pool(TEST_DUMMY_PATH, m_factory, options);
+
+    std::string results[2];
+    std::thread first([&pool, &results]() { results[0] = pool.query("global update-keepalive 1"); });
+    std::thread second([&pool, &results]() { results[1] = pool.query("global update-keepalive 2"); });
+    first.join();
+    second.join();
+
+    ASSERT_EQ(results[0], "ok global update-keepalive 1");
+    ASSERT_EQ(results[1], "ok global update-keepalive 2");
+    ASSERT_EQ(server.maxInFlight, 2);
+}
+
+TEST_F(WDBPoolTest, ReconnectsAfterFailure)
+{
+    WDBPoolOptions options;
+    options.connections = 1;
+    auto sockets = expectSockets(*m_factory, 1);
+    EXPECT_CALL(*sockets[0], getMaxMsgSize()).WillRepeatedly(testing::Return(1024));
+    EXPECT_CALL(*sockets[0], sendMsg(testing::_))
+        .WillOnce(testing::Throw(sockiface::ISockHandler::RecoverableError("Error sending message")))
+        .WillOnce(testing::Return(successSendMsgRes()));
+    EXPECT_CALL(*sockets[0], socketDisconnect()).Times(1);
+    EXPECT_CALL(*sockets[0], recvMsg()).WillOnce(testing::Return(recvMsgRes("ok")));
+    WDBPooledHandler handler(std::make_shared<WDBPool>(TEST_DUMMY_PATH, m_factory, options));
+
+    ASSERT_EQ(handler.tryQuery(TEST_WRITE_QUERY, 2), "ok");
+}
+
+TEST_F(WDBPoolTest, IrrecoverableError)
+{
+    WDBPoolOptions options;
+    options.connections = 1;
+    auto sockets = expectSockets(*m_factory, 1);
+    EXPECT_CALL(*sockets[0], getMaxMsgSize()).WillRepeatedly(testing::Return(1024));
+    EXPECT_CALL(*sockets[0], sendMsg(testing::_))
+        .WillOnce(testing::Throw(std::runtime_error("Error sending message")));
+    WDBPooledHandler handler(std::make_shared<WDBPool>(TEST_DUMMY_PATH, m_factory, options));
+
+    // Empty string on error, no more attempts
+    ASSERT_EQ(handler.tryQuery(TEST_WRITE_QUERY, 2), "");
+}
+
+TEST_F(WDBPoolTest, CachesReadOnlyResults)
+{
+    WDBPoolOptions options;
+    options.connections = 1;
+    auto sockets = expectSockets(*m_factory, 1);
+    EchoServer server;
+    server.install(*sockets[0]);
+    WDBPool pool(TEST_DUMMY_PATH, m_factory, options);
+
+    for (auto i = 0; i < 3; ++i)
+    {
+        ASSERT_EQ(pool.query(TEST_READ_QUERY), std::string("ok ") + TEST_READ_QUERY);
+        ASSERT_EQ(pool.query(TEST_WRITE_QUERY), std::string("ok ") + TEST_WRITE_QUERY);
+    }
+    ASSERT_EQ(server.sent, 4);
+    ASSERT_EQ(pool.getCacheSize(), 1);
+
+    pool.clearCache();
+    pool.query(TEST_READ_QUERY);
+    ASSERT_EQ(server.sent, 5);
+}
+
+TEST_F(WDBPoolTest, CachedResultsExpire)
+{
+    WDBPoolOptions options;
+    options.connections = 1;
+    options.cacheTTL = std::chrono::milliseconds {1};
+    auto sockets = expectSockets(*m_factory, 1);
+    EchoServer server;
+    server.install(*sockets[0]);
+    WDBPool pool(TEST_DUMMY_PATH, m_factory, options);
+
+    pool.query(TEST_READ_QUERY);
+    std::this_thread::sleep_for(std::chrono::milliseconds {5});
+    pool.query(TEST_READ_QUERY);
+    ASSERT_EQ(server.sent, 2);
+}
+
+TEST_F(WDBPoolTest, ErrorsAreNotCached)
+{
+    WDBPoolOptions options;
+    options.connections = 1;
+    auto sockets = expectSockets(*m_factory, 1);
+    EXPECT_CALL(*sockets[0], getMaxMsgSize()).WillRepeatedly(testing::Return(1024));
+    EXPECT_CALL(*sockets[0], sendMsg(testing::_)).Times(2).WillRepeatedly(testing::Return(successSendMsgRes()));
+    EXPECT_CALL(*sockets[0], recvMsg())
+        .WillOnce(testing::Return(recvMsgRes("err Cannot open the database")))
+        .WillOnce(testing::Return(recvMsgRes("ok []")));
+    WDBPool pool(TEST_DUMMY_PATH, m_factory, options);
+
+    ASSERT_EQ(pool.query(TEST_READ_QUERY), "err Cannot open the database");
+    ASSERT_EQ(pool.query(TEST_READ_QUERY), "ok []");
+    ASSERT_EQ(pool.query(TEST_READ_QUERY), "ok []");
+}
+
+TEST_F(WDBPoolTest, CacheIsBounded)
+{
+    WDBPoolOptions options;
+    options.connections = 1;
+    options.cacheSize = 4;
+    auto sockets = expectSockets(*m_factory, 1);
+    EchoServer server;
+    server.install(*sockets[0]);
+    WDBPool pool(TEST_DUMMY_PATH, m_factory, options);
+
+    for (auto i = 0; i < 10; ++i)
+    {
+        pool.query(fmt::format("global get-agent-info {}", i));
+    }
+    ASSERT_EQ(pool.getCacheSize(), 4);
+}
+
+TEST(WDBPoolIsReadOnlyTest, Commands)
+{
+    ASSERT_TRUE(WDBPool::isReadOnly("global get-agent-info 1"));
+    ASSERT_TRUE(WDBPool::isReadOnly("global select-agent-group 1"));
+    ASSERT_TRUE(WDBPool::isReadOnly("global sql SELECT name FROM agent WHERE id = 1"));
+    ASSERT_TRUE(WDBPool::isReadOnly("agent 001 sql select * from sys_osinfo"));
+    ASSERT_TRUE(WDBPool::isReadOnly("mitre get tactics"));
+
+    ASSERT_FALSE(WDBPool::isReadOnly(""));
+    ASSERT_FALSE(WDBPool::isReadOnly("global"));
+    ASSERT_FALSE(WDBPool::isReadOnly("global update-keepalive 1"));
+    ASSERT_FALSE(WDBPool::isReadOnly("global sql UPDATE agent SET name = 'a'"));
+    ASSERT_FALSE(WDBPool::isReadOnly("global sql SELECT 1; DELETE FROM agent"));
+    ASSERT_FALSE(WDBPool::isReadOnly("agent 001 syscheck save file"));
+    ASSERT_FALSE(WDBPool::isReadOnly("agent get-agent-info"));
+    ASSERT_FALSE(WDBPool::isReadOnly("other get-agent-info 1"));
+}
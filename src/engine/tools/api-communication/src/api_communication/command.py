@@ -63,6 +63,8 @@ def get_command(message: Message) -> Tuple[Optional[str], str]:
         return None, 'kvdb.manager/get'
     elif isinstance(message, kvdb.managerPost_Request):
         return None, 'kvdb.manager/post'
+    elif isinstance(message, kvdb.managerImport_Request):
+        return None, 'kvdb.manager/import'
     elif isinstance(message, kvdb.managerDelete_Request):
         return None, 'kvdb.manager/delete'
     elif isinstance(message, kvdb.managerDump_Request):
@@ -79,6 +81,8 @@ def get_command(message: Message) -> Tuple[Optional[str], str]:
         return None, 'metrics/list'
     elif isinstance(message, metrics.Test_Request):
         return None, 'metrics/test'
+    elif isinstance(message, metrics.Profile_Request):
+        return None, 'metrics.manager/profile'
 
     # Policy
     elif isinstance(message, policy.StorePost_Request):
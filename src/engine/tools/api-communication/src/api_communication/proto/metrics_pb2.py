@@ -15,7 +15,7 @@ import api_communication.proto.engine_pb2 as _engine_pb2
 from google.protobuf import struct_pb2 as google_dot_protobuf_dot_struct__pb2
 
 
-DESCRIPTOR = _descriptor_pool.Default().AddSerializedFile(b'\n\rmetrics.proto\x12\x1c\x63om.wazuh.api.engine.metrics\x1a\x0c\x65ngine.proto\x1a\x1cgoogle/protobuf/struct.proto\"\x0e\n\x0c\x44ump_Request\"\x97\x01\n\rDump_Response\x12\x32\n\x06status\x18\x01 \x01(\x0e\x32\".com.wazuh.api.engine.ReturnStatus\x12\x12\n\x05\x65rror\x18\x02 \x01(\tH\x00\x88\x01\x01\x12*\n\x05value\x18\x03 \x01(\x0b\x32\x16.google.protobuf.ValueH\x01\x88\x01\x01\x42\x08\n\x06_errorB\x08\n\x06_value\"c\n\x0bGet_Request\x12\x16\n\tscopeName\x18\x01 \x01(\tH\x00\x88\x01\x01\x12\x1b\n\x0einstrumentName\x18\x02 \x01(\tH\x01\x88\x01\x01\x42\x0c\n\n_scopeNameB\x11\n\x0f_instrumentName\"\x96\x01\n\x0cGet_Response\x12\x32\n\x06status\x18\x01 \x01(\x0e\x32\".com.wazuh.api.engine.ReturnStatus\x12\x12\n\x05\x65rror\x18\x02 \x01(\tH\x00\x88\x01\x01\x12*\n\x05value\x18\x03 \x01(\x0b\x32\x16.google.protobuf.ValueH\x01\x88\x01\x01\x42\x08\n\x06_errorB\x08\n\x06_value\"\x86\x01\n\x0e\x45nable_Request\x12\x16\n\tscopeName\x18\x01 \x01(\tH\x00\x88\x01\x01\x12\x1b\n\x0einstrumentName\x18\x02 \x01(\tH\x01\x88\x01\x01\x12\x13\n\x06status\x18\x03 \x01(\x08H\x02\x88\x01\x01\x42\x0c\n\n_scopeNameB\x11\n\x0f_instrumentNameB\t\n\x07_status\"\x85\x01\n\x0f\x45nable_Response\x12\x32\n\x06status\x18\x01 \x01(\x0e\x32\".com.wazuh.api.engine.ReturnStatus\x12\x12\n\x05\x65rror\x18\x02 \x01(\tH\x00\x88\x01\x01\x12\x14\n\x07\x63ontent\x18\x03 \x01(\tH\x01\x88\x01\x01\x42\x08\n\x06_errorB\n\n\x08_content\"\x0e\n\x0cList_Request\"\x97\x01\n\rList_Response\x12\x32\n\x06status\x18\x01 \x01(\x0e\x32\".com.wazuh.api.engine.ReturnStatus\x12\x12\n\x05\x65rror\x18\x02 \x01(\tH\x00\x88\x01\x01\x12*\n\x05value\x18\x03 \x01(\x0b\x32\x16.google.protobuf.ValueH\x01\x88\x01\x01\x42\x08\n\x06_errorB\x08\n\x06_value\"\x0e\n\x0cTest_Request\"r\n\rTest_Response\x12\x32\n\x06status\x18\x01 \x01(\x0e\x32\".com.wazuh.api.engine.ReturnStatus\x12\x12\n\x05\x65rror\x18\x02 \x01(\tH\x00\x88\x01\x01\x12\x0f\n\x07\x63ontent\x18\x03 \x03(\tB\x08\n\x06_errorb\x06proto3')
+DESCRIPTOR = _descriptor_pool.Default().AddSerializedFile(b'\n\rmetrics.proto\x12\x1c\x63om.wazuh.api.engine.metrics\x1a\x0c\x65ngine.proto\x1a\x1cgoogle/protobuf/struct.proto\"\x0e\n\x0c\x44ump_Request\"\x97\x01\n\rDump_Response\x12\x32\n\x06status\x18\x01 \x01(\x0e\x32\".com.wazuh.api.engine.ReturnStatus\x12\x12\n\x05\x65rror\x18\x02 \x01(\tH\x00\x88\x01\x01\x12*\n\x05value\x18\x03 \x01(\x0b\x32\x16.google.protobuf.ValueH\x01\x88\x01\x01\x42\x08\n\x06_errorB\x08\n\x06_value\"c\n\x0bGet_Request\x12\x16\n\tscopeName\x18\x01 \x01(\tH\x00\x88\x01\x01\x12\x1b\n\x0einstrumentName\x18\x02 \x01(\tH\x01\x88\x01\x01\x42\x0c\n\n_scopeNameB\x11\n\x0f_instrumentName\"\x96\x01\n\x0cGet_Response\x12\x32\n\x06status\x18\x01 \x01(\x0e\x32\".com.wazuh.api.engine.ReturnStatus\x12\x12\n\x05\x65rror\x18\x02 \x01(\tH\x00\x88\x01\x01\x12*\n\x05value\x18\x03 \x01(\x0b\x32\x16.google.protobuf.ValueH\x01\x88\x01\x01\x42\x08\n\x06_errorB\x08\n\x06_value\"\x86\x01\n\x0e\x45nable_Request\x12\x16\n\tscopeName\x18\x01 \x01(\tH\x00\x88\x01\x01\x12\x1b\n\x0einstrumentName\x18\x02 \x01(\tH\x01\x88\x01\x01\x12\x13\n\x06status\x18\x03 \x01(\x08H\x02\x88\x01\x01\x42\x0c\n\n_scopeNameB\x11\n\x0f_instrumentNameB\t\n\x07_status\"\x85\x01\n\x0f\x45nable_Response\x12\x32\n\x06status\x18\x01 \x01(\x0e\x32\".com.wazuh.api.engine.ReturnStatus\x12\x12\n\x05\x65rror\x18\x02 \x01(\tH\x00\x88\x01\x01\x12\x14\n\x07\x63ontent\x18\x03 \x01(\tH\x01\x88\x01\x01\x42\x08\n\x06_errorB\n\n\x08_content\"\x0e\n\x0cList_Request\"\x97\x01\n\rList_Response\x12\x32\n\x06status\x18\x01 \x01(\x0e\x32\".com.wazuh.api.engine.ReturnStatus\x12\x12\n\x05\x65rror\x18\x02 \x01(\tH\x00\x88\x01\x01\x12*\n\x05value\x18\x03 \x01(\x0b\x32\x16.google.protobuf.ValueH\x01\x88\x01\x01\x42\x08\n\x06_errorB\x08\n\x06_value\"\x0e\n\x0cTest_Request\"r\n\rTest_Response\x12\x32\n\x06status\x18\x01 \x01(\x0e\x32\".com.wazuh.api.engine.ReturnStatus\x12\x12\n\x05\x65rror\x18\x02 \x01(\tH\x00\x88\x01\x01\x12\x0f\n\x07\x63ontent\x18\x03 \x03(\tB\x08\n\x06_error\"M\n\x0fProfile_Request\x12\x12\n\x05limit\x18\x01 \x01(\rH\x00\x88\x01\x01\x12\x12\n\x05reset\x18\x02 \x01(\x08H\x01\x88\x01\x01\x42\x08\n\x06_limitB\x08\n\x06_reset\"\x9a\x01\n\x10Profile_Response\x12\x32\n\x06status\x18\x01 \x01(\x0e\x32\".com.wazuh.api.engine.ReturnStatus\x12\x12\n\x05\x65rror\x18\x02 \x01(\tH\x00\x88\x01\x01\x12*\n\x05value\x18\x03 \x01(\x0b\x32\x16.google.protobuf.ValueH\x01\x88\x01\x01\x42\x08\n\x06_errorB\x08\n\x06_valueb\x06proto3')
 
 _builder.BuildMessageAndEnumDescriptors(DESCRIPTOR, globals())
 _builder.BuildTopDescriptorsAndMessages(DESCRIPTOR, 'metrics_pb2', globals())
@@ -42,4 +42,8 @@ if _descriptor._USE_C_DESCRIPTORS == False:
   _TEST_REQUEST._serialized_end=972
   _TEST_RESPONSE._serialized_start=974
   _TEST_RESPONSE._serialized_end=1088
+  _PROFILE_REQUEST._serialized_start=1090
+  _PROFILE_REQUEST._serialized_end=1167
+  _PROFILE_RESPONSE._serialized_start=1170
+  _PROFILE_RESPONSE._serialized_end=1324
 # @@protoc_insertion_point(module_scope)
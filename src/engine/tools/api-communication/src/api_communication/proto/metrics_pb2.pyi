@@ -73,6 +73,24 @@ class List_Response(_message.Message):
     value: _struct_pb2.Value
     def __init__(self, status: _Optional[_Union[_engine_pb2.ReturnStatus, str]] = ..., error: _Optional[str] = ..., value: _Optional[_Union[_struct_pb2.Value, _Mapping]] = ...) -> None: ...
 
+class Profile_Request(_message.Message):
+    __slots__ = ["limit", "reset"]
+    LIMIT_FIELD_NUMBER: _ClassVar[int]
+    RESET_FIELD_NUMBER: _ClassVar[int]
+    limit: int
+    reset: bool
+    def __init__(self, limit: _Optional[int] = ..., reset: bool = ...) -> None: ...
+
+class Profile_Response(_message.Message):
+    __slots__ = ["error", "status", "value"]
+    ERROR_FIELD_NUMBER: _ClassVar[int]
+    STATUS_FIELD_NUMBER: _ClassVar[int]
+    VALUE_FIELD_NUMBER: _ClassVar[int]
+    error: str
+    status: _engine_pb2.ReturnStatus
+    value: _struct_pb2.Value
+    def __init__(self, status: _Optional[_Union[_engine_pb2.ReturnStatus, str]] = ..., error: _Optional[str] = ..., value: _Optional[_Union[_struct_pb2.Value, _Mapping]] = ...) -> None: ...
+
 class Test_Request(_message.Message):
     __slots__ = []
     def __init__(self) -> None: ...
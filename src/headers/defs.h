@@ -136,6 +136,7 @@ https://www.gnu.org/licenses/gpl.html\n"
 #define LESSD_LOCAL_SOCK "queue/sockets/agentless"
 #define INTG_LOCAL_SOCK "queue/sockets/integrator"
 #define CSYS_LOCAL_SOCK  "queue/sockets/csyslog"
+#define ALERT_BUS_SOCK  "queue/sockets/alerts"
 #define MON_LOCAL_SOCK  "queue/sockets/monitor"
 #define CLUSTER_SOCK "queue/cluster/c-internal.sock"
 #define CONTROL_SOCK "queue/sockets/control"
@@ -26,6 +26,9 @@ typedef struct _file_queue {
 
     FILE *fp;
     struct stat f_status;
+
+    int sock;       // Alert bus connection, -1 if disconnected
+    char *filter;   // Alert bus filter, NULL if the queue reads the alerts file
 } file_queue;
 
 #include "read-alert.h"
@@ -16,9 +16,20 @@
 // Initializes queue. Equivalent to initialize every field to 0.
 void jqueue_init(file_queue * queue);
 
+/**
+ * @brief Make the queue read the alerts from the analysisd alert bus instead of the alerts file.
+ *
+ * Must be called before jqueue_open(). Only the alerts matching the filter are received.
+ *
+ * @param queue Queue initialized with jqueue_init().
+ * @param filter Filter with the optional fields "level", "groups", "rule_ids" and "mail".
+ */
+void jqueue_subscribe(file_queue * queue, const cJSON * filter);
+
 /*
  * Open queue with the JSON alerts log file.
  * Returns 0 on success or -1 on error.
+ * When subscribed to the alert bus, the connection is retried by jqueue_next().
  */
 int jqueue_open(file_queue * queue, int tail);
 
@@ -0,0 +1,178 @@
+/*
+ * Lock-free queue (abstract data type)
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+/**
+ * Library that creates a bounded FIFO queue that can be shared by
+ * multiple producers and consumers without locks. Each slot has a
+ * sequence number that tells whether it's ready to be written or read,
+ * so the threads only compete for the positions of the queue.
+ *
+ * The blocking operations spin for a while before waiting on a
+ * condition variable, which is only signaled if a thread is waiting.
+ * */
+#ifndef MPMC_QUEUE_OP_H
+#define MPMC_QUEUE_OP_H
+
+#include <pthread.h>
+#include <time.h>
+
+#define MPMC_QUEUE_CACHE_LINE 64
+
+/**
+ * queue slot
+ * */
+typedef struct w_mpmc_cell_s {
+    size_t sequence; ///> Position that can use the slot next: pos to push, pos + 1 to pop
+    void * data;     ///> Element stored
+} w_mpmc_cell_t;
+
+/**
+ * queue main structure
+ * */
+typedef struct w_mpmc_queue_s {
+    w_mpmc_cell_t * cells; ///> Pointer to the circular buffer
+    size_t size;           ///> Size of the queue (fits size elements)
+    pthread_mutex_t mutex; ///> mutex for the blocking operations
+    pthread_cond_t available; ///> condition variable when queue is empty
+    pthread_cond_t available_not_full; ///> Condition variable when queue is full
+    unsigned int pop_waiters;  ///> Number of threads waiting for an element
+    unsigned int push_waiters; ///> Number of threads waiting for a free slot
+    char pad_push[MPMC_QUEUE_CACHE_LINE];
+    size_t push_pos; ///> Position of the next element pushed
+    char pad_pop[MPMC_QUEUE_CACHE_LINE - sizeof(size_t)];
+    size_t pop_pos;  ///> Position of the next element popped
+    char pad_end[MPMC_QUEUE_CACHE_LINE - sizeof(size_t)];
+} w_mpmc_queue_t;
+
+/**
+ * @brief Initializes a new queue structure
+ *
+ * @param size size of the queue (fits size elements, at least 2)
+ * @return initialized queue structure
+ * */
+w_mpmc_queue_t * mpmc_queue_init(size_t size);
+
+/**
+ * @brief Frees an existent queue, the elements are not freed
+ *
+ * @param queue
+ * */
+void mpmc_queue_free(w_mpmc_queue_t * queue);
+
+/**
+ * @brief Gets the number of elements in the queue. The value can be
+ * outdated as soon as it's returned if other threads use the queue
+ *
+ * @param queue
+ * @return number of elements
+ * */
+size_t mpmc_queue_elements(const w_mpmc_queue_t * queue);
+
+/**
+ * @brief Evaluates whether the queue is full or not
+ *
+ * @param queue
+ * @return 1 if true, 0 if false
+ * */
+int mpmc_queue_full(const w_mpmc_queue_t * queue);
+
+/**
+ * @brief Evaluates whether the queue is empty or not
+ *
+ * @param queue
+ * @return 1 if true, 0 if false
+ * */
+int mpmc_queue_empty(const w_mpmc_queue_t * queue);
+
+/**
+ * @brief Tries to insert an element into the queue
+ *
+ * @param queue the queue
+ * @param data data to be inserted
+ * @return -1 if queue is full
+ *          0 on success
+ * */
+int mpmc_queue_push(w_mpmc_queue_t * queue, void * data);
+
+/**
+ * @brief Tries to insert several elements into the queue, in order.
+ * The positions of the elements are taken at once
+ *
+ * @param queue the queue
+ * @param data elements to be inserted
+ * @param count number of elements
+ * @return number of elements inserted, from the start of data,
+ *         less than count if the queue got full
+ * */
+size_t mpmc_queue_push_batch(w_mpmc_queue_t * queue, void ** data, size_t count);
+
+/**
+ * @brief Same as mpmc_queue_push but if queue is full will
+ * wait until there is space for the element (THREAD BLOCK)
+ *
+ * @param queue the queue
+ * @param data data to be inserted
+ * @return 0 always
+ * */
+int mpmc_queue_push_block(w_mpmc_queue_t * queue, void * data);
+
+/**
+ * @brief Retrieves next item in the queue
+ *
+ * @param queue the queue
+ * @return element if queue has a next
+ *         NULL if queue is empty
+ * */
+void * mpmc_queue_pop(w_mpmc_queue_t * queue);
+
+/**
+ * @brief Retrieves the next items in the queue, in order. The
+ * positions of the elements are taken at once
+ *
+ * @param queue the queue
+ * @param data array where the elements are stored
+ * @param max maximum number of elements to retrieve
+ * @return number of elements retrieved, 0 if queue is empty
+ * */
+size_t mpmc_queue_pop_batch(w_mpmc_queue_t * queue, void ** data, size_t max);
+
+/**
+ * @brief Same as mpmc_queue_pop but if queue is empty
+ * THREAD WILL BLOCK
+ *
+ * @param queue the queue
+ * @return next element in the queue
+ * */
+void * mpmc_queue_pop_block(w_mpmc_queue_t * queue);
+
+/**
+ * @brief Same as mpmc_queue_pop_batch but if queue is empty
+ * THREAD WILL BLOCK until there is at least one element
+ *
+ * @param queue the queue
+ * @param data array where the elements are stored
+ * @param max maximum number of elements to retrieve, greater than 0
+ * @return number of elements retrieved
+ * */
+size_t mpmc_queue_pop_batch_block(w_mpmc_queue_t * queue, void ** data, size_t max);
+
+/**
+ * @brief Same as mpmc_queue_pop_block but with a configured timeout
+ * for the wait. If queue is empty THREAD WILL BLOCK
+ *
+ * @param queue the queue
+ * @param abstime timeout specification
+ * @return next element in the queue
+ *         NULL on timeout
+ * */
+void * mpmc_queue_pop_timedwait(w_mpmc_queue_t * queue, const struct timespec * abstime);
+
+#endif // MPMC_QUEUE_OP_H
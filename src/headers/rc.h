@@ -15,6 +15,8 @@
 
 /* Global headers */
 #define CONTROL_HEADER      "#!-"
+/* Several events in a message, each one as "<length>:<event>" */
+#define EVENT_BATCH_HEADER  "#!batch "
 
 #define IsValidHeader(str)  ((str[0] == '#') && \
                              (str[1] == '!') && \
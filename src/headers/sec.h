@@ -126,6 +126,14 @@ int OS_CheckUpdateKeys(const keystore *keys) __attribute((nonnull));
 /* Update the keys if they changed on the system */
 void OS_UpdateKeys(keystore *keys) __attribute((nonnull));
 
+/* Read the keys into a new keystore with the same mode. It doesn't access the current keys, so it
+ * can run while they're in use. */
+keystore * OS_ReadUpdatedKeys(const keystore *keys) __attribute((nonnull));
+
+/* Replace the keys with the ones read by OS_ReadUpdatedKeys(), keeping the network data of the agents.
+ * new_keys is freed. The keys must be locked for writing. */
+void OS_SwapKeys(keystore *keys, keystore *new_keys) __attribute((nonnull));
+
 /* Start counter for all agents */
 void OS_StartCounter(keystore *keys) __attribute((nonnull));
 
@@ -254,6 +254,7 @@ extern const char *__local_name;
 #include "hash_op.h"
 #include "rbtree_op.h"
 #include "queue_op.h"
+#include "mpmc_queue_op.h"
 #include "queue_linked_op.h"
 #include "bqueue_op.h"
 #include "store_op.h"
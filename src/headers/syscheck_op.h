@@ -182,6 +182,11 @@ typedef struct __sdb {
 
     int db_err;
     int socket;
+
+    // FIM entries stored together while the events of a batch are decoded
+    cJSON *db_batch;
+    size_t db_batch_size;
+    char *db_batch_agent;
 } _sdb; /* syscheck db information */
 
 typedef struct sk_sum_wdata {
@@ -0,0 +1,130 @@
+/* Copyright (C) 2015, Wazuh Inc.
+ * All right reserved.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation
+ */
+
+/* Read the lines of a file in large blocks */
+
+#include "shared.h"
+#include "logcollector.h"
+
+#ifdef WAZUH_UNIT_TESTING
+// Remove STATIC qualifier from tests
+#define STATIC
+#else
+#define STATIC static
+#endif
+
+/**
+ * @brief Read more data after the pending one
+ *
+ * Regular files are read in blocks. Other files (FIFOs, devices) are read
+ * up to the end of the next line, so the reader doesn't wait for a whole
+ * block to arrive.
+ *
+ * @param reader Block reader.
+ * @return Number of bytes read, 0 at the end of the file or on error.
+ */
+STATIC size_t w_block_reader_fill(w_block_reader_t * reader) {
+    size_t read_bytes = 0;
+    int c;
+
+    if (reader->pos > 0) {
+        memmove(reader->buffer, reader->buffer + reader->pos, reader->size - reader->pos);
+        reader->offset += reader->pos;
+        reader->size -= reader->pos;
+        reader->pos = 0;
+    }
+
+    if (reader->regular) {
+        read_bytes = fread(reader->buffer + reader->size, 1, W_BLOCK_READER_SIZE - reader->size, reader->fp);
+    } else {
+        while (reader->size + read_bytes < W_BLOCK_READER_SIZE && (c = fgetc(reader->fp)) != EOF) {
+            reader->buffer[reader->size + read_bytes++] = (char)c;
+
+            if (c == '\n') {
+                break;
+            }
+        }
+    }
+
+    reader->size += read_bytes;
+
+    if (read_bytes == 0) {
+        reader->eof = true;
+    }
+
+    return read_bytes;
+}
+
+void w_block_reader_init(w_block_reader_t * reader, FILE * fp, int64_t offset) {
+    struct stat stat_fd;
+
+    reader->fp = fp;
+    reader->pos = 0;
+    reader->size = 0;
+    reader->offset = offset;
+    reader->saved = '\0';
+    reader->eof = false;
+    reader->regular = fstat(fileno(fp), &stat_fd) == 0 && S_ISREG(stat_fd.st_mode);
+
+    os_malloc(W_BLOCK_READER_SIZE + 1, reader->buffer);
+    reader->buffer[0] = '\0';
+}
+
+char * w_block_reader_gets(w_block_reader_t * reader, size_t size, int64_t * length) {
+    size_t max = size - 1;
+    size_t available;
+    size_t line_length;
+    char * line;
+    char * newline;
+
+    // Restore the byte replaced by the terminator of the previous line
+    reader->buffer[reader->pos] = reader->saved;
+
+    while (1) {
+        line = reader->buffer + reader->pos;
+        available = reader->size - reader->pos;
+
+        if (newline = memchr(line, '\n', available < max ? available : max), newline != NULL) {
+            line_length = newline - line + 1;
+            break;
+        }
+
+        if (available >= max) {
+            line_length = max;
+            break;
+        }
+
+        if (reader->eof || w_block_reader_fill(reader) == 0) {
+            line = reader->buffer + reader->pos;
+            line_length = reader->size - reader->pos;
+
+            if (line_length == 0) {
+                reader->saved = '\0';
+                return NULL;
+            }
+
+            break;
+        }
+    }
+
+    reader->saved = line[line_length];
+    line[line_length] = '\0';
+    reader->pos += line_length;
+    *length = line_length;
+
+    return line;
+}
+
+int64_t w_block_reader_tell(const w_block_reader_t * reader) {
+    return reader->offset + reader->pos;
+}
+
+void w_block_reader_free(w_block_reader_t * reader) {
+    os_free(reader->buffer);
+}
@@ -0,0 +1,240 @@
+/* Copyright (C) 2015, Wazuh Inc.
+ * All right reserved.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation
+ */
+
+/* Readiness of the monitored files from inotify events */
+
+#include "shared.h"
+#include "logcollector.h"
+
+#ifdef INOTIFY_ENABLED
+
+#include <sys/inotify.h>
+
+#ifdef WAZUH_UNIT_TESTING
+// Remove STATIC qualifier from tests
+#define STATIC
+#else
+#define STATIC static
+#endif
+
+/* The directories of the files are watched, so the watches survive the rotation of the files */
+#define W_FILE_EVENTS_MASK (IN_MODIFY | IN_CREATE | IN_MOVED_TO)
+
+/* Maximum time that a file is not read without events (seconds) */
+#define W_FILE_EVENTS_POLL 60
+
+typedef struct w_file_event_t {
+    int ready;               ///< The file changed since it was last read
+    unsigned int generation; ///< Overflow generation when the file was last read
+    time_t polled;           ///< Time when the file was last read
+} w_file_event_t;
+
+static int inotify_fd = -1;
+static OSHash * files_table;    ///< File path -> w_file_event_t
+static OSHash * dirs_table;     ///< Directory path -> watch descriptor (intptr_t), -1 if it can't be watched
+static OSHash * wds_table;      ///< Watch descriptor -> directory path
+static volatile unsigned int generation; ///< Increased when the event queue overflows
+static pthread_mutex_t watch_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+STATIC void * w_file_events_main(void * args);
+
+/**
+ * @brief Mark the file of an event as ready
+ * @param wd Watch descriptor of the directory.
+ * @param name File name.
+ */
+STATIC void w_file_events_notify(int wd, const char * name) {
+    char key[OS_SIZE_32];
+    char path[PATH_MAX];
+    const char * dir;
+    w_file_event_t * entry;
+
+    snprintf(key, sizeof(key), "%d", wd);
+
+    if (dir = OSHash_Get_ex(wds_table, key), dir == NULL) {
+        return;
+    }
+
+    snprintf(path, sizeof(path), "%s/%s", dir, name);
+
+    if (entry = OSHash_Get_ex(files_table, path), entry != NULL) {
+        entry->ready = 1;
+    }
+}
+
+/**
+ * @brief Forget a directory that is no longer watched
+ * @param wd Watch descriptor of the directory.
+ */
+STATIC void w_file_events_unwatch(int wd) {
+    char key[OS_SIZE_32];
+    char * dir;
+
+    snprintf(key, sizeof(key), "%d", wd);
+
+    w_mutex_lock(&watch_mutex);
+
+    if (dir = OSHash_Delete_ex(wds_table, key), dir != NULL) {
+        mdebug2("Directory '%s' is no longer watched.", dir);
+        OSHash_Delete_ex(dirs_table, dir);
+        os_free(dir);
+    }
+
+    w_mutex_unlock(&watch_mutex);
+}
+
+/**
+ * @brief Watch the directory of a file, if it's not watched yet
+ * @param path Path of the file.
+ * @return true if the directory is watched, false if it can't be watched.
+ */
+STATIC bool w_file_events_watch(const char * path) {
+    char dir[PATH_MAX];
+    char key[OS_SIZE_32];
+    char * slash;
+    intptr_t wd;
+
+    snprintf(dir, sizeof(dir), "%s", path);
+
+    if (slash = strrchr(dir, '/'), slash == NULL) {
+        return false;
+    }
+
+    *slash = '\0';
+
+    // Watch descriptors are never 0, so they can be stored as pointers
+    if (wd = (intptr_t)OSHash_Get_ex(dirs_table, dir), wd != 0) {
+        return wd > 0;
+    }
+
+    w_mutex_lock(&watch_mutex);
+
+    if (wd = (intptr_t)OSHash_Get_ex(dirs_table, dir), wd == 0) {
+        if (wd = inotify_add_watch(inotify_fd, dir, W_FILE_EVENTS_MASK), wd < 0) {
+            mwarn("Cannot watch directory '%s' with inotify: %s (%d). Its files will be polled.", dir, strerror(errno), errno);
+            wd = -1;
+        } else {
+            snprintf(key, sizeof(key), "%d", (int)wd);
+            OSHash_Add_ex(wds_table, key, strdup(dir));
+            mdebug2("Watching directory '%s'.", dir);
+        }
+
+        OSHash_Add_ex(dirs_table, dir, (void *)wd);
+    }
+
+    w_mutex_unlock(&watch_mutex);
+
+    return wd > 0;
+}
+
+void w_file_events_init(void) {
+    if (!getDefine_Int("logcollector", "inotify", 0, 1)) {
+        return;
+    }
+
+    files_table = OSHash_Create();
+    dirs_table = OSHash_Create();
+    wds_table = OSHash_Create();
+
+    if (files_table == NULL || dirs_table == NULL || wds_table == NULL) {
+        merror_exit(LIST_ERROR);
+    }
+
+    if (inotify_fd = inotify_init1(IN_CLOEXEC), inotify_fd < 0) {
+        mwarn("Cannot start inotify: %s (%d). The files will be polled.", strerror(errno), errno);
+        return;
+    }
+
+    w_create_thread(w_file_events_main, NULL);
+    mdebug1("Watching the monitored files with inotify.");
+}
+
+bool w_file_events_enabled(void) {
+    return inotify_fd >= 0;
+}
+
+bool w_file_events_ready(const char * path) {
+    w_file_event_t * entry;
+    time_t now;
+
+    if (inotify_fd < 0) {
+        return true;
+    }
+
+    if (entry = OSHash_Get_ex(files_table, path), entry == NULL) {
+        os_calloc(1, sizeof(w_file_event_t), entry);
+
+        if (OSHash_Add_ex(files_table, path, entry) != 2) {
+            os_free(entry);
+            return true;
+        }
+    }
+
+    if (!w_file_events_watch(path)) {
+        return true;
+    }
+
+    now = time(NULL);
+
+    /* The flag is cleared before reading, so no event gets lost */
+    if (entry->ready || entry->generation != generation || now - entry->polled >= W_FILE_EVENTS_POLL) {
+        entry->ready = 0;
+        entry->generation = generation;
+        entry->polled = now;
+        return true;
+    }
+
+    return false;
+}
+
+void w_file_events_set_ready(const char * path) {
+    w_file_event_t * entry;
+
+    if (inotify_fd >= 0 && (entry = OSHash_Get_ex(files_table, path), entry != NULL)) {
+        entry->ready = 1;
+    }
+}
+
+// Thread that reads the inotify events
+STATIC void * w_file_events_main(__attribute__((unused)) void * args) {
+    char buffer[OS_SIZE_65536] __attribute__((aligned(__alignof__(struct inotify_event))));
+    const struct inotify_event * event;
+    ssize_t length;
+
+    while (1) {
+        if (length = read(inotify_fd, buffer, sizeof(buffer)), length < 0) {
+            if (errno != EINTR) {
+                merror("Cannot read inotify events: %s (%d)", strerror(errno), errno);
+                sleep(1);
+            }
+            continue;
+        }
+
+        for (char * ptr = buffer; ptr < buffer + length; ptr += sizeof(struct inotify_event) + event->len) {
+            event = (const struct inotify_event *)ptr;
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                mdebug1("Inotify event queue overflow. All the files will be read.");
+                generation++;
+            } else if (event->mask & IN_IGNORED) {
+                w_file_events_unwatch(event->wd);
+            } else if (event->len > 0) {
+                w_file_events_notify(event->wd, event->name);
+            }
+        }
+
+#ifdef WAZUH_UNIT_TESTING
+        break;
+#endif
+    }
+
+    return NULL;
+}
+
+#endif
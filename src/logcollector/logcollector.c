@@ -62,6 +62,22 @@ STATIC void w_save_file_status();
  */
 STATIC void w_load_files_status(cJSON *global_json);
 
+#ifndef WIN32
+/**
+ * @brief Report the bytes left to read in a file after reading it
+ *
+ * The readers stop after the maximum lines, so a busy file is read in
+ * slices and the threads get to the other files between them. If the
+ * reader advanced but didn't reach the end, the file is read again in the
+ * next loop without waiting.
+ *
+ * @param current File just read.
+ * @param read_position Position of the file before reading it.
+ * @param pending Set to true if the file must be read again.
+ */
+STATIC void w_update_read_lag(logreader * current, int64_t read_position, bool * pending);
+#endif
+
 /**
  * @brief Parse the hash files_status to JSON
  * @return json of all read status files in a string
@@ -479,6 +495,11 @@ void LogCollectorStart()
     /* Create the output threads */
     w_create_output_threads();
 
+#ifdef INOTIFY_ENABLED
+    /* Watch the changes of the files */
+    w_file_events_init();
+#endif
+
     /* Create the input threads */
     w_create_input_threads();
 
@@ -2055,6 +2076,8 @@ void * w_input_thread(__attribute__((unused)) void * t_id){
     int int_error = 0;
     struct timeval fp_timeout;
     struct stat tmp_stat;
+    int64_t read_position = 0;
+    bool pending = false;
 #else
     BY_HANDLE_FILE_INFORMATION lpFileInformation;
     memset(&lpFileInformation, 0, sizeof(BY_HANDLE_FILE_INFORMATION));
@@ -2063,8 +2086,10 @@ void * w_input_thread(__attribute__((unused)) void * t_id){
     /* Daemon loop */
     while (1) {
 #ifndef WIN32
-        fp_timeout.tv_sec = loop_timeout;
+        /* A file was left behind in the last loop, so it's read again without waiting */
+        fp_timeout.tv_sec = pending ? 0 : loop_timeout;
         fp_timeout.tv_usec = 0;
+        pending = false;
 
         /* Wait for the select timeout */
         if ((r = select(0, NULL, NULL, NULL, &fp_timeout)) < 0) {
@@ -2162,6 +2187,15 @@ void * w_input_thread(__attribute__((unused)) void * t_id){
                     }
                 }
 
+#ifdef INOTIFY_ENABLED
+                /* Skip the files that didn't change since they were read */
+                if (!w_file_events_ready(current->file)) {
+                    w_mutex_unlock(&current->mutex);
+                    rwlock_unlock(&files_update_rwlock);
+                    continue;
+                }
+#endif
+
                 /* We check for the end of file. If is returns EOF,
                 * we don't attempt to read it.
                 * Excluding multiline_regex log format which has its own handler.
@@ -2177,6 +2211,8 @@ void * w_input_thread(__attribute__((unused)) void * t_id){
                    /* If it is not EOF, we need to return the read character */
                    ungetc(r, current->fp);
                 }
+
+                read_position = w_ftell(current->fp);
     #endif
 
 #ifdef WIN32
@@ -2270,6 +2306,10 @@ void * w_input_thread(__attribute__((unused)) void * t_id){
                         }
 
                     }
+
+#ifndef WIN32
+                    w_update_read_lag(current, read_position, &pending);
+#endif
                     w_mutex_unlock(&current->mutex);
                 }
                 /* If ferror is set */
@@ -2333,6 +2373,31 @@ void * w_input_thread(__attribute__((unused)) void * t_id){
 #endif
 }
 
+#ifndef WIN32
+STATIC void w_update_read_lag(logreader * current, int64_t read_position, bool * pending) {
+    struct stat stat_fd;
+    int64_t position;
+    uint64_t lag = 0;
+
+    if (fstat(fileno(current->fp), &stat_fd) != 0) {
+        return;
+    }
+
+    if (position = w_ftell(current->fp), position >= 0 && position < stat_fd.st_size) {
+        lag = stat_fd.st_size - position;
+    }
+
+    w_logcollector_state_update_lag(current->file, lag);
+
+    if (lag > 0 && position > read_position) {
+        *pending = true;
+#ifdef INOTIFY_ENABLED
+        w_file_events_set_ready(current->file);
+#endif
+    }
+}
+#endif
+
 void w_create_input_threads(){
 
     int i;
@@ -65,6 +65,90 @@ int reload_file(logreader * lf);
 /* Close file and save position */
 void close_file(logreader * lf);
 
+/* Size of the blocks read from the files */
+#define W_BLOCK_READER_SIZE OS_MAXSTR
+
+/**
+ * @brief Reader of the lines of a file in large blocks
+ *
+ * The lines are split in memory and their offsets are tracked from the
+ * start of the block, instead of asking the stream for each line. The
+ * stream position is ahead of the lines returned: the caller must set it
+ * to w_block_reader_tell() when it's done.
+ */
+typedef struct w_block_reader_t {
+    FILE * fp;      ///< File being read
+    char * buffer;  ///< Data read, pending from buffer + pos to buffer + size
+    size_t pos;     ///< Start of the next line in the buffer
+    size_t size;    ///< Bytes in the buffer
+    int64_t offset; ///< File offset of the start of the buffer
+    char saved;     ///< Byte replaced by the terminator of the last line
+    bool eof;       ///< The end of the file was reached
+    bool regular;   ///< The file is a regular file, read in blocks
+} w_block_reader_t;
+
+/**
+ * @brief Start reading lines from the current position of a file
+ * @param reader Block reader to initialize.
+ * @param fp File to read.
+ * @param offset Current position of the file.
+ */
+void w_block_reader_init(w_block_reader_t * reader, FILE * fp, int64_t offset);
+
+/**
+ * @brief Get the next line, like fgets(), from the block in memory
+ * @param reader Block reader.
+ * @param size Maximum size of the line, including the terminator. Up to W_BLOCK_READER_SIZE.
+ * @param[out] length Number of bytes of the line, including the newline if any.
+ * @return Line, terminated and valid until the next call. NULL at the end of the file.
+ */
+char * w_block_reader_gets(w_block_reader_t * reader, size_t size, int64_t * length);
+
+/**
+ * @brief Get the file offset after the last line returned
+ * @param reader Block reader.
+ * @return File offset.
+ */
+int64_t w_block_reader_tell(const w_block_reader_t * reader);
+
+/**
+ * @brief Free the buffer of a block reader
+ * @param reader Block reader.
+ */
+void w_block_reader_free(w_block_reader_t * reader);
+
+#ifdef INOTIFY_ENABLED
+/**
+ * @brief Start watching the changes of the monitored files with inotify
+ *
+ * Does nothing if the option logcollector.inotify is disabled.
+ */
+void w_file_events_init(void);
+
+/**
+ * @brief Check whether a file may have new data since it was last read
+ *
+ * Files that were not reported since W_FILE_EVENTS_POLL seconds, or
+ * whose directory can't be watched, are always considered ready.
+ *
+ * @param path Path of the file.
+ * @return true if the file should be read, false otherwise.
+ */
+bool w_file_events_ready(const char * path);
+
+/**
+ * @brief Mark a file as ready, because it has data left to read
+ * @param path Path of the file.
+ */
+void w_file_events_set_ready(const char * path);
+
+/**
+ * @brief Check whether the files are watched with inotify
+ * @return true if enabled, false otherwise.
+ */
+bool w_file_events_enabled(void);
+#endif
+
 /* Read syslog file */
 void *read_syslog(logreader *lf, int *rc, int drop_it);
 
@@ -19,13 +19,12 @@
 void *read_syslog(logreader *lf, int *rc, int drop_it) {
     int __ms = 0;
     int __ms_reported = 0;
-    char str[OS_MAXSTR + 1];
+    char *str;
     int64_t current_position = 0;
     int lines = 0;
-    int64_t offset = 0;
     int64_t rbytes = 0;
+    w_block_reader_t reader;
 
-    str[OS_MAXSTR] = '\0';
     *rc = 0;
 
     /* Obtain context to calculate hash */
@@ -34,14 +33,11 @@ void *read_syslog(logreader *lf, int *rc, int drop_it) {
     EVP_MD_CTX *context = EVP_MD_CTX_new();
     bool is_valid_context_file = w_get_hash_context(lf, &context, current_position);
 
-    for (offset = w_ftell(lf->fp); can_read() && fgets(str, OS_MAXSTR - OS_LOG_HEADER, lf->fp) != NULL && (!maximum_lines || lines < maximum_lines) && offset >= 0; offset += rbytes) {
-        rbytes = w_ftell(lf->fp) - offset;
-        lines++;
+    /* The lines are taken from large blocks, and their offsets are counted from the current position */
+    w_block_reader_init(&reader, lf->fp, current_position);
 
-        /* Flow control */
-        if (rbytes <= 0) {
-            break;
-        }
+    while (current_position >= 0 && can_read() && (!maximum_lines || lines < maximum_lines) && (str = w_block_reader_gets(&reader, OS_MAXSTR - OS_LOG_HEADER, &rbytes)) != NULL) {
+        lines++;
 
         /* Get the last occurrence of \n */
         if (str[rbytes - 1] == '\n') {
@@ -53,6 +49,7 @@ void *read_syslog(logreader *lf, int *rc, int drop_it) {
             if ((int64_t)strlen(str) != rbytes - 1)
             {
                 mdebug2("Line in '%s' contains some zero-bytes (valid=" FTELL_TT "/ total=" FTELL_TT "). Dropping line.", lf->file, FTELL_INT64 strlen(str), FTELL_INT64 rbytes - 1);
+                current_position = w_block_reader_tell(&reader);
                 continue;
             }
         }
@@ -68,17 +65,11 @@ void *read_syslog(logreader *lf, int *rc, int drop_it) {
             }
             str[rbytes - 1] = '\0';
         } else {
-            /* We may not have gotten a line feed
-             * because we reached EOF.
+            /* We didn't get a line feed because we reached EOF.
+             * Message not complete. Return.
              */
-             if (feof(lf->fp)) {
-                /* Message not complete. Return. */
-                mdebug2("Message not complete from '%s'. Trying again: '%.*s'%s", lf->file, sample_log_length, str, rbytes > sample_log_length ? "..." : "");
-                if(current_position >= 0) {
-                    w_fseek(lf->fp, current_position, SEEK_SET);
-                }
-                break;
-            }
+            mdebug2("Message not complete from '%s'. Trying again: '%.*s'%s", lf->file, sample_log_length, str, rbytes > sample_log_length ? "..." : "");
+            break;
         }
 
 #ifdef WIN32
@@ -90,13 +81,13 @@ void *read_syslog(logreader *lf, int *rc, int drop_it) {
 
         /* Look for empty string (only on Windows) */
         if (rbytes <= 2) {
-            current_position = w_ftell(lf->fp);
+            current_position = w_block_reader_tell(&reader);
             continue;
         }
 
         /* Windows can have comment on their logs */
         if (str[0] == '#') {
-            current_position = w_ftell(lf->fp);
+            current_position = w_block_reader_tell(&reader);
             continue;
         }
 #endif
@@ -121,14 +112,7 @@ void *read_syslog(logreader *lf, int *rc, int drop_it) {
                 mdebug2("Large message size from file '%s' (length = " FTELL_TT "): '%.*s'...", lf->file, FTELL_INT64 rbytes, sample_log_length, str);
             }
 
-            for (offset += rbytes; fgets(str, OS_MAXSTR - 2, lf->fp) != NULL; offset += rbytes) {
-                rbytes = w_ftell(lf->fp) - offset;
-
-                /* Flow control */
-                if (rbytes <= 0) {
-                    break;
-                }
-
+            while ((str = w_block_reader_gets(&reader, OS_MAXSTR - 2, &rbytes)) != NULL) {
                 if (is_valid_context_file) {
                     OS_SHA1_Stream(context, NULL, str);
                 }
@@ -140,9 +124,16 @@ void *read_syslog(logreader *lf, int *rc, int drop_it) {
             }
             __ms = 0;
         }
-        current_position = w_ftell(lf->fp);
+        current_position = w_block_reader_tell(&reader);
     }
 
+    /* Leave the file after the last line processed */
+    if (current_position >= 0) {
+        w_fseek(lf->fp, current_position, SEEK_SET);
+    }
+
+    w_block_reader_free(&reader);
+
     if (is_valid_context_file) {
         w_update_file_status(lf->file, current_position, context);
     } else {
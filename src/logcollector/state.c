@@ -53,6 +53,15 @@ STATIC cJSON * _w_logcollector_generate_state(w_lc_state_storage_t * state, bool
  */
 STATIC void _w_logcollector_state_update_file(w_lc_state_storage_t * state, char * fpath, uint64_t bytes);
 
+/**
+ * @brief Update the amount of bytes that were left to read in a file/location
+ *
+ * @param state state to be used
+ * @param fpath file path or locafile location value
+ * @param lag bytes left to read
+ */
+STATIC void _w_logcollector_state_update_lag(w_lc_state_storage_t * state, char * fpath, uint64_t lag);
+
 /**
  * @brief Update/register current drop count for a target belonging to a particular file
  *
@@ -231,6 +240,34 @@ void _w_logcollector_state_update_file(w_lc_state_storage_t * state, char * fpat
     }
 }
 
+void w_logcollector_state_update_lag(char * fpath, uint64_t lag) {
+
+    if (fpath == NULL) {
+        return;
+    }
+
+    w_mutex_lock(&g_lc_raw_stats_mutex);
+
+    if (g_lc_state_type & LC_STATE_GLOBAL) {
+        _w_logcollector_state_update_lag(g_lc_states_global, fpath, lag);
+    }
+    if (g_lc_state_type & LC_STATE_INTERVAL) {
+        _w_logcollector_state_update_lag(g_lc_states_interval, fpath, lag);
+    }
+
+    w_mutex_unlock(&g_lc_raw_stats_mutex);
+}
+
+void _w_logcollector_state_update_lag(w_lc_state_storage_t * state, char * fpath, uint64_t lag) {
+
+    w_lc_state_file_t * data = NULL;
+
+    // The files are registered when they are opened
+    if (data = (w_lc_state_file_t *) OSHash_Get(state->states, fpath), data != NULL) {
+        data->lag = lag;
+    }
+}
+
 void _w_logcollector_state_update_target(w_lc_state_storage_t * state, char * fpath, char * target, bool dropped) {
 
     w_lc_state_file_t * data = NULL;
@@ -396,6 +433,7 @@ cJSON * _w_logcollector_generate_state(w_lc_state_storage_t * state, bool restar
         cJSON_AddStringToObject(lc_stats_file, "location", hash_node->key);
         cJSON_AddNumberToObject(lc_stats_file, "events", data->events);
         cJSON_AddNumberToObject(lc_stats_file, "bytes", data->bytes);
+        cJSON_AddNumberToObject(lc_stats_file, "lag", data->lag);
         cJSON_AddItemToObject(lc_stats_file, "targets", lc_stats_targets_array);
 
         if (restart) {
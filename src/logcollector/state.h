@@ -50,6 +50,7 @@ typedef struct {
 typedef struct {
     uint64_t bytes;               ///< bytes count
     uint64_t events;              ///< events count
+    uint64_t lag;                 ///< bytes left to read after the last read
     w_lc_state_target_t ** targets; ///< array of poiters to file's different targets
 } w_lc_state_file_t;
 
@@ -98,6 +99,14 @@ void w_logcollector_state_update_target(char * fpath, char * target, bool droppe
  */
 void w_logcollector_state_update_file(char * fpath, uint64_t bytes);
 
+/**
+ * @brief Update the amount of bytes that were left to read in a file
+ *
+ * @param fpath file path or locafile location value
+ * @param lag bytes between the read position and the end of the file.
+ */
+void w_logcollector_state_update_lag(char * fpath, uint64_t lag);
+
 /**
  * @brief Removes the `fpath` file from statistics
  * 
@@ -13,20 +13,44 @@
 #include "../external/zlib/zlib.h"
 
 
+#define COMPRESS_BLOCK_SIZE (1024 * 1024)
+
+/* Block of a log file, compressed as a standalone gzip member */
+typedef struct compress_block_t {
+    char *input;
+    size_t input_len;
+    unsigned char *output;
+    size_t output_size;
+    size_t output_len;
+    int joinable;
+    int error;
+} compress_block_t;
+
+static void * compress_block(void *arg);
+
 /* gzip a log file */
 void OS_CompressLog(const char *logfile)
 {
-    FILE *log;
-    gzFile zlog;
+    OS_CompressLogParallel(logfile, 1, 0, NULL, NULL);
+}
 
+/* gzip a log file in blocks compressed by several threads */
+int OS_CompressLogParallel(const char *logfile, int threads, unsigned int rate_limit, compress_digest_cb digest, void *arg)
+{
+    FILE *log;
+    FILE *zlog;
     char logfileGZ[OS_FLSIZE + 1];
-    int len, err;
-
-    char buf[OS_MAXSTR + 1];
+    compress_block_t *blocks;
+    pthread_t *thread_ids;
+    struct timespec start;
+    struct timespec now;
+    size_t total = 0;
+    size_t written = 0;
+    int count;
+    int error = 0;
+    int i;
 
-    /* Clear memory */
-    memset(logfileGZ, '\0', OS_FLSIZE + 1);
-    memset(buf, '\0', OS_MAXSTR + 1);
+    threads = threads > 0 ? threads : 1;
 
     /* Set umask */
     umask(0027);
@@ -38,33 +62,143 @@ void OS_CompressLog(const char *logfile)
     log = wfopen(logfile, "r");
     if (!log) {
         /* Do not warn in here, since the alert file may not exist */
-        return;
+        return -1;
     }
 
     /* Open compressed file */
-    zlog = gzopen(logfileGZ, "w");
+    zlog = wfopen(logfileGZ, "wb");
     if (!zlog) {
         fclose(log);
         merror(FOPEN_ERROR, logfileGZ, errno, strerror(errno));
-        return;
+        return -1;
+    }
+
+    os_calloc(threads, sizeof(compress_block_t), blocks);
+    os_calloc(threads, sizeof(pthread_t), thread_ids);
+
+    for (i = 0; i < threads; i++) {
+        blocks[i].output_size = compressBound(COMPRESS_BLOCK_SIZE) + 32;
+        os_malloc(COMPRESS_BLOCK_SIZE, blocks[i].input);
+        os_malloc(blocks[i].output_size, blocks[i].output);
     }
 
-    for (;;) {
-        len = (int) fread(buf, 1, OS_MAXSTR, log);
-        if (len <= 0) {
-            break;
+    gettime(&start);
+
+    do {
+        /* Read a block for each thread, feeding the digest in order */
+        for (count = 0; count < threads; count++) {
+            blocks[count].input_len = fread(blocks[count].input, 1, COMPRESS_BLOCK_SIZE, log);
+
+            if (blocks[count].input_len == 0) {
+                break;
+            }
+
+            if (digest) {
+                digest(blocks[count].input, blocks[count].input_len, arg);
+            }
+
+            total += blocks[count].input_len;
+        }
+
+        /* An empty file still gets an empty gzip member */
+        if (count == 0 && written == 0) {
+            count = 1;
         }
-        if (gzwrite(zlog, buf, (unsigned)len) != len) {
-            merror("Compression error: %s", gzerror(zlog, &err));
+
+        if (count == 1) {
+            compress_block(&blocks[0]);
+        } else {
+            for (i = 0; i < count; i++) {
+                blocks[i].joinable = pthread_create(&thread_ids[i], NULL, compress_block, &blocks[i]) == 0;
+
+                if (!blocks[i].joinable) {
+                    compress_block(&blocks[i]);
+                }
+            }
+
+            for (i = 0; i < count; i++) {
+                if (blocks[i].joinable) {
+                    pthread_join(thread_ids[i], NULL);
+                }
+            }
         }
+
+        /* Write the gzip members in order */
+        for (i = 0; i < count && !error; i++) {
+            if (blocks[i].error) {
+                merror("Compression error: '%s'", logfileGZ);
+                error = 1;
+            } else if (fwrite(blocks[i].output, 1, blocks[i].output_len, zlog) != blocks[i].output_len) {
+                merror("Unable to write '%s' due to '%s'", logfileGZ, strerror(errno));
+                error = 1;
+            }
+
+            written++;
+        }
+
+        /* Do not take more than rate_limit MiB per second */
+        if (rate_limit > 0 && count > 0) {
+            double expected = (double)total / (rate_limit * 1024.0 * 1024.0);
+            double elapsed;
+
+            gettime(&now);
+            elapsed = time_diff(&start, &now);
+
+            if (expected > elapsed) {
+                w_time_delay((unsigned long)((expected - elapsed) * 1000));
+            }
+        }
+    } while (count == threads);
+
+    for (i = 0; i < threads; i++) {
+        os_free(blocks[i].input);
+        os_free(blocks[i].output);
     }
 
+    os_free(blocks);
+    os_free(thread_ids);
     fclose(log);
-    gzclose(zlog);
+
+    if (fclose(zlog) != 0 && !error) {
+        merror("Unable to write '%s' due to '%s'", logfileGZ, strerror(errno));
+        error = 1;
+    }
+
+    if (error) {
+        /* Keep the uncompressed file */
+        unlink(logfileGZ);
+        return 0;
+    }
 
     /* Remove uncompressed file */
     if ( unlink(logfile) == -1)
         merror("Unable to delete '%s' due to '%s'", logfile, strerror(errno));
 
-    return;
+    return 0;
+}
+
+/* Compress a block into a gzip member */
+static void * compress_block(void *arg)
+{
+    compress_block_t *block = arg;
+    z_stream strm;
+
+    memset(&strm, 0, sizeof(strm));
+
+    /* 16 added to the window bits writes a gzip header and trailer */
+    if (deflateInit2(&strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        block->error = 1;
+        return NULL;
+    }
+
+    strm.next_in = (Bytef *)block->input;
+    strm.avail_in = (uInt)block->input_len;
+    strm.next_out = block->output;
+    strm.avail_out = (uInt)block->output_size;
+
+    block->error = deflate(&strm, Z_FINISH) != Z_STREAM_END;
+    block->output_len = strm.total_out;
+    deflateEnd(&strm);
+
+    return NULL;
 }
@@ -178,6 +178,8 @@ int MonitordConfig(const char *cfg, monitor_config *mond, int no_agents, short d
     mond->keep_log_days = getDefine_Int("monitord", "keep_log_days", 0, 500);
     mond->size_rotate = (unsigned long) getDefine_Int("monitord", "size_rotate", 0, 4096) * 1024 * 1024;
     mond->daily_rotations = getDefine_Int("monitord", "daily_rotations", 1, 256);
+    mond->compress_threads = getDefine_Int("monitord", "compress_threads", 1, 64);
+    mond->compress_rate = (unsigned int) getDefine_Int("monitord", "compress_rate", 0, 4096);
     mond->delete_old_agents = (unsigned int)getDefine_Int("monitord", "delete_old_agents", 0, 9600);
 
     mond->agents = NULL;
@@ -24,12 +24,30 @@
 #define AG_DISCON_MSG MONITORD_MSG_HEADER OS_AG_DISCON
 #define CHECK_LOGS_SIZE TRUE
 
+/* Receives the content of a log file as it is compressed */
+typedef void (*compress_digest_cb)(const char *data, size_t size, void *arg);
+
 /* Prototypes */
 void Monitord(void) __attribute__((noreturn));
 void manage_files(int cday, int cmon, int cyear);
 void generate_reports(int cday, int cmon, int cyear, const struct tm *p);
-void OS_SignLog(const char *logfile, const char *logfile_old, const char * ext);
+void OS_SignLog(const char *logfile, const char *logfile_old, const char * ext, int compress);
 void OS_CompressLog(const char *logfile);
+
+/**
+ * @brief Compress a log file into logfile.gz, in blocks compressed in parallel
+ *
+ * Each block is written as a gzip member, so the result can be read by any gzip reader.
+ * The uncompressed file is removed on success.
+ *
+ * @param logfile Log file to compress.
+ * @param threads Number of blocks compressed at the same time.
+ * @param rate_limit Maximum read rate in MiB per second, 0 for no limit.
+ * @param digest Callback receiving the content read, in order. May be NULL.
+ * @param arg Argument for the callback.
+ * @return 0 if the log file was read, -1 if it could not be opened.
+ */
+int OS_CompressLogParallel(const char *logfile, int threads, unsigned int rate_limit, compress_digest_cb digest, void *arg);
 void w_rotate_log(int compress, int keep_log_days, int new_day, int rotate_json, int daily_rotations);
 int delete_old_agent(const char *agent_id);
 int MonitordConfig(const char *cfg, monitor_config *mond, int no_agents, short day_wait);
@@ -15,9 +15,15 @@
 #include "monitord.h"
 #include <openssl/evp.h>
 #include <openssl/sha.h>
+#include "../external/zlib/zlib.h"
 
-/* Sign a log file */
-void OS_SignLog(const char *logfile, const char *logfile_old, const char * ext)
+static void sign_update(const char *data, size_t size, void *arg);
+static int sign_file(const char *path, EVP_MD_CTX **ctx, int compress);
+static int sign_gzip(const char *path, EVP_MD_CTX **ctx);
+static int chunk_exists(const char *path);
+
+/* Sign a log file, compressing it in the same pass if requested */
+void OS_SignLog(const char *logfile, const char *logfile_old, const char * ext, int compress)
 {
     int i;
     size_t n;
@@ -38,7 +44,8 @@ void OS_SignLog(const char *logfile, const char *logfile_old, const char * ext)
     char logfilesum[OS_FLSIZE + 1];
     char logfilesum_old[OS_FLSIZE + 1];
     char logfile_r[OS_FLSIZE + 1];
-    char buffer[4096];
+
+    EVP_MD_CTX *ctx[] = { md5_ctx, sha1_ctx, sha256_ctx, NULL };
 
     FILE *fp;
 
@@ -89,27 +96,12 @@ void OS_SignLog(const char *logfile, const char *logfile_old, const char * ext)
 
     /* Generate MD5, SHA-1, and SHA-256 of the current file */
 
-    if (fp = wfopen(logfile_r, "r"), fp) {
-        while (n = fread(buffer, 1, 2048, fp), n > 0) {
-            EVP_DigestUpdate(sha1_ctx, buffer, n);
-            EVP_DigestUpdate(md5_ctx, buffer, n);
-            EVP_DigestUpdate(sha256_ctx, buffer, n);
-        }
-
-        fclose(fp);
+    if (sign_file(logfile_r, ctx, compress) == 0) {
 
         // Include rotated files
 
-        for (i = 1; snprintf(logfile_r, OS_FLSIZE + 1, "%s-%.3d.%s", logfile, i, ext), !IsFile(logfile_r) && FileSize(logfile_r) > 0; i++) {
-            if (fp = wfopen(logfile_r, "r"), fp) {
-                while (n = fread(buffer, 1, 2048, fp), n > 0) {
-                    EVP_DigestUpdate(sha1_ctx, buffer, n);
-                    EVP_DigestUpdate(md5_ctx, buffer, n);
-                    EVP_DigestUpdate(sha256_ctx, buffer, n);
-                }
-
-                fclose(fp);
-            } else {
+        for (i = 1; snprintf(logfile_r, OS_FLSIZE + 1, "%s-%.3d.%s", logfile, i, ext), chunk_exists(logfile_r); i++) {
+            if (sign_file(logfile_r, ctx, compress) < 0) {
                 merror(FOPEN_ERROR, logfile_r, errno, strerror(errno));
                 break;
             }
@@ -165,3 +157,76 @@ void OS_SignLog(const char *logfile, const char *logfile_old, const char * ext)
 
     return;
 }
+
+/* Feed the digests with a chunk of a log file */
+static void sign_update(const char *data, size_t size, void *arg)
+{
+    EVP_MD_CTX **ctx = arg;
+    int i;
+
+    for (i = 0; ctx[i]; i++) {
+        EVP_DigestUpdate(ctx[i], data, size);
+    }
+}
+
+/* Feed the digests with a log file, compressing it if requested */
+static int sign_file(const char *path, EVP_MD_CTX **ctx, int compress)
+{
+    char buffer[4096];
+    size_t n;
+    FILE *fp;
+
+    if (compress) {
+        if (OS_CompressLogParallel(path, mond.compress_threads, mond.compress_rate, sign_update, ctx) < 0) {
+            return sign_gzip(path, ctx);
+        }
+
+        return 0;
+    }
+
+    if (fp = wfopen(path, "r"), !fp) {
+        return sign_gzip(path, ctx);
+    }
+
+    while (n = fread(buffer, 1, sizeof(buffer), fp), n > 0) {
+        sign_update(buffer, n, ctx);
+    }
+
+    fclose(fp);
+    return 0;
+}
+
+/* Feed the digests with the content of a chunk compressed by analysisd */
+static int sign_gzip(const char *path, EVP_MD_CTX **ctx)
+{
+    char path_gz[OS_FLSIZE + 1];
+    char buffer[4096];
+    gzFile fp;
+    int n;
+
+    snprintf(path_gz, sizeof(path_gz), "%s.gz", path);
+
+    if (fp = gzopen(path_gz, "rb"), !fp) {
+        return -1;
+    }
+
+    while (n = gzread(fp, buffer, sizeof(buffer)), n > 0) {
+        sign_update(buffer, n, ctx);
+    }
+
+    gzclose(fp);
+    return 0;
+}
+
+/* Check whether a non-empty chunk exists, either plain or compressed */
+static int chunk_exists(const char *path)
+{
+    char path_gz[OS_FLSIZE + 1];
+
+    if (!IsFile(path) && FileSize(path) > 0) {
+        return 1;
+    }
+
+    snprintf(path_gz, sizeof(path_gz), "%s.gz", path);
+    return !IsFile(path_gz) && FileSize(path_gz) > 0;
+}
@@ -33,6 +33,7 @@ struct keynode *queue_insert = NULL;
 struct keynode *queue_remove = NULL;
 struct keynode * volatile *insert_tail;
 struct keynode * volatile *remove_tail;
+static unsigned long keynode_seq = 0;
 
 // Append key to insertion queue
 void add_insert(const keyentry *entry,const char *group) {
@@ -44,19 +45,23 @@ void add_insert(const keyentry *entry,const char *group) {
     node->ip = strdup(entry->ip->ip);
     node->raw_key = strdup(entry->raw_key);
     node->group = group ? strdup(group) : NULL;
+    node->time_added = entry->time_added;
+    node->seq = keynode_seq++;
 
     (*insert_tail) = node;
     insert_tail = &node->next;
 }
 
 // Append key to deletion queue
-void add_remove(const keyentry *entry) {
+void add_remove(const keyentry *entry, int purge) {
     struct keynode *node;
 
     os_calloc(1, sizeof(struct keynode), node);
     node->id = strdup(entry->id);
     node->name = strdup(entry->name);
     node->ip = strdup(entry->ip->ip);
+    node->purge = purge;
+    node->seq = keynode_seq++;
 
     (*remove_tail) = node;
     remove_tail = &node->next;
@@ -309,7 +314,7 @@ w_err_t w_auth_replace_agent(keyentry *key,
     if (replace_agent) {
         snprintf(message, OS_SIZE_128, "Removing old agent '%s' (id '%s').", key->name, key->id);
         os_strdup(message, *str_result);
-        add_remove(key);
+        add_remove(key, 0);
         OS_DeleteKey(&keys, key->id, 0);
         return OS_SUCCESS;
     }
@@ -48,6 +48,7 @@ extern BIO *bio_err;
 #define DEFAULT_CENTRALIZED_GROUP "default"
 #define DEPRECATED_OPTION_WARN "Option '%s' is deprecated. Configure it in the file '%s'."
 #define MAX_SSL_PACKET_SIZE 16384
+#define KEYS_JOURNAL KEYS_FILE ".journal"
 
 #define full(i, j) ((i + 1) % AUTH_POOL == j)
 #define empty(i, j) (i == j)
@@ -68,6 +69,9 @@ struct keynode {
     char *ip;
     char *group;
     char *raw_key;
+    time_t time_added;
+    int purge;
+    unsigned long seq;  // Order of the change among the insertions and removals
     struct keynode *next;
 };
 
@@ -96,7 +100,29 @@ void* run_local_server(void *arg);
 void add_insert(const keyentry *entry,const char *group);
 
 // Append key to deletion queue
-void add_remove(const keyentry *entry);
+void add_remove(const keyentry *entry, int purge);
+
+/**
+ * @brief Append the pending key changes to the journal, in the order they were made, and flush it to disk.
+ *
+ * The journal keeps the changes not yet written into client.keys, see w_auth_journal_replay.
+ * @param path Path of the journal
+ * @param inserts Queue of added keys
+ * @param removals Queue of removed keys
+ * @return Number of changes written, or OS_INVALID on error.
+ * */
+int w_auth_journal_append(const char *path, const struct keynode *inserts, const struct keynode *removals);
+
+/**
+ * @brief Apply the changes of the journal to the keystore.
+ *
+ * The changes already in the keystore are skipped, so replaying a journal older than client.keys is harmless.
+ * Incomplete or invalid lines are ignored.
+ * @param path Path of the journal
+ * @param keys Keystore read from client.keys
+ * @return Number of changes applied, or OS_INVALID if the journal can't be read.
+ * */
+int w_auth_journal_replay(const char *path, keystore *keys);
 
 // Read configuration
 int authd_read_config(const char *path);
@@ -41,6 +41,8 @@ int authd_read_config(const char *path) {
 
     config.timeout_sec = getDefine_Int("auth", "timeout_seconds", 0, INT_MAX);
     config.timeout_usec = getDefine_Int("auth", "timeout_microseconds", 0, 999999);
+    config.handshake_threads = getDefine_Int("auth", "handshake_threads", 1, 128);
+    config.keys_compaction_interval = getDefine_Int("auth", "keys_compaction_interval", 0, 3600);
 
     return 0;
 }
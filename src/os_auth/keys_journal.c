@@ -0,0 +1,143 @@
+/* Copyright (C) 2015, Wazuh Inc.
+ * All rights reserved.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation
+ */
+
+#include "shared.h"
+#include "auth.h"
+
+/* Journal of the key changes not yet compacted into client.keys. Lines are:
+ * "+ <id> <name> <ip> <key> <time added>" for added keys and "- <id> <purge>" for removed keys. */
+
+int w_auth_journal_append(const char *path, const struct keynode *inserts, const struct keynode *removals) {
+    FILE *fp;
+    int count = 0;
+
+    if (!inserts && !removals) {
+        return 0;
+    }
+
+    if (fp = wfopen(path, "a"), !fp) {
+        merror(FOPEN_ERROR, path, errno, strerror(errno));
+        return OS_INVALID;
+    }
+
+    // Same permissions as client.keys
+    if (fchmod(fileno(fp), 0640) < 0) {
+        mdebug1("Couldn't set the permissions of '%s': %s (%d)", path, strerror(errno), errno);
+    }
+
+    // Both queues are sorted, merge them to keep the order of the changes
+    while (inserts || removals) {
+        int written;
+
+        if (inserts && (!removals || inserts->seq < removals->seq)) {
+            written = fprintf(fp, "+ %s %s %s %s %ld\n", inserts->id, inserts->name, inserts->ip, inserts->raw_key, (long)inserts->time_added);
+            inserts = inserts->next;
+        } else {
+            written = fprintf(fp, "- %s %d\n", removals->id, removals->purge);
+            removals = removals->next;
+        }
+
+        if (written < 0) {
+            merror(FWRITE_ERROR, path, errno, strerror(errno));
+            fclose(fp);
+            return OS_INVALID;
+        }
+
+        count++;
+    }
+
+    if (fflush(fp) != 0 || fsync(fileno(fp)) < 0) {
+        merror(FWRITE_ERROR, path, errno, strerror(errno));
+        fclose(fp);
+        return OS_INVALID;
+    }
+
+    if (fclose(fp) != 0) {
+        merror(FCLOSE_ERROR, path, errno, strerror(errno));
+        return OS_INVALID;
+    }
+
+    return count;
+}
+
+int w_auth_journal_replay(const char *path, keystore *keys) {
+    FILE *fp;
+    char buffer[OS_BUFFER_SIZE + 1];
+    int count = 0;
+
+    if (fp = wfopen(path, "r"), !fp) {
+        if (errno == ENOENT) {
+            return 0;
+        }
+
+        merror(FOPEN_ERROR, path, errno, strerror(errno));
+        return OS_INVALID;
+    }
+
+    while (fgets(buffer, sizeof(buffer), fp)) {
+        char *saveptr = NULL;
+        char *op;
+        char *id;
+        size_t length = strlen(buffer);
+
+        // The last line may be incomplete if the daemon stopped while appending it
+        if (length == 0 || buffer[length - 1] != '\n') {
+            mwarn("Ignoring incomplete line in '%s'.", path);
+            continue;
+        }
+
+        op = strtok_r(buffer, " \n", &saveptr);
+        id = strtok_r(NULL, " \n", &saveptr);
+
+        if (!op || !id) {
+            mwarn("Ignoring invalid line in '%s'.", path);
+            continue;
+        }
+
+        if (!strcmp(op, "+")) {
+            char *name = strtok_r(NULL, " \n", &saveptr);
+            char *ip = strtok_r(NULL, " \n", &saveptr);
+            char *key = strtok_r(NULL, " \n", &saveptr);
+            char *time_added = strtok_r(NULL, " \n", &saveptr);
+            char *end;
+            long id_number;
+
+            if (!name || !ip || !key || !time_added) {
+                mwarn("Ignoring invalid line in '%s'.", path);
+                continue;
+            }
+
+            // Already in client.keys
+            if (OS_IsAllowedID(keys, id) >= 0) {
+                continue;
+            }
+
+            OS_AddKey(keys, id, name, ip, key, (time_t)strtol(time_added, NULL, 10));
+
+            id_number = strtol(id, &end, 10);
+
+            if (!*end && id_number > keys->id_counter) {
+                keys->id_counter = id_number;
+            }
+
+            count++;
+        } else if (!strcmp(op, "-")) {
+            char *purge = strtok_r(NULL, " \n", &saveptr);
+
+            if (OS_DeleteKey(keys, id, purge ? atoi(purge) : 1) >= 0) {
+                count++;
+            }
+        } else {
+            mwarn("Ignoring invalid line in '%s'.", path);
+        }
+    }
+
+    fclose(fp);
+    return count;
+}
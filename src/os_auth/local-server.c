@@ -461,7 +461,7 @@ cJSON* local_remove(const char *id, int purge) {
     } else {
         minfo("Agent '%s' (%s) deleted (requested locally)", id, keys.keyentries[index]->name);
         /* Add pending key to write */
-        add_remove(keys.keyentries[index]);
+        add_remove(keys.keyentries[index], purge);
         OS_DeleteKey(&keys, id, purge);
         write_pending = 1;
         w_cond_signal(&cond_pending);
@@ -131,13 +131,14 @@ int main(int argc, char **argv)
     int debug_level = 0;
     int test_config = 0;
     int status;
+    int i;
     int run_foreground = 0;
     gid_t gid;
     const char *group = GROUPGLOBAL;
     char buf[4096 + 1];
 
     pthread_t thread_local_server = 0;
-    pthread_t thread_dispatcher = 0;
+    pthread_t *thread_dispatchers = NULL;
     pthread_t thread_remote_server = 0;
     pthread_t thread_writer = 0;
     pthread_t thread_key_request = 0;
@@ -598,6 +599,19 @@ int main(int argc, char **argv)
         OS_PassEmptyKeyfile();
         OS_ReadKeys(&keys, W_RAW_KEY, !config.flags.clear_removed);
         OS_ReadTimestamps(&keys);
+
+        /* Apply the changes journaled and not written into client.keys before stopping */
+        int replayed = w_auth_journal_replay(KEYS_JOURNAL, &keys);
+
+        if (replayed > 0) {
+            minfo("Recovered %d key changes from the journal.", replayed);
+
+            if (OS_WriteKeys(&keys) < 0 || OS_WriteTimestamps(&keys) < 0) {
+                merror("Couldn't write the recovered keys, the journal is kept.");
+            } else if (unlink(KEYS_JOURNAL) < 0) {
+                merror(DELETE_ERROR, KEYS_JOURNAL, errno, strerror(errno));
+            }
+        }
     }
 
     /* Start working threads */
@@ -609,10 +623,14 @@ int main(int argc, char **argv)
 
     if (config.flags.remote_enrollment) {
         client_queue = queue_init(AUTH_POOL);
+        os_calloc(config.handshake_threads, sizeof(pthread_t), thread_dispatchers);
 
-        if (status = pthread_create(&thread_dispatcher, NULL, (void *)&run_dispatcher, NULL), status != 0) {
-            merror("Couldn't create thread: %s", strerror(status));
-            return EXIT_FAILURE;
+        /* The TLS handshakes run in a pool of their own, the keys are written by the writer thread */
+        for (i = 0; i < config.handshake_threads; i++) {
+            if (status = pthread_create(&thread_dispatchers[i], NULL, (void *)&run_dispatcher, NULL), status != 0) {
+                merror("Couldn't create thread: %s", strerror(status));
+                return EXIT_FAILURE;
+            }
         }
 
         if (status = pthread_create(&thread_remote_server, NULL, (void *)&run_remote_server, NULL), status != 0) {
@@ -640,8 +658,12 @@ int main(int argc, char **argv)
     /* Join threads */
     pthread_join(thread_local_server, NULL);
     if (config.flags.remote_enrollment) {
-        pthread_join(thread_dispatcher, NULL);
+        for (i = 0; i < config.handshake_threads; i++) {
+            pthread_join(thread_dispatchers[i], NULL);
+        }
         pthread_join(thread_remote_server, NULL);
+        os_free(thread_dispatchers);
+        SSL_CTX_free(ctx);
     }
     if (!config.worker_node) {
         /* Send signal to writer thread */
@@ -800,14 +822,18 @@ void* run_dispatcher(__attribute__((unused)) void *arg) {
                     merror("Agent key not saved for %s", agentname);
                     ERR_print_errors_fp(stderr);
                     w_mutex_lock(&mutex_keys);
-                    OS_DeleteKey(&keys, keys.keyentries[keys.keysize - 1]->id, 1);
+                    OS_DeleteKey(&keys, new_id, 1);
                     w_mutex_unlock(&mutex_keys);
                 } else {
-                    /* Add pending key to write */
+                    /* Add pending key to write. Other dispatchers may have added keys after this one */
                     w_mutex_lock(&mutex_keys);
-                    add_insert(keys.keyentries[keys.keysize - 1], centralized_group);
-                    write_pending = 1;
-                    w_cond_signal(&cond_pending);
+                    int index = OS_IsAllowedID(&keys, new_id);
+
+                    if (index >= 0) {
+                        add_insert(keys.keyentries[index], centralized_group);
+                        write_pending = 1;
+                        w_cond_signal(&cond_pending);
+                    }
                     w_mutex_unlock(&mutex_keys);
                 }
             }
@@ -836,7 +862,6 @@ void* run_dispatcher(__attribute__((unused)) void *arg) {
 
     mdebug1("Dispatch thread finished");
 
-    SSL_CTX_free(ctx);
     return NULL;
 }
 
@@ -927,9 +952,36 @@ void* run_remote_server(__attribute__((unused)) void *arg) {
     return NULL;
 }
 
+/* Write the keystore into client.keys and drop the journal, the journaled changes are in it now */
+static void compact_keys() {
+    keystore *copy_keys;
+    struct timespec t0, t1;
+
+    w_mutex_lock(&mutex_keys);
+    copy_keys = OS_DupKeys(&keys);
+    w_mutex_unlock(&mutex_keys);
+
+    gettime(&t0);
+
+    if (OS_WriteKeys(copy_keys) < 0) {
+        merror("Couldn't write file client.keys");
+        sleep(1);
+    } else if (OS_WriteTimestamps(copy_keys) < 0) {
+        merror("Couldn't write file agents-timestamp.");
+        sleep(1);
+    } else if (unlink(KEYS_JOURNAL) < 0 && errno != ENOENT) {
+        merror(DELETE_ERROR, KEYS_JOURNAL, errno, strerror(errno));
+    }
+
+    gettime(&t1);
+    mdebug2("[Writer] Compaction: %d µs.", (int)(1000000. * (double)time_diff(&t0, &t1)));
+
+    OS_FreeKeys(copy_keys);
+    os_free(copy_keys);
+}
+
 /* Thread for writing keystore onto disk */
 void* run_writer(__attribute__((unused)) void *arg) {
-    keystore *copy_keys;
     struct keynode *copy_insert;
     struct keynode *copy_remove;
     struct keynode *cur;
@@ -937,6 +989,8 @@ void* run_writer(__attribute__((unused)) void *arg) {
     char wdbquery[OS_SIZE_128];
     char wdboutput[128];
     int wdb_sock = -1;
+    int compaction_pending = 0;
+    time_t last_compaction = time(NULL);
 
     authd_sigblock();
 
@@ -948,6 +1002,7 @@ void* run_writer(__attribute__((unused)) void *arg) {
     while (running) {
         int inserted_agents = 0;
         int removed_agents = 0;
+        int idle;
 
         w_mutex_lock(&mutex_keys);
 
@@ -959,7 +1014,6 @@ void* run_writer(__attribute__((unused)) void *arg) {
 
         gettime(&global_t0);
 
-        copy_keys = OS_DupKeys(&keys);
         copy_insert = queue_insert;
         copy_remove = queue_remove;
         queue_insert = NULL;
@@ -969,64 +1023,81 @@ void* run_writer(__attribute__((unused)) void *arg) {
         write_pending = 0;
         w_mutex_unlock(&mutex_keys);
 
+        /* The batch is persisted appending it to the journal, client.keys is rewritten by the compaction */
         gettime(&t0);
 
-        if (OS_WriteKeys(copy_keys) < 0) {
-            merror("Couldn't write file client.keys");
-            sleep(1);
-        }
-
-        gettime(&t1);
-        mdebug2("[Writer] OS_WriteKeys(): %d µs.", (int)(1000000. * (double)time_diff(&t0, &t1)));
-
-        gettime(&t0);
-
-        if (OS_WriteTimestamps(copy_keys) < 0) {
-            merror("Couldn't write file agents-timestamp.");
+        if (w_auth_journal_append(KEYS_JOURNAL, copy_insert, copy_remove) < 0) {
+            merror("Couldn't write the key changes into the journal.");
             sleep(1);
         }
 
         gettime(&t1);
-        mdebug2("[Writer] OS_WriteTimestamps(): %d µs.", (int)(1000000. * (double)time_diff(&t0, &t1)));
-
-        OS_FreeKeys(copy_keys);
-        os_free(copy_keys);
-
-        for (cur = copy_insert; cur; cur = next) {
-            next = cur->next;
+        mdebug2("[Writer] w_auth_journal_append(): %d µs.", (int)(1000000. * (double)time_diff(&t0, &t1)));
+
+        if (copy_insert) {
+            cJSON *agents = cJSON_CreateArray();
+            cJSON *groups = cJSON_CreateArray();
+
+            for (cur = copy_insert; cur; cur = cur->next) {
+                mdebug1("[Writer] Performing insert([%s] %s).", cur->id, cur->name);
+
+                cJSON *agent = cJSON_CreateObject();
+                cJSON_AddNumberToObject(agent, "id", atoi(cur->id));
+                cJSON_AddStringToObject(agent, "name", cur->name);
+                cJSON_AddStringToObject(agent, "register_ip", cur->ip);
+                cJSON_AddStringToObject(agent, "internal_key", cur->raw_key);
+                if (cur->group) {
+                    cJSON_AddStringToObject(agent, "group", cur->group);
+                }
+                cJSON_AddNumberToObject(agent, "date_add", cur->time_added ? cur->time_added : time(NULL));
+                cJSON_AddItemToArray(agents, agent);
+
+                if (cur->group) {
+                    char **groups_array = w_string_split(cur->group, ",", 0);
+                    cJSON *agent_groups = cJSON_CreateObject();
+                    cJSON *j_groups = NULL;
+
+                    cJSON_AddNumberToObject(agent_groups, "id", atoi(cur->id));
+                    j_groups = cJSON_AddArrayToObject(agent_groups, "groups");
+                    for (int i = 0; groups_array[i]; i++) {
+                        cJSON_AddItemToArray(j_groups, cJSON_CreateString(groups_array[i]));
+                    }
+                    cJSON_AddItemToArray(groups, agent_groups);
+                    free_strarray(groups_array);
+                }
 
-            mdebug1("[Writer] Performing insert([%s] %s).", cur->id, cur->name);
+                inserted_agents++;
+            }
 
             gettime(&t0);
-            if (wdb_insert_agent(atoi(cur->id), cur->name, NULL, cur->ip, cur->raw_key, cur->group, 1, &wdb_sock)) {
-                mdebug2("The agent %s '%s' already exists in the database.", cur->id, cur->name);
+            if (wdb_insert_agents(agents, &wdb_sock)) {
+                mdebug2("Some of the %d agents couldn't be inserted in the database, they may already exist.", inserted_agents);
             }
             gettime(&t1);
-            mdebug2("[Writer] wdb_insert_agent(): %d µs.", (int)(1000000. * (double)time_diff(&t0, &t1)));
+            mdebug2("[Writer] wdb_insert_agents(): %d µs.", (int)(1000000. * (double)time_diff(&t0, &t1)));
 
             gettime(&t0);
-            if (cur->group) {
-                if (wdb_set_agent_groups_csv(atoi(cur->id),
-                                             cur->group,
-                                             WDB_GROUP_MODE_OVERRIDE,
-                                             w_is_single_node(NULL) ? "synced" : "syncreq",
-                                             &wdb_sock)) {
-                    merror("Unable to set agent centralized group: %s (internal error)", cur->group);
-                }
-
+            if (cJSON_GetArraySize(groups) > 0 && wdb_set_agents_groups(groups,
+                                                                        WDB_GROUP_MODE_OVERRIDE,
+                                                                        w_is_single_node(NULL) ? "synced" : "syncreq",
+                                                                        &wdb_sock)) {
+                merror("Unable to set the agents centralized groups (internal error)");
             }
-
             gettime(&t1);
-            mdebug2("[Writer] wdb_set_agent_groups_csv(): %d µs.", (int)(1000000. * (double)time_diff(&t0, &t1)));
+            mdebug2("[Writer] wdb_set_agents_groups(): %d µs.", (int)(1000000. * (double)time_diff(&t0, &t1)));
+
+            cJSON_Delete(agents);
+            cJSON_Delete(groups);
+        }
 
+        for (cur = copy_insert; cur; cur = next) {
+            next = cur->next;
             os_free(cur->id);
             os_free(cur->name);
             os_free(cur->ip);
             os_free(cur->group);
             os_free(cur->raw_key);
             os_free(cur);
-
-            inserted_agents++;
         }
 
         for (cur = copy_remove; cur; cur = next) {
@@ -1044,11 +1115,6 @@ void* run_writer(__attribute__((unused)) void *arg) {
             gettime(&t1);
             mdebug2("[Writer] OS_RemoveCounter(): %d µs.", (int)(1000000. * (double)time_diff(&t0, &t1)));
 
-            gettime(&t0);
-            OS_RemoveAgentTimestamp(cur->id);
-            gettime(&t1);
-            mdebug2("[Writer] OS_RemoveAgentTimestamp(): %d µs.", (int)(1000000. * (double)time_diff(&t0, &t1)));
-
             gettime(&t0);
             if (wdb_remove_agent(atoi(cur->id), &wdb_sock) != OS_SUCCESS) {
                 mdebug1("Could not remove the information stored in Wazuh DB of the agent %s.", cur->id);
@@ -1072,12 +1138,30 @@ void* run_writer(__attribute__((unused)) void *arg) {
             removed_agents++;
         }
 
+        compaction_pending |= inserted_agents || removed_agents;
+
+        /* Rewrite client.keys, and the timestamps without the removed agents, as soon as there are no more
+         * changes or every keys_compaction_interval seconds under a sustained load */
+        w_mutex_lock(&mutex_keys);
+        idle = !write_pending;
+        w_mutex_unlock(&mutex_keys);
+
+        if (compaction_pending && (idle || time(NULL) - last_compaction >= config.keys_compaction_interval)) {
+            compact_keys();
+            compaction_pending = 0;
+            last_compaction = time(NULL);
+        }
+
         gettime(&global_t1);
         mdebug2("[Writer] Inserted agents: %d", inserted_agents);
         mdebug2("[Writer] Removed agents: %d", removed_agents);
         mdebug2("[Writer] Loop: %d ms.", (int)(1000. * (double)time_diff(&global_t0, &global_t1)));
     }
 
+    if (compaction_pending) {
+        compact_keys();
+    }
+
     return NULL;
 }
 
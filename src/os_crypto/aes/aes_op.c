@@ -11,6 +11,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <pthread.h>
 
 #include <openssl/conf.h>
 #include <openssl/evp.h>
@@ -19,20 +20,145 @@
 
 typedef unsigned char uchar;
 
+/* Bytes of the key used by AES-256 */
+#define AES_KEY_SIZE 32
+
+/* Contexts cached by each thread, indexed by a hash of the key */
+#define AES_CACHE_SIZE 256
+
+/* Cipher contexts already set up with a key, so a message only has to
+ * reset the IV instead of allocating a context and expanding the key */
+typedef struct aes_cache_entry {
+    uchar key[AES_KEY_SIZE];
+    EVP_CIPHER_CTX *ctx[2]; /* Indexed by action: OS_DECRYPT or OS_ENCRYPT */
+} aes_cache_entry;
+
+static pthread_key_t aes_cache_key;
+static pthread_once_t aes_cache_once = PTHREAD_ONCE_INIT;
+
+static void aes_cache_free(void *data)
+{
+    aes_cache_entry *cache = data;
+    int i;
+
+    for (i = 0; i < AES_CACHE_SIZE; i++) {
+        EVP_CIPHER_CTX_free(cache[i].ctx[OS_DECRYPT]);
+        EVP_CIPHER_CTX_free(cache[i].ctx[OS_ENCRYPT]);
+    }
+
+    OPENSSL_cleanse(cache, AES_CACHE_SIZE * sizeof(aes_cache_entry));
+    free(cache);
+}
+
+static void aes_cache_init(void)
+{
+    pthread_key_create(&aes_cache_key, aes_cache_free);
+}
+
+/**
+ * @brief Gets the cache entry of this thread set up with a key
+ *
+ * @param key Key, padded with zeros to AES_KEY_SIZE bytes.
+ * @param action OS_ENCRYPT or OS_DECRYPT.
+ * @return Entry whose context for the action is ready to be initialized with the IV, NULL on error.
+ */
+static aes_cache_entry *aes_cache_get(const uchar *key, short int action)
+{
+    aes_cache_entry *cache;
+    aes_cache_entry *entry;
+    unsigned int hash = 2166136261u;
+    int i;
+
+    pthread_once(&aes_cache_once, aes_cache_init);
+
+    if (cache = pthread_getspecific(aes_cache_key), !cache) {
+        if (cache = calloc(AES_CACHE_SIZE, sizeof(aes_cache_entry)), !cache) {
+            return NULL;
+        }
+        pthread_setspecific(aes_cache_key, cache);
+    }
+
+    for (i = 0; i < AES_KEY_SIZE; i++) {
+        hash = (hash ^ key[i]) * 16777619u;
+    }
+
+    entry = &cache[hash % AES_CACHE_SIZE];
+
+    /* The slot belongs to another key: its contexts are keyed again */
+    if (memcmp(entry->key, key, AES_KEY_SIZE) != 0) {
+        memcpy(entry->key, key, AES_KEY_SIZE);
+        EVP_CIPHER_CTX_free(entry->ctx[OS_DECRYPT]);
+        EVP_CIPHER_CTX_free(entry->ctx[OS_ENCRYPT]);
+        entry->ctx[OS_DECRYPT] = NULL;
+        entry->ctx[OS_ENCRYPT] = NULL;
+    }
+
+    if (!entry->ctx[action]) {
+        EVP_CIPHER_CTX *ctx;
+
+        if (ctx = EVP_CIPHER_CTX_new(), !ctx) {
+            return NULL;
+        }
+
+        if (1 != EVP_CipherInit_ex(ctx, EVP_aes_256_cbc(), NULL, key, NULL, action)) {
+            EVP_CIPHER_CTX_free(ctx);
+            return NULL;
+        }
+
+        entry->ctx[action] = ctx;
+    }
+
+    return entry;
+}
+
+/* Runs a whole encryption or decryption with a context already keyed */
+static int aes_cipher(EVP_CIPHER_CTX *ctx, const uchar *input, int input_len, const uchar *iv, uchar *output)
+{
+    int len;
+    int output_len;
+
+    if (1 != EVP_CipherInit_ex(ctx, NULL, NULL, NULL, iv, -1)) {
+        return 0;
+    }
+
+    if (1 != EVP_CipherUpdate(ctx, output, &len, input, input_len)) {
+        return 0;
+    }
+
+    output_len = len;
+
+    if (1 != EVP_CipherFinal_ex(ctx, output + len, &len)) {
+        return 0;
+    }
+
+    return output_len + len;
+}
 
 int OS_AES_Str(const char *input, char *output, const char *charkey,
               long size, short int action)
 {
     static unsigned char *iv = (unsigned char *)"FEDCBA0987654321";
-
-    if(action == OS_ENCRYPT)
-    {
-        return encrypt_AES((const uchar *)input, (int)size,(uchar *)charkey, iv,(uchar *)output);
-    }
-    else
-    {
-        return decrypt_AES((const uchar *)input, (int)size,(uchar *)charkey, iv,(uchar *)output);
+    uchar key[AES_KEY_SIZE] = {0};
+    aes_cache_entry *entry;
+    int result;
+
+    action = action == OS_ENCRYPT ? OS_ENCRYPT : OS_DECRYPT;
+    memcpy(key, charkey, strnlen(charkey, AES_KEY_SIZE));
+
+    if (entry = aes_cache_get(key, action), !entry) {
+        if (action == OS_ENCRYPT) {
+            result = encrypt_AES((const uchar *)input, (int)size, key, iv, (uchar *)output);
+        } else {
+            result = decrypt_AES((const uchar *)input, (int)size, key, iv, (uchar *)output);
+        }
+    } else if (result = aes_cipher(entry->ctx[action], (const uchar *)input, (int)size, iv, (uchar *)output), !result) {
+        /* The context is left in an unknown state, it's set up again next time */
+        EVP_CIPHER_CTX_free(entry->ctx[action]);
+        entry->ctx[action] = NULL;
     }
+
+    OPENSSL_cleanse(key, sizeof(key));
+    return result;
 }
 
 int encrypt_AES(const unsigned char *plaintext, int plaintext_len, unsigned char *key,
@@ -15,26 +15,113 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <pthread.h>
 
 #include <openssl/blowfish.h>
+#include <openssl/crypto.h>
 #include "bf_op.h"
 
 typedef unsigned char uchar;
 
+/* Key schedules cached by each thread, indexed by a hash of the key */
+#define BF_CACHE_SIZE 256
+
+/* Setting up a Blowfish key takes hundreds of block encryptions, so
+ * the schedule of the last keys used by the thread is kept */
+typedef struct bf_cache_entry {
+    char *charkey;
+    BF_KEY key;
+} bf_cache_entry;
+
+static pthread_key_t bf_cache_key;
+static pthread_once_t bf_cache_once = PTHREAD_ONCE_INIT;
+
+static void bf_cache_free(void *data)
+{
+    bf_cache_entry *cache = data;
+    int i;
+
+    for (i = 0; i < BF_CACHE_SIZE; i++) {
+        if (cache[i].charkey) {
+            OPENSSL_cleanse(cache[i].charkey, strlen(cache[i].charkey));
+            free(cache[i].charkey);
+        }
+    }
+
+    OPENSSL_cleanse(cache, BF_CACHE_SIZE * sizeof(bf_cache_entry));
+    free(cache);
+}
+
+static void bf_cache_init(void)
+{
+    pthread_key_create(&bf_cache_key, bf_cache_free);
+}
+
+/**
+ * @brief Gets the schedule of a key from the cache of this thread
+ *
+ * @param charkey Key.
+ * @return Key schedule, NULL if the cache couldn't be allocated.
+ */
+static const BF_KEY *bf_cache_get(const char *charkey)
+{
+    bf_cache_entry *cache;
+    bf_cache_entry *entry;
+    unsigned int hash = 2166136261u;
+    const char *c;
+
+    pthread_once(&bf_cache_once, bf_cache_init);
+
+    if (cache = pthread_getspecific(bf_cache_key), !cache) {
+        if (cache = calloc(BF_CACHE_SIZE, sizeof(bf_cache_entry)), !cache) {
+            return NULL;
+        }
+        pthread_setspecific(bf_cache_key, cache);
+    }
+
+    for (c = charkey; *c; c++) {
+        hash = (hash ^ (uchar)*c) * 16777619u;
+    }
+
+    entry = &cache[hash % BF_CACHE_SIZE];
+
+    if (!entry->charkey || strcmp(entry->charkey, charkey) != 0) {
+        char *copy;
+
+        if (copy = strdup(charkey), !copy) {
+            return NULL;
+        }
+
+        if (entry->charkey) {
+            OPENSSL_cleanse(entry->charkey, strlen(entry->charkey));
+            free(entry->charkey);
+        }
+
+        entry->charkey = copy;
+        BF_set_key(&entry->key, (int)strlen(charkey), (const uchar *)charkey);
+    }
+
+    return &entry->key;
+}
 
 int OS_BF_Str(const char *input, char *output, const char *charkey,
               long size, short int action)
 {
     BF_KEY key = {.P = {0}};
+    const BF_KEY *cached_key;
     static unsigned char cbc_iv [8] = {0xfe, 0xdc, 0xba, 0x98, 0x76, 0x54, 0x32, 0x10};
     unsigned char iv[8];
 
     memcpy(iv, cbc_iv, sizeof(iv));
 
-    BF_set_key(&key, (int)strlen(charkey), (const uchar *)charkey);
+    if (cached_key = bf_cache_get(charkey), !cached_key) {
+        BF_set_key(&key, (int)strlen(charkey), (const uchar *)charkey);
+        cached_key = &key;
+    }
 
     BF_cbc_encrypt((const uchar *)input, (uchar *)output, (long)size,
-                   &key, iv, action);
+                   cached_key, iv, action);
 
+    OPENSSL_cleanse(&key, sizeof(key));
     return (1);
 }
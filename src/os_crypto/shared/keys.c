@@ -427,31 +427,64 @@ int OS_CheckUpdateKeys(const keystore *keys)
 /* Update the keys if changed */
 void OS_UpdateKeys(keystore *keys)
 {
-    keystore *old_keys;
-
     mdebug1("Reloading keys");
+    OS_SwapKeys(keys, OS_ReadUpdatedKeys(keys));
+    mdebug1("Key reloading completed");
+}
 
-    mdebug2("OS_DupKeys");
-    old_keys = OS_DupKeys(keys);
+keystore * OS_ReadUpdatedKeys(const keystore *keys)
+{
+    keystore *new_keys;
 
-    mdebug2("Freekeys");
-    OS_FreeKeys(keys);
+    os_calloc(1, sizeof(keystore), new_keys);
 
     /* Read keys */
     mdebug2("OS_ReadKeys");
     minfo(ENC_READ);
-    OS_ReadKeys(keys, keys->flags.key_mode, keys->flags.save_removed);
+    OS_ReadKeys(new_keys, keys->flags.key_mode, keys->flags.save_removed);
 
     mdebug2("OS_StartCounter");
-    OS_StartCounter(keys);
+    OS_StartCounter(new_keys);
 
-    mdebug2("move_netdata");
-    move_netdata(keys, old_keys);
+    return new_keys;
+}
 
-    OS_FreeKeys(old_keys);
-    free(old_keys);
+void OS_SwapKeys(keystore *keys, keystore *new_keys)
+{
+    keystore old_keys = *new_keys;
+
+    /* The structures are exchanged but their mutexes, which stay in place */
+    new_keys->keyentries = keys->keyentries;
+    new_keys->keytree_id = keys->keytree_id;
+    new_keys->keytree_ip = keys->keytree_ip;
+    new_keys->keytree_sock = keys->keytree_sock;
+    new_keys->keysize = keys->keysize;
+    new_keys->file_change = keys->file_change;
+    new_keys->inode = keys->inode;
+    new_keys->id_counter = keys->id_counter;
+    new_keys->flags = keys->flags;
+    new_keys->removed_keys = keys->removed_keys;
+    new_keys->removed_keys_size = keys->removed_keys_size;
+    new_keys->opened_fp_queue = keys->opened_fp_queue;
+
+    keys->keyentries = old_keys.keyentries;
+    keys->keytree_id = old_keys.keytree_id;
+    keys->keytree_ip = old_keys.keytree_ip;
+    keys->keytree_sock = old_keys.keytree_sock;
+    keys->keysize = old_keys.keysize;
+    keys->file_change = old_keys.file_change;
+    keys->inode = old_keys.inode;
+    keys->id_counter = old_keys.id_counter;
+    keys->flags = old_keys.flags;
+    keys->removed_keys = old_keys.removed_keys;
+    keys->removed_keys_size = old_keys.removed_keys_size;
+    keys->opened_fp_queue = old_keys.opened_fp_queue;
 
-    mdebug1("Key reloading completed");
+    mdebug2("move_netdata");
+    move_netdata(keys, new_keys);
+
+    OS_FreeKeys(new_keys);
+    free(new_keys);
 }
 
 /* Check if an IP address is allowed to connect */
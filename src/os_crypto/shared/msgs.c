@@ -117,10 +117,14 @@ void OS_StartCounter(keystore *keys)
             }
 
             if (i == keys->keysize) {
-                mdebug1("Assigning sender counter: %u:%u",
-                        g_c, l_c);
-                global_count = g_c;
-                local_count = l_c;
+                /* The counter only moves forward: when the keys are reloaded,
+                 * messages may have been sent since the file was read */
+                if (g_c > global_count || (g_c == global_count && l_c > local_count)) {
+                    mdebug1("Assigning sender counter: %u:%u",
+                            g_c, l_c);
+                    global_count = g_c;
+                    local_count = l_c;
+                }
             } else {
                 mdebug1("Assigning counter for agent %s: '%u:%u'.",
                         keys->keyentries[i]->name, g_c, l_c);
@@ -296,37 +300,38 @@ int ReadSecMSG(keystore *keys, char *buffer, char *cleartext, int id, unsigned i
     unsigned int msg_global = 0;
     unsigned int msg_local = 0;
     char *f_msg;
+    crypt_method method;
 
-    w_mutex_lock(&keys->keyentries[id]->mutex);
-
+    /* The method is taken from the message, the one stored in the key is
+     * used to answer the agent */
     if(strncmp(buffer, "#AES", 4)==0){
         buffer+=4;
-        #ifndef CLIENT
-            keys->keyentries[id]->crypto_method = W_METH_AES;
-        #endif
+        method = W_METH_AES;
     }
     else{
-        #ifndef CLIENT
-            keys->keyentries[id]->crypto_method = W_METH_BLOWFISH;
-        #endif
+        method = W_METH_BLOWFISH;
     }
 
+    #ifndef CLIENT
+        keys->keyentries[id]->crypto_method = method;
+    #else
+        method = keys->keyentries[id]->crypto_method;
+    #endif
 
     if (*buffer == ':') {
         buffer++;
     } else {
         merror(ENCFORMAT_ERROR, keys->keyentries[id]->id, srcip);
-        w_mutex_unlock(&keys->keyentries[id]->mutex);
         return KS_CORRUPT;
     }
 
-    /* Decrypt message */
-    switch((crypt_method)keys->keyentries[id]->crypto_method){
+    /* Decrypt message. The key doesn't change while the keystore is
+     * read, so the messages of an agent are decrypted concurrently */
+    switch(method){
         case W_METH_BLOWFISH:
             if (!OS_BF_Str(buffer, cleartext, keys->keyentries[id]->encryption_key,
                         buffer_size, OS_DECRYPT)) {
                 mwarn(ENCKEY_ERROR, keys->keyentries[id]->id, keys->keyentries[id]->ip->ip);
-                w_mutex_unlock(&keys->keyentries[id]->mutex);
                 return KS_ENCKEY;
             }
             break;
@@ -334,14 +339,11 @@ int ReadSecMSG(keystore *keys, char *buffer, char *cleartext, int id, unsigned i
             if (!OS_AES_Str(buffer, cleartext, keys->keyentries[id]->encryption_key,
                 buffer_size-4, OS_DECRYPT)) {
                 mwarn(ENCKEY_ERROR, keys->keyentries[id]->id, keys->keyentries[id]->ip->ip);
-                w_mutex_unlock(&keys->keyentries[id]->mutex);
                 return KS_ENCKEY;
             }
             break;
     }
 
-    w_mutex_unlock(&keys->keyentries[id]->mutex);
-
     /* Compressed */
     if (cleartext[0] == '!') {
         cleartext[buffer_size] = '\0';
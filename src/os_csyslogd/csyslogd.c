@@ -21,7 +21,11 @@ typedef struct alert_source_t {
 char __shost[512];
 char __shost_long[512];
 
+/* Read the JSON alerts from the analysisd alert bus */
+int csyslogd_alert_bus;
+
 static alert_source_t get_alert_sources(SyslogConfig **syslog_config);
+static cJSON * get_alert_filter(SyslogConfig **syslog_config);
 
 /* Monitor the alerts and send them via syslog
  * Only return in case of error
@@ -63,6 +67,12 @@ void OS_CSyslogD(SyslogConfig **syslog_config)
     if (sources.alert_json) {
         jqueue_init(&jfileq);
 
+        if (csyslogd_alert_bus) {
+            cJSON *filter = get_alert_filter(syslog_config);
+            jqueue_subscribe(&jfileq, filter);
+            cJSON_Delete(filter);
+        }
+
         for (tries = 1; tries < OS_CSYSLOGD_MAX_TRIES && jqueue_open(&jfileq, 1) < 0; tries++) {
             sleep(1);
         }
@@ -255,3 +265,46 @@ alert_source_t get_alert_sources(SyslogConfig **syslog_config) {
 
     return sources;
 }
+
+/* Filter of the alert bus matching every alert that any JSON server may receive.
+ * The group and location of the servers are checked on each alert received.
+ */
+cJSON * get_alert_filter(SyslogConfig **syslog_config) {
+    cJSON *filter = cJSON_CreateObject();
+    cJSON *rule_ids = cJSON_CreateArray();
+    unsigned int level = 0;
+    int any_rule = 0;
+    int first = 1;
+    int i;
+    int j;
+
+    for (i = 0; syslog_config[i]; i++) {
+        if (syslog_config[i]->format != JSON_CSYSLOG) {
+            continue;
+        }
+
+        if (first || syslog_config[i]->level < level) {
+            level = syslog_config[i]->level;
+        }
+
+        if (syslog_config[i]->rule_id) {
+            for (j = 0; syslog_config[i]->rule_id[j]; j++) {
+                cJSON_AddItemToArray(rule_ids, cJSON_CreateNumber(syslog_config[i]->rule_id[j]));
+            }
+        } else {
+            any_rule = 1;
+        }
+
+        first = 0;
+    }
+
+    cJSON_AddNumberToObject(filter, "level", level);
+
+    if (any_rule) {
+        cJSON_Delete(rule_ids);
+    } else {
+        cJSON_AddItemToObject(filter, "rule_ids", rule_ids);
+    }
+
+    return filter;
+}
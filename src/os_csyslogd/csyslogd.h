@@ -57,5 +57,6 @@ extern char __shost[512];
 extern char __shost_long[512];
 
 extern SyslogConfig **syslog_config;
+extern int csyslogd_alert_bus;
 
 #endif /* CSYSLOGD_H */
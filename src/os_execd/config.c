@@ -190,6 +190,11 @@ cJSON *getExecdInternalOptions(void) {
 
     cJSON_AddNumberToObject(execd,"request_timeout",req_timeout);
     cJSON_AddNumberToObject(execd,"max_restart_lock",max_restart_lock);
+#ifndef WIN32
+    cJSON_AddNumberToObject(execd,"workers",execd_workers);
+    cJSON_AddNumberToObject(execd,"queue_size",execd_queue_size);
+    cJSON_AddNumberToObject(execd,"resident",execd_resident);
+#endif
 
     cJSON_AddItemToObject(internals,"execd",execd);
     cJSON_AddItemToObject(root,"internal",internals);
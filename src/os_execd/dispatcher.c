@@ -0,0 +1,296 @@
+/* Active response dispatcher
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef WIN32
+
+#include "shared.h"
+#include "../external/cJSON/cJSON.h"
+#include "execd.h"
+#include "active-response/active_responses.h"
+
+/* Active responses that can keep running to serve the next requests */
+static const char *resident_names[] = { "firewall-drop", NULL };
+
+/* Request queued for the workers */
+typedef struct ar_job {
+    char *command;      // Path of the active response
+    int timeout;        // Timeout of the active response
+    time_t time;        // Time of the request
+    cJSON *message;     // Add request, NULL for a delete
+    char *parameters;   // Delete message
+    char *key;          // In-flight key, NULL if not deduplicated
+} ar_job;
+
+struct ar_resident {
+    pthread_mutex_t mutex;  // Held while serving a request
+    const char *name;
+    wfd_t *wfd;             // Running process, NULL if not started
+};
+
+int execd_workers;
+int execd_queue_size;
+int execd_resident;
+
+static w_queue_t *ar_queue;
+static OSHash *ar_inflight;
+static ar_resident *residents;
+
+static struct {
+    unsigned long received;
+    unsigned long deduplicated;
+    unsigned long dropped;
+    unsigned long executed;
+    unsigned long failed;
+    unsigned long resident_started;
+} ar_stats;
+static pthread_mutex_t stats_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/* Prototypes */
+static void *ExecdWorker(void *arg);
+static void ExecdFreeJob(ar_job *job);
+static ar_resident *ExecdGetResident(const char *command);
+
+#define ExecdCount(field) do { w_mutex_lock(&stats_mutex); ar_stats.field++; w_mutex_unlock(&stats_mutex); } while (0)
+
+
+void ExecdPoolInit(void)
+{
+    int i;
+
+    execd_workers = getDefine_Int("execd", "workers", 0, EXECD_MAX_WORKERS);
+    execd_queue_size = getDefine_Int("execd", "queue_size", 16, 65536);
+    execd_resident = getDefine_Int("execd", "resident", 0, 1);
+
+    if (execd_resident) {
+        for (i = 0; resident_names[i]; i++);
+        os_calloc(i, sizeof(ar_resident), residents);
+
+        for (i = 0; resident_names[i]; i++) {
+            w_mutex_init(&residents[i].mutex, NULL);
+            residents[i].name = resident_names[i];
+        }
+    }
+
+    if (!execd_workers) {
+        return;
+    }
+
+    ar_queue = queue_init(execd_queue_size);
+
+    if (ar_inflight = OSHash_Create(), !ar_inflight) {
+        merror_exit(HASH_ERROR);
+    }
+
+    for (i = 0; i < execd_workers; i++) {
+        w_create_thread(ExecdWorker, NULL);
+    }
+
+    mdebug1("Running active responses with %d workers.", execd_workers);
+}
+
+int ExecdPoolEnabled(void)
+{
+    return ar_queue != NULL;
+}
+
+void ExecdDispatch(const char *command, int timeout_value, cJSON *json_root, time_t curr_time)
+{
+    const char *srcip = get_srcip_from_json(json_root);
+    ar_job *job;
+
+    ExecdCount(received);
+
+    os_calloc(1, sizeof(ar_job), job);
+    os_strdup(command, job->command);
+    job->timeout = timeout_value;
+    job->time = curr_time;
+    job->message = json_root;
+
+    /* The same response against the same source is run once at a time */
+    if (srcip) {
+        os_malloc(strlen(command) + strlen(srcip) + 2, job->key);
+        sprintf(job->key, "%s %s", command, srcip);
+
+        if (OSHash_Add_ex(ar_inflight, job->key, job) != 2) {
+            mdebug1("Command '%s' against '%s' is already running. Discarding it.", command, srcip);
+            ExecdCount(deduplicated);
+            os_free(job->key);
+            ExecdFreeJob(job);
+            return;
+        }
+    }
+
+    if (queue_push_ex(ar_queue, job) < 0) {
+        mwarn("Active response queue is full. Discarding command '%s'.", command);
+        ExecdCount(dropped);
+        ExecdFreeJob(job);
+    }
+}
+
+void ExecdDispatchDelete(const char *command, const char *parameters)
+{
+    ar_job *job;
+
+    os_calloc(1, sizeof(ar_job), job);
+    os_strdup(command, job->command);
+    os_strdup(parameters, job->parameters);
+
+    /* A delete is never discarded, or the response would stay forever */
+    if (queue_push_ex(ar_queue, job) < 0) {
+        if (ExecdDelete(job->command, job->parameters) == 0) {
+            ExecdCount(executed);
+        } else {
+            ExecdCount(failed);
+        }
+        ExecdFreeJob(job);
+    }
+}
+
+static void *ExecdWorker(__attribute__((unused)) void *arg)
+{
+    ar_job *job;
+    int result;
+
+    while (1) {
+        job = queue_pop_ex(ar_queue);
+
+        if (job->message) {
+            result = ExecdExecute(job->command, job->timeout, job->message, job->time);
+        } else {
+            result = ExecdDelete(job->command, job->parameters);
+        }
+
+        w_mutex_lock(&stats_mutex);
+        if (result == 0) {
+            ar_stats.executed++;
+        } else {
+            ar_stats.failed++;
+        }
+        w_mutex_unlock(&stats_mutex);
+
+        ExecdFreeJob(job);
+    }
+
+    return NULL;
+}
+
+static void ExecdFreeJob(ar_job *job)
+{
+    if (job->key) {
+        OSHash_Delete_ex(ar_inflight, job->key);
+        os_free(job->key);
+    }
+
+    os_free(job->command);
+    os_free(job->parameters);
+    cJSON_Delete(job->message);
+    os_free(job);
+}
+
+static ar_resident *ExecdGetResident(const char *command)
+{
+    const char *name = basename_ex((char *)command);
+    int i;
+
+    if (!residents) {
+        return NULL;
+    }
+
+    for (i = 0; resident_names[i]; i++) {
+        if (!strcmp(residents[i].name, name)) {
+            return &residents[i];
+        }
+    }
+
+    return NULL;
+}
+
+wfd_t *ExecdOpenAR(char *command, int flags, ar_resident **resident)
+{
+    char *argv[3] = { command, NULL, NULL };
+
+    if (*resident = ExecdGetResident(command), !*resident) {
+        return wpopenv(command, argv, flags);
+    }
+
+    w_mutex_lock(&(*resident)->mutex);
+
+    if (!(*resident)->wfd) {
+        argv[1] = RESIDENT_ARG;
+
+        if ((*resident)->wfd = wpopenv(command, argv, W_BIND_STDIN | W_BIND_STDOUT), !(*resident)->wfd) {
+            w_mutex_unlock(&(*resident)->mutex);
+            return NULL;
+        }
+
+        mdebug1("Started resident active response '%s'.", command);
+        ExecdCount(resident_started);
+    }
+
+    return (*resident)->wfd;
+}
+
+void ExecdCloseAR(wfd_t *wfd, ar_resident *resident, int done)
+{
+    char buffer[OS_SIZE_8192];
+
+    if (!resident) {
+        wpclose(wfd);
+        return;
+    }
+
+    /* Wait until the resident process finishes the request */
+    while (!done && fgets(buffer, sizeof(buffer), wfd->file_out)) {
+        cJSON *json = get_json_from_input(buffer);
+        const char *action = json ? get_command_from_json(json) : NULL;
+
+        done = action && !strcmp(action, DONE_ENTRY);
+        cJSON_Delete(json);
+    }
+
+    /* It exited, a new one will be started by the next request */
+    if (!done) {
+        mdebug1("Resident active response '%s' exited.", resident->name);
+        wpclose(wfd);
+        resident->wfd = NULL;
+    }
+
+    w_mutex_unlock(&resident->mutex);
+}
+
+cJSON *getExecdStats(void)
+{
+    cJSON *root = cJSON_CreateObject();
+    cJSON *stats = cJSON_CreateObject();
+
+    w_mutex_lock(&stats_mutex);
+    cJSON_AddNumberToObject(stats, "received", ar_stats.received);
+    cJSON_AddNumberToObject(stats, "deduplicated", ar_stats.deduplicated);
+    cJSON_AddNumberToObject(stats, "dropped", ar_stats.dropped);
+    cJSON_AddNumberToObject(stats, "executed", ar_stats.executed);
+    cJSON_AddNumberToObject(stats, "failed", ar_stats.failed);
+    cJSON_AddNumberToObject(stats, "resident_started", ar_stats.resident_started);
+    w_mutex_unlock(&stats_mutex);
+
+    cJSON_AddNumberToObject(stats, "workers", execd_workers);
+
+    if (ar_queue) {
+        w_mutex_lock(&ar_queue->mutex);
+        cJSON_AddNumberToObject(stats, "queue_size", execd_queue_size);
+        cJSON_AddNumberToObject(stats, "queue_usage", ar_queue->elements);
+        w_mutex_unlock(&ar_queue->mutex);
+    }
+
+    cJSON_AddItemToObject(root, "execd", stats);
+
+    return root;
+}
+
+#endif /* WIN32 */
@@ -31,12 +31,31 @@ STATIC OSList *timeout_list;
 STATIC OSListNode *timeout_node;
 STATIC OSHash *repeated_hash;
 
+/* Protects the timeout list and the repeated offenders hash from the workers */
+static pthread_mutex_t timeout_mutex = PTHREAD_MUTEX_INITIALIZER;
+
 #ifdef WIN32
 #ifdef WAZUH_UNIT_TESTING
     #include "unit_tests/wrappers/windows/libc/stdio_wrappers.h"
 #endif
 extern w_queue_t * winexec_queue;
 DWORD WINAPI win_exec_main(void * args);
+
+/* Windows runs every active response as a new process */
+typedef void ar_resident;
+
+static wfd_t *ExecdOpenAR(char *command, int flags, ar_resident **resident)
+{
+    char *argv[2] = { command, NULL };
+
+    *resident = NULL;
+    return wpopenv(command, argv, flags);
+}
+
+static void ExecdCloseAR(wfd_t *wfd, __attribute__((unused)) ar_resident *resident, __attribute__((unused)) int done)
+{
+    wpclose(wfd);
+}
 #endif
 
 
@@ -130,6 +149,8 @@ void ExecdTimeoutRun(int *childcount)
 {
     time_t curr_time = time(NULL);
 
+    w_mutex_lock(&timeout_mutex);
+
     /* Check if there is any timed out command to execute */
     timeout_node = OSList_GetFirstNode(timeout_list);
     while (timeout_node) {
@@ -146,14 +167,15 @@ void ExecdTimeoutRun(int *childcount)
                 list_entry->time_to_block
             );
 
-            wfd_t *wfd = wpopenv(list_entry->command[0], list_entry->command, W_BIND_STDIN);
-            if (wfd) {
-                /* Send alert to AR script */
-                fprintf(wfd->file_in, "%s\n", list_entry->parameters);
-                fflush(wfd->file_in);
-                wpclose(wfd);
-            } else {
-                merror(EXEC_CMD_FAIL, strerror(errno), errno);
+#ifndef WIN32
+            if (ExecdPoolEnabled()) {
+                ExecdDispatchDelete(list_entry->command[0], list_entry->parameters);
+            } else
+#endif
+            if (ExecdDelete(list_entry->command[0], list_entry->parameters) == 0) {
+#ifndef WIN32
+                (*childcount)++;
+#endif
             }
 
             /* Delete currently node - already sets the pointer to next */
@@ -162,14 +184,30 @@ void ExecdTimeoutRun(int *childcount)
 
             /* Clear the memory */
             FreeTimeoutEntry(list_entry);
-
-#ifndef WIN32
-            (*childcount)++;
-#endif
         } else {
             timeout_node = OSList_GetNextNode(timeout_list);
         }
     }
+
+    w_mutex_unlock(&timeout_mutex);
+}
+
+int ExecdDelete(char *command, const char *parameters)
+{
+    ar_resident *resident;
+
+    wfd_t *wfd = ExecdOpenAR(command, W_BIND_STDIN, &resident);
+    if (!wfd) {
+        merror(EXEC_CMD_FAIL, strerror(errno), errno);
+        return -1;
+    }
+
+    /* Send alert to AR script */
+    fprintf(wfd->file_in, "%s\n", parameters);
+    fflush(wfd->file_in);
+    ExecdCloseAR(wfd, resident, 0);
+
+    return 0;
 }
 
 #ifdef WIN32
@@ -181,14 +219,10 @@ void ExecdRun(char *exec_msg, int *childcount)
     time_t curr_time;
 
     int timeout_value;
-    int added_before = 0;
 
     cJSON *json_root = NULL;
     char *name = NULL;
     char *cmd[2] = { NULL, NULL };
-    char *cmd_parameters = NULL;
-
-    timeout_data *timeout_entry;
 
     /* Current time */
     curr_time = time(0);
@@ -250,12 +284,39 @@ void ExecdRun(char *exec_msg, int *childcount)
     cJSON_ReplaceItemInObject(json_origin, "module", cJSON_CreateString(ARGV0));
     cJSON *json_parameters = cJSON_GetObjectItem(json_root, "parameters");
     cJSON_AddItemToObject(json_parameters, "program", cJSON_CreateString(cmd[0]));
+
+#ifndef WIN32
+    if (ExecdPoolEnabled()) {
+        /* The dispatcher takes the message */
+        ExecdDispatch(cmd[0], timeout_value, json_root, curr_time);
+        return;
+    }
+#endif
+
+    if (ExecdExecute(cmd[0], timeout_value, json_root, curr_time) == 0) {
+#ifndef WIN32
+        (*childcount)++;
+#endif
+    }
+
+    cJSON_Delete(json_root);
+}
+
+int ExecdExecute(char *command, int timeout_value, cJSON *json_root, time_t curr_time)
+{
+    int added_before = 0;
+    int done = 0;
+    char *cmd_parameters = NULL;
+    ar_resident *resident;
+
+    timeout_data *timeout_entry;
+
     cmd_parameters = cJSON_PrintUnformatted(json_root);
 
     /* Execute command */
-    mdebug1("Executing command '%s %s'", cmd[0], cmd_parameters ? cmd_parameters : "");
+    mdebug1("Executing command '%s %s'", command, cmd_parameters ? cmd_parameters : "");
 
-    wfd_t *wfd = wpopenv(cmd[0], cmd, W_BIND_STDIN | W_BIND_STDOUT);
+    wfd_t *wfd = ExecdOpenAR(command, W_BIND_STDIN | W_BIND_STDOUT, &resident);
     if (wfd) {
         char response[OS_SIZE_8192];
         char rkey[OS_SIZE_4096];
@@ -268,16 +329,15 @@ void ExecdRun(char *exec_msg, int *childcount)
         /* Receive alert keys from AR script to check timeout list */
         if (fgets(response, sizeof(response), wfd->file_out) == NULL) {
             mdebug1("Active response won't be added to timeout list. "
-                    "Message not received with alert keys from script '%s'", cmd[0]);
-            wpclose(wfd);
+                    "Message not received with alert keys from script '%s'", command);
+            ExecdCloseAR(wfd, resident, 0);
             os_free(cmd_parameters);
-            cJSON_Delete(json_root);
-            return;
+            return 0;
         }
 
         /* Set rkey initially with the name of the AR */
         memset(rkey, '\0', OS_SIZE_4096);
-        snprintf(rkey, OS_SIZE_4096 - 1, "%s", basename_ex(cmd[0]));
+        snprintf(rkey, OS_SIZE_4096 - 1, "%s", basename_ex(command));
 
         keys_json = get_json_from_input(response);
         if (keys_json != NULL) {
@@ -289,6 +349,9 @@ void ExecdRun(char *exec_msg, int *childcount)
                     strcat(rkey, keys);
                     os_free(keys);
                 }
+            } else if ((action != NULL) && (strcmp(DONE_ENTRY, action) == 0)) {
+                /* A resident AR finished the request without sending keys */
+                done = 1;
             }
             cJSON_Delete(keys_json);
         }
@@ -297,6 +360,8 @@ void ExecdRun(char *exec_msg, int *childcount)
 
         /* We don't need to add to the list if the timeout_value == 0 */
         if (timeout_value) {
+            w_mutex_lock(&timeout_mutex);
+
             if (repeated_hash != NULL) {
                 char *ntimes = NULL;
 
@@ -364,7 +429,7 @@ void ExecdRun(char *exec_msg, int *childcount)
                 /* Create the timeout entry */
                 os_calloc(1, sizeof(timeout_data), timeout_entry);
                 os_calloc(2, sizeof(char *), timeout_entry->command);
-                os_strdup(cmd[0], timeout_entry->command[0]);
+                os_strdup(command, timeout_entry->command[0]);
                 timeout_entry->command[1] = NULL;
                 timeout_entry->parameters = cJSON_PrintUnformatted(json_root);
                 os_strdup(rkey, timeout_entry->rkey);
@@ -383,6 +448,8 @@ void ExecdRun(char *exec_msg, int *childcount)
                     FreeTimeoutEntry(timeout_entry);
                 }
             }
+
+            w_mutex_unlock(&timeout_mutex);
         }
 
         /* If it wasn't added before, continue execution */
@@ -398,20 +465,20 @@ void ExecdRun(char *exec_msg, int *childcount)
         cmd_parameters = cJSON_PrintUnformatted(json_root);
 
         /* Send continue/abort message to AR script */
-        fprintf(wfd->file_in, "%s\n", cmd_parameters);
-        fflush(wfd->file_in);
-
-        wpclose(wfd);
+        if (!done) {
+            fprintf(wfd->file_in, "%s\n", cmd_parameters);
+            fflush(wfd->file_in);
+        }
 
-#ifndef WIN32
-        (*childcount)++;
-#endif
+        ExecdCloseAR(wfd, resident, done);
     } else {
         merror(EXEC_CMD_FAIL, strerror(errno), errno);
+        os_free(cmd_parameters);
+        return -1;
     }
 
     os_free(cmd_parameters);
-    cJSON_Delete(json_root);
+    return 0;
 }
 
 #ifndef WIN32
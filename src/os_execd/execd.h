@@ -30,11 +30,19 @@
 /* Execd select timeout -- in seconds */
 #define EXECD_TIMEOUT   1
 
+/* Maximum number of active response workers */
+#define EXECD_MAX_WORKERS   32
+
 extern int repeated_offenders_timeout[];
 extern time_t pending_upg;
 extern int is_disabled;
 extern int req_timeout;
 extern int max_restart_lock;
+#ifndef WIN32
+extern int execd_workers;
+extern int execd_queue_size;
+extern int execd_resident;
+#endif
 
 /** Function prototypes **/
 
@@ -63,6 +71,79 @@ void ExecdTimeoutRun(int *childcount);
 void ExecdShutdown(int sig) __attribute__((noreturn));
 #endif
 
+/**
+ * @brief Run an active response and add it to the timeout list
+ * @param command Path of the active response
+ * @param timeout_value Timeout of the active response, 0 to not add it
+ * @param json_root Message of the request, it's modified but not freed
+ * @param curr_time Time of the request
+ * @return 0 if the active response was run, -1 if it couldn't be launched
+ */
+int ExecdExecute(char *command, int timeout_value, cJSON *json_root, time_t curr_time);
+
+/**
+ * @brief Run the delete command of an active response
+ * @param command Path of the active response
+ * @param parameters Delete message
+ * @return 0 if the active response was run, -1 if it couldn't be launched
+ */
+int ExecdDelete(char *command, const char *parameters);
+
+#ifndef WIN32
+/* Running process of a resident active response */
+typedef struct ar_resident ar_resident;
+
+/**
+ * @brief Read the internal options of the dispatcher and start the workers
+ */
+void ExecdPoolInit(void);
+
+/**
+ * @brief Check if the active responses are run by the workers
+ * @return 1 if there are workers, 0 if they're run by the main thread
+ */
+int ExecdPoolEnabled(void);
+
+/**
+ * @brief Queue an active response for the workers
+ * @param command Path of the active response
+ * @param timeout_value Timeout of the active response
+ * @param json_root Message of the request, the dispatcher takes it
+ * @param curr_time Time of the request
+ */
+void ExecdDispatch(const char *command, int timeout_value, cJSON *json_root, time_t curr_time);
+
+/**
+ * @brief Queue the delete command of an active response for the workers
+ * @param command Path of the active response
+ * @param parameters Delete message
+ */
+void ExecdDispatchDelete(const char *command, const char *parameters);
+
+/**
+ * @brief Open an active response, using its resident process if enabled
+ * @param command Path of the active response
+ * @param flags wpopenv() flags for a new process
+ * @param resident Set to the resident process, NULL if it's a new process
+ * @return Process handler, NULL on error
+ */
+wfd_t *ExecdOpenAR(char *command, int flags, ar_resident **resident);
+
+/**
+ * @brief Close an active response opened by ExecdOpenAR()
+ * @param wfd Process handler
+ * @param resident Resident process, NULL if it's a new process
+ * @param done 1 if the resident process already finished the request
+ */
+void ExecdCloseAR(wfd_t *wfd, ar_resident *resident, int done);
+
+/**
+ * @brief Get the statistics of the dispatcher
+ * @return JSON object with the statistics
+ */
+cJSON *getExecdStats(void);
+#endif
+
 size_t wcom_unmerge(const char *file_path, char **output);
 size_t wcom_uncompress(const char * source, const char * target, char ** output);
 size_t wcom_restart(char **output);
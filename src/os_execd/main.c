@@ -165,6 +165,9 @@ int main(int argc, char **argv)
         exit(EXIT_SUCCESS);
     }
 
+    /* Start the active response workers */
+    ExecdPoolInit();
+
     /* Start exec queue */
     if ((m_queue = StartMQ(EXECQUEUE, READ, 0)) < 0) {
         merror_exit(QUEUE_ERROR, EXECQUEUE, strerror(errno));
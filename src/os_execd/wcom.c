@@ -103,6 +103,18 @@ size_t wcom_dispatch(char *command, char ** output) {
     } else if (strcmp(rcv_comm, "check-manager-configuration") == 0) {
         return wcom_check_manager_config(output);
 
+#ifndef WIN32
+    } else if (strcmp(rcv_comm, "getstats") == 0) {
+        cJSON *stats = getExecdStats();
+        char *json_str = cJSON_PrintUnformatted(stats);
+
+        os_strdup("ok ", *output);
+        wm_strcat(output, json_str, ' ');
+        os_free(json_str);
+        cJSON_Delete(stats);
+        return strlen(*output);
+#endif
+
     } else {
         mdebug1("WCOM Unrecognized command '%s'.", rcv_comm);
         os_strdup("err Unrecognized command", *output);
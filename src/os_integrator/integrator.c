@@ -13,6 +13,10 @@
 #include <external/cJSON/cJSON.h>
 #include "os_net/os_net.h"
 
+/* Read the alerts from the analysisd alert bus */
+int integrator_alert_bus;
+
+static cJSON * integrator_alert_filter(IntegratorConfig **integrator_config);
 
 void OS_IntegratorD(IntegratorConfig **integrator_config)
 {
@@ -43,6 +47,12 @@ void OS_IntegratorD(IntegratorConfig **integrator_config)
     /* Initing file queue JSON - to read the alerts */
     jqueue_init(&jfileq);
 
+    if (integrator_alert_bus) {
+        cJSON *filter = integrator_alert_filter(integrator_config);
+        jqueue_subscribe(&jfileq, filter);
+        cJSON_Delete(filter);
+    }
+
     for (tries = 1; tries < 100 && jqueue_open(&jfileq, 1) < 0; tries++) {
         sleep(1);
     }
@@ -491,3 +501,64 @@ void OS_IntegratorD(IntegratorConfig **integrator_config)
         }
     }
 }
+
+/* Filter of the alert bus matching every alert that any integration may send.
+ * The integrations check their own options on each alert received.
+ */
+static cJSON * integrator_alert_filter(IntegratorConfig **integrator_config)
+{
+    cJSON *filter = cJSON_CreateObject();
+    cJSON *groups = cJSON_CreateArray();
+    cJSON *rule_ids = cJSON_CreateArray();
+    unsigned int level = 0;
+    int any_group = 0;
+    int any_rule = 0;
+    int s;
+    int i;
+
+    for (s = 0; integrator_config[s]; s++) {
+        if (s == 0 || integrator_config[s]->level < level) {
+            level = integrator_config[s]->level;
+        }
+
+        if (integrator_config[s]->group) {
+            char *copy;
+            char *group;
+            char *save_ptr = NULL;
+
+            os_strdup(integrator_config[s]->group, copy);
+
+            for (group = strtok_r(copy, ",", &save_ptr); group; group = strtok_r(NULL, ",", &save_ptr)) {
+                cJSON_AddItemToArray(groups, cJSON_CreateString(group));
+            }
+
+            os_free(copy);
+        } else {
+            any_group = 1;
+        }
+
+        if (integrator_config[s]->rule_id) {
+            for (i = 0; integrator_config[s]->rule_id[i]; i++) {
+                cJSON_AddItemToArray(rule_ids, cJSON_CreateNumber(integrator_config[s]->rule_id[i]));
+            }
+        } else {
+            any_rule = 1;
+        }
+    }
+
+    cJSON_AddNumberToObject(filter, "level", level);
+
+    if (any_group) {
+        cJSON_Delete(groups);
+    } else {
+        cJSON_AddItemToObject(filter, "groups", groups);
+    }
+
+    if (any_rule) {
+        cJSON_Delete(rule_ids);
+    } else {
+        cJSON_AddItemToObject(filter, "rule_ids", rule_ids);
+    }
+
+    return filter;
+}
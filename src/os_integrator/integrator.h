@@ -23,6 +23,7 @@ void **OS_ReadIntegratorConf(char *cfgfile, IntegratorConfig ***integrator_confi
 void OS_IntegratorD(IntegratorConfig **integrator_config);
 
 extern IntegratorConfig **integrator_config;
+extern int integrator_alert_bus;
 
 // Read config
 cJSON *getIntegratorConfig(void);
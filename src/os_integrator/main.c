@@ -113,6 +113,9 @@ int main(int argc, char **argv)
         merror_exit(USER_ERROR, user, group, strerror(errno), errno);
     }
 
+    /* Read the alerts from the alert bus of analysisd */
+    integrator_alert_bus = getDefine_Int("analysisd", "alert_bus", 0, 1);
+
     /* Reading configuration */
     if(!OS_ReadIntegratorConf(cfg, &integrator_config) || !integrator_config[0])
     {
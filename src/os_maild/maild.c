@@ -135,6 +135,11 @@ int main(int argc, char **argv)
                                          "strict_checking",
                                          0, 1);
 
+    /* Read the alerts from the alert bus of analysisd */
+    mail.alert_bus = getDefine_Int("analysisd",
+                                   "alert_bus",
+                                   0, 1);
+
     /* Get grouping */
     mail.grouping = getDefine_Int("maild",
                                    "grouping",
@@ -263,6 +268,13 @@ static void OS_Run(MailConfig *mail)
         minfo("Getting alerts in JSON format.");
         jqueue_init(fileq);
 
+        if (mail->alert_bus) {
+            cJSON *filter = cJSON_CreateObject();
+            cJSON_AddBoolToObject(filter, "mail", true);
+            jqueue_subscribe(fileq, filter);
+            cJSON_Delete(filter);
+        }
+
         if (jqueue_open(fileq, 1) < 0) {
             merror("Could not open JSON alerts file.");
         }
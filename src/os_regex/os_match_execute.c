@@ -18,41 +18,64 @@
 
 int _OS_Match(const char *pattern, const char *str, size_t str_len, size_t size)
 {
-    size_t i = 0, j;
-    const char *pt = pattern;
+    return (_os_strcasestr(pattern, size, str, str_len) ? TRUE : FALSE);
+}
 
-    if (str_len < size) {
-        return (FALSE);
+/* Find a pattern in the first str_len bytes of a string, comparing it with the
+ * string in lower case. The candidates are found with memchr, looking for the
+ * first character of the pattern in both cases.
+ * Returns the first occurrence or NULL if it isn't found (or the string ends
+ * in the middle of a partial match).
+ */
+const char *_os_strcasestr(const char *literal, size_t size, const char *str, size_t str_len)
+{
+    const uchar first = (uchar)*literal;
+    const uchar other = (first >= 'a' && first <= 'z') ? (uchar)(first - 'a' + 'A') : first;
+    const char *end;
+    const char *next_first;
+    const char *next_other;
+    size_t j;
+
+    if (size == 0) {
+        return (str);
+    }
+
+    /* The string in lower case never has an upper case letter */
+    if (str_len < size || (first >= 'A' && first <= 'Z')) {
+        return (NULL);
     }
 
-    size = str_len - size;
-
-    /* Look to match the first pattern */
-    do {
-        /* Match */
-        if (charmap[(uchar)str[i]] == *pt) {
-            pt++;
-            j = i + 1;
-
-            while (*pt != '\0') {
-                if (str[j] == '\0') {
-                    return (FALSE);
-                }
-
-                else if (*pt != charmap[(uchar)str[j]]) {
-                    pt = pattern;
-                    goto nnext;
-                }
-                j++;
-                pt++;
+    /* Last position where the pattern fits */
+    end = str + (str_len - size) + 1;
+
+    next_first = memchr(str, first, (size_t)(end - str));
+    next_other = (other != first) ? memchr(str, other, (size_t)(end - str)) : NULL;
+
+    while (next_first || next_other) {
+        const char *candidate;
+
+        if (next_first && (!next_other || next_first < next_other)) {
+            candidate = next_first;
+            next_first = memchr(candidate + 1, first, (size_t)(end - candidate - 1));
+        } else {
+            candidate = next_other;
+            next_other = memchr(candidate + 1, other, (size_t)(end - candidate - 1));
+        }
+
+        for (j = 0; j < size; j++) {
+            if (candidate[j] == '\0') {
+                return (NULL);
+            } else if (literal[j] != charmap[(uchar)candidate[j]]) {
+                break;
             }
-            return (TRUE);
-nnext:
-            continue;
         }
-    } while (++i <= size);
 
-    return (FALSE);
+        if (j == size) {
+            return (candidate);
+        }
+    }
+
+    return (NULL);
 }
 
 int _os_strncmp(const char *pattern, const char *str, __attribute__((unused)) size_t str_len, size_t size)
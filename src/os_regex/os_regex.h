@@ -55,6 +55,7 @@ typedef struct _OSRegex {
     char *raw;
     int *flags;
     char **patterns;
+    size_t *literal_size;
     const char ** *prts_closure;
     pthread_mutex_t mutex;
     bool mutex_initialised;
@@ -45,6 +45,7 @@ int OSRegex_Compile(const char *pattern, OSRegex *reg, int flags)
     /* Initialize OSRegex structure */
     reg->error = 0;
     reg->patterns = NULL;
+    reg->literal_size = NULL;
     reg->flags = NULL;
     reg->d_prts_str = NULL;
     reg->d_sub_strings = NULL;
@@ -178,9 +179,10 @@ int OSRegex_Compile(const char *pattern, OSRegex *reg, int flags)
     count++;
     os_calloc(count + 1, sizeof(char *), reg->patterns);
     os_calloc(count + 1, sizeof(int), reg->flags);
+    os_calloc(count + 1, sizeof(size_t), reg->literal_size);
 
     /* Memory allocation error check */
-    if (!reg->patterns || !reg->flags) {
+    if (!reg->patterns || !reg->flags || !reg->literal_size) {
         reg->error = OS_REGEX_OUTOFMEMORY;
         goto compile_error;
     }
@@ -241,6 +243,15 @@ int OSRegex_Compile(const char *pattern, OSRegex *reg, int flags)
 
             }
 
+            /* Every match goes through the literal that starts the
+             * pattern, so the pattern is skipped if it isn't in the string
+             */
+            while (new_str[reg->literal_size[i]] != '\0' &&
+                   new_str[reg->literal_size[i]] != BACKSLASH &&
+                   !prts(new_str[reg->literal_size[i]])) {
+                reg->literal_size[i]++;
+            }
+
             /* Set the parenthesis closures */
             /* The parenthesis closure if set */
             if (reg->prts_closure) {
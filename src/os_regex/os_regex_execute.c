@@ -18,6 +18,7 @@
 /* Internal prototypes */
 static const char *_OS_Regex(const char *pattern, const char *str, const char **prts_closure,
                              const char **prts_str, int flags) __attribute__((nonnull(1, 2)));
+static int _OS_RegexLiteral(const OSRegex *reg, int i, const char *str, size_t *str_len) __attribute__((nonnull));
 
 
 const char *OSRegex_Execute(const char *str, OSRegex *reg)
@@ -31,6 +32,7 @@ const char *OSRegex_Execute_ex(const char *str, OSRegex *reg, regex_matching *re
     const char ****prts_str;
     regex_dynamic_size *str_sizes;
     const char *ret;
+    size_t str_len = 0;
     int i;
     const bool external_context = (regex_match != NULL) ? true : false;
 
@@ -108,7 +110,8 @@ const char *OSRegex_Execute_ex(const char *str, OSRegex *reg, regex_matching *re
             /* Clean the prts_str */
             memset((void*)(*prts_str)[i], 0, (str_sizes) ? str_sizes->prts_str_size[i] : reg->d_size.prts_str_size[i]);
 
-            if ((ret = _OS_Regex(reg->patterns[i], str, reg->prts_closure[i],
+            if (_OS_RegexLiteral(reg, i, str, &str_len) &&
+                (ret = _OS_Regex(reg->patterns[i], str, reg->prts_closure[i],
                                  (*prts_str)[i], reg->flags[i]))) {
                 j = 0;
 
@@ -157,7 +160,8 @@ const char *OSRegex_Execute_ex(const char *str, OSRegex *reg, regex_matching *re
 
     /* Loop on all sub patterns */
     for (i = 0; reg->patterns[i]; i++) {
-        if ((ret = _OS_Regex(reg->patterns[i], str, NULL, NULL, reg->flags[i]))) {
+        if (_OS_RegexLiteral(reg, i, str, &str_len) &&
+            (ret = _OS_Regex(reg->patterns[i], str, NULL, NULL, reg->flags[i]))) {
             if (!external_context) {
                 w_mutex_unlock((pthread_mutex_t *)&reg->mutex);
             }
@@ -171,6 +175,37 @@ const char *OSRegex_Execute_ex(const char *str, OSRegex *reg, regex_matching *re
     return (NULL);
 }
 
+/* Check whether the string has the literal that starts the pattern i.
+ * str_len is the length of the string, 0 until it's needed.
+ * Returns 1 if it does (or the pattern doesn't start with a literal) and 0 otherwise.
+ */
+static int _OS_RegexLiteral(const OSRegex *reg, int i, const char *str, size_t *str_len)
+{
+    const size_t size = reg->literal_size ? reg->literal_size[i] : 0;
+    size_t j;
+
+    if (size == 0) {
+        return (1);
+    }
+
+    /* With ^ the literal must be at the beginning */
+    if (reg->flags[i] & BEGIN_SET) {
+        for (j = 0; j < size; j++) {
+            if (str[j] == '\0' || reg->patterns[i][j] != charmap[(uchar)str[j]]) {
+                return (0);
+            }
+        }
+
+        return (1);
+    }
+
+    if (*str_len == 0) {
+        *str_len = strlen(str);
+    }
+
+    return (_os_strcasestr(reg->patterns[i], size, str, *str_len) != NULL);
+}
+
 #define PRTS(x) ((prts(*x) && x++) || 1)
 #define ENDOFFILE(x) ( PRTS(x) && (*x == '\0'))
 
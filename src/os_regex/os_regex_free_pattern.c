@@ -33,6 +33,7 @@ void OSRegex_FreePattern(OSRegex *reg)
 
     /* Free the flags */
     os_free(reg->flags);
+    os_free(reg->literal_size);
 
     if (reg->raw) {
         os_free(reg->raw);
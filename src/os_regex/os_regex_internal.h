@@ -17,6 +17,7 @@ int _os_strncmp(const char *pattern, const char *str, size_t str_len, size_t siz
 int _os_strcmp_last(const char *pattern, const char *str, size_t str_len, size_t size) __attribute__((nonnull));
 int _os_strcmp(const char *pattern, const char *str, size_t str_len, size_t size) __attribute__((nonnull));
 int _os_strmatch(const char *pattern, const char *str, size_t str_len, size_t size) __attribute__((nonnull));
+const char *_os_strcasestr(const char *literal, size_t size, const char *str, size_t str_len) __attribute__((nonnull));
 
 #define BACKSLASH   '\\'
 #define ENDSTR      '\0'
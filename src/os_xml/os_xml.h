@@ -51,6 +51,15 @@ typedef struct _OS_XML {
 
 typedef xml_node **XML_NODE;
 
+/* XML file parsed by OS_ReadXMLFiles() */
+typedef struct _OS_XML_FILE {
+    const char *file;           /* File to parse */
+    OS_XML xml;                 /* Parsed file, to be freed with OS_ClearXML() */
+    int result;                 /* Return value of OS_ReadXML() */
+    int error;                  /* errno if the file could not be opened */
+    double time;                /* Time spent parsing the file, in seconds */
+} OS_XML_FILE;
+
 /**
  * @brief Parses a XML file and stores the content in the OS_XML struct.
  *        This legacy method will always fail if the content of a tag is bigger than XML_MAXSIZE.
@@ -103,6 +112,27 @@ int OS_ReadXMLString_Ex(const char *string, OS_XML *_lxml, bool flag_truncate) _
  */
 int ParseXML(OS_XML *_lxml, bool flag_truncate) __attribute__((nonnull));
 
+/**
+ * @brief Parses a XML file like OS_ReadXML() and measures the time spent.
+ *
+ * @param file The file to parse. The result, errno and time are stored in it.
+ * @return int OS_SUCCESS on success, OS_INVALID or -2 (file not found) otherwise.
+ */
+int OS_ReadXMLFile(OS_XML_FILE *file) __attribute__((nonnull));
+
+/**
+ * @brief Parses a list of XML files on a pool of threads.
+ *
+ * The files are independent, every one is parsed into its own OS_XML struct,
+ * so the caller can process them afterwards in the order of the list.
+ *
+ * @param files The files to parse.
+ * @param count Number of files.
+ * @param threads Maximum number of threads, including the calling one.
+ * @return int Number of files that could not be parsed.
+ */
+int OS_ReadXMLFiles(OS_XML_FILE *files, size_t count, unsigned int threads);
+
 /* Clear the XML structure memory */
 void OS_ClearXML(OS_XML *_lxml) __attribute__((nonnull));
 
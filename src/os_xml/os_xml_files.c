@@ -0,0 +1,100 @@
+/* Copyright (C) 2015, Wazuh Inc.
+ * All rights reserved.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation
+ */
+
+/* Parallel parsing of XML files */
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+
+#include "os_xml.h"
+#include "time_op.h"
+
+/* Files pending to be parsed */
+typedef struct _xml_files_queue {
+    OS_XML_FILE *files;
+    size_t count;
+    size_t next;
+    pthread_mutex_t mutex;
+} xml_files_queue;
+
+static void * _ReadXMLFilesThread(void *arg);
+
+
+int OS_ReadXMLFile(OS_XML_FILE *file)
+{
+    struct timespec start;
+    struct timespec end;
+
+    gettime(&start);
+    file->result = OS_ReadXML(file->file, &file->xml);
+    file->error = file->result == -2 ? errno : 0;
+    gettime(&end);
+
+    file->time = time_diff(&start, &end);
+    return file->result;
+}
+
+static void * _ReadXMLFilesThread(void *arg)
+{
+    xml_files_queue *queue = arg;
+    size_t i;
+
+    while (1) {
+        pthread_mutex_lock(&queue->mutex);
+        i = queue->next < queue->count ? queue->next++ : queue->count;
+        pthread_mutex_unlock(&queue->mutex);
+
+        if (i == queue->count) {
+            return NULL;
+        }
+
+        OS_ReadXMLFile(&queue->files[i]);
+    }
+}
+
+int OS_ReadXMLFiles(OS_XML_FILE *files, size_t count, unsigned int threads)
+{
+    xml_files_queue queue = { .files = files, .count = count };
+    pthread_t *workers = NULL;
+    unsigned int started = 0;
+    unsigned int i;
+    size_t j;
+    int failed = 0;
+
+    if (threads > count) {
+        threads = count;
+    }
+
+    pthread_mutex_init(&queue.mutex, NULL);
+
+    /* The calling thread parses files too, so a failure to start
+     * the workers only makes the parsing slower
+     */
+    if (threads > 1 && (workers = calloc(threads - 1, sizeof(pthread_t)), workers)) {
+        while (started < threads - 1 && pthread_create(&workers[started], NULL, _ReadXMLFilesThread, &queue) == 0) {
+            started++;
+        }
+    }
+
+    _ReadXMLFilesThread(&queue);
+
+    for (i = 0; i < started; i++) {
+        pthread_join(workers[i], NULL);
+    }
+
+    free(workers);
+    pthread_mutex_destroy(&queue.mutex);
+
+    for (j = 0; j < count; j++) {
+        failed += files[j].result != 0;
+    }
+
+    return failed;
+}
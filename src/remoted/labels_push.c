@@ -0,0 +1,87 @@
+/* Labels notification for Remoted
+ * Copyright (C) 2015, Wazuh Inc.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include <shared.h>
+#include "os_net/os_net.h"
+#include "remoted.h"
+
+/* Build the labels array in the format returned by wazuh-db:
+ * [{"key":"\"key1\"","value":"value1"},{"key":"#\"key2\"","value":"value2"}] */
+static cJSON * labels_to_json(const char * labels) {
+    cJSON * array = cJSON_CreateArray();
+    char * copy;
+    char * line;
+    char * save_ptr = NULL;
+    char * value;
+
+    if (labels == NULL) {
+        return array;
+    }
+
+    os_strdup(labels, copy);
+
+    for (line = strtok_r(copy, "\n", &save_ptr); line != NULL; line = strtok_r(NULL, "\n", &save_ptr)) {
+        if (value = strchr(line, ':'), value == NULL) {
+            continue;
+        }
+
+        *value++ = '\0';
+
+        cJSON * label = cJSON_CreateObject();
+        cJSON_AddStringToObject(label, "key", line);
+        cJSON_AddStringToObject(label, "value", value);
+        cJSON_AddItemToArray(array, label);
+    }
+
+    os_free(copy);
+    return array;
+}
+
+int rem_push_labels(const char * agent_id, const char * labels) {
+    char response[OS_SIZE_1024];
+    cJSON * request;
+    cJSON * parameters;
+    char * payload;
+    ssize_t length;
+    int sock;
+    int retval = -1;
+
+    request = cJSON_CreateObject();
+    cJSON_AddStringToObject(request, "command", "setlabels");
+    parameters = cJSON_AddObjectToObject(request, "parameters");
+    cJSON_AddStringToObject(parameters, "agent", agent_id);
+    cJSON_AddItemToObject(parameters, "labels", labels_to_json(labels));
+
+    payload = cJSON_PrintUnformatted(request);
+    cJSON_Delete(request);
+
+    if (sock = OS_ConnectUnixDomain(ANLSYS_LOCAL_SOCK, SOCK_STREAM, OS_MAXSTR), sock < 0) {
+        mdebug1("Cannot notify the labels of agent '%s' to analysisd: %s (%d)", agent_id, strerror(errno), errno);
+        os_free(payload);
+        return -1;
+    }
+
+    if (OS_SendSecureTCP(sock, strlen(payload), payload) < 0) {
+        mdebug1("Cannot notify the labels of agent '%s' to analysisd: %s (%d)", agent_id, strerror(errno), errno);
+    } else if (length = OS_RecvSecureTCP(sock, response, sizeof(response) - 1), length <= 0) {
+        mdebug1("No response from analysisd to the labels of agent '%s'", agent_id);
+    } else {
+        response[length] = '\0';
+
+        if (strncmp(response, "{\"error\":0,", 11) == 0) {
+            retval = 0;
+        } else {
+            mdebug1("Analysisd rejected the labels of agent '%s': %s", agent_id, response);
+        }
+    }
+
+    close(sock);
+    os_free(payload);
+    return retval;
+}
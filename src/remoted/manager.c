@@ -15,6 +15,7 @@
 #include "../wazuh_db/helpers/wdb_global_helpers.h"
 #include "../os_net/os_net.h"
 #include "shared_download.h"
+#include "agent_messages_adapter.h"
 #include "../os_crypto/sha256/sha256_op.h"
 #include <pthread.h>
 
@@ -47,6 +48,25 @@ typedef struct group_t {
     bool exists;
 } group_t;
 
+/* Content of a shared file, kept in memory to send it to several agents */
+typedef struct shared_file_t {
+    os_md5 sum;
+    char *data;
+    size_t size;
+    unsigned int refs;
+    time_t last_used;
+} shared_file_t;
+
+/* Digests of a file, valid while its inode, modification time and size don't change */
+typedef struct file_digest_t {
+    ino_t ino;
+    time_t mtime;
+    off_t size;
+    os_md5 md5;         // Empty until computed
+    int binary;         // -1 until checked
+    unsigned int scan;  // Last scan that used the file
+} file_digest_t;
+
 static OSHash *invalid_files;
 
 static const char *IGNORE_LIST[] = { SHAREDCFG_FILENAME, NULL };
@@ -201,6 +221,77 @@ STATIC void copy_directory(const char *src_path, const char *dst_path, char *gro
  */
 STATIC void send_wrong_version_response(const char *agent_id, char *msg, agent_status_code_t status_code, char *version, int *wdb_sock);
 
+/**
+ * @brief Add an agent keepalive to the batch saved by save_keepalives()
+ * @param agent_id ID of the agent
+ */
+STATIC void keepalive_push(int agent_id);
+
+/**
+ * @brief Remove the keepalives of an agent that are waiting to be saved, before its connection status is set
+ *
+ * A batch being sent is waited for, so it doesn't override the new status.
+ * @param agent_id ID of the agent
+ */
+STATIC void keepalive_discard(int agent_id);
+
+/**
+ * @brief Save the keepalives of the batch in Wazuh DB
+ * @param wdb_sock Wazuh-DB socket
+ */
+STATIC void keepalive_flush(int *wdb_sock);
+
+/**
+ * @brief Get the content of a shared file, from the cache if its sum didn't change
+ *
+ * The file is read again when it isn't cached or its sum differs. It's cached only if the content read has the sum.
+ * @param path Path of the file
+ * @param sum Expected MD5 sum of the file
+ * @return Content of the file, to release with shared_file_release(). NULL if the file couldn't be read
+ */
+STATIC shared_file_t *shared_file_get(const char *path, const char *sum);
+
+/**
+ * @brief Release the content of a shared file got from shared_file_get()
+ * @param file Content of the file
+ */
+STATIC void shared_file_release(shared_file_t *file);
+
+/**
+ * @brief Remove the shared files that haven't been sent for a while from the cache
+ * @param now Current time
+ */
+STATIC void shared_file_expire(time_t now);
+
+/**
+ * @brief Get the cached digests of a file, reset if the file changed since they were computed
+ * @param path Path of the file
+ * @param attrib Current attributes of the file
+ * @return Digests of the file. NULL if the cache is disabled
+ */
+STATIC file_digest_t *file_digest_get(const char *path, const struct stat *attrib);
+
+/**
+ * @brief Get the MD5 of a file, reading it only if it changed since the last time
+ * @param path Path of the file
+ * @param output MD5 of the file
+ * @return 0 on success, -1 on error
+ */
+STATIC int file_digest_md5(const char *path, os_md5 output);
+
+/**
+ * @brief Check whether a file is binary, reading it only if it changed since the last time
+ * @param path Path of the file
+ * @param attrib Current attributes of the file
+ * @return Non-zero if the file is binary, 0 otherwise
+ */
+STATIC int file_digest_binary(const char *path, const struct stat *attrib);
+
+/**
+ * @brief Remove the digests of the files that weren't used in the last scan
+ */
+STATIC void file_digest_expire();
+
 /* Groups structures */
 static OSHash *groups;
 static OSHash *multi_groups;
@@ -231,6 +322,29 @@ static int reported_path_size_exceeded = 0;
 /* Hash table for agent data */
 OSHash *agent_data_hash;
 
+/* Content of the shared files sent to the agents, by path */
+static OSHash *shared_files;
+static pthread_mutex_t shared_files_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/* Seconds a shared file stays in the cache since it was last sent */
+#define SHARED_FILE_EXPIRE 600
+
+/* Digests of the group files, by path. Only used by c_files() */
+static rb_tree *file_digests;
+static unsigned int file_digests_scan;
+
+/* Seconds the keepalives are held to save them in a single query, 0 saves each one at once */
+int keepalive_batch_interval = 0;
+
+/* Agents whose keepalive is waiting to be saved */
+static int *keepalive_ids;
+static size_t keepalive_count;
+static size_t keepalive_size;
+static pthread_mutex_t keepalive_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/* Keeps the batches in order with the connection status set for single agents */
+static pthread_mutex_t keepalive_send_mutex = PTHREAD_MUTEX_INITIALIZER;
+
 // Frees data in m_hash table
 void cleaner(void* data) {
     os_free(data);
@@ -262,6 +376,8 @@ void save_controlmsg(const keyentry * key, char *r_msg, size_t msg_length, int *
     const char * version_label = "#\"_wazuh_version\":";
     int is_startup = 0;
     int is_shutdown = 0;
+    int accept_batch = 0;
+    int accept_credit = 0;
     int agent_id = 0;
     int result = 0;
 
@@ -307,6 +423,10 @@ void save_controlmsg(const keyentry * key, char *r_msg, size_t msg_length, int *
                 if (version = cJSON_GetObjectItem(agent_info, "version"), cJSON_IsString(version)) {
                     // Update agent data to keep context of events to forward
                     OSHash_Set_ex(agent_data_hash, key->id, cJSON_Duplicate(agent_info, true));
+                    // The agent can send batches of events
+                    accept_batch = cJSON_IsTrue(cJSON_GetObjectItem(agent_info, "batch"));
+                    // The agent follows the credit of events per second
+                    accept_credit = cJSON_IsTrue(cJSON_GetObjectItem(agent_info, "credit"));
                     if (!logr.allow_higher_versions &&
                         compare_wazuh_versions(__ossec_version, version->valuestring, false) < 0) {
 
@@ -352,8 +472,22 @@ void save_controlmsg(const keyentry * key, char *r_msg, size_t msg_length, int *
     }
 
     if (is_shutdown == 0) {
+        char ack_options[OS_SIZE_64] = "";
+
+        if (!is_startup) {
+            cJSON *agent_data = OSHash_Get_ex_dup(agent_data_hash, key->id, agent_data_hash_duplicator);
+            accept_credit = cJSON_IsTrue(cJSON_GetObjectItem(agent_data, "credit"));
+            cJSON_Delete(agent_data);
+        }
+
+        if (accept_credit) {
+            snprintf(ack_options, sizeof(ack_options), "{%s\"credit\":%d}", accept_batch ? "\"batch\":true," : "", rem_get_credit());
+        } else if (accept_batch) {
+            snprintf(ack_options, sizeof(ack_options), "{\"batch\":true}");
+        }
+
         /* Reply to the agent except on shutdown message*/
-        snprintf(msg_ack, OS_FLSIZE, "%s%s", CONTROL_HEADER, HC_ACK);
+        snprintf(msg_ack, OS_FLSIZE, "%s%s%s", CONTROL_HEADER, HC_ACK, ack_options);
         if (send_msg(key->id, msg_ack, -1) >= 0) {
             rem_inc_send_ack(key->id);
         }
@@ -367,10 +501,14 @@ void save_controlmsg(const keyentry * key, char *r_msg, size_t msg_length, int *
 
         agent_id = atoi(key->id);
 
-        result = wdb_update_agent_keepalive(agent_id, AGENT_CS_ACTIVE, logr.worker_node ? "syncreq" : "synced", wdb_sock);
+        if (keepalive_batch_interval > 0) {
+            keepalive_push(agent_id);
+        } else {
+            result = wdb_update_agent_keepalive(agent_id, AGENT_CS_ACTIVE, logr.worker_node ? "syncreq" : "synced", wdb_sock);
 
-        if (OS_SUCCESS != result) {
-            mwarn("Unable to save last keepalive and set connection status as active for agent: %s", key->id);
+            if (OS_SUCCESS != result) {
+                mwarn("Unable to save last keepalive and set connection status as active for agent: %s", key->id);
+            }
         }
     } else {
         if (!data) {
@@ -390,6 +528,10 @@ void save_controlmsg(const keyentry * key, char *r_msg, size_t msg_length, int *
 
             agent_id = atoi(key->id);
 
+            if (keepalive_batch_interval > 0) {
+                keepalive_discard(agent_id);
+            }
+
             result = wdb_update_agent_keepalive(agent_id, AGENT_CS_PENDING, logr.worker_node ? "syncreq" : "synced", wdb_sock);
 
             if (OS_SUCCESS != result) {
@@ -400,6 +542,10 @@ void save_controlmsg(const keyentry * key, char *r_msg, size_t msg_length, int *
 
             agent_id = atoi(key->id);
 
+            if (keepalive_batch_interval > 0) {
+                keepalive_discard(agent_id);
+            }
+
             result = wdb_update_agent_connection_status(agent_id, AGENT_CS_DISCONNECTED, logr.worker_node ? "syncreq" : "synced", wdb_sock, HC_SHUTDOWN_RECV);
 
             if (OS_SUCCESS != result) {
@@ -528,6 +674,9 @@ void save_controlmsg(const keyentry * key, char *r_msg, size_t msg_length, int *
 
             if (OS_INVALID == result) {
                 mdebug1("Unable to update information in global.db for agent: %s", key->id);
+            } else {
+                // The labels may have changed, analysisd caches them
+                rem_push_labels(key->id, agent_data->labels);
             }
 
             wdb_free_agent_info_data(agent_data);
@@ -745,7 +894,7 @@ STATIC void c_group(const char *group, OSHash **_f_time, os_md5 *_merged_sum, ch
                 }
             }
 
-            if ((OS_MD5_File(merged, md5sum, OS_TEXT) != 0) || (strcmp(md5sum_tmp, md5sum) != 0)) {
+            if ((file_digest_md5(merged, md5sum) != 0) || (strcmp(md5sum_tmp, md5sum) != 0)) {
                 if (disk_storage) {
                     OS_MoveFile(merged_tmp, merged);
                 } else {
@@ -768,7 +917,7 @@ STATIC void c_group(const char *group, OSHash **_f_time, os_md5 *_merged_sum, ch
         }
     }
 
-    if (OS_MD5_File(merged, md5sum, OS_TEXT) == 0) {
+    if (file_digest_md5(merged, md5sum) == 0) {
         snprintf((*_merged_sum), sizeof((*_merged_sum)), "%s", md5sum);
 
         if (stat(merged, &attrib) != 0) {
@@ -847,6 +996,8 @@ STATIC void c_files(bool initial_scan)
 
     w_mutex_lock(&files_mutex);
 
+    file_digests_scan++;
+
     /* Analize groups */
     process_groups();
 
@@ -859,6 +1010,9 @@ STATIC void c_files(bool initial_scan)
     /* Delete residual multigroups */
     process_deleted_multi_groups(initial_scan);
 
+    /* Forget the files that no longer exist */
+    file_digest_expire();
+
     w_mutex_unlock(&files_mutex);
 
     if (!reported_path_size_exceeded) {
@@ -1219,7 +1373,7 @@ STATIC int validate_shared_files(const char *src_path, FILE *finalfp, OSHash **_
                     }
                 }
             } else {
-                if (checkBinaryFile(file)) {
+                if (file_digest_binary(file, &attrib)) {
                     int ret_val;
 
                     os_calloc(1, sizeof(time_t), modify_time);
@@ -1572,6 +1726,203 @@ STATIC int lookfor_agent_group(const char *agent_id, char *msg, char **r_group,
     return OS_INVALID;
 }
 
+STATIC file_digest_t *file_digest_get(const char *path, const struct stat *attrib) {
+    file_digest_t *digest;
+
+    if (!file_digests) {
+        return NULL;
+    }
+
+    if (digest = rbtree_get(file_digests, path), !digest) {
+        os_calloc(1, sizeof(file_digest_t), digest);
+        rbtree_insert(file_digests, path, digest);
+        digest->binary = -1;
+    } else if (digest->ino != attrib->st_ino || digest->mtime != attrib->st_mtime || digest->size != attrib->st_size) {
+        *digest->md5 = '\0';
+        digest->binary = -1;
+    }
+
+    digest->ino = attrib->st_ino;
+    digest->mtime = attrib->st_mtime;
+    digest->size = attrib->st_size;
+    digest->scan = file_digests_scan;
+
+    return digest;
+}
+
+STATIC int file_digest_md5(const char *path, os_md5 output) {
+    file_digest_t *digest;
+    struct stat attrib;
+
+    if (!file_digests || stat(path, &attrib) != 0) {
+        return OS_MD5_File(path, output, OS_TEXT);
+    }
+
+    digest = file_digest_get(path, &attrib);
+
+    if (*digest->md5 == '\0' && OS_MD5_File(path, digest->md5, OS_TEXT) != 0) {
+        *digest->md5 = '\0';
+        return -1;
+    }
+
+    memcpy(output, digest->md5, sizeof(os_md5));
+    return 0;
+}
+
+STATIC int file_digest_binary(const char *path, const struct stat *attrib) {
+    file_digest_t *digest;
+
+    if (digest = file_digest_get(path, attrib), !digest) {
+        return checkBinaryFile(path);
+    }
+
+    if (digest->binary < 0) {
+        digest->binary = checkBinaryFile(path) ? 1 : 0;
+    }
+
+    return digest->binary;
+}
+
+STATIC void file_digest_expire() {
+    char **keys;
+    int i;
+
+    if (!file_digests) {
+        return;
+    }
+
+    keys = rbtree_keys(file_digests);
+
+    for (i = 0; keys[i]; i++) {
+        file_digest_t *digest = rbtree_get(file_digests, keys[i]);
+
+        if (digest->scan != file_digests_scan) {
+            rbtree_delete(file_digests, keys[i]);
+        }
+    }
+
+    free_strarray(keys);
+}
+
+/* Unreference a shared file, the caller must hold shared_files_mutex */
+static void shared_file_unref(shared_file_t *file) {
+    if (--file->refs == 0) {
+        os_free(file->data);
+        os_free(file);
+    }
+}
+
+STATIC shared_file_t *shared_file_get(const char *path, const char *sum) {
+    shared_file_t *file;
+    shared_file_t *cached;
+    struct stat st;
+    FILE *fp;
+
+    w_mutex_lock(&shared_files_mutex);
+
+    if (file = OSHash_Get(shared_files, path), file && strcmp(file->sum, sum) == 0) {
+        file->refs++;
+        file->last_used = time(NULL);
+        w_mutex_unlock(&shared_files_mutex);
+        return file;
+    }
+
+    w_mutex_unlock(&shared_files_mutex);
+
+    fp = wfopen(path, "r");
+    if (!fp) {
+        mdebug1(FOPEN_ERROR, path, errno, strerror(errno));
+        return NULL;
+    }
+
+    if (fstat(fileno(fp), &st) < 0) {
+        merror(FSTAT_ERROR, path, errno, strerror(errno));
+        fclose(fp);
+        return NULL;
+    }
+
+    os_calloc(1, sizeof(shared_file_t), file);
+    os_malloc(st.st_size + 1, file->data);
+    file->size = fread(file->data, 1, st.st_size, fp);
+    file->data[file->size] = '\0';
+    file->refs = 1;
+    file->last_used = time(NULL);
+    fclose(fp);
+
+    OS_MD5_Str(file->data, file->size, file->sum);
+
+    // The file is being rewritten, send it without caching
+    if (strcmp(file->sum, sum) != 0) {
+        mdebug2("The sum of file '%s' doesn't match the group sum, it won't be cached.", path);
+        return file;
+    }
+
+    w_mutex_lock(&shared_files_mutex);
+
+    if (cached = OSHash_Get(shared_files, path), cached && strcmp(cached->sum, sum) == 0) {
+        // Another thread read it meanwhile
+        cached->refs++;
+        cached->last_used = file->last_used;
+        shared_file_unref(file);
+        file = cached;
+    } else {
+        // One reference is held by the cache
+        file->refs++;
+
+        if (cached) {
+            OSHash_Update(shared_files, path, file);
+            shared_file_unref(cached);
+        } else if (OSHash_Add(shared_files, path, file) != 2) {
+            file->refs--;
+        }
+    }
+
+    w_mutex_unlock(&shared_files_mutex);
+
+    return file;
+}
+
+STATIC void shared_file_release(shared_file_t *file) {
+    if (file) {
+        w_mutex_lock(&shared_files_mutex);
+        shared_file_unref(file);
+        w_mutex_unlock(&shared_files_mutex);
+    }
+}
+
+STATIC void shared_file_expire(time_t now) {
+    OSHashNode *node;
+    char **expired = NULL;
+    size_t count = 0;
+    unsigned int i;
+
+    w_mutex_lock(&shared_files_mutex);
+
+    for (node = OSHash_Begin(shared_files, &i); node; node = OSHash_Next(shared_files, &i, node)) {
+        shared_file_t *file = node->data;
+
+        if (now - file->last_used >= SHARED_FILE_EXPIRE) {
+            os_realloc(expired, (count + 1) * sizeof(char *), expired);
+            os_strdup(node->key, expired[count++]);
+        }
+    }
+
+    for (size_t j = 0; j < count; j++) {
+        shared_file_t *file = OSHash_Delete(shared_files, expired[j]);
+
+        if (file) {
+            mdebug2("Removing file '%s' from the shared files cache.", expired[j]);
+            shared_file_unref(file);
+        }
+
+        os_free(expired[j]);
+    }
+
+    w_mutex_unlock(&shared_files_mutex);
+
+    os_free(expired);
+}
+
 /* Send a file to the agent
  * Returns -1 on error
  */
@@ -1579,9 +1930,10 @@ static int send_file_toagent(const char *agent_id, const char *group, const char
 {
     int i = 0;
     size_t n = 0;
+    size_t offset;
     char file[OS_SIZE_1024 + 1];
     char buf[OS_SIZE_1024 + 1];
-    FILE *fp;
+    shared_file_t *content;
     os_sha256 multi_group_hash;
     int protocol = -1; // Agent client net protocol
 
@@ -1593,9 +1945,8 @@ static int send_file_toagent(const char *agent_id, const char *group, const char
         snprintf(file, OS_SIZE_1024, "%s/%s/%s", sharedcfg_dir, group, name);
     }
 
-    fp = wfopen(file, "r");
-    if (!fp) {
-        mdebug1(FOPEN_ERROR, file, errno, strerror(errno));
+    /* The agents of a group get the same content, read once */
+    if (content = shared_file_get(file, sum), !content) {
         return OS_INVALID;
     }
 
@@ -1604,7 +1955,7 @@ static int send_file_toagent(const char *agent_id, const char *group, const char
              CONTROL_HEADER, FILE_UPDATE_HEADER, sum, name);
 
     if (send_msg(agent_id, buf, -1) < 0) {
-        fclose(fp);
+        shared_file_release(content);
         return OS_INVALID;
     } else {
         rem_inc_send_shared(agent_id);
@@ -1616,16 +1967,18 @@ static int send_file_toagent(const char *agent_id, const char *group, const char
     key_unlock();
     if (protocol < 0) {
         merror(AR_NOAGENT_ERROR, agent_id);
-        fclose(fp);
+        shared_file_release(content);
         return OS_INVALID;
     }
 
     /* Send the file contents */
-    while ((n = fread(buf, 1, 900, fp)) > 0) {
+    for (offset = 0; offset < content->size; offset += n) {
+        n = content->size - offset < 900 ? content->size - offset : 900;
+        memcpy(buf, content->data + offset, n);
         buf[n] = '\0';
 
         if (send_msg(agent_id, buf, -1) < 0) {
-            fclose(fp);
+            shared_file_release(content);
             return OS_INVALID;
         } else {
             rem_inc_send_shared(agent_id);
@@ -1641,22 +1994,20 @@ static int send_file_toagent(const char *agent_id, const char *group, const char
         }
     }
 
+    shared_file_release(content);
+
     /* Send the message to close the file */
     snprintf(buf, OS_SIZE_1024, "%s%s", CONTROL_HEADER, FILE_CLOSE_HEADER);
 
     if (send_msg(agent_id, buf, -1) < 0) {
-        fclose(fp);
         return OS_INVALID;
     } else {
         rem_inc_send_shared(agent_id);
     }
 
-    fclose(fp);
-
     return OS_SUCCESS;
 }
 
-/* Wait for new messages to read */
 void *wait_for_msgs(__attribute__((unused)) void *none)
 {
     pending_data_t *data;
@@ -1741,6 +2092,7 @@ void *update_shared_files(__attribute__((unused)) void *none)
             }
 
             c_files(false);
+            shared_file_expire(_ctime);
             _stime = _ctime;
         }
 
@@ -1750,6 +2102,96 @@ void *update_shared_files(__attribute__((unused)) void *none)
     return NULL;
 }
 
+static int keepalive_id_cmp(const void *a, const void *b) {
+    const int id_a = *(const int *)a;
+    const int id_b = *(const int *)b;
+
+    return (id_a > id_b) - (id_a < id_b);
+}
+
+STATIC void keepalive_push(int agent_id) {
+    w_mutex_lock(&keepalive_mutex);
+
+    if (keepalive_count == keepalive_size) {
+        keepalive_size = keepalive_size ? keepalive_size * 2 : OS_SIZE_1024;
+        os_realloc(keepalive_ids, keepalive_size * sizeof(int), keepalive_ids);
+    }
+
+    keepalive_ids[keepalive_count++] = agent_id;
+
+    w_mutex_unlock(&keepalive_mutex);
+}
+
+STATIC void keepalive_discard(int agent_id) {
+    size_t i;
+    size_t j = 0;
+
+    w_mutex_lock(&keepalive_send_mutex);
+    w_mutex_lock(&keepalive_mutex);
+
+    for (i = 0; i < keepalive_count; i++) {
+        if (keepalive_ids[i] != agent_id) {
+            keepalive_ids[j++] = keepalive_ids[i];
+        }
+    }
+
+    keepalive_count = j;
+
+    w_mutex_unlock(&keepalive_mutex);
+    w_mutex_unlock(&keepalive_send_mutex);
+}
+
+STATIC void keepalive_flush(int *wdb_sock) {
+    int *ids;
+    size_t count;
+    size_t unique = 0;
+    size_t i;
+
+    w_mutex_lock(&keepalive_send_mutex);
+
+    // The batch is taken so the handlers don't wait for Wazuh DB
+    w_mutex_lock(&keepalive_mutex);
+    ids = keepalive_ids;
+    count = keepalive_count;
+    keepalive_ids = NULL;
+    keepalive_count = 0;
+    keepalive_size = 0;
+    w_mutex_unlock(&keepalive_mutex);
+
+    if (count > 0) {
+        // An agent may have sent several keepalives during the interval
+        qsort(ids, count, sizeof(int), keepalive_id_cmp);
+
+        for (i = 0; i < count; i++) {
+            if (unique == 0 || ids[unique - 1] != ids[i]) {
+                ids[unique++] = ids[i];
+            }
+        }
+
+        mdebug2("Saving the keepalive of %zu agents.", unique);
+
+        if (OS_SUCCESS != wdb_update_agents_keepalive(ids, unique, AGENT_CS_ACTIVE, logr.worker_node ? "syncreq" : "synced", wdb_sock)) {
+            mwarn("Unable to save last keepalive and set connection status as active for %zu agents.", unique);
+        }
+    }
+
+    w_mutex_unlock(&keepalive_send_mutex);
+    os_free(ids);
+}
+
+/* Save the keepalives of the agents in batches */
+void *save_keepalives(__attribute__((unused)) void *none)
+{
+    int wdb_sock = -1;
+
+    while (1) {
+        sleep(keepalive_batch_interval);
+        keepalive_flush(&wdb_sock);
+    }
+
+    return NULL;
+}
+
 void free_pending_data(pending_data_t *data) {
     if (!data) return;
     os_free(data->message);
@@ -1770,8 +2212,13 @@ void manager_init()
     multi_groups = OSHash_Create();
 
     agent_data_hash = OSHash_Create();
+    shared_files = OSHash_Create();
+
+    file_digests = rbtree_init();
+    rbtree_set_dispose(file_digests, free);
 
     disk_storage = getDefine_Int("remoted", "disk_storage", 0, 1);
+    keepalive_batch_interval = getDefine_Int("remoted", "keepalive_batch_interval", 0, 60);
 
     /* Run initial groups and multigroups scan */
     c_files(true);
@@ -1781,7 +2228,7 @@ void manager_init()
     pending_queue = linked_queue_init();
     pending_data = OSHash_Create();
 
-    if (!m_hash || !invalid_files || !groups || !multi_groups || !pending_data) {
+    if (!m_hash || !invalid_files || !groups || !multi_groups || !pending_data || !shared_files) {
         merror_exit("OSHash_Create() failed");
     }
 
@@ -19,18 +19,36 @@ extern wnotify_t * notify;
 
 static pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
 
+/* Get the buffer of an open connection, NULL if the socket is not open */
+static sockbuffer_t * nb_get(netbuffer_t * buffer, int sock) {
+    return sock >= 0 && sock < buffer->size ? buffer->buffers[sock] : NULL;
+}
+
 void nb_open(netbuffer_t * buffer, int sock, const struct sockaddr_storage * peer_info) {
     w_mutex_lock(&mutex);
 
-    if (sock >= buffer->max_fd) {
-        os_realloc(buffer->buffers, sizeof(sockbuffer_t) * (sock + 1), buffer->buffers);
-        buffer->max_fd = sock;
+    // The table doubles its size, so the mass reconnections cause a few reallocations only
+    if (sock >= buffer->size) {
+        int new_size = buffer->size > 0 ? buffer->size : FD_LIST_INIT_VALUE;
+
+        while (sock >= new_size) {
+            new_size *= 2;
+        }
+
+        os_realloc(buffer->buffers, sizeof(sockbuffer_t *) * new_size, buffer->buffers);
+        memset(buffer->buffers + buffer->size, 0, sizeof(sockbuffer_t *) * (new_size - buffer->size));
+        buffer->size = new_size;
     }
 
-    memset(buffer->buffers + sock, 0, sizeof(sockbuffer_t));
-    memcpy(&buffer->buffers[sock].peer_info, peer_info, sizeof(struct sockaddr_storage));
+    if (buffer->buffers[sock] == NULL) {
+        os_malloc(sizeof(sockbuffer_t), buffer->buffers[sock]);
+    } else {
+        nb_sendq_clear(&buffer->buffers[sock]->sendq);
+        os_free(buffer->buffers[sock]->data);
+    }
 
-    buffer->buffers[sock].bqueue = bqueue_init(send_buffer_size, BQUEUE_SHRINK);
+    memset(buffer->buffers[sock], 0, sizeof(sockbuffer_t));
+    memcpy(&buffer->buffers[sock]->peer_info, peer_info, sizeof(struct sockaddr_storage));
 
     w_mutex_unlock(&mutex);
 }
@@ -39,12 +57,13 @@ void nb_close(netbuffer_t * buffer, int sock) {
 
     w_mutex_lock(&mutex);
 
-    if (buffer->buffers[sock].bqueue) {
-        bqueue_destroy(buffer->buffers[sock].bqueue);
-    }
+    sockbuffer_t * sockbuf = nb_get(buffer, sock);
 
-    os_free(buffer->buffers[sock].data);
-    memset(buffer->buffers + sock, 0, sizeof(sockbuffer_t));
+    if (sockbuf) {
+        nb_sendq_clear(&sockbuf->sendq);
+        os_free(sockbuf->data);
+        os_free(buffer->buffers[sock]);
+    }
 
     w_mutex_unlock(&mutex);
 }
@@ -61,10 +80,19 @@ int nb_recv(netbuffer_t * buffer, int sock) {
     unsigned long i;
     unsigned long cur_offset;
     uint32_t cur_len;
+    rem_msgref_t messages[NB_RECV_BATCH];
+    size_t pending = 0;
 
     w_mutex_lock(&mutex);
 
-    sockbuffer_t * sockbuf = &buffer->buffers[sock];
+    sockbuffer_t * sockbuf = nb_get(buffer, sock);
+
+    if (sockbuf == NULL) {
+        errno = EBADF;
+        recv_len = -1;
+        goto end;
+    }
+
     unsigned long data_ext = sockbuf->data_len + receive_chunk;
 
     // Extend data buffer
@@ -93,6 +121,7 @@ int nb_recv(netbuffer_t * buffer, int sock) {
             char hex[OS_SIZE_2048 + 1] = {0};
             print_hex_string(&sockbuf->data[i], sockbuf->data_len - i, hex, sizeof(hex));
             mwarn("Unexpected message (hex): '%s'", hex);
+            rem_msgpush_batch(messages, pending, sock);
             recv_len = -2;
             goto end;
         }
@@ -103,7 +132,19 @@ int nb_recv(netbuffer_t * buffer, int sock) {
             break;
         }
 
-        rem_msgpush(sockbuf->data + cur_offset, cur_len, &sockbuf->peer_info, sock);
+        messages[pending].buffer = sockbuf->data + cur_offset;
+        messages[pending].size = cur_len;
+        messages[pending].addr = &sockbuf->peer_info;
+
+        if (++pending == NB_RECV_BATCH) {
+            rem_msgpush_batch(messages, pending, sock);
+            pending = 0;
+        }
+    }
+
+    // The messages point to the buffer, so they're queued before moving it
+    if (pending > 0) {
+        rem_msgpush_batch(messages, pending, sock);
     }
 
     // Move remaining data to data start
@@ -152,16 +193,18 @@ int nb_send(netbuffer_t * buffer, int socket) {
 
     w_mutex_lock(&mutex);
 
-    if (buffer->buffers[socket].bqueue) {
+    sockbuffer_t * sockbuf = nb_get(buffer, socket);
+
+    if (sockbuf) {
 
-        ssize_t peeked_bytes = bqueue_peek(buffer->buffers[socket].bqueue, data, send_chunk, BQUEUE_NOFLAG);
+        ssize_t peeked_bytes = nb_sendq_peek(&sockbuf->sendq, data, send_chunk);
         if (peeked_bytes > 0) {
             // Asynchronous sending
             sent_bytes = send(socket, (const void *)data, peeked_bytes, MSG_DONTWAIT);
         }
 
         if (sent_bytes > 0) {
-            bqueue_drop(buffer->buffers[socket].bqueue, sent_bytes);
+            nb_sendq_drop(&sockbuf->sendq, sent_bytes);
         } else if (sent_bytes < 0) {
             switch (errno) {
             case EAGAIN:
@@ -174,7 +217,7 @@ int nb_send(netbuffer_t * buffer, int socket) {
             }
         }
 
-        if (!peeked_bytes || bqueue_used(buffer->buffers[socket].bqueue) == 0) {
+        if (!peeked_bytes || nb_sendq_used(&sockbuf->sendq) == 0) {
             wnotify_modify(notify, socket, WO_READ);
         }
     }
@@ -196,27 +239,32 @@ int nb_queue(netbuffer_t * buffer, int socket, char * crypt_msg, ssize_t msg_siz
 
     w_mutex_lock(&mutex);
 
-    if (buffer->buffers[socket].bqueue) {
+    sockbuffer_t * sockbuf = nb_get(buffer, socket);
 
-        if (!bqueue_push(buffer->buffers[socket].bqueue, (const void *) data, (size_t)(msg_size + header_size), BQUEUE_NOFLAG)) {
+    if (sockbuf) {
 
-            if (bqueue_used(buffer->buffers[socket].bqueue) == (size_t)(msg_size + header_size)) {
+        if (!nb_sendq_push(&sockbuf->sendq, data, (unsigned long)(msg_size + header_size), send_buffer_size)) {
+
+            if (nb_sendq_used(&sockbuf->sendq) == (unsigned long)(msg_size + header_size)) {
                 wnotify_modify(notify, socket, (WO_READ | WO_WRITE));
             }
             retval = 0;
         } else {
-            mdebug1("Not enough buffer space. Retrying... [buffer_size=%lu, used=%lu, msg_size=%lu]",
-                buffer->buffers[socket].bqueue->max_length, buffer->buffers[socket].bqueue->length, msg_size);
+            mdebug1("Not enough buffer space. Retrying... [buffer_size=%u, used=%lu, msg_size=%lu]",
+                send_buffer_size, nb_sendq_used(&sockbuf->sendq), msg_size);
 
             w_mutex_unlock(&mutex);
             sleep(send_timeout_to_retry);
             w_mutex_lock(&mutex);
 
-            if (buffer->buffers[socket].bqueue) {
+            // The connection may have been closed meanwhile
+            sockbuf = nb_get(buffer, socket);
+
+            if (sockbuf) {
 
-                if (!bqueue_push(buffer->buffers[socket].bqueue, (const void *) data, (size_t)(msg_size + header_size), BQUEUE_NOFLAG)) {
+                if (!nb_sendq_push(&sockbuf->sendq, data, (unsigned long)(msg_size + header_size), send_buffer_size)) {
 
-                    if (bqueue_used(buffer->buffers[socket].bqueue) == (size_t)(msg_size + header_size)) {
+                    if (nb_sendq_used(&sockbuf->sendq) == (unsigned long)(msg_size + header_size)) {
                         wnotify_modify(notify, socket, (WO_READ | WO_WRITE));
                     }
                     retval = 0;
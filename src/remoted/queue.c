@@ -24,29 +24,50 @@ void rem_msginit(size_t size) {
 
 // Push message into queue
 int rem_msgpush(const char * buffer, unsigned long size, struct sockaddr_storage * addr, int sock) {
+    rem_msgref_t message = { buffer, size, addr };
+
+    return rem_msgpush_batch(&message, 1, sock) == 1 ? 0 : -1;
+}
+
+// Push several messages into queue
+size_t rem_msgpush_batch(const rem_msgref_t * messages, size_t count, int sock) {
     message_t * message;
-    int result;
+    size_t queued = 0;
+    size_t i;
     static int reported = 0;
 
-    os_malloc(sizeof(message_t), message);
-    os_malloc(size, message->buffer);
-    memcpy(message->buffer, buffer, size);
-    message->size = size;
-    memcpy(&message->addr, addr, sizeof(struct sockaddr_storage));
-    message->sock = sock;
+    if (count == 0) {
+        return 0;
+    }
 
     w_mutex_lock(&mutex);
 
-    message->counter = ++global_counter;
+    for (i = 0; i < count; i++) {
+        os_malloc(sizeof(message_t), message);
+        os_malloc(messages[i].size, message->buffer);
+        memcpy(message->buffer, messages[i].buffer, messages[i].size);
+        message->size = messages[i].size;
+        memcpy(&message->addr, messages[i].addr, sizeof(struct sockaddr_storage));
+        message->sock = sock;
+        message->counter = ++global_counter;
+
+        if (queue_push(queue, message) == 0) {
+            queued++;
+        } else {
+            rem_msgfree(message);
+        }
+    }
 
-    if (result = queue_push(queue, message), result == 0) {
+    // Wake up as many handlers as messages were queued
+    if (queued > 1) {
+        w_cond_broadcast(&available);
+    } else if (queued == 1) {
         w_cond_signal(&available);
     }
 
     w_mutex_unlock(&mutex);
 
-    if (result < 0) {
-        rem_msgfree(message);
+    for (i = queued; i < count; i++) {
         mdebug2("Discarding event from host.");
         rem_inc_recv_discarded();
         if (!reported) {
@@ -55,7 +76,7 @@ int rem_msgpush(const char * buffer, unsigned long size, struct sockaddr_storage
         }
     }
 
-    return result;
+    return queued;
 }
 
 // Get current queue size
@@ -67,6 +88,19 @@ size_t rem_get_qsize() {
     return size;
 }
 
+// Get the share of their events per second that the agents can send
+int rem_get_credit() {
+    size_t size = rem_get_tsize();
+    size_t usage = rem_get_qsize();
+
+    // The agents send at full rate until the queue is half full, then the rate drops to none as it fills up
+    if (usage * 2 <= size) {
+        return 100;
+    }
+
+    return (int)(200 * (size - usage) / size);
+}
+
 // Get total queue size
 size_t rem_get_tsize() {
     static size_t size = 0;
@@ -25,6 +25,10 @@
 #define REMOTED_MSG_HEADER "1:" ARGV0 ":"
 #define AG_STOP_MSG REMOTED_MSG_HEADER OS_AG_STOPPED
 #define MAX_SHARED_PATH 200
+#define REM_UDP_BATCH 32 /* Datagrams received by a single recvmmsg() call */
+#define NB_RECV_BATCH 64 /* TCP messages queued at once */
+#define NB_CHUNK_SIZE 4096 /* Bytes of each chunk of the send queues */
+#define NB_POOL_MAX_FREE 1024 /* Free chunks kept in the pool to be reused */
 
 /* Hash table for agent data */
 extern OSHash *agent_data_hash;
@@ -46,19 +50,41 @@ typedef struct message_t {
     size_t counter;
 } message_t;
 
+/* Message received but not queued yet, the data is copied when queued */
+typedef struct rem_msgref_t {
+    const char * buffer;
+    unsigned long size;
+    struct sockaddr_storage * addr;
+} rem_msgref_t;
+
 /* Network buffer structure */
 
+/* Chunk of a send queue, taken from the pool shared by all the connections */
+typedef struct nb_chunk_t {
+    struct nb_chunk_t * next;
+    unsigned long begin;        /* First byte pending to be sent */
+    unsigned long end;          /* First byte available to write */
+    char data[NB_CHUNK_SIZE];
+} nb_chunk_t;
+
+/* Send queue of a connection, it only holds chunks while there is data pending to be sent */
+typedef struct sendqueue_t {
+    nb_chunk_t * head;
+    nb_chunk_t * tail;
+    unsigned long used;
+} sendqueue_t;
+
 typedef struct sockbuffer_t {
     struct sockaddr_storage peer_info;
     char * data;
     unsigned long data_size;
     unsigned long data_len;
-    bqueue_t * bqueue;
+    sendqueue_t sendq;
 } sockbuffer_t;
 
 typedef struct netbuffer_t {
-    int max_fd;
-    sockbuffer_t * buffers;
+    int size;                   /* Slots of the table */
+    sockbuffer_t ** buffers;    /* Connections indexed by socket, NULL if not open */
 } netbuffer_t;
 
 /** Function prototypes **/
@@ -96,6 +122,9 @@ void *wait_for_msgs(void *none);
 /* Update shared files */
 void *update_shared_files(void *none);
 
+/* Save the keepalives of the agents in batches */
+void *save_keepalives(void *none);
+
 /* Save control messages */
 void save_controlmsg(const keyentry * key, char *msg, size_t msg_length, int *wdb_sock);
 
@@ -131,6 +160,9 @@ void rem_msginit(size_t size);
 // Push message into queue
 int rem_msgpush(const char * buffer, unsigned long size, struct sockaddr_storage * addr, int sock);
 
+// Push several messages from the same socket into queue, taking the lock once. Return the number of messages queued.
+size_t rem_msgpush_batch(const rem_msgref_t * messages, size_t count, int sock);
+
 // Pop message from queue
 message_t * rem_msgpop();
 
@@ -140,6 +172,9 @@ size_t rem_get_qsize();
 // Get total queue size
 size_t rem_get_tsize();
 
+// Get the share of their events per second that the agents can send, in percentage, as the queue fills up
+int rem_get_credit();
+
 // Free message
 void rem_msgfree(message_t * message);
 
@@ -179,6 +214,67 @@ int nb_send(netbuffer_t * buffer, int socket);
  */
 int nb_queue(netbuffer_t * buffer, int socket, char * crypt_msg, ssize_t msg_size, char * agent_id);
 
+/* Send queue */
+
+/**
+ * @brief Append data to a send queue, taking the chunks from the shared pool.
+ *
+ * @param queue send queue.
+ * @param data data to append.
+ * @param length data size.
+ * @param max_length maximum size of the queue.
+ *
+ * @return -1 if the data does not fit into the queue.
+ * @return 0 on success.
+ */
+int nb_sendq_push(sendqueue_t * queue, const char * data, unsigned long length, unsigned long max_length);
+
+/**
+ * @brief Copy the first bytes of a send queue, without removing them.
+ *
+ * @param queue send queue.
+ * @param buffer destination buffer.
+ * @param length destination buffer size.
+ *
+ * @return number of bytes copied.
+ */
+unsigned long nb_sendq_peek(const sendqueue_t * queue, char * buffer, unsigned long length);
+
+/**
+ * @brief Remove the first bytes of a send queue, returning the drained chunks to the pool.
+ *
+ * @param queue send queue.
+ * @param length number of bytes to remove.
+ */
+void nb_sendq_drop(sendqueue_t * queue, unsigned long length);
+
+/**
+ * @brief Get the number of bytes pending to be sent.
+ *
+ * @param queue send queue.
+ *
+ * @return number of bytes in the queue.
+ */
+unsigned long nb_sendq_used(const sendqueue_t * queue);
+
+/**
+ * @brief Remove all the data of a send queue, returning its chunks to the pool.
+ *
+ * @param queue send queue.
+ */
+void nb_sendq_clear(sendqueue_t * queue);
+
+/* Labels notification */
+
+/**
+ * @brief Notify analysisd of the labels of an agent, so its label cache does not wait for a refresh.
+ *
+ * @param agent_id ID of the agent.
+ * @param labels Labels as stored in global.db, one "key:value" per line. NULL if the agent has no labels.
+ * @return 0 on success, -1 if the notification could not be delivered.
+ */
+int rem_push_labels(const char * agent_id, const char * labels);
+
 /* Network counter */
 
 void rem_initList(int initial_size);
@@ -201,6 +297,7 @@ extern int request_timeout;
 extern int response_timeout;
 extern int INTERVAL;
 extern int disk_storage;
+extern int keepalive_batch_interval;
 extern rlim_t nofile;
 extern int guess_agent_group;
 extern unsigned receive_chunk;
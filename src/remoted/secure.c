@@ -8,6 +8,11 @@
  * Foundation
  */
 
+// recvmmsg() is a GNU extension
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
 #include "shared.h"
 #include "../os_net/os_net.h"
 #include "remoted.h"
@@ -50,7 +55,7 @@ ROUTER_PROVIDER_HANDLE router_rsync_handle = NULL;
 ROUTER_PROVIDER_HANDLE router_syscollector_handle = NULL;
 STATIC void handle_outgoing_data_to_tcp_socket(int sock_client);
 STATIC void handle_incoming_data_from_tcp_socket(int sock_client);
-STATIC void handle_incoming_data_from_udp_socket(struct sockaddr_storage * peer_info);
+STATIC void handle_incoming_data_from_udp_socket();
 STATIC void handle_new_tcp_connection(wnotify_t * notify, struct sockaddr_storage * peer_info);
 
 // Headers for syscollector messages: DBSYNC_MQ + WM_SYS_LOCATION and SYSCOLLECTOR_MQ + WM_SYS_LOCATION
@@ -71,6 +76,12 @@ void * rem_keyupdate_main(__attribute__((unused)) void * args);
 /* Handle each message received */
 STATIC void HandleSecureMessage(const message_t *message, int *wdb_sock);
 
+/* Send an event to analysisd and the router */
+STATIC void forward_event(char *msg, const char *srcmsg, const char *agent_id, const char *agent_ip, const char *agent_name);
+
+/* Send each event of a batch, returns the number of events */
+STATIC unsigned int forward_event_batch(char *batch, size_t length, const char *srcmsg, const char *agent_id, const char *agent_ip, const char *agent_name);
+
 // Close and remove socket from keystore
 int _close_sock(keystore * keys, int sock);
 
@@ -146,6 +157,11 @@ void HandleSecure()
     /* Create shared file updating thread */
     w_create_thread(update_shared_files, NULL);
 
+    /* Create keepalive saving thread */
+    if (keepalive_batch_interval > 0) {
+        w_create_thread(save_keepalives, NULL);
+    }
+
     /* Create Active Response forwarder thread */
     w_create_thread(AR_Forward, NULL);
 
@@ -278,7 +294,7 @@ void HandleSecure()
             }
             // If a new UDP connection was received and UDP is enabled
             else if ((fd == logr.udp_sock) && (protocol & REMOTED_NET_PROTOCOL_UDP)) {
-                handle_incoming_data_from_udp_socket(&peer_info);
+                handle_incoming_data_from_udp_socket();
             }
             // If a message was received through a TCP client and tcp is enabled
             else if ((protocol & REMOTED_NET_PROTOCOL_TCP) && (event & WE_READ)) {
@@ -321,16 +337,49 @@ STATIC void handle_new_tcp_connection(wnotify_t * notify, struct sockaddr_storag
     }
 }
 
-STATIC void handle_incoming_data_from_udp_socket(struct sockaddr_storage * peer_info)
+STATIC void handle_incoming_data_from_udp_socket()
 {
-    char buffer[OS_MAXSTR + 1];
-    memset(buffer, '\0', OS_MAXSTR + 1);
+    // Only the main thread receives from the UDP socket, so the buffers are allocated once
+    static char (*buffers)[OS_MAXSTR + 1] = NULL;
+    static struct sockaddr_storage peers[REM_UDP_BATCH];
+    struct mmsghdr msgs[REM_UDP_BATCH];
+    struct iovec iovecs[REM_UDP_BATCH];
+    rem_msgref_t messages[REM_UDP_BATCH];
+    unsigned long recv_b = 0;
+    size_t pending = 0;
+    int count;
+
+    if (!buffers) {
+        os_malloc(REM_UDP_BATCH * sizeof(*buffers), buffers);
+    }
 
-    int recv_b = recvfrom(logr.udp_sock, buffer, OS_MAXSTR, 0, (struct sockaddr *) peer_info, &logr.peer_size);
+    memset(msgs, 0, sizeof(msgs));
 
-    if (recv_b > 0) {
-        rem_msgpush(buffer, recv_b, peer_info, USING_UDP_NO_CLIENT_SOCKET);
-        rem_add_recv((unsigned long) recv_b);
+    for (int i = 0; i < REM_UDP_BATCH; i++) {
+        iovecs[i].iov_base = buffers[i];
+        iovecs[i].iov_len = OS_MAXSTR;
+        msgs[i].msg_hdr.msg_iov = &iovecs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+        msgs[i].msg_hdr.msg_name = &peers[i];
+        msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_storage);
+    }
+
+    // Take the datagrams already received without waiting for more
+    count = recvmmsg(logr.udp_sock, msgs, REM_UDP_BATCH, MSG_DONTWAIT, NULL);
+
+    for (int i = 0; i < count; i++) {
+        if (msgs[i].msg_len > 0) {
+            messages[pending].buffer = buffers[i];
+            messages[pending].size = msgs[i].msg_len;
+            messages[pending].addr = &peers[i];
+            recv_b += msgs[i].msg_len;
+            pending++;
+        }
+    }
+
+    if (pending > 0) {
+        rem_msgpush_batch(messages, pending, USING_UDP_NO_CLIENT_SOCKET);
+        rem_add_recv(recv_b);
     }
 }
 
@@ -795,10 +844,22 @@ STATIC void HandleSecureMessage(const message_t *message, int *wdb_sock) {
         _close_sock(&keys, sock_idle);
     }
 
+    if (strncmp(tmp_msg, EVENT_BATCH_HEADER, strlen(EVENT_BATCH_HEADER)) == 0) {
+        forward_event_batch(tmp_msg + strlen(EVENT_BATCH_HEADER), msg_length - strlen(EVENT_BATCH_HEADER), srcmsg, agentid_str, agent_ip, agent_name);
+    } else {
+        forward_event(tmp_msg, srcmsg, agentid_str, agent_ip, agent_name);
+    }
+
+    os_free(agentid_str);
+    os_free(agent_ip);
+    os_free(agent_name);
+}
+
+STATIC void forward_event(char *msg, const char *srcmsg, const char *agent_id, const char *agent_ip, const char *agent_name) {
     /* If we can't send the message, try to connect to the
      * socket again. If it not exit.
      */
-    if (SendMSG(logr.m_queue, tmp_msg, srcmsg, SECURE_MQ) < 0) {
+    if (SendMSG(logr.m_queue, msg, srcmsg, SECURE_MQ) < 0) {
         merror(QUEUE_ERROR, DEFAULTQUEUE, strerror(errno));
 
         // Try to reconnect infinitely
@@ -806,22 +867,50 @@ STATIC void HandleSecureMessage(const message_t *message, int *wdb_sock) {
 
         minfo("Successfully reconnected to '%s'", DEFAULTQUEUE);
 
-        if (SendMSG(logr.m_queue, tmp_msg, srcmsg, SECURE_MQ) < 0) {
+        if (SendMSG(logr.m_queue, msg, srcmsg, SECURE_MQ) < 0) {
             // Something went wrong sending a message after an immediate reconnection...
             merror(QUEUE_ERROR, DEFAULTQUEUE, strerror(errno));
         } else {
-            rem_inc_recv_evt(agentid_str);
+            rem_inc_recv_evt(agent_id);
         }
     } else {
-        rem_inc_recv_evt(agentid_str);
+        rem_inc_recv_evt(agent_id);
     }
 
     // Forwarding events to subscribers
-    router_message_forward(tmp_msg, agentid_str, agent_ip, agent_name);
+    router_message_forward(msg, agent_id, agent_ip, agent_name);
+}
 
-    os_free(agentid_str);
-    os_free(agent_ip);
-    os_free(agent_name);
+STATIC unsigned int forward_event_batch(char *batch, size_t length, const char *srcmsg, const char *agent_id, const char *agent_ip, const char *agent_name) {
+    unsigned int count = 0;
+    char *end = batch + length;
+    char *event;
+    char *next;
+    char saved;
+    unsigned long event_length;
+
+    while (batch < end) {
+        event_length = strtoul(batch, &event, 10);
+
+        if (event == batch || *event != ':' || event_length == 0 || event_length > (unsigned long)(end - event - 1)) {
+            mwarn("Invalid batch of events from agent ID '%s'.", agent_id);
+            break;
+        }
+
+        // Each event is terminated in place while it's sent
+        event++;
+        next = event + event_length;
+        saved = *next;
+        *next = '\0';
+
+        forward_event(event, srcmsg, agent_id, agent_ip, agent_name);
+
+        *next = saved;
+        batch = next;
+        count++;
+    }
+
+    return count;
 }
 
 void router_message_forward(char* msg, const char* agent_id, const char* agent_ip, const char* agent_name) {
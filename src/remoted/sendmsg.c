@@ -42,15 +42,24 @@ void key_unlock()
 /* Check for key updates */
 int check_keyupdate()
 {
+    keystore *new_keys;
+
     /* Check key for updates */
     if (!OS_CheckUpdateKeys(&keys)) {
         return (0);
     }
 
     minfo(ENCFILE_CHANGED);
+
+    /* The keys are read before locking, so the handlers only wait for the swap */
+    mdebug1("Reloading keys");
+    new_keys = OS_ReadUpdatedKeys(&keys);
+
     key_lock_write();
-    OS_UpdateKeys(&keys);
+    OS_SwapKeys(&keys, new_keys);
     key_unlock();
+
+    mdebug1("Key reloading completed");
     return 1;
 }
 
@@ -0,0 +1,142 @@
+/* Send queue library for Remoted
+ * Copyright (C) 2015, Wazuh Inc.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include <shared.h>
+#include "remoted.h"
+
+/* Fixed-size chunks shared by the send queues of all the connections.
+ * The idle connections hold no chunks, and only a bounded number of free
+ * chunks is kept, so the memory follows the data pending to be sent. */
+static struct {
+    nb_chunk_t * free;
+    unsigned long free_count;
+} pool;
+
+static pthread_mutex_t pool_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static nb_chunk_t * chunk_take(void) {
+    nb_chunk_t * chunk;
+
+    w_mutex_lock(&pool_mutex);
+    chunk = pool.free;
+
+    if (chunk != NULL) {
+        pool.free = chunk->next;
+        pool.free_count--;
+    }
+
+    w_mutex_unlock(&pool_mutex);
+
+    if (chunk == NULL) {
+        os_malloc(sizeof(nb_chunk_t), chunk);
+    }
+
+    chunk->next = NULL;
+    chunk->begin = chunk->end = 0;
+    return chunk;
+}
+
+static void chunk_release(nb_chunk_t * chunk) {
+    w_mutex_lock(&pool_mutex);
+
+    if (pool.free_count < NB_POOL_MAX_FREE) {
+        chunk->next = pool.free;
+        pool.free = chunk;
+        pool.free_count++;
+        chunk = NULL;
+    }
+
+    w_mutex_unlock(&pool_mutex);
+
+    os_free(chunk);
+}
+
+int nb_sendq_push(sendqueue_t * queue, const char * data, unsigned long length, unsigned long max_length) {
+    if (length + queue->used >= max_length) {
+        return -1;
+    }
+
+    while (length > 0) {
+        if (queue->tail == NULL || queue->tail->end == NB_CHUNK_SIZE) {
+            nb_chunk_t * chunk = chunk_take();
+
+            if (queue->tail == NULL) {
+                queue->head = chunk;
+            } else {
+                queue->tail->next = chunk;
+            }
+
+            queue->tail = chunk;
+        }
+
+        unsigned long copy_len = NB_CHUNK_SIZE - queue->tail->end;
+
+        if (copy_len > length) {
+            copy_len = length;
+        }
+
+        memcpy(queue->tail->data + queue->tail->end, data, copy_len);
+        queue->tail->end += copy_len;
+        queue->used += copy_len;
+        data += copy_len;
+        length -= copy_len;
+    }
+
+    return 0;
+}
+
+unsigned long nb_sendq_peek(const sendqueue_t * queue, char * buffer, unsigned long length) {
+    unsigned long copied = 0;
+
+    for (const nb_chunk_t * chunk = queue->head; chunk != NULL && copied < length; chunk = chunk->next) {
+        unsigned long copy_len = chunk->end - chunk->begin;
+
+        if (copy_len > length - copied) {
+            copy_len = length - copied;
+        }
+
+        memcpy(buffer + copied, chunk->data + chunk->begin, copy_len);
+        copied += copy_len;
+    }
+
+    return copied;
+}
+
+void nb_sendq_drop(sendqueue_t * queue, unsigned long length) {
+    while (length > 0 && queue->head != NULL) {
+        nb_chunk_t * chunk = queue->head;
+        unsigned long drop_len = chunk->end - chunk->begin;
+
+        if (drop_len > length) {
+            drop_len = length;
+        }
+
+        chunk->begin += drop_len;
+        queue->used -= drop_len;
+        length -= drop_len;
+
+        if (chunk->begin == chunk->end) {
+            queue->head = chunk->next;
+
+            if (queue->head == NULL) {
+                queue->tail = NULL;
+            }
+
+            chunk_release(chunk);
+        }
+    }
+}
+
+unsigned long nb_sendq_used(const sendqueue_t * queue) {
+    return queue->used;
+}
+
+void nb_sendq_clear(sendqueue_t * queue) {
+    nb_sendq_drop(queue, queue->used);
+}
@@ -13,13 +13,147 @@
 #include "rootcheck.h"
 
 /* Prototypes */
+static void report_dev_file(const char *file_name);
+static void report_dev_result(void);
+static int is_ignored_dev(const char *name, size_t len);
+static const char *dev_relative_path(const char *file_name);
 static int read_dev_file(const char *file_name);
 static int read_dev_dir(const char *dir_name);
+static void dev_visitor_start(const char *basedir);
+static void dev_visitor_dir(const char *dir_name);
+static void dev_visitor_entry(const char *file_name, const struct stat *statbuf);
+static void dev_visitor_pruned(const char *dir_name);
+static void dev_visitor_end(void);
 
 /* Global variables */
 static int _dev_errors;
 static int _dev_total;
+static int _dev_visited;
+static char _dev_root[PATH_MAX + 1];
 
+/* When will these people learn that /dev is not
+ * meant to store log files or other kind of texts?
+ */
+static const char *(ignore_dev[]) = {"MAKEDEV", "README.MAKEDEV",
+                                     "MAKEDEV.README", ".udevdb",
+                                     ".udev.tdb", ".initramfs-tools",
+                                     "MAKEDEV.local", ".udev", ".initramfs",
+                                     "oprofile", "fd", "cgroup",
+#ifdef SOLARIS
+                                     ".devfsadm_dev.lock",
+                                     ".devlink_db_lock",
+                                     ".devlink_db",
+                                     ".devfsadm_daemon.lock",
+                                     ".devfsadm_deamon.lock",
+                                     ".devfsadm_synch_door",
+                                     ".zone_reg_door",
+#endif
+                                     NULL
+                                    };
+
+/* Full path ignore */
+static const char *(ignore_dev_full_path[]) = {"shm/sysconfig",
+                                               "bus/usb/.usbfs",
+                                               "shm",
+                                               "gpmctl",
+                                               NULL
+                                              };
+
+const rk_sys_visitor rk_dev_visitor = {
+    .start = dev_visitor_start,
+    .dir = dev_visitor_dir,
+    .entry = dev_visitor_entry,
+    .pruned = dev_visitor_pruned,
+    .end = dev_visitor_end,
+};
+
+
+static void report_dev_file(const char *file_name)
+{
+    char op_msg[OS_SIZE_1024 + 1];
+    const char op_msg_fmt[] = "File '%*s' present on /dev. Possible hidden file.";
+
+    const int size = snprintf(NULL, 0, op_msg_fmt, (int)strlen(file_name), file_name);
+
+    if (size >= 0) {
+        if ((size_t)size < sizeof(op_msg)) {
+            snprintf(op_msg, sizeof(op_msg), op_msg_fmt, (int)strlen(file_name), file_name);
+        } else {
+            const unsigned int surplus = size - sizeof(op_msg) + 1;
+            snprintf(op_msg, sizeof(op_msg), op_msg_fmt, (int)(strlen(file_name) - surplus), file_name);
+        }
+
+        notify_rk(ALERT_SYSTEM_CRIT, op_msg);
+    } else {
+        mtdebug2(ARGV0, "Error %d (%s) with snprintf with file %s\n", errno, strerror(errno), file_name);
+    }
+    _dev_errors++;
+}
+
+static void report_dev_result()
+{
+    if (_dev_errors == 0) {
+        char op_msg[OS_SIZE_1024 + 1];
+        snprintf(op_msg, OS_SIZE_1024, "No problem detected on the /dev "
+                 "directory. Analyzed %d files",
+                 _dev_total);
+        notify_rk(ALERT_OK, op_msg);
+    }
+}
+
+/* Check if an entry name is ignored. The full path entries are relative to
+ * the directory being read, so only the ones with a single component match.
+ */
+static int is_ignored_dev(const char *name, size_t len)
+{
+    int i;
+
+    for (i = 0; ignore_dev[i] != NULL; i++) {
+        if (strlen(ignore_dev[i]) == len && strncmp(ignore_dev[i], name, len) == 0) {
+            return (1);
+        }
+    }
+
+    for (i = 0; ignore_dev_full_path[i] != NULL; i++) {
+        if (strlen(ignore_dev_full_path[i]) == len && strncmp(ignore_dev_full_path[i], name, len) == 0) {
+            return (1);
+        }
+    }
+
+    return (0);
+}
+
+/* Get the path of a file relative to the /dev directory. Return NULL if the
+ * file is not inside it or it's below an ignored directory, that the
+ * standalone check never reads.
+ */
+static const char *dev_relative_path(const char *file_name)
+{
+    size_t root_len = strlen(_dev_root);
+    const char *rel_path;
+    const char *component;
+    const char *sep;
+
+    if (strncmp(file_name, _dev_root, root_len) != 0) {
+        return (NULL);
+    }
+
+    if (file_name[root_len] == '\0') {
+        return (file_name + root_len);
+    } else if (file_name[root_len] != '/') {
+        return (NULL);
+    }
+
+    rel_path = file_name + root_len + 1;
+
+    for (component = rel_path; (sep = strchr(component, '/')) != NULL; component = sep + 1) {
+        if (is_ignored_dev(component, (size_t)(sep - component))) {
+            return (NULL);
+        }
+    }
+
+    return (rel_path);
+}
 
 static int read_dev_file(const char *file_name)
 {
@@ -36,24 +170,7 @@ static int read_dev_file(const char *file_name)
     }
 
     else if (S_ISREG(statbuf.st_mode)) {
-        char op_msg[OS_SIZE_1024 + 1];
-        const char op_msg_fmt[] = "File '%*s' present on /dev. Possible hidden file.";
-
-        const int size = snprintf(NULL, 0, op_msg_fmt, (int)strlen(file_name), file_name);
-
-        if (size >= 0) {
-            if ((size_t)size < sizeof(op_msg)) {
-                snprintf(op_msg, sizeof(op_msg), op_msg_fmt, (int)strlen(file_name), file_name);
-            } else {
-                const unsigned int surplus = size - sizeof(op_msg) + 1;
-                snprintf(op_msg, sizeof(op_msg), op_msg_fmt, (int)(strlen(file_name) - surplus), file_name);
-            }
-
-            notify_rk(ALERT_SYSTEM_CRIT, op_msg);
-        } else {
-            mtdebug2(ARGV0, "Error %d (%s) with snprintf with file %s\n", errno, strerror(errno), file_name);
-        }
-        _dev_errors++;
+        report_dev_file(file_name);
     }
 
     return (0);
@@ -67,34 +184,6 @@ static int read_dev_dir(const char *dir_name)
     char f_name[PATH_MAX + 2];
     char f_dir[PATH_MAX + 2];
 
-    /* When will these people learn that /dev is not
-     * meant to store log files or other kind of texts?
-     */
-    const char *(ignore_dev[]) = {"MAKEDEV", "README.MAKEDEV",
-                                  "MAKEDEV.README", ".udevdb",
-                                  ".udev.tdb", ".initramfs-tools",
-                                  "MAKEDEV.local", ".udev", ".initramfs",
-                                  "oprofile", "fd", "cgroup",
-#ifdef SOLARIS
-                                  ".devfsadm_dev.lock",
-                                  ".devlink_db_lock",
-                                  ".devlink_db",
-                                  ".devfsadm_daemon.lock",
-                                  ".devfsadm_deamon.lock",
-                                  ".devfsadm_synch_door",
-                                  ".zone_reg_door",
-#endif
-                                  NULL
-                                 };
-
-    /* Full path ignore */
-    const char *(ignore_dev_full_path[]) = {"shm/sysconfig",
-                                            "bus/usb/.usbfs",
-                                            "shm",
-                                            "gpmctl",
-                                            NULL
-                                           };
-
     if (dir_name == NULL || strlen(dir_name) > PATH_MAX) {
         mterror(ARGV0, "Invalid directory given.");
         return (-1);
@@ -155,23 +244,90 @@ static int read_dev_dir(const char *dir_name)
     return (0);
 }
 
-void check_rc_dev(const char *basedir)
+/* The walk of check_rc_sys reads /dev too, so the entries found there are
+ * checked as they show up, and only the directories it skips are read again.
+ */
+static void dev_visitor_start(const char *basedir)
+{
+    _dev_total = 0, _dev_errors = 0, _dev_visited = 0;
+    mtdebug1(ARGV0, "Starting on check_rc_dev");
+
+    snprintf(_dev_root, sizeof(_dev_root), "%s/dev", basedir);
+}
+
+static void dev_visitor_dir(const char *dir_name)
 {
-    char file_path[OS_SIZE_1024 + 1];
+    if (strcmp(dir_name, _dev_root) == 0) {
+        _dev_visited = 1;
+    }
+}
+
+static void dev_visitor_entry(const char *file_name, const struct stat *statbuf)
+{
+    const char *rel_path = dev_relative_path(file_name);
+    const char *name;
+
+    if (rel_path == NULL || *rel_path == '\0') {
+        return;
+    }
 
+    _dev_total++;
+
+    name = strrchr(rel_path, '/');
+    name = name ? name + 1 : rel_path;
+
+    /* Do not look for the ignored files and the user ignored paths */
+    if (is_ignored_dev(name, strlen(name)) || check_ignore(file_name)) {
+        return;
+    }
+
+    if (statbuf && S_ISREG(statbuf->st_mode)) {
+        report_dev_file(file_name);
+    }
+}
+
+static void dev_visitor_pruned(const char *dir_name)
+{
+    const char *rel_path = dev_relative_path(dir_name);
+    const char *name;
+
+    if (rel_path == NULL) {
+        return;
+    }
+
+    if (*rel_path == '\0') {
+        _dev_visited = 1;
+    } else {
+        name = strrchr(rel_path, '/');
+        name = name ? name + 1 : rel_path;
+
+        if (is_ignored_dev(name, strlen(name))) {
+            return;
+        }
+    }
+
+    read_dev_dir(dir_name);
+}
+
+static void dev_visitor_end()
+{
+    /* The walk did not reach /dev at all */
+    if (!_dev_visited) {
+        read_dev_dir(_dev_root);
+    }
+
+    report_dev_result();
+}
+
+void check_rc_dev(const char *basedir)
+{
     _dev_total = 0, _dev_errors = 0;
     mtdebug1(ARGV0, "Starting on check_rc_dev");
 
-    snprintf(file_path, OS_SIZE_1024, "%s/dev", basedir);
+    snprintf(_dev_root, sizeof(_dev_root), "%s/dev", basedir);
 
-    read_dev_dir(file_path);
-    if (_dev_errors == 0) {
-        char op_msg[OS_SIZE_1024 + 1];
-        snprintf(op_msg, OS_SIZE_1024, "No problem detected on the /dev "
-                 "directory. Analyzed %d files",
-                 _dev_total);
-        notify_rk(ALERT_OK, op_msg);
-    }
+    read_dev_dir(_dev_root);
+    report_dev_result();
 
     return;
 }
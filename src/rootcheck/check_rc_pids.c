@@ -12,11 +12,22 @@
 #include "shared.h"
 #include "rootcheck.h"
 
+/* State of the scan, shared by the probe threads */
+typedef struct pids_scan {
+    pthread_mutex_t mutex;
+    const char *ps;
+    pid_t my_pid;
+    int errors;
+    int total;
+    int excessive;
+} pids_scan;
+
 /* Prototypes */
 static int  proc_read(int pid);
 static int  proc_opendir(int pid);
 static int  proc_stat(int pid);
-static void loop_all_pids(const char *ps, pid_t max_pid, int *_errors, int *_total);
+static void pid_hidden(pids_scan *scan, const char *msg);
+static int  probe_pid(int value, void *arg);
 
 /* Global variables */
 static int noproc;
@@ -82,9 +93,20 @@ static int proc_stat(int pid)
     return (0);
 }
 
-/* Check all the available PIDs for hidden stuff */
-static void loop_all_pids(const char *ps, pid_t max_pid, int *_errors, int *_total)
+/* Report a hidden process */
+static void pid_hidden(pids_scan *scan, const char *msg)
+{
+    notify_rk(ALERT_ROOTKIT_FOUND, msg);
+
+    w_mutex_lock(&scan->mutex);
+    scan->errors++;
+    w_mutex_unlock(&scan->mutex);
+}
+
+/* Check a PID for hidden stuff */
+static int probe_pid(int value, void *arg)
 {
+    pids_scan *scan = arg;
     int _kill0 = 0;
     int _kill1 = 0;
     int _gsid0 = 0;
@@ -96,194 +118,184 @@ static void loop_all_pids(const char *ps, pid_t max_pid, int *_errors, int *_tot
     int _proc_read  = 0;
     int _proc_opendir = 0;
 
-    pid_t i = 1;
-    pid_t my_pid;
+    pid_t i = (pid_t)value;
+    int errors;
 
     char command[OS_SIZE_1024 + 64];
 
-    my_pid = getpid();
+    w_mutex_lock(&scan->mutex);
+    scan->total++;
+    w_mutex_unlock(&scan->mutex);
 
-    for (;; i++) {
-        if ((i <= 0) || (i > max_pid)) {
-            break;
-        }
-
-        (*_total)++;
-
-        _kill0 = 0;
-        _kill1 = 0;
-        _gsid0 = 0;
-        _gsid1 = 0;
-        _gpid0 = 0;
-        _gpid1 = 0;
-        _ps0 = -1;
+    /* kill test */
+    if (!((kill(i, 0) == -1) && (errno == ESRCH))) {
+        _kill0 = 1;
+    }
 
-        /* kill test */
-        if (!((kill(i, 0) == -1) && (errno == ESRCH))) {
-            _kill0 = 1;
-        }
+    /* getsid test */
+    if (!((getsid(i) == -1) && (errno == ESRCH))) {
+        _gsid0 = 1;
+    }
 
-        /* getsid test */
-        if (!((getsid(i) == -1) && (errno == ESRCH))) {
-            _gsid0 = 1;
-        }
+    /* getpgid test */
+    if (!((getpgid(i) == -1) && (errno == ESRCH))) {
+        _gpid0 = 1;
+    }
 
-        /* getpgid test */
-        if (!((getpgid(i) == -1) && (errno == ESRCH))) {
-            _gpid0 = 1;
-        }
+    /* /proc test */
+    _proc_stat = proc_stat(i);
+    _proc_read = proc_read(i);
+    _proc_opendir = proc_opendir(i);
 
-        /* /proc test */
-        _proc_stat = proc_stat(i);
-        _proc_read = proc_read(i);
-        _proc_opendir = proc_opendir(i);
+    /* If PID does not exist, move on */
+    if (!_kill0     && !_gsid0     && !_gpid0 &&
+            !_proc_stat && !_proc_read && !_proc_opendir) {
+        return (0);
+    }
 
-        /* If PID does not exist, move on */
-        if (!_kill0     && !_gsid0     && !_gpid0 &&
-                !_proc_stat && !_proc_read && !_proc_opendir) {
-            continue;
-        }
+    /* Ignore our own pid */
+    if (i == scan->my_pid) {
+        return (0);
+    }
 
-        /* Ignore our own pid */
-        if (i == my_pid) {
-            continue;
-        }
+    /* Check the number of errors, and report it only once */
+    w_mutex_lock(&scan->mutex);
+    errors = scan->errors;
+    if (errors > 15 && !scan->excessive) {
+        char op_msg[OS_SIZE_1024 + 1];
+        scan->excessive = 1;
+        snprintf(op_msg, OS_SIZE_1024, "Excessive number of hidden processes"
+                 ". It maybe a false-positive or "
+                 "something really bad is going on.");
+        notify_rk(ALERT_SYSTEM_CRIT, op_msg);
+    }
+    w_mutex_unlock(&scan->mutex);
 
-        /* Check the number of errors */
-        if ((*_errors) > 15) {
-            char op_msg[OS_SIZE_1024 + 1];
-            snprintf(op_msg, OS_SIZE_1024, "Excessive number of hidden processes"
-                     ". It maybe a false-positive or "
-                     "something really bad is going on.");
-            notify_rk(ALERT_SYSTEM_CRIT, op_msg);
-            return;
-        }
+    if (errors > 15) {
+        return (1);
+    }
 
-        /* Check if the process appears in ps(1) output */
-        if (*ps) {
-            snprintf(command, sizeof(command), "%s -p %d > /dev/null 2>&1", ps, (int)i);
-            _ps0 = 0;
-            if (system(command) == 0) {
-                _ps0 = 1;
-            }
+    /* Check if the process appears in ps(1) output */
+    if (*scan->ps) {
+        snprintf(command, sizeof(command), "%s -p %d > /dev/null 2>&1", scan->ps, (int)i);
+        _ps0 = 0;
+        if (system(command) == 0) {
+            _ps0 = 1;
         }
+    }
 
-        /* If we are run in the context of OSSEC-HIDS, sleep here (no rush) */
+    /* If we are run in the context of OSSEC-HIDS, sleep here (no rush) */
 #ifdef OSSECHIDS
 #ifdef WIN32
-        Sleep(rootcheck.tsleep);
+    Sleep(rootcheck.tsleep);
 #else
-        struct timeval timeout = {0, rootcheck.tsleep * 1000};
-        select(0, NULL, NULL, NULL, &timeout);
+    struct timeval timeout = {0, rootcheck.tsleep * 1000};
+    select(0, NULL, NULL, NULL, &timeout);
 #endif
 #endif
 
-        /* Everything fine, move on */
-        if (_ps0 && _kill0 && _gsid0 && _gpid0 && _proc_stat && _proc_read) {
-            continue;
-        }
+    /* Everything fine, move on */
+    if (_ps0 && _kill0 && _gsid0 && _gpid0 && _proc_stat && _proc_read) {
+        return (0);
+    }
+
+    /*
+     * If our kill or getsid system call got the PID but ps(1) did not,
+     * find out if the PID is deleted (not used anymore)
+     */
+    if (!((getsid(i) == -1) && (errno == ESRCH))) {
+        _gsid1 = 1;
+    }
+    if (!((kill(i, 0) == -1) && (errno == ESRCH))) {
+        _kill1 = 1;
+    }
+    if (!((getpgid(i) == -1) && (errno == ESRCH))) {
+        _gpid1 = 1;
+    }
+
+    _proc_stat = proc_stat(i);
+    _proc_read = proc_read(i);
+    _proc_opendir = proc_opendir(i);
 
-        /*
-         * If our kill or getsid system call got the PID but ps(1) did not,
-         * find out if the PID is deleted (not used anymore)
+    /* If it matches, process was terminated in the meantime, so move on */
+    if (!_gsid1 && !_kill1 && !_gpid1 && !_proc_stat &&
+            !_proc_read && !_proc_opendir) {
+        return (0);
+    }
+
+#ifdef AIX
+    /* Ignore AIX wait and sched programs */
+    if (_gsid0 == _gsid1 &&
+            _kill0 == _kill1 &&
+            _gpid0 == _gpid1 &&
+            _ps0 == 1 &&
+            _gsid0 == 1 &&
+            _kill0 == 0) {
+        /* The wait and sched programs do not respond to kill 0.
+         * So if everything else finds it, including ps, getpid, getsid,
+         * but not kill, we can safely ignore on AIX.
+         * A malicious program would specially try to hide from ps.
          */
-        if (!((getsid(i) == -1) && (errno == ESRCH))) {
-            _gsid1 = 1;
-        }
-        if (!((kill(i, 0) == -1) && (errno == ESRCH))) {
-            _kill1 = 1;
-        }
-        if (!((getpgid(i) == -1) && (errno == ESRCH))) {
-            _gpid1 = 1;
-        }
+        return (0);
+    }
+#endif
 
-        _proc_stat = proc_stat(i);
-        _proc_read = proc_read(i);
-        _proc_opendir = proc_opendir(i);
+    if (_gsid0 == _gsid1 &&
+            _kill0 == _kill1 &&
+            _gsid0 != _kill0) {
+        /* If kill worked, but getsid and getpgid did not, it may
+         * be a defunct process -- ignore.
+         */
+        if (! (_kill0 == 1 && _gsid0 == 0 && _gpid0 == 0 && _gsid1 == 0) ) {
+            char op_msg[OS_SIZE_1024 + 1];
 
-        /* If it matches, process was terminated in the meantime, so move on */
-        if (!_gsid1 && !_kill1 && !_gpid1 && !_proc_stat &&
-                !_proc_read && !_proc_opendir) {
-            continue;
+            snprintf(op_msg, OS_SIZE_1024, "Process '%d' hidden from "
+                     "kill (%d) or getsid (%d). Possible kernel-level"
+                     " rootkit.", (int)i, _kill0, _gsid0);
+            pid_hidden(scan, op_msg);
         }
+    } else if (_kill1 != _gsid1 ||
+               _gpid1 != _kill1 ||
+               _gpid1 != _gsid1) {
+        /* See defunct process comment above */
+        if (! (_kill1 == 1 && _gsid1 == 0 && _gpid0 == 0) ) {
+            char op_msg[OS_SIZE_1024 + 1];
 
-#ifdef AIX
-        /* Ignore AIX wait and sched programs */
-        if (_gsid0 == _gsid1 &&
-                _kill0 == _kill1 &&
-                _gpid0 == _gpid1 &&
-                _ps0 == 1 &&
-                _gsid0 == 1 &&
-                _kill0 == 0) {
-            /* The wait and sched programs do not respond to kill 0.
-             * So if everything else finds it, including ps, getpid, getsid,
-             * but not kill, we can safely ignore on AIX.
-             * A malicious program would specially try to hide from ps.
-             */
-            continue;
+            snprintf(op_msg, OS_SIZE_1024, "Process '%d' hidden from "
+                     "kill (%d), getsid (%d) or getpgid. Possible "
+                     "kernel-level rootkit.", (int)i, _kill1, _gsid1);
+            pid_hidden(scan, op_msg);
         }
-#endif
+    } else if (_proc_read != _proc_stat  ||
+               _proc_read != _proc_opendir ||
+               _proc_stat != _kill1) {
+        /* Check if the pid is a thread (not showing in /proc */
+        if (!noproc && !check_rc_readproc((int)i)) {
+            char op_msg[OS_SIZE_1024 + 1];
 
-        if (_gsid0 == _gsid1 &&
-                _kill0 == _kill1 &&
-                _gsid0 != _kill0) {
-            /* If kill worked, but getsid and getpgid did not, it may
-             * be a defunct process -- ignore.
-             */
-            if (! (_kill0 == 1 && _gsid0 == 0 && _gpid0 == 0 && _gsid1 == 0) ) {
-                char op_msg[OS_SIZE_1024 + 1];
-
-                snprintf(op_msg, OS_SIZE_1024, "Process '%d' hidden from "
-                         "kill (%d) or getsid (%d). Possible kernel-level"
-                         " rootkit.", (int)i, _kill0, _gsid0);
-                notify_rk(ALERT_ROOTKIT_FOUND, op_msg);
-                (*_errors)++;
-            }
-        } else if (_kill1 != _gsid1 ||
-                   _gpid1 != _kill1 ||
-                   _gpid1 != _gsid1) {
-            /* See defunct process comment above */
-            if (! (_kill1 == 1 && _gsid1 == 0 && _gpid0 == 0) ) {
-                char op_msg[OS_SIZE_1024 + 1];
-
-                snprintf(op_msg, OS_SIZE_1024, "Process '%d' hidden from "
-                         "kill (%d), getsid (%d) or getpgid. Possible "
-                         "kernel-level rootkit.", (int)i, _kill1, _gsid1);
-                notify_rk(ALERT_ROOTKIT_FOUND, op_msg);
-                (*_errors)++;
-            }
-        } else if (_proc_read != _proc_stat  ||
-                   _proc_read != _proc_opendir ||
-                   _proc_stat != _kill1) {
-            /* Check if the pid is a thread (not showing in /proc */
-            if (!noproc && !check_rc_readproc((int)i)) {
-                char op_msg[OS_SIZE_1024 + 1];
-
-                snprintf(op_msg, OS_SIZE_1024, "Process '%d' hidden from "
-                         "/proc. Possible kernel level rootkit.", (int)i);
-                notify_rk(ALERT_ROOTKIT_FOUND, op_msg);
-                (*_errors)++;
-            }
-        } else if (_gsid1 && _kill1 && !_ps0) {
-            /* checking if the pid is a thread (not showing on ps */
-            if (!check_rc_readproc((int)i)) {
-                char op_msg[OS_SIZE_1024 + 1];
-
-                snprintf(op_msg, OS_SIZE_1024, "Process '%d' hidden from "
-                         "ps. Possible trojaned version installed.",
-                         (int)i);
-                notify_rk(ALERT_ROOTKIT_FOUND, op_msg);
-                (*_errors)++;
-            }
+            snprintf(op_msg, OS_SIZE_1024, "Process '%d' hidden from "
+                     "/proc. Possible kernel level rootkit.", (int)i);
+            pid_hidden(scan, op_msg);
+        }
+    } else if (_gsid1 && _kill1 && !_ps0) {
+        /* checking if the pid is a thread (not showing on ps */
+        if (!check_rc_readproc((int)i)) {
+            char op_msg[OS_SIZE_1024 + 1];
+
+            snprintf(op_msg, OS_SIZE_1024, "Process '%d' hidden from "
+                     "ps. Possible trojaned version installed.",
+                     (int)i);
+            pid_hidden(scan, op_msg);
         }
     }
+
+    return (0);
 }
 
 /* Scan the whole filesystem looking for possible issues */
 void check_rc_pids()
 {
-    int _total = 0;
-    int _errors = 0;
+    pids_scan scan = { .errors = 0, .total = 0, .excessive = 0 };
 
     char ps[OS_SIZE_1024 + 1];
 
@@ -308,13 +320,20 @@ void check_rc_pids()
         noproc = 0;
     }
 
-    loop_all_pids(ps, max_pid, &_errors, &_total);
+    /* The PIDs are probed in parallel, most of the time is spent waiting for ps(1) */
+    scan.ps = ps;
+    scan.my_pid = getpid();
+    w_mutex_init(&scan.mutex, NULL);
+
+    rk_probe_range(1, (int)max_pid, probe_pid, &scan);
+
+    w_mutex_destroy(&scan.mutex);
 
-    if (_errors == 0) {
+    if (scan.errors == 0) {
         char op_msg[OS_SIZE_2048];
         snprintf(op_msg, OS_SIZE_2048, "No hidden process by Kernel-level "
                  "rootkits.\n      %s is not trojaned. "
-                 "Analyzed %d processes.", ps, _total);
+                 "Analyzed %d processes.", ps, scan.total);
         notify_rk(ALERT_OK, op_msg);
     }
 
@@ -21,10 +21,19 @@
                         "grep \"[^0-9]%d \" > /dev/null 2>&1"
 #endif
 
+/* State of the scan, shared by the probe threads */
+typedef struct ports_scan {
+    pthread_mutex_t mutex;
+    int proto;
+    int errors;
+    int total;
+    int excessive;
+} ports_scan;
+
 /* Prototypes */
 static int  run_netstat(int proto, int port);
 static int  conn_port(int proto, int port);
-static void test_ports(int proto, int *_errors, int *_total);
+static int  probe_port(int port, void *arg);
 
 
 static int run_netstat(int proto, int port)
@@ -91,62 +100,67 @@ static int conn_port(int proto, int port)
     return (rc);
 }
 
-static void test_ports(int proto, int *_errors, int *_total)
+/* Check a port for hidden stuff */
+static int probe_port(int port, void *arg)
 {
-    int i;
-
-    for (i = 0; i <= 65535; i++) {
-        (*_total)++;
-        if (conn_port(proto, i)) {
-            /* Check if we can find it using netstat. If not,
-             * check again to see if the port is still being used.
-             */
-            if (run_netstat(proto, i)) {
-                continue;
-            }
-
+    ports_scan *scan = arg;
+    int proto = scan->proto;
+    int errors;
+
+    if (conn_port(proto, port)) {
+        /* Check if we can find it using netstat. If not,
+         * check again to see if the port is still being used.
+         */
+        if (!run_netstat(proto, port)) {
 #ifdef OSSECHIDS
             /* If we are in the context of OSSEC-HIDS, sleep here (no rush) */
 #ifdef WIN32
-        Sleep(rootcheck.tsleep);
+            Sleep(rootcheck.tsleep);
 #else
-        struct timeval timeout = {0, rootcheck.tsleep * 1000};
-        select(0, NULL, NULL, NULL, &timeout);
+            struct timeval timeout = {0, rootcheck.tsleep * 1000};
+            select(0, NULL, NULL, NULL, &timeout);
 #endif
 #endif
 
-            if (!run_netstat(proto, i) && conn_port(proto, i)) {
+            if (!run_netstat(proto, port) && conn_port(proto, port)) {
                 char op_msg[OS_SIZE_1024 + 1];
 
-                (*_errors)++;
-
                 snprintf(op_msg, OS_SIZE_1024, "Port '%d'(%s) hidden. "
                          "Kernel-level rootkit or trojaned "
-                         "version of netstat.", i,
+                         "version of netstat.", port,
                          (proto == IPPROTO_UDP) ? "udp" : "tcp");
 
                 notify_rk(ALERT_ROOTKIT_FOUND, op_msg);
+
+                w_mutex_lock(&scan->mutex);
+                scan->errors++;
+                w_mutex_unlock(&scan->mutex);
             }
         }
+    }
 
-        if ((*_errors) > 20) {
-            char op_msg[OS_SIZE_1024 + 1];
+    /* Check the number of errors, and report it only once */
+    w_mutex_lock(&scan->mutex);
+    scan->total++;
+    errors = scan->errors;
+    if (errors > 20 && !scan->excessive) {
+        char op_msg[OS_SIZE_1024 + 1];
 
-            snprintf(op_msg, OS_SIZE_1024, "Excessive number of '%s' ports "
-                     "hidden. It maybe a false-positive or "
-                     "something really bad is going on.",
-                     (proto == IPPROTO_UDP) ? "udp" : "tcp" );
-            notify_rk(ALERT_SYSTEM_CRIT, op_msg);
-            return;
-        }
+        scan->excessive = 1;
+        snprintf(op_msg, OS_SIZE_1024, "Excessive number of '%s' ports "
+                 "hidden. It maybe a false-positive or "
+                 "something really bad is going on.",
+                 (proto == IPPROTO_UDP) ? "udp" : "tcp" );
+        notify_rk(ALERT_SYSTEM_CRIT, op_msg);
     }
+    w_mutex_unlock(&scan->mutex);
 
+    return (errors > 20);
 }
 
 void check_rc_ports()
 {
-    int _errors = 0;
-    int _total = 0;
+    ports_scan scan = { .errors = 0, .total = 0 };
 
     int i = 0;
 
@@ -156,16 +170,25 @@ void check_rc_ports()
         i++;
     }
 
-    /* Test both TCP and UDP ports */
-    test_ports(IPPROTO_TCP, &_errors, &_total);
-    test_ports(IPPROTO_UDP, &_errors, &_total);
+    w_mutex_init(&scan.mutex, NULL);
+
+    /* Test both TCP and UDP ports, each port is probed by a single thread */
+    scan.proto = IPPROTO_TCP;
+    scan.excessive = 0;
+    rk_probe_range(0, 65535, probe_port, &scan);
+
+    scan.proto = IPPROTO_UDP;
+    scan.excessive = 0;
+    rk_probe_range(0, 65535, probe_port, &scan);
+
+    w_mutex_destroy(&scan.mutex);
 
-    if (_errors == 0) {
+    if (scan.errors == 0) {
         char op_msg[OS_SIZE_1024 + 1];
 
         snprintf(op_msg, OS_SIZE_1024, "No kernel-level rootkit hiding any port."
                  "\n      Netstat is acting correctly."
-                 " Analyzed %d ports.", _total);
+                 " Analyzed %d ports.", scan.total);
         notify_rk(ALERT_OK, op_msg);
     }
 
@@ -18,14 +18,11 @@
 #define TASK 2
 
 /* Prototypes */
-static int read_proc_file(const char *file_name, const char *pid, int position);
-static int read_proc_dir(const char *dir_name, const char *pid, int position);
+static int read_proc_file(const char *file_name, const char *pid, int position, int *found);
+static int read_proc_dir(const char *dir_name, const char *pid, int position, int *found);
 
-/* Global variables */
-static int proc_pid_found;
 
-
-static int read_proc_file(const char *file_name, const char *pid, int position)
+static int read_proc_file(const char *file_name, const char *pid, int position, int *found)
 {
     struct stat statbuf;
 
@@ -35,13 +32,13 @@ static int read_proc_file(const char *file_name, const char *pid, int position)
 
     /* If directory, read the directory */
     if (S_ISDIR(statbuf.st_mode)) {
-        return (read_proc_dir(file_name, pid, position));
+        return (read_proc_dir(file_name, pid, position, found));
     }
 
     return (0);
 }
 
-int read_proc_dir(const char *dir_name, const char *pid, int position)
+static int read_proc_dir(const char *dir_name, const char *pid, int position, int *found)
 {
     DIR *dp;
     struct dirent *entry = NULL;
@@ -82,16 +79,16 @@ int read_proc_dir(const char *dir_name, const char *pid, int position)
             }
 
             snprintf(f_name, PATH_MAX + 1, "%s/%s", dir_name, entry->d_name);
-            read_proc_file(f_name, pid, position + 1);
+            read_proc_file(f_name, pid, position + 1, found);
         } else if (position == PID) {
             if (strcmp(entry->d_name, "task") == 0) {
                 snprintf(f_name, PATH_MAX + 1, "%s/%s", dir_name, entry->d_name);
-                read_proc_file(f_name, pid, position + 1);
+                read_proc_file(f_name, pid, position + 1, found);
             }
         } else if (position == TASK) {
             /* Check under proc/pid/task/lwp */
             if (strcmp(entry->d_name, pid) == 0) {
-                proc_pid_found = 1;
+                *found = 1;
                 break;
             }
         } else {
@@ -105,13 +102,13 @@ int read_proc_dir(const char *dir_name, const char *pid, int position)
 }
 
 /*  Read the /proc directory (if present) and check if it can find
- *  the given pid (as a pid or as a thread)
+ *  the given pid (as a pid or as a thread). It's called from the
+ *  threads of check_rc_pids, so it keeps no global state.
  */
 int check_rc_readproc(int pid)
 {
     char char_pid[32];
-
-    proc_pid_found = 0;
+    int proc_pid_found = 0;
 
     /* NL threads */
     snprintf(char_pid, 31, "/proc/.%d", pid);
@@ -120,7 +117,7 @@ int check_rc_readproc(int pid)
     }
 
     snprintf(char_pid, 31, "%d", pid);
-    read_proc_dir("/proc", char_pid, PROC);
+    read_proc_dir("/proc", char_pid, PROC, &proc_pid_found);
 
     return (proc_pid_found);
 }
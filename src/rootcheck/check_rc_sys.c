@@ -14,6 +14,7 @@
 /* Prototypes */
 static int read_sys_file(const char *file_name, int do_read);
 static int read_sys_dir(const char *dir_name, int do_read);
+static void visit_pruned(const char *dir_name);
 
 /* Global variables */
 static int   _sys_errors;
@@ -22,6 +23,19 @@ static dev_t did;
 static FILE *_wx;
 static FILE *_ww;
 static FILE *_suid;
+static const rk_sys_visitor *const *_visitors;
+
+/* Tell the visitors the walk does not descend into a directory */
+static void visit_pruned(const char *dir_name)
+{
+    int i;
+
+    for (i = 0; _visitors && _visitors[i]; i++) {
+        if (_visitors[i]->pruned) {
+            _visitors[i]->pruned(dir_name);
+        }
+    }
+}
 
 
 static int read_sys_file(const char *file_name, int do_read)
@@ -66,15 +80,22 @@ static int read_sys_file(const char *file_name, int do_read)
          * /dev/fd5, /dev/fd6, etc.. weird
          */
         if (strstr(file_name, "/dev/fd") != NULL) {
+            visit_pruned(file_name);
             return (0);
         }
 
         /* Ignore the /proc directory (it has size 0) */
         if (statbuf.st_size == 0) {
+            visit_pruned(file_name);
             return (0);
         }
 
-        return (read_sys_dir(file_name, do_read));
+        if (read_sys_dir(file_name, do_read) != 0) {
+            visit_pruned(file_name);
+            return (-1);
+        }
+
+        return (0);
     }
 
     /* Check if the size from stats is the same as when we read the file */
@@ -270,10 +291,17 @@ static int read_sys_dir(const char *dir_name, int do_read)
         }
     }
 
+    for (i = 0; _visitors && _visitors[i]; i++) {
+        if (_visitors[i]->dir) {
+            _visitors[i]->dir(dir_name);
+        }
+    }
+
     /* Read every entry in the directory */
     while ((entry = readdir(dp)) != NULL) {
         char f_name[PATH_MAX + 2];
         struct stat statbuf_local;
+        int stat_ok;
 
         /* Ignore . and ..  */
         if ((strcmp(entry->d_name, ".") == 0) ||
@@ -290,7 +318,8 @@ static int read_sys_dir(const char *dir_name, int do_read)
         }
 
         /* Check if file is a directory */
-        if (lstat(f_name, &statbuf_local) == 0) {
+        stat_ok = (lstat(f_name, &statbuf_local) == 0);
+        if (stat_ok) {
             /* On all the systems except Darwin, the
              * link count is only increased on directories
              */
@@ -310,6 +339,12 @@ static int read_sys_dir(const char *dir_name, int do_read)
             }
         }
 
+        for (i = 0; _visitors && _visitors[i]; i++) {
+            if (_visitors[i]->entry) {
+                _visitors[i]->entry(f_name, stat_ok ? &statbuf_local : NULL);
+            }
+        }
+
         /* Ignore the /proc and /sys filesystems */
         if (check_ignore(f_name) || !strcmp(f_name, "/proc") || !strcmp(f_name, "/sys")) {
             continue;
@@ -389,16 +424,24 @@ static int read_sys_dir(const char *dir_name, int do_read)
 }
 
 /* Scan the whole filesystem looking for possible issues */
-void check_rc_sys(const char *basedir)
+void check_rc_sys(const char *basedir, const rk_sys_visitor *const *visitors)
 {
     char file_path[OS_SIZE_1024 + 1];
     char dir_path[OS_SIZE_1024 + 1];
+    int i;
 
     mtdebug1(ARGV0, "Starting on check_rc_sys");
 
     _sys_errors = 0;
     _sys_total = 0;
     did = 0; /* device id */
+    _visitors = visitors;
+
+    for (i = 0; _visitors && _visitors[i]; i++) {
+        if (_visitors[i]->start) {
+            _visitors[i]->start(basedir);
+        }
+    }
 
     snprintf(file_path, OS_SIZE_1024, "%s", basedir);
 
@@ -420,7 +463,9 @@ void check_rc_sys(const char *basedir)
 #else
         snprintf(file_path, 5, "%s", "C:\\");
 #endif
-        read_sys_dir(file_path, rootcheck.readall);
+        if (read_sys_dir(file_path, rootcheck.readall) != 0) {
+            visit_pruned(file_path);
+        }
     } else {
         /* Scan only specific directories */
         int _i;
@@ -441,11 +486,20 @@ void check_rc_sys(const char *basedir)
         _i = 0;
         while (dirs_to_scan[_i] != NULL) {
             snprintf(dir_path, OS_SIZE_1024, "%s%c%s", basedir, PATH_SEP, dirs_to_scan[_i]);
-            read_sys_dir(dir_path, rootcheck.readall);
+            if (read_sys_dir(dir_path, rootcheck.readall) != 0) {
+                visit_pruned(dir_path);
+            }
             _i++;
         }
     }
 
+    for (i = 0; _visitors && _visitors[i]; i++) {
+        if (_visitors[i]->end) {
+            _visitors[i]->end();
+        }
+    }
+    _visitors = NULL;
+
     if (_sys_errors == 0) {
         char op_msg[OS_SIZE_1024 + 1];
         snprintf(op_msg, OS_SIZE_1024, "No problem found on the system."
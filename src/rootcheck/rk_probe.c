@@ -0,0 +1,100 @@
+/* Copyright (C) 2015, Wazuh Inc.
+ * All right reserved.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation
+ */
+
+#ifndef WIN32
+#include "shared.h"
+#include "rootcheck.h"
+
+/* Values taken by a thread each time */
+#define RK_PROBE_BLOCK  64
+
+/* Maximum number of probe threads */
+#define RK_PROBE_MAX_THREADS    32
+
+typedef struct rk_probe_pool {
+    pthread_mutex_t mutex;
+    int next;
+    int last;
+    int stop;
+    int (*probe)(int value, void *arg);
+    void *arg;
+} rk_probe_pool;
+
+/* Prototypes */
+static void *rk_probe_worker(void *arg);
+
+
+/* Take blocks of values until the range is done or a probe stops it */
+static void *rk_probe_worker(void *arg)
+{
+    rk_probe_pool *pool = arg;
+    int first;
+    int last;
+    int value;
+
+    while (1) {
+        w_mutex_lock(&pool->mutex);
+
+        if (pool->stop || pool->next > pool->last) {
+            w_mutex_unlock(&pool->mutex);
+            break;
+        }
+
+        first = pool->next;
+        last = (pool->last - first < RK_PROBE_BLOCK) ? pool->last : first + RK_PROBE_BLOCK - 1;
+        pool->next = last + 1;
+
+        w_mutex_unlock(&pool->mutex);
+
+        for (value = first; value <= last; value++) {
+            if (pool->probe(value, pool->arg)) {
+                w_mutex_lock(&pool->mutex);
+                pool->stop = 1;
+                w_mutex_unlock(&pool->mutex);
+                return NULL;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+void rk_probe_range(int first, int last, int (*probe)(int value, void *arg), void *arg)
+{
+    pthread_t threads[RK_PROBE_MAX_THREADS];
+    rk_probe_pool pool = { .next = first, .last = last, .stop = 0, .probe = probe, .arg = arg };
+    int nthreads = rootcheck.threads;
+    int created = 0;
+    int i;
+
+    if (nthreads > RK_PROBE_MAX_THREADS) {
+        nthreads = RK_PROBE_MAX_THREADS;
+    }
+
+    w_mutex_init(&pool.mutex, NULL);
+
+    /* The calling thread is one of the workers */
+    for (i = 1; i < nthreads; i++) {
+        if (CreateThreadJoinable(&threads[created], rk_probe_worker, &pool) < 0) {
+            mtwarn(ARGV0, "Cannot create a probe thread, using %d.", created + 1);
+            break;
+        }
+        created++;
+    }
+
+    rk_probe_worker(&pool);
+
+    for (i = 0; i < created; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    w_mutex_destroy(&pool.mutex);
+}
+
+#endif /* WIN32 */
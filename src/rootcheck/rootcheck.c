@@ -192,6 +192,8 @@ int rootcheck_init(int test_config)
 #endif
 
     rootcheck.tsleep = getDefine_Int("rootcheck", "sleep", 0, 1000);
+    rootcheck.threads = getDefine_Int("rootcheck", "threads", 1, 32);
+    rootcheck.io_idle = getDefine_Int("rootcheck", "io_idle", 0, 1);
 
     /* If testing config, exit here */
     if (test_config) {
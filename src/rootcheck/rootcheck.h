@@ -42,6 +42,26 @@ extern rkconfig rootcheck;
 /* Default to 12 hours */
 #define ROOTCHECK_WAIT          43200
 
+/* Visitor of the filesystem walk of check_rc_sys. It lets other file-based
+ * checks inspect the entries found by the walk instead of reading the same
+ * tree again. Every callback is optional.
+ */
+typedef struct rk_sys_visitor {
+    /* Called before the walk starts */
+    void (*start)(const char *basedir);
+    /* Called for every directory opened by the walk */
+    void (*dir)(const char *dir_name);
+    /* Called for every entry read, statbuf is NULL if lstat failed */
+    void (*entry)(const char *file_name, const struct stat *statbuf);
+    /* Called for every directory the walk does not descend into */
+    void (*pruned)(const char *dir_name);
+    /* Called after the walk ends */
+    void (*end)(void);
+} rk_sys_visitor;
+
+/* Visitor of check_rc_dev, to run it inside the walk of check_rc_sys */
+extern const rk_sys_visitor rk_dev_visitor;
+
 /** Prototypes **/
 
 /* Check if file is present on dir */
@@ -85,6 +105,11 @@ int os_check_ads(const char *full_path);
 /* Get list of processes */
 OSList *os_get_process_list(void);
 
+/* Run probe(value, arg) for every value in [first, last] on up to
+ * rootcheck.threads threads. A non-zero return stops the remaining probes.
+ */
+void rk_probe_range(int first, int last, int (*probe)(int value, void *arg), void *arg);
+
 /* Check if a process is running */
 int is_process(char *value, OSList *p_list);
 
@@ -119,7 +144,7 @@ void check_rc_winaudit(FILE *fp, OSList *p_list);
 void check_rc_winmalware(FILE *fp, OSList *p_list);
 void check_rc_winapps(FILE *fp, OSList *p_list);
 void check_rc_dev(const char *basedir);
-void check_rc_sys(const char *basedir);
+void check_rc_sys(const char *basedir, const rk_sys_visitor *const *visitors);
 void check_rc_pids(void);
 
 /* Verify if "pid" is in the proc directory */
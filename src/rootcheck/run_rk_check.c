@@ -12,7 +12,21 @@
 #include "rootcheck.h"
 #include "config/syscheck-config.h"
 
+#ifdef __linux__
+#include <sys/syscall.h>
+
+/* I/O scheduling, see ioprio_set(2) */
+#define RK_IOPRIO_WHO_PROCESS   1
+#define RK_IOPRIO_CLASS_SHIFT   13
+#define RK_IOPRIO_CLASS_IDLE    3
+#endif
+
 static void log_realtime_status_rk(int next);
+static int rk_set_io_idle(void);
+static void rk_restore_io_priority(int ioprio);
+
+/* The checks probing PIDs and ports notify from several threads */
+static pthread_mutex_t rk_notify_mutex = PTHREAD_MUTEX_INITIALIZER;
 
 /* Report a problem */
 int notify_rk(int rk_type, const char *msg)
@@ -40,6 +54,8 @@ int notify_rk(int rk_type, const char *msg)
 
 #ifdef OSSECHIDS
     /* When running in context of OSSEC-HIDS, send problem to the rootcheck queue */
+    w_mutex_lock(&rk_notify_mutex);
+
     if (SendMSG(rootcheck.queue, msg, ROOTCHECK, ROOTCHECK_MQ) < 0) {
         mterror(ARGV0, QUEUE_SEND);
 
@@ -51,11 +67,52 @@ int notify_rk(int rk_type, const char *msg)
             mterror_exit(ARGV0, QUEUE_FATAL, DEFAULTQUEUE);
         }
     }
+
+    w_mutex_unlock(&rk_notify_mutex);
 #endif
 
     return (0);
 }
 
+/* Move the calling thread, and the ones it creates, to the idle I/O class.
+ * Return the previous I/O priority, or -1 if it was not changed.
+ */
+static int rk_set_io_idle()
+{
+#ifdef __linux__
+    int ioprio;
+
+    if (!rootcheck.io_idle) {
+        return (-1);
+    }
+
+    if (ioprio = syscall(SYS_ioprio_get, RK_IOPRIO_WHO_PROCESS, 0), ioprio < 0) {
+        mtdebug1(ARGV0, "Cannot get the I/O priority: %s (%d)", strerror(errno), errno);
+        return (-1);
+    }
+
+    if (syscall(SYS_ioprio_set, RK_IOPRIO_WHO_PROCESS, 0, RK_IOPRIO_CLASS_IDLE << RK_IOPRIO_CLASS_SHIFT) < 0) {
+        mtwarn(ARGV0, "Cannot set the idle I/O priority: %s (%d)", strerror(errno), errno);
+        return (-1);
+    }
+
+    return (ioprio);
+#else
+    return (-1);
+#endif
+}
+
+static void rk_restore_io_priority(int ioprio)
+{
+#ifdef __linux__
+    if (ioprio >= 0 && syscall(SYS_ioprio_set, RK_IOPRIO_WHO_PROCESS, 0, ioprio) < 0) {
+        mtdebug1(ARGV0, "Cannot restore the I/O priority: %s (%d)", strerror(errno), errno);
+    }
+#else
+    (void)ioprio;
+#endif
+}
+
 /* Execute the rootkit checks */
 void run_rk_check()
 {
@@ -63,6 +120,7 @@ void run_rk_check()
     time_t time2;
     FILE *fp;
     OSList *plist;
+    int ioprio;
 
 #ifndef WIN32
     /* On non-Windows, always start at / */
@@ -83,6 +141,7 @@ void run_rk_check()
     }
 
     time1 = time(0);
+    ioprio = rk_set_io_idle();
 
     /* Initial message */
     if (rootcheck.notify != QUEUE) {
@@ -227,17 +286,34 @@ void run_rk_check()
 
 #endif /* !WIN32 */
 
-    /* Check for files in the /dev filesystem */
-    if (rootcheck.checks.rc_dev) {
+#ifndef WIN32
+    /* Check for files in the /dev filesystem. The system scan reads it
+     * too, so if both are enabled it's checked inside that walk.
+     */
+    if (rootcheck.checks.rc_dev && !rootcheck.checks.rc_sys) {
         mtdebug1(ARGV0, "Going into check_rc_dev");
         check_rc_dev(rootcheck.basedir);
     }
 
+    /* Scan the whole system for additional issues */
+    if (rootcheck.checks.rc_sys) {
+        const rk_sys_visitor *visitors[2] = { NULL, NULL };
+
+        if (rootcheck.checks.rc_dev) {
+            mtdebug1(ARGV0, "Going into check_rc_dev");
+            visitors[0] = &rk_dev_visitor;
+        }
+
+        mtdebug1(ARGV0, "Going into check_rc_sys");
+        check_rc_sys(rootcheck.basedir, visitors);
+    }
+#else
     /* Scan the whole system for additional issues */
     if (rootcheck.checks.rc_sys) {
         mtdebug1(ARGV0, "Going into check_rc_sys");
-        check_rc_sys(rootcheck.basedir);
+        check_rc_sys(rootcheck.basedir, NULL);
     }
+#endif
 
     /* Check processes */
     if (rootcheck.checks.rc_pids) {
@@ -277,6 +353,8 @@ void run_rk_check()
         }
     }
 
+    rk_restore_io_priority(ioprio);
+
     /* Final message */
     time2 = time(0);
 
@@ -8,10 +8,21 @@
  */
 
 #include "shared.h"
+#include "os_net/os_net.h"
+
+static int jqueue_connect(file_queue * queue);
+static cJSON * jqueue_receive(file_queue * queue);
 
 // Initializes queue. Equivalent to initialize every field to 0.
 void jqueue_init(file_queue * queue) {
     memset(queue, 0, sizeof(file_queue));
+    queue->sock = -1;
+}
+
+// Read the alerts from the alert bus
+void jqueue_subscribe(file_queue * queue, const cJSON * filter) {
+    os_free(queue->filter);
+    queue->filter = cJSON_PrintUnformatted(filter);
 }
 
 /*
@@ -20,6 +31,11 @@ void jqueue_init(file_queue * queue) {
  */
 int jqueue_open(file_queue * queue, int tail) {
 
+    if (queue->filter) {
+        jqueue_connect(queue);
+        return 0;
+    }
+
     strncpy(queue->file_name, ALERTSJSON_DAILY, MAX_FQUEUE);
 
     if (queue->fp) {
@@ -58,6 +74,10 @@ cJSON * jqueue_next(file_queue * queue) {
     struct stat buf;
     cJSON * alert;
 
+    if (queue->filter) {
+        return jqueue_receive(queue);
+    }
+
     if (!queue->fp && jqueue_open(queue, 1) < 0) {
         return NULL;
     }
@@ -100,6 +120,14 @@ cJSON * jqueue_next(file_queue * queue) {
 
 // Close queue
 void jqueue_close(file_queue * queue) {
+    if (queue->filter) {
+        if (queue->sock >= 0) {
+            close(queue->sock);
+            queue->sock = -1;
+        }
+        return;
+    }
+
     fclose(queue->fp);
     queue->fp = NULL;
 }
@@ -173,3 +201,66 @@ cJSON * jqueue_parse_json(file_queue * queue) {
 
     return NULL;
 }
+
+// Connect to the alert bus and send the filter
+static int jqueue_connect(file_queue * queue) {
+#ifdef WIN32
+    return -1;
+#else
+    if (queue->sock >= 0) {
+        close(queue->sock);
+    }
+
+    if (queue->sock = OS_ConnectUnixDomain(ALERT_BUS_SOCK, SOCK_SEQPACKET, OS_MAXSTR), queue->sock < 0) {
+        mdebug1("Cannot connect to '%s': %s (%d)", ALERT_BUS_SOCK, strerror(errno), errno);
+        queue->sock = -1;
+        return -1;
+    }
+
+    if (send(queue->sock, queue->filter, strlen(queue->filter), 0) < 0) {
+        merror("Cannot send the filter to '%s': %s (%d)", ALERT_BUS_SOCK, strerror(errno), errno);
+        close(queue->sock);
+        queue->sock = -1;
+        return -1;
+    }
+
+    // Wait for an alert no longer than a second
+    OS_SetRecvTimeout(queue->sock, 1, 0);
+    mdebug1("Connected to the alert bus.");
+
+    return 0;
+#endif
+}
+
+// Receive the next JSON alert from the alert bus
+static cJSON * jqueue_receive(file_queue * queue) {
+    cJSON * object;
+    char buffer[OS_MAXSTR + 1];
+    const char * jsonErrPtr;
+    ssize_t length;
+
+    if (queue->sock < 0 && jqueue_connect(queue) < 0) {
+        return NULL;
+    }
+
+    if (length = recv(queue->sock, buffer, OS_MAXSTR, 0), length <= 0) {
+        if (length < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+            return NULL;
+        }
+
+        mwarn("Disconnected from the alert bus. Reconnecting.");
+        close(queue->sock);
+        queue->sock = -1;
+        return NULL;
+    }
+
+    buffer[length] = '\0';
+
+    if ((object = cJSON_ParseWithOpts(buffer, &jsonErrPtr, 0), object) && (*jsonErrPtr == '\0')) {
+        return object;
+    }
+
+    cJSON_Delete(object);
+    mwarn("Invalid JSON alert received from '%s': '%s'", ALERT_BUS_SOCK, buffer);
+    return NULL;
+}
@@ -0,0 +1,297 @@
+/*
+ * Lock-free queue (abstract data type)
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include <shared.h>
+
+// Attempts of the blocking operations before waiting on the condition variables
+#define MPMC_QUEUE_SPIN 64
+
+static size_t mpmc_queue_load(const size_t * position) {
+    return __atomic_load_n(position, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Wakes the threads waiting on a condition variable, if any.
+ * The fence pairs with the one taken by the threads before waiting:
+ * either they see the change of the queue or this sees them waiting.
+ */
+static void mpmc_queue_wake(w_mpmc_queue_t * queue, unsigned int * waiters, pthread_cond_t * cond, int all) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    if (__atomic_load_n(waiters, __ATOMIC_RELAXED) > 0) {
+        w_mutex_lock(&queue->mutex);
+
+        if (all) {
+            w_cond_broadcast(cond);
+        } else {
+            w_cond_signal(cond);
+        }
+
+        w_mutex_unlock(&queue->mutex);
+    }
+}
+
+static void mpmc_queue_wait_start(unsigned int * waiters) {
+    __atomic_add_fetch(waiters, 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+static void mpmc_queue_wait_end(unsigned int * waiters) {
+    __atomic_sub_fetch(waiters, 1, __ATOMIC_RELAXED);
+}
+
+w_mpmc_queue_t * mpmc_queue_init(size_t size) {
+    w_mpmc_queue_t * queue;
+    size_t i;
+
+    // With a single slot, a pushed element would look like a free slot to the next push
+    if (size < 2) {
+        size = 2;
+    }
+
+    os_calloc(1, sizeof(w_mpmc_queue_t), queue);
+    os_malloc(size * sizeof(w_mpmc_cell_t), queue->cells);
+
+    for (i = 0; i < size; i++) {
+        queue->cells[i].sequence = i;
+        queue->cells[i].data = NULL;
+    }
+
+    queue->size = size;
+    w_mutex_init(&queue->mutex, NULL);
+    w_cond_init(&queue->available, NULL);
+    w_cond_init(&queue->available_not_full, NULL);
+    return queue;
+}
+
+void mpmc_queue_free(w_mpmc_queue_t * queue) {
+    if (queue) {
+        free(queue->cells);
+        w_mutex_destroy(&queue->mutex);
+        w_cond_destroy(&queue->available);
+        w_cond_destroy(&queue->available_not_full);
+        free(queue);
+    }
+}
+
+size_t mpmc_queue_elements(const w_mpmc_queue_t * queue) {
+    const size_t pop_pos = mpmc_queue_load(&queue->pop_pos);
+    const size_t push_pos = mpmc_queue_load(&queue->push_pos);
+
+    // The positions are read at different times
+    if (push_pos <= pop_pos) {
+        return 0;
+    }
+
+    return push_pos - pop_pos < queue->size ? push_pos - pop_pos : queue->size;
+}
+
+int mpmc_queue_full(const w_mpmc_queue_t * queue) {
+    return mpmc_queue_elements(queue) == queue->size;
+}
+
+int mpmc_queue_empty(const w_mpmc_queue_t * queue) {
+    return mpmc_queue_elements(queue) == 0;
+}
+
+/**
+ * @brief Takes up to max consecutive positions whose slots are ready,
+ * i.e. their sequence is the position plus the offset.
+ *
+ * @param queue the queue
+ * @param position position to take (push_pos or pop_pos)
+ * @param offset 0 to push, 1 to pop
+ * @param max maximum number of positions
+ * @param first first position taken
+ * @return number of positions taken, 0 if the queue is full (push) or empty (pop)
+ */
+static size_t mpmc_queue_claim(w_mpmc_queue_t * queue, size_t * position, size_t offset, size_t max, size_t * first) {
+    size_t pos = mpmc_queue_load(position);
+
+    while (1) {
+        size_t count;
+
+        for (count = 0; count < max; count++) {
+            const w_mpmc_cell_t * cell = &queue->cells[(pos + count) % queue->size];
+            const size_t sequence = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+
+            if (sequence != pos + count + offset) {
+                break;
+            }
+        }
+
+        if (count == 0) {
+            const w_mpmc_cell_t * cell = &queue->cells[pos % queue->size];
+            const size_t sequence = __atomic_load_n(&cell->sequence, __ATOMIC_ACQUIRE);
+
+            // The slot is still being used by the previous round: full (push) or empty (pop)
+            if ((long)(sequence - (pos + offset)) < 0) {
+                return 0;
+            }
+
+            // Another thread took the position
+            pos = mpmc_queue_load(position);
+        } else if (__atomic_compare_exchange_n(position, &pos, pos + count, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            *first = pos;
+            return count;
+        }
+    }
+}
+
+/**
+ * @brief Inserts up to count elements, without waking the consumers.
+ */
+static size_t mpmc_queue_try_push(w_mpmc_queue_t * queue, void ** data, size_t count) {
+    size_t first;
+    size_t i;
+
+    if (count = mpmc_queue_claim(queue, &queue->push_pos, 0, count, &first), count == 0) {
+        return 0;
+    }
+
+    for (i = 0; i < count; i++) {
+        w_mpmc_cell_t * cell = &queue->cells[(first + i) % queue->size];
+        cell->data = data[i];
+        __atomic_store_n(&cell->sequence, first + i + 1, __ATOMIC_RELEASE);
+    }
+
+    return count;
+}
+
+/**
+ * @brief Retrieves up to max elements, without waking the producers.
+ */
+static size_t mpmc_queue_try_pop(w_mpmc_queue_t * queue, void ** data, size_t max) {
+    size_t first;
+    size_t count;
+    size_t i;
+
+    if (count = mpmc_queue_claim(queue, &queue->pop_pos, 1, max, &first), count == 0) {
+        return 0;
+    }
+
+    for (i = 0; i < count; i++) {
+        w_mpmc_cell_t * cell = &queue->cells[(first + i) % queue->size];
+        data[i] = cell->data;
+        __atomic_store_n(&cell->sequence, first + i + queue->size, __ATOMIC_RELEASE);
+    }
+
+    return count;
+}
+
+size_t mpmc_queue_push_batch(w_mpmc_queue_t * queue, void ** data, size_t count) {
+    if (count = mpmc_queue_try_push(queue, data, count), count > 0) {
+        mpmc_queue_wake(queue, &queue->pop_waiters, &queue->available, count > 1);
+    }
+
+    return count;
+}
+
+int mpmc_queue_push(w_mpmc_queue_t * queue, void * data) {
+    return mpmc_queue_push_batch(queue, &data, 1) == 1 ? 0 : -1;
+}
+
+int mpmc_queue_push_block(w_mpmc_queue_t * queue, void * data) {
+    int i;
+
+    for (i = 0; i < MPMC_QUEUE_SPIN; i++) {
+        if (mpmc_queue_push(queue, data) == 0) {
+            return 0;
+        }
+    }
+
+    mpmc_queue_wait_start(&queue->push_waiters);
+    w_mutex_lock(&queue->mutex);
+
+    while (mpmc_queue_try_push(queue, &data, 1) == 0) {
+        w_cond_wait(&queue->available_not_full, &queue->mutex);
+    }
+
+    w_mutex_unlock(&queue->mutex);
+    mpmc_queue_wait_end(&queue->push_waiters);
+    mpmc_queue_wake(queue, &queue->pop_waiters, &queue->available, 0);
+
+    return 0;
+}
+
+size_t mpmc_queue_pop_batch(w_mpmc_queue_t * queue, void ** data, size_t max) {
+    size_t count;
+
+    if (count = mpmc_queue_try_pop(queue, data, max), count > 0) {
+        mpmc_queue_wake(queue, &queue->push_waiters, &queue->available_not_full, count > 1);
+    }
+
+    return count;
+}
+
+void * mpmc_queue_pop(w_mpmc_queue_t * queue) {
+    void * data;
+
+    return mpmc_queue_pop_batch(queue, &data, 1) == 1 ? data : NULL;
+}
+
+size_t mpmc_queue_pop_batch_block(w_mpmc_queue_t * queue, void ** data, size_t max) {
+    size_t count;
+    int i;
+
+    for (i = 0; i < MPMC_QUEUE_SPIN; i++) {
+        if (count = mpmc_queue_pop_batch(queue, data, max), count > 0) {
+            return count;
+        }
+    }
+
+    mpmc_queue_wait_start(&queue->pop_waiters);
+    w_mutex_lock(&queue->mutex);
+
+    while (count = mpmc_queue_try_pop(queue, data, max), count == 0) {
+        w_cond_wait(&queue->available, &queue->mutex);
+    }
+
+    w_mutex_unlock(&queue->mutex);
+    mpmc_queue_wait_end(&queue->pop_waiters);
+    mpmc_queue_wake(queue, &queue->push_waiters, &queue->available_not_full, count > 1);
+
+    return count;
+}
+
+void * mpmc_queue_pop_block(w_mpmc_queue_t * queue) {
+    void * data;
+
+    mpmc_queue_pop_batch_block(queue, &data, 1);
+    return data;
+}
+
+void * mpmc_queue_pop_timedwait(w_mpmc_queue_t * queue, const struct timespec * abstime) {
+    void * data;
+
+    if (data = mpmc_queue_pop(queue), data) {
+        return data;
+    }
+
+    mpmc_queue_wait_start(&queue->pop_waiters);
+    w_mutex_lock(&queue->mutex);
+
+    while (mpmc_queue_try_pop(queue, &data, 1) == 0) {
+        if (pthread_cond_timedwait(&queue->available, &queue->mutex, abstime) != 0) {
+            data = NULL;
+            break;
+        }
+    }
+
+    w_mutex_unlock(&queue->mutex);
+    mpmc_queue_wait_end(&queue->pop_waiters);
+
+    if (data) {
+        mpmc_queue_wake(queue, &queue->push_waiters, &queue->available_not_full, 0);
+    }
+
+    return data;
+}
@@ -15,6 +15,7 @@
 #include "../sharedDefs.hpp"
 #include "IURLRequest.hpp"
 #include "componentsHelper.hpp"
+#include "rangeDownloader.hpp"
 #include "updaterContext.hpp"
 #include "utils/chainOfResponsability.hpp"
 #include <algorithm>
@@ -26,6 +27,7 @@
 #include <stdexcept>
 #include <string>
 #include <thread>
+#include <unordered_set>
 #include <utility>
 
 static const unsigned int TOO_MANY_REQUESTS_DEFAULT_RETRY_TIME {90};
@@ -39,7 +41,8 @@ enum class CtiErrorType
 {
     NO_ERROR,
     GENERIC_SERVER_ERROR,
-    TOO_MANY_REQUESTS
+    TOO_MANY_REQUESTS,
+    RANGE_NOT_SATISFIABLE
 };
 
 /**
@@ -185,11 +188,13 @@ protected:
      * @param onSuccess Callback on success download.
      * @param queryParameters Parameters to the GET query.
      * @param outputFilepath File where to store the downloaded content.
+     * @param headers Headers of the GET query.
      */
     void performQueryWithRetry(const std::string& URL,
                                const std::function<void(const std::string&)>& onSuccess,
                                const std::string& queryParameters = "",
-                               const std::string& outputFilepath = "") const
+                               const std::string& outputFilepath = "",
+                               const std::unordered_set<std::string>& headers = DEFAULT_HEADERS) const
     {
         // On download error routine.
         const auto onError {
@@ -202,6 +207,11 @@ protected:
                     throw cti_server_error {exceptionMessage, CtiErrorType::TOO_MANY_REQUESTS};
                 }
 
+                if (statusCode == HTTP_RANGE_NOT_SATISFIABLE)
+                {
+                    throw cti_server_error {exceptionMessage, CtiErrorType::RANGE_NOT_SATISFIABLE};
+                }
+
                 if (statusCode >= 500 && statusCode <= 599)
                 {
                     throw cti_server_error {exceptionMessage, CtiErrorType::GENERIC_SERVER_ERROR};
@@ -222,7 +232,7 @@ protected:
                                  onSuccess,
                                  onError,
                                  outputFilepath,
-                                 DEFAULT_HEADERS,
+                                 headers,
                                  {},
                                  m_spUpdaterContext->spUpdaterBaseContext->httpUserAgent);
                 return;
@@ -260,6 +270,12 @@ protected:
                         break;
                     }
 
+                    case CtiErrorType::RANGE_NOT_SATISFIABLE:
+                    {
+                        // Not retried: The requested range is past the end of the content.
+                        throw;
+                    }
+
                     // LCOV_EXCL_START
                     default:
                         throw std::runtime_error {"Invalid CTI error type"};
@@ -17,8 +17,11 @@
 #include "IURLRequest.hpp"
 #include "updaterContext.hpp"
 #include <algorithm>
+#include <future>
 #include <sstream>
 #include <string>
+#include <utility>
+#include <vector>
 
 /**
  * @class CtiOffsetDownloader
@@ -59,6 +62,11 @@ private:
         }
         const auto& consumerLastOffset {ctiParameters.lastOffset.value()};
 
+        // Number of pages downloaded at the same time.
+        const auto connections {std::max(context.spUpdaterBaseContext->configData.value(
+                                              "downloadConnections", DEFAULT_DOWNLOAD_CONNECTIONS),
+                                          1u)};
+
         // Iterate until the current offset is equal to the consumer offset.
         auto pathsArray = nlohmann::json::array();
         while (context.currentOffset < consumerLastOffset)
@@ -72,22 +80,51 @@ private:
             // Amount of offsets to download on each query.
             constexpr auto OFFSETS_DELTA {1000};
 
-            // Calculate the offset to download
-            const auto toOffset {std::min(consumerLastOffset, context.currentOffset + OFFSETS_DELTA)};
+            // Download the next pages concurrently, each one into its own file.
+            std::vector<std::pair<int, std::string>> pages;
+            std::vector<std::future<void>> downloads;
+            auto fromOffset {context.currentOffset};
+            while (fromOffset < consumerLastOffset && downloads.size() < connections)
+            {
+                // Calculate the offset to download
+                const auto toOffset {std::min(consumerLastOffset, fromOffset + OFFSETS_DELTA)};
+
+                // full path where the content will be saved.
+                std::ostringstream filePathStream;
+                filePathStream << m_outputFolder << "/" << toOffset << "-" << m_fileName;
+                pages.emplace_back(toOffset, filePathStream.str());
+
+                // Download the content.
+                downloads.push_back(std::async(std::launch::async,
+                                               [this, fromOffset, toOffset, fullFilePath = pages.back().second]()
+                                               { downloadContent(fromOffset, toOffset, fullFilePath); }));
+                fromOffset = toOffset;
+            }
 
-            // full path where the content will be saved.
-            std::ostringstream filePathStream;
-            filePathStream << m_outputFolder << "/" << toOffset << "-" << m_fileName;
-            const std::string fullFilePath = filePathStream.str();
+            // Wait for all the downloads, so none is left running if one of them fails.
+            for (auto& download : downloads)
+            {
+                download.wait();
+            }
+            for (auto& download : downloads)
+            {
+                download.get();
+            }
 
-            // Download the content.
-            downloadContent(toOffset, fullFilePath, context);
+            if (stopCondition->check())
+            {
+                logWarn(WM_CONTENTUPDATER, "The offsets download has been interrupted.");
+                return;
+            }
 
-            // Update the current offset.
-            context.currentOffset = toOffset;
+            for (auto& [toOffset, fullFilePath] : pages)
+            {
+                // Update the current offset.
+                context.currentOffset = toOffset;
 
-            // Save the path of the downloaded content in a temporary variable.
-            pathsArray.push_back(fullFilePath);
+                // Save the path of the downloaded content in a temporary variable.
+                pathsArray.push_back(std::move(fullFilePath));
+            }
         }
 
         // Commit changes.
@@ -118,14 +155,15 @@ private:
     /**
      * @brief Download the content from the API.
      *
+     * @param fromOffset start offset to download.
      * @param toOffset end offset to download.
      * @param fullFilePath full path where the content will be saved.
      */
-    void downloadContent(int toOffset, const std::string& fullFilePath, const UpdaterContext& context) const
+    void downloadContent(int fromOffset, int toOffset, const std::string& fullFilePath) const
     {
         // Define the parameters for the request.
         const auto queryParameters =
-            "/changes?from_offset=" + std::to_string(context.currentOffset) + "&to_offset=" + std::to_string(toOffset);
+            "/changes?from_offset=" + std::to_string(fromOffset) + "&to_offset=" + std::to_string(toOffset);
 
         // Empty on download success routine.
         const auto onSuccess {[]([[maybe_unused]] const std::string& data) {
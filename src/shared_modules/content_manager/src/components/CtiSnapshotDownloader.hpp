@@ -15,6 +15,7 @@
 #include "../sharedDefs.hpp"
 #include "CtiDownloader.hpp"
 #include "IURLRequest.hpp"
+#include "rangeDownloader.hpp"
 #include "updaterContext.hpp"
 #include <filesystem>
 #include <string>
@@ -60,8 +61,38 @@ private:
 
         logDebug2(WM_CONTENTUPDATER, "Downloading snapshot from '%s'", lastSnapshotURL.string().c_str());
 
-        // Download the content.
-        performQueryWithRetry(lastSnapshotURL, onSuccess, "", outputFilepath);
+        const auto& configData {context.spUpdaterBaseContext->configData};
+        const auto connections {configData.value("downloadConnections", DEFAULT_DOWNLOAD_CONNECTIONS)};
+        if (connections <= 1)
+        {
+            // Download the content.
+            performQueryWithRetry(lastSnapshotURL, onSuccess, "", outputFilepath);
+            return;
+        }
+
+        // Download the content in chunks, through several connections.
+        const auto query {[this, &lastSnapshotURL](const std::string& rangeHeader, const std::string& chunkFilepath)
+                          {
+                              auto headers {DEFAULT_HEADERS};
+                              headers.insert(rangeHeader);
+                              try
+                              {
+                                  performQueryWithRetry(
+                                      lastSnapshotURL, [](const std::string&) {}, "", chunkFilepath, headers);
+                              }
+                              catch (const cti_server_error& e)
+                              {
+                                  if (CtiErrorType::RANGE_NOT_SATISFIABLE == e.type())
+                                  {
+                                      return false;
+                                  }
+                                  throw;
+                              }
+                              return true;
+                          }};
+        RangeDownloader(query, connections, configData.value("downloadChunkSize", DEFAULT_DOWNLOAD_CHUNK_SIZE))
+            .download(lastSnapshotURL, outputFilepath, *context.spUpdaterBaseContext);
+        onSuccess("");
     }
 
 public:
@@ -34,6 +34,8 @@
 class XZDecompressor final : public AbstractHandler<std::shared_ptr<UpdaterContext>>
 {
 private:
+    bool m_streamDecompression {false};
+
     /**
      * @brief Decompress the content and save it in the context.
      *
@@ -54,6 +56,18 @@ private:
             Utils::replaceFirst(
                 outputPath, (outputFolder / DOWNLOAD_FOLDER).string(), (outputFolder / CONTENTS_FOLDER).string());
 
+            if (m_streamDecompression)
+            {
+                // Keep the compressed file: The consumer decompresses it while reading it.
+                logDebug2(WM_CONTENTUPDATER,
+                          "Moving '%s' into '%s' for stream decompression",
+                          inputPath.string().c_str(),
+                          outputPath.c_str());
+                std::filesystem::rename(inputPath, outputPath);
+                path = std::move(outputPath);
+                continue;
+            }
+
             // Remove .xz extension.
             outputPath = Utils::rightTrim(outputPath, inputPath.extension());
 
@@ -68,6 +82,17 @@ private:
     }
 
 public:
+    /**
+     * @brief Construct a new XZDecompressor object.
+     *
+     * @param streamDecompression If true, the compressed file is moved to the contents folder as is, so the consumer
+     * can decompress it while reading it, without storing the decompressed content.
+     */
+    explicit XZDecompressor(bool streamDecompression = false)
+        : m_streamDecompression(streamDecompression)
+    {
+    }
+
     /**
      * @brief Decompress the content.
      *
@@ -34,6 +34,7 @@ namespace Components
     {
         static const std::string CURRENT_OFFSET {"current_offset"};             ///< Database column name for offsets.
         static const std::string DOWNLOADED_FILE_HASH {"downloaded_file_hash"}; ///< Database column name for hashes.
+        static const std::string DOWNLOAD_CHUNKS {"download_chunks"};           ///< Database column name for chunks.
     }                                                                           // namespace Columns
 
     /**
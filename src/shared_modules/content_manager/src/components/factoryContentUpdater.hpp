@@ -17,10 +17,13 @@
 #include "factoryDecompressor.hpp"
 #include "factoryDownloader.hpp"
 #include "factoryVersionUpdater.hpp"
+#include "offsetsCoalescer.hpp"
 #include "pubSubPublisher.hpp"
+#include "skipStep.hpp"
 #include "updaterContext.hpp"
 #include "utils/chainOfResponsability.hpp"
 #include <memory>
+#include <stdexcept>
 
 /**
  * @class FactoryContentUpdater
@@ -31,6 +34,31 @@
  */
 class FactoryContentUpdater final
 {
+private:
+    /**
+     * @brief Creates the offsets coalescer based on the coalesceOffsets value.
+     *
+     * @param config Configurations.
+     * @return std::shared_ptr<AbstractHandler<std::shared_ptr<UpdaterContext>>>
+     */
+    static std::shared_ptr<AbstractHandler<std::shared_ptr<UpdaterContext>>>
+    createOffsetsCoalescer(const nlohmann::json& config)
+    {
+        if (!config.contains("coalesceOffsets") || !config.at("coalesceOffsets").get<bool>())
+        {
+            return std::make_shared<SkipStep>();
+        }
+
+        // The coalescer reads the offsets as plain JSON files.
+        if (config.contains("streamDecompression") && config.at("streamDecompression").get<bool>())
+        {
+            throw std::invalid_argument {"'coalesceOffsets' can't be used along with 'streamDecompression'"};
+        }
+
+        logDebug1(WM_CONTENTUPDATER, "Offsets coalescer created");
+        return std::make_shared<OffsetsCoalescer>();
+    }
+
 public:
     /**
      * @brief Creates the corresponding instances for the orchestration in charge of processing certain contents based
@@ -45,6 +73,7 @@ public:
 
         auto factoryDownloader {FactoryDownloader::create(config)};
         auto factoryDecompressor {FactoryDecompressor::create(config)};
+        auto factoryCoalescer {createOffsetsCoalescer(config)};
         auto factoryPublisher {std::make_shared<PubSubPublisher>()};
         auto factoryVersionUpdater {FactoryVersionUpdater::create(config)};
         auto factoryCleaner {FactoryCleaner::create(config)};
@@ -54,6 +83,7 @@ public:
 
         // If there is new content to process, create the updater chain.
         updaterChain->setNext(factoryDecompressor)
+            ->setNext(factoryCoalescer)
             ->setNext(factoryPublisher)
             ->setNext(factoryVersionUpdater)
             ->setNext(factoryCleaner);
@@ -72,14 +72,17 @@ public:
 
         logDebug1(WM_CONTENTUPDATER, "Creating '%s' decompressor", decompressorType.c_str());
 
+        const auto streamDecompression {config.contains("streamDecompression") &&
+                                        config.at("streamDecompression").get<bool>()};
+
         if ("xz" == decompressorType)
         {
-            return std::make_shared<XZDecompressor>();
+            return std::make_shared<XZDecompressor>(streamDecompression);
         }
 
         if ("gzip" == decompressorType)
         {
-            return std::make_shared<GzipDecompressor>();
+            return std::make_shared<GzipDecompressor>(streamDecompression);
         }
 
         if ("zip" == decompressorType)
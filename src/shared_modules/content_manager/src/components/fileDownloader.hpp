@@ -18,6 +18,7 @@
 #include "componentsHelper.hpp"
 #include "hashHelper.h"
 #include "json.hpp"
+#include "rangeDownloader.hpp"
 #include "stringHelper.h"
 #include "updaterContext.hpp"
 #include <array>
@@ -70,8 +71,41 @@ private:
 
         // Download and store file.
         logDebug2(WM_CONTENTUPDATER, "Downloading file from '%s'", url.string().c_str());
-        HTTPRequest::instance().download(
-            HttpURL(url), outputFilePath, onError, {}, {}, context.spUpdaterBaseContext->httpUserAgent);
+        const auto& configData {context.spUpdaterBaseContext->configData};
+        if (const auto connections {configData.value("downloadConnections", DEFAULT_DOWNLOAD_CONNECTIONS)};
+            connections > 1)
+        {
+            // Download the file in chunks, through several connections.
+            const auto query {
+                [&url, &context](const std::string& rangeHeader, const std::string& chunkFilepath)
+                {
+                    auto rangeSatisfiable {true};
+                    HTTPRequest::instance().get(
+                        HttpURL(url),
+                        [](const std::string&) {},
+                        [&rangeSatisfiable](const std::string& errorMessage, const long errorCode)
+                        {
+                            if (HTTP_RANGE_NOT_SATISFIABLE == errorCode)
+                            {
+                                rangeSatisfiable = false;
+                                return;
+                            }
+                            throw std::runtime_error {"(" + std::to_string(errorCode) + ") " + errorMessage};
+                        },
+                        chunkFilepath,
+                        {rangeHeader},
+                        {},
+                        context.spUpdaterBaseContext->httpUserAgent);
+                    return rangeSatisfiable;
+                }};
+            RangeDownloader(query, connections, configData.value("downloadChunkSize", DEFAULT_DOWNLOAD_CHUNK_SIZE))
+                .download(url.string(), outputFilePath, *context.spUpdaterBaseContext);
+        }
+        else
+        {
+            HTTPRequest::instance().download(
+                HttpURL(url), outputFilePath, onError, {}, {}, context.spUpdaterBaseContext->httpUserAgent);
+        }
 
         // Just process the new file if the hash is different from the last one.
         auto downloadFileHash {Utils::asciiToHex(Utils::hashFile(outputFilePath))};
@@ -33,6 +33,8 @@
 class GzipDecompressor final : public AbstractHandler<std::shared_ptr<UpdaterContext>>
 {
 private:
+    bool m_streamDecompression {false};
+
     /**
      * @brief Decompress the compressed content and update the context paths.
      *
@@ -53,6 +55,18 @@ private:
             Utils::replaceFirst(
                 outputPath, (outputFolder / DOWNLOAD_FOLDER).string(), (outputFolder / CONTENTS_FOLDER).string());
 
+            if (m_streamDecompression)
+            {
+                // Keep the compressed file: The consumer decompresses it while reading it.
+                logDebug2(WM_CONTENTUPDATER,
+                          "Moving '%s' into '%s' for stream decompression",
+                          inputPath.string().c_str(),
+                          outputPath.c_str());
+                std::filesystem::rename(inputPath, outputPath);
+                path = std::move(outputPath);
+                continue;
+            }
+
             // Remove .gz extension.
             outputPath = Utils::rightTrim(outputPath, inputPath.extension());
 
@@ -67,6 +81,17 @@ private:
     }
 
 public:
+    /**
+     * @brief Construct a new GzipDecompressor object.
+     *
+     * @param streamDecompression If true, the compressed file is moved to the contents folder as is, so the consumer
+     * can decompress it while reading it, without storing the decompressed content.
+     */
+    explicit GzipDecompressor(bool streamDecompression = false)
+        : m_streamDecompression(streamDecompression)
+    {
+    }
+
     /**
      * @brief Decompress the GZ content and passes the control to the next step on the chain.
      *
@@ -0,0 +1,221 @@
+/*
+ * Wazuh Content Manager
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _OFFSETS_COALESCER_HPP
+#define _OFFSETS_COALESCER_HPP
+
+#include "../sharedDefs.hpp"
+#include "componentsHelper.hpp"
+#include "json.hpp"
+#include "updaterContext.hpp"
+#include "utils/chainOfResponsability.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+constexpr auto DEFAULT_COALESCED_FILES {10u};
+
+/**
+ * @class OffsetsCoalescer
+ *
+ * @brief Class in charge of merging the downloaded offsets per resource as a step of a chain of responsibility.
+ *
+ * @details The offset files are merged in batches: Within each batch, the changes of the same resource are folded into
+ * a single change, so a resource updated many times is applied once. The updates that follow a creation are applied
+ * to its payload, consecutive updates are concatenated into one update and a creation or deletion replaces the
+ * previous changes. Each coalesced change keeps the greatest offset it covers, so the consumer must apply each
+ * coalesced file as a whole before storing its offset. The published data is flagged with "coalesced": true.
+ */
+class OffsetsCoalescer final : public AbstractHandler<std::shared_ptr<UpdaterContext>>
+{
+private:
+    const unsigned int m_filesPerBatch;
+
+    /**
+     * @brief Folds a change into the pending change of the same resource, if possible.
+     *
+     * @param pending Pending change of the resource.
+     * @param change New change of the resource.
+     * @return true If the change was folded.
+     */
+    static bool fold(nlohmann::json& pending, const nlohmann::json& change)
+    {
+        const auto& type {change.at("type").get_ref<const std::string&>()};
+        const auto& pendingType {pending.at("type").get_ref<const std::string&>()};
+
+        if ("create" == type || "delete" == type)
+        {
+            // The new change replaces the resource as a whole.
+            pending = change;
+            return true;
+        }
+
+        if ("update" != type || "delete" == pendingType)
+        {
+            return false;
+        }
+
+        if ("create" == pendingType)
+        {
+            pending.at("payload").patch_inplace(change.at("operations"));
+        }
+        else
+        {
+            auto& operations {pending.at("operations")};
+            operations.insert(operations.end(), change.at("operations").begin(), change.at("operations").end());
+        }
+        pending["offset"] = change.at("offset");
+        if (change.contains("version"))
+        {
+            pending["version"] = change.at("version");
+        }
+        return true;
+    }
+
+    /**
+     * @brief Merges a batch of offset files into a single file.
+     *
+     * @param paths Offset files of the batch, in offset order.
+     * @param outputPath File where the coalesced changes are stored.
+     * @return size_t Number of changes of the batch.
+     */
+    static size_t coalesce(const std::vector<std::string>& paths, const std::filesystem::path& outputPath)
+    {
+        size_t changesCount {0};
+        auto changes = nlohmann::json::array();
+        std::unordered_map<std::string, size_t> pendingChanges;
+
+        for (const auto& path : paths)
+        {
+            std::ifstream file {path};
+            auto content = nlohmann::json::parse(file);
+
+            for (auto& change : content.at("data"))
+            {
+                ++changesCount;
+                const auto& resource {change.at("resource").get_ref<const std::string&>()};
+
+                if (const auto it {pendingChanges.find(resource)};
+                    it != pendingChanges.end() && fold(changes.at(it->second), change))
+                {
+                    continue;
+                }
+
+                pendingChanges[resource] = changes.size();
+                changes.push_back(std::move(change));
+            }
+        }
+
+        auto output = nlohmann::json::object();
+        output["data"] = std::move(changes);
+        std::ofstream outputFile {outputPath};
+        outputFile << output;
+        if (!outputFile)
+        {
+            throw std::runtime_error {"Unable to write '" + outputPath.string() + "'"};
+        }
+
+        return changesCount;
+    }
+
+    /**
+     * @brief Coalesces the offset files of the context.
+     *
+     * @param context Updater context.
+     */
+    void coalesce(UpdaterContext& context) const
+    {
+        const auto& paths {context.data.at("paths")};
+
+        auto coalescedPaths = nlohmann::json::array();
+        for (size_t first {0}; first < paths.size(); first += m_filesPerBatch)
+        {
+            std::vector<std::string> batch;
+            for (auto index {first}; index < std::min<size_t>(first + m_filesPerBatch, paths.size()); ++index)
+            {
+                batch.push_back(paths.at(index).get<std::string>());
+            }
+
+            // The coalesced file is named after the last file of the batch, whose name starts with the last offset.
+            const std::filesystem::path lastPath {batch.back()};
+            const auto outputPath {lastPath.parent_path() / ("coalesced-" + lastPath.filename().string())};
+
+            const auto changesCount {coalesce(batch, outputPath)};
+            logDebug2(WM_CONTENTUPDATER,
+                      "Coalesced %zu offsets from %zu files into '%s'",
+                      changesCount,
+                      batch.size(),
+                      outputPath.string().c_str());
+
+            for (const auto& path : batch)
+            {
+                std::filesystem::remove(path);
+            }
+            coalescedPaths.push_back(outputPath.string());
+        }
+
+        context.data.at("paths") = std::move(coalescedPaths);
+        context.data["coalesced"] = true;
+    }
+
+public:
+    /**
+     * @brief Class constructor.
+     *
+     * @param filesPerBatch Number of offset files merged into each coalesced file.
+     */
+    explicit OffsetsCoalescer(const unsigned int filesPerBatch = DEFAULT_COALESCED_FILES)
+        : m_filesPerBatch(std::max(filesPerBatch, 1u))
+    {
+    }
+
+    /**
+     * @brief Coalesces the downloaded offsets.
+     *
+     * @param context Updater context.
+     * @return std::shared_ptr<UpdaterContext>
+     */
+    std::shared_ptr<UpdaterContext> handleRequest(std::shared_ptr<UpdaterContext> context) override
+    {
+        logDebug1(WM_CONTENTUPDATER, "OffsetsCoalescer - Starting process");
+        constexpr auto COMPONENT_NAME {"OffsetsCoalescer"};
+
+        if ("offsets" != context->data.at("type") || context->data.at("paths").empty())
+        {
+            return AbstractHandler<std::shared_ptr<UpdaterContext>>::handleRequest(std::move(context));
+        }
+
+        try
+        {
+            coalesce(*context);
+        }
+        catch (const std::exception& e)
+        {
+            // Push error state.
+            Components::pushStatus(COMPONENT_NAME, Components::Status::STATUS_FAIL, *context);
+
+            throw std::runtime_error("Offsets coalescing failed: " + std::string(e.what()));
+        }
+
+        // Push success state.
+        Components::pushStatus(COMPONENT_NAME, Components::Status::STATUS_OK, *context);
+
+        return AbstractHandler<std::shared_ptr<UpdaterContext>>::handleRequest(std::move(context));
+    }
+};
+
+#endif // _OFFSETS_COALESCER_HPP
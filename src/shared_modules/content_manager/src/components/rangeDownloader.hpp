@@ -0,0 +1,320 @@
+/*
+ * Wazuh Content Manager
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _RANGE_DOWNLOADER_HPP
+#define _RANGE_DOWNLOADER_HPP
+
+#include "../sharedDefs.hpp"
+#include "componentsHelper.hpp"
+#include "hashHelper.h"
+#include "json.hpp"
+#include "stringHelper.h"
+#include "updaterContext.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+constexpr auto HTTP_RANGE_NOT_SATISFIABLE {416};
+constexpr auto DEFAULT_DOWNLOAD_CONNECTIONS {1u};
+constexpr size_t DEFAULT_DOWNLOAD_CHUNK_SIZE {16 * 1024 * 1024};
+
+/**
+ * @class RangeDownloader
+ *
+ * @brief Class in charge of downloading a file through several concurrent HTTP range requests.
+ *
+ * @details The content size isn't known beforehand, so the chunks are requested in order until one of them is shorter
+ * than the chunk size or past the end of the content. Each chunk is stored in its own file and its hash is recorded in
+ * the updater database, so a download interrupted by a restart resumes from the chunks that are still intact. If the
+ * server doesn't support range requests, the first request receives the whole content.
+ */
+class RangeDownloader final
+{
+public:
+    /**
+     * @brief Performs a GET query of the content with the given "Range" header, storing the response in a file.
+     *
+     * @details Returns false if the server answers that the range is past the end of the content.
+     */
+    using Query = std::function<bool(const std::string& rangeHeader, const std::string& outputFilepath)>;
+
+private:
+    Query m_query;
+    const unsigned int m_connections;
+    const size_t m_chunkSize;
+
+    /**
+     * @brief Reads the record of a previous download of the same content, or creates an empty one.
+     *
+     * @param key Database key of the record.
+     * @param url URL of the content.
+     * @param context Updater base context.
+     * @return nlohmann::json Download record.
+     */
+    nlohmann::json loadRecord(const std::string& key, const std::string& url, UpdaterBaseContext& context) const
+    {
+        nlohmann::json record;
+        if (std::string value;
+            context.spRocksDB && context.spRocksDB->get(key, value, Components::Columns::DOWNLOAD_CHUNKS))
+        {
+            record = nlohmann::json::parse(value, nullptr, false);
+        }
+
+        if (!record.is_object() || record.value("url", "") != url || record.value("chunkSize", 0u) != m_chunkSize)
+        {
+            record = nlohmann::json::object();
+            record["url"] = url;
+            record["chunkSize"] = m_chunkSize;
+            record["chunks"] = nlohmann::json::object();
+        }
+
+        return record;
+    }
+
+    /**
+     * @brief Stores the download record, so the download can be resumed after a restart.
+     *
+     * @param key Database key of the record.
+     * @param record Download record.
+     * @param context Updater base context.
+     */
+    void storeRecord(const std::string& key, const nlohmann::json& record, UpdaterBaseContext& context) const
+    {
+        if (context.spRocksDB)
+        {
+            context.spRocksDB->put(key, record.dump(), Components::Columns::DOWNLOAD_CHUNKS);
+        }
+    }
+
+    /**
+     * @brief Removes the download record and the chunk files.
+     *
+     * @param key Database key of the record.
+     * @param chunksFolder Folder with the chunk files.
+     * @param context Updater base context.
+     */
+    void clear(const std::string& key, const std::filesystem::path& chunksFolder, UpdaterBaseContext& context) const
+    {
+        std::filesystem::remove_all(chunksFolder);
+        if (context.spRocksDB)
+        {
+            context.spRocksDB->delete_(key, Components::Columns::DOWNLOAD_CHUNKS);
+        }
+    }
+
+public:
+    /**
+     * @brief Class constructor.
+     *
+     * @param query Function that performs each range query.
+     * @param connections Number of concurrent queries.
+     * @param chunkSize Size, in bytes, of each range.
+     */
+    RangeDownloader(Query query, const unsigned int connections, const size_t chunkSize)
+        : m_query(std::move(query))
+        , m_connections(std::max(connections, 1u))
+        , m_chunkSize(chunkSize)
+    {
+        if (m_chunkSize == 0)
+        {
+            throw std::invalid_argument {"Invalid download chunk size: 0"};
+        }
+    }
+
+    /**
+     * @brief Downloads the content into the given file.
+     *
+     * @param url URL of the content. Used to discard the chunks of a previous download of another content.
+     * @param outputFilepath File where to store the content.
+     * @param context Updater base context.
+     */
+    void download(const std::string& url, const std::filesystem::path& outputFilepath, UpdaterBaseContext& context)
+    {
+        const auto key {outputFilepath.filename().string()};
+        const auto chunksFolder {std::filesystem::path(outputFilepath.string() + ".chunks")};
+
+        auto record = loadRecord(key, url, context);
+        if (record.at("chunks").empty())
+        {
+            std::filesystem::remove_all(chunksFolder);
+        }
+        else
+        {
+            logDebug1(WM_CONTENTUPDATER,
+                      "Resuming the download of '%s' from %zu chunks",
+                      key.c_str(),
+                      record.at("chunks").size());
+        }
+        std::filesystem::create_directories(chunksFolder);
+
+        std::mutex mutex;
+        size_t nextChunk {0};
+        size_t endChunk {std::numeric_limits<size_t>::max()};
+        size_t dataEndChunk {0};
+        std::exception_ptr error;
+
+        // Downloads a chunk, unless it was downloaded before and it's still intact, and returns its size.
+        const auto fetchChunk {
+            [&](const size_t index)
+            {
+                const auto chunkKey {std::to_string(index)};
+                const auto chunkFilepath {chunksFolder / chunkKey};
+                nlohmann::json previousChunk;
+                {
+                    std::scoped_lock lock {mutex};
+                    previousChunk = record.at("chunks").value(chunkKey, nlohmann::json::object());
+                }
+                if (!previousChunk.empty() && std::filesystem::exists(chunkFilepath) &&
+                    Utils::asciiToHex(Utils::hashFile(chunkFilepath)) == previousChunk.at("hash"))
+                {
+                    return previousChunk.at("size").get<size_t>();
+                }
+
+                std::filesystem::remove(chunkFilepath);
+                const auto first {index * m_chunkSize};
+                const auto rangeHeader {"Range: bytes=" + std::to_string(first) + "-" +
+                                        std::to_string(first + m_chunkSize - 1)};
+                if (!m_query(rangeHeader, chunkFilepath))
+                {
+                    return static_cast<size_t>(0);
+                }
+
+                if (!std::filesystem::exists(chunkFilepath))
+                {
+                    throw std::runtime_error {"Download of chunk " + chunkKey + " was interrupted"};
+                }
+
+                auto chunk = nlohmann::json::object();
+                const auto size {static_cast<size_t>(std::filesystem::file_size(chunkFilepath))};
+                chunk["size"] = size;
+                chunk["hash"] = Utils::asciiToHex(Utils::hashFile(chunkFilepath));
+
+                std::scoped_lock lock {mutex};
+                record.at("chunks")[chunkKey] = std::move(chunk);
+                storeRecord(key, record, context);
+                return size;
+            }};
+
+        // Updates the end of the content with the size of a chunk. Must be called with the mutex locked.
+        const auto registerChunk {[&](const size_t index, const size_t size)
+                                  {
+                                      if (size > m_chunkSize)
+                                      {
+                                          throw std::runtime_error {"Chunk " + std::to_string(index) +
+                                                                    " is larger than the requested range"};
+                                      }
+                                      if (size > 0)
+                                      {
+                                          dataEndChunk = std::max(dataEndChunk, index + 1);
+                                      }
+                                      if (size < m_chunkSize)
+                                      {
+                                          endChunk = std::min(endChunk, size == 0 ? index : index + 1);
+                                      }
+                                  }};
+
+        // The first chunk is downloaded alone to find out whether the server supports range requests.
+        const auto firstChunkSize {fetchChunk(nextChunk++)};
+        if (firstChunkSize > m_chunkSize)
+        {
+            logDebug1(WM_CONTENTUPDATER, "Range requests not supported, '%s' downloaded at once", key.c_str());
+            std::filesystem::rename(chunksFolder / "0", outputFilepath);
+            clear(key, chunksFolder, context);
+            return;
+        }
+        registerChunk(0, firstChunkSize);
+
+        const auto worker {[&]()
+                           {
+                               while (true)
+                               {
+                                   size_t index;
+                                   {
+                                       std::scoped_lock lock {mutex};
+                                       if (error || nextChunk >= endChunk || context.spStopCondition->check())
+                                       {
+                                           return;
+                                       }
+                                       index = nextChunk++;
+                                   }
+
+                                   try
+                                   {
+                                       const auto size {fetchChunk(index)};
+                                       std::scoped_lock lock {mutex};
+                                       registerChunk(index, size);
+                                   }
+                                   catch (...)
+                                   {
+                                       std::scoped_lock lock {mutex};
+                                       if (!error)
+                                       {
+                                           error = std::current_exception();
+                                       }
+                                       return;
+                                   }
+                               }
+                           }};
+
+        std::vector<std::thread> workers;
+        for (auto i {0u}; i < m_connections; ++i)
+        {
+            workers.emplace_back(worker);
+        }
+        for (auto& thread : workers)
+        {
+            thread.join();
+        }
+
+        // The downloaded chunks are kept, so the download is resumed in the next execution.
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+        if (context.spStopCondition->check())
+        {
+            throw std::runtime_error {"Download of '" + key + "' was interrupted"};
+        }
+
+        // A short chunk followed by data means the content changed during the download.
+        if (dataEndChunk > endChunk)
+        {
+            clear(key, chunksFolder, context);
+            throw std::runtime_error {"Content of '" + key + "' changed during the download"};
+        }
+
+        std::ofstream output {outputFilepath, std::ios::binary | std::ios::trunc};
+        for (size_t index {0}; index < endChunk; ++index)
+        {
+            std::ifstream chunk {chunksFolder / std::to_string(index), std::ios::binary};
+            output << chunk.rdbuf();
+        }
+        output.close();
+        if (!output)
+        {
+            throw std::runtime_error {"Unable to write '" + outputFilepath.string() + "'"};
+        }
+
+        clear(key, chunksFolder, context);
+    }
+};
+
+#endif // _RANGE_DOWNLOADER_HPP
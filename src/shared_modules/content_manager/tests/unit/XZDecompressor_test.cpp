@@ -162,3 +162,30 @@ TEST_F(XZDecompressorTest, DecompressTwoFilesOneInexistantThrows)
 
     EXPECT_EQ(m_spUpdaterContext->data, expectedData);
 }
+
+/**
+ * @brief Tests that, with stream decompression, the compressed file is moved to the contents folder as is.
+ *
+ */
+TEST_F(XZDecompressorTest, StreamDecompressionMovesCompressedFile)
+{
+    const auto streamInputFile {INPUT_FILES_FOLDER / "downloads" / "sample_stream.json.xz"};
+    const auto streamOutputFile {CONTENT_FOLDER / "sample_stream.json.xz"};
+    std::filesystem::copy_file(SAMPLE_A_INPUT_FILE, streamInputFile);
+    m_spUpdaterContext->data.at("paths").push_back(streamInputFile);
+
+    ASSERT_NO_THROW(XZDecompressor(true).handleRequest(m_spUpdaterContext));
+
+    nlohmann::json expectedData;
+    expectedData["paths"] = nlohmann::json::array();
+    expectedData["paths"].push_back(streamOutputFile);
+    expectedData["stageStatus"] = nlohmann::json::array();
+    expectedData["stageStatus"].push_back(OK_STATUS);
+    expectedData["type"] = DEFAULT_TYPE;
+    expectedData["offset"] = 0;
+
+    EXPECT_EQ(m_spUpdaterContext->data, expectedData);
+    EXPECT_TRUE(std::filesystem::exists(streamOutputFile));
+    EXPECT_FALSE(std::filesystem::exists(streamInputFile));
+    EXPECT_FALSE(std::filesystem::exists(SAMPLE_A_OUTPUT_FILE));
+}
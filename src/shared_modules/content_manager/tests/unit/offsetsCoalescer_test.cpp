@@ -0,0 +1,175 @@
+/*
+ * Wazuh Content Manager - Unit Tests
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "offsetsCoalescer_test.hpp"
+#include "offsetsCoalescer.hpp"
+#include "updaterContext.hpp"
+#include "gtest/gtest.h"
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+
+void OffsetsCoalescerTest::SetUp()
+{
+    auto spBaseContext {std::make_shared<UpdaterBaseContext>(m_spStopActionCondition)};
+    spBaseContext->contentsFolder = m_outputFolder;
+
+    m_spUpdaterContext = std::make_shared<UpdaterContext>();
+    m_spUpdaterContext->spUpdaterBaseContext = spBaseContext;
+    m_spUpdaterContext->data.at("type") = "offsets";
+
+    std::filesystem::create_directory(m_outputFolder);
+}
+
+void OffsetsCoalescerTest::TearDown()
+{
+    std::filesystem::remove_all(m_outputFolder);
+}
+
+void OffsetsCoalescerTest::addOffsetsFile(const std::string& fileName, const nlohmann::json& offsets)
+{
+    const auto filePath {m_outputFolder / fileName};
+    std::ofstream file {filePath};
+    file << nlohmann::json {{"data", offsets}};
+    m_spUpdaterContext->data.at("paths").push_back(filePath.string());
+}
+
+/**
+ * @brief Reads the offsets stored in a coalesced file.
+ *
+ * @param filePath Path to the file.
+ * @return nlohmann::json Offsets.
+ */
+static nlohmann::json readOffsets(const std::string& filePath)
+{
+    std::ifstream file {filePath};
+    return nlohmann::json::parse(file).at("data");
+}
+
+/**
+ * @brief Tests that the changes of each resource are folded into a single change.
+ *
+ */
+TEST_F(OffsetsCoalescerTest, CoalesceChanges)
+{
+    addOffsetsFile("2-offsets.json", R"(
+        [
+            {"offset": 1, "type": "create", "resource": "CVE-1", "payload": {"state": "PUBLISHED", "list": []}},
+            {"offset": 2, "type": "update", "resource": "CVE-2",
+             "operations": [{"op": "replace", "path": "/state", "value": "REJECTED"}]}
+        ])"_json);
+    addOffsetsFile("5-offsets.json", R"(
+        [
+            {"offset": 3, "type": "update", "resource": "CVE-1",
+             "operations": [{"op": "add", "path": "/list/-", "value": 1}]},
+            {"offset": 4, "type": "update", "resource": "CVE-2",
+             "operations": [{"op": "add", "path": "/new", "value": 1}]},
+            {"offset": 5, "type": "update", "resource": "CVE-1",
+             "operations": [{"op": "add", "path": "/list/-", "value": 2}]}
+        ])"_json);
+
+    EXPECT_NO_THROW(OffsetsCoalescer().handleRequest(m_spUpdaterContext));
+
+    const auto expectedPath {(m_outputFolder / "coalesced-5-offsets.json").string()};
+    ASSERT_EQ(m_spUpdaterContext->data.at("paths"), nlohmann::json::array({expectedPath}));
+    EXPECT_TRUE(m_spUpdaterContext->data.at("coalesced").get<bool>());
+    EXPECT_FALSE(std::filesystem::exists(m_outputFolder / "2-offsets.json"));
+    EXPECT_FALSE(std::filesystem::exists(m_outputFolder / "5-offsets.json"));
+
+    const auto expectedOffsets = R"(
+        [
+            {"offset": 5, "type": "create", "resource": "CVE-1", "payload": {"state": "PUBLISHED", "list": [1, 2]}},
+            {"offset": 4, "type": "update", "resource": "CVE-2",
+             "operations": [{"op": "replace", "path": "/state", "value": "REJECTED"},
+                            {"op": "add", "path": "/new", "value": 1}]}
+        ])"_json;
+    EXPECT_EQ(readOffsets(expectedPath), expectedOffsets);
+    EXPECT_EQ(m_spUpdaterContext->data.at("stageStatus"),
+              R"([{"stage":"OffsetsCoalescer","status":"ok"}])"_json);
+}
+
+/**
+ * @brief Tests that a creation or deletion replaces the previous changes, and that the updates following a deletion
+ * are kept apart.
+ *
+ */
+TEST_F(OffsetsCoalescerTest, ReplaceChanges)
+{
+    addOffsetsFile("4-offsets.json", R"(
+        [
+            {"offset": 1, "type": "update", "resource": "TID-1",
+             "operations": [{"op": "add", "path": "/a", "value": 1}]},
+            {"offset": 2, "type": "delete", "resource": "TID-1"},
+            {"offset": 3, "type": "update", "resource": "TID-1",
+             "operations": [{"op": "add", "path": "/b", "value": 1}]},
+            {"offset": 4, "type": "create", "resource": "TID-1", "payload": {"c": 1}}
+        ])"_json);
+
+    EXPECT_NO_THROW(OffsetsCoalescer().handleRequest(m_spUpdaterContext));
+
+    const auto expectedOffsets = R"(
+        [
+            {"offset": 2, "type": "delete", "resource": "TID-1"},
+            {"offset": 4, "type": "create", "resource": "TID-1", "payload": {"c": 1}}
+        ])"_json;
+    EXPECT_EQ(readOffsets(m_spUpdaterContext->data.at("paths").at(0)), expectedOffsets);
+}
+
+/**
+ * @brief Tests that the files are coalesced in batches.
+ *
+ */
+TEST_F(OffsetsCoalescerTest, CoalesceInBatches)
+{
+    for (auto offset {1}; offset <= 5; ++offset)
+    {
+        addOffsetsFile(std::to_string(offset) + "-offsets.json",
+                       nlohmann::json::array({{{"offset", offset}, {"type", "create"}, {"resource", "CVE-1"}}}));
+    }
+
+    EXPECT_NO_THROW(OffsetsCoalescer(2).handleRequest(m_spUpdaterContext));
+
+    const auto& paths {m_spUpdaterContext->data.at("paths")};
+    ASSERT_EQ(paths.size(), 3);
+    EXPECT_EQ(paths.at(0), (m_outputFolder / "coalesced-2-offsets.json").string());
+    EXPECT_EQ(paths.at(1), (m_outputFolder / "coalesced-4-offsets.json").string());
+    EXPECT_EQ(paths.at(2), (m_outputFolder / "coalesced-5-offsets.json").string());
+    EXPECT_EQ(readOffsets(paths.at(1)).at(0).at("offset"), 4);
+}
+
+/**
+ * @brief Tests that the contents other than offsets are left untouched.
+ *
+ */
+TEST_F(OffsetsCoalescerTest, SkipRawContent)
+{
+    m_spUpdaterContext->data.at("type") = "raw";
+    addOffsetsFile("content.json", nlohmann::json::array());
+
+    EXPECT_NO_THROW(OffsetsCoalescer().handleRequest(m_spUpdaterContext));
+
+    EXPECT_EQ(m_spUpdaterContext->data.at("paths").at(0), (m_outputFolder / "content.json").string());
+    EXPECT_FALSE(m_spUpdaterContext->data.contains("coalesced"));
+}
+
+/**
+ * @brief Tests the failure with an invalid offsets file.
+ *
+ */
+TEST_F(OffsetsCoalescerTest, InvalidOffsetsFile)
+{
+    m_spUpdaterContext->data.at("paths").push_back((m_outputFolder / "missing.json").string());
+
+    EXPECT_THROW(OffsetsCoalescer().handleRequest(m_spUpdaterContext), std::runtime_error);
+    EXPECT_EQ(m_spUpdaterContext->data.at("stageStatus"),
+              R"([{"stage":"OffsetsCoalescer","status":"fail"}])"_json);
+}
@@ -0,0 +1,60 @@
+/*
+ * Wazuh Content Manager - Unit Tests
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _OFFSETS_COALESCER_TEST_HPP
+#define _OFFSETS_COALESCER_TEST_HPP
+
+#include "conditionSync.hpp"
+#include "offsetsCoalescer.hpp"
+#include "updaterContext.hpp"
+#include "gtest/gtest.h"
+#include <filesystem>
+#include <memory>
+#include <string>
+
+/**
+ * @brief Runs unit tests for OffsetsCoalescer
+ *
+ */
+class OffsetsCoalescerTest : public ::testing::Test
+{
+protected:
+    OffsetsCoalescerTest() = default;
+    ~OffsetsCoalescerTest() override = default;
+
+    const std::filesystem::path m_outputFolder {std::filesystem::temp_directory_path() /
+                                                "OffsetsCoalescerTest"}; ///< Output test folder.
+    std::shared_ptr<UpdaterContext> m_spUpdaterContext;                  ///< Context used on tests.
+    std::shared_ptr<ConditionSync> m_spStopActionCondition {
+        std::make_shared<ConditionSync>(false)}; ///< Stop condition wrapper
+
+    /**
+     * @brief Set up routine for each test fixture.
+     *
+     */
+    void SetUp() override;
+
+    /**
+     * @brief Teardown routine for each test fixture.
+     *
+     */
+    void TearDown() override;
+
+    /**
+     * @brief Writes an offsets file and adds it to the context paths.
+     *
+     * @param fileName Name of the file.
+     * @param offsets Offsets stored in the file.
+     */
+    void addOffsetsFile(const std::string& fileName, const nlohmann::json& offsets);
+};
+
+#endif //_OFFSETS_COALESCER_TEST_HPP
@@ -0,0 +1,211 @@
+/*
+ * Wazuh Content Manager - Unit Tests
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "rangeDownloader_test.hpp"
+#include "componentsHelper.hpp"
+#include "rangeDownloader.hpp"
+#include "updaterContext.hpp"
+#include "utils/rocksDBWrapper.hpp"
+#include "gtest/gtest.h"
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+constexpr auto CONTENT {"This content is downloaded in chunks of four bytes."};
+constexpr auto CHUNK_SIZE {4};
+
+void RangeDownloaderTest::SetUp()
+{
+    m_spUpdaterBaseContext = std::make_shared<UpdaterBaseContext>(m_spStopActionCondition);
+    m_spUpdaterBaseContext->spRocksDB = std::make_unique<Utils::RocksDBWrapper>((m_outputFolder / "database").string());
+    m_spUpdaterBaseContext->spRocksDB->createColumn(Components::Columns::DOWNLOAD_CHUNKS);
+}
+
+void RangeDownloaderTest::TearDown()
+{
+    m_spUpdaterBaseContext->spRocksDB.reset();
+    std::filesystem::remove_all(m_outputFolder);
+}
+
+RangeDownloader::Query RangeDownloaderTest::fakeQuery(const std::string& content, bool supportRanges)
+{
+    return [this, content, supportRanges](const std::string& rangeHeader, const std::string& outputFilepath)
+    {
+        ++m_queries;
+
+        std::string body {content};
+        if (supportRanges)
+        {
+            // Parse "Range: bytes=<first>-<last>".
+            const auto bytes {rangeHeader.substr(rangeHeader.find('=') + 1)};
+            const auto first {std::stoul(bytes.substr(0, bytes.find('-')))};
+            const auto last {std::stoul(bytes.substr(bytes.find('-') + 1))};
+            if (first >= content.size())
+            {
+                return false;
+            }
+            body = content.substr(first, last - first + 1);
+        }
+
+        std::ofstream {outputFilepath, std::ios::binary} << body;
+        return true;
+    };
+}
+
+/**
+ * @brief Reads the whole content of a file.
+ *
+ * @param filepath File to read.
+ * @return std::string File content.
+ */
+static std::string readFile(const std::filesystem::path& filepath)
+{
+    std::ifstream file {filepath, std::ios::binary};
+    std::ostringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+/**
+ * @brief Tests the download of a content through several connections.
+ *
+ */
+TEST_F(RangeDownloaderTest, ConcurrentDownload)
+{
+    RangeDownloader downloader {fakeQuery(CONTENT), 3, CHUNK_SIZE};
+    ASSERT_NO_THROW(downloader.download(m_url, m_outputFilepath, *m_spUpdaterBaseContext));
+
+    EXPECT_EQ(readFile(m_outputFilepath), CONTENT);
+    EXPECT_FALSE(std::filesystem::exists(m_outputFilepath.string() + ".chunks"));
+
+    // The record of the download is removed once finished.
+    std::string record;
+    EXPECT_FALSE(m_spUpdaterBaseContext->spRocksDB->get(
+        m_outputFilepath.filename().string(), record, Components::Columns::DOWNLOAD_CHUNKS));
+}
+
+/**
+ * @brief Tests the download of a content whose size is a multiple of the chunk size.
+ *
+ */
+TEST_F(RangeDownloaderTest, ContentSizeMultipleOfChunkSize)
+{
+    const std::string content {"12345678"};
+
+    RangeDownloader downloader {fakeQuery(content), 2, CHUNK_SIZE};
+    ASSERT_NO_THROW(downloader.download(m_url, m_outputFilepath, *m_spUpdaterBaseContext));
+
+    EXPECT_EQ(readFile(m_outputFilepath), content);
+}
+
+/**
+ * @brief Tests the download of an empty content.
+ *
+ */
+TEST_F(RangeDownloaderTest, EmptyContent)
+{
+    RangeDownloader downloader {fakeQuery(""), 2, CHUNK_SIZE};
+    ASSERT_NO_THROW(downloader.download(m_url, m_outputFilepath, *m_spUpdaterBaseContext));
+
+    EXPECT_TRUE(std::filesystem::exists(m_outputFilepath));
+    EXPECT_EQ(readFile(m_outputFilepath), "");
+}
+
+/**
+ * @brief Tests the download from a server that doesn't support range requests.
+ *
+ */
+TEST_F(RangeDownloaderTest, RangesNotSupported)
+{
+    RangeDownloader downloader {fakeQuery(CONTENT, false), 3, CHUNK_SIZE};
+    ASSERT_NO_THROW(downloader.download(m_url, m_outputFilepath, *m_spUpdaterBaseContext));
+
+    EXPECT_EQ(readFile(m_outputFilepath), CONTENT);
+    EXPECT_EQ(m_queries, 1);
+}
+
+/**
+ * @brief Tests that an interrupted download is resumed from the intact chunks.
+ *
+ */
+TEST_F(RangeDownloaderTest, ResumeDownload)
+{
+    const std::string content {CONTENT};
+    const auto totalChunks {(content.size() + CHUNK_SIZE - 1) / CHUNK_SIZE};
+
+    // The download fails after five chunks.
+    auto query {fakeQuery(content)};
+    RangeDownloader failingDownloader {[this, &query](const std::string& rangeHeader, const std::string& filepath)
+                                       {
+                                           if (m_queries >= 5)
+                                           {
+                                               throw std::runtime_error {"Connection lost"};
+                                           }
+                                           return query(rangeHeader, filepath);
+                                       },
+                                       1,
+                                       CHUNK_SIZE};
+    EXPECT_THROW(failingDownloader.download(m_url, m_outputFilepath, *m_spUpdaterBaseContext), std::runtime_error);
+    EXPECT_EQ(m_queries, 5);
+
+    // Corrupt one of the downloaded chunks, so it's downloaded again.
+    std::ofstream {m_outputFilepath.string() + ".chunks/1", std::ios::binary} << "XXXX";
+
+    m_queries = 0;
+    RangeDownloader downloader {fakeQuery(content), 1, CHUNK_SIZE};
+    ASSERT_NO_THROW(downloader.download(m_url, m_outputFilepath, *m_spUpdaterBaseContext));
+
+    EXPECT_EQ(readFile(m_outputFilepath), content);
+    // The pending chunks and the corrupted one.
+    EXPECT_EQ(m_queries, totalChunks - 5 + 1);
+}
+
+/**
+ * @brief Tests that the chunks of a different content are discarded.
+ *
+ */
+TEST_F(RangeDownloaderTest, DiscardChunksOfOtherContent)
+{
+    RangeDownloader failingDownloader {[](const std::string&, const std::string&) -> bool
+                                       {
+                                           throw std::runtime_error {"Connection lost"};
+                                       },
+                                       1,
+                                       CHUNK_SIZE};
+    EXPECT_THROW(failingDownloader.download(m_url, m_outputFilepath, *m_spUpdaterBaseContext), std::runtime_error);
+
+    RangeDownloader downloader {fakeQuery(CONTENT), 2, CHUNK_SIZE};
+    ASSERT_NO_THROW(downloader.download(m_url + "?new", m_outputFilepath, *m_spUpdaterBaseContext));
+
+    EXPECT_EQ(readFile(m_outputFilepath), CONTENT);
+}
+
+/**
+ * @brief Tests that an interrupted query makes the download fail.
+ *
+ */
+TEST_F(RangeDownloaderTest, InterruptedQuery)
+{
+    RangeDownloader downloader {[](const std::string&, const std::string&) { return true; }, 2, CHUNK_SIZE};
+
+    EXPECT_THROW(downloader.download(m_url, m_outputFilepath, *m_spUpdaterBaseContext), std::runtime_error);
+}
+
+/**
+ * @brief Tests the construction with an invalid chunk size.
+ *
+ */
+TEST_F(RangeDownloaderTest, InvalidChunkSize)
+{
+    EXPECT_THROW(RangeDownloader(fakeQuery(CONTENT), 2, 0), std::invalid_argument);
+}
@@ -0,0 +1,65 @@
+/*
+ * Wazuh Content Manager - Unit Tests
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _RANGE_DOWNLOADER_TEST_HPP
+#define _RANGE_DOWNLOADER_TEST_HPP
+
+#include "conditionSync.hpp"
+#include "rangeDownloader.hpp"
+#include "updaterContext.hpp"
+#include "gtest/gtest.h"
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+/**
+ * @brief Runs unit tests for RangeDownloader
+ *
+ */
+class RangeDownloaderTest : public ::testing::Test
+{
+protected:
+    RangeDownloaderTest() = default;
+    ~RangeDownloaderTest() override = default;
+
+    const std::filesystem::path m_outputFolder {std::filesystem::temp_directory_path() /
+                                                "RangeDownloaderTest"}; ///< Output test folder.
+    const std::filesystem::path m_outputFilepath {m_outputFolder / "content.xz"}; ///< Output file.
+    const std::string m_url {"http://localhost/content.xz"};                       ///< Content URL.
+    std::shared_ptr<UpdaterBaseContext> m_spUpdaterBaseContext;                     ///< Context used on tests.
+    std::shared_ptr<ConditionSync> m_spStopActionCondition {
+        std::make_shared<ConditionSync>(false)}; ///< Stop condition wrapper
+    std::atomic<unsigned int> m_queries {0};     ///< Number of queries performed.
+
+    /**
+     * @brief Set up routine for each test fixture.
+     *
+     */
+    void SetUp() override;
+
+    /**
+     * @brief Teardown routine for each test fixture.
+     *
+     */
+    void TearDown() override;
+
+    /**
+     * @brief Returns a query that serves the given content, as a server supporting range requests would.
+     *
+     * @param content Content to serve.
+     * @param supportRanges If false, the whole content is served regardless of the requested range.
+     * @return RangeDownloader::Query Query function.
+     */
+    RangeDownloader::Query fakeQuery(const std::string& content, bool supportRanges = true);
+};
+
+#endif //_RANGE_DOWNLOADER_TEST_HPP
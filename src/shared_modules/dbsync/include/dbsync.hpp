@@ -145,10 +145,21 @@ class EXPORTED DBSync
          * @param jsInput       JSON with snapshot values.
          * @param callbackData  Result callback(std::function) will be called for each result.
          *
+         * @details With "options":{"sorted_merge":true} in \p jsInput, the snapshot is sorted by primary key and
+         *          merged with the table in a single ordered pass, instead of being diffed through a temporary table.
+         *          The results are the same, but the snapshot must not repeat primary keys.
          */
         virtual void updateWithSnapshot(const nlohmann::json& jsInput,
                                         ResultCallbackData    callbackData);
 
+        /**
+         * @brief Gets the version of the data, increased on every change of the rows of the tables.
+         *
+         * @return The same version if the rows didn't change since it was read, so the results computed from them
+         *         (e.g. the rsync checksums) can be reused.
+         */
+        virtual uint64_t dataVersion();
+
         /**
          * @brief Turns off the services provided by the shared library.
          */
@@ -288,6 +299,17 @@ class EXPORTED SelectQuery final : public Query<SelectQuery>
         */
         SelectQuery& rowFilter(const std::string& filter);
 
+        /**
+        * @brief Set the values bound to the '?' parameters of the filter.
+        *
+        * @param parameters Values of the parameters, in order (strings or numbers).
+        *
+        * @details The SQL of a query with bound parameters doesn't change between calls,
+        *          so its statement is prepared once and reused. The rows are read before
+        *          the result callback is called.
+        */
+        SelectQuery& rowFilterParams(const nlohmann::json& parameters);
+
         /**
          * @brief Set distinct flag to be applied in the query.
          *
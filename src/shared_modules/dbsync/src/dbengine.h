@@ -65,6 +65,8 @@ namespace DbSync
 
             virtual void addTableRelationship(const nlohmann::json& data) = 0;
 
+            virtual uint64_t dataVersion() const = 0;
+
         protected:
             IDbEngine() = default;
     };
@@ -778,6 +778,11 @@ void DBSync::updateWithSnapshot(const nlohmann::json&     jsInput,
     DBSyncImplementation::instance().updateSnapshotData(m_dbsyncHandle, jsInput, callbackWrapper);
 }
 
+uint64_t DBSync::dataVersion()
+{
+    return DBSyncImplementation::instance().dataVersion(m_dbsyncHandle);
+}
+
 
 DBSyncTxn::DBSyncTxn(const DBSYNC_HANDLE   handle,
                      const nlohmann::json& tables,
@@ -845,6 +850,12 @@ SelectQuery& SelectQuery::rowFilter(const std::string& filter)
     return *this;
 }
 
+SelectQuery& SelectQuery::rowFilterParams(const nlohmann::json& parameters)
+{
+    m_jsQuery["query"]["row_filter_params"] = parameters;
+    return *this;
+}
+
 SelectQuery& SelectQuery::distinctOpt(const bool distinct)
 {
     m_jsQuery["query"]["distinct_opt"] = distinct;
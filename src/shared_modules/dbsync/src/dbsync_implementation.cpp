@@ -188,3 +188,8 @@ void DBSyncImplementation::addTableRelationship(const DBSYNC_HANDLE   handle,
     std::lock_guard<std::shared_timed_mutex> lock{ ctx->m_syncMutex };
     ctx->m_dbEngine->addTableRelationship(json);
 }
+
+uint64_t DBSyncImplementation::dataVersion(const DBSYNC_HANDLE handle)
+{
+    return dbEngineContext(handle)->m_dbEngine->dataVersion();
+}
@@ -78,6 +78,8 @@ namespace DbSync
             void addTableRelationship(const DBSYNC_HANDLE   handle,
                                       const nlohmann::json& json);
 
+            uint64_t dataVersion(const DBSYNC_HANDLE handle);
+
             void release();
 
             void releaseContext(const DBSYNC_HANDLE handle);
@@ -27,6 +27,7 @@ SQLiteDBEngine::SQLiteDBEngine(const std::shared_ptr<ISQLiteFactory>& sqliteFact
                                const DbManagement                     dbManagement,
                                const std::vector<std::string>&        upgradeStatements)
     : m_sqliteFactory(sqliteFactory)
+    , m_dataVersion(0)
 {
     initialize(path, tableStmtCreation, dbManagement, upgradeStatements);
 }
@@ -91,11 +92,50 @@ void SQLiteDBEngine::bulkInsert(const std::string& table,
     if (0 != loadTableData(table))
     {
         const auto& tableFieldsMetaData { m_tableFields[table] };
+        bool bulkEnabled { false };
+
+        {
+            // The rows are inserted one by one when the table has a rows limit, so it's reached at the same row.
+            std::lock_guard<std::mutex> lock(m_maxRowsMutex);
+            bulkEnabled = m_maxRows.end() == m_maxRows.find(table);
+        }
+
+        // The consecutive elements with the same columns are inserted together.
+        std::vector<const nlohmann::json*> elements;
+        std::vector<bool> columnsMask;
+        std::vector<bool> elementMask(tableFieldsMetaData.size());
 
         for (const auto& element : data)
         {
-            insertElement(table, tableFieldsMetaData, element);
+            auto hasColumns { false };
+
+            for (size_t i = 0; i < tableFieldsMetaData.size(); ++i)
+            {
+                elementMask[i] = element.is_object() && element.end() != element.find(std::get<TableHeader::Name>
+                                                                                      (tableFieldsMetaData[i]));
+                hasColumns = hasColumns || elementMask[i];
+            }
+
+            if (!bulkEnabled || !hasColumns)
+            {
+                insertElements(table, tableFieldsMetaData, columnsMask, elements);
+                elements.clear();
+                insertElement(table, tableFieldsMetaData, element);
+            }
+            else
+            {
+                if (elementMask != columnsMask)
+                {
+                    insertElements(table, tableFieldsMetaData, columnsMask, elements);
+                    elements.clear();
+                    columnsMask = elementMask;
+                }
+
+                elements.push_back(&element);
+            }
         }
+
+        insertElements(table, tableFieldsMetaData, columnsMask, elements);
     }
     else
     {
@@ -109,7 +149,24 @@ void SQLiteDBEngine::refreshTableData(const nlohmann::json& data,
 {
     const std::string table { data.at("table").is_string() ? data.at("table").get_ref<const std::string&>() : "" };
 
-    if (createCopyTempTable(table))
+    auto it { data.find("options") };
+    auto sortedMerge { false };
+
+    if (data.end() != it)
+    {
+        auto itSortedMerge { it->find("sorted_merge") };
+
+        if (it->end() != itSortedMerge)
+        {
+            sortedMerge = itSortedMerge->is_boolean() ? itSortedMerge.value().get<bool>() : sortedMerge;
+        }
+    }
+
+    if (sortedMerge)
+    {
+        mergeTableData(table, data.at("data"), callback, lock);
+    }
+    else if (createCopyTempTable(table))
     {
         bulkInsert(table + TEMP_TABLE_SUBFIX, data.at("data"));
 
@@ -151,6 +208,235 @@ void SQLiteDBEngine::refreshTableData(const nlohmann::json& data,
     }
 }
 
+void SQLiteDBEngine::mergeTableData(const std::string& table,
+                                    const nlohmann::json& data,
+                                    const DbSync::ResultCallback callback,
+                                    std::unique_lock<std::shared_timed_mutex>& lock)
+{
+    std::vector<std::string> primaryKeyList;
+
+    if (0 == loadTableData(table) || !getPrimaryKeysFromTable(table, primaryKeyList))
+    {
+        throw dbengine_error { EMPTY_TABLE_METADATA };
+    }
+
+    const auto tableFields { m_tableFields[table] };
+    const auto primaryKeyColumns { getPrimaryKeyColumns(tableFields, primaryKeyList) };
+
+    if (primaryKeyColumns.empty())
+    {
+        throw dbengine_error { SQL_STMT_ERROR };
+    }
+
+    const auto comparePrimaryKeys
+    {
+        [this, &primaryKeyColumns](const Row & lhs, const Row & rhs)
+        {
+            auto retVal { 0 };
+
+            for (auto it = primaryKeyColumns.begin(); 0 == retVal && it != primaryKeyColumns.end(); ++it)
+            {
+                retVal = compareFieldData(lhs[*it], rhs[*it]);
+            }
+
+            return retVal;
+        }
+    };
+
+    // The snapshot rows, with the values converted as they're stored and sorted as the table is read.
+    std::vector<Row> snapshot;
+    snapshot.reserve(data.size());
+
+    for (const auto& element : data)
+    {
+        Row row(tableFields.size());
+
+        for (const auto& field : tableFields)
+        {
+            getJsonFieldValue(field, element, row[std::get<TableHeader::CID>(field)]);
+        }
+
+        for (const auto& column : primaryKeyColumns)
+        {
+            if (ColumnType::Unknown == std::get<GenericTupleIndex::GenType>(row[column]))
+            {
+                throw dbengine_error { BIND_FIELDS_DOES_NOT_MATCH };
+            }
+        }
+
+        snapshot.push_back(std::move(row));
+    }
+
+    std::sort(snapshot.begin(), snapshot.end(), [&comparePrimaryKeys](const Row & lhs, const Row & rhs)
+    {
+        return comparePrimaryKeys(lhs, rhs) < 0;
+    });
+
+    const auto duplicated
+    {
+        std::adjacent_find(snapshot.begin(), snapshot.end(), [&comparePrimaryKeys](const Row & lhs, const Row & rhs)
+        {
+            return 0 == comparePrimaryKeys(lhs, rhs);
+        })
+    };
+
+    if (snapshot.end() != duplicated)
+    {
+        throw dbengine_error { BIND_FIELDS_DOES_NOT_MATCH };
+    }
+
+    // Single pass over the table, ordered by the primary keys as the snapshot.
+    std::string sql { "SELECT * FROM " + table + " ORDER BY " };
+
+    for (const auto& value : primaryKeyList)
+    {
+        sql.append(value);
+        sql.append(" COLLATE BINARY,");
+    }
+
+    sql.back() = ';';
+
+    std::vector<Row> rowsToRemove;
+    std::vector<ModifiedRow> rowsToModify;
+    std::vector<Row> rowsToInsert;
+    auto itSnapshot { snapshot.begin() };
+
+    {
+        const auto stmt { getStatement(sql) };
+        Row row(tableFields.size());
+
+        while (SQLITE_ROW == stmt->step())
+        {
+            for (const auto& field : tableFields)
+            {
+                const auto index { std::get<TableHeader::CID>(field) };
+
+                if (stmt->column(index)->hasValue())
+                {
+                    getTableData(stmt, index, std::get<TableHeader::Type>(field), row[index]);
+                }
+                else
+                {
+                    std::get<GenericTupleIndex::GenType>(row[index]) = ColumnType::Unknown;
+                }
+            }
+
+            for (; snapshot.end() != itSnapshot && comparePrimaryKeys(*itSnapshot, row) < 0; ++itSnapshot)
+            {
+                rowsToInsert.push_back(std::move(*itSnapshot));
+            }
+
+            if (snapshot.end() != itSnapshot && 0 == comparePrimaryKeys(*itSnapshot, row))
+            {
+                // As the temporary table diff, the missing and NULL values aren't modifications.
+                ModifiedRow modifiedRow { Row(tableFields.size()), Row(tableFields.size()) };
+                auto dataModified { false };
+
+                for (const auto& column : primaryKeyColumns)
+                {
+                    modifiedRow.first[column] = (*itSnapshot)[column];
+                }
+
+                for (const auto& field : tableFields)
+                {
+                    const auto index { std::get<TableHeader::CID>(field) };
+                    const auto& value { (*itSnapshot)[index] };
+
+                    if (!std::get<TableHeader::PK>(field) &&
+                            ColumnType::Unknown != std::get<GenericTupleIndex::GenType>(value) &&
+                            ColumnType::Unknown != std::get<GenericTupleIndex::GenType>(row[index]) &&
+                            0 != compareFieldData(value, row[index]))
+                    {
+                        modifiedRow.second[index] = value;
+                        dataModified = true;
+                    }
+                }
+
+                if (dataModified)
+                {
+                    rowsToModify.push_back(std::move(modifiedRow));
+                }
+
+                ++itSnapshot;
+            }
+            else
+            {
+                Row primaryKeys(tableFields.size());
+
+                for (const auto& column : primaryKeyColumns)
+                {
+                    primaryKeys[column] = row[column];
+                }
+
+                rowsToRemove.push_back(std::move(primaryKeys));
+            }
+        }
+    }
+
+    std::move(itSnapshot, snapshot.end(), std::back_inserter(rowsToInsert));
+
+    // The changes are applied and reported as the temporary table diff does: Deletions, modifications and insertions.
+    deleteRows(table, primaryKeyList, rowsToRemove);
+
+    for (const auto& row : rowsToRemove)
+    {
+        nlohmann::json object;
+        getRowValues(tableFields, row, object);
+
+        if (callback)
+        {
+            lock.unlock();
+            callback(ReturnTypeCallback::DELETED, object);
+            lock.lock();
+        }
+    }
+
+    updateRows(table, primaryKeyList, rowsToModify);
+
+    for (const auto& row : rowsToModify)
+    {
+        nlohmann::json object;
+        getRowValues(tableFields, row.first, object, "PK_");
+        getRowValues(tableFields, row.second, object);
+
+        if (callback)
+        {
+            lock.unlock();
+            callback(ReturnTypeCallback::MODIFIED, object);
+            lock.lock();
+        }
+    }
+
+    // The missing values are inserted with the default value of their type, as the temporary table rows.
+    for (auto& row : rowsToInsert)
+    {
+        for (const auto& field : tableFields)
+        {
+            auto& value { row[std::get<TableHeader::CID>(field)] };
+
+            if (ColumnType::Unknown == std::get<GenericTupleIndex::GenType>(value))
+            {
+                std::get<GenericTupleIndex::GenType>(value) = std::get<TableHeader::Type>(field);
+            }
+        }
+    }
+
+    bulkInsert(table, rowsToInsert);
+
+    for (const auto& row : rowsToInsert)
+    {
+        nlohmann::json object;
+        getRowValues(tableFields, row, object);
+
+        if (callback)
+        {
+            lock.unlock();
+            callback(ReturnTypeCallback::INSERTED, object);
+            lock.lock();
+        }
+    }
+}
+
 void SQLiteDBEngine::syncTableRowData(const nlohmann::json& jsInput,
                                       const DbSync::ResultCallback callback,
                                       const bool inTransaction,
@@ -239,6 +525,12 @@ void SQLiteDBEngine::syncTableRowData(const nlohmann::json& jsInput,
                     {
                         updateSingleRow(table, jsDataToUpdate);
 
+                        // Only the status field is updated when the row didn't change.
+                        if (!updated.empty())
+                        {
+                            increaseDataVersion(table);
+                        }
+
                         if (callback && !updated.empty())
                         {
 
@@ -389,9 +681,10 @@ void SQLiteDBEngine::returnRowsMarkedForDelete(const nlohmann::json& tableNames,
             auto tableFields { m_tableFields[table] };
             const auto stmt { getStatement(getSelectAllQuery(table, tableFields)) };
 
+            Row registerFields(tableFields.size());
+
             while (SQLITE_ROW == stmt->step())
             {
-                Row registerFields;
                 auto index { 0 };
 
                 for (const auto& field : tableFields)
@@ -401,19 +694,14 @@ void SQLiteDBEngine::returnRowsMarkedForDelete(const nlohmann::json& tableNames,
                         getTableData(stmt,
                                      index,
                                      std::get<TableHeader::Type>(field),
-                                     std::get<TableHeader::Name>(field),
-                                     registerFields);
+                                     registerFields[std::get<TableHeader::CID>(field)]);
                     }
 
                     ++index;
                 }
 
                 nlohmann::json object {};
-
-                for (const auto& value : registerFields)
-                {
-                    getFieldValueFromTuple(value, object);
-                }
+                getRowValues(tableFields, registerFields, object);
 
                 lock.unlock();
                 callback(ReturnTypeCallback::DELETED, object);
@@ -434,48 +722,84 @@ void SQLiteDBEngine::selectData(const std::string& table,
 {
     if (0 != loadTableData(table))
     {
-        const auto& stmt { m_sqliteFactory->createStatement(m_sqliteConnection, buildSelectQuery(table, query)) };
+        const auto& itParams { query.find("row_filter_params") };
 
-        while (SQLITE_ROW == stmt->step())
+        if (itParams != query.end())
         {
-            nlohmann::json object;
+            // The filter parameters are bound, so the SQL text doesn't change between the calls and its statement is
+            // prepared once. The rows are read before running the callbacks, as the lock is released while they run
+            // and the cached statement could be reused meanwhile.
+            const auto stmt { getStatement(buildSelectQuery(table, query)) };
+            int32_t index { 1 };
 
-            for (int i = 0; i < stmt->columnsCount(); ++i)
+            for (const auto& param : *itParams)
             {
-                const auto& column{ stmt->column(i) };
-                const auto& name{ column->name() };
-
-                if (column->hasValue() && name != STATUS_FIELD_NAME)
+                if (param.is_string())
                 {
-                    switch (column->type())
-                    {
-                        case SQLITE_TEXT:
-                            object[name] = column->value(std::string{});
-                            break;
+                    stmt->bind(index, param.get_ref<const std::string&>());
+                }
+                else if (param.is_number_unsigned())
+                {
+                    stmt->bind(index, param.get<uint64_t>());
+                }
+                else if (param.is_number_integer())
+                {
+                    stmt->bind(index, param.get<int64_t>());
+                }
+                else if (param.is_number_float())
+                {
+                    stmt->bind(index, param.get<double_t>());
+                }
+                else
+                {
+                    throw dbengine_error { INVALID_DATA_BIND };
+                }
+
+                ++index;
+            }
 
-                        case SQLITE_INTEGER:
-                            object[name] = column->value(int64_t{});
-                            break;
+            std::vector<nlohmann::json> rows;
 
-                        case SQLITE_FLOAT:
-                            object[name] = column->value(double_t{});
-                            break;
+            while (SQLITE_ROW == stmt->step())
+            {
+                auto object = selectedRow(*stmt);
 
-                        // LCOV_EXCL_START
-                        default:
-                            throw dbengine_error{INVALID_COLUMN_TYPE};
-                            // LCOV_EXCL_STOP
-                    }
+                if (!object.empty())
+                {
+                    rows.push_back(std::move(object));
                 }
             }
 
-            if (callback && !object.empty())
+            stmt->reset();
+
+            if (callback)
             {
                 lock.unlock();
-                callback(SELECTED, object);
+
+                for (const auto& row : rows)
+                {
+                    callback(SELECTED, row);
+                }
+
                 lock.lock();
             }
         }
+        else
+        {
+            const auto& stmt { m_sqliteFactory->createStatement(m_sqliteConnection, buildSelectQuery(table, query)) };
+
+            while (SQLITE_ROW == stmt->step())
+            {
+                const auto object = selectedRow(*stmt);
+
+                if (callback && !object.empty())
+                {
+                    lock.unlock();
+                    callback(SELECTED, object);
+                    lock.lock();
+                }
+            }
+        }
     }
     else
     {
@@ -483,6 +807,42 @@ void SQLiteDBEngine::selectData(const std::string& table,
     }
 }
 
+nlohmann::json SQLiteDBEngine::selectedRow(SQLite::IStatement& stmt)
+{
+    nlohmann::json object;
+
+    for (int i = 0; i < stmt.columnsCount(); ++i)
+    {
+        const auto& column{ stmt.column(i) };
+        const auto& name{ column->name() };
+
+        if (column->hasValue() && name != STATUS_FIELD_NAME)
+        {
+            switch (column->type())
+            {
+                case SQLITE_TEXT:
+                    object[name] = column->value(std::string{});
+                    break;
+
+                case SQLITE_INTEGER:
+                    object[name] = column->value(int64_t{});
+                    break;
+
+                case SQLITE_FLOAT:
+                    object[name] = column->value(double_t{});
+                    break;
+
+                // LCOV_EXCL_START
+                default:
+                    throw dbengine_error{INVALID_COLUMN_TYPE};
+                    // LCOV_EXCL_STOP
+            }
+        }
+    }
+
+    return object;
+}
+
 void SQLiteDBEngine::deleteTableRowsData(const std::string&    table,
                                          const nlohmann::json& jsDeletionData)
 {
@@ -533,6 +893,11 @@ void SQLiteDBEngine::addTableRelationship(const nlohmann::json& data)
     }
 }
 
+uint64_t SQLiteDBEngine::dataVersion() const
+{
+    return m_dataVersion.load();
+}
+
 ///
 /// Private functions section
 ///
@@ -688,6 +1053,77 @@ void SQLiteDBEngine::insertElement(const std::string& table,
     }
 }
 
+void SQLiteDBEngine::insertElements(const std::string& table,
+                                    const TableColumns& tableColumns,
+                                    const std::vector<bool>& columnsMask,
+                                    const std::vector<const nlohmann::json*>& elements)
+{
+    TableColumns columns;
+
+    for (size_t i = 0; i < columnsMask.size(); ++i)
+    {
+        if (columnsMask[i])
+        {
+            columns.push_back(tableColumns[i]);
+        }
+    }
+
+    const size_t rowsPerStep
+    {
+        columns.empty() ? 1 : std::min<size_t>(BULK_INSERT_ROWS, MAX_BIND_PARAMETERS / columns.size())
+    };
+    size_t offset { 0ull };
+
+    if (rowsPerStep > 1 && elements.size() >= rowsPerStep)
+    {
+        const auto stmt { getStatement(buildInsertBulkDataSqlQuery(table, columns, rowsPerStep)) };
+
+        for (; elements.size() - offset >= rowsPerStep; offset += rowsPerStep)
+        {
+            updateTableRowCounter(table, rowsPerStep);
+            auto inserted { false };
+
+            try
+            {
+                int32_t index { 1l };
+
+                for (size_t row = offset; row < offset + rowsPerStep; ++row)
+                {
+                    for (const auto& column : columns)
+                    {
+                        bindJsonData(stmt, column, *elements[row], index);
+                        ++index;
+                    }
+                }
+
+                inserted = SQLITE_ERROR != stmt->step();
+            }
+            catch (const std::exception&)
+            {
+                // The failing row is found below.
+            }
+
+            stmt->reset();
+
+            if (!inserted)
+            {
+                // The statement didn't insert any row, so they're inserted one by one to fail at the same row.
+                updateTableRowCounter(table, -static_cast<long long>(rowsPerStep));
+
+                for (size_t row = offset; row < offset + rowsPerStep; ++row)
+                {
+                    insertElement(table, tableColumns, *elements[row]);
+                }
+            }
+        }
+    }
+
+    for (; offset < elements.size(); ++offset)
+    {
+        insertElement(table, tableColumns, *elements[offset]);
+    }
+}
+
 size_t SQLiteDBEngine::loadTableData(const std::string& table)
 {
     size_t fieldsNumber { 0ull };
@@ -752,6 +1188,49 @@ std::string SQLiteDBEngine::buildInsertDataSqlQuery(const std::string& table,
     return sql;
 }
 
+std::string SQLiteDBEngine::buildInsertBulkDataSqlQuery(const std::string& table,
+                                                        const TableColumns& columns,
+                                                        const size_t rows)
+{
+    //
+    // The INSERT statement will be as the following:
+    //  INSERT INTO table (column1, column2, ...) VALUES (?, ?, ...),(?, ?, ...),...;
+    //
+    std::string sql {"INSERT INTO " + table + " ("};
+    std::string binds {"("};
+
+    if (!columns.empty() && 0 != rows)
+    {
+        for (const auto& field : columns)
+        {
+            sql.append(std::get<TableHeader::Name>(field) + ",");
+            binds.append("?,");
+        }
+
+        // Remove extra "," for both strings
+        sql.back() = ')';
+        binds.back() = ')';
+        sql.append(" VALUES ");
+
+        for (size_t i = 0; i < rows; ++i)
+        {
+            sql.append(binds);
+            sql.append(",");
+        }
+
+        sql.back() = ';';
+    }
+    // LCOV_EXCL_START
+    else
+    {
+        throw dbengine_error { SQL_STMT_ERROR };
+    }
+
+    // LCOV_EXCL_STOP
+
+    return sql;
+}
+
 bool SQLiteDBEngine::loadFieldData(const std::string& table)
 {
     const auto ret { !table.empty() };
@@ -797,10 +1276,25 @@ bool SQLiteDBEngine::bindJsonData(const std::shared_ptr<SQLite::IStatement> stmt
                                   const ColumnData& cd,
                                   const nlohmann::json::value_type& valueType,
                                   const unsigned int cid)
+{
+    TableField field;
+    const auto retVal { getJsonFieldValue(cd, valueType, field) };
+
+    if (retVal)
+    {
+        bindFieldData(stmt, cid, field);
+    }
+
+    return retVal;
+}
+
+bool SQLiteDBEngine::getJsonFieldValue(const ColumnData& cd,
+                                       const nlohmann::json::value_type& valueType,
+                                       TableField& field)
 {
     bool retVal { true };
     const auto type { std::get<TableHeader::Type>(cd) };
-    const auto name { std::get<TableHeader::Name>(cd) };
+    const auto& name { std::get<TableHeader::Name>(cd) };
     const auto& it  { valueType.find(name) };
 
     if (valueType.end() != it)
@@ -809,60 +1303,47 @@ bool SQLiteDBEngine::bindJsonData(const std::shared_ptr<SQLite::IStatement> stmt
 
         if (ColumnType::BigInt == type)
         {
-            int64_t value
-            {
+            std::get<GenericTupleIndex::GenBigInt>(field) =
                 jsData.is_number() ? jsData.get<int64_t>() : jsData.is_string()
                 && jsData.get_ref<const std::string&>().size()
                 ? std::stoll(jsData.get_ref<const std::string&>())
-                : 0
-            };
-            stmt->bind(cid, value);
+                : 0;
         }
         else if (ColumnType::UnsignedBigInt == type)
         {
-            uint64_t value
-            {
+            std::get<GenericTupleIndex::GenUnsignedBigInt>(field) =
                 jsData.is_number_unsigned() ? jsData.get<uint64_t>() : jsData.is_string()
                 && jsData.get_ref<const std::string&>().size()
                 ? std::stoull(jsData.get_ref<const std::string&>())
-                : 0
-            };
-            stmt->bind(cid, value);
+                : 0;
         }
         else if (ColumnType::Integer == type)
         {
-            int32_t value
-            {
+            std::get<GenericTupleIndex::GenInteger>(field) =
                 jsData.is_number() ? jsData.get<int32_t>() : jsData.is_string()
                 && jsData.get_ref<const std::string&>().size()
                 ? std::stoi(jsData.get_ref<const std::string&>())
-                : 0
-            };
-            stmt->bind(cid, value);
+                : 0;
         }
         else if (ColumnType::Text == type)
         {
-            std::string value
-            {
-                jsData.is_string() ? jsData.get_ref<const std::string&>() : ""
-            };
-            stmt->bind(cid, value);
+            std::get<GenericTupleIndex::GenString>(field) =
+                jsData.is_string() ? jsData.get_ref<const std::string&>() : "";
         }
         else if (ColumnType::Double == type)
         {
-            double_t value
-            {
+            std::get<GenericTupleIndex::GenDouble>(field) =
                 jsData.is_number_float() ? jsData.get<double>() : jsData.is_string()
                 && jsData.get_ref<const std::string&>().size()
                 ? std::stod(jsData.get_ref<const std::string&>())
-                : .0f
-            };
-            stmt->bind(cid, value);
+                : .0f;
         }
         else
         {
             throw dbengine_error { INVALID_COLUMN_TYPE };
         }
+
+        std::get<GenericTupleIndex::GenType>(field) = type;
     }
     else
     {
@@ -872,6 +1353,46 @@ bool SQLiteDBEngine::bindJsonData(const std::shared_ptr<SQLite::IStatement> stmt
     return retVal;
 }
 
+int SQLiteDBEngine::compareFieldData(const TableField& lhs,
+                                     const TableField& rhs)
+{
+    // Same order as SQLite: The integers are stored as signed 64 bits values and the text is compared as binary.
+    const auto type { std::get<GenericTupleIndex::GenType>(lhs) };
+    auto retVal { 0 };
+
+    if (ColumnType::BigInt == type || ColumnType::UnsignedBigInt == type || ColumnType::Integer == type)
+    {
+        const auto value
+        {
+            [type](const TableField & field) -> int64_t
+            {
+                return ColumnType::BigInt == type ? std::get<GenericTupleIndex::GenBigInt>(field)
+                : ColumnType::UnsignedBigInt == type ? static_cast<int64_t>(std::get<GenericTupleIndex::GenUnsignedBigInt>(field))
+                : std::get<GenericTupleIndex::GenInteger>(field);
+            }
+        };
+        const auto lhsValue { value(lhs) };
+        const auto rhsValue { value(rhs) };
+        retVal = lhsValue < rhsValue ? -1 : rhsValue < lhsValue ? 1 : 0;
+    }
+    else if (ColumnType::Text == type)
+    {
+        retVal = std::get<GenericTupleIndex::GenString>(lhs).compare(std::get<GenericTupleIndex::GenString>(rhs));
+    }
+    else if (ColumnType::Double == type)
+    {
+        const auto lhsValue { std::get<GenericTupleIndex::GenDouble>(lhs) };
+        const auto rhsValue { std::get<GenericTupleIndex::GenDouble>(rhs) };
+        retVal = lhsValue < rhsValue ? -1 : rhsValue < lhsValue ? 1 : 0;
+    }
+    else
+    {
+        throw dbengine_error { DATATYPE_NOT_IMPLEMENTED };
+    }
+
+    return retVal;
+}
+
 bool SQLiteDBEngine::createCopyTempTable(const std::string& table)
 {
     auto ret { false };
@@ -939,14 +1460,12 @@ bool SQLiteDBEngine::removeNotExistsRows(const std::string& table,
     {
         if (deleteRows(table, primaryKeyList, rowKeysValue))
         {
+            const auto tableFields { m_tableFields[table] };
+
             for (const auto& row : rowKeysValue)
             {
                 nlohmann::json object;
-
-                for (const auto& value : row)
-                {
-                    getFieldValueFromTuple(value, object);
-                }
+                getRowValues(tableFields, row, object);
 
                 if (callback)
                 {
@@ -987,33 +1506,65 @@ bool SQLiteDBEngine::getPrimaryKeysFromTable(const std::string& table,
 void SQLiteDBEngine::getTableData(std::shared_ptr<SQLite::IStatement>const stmt,
                                   const int32_t index,
                                   const ColumnType& type,
-                                  const std::string& fieldName,
-                                  Row& row)
+                                  TableField& field)
 {
+    // The field is overwritten in place, so the rows can be reused between statement steps and the text buffers
+    // keep their capacity.
     if (ColumnType::BigInt == type)
     {
-        row[fieldName] = std::make_tuple(type, std::string(), 0, stmt->column(index)->value(int64_t{}), 0, 0);
+        std::get<GenericTupleIndex::GenBigInt>(field) = stmt->column(index)->value(int64_t{});
     }
     else if (ColumnType::UnsignedBigInt == type)
     {
-        row[fieldName] = std::make_tuple(type, std::string(), 0, 0, stmt->column(index)->value(int64_t{}), 0);
+        std::get<GenericTupleIndex::GenUnsignedBigInt>(field) = stmt->column(index)->value(int64_t{});
     }
     else if (ColumnType::Integer == type)
     {
-        row[fieldName] = std::make_tuple(type, std::string(), stmt->column(index)->value(int32_t{}), 0, 0, 0);
+        std::get<GenericTupleIndex::GenInteger>(field) = stmt->column(index)->value(int32_t{});
     }
     else if (ColumnType::Text == type)
     {
-        row[fieldName] = std::make_tuple(type, stmt->column(index)->value(std::string{}), 0, 0, 0, 0);
+        std::get<GenericTupleIndex::GenString>(field) = stmt->column(index)->value(std::string{});
     }
     else if (ColumnType::Double == type)
     {
-        row[fieldName] = std::make_tuple(type, std::string(), 0, 0, 0, stmt->column(index)->value(double_t{}));
+        std::get<GenericTupleIndex::GenDouble>(field) = stmt->column(index)->value(double_t{});
     }
     else
     {
         throw dbengine_error { INVALID_COLUMN_TYPE };
     }
+
+    std::get<GenericTupleIndex::GenType>(field) = type;
+}
+
+std::vector<int32_t> SQLiteDBEngine::getPrimaryKeyColumns(const TableColumns& tableFields,
+                                                          const std::vector<std::string>& primaryKeyList)
+{
+    std::vector<int32_t> retVal;
+
+    for (const auto& pkValue : primaryKeyList)
+    {
+        const auto& it
+        {
+            std::find_if(tableFields.begin(), tableFields.end(),
+                         [&pkValue](const ColumnData & columnData)
+            {
+                return std::get<TableHeader::Name>(columnData) == pkValue;
+            })
+        };
+
+        // LCOV_EXCL_START
+        if (tableFields.end() == it)
+        {
+            throw dbengine_error { BIND_FIELDS_DOES_NOT_MATCH };
+        }
+
+        // LCOV_EXCL_STOP
+        retVal.push_back(std::get<TableHeader::CID>(*it));
+    }
+
+    return retVal;
 }
 
 bool SQLiteDBEngine::getLeftOnly(const std::string& t1,
@@ -1031,15 +1582,12 @@ bool SQLiteDBEngine::getLeftOnly(const std::string& t1,
 
         while (SQLITE_ROW == stmt->step())
         {
-            Row registerFields;
+            Row registerFields(tableFields.size());
 
             for (const auto& field : tableFields)
             {
-                getTableData(stmt,
-                             std::get<TableHeader::CID>(field),
-                             std::get<TableHeader::Type>(field),
-                             std::get<TableHeader::Name>(field),
-                             registerFields);
+                const auto index { std::get<TableHeader::CID>(field) };
+                getTableData(stmt, index, std::get<TableHeader::Type>(field), registerFields[index]);
             }
 
             returnRows.push_back(std::move(registerFields));
@@ -1063,32 +1611,17 @@ bool SQLiteDBEngine::getPKListLeftOnly(const std::string& t1,
     {
         const auto stmt { getStatement(sql) };
         const auto tableFields { m_tableFields[t1] };
+        const auto primaryKeyColumns { getPrimaryKeyColumns(tableFields, primaryKeyList) };
 
         while (SQLITE_ROW == stmt->step())
         {
-            Row registerFields;
+            // Only the primary keys are selected, in the order of the list.
+            Row registerFields(tableFields.size());
+            auto index { 0 };
 
-            for (const auto& pkValue : primaryKeyList)
+            for (const auto& column : primaryKeyColumns)
             {
-                auto index { 0ull };
-                const auto& it
-                {
-                    std::find_if(tableFields.begin(), tableFields.end(),
-                                 [&pkValue](const ColumnData & columnData)
-                    {
-                        return std::get<TableHeader::Name>(columnData) == pkValue;
-                    })
-                };
-
-                if (tableFields.end() != it)
-                {
-                    getTableData(stmt,
-                                 index,
-                                 std::get<TableHeader::Type>(*it),
-                                 std::get<TableHeader::Name>(*it),
-                                 registerFields);
-                }
-
+                getTableData(stmt, index, std::get<TableHeader::Type>(tableFields[column]), registerFields[column]);
                 ++index;
             }
 
@@ -1139,14 +1672,15 @@ bool SQLiteDBEngine::deleteRows(const std::string& table,
     if (!sql.empty())
     {
         const auto stmt { getStatement(sql) };
+        const auto primaryKeyColumns { getPrimaryKeyColumns(m_tableFields[table], primaryKeyList) };
 
         for (const auto& row : rowsToRemove)
         {
             auto index {1l};
 
-            for (const auto& value : primaryKeyList)
+            for (const auto& column : primaryKeyColumns)
             {
-                bindFieldData(stmt, index, row.at(value));
+                bindFieldData(stmt, index, row.at(column));
                 ++index;
             }
 
@@ -1389,40 +1923,31 @@ bool SQLiteDBEngine::getRowDiff(const std::vector<std::string>& primaryKeyList,
     if (diffExist)
     {
         // The row exists, so let's generate the diff
-        Row registryFields;
+        TableField value;
 
         for (const auto& field : tableFields)
         {
-            getTableData(stmt,
-                         std::get<TableHeader::CID>(field),
-                         std::get<TableHeader::Type>(field),
-                         std::get<TableHeader::Name>(field),
-                         registryFields);
-        }
+            const auto& fieldName { std::get<TableHeader::Name>(field) };
+            const auto& it
+            {
+                data.find(fieldName)
+            };
 
-        if (!registryFields.empty())
-        {
-            for (const auto& value : registryFields)
+            if (data.end() != it)
             {
                 nlohmann::json object;
-                getFieldValueFromTuple(value, object);
-                const auto& it
-                {
-                    data.find(value.first)
-                };
+                getTableData(stmt, std::get<TableHeader::CID>(field), std::get<TableHeader::Type>(field), value);
+                getFieldValueFromTuple(fieldName, value, object);
 
-                if (data.end() != it)
+                // Only compare if not in ignore set
+                if (*it != object.at(fieldName))
                 {
-                    // Only compare if not in ignore set
-                    if (*it != object.at(value.first))
-                    {
-                        // Diff found
-                        isModified = true;
-                        oldData[value.first] = object[value.first];
-                    }
-
-                    updatedData[value.first] = *it;
+                    // Diff found
+                    isModified = true;
+                    oldData[fieldName] = object[fieldName];
                 }
+
+                updatedData[fieldName] = *it;
             }
         }
     }
@@ -1483,15 +2008,12 @@ bool SQLiteDBEngine::insertNewRows(const std::string& table,
     if (getLeftOnly(table + TEMP_TABLE_SUBFIX, table, primaryKeyList, rowValues))
     {
         bulkInsert(table, rowValues);
+        const auto tableFields { m_tableFields[table + TEMP_TABLE_SUBFIX] };
 
         for (const auto& row : rowValues)
         {
             nlohmann::json object;
-
-            for (const auto& value : row)
-            {
-                getFieldValueFromTuple(value, object);
-            }
+            getRowValues(tableFields, row, object);
 
             if (callback)
             {
@@ -1509,18 +2031,20 @@ void SQLiteDBEngine::bulkInsert(const std::string& table,
                                 const std::vector<Row>& data)
 {
     const auto stmt { getStatement(buildInsertDataSqlQuery(table)) };
+    const auto tableFields { m_tableFields[table] };
 
     for (const auto& row : data)
     {
-        const auto tableFields { m_tableFields[table] };
-
+        // The rows come from the temporary copy of the table, created with the same statement, so the columns have
+        // the same ordinals.
         for (const auto& value : tableFields)
         {
-            auto it { row.find(std::get<TableHeader::Name>(value))};
+            const auto index { std::get<TableHeader::CID>(value) };
 
-            if (row.end() != it)
+            if (index < static_cast<int32_t>(row.size()) &&
+                    ColumnType::Unknown != std::get<GenericTupleIndex::GenType>(row[index]))
             {
-                bindFieldData(stmt, std::get<TableHeader::CID>(value) + 1, (*it).second);
+                bindFieldData(stmt, index + 1, row[index]);
             }
         }
 
@@ -1545,20 +2069,19 @@ int SQLiteDBEngine::changeModifiedRows(const std::string& table,
                                        std::unique_lock<std::shared_timed_mutex>& lock)
 {
     auto ret { true };
-    std::vector<Row> rowKeysValue;
+    std::vector<ModifiedRow> rowKeysValue;
 
     if (getRowsToModify(table, primaryKeyList, rowKeysValue))
     {
         if (updateRows(table, primaryKeyList, rowKeysValue))
         {
+            const auto tableFields { m_tableFields[table] };
+
             for (const auto& row : rowKeysValue)
             {
                 nlohmann::json object;
-
-                for (const auto& value : row)
-                {
-                    getFieldValueFromTuple(value, object);
-                }
+                getRowValues(tableFields, row.first, object, "PK_");
+                getRowValues(tableFields, row.second, object);
 
                 if (callback)
                 {
@@ -1649,28 +2172,29 @@ std::string SQLiteDBEngine::buildSelectMatchingPKsSqlQuery(const std::string& ta
 
 std::string SQLiteDBEngine::buildUpdateDataSqlQuery(const std::string& table,
                                                     const std::vector<std::string>& primaryKeyList,
-                                                    const Row& row,
-                                                    const std::pair<const std::string, TableField>& field)
+                                                    const std::vector<int32_t>& primaryKeyColumns,
+                                                    const ModifiedRow& row,
+                                                    const ColumnData& field)
 {
     std::string sql{ "UPDATE " };
     sql.append(table);
     sql.append(" SET ");
-    sql.append(field.first);
+    sql.append(std::get<TableHeader::Name>(field));
     sql.append("=");
-    getFieldValueFromTuple(field, sql, true);
+    getFieldValueFromTuple(row.second.at(std::get<TableHeader::CID>(field)), sql, true);
     sql.append(" WHERE ");
 
     if (0 != primaryKeyList.size())
     {
-        for (const auto& value : primaryKeyList)
+        for (size_t i = 0; i < primaryKeyList.size(); ++i)
         {
-            const auto it { row.find("PK_" + value) };
+            const auto& value { row.first.at(primaryKeyColumns.at(i)) };
 
-            if (it != row.end())
+            if (ColumnType::Unknown != std::get<GenericTupleIndex::GenType>(value))
             {
-                sql.append(value);
+                sql.append(primaryKeyList[i]);
                 sql.append("=");
-                getFieldValueFromTuple((*it), sql, true);
+                getFieldValueFromTuple(value, sql, true);
             }
             else
             {
@@ -1752,7 +2276,7 @@ std::string SQLiteDBEngine::buildModifiedRowsQuery(const std::string& t1,
 
 bool SQLiteDBEngine::getRowsToModify(const std::string& table,
                                      const std::vector<std::string>& primaryKeyList,
-                                     std::vector<Row>& rowKeysValue)
+                                     std::vector<ModifiedRow>& rowKeysValue)
 {
     auto ret { false };
     auto sql { buildModifiedRowsQuery(table, table + TEMP_TABLE_SUBFIX, primaryKeyList) };
@@ -1760,47 +2284,34 @@ bool SQLiteDBEngine::getRowsToModify(const std::string& table,
     if (!sql.empty())
     {
         const auto stmt { getStatement(sql) };
+        const auto tableFields { m_tableFields[table] };
+        const auto primaryKeyColumns { getPrimaryKeyColumns(tableFields, primaryKeyList) };
 
         while (SQLITE_ROW == stmt->step())
         {
+            // The primary keys are selected first, followed by the modified value (or NULL) of each field.
             bool dataModified{false};
-            const auto tableFields { m_tableFields[table] };
-            Row registerFields;
+            ModifiedRow registerFields { Row(tableFields.size()), Row(tableFields.size()) };
             int32_t index {0l};
 
-            for (const auto& pkValue : primaryKeyList)
+            for (const auto& column : primaryKeyColumns)
             {
-                const auto it
-                {
-                    std::find_if(tableFields.begin(), tableFields.end(),
-                                 [&pkValue] (const ColumnData & cd)
-                    {
-                        return std::get<TableHeader::Name>(cd).compare(pkValue) == 0;
-                    })
-                };
-
-                if (tableFields.end() != it)
-                {
-                    getTableData(stmt,
-                                 index,
-                                 std::get<TableHeader::Type>(*it),
-                                 "PK_" + std::get<TableHeader::Name>(*it),
-                                 registerFields);
-                }
-
+                getTableData(stmt,
+                             index,
+                             std::get<TableHeader::Type>(tableFields[column]),
+                             registerFields.first[column]);
                 ++index;
             }
 
             for (const auto& field : tableFields)
             {
-                if (registerFields.end() == registerFields.find(std::get<TableHeader::Name>(field)))
+                if (stmt->column(index)->hasValue())
                 {
-                    if (stmt->column(index)->hasValue())
-                    {
-                        dataModified = true;
-                        getTableData(stmt, index, std::get<TableHeader::Type>(field),
-                                     std::get<TableHeader::Name>(field), registerFields);
-                    }
+                    dataModified = true;
+                    getTableData(stmt,
+                                 index,
+                                 std::get<TableHeader::Type>(field),
+                                 registerFields.second[std::get<TableHeader::CID>(field)]);
                 }
 
                 ++index;
@@ -1886,19 +2397,29 @@ void SQLiteDBEngine::updateSingleRow(const std::string& table,
 
 bool SQLiteDBEngine::updateRows(const std::string& table,
                                 const std::vector<std::string>& primaryKeyList,
-                                const std::vector<Row>& rowKeysValue)
+                                const std::vector<ModifiedRow>& rowKeysValue)
 {
+    const auto tableFields { m_tableFields[table] };
+    const auto primaryKeyColumns { getPrimaryKeyColumns(tableFields, primaryKeyList) };
+
+    if (!rowKeysValue.empty())
+    {
+        increaseDataVersion(table);
+    }
 
     for (const auto& row : rowKeysValue)
     {
-        for (const auto& field : row)
+        for (const auto& field : tableFields)
         {
-            if (0 != field.first.substr(0, 3).compare("PK_"))
+            const auto& value { row.second[std::get<TableHeader::CID>(field)] };
+
+            if (ColumnType::Unknown != std::get<GenericTupleIndex::GenType>(value))
             {
                 const auto sql
                 {
                     buildUpdateDataSqlQuery(table,
                                             primaryKeyList,
+                                            primaryKeyColumns,
                                             row,
                                             field)
                 };
@@ -1910,30 +2431,31 @@ bool SQLiteDBEngine::updateRows(const std::string& table,
     return true;
 }
 
-void SQLiteDBEngine::getFieldValueFromTuple(const Field& value,
+void SQLiteDBEngine::getFieldValueFromTuple(const std::string& fieldName,
+                                            const TableField& value,
                                             nlohmann::json& object)
 {
-    const auto rowType { std::get<GenericTupleIndex::GenType>(value.second) };
+    const auto rowType { std::get<GenericTupleIndex::GenType>(value) };
 
     if (ColumnType::BigInt == rowType)
     {
-        object[value.first] = std::get<ColumnType::BigInt>(value.second);
+        object[fieldName] = std::get<ColumnType::BigInt>(value);
     }
     else if (ColumnType::UnsignedBigInt == rowType)
     {
-        object[value.first] = std::get<ColumnType::UnsignedBigInt>(value.second);
+        object[fieldName] = std::get<ColumnType::UnsignedBigInt>(value);
     }
     else if (ColumnType::Integer == rowType)
     {
-        object[value.first] = std::get<ColumnType::Integer>(value.second);
+        object[fieldName] = std::get<ColumnType::Integer>(value);
     }
     else if (ColumnType::Text == rowType)
     {
-        object[value.first] = std::get<ColumnType::Text>(value.second);
+        object[fieldName] = std::get<ColumnType::Text>(value);
     }
     else if (ColumnType::Double == rowType)
     {
-        object[value.first] = std::get<ColumnType::Double>(value.second);
+        object[fieldName] = std::get<ColumnType::Double>(value);
     }
     else
     {
@@ -1941,38 +2463,55 @@ void SQLiteDBEngine::getFieldValueFromTuple(const Field& value,
     }
 }
 
-void SQLiteDBEngine::getFieldValueFromTuple(const Field& value,
+void SQLiteDBEngine::getRowValues(const TableColumns& tableFields,
+                                  const Row& row,
+                                  nlohmann::json& object,
+                                  const std::string& prefix)
+{
+    for (const auto& field : tableFields)
+    {
+        const auto index { std::get<TableHeader::CID>(field) };
+
+        if (index < static_cast<int32_t>(row.size()) &&
+                ColumnType::Unknown != std::get<GenericTupleIndex::GenType>(row[index]))
+        {
+            getFieldValueFromTuple(prefix + std::get<TableHeader::Name>(field), row[index], object);
+        }
+    }
+}
+
+void SQLiteDBEngine::getFieldValueFromTuple(const TableField& value,
                                             std::string& resultValue,
                                             const bool quotationMarks)
 {
-    const auto rowType { std::get<GenericTupleIndex::GenType>(value.second) };
+    const auto rowType { std::get<GenericTupleIndex::GenType>(value) };
 
     if (ColumnType::BigInt == rowType)
     {
-        resultValue.append(std::to_string(std::get<ColumnType::BigInt>(value.second)));
+        resultValue.append(std::to_string(std::get<ColumnType::BigInt>(value)));
     }
     else if (ColumnType::UnsignedBigInt == rowType)
     {
-        resultValue.append(std::to_string(std::get<ColumnType::UnsignedBigInt>(value.second)));
+        resultValue.append(std::to_string(std::get<ColumnType::UnsignedBigInt>(value)));
     }
     else if (ColumnType::Integer == rowType)
     {
-        resultValue.append(std::to_string(std::get<ColumnType::Integer>(value.second)));
+        resultValue.append(std::to_string(std::get<ColumnType::Integer>(value)));
     }
     else if (ColumnType::Text == rowType)
     {
         if (quotationMarks)
         {
-            resultValue.append("'" + std::get<ColumnType::Text>(value.second) + "'");
+            resultValue.append("'" + std::get<ColumnType::Text>(value) + "'");
         }
         else
         {
-            resultValue.append(std::get<ColumnType::Text>(value.second));
+            resultValue.append(std::get<ColumnType::Text>(value));
         }
     }
     else if (ColumnType::Double == rowType)
     {
-        resultValue.append(std::to_string(std::get<ColumnType::Double>(value.second)));
+        resultValue.append(std::to_string(std::get<ColumnType::Double>(value)));
     }
     else
     {
@@ -2129,6 +2668,11 @@ std::string SQLiteDBEngine::buildUpdateRelationTrigger(const nlohmann::json&
 
 void SQLiteDBEngine::updateTableRowCounter(const std::string& table, const long long rowModifyCount)
 {
+    if (0 != rowModifyCount)
+    {
+        increaseDataVersion(table);
+    }
+
     std::lock_guard<std::mutex> lock(m_maxRowsMutex);
     auto it { m_maxRows.find(table) };
 
@@ -2148,3 +2692,13 @@ void SQLiteDBEngine::updateTableRowCounter(const std::string& table, const long
         }
     }
 }
+
+void SQLiteDBEngine::increaseDataVersion(const std::string& table)
+{
+    // The temporary copies are only used to diff the snapshots, the changes of the tables are counted when they are
+    // applied.
+    if (!Utils::endsWith(table, TEMP_TABLE_SUBFIX))
+    {
+        ++m_dataVersion;
+    }
+}
@@ -13,6 +13,7 @@
 #define _SQLITE_DBENGINE_H
 
 #include <tuple>
+#include <atomic>
 #include <iostream>
 #include <mutex>
 #include <queue>
@@ -31,6 +32,18 @@ constexpr auto CACHE_STMT_LIMIT
     30ull
 };
 
+// Rows inserted by each step of the bulk inserts, bounded by the SQLite host parameters limit.
+constexpr auto BULK_INSERT_ROWS
+{
+    64ull
+};
+
+// Default SQLITE_MAX_VARIABLE_NUMBER of the SQLite versions before 3.32.0.
+constexpr auto MAX_BIND_PARAMETERS
+{
+    999ull
+};
+
 const std::vector<std::string> InternalColumnNames =
 {
     { STATUS_FIELD_NAME }
@@ -86,9 +99,12 @@ using TableColumns =
 using TableField =
     std::tuple<int32_t, std::string, int32_t, int64_t, uint64_t, double_t>;
 
-using Row = std::map<std::string, TableField>;
+// Values of a row, indexed by the ordinal (CID) of their columns in the table fields. The columns that weren't read
+// keep the Unknown type.
+using Row = std::vector<TableField>;
 
-using Field = std::pair<const std::string, TableField>;
+// Primary key values and modified values of a row.
+using ModifiedRow = std::pair<Row, Row>;
 
 enum ResponseType
 {
@@ -156,6 +172,8 @@ class SQLiteDBEngine final : public DbSync::IDbEngine
 
         void addTableRelationship(const nlohmann::json& data) override;
 
+        uint64_t dataVersion() const override;
+
     private:
         void initialize(const std::string&              path,
                         const std::string&              tableStmtCreation,
@@ -173,12 +191,18 @@ class SQLiteDBEngine final : public DbSync::IDbEngine
         std::string buildInsertDataSqlQuery(const std::string& table,
                                             const nlohmann::json& data = {});
 
+        std::string buildInsertBulkDataSqlQuery(const std::string& table,
+                                                const TableColumns& columns,
+                                                const size_t rows);
+
         std::string buildDeleteBulkDataSqlQuery(const std::string& table,
                                                 const std::vector<std::string>& primaryKeyList);
 
         std::string buildSelectQuery(const std::string& table,
                                      const nlohmann::json& jsQuery);
 
+        nlohmann::json selectedRow(SQLite::IStatement& stmt);
+
         ColumnType columnTypeName(const std::string& type);
 
         bool bindJsonData(const std::shared_ptr<SQLite::IStatement> stmt,
@@ -186,6 +210,18 @@ class SQLiteDBEngine final : public DbSync::IDbEngine
                           const nlohmann::json::value_type& valueType,
                           const unsigned int cid);
 
+        bool getJsonFieldValue(const ColumnData& cd,
+                               const nlohmann::json::value_type& valueType,
+                               TableField& field);
+
+        int compareFieldData(const TableField& lhs,
+                             const TableField& rhs);
+
+        void mergeTableData(const std::string& table,
+                            const nlohmann::json& data,
+                            const DbSync::ResultCallback callback,
+                            std::unique_lock<std::shared_timed_mutex>& lock);
+
         bool createCopyTempTable(const std::string& table);
 
         bool getTableCreateQuery(const std::string& table,
@@ -225,8 +261,10 @@ class SQLiteDBEngine final : public DbSync::IDbEngine
         void getTableData(std::shared_ptr<SQLite::IStatement>const stmt,
                           const int32_t index,
                           const ColumnType& type,
-                          const std::string& fieldName,
-                          Row& row);
+                          TableField& field);
+
+        std::vector<int32_t> getPrimaryKeyColumns(const TableColumns& tableFields,
+                                                  const std::vector<std::string>& primaryKeyList);
 
         void bindFieldData(const std::shared_ptr<SQLite::IStatement> stmt,
                            const int32_t index,
@@ -266,8 +304,9 @@ class SQLiteDBEngine final : public DbSync::IDbEngine
 
         std::string buildUpdateDataSqlQuery(const std::string& table,
                                             const std::vector<std::string>& primaryKeyList,
-                                            const Row& row,
-                                            const std::pair<const std::string, TableField>& field);
+                                            const std::vector<int32_t>& primaryKeyColumns,
+                                            const ModifiedRow& row,
+                                            const ColumnData& field);
 
         std::string buildUpdatePartialDataSqlQuery(const std::string& table,
                                                    const nlohmann::json& data,
@@ -275,22 +314,28 @@ class SQLiteDBEngine final : public DbSync::IDbEngine
 
         bool getRowsToModify(const std::string& table,
                              const std::vector<std::string>& primaryKeyList,
-                             std::vector<Row>& rowKeysValue);
+                             std::vector<ModifiedRow>& rowKeysValue);
 
         void updateSingleRow(const std::string& table,
                              const nlohmann::json& jsData);
 
         bool updateRows(const std::string& table,
                         const std::vector<std::string>& primaryKeyList,
-                        const std::vector<Row>& rowKeysValue);
+                        const std::vector<ModifiedRow>& rowKeysValue);
 
-        void getFieldValueFromTuple(const Field& value,
+        void getFieldValueFromTuple(const TableField& value,
                                     std::string& resultValue,
                                     const bool quotationMarks = false);
 
-        void getFieldValueFromTuple(const Field& value,
+        void getFieldValueFromTuple(const std::string& fieldName,
+                                    const TableField& value,
                                     nlohmann::json& object);
 
+        void getRowValues(const TableColumns& tableFields,
+                          const Row& row,
+                          nlohmann::json& object,
+                          const std::string& prefix = "");
+
         SQLiteDBEngine(const SQLiteDBEngine&) = delete;
 
         SQLiteDBEngine& operator=(const SQLiteDBEngine&) = delete;
@@ -310,11 +355,18 @@ class SQLiteDBEngine final : public DbSync::IDbEngine
         void updateTableRowCounter(const std::string& table,
                                    const long long    rowModifyCount);
 
+        void increaseDataVersion(const std::string& table);
+
         void insertElement(const std::string& table,
                            const TableColumns& tableColumns,
                            const nlohmann::json& element,
                            const std::function<void()> callback = {});
 
+        void insertElements(const std::string& table,
+                            const TableColumns& tableColumns,
+                            const std::vector<bool>& columnsMask,
+                            const std::vector<const nlohmann::json*>& elements);
+
         Utils::MapWrapperSafe<std::string, TableColumns> m_tableFields;
         std::deque<std::pair<std::string, std::shared_ptr<SQLite::IStatement>>> m_statementsCache;
         const std::shared_ptr<ISQLiteFactory> m_sqliteFactory;
@@ -323,6 +375,8 @@ class SQLiteDBEngine final : public DbSync::IDbEngine
         std::unique_ptr<SQLite::ITransaction> m_transaction;
         std::mutex m_maxRowsMutex;
         std::map<std::string, MaxRows> m_maxRows;
+        // Increased on every change of the rows of the tables (not of their status field or temporary copies).
+        std::atomic<uint64_t> m_dataVersion;
 };
 
 #endif // _SQLITE_DBENGINE_H
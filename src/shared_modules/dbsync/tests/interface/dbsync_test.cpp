@@ -1667,6 +1667,62 @@ TEST_F(DBSyncTest, selectCountCPP)
     EXPECT_NO_THROW(dbSync->deleteRows(nlohmann::json::parse(rowDeletePID4)));
 }
 
+TEST_F(DBSyncTest, insertBulkDataCPP)
+{
+    CallbackMock wrapper;
+    std::unique_ptr<DBSync> dbSync;
+
+    const auto sql{ "CREATE TABLE processes(`pid` BIGINT, `name` TEXT, `tid` BIGINT, PRIMARY KEY (`pid`)) WITHOUT ROWID;"};
+    EXPECT_NO_THROW(dbSync = std::make_unique<DBSync>(HostType::AGENT, DbEngineType::SQLITE3, DATABASE_TEMP, sql));
+
+    const auto selectData
+    {
+        R"({"table":"processes",
+           "query":{"column_list":["count(*) AS count", "sum(tid) AS tids"],
+           "row_filter":"",
+           "distinct_opt":false,
+           "order_by_opt":"",
+           "count_opt":100}})"
+    };
+
+    // More rows than a bulk insert step, with a different set of columns in the middle.
+    auto insertion = nlohmann::json::parse(R"({"table":"processes","data":[]})");
+
+    for (auto pid = 1; pid <= 150; ++pid)
+    {
+        insertion["data"].push_back({{"pid", pid}, {"name", "System" + std::to_string(pid)}, {"tid", 1}});
+
+        if (pid == 100)
+        {
+            insertion["data"].push_back({{"pid", 1000}, {"name", "Test"}});
+        }
+    }
+
+    // The rows before the duplicated one are inserted.
+    auto duplicated = nlohmann::json::parse(R"({"table":"processes","data":[]})");
+
+    for (auto pid = 2000; pid < 2100; ++pid)
+    {
+        duplicated["data"].push_back({{"pid", pid == 2070 ? 2000 : pid}, {"name", "Dup"}, {"tid", 2}});
+    }
+
+    EXPECT_CALL(wrapper, callbackMock(SELECTED, nlohmann::json::parse(R"({"count":151,"tids":150})"))).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(SELECTED, nlohmann::json::parse(R"({"count":221,"tids":290})"))).Times(1);
+
+    ResultCallbackData selectCallbackData
+    {
+        [&wrapper](ReturnTypeCallback type, const nlohmann::json & jsonResult)
+        {
+            wrapper.callbackMock(type, jsonResult);
+        }
+    };
+
+    EXPECT_NO_THROW(dbSync->insertData(insertion));
+    EXPECT_NO_THROW(dbSync->selectRows(nlohmann::json::parse(selectData), selectCallbackData));
+    EXPECT_ANY_THROW(dbSync->insertData(duplicated));
+    EXPECT_NO_THROW(dbSync->selectRows(nlohmann::json::parse(selectData), selectCallbackData));
+}
+
 TEST_F(DBSyncTest, TryToInsertMoreThanMaxRowsCPP)
 {
     const auto sql{ "CREATE TABLE processes(`pid` BIGINT, `name` TEXT, PRIMARY KEY (`pid`)) WITHOUT ROWID;"};
@@ -2052,6 +2108,95 @@ TEST_F(DBSyncTest, UpdateDataCPP)
     EXPECT_NO_THROW(dbSync->updateWithSnapshot(nlohmann::json::parse(insertionSqlStmt2), callbackData));
 }
 
+TEST_F(DBSyncTest, UpdateDataWithCompoundPKsCPP)
+{
+    const auto sql{ "CREATE TABLE processes(`pid` BIGINT, `name` TEXT, `tid` BIGINT, PRIMARY KEY (`pid`, `tid`)) WITHOUT ROWID;"};
+    const auto insertionSqlStmt1{ R"({"table":"processes","data":[{"pid":4,"name":"System","tid":1},{"pid":4,"name":"Worker","tid":2}]})"};
+    const auto insertionSqlStmt2{ R"({"table":"processes","data":[{"pid":4,"name":"System2","tid":1},{"pid":5,"name":"Test","tid":1}]})"};
+
+    std::unique_ptr<DBSync> dbSync;
+    EXPECT_NO_THROW(dbSync = std::make_unique<DBSync>(HostType::AGENT, DbEngineType::SQLITE3, DATABASE_TEMP, sql));
+
+    nlohmann::json jsResponse;
+
+    EXPECT_NO_THROW(dbSync->updateWithSnapshot(nlohmann::json::parse(insertionSqlStmt1), jsResponse));
+    EXPECT_NE(nullptr, jsResponse);
+
+    CallbackMock wrapper;
+    EXPECT_CALL(wrapper, callbackMock(DELETED, nlohmann::json::parse(R"({"pid":4,"tid":2})"))).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(MODIFIED, nlohmann::json::parse(R"({"PK_pid":4,"PK_tid":1,"name":"System2"})"))).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(INSERTED, nlohmann::json::parse(R"({"name":"Test","pid":5,"tid":1})"))).Times(1);
+
+    ResultCallbackData callbackData
+    {
+        [&wrapper](ReturnTypeCallback type, const nlohmann::json & jsonResult)
+        {
+            wrapper.callbackMock(type, jsonResult);
+        }
+    };
+
+    EXPECT_NO_THROW(dbSync->updateWithSnapshot(nlohmann::json::parse(insertionSqlStmt2), callbackData));
+    // The rows were deleted by their whole primary key, so the same snapshot doesn't report changes.
+    EXPECT_NO_THROW(dbSync->updateWithSnapshot(nlohmann::json::parse(insertionSqlStmt2), callbackData));
+}
+
+TEST_F(DBSyncTest, UpdateDataSortedMergeCPP)
+{
+    const auto sql{ "CREATE TABLE processes(`pid` BIGINT, `name` TEXT, `tid` BIGINT, PRIMARY KEY (`pid`, `tid`)) WITHOUT ROWID;"};
+    const auto insertionSqlStmt1{ R"({"table":"processes","data":[{"pid":4,"name":"System","tid":1},{"pid":4,"name":"Worker","tid":2}],"options":{"sorted_merge":true}})"};
+    const auto insertionSqlStmt2{ R"({"table":"processes","data":[{"pid":5,"name":"Test","tid":1},{"pid":4,"name":"System2","tid":1}],"options":{"sorted_merge":true}})"};
+    const auto duplicatedSqlStmt{ R"({"table":"processes","data":[{"pid":5,"name":"Test","tid":1},{"pid":5,"name":"Test2","tid":1}],"options":{"sorted_merge":true}})"};
+
+    std::unique_ptr<DBSync> dbSync;
+    EXPECT_NO_THROW(dbSync = std::make_unique<DBSync>(HostType::AGENT, DbEngineType::SQLITE3, DATABASE_TEMP, sql));
+
+    CallbackMock wrapper;
+    EXPECT_CALL(wrapper, callbackMock(INSERTED, nlohmann::json::parse(R"({"name":"System","pid":4,"tid":1})"))).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(INSERTED, nlohmann::json::parse(R"({"name":"Worker","pid":4,"tid":2})"))).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(DELETED, nlohmann::json::parse(R"({"pid":4,"tid":2})"))).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(MODIFIED, nlohmann::json::parse(R"({"PK_pid":4,"PK_tid":1,"name":"System2"})"))).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(INSERTED, nlohmann::json::parse(R"({"name":"Test","pid":5,"tid":1})"))).Times(1);
+
+    ResultCallbackData callbackData
+    {
+        [&wrapper](ReturnTypeCallback type, const nlohmann::json & jsonResult)
+        {
+            wrapper.callbackMock(type, jsonResult);
+        }
+    };
+
+    EXPECT_NO_THROW(dbSync->updateWithSnapshot(nlohmann::json::parse(insertionSqlStmt1), callbackData));
+    EXPECT_NO_THROW(dbSync->updateWithSnapshot(nlohmann::json::parse(insertionSqlStmt2), callbackData));
+    // The same snapshot doesn't report changes.
+    EXPECT_NO_THROW(dbSync->updateWithSnapshot(nlohmann::json::parse(insertionSqlStmt2), callbackData));
+    // A snapshot with repeated primary keys is rejected without changing the table.
+    EXPECT_ANY_THROW(dbSync->updateWithSnapshot(nlohmann::json::parse(duplicatedSqlStmt), callbackData));
+}
+
+TEST_F(DBSyncTest, dataVersionCPP)
+{
+    const auto sql{ "CREATE TABLE processes(`pid` BIGINT, `name` TEXT, PRIMARY KEY (`pid`)) WITHOUT ROWID;"};
+    const auto insertionSqlStmt1{ R"({"table":"processes","data":[{"pid":4,"name":"System"},{"pid":5,"name":"Worker"}]})"};
+    const auto insertionSqlStmt2{ R"({"table":"processes","data":[{"pid":4,"name":"System2"},{"pid":5,"name":"Worker"}]})"};
+
+    std::unique_ptr<DBSync> dbSync;
+    EXPECT_NO_THROW(dbSync = std::make_unique<DBSync>(HostType::AGENT, DbEngineType::SQLITE3, DATABASE_TEMP, sql));
+
+    nlohmann::json jsResponse;
+    const auto initialVersion { dbSync->dataVersion() };
+
+    EXPECT_NO_THROW(dbSync->updateWithSnapshot(nlohmann::json::parse(insertionSqlStmt1), jsResponse));
+    const auto insertedVersion { dbSync->dataVersion() };
+    EXPECT_NE(initialVersion, insertedVersion);
+
+    // The same snapshot doesn't change the rows, even if it's diffed through a temporary table.
+    EXPECT_NO_THROW(dbSync->updateWithSnapshot(nlohmann::json::parse(insertionSqlStmt1), jsResponse));
+    EXPECT_EQ(insertedVersion, dbSync->dataVersion());
+
+    EXPECT_NO_THROW(dbSync->updateWithSnapshot(nlohmann::json::parse(insertionSqlStmt2), jsResponse));
+    EXPECT_NE(insertedVersion, dbSync->dataVersion());
+}
+
 TEST_F(DBSyncTest, constructorWithHandle)
 {
     const auto sql{ "CREATE TABLE processes(`pid` BIGINT, `name` TEXT, PRIMARY KEY (`pid`)) WITHOUT ROWID;"};
@@ -2394,6 +2539,58 @@ TEST_F(DBSyncTest, TestPersistentMode)
     EXPECT_NO_THROW(dbSync->selectRows(selectQuery.query(), selectCallbackData));
 }
 
+TEST_F(DBSyncTest, SelectRowsWithParamsCPP)
+{
+    const auto sql{"CREATE TABLE simple_test(`name` TEXT, `value` BIGINT, PRIMARY KEY (`name`));"};
+    std::unique_ptr<DBSync> dbSync { std::make_unique<DBSync>(HostType::AGENT, DbEngineType::SQLITE3, DATABASE_TEMP, sql) };
+    dbSync->insertData(nlohmann::json::parse(R"({"table":"simple_test","data":[{"name":"test1","value":1},
+                                                                                {"name":"test\"2","value":2},
+                                                                                {"name":"test3","value":3}]})"));
+
+    const auto selectQuery
+    {
+        [](const nlohmann::json & parameters)
+        {
+            return SelectQuery::builder()
+                   .table("simple_test")
+                   .columnList({"name", "value"})
+                   .rowFilter("WHERE name = ? OR value > ?")
+                   .rowFilterParams(parameters)
+                   .orderByOpt("name")
+                   .build();
+        }
+    };
+
+    CallbackMock wrapper;
+    EXPECT_CALL(wrapper, callbackMock(SELECTED, nlohmann::json::parse(R"({"name":"test\"2","value":2})"))).Times(1);
+    EXPECT_CALL(wrapper, callbackMock(SELECTED, nlohmann::json::parse(R"({"name":"test1","value":1})"))).Times(2);
+    EXPECT_CALL(wrapper, callbackMock(SELECTED, nlohmann::json::parse(R"({"name":"test3","value":3})"))).Times(3);
+
+    ResultCallbackData selectCallbackData
+    {
+        [&wrapper](ReturnTypeCallback type, const nlohmann::json & jsonResult)
+        {
+            wrapper.callbackMock(type, jsonResult);
+        }
+    };
+
+    EXPECT_NO_THROW(dbSync->selectRows(selectQuery(R"(["test\"2", 2])"_json).query(), selectCallbackData));
+
+    // The same statement is reused from the result callback.
+    ResultCallbackData nestedCallbackData
+    {
+        [&](ReturnTypeCallback type, const nlohmann::json & jsonResult)
+        {
+            wrapper.callbackMock(type, jsonResult);
+            dbSync->selectRows(selectQuery(nlohmann::json::array({jsonResult.at("name"), 5})).query(), selectCallbackData);
+        }
+    };
+
+    EXPECT_NO_THROW(dbSync->selectRows(selectQuery(R"(["test1", 2])"_json).query(), nestedCallbackData));
+
+    EXPECT_ANY_THROW(dbSync->selectRows(selectQuery(R"([true, 2])"_json).query(), selectCallbackData));
+}
+
 TEST_F(DBSyncTest, TestUpgrade)
 {
     const auto sql{"CREATE TABLE simple_test(`name` TEXT, `value` BIGINT, PRIMARY KEY (`name`));"};
@@ -25,11 +25,15 @@ class ServerSelector;
 class SecureCommunication;
 #include "threadDispatcher.h"
 #include "threadEventDispatcher.hpp"
+#include <future>
 #include <json.hpp>
 #include <string>
+#include <vector>
 
 using ThreadDispatchQueue = ThreadEventDispatcher<std::string, std::function<void(std::queue<std::string>&)>>;
 using ThreadSyncQueue = Utils::AsyncDispatcher<std::string, std::function<void(const std::string&)>>;
+using BulkTask = std::shared_ptr<std::packaged_task<void()>>;
+using ThreadBulkSenders = Utils::AsyncDispatcher<BulkTask, std::function<void(const BulkTask&)>>;
 
 /**
  * @brief IndexerConnector class.
@@ -52,6 +56,39 @@ class EXPORTED IndexerConnector final
     std::mutex m_syncMutex;
     std::unique_ptr<ThreadDispatchQueue> m_dispatcher;
     std::unordered_map<std::string, std::chrono::system_clock::time_point> m_lastSync;
+    std::string m_bulkEndpoint;
+    size_t m_bulkConcurrency {1};
+    size_t m_maxBulkBytes {0};
+    bool m_bulkCompression {false};
+    bool m_incrementalSync {false};
+    // Long-lived threads that send the concurrent bulks, so their connections are reused.
+    std::unique_ptr<ThreadBulkSenders> m_bulkSenders;
+    // Index actions dropped because the document didn't change since it was last indexed.
+    std::atomic<uint64_t> m_suppressedWrites {0};
+
+    /**
+     * @brief Appends a bulk action to the bulks of its document. The actions of a document always go to the same
+     * list, so they are sent in order, and a new bulk is started when the action doesn't fit in the size limit.
+     *
+     * @param bulks Bulks to send, one list for each in-flight request.
+     * @param id Document ID.
+     * @param action Bulk action (metadata and data lines).
+     */
+    void appendBulkAction(std::vector<std::vector<std::string>>& bulks,
+                          const std::string& id,
+                          const std::string& action) const;
+
+    /**
+     * @brief Sends the bulks, each list to the next available server, with up to one request in-flight per list.
+     * Returns once all of them are sent.
+     *
+     * @param bulks Bulks to send, one list for each in-flight request.
+     * @param secureCommunication Secure communication.
+     * @param selector Server selector.
+     */
+    void sendBulks(const std::vector<std::vector<std::string>>& bulks,
+                   const SecureCommunication& secureCommunication,
+                   ServerSelector& selector) const;
 
     /**
      * @brief This method is used to calculate the diff between the inventory database and the indexer.
@@ -76,6 +113,37 @@ class EXPORTED IndexerConnector final
                                         const std::string& agentId,
                                         const SecureCommunication& secureCommunication) const;
 
+    /**
+     * @brief Calculates the diff between the inventory database and the indexer page by page, using a point in time
+     * and search_after. The pages are sorted by ID like the database, so they are merged with it as they arrive,
+     * without holding all the indexer IDs.
+     * @param agentId Agent ID.
+     * @param secureCommunication Secure communication.
+     * @param selector Server selector.
+     */
+    void incrementalDiff(const std::string& agentId,
+                         const SecureCommunication& secureCommunication,
+                         const std::shared_ptr<ServerSelector>& selector);
+
+    /**
+     * @brief Get the number of documents of an agent in the indexer.
+     * @param url Indexer URL.
+     * @param agentId Agent ID.
+     * @param secureCommunication Secure communication.
+     * @return Number of agent documents.
+     */
+    size_t getAgentDocumentsCount(const std::string& url,
+                                  const std::string& agentId,
+                                  const SecureCommunication& secureCommunication) const;
+
+    /**
+     * @brief Calculates the checksum of the IDs of the agent documents in the inventory database.
+     * @param agentId Agent ID.
+     * @param documents Number of agent documents.
+     * @return Checksum.
+     */
+    std::string agentChecksum(const std::string& agentId, size_t& documents) const;
+
     /**
      * @brief Abuse control.
      * @param agentId Agent ID.
@@ -87,7 +155,11 @@ public:
     /**
      * @brief Class constructor that initializes the publisher.
      *
-     * @param config Indexer configuration, including database_path and servers.
+     * @param config Indexer configuration, including database_path and servers. The optional 'bulk_concurrency',
+     * 'max_bulk_bytes', 'refresh' and 'bulk_compression' keys set the number of bulk requests in-flight, the size
+     * limit of each one, the refresh policy used by them and whether they are sent gzip encoded. The optional
+     * 'resync_mode' key selects how the agents are synced: 'scroll' (default) or 'pit' (point in time, skipping the
+     * agents that didn't change since their last sync).
      * @param logFunction Callback function to be called when trying to log a message.
      * @param timeout Server selector time interval.
      */
@@ -117,6 +189,13 @@ public:
      * @param agentId Agent ID.
      */
     void sync(const std::string& agentId);
+
+    /**
+     * @brief Number of index actions dropped because the document content was the same one already indexed.
+     *
+     * @return Suppressed writes since the connector was created.
+     */
+    uint64_t suppressedWrites() const;
 };
 
 #endif // _INDEXER_CONNECTOR_HPP
@@ -11,11 +11,18 @@
 
 #include "indexerConnector.hpp"
 #include "HTTPRequest.hpp"
+#include "hashHelper.h"
 #include "keyStore.hpp"
 #include "loggerHelper.h"
 #include "secureCommunication.hpp"
 #include "serverSelector.hpp"
+#include "stringHelper.h"
+#include "zlibHelper.hpp"
+#include <algorithm>
+#include <exception>
 #include <fstream>
+#include <functional>
+#include <future>
 
 constexpr auto NOT_USED {-1};
 constexpr auto INDEXER_COLUMN {"indexer"};
@@ -45,6 +52,66 @@ constexpr auto SYNC_QUEUE_LIMIT = 4096;
 // Abuse control
 constexpr auto MINIMAL_SYNC_TIME {30}; // In minutes
 
+// Incremental sync
+constexpr auto SYNC_CHECKSUM_COLUMN {"sync_checksum"};
+constexpr auto PIT_KEEP_ALIVE {"1m"};
+
+// Hash of the content last indexed for each document, to drop the index actions that resend it unchanged.
+constexpr auto DOCUMENT_HASH_COLUMN {"document_hash"};
+
+constexpr auto HTTP_OK {200};
+constexpr auto ELEMENTS_PER_PAGE {10000}; // The max value for queries is 10000 in the wazuh-indexer.
+
+// Bulk configuration
+constexpr auto DEFAULT_BULK_CONCURRENCY {1};
+constexpr auto MAX_BULK_CONCURRENCY {64};
+constexpr auto DEFAULT_MAX_BULK_BYTES {10 * 1024 * 1024};
+constexpr auto DEFAULT_REFRESH_POLICY {"wait_for"};
+
+static size_t getSizeConfiguration(const nlohmann::json& config, const std::string& key, const size_t defaultValue)
+{
+    if (!config.contains(key))
+    {
+        return defaultValue;
+    }
+
+    // The values read from the XML configuration are strings.
+    const auto& value {config.at(key)};
+    const auto size {value.is_string() ? std::stoull(value.get_ref<const std::string&>()) : value.get<size_t>()};
+    if (size == 0)
+    {
+        throw std::runtime_error("Invalid '" + key + "' value.");
+    }
+    return size;
+}
+
+static bool getBoolConfiguration(const nlohmann::json& config, const std::string& key)
+{
+    if (!config.contains(key))
+    {
+        return false;
+    }
+
+    // The values read from the XML configuration are strings.
+    const auto& value {config.at(key)};
+    return value.is_string() ? Utils::parseStrToBool(value.get_ref<const std::string&>()) : value.get<bool>();
+}
+
+static std::string getRefreshPolicy(const nlohmann::json& config)
+{
+    if (!config.contains("refresh"))
+    {
+        return DEFAULT_REFRESH_POLICY;
+    }
+
+    const auto& refresh {config.at("refresh").get_ref<const std::string&>()};
+    if (refresh != "true" && refresh != "false" && refresh != "wait_for")
+    {
+        throw std::runtime_error("Invalid 'refresh' value, it must be one of 'true', 'false' or 'wait_for'.");
+    }
+    return refresh;
+}
+
 static void initConfiguration(SecureCommunication& secureCommunication, const nlohmann::json& config)
 {
     std::string caRootCertificate;
@@ -72,8 +139,11 @@ static void initConfiguration(SecureCommunication& secureCommunication, const nl
         }
     }
 
-    Keystore::get(INDEXER_COLUMN, USER_KEY, username);
-    Keystore::get(INDEXER_COLUMN, PASSWORD_KEY, password);
+    // The credentials are cached by the keystore, the reconnections do not open it again.
+    std::vector<std::string> credentials;
+    Keystore::get(INDEXER_COLUMN, {USER_KEY, PASSWORD_KEY}, credentials);
+    username = credentials.at(0);
+    password = credentials.at(1);
 
     if (username.empty() && password.empty())
     {
@@ -94,6 +164,14 @@ static void initConfiguration(SecureCommunication& secureCommunication, const nl
         .caRootCertificate(caRootCertificate);
 }
 
+static std::string documentHash(const std::string& data)
+{
+    Utils::HashData hash;
+    hash.update(data.c_str(), data.size());
+    const auto digest {hash.hash()};
+    return {digest.begin(), digest.end()};
+}
+
 static void builderBulkDelete(std::string& bulkData, std::string_view id, std::string_view index)
 {
     bulkData.append(R"({"delete":{"_index":")");
@@ -186,6 +264,266 @@ nlohmann::json IndexerConnector::getAgentDocumentsIds(const std::string& url,
     return responseJson;
 }
 
+void IndexerConnector::appendBulkAction(std::vector<std::vector<std::string>>& bulks,
+                                        const std::string& id,
+                                        const std::string& action) const
+{
+    auto& documentBulks {bulks[std::hash<std::string> {}(id) % bulks.size()]};
+
+    if (documentBulks.empty() ||
+        (!documentBulks.back().empty() && documentBulks.back().size() + action.size() > m_maxBulkBytes))
+    {
+        documentBulks.emplace_back();
+    }
+    documentBulks.back().append(action);
+}
+
+void IndexerConnector::sendBulks(const std::vector<std::vector<std::string>>& bulks,
+                                 const SecureCommunication& secureCommunication,
+                                 ServerSelector& selector) const
+{
+    static const auto COMPRESSED_HEADERS {[]()
+                                          {
+                                              auto headers {DEFAULT_HEADERS};
+                                              headers.insert("Content-Encoding: gzip");
+                                              return headers;
+                                          }()};
+
+    const auto sendList =
+        [this, &secureCommunication, &selector](const std::string& server, const std::vector<std::string>& list)
+    {
+        const auto url {server + m_bulkEndpoint};
+        for (const auto& bulkData : list)
+        {
+            std::string compressedData;
+            if (m_bulkCompression)
+            {
+                compressedData = Utils::ZlibHelper::gzipCompress(bulkData);
+            }
+
+            const auto start {std::chrono::steady_clock::now()};
+            const auto elapsed = [&start]()
+            {
+                return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() -
+                                                                             start);
+            };
+
+            HTTPRequest::instance().post(
+                HttpURL(url),
+                m_bulkCompression ? compressedData : bulkData,
+                [&server, &selector, &elapsed](const std::string& response)
+                {
+                    logDebug2(IC_NAME, "Response: %s", response.c_str());
+
+                    // An overloaded server answers the bulk successfully, but rejects its items.
+                    if (response.find(R"("status":429)") != std::string::npos)
+                    {
+                        selector.reportResult(server, elapsed(), HTTP_TOO_MANY_REQUESTS);
+                        throw std::runtime_error("Bulk items rejected by the server: " + server);
+                    }
+                    selector.reportResult(server, elapsed(), HTTP_OK);
+                },
+                [&server, &selector, &elapsed](const std::string& error, const long statusCode)
+                {
+                    selector.reportResult(server, elapsed(), statusCode);
+                    logError(IC_NAME, "%s, status code: %ld.", error.c_str(), statusCode);
+                    throw std::runtime_error(error);
+                },
+                "",
+                m_bulkCompression ? COMPRESSED_HEADERS : DEFAULT_HEADERS,
+                secureCommunication);
+        }
+    };
+
+    std::vector<std::pair<std::string, const std::vector<std::string>*>> requests;
+    for (const auto& list : bulks)
+    {
+        if (!list.empty())
+        {
+            requests.emplace_back(selector.getNext(), &list);
+        }
+    }
+
+    if (requests.size() == 1)
+    {
+        sendList(requests.front().first, *requests.front().second);
+        return;
+    }
+
+    std::vector<std::future<void>> inFlight;
+    inFlight.reserve(requests.size());
+    for (const auto& [server, list] : requests)
+    {
+        auto task {std::make_shared<std::packaged_task<void()>>([&sendList, &server = server, list = list]()
+                                                                { sendList(server, *list); })};
+        inFlight.push_back(task->get_future());
+        m_bulkSenders->push(task);
+    }
+
+    // Wait for all the requests, so the next bulks are not sent before these ones.
+    std::exception_ptr error;
+    for (auto& request : inFlight)
+    {
+        try
+        {
+            request.get();
+        }
+        catch (...)
+        {
+            if (!error)
+            {
+                error = std::current_exception();
+            }
+        }
+    }
+
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+size_t IndexerConnector::getAgentDocumentsCount(const std::string& url,
+                                                const std::string& agentId,
+                                                const SecureCommunication& secureCommunication) const
+{
+    nlohmann::json postData;
+    size_t count {0};
+
+    postData["query"]["match"]["agent.id"] = agentId;
+
+    HTTPRequest::instance().post(
+        HttpURL(url + "/" + m_indexName + "/_count"),
+        postData.dump(),
+        [&count](const std::string& response) { count = nlohmann::json::parse(response).at("count").get<size_t>(); },
+        [](const std::string& error, const long) { throw std::runtime_error(error); },
+        "",
+        DEFAULT_HEADERS,
+        secureCommunication);
+
+    return count;
+}
+
+std::string IndexerConnector::agentChecksum(const std::string& agentId, size_t& documents) const
+{
+    Utils::HashData hash;
+    documents = 0;
+
+    for (const auto& [key, value] : m_db->seek(agentId))
+    {
+        // The separator avoids the same checksum for different splits of the same characters.
+        hash.update(key.c_str(), key.size() + 1);
+        ++documents;
+    }
+
+    const auto digest {hash.hash()};
+    return {digest.begin(), digest.end()};
+}
+
+void IndexerConnector::incrementalDiff(const std::string& agentId,
+                                       const SecureCommunication& secureCommunication,
+                                       const std::shared_ptr<ServerSelector>& selector)
+{
+    const auto url {selector->getNext()};
+    std::string pitId;
+
+    HTTPRequest::instance().post(
+        HttpURL(url + "/" + m_indexName + "/_search/point_in_time?keep_alive=" + PIT_KEEP_ALIVE),
+        "",
+        [&pitId](const std::string& response)
+        { pitId = nlohmann::json::parse(response).at("pit_id").get<std::string>(); },
+        [](const std::string& error, const long) { throw std::runtime_error(error); },
+        "",
+        DEFAULT_HEADERS,
+        secureCommunication);
+
+    nlohmann::json postData;
+    postData["size"] = ELEMENTS_PER_PAGE;
+    postData["query"]["match"]["agent.id"] = agentId;
+    postData["_source"] = false;
+    postData["sort"] = nlohmann::json::array({{{"_id", "asc"}}});
+
+    // Both the database and the pages are sorted by ID, so the documents missing on each side are found merging them.
+    auto localDocuments {m_db->seek(agentId)};
+    auto& local {localDocuments.begin()};
+    const auto& localEnd {localDocuments.end()};
+
+    std::vector<std::vector<std::string>> bulks(m_bulkConcurrency);
+    std::string action;
+    const auto indexLocalDocument = [&]()
+    {
+        const auto [id, data] {*local};
+        action.clear();
+        builderBulkIndex(action, id, m_indexName, std::string_view(data.data(), data.size()));
+        appendBulkAction(bulks, id, action);
+    };
+
+    nlohmann::json responseJson;
+    do
+    {
+        postData["pit"]["id"] = pitId;
+        postData["pit"]["keep_alive"] = PIT_KEEP_ALIVE;
+
+        HTTPRequest::instance().post(
+            HttpURL(url + "/_search"),
+            postData.dump(),
+            [&responseJson](const std::string& response) { responseJson = nlohmann::json::parse(response); },
+            [](const std::string& error, const long) { throw std::runtime_error(error); },
+            "",
+            DEFAULT_HEADERS,
+            secureCommunication);
+
+        // The point in time ID may change between requests.
+        if (responseJson.contains("pit_id"))
+        {
+            pitId = responseJson.at("pit_id").get<std::string>();
+        }
+
+        const auto& hits {responseJson.at("hits").at("hits")};
+        for (const auto& hit : hits)
+        {
+            const auto& id {hit.at("_id").get_ref<const std::string&>()};
+
+            // The documents before this one are not in the indexer.
+            while (local != localEnd && (*local).first < id)
+            {
+                indexLocalDocument();
+                ++local;
+            }
+
+            if (local != localEnd && (*local).first == id)
+            {
+                ++local;
+            }
+            else
+            {
+                // The document is in the indexer but not in the database.
+                action.clear();
+                builderBulkDelete(action, id, m_indexName);
+                appendBulkAction(bulks, id, action);
+            }
+        }
+
+        sendBulks(bulks, secureCommunication, *selector);
+        for (auto& list : bulks)
+        {
+            list.clear();
+        }
+
+        if (!hits.empty())
+        {
+            postData["search_after"] = hits.back().at("sort");
+        }
+    } while (responseJson.at("hits").at("hits").size() == static_cast<size_t>(ELEMENTS_PER_PAGE));
+
+    // The remaining documents are not in the indexer.
+    for (; local != localEnd; ++local)
+    {
+        indexLocalDocument();
+    }
+    sendBulks(bulks, secureCommunication, *selector);
+}
+
 void IndexerConnector::diff(const nlohmann::json& responseJson,
                             const std::string& agentId,
                             const SecureCommunication& secureCommunication,
@@ -235,18 +573,17 @@ void IndexerConnector::diff(const nlohmann::json& responseJson,
         }
     }
 
-    auto url = selector->getNext();
-    url.append("/_bulk?refresh=wait_for");
-
-    std::string bulkData;
+    std::vector<std::vector<std::string>> bulks(m_bulkConcurrency);
+    std::string action;
     // Iterate over the actions vector and build the bulk data.
     // If the element is marked as deleted, the element will be deleted from the indexer.
     // If the element is not marked as deleted, the element will be added to the indexer.
     for (const auto& [id, deleted] : actions)
     {
+        action.clear();
         if (deleted)
         {
-            builderBulkDelete(bulkData, id, m_indexName);
+            builderBulkDelete(action, id, m_indexName);
         }
         else
         {
@@ -255,21 +592,12 @@ void IndexerConnector::diff(const nlohmann::json& responseJson,
             {
                 throw std::runtime_error("Failed to get data from the database.");
             }
-            builderBulkIndex(bulkData, id, m_indexName, data);
+            builderBulkIndex(action, id, m_indexName, data);
         }
+        appendBulkAction(bulks, id, action);
     }
 
-    if (!bulkData.empty())
-    {
-        HTTPRequest::instance().post(
-            HttpURL(url),
-            bulkData,
-            [](const std::string& response) { logDebug2(IC_NAME, "Response: %s", response.c_str()); },
-            [](const std::string& error, const long statusCode) { throw std::runtime_error(error); },
-            "",
-            DEFAULT_HEADERS,
-            secureCommunication);
-    }
+    sendBulks(bulks, secureCommunication, *selector);
 }
 
 IndexerConnector::IndexerConnector(
@@ -292,8 +620,39 @@ IndexerConnector::IndexerConnector(
         throw std::runtime_error("Index name must be lowercase.");
     }
 
+    m_bulkConcurrency = std::min<size_t>(getSizeConfiguration(config, "bulk_concurrency", DEFAULT_BULK_CONCURRENCY),
+                                         MAX_BULK_CONCURRENCY);
+    m_maxBulkBytes = getSizeConfiguration(config, "max_bulk_bytes", DEFAULT_MAX_BULK_BYTES);
+    m_bulkEndpoint = "/_bulk?refresh=" + getRefreshPolicy(config);
+    m_bulkCompression = getBoolConfiguration(config, "bulk_compression");
+    if (m_bulkConcurrency > 1)
+    {
+        m_bulkSenders = std::make_unique<ThreadBulkSenders>([](const BulkTask& task) { (*task)(); },
+                                                            m_bulkConcurrency);
+    }
+
     m_db = std::make_unique<Utils::RocksDBWrapper>(std::string(DATABASE_BASE_PATH) + "db/" + m_indexName);
 
+    if (config.contains("resync_mode"))
+    {
+        const auto& resyncMode {config.at("resync_mode").get_ref<const std::string&>()};
+        if (resyncMode != "scroll" && resyncMode != "pit")
+        {
+            throw std::runtime_error("Invalid 'resync_mode' value, it must be one of 'scroll' or 'pit'.");
+        }
+        m_incrementalSync = resyncMode == "pit";
+    }
+
+    if (m_incrementalSync && !m_db->columnExists(SYNC_CHECKSUM_COLUMN))
+    {
+        m_db->createColumn(SYNC_CHECKSUM_COLUMN);
+    }
+
+    if (!m_db->columnExists(DOCUMENT_HASH_COLUMN))
+    {
+        m_db->createColumn(DOCUMENT_HASH_COLUMN);
+    }
+
     auto secureCommunication = SecureCommunication::builder();
     initConfiguration(secureCommunication, config);
 
@@ -317,9 +676,12 @@ IndexerConnector::IndexerConnector(
                 throw std::runtime_error("IndexerConnector is stopping, event processing will be skipped.");
             }
 
-            auto url = selector->getNext();
-            std::string bulkData;
-            url.append("/_bulk?refresh=wait_for");
+            // The documents are spread across the in-flight requests, keeping the order of the events of each one.
+            std::vector<std::vector<std::string>> bulks(m_bulkConcurrency);
+            std::string action;
+            // Hashes of the documents indexed by these bulks, only stored once they are sent.
+            std::unordered_map<std::string, std::string> indexedHashes;
+            uint64_t suppressed {0};
 
             while (!dataQueue.empty())
             {
@@ -330,40 +692,86 @@ IndexerConnector::IndexerConnector(
                 // If the element should not be indexed, only delete it from the sync database.
                 const bool noIndex = parsedData.contains("no-index") ? parsedData.at("no-index").get<bool>() : false;
 
+                action.clear();
                 if (parsedData.at("operation").get_ref<const std::string&>().compare("DELETED") == 0)
                 {
                     if (!noIndex)
                     {
-                        builderBulkDelete(bulkData, id, m_indexName);
+                        builderBulkDelete(action, id, m_indexName);
                     }
                     m_db->delete_(id);
+                    m_db->delete_(id, DOCUMENT_HASH_COLUMN);
+                    indexedHashes.erase(id);
                 }
                 else
                 {
                     const auto dataString = parsedData.at("data").dump();
                     if (!noIndex)
                     {
-                        builderBulkIndex(bulkData, id, m_indexName, dataString);
+                        // The last hash of the document is the one of these bulks, if they index it.
+                        auto hash {documentHash(dataString)};
+                        std::string lastHash;
+                        if (const auto it {indexedHashes.find(id)}; it != indexedHashes.end())
+                        {
+                            lastHash = it->second;
+                        }
+                        else
+                        {
+                            m_db->get(id, lastHash, DOCUMENT_HASH_COLUMN);
+                        }
+
+                        if (lastHash == hash)
+                        {
+                            ++suppressed;
+                            continue;
+                        }
+
+                        builderBulkIndex(action, id, m_indexName, dataString);
+                        indexedHashes[id] = std::move(hash);
+                    }
+                    else
+                    {
+                        // The indexer doesn't have this content, so the next index action is always sent.
+                        m_db->delete_(id, DOCUMENT_HASH_COLUMN);
+                        indexedHashes.erase(id);
                     }
                     m_db->put(id, dataString);
                 }
+
+                if (!action.empty())
+                {
+                    appendBulkAction(bulks, id, action);
+                }
             }
 
-            if (!bulkData.empty())
+            // Process data.
+            try
             {
-                // Process data.
-                HTTPRequest::instance().post(
-                    HttpURL(url),
-                    bulkData,
-                    [](const std::string& response) { logDebug2(IC_NAME, "Response: %s", response.c_str()); },
-                    [](const std::string& error, const long statusCode)
-                    {
-                        logError(IC_NAME, "%s, status code: %ld.", error.c_str(), statusCode);
-                        throw std::runtime_error(error);
-                    },
-                    "",
-                    DEFAULT_HEADERS,
-                    secureCommunication);
+                sendBulks(bulks, secureCommunication, *selector);
+            }
+            catch (const std::exception&)
+            {
+                // Backpressure: the events are retried once a server can be selected again.
+                const auto retryAfter {
+                    std::max<std::chrono::milliseconds>(selector->retryAfter(), std::chrono::seconds(START_TIME))};
+                std::unique_lock lock(m_mutex);
+                m_cv.wait_for(lock, retryAfter, [this]() { return m_stopping.load(); });
+                throw;
+            }
+
+            // The hashes are stored once the indexer has the documents, the retried events are indexed again.
+            for (const auto& [id, hash] : indexedHashes)
+            {
+                m_db->put(id, hash, DOCUMENT_HASH_COLUMN);
+            }
+
+            if (suppressed > 0)
+            {
+                m_suppressedWrites += suppressed;
+                logDebug2(IC_NAME,
+                          "%llu unchanged documents not indexed again (%llu in total).",
+                          static_cast<unsigned long long>(suppressed),
+                          static_cast<unsigned long long>(m_suppressedWrites.load()));
             }
         },
         DATABASE_BASE_PATH + m_indexName,
@@ -376,14 +784,36 @@ IndexerConnector::IndexerConnector(
             try
             {
                 std::scoped_lock lock(m_syncMutex);
-                if (!abuseControl(agentId))
+                if (abuseControl(agentId))
+                {
+                    return;
+                }
+
+                if (!m_incrementalSync)
                 {
                     logDebug2(IC_NAME, "Syncing agent '%s' with the indexer.", agentId.c_str());
                     diff(getAgentDocumentsIds(selector->getNext(), agentId, secureCommunication),
                          agentId,
                          secureCommunication,
                          selector);
+                    return;
+                }
+
+                // The agent is skipped if its documents didn't change since the last sync, and the indexer still has
+                // the same number of them.
+                size_t documents {0};
+                const auto checksum {agentChecksum(agentId, documents)};
+                std::string lastChecksum;
+                if (m_db->get(agentId, lastChecksum, SYNC_CHECKSUM_COLUMN) && lastChecksum == checksum &&
+                    getAgentDocumentsCount(selector->getNext(), agentId, secureCommunication) == documents)
+                {
+                    logDebug2(IC_NAME, "Agent '%s' is already synced with the indexer.", agentId.c_str());
+                    return;
                 }
+
+                logDebug2(IC_NAME, "Syncing agent '%s' with the indexer.", agentId.c_str());
+                incrementalDiff(agentId, secureCommunication, selector);
+                m_db->put(agentId, checksum, SYNC_CHECKSUM_COLUMN);
             }
             catch (const std::exception& e)
             {
@@ -401,6 +831,7 @@ IndexerConnector::~IndexerConnector()
     m_cv.notify_all();
 
     m_dispatcher->cancel();
+    m_syncQueue->cancel();
 
     if (m_initializeThread.joinable())
     {
@@ -417,3 +848,8 @@ void IndexerConnector::sync(const std::string& agentId)
 {
     m_syncQueue->push(agentId);
 }
+
+uint64_t IndexerConnector::suppressedWrites() const
+{
+    return m_suppressedWrites.load();
+}
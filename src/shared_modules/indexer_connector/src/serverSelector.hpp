@@ -13,25 +13,74 @@
 #define _SERVER_SELECTOR_HPP
 
 #include "monitoring.hpp"
-#include "roundRobinSelector.hpp"
 #include "secureCommunication.hpp"
+#include <algorithm>
+#include <chrono>
 #include <memory>
+#include <mutex>
+#include <random>
 #include <string>
+#include <vector>
+
+// Smoothing factor of the latency moving average.
+constexpr auto LATENCY_SMOOTHING {0.2};
+// Consecutive failures that open the circuit of a server.
+constexpr auto MAX_CONSECUTIVE_FAILURES {3u};
+// Backoff applied to a server whose circuit is open, doubled each time it opens again.
+constexpr auto MIN_BACKOFF {std::chrono::milliseconds(1000)};
+constexpr auto MAX_BACKOFF {std::chrono::milliseconds(60000)};
+// HTTP status of the requests rejected by an overloaded server.
+constexpr auto HTTP_TOO_MANY_REQUESTS {429};
 
 /**
  * @brief ServerSelector class.
+ * @details The healthy servers are selected with a smooth weighted round robin, where each server weight is inversely
+ * proportional to its average latency, so the same order is kept while there are no latency reports. Each server has a
+ * circuit breaker: a rejection (429) or several consecutive failures open it, and the server isn't selected until its
+ * backoff (exponential, with jitter) expires.
  *
  */
-class ServerSelector final : private RoundRobinSelector<std::string>
+class ServerSelector final
 {
 private:
+    struct ServerState final
+    {
+        std::string address;
+        double latencyMs {0};
+        double currentWeight {0};
+        uint32_t consecutiveFailures {0};
+        uint32_t backoffLevel {0};
+        std::chrono::steady_clock::time_point openUntil {};
+    };
+
     std::shared_ptr<Monitoring> monitoring;
+    std::vector<ServerState> m_servers;
+    std::mutex m_mutex;
+    std::mt19937 m_random {std::random_device {}()};
+
+    static double weight(const ServerState& server)
+    {
+        constexpr auto WEIGHT_SCALE {1000.0};
+        return WEIGHT_SCALE / (1.0 + server.latencyMs);
+    }
+
+    void openCircuit(ServerState& server, const std::chrono::steady_clock::time_point now)
+    {
+        // Equal jitter: between half and the whole backoff, so the servers aren't retried all at once.
+        const auto backoff {std::min<std::chrono::milliseconds::rep>(
+            MIN_BACKOFF.count() << std::min(server.backoffLevel, 16u), MAX_BACKOFF.count())};
+        std::uniform_int_distribution<std::chrono::milliseconds::rep> jitter {backoff / 2, backoff};
+
+        server.openUntil = now + std::chrono::milliseconds(jitter(m_random));
+        server.consecutiveFailures = 0;
+        ++server.backoffLevel;
+    }
 
 public:
     ~ServerSelector() = default;
 
     /**
-     * @brief Class constructor. Initializes Round Robin selector and monitoring.
+     * @brief Class constructor. Initializes the selector and monitoring.
      *
      * @param values Servers to be selected.
      * @param timeout Timeout for monitoring.
@@ -40,8 +89,12 @@ public:
     explicit ServerSelector(const std::vector<std::string>& values,
                             const uint32_t timeout = INTERVAL,
                             const SecureCommunication& secureCommunication = {})
-        : RoundRobinSelector<std::string>(values)
     {
+        m_servers.reserve(values.size());
+        for (const auto& value : values)
+        {
+            m_servers.push_back({value});
+        }
         monitoring = std::make_shared<Monitoring>(values, timeout, secureCommunication);
     }
 
@@ -52,18 +105,90 @@ public:
      */
     std::string getNext()
     {
-        auto initialValue {RoundRobinSelector<std::string>::getNext()};
-        auto retValue {initialValue};
+        std::scoped_lock lock {m_mutex};
+        const auto now {std::chrono::steady_clock::now()};
 
-        while (!monitoring->isAvailable(retValue))
+        ServerState* selected {nullptr};
+        auto totalWeight {0.0};
+        for (auto& server : m_servers)
         {
-            retValue = RoundRobinSelector<std::string>::getNext();
-            if (retValue.compare(initialValue) == 0)
+            if (server.openUntil > now || !monitoring->isAvailable(server.address))
             {
-                throw std::runtime_error("No available server");
+                continue;
             }
+
+            server.currentWeight += weight(server);
+            totalWeight += weight(server);
+            if (!selected || server.currentWeight > selected->currentWeight)
+            {
+                selected = &server;
+            }
+        }
+
+        if (!selected)
+        {
+            throw std::runtime_error("No available server");
+        }
+
+        selected->currentWeight -= totalWeight;
+        return selected->address;
+    }
+
+    /**
+     * @brief Reports the result of a request sent to a server, updating its latency and circuit breaker.
+     *
+     * @param address Server's address.
+     * @param latency Request latency.
+     * @param statusCode HTTP status code of the response, or a negative value if there was no response.
+     */
+    void reportResult(const std::string& address, const std::chrono::milliseconds latency, const long statusCode)
+    {
+        std::scoped_lock lock {m_mutex};
+        const auto it {std::find_if(m_servers.begin(),
+                                    m_servers.end(),
+                                    [&address](const ServerState& server) { return server.address == address; })};
+        if (it == m_servers.end())
+        {
+            return;
+        }
+
+        auto& server {*it};
+        server.latencyMs = server.latencyMs == 0
+                               ? latency.count()
+                               : LATENCY_SMOOTHING * latency.count() + (1 - LATENCY_SMOOTHING) * server.latencyMs;
+
+        if (statusCode >= 200 && statusCode < 300)
+        {
+            server.consecutiveFailures = 0;
+            server.backoffLevel = 0;
+        }
+        else if (statusCode == HTTP_TOO_MANY_REQUESTS || ++server.consecutiveFailures >= MAX_CONSECUTIVE_FAILURES)
+        {
+            openCircuit(server, std::chrono::steady_clock::now());
+        }
+    }
+
+    /**
+     * @brief Time until a server is selectable again, zero if there is one available now.
+     *
+     * @return std::chrono::milliseconds Time to wait.
+     */
+    std::chrono::milliseconds retryAfter()
+    {
+        std::scoped_lock lock {m_mutex};
+        const auto now {std::chrono::steady_clock::now()};
+
+        auto earliest {std::chrono::steady_clock::time_point::max()};
+        for (const auto& server : m_servers)
+        {
+            earliest = std::min(earliest, server.openUntil);
+        }
+
+        if (m_servers.empty() || earliest <= now)
+        {
+            return std::chrono::milliseconds::zero();
         }
-        return retValue;
+        return std::chrono::duration_cast<std::chrono::milliseconds>(earliest - now);
     }
 };
 
@@ -12,12 +12,16 @@
 #ifndef _FAKE_INDEXER_HPP
 #define _FAKE_INDEXER_HPP
 
+#include "json.hpp"
+#include <algorithm>
 #include <external/cpp-httplib/httplib.h>
 #include <functional>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <thread>
 #include <utility>
+#include <vector>
 
 /**
  * @brief This class is a simple HTTP server that provides a fake OpenSearch server.
@@ -35,6 +39,8 @@ private:
     std::function<void(const std::string&)> m_initTemplateCallback = {};
     std::function<void(const std::string&)> m_initIndexCallback = {};
     std::function<void(const std::string&)> m_publishCallback = {};
+    std::mutex m_documentIdsMutex;
+    std::vector<std::string> m_documentIds;
 
 public:
     /**
@@ -88,6 +94,18 @@ public:
         m_publishCallback = std::move(callback);
     }
 
+    /**
+     * @brief Sets the IDs of the documents returned by the searches.
+     *
+     * @param documentIds Document IDs.
+     */
+    void setDocumentIds(std::vector<std::string> documentIds)
+    {
+        std::sort(documentIds.begin(), documentIds.end());
+        std::scoped_lock lock {m_documentIdsMutex};
+        m_documentIds = std::move(documentIds);
+    }
+
     /**
      * @brief Returns the indexer initialized flag.
      *
@@ -140,6 +158,49 @@ public:
                           }
                       });
 
+        // Endpoint where the points in time are opened.
+        m_server.Post("/" + m_indexName + "/_search/point_in_time",
+                      [](const httplib::Request& req, httplib::Response& res)
+                      {
+                          std::ignore = req;
+                          res.set_content(R"({"pit_id":"fake_pit_id"})", "application/json");
+                      });
+
+        // Endpoint where the documents are searched, sorted by ID and paginated with search_after.
+        m_server.Post("/_search",
+                      [this](const httplib::Request& req, httplib::Response& res)
+                      {
+                          const auto query {nlohmann::json::parse(req.body)};
+                          const auto size {query.at("size").get<size_t>()};
+                          std::string searchAfter;
+                          if (query.contains("search_after"))
+                          {
+                              searchAfter = query.at("search_after").front().get<std::string>();
+                          }
+
+                          nlohmann::json response;
+                          response["pit_id"] = query.at("pit").at("id");
+                          response["hits"]["hits"] = nlohmann::json::array();
+                          std::scoped_lock lock {m_documentIdsMutex};
+                          for (auto it {std::upper_bound(m_documentIds.begin(), m_documentIds.end(), searchAfter)};
+                               it != m_documentIds.end() && response.at("hits").at("hits").size() < size;
+                               ++it)
+                          {
+                              response["hits"]["hits"].push_back(
+                                  {{"_id", *it}, {"sort", nlohmann::json::array({*it})}});
+                          }
+                          res.set_content(response.dump(), "application/json");
+                      });
+
+        // Endpoint where the documents are counted.
+        m_server.Post("/" + m_indexName + "/_count",
+                      [this](const httplib::Request& req, httplib::Response& res)
+                      {
+                          std::ignore = req;
+                          std::scoped_lock lock {m_documentIdsMutex};
+                          res.set_content(nlohmann::json {{"count", m_documentIds.size()}}.dump(), "application/json");
+                      });
+
         m_server.set_keep_alive_max_count(1);
         m_server.listen(m_host, m_port);
     }
@@ -14,16 +14,21 @@
 #include "indexerConnector.hpp"
 #include "json.hpp"
 #include "stringHelper.h"
+#include "zlibHelper.hpp"
 #include "gtest/gtest.h"
+#include <atomic>
 #include <chrono>
 #include <filesystem>
 #include <fstream>
 #include <functional>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <thread>
 #include <utility>
+#include <vector>
 
 // Template.
 static const auto TEMPLATE_FILE_PATH {std::filesystem::temp_directory_path() / "template.json"};
@@ -461,6 +466,267 @@ TEST_F(IndexerConnectorTest, PublishErrorFromServer)
     ASSERT_NO_THROW(waitUntil([&callbackCalled]() { return callbackCalled; }, MAX_INDEXER_PUBLISH_TIME_MS));
 }
 
+/**
+ * @brief Test the publication with several bulk requests in-flight, each one split by size. The updates of each
+ * document must arrive in order.
+ *
+ */
+TEST_F(IndexerConnectorTest, PublishConcurrentBulksInOrder)
+{
+    constexpr auto DOCUMENTS {20};
+    constexpr auto UPDATES {5};
+
+    // Callback that stores, for each document, the versions received, in the order they arrive.
+    std::mutex publishedMutex;
+    std::map<std::string, std::vector<int>> publishedVersions;
+    auto publishedCount {0};
+    const auto storePublishedData {[&](const std::string& data)
+                                   {
+                                       const auto splitData {Utils::split(data, '\n')};
+                                       std::scoped_lock lock {publishedMutex};
+                                       for (size_t i = 0; i + 1 < splitData.size(); i += 2)
+                                       {
+                                           const auto metadata {nlohmann::json::parse(splitData.at(i))};
+                                           const auto document {nlohmann::json::parse(splitData.at(i + 1))};
+                                           publishedVersions[metadata.at("index").at("_id")].push_back(
+                                               document.at("version").get<int>());
+                                           ++publishedCount;
+                                       }
+                                   }};
+    m_indexerServers[A_IDX]->setPublishCallback(storePublishedData);
+
+    // Create connector with several requests in-flight and small bulks.
+    nlohmann::json indexerConfig;
+    indexerConfig["name"] = INDEXER_NAME;
+    indexerConfig["hosts"] = nlohmann::json::array({A_ADDRESS});
+    indexerConfig["bulk_concurrency"] = 4;
+    indexerConfig["max_bulk_bytes"] = "256";
+    indexerConfig["refresh"] = "false";
+    auto indexerConnector {IndexerConnector(indexerConfig, logFunction, INDEXER_TIMEOUT)};
+
+    for (auto version = 0; version < UPDATES; ++version)
+    {
+        for (auto document = 0; document < DOCUMENTS; ++document)
+        {
+            nlohmann::json publishData;
+            publishData["id"] = "document_" + std::to_string(document);
+            publishData["operation"] = "INSERT";
+            publishData["data"]["version"] = version;
+            ASSERT_NO_THROW(indexerConnector.publish(publishData.dump()));
+        }
+    }
+
+    ASSERT_NO_THROW(waitUntil(
+        [&]()
+        {
+            std::scoped_lock lock {publishedMutex};
+            return publishedCount == DOCUMENTS * UPDATES;
+        },
+        MAX_INDEXER_PUBLISH_TIME_MS));
+
+    const std::vector<int> expectedVersions {0, 1, 2, 3, 4};
+    std::scoped_lock lock {publishedMutex};
+    ASSERT_EQ(publishedVersions.size(), static_cast<size_t>(DOCUMENTS));
+    for (const auto& [id, versions] : publishedVersions)
+    {
+        EXPECT_EQ(versions, expectedVersions) << id;
+    }
+}
+
+/**
+ * @brief Test the publication of a gzip encoded bulk. The published data is decompressed and checked against the
+ * expected one.
+ *
+ */
+TEST_F(IndexerConnectorTest, PublishCompressedBulk)
+{
+    nlohmann::json expectedMetadata;
+    expectedMetadata["index"]["_index"] = INDEXER_NAME;
+    expectedMetadata["index"]["_id"] = INDEX_ID_A;
+
+    // Callback that decompresses the published data and checks it.
+    const auto compressedFile {std::filesystem::temp_directory_path() / "indexer_connector_bulk.json.gz"};
+    constexpr auto INDEX_DATA {"content"};
+    std::atomic<bool> callbackCalled {false};
+    const auto checkPublishedData {[&](const std::string& data)
+                                   {
+                                       // GZIP magic number.
+                                       ASSERT_EQ(data.substr(0, 2), "\x1f\x8b");
+                                       std::ofstream {compressedFile, std::ios::binary} << data;
+                                       std::string decompressedData;
+                                       Utils::ZlibHelper::gzipDecompress(compressedFile,
+                                                                         [&decompressedData](const char* chunk,
+                                                                                             size_t size)
+                                                                         { decompressedData.append(chunk, size); });
+                                       std::filesystem::remove(compressedFile);
+
+                                       const auto splitData {Utils::split(decompressedData, '\n')};
+                                       ASSERT_EQ(nlohmann::json::parse(splitData.front()), expectedMetadata);
+                                       ASSERT_EQ(nlohmann::json::parse(splitData.back()), INDEX_DATA);
+                                       callbackCalled = true;
+                                   }};
+    m_indexerServers[A_IDX]->setPublishCallback(checkPublishedData);
+
+    // Create connector and wait until the connection is established.
+    nlohmann::json indexerConfig;
+    indexerConfig["name"] = INDEXER_NAME;
+    indexerConfig["hosts"] = nlohmann::json::array({A_ADDRESS});
+    indexerConfig["bulk_compression"] = "yes";
+    auto indexerConnector {IndexerConnector(indexerConfig, logFunction, INDEXER_TIMEOUT)};
+
+    // Publish content and wait until the publication finishes.
+    nlohmann::json publishData;
+    publishData["id"] = INDEX_ID_A;
+    publishData["operation"] = "INSERT";
+    publishData["data"] = INDEX_DATA;
+    ASSERT_NO_THROW(indexerConnector.publish(publishData.dump()));
+    ASSERT_NO_THROW(waitUntil([&callbackCalled]() { return callbackCalled.load(); }, MAX_INDEXER_PUBLISH_TIME_MS));
+}
+
+/**
+ * @brief Test the incremental sync of an agent: the documents missing in the indexer are indexed and the ones that
+ * are not in the database anymore are deleted.
+ *
+ */
+TEST_F(IndexerConnectorTest, IncrementalSync)
+{
+    // Callback that stores the published actions.
+    std::mutex publishedMutex;
+    std::vector<nlohmann::json> publishedActions;
+    const auto storePublishedData {[&](const std::string& data)
+                                   {
+                                       std::scoped_lock lock {publishedMutex};
+                                       for (const auto& line : Utils::split(data, '\n'))
+                                       {
+                                           if (const auto action {nlohmann::json::parse(line)};
+                                               action.contains("index") || action.contains("delete"))
+                                           {
+                                               publishedActions.push_back(action);
+                                           }
+                                       }
+                                   }};
+    m_indexerServers[A_IDX]->setPublishCallback(storePublishedData);
+
+    nlohmann::json indexerConfig;
+    indexerConfig["name"] = INDEXER_NAME;
+    indexerConfig["hosts"] = nlohmann::json::array({A_ADDRESS});
+    indexerConfig["resync_mode"] = "pit";
+    auto indexerConnector {IndexerConnector(indexerConfig, logFunction, INDEXER_TIMEOUT)};
+
+    // Store three documents of the agent in the database.
+    for (const auto& id : {"001_A", "001_B", "001_C"})
+    {
+        nlohmann::json publishData;
+        publishData["id"] = id;
+        publishData["operation"] = "INSERT";
+        publishData["data"]["value"] = id;
+        ASSERT_NO_THROW(indexerConnector.publish(publishData.dump()));
+    }
+    ASSERT_NO_THROW(waitUntil(
+        [&]()
+        {
+            std::scoped_lock lock {publishedMutex};
+            return publishedActions.size() == 3;
+        },
+        MAX_INDEXER_PUBLISH_TIME_MS));
+
+    // The indexer lost '001_B' and has a stale '001_X' document.
+    m_indexerServers[A_IDX]->setDocumentIds({"001_A", "001_C", "001_X"});
+    {
+        std::scoped_lock lock {publishedMutex};
+        publishedActions.clear();
+    }
+
+    indexerConnector.sync("001");
+    ASSERT_NO_THROW(waitUntil(
+        [&]()
+        {
+            std::scoped_lock lock {publishedMutex};
+            return publishedActions.size() == 2;
+        },
+        MAX_INDEXER_PUBLISH_TIME_MS));
+
+    std::scoped_lock lock {publishedMutex};
+    EXPECT_EQ(publishedActions.at(0).at("index").at("_id"), "001_B");
+    EXPECT_EQ(publishedActions.at(1).at("delete").at("_id"), "001_X");
+}
+
+/**
+ * @brief Test that the documents published again without changes are not indexed again, while the changed ones are.
+ *
+ */
+TEST_F(IndexerConnectorTest, PublishUnchangedDocumentSuppressed)
+{
+    // Callback that stores the published index actions.
+    std::mutex publishedMutex;
+    std::vector<nlohmann::json> publishedActions;
+    const auto storePublishedData {[&](const std::string& data)
+                                   {
+                                       std::scoped_lock lock {publishedMutex};
+                                       for (const auto& line : Utils::split(data, '\n'))
+                                       {
+                                           if (const auto action {nlohmann::json::parse(line)};
+                                               action.contains("index"))
+                                           {
+                                               publishedActions.push_back(action);
+                                           }
+                                       }
+                                   }};
+    m_indexerServers[A_IDX]->setPublishCallback(storePublishedData);
+
+    nlohmann::json indexerConfig;
+    indexerConfig["name"] = INDEXER_NAME;
+    indexerConfig["hosts"] = nlohmann::json::array({A_ADDRESS});
+    auto indexerConnector {IndexerConnector(indexerConfig, logFunction, INDEXER_TIMEOUT)};
+
+    nlohmann::json publishData;
+    publishData["id"] = INDEX_ID_A;
+    publishData["operation"] = "INSERT";
+    publishData["data"]["value"] = "first";
+    ASSERT_NO_THROW(indexerConnector.publish(publishData.dump()));
+    ASSERT_NO_THROW(waitUntil(
+        [&]()
+        {
+            std::scoped_lock lock {publishedMutex};
+            return publishedActions.size() == 1;
+        },
+        MAX_INDEXER_PUBLISH_TIME_MS));
+
+    // The same content is not indexed again.
+    publishData["operation"] = "MODIFIED";
+    ASSERT_NO_THROW(indexerConnector.publish(publishData.dump()));
+    ASSERT_NO_THROW(
+        waitUntil([&]() { return indexerConnector.suppressedWrites() == 1; }, MAX_INDEXER_PUBLISH_TIME_MS));
+
+    // A new content is.
+    publishData["data"]["value"] = "second";
+    ASSERT_NO_THROW(indexerConnector.publish(publishData.dump()));
+    ASSERT_NO_THROW(waitUntil(
+        [&]()
+        {
+            std::scoped_lock lock {publishedMutex};
+            return publishedActions.size() == 2;
+        },
+        MAX_INDEXER_PUBLISH_TIME_MS));
+
+    std::scoped_lock lock {publishedMutex};
+    EXPECT_EQ(publishedActions.at(1).at("index").at("_id"), INDEX_ID_A);
+    EXPECT_EQ(indexerConnector.suppressedWrites(), 1);
+}
+
+/**
+ * @brief Test the initialization with an invalid refresh policy.
+ *
+ */
+TEST_F(IndexerConnectorTest, InvalidRefreshPolicy)
+{
+    nlohmann::json indexerConfig;
+    indexerConfig["name"] = INDEXER_NAME;
+    indexerConfig["hosts"] = nlohmann::json::array({A_ADDRESS});
+    indexerConfig["refresh"] = "sometimes";
+    EXPECT_THROW(IndexerConnector(indexerConfig, logFunction, INDEXER_TIMEOUT), std::runtime_error);
+}
+
 /**
  * @brief Test the initialization with upper case character in the index name.
  *
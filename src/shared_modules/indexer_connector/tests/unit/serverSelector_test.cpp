@@ -120,3 +120,83 @@ TEST_F(ServerSelectorTest, TestGextNextWhenThereAreNoAvailableServers)
     // It throws an exception because there are no available servers
     EXPECT_THROW(nextServer = m_selector->getNext(), std::runtime_error);
 }
+
+/**
+ * @brief Test that the servers with lower latency are selected more often.
+ *
+ */
+TEST_F(ServerSelectorTest, TestGetNextWeightedByLatency)
+{
+    const auto hostFastServer {m_servers.at(0)};
+    const auto hostSlowServer {m_servers.at(1)};
+
+    EXPECT_NO_THROW(m_selector = std::make_shared<ServerSelector>(m_servers, SERVER_SELECTOR_HEALTH_CHECK_INTERVAL));
+
+    m_selector->reportResult(hostFastServer, std::chrono::milliseconds(10), 200);
+    m_selector->reportResult(hostSlowServer, std::chrono::milliseconds(100), 200);
+
+    auto fastSelections {0};
+    auto slowSelections {0};
+    for (auto i = 0; i < 100; ++i)
+    {
+        m_selector->getNext() == hostFastServer ? ++fastSelections : ++slowSelections;
+    }
+
+    // Both servers are used, proportionally to the inverse of their latency.
+    EXPECT_GT(slowSelections, 0);
+    EXPECT_GT(fastSelections, 5 * slowSelections);
+}
+
+/**
+ * @brief Test that a server that rejects a request isn't selected until its backoff expires.
+ *
+ */
+TEST_F(ServerSelectorTest, TestGetNextAfterRejection)
+{
+    const auto hostRejectingServer {m_servers.at(0)};
+    const auto hostOtherServer {m_servers.at(1)};
+
+    EXPECT_NO_THROW(m_selector = std::make_shared<ServerSelector>(m_servers, SERVER_SELECTOR_HEALTH_CHECK_INTERVAL));
+    EXPECT_EQ(m_selector->retryAfter(), std::chrono::milliseconds::zero());
+
+    m_selector->reportResult(hostRejectingServer, std::chrono::milliseconds(10), 429);
+
+    // Only the other server is selected while the rejecting server backs off.
+    EXPECT_EQ(m_selector->getNext(), hostOtherServer);
+    EXPECT_EQ(m_selector->getNext(), hostOtherServer);
+    EXPECT_EQ(m_selector->retryAfter(), std::chrono::milliseconds::zero());
+
+    // With both servers backing off, none can be selected.
+    m_selector->reportResult(hostOtherServer, std::chrono::milliseconds(10), 429);
+    EXPECT_THROW(m_selector->getNext(), std::runtime_error);
+    EXPECT_GT(m_selector->retryAfter(), std::chrono::milliseconds::zero());
+
+    // The first backoff is at most one second.
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    EXPECT_NO_THROW(m_selector->getNext());
+}
+
+/**
+ * @brief Test that a server is only excluded after several consecutive failures.
+ *
+ */
+TEST_F(ServerSelectorTest, TestGetNextAfterConsecutiveFailures)
+{
+    const auto hostFailingServer {m_servers.at(0)};
+    const auto hostOtherServer {m_servers.at(1)};
+
+    EXPECT_NO_THROW(m_selector = std::make_shared<ServerSelector>(m_servers, SERVER_SELECTOR_HEALTH_CHECK_INTERVAL));
+
+    // A success in the middle resets the failures count.
+    m_selector->reportResult(hostFailingServer, std::chrono::milliseconds(10), 500);
+    m_selector->reportResult(hostFailingServer, std::chrono::milliseconds(10), 500);
+    m_selector->reportResult(hostFailingServer, std::chrono::milliseconds(10), 200);
+    m_selector->reportResult(hostFailingServer, std::chrono::milliseconds(10), 500);
+    m_selector->reportResult(hostFailingServer, std::chrono::milliseconds(10), 500);
+    m_selector->reportResult(hostOtherServer, std::chrono::milliseconds(10), 200);
+    EXPECT_EQ(m_selector->getNext(), hostFailingServer);
+
+    m_selector->reportResult(hostFailingServer, std::chrono::milliseconds(10), 500);
+    EXPECT_EQ(m_selector->getNext(), hostOtherServer);
+    EXPECT_EQ(m_selector->getNext(), hostOtherServer);
+}
@@ -13,6 +13,7 @@
 #define _KEYSTORE_HPP
 
 #include <string>
+#include <vector>
 
 class Keystore final
 {
@@ -37,6 +38,23 @@ public:
      * @param value The corresponding value to be returned.
      */
     static void get(const std::string& columnFamily, const std::string& key, std::string& value);
+
+    /**
+     * Get the values of several keys in the specified column family.
+     *
+     * The database is opened once for all the keys. The decrypted values are cached in locked memory for a minute,
+     * so the lookups repeated by a module during its reconnections do not open the database nor decrypt again. The
+     * values put by this process replace the cached ones, the values put by another process are seen once the
+     * cached ones expire.
+     *
+     * @param columnFamily The target column family.
+     * @param keys The keys to be fetched.
+     * @param values The corresponding values to be returned, in the same order as the keys. Empty for the keys not
+     * found.
+     */
+    static void get(const std::string& columnFamily,
+                    const std::vector<std::string>& keys,
+                    std::vector<std::string>& values);
 };
 
 #endif // _KEYSTORE_HPP
@@ -3,6 +3,11 @@
 #include "loggerHelper.h"
 #include "rocksDBWrapper.hpp"
 #include "rsaHelper.hpp"
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <openssl/crypto.h>
+#include <sys/mman.h>
 
 // Database constants, based on the keystore path.
 constexpr auto DATABASE_PATH {"queue/keystore"};
@@ -18,6 +23,62 @@ constexpr auto KS_NAME {"keystore"};
 constexpr auto KS_VERSION {"2"};
 constexpr auto KS_VERSION_FIELD {"version"};
 
+// Time the decrypted values are kept in the cache of the batch get.
+constexpr auto KS_CACHE_TTL {std::chrono::seconds(60)};
+
+/**
+ * @brief Allocator of memory that is not swapped out and is cleared when released.
+ */
+template<typename T>
+struct LockedAllocator
+{
+    using value_type = T;
+
+    LockedAllocator() = default;
+
+    template<typename U>
+    explicit LockedAllocator(const LockedAllocator<U>& /*other*/)
+    {
+    }
+
+    T* allocate(std::size_t size)
+    {
+        auto ptr {static_cast<T*>(::operator new(size * sizeof(T)))};
+        // Best effort, the limit of locked memory of the process may have been reached.
+        mlock(ptr, size * sizeof(T));
+        return ptr;
+    }
+
+    void deallocate(T* ptr, std::size_t size)
+    {
+        // The pages are not unlocked, they may be shared with other locked values.
+        OPENSSL_cleanse(ptr, size * sizeof(T));
+        ::operator delete(ptr);
+    }
+
+    template<typename U>
+    bool operator==(const LockedAllocator<U>& /*other*/) const
+    {
+        return true;
+    }
+
+    template<typename U>
+    bool operator!=(const LockedAllocator<U>& /*other*/) const
+    {
+        return false;
+    }
+};
+
+struct CachedValue
+{
+    std::vector<char, LockedAllocator<char>> value;
+    std::chrono::steady_clock::time_point expiration;
+};
+
+// Cache of the batch get, by column family and key.
+static std::map<std::pair<std::string, std::string>, CachedValue> CACHE;
+static std::mutex CACHE_MUTEX;
+
 static void upgrade(Utils::RocksDBWrapper& keystoreDB, const std::string& columnFamily)
 {
     std::string versionValue;
@@ -100,6 +161,9 @@ void Keystore::put(const std::string& columnFamily, const std::string& key, cons
 
     // Insert the key-value pair using AES encryption.
     keystoreDB.put(key, rocksdb::Slice(encryptedValue.data(), encryptedValue.size()), columnFamily);
+
+    std::scoped_lock lock(CACHE_MUTEX);
+    CACHE.erase({columnFamily, key});
 }
 
 /**
@@ -130,3 +194,61 @@ void Keystore::get(const std::string& columnFamily, const std::string& key, std:
         EVPHelper().decryptAES256(encryptedValueVec, value);
     }
 }
+
+void Keystore::get(const std::string& columnFamily,
+                   const std::vector<std::string>& keys,
+                   std::vector<std::string>& values)
+{
+    std::scoped_lock lock(CACHE_MUTEX);
+    const auto now {std::chrono::steady_clock::now()};
+    std::vector<std::string> missingKeys;
+
+    for (const auto& key : keys)
+    {
+        const auto it {CACHE.find({columnFamily, key})};
+
+        if (it == CACHE.end() || it->second.expiration <= now)
+        {
+            missingKeys.push_back(key);
+        }
+    }
+
+    if (!missingKeys.empty())
+    {
+        auto keystoreDB = Utils::RocksDBWrapper(DATABASE_PATH, false);
+
+        if (!keystoreDB.columnExists(columnFamily))
+        {
+            keystoreDB.createColumn(columnFamily);
+        }
+
+        upgrade(keystoreDB, columnFamily);
+
+        for (const auto& key : missingKeys)
+        {
+            std::string encryptedValue;
+            std::string value;
+
+            if (keystoreDB.get(key, encryptedValue, columnFamily))
+            {
+                std::vector<char> encryptedValueVec(encryptedValue.begin(), encryptedValue.end());
+                EVPHelper().decryptAES256(encryptedValueVec, value);
+            }
+
+            // The keys not found are cached too, so a missing value does not open the database on every lookup.
+            auto& cachedValue {CACHE[{columnFamily, key}]};
+            cachedValue.value.assign(value.begin(), value.end());
+            cachedValue.expiration = now + KS_CACHE_TTL;
+            OPENSSL_cleanse(value.data(), value.size());
+        }
+    }
+
+    values.clear();
+    values.reserve(keys.size());
+
+    for (const auto& key : keys)
+    {
+        const auto& cachedValue {CACHE.at({columnFamily, key}).value};
+        values.emplace_back(cachedValue.begin(), cachedValue.end());
+    }
+}
@@ -12,6 +12,7 @@
 #include "keyStoreComponent_test.hpp"
 #include "include/keyStore.hpp"
 #include "rocksDBWrapper.hpp"
+#include "evpHelper.hpp"
 #include "rsaHelper.hpp"
 #include <fstream>
 
@@ -198,3 +199,29 @@ TEST(KeyStoreComponentTest, TestUpgradeFailWithInvalidCerts)
     Keystore::get("default", "key2", out);
     ASSERT_EQ(out, "value2");
 }
+
+TEST(KeyStoreComponentTest, TestBatchGetCache)
+{
+    std::filesystem::remove_all(DATABASE_PATH);
+
+    Keystore::put("default", "batch1", "value1");
+    Keystore::put("default", "batch2", "value2");
+
+    // Get the values in a single call, the missing keys are returned empty
+    std::vector<std::string> out;
+    Keystore::get("default", {"batch1", "batch2", "batch3"}, out);
+    ASSERT_EQ(out, std::vector<std::string>({"value1", "value2", ""}));
+
+    // A value changed by another process is not seen while cached
+    std::vector<char> encryptedValue;
+    EVPHelper().encryptAES256("other", encryptedValue);
+    Utils::RocksDBWrapper(DATABASE_PATH, false)
+        .put("batch1", rocksdb::Slice(encryptedValue.data(), encryptedValue.size()), "default");
+    Keystore::get("default", {"batch1"}, out);
+    ASSERT_EQ(out, std::vector<std::string>({"value1"}));
+
+    // A value put by this process replaces the cached one
+    Keystore::put("default", "batch1", "value3");
+    Keystore::get("default", {"batch1", "batch2"}, out);
+    ASSERT_EQ(out, std::vector<std::string>({"value3", "value2"}));
+}
@@ -0,0 +1,25 @@
+/*
+ * Wazuh router
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 14, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _ROUTER_MESSAGE_HPP
+#define _ROUTER_MESSAGE_HPP
+
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Immutable message routed to the subscribers. All the local subscribers of a provider share the same buffer,
+ * which is released once the last of them drops it.
+ *
+ */
+using RouterMessage = std::shared_ptr<const std::vector<char>>;
+
+#endif //_ROUTER_MESSAGE_HPP
@@ -19,6 +19,7 @@
 #endif
 
 #include "iRouterProvider.hpp"
+#include "routerMessage.hpp"
 #include <functional>
 #include <iostream>
 #include <memory>
@@ -52,6 +53,13 @@ public:
     void start();
     void start(const std::function<void()>& onConnect);
     void send(const std::vector<char>& data);
+
+    /**
+     * @brief Sends the data to the provider without copying it, the buffer is shared with the local subscribers.
+     *
+     * @param data Data to be sent.
+     */
+    void send(RouterMessage data);
 };
 
 #endif //_ROUTER_PROVIDER_HPP
@@ -18,6 +18,7 @@
 #define EXPORTED
 #endif
 
+#include "routerMessage.hpp"
 #include <functional>
 #include <iostream>
 #include <memory>
@@ -81,6 +82,14 @@ public:
      */
     void subscribe(const std::function<void(const std::vector<char>&)>& callback,
                    const std::function<void()>& onConnect);
+
+    /**
+     * @brief Adds subscriber to the list, receiving the shared buffer of the messages so it can be kept without a
+     * copy. The messages of a remote provider are received into a new buffer.
+     *
+     * @param callback Subscriber update callback.
+     */
+    void subscribeShared(const std::function<void(const RouterMessage&)>& callback);
 };
 
 #endif //_ROUTER_SUBSCRIBER_HPP
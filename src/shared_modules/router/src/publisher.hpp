@@ -14,6 +14,7 @@
 
 #include "filterMsgDispatcher.hpp"
 #include "provider.hpp"
+#include "routerMessage.hpp"
 #include "socketServer.hpp"
 #include "subscriber.hpp"
 #include <external/nlohmann/json.hpp>
@@ -26,10 +27,10 @@ constexpr auto PUBLISHER_DISPATCH_THREAD_COUNT {1};
  * @brief Publisher class.
  *
  */
-class Publisher final : public Provider<const std::vector<char>&>
+class Publisher final : public Provider<const RouterMessage&>
 {
 private:
-    using MsgDispatcher = Utils::FilterMsgDispatcher<const std::vector<char>&>;
+    using MsgDispatcher = Utils::FilterMsgDispatcher<RouterMessage>;
     std::unique_ptr<SocketServer<Socket<OSPrimitives>, EpollWrapper>> m_socketServer {};
     std::unique_ptr<MsgDispatcher> m_msgDispatcher {};
 
@@ -42,7 +43,7 @@ public:
      */
     explicit Publisher(const std::string& endpointName, const std::string& socketPath)
         : m_socketServer(std::make_unique<SocketServer<Socket<OSPrimitives>, EpollWrapper>>(socketPath + endpointName))
-        , m_msgDispatcher(std::make_unique<MsgDispatcher>([this, endpointName](const std::vector<char>& data)
+        , m_msgDispatcher(std::make_unique<MsgDispatcher>([this, endpointName](const RouterMessage& data)
                                                           { this->call(data); },
                                                           nullptr,
                                                           PUBLISHER_DISPATCH_THREAD_COUNT))
@@ -61,16 +62,15 @@ public:
                 {
                     if (headerString.compare("P") == 0)
                     {
-                        auto message = std::vector<char>(body, body + bodySize);
-                        msgDispatcher->push(message);
+                        msgDispatcher->push(std::make_shared<const std::vector<char>>(body, body + bodySize));
                     }
                 }
                 else
                 {
                     auto jsonBody = nlohmann::json::parse(body, body + bodySize);
-                    this->addSubscriber(std::make_shared<Subscriber<const std::vector<char>&>>(
-                        [fd, socketServer](const std::vector<char>& message)
-                        { socketServer->send(fd, message.data(), message.size()); },
+                    this->addSubscriber(std::make_shared<Subscriber<const RouterMessage&>>(
+                        [fd, socketServer](const RouterMessage& message)
+                        { socketServer->send(fd, message->data(), message->size()); },
                         jsonBody.at("subscriberId").get_ref<const std::string&>()));
 
                     const std::string responseString = R"({"Result":"OK"})";
@@ -85,6 +85,16 @@ public:
      * @param data Data to be pushed.
      */
     void push(const std::vector<char>& data)
+    {
+        m_msgDispatcher->push(std::make_shared<const std::vector<char>>(data));
+    }
+
+    /**
+     * @brief Pushes data into the message dispatcher, the buffer is shared with all the subscribers.
+     *
+     * @param data Data to be pushed.
+     */
+    void push(RouterMessage data)
     {
         m_msgDispatcher->push(data);
     }
@@ -0,0 +1,274 @@
+/*
+ * Wazuh router
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _REMOTE_MULTIPLEXER_HPP
+#define _REMOTE_MULTIPLEXER_HPP
+
+#include "epollWrapper.hpp"
+#include "remoteSubscriptionManager.hpp"
+#include "routerMessage.hpp"
+#include "socketClient.hpp"
+#include "threadDispatcher.h"
+#include <charconv>
+#include <external/nlohmann/json.hpp>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+
+// Header of the messages pushed by a provider through the multiplexed connection, followed by the topic ID.
+constexpr auto MULTIPLEXER_PROVIDER_HEADER {'P'};
+
+/**
+ * @brief RemoteMultiplexer class.
+ *
+ * Single connection of a process to the broker, shared by all its remote providers and subscribers. Each of them
+ * is registered as a topic with an ID, and the data messages carry the ID of their topic in the header. The
+ * messages of all the topics are received by the same thread, and delivered to the subscribers by another one, so
+ * the callbacks can push to the providers sharing the connection.
+ *
+ */
+class RemoteMultiplexer final
+{
+private:
+    struct Topic final
+    {
+        nlohmann::json registration;
+        std::function<void(const RouterMessage&)> onMessage;
+        std::function<void()> onConnect;
+        bool isRegistered {false};
+    };
+
+    // Message of a topic to be delivered. A delivery without message notifies the registration of the topic.
+    struct Delivery final
+    {
+        uint32_t topicId;
+        RouterMessage message;
+    };
+
+    using DeliveryDispatcher = Utils::AsyncDispatcher<Delivery, std::function<void(const Delivery&)>>;
+
+    std::map<uint32_t, Topic> m_topics {};
+    uint32_t m_nextTopicId {0};
+    std::mutex m_topicsMutex {};
+    std::unique_ptr<DeliveryDispatcher> m_deliveryDispatcher {};
+    std::unique_ptr<SocketClient<Socket<OSPrimitives>, EpollWrapper>> m_socketClient {};
+
+    void send(const nlohmann::json& jsonMsg)
+    {
+        const auto msg {jsonMsg.dump()};
+        m_socketClient->send(msg.data(), msg.size());
+    }
+
+    /**
+     * @brief Registers all the topics, on every connection to the broker.
+     *
+     */
+    void registerTopics()
+    {
+        std::vector<nlohmann::json> registrations;
+        {
+            std::lock_guard<std::mutex> lock {m_topicsMutex};
+            for (const auto& [topicId, topic] : m_topics)
+            {
+                registrations.push_back(topic.registration);
+            }
+        }
+
+        for (const auto& registration : registrations)
+        {
+            send(registration);
+        }
+    }
+
+    void deliver(const Delivery& delivery)
+    {
+        // The callbacks run with the lock held, so a topic does not receive any message once removed.
+        std::lock_guard<std::mutex> lock {m_topicsMutex};
+        const auto it {m_topics.find(delivery.topicId)};
+
+        if (it == m_topics.end())
+        {
+            return;
+        }
+
+        if (delivery.message)
+        {
+            if (it->second.onMessage)
+            {
+                it->second.onMessage(delivery.message);
+            }
+        }
+        else if (!it->second.isRegistered)
+        {
+            it->second.isRegistered = true;
+            it->second.onConnect();
+        }
+    }
+
+    void onRead(const char* body, uint32_t bodySize, const char* header, uint32_t headerSize)
+    {
+        if (headerSize > 0)
+        {
+            uint32_t topicId {0};
+            std::from_chars(header, header + headerSize, topicId);
+            m_deliveryDispatcher->push({topicId, std::make_shared<const std::vector<char>>(body, body + bodySize)});
+        }
+        else
+        {
+            // LCOV_EXCL_START
+            try
+            {
+                const auto result = nlohmann::json::parse(body, body + bodySize);
+
+                if (result.at("Result") != "OK")
+                {
+                    throw std::runtime_error(result.at("Result"));
+                }
+
+                m_deliveryDispatcher->push({result.at("TopicId").get<uint32_t>(), nullptr});
+            }
+            catch (const std::exception& e)
+            {
+                std::cerr << "RemoteMultiplexer: Invalid result: " << e.what() << std::endl;
+            }
+            // LCOV_EXCL_STOP
+        }
+    }
+
+    uint32_t addTopic(nlohmann::json registration,
+                      const std::function<void(const RouterMessage&)>& onMessage,
+                      const std::function<void()>& onConnect)
+    {
+        uint32_t topicId {0};
+        {
+            std::lock_guard<std::mutex> lock {m_topicsMutex};
+            topicId = m_nextTopicId++;
+            registration["TopicId"] = topicId;
+            m_topics[topicId] = Topic {registration, onMessage, onConnect ? onConnect : []() {}};
+        }
+
+        // Sent before any message of the topic, it is queued if the connection is not ready.
+        send(registration);
+        return topicId;
+    }
+
+public:
+    /**
+     * @brief Class constructor.
+     *
+     * @param socketPath Socket of the broker.
+     */
+    explicit RemoteMultiplexer(const std::string& socketPath = REMOTE_SUBSCRIPTION_ENDPOINT)
+        : m_deliveryDispatcher {std::make_unique<DeliveryDispatcher>(
+              [this](const Delivery& delivery) { deliver(delivery); }, 1)}
+        , m_socketClient {std::make_unique<SocketClient<Socket<OSPrimitives>, EpollWrapper>>(socketPath)}
+    {
+        m_socketClient->connect([this](const char* body, uint32_t bodySize, const char* header, uint32_t headerSize)
+                                { onRead(body, bodySize, header, headerSize); },
+                                [this]() { registerTopics(); });
+    }
+
+    ~RemoteMultiplexer()
+    {
+        // Stop the reader and the deliveries before the topics are released.
+        m_socketClient.reset();
+        m_deliveryDispatcher->cancel();
+    }
+
+    /**
+     * @brief Registers a provider.
+     *
+     * @param endpointName Name of the provider.
+     * @param onConnect Callback to be called when the provider is registered.
+     * @return Topic ID of the provider.
+     */
+    uint32_t addProvider(const std::string& endpointName, const std::function<void()>& onConnect)
+    {
+        return addTopic(
+            {{"EndpointName", endpointName}, {"MessageType", "InitProvider"}}, nullptr, onConnect);
+    }
+
+    /**
+     * @brief Registers a subscriber.
+     *
+     * @param endpointName Name of the provider.
+     * @param subscriberId Subscriber ID.
+     * @param callback Callback to be called with every message of the provider.
+     * @param onConnect Callback to be called when the subscriber is registered.
+     * @return Topic ID of the subscriber.
+     */
+    uint32_t addSubscriber(const std::string& endpointName,
+                           const std::string& subscriberId,
+                           const std::function<void(const RouterMessage&)>& callback,
+                           const std::function<void()>& onConnect)
+    {
+        return addTopic(
+            {{"EndpointName", endpointName}, {"MessageType", "Subscribe"}, {"SubscriberId", subscriberId}},
+            callback,
+            onConnect);
+    }
+
+    /**
+     * @brief Removes a topic. The subscribers are removed from the broker too.
+     *
+     * @param topicId Topic ID.
+     */
+    void removeTopic(const uint32_t topicId)
+    {
+        nlohmann::json registration;
+        {
+            std::lock_guard<std::mutex> lock {m_topicsMutex};
+            const auto it {m_topics.find(topicId)};
+
+            if (it == m_topics.end())
+            {
+                return;
+            }
+
+            registration = std::move(it->second.registration);
+            m_topics.erase(it);
+        }
+
+        if (registration.at("MessageType") == "Subscribe")
+        {
+            send({{"EndpointName", registration.at("EndpointName")},
+                  {"MessageType", "RemoveSubscriber"},
+                  {"SubscriberId", registration.at("SubscriberId")},
+                  {"TopicId", topicId}});
+        }
+    }
+
+    /**
+     * @brief Sends a message of a provider.
+     *
+     * @param header Header of the provider, from providerHeader().
+     * @param message Message to be sent.
+     */
+    void push(const std::string& header, const std::vector<char>& message)
+    {
+        m_socketClient->send(message.data(), message.size(), header.data(), header.size());
+    }
+
+    /**
+     * @brief Header of the messages of a provider.
+     *
+     * @param topicId Topic ID of the provider.
+     * @return Header to be used in push().
+     */
+    static std::string providerHeader(const uint32_t topicId)
+    {
+        return MULTIPLEXER_PROVIDER_HEADER + std::to_string(topicId);
+    }
+};
+
+#endif // _REMOTE_MULTIPLEXER_HPP
@@ -12,13 +12,10 @@
 #ifndef _REMOTE_PROVIDER_HPP
 #define _REMOTE_PROVIDER_HPP
 
-#include "epollWrapper.hpp"
-#include "observer.hpp"
-#include "remoteSubscriptionManager.hpp"
-#include "routerProvider.hpp"
-#include "socketClient.hpp"
-#include <external/nlohmann/json.hpp>
+#include "remoteMultiplexer.hpp"
+#include "routerMessage.hpp"
 #include <functional>
+#include <memory>
 
 /**
  * @brief RemoteProvider class.
@@ -27,46 +24,53 @@
 class RemoteProvider final
 {
 private:
-    std::unique_ptr<SocketClient<Socket<OSPrimitives>, EpollWrapper>> m_socketClient {};
-    std::unique_ptr<RemoteSubscriptionManager> m_remoteSubscriptionManager {};
-    std::string m_endpointName {};
+    std::shared_ptr<RemoteMultiplexer> m_remoteMultiplexer {};
+    uint32_t m_topicId {0};
+    std::string m_header {};
 
 public:
     /**
      * @brief Class constructor.
      *
      * @param endpoint Endpoint name.
-     * @param socketPath Client socket path.
+     * @param remoteMultiplexer Connection to the broker, shared by the remote providers and subscribers of the process.
      * @param onConnect Callback to be called when the provider is connected.
      */
     // LCOV_EXCL_START
-    explicit RemoteProvider(std::string endpoint,
-                            const std::string& socketPath,
+    explicit RemoteProvider(const std::string& endpoint,
+                            std::shared_ptr<RemoteMultiplexer> remoteMultiplexer,
                             const std::function<void()>& onConnect = {})
-        : m_endpointName {std::move(endpoint)}
-        , m_remoteSubscriptionManager {std::make_unique<RemoteSubscriptionManager>()}
+        : m_remoteMultiplexer {std::move(remoteMultiplexer)}
+        , m_topicId {m_remoteMultiplexer->addProvider(endpoint, onConnect)}
+        , m_header {RemoteMultiplexer::providerHeader(m_topicId)}
     {
-
-        m_socketClient =
-            std::make_unique<SocketClient<Socket<OSPrimitives>, EpollWrapper>>(socketPath + m_endpointName);
-        m_remoteSubscriptionManager->sendInitProviderMessage(
-            m_endpointName,
-            [&, onConnect, socketClient = m_socketClient.get()]()
-            { socketClient->connect([&](const char*, uint32_t, const char*, uint32_t) {}, onConnect); });
     }
     // LCOV_EXCL_STOP
 
     /**
-     * @brief Sends a message into the client socket.
+     * @brief Sends a message to the broker.
      *
      * @param message Message to be sent.
      */
     void push(const std::vector<char>& message)
     {
-        m_socketClient->send(message.data(), message.size(), "P", 1);
+        m_remoteMultiplexer->push(m_header, message);
+    }
+
+    /**
+     * @brief Sends a shared message to the broker.
+     *
+     * @param message Message to be sent.
+     */
+    void push(const RouterMessage& message)
+    {
+        push(*message);
     }
 
-    ~RemoteProvider() = default;
+    ~RemoteProvider()
+    {
+        m_remoteMultiplexer->removeTopic(m_topicId);
+    }
 };
 
 #endif // _REMOTE_PROVIDER_HPP
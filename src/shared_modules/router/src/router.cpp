@@ -11,6 +11,7 @@
 
 #include "router.h"
 #include "flatbuffers/idl.h"
+#include <unordered_map>
 #include "logging_helper.h"
 #include "routerFacade.hpp"
 #include "routerModule.hpp"
@@ -58,6 +59,12 @@ void RouterProvider::send(const std::vector<char>& data)
     RouterFacade::instance().push(m_topicName, data);
 }
 
+void RouterProvider::send(RouterMessage data)
+{
+    // Send data to the right provider, sharing the buffer.
+    RouterFacade::instance().push(m_topicName, data);
+}
+
 void RouterProvider::start()
 {
     // Add provider to the list.
@@ -126,6 +133,19 @@ void RouterSubscriber::subscribe(const std::function<void(const std::vector<char
     }
 }
 
+void RouterSubscriber::subscribeShared(const std::function<void(const RouterMessage&)>& callback)
+{
+    // Add subscriber to the list.
+    if (m_isLocal)
+    {
+        RouterFacade::instance().addSubscriber(m_topicName, m_subscriberId, callback);
+    }
+    else
+    {
+        RouterFacade::instance().addSubscriberRemote(m_topicName, m_subscriberId, callback);
+    }
+}
+
 void RouterSubscriber::unsubscribe()
 {
     // Remove subscriber to the list.
@@ -228,7 +248,7 @@ extern "C"
             }
             else
             {
-                std::vector<char> data(message, message + message_size);
+                auto data {std::make_shared<const std::vector<char>>(message, message + message_size)};
                 std::shared_lock<std::shared_mutex> lock(PROVIDERS_MUTEX);
                 PROVIDERS.at(handle)->send(data);
                 retVal = 0;
@@ -252,19 +272,34 @@ extern "C"
             }
             else
             {
-                flatbuffers::Parser parser;
-                if (!parser.Parse(schema))
+                // The schema is parsed once per thread. Clearing the builder keeps its buffer, so it is only grown
+                // by the first messages instead of being allocated for every message.
+                thread_local std::unordered_map<std::string, std::unique_ptr<flatbuffers::Parser>> parsers;
+                auto& parser {parsers[schema]};
+
+                if (!parser)
                 {
-                    throw std::runtime_error("Error parsing schema, " + std::string(parser.error_));
+                    parser = std::make_unique<flatbuffers::Parser>();
+                    if (!parser->Parse(schema))
+                    {
+                        const std::string error {parser->error_};
+                        parsers.erase(schema);
+                        throw std::runtime_error("Error parsing schema, " + error);
+                    }
                 }
 
-                if (!parser.Parse(message))
+                parser->builder_.Clear();
+                if (!parser->Parse(message))
                 {
-                    throw std::runtime_error("Error parsing message, " + std::string(parser.error_));
+                    // Do not reuse a parser left in the middle of a message.
+                    const std::string error {parser->error_};
+                    parsers.erase(schema);
+                    throw std::runtime_error("Error parsing message, " + error);
                 }
 
-                std::vector<char> data(parser.builder_.GetBufferPointer(),
-                                       parser.builder_.GetBufferPointer() + parser.builder_.GetSize());
+                const auto& builder {parser->builder_};
+                auto data {std::make_shared<const std::vector<char>>(
+                    builder.GetBufferPointer(), builder.GetBufferPointer() + builder.GetSize())};
                 std::shared_lock<std::shared_mutex> lock(PROVIDERS_MUTEX);
                 PROVIDERS.at(handle)->send(data);
                 retVal = 0;
@@ -13,6 +13,7 @@
 #include "observer.hpp"
 #include "socketServer.hpp"
 #include "subscriber.hpp"
+#include <charconv>
 #include <external/nlohmann/json.hpp>
 
 constexpr auto DEFAULT_SOCKET_PATH = "queue/router/";
@@ -28,8 +29,21 @@ void RouterFacade::initialize()
         std::make_unique<SocketServer<Socket<OSPrimitives>, EpollWrapper>>(REMOTE_SUBSCRIPTION_ENDPOINT);
     m_providerRegistrationServer->listen(
         [providerRegistrationServer = m_providerRegistrationServer.get()](
-            const int fd, const char* body, const uint32_t bodySize, const char*, const uint32_t)
+            const int fd, const char* body, const uint32_t bodySize, const char* header, const uint32_t headerSize)
         {
+            // The messages of the multiplexed providers carry their topic ID in the header.
+            if (headerSize > 0)
+            {
+                if (header[0] == MULTIPLEXER_PROVIDER_HEADER)
+                {
+                    uint32_t topicId {0};
+                    std::from_chars(header + 1, header + headerSize, topicId);
+                    RouterFacade::instance().pushMultiplexed(
+                        fd, topicId, std::make_shared<const std::vector<char>>(body, body + bodySize));
+                }
+                return;
+            }
+
             auto message = nlohmann::json::parse(body, body + bodySize);
             nlohmann::json result;
             // Register provider
@@ -38,8 +52,38 @@ void RouterFacade::initialize()
                 const std::string messageType = message.at("MessageType");
                 if (messageType.compare("InitProvider") == 0)
                 {
-                    RouterFacade::instance().initProviderLocal(
-                        message.at("EndpointName").get_ref<const std::string&>());
+                    const auto& endpointName {message.at("EndpointName").get_ref<const std::string&>()};
+
+                    if (message.contains("TopicId"))
+                    {
+                        RouterFacade::instance().initProviderMultiplexed(
+                            endpointName, fd, message.at("TopicId").get<uint32_t>());
+                    }
+                    else
+                    {
+                        RouterFacade::instance().initProviderLocal(endpointName);
+                    }
+                }
+                else if (messageType.compare("Subscribe") == 0)
+                {
+                    // The messages are sent through the multiplexed connection, with the topic ID of the subscriber.
+                    RouterFacade::instance().addSubscriber(
+                        message.at("EndpointName").get_ref<const std::string&>(),
+                        message.at("SubscriberId").get_ref<const std::string&>(),
+                        [fd,
+                         topicId = std::to_string(message.at("TopicId").get<uint32_t>()),
+                         providerRegistrationServer](const RouterMessage& data)
+                        {
+                            try
+                            {
+                                providerRegistrationServer->send(
+                                    fd, data->data(), data->size(), topicId.data(), topicId.size());
+                            }
+                            catch (const std::exception&)
+                            {
+                                // The connection of the subscriber is closed.
+                            }
+                        });
                 }
                 else if (messageType.compare("RemoveSubscriber") == 0)
                 {
@@ -58,6 +102,11 @@ void RouterFacade::initialize()
                 result["Result"] = e.what();
             }
 
+            if (message.contains("TopicId"))
+            {
+                result["TopicId"] = message.at("TopicId");
+            }
+
             const auto resultStr {result.dump()};
             providerRegistrationServer->send(fd, resultStr.data(), resultStr.size());
         });
@@ -71,8 +120,47 @@ void RouterFacade::destroy()
     }
     m_remoteSubscribers.clear();
     m_remoteProviders.clear();
+    // The multiplexed subscribers send through the registration server, so the providers are released first.
+    {
+        std::unique_lock<std::shared_mutex> lock {m_providersMutex};
+        m_providers.clear();
+    }
     m_providerRegistrationServer.reset();
-    m_providers.clear();
+    m_multiplexedProviders.clear();
+}
+
+void RouterFacade::initProviderMultiplexed(const std::string& endpointName, const int fd, const uint32_t topicId)
+{
+    initProviderLocal(endpointName);
+
+    std::lock_guard<std::mutex> lock {m_multiplexedProvidersMutex};
+    m_multiplexedProviders[{fd, topicId}] = endpointName;
+}
+
+std::shared_ptr<RemoteMultiplexer> RouterFacade::remoteMultiplexer()
+{
+    std::lock_guard<std::mutex> lock {m_remoteMultiplexerMutex};
+    auto remoteMultiplexer {m_remoteMultiplexer.lock()};
+
+    if (!remoteMultiplexer)
+    {
+        remoteMultiplexer = std::make_shared<RemoteMultiplexer>();
+        m_remoteMultiplexer = remoteMultiplexer;
+    }
+
+    return remoteMultiplexer;
+}
+
+void RouterFacade::pushMultiplexed(const int fd, const uint32_t topicId, RouterMessage data)
+{
+    std::string endpointName;
+    {
+        std::lock_guard<std::mutex> lock {m_multiplexedProvidersMutex};
+        endpointName = m_multiplexedProviders.at({fd, topicId});
+    }
+
+    std::shared_lock<std::shared_mutex> lock {m_providersMutex};
+    m_providers.at(endpointName)->push(std::move(data));
 }
 
 void RouterFacade::initProviderLocal(const std::string& endpointName)
@@ -107,7 +195,7 @@ void RouterFacade::initProviderRemote(const std::string& name, const std::functi
     }
 
     // Send a message to the provider from the client side to add a remote provider
-    m_remoteProviders[name] = std::make_shared<RemoteProvider>(name, DEFAULT_SOCKET_PATH, onConnect);
+    m_remoteProviders[name] = std::make_shared<RemoteProvider>(name, remoteMultiplexer(), onConnect);
 }
 
 void RouterFacade::removeProviderRemote(const std::string& name)
@@ -125,6 +213,13 @@ void RouterFacade::removeProviderRemote(const std::string& name)
 void RouterFacade::addSubscriber(const std::string& name,
                                  const std::string& subscriberId,
                                  const std::function<void(const std::vector<char>&)>& callback)
+{
+    addSubscriber(name, subscriberId, [callback](const RouterMessage& data) { callback(*data); });
+}
+
+void RouterFacade::addSubscriber(const std::string& name,
+                                 const std::string& subscriberId,
+                                 const std::function<void(const RouterMessage&)>& callback)
 {
     std::lock_guard<std::shared_mutex> lock {m_providersMutex};
     // If not exist, create it.
@@ -133,13 +228,22 @@ void RouterFacade::addSubscriber(const std::string& name,
         m_providers.emplace(name, std::make_unique<Publisher>(name, DEFAULT_SOCKET_PATH));
     }
 
-    m_providers[name]->addSubscriber(std::make_shared<Subscriber<const std::vector<char>&>>(callback, subscriberId));
+    m_providers[name]->addSubscriber(std::make_shared<Subscriber<const RouterMessage&>>(callback, subscriberId));
 }
 
 void RouterFacade::addSubscriberRemote(const std::string& name,
                                        const std::string& subscriberId,
                                        const std::function<void(const std::vector<char>&)>& callback,
                                        const std::function<void()>& onConnect)
+{
+    addSubscriberRemote(
+        name, subscriberId, [callback](const RouterMessage& data) { callback(*data); }, onConnect);
+}
+
+void RouterFacade::addSubscriberRemote(const std::string& name,
+                                       const std::string& subscriberId,
+                                       const std::function<void(const RouterMessage&)>& callback,
+                                       const std::function<void()>& onConnect)
 {
     std::lock_guard<std::mutex> lock {m_remoteSubscribersMutex};
     // If exist throw exception
@@ -150,7 +254,7 @@ void RouterFacade::addSubscriberRemote(const std::string& name,
 
     // Send a message to the provider from the client side to add a remote subscriber
     m_remoteSubscribers[name] =
-        std::make_shared<RemoteSubscriber>(name, subscriberId, callback, DEFAULT_SOCKET_PATH, onConnect);
+        std::make_shared<RemoteSubscriber>(name, subscriberId, callback, remoteMultiplexer(), onConnect);
 }
 
 void RouterFacade::removeSubscriberRemote(const std::string& name, const std::string& subscriberId)
@@ -174,6 +278,17 @@ void RouterFacade::removeSubscriberLocal(const std::string& name, const std::str
 }
 
 void RouterFacade::push(const std::string& name, const std::vector<char>& data)
+{
+    pushData(name, data);
+}
+
+void RouterFacade::push(const std::string& name, const RouterMessage& data)
+{
+    pushData(name, data);
+}
+
+template<typename TData>
+void RouterFacade::pushData(const std::string& name, const TData& data)
 {
     std::unique_lock<std::mutex> lockRemoteProviders {m_remoteProvidersMutex};
     const auto itRemoteProvider {m_remoteProviders.find(name)};
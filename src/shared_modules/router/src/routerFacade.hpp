@@ -13,6 +13,7 @@
 #define _ROUTER_FACADE_HPP
 
 #include "publisher.hpp"
+#include "remoteMultiplexer.hpp"
 #include "remoteProvider.hpp"
 #include "remoteSubscriber.hpp"
 #include "remoteSubscriptionManager.hpp"
@@ -43,6 +44,17 @@ public:
                        const std::string& subscriberId,
                        const std::function<void(const std::vector<char>&)>& callback);
 
+    /**
+     * @brief Adds a subscriber to a given provider, receiving the shared buffer of the messages.
+     *
+     * @param name Provider name.
+     * @param subscriberId Subscriber ID.
+     * @param callback Subscriber update callback.
+     */
+    void addSubscriber(const std::string& name,
+                       const std::string& subscriberId,
+                       const std::function<void(const RouterMessage&)>& callback);
+
     /**
      * @brief Adds a subscriber to a given remote provider.
      *
@@ -57,6 +69,20 @@ public:
         const std::function<void(const std::vector<char>&)>& callback,
         const std::function<void()>& onConnect = []() {});
 
+    /**
+     * @brief Adds a subscriber to a given remote provider, receiving each message in a new shared buffer.
+     *
+     * @param name Provider name.
+     * @param subscriberId Subscriber ID.
+     * @param callback Subscriber update callback.
+     * @param onConnect Callback to be called when the subscriber is connected.
+     */
+    void addSubscriberRemote(
+        const std::string& name,
+        const std::string& subscriberId,
+        const std::function<void(const RouterMessage&)>& callback,
+        const std::function<void()>& onConnect = []() {});
+
     /**
      * @brief Removes a local subscriber.
      *
@@ -113,6 +139,14 @@ public:
      */
     void push(const std::string& name, const std::vector<char>& data);
 
+    /**
+     * @brief Push a shared buffer into a provider, without copying it for the local subscribers.
+     *
+     * @param name Provider name.
+     * @param data Data to be pushed.
+     */
+    void push(const std::string& name, const RouterMessage& data);
+
     // From modulesd-router
 
     /**
@@ -135,6 +169,40 @@ private:
     std::unordered_map<std::string, std::shared_ptr<RemoteProvider>> m_remoteProviders {};
     std::mutex m_remoteSubscribersMutex {};
     std::mutex m_remoteProvidersMutex {};
+    std::weak_ptr<RemoteMultiplexer> m_remoteMultiplexer {};
+    std::mutex m_remoteMultiplexerMutex {};
+    // Endpoint of the providers pushing through a multiplexed connection, by connection and topic ID.
+    std::map<std::pair<int, uint32_t>, std::string> m_multiplexedProviders {};
+    std::mutex m_multiplexedProvidersMutex {};
+
+    /**
+     * @brief Returns the connection to the broker shared by the remote providers and subscribers, created by the
+     * first of them and closed with the last one.
+     *
+     * @return Connection to the broker.
+     */
+    std::shared_ptr<RemoteMultiplexer> remoteMultiplexer();
+
+    /**
+     * @brief Initializes a local provider that receives its data from a multiplexed connection.
+     *
+     * @param endpointName Provider name.
+     * @param fd Descriptor of the connection.
+     * @param topicId Topic ID of the provider in the connection.
+     */
+    void initProviderMultiplexed(const std::string& endpointName, int fd, uint32_t topicId);
+
+    /**
+     * @brief Pushes the data of a provider received from a multiplexed connection.
+     *
+     * @param fd Descriptor of the connection.
+     * @param topicId Topic ID of the provider.
+     * @param data Data to be pushed.
+     */
+    void pushMultiplexed(int fd, uint32_t topicId, RouterMessage data);
+
+    template<typename TData>
+    void pushData(const std::string& name, const TData& data);
 };
 
 #endif /* _ROUTER_FACADE_HPP */
@@ -120,6 +120,37 @@ TEST_F(RouterInterfaceTest, TestSendMessage)
     EXPECT_EQ(count, MESSAGE_COUNT);
 }
 
+TEST_F(RouterInterfaceTest, TestSendSharedMessage)
+{
+    auto provider {std::make_unique<RouterProvider>("test")};
+    auto subscriptorA = std::make_unique<RouterSubscriber>("test", "subscriberTestA");
+    auto subscriptorB = std::make_unique<RouterSubscriber>("test", "subscriberTestB");
+
+    auto payloadString = std::string("abc");
+    auto payload {std::make_shared<const std::vector<char>>(payloadString.begin(), payloadString.end())};
+
+    std::atomic<int> count = 0;
+
+    EXPECT_NO_THROW({ provider->start(); });
+
+    // Both subscribers receive the buffer sent by the provider, without copies.
+    const auto callback = [&](const RouterMessage& message)
+    {
+        EXPECT_EQ(message.get(), payload.get());
+        count++;
+    };
+
+    EXPECT_NO_THROW({ subscriptorA->subscribeShared(callback); });
+    EXPECT_NO_THROW({ subscriptorB->subscribeShared(callback); });
+
+    EXPECT_NO_THROW({ provider->send(payload); });
+
+    provider->stop();
+    provider.reset();
+
+    EXPECT_EQ(count, 2);
+}
+
 TEST_F(RouterInterfaceTest, TestSendMessageAfterSubscribeRemove)
 {
     auto provider {std::make_unique<RouterProvider>("test")};
@@ -392,6 +423,64 @@ TEST_F(RouterInterfaceTest, TestRemoteSendMessageAfterProviderShutdown)
     EXPECT_EQ(count, 0);
 }
 
+TEST_F(RouterInterfaceTest, TestRemoteSendMessageMultipleTopics)
+{
+    // All the remote providers and subscribers of the process share the same connection to the broker
+    auto providerA {std::make_unique<RouterProvider>("test-a", false)};
+    auto providerB {std::make_unique<RouterProvider>("test-b", false)};
+    auto subscriptorA = std::make_unique<RouterSubscriber>("test-a", "subscriberTest", false);
+    auto subscriptorB = std::make_unique<RouterSubscriber>("test-b", "subscriberTest", false);
+
+    std::atomic<int> countA = 0;
+    std::atomic<int> countB = 0;
+    constexpr auto MESSAGE_COUNT = 5;
+    std::promise<void> promiseSubscriberA;
+    std::promise<void> promiseSubscriberB;
+    std::promise<void> promiseConnectedA;
+    std::promise<void> promiseConnectedB;
+
+    subscriptorA->subscribe(
+        [&](const std::vector<char>& message)
+        {
+            EXPECT_EQ(std::string(message.begin(), message.end()), "a");
+            if (++countA == MESSAGE_COUNT)
+            {
+                promiseSubscriberA.set_value();
+            }
+        },
+        [&]() { promiseConnectedA.set_value(); });
+    subscriptorB->subscribe(
+        [&](const std::vector<char>& message)
+        {
+            EXPECT_EQ(std::string(message.begin(), message.end()), "b");
+            if (++countB == MESSAGE_COUNT)
+            {
+                promiseSubscriberB.set_value();
+            }
+        },
+        [&]() { promiseConnectedB.set_value(); });
+    promiseConnectedA.get_future().wait();
+    promiseConnectedB.get_future().wait();
+
+    providerA->start();
+    providerB->start();
+
+    for (int i = 0; i < MESSAGE_COUNT; i++)
+    {
+        EXPECT_NO_THROW({ providerA->send(std::vector<char> {'a'}); });
+        EXPECT_NO_THROW({ providerB->send(std::vector<char> {'b'}); });
+    }
+
+    EXPECT_EQ(promiseSubscriberA.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_EQ(promiseSubscriberB.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+
+    providerA->stop();
+    providerB->stop();
+
+    EXPECT_EQ(countA, MESSAGE_COUNT);
+    EXPECT_EQ(countB, MESSAGE_COUNT);
+}
+
 TEST_F(RouterInterfaceTestNoBroker, ShutdownWithoutBrokerProvider)
 {
     auto provider {std::make_unique<RouterProvider>("test", false)};
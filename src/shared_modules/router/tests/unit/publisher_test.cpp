@@ -175,7 +175,8 @@ TEST_F(PublisherTest, TestPublishSocketWithoutP)
     }
     )"_json;
     const auto routerMessagePayload = routerMessageJson.dump();
-    const auto routerMessage = std::vector<char>(routerMessagePayload.begin(), routerMessagePayload.end());
+    const auto routerMessage =
+        std::make_shared<const std::vector<char>>(routerMessagePayload.begin(), routerMessagePayload.end());
     publisher->call(routerMessage);
 
     {
@@ -0,0 +1,102 @@
+/*
+ * Wazuh RSYNC
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _CHECKSUM_CACHE_HPP
+#define _CHECKSUM_CACHE_HPP
+
+#include "commonDefs.h"
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace RSync
+{
+    /**
+     * @brief Range checksums computed for each table, valid while the dbsync data version doesn't change.
+     *
+     * @tparam TValue Checksums of a range.
+     */
+    template <typename TValue>
+    class ChecksumCache final
+    {
+        public:
+            bool get(const RSYNC_HANDLE key,
+                     const std::string& table,
+                     const std::string& range,
+                     const uint64_t dataVersion,
+                     TValue& value)
+            {
+                std::lock_guard<std::mutex> lock{ m_mutex };
+                const auto it { m_data.find(key) };
+
+                if (it != m_data.end())
+                {
+                    const auto itTable { it->second.find(table) };
+
+                    if (itTable != it->second.end() && itTable->second.dataVersion == dataVersion)
+                    {
+                        const auto itRange { itTable->second.ranges.find(range) };
+
+                        if (itRange != itTable->second.ranges.end())
+                        {
+                            value = itRange->second;
+                            return true;
+                        }
+                    }
+                }
+
+                return false;
+            }
+
+            void set(const RSYNC_HANDLE key,
+                     const std::string& table,
+                     const std::string& range,
+                     const uint64_t dataVersion,
+                     const TValue& value)
+            {
+                std::lock_guard<std::mutex> lock{ m_mutex };
+                auto& tableChecksums { m_data[key][table] };
+
+                // The checksums of the previous versions won't be valid again.
+                if (tableChecksums.dataVersion != dataVersion)
+                {
+                    tableChecksums.ranges.clear();
+                    tableChecksums.dataVersion = dataVersion;
+                }
+
+                tableChecksums.ranges[range] = value;
+            }
+
+            void stop(const RSYNC_HANDLE key)
+            {
+                std::lock_guard<std::mutex> lock{ m_mutex };
+                m_data.erase(key);
+            }
+
+            void clear()
+            {
+                std::lock_guard<std::mutex> lock{ m_mutex };
+                m_data.clear();
+            }
+
+        private:
+            struct TableChecksums final
+            {
+                uint64_t dataVersion { 0 };
+                std::map<std::string, TValue> ranges;
+            };
+
+            std::unordered_map<RSYNC_HANDLE, std::unordered_map<std::string, TableChecksums>> m_data;
+            std::mutex m_mutex;
+    };
+} // namespace RSync
+#endif // _CHECKSUM_CACHE_HPP
@@ -29,6 +29,10 @@ namespace RSync
             {
                 DBSync(m_dbsyncHandle).selectRows(data, callbackData);
             }
+            virtual uint64_t dataVersion()
+            {
+                return DBSync(m_dbsyncHandle).dataVersion();
+            }
             // LCOV_EXCL_START
             virtual ~DBSyncWrapper() = default;
             // LCOV_EXCL_STOP
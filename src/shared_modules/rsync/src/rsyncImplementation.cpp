@@ -21,11 +21,13 @@
 using namespace RSync;
 
 SynchronizationController RSyncImplementation::m_synchronizationController;
+ChecksumCache<ChecksumContext> RSyncImplementation::m_checksumCache;
 
 void RSyncImplementation::release()
 {
     std::lock_guard<std::mutex> lock{ m_mutex };
     m_synchronizationController.clear();
+    m_checksumCache.clear();
 
     for (const auto& ctx : m_remoteSyncContexts)
     {
@@ -42,17 +44,27 @@ void RSyncImplementation::releaseContext(const RSYNC_HANDLE handle)
     remoteSyncContext(handle)->m_msgDispatcher->rundown();
     std::lock_guard<std::mutex> lock{ m_mutex };
     m_synchronizationController.stop(handle);
+    m_checksumCache.stop(handle);
     m_remoteSyncContexts.erase(handle);
 }
 
 RSYNC_HANDLE RSyncImplementation::create(const unsigned int threadPoolSize, const size_t maxQueueSize)
 {
+    const auto poolSize { threadPoolSize ? threadPoolSize : 1 };
+    std::lock_guard<std::mutex> lock{m_mutex};
+    auto spExecutor { m_executors[poolSize].lock() };
+
+    if (!spExecutor)
+    {
+        spExecutor = std::make_shared<Utils::WorkStealingExecutor>(poolSize);
+        m_executors[poolSize] = spExecutor;
+    }
+
     const auto spRSyncContext
     {
-        std::make_shared<RSyncContext>(threadPoolSize, maxQueueSize)
+        std::make_shared<RSyncContext>(spExecutor, maxQueueSize)
     };
     const RSYNC_HANDLE handle{ spRSyncContext.get() };
-    std::lock_guard<std::mutex> lock{m_mutex};
     m_remoteSyncContexts[handle] = spRSyncContext;
     return handle;
 }
@@ -94,7 +106,7 @@ void RSyncImplementation::startRSync(const RSYNC_HANDLE handle,
             {
                 checksumCtx.rightCtx.begin = begin;
                 checksumCtx.rightCtx.end   = end;
-                fillChecksum(spDBSyncWrapper, startConfiguration, begin, end, checksumCtx);
+                fillChecksum(handle, spDBSyncWrapper, startConfiguration, begin, end, checksumCtx);
             }
             else
             {
@@ -104,7 +116,7 @@ void RSyncImplementation::startRSync(const RSYNC_HANDLE handle,
                 const auto endString{std::to_string(endNumber)};
                 checksumCtx.rightCtx.begin = beginString;
                 checksumCtx.rightCtx.end   = endString;
-                fillChecksum(spDBSyncWrapper, startConfiguration, beginString, endString, checksumCtx);
+                fillChecksum(handle, spDBSyncWrapper, startConfiguration, beginString, endString, checksumCtx);
             }
         }
         else
@@ -164,7 +176,7 @@ void RSyncImplementation::registerSyncId(const RSYNC_HANDLE handle,
 
                 if (0 == syncData.command.compare("checksum_fail"))
                 {
-                    sendChecksumFail(spDBSyncWrapper, syncConfiguration, callbackWrapper, syncData);
+                    sendChecksumFail(handle, spDBSyncWrapper, syncConfiguration, callbackWrapper, syncData);
                 }
                 else if (0 == syncData.command.compare("no_data"))
                 {
@@ -197,7 +209,8 @@ void RSyncImplementation::push(const RSYNC_HANDLE handle, const std::vector<unsi
     spRSyncContext->m_msgDispatcher->push(data);
 }
 
-void RSyncImplementation::sendChecksumFail(const std::shared_ptr<DBSyncWrapper>& spDBSyncWrapper,
+void RSyncImplementation::sendChecksumFail(const RSYNC_HANDLE handle,
+                                           const std::shared_ptr<DBSyncWrapper>& spDBSyncWrapper,
                                            const nlohmann::json& jsonSyncConfiguration,
                                            const ResultCallback callbackWrapper,
                                            const SyncInputData syncData)
@@ -224,7 +237,7 @@ void RSyncImplementation::sendChecksumFail(const std::shared_ptr<DBSyncWrapper>&
         checksumCtx.rightCtx.id = syncData.id;
         checksumCtx.rightCtx.type = IntegrityMsgType::INTEGRITY_CHECK_RIGHT;
         checksumCtx.rightCtx.end = syncData.end;
-        fillChecksum(spDBSyncWrapper, jsonSyncConfiguration, syncData.begin, syncData.end, checksumCtx);
+        fillChecksum(handle, spDBSyncWrapper, jsonSyncConfiguration, syncData.begin, syncData.end, checksumCtx);
 
         messageCreator->send(callbackWrapper, jsonSyncConfiguration, checksumCtx.leftCtx);
         messageCreator->send(callbackWrapper, jsonSyncConfiguration, checksumCtx.rightCtx);
@@ -270,12 +283,41 @@ size_t RSyncImplementation::getRangeCount(const std::shared_ptr<DBSyncWrapper>&
 }
 
 
-void RSyncImplementation::fillChecksum(const std::shared_ptr<DBSyncWrapper>& spDBSyncWrapper,
+void RSyncImplementation::fillChecksum(const RSYNC_HANDLE handle,
+                                       const std::shared_ptr<DBSyncWrapper>& spDBSyncWrapper,
                                        const nlohmann::json& jsonSyncConfiguration,
                                        const std::string& begin,
                                        const std::string& end,
                                        ChecksumContext& ctx)
 {
+    // The checksums of a range are reused while the rows of the database don't change, e.g. on idle agents.
+    const auto& table { jsonSyncConfiguration.at("table").get_ref<const std::string&>() };
+    const auto range { begin + '\n' + end + '\n' + std::to_string(ctx.size) };
+    auto dataVersion { 0ull };
+    auto cacheable { true };
+
+    try
+    {
+        dataVersion = spDBSyncWrapper->dataVersion();
+    }
+    catch (const std::exception& ex)
+    {
+        logDebug2(RSYNC_LOG_TAG, "Unable to get the data version, the checksums aren't cached: %s", ex.what());
+        cacheable = false;
+    }
+
+    ChecksumContext cachedCtx;
+
+    if (cacheable && m_checksumCache.get(handle, table, range, dataVersion, cachedCtx))
+    {
+        ctx.leftCtx.checksum = cachedCtx.leftCtx.checksum;
+        ctx.leftCtx.tail = cachedCtx.leftCtx.tail;
+        ctx.leftCtx.end = cachedCtx.leftCtx.end;
+        ctx.rightCtx.checksum = cachedCtx.rightCtx.checksum;
+        ctx.rightCtx.begin = cachedCtx.rightCtx.begin;
+        return;
+    }
+
     nlohmann::json selectData;
     selectData["table"] = jsonSyncConfiguration.at("table");
 
@@ -328,6 +370,11 @@ void RSyncImplementation::fillChecksum(const std::shared_ptr<DBSyncWrapper>& spD
 
     // rightCtx field will have the final checksum
     ctx.rightCtx.checksum = Utils::asciiToHex(hash->hash());
+
+    if (cacheable)
+    {
+        m_checksumCache.set(handle, table, range, dataVersion, ctx);
+    }
 }
 
 nlohmann::json RSyncImplementation::getRowData(const std::shared_ptr<DBSyncWrapper>& spDBSyncWrapper,
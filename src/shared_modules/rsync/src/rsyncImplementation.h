@@ -25,6 +25,7 @@
 #include "dbsyncWrapper.h"
 #include "cjsonSmartDeleter.hpp"
 #include "synchronizationController.hpp"
+#include "checksumCache.hpp"
 
 namespace RSync
 {
@@ -114,8 +115,8 @@ namespace RSync
             class RSyncContext final
             {
                 public:
-                    RSyncContext(const unsigned int threadPoolSize, const size_t maxQueueSize)
-                        : m_msgDispatcher { std::make_shared<MsgDispatcher>(threadPoolSize, maxQueueSize) }
+                    RSyncContext(std::shared_ptr<Utils::WorkStealingExecutor> executor, const size_t maxQueueSize)
+                        : m_msgDispatcher { std::make_shared<MsgDispatcher>(std::move(executor), maxQueueSize) }
                     { }
                     std::shared_ptr<MsgDispatcher> m_msgDispatcher;
             };
@@ -126,7 +127,8 @@ namespace RSync
                                         const nlohmann::json& jsonSyncConfiguration,
                                         const SyncInputData& syncData);
 
-            static void fillChecksum(const std::shared_ptr<DBSyncWrapper>& spDBSyncWrapper,
+            static void fillChecksum(const RSYNC_HANDLE handle,
+                                     const std::shared_ptr<DBSyncWrapper>& spDBSyncWrapper,
                                      const nlohmann::json& jsonConfiguration,
                                      const std::string& begin,
                                      const std::string& end,
@@ -146,7 +148,8 @@ namespace RSync
                                     const ResultCallback callbackWrapper,
                                     const SyncInputData& ctx);
 
-            static void sendChecksumFail(const std::shared_ptr<DBSyncWrapper>& spDBSyncWrapper,
+            static void sendChecksumFail(const RSYNC_HANDLE handle,
+                                         const std::shared_ptr<DBSyncWrapper>& spDBSyncWrapper,
                                          const nlohmann::json& jsonSyncConfiguration,
                                          const ResultCallback callbackWrapper,
                                          const SyncInputData syncData);
@@ -156,9 +159,12 @@ namespace RSync
             RSyncImplementation(const RSyncImplementation&) = delete;
             RSyncImplementation& operator=(const RSyncImplementation&) = delete;
             std::map<RSYNC_HANDLE, std::shared_ptr<RSyncContext>> m_remoteSyncContexts;
+            // The contexts with the same pool size share the threads that dispatch their messages
+            std::map<unsigned int, std::weak_ptr<Utils::WorkStealingExecutor>> m_executors;
             std::mutex m_mutex;
             RegistrationController m_registrationController;
             static SynchronizationController m_synchronizationController;
+            static ChecksumCache<ChecksumContext> m_checksumCache;
     };
 }// namespace RSync
 
@@ -703,3 +703,56 @@ TEST_F(RSyncImplementationTest, ValidDecoderPushedChecksumFailInvalidSize)
     EXPECT_NO_THROW(RSync::RSyncImplementation::instance().release());
 }
 
+TEST_F(RSyncImplementationTest, ChecksumReusedWhileDataUnchanged)
+{
+    const auto handle { RSync::RSyncImplementation::instance().create() };
+    auto mockDbSync { std::make_shared<MockDBSync>() };
+    auto checksumQueries { 0 };
+
+    EXPECT_CALL(*mockDbSync, dataVersion())
+    .WillOnce(testing::Return(1))
+    .WillOnce(testing::Return(1))
+    .WillOnce(testing::Return(2));
+    EXPECT_CALL(*mockDbSync, select(_, _)).WillRepeatedly(testing::Invoke(
+                                                               [&checksumQueries](nlohmann::json & data, ResultCallbackData callback)
+    {
+        const auto& query { data.at("query") };
+
+        if (query.at("order_by_opt") == "path ASC")
+        {
+            callback(SELECTED, R"({"path":"a"})"_json);
+        }
+        else if (query.at("order_by_opt") == "path DESC")
+        {
+            callback(SELECTED, R"({"path":"c"})"_json);
+        }
+        else
+        {
+            ++checksumQueries;
+            callback(SELECTED, R"({"path":"a","checksum":"1"})"_json);
+            callback(SELECTED, R"({"path":"c","checksum":"2"})"_json);
+        }
+    }));
+
+    std::vector<std::string> checksums;
+    SyncCallbackData callbackData
+    {
+        [&checksums](const std::string & payload)
+        {
+            checksums.push_back(nlohmann::json::parse(payload).at("data").at("checksum"));
+        }
+    };
+
+    // The second sync reuses the checksum, the third one computes it again as the data changed.
+    EXPECT_NO_THROW(RSync::RSyncImplementation::instance().startRSync(handle, mockDbSync, g_startConfigStmt, callbackData));
+    EXPECT_NO_THROW(RSync::RSyncImplementation::instance().startRSync(handle, mockDbSync, g_startConfigStmt, callbackData));
+    EXPECT_NO_THROW(RSync::RSyncImplementation::instance().startRSync(handle, mockDbSync, g_startConfigStmt, callbackData));
+
+    EXPECT_EQ(2, checksumQueries);
+    ASSERT_EQ(3u, checksums.size());
+    EXPECT_FALSE(checksums[0].empty());
+    EXPECT_EQ(checksums[0], checksums[1]);
+    EXPECT_EQ(checksums[0], checksums[2]);
+
+    EXPECT_NO_THROW(RSync::RSyncImplementation::instance().release());
+}
@@ -27,6 +27,11 @@ class MockDBSync : public RSync::DBSyncWrapper
                     (nlohmann::json&, ResultCallbackData),
                     (override));
 
+        MOCK_METHOD(uint64_t,
+                    dataVersion,
+                    (),
+                    (override));
+
 };
 
 #endif //_MOCKDBSYNC_TEST_H
@@ -0,0 +1,87 @@
+#include <benchmark/benchmark.h>
+#include <sstream>
+#include <string>
+#include "json.hpp"
+#include "jsonArrayParser.hpp"
+
+constexpr auto FEED_ITEMS = 10000;
+
+static const std::string& feed()
+{
+    static const std::string content = []()
+    {
+        auto items = nlohmann::json::array();
+        for (int i = 0; i < FEED_ITEMS; i++)
+        {
+            auto item = nlohmann::json::object();
+            item["id"] = "CVE-2024-" + std::to_string(i);
+            item["published"] = "2024-01-01T00:00:00Z";
+            item["description"] = "Buffer overflow in \"component\" allows [remote] attackers to execute code.";
+            item["metrics"] = {{"baseScore", 9.8}, {"vectorString", "CVSS:3.1/AV:N/AC:L/PR:N/UI:N/S:U/C:H/I:H/A:H"}};
+            item["references"] = {"https://example.com/a", "https://example.com/b"};
+            items.push_back(std::move(item));
+        }
+        nlohmann::json document;
+        document["data"] = std::move(items);
+        return document.dump();
+    }();
+    return content;
+}
+
+static void saxParseBenchmark(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        std::istringstream input {feed()};
+        JsonArray::parse(
+            input,
+            [](nlohmann::json&& item, const size_t /*itemId*/)
+            {
+                benchmark::DoNotOptimize(item);
+                return true;
+            },
+            "/data"_json_pointer);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * feed().size()));
+}
+
+BENCHMARK(saxParseBenchmark);
+
+static void scanBenchmark(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        std::istringstream input {feed()};
+        JsonArray::scan(
+            input,
+            [](std::string_view item, const size_t /*itemId*/)
+            {
+                benchmark::DoNotOptimize(item);
+                return true;
+            },
+            "/data"_json_pointer);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * feed().size()));
+}
+
+BENCHMARK(scanBenchmark);
+
+static void scanAndParseBenchmark(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        std::istringstream input {feed()};
+        JsonArray::scan(
+            input,
+            [](std::string_view item, const size_t /*itemId*/)
+            {
+                auto json = nlohmann::json::parse(item);
+                benchmark::DoNotOptimize(json);
+                return true;
+            },
+            "/data"_json_pointer);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * feed().size()));
+}
+
+BENCHMARK(scanAndParseBenchmark);
@@ -53,3 +53,26 @@ static void frontBenchmark(benchmark::State& state)
 }
 
 BENCHMARK(frontBenchmark);
+
+static void recoveryBenchmark(benchmark::State& state)
+{
+    std::error_code ec;
+    std::filesystem::remove_all(TEST_DB, ec);
+
+    {
+        RocksDBQueue<std::string> queue(TEST_DB);
+        for (int64_t i = 0; i < state.range(0); i++)
+        {
+            queue.push("test");
+        }
+    }
+
+    // Reopening the queue reads its metadata, it does not depend on the number of elements.
+    for (auto _ : state)
+    {
+        RocksDBQueue<std::string> queue(TEST_DB);
+        benchmark::DoNotOptimize(queue.size());
+    }
+}
+
+BENCHMARK(recoveryBenchmark)->Arg(1000)->Arg(100000);
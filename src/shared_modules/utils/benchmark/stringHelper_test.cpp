@@ -0,0 +1,97 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include "stringHelper.h"
+
+static const std::string PACKAGE_LIST {"Microsoft Visual C++ 2015-2022 Redistributable (x64),OpenSSL,Mozilla Firefox "
+                                       "(x64 en-US),Python 3.11.4 (64-bit),Google Chrome,libssl3,LibreOffice 7.5"};
+
+static void splitBenchmark(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        for (const auto& token : Utils::split(PACKAGE_LIST, ','))
+        {
+            benchmark::DoNotOptimize(token);
+        }
+    }
+}
+
+BENCHMARK(splitBenchmark);
+
+static void splitViewBenchmark(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        for (const auto& token : Utils::splitView(PACKAGE_LIST, ','))
+        {
+            benchmark::DoNotOptimize(token);
+        }
+    }
+}
+
+BENCHMARK(splitViewBenchmark);
+
+static void toLowerCaseBenchmark(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(Utils::toLowerCase(PACKAGE_LIST));
+    }
+}
+
+BENCHMARK(toLowerCaseBenchmark);
+
+static void toLowerCaseInPlaceBenchmark(benchmark::State& state)
+{
+    std::string str;
+
+    for (auto _ : state)
+    {
+        str = PACKAGE_LIST;
+        Utils::toLowerCaseInPlace(str);
+        benchmark::DoNotOptimize(str);
+    }
+}
+
+BENCHMARK(toLowerCaseInPlaceBenchmark);
+
+static void startsWithIgnoreCaseBenchmark(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(Utils::startsWithIgnoreCase(PACKAGE_LIST, "microsoft visual c++"));
+    }
+}
+
+BENCHMARK(startsWithIgnoreCaseBenchmark);
+
+static void chainedReplaceAllBenchmark(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        std::string cpe {"cpe:/o:$(VENDOR):$(PRODUCT):$(VERSION):$(UPDATE)"};
+        Utils::replaceAll(cpe, "$(VENDOR)", "canonical");
+        Utils::replaceAll(cpe, "$(PRODUCT)", "ubuntu_linux");
+        Utils::replaceAll(cpe, "$(VERSION)", "22.04");
+        Utils::replaceAll(cpe, "$(UPDATE)", "lts");
+        benchmark::DoNotOptimize(cpe);
+    }
+}
+
+BENCHMARK(chainedReplaceAllBenchmark);
+
+static void multiReplaceAllBenchmark(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        std::string cpe {"cpe:/o:$(VENDOR):$(PRODUCT):$(VERSION):$(UPDATE)"};
+        Utils::replaceAll(cpe,
+                          {{"$(VENDOR)", "canonical"},
+                           {"$(PRODUCT)", "ubuntu_linux"},
+                           {"$(VERSION)", "22.04"},
+                           {"$(UPDATE)", "lts"}});
+        benchmark::DoNotOptimize(cpe);
+    }
+}
+
+BENCHMARK(multiReplaceAllBenchmark);
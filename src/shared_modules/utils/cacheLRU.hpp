@@ -12,9 +12,18 @@
 #ifndef _CACHELRU_HPP
 #define _CACHELRU_HPP
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
 #include <list>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
 
 /**
  * @brief A class for implementing a Least Recently Used (LRU) Cache.
@@ -161,4 +170,267 @@ private:
     }
 };
 
+/**
+ * @brief Counters of the accesses to a cache.
+ */
+struct LRUCacheStats final
+{
+    uint64_t hits {0};      ///< Lookups that found the key.
+    uint64_t misses {0};    ///< Lookups that did not find the key.
+    uint64_t evictions {0}; ///< Items removed to make space for new ones.
+};
+
+/**
+ * @brief A thread-safe cache, split in independently locked shards, that removes the least recently used items.
+ *
+ * The keys are distributed among the shards by their hash, and each shard holds a part of the capacity. A shard
+ * evicts with the CLOCK algorithm: a lookup only marks the item as referenced, under a shared lock, and the insertion
+ * of a new key into a full shard sweeps its slots, giving a second chance to the referenced items. Lookups only wait
+ * for the insertions into their own shard, and hits do not reorder any list.
+ *
+ * It has the same interface as LRUCache, so it can be used in its place when the cache is accessed from multiple
+ * threads.
+ *
+ * @tparam KeyType The type of the keys used for caching.
+ * @tparam ValueType The type of the values associated with the keys.
+ * @tparam Shards The maximum number of shards, fewer are used when the capacity is smaller.
+ * @tparam Hash The hash of the keys.
+ */
+template<typename KeyType, typename ValueType, size_t Shards = 16, typename Hash = std::hash<KeyType>>
+class ShardedLRUCache final
+{
+    static_assert(Shards > 0, "The cache needs at least one shard");
+
+public:
+    /**
+     * @brief Constructor to initialize a ShardedLRUCache with a specified capacity.
+     *
+     * @param capacity The maximum number of key-value pairs the cache can hold.
+     */
+    explicit ShardedLRUCache(const size_t capacity)
+        : m_capacity(capacity)
+    {
+        const auto shards = std::clamp<size_t>(capacity, 1, Shards);
+        m_shards.reserve(shards);
+        for (size_t i = 0; i < shards; ++i)
+        {
+            // The remainder of the capacity goes to the first shards.
+            m_shards.emplace_back(std::make_unique<Shard>(capacity / shards + (i < capacity % shards ? 1 : 0)));
+        }
+    }
+
+    /**
+     * @brief Inserts a key-value pair into the cache.
+     *
+     * If the shard of the key is full, an item not referenced since the last sweep is removed to make space for the
+     * new pair. If the key is already cached, its value is replaced.
+     *
+     * @param key The key to be inserted.
+     * @param value The value associated with the key.
+     */
+    void insertKey(const KeyType& key, const ValueType& value)
+    {
+        auto& shard = shardOf(key);
+        std::unique_lock lock(shard.mutex);
+
+        if (const auto it = shard.index.find(key); it != shard.index.end())
+        {
+            auto& slot = shard.slots[it->second];
+            slot.value = value;
+            slot.referenced.store(true, std::memory_order_relaxed);
+            return;
+        }
+
+        if (shard.slots.empty())
+        {
+            return;
+        }
+
+        size_t position;
+        if (shard.index.size() < shard.slots.size())
+        {
+            // Not full yet, the slots are used in order.
+            position = shard.index.size();
+            m_size.fetch_add(1, std::memory_order_relaxed);
+        }
+        else
+        {
+            // Sweep until an item not referenced since the last pass is found.
+            while (shard.slots[shard.hand].referenced.exchange(false, std::memory_order_relaxed))
+            {
+                shard.hand = (shard.hand + 1) % shard.slots.size();
+            }
+            position = shard.hand;
+            shard.hand = (shard.hand + 1) % shard.slots.size();
+            shard.index.erase(shard.slots[position].key);
+            shard.evictions.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        auto& slot = shard.slots[position];
+        slot.key = key;
+        slot.value = value;
+        slot.referenced.store(false, std::memory_order_relaxed);
+        shard.index.emplace(key, position);
+    }
+
+    /**
+     * @brief Retrieves the value associated with a key.
+     *
+     * If the key exists in the cache, it is marked as referenced, so the next sweep of its shard keeps it.
+     *
+     * @param key The key for which to retrieve the value.
+     * @return A copy of the value associated with the key, or an empty optional if the key is not found.
+     */
+    std::optional<ValueType> getValue(const KeyType& key)
+    {
+        auto& shard = shardOf(key);
+        std::shared_lock lock(shard.mutex);
+
+        if (const auto it = shard.index.find(key); it != shard.index.end())
+        {
+            auto& slot = shard.slots[it->second];
+            slot.referenced.store(true, std::memory_order_relaxed);
+            shard.hits.fetch_add(1, std::memory_order_relaxed);
+            return slot.value;
+        }
+
+        shard.misses.fetch_add(1, std::memory_order_relaxed);
+        return {};
+    }
+
+    /**
+     * @brief Checks if the cache is full.
+     *
+     * As each shard holds a part of the capacity, a shard may already evict items while the cache is not full.
+     *
+     * @return true if the cache holds as many items as its capacity, false otherwise.
+     */
+    bool isFull() const
+    {
+        return m_size.load(std::memory_order_relaxed) == m_capacity;
+    }
+
+    /**
+     * @brief Checks if a key exists in the cache.
+     *
+     * It neither marks the key as referenced nor counts as a lookup in the stats.
+     *
+     * @param key The key to be checked.
+     * @return true if the key exists in the cache, false otherwise.
+     */
+    bool isHit(const KeyType& key) const
+    {
+        const auto& shard = shardOf(key);
+        std::shared_lock lock(shard.mutex);
+        return shard.index.find(key) != shard.index.end();
+    }
+
+    /**
+     * @brief Iterates over the cache data and applies a function to each key-value pair.
+     *
+     * The shards are visited one after the other, each one locked while its pairs are handled, so the handler must
+     * not access the cache.
+     *
+     * @tparam Handler The type of the handler function. It should be callable with (const KeyType&, const ValueType&).
+     * @param handler The function to be applied to each key-value pair. It should return a boolean value.
+     *                If the handler returns false, the iteration stops.
+     */
+    template<typename Handler>
+    void forEach(Handler&& handler) const
+    {
+        for (const auto& shard : m_shards)
+        {
+            std::shared_lock lock(shard->mutex);
+            for (const auto& [key, position] : shard->index)
+            {
+                if (!handler(key, shard->slots[position].value))
+                {
+                    return;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Clears the cache by removing all key-value pairs. The stats are kept.
+     */
+    void clear()
+    {
+        for (auto& shard : m_shards)
+        {
+            std::unique_lock lock(shard->mutex);
+            m_size.fetch_sub(shard->index.size(), std::memory_order_relaxed);
+            shard->index.clear();
+            shard->slots = std::vector<Slot>(shard->slots.size());
+            shard->hand = 0;
+        }
+    }
+
+    /**
+     * @brief Returns the number of key-value pairs in the cache.
+     *
+     * @return size_t
+     */
+    size_t size() const
+    {
+        return m_size.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Returns the hits, misses and evictions of all the shards since the cache was created.
+     *
+     * @return LRUCacheStats
+     */
+    LRUCacheStats stats() const
+    {
+        LRUCacheStats stats;
+        for (const auto& shard : m_shards)
+        {
+            stats.hits += shard->hits.load(std::memory_order_relaxed);
+            stats.misses += shard->misses.load(std::memory_order_relaxed);
+            stats.evictions += shard->evictions.load(std::memory_order_relaxed);
+        }
+        return stats;
+    }
+
+private:
+    /**
+     * @brief A cached item, with the CLOCK reference bit.
+     */
+    struct Slot final
+    {
+        KeyType key {};                       ///< The key of the item.
+        ValueType value {};                   ///< The value of the item.
+        std::atomic<bool> referenced {false}; ///< Looked up since the last sweep, set under the shared lock.
+    };
+
+    /**
+     * @brief A part of the cache, with its own lock.
+     */
+    struct Shard final
+    {
+        explicit Shard(const size_t capacity)
+            : slots(capacity)
+        {
+        }
+
+        mutable std::shared_mutex mutex;                 ///< Exclusive to insert and clear, shared to look up.
+        std::vector<Slot> slots;                         ///< The items, as many as the capacity of the shard.
+        std::unordered_map<KeyType, size_t, Hash> index; ///< Position of each key in the slots.
+        size_t hand {0};                                 ///< Next slot checked by the sweep.
+        std::atomic<uint64_t> hits {0};                  ///< Lookups that found the key.
+        std::atomic<uint64_t> misses {0};                ///< Lookups that did not find the key.
+        std::atomic<uint64_t> evictions {0};             ///< Items removed to make space for new ones.
+    };
+
+    std::vector<std::unique_ptr<Shard>> m_shards; ///< The shards, the keys are assigned by their hash.
+    std::atomic<size_t> m_size {0};               ///< The number of items in all the shards.
+    size_t m_capacity;                            ///< The maximum capacity of the cache.
+
+    Shard& shardOf(const KeyType& key) const
+    {
+        return *m_shards[Hash {}(key) % m_shards.size()];
+    }
+};
+
 #endif // CACHELRU_HPP
@@ -0,0 +1,174 @@
+/*
+ * Wazuh shared modules utils
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _CHUNKED_INPUT_STREAM_HPP
+#define _CHUNKED_INPUT_STREAM_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <istream>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <streambuf>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Utils
+{
+    /**
+     * @brief Input stream fed by a producer running on its own thread.
+     * @details The producer pushes chunks of data (e.g. the output of a decompressor) into a bounded queue that the
+     * stream reads from, so the data can be consumed while it's being produced, without storing it entirely. If the
+     * queue is full the producer blocks until the reader catches up. An exception thrown by the producer is rethrown
+     * to the reader once all the previous data was read.
+     */
+    class ChunkedInputStream final : public std::istream
+    {
+    public:
+        /**
+         * @brief Function used by the producer to push a chunk of data.
+         *
+         */
+        using PushFunction = std::function<void(const char*, size_t)>;
+
+    private:
+        static constexpr size_t DEFAULT_MAX_CHUNKS {8};
+
+        class ChunkedBuffer final : public std::streambuf
+        {
+            std::mutex m_mutex;
+            std::condition_variable m_cv;
+            std::queue<std::vector<char>> m_chunks;
+            std::vector<char> m_current;
+            std::exception_ptr m_error;
+            const size_t m_maxChunks;
+            bool m_finished {false};
+            bool m_stopped {false};
+
+        public:
+            explicit ChunkedBuffer(const size_t maxChunks)
+                : m_maxChunks(maxChunks)
+            {
+            }
+
+            void push(const char* data, const size_t size)
+            {
+                if (size == 0)
+                {
+                    return;
+                }
+
+                std::unique_lock lock {m_mutex};
+                m_cv.wait(lock, [this]() { return m_chunks.size() < m_maxChunks || m_stopped; });
+                if (m_stopped)
+                {
+                    throw std::runtime_error("Chunked input stream stopped");
+                }
+                m_chunks.emplace(data, data + size);
+                m_cv.notify_all();
+            }
+
+            void finish(std::exception_ptr error)
+            {
+                std::scoped_lock lock {m_mutex};
+                m_finished = true;
+                m_error = std::move(error);
+                m_cv.notify_all();
+            }
+
+            void stop()
+            {
+                std::scoped_lock lock {m_mutex};
+                m_stopped = true;
+                m_cv.notify_all();
+            }
+
+        protected:
+            int_type underflow() override
+            {
+                if (gptr() < egptr())
+                {
+                    return traits_type::to_int_type(*gptr());
+                }
+
+                std::unique_lock lock {m_mutex};
+                m_cv.wait(lock, [this]() { return !m_chunks.empty() || m_finished; });
+                if (m_chunks.empty())
+                {
+                    if (m_error)
+                    {
+                        std::rethrow_exception(std::exchange(m_error, nullptr));
+                    }
+                    return traits_type::eof();
+                }
+
+                m_current = std::move(m_chunks.front());
+                m_chunks.pop();
+                m_cv.notify_all();
+                setg(m_current.data(), m_current.data(), m_current.data() + m_current.size());
+                return traits_type::to_int_type(*gptr());
+            }
+        };
+
+        ChunkedBuffer m_buffer;
+        std::thread m_producerThread;
+
+    public:
+        /**
+         * @brief Construct a new Chunked Input Stream object and start the producer.
+         *
+         * @param producer Function that produces the whole content, calling the given push function with each chunk.
+         * @param maxChunks Maximum amount of chunks waiting to be read before the producer is blocked.
+         */
+        explicit ChunkedInputStream(std::function<void(const PushFunction&)> producer,
+                                    const size_t maxChunks = DEFAULT_MAX_CHUNKS)
+            : std::istream(nullptr)
+            , m_buffer(maxChunks == 0 ? 1 : maxChunks)
+        {
+            rdbuf(&m_buffer);
+            // Make the producer errors reach the reader instead of ending the stream silently.
+            exceptions(std::ios::badbit);
+            m_producerThread = std::thread(
+                [this, producer = std::move(producer)]()
+                {
+                    std::exception_ptr error;
+                    try
+                    {
+                        producer([this](const char* data, const size_t size) { m_buffer.push(data, size); });
+                    }
+                    catch (...)
+                    {
+                        error = std::current_exception();
+                    }
+                    m_buffer.finish(std::move(error));
+                });
+        }
+
+        ~ChunkedInputStream() override
+        {
+            // The reader may leave before the end of the data, so the producer must be released.
+            m_buffer.stop();
+            if (m_producerThread.joinable())
+            {
+                m_producerThread.join();
+            }
+        }
+
+        ChunkedInputStream(const ChunkedInputStream&) = delete;
+        ChunkedInputStream& operator=(const ChunkedInputStream&) = delete;
+    };
+} // namespace Utils
+
+#endif // _CHUNKED_INPUT_STREAM_HPP
@@ -43,6 +43,16 @@ namespace Utils
             }
             {
             }
+            MsgDispatcher(std::shared_ptr<WorkStealingExecutor> executor,
+                          const size_t maxQueueSize = UNLIMITED_QUEUE_SIZE)
+                : ThreadType
+            {
+                std::bind(&DispatcherType::dispatch, this, std::placeholders::_1),
+                std::move(executor),
+                maxQueueSize
+            }
+            {
+            }
             // LCOV_EXCL_START
             ~MsgDispatcher() = default;
             // LCOV_EXCL_STOP
@@ -33,6 +33,10 @@ namespace Utils
                      const unsigned int numberOfThreads)
                 : DispatcherType{ functor, numberOfThreads, UNLIMITED_QUEUE_SIZE }
             {}
+            ReadNode(Functor functor,
+                     std::shared_ptr<WorkStealingExecutor> executor)
+                : DispatcherType{ functor, std::move(executor), UNLIMITED_QUEUE_SIZE }
+            {}
             // LCOV_EXCL_START
             ~ReadNode() = default;
             // LCOV_EXCL_STOP
@@ -66,6 +70,11 @@ namespace Utils
                 : DispatcherType{ std::bind(&RWNodeType::doTheWork, this, std::placeholders::_1), numberOfThreads, UNLIMITED_QUEUE_SIZE }
                 , m_functor{functor}
             {}
+            ReadWriteNode(Functor functor,
+                          std::shared_ptr<WorkStealingExecutor> executor)
+                : DispatcherType{ std::bind(&RWNodeType::doTheWork, this, std::placeholders::_1), std::move(executor), UNLIMITED_QUEUE_SIZE }
+                , m_functor{functor}
+            {}
             // LCOV_EXCL_START
             ~ReadWriteNode() = default;
             // LCOV_EXCL_STOP
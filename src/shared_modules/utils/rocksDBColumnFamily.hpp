@@ -12,12 +12,14 @@
 #ifndef _ROCKS_DB_CF_HPP
 #define _ROCKS_DB_CF_HPP
 
+#include <functional>
 #include <memory>
 #include <rocksdb/db.h>
 #include <rocksdb/filter_policy.h>
 #include <rocksdb/table.h>
 #include <stdexcept>
 #include <string>
+#include <utility>
 
 namespace Utils
 {
@@ -87,5 +89,74 @@ namespace Utils
             }
         }
     };
+    template<typename T>
+    class TRocksDBWrapper;
+
+    /**
+     * @brief Handle of a column family of a RocksDBWrapper, obtained once to access the column without looking it up
+     * by its name.
+     *
+     * @note The handle is valid while the wrapper exists. It follows the column when it is dropped and created again,
+     * and it can be obtained before the column is created. Accessing the column while it doesn't exist throws.
+     */
+    class RocksDBColumn final
+    {
+    private:
+        std::string m_name;                                   ///< Column family name.
+        std::shared_ptr<rocksdb::ColumnFamilyHandle*> m_slot; ///< Current handle of the column, set by the wrapper.
+
+        /**
+         * @brief Constructor.
+         *
+         * @param name Column family name.
+         * @param slot Current handle of the column, null while the column doesn't exist.
+         */
+        RocksDBColumn(std::string name, std::shared_ptr<rocksdb::ColumnFamilyHandle*> slot)
+            : m_name {std::move(name)}
+            , m_slot {std::move(slot)}
+        {
+        }
+
+        /**
+         * @brief Get the column family handle.
+         *
+         * @return rocksdb::ColumnFamilyHandle* Column family handle.
+         */
+        rocksdb::ColumnFamilyHandle* handle() const
+        {
+            if (!m_slot || *m_slot == nullptr)
+            {
+                throw std::runtime_error {"Couldn't find column family: '" + m_name + "'"};
+            }
+            return *m_slot;
+        }
+
+        template<typename T>
+        friend class TRocksDBWrapper;
+
+    public:
+        RocksDBColumn() = default;
+
+        /**
+         * @brief Get the column family name.
+         *
+         * @return const std::string& Column family name.
+         */
+        const std::string& name() const
+        {
+            return m_name;
+        }
+
+        /**
+         * @brief Checks whether the column exists.
+         *
+         * @return true If the column exists.
+         * @return false If the column doesn't exist or the handle is empty.
+         */
+        bool exists() const
+        {
+            return m_slot && *m_slot != nullptr;
+        }
+    };
 } // namespace Utils
 #endif // _ROCKS_DB_CF_HPP
@@ -16,6 +16,7 @@
 #include <algorithm>
 #include <iostream>
 #include <memory>
+#include <string_view>
 #include <utility>
 
 /**
@@ -79,6 +80,18 @@ public:
         return *this;
     }
 
+    /**
+     * @brief Change the prefix of the iteration, reusing the underlying iterator. The prefix must outlive the
+     * iteration.
+     * @param newPrefix New prefix.
+     * @return RocksDBIterator& Iterator to the database, ready to be iterated from the new prefix.
+     */
+    RocksDBIterator& prefix(std::string_view newPrefix)
+    {
+        m_prefix = newPrefix;
+        return *this;
+    }
+
     /**
      * @brief Get an iterator to the end of the database.
      * @return const RocksDBIterator Iterator to the end of the database.
@@ -24,6 +24,7 @@ namespace Utils
     constexpr auto ROCKSDB_MAX_OPEN_FILES = 256;
     constexpr auto ROCKSDB_NUM_LEVELS = 4;
     constexpr auto ROCKSDB_BLOCK_CACHE_SIZE = 16 * 1024 * 1024;
+    constexpr auto ROCKSDB_SCAN_READAHEAD_SIZE = 2 * 1024 * 1024;
 
     class RocksDBOptions final
     {
@@ -103,6 +104,36 @@ namespace Utils
             options.table_factory.reset(NewBlockBasedTableFactory(buildTableOptions(readCache)));
             return options;
         }
+
+        /**
+         * @brief Builds the read options for the lookups of a database that is mostly read, like the feeds.
+         * @return rocksdb::ReadOptions Read options.
+         */
+        static rocksdb::ReadOptions buildReadMostlyOptions()
+        {
+            rocksdb::ReadOptions readOptions;
+            // The blocks read are kept in the block cache, the same keys are looked up again.
+            readOptions.fill_cache = true;
+            // The block checksums are not verified on each read, the compactions still verify them.
+            readOptions.verify_checksums = false;
+            return readOptions;
+        }
+
+        /**
+         * @brief Builds the read options for the iteration over a whole column of a database that is mostly read.
+         * @return rocksdb::ReadOptions Read options.
+         */
+        static rocksdb::ReadOptions buildScanOptions()
+        {
+            rocksdb::ReadOptions readOptions;
+            // The blocks read are not kept, so they don't evict the blocks of the lookups from the block cache.
+            readOptions.fill_cache = false;
+            // The block checksums are not verified on each read, the compactions still verify them.
+            readOptions.verify_checksums = false;
+            // The blocks are read sequentially, read them ahead.
+            readOptions.readahead_size = ROCKSDB_SCAN_READAHEAD_SIZE;
+            return readOptions;
+        }
     };
 } // namespace Utils
 
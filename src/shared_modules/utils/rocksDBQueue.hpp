@@ -15,9 +15,13 @@
 #include "rocksdb/db.h"
 #include "rocksdb/filter_policy.h"
 #include "rocksdb/table.h"
+#include "rocksdb/write_batch.h"
+#include <algorithm>
 #include <filesystem>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 // RocksDB integration as queue
 template<typename T, typename U = T>
@@ -59,68 +63,99 @@ public:
 
         m_db.reset(db);
 
-        // RocksDB counter initialization.
-        m_size = 0;
-
-        auto it = std::unique_ptr<rocksdb::Iterator>(m_db->NewIterator(rocksdb::ReadOptions()));
-        it->SeekToFirst();
-        if (it->Valid())
-        {
-            auto key = std::stoull(it->key().ToString());
-            m_first = key;
-            m_last = key;
-        }
-        else
-        {
-            m_first = 1;
-            m_last = 0;
-        }
-
-        while (it->Valid())
+        // RocksDB counter initialization, from the metadata if it is consistent with the data.
+        if (!loadMetadata())
         {
-            auto key = std::stoull(it->key().ToString());
-            if (key > m_last)
-            {
-                m_last = key;
-            }
-
-            if (key < m_first)
-            {
-                m_first = key;
-            }
-            ++m_size;
-
-            it->Next();
+            scan();
+            writeMetadata();
         }
     }
 
     void push(const T& data)
     {
-        // RocksDB enqueue element.
-        ++m_last;
-        if (const auto status = m_db->Put(rocksdb::WriteOptions(), std::to_string(m_last), data); !status.ok())
+        // RocksDB enqueue element, the metadata is updated in the same batch.
+        rocksdb::WriteBatch batch;
+        batch.Put(std::to_string(m_last + 1), data);
+        batch.Put(METADATA_KEY, encodeMetadata(m_first, m_last + 1, m_size + 1));
+        if (const auto status = m_db->Write(rocksdb::WriteOptions(), &batch); !status.ok())
         {
             throw std::runtime_error("Failed to enqueue element");
         }
+        ++m_last;
         ++m_size;
     }
 
     void pop()
     {
-        // RocksDB dequeue element.
-        if (!m_db->Delete(rocksdb::WriteOptions(), std::to_string(m_first)).ok())
+        // RocksDB dequeue element, the metadata is updated in the same batch.
+        const auto empty = m_size == 1;
+        const auto first = empty ? 1 : m_first + 1;
+        const auto last = empty ? 0 : m_last;
+
+        rocksdb::WriteBatch batch;
+        batch.Delete(std::to_string(m_first));
+        batch.Put(METADATA_KEY, encodeMetadata(first, last, m_size - 1));
+        if (!m_db->Write(rocksdb::WriteOptions(), &batch).ok())
         {
             throw std::runtime_error("Failed to dequeue element, can't delete it");
         }
 
-        ++m_first;
+        m_first = first;
+        m_last = last;
         --m_size;
+    }
+
+    void pushBulk(const std::vector<T>& data)
+    {
+        if (data.empty())
+        {
+            return;
+        }
+
+        // RocksDB enqueue elements, all of them and the metadata in a single batch.
+        rocksdb::WriteBatch batch;
+        auto last = m_last;
+        for (const auto& element : data)
+        {
+            batch.Put(std::to_string(++last), element);
+        }
+        batch.Put(METADATA_KEY, encodeMetadata(m_first, last, m_size + data.size()));
+        if (const auto status = m_db->Write(rocksdb::WriteOptions(), &batch); !status.ok())
+        {
+            throw std::runtime_error("Failed to enqueue elements");
+        }
+        m_last = last;
+        m_size += data.size();
+    }
+
+    void popBulk(const uint64_t elementsQuantity)
+    {
+        const auto quantity = std::min(elementsQuantity, m_size);
+        if (quantity == 0)
+        {
+            return;
+        }
+
+        // RocksDB dequeue elements, all of them and the metadata in a single batch.
+        // The keys are not zero padded, so a numeric range is not a key range and DeleteRange cannot be used.
+        const auto empty = m_size == quantity;
+        const auto first = empty ? 1 : m_first + quantity;
+        const auto last = empty ? 0 : m_last;
 
-        if (m_size == 0)
+        rocksdb::WriteBatch batch;
+        for (auto key = m_first; key < m_first + quantity; ++key)
+        {
+            batch.Delete(std::to_string(key));
+        }
+        batch.Put(METADATA_KEY, encodeMetadata(first, last, m_size - quantity));
+        if (!m_db->Write(rocksdb::WriteOptions(), &batch).ok())
         {
-            m_first = 1;
-            m_last = 0;
+            throw std::runtime_error("Failed to dequeue elements, can't delete them");
         }
+
+        m_first = first;
+        m_last = last;
+        m_size -= quantity;
     }
 
     uint64_t size() const
@@ -144,6 +179,46 @@ public:
         return value;
     }
 
+    /**
+     * @brief Gets the first elements with a single batched lookup, without removing them.
+     *
+     * The keys are not zero padded, so the elements are not contiguous for an iterator and they are looked up by key.
+     * The buffers of the lookup and the elements in values are reused between calls, a pinned element stays valid
+     * until the next call.
+     *
+     * @param values Elements read, at most elementsQuantity.
+     * @param elementsQuantity Maximum number of elements to get.
+     */
+    void frontBulk(std::vector<U>& values, const uint64_t elementsQuantity)
+    {
+        const auto quantity = std::min(elementsQuantity, m_size);
+        m_keys.resize(quantity);
+        m_keySlices.resize(quantity);
+        m_statuses.resize(quantity);
+        for (uint64_t i = 0; i < quantity; ++i)
+        {
+            m_keys[i] = std::to_string(m_first + i);
+            m_keySlices[i] = m_keys[i];
+        }
+
+        if constexpr (std::is_same_v<U, rocksdb::PinnableSlice>)
+        {
+            values.resize(quantity);
+            multiGet(values);
+        }
+        else
+        {
+            m_pinned.resize(quantity);
+            multiGet(m_pinned);
+            values.resize(quantity);
+            for (uint64_t i = 0; i < quantity; ++i)
+            {
+                values[i].assign(m_pinned[i].data(), m_pinned[i].size());
+                m_pinned[i].Reset();
+            }
+        }
+    }
+
     U at(const uint64_t index) const
     {
         if (index >= m_size)
@@ -162,12 +237,136 @@ public:
     }
 
 private:
+    // Key of the head, tail and size of the queue. It is not a number, so it never collides with an element.
+    static constexpr auto METADATA_KEY = "queue_metadata";
+
+    static std::string encodeMetadata(const uint64_t first, const uint64_t last, const uint64_t size)
+    {
+        return std::to_string(first) + ":" + std::to_string(last) + ":" + std::to_string(size);
+    }
+
+    void multiGet(std::vector<rocksdb::PinnableSlice>& values)
+    {
+        for (auto& value : values)
+        {
+            value.Reset();
+        }
+
+        m_db->MultiGet(rocksdb::ReadOptions(),
+                       m_db->DefaultColumnFamily(),
+                       m_keySlices.size(),
+                       m_keySlices.data(),
+                       values.data(),
+                       m_statuses.data());
+
+        if (std::any_of(m_statuses.begin(), m_statuses.end(), [](const auto& status) { return !status.ok(); }))
+        {
+            throw std::runtime_error("Failed to get front elements");
+        }
+    }
+
+    bool exists(const uint64_t key) const
+    {
+        std::string value;
+        return m_db->Get(rocksdb::ReadOptions(), std::to_string(key), &value).ok();
+    }
+
+    bool loadMetadata()
+    {
+        std::string value;
+        if (!m_db->Get(rocksdb::ReadOptions(), METADATA_KEY, &value).ok())
+        {
+            return false;
+        }
+
+        uint64_t first {};
+        uint64_t last {};
+        uint64_t size {};
+        try
+        {
+            const auto firstEnd = value.find(':');
+            const auto lastEnd = value.find(':', firstEnd + 1);
+            if (firstEnd == std::string::npos || lastEnd == std::string::npos)
+            {
+                return false;
+            }
+            first = std::stoull(value.substr(0, firstEnd));
+            last = std::stoull(value.substr(firstEnd + 1, lastEnd - firstEnd - 1));
+            size = std::stoull(value.substr(lastEnd + 1));
+        }
+        catch (const std::exception&)
+        {
+            return false;
+        }
+
+        // The elements are contiguous, check the bounds instead of reading them all.
+        if (size == 0)
+        {
+            if (first != 1 || last != 0 || exists(1))
+            {
+                return false;
+            }
+        }
+        else if (last < first || last - first + 1 != size || !exists(first) || !exists(last) || exists(last + 1)
+                 || (first > 1 && exists(first - 1)))
+        {
+            return false;
+        }
+
+        m_first = first;
+        m_last = last;
+        m_size = size;
+        return true;
+    }
+
+    void scan()
+    {
+        m_size = 0;
+        m_first = 1;
+        m_last = 0;
+
+        auto it = std::unique_ptr<rocksdb::Iterator>(m_db->NewIterator(rocksdb::ReadOptions()));
+        for (it->SeekToFirst(); it->Valid(); it->Next())
+        {
+            if (it->key() == METADATA_KEY)
+            {
+                continue;
+            }
+
+            const auto key = std::stoull(it->key().ToString());
+            if (m_size == 0)
+            {
+                m_first = key;
+                m_last = key;
+            }
+            else
+            {
+                m_first = std::min<uint64_t>(m_first, key);
+                m_last = std::max<uint64_t>(m_last, key);
+            }
+            ++m_size;
+        }
+    }
+
+    void writeMetadata()
+    {
+        if (!m_db->Put(rocksdb::WriteOptions(), METADATA_KEY, encodeMetadata(m_first, m_last, m_size)).ok())
+        {
+            throw std::runtime_error("Failed to write the queue metadata");
+        }
+    }
+
     std::unique_ptr<rocksdb::DB> m_db;
     std::shared_ptr<rocksdb::Cache> m_readCache;
     std::shared_ptr<rocksdb::WriteBufferManager> m_writeManager;
     uint64_t m_size;
     uint64_t m_first;
     uint64_t m_last;
+    // Buffers of frontBulk
+    std::vector<std::string> m_keys;
+    std::vector<rocksdb::Slice> m_keySlices;
+    std::vector<rocksdb::Status> m_statuses;
+    std::vector<rocksdb::PinnableSlice> m_pinned;
 };
 
 #endif // _ROCKSDB_QUEUE_HPP
@@ -16,10 +16,13 @@
 #include "rocksdb/db.h"
 #include "rocksdb/filter_policy.h"
 #include "rocksdb/table.h"
+#include "rocksdb/write_batch.h"
 #include "stringHelper.h"
+#include <algorithm>
 #include <filesystem>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 // RocksDB integration as queue
 template<typename T, typename U = T>
@@ -151,6 +154,67 @@ public:
         }
     }
 
+    void pushBulk(std::string_view id, const std::vector<T>& data)
+    {
+        if (data.empty())
+        {
+            return;
+        }
+
+        auto it = m_queueMetadata.find(id.data());
+        const auto tail = it != m_queueMetadata.end() ? it->second.tail : 0;
+
+        // RocksDB enqueue elements, all of them in a single batch.
+        rocksdb::WriteBatch batch;
+        for (uint64_t i = 1; i <= data.size(); ++i)
+        {
+            batch.Put(std::string(id) + "_" + std::to_string(tail + i), data[i - 1]);
+        }
+        if (const auto status = m_db->Write(rocksdb::WriteOptions(), &batch); !status.ok())
+        {
+            throw std::runtime_error("Failed to enqueue elements");
+        }
+
+        if (it == m_queueMetadata.end())
+        {
+            it = m_queueMetadata.emplace(id, QueueMetadata {1, 0, 0, std::chrono::system_clock::now()}).first;
+        }
+        it->second.tail += data.size();
+        it->second.size += data.size();
+    }
+
+    void popBulk(std::string_view id, const uint64_t elementsQuantity)
+    {
+        if (const auto it {m_queueMetadata.find(id.data())}; it != m_queueMetadata.end())
+        {
+            const auto quantity = std::min(elementsQuantity, it->second.size);
+
+            // RocksDB dequeue elements, all of them in a single batch.
+            // The sequence numbers are not zero padded, so they are not a key range and DeleteRange cannot be used.
+            rocksdb::WriteBatch batch;
+            for (auto i = it->second.head; i < it->second.head + quantity; ++i)
+            {
+                batch.Delete(std::string(id) + "_" + std::to_string(i));
+            }
+            if (!m_db->Write(rocksdb::WriteOptions(), &batch).ok())
+            {
+                throw std::runtime_error("Failed to dequeue elements, can't delete them");
+            }
+
+            it->second.head += quantity;
+            it->second.size -= quantity;
+
+            if (it->second.size == 0)
+            {
+                m_queueMetadata.erase(it);
+            }
+        }
+        else
+        {
+            throw std::runtime_error("Couldn't find ID: " + std::string {id});
+        }
+    }
+
     uint64_t size(std::string_view id) const
     {
         if (const auto it = m_queueMetadata.find(id.data()); it != m_queueMetadata.end())
@@ -227,11 +291,13 @@ public:
 
     void clear(std::string_view id)
     {
-        auto deleteElement = [this](const std::string& key)
+        // All the elements are deleted in a single batch.
+        rocksdb::WriteBatch batch;
+        auto deleteElements = [&batch](const std::string& queueId, const QueueMetadata& metadata)
         {
-            if (!m_db->Delete(rocksdb::WriteOptions(), key).ok())
+            for (auto i = metadata.head; i <= metadata.tail; ++i)
             {
-                throw std::runtime_error("Failed to clear element, can't delete it");
+                batch.Delete(queueId + "_" + std::to_string(i));
             }
         };
 
@@ -240,26 +306,30 @@ public:
             // Clear all elements from the queue.
             for (const auto& metadata : m_queueMetadata)
             {
-                for (auto i = metadata.second.head; i <= metadata.second.tail; ++i)
-                {
-                    deleteElement(std::string(metadata.first) + "_" + std::to_string(i));
-                }
+                deleteElements(metadata.first, metadata.second);
             }
+        }
+        else if (const auto it {m_queueMetadata.find(id.data())}; it != m_queueMetadata.end())
+        {
+            deleteElements(it->first, it->second);
+        }
+        else
+        {
+            return;
+        }
+
+        if (!m_db->Write(rocksdb::WriteOptions(), &batch).ok())
+        {
+            throw std::runtime_error("Failed to clear element, can't delete it");
+        }
+
+        if (id.empty())
+        {
             m_queueMetadata.clear();
         }
         else
         {
-            if (const auto it {m_queueMetadata.find(id.data())}; it != m_queueMetadata.end())
-            {
-                // Clear all elements from the queue.
-                for (auto i = it->second.head; i <= it->second.tail; ++i)
-                {
-                    deleteElement(std::string(id) + "_" + std::to_string(i));
-                    ++it->second.head;
-                    --it->second.size;
-                }
-                m_queueMetadata.erase(it);
-            }
+            m_queueMetadata.erase(std::string(id));
         }
     }
 
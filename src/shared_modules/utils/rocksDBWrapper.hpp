@@ -17,20 +17,27 @@
 #include "rocksDBOptions.hpp"
 #include <algorithm>
 #include <filesystem>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <rocksdb/db.h>
 #include <rocksdb/filter_policy.h>
 #include <rocksdb/table.h>
+#include <rocksdb/utilities/checkpoint.h>
 #include <rocksdb/utilities/transaction.h>
 #include <rocksdb/utilities/transaction_db.h>
+#include <rocksdb/write_batch.h>
+#include <shared_mutex>
 #include <stdexcept>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 namespace Utils
 {
     class RocksDBTransaction;
+    class RocksDBWriteBatch;
     class IRocksDBWrapper
     {
     public:
@@ -70,6 +77,7 @@ namespace Utils
             : m_enableWal {enableWal}
             , m_path {std::move(dbPath)}
         {
+            m_writeOptions.disableWAL = !m_enableWal;
             m_readCache = rocksdb::NewLRUCache(16 * 1024 * 1024);
             m_writeManager = std::make_shared<rocksdb::WriteBufferManager>(128 * 1024 * 1024);
 
@@ -162,15 +170,25 @@ namespace Utils
                 throw std::invalid_argument("Key is empty");
             }
 
-            rocksdb::WriteOptions writeOptions;
-            writeOptions.disableWAL = !m_enableWal;
+            putInto(key, value, getColumnFamilyBasedOnName(columnName).handle());
+        }
 
-            if (const auto status {
-                    m_db->Put(writeOptions, getColumnFamilyBasedOnName(columnName).handle(), key, value)};
-                !status.ok())
+        /**
+         * @brief Put a key-value pair in the database.
+         * @param key Key to put.
+         * @param value Value to put.
+         * @param column Column where the put will be performed.
+         *
+         * @note If the key already exists, the value will be overwritten.
+         */
+        void put(const std::string& key, const rocksdb::Slice& value, const RocksDBColumn& column)
+        {
+            if (key.empty())
             {
-                throw std::runtime_error("Error putting data: " + status.ToString());
+                throw std::invalid_argument("Key is empty");
             }
+
+            putInto(key, value, column.handle());
         }
 
         /**
@@ -203,17 +221,31 @@ namespace Utils
                 throw std::invalid_argument("Key is empty");
             }
 
-            if (const auto status {
-                    m_db->Get(rocksdb::ReadOptions(), getColumnFamilyBasedOnName(columnName).handle(), key, &value)};
-                status.IsNotFound())
-            {
-                return false;
-            }
-            else if (!status.ok())
+            return getFrom(key, value, getColumnFamilyBasedOnName(columnName).handle(), DEFAULT_READ_OPTIONS);
+        }
+
+        /**
+         * @brief Get a value from the database.
+         *
+         * @param key Key to get.
+         * @param value Value to get (std::string).
+         * @param column Column from where to get.
+         * @param readOptions Read options, see RocksDBOptions::buildReadMostlyOptions.
+         *
+         * @return bool True if the operation was successful.
+         * @return bool False if the key was not found.
+         */
+        bool get(const std::string& key,
+                 std::string& value,
+                 const RocksDBColumn& column,
+                 const rocksdb::ReadOptions& readOptions = DEFAULT_READ_OPTIONS)
+        {
+            if (key.empty())
             {
-                throw std::runtime_error("Error getting data: " + status.ToString());
+                throw std::invalid_argument("Key is empty");
             }
-            return true;
+
+            return getFrom(key, value, column.handle(), readOptions);
         }
 
         /**
@@ -233,17 +265,31 @@ namespace Utils
                 throw std::invalid_argument("Key is empty");
             }
 
-            if (const auto status {
-                    m_db->Get(rocksdb::ReadOptions(), getColumnFamilyBasedOnName(columnName).handle(), key, &value)};
-                status.IsNotFound())
-            {
-                return false;
-            }
-            else if (!status.ok())
+            return getFrom(key, value, getColumnFamilyBasedOnName(columnName).handle(), DEFAULT_READ_OPTIONS);
+        }
+
+        /**
+         * @brief Get a value from the database.
+         *
+         * @param key Key to get.
+         * @param value Value to get (rocksdb::PinnableSlice).
+         * @param column Column from where to get.
+         * @param readOptions Read options, see RocksDBOptions::buildReadMostlyOptions.
+         *
+         * @return bool True if the operation was successful.
+         * @return bool False if the key was not found.
+         */
+        bool get(const std::string& key,
+                 rocksdb::PinnableSlice& value,
+                 const RocksDBColumn& column,
+                 const rocksdb::ReadOptions& readOptions = DEFAULT_READ_OPTIONS)
+        {
+            if (key.empty())
             {
-                throw std::runtime_error("Error getting data: " + status.ToString());
+                throw std::invalid_argument("Key is empty");
             }
-            return true;
+
+            return getFrom(key, value, column.handle(), readOptions);
         }
 
         /**
@@ -261,6 +307,44 @@ namespace Utils
             return get(key, value, "");
         }
 
+        /**
+         * @brief Get the values of multiple keys from the database in a single call.
+         *
+         * @note The keys are looked up together, so the blocks they need are read in parallel.
+         *
+         * @param keys Keys to get.
+         * @param values Values of the keys, in the same order. The value of a key not found is empty.
+         * @param columnName Column name from where to get. If empty, the default column will be used.
+         *
+         * @return std::vector<bool> Whether each key was found.
+         */
+        std::vector<bool> multiGet(const std::vector<std::string>& keys,
+                                   std::vector<rocksdb::PinnableSlice>& values,
+                                   const std::string& columnName = "")
+        {
+            return multiGetFrom(keys, values, getColumnFamilyBasedOnName(columnName).handle(), DEFAULT_READ_OPTIONS);
+        }
+
+        /**
+         * @brief Get the values of multiple keys from the database in a single call.
+         *
+         * @note The keys are looked up together, so the blocks they need are read in parallel.
+         *
+         * @param keys Keys to get.
+         * @param values Values of the keys, in the same order. The value of a key not found is empty.
+         * @param column Column from where to get.
+         * @param readOptions Read options, see RocksDBOptions::buildReadMostlyOptions.
+         *
+         * @return std::vector<bool> Whether each key was found.
+         */
+        std::vector<bool> multiGet(const std::vector<std::string>& keys,
+                                   std::vector<rocksdb::PinnableSlice>& values,
+                                   const RocksDBColumn& column,
+                                   const rocksdb::ReadOptions& readOptions = DEFAULT_READ_OPTIONS)
+        {
+            return multiGetFrom(keys, values, column.handle(), readOptions);
+        }
+
         /**
          * @brief Delete a key-value pair from the database.
          *
@@ -274,14 +358,23 @@ namespace Utils
                 throw std::invalid_argument("Key is empty");
             }
 
-            rocksdb::WriteOptions writeOptions;
-            writeOptions.disableWAL = !m_enableWal;
+            deleteFrom(key, getColumnFamilyBasedOnName(columnName).handle());
+        }
 
-            const auto status {m_db->Delete(writeOptions, getColumnFamilyBasedOnName(columnName).handle(), key)};
-            if (!status.ok())
+        /**
+         * @brief Delete a key-value pair from the database.
+         *
+         * @param key Key to delete.
+         * @param column Column from where to delete.
+         */
+        void delete_(const std::string& key, const RocksDBColumn& column) // NOLINT
+        {
+            if (key.empty())
             {
-                throw std::runtime_error("Error deleting data: " + status.ToString());
+                throw std::invalid_argument("Key is empty");
             }
+
+            deleteFrom(key, column.handle());
         }
 
         /**
@@ -325,10 +418,24 @@ namespace Utils
         RocksDBIterator seek(std::string_view key, const std::string& columnName = "") override // NOLINT
         {
             return {std::shared_ptr<rocksdb::Iterator>(
-                        m_db->NewIterator(rocksdb::ReadOptions(), getColumnFamilyBasedOnName(columnName).handle())),
+                        m_db->NewIterator(DEFAULT_READ_OPTIONS, getColumnFamilyBasedOnName(columnName).handle())),
                     key};
         }
 
+        /**
+         * @brief Seek to specific key.
+         * @param key Key to seek.
+         * @param column Column to iterate.
+         * @param readOptions Read options, see RocksDBOptions::buildReadMostlyOptions.
+         * @return RocksDBIterator Iterator to the database.
+         */
+        RocksDBIterator seek(std::string_view key, // NOLINT
+                             const RocksDBColumn& column,
+                             const rocksdb::ReadOptions& readOptions = DEFAULT_READ_OPTIONS)
+        {
+            return {std::shared_ptr<rocksdb::Iterator>(m_db->NewIterator(readOptions, column.handle())), key};
+        }
+
         /**
          * @brief Get an iterator to the database.
          * @return RocksDBIterator Iterator to the database.
@@ -337,12 +444,40 @@ namespace Utils
         {
             RocksDBIterator rocksDBIterator(
                 std::shared_ptr<rocksdb::Iterator>(
-                    m_db->NewIterator(rocksdb::ReadOptions(), getColumnFamilyBasedOnName(columnName).handle())),
+                    m_db->NewIterator(DEFAULT_READ_OPTIONS, getColumnFamilyBasedOnName(columnName).handle())),
                 "");
             rocksDBIterator.begin();
             return rocksDBIterator;
         }
 
+        /**
+         * @brief Get an iterator to the database.
+         * @param column Column to iterate.
+         * @param readOptions Read options, see RocksDBOptions::buildScanOptions.
+         * @return RocksDBIterator Iterator to the database.
+         */
+        RocksDBIterator begin(const RocksDBColumn& column,
+                              const rocksdb::ReadOptions& readOptions = DEFAULT_READ_OPTIONS)
+        {
+            RocksDBIterator rocksDBIterator(
+                std::shared_ptr<rocksdb::Iterator>(m_db->NewIterator(readOptions, column.handle())), "");
+            rocksDBIterator.begin();
+            return rocksDBIterator;
+        }
+
+        /**
+         * @brief Takes a snapshot of the database, to read a consistent view of it while it's written concurrently.
+         * The snapshot is used by setting it in the read options of the gets and iterators.
+         *
+         * @return std::shared_ptr<const rocksdb::Snapshot> Snapshot, released when the last copy is destroyed. It keeps
+         * the RocksDB instance open until then.
+         */
+        std::shared_ptr<const rocksdb::Snapshot> snapshot()
+        {
+            return {m_db->GetSnapshot(),
+                    [db = m_db](const rocksdb::Snapshot* snapshot) { db->ReleaseSnapshot(snapshot); }};
+        }
+
         /**
          * @brief Get an iterator to the end of the database.
          * @return const RocksDBIterator Iterator to the end of the database.
@@ -398,6 +533,65 @@ namespace Utils
             m_db->CompactRange(compactOptions, nullptr, nullptr);
         }
 
+        /**
+         * @brief Prepares the database to load a large amount of data, like a whole feed into an empty database.
+         *
+         * @details The automatic compactions and the write stalls they avoid are disabled, also for the columns
+         * created later, so the data is flushed to sorted files without being rewritten while it's loaded.
+         * endBulkLoad() must be called once the data is loaded.
+         */
+        void beginBulkLoad()
+        {
+            m_bulkLoad = true;
+            for (const auto& columnFamily : m_columnsInstances)
+            {
+                setBulkLoadOptions(columnFamily.handle(), true);
+            }
+        }
+
+        /**
+         * @brief Ends the load started by beginBulkLoad(): The data is flushed and compacted into the last level, so
+         * the database is read without merging overlapping files, and the automatic compactions are enabled again.
+         */
+        void endBulkLoad()
+        {
+            flush();
+
+            rocksdb::CompactRangeOptions compactOptions;
+            compactOptions.bottommost_level_compaction = rocksdb::BottommostLevelCompaction::kForceOptimized;
+            for (const auto& columnFamily : m_columnsInstances)
+            {
+                if (const auto status {m_db->CompactRange(compactOptions, columnFamily.handle(), nullptr, nullptr)};
+                    !status.ok())
+                {
+                    throw std::runtime_error {"Failed to compact column: " + std::string {status.getState()}};
+                }
+                setBulkLoadOptions(columnFamily.handle(), false);
+            }
+            m_bulkLoad = false;
+        }
+
+        /**
+         * @brief Creates an openable copy of the database in a new directory. The sorted files are hard linked when
+         * the directory is in the same filesystem, so the copy is cheap even for a large database.
+         *
+         * @param path Directory of the copy, it must not exist.
+         */
+        void createCheckpoint(const std::filesystem::path& path)
+        {
+            rocksdb::Checkpoint* checkpoint {nullptr};
+            if (const auto status {rocksdb::Checkpoint::Create(m_db.get(), &checkpoint)}; !status.ok())
+            {
+                throw std::runtime_error {"Failed to create checkpoint: " + std::string {status.getState()}};
+            }
+
+            const std::unique_ptr<rocksdb::Checkpoint> checkpointGuard {checkpoint};
+            if (const auto status {checkpoint->CreateCheckpoint(path.string())}; !status.ok())
+            {
+                throw std::runtime_error {"Failed to create checkpoint: " + std::string {status.getState()}};
+            }
+        }
+
         /**
          * @brief Initialize transaction.
          * @return RocksDBTransaction Transaction object.
@@ -412,6 +606,32 @@ namespace Utils
             throw std::runtime_error("Not implemented");
         }
 
+        /**
+         * @brief Get the handle of a column, to access it without looking it up by its name.
+         *
+         * @note The column doesn't need to exist yet, see RocksDBColumn.
+         *
+         * @param columnName Name of the column. If empty, the default column is used.
+         * @return RocksDBColumn Column handle.
+         */
+        RocksDBColumn column(const std::string& columnName = "")
+        {
+            const auto& name = columnName.empty() ? rocksdb::kDefaultColumnFamilyName : columnName;
+
+            auto& slot = m_columnSlots[name];
+            if (!slot)
+            {
+                const auto it {std::find_if(m_columnsInstances.begin(),
+                                            m_columnsInstances.end(),
+                                            [&name](const ColumnFamilyRAII& handle)
+                                            { return name == handle->GetName(); })};
+                slot = std::make_shared<rocksdb::ColumnFamilyHandle*>(it != m_columnsInstances.end() ? it->handle()
+                                                                                                     : nullptr);
+            }
+
+            return {name, slot};
+        }
+
         /**
          * @brief Creates a new column family in the database.
          *
@@ -435,6 +655,12 @@ namespace Utils
                 throw std::runtime_error {"Couldn't create column family: " + std::string {status.getState()}};
             }
             m_columnsInstances.emplace_back(m_db, pColumnFamily);
+            updateColumnSlot(columnName, pColumnFamily);
+
+            if (m_bulkLoad)
+            {
+                setBulkLoadOptions(pColumnFamily, true);
+            }
         }
 
         /**
@@ -488,6 +714,7 @@ namespace Utils
                 {
                     it->drop();
                     columnsNames.push_back((*it)->GetName());
+                    updateColumnSlot(columnsNames.back(), nullptr);
                     it = m_columnsInstances.erase(it);
                 }
                 else
@@ -538,6 +765,7 @@ namespace Utils
                 if (it != m_columnsInstances.end())
                 {
                     it->drop();
+                    updateColumnSlot(columnName, nullptr);
                     m_columnsInstances.erase(it);
 
                     createColumn(columnName);
@@ -657,6 +885,123 @@ namespace Utils
         const std::string m_path;                                    ///< Location of the DB.
         std::shared_ptr<rocksdb::Cache> m_readCache;                 ///< Cache for read operations.
         std::shared_ptr<rocksdb::WriteBufferManager> m_writeManager; ///< Write buffer manager.
+        rocksdb::WriteOptions m_writeOptions;                        ///< Options of the puts and deletes.
+        std::map<std::string, std::shared_ptr<rocksdb::ColumnFamilyHandle*>>
+            m_columnSlots; ///< Current handle of each column a RocksDBColumn was obtained for.
+
+        static inline const rocksdb::ReadOptions DEFAULT_READ_OPTIONS {}; ///< Options of the reads by column name.
+        bool m_bulkLoad {false}; ///< Whether a bulk load is in progress.
+
+        /**
+         * @brief Sets the options of a column for a bulk load, or restores the default ones.
+         *
+         * @param handle Column family handle.
+         * @param bulkLoad Whether the bulk load options are set or the default ones restored.
+         */
+        void setBulkLoadOptions(rocksdb::ColumnFamilyHandle* handle, const bool bulkLoad)
+        {
+            static const std::unordered_map<std::string, std::string> BULK_LOAD_OPTIONS {
+                {"disable_auto_compactions", "true"},
+                {"level0_slowdown_writes_trigger", "1073741824"},
+                {"level0_stop_writes_trigger", "1073741824"},
+                {"soft_pending_compaction_bytes_limit", "0"},
+                {"hard_pending_compaction_bytes_limit", "0"}};
+            static const std::unordered_map<std::string, std::string> DEFAULT_OPTIONS {
+                {"disable_auto_compactions", "false"},
+                {"level0_slowdown_writes_trigger", "20"},
+                {"level0_stop_writes_trigger", "36"},
+                {"soft_pending_compaction_bytes_limit", "68719476736"},
+                {"hard_pending_compaction_bytes_limit", "274877906944"}};
+
+            if (const auto status {m_db->SetOptions(handle, bulkLoad ? BULK_LOAD_OPTIONS : DEFAULT_OPTIONS)};
+                !status.ok())
+            {
+                throw std::runtime_error {"Failed to set the bulk load options: " + std::string {status.getState()}};
+            }
+        }
+
+        void putInto(const std::string& key, const rocksdb::Slice& value, rocksdb::ColumnFamilyHandle* handle)
+        {
+            if (const auto status {m_db->Put(m_writeOptions, handle, key, value)}; !status.ok())
+            {
+                throw std::runtime_error("Error putting data: " + status.ToString());
+            }
+        }
+
+        template<typename V>
+        bool getFrom(const std::string& key,
+                     V& value,
+                     rocksdb::ColumnFamilyHandle* handle,
+                     const rocksdb::ReadOptions& readOptions)
+        {
+            if (const auto status {m_db->Get(readOptions, handle, key, &value)}; status.IsNotFound())
+            {
+                return false;
+            }
+            else if (!status.ok())
+            {
+                throw std::runtime_error("Error getting data: " + status.ToString());
+            }
+            return true;
+        }
+
+        std::vector<bool> multiGetFrom(const std::vector<std::string>& keys,
+                                       std::vector<rocksdb::PinnableSlice>& values,
+                                       rocksdb::ColumnFamilyHandle* handle,
+                                       const rocksdb::ReadOptions& readOptions)
+        {
+            std::vector<rocksdb::Slice> keySlices;
+            keySlices.reserve(keys.size());
+            for (const auto& key : keys)
+            {
+                if (key.empty())
+                {
+                    throw std::invalid_argument("Key is empty");
+                }
+                keySlices.emplace_back(key);
+            }
+
+            values.clear();
+            values.resize(keys.size());
+            std::vector<rocksdb::Status> statuses(keys.size());
+            m_db->MultiGet(readOptions, handle, keys.size(), keySlices.data(), values.data(), statuses.data());
+
+            std::vector<bool> found(keys.size(), false);
+            for (size_t i = 0; i < statuses.size(); ++i)
+            {
+                if (statuses[i].ok())
+                {
+                    found[i] = true;
+                }
+                else if (!statuses[i].IsNotFound())
+                {
+                    throw std::runtime_error("Error getting data: " + statuses[i].ToString());
+                }
+            }
+            return found;
+        }
+
+        void deleteFrom(const std::string& key, rocksdb::ColumnFamilyHandle* handle)
+        {
+            if (const auto status {m_db->Delete(m_writeOptions, handle, key)}; !status.ok())
+            {
+                throw std::runtime_error("Error deleting data: " + status.ToString());
+            }
+        }
+
+        /**
+         * @brief Sets the current handle of a column in the RocksDBColumn handles obtained for it.
+         *
+         * @param columnName Name of the column.
+         * @param handle Column family handle, null if the column was dropped.
+         */
+        void updateColumnSlot(const std::string& columnName, rocksdb::ColumnFamilyHandle* handle)
+        {
+            if (const auto it {m_columnSlots.find(columnName)}; it != m_columnSlots.end())
+            {
+                *it->second = handle;
+            }
+        }
 
         /**
          * @brief Returns the column family handle identified by its name.
@@ -703,6 +1048,7 @@ namespace Utils
         }
 
         friend class RocksDBTransaction;
+        friend class RocksDBWriteBatch;
     };
 
     /**
@@ -923,6 +1269,224 @@ namespace Utils
             m_txn;                ///< RocksDB transaction.
         bool m_committed {false}; ///< Whether the transaction has been committed or not.
     };
+
+    /**
+     * @brief Wrapper class that accumulates the writes in a rocksdb::WriteBatch, written at once on commit.
+     *
+     * @details Several batches of the same database can be filled concurrently: The accesses to the columns list are
+     * serialized with the mutex given to all of them. The reads are done on the database, so they don't see the
+     * writes still pending on the batch.
+     */
+    class RocksDBWriteBatch final : public IRocksDBWrapper
+    {
+    public:
+        /**
+         * @brief Constructor.
+         *
+         * @param dbWrapper RocksDB instance.
+         * @param columnsMutex Mutex shared by the batches filled concurrently, to create and look up the columns.
+         */
+        RocksDBWriteBatch(TRocksDBWrapper<>* dbWrapper, std::shared_mutex& columnsMutex)
+            : m_dbWrapper {dbWrapper}
+            , m_columnsMutex {columnsMutex}
+        {
+            if (!m_dbWrapper)
+            {
+                throw std::runtime_error {"RocksDB instance is null"};
+            }
+        }
+
+        /**
+         * @brief Put a key-value pair in the batch.
+         * @param key Key to put.
+         * @param value Value to put.
+         * @param columnName Column name where the put will be performed. If empty, the default column will be used.
+         *
+         * @note If the key already exists, the value will be overwritten.
+         */
+        void put(const std::string& key, const rocksdb::Slice& value, const std::string& columnName) override
+        {
+            std::shared_lock lock {m_columnsMutex};
+            const auto handle {m_dbWrapper->getColumnFamilyBasedOnName(columnName).handle()};
+            if (const auto status {m_batch.Put(handle, key, value)}; !status.ok())
+            {
+                throw std::runtime_error {"Failed to put key: " + std::string {status.getState()}};
+            }
+        }
+
+        /**
+         * @brief Put a key-value pair in the batch.
+         * @param key Key to put.
+         * @param value Value to put.
+         *
+         * @note If the key already exists, the value will be overwritten.
+         */
+        void put(const std::string& key, const rocksdb::Slice& value) override
+        {
+            put(key, value, "");
+        }
+
+        /**
+         * @brief Delete a key-value pair from the database, when the batch is written.
+         *
+         * @param key Key to delete.
+         * @param columnName Column name from where to delete. If empty, the default column will be used.
+         */
+        void delete_(const std::string& key, const std::string& columnName) override
+        {
+            std::shared_lock lock {m_columnsMutex};
+            if (const auto status {m_batch.Delete(m_dbWrapper->getColumnFamilyBasedOnName(columnName).handle(), key)};
+                !status.ok())
+            {
+                throw std::runtime_error {"Failed to delete key: " + std::string {status.getState()}};
+            }
+        }
+
+        /**
+         * @brief Delete a key-value pair from the database, when the batch is written.
+         *
+         * @param key Key to delete.
+         */
+        void delete_(const std::string& key) override
+        {
+            delete_(key, "");
+        }
+
+        /**
+         * @brief Get a value from the database. The writes pending on the batch aren't visible.
+         *
+         * @param key Key to get.
+         * @param value Value to get (rocksdb::PinnableSlice).
+         * @param columnName Column name from where to get. If empty, the default column will be used.
+         *
+         * @return bool True if the operation was successful.
+         * @return bool False if the key was not found.
+         */
+        bool get(const std::string& key, rocksdb::PinnableSlice& value, const std::string& columnName) override
+        {
+            std::shared_lock lock {m_columnsMutex};
+            return m_dbWrapper->get(key, value, columnName);
+        }
+
+        /**
+         * @brief Get a value from the database. The writes pending on the batch aren't visible.
+         *
+         * @param key Key to get.
+         * @param value Value to get (rocksdb::PinnableSlice).
+         *
+         * @return bool True if the operation was successful.
+         * @return bool False if the key was not found.
+         */
+        bool get(const std::string& key, rocksdb::PinnableSlice& value) override
+        {
+            return get(key, value, "");
+        }
+
+        /**
+         * @brief Writes the batch in the database and clears it.
+         */
+        void commit() override
+        {
+            if (const auto status {m_dbWrapper->m_db->Write(m_dbWrapper->m_writeOptions, &m_batch)}; !status.ok())
+            {
+                throw std::runtime_error {"Failed to write batch: " + std::string {status.getState()}};
+            }
+            m_batch.Clear();
+        }
+
+        /**
+         * @brief Size of the data accumulated in the batch.
+         *
+         * @return size_t Size in bytes.
+         */
+        size_t size() const
+        {
+            return m_batch.GetDataSize();
+        }
+
+        /**
+         * @brief Checks whether the batch has pending writes.
+         *
+         * @return true If there are no pending writes.
+         */
+        bool empty() const
+        {
+            return m_batch.Count() == 0;
+        }
+
+        /**
+         * @brief Delete all key-value pairs from the database.
+         */
+        void deleteAll() override
+        {
+            std::unique_lock lock {m_columnsMutex};
+            m_dbWrapper->deleteAll();
+        }
+
+        /**
+         * @brief Creates a new column family in the database, if it doesn't exist yet.
+         *
+         * @param columnName Name of the new column.
+         */
+        void createColumn(const std::string& columnName) override
+        {
+            std::unique_lock lock {m_columnsMutex};
+            if (!m_dbWrapper->columnExists(columnName))
+            {
+                m_dbWrapper->createColumn(columnName);
+            }
+        }
+
+        /**
+         * @brief Checks whether a column exists in the database or not.
+         *
+         * @param columnName Name of the column.
+         * @return true If the column exists.
+         * @return false If the column doesn't exists.
+         */
+        bool columnExists(const std::string& columnName) const override
+        {
+            std::shared_lock lock {m_columnsMutex};
+            return m_dbWrapper->columnExists(columnName);
+        }
+
+        /**
+         * @brief Retrieves all the column families from the DB.
+         *
+         * @return std::vector<std::string> Vector of strings with all the column names.
+         */
+        std::vector<std::string> getAllColumns() override
+        {
+            return m_dbWrapper->getAllColumns();
+        }
+
+        /**
+         * @brief Seek to specific key of the database. The writes pending on the batch aren't visible.
+         *
+         * @param key Key to seek.
+         * @param columnName Column family name.
+         * @return RocksDBIterator  RocksDBIterator Iterator to the database.
+         */
+        RocksDBIterator seek(std::string_view key, const std::string& columnName = "") override // NOLINT
+        {
+            std::shared_lock lock {m_columnsMutex};
+            return m_dbWrapper->seek(key, columnName);
+        }
+
+        /**
+         * @brief Flushes the batch.
+         */
+        [[noreturn]] void flush() override
+        {
+            // The batch is written on commit.
+            throw std::runtime_error("Not implemented");
+        }
+
+    private:
+        TRocksDBWrapper<>* m_dbWrapper;    ///< RocksDB instance.
+        std::shared_mutex& m_columnsMutex; ///< Mutex of the columns list, shared by the concurrent batches.
+        rocksdb::WriteBatch m_batch;       ///< Pending writes.
+    };
     using RocksDBWrapper = TRocksDBWrapper<>;
 } // namespace Utils
 
@@ -58,6 +58,20 @@ private:
         }
     }
 
+    void sendExpiredBatch()
+    {
+        std::shared_lock<std::shared_mutex> lock(m_socketMutex);
+        try
+        {
+            m_socket->flushExpired();
+        }
+        catch (const std::exception& e)
+        {
+            // Error sending the batch, the rest is sent when the socket is ready.
+            m_epoll->modifyDescriptor(m_socket->fileDescriptor(), EPOLLIN | EPOLLOUT);
+        }
+    }
+
 public:
     explicit SocketClient(std::string socketPath)
         : m_socketPath {std::move(socketPath)}
@@ -127,7 +141,7 @@ public:
                     try
                     {
                         // Wait for events
-                        auto numFDsReady = m_epoll->wait(events.data(), events.size(), -1);
+                        auto numFDsReady = m_epoll->wait(events.data(), events.size(), TSocket::flushTimeout());
 
                         for (int i = 0; i < numFDsReady; ++i)
                         {
@@ -179,6 +193,11 @@ public:
                                 }
                             }
                         }
+
+                        if constexpr (TSocket::BATCHED)
+                        {
+                            sendExpiredBatch();
+                        }
                     }
                     catch (const std::exception& e)
                     {
@@ -29,6 +29,9 @@ char constexpr DB_WRAPPER_UNKNOWN[] {"unk"};
 char constexpr DB_WRAPPER_IGNORE[] {"ign"};
 char constexpr DB_WRAPPER_DUE[] {"due"};
 
+// Largest query accepted by wazuh-db (OS_MAXSTR).
+auto constexpr DB_WRAPPER_MAX_QUERY_SIZE {65536};
+
 enum class DbQueryStatus : uint8_t
 {
     UNKNOWN,
@@ -104,7 +107,11 @@ public:
                     }
                     else if (0 == responsePacket.compare(0, sizeof(DB_WRAPPER_OK) - 1, DB_WRAPPER_OK))
                     {
-                        if (!m_responsePartial.empty())
+                        if (responsePacket.size() == sizeof(DB_WRAPPER_OK) - 1)
+                        {
+                            // Acknowledge without payload, like the responses to the save commands.
+                        }
+                        else if (!m_responsePartial.empty())
                         {
                             m_response = m_responsePartial;
                         }
@@ -199,6 +206,45 @@ public:
         response = m_response;
     }
 
+    /**
+     * @brief Stores a set of Syscollector rows of an agent, in as few queries as possible.
+     *
+     * @details The rows are sent with the "save_batch" command, stored by wazuh-db in a single transaction and
+     * acknowledged once, instead of a "save2" query and its response for each one. The rows are split in several
+     * batches when they don't fit in a query.
+     *
+     * @param agentId Agent ID, formatted as in the queries ("001").
+     * @param component Syscollector component, like "syscollector_packages".
+     * @param rows Array of rows, with the same format as the "save2" payload ({"attributes": {...}}).
+     */
+    void saveBatch(const std::string& agentId, const std::string& component, const nlohmann::json& rows)
+    {
+        const auto prefix {"agent " + agentId + " " + component + " save_batch ["};
+        std::string batch {prefix};
+        nlohmann::json response;
+
+        for (const auto& row : rows)
+        {
+            const auto data {row.dump()};
+
+            if (batch.size() > prefix.size() && batch.size() + data.size() + 1 >= DB_WRAPPER_MAX_QUERY_SIZE)
+            {
+                batch.back() = ']';
+                query(batch, response);
+                batch = prefix;
+            }
+
+            batch.append(data);
+            batch.push_back(',');
+        }
+
+        if (batch.size() > prefix.size())
+        {
+            batch.back() = ']';
+            query(batch, response);
+        }
+    }
+
     /**
      * @brief Teardown the Socket DB Wrapper object
      *
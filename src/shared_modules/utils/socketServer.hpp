@@ -14,6 +14,8 @@
 #include "epollWrapper.hpp"
 #include "osPrimitives.hpp"
 #include "socketWrapper.hpp"
+#include "threadDispatcher.h"
+#include <algorithm>
 #include <atomic>
 #include <iostream>
 #include <memory>
@@ -23,21 +25,37 @@
 #include <sys/epoll.h>
 #include <thread>
 #include <unordered_map>
+#include <vector>
 
 constexpr auto EVENTS_LIMIT = 1024;
 constexpr auto EVENTS = 32;
 
+/**
+ * @brief Message read by a reactor, copied to be processed by the callback workers.
+ *
+ */
+struct ServerMessage final
+{
+    int fd;
+    std::vector<char> body;
+    std::vector<char> header;
+};
+
 template<typename TSocket = Socket<OSPrimitives>, typename TEpoll = EpollWrapper>
 class SocketServer final
 {
 private:
+    using CallbackWorker = Utils::AsyncDispatcher<ServerMessage, std::function<void(const ServerMessage&)>>;
+
     const std::string m_socketPath;
     std::atomic<bool> m_shouldStop;
     int m_stopFD[2] = {-1, -1};
-    std::unique_ptr<TEpoll> m_epoll;
+    std::vector<std::unique_ptr<TEpoll>> m_epolls;
     std::unique_ptr<TSocket> m_listenSocket;
     std::unordered_map<int, std::shared_ptr<TSocket>> m_clients {};
-    std::thread m_listenThread;
+    std::vector<std::thread> m_reactorThreads;
+    std::vector<std::unique_ptr<CallbackWorker>> m_callbackWorkers;
+    const size_t m_callbackThreads;
     std::mutex m_mutex;
 
     std::shared_ptr<TSocket> getClient(const int fd)
@@ -58,12 +76,18 @@ private:
         m_clients[fd] = std::move(client);
     }
 
+    // The clients are sharded by their descriptor across the reactors.
+    TEpoll& clientEpoll(const int fd)
+    {
+        return *m_epolls[fd % m_epolls.size()];
+    }
+
     void sendPendingMessages(std::shared_ptr<TSocket> client)
     {
         try
         {
             client->sendUnsentMessages();
-            m_epoll->modifyDescriptor(client->fileDescriptor(), EPOLLIN);
+            clientEpoll(client->fileDescriptor()).modifyDescriptor(client->fileDescriptor(), EPOLLIN);
         }
         catch (const std::exception& e)
         {
@@ -71,13 +95,122 @@ private:
         }
     }
 
+    void sendExpiredBatches(const size_t reactor)
+    {
+        std::lock_guard<std::mutex> lock {m_mutex};
+        for (const auto& [fd, client] : m_clients)
+        {
+            if (fd % m_epolls.size() != reactor)
+            {
+                continue;
+            }
+
+            try
+            {
+                client->flushExpired();
+            }
+            catch (const std::exception& e)
+            {
+                // Error sending the batch, the rest is sent when the socket is ready.
+                clientEpoll(fd).modifyDescriptor(fd, EPOLLIN | EPOLLOUT);
+            }
+        }
+    }
+
+    void handleEvents(const size_t reactor,
+                      const std::function<void(const int, const char*, uint32_t, const char*, uint32_t)>& onRead)
+    {
+        auto& epoll {*m_epolls[reactor]};
+        std::vector<struct epoll_event> events(EVENTS);
+        while (!m_shouldStop)
+        {
+            // Wait for events
+            auto numFDsReady = epoll.wait(events.data(), events.size(), TSocket::flushTimeout());
+
+            // Process events
+            for (int i = 0; i < numFDsReady; ++i)
+            {
+                auto eventFD {events.at(i).data.fd};
+                // If the event is on the server socket, then it's a new connection
+                if (eventFD == m_listenSocket->fileDescriptor())
+                {
+                    try
+                    {
+                        const auto clientFD = m_listenSocket->accept();
+                        addClient(clientFD, std::make_shared<TSocket>(clientFD));
+                        clientEpoll(clientFD).addDescriptor(clientFD, EPOLLIN);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        std::cerr << "Failed to initialize client socket: " << e.what() << std::endl;
+                    }
+                }
+                else if (eventFD == m_stopFD[0])
+                {
+                    // The stop_fd is drained once all the reactors are stopped, so every reactor sees it.
+                    break;
+                }
+                else
+                {
+                    auto event = events.at(i).events;
+                    auto client {getClient(eventFD)};
+
+                    if (event & EPOLLOUT)
+                    {
+                        sendPendingMessages(client);
+                    }
+
+                    if (event & EPOLLIN)
+                    {
+                        try
+                        {
+                            client->read(onRead);
+                        }
+                        catch (const std::exception&)
+                        {
+                            // std::cerr << "Failed to read from client socket: " << e.what() << std::endl;
+                        }
+                    }
+
+                    if (event & EPOLLERR || event & EPOLLHUP)
+                    {
+                        removeClient(eventFD);
+                    }
+                }
+            }
+
+            if constexpr (TSocket::BATCHED)
+            {
+                sendExpiredBatches(reactor);
+            }
+
+            // If we ran out of room in our events vector, double its size
+            if (numFDsReady == static_cast<int>(events.size()))
+            {
+                if (numFDsReady >= EVENTS_LIMIT)
+                {
+                    events.resize(events.size() * 2);
+                }
+            }
+        }
+    }
+
 public:
-    explicit SocketServer(std::string socketPath)
+    /**
+     * @brief Constructor.
+     *
+     * @param socketPath Path of the unix socket to listen on.
+     * @param reactorThreads Threads waiting for the events of the clients, each one owning the clients whose
+     * descriptor modulo the number of threads is its index. The first one also accepts the new clients.
+     * @param callbackThreads Threads running the read callback, 0 runs it in the reactor threads. The messages of a
+     * client are always processed by the same thread, in order.
+     */
+    explicit SocketServer(std::string socketPath, const size_t reactorThreads = 1, const size_t callbackThreads = 0)
         : m_socketPath {std::move(socketPath)}
         , m_shouldStop {false}
-        , m_epoll {std::make_unique<TEpoll>()}
         , m_listenSocket {std::make_unique<TSocket>()}
         , m_clients {}
+        , m_callbackThreads {callbackThreads}
     {
         int result = pipe(m_stopFD);
         if (result == -1)
@@ -90,8 +223,12 @@ public:
             throw std::runtime_error("Failed to set stop pipe to non-blocking");
         }
 
-        // Add pipe to stop epoll
-        m_epoll->addDescriptor(m_stopFD[0], EPOLLIN | EPOLLET);
+        for (size_t i = 0; i < std::max<size_t>(reactorThreads, 1); ++i)
+        {
+            m_epolls.push_back(std::make_unique<TEpoll>());
+            // Add pipe to stop epoll
+            m_epolls.back()->addDescriptor(m_stopFD[0], EPOLLIN | EPOLLET);
+        }
     }
 
     ~SocketServer()
@@ -110,11 +247,26 @@ public:
         char dummy = 'x';
         std::ignore = ::write(m_stopFD[1], &dummy, sizeof(dummy));
 
-        if (m_listenThread.joinable())
+        for (auto& thread : m_reactorThreads)
         {
-            m_listenThread.join();
+            if (thread.joinable())
+            {
+                thread.join();
+            }
         }
-        m_epoll->deleteDescriptor(m_listenSocket->fileDescriptor());
+        m_reactorThreads.clear();
+
+        // Drain the byte from the stop_fd
+        std::ignore = ::read(m_stopFD[0], &dummy, sizeof(dummy));
+
+        // Process the messages already read.
+        for (auto& worker : m_callbackWorkers)
+        {
+            worker->rundown();
+        }
+        m_callbackWorkers.clear();
+
+        m_epolls.front()->deleteDescriptor(m_listenSocket->fileDescriptor());
         m_listenSocket->closeSocket();
     }
 
@@ -132,81 +284,44 @@ public:
         m_listenSocket->listen(unixAddressBuilder.address(m_socketPath).data());
 
         // Add server socket to epoll
-        m_epoll->addDescriptor(m_listenSocket->fileDescriptor(), EPOLLIN);
+        m_epolls.front()->addDescriptor(m_listenSocket->fileDescriptor(), EPOLLIN);
 
-        m_listenThread = std::thread(
-            [&, onRead]()
+        auto callback {onRead};
+        if (m_callbackThreads > 0)
+        {
+            for (size_t i = 0; i < m_callbackThreads; ++i)
             {
-                std::vector<struct epoll_event> events(EVENTS);
-                while (!m_shouldStop)
-                {
-                    // Wait for events
-                    auto numFDsReady = m_epoll->wait(events.data(), events.size(), -1);
-
-                    // Process events
-                    for (int i = 0; i < numFDsReady; ++i)
+                m_callbackWorkers.push_back(std::make_unique<CallbackWorker>(
+                    [onRead](const ServerMessage& message)
                     {
-                        auto eventFD {events.at(i).data.fd};
-                        // If the event is on the server socket, then it's a new connection
-                        if (eventFD == m_listenSocket->fileDescriptor())
-                        {
-                            try
-                            {
-                                const auto clientFD = m_listenSocket->accept();
-                                addClient(clientFD, std::make_shared<TSocket>(clientFD));
-                                m_epoll->addDescriptor(clientFD, EPOLLIN);
-                            }
-                            catch (const std::exception& e)
-                            {
-                                std::cerr << "Failed to initialize client socket: " << e.what() << std::endl;
-                            }
-                        }
-                        else if (eventFD == m_stopFD[0])
+                        try
                         {
-                            // Drain the byte from the stop_fd and break out of the loop
-                            char dummy;
-                            std::ignore = ::read(m_stopFD[0], &dummy, sizeof(dummy));
-                            break;
+                            onRead(message.fd,
+                                   message.body.data(),
+                                   message.body.size(),
+                                   message.header.data(),
+                                   message.header.size());
                         }
-                        else
+                        catch (const std::exception&)
                         {
-                            auto event = events.at(i).events;
-                            auto client {getClient(eventFD)};
-
-                            if (event & EPOLLOUT)
-                            {
-                                sendPendingMessages(client);
-                            }
-
-                            if (event & EPOLLIN)
-                            {
-                                try
-                                {
-                                    client->read(onRead);
-                                }
-                                catch (const std::exception&)
-                                {
-                                    // std::cerr << "Failed to read from client socket: " << e.what() << std::endl;
-                                }
-                            }
-
-                            if (event & EPOLLERR || event & EPOLLHUP)
-                            {
-                                removeClient(eventFD);
-                            }
+                            // Error processing the message, the worker keeps running.
                         }
-                    }
+                    },
+                    1));
+            }
 
-                    // If we ran out of room in our events vector, double its size
-                    if (numFDsReady == static_cast<int>(events.size()))
-                    {
-                        if (numFDsReady >= EVENTS_LIMIT)
-                        {
-                            events.resize(events.size() * 2);
-                        }
-                    }
-                }
-            });
+            callback =
+                [this](const int fd, const char* body, uint32_t bodySize, const char* header, uint32_t headerSize)
+            {
+                m_callbackWorkers[fd % m_callbackWorkers.size()]->push(ServerMessage {
+                    fd, std::vector<char>(body, body + bodySize), std::vector<char>(header, header + headerSize)});
+            };
+        }
+
+        for (size_t i = 0; i < m_epolls.size(); ++i)
+        {
+            m_reactorThreads.emplace_back([this, i, callback]() { handleEvents(i, callback); });
+        }
     }
 
     void send(int fd, const char* dataBody, size_t sizeBody, const char* dataHeader = nullptr, size_t sizeHeader = 0)
@@ -218,7 +333,7 @@ public:
         }
         catch (const std::exception& e)
         {
-            m_epoll->modifyDescriptor(fd, EPOLLIN | EPOLLOUT);
+            clientEpoll(fd).modifyDescriptor(fd, EPOLLIN | EPOLLOUT);
         }
     }
 };
@@ -15,6 +15,8 @@
 #include "osPrimitives.hpp"
 #include "packet.hpp"
 #include <arpa/inet.h>
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <cstring>
 #include <filesystem>
@@ -25,7 +27,9 @@
 #include <mutex>
 #include <queue>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <thread>
+#include <type_traits>
 #include <unistd.h>
 
 constexpr auto INVALID_SOCKET {-1};
@@ -35,6 +39,9 @@ using HeaderFieldType = uint32_t;
 constexpr auto PACKET_FIELD_SIZE {sizeof(PacketFieldType)};
 constexpr auto HEADER_FIELD_SIZE {sizeof(HeaderFieldType)};
 constexpr auto BUFFER_MAX_SIZE {8192 * 8};
+constexpr auto SEND_VECTORS_MAX_SIZE {3};
+constexpr auto DEFAULT_BATCH_DELAY_MS {1};
+using SendVectors = std::array<iovec, SEND_VECTORS_MAX_SIZE>;
 
 enum class SocketType
 {
@@ -167,6 +174,45 @@ public:
         bufferSize = sizeof(Header) + sizeHeader + sizeBody;
     }
 
+    /**
+     * @brief Point the vectors to send to the parts of the packet according to this protocol, so they are written
+     * together without copying the header and the body.
+     *
+     * @param buffer        Buffer to write the packet and header sizes to, it must outlive the send.
+     * @param vectors       Output vectors.
+     * @param dataBody      Data to send.
+     * @param sizeBody      Size of the data to send.
+     * @param dataHeader    Optional header to send.
+     * @param sizeHeader    Size of the optional header.
+     * @return size_t Number of vectors used.
+     */
+    size_t static buildVectors(std::vector<char>& buffer,
+                               SendVectors& vectors,
+                               const char* dataBody,
+                               uint32_t sizeBody,
+                               const char* dataHeader = nullptr,
+                               uint32_t sizeHeader = 0)
+    {
+        auto* pHeader = reinterpret_cast<struct Header*>(buffer.data());
+        pHeader->packetSize = sizeBody + sizeof(Header::headerSize) + sizeHeader;
+        pHeader->headerSize = sizeHeader;
+
+        size_t count {0};
+        vectors[count++] = {buffer.data(), sizeof(Header)};
+
+        if (sizeHeader > 0)
+        {
+            vectors[count++] = {const_cast<char*>(dataHeader), sizeHeader};
+        }
+
+        if (sizeBody > 0)
+        {
+            vectors[count++] = {const_cast<char*>(dataBody), sizeBody};
+        }
+
+        return count;
+    }
+
     /**
      * @brief Get the size of the header according to this protocol.
      *
@@ -178,6 +224,19 @@ public:
         return *reinterpret_cast<const uint32_t*>(buffer.data());
     }
 
+    /**
+     * @brief Get the size of the header of a frame according to this protocol.
+     *
+     * @param frame Frame to obtain the header size from, after the packet size.
+     * @return auto Header size.
+     */
+    auto static getHeaderSize(const char* frame)
+    {
+        HeaderFieldType headerSize {0};
+        std::memcpy(&headerSize, frame, sizeof(headerSize));
+        return headerSize;
+    }
+
     /**
      * @brief Get the data offset according to this protocol.
      *
@@ -249,6 +308,39 @@ public:
         bufferSize = sizeof(Header) + sizeBody;
     }
 
+    /**
+     * @brief Point the vectors to send to the parts of the packet according to this protocol, so they are written
+     * together without copying the body.
+     *
+     * @param buffer        Buffer to write the packet size to, it must outlive the send.
+     * @param vectors       Output vectors.
+     * @param dataBody      Data to send.
+     * @param sizeBody      Size of the data to send.
+     * @param dataHeader    Optional header to send.
+     * @param sizeHeader    Size of the optional header.
+     * @return size_t Number of vectors used.
+     */
+    size_t static buildVectors(std::vector<char>& buffer,
+                               SendVectors& vectors,
+                               const char* dataBody,
+                               uint32_t sizeBody,
+                               const char* dataHeader = nullptr,
+                               uint32_t sizeHeader = 0)
+    {
+        auto* pHeader = reinterpret_cast<struct Header*>(buffer.data());
+        pHeader->packetSize = sizeBody;
+
+        size_t count {0};
+        vectors[count++] = {buffer.data(), sizeof(Header)};
+
+        if (sizeBody > 0)
+        {
+            vectors[count++] = {const_cast<char*>(dataBody), sizeBody};
+        }
+
+        return count;
+    }
+
     /**
      * @brief Get the size of the header according to this protocol.
      *
@@ -260,6 +352,17 @@ public:
         return 0;
     }
 
+    /**
+     * @brief Get the size of the header of a frame according to this protocol.
+     *
+     * @param frame Frame to obtain the header size from, after the packet size.
+     * @return auto Header size.
+     */
+    auto static getHeaderSize(const char* frame)
+    {
+        return 0;
+    }
+
     /**
      * @brief Get the data offset according to this protocol.
      *
@@ -325,6 +428,34 @@ public:
         bufferSize = sizeBody;
     }
 
+    /**
+     * @brief Point the vectors to send to the body according to this protocol, so it is written without copying it.
+     *
+     * @param buffer        Unused, this protocol does not send sizes.
+     * @param vectors       Output vectors.
+     * @param dataBody      Data to send.
+     * @param sizeBody      Size of the data to send.
+     * @param dataHeader    Optional header to send.
+     * @param sizeHeader    Size of the optional header.
+     * @return size_t Number of vectors used.
+     */
+    size_t static buildVectors(std::vector<char>& buffer,
+                               SendVectors& vectors,
+                               const char* dataBody,
+                               uint32_t sizeBody,
+                               const char* dataHeader = nullptr,
+                               uint32_t sizeHeader = 0)
+    {
+        size_t count {0};
+
+        if (sizeBody > 0)
+        {
+            vectors[count++] = {const_cast<char*>(dataBody), sizeBody};
+        }
+
+        return count;
+    }
+
     /**
      * @brief Get the size of the header according to this protocol.
      *
@@ -358,6 +489,77 @@ public:
     }
 };
 
+/**
+ * @brief This class keeps the format of the framed protocol it wraps, but the messages are coalesced in bursts sent
+ *        with a single syscall once the byte budget is reached or the oldest message waited for the time budget. The
+ *        receiver parses all the frames available after each read, so the peer can use either of them.
+ *
+ * @tparam TProtocol Framed protocol of the messages (AppendHeaderProtocol or SizeHeaderProtocol).
+ * @tparam MaxBatchBytes Bytes queued that trigger a send.
+ * @tparam MaxBatchDelayMs Milliseconds a queued message waits before the batch is sent.
+ */
+template<class TProtocol = AppendHeaderProtocol,
+         size_t MaxBatchBytes = BUFFER_MAX_SIZE,
+         size_t MaxBatchDelayMs = DEFAULT_BATCH_DELAY_MS>
+class BatchedProtocol final
+{
+    static_assert(!std::is_same_v<TProtocol, NoHeaderProtocol>, "Batched messages must be framed");
+
+public:
+    static constexpr auto BATCH_MAX_BYTES {MaxBatchBytes};
+    static constexpr auto BATCH_MAX_DELAY {std::chrono::milliseconds(MaxBatchDelayMs)};
+
+    template<typename... Args>
+    void static buildBuffer(Args&&... args)
+    {
+        TProtocol::buildBuffer(std::forward<Args>(args)...);
+    }
+
+    template<typename... Args>
+    size_t static buildVectors(Args&&... args)
+    {
+        return TProtocol::buildVectors(std::forward<Args>(args)...);
+    }
+
+    template<typename TBuffer>
+    auto static getHeaderSize(const TBuffer& buffer)
+    {
+        return TProtocol::getHeaderSize(buffer);
+    }
+
+    auto static getDataOffset(uint32_t headerSize)
+    {
+        return TProtocol::getDataOffset(headerSize);
+    }
+
+    auto static getHeaderOffset()
+    {
+        return TProtocol::getHeaderOffset();
+    }
+};
+
+template<typename TProtocol>
+struct IsBatchedProtocol final : std::false_type
+{
+};
+
+template<class TProtocol, size_t MaxBatchBytes, size_t MaxBatchDelayMs>
+struct IsBatchedProtocol<BatchedProtocol<TProtocol, MaxBatchBytes, MaxBatchDelayMs>> final : std::true_type
+{
+};
+
+/**
+ * @brief Counters of the batched sockets, to measure the frames moved by each syscall.
+ *
+ */
+struct SocketCounters final
+{
+    std::atomic<uint64_t> sendCalls {0};
+    std::atomic<uint64_t> sentFrames {0};
+    std::atomic<uint64_t> recvCalls {0};
+    std::atomic<uint64_t> receivedFrames {0};
+};
+
 enum class SocketStatus
 {
     HEADER,
@@ -388,8 +590,14 @@ private:
     std::vector<char> m_sendDataBuffer {};
     std::queue<Packet> m_unsentPacketList {};
     std::mutex m_mutex;
+    std::vector<char> m_batchBuffer {};
+    uint64_t m_batchFrames {0};
+    std::chrono::steady_clock::time_point m_batchStart {};
+    SocketCounters m_counters {};
 
 public:
+    static constexpr bool BATCHED {IsBatchedProtocol<TCommunicationProtocol>::value};
+
     explicit Socket(const int sock = INVALID_SOCKET)
         : m_sock {sock}
         , m_status {SocketStatus::HEADER}
@@ -430,6 +638,64 @@ public:
         return !m_unsentPacketList.empty();
     }
 
+    /**
+     * @brief Counters of the syscalls and the frames sent and received, only updated by batched protocols.
+     *
+     * @return const SocketCounters& Counters.
+     */
+    const SocketCounters& counters() const
+    {
+        return m_counters;
+    }
+
+    /**
+     * @brief Timeout, in milliseconds, to wait for events before checking the queued batch. -1 if the protocol
+     * doesn't batch the messages.
+     *
+     * @return int Timeout.
+     */
+    static constexpr int flushTimeout()
+    {
+        if constexpr (BATCHED)
+        {
+            return TCommunicationProtocol::BATCH_MAX_DELAY.count();
+        }
+        else
+        {
+            return -1;
+        }
+    }
+
+    /**
+     * @brief Send the queued batch, regardless of the budgets of the protocol.
+     *
+     */
+    void flush()
+    {
+        if constexpr (BATCHED)
+        {
+            std::lock_guard<std::mutex> lock {m_mutex};
+            flushBatch();
+        }
+    }
+
+    /**
+     * @brief Send the queued batch if its oldest message waited for the time budget of the protocol.
+     *
+     */
+    void flushExpired()
+    {
+        if constexpr (BATCHED)
+        {
+            std::lock_guard<std::mutex> lock {m_mutex};
+            if (m_batchFrames > 0 &&
+                std::chrono::steady_clock::now() - m_batchStart >= TCommunicationProtocol::BATCH_MAX_DELAY)
+            {
+                flushBatch();
+            }
+        }
+    }
+
     void connect(const SocketAddress& connInfo, int type = (SOCK_STREAM | SOCK_NONBLOCK))
     {
         // Close socket if it was already initialized.
@@ -470,6 +736,12 @@ public:
 
     void read(const std::function<void(const int, const char*, uint32_t, const char*, uint32_t)>& callback)
     {
+        if constexpr (BATCHED)
+        {
+            readFrames(callback);
+            return;
+        }
+
         uint32_t* uip;
         ssize_t ret;
         bool dataToRead = true;
@@ -647,7 +919,7 @@ public:
             }
             else
             {
-                if (ret != packet.size)
+                if (packet.offset + ret != packet.size)
                 {
                     // In this case we need to send the rest of the data, when the next send is called.
                     packet.offset += ret;
@@ -663,33 +935,42 @@ public:
 
     void send(const char* dataBody, uint32_t sizeBody, const char* dataHeader = nullptr, uint32_t sizeHeader = 0)
     {
-        uint32_t bufferSize {0};
-        ssize_t amountSent {0};
         std::lock_guard<std::mutex> lock {m_mutex};
 
-        TCommunicationProtocol::buildBuffer(m_sendDataBuffer, bufferSize, dataBody, sizeBody, dataHeader, sizeHeader);
-
+        if constexpr (BATCHED)
+        {
+            queueBatch(dataBody, sizeBody, dataHeader, sizeHeader);
+        }
         // If there is data in the unsent queue, add it to the queue.
-        if (!m_unsentPacketList.empty())
+        else if (!m_unsentPacketList.empty())
         {
+            uint32_t bufferSize {0};
+            TCommunicationProtocol::buildBuffer(
+                m_sendDataBuffer, bufferSize, dataBody, sizeBody, dataHeader, sizeHeader);
             m_unsentPacketList.emplace(m_sendDataBuffer.data(), bufferSize);
         }
         else
         {
-            // Send the data.
-            while (bufferSize != amountSent)
+            // Send the sizes, the header and the body in a single write, without copying them to the send buffer.
+            SendVectors vectors {};
+            msghdr message {};
+            message.msg_iov = vectors.data();
+            message.msg_iovlen = TCommunicationProtocol::buildVectors(
+                m_sendDataBuffer, vectors, dataBody, sizeBody, dataHeader, sizeHeader);
+
+            while (message.msg_iovlen > 0)
             {
-                const auto ret =
-                    T::send(m_sock, m_sendDataBuffer.data() + amountSent, bufferSize - amountSent, MSG_NOSIGNAL);
+                const auto ret = T::sendmsg(m_sock, &message, MSG_NOSIGNAL);
 
                 if (ret <= 0)
                 {
-                    m_unsentPacketList.emplace(m_sendDataBuffer.data() + amountSent, bufferSize - amountSent);
-                    throw std::runtime_error {"Error sending data to socket: " + std::string(std::strerror(errno))};
+                    const auto error {errno};
+                    queueUnsentVectors(message);
+                    throw std::runtime_error {"Error sending data to socket: " + std::string(std::strerror(error))};
                 }
                 else
                 {
-                    amountSent += ret;
+                    consumeVectors(message, ret);
                 }
             }
         }
@@ -779,6 +1060,18 @@ public:
     {
         if (m_sock != INVALID_SOCKET)
         {
+            if constexpr (BATCHED)
+            {
+                try
+                {
+                    flush();
+                }
+                catch (const std::exception& e)
+                {
+                    std::cerr << "Failed to send the queued batch: " << e.what() << std::endl;
+                }
+            }
+
             if (-1 == T::shutdown(m_sock, SHUT_WR))
             {
                 std::cerr << "Shutdown error: " << errno << std::endl;
@@ -787,6 +1080,228 @@ public:
             m_sock = INVALID_SOCKET;
         }
     }
+
+private:
+    /**
+     * @brief Append a framed message to the queued batch, and send the batch if a budget of the protocol is reached.
+     * The message is copied since the caller's buffer may not outlive the batch.
+     *
+     * @param dataBody      Data to send.
+     * @param sizeBody      Size of the data to send.
+     * @param dataHeader    Optional header to send.
+     * @param sizeHeader    Size of the optional header.
+     */
+    void queueBatch(const char* dataBody, uint32_t sizeBody, const char* dataHeader, uint32_t sizeHeader)
+    {
+        SendVectors vectors {};
+        const auto count {TCommunicationProtocol::buildVectors(
+            m_sendDataBuffer, vectors, dataBody, sizeBody, dataHeader, sizeHeader)};
+
+        const auto now {std::chrono::steady_clock::now()};
+        if (m_batchFrames == 0)
+        {
+            m_batchStart = now;
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            const auto* base = static_cast<const char*>(vectors[i].iov_base);
+            m_batchBuffer.insert(m_batchBuffer.end(), base, base + vectors[i].iov_len);
+        }
+        ++m_batchFrames;
+
+        if (m_batchBuffer.size() >= TCommunicationProtocol::BATCH_MAX_BYTES ||
+            now - m_batchStart >= TCommunicationProtocol::BATCH_MAX_DELAY)
+        {
+            flushBatch();
+        }
+    }
+
+    /**
+     * @brief Send the queued batch with a single syscall, the part not sent is queued with the unsent messages.
+     *
+     */
+    void flushBatch()
+    {
+        if (m_batchFrames == 0)
+        {
+            return;
+        }
+
+        // Keep the order of the messages waiting for the socket to be ready.
+        if (!m_unsentPacketList.empty())
+        {
+            m_unsentPacketList.emplace(m_batchBuffer.data(), m_batchBuffer.size());
+            clearBatch();
+            return;
+        }
+
+        size_t amountSent {0};
+        while (amountSent != m_batchBuffer.size())
+        {
+            const auto ret =
+                T::send(m_sock, m_batchBuffer.data() + amountSent, m_batchBuffer.size() - amountSent, MSG_NOSIGNAL);
+            m_counters.sendCalls.fetch_add(1, std::memory_order_relaxed);
+
+            if (ret <= 0)
+            {
+                const auto error {errno};
+                m_unsentPacketList.emplace(m_batchBuffer.data() + amountSent, m_batchBuffer.size() - amountSent);
+                clearBatch();
+                throw std::runtime_error {"Error sending data to socket: " + std::string(std::strerror(error))};
+            }
+
+            amountSent += ret;
+        }
+
+        m_counters.sentFrames.fetch_add(m_batchFrames, std::memory_order_relaxed);
+        clearBatch();
+    }
+
+    /**
+     * @brief Empty the queued batch, keeping its buffer unless a big message grew it beyond the byte budget.
+     *
+     */
+    void clearBatch()
+    {
+        m_batchBuffer.clear();
+        m_batchFrames = 0;
+
+        if (m_batchBuffer.capacity() > TCommunicationProtocol::BATCH_MAX_BYTES * 2)
+        {
+            m_batchBuffer.shrink_to_fit();
+        }
+    }
+
+    /**
+     * @brief Read all the data available and call the callback for each complete frame in it. The bytes of an
+     * incomplete frame are kept at the beginning of the receive buffer for the next read.
+     *
+     * @param callback Callback to call for each frame.
+     */
+    void readFrames(const std::function<void(const int, const char*, uint32_t, const char*, uint32_t)>& callback)
+    {
+        if (m_sock == INVALID_SOCKET)
+        {
+            throw std::runtime_error {"Invalid socket"};
+        }
+
+        while (true)
+        {
+            const auto ret = T::recv(
+                m_sock, m_recvDataBuffer.data() + m_readPosition, m_recvDataBuffer.size() - m_readPosition, 0);
+
+            if (ret == SOCKET_ERROR)
+            {
+                if (errno == EAGAIN || errno == EWOULDBLOCK)
+                {
+                    // No more data to read.
+                    break;
+                }
+
+                throw std::runtime_error {"Error reading from socket."};
+            }
+            else if (ret == 0)
+            {
+                // Remote shutdown / disconnect.
+                throw std::runtime_error {"Remote shutdown / disconnect."};
+            }
+
+            m_counters.recvCalls.fetch_add(1, std::memory_order_relaxed);
+            m_readPosition += ret;
+
+            // Parse all the complete frames.
+            uint32_t offset {0};
+            uint64_t frames {0};
+            PacketFieldType packetSize {0};
+            while (m_readPosition - offset >= PACKET_FIELD_SIZE)
+            {
+                std::memcpy(&packetSize, m_recvDataBuffer.data() + offset, PACKET_FIELD_SIZE);
+                if (m_readPosition - offset - PACKET_FIELD_SIZE < packetSize)
+                {
+                    break;
+                }
+
+                const auto* frame = m_recvDataBuffer.data() + offset + PACKET_FIELD_SIZE;
+                const auto headerDataSize = TCommunicationProtocol::getHeaderSize(frame);
+                const auto dataOffset = TCommunicationProtocol::getDataOffset(headerDataSize);
+
+                callback(m_sock,
+                         frame + dataOffset,
+                         packetSize - dataOffset,
+                         frame + TCommunicationProtocol::getHeaderOffset(),
+                         headerDataSize);
+
+                offset += PACKET_FIELD_SIZE + packetSize;
+                ++frames;
+            }
+            m_counters.receivedFrames.fetch_add(frames, std::memory_order_relaxed);
+
+            // Move the incomplete frame to the beginning of the buffer.
+            if (offset > 0)
+            {
+                std::memmove(m_recvDataBuffer.data(), m_recvDataBuffer.data() + offset, m_readPosition - offset);
+                m_readPosition -= offset;
+            }
+
+            // Grow the buffer for a frame bigger than it, and restore it once that frame is consumed.
+            size_t requiredSize {BUFFER_MAX_SIZE};
+            if (m_readPosition >= PACKET_FIELD_SIZE)
+            {
+                std::memcpy(&packetSize, m_recvDataBuffer.data(), PACKET_FIELD_SIZE);
+                requiredSize = std::max<size_t>(requiredSize, PACKET_FIELD_SIZE + packetSize);
+            }
+
+            if (requiredSize > m_recvDataBuffer.size() ||
+                (m_recvDataBuffer.size() > BUFFER_MAX_SIZE && m_readPosition <= BUFFER_MAX_SIZE))
+            {
+                m_recvDataBuffer.resize(requiredSize);
+            }
+        }
+    }
+
+    /**
+     * @brief Skip the bytes already sent from the vectors of a message.
+     *
+     * @param message Message to update.
+     * @param sent    Number of bytes sent.
+     */
+    static void consumeVectors(msghdr& message, size_t sent)
+    {
+        while (sent > 0 && message.msg_iovlen > 0)
+        {
+            auto& vector = message.msg_iov[0];
+
+            if (sent >= vector.iov_len)
+            {
+                sent -= vector.iov_len;
+                ++message.msg_iov;
+                --message.msg_iovlen;
+            }
+            else
+            {
+                vector.iov_base = static_cast<char*>(vector.iov_base) + sent;
+                vector.iov_len -= sent;
+                sent = 0;
+            }
+        }
+    }
+
+    /**
+     * @brief Queue the bytes not sent yet from the vectors of a message, to be sent when the socket is ready.
+     *
+     * @param message Message not sent completely.
+     */
+    void queueUnsentVectors(const msghdr& message)
+    {
+        std::vector<char> unsent;
+        for (size_t i = 0; i < message.msg_iovlen; ++i)
+        {
+            const auto* base = static_cast<const char*>(message.msg_iov[i].iov_base);
+            unsent.insert(unsent.end(), base, base + message.msg_iov[i].iov_len);
+        }
+        m_unsentPacketList.emplace(unsent.data(), unsent.size());
+    }
 };
 
 #endif // _SOCKET_WRAPPER_HPP
@@ -14,10 +14,13 @@
 
 #include <algorithm>
 #include <iomanip>
+#include <iterator>
 #include <memory>
 #include <regex>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 #pragma GCC diagnostic push
@@ -456,6 +459,256 @@ namespace Utils
         return out;
     }
 
+    /**
+     * @brief Iterator over the tokens of a string, viewing the original string. The tokens are the same as the ones
+     * of split().
+     */
+    class SplitIterator final
+    {
+    private:
+        std::string_view m_str;
+        std::string_view m_token;
+        size_t m_next {0};
+        char m_delimiter {'\0'};
+        bool m_end {true};
+
+        void advance()
+        {
+            // A delimiter at the end does not start an empty token, as in std::getline.
+            if (m_next >= m_str.size())
+            {
+                m_end = true;
+                return;
+            }
+
+            const auto pos {m_str.find(m_delimiter, m_next)};
+            const auto end {std::string_view::npos == pos ? m_str.size() : pos};
+            m_token = m_str.substr(m_next, end - m_next);
+            m_next = end + 1;
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::string_view*;
+        using reference = const std::string_view&;
+
+        SplitIterator() = default;
+
+        SplitIterator(const std::string_view str, const char delimiter)
+            : m_str {str}
+            , m_delimiter {delimiter}
+            , m_end {false}
+        {
+            advance();
+        }
+
+        reference operator*() const
+        {
+            return m_token;
+        }
+
+        pointer operator->() const
+        {
+            return &m_token;
+        }
+
+        SplitIterator& operator++()
+        {
+            advance();
+            return *this;
+        }
+
+        SplitIterator operator++(int)
+        {
+            auto ret {*this};
+            advance();
+            return ret;
+        }
+
+        bool operator==(const SplitIterator& other) const
+        {
+            return m_end == other.m_end && (m_end || m_next == other.m_next);
+        }
+
+        bool operator!=(const SplitIterator& other) const
+        {
+            return !(*this == other);
+        }
+    };
+
+    /**
+     * @brief Tokens of a string, split lazily without copying them. The string must outlive the tokens.
+     */
+    class SplitView final
+    {
+    private:
+        std::string_view m_str;
+        char m_delimiter;
+
+    public:
+        SplitView(const std::string_view str, const char delimiter)
+            : m_str {str}
+            , m_delimiter {delimiter}
+        {
+        }
+
+        SplitIterator begin() const
+        {
+            return SplitIterator {m_str, m_delimiter};
+        }
+
+        SplitIterator end() const
+        {
+            return SplitIterator {};
+        }
+    };
+
+    /**
+     * @brief Split a string without allocating the tokens.
+     *
+     * @param str Original string.
+     * @param delimiter Delimiter of the tokens.
+     * @return SplitView Range of the tokens, as std::string_view.
+     */
+    static SplitView splitView(const std::string_view str, const char delimiter)
+    {
+        return SplitView {str, delimiter};
+    }
+
+    /**
+     * @brief Lower case of an ASCII character, other characters are returned unchanged regardless of the locale.
+     */
+    static constexpr char asciiToLower(const char character)
+    {
+        return character >= 'A' && character <= 'Z' ? static_cast<char>(character - 'A' + 'a') : character;
+    }
+
+    /**
+     * @brief Upper case of an ASCII character, other characters are returned unchanged regardless of the locale.
+     */
+    static constexpr char asciiToUpper(const char character)
+    {
+        return character >= 'a' && character <= 'z' ? static_cast<char>(character - 'a' + 'A') : character;
+    }
+
+    /**
+     * @brief Convert the ASCII characters of a string to lower case, without copying it.
+     *
+     * @param str String to convert.
+     */
+    static void toLowerCaseInPlace(std::string& str)
+    {
+        for (auto& character : str)
+        {
+            character = asciiToLower(character);
+        }
+    }
+
+    /**
+     * @brief Convert the ASCII characters of a string to upper case, without copying it.
+     *
+     * @param str String to convert.
+     */
+    static void toUpperCaseInPlace(std::string& str)
+    {
+        for (auto& character : str)
+        {
+            character = asciiToUpper(character);
+        }
+    }
+
+    /**
+     * @brief Compare two strings ignoring the case of the ASCII characters.
+     *
+     * @param lhs First string.
+     * @param rhs Second string.
+     * @return true if both strings are equal.
+     */
+    static bool equalsIgnoreCase(const std::string_view lhs, const std::string_view rhs)
+    {
+        return lhs.size() == rhs.size() &&
+               std::equal(lhs.begin(),
+                          lhs.end(),
+                          rhs.begin(),
+                          [](const char left, const char right) { return asciiToLower(left) == asciiToLower(right); });
+    }
+
+    /**
+     * @brief Check whether a string starts with another one, ignoring the case of the ASCII characters.
+     *
+     * @param str Original string.
+     * @param start Prefix.
+     * @return true if the string starts with the prefix.
+     */
+    static bool startsWithIgnoreCase(const std::string_view str, const std::string_view start)
+    {
+        return str.size() >= start.size() && equalsIgnoreCase(str.substr(0, start.size()), start);
+    }
+
+    /**
+     * @brief Replace all the occurrences of several strings in a single pass. Unlike chained calls to replaceAll(),
+     * the replaced text is never searched again. When several strings match at the same position, the first one in
+     * the list is replaced.
+     *
+     * @param data String to modify.
+     * @param replacements Pairs of the string to search and its replacement. Empty strings to search are ignored.
+     * @return true if any string was replaced.
+     */
+    static bool replaceAll(std::string& data,
+                           const std::vector<std::pair<std::string_view, std::string_view>>& replacements)
+    {
+        // Next occurrence of each string to search.
+        std::vector<size_t> positions;
+        positions.reserve(replacements.size());
+
+        for (const auto& [toSearch, toReplace] : replacements)
+        {
+            positions.push_back(toSearch.empty() ? std::string::npos : data.find(toSearch));
+        }
+
+        std::string result;
+        size_t current {0};
+
+        while (true)
+        {
+            const auto next {std::min_element(positions.begin(), positions.end())};
+
+            if (next == positions.end() || std::string::npos == *next)
+            {
+                break;
+            }
+
+            const auto& [toSearch, toReplace] {replacements.at(std::distance(positions.begin(), next))};
+
+            if (result.empty())
+            {
+                result.reserve(data.size());
+            }
+            result.append(data, current, *next - current).append(toReplace);
+            current = *next + toSearch.size();
+
+            // The occurrences overlapping the replaced text are searched again after it.
+            for (size_t i = 0; i < positions.size(); ++i)
+            {
+                if (std::string::npos != positions[i] && positions[i] < current)
+                {
+                    positions[i] = data.find(replacements[i].first, current);
+                }
+            }
+        }
+
+        if (0 == current)
+        {
+            return false;
+        }
+
+        result.append(data, current, std::string::npos);
+        data = std::move(result);
+        return true;
+    }
+
 } // namespace Utils
 
 #pragma GCC diagnostic pop
@@ -11,6 +11,9 @@
 
 #include "cacheLRU_test.h"
 #include "cacheLRU.hpp"
+#include <string>
+#include <thread>
+#include <vector>
 
 void CacheLRUTest::SetUp() {};
 
@@ -33,3 +36,155 @@ TEST_F(CacheLRUTest, insertAndMiss)
 
     EXPECT_FALSE(result.has_value());
 }
+
+TEST_F(CacheLRUTest, shardedInsertAndHit)
+{
+    auto cacheMemory = ShardedLRUCache<int, int>(10);
+
+    EXPECT_NO_THROW(cacheMemory.insertKey(1, 10));
+    EXPECT_TRUE(cacheMemory.isHit(1));
+    EXPECT_EQ(cacheMemory.getValue(1).value(), 10);
+    EXPECT_FALSE(cacheMemory.getValue(2).has_value());
+
+    const auto stats = cacheMemory.stats();
+    EXPECT_EQ(stats.hits, 1);
+    EXPECT_EQ(stats.misses, 1);
+    EXPECT_EQ(stats.evictions, 0);
+}
+
+TEST_F(CacheLRUTest, shardedReplaceValue)
+{
+    auto cacheMemory = ShardedLRUCache<int, int, 1>(2);
+
+    cacheMemory.insertKey(1, 10);
+    cacheMemory.insertKey(1, 20);
+
+    EXPECT_EQ(cacheMemory.size(), 1);
+    EXPECT_EQ(cacheMemory.getValue(1).value(), 20);
+}
+
+TEST_F(CacheLRUTest, shardedEvictsNotReferenced)
+{
+    auto cacheMemory = ShardedLRUCache<int, int, 1>(3);
+
+    cacheMemory.insertKey(1, 10);
+    cacheMemory.insertKey(2, 20);
+    cacheMemory.insertKey(3, 30);
+    EXPECT_TRUE(cacheMemory.isFull());
+
+    // The referenced key gets a second chance, the oldest not referenced one is evicted.
+    EXPECT_TRUE(cacheMemory.getValue(1).has_value());
+    cacheMemory.insertKey(4, 40);
+
+    EXPECT_TRUE(cacheMemory.isHit(1));
+    EXPECT_FALSE(cacheMemory.isHit(2));
+    EXPECT_TRUE(cacheMemory.isHit(3));
+    EXPECT_TRUE(cacheMemory.isHit(4));
+    EXPECT_EQ(cacheMemory.size(), 3);
+    EXPECT_EQ(cacheMemory.stats().evictions, 1);
+}
+
+TEST_F(CacheLRUTest, shardedCapacityIsShared)
+{
+    auto cacheMemory = ShardedLRUCache<int, int, 4>(10);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        cacheMemory.insertKey(i, i);
+    }
+
+    EXPECT_TRUE(cacheMemory.isFull());
+    EXPECT_EQ(cacheMemory.size(), 10);
+    EXPECT_EQ(cacheMemory.stats().evictions, 90);
+
+    auto count = 0;
+    cacheMemory.forEach(
+        [&count](const int& key, const int& value)
+        {
+            EXPECT_EQ(key, value);
+            ++count;
+            return true;
+        });
+    EXPECT_EQ(count, 10);
+}
+
+TEST_F(CacheLRUTest, shardedForEachStops)
+{
+    auto cacheMemory = ShardedLRUCache<int, int>(10);
+
+    for (int i = 0; i < 10; ++i)
+    {
+        cacheMemory.insertKey(i, i);
+    }
+
+    auto count = 0;
+    cacheMemory.forEach(
+        [&count](const int&, const int&)
+        {
+            ++count;
+            return false;
+        });
+    EXPECT_EQ(count, 1);
+}
+
+TEST_F(CacheLRUTest, shardedClear)
+{
+    auto cacheMemory = ShardedLRUCache<std::string, std::string>(4);
+
+    cacheMemory.insertKey("key1", "value1");
+    cacheMemory.insertKey("key2", "value2");
+    cacheMemory.clear();
+
+    EXPECT_EQ(cacheMemory.size(), 0);
+    EXPECT_FALSE(cacheMemory.isHit("key1"));
+    EXPECT_FALSE(cacheMemory.getValue("key2").has_value());
+
+    cacheMemory.insertKey("key3", "value3");
+    EXPECT_EQ(cacheMemory.getValue("key3").value(), "value3");
+}
+
+TEST_F(CacheLRUTest, shardedZeroCapacity)
+{
+    auto cacheMemory = ShardedLRUCache<int, int>(0);
+
+    EXPECT_NO_THROW(cacheMemory.insertKey(1, 10));
+    EXPECT_FALSE(cacheMemory.getValue(1).has_value());
+    EXPECT_EQ(cacheMemory.size(), 0);
+}
+
+TEST_F(CacheLRUTest, shardedConcurrentAccess)
+{
+    constexpr auto THREADS {8};
+    constexpr auto KEYS {1000};
+    auto cacheMemory = ShardedLRUCache<int, int>(KEYS / 2);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t)
+    {
+        threads.emplace_back(
+            [&cacheMemory, t]()
+            {
+                for (int i = 0; i < KEYS; ++i)
+                {
+                    const auto key = (i * (t + 1)) % KEYS;
+                    if (const auto value = cacheMemory.getValue(key); value.has_value())
+                    {
+                        EXPECT_EQ(*value, key * 2);
+                    }
+                    else
+                    {
+                        cacheMemory.insertKey(key, key * 2);
+                    }
+                }
+            });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    const auto stats = cacheMemory.stats();
+    EXPECT_EQ(stats.hits + stats.misses, THREADS * KEYS);
+    EXPECT_LE(cacheMemory.size(), KEYS / 2);
+}
@@ -0,0 +1,118 @@
+/*
+ * Wazuh - Shared Modules utils tests
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "chunkedInputStream_test.hpp"
+#include "chunkedInputStream.hpp"
+#include <atomic>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+/**
+ * @brief Test that the chunks pushed by the producer are read in order.
+ *
+ */
+TEST_F(ChunkedInputStreamTest, ReadAllChunks)
+{
+    std::string expected;
+    Utils::ChunkedInputStream stream(
+        [](const Utils::ChunkedInputStream::PushFunction& push)
+        {
+            for (auto i = 0; i < 100; ++i)
+            {
+                const auto line {"line " + std::to_string(i) + "\n"};
+                push(line.data(), line.size());
+            }
+        },
+        2);
+
+    for (auto i = 0; i < 100; ++i)
+    {
+        expected += "line " + std::to_string(i) + "\n";
+    }
+
+    const std::string data {std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+    EXPECT_EQ(expected, data);
+}
+
+/**
+ * @brief Test that the lines are read across chunk boundaries.
+ *
+ */
+TEST_F(ChunkedInputStreamTest, GetLineAcrossChunks)
+{
+    Utils::ChunkedInputStream stream(
+        [](const Utils::ChunkedInputStream::PushFunction& push)
+        {
+            push("fir", 3);
+            push("", 0);
+            push("st\nsec", 6);
+            push("ond\n", 4);
+        });
+
+    std::string line;
+    ASSERT_TRUE(std::getline(stream, line));
+    EXPECT_EQ("first", line);
+    ASSERT_TRUE(std::getline(stream, line));
+    EXPECT_EQ("second", line);
+    EXPECT_FALSE(std::getline(stream, line));
+}
+
+/**
+ * @brief Test that a producer error is rethrown to the reader.
+ *
+ */
+TEST_F(ChunkedInputStreamTest, ProducerErrorIsRethrown)
+{
+    Utils::ChunkedInputStream stream(
+        [](const Utils::ChunkedInputStream::PushFunction& push)
+        {
+            push("data\n", 5);
+            throw std::runtime_error("Producer error");
+        });
+
+    std::string line;
+    ASSERT_TRUE(std::getline(stream, line));
+    EXPECT_EQ("data", line);
+    EXPECT_THROW(std::getline(stream, line), std::runtime_error);
+}
+
+/**
+ * @brief Test that a blocked producer is released when the reader leaves early.
+ *
+ */
+TEST_F(ChunkedInputStreamTest, ReaderLeavesEarly)
+{
+    std::atomic<bool> producerStopped {false};
+    {
+        Utils::ChunkedInputStream stream(
+            [&producerStopped](const Utils::ChunkedInputStream::PushFunction& push)
+            {
+                try
+                {
+                    while (true)
+                    {
+                        push("data\n", 5);
+                    }
+                }
+                catch (const std::runtime_error&)
+                {
+                    producerStopped = true;
+                    throw;
+                }
+            },
+            1);
+
+        std::string line;
+        ASSERT_TRUE(std::getline(stream, line));
+    }
+    EXPECT_TRUE(producerStopped);
+}
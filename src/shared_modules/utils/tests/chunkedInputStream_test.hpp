@@ -0,0 +1,28 @@
+/*
+ * Wazuh - Shared Modules utils tests
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _CHUNKED_INPUT_STREAM_TEST_HPP
+#define _CHUNKED_INPUT_STREAM_TEST_HPP
+
+#include "gtest/gtest.h"
+
+/**
+ * @brief Tests for the ChunkedInputStream class.
+ *
+ */
+class ChunkedInputStreamTest : public ::testing::Test
+{
+protected:
+    ChunkedInputStreamTest() = default;
+    ~ChunkedInputStreamTest() override = default;
+};
+
+#endif // _CHUNKED_INPUT_STREAM_TEST_HPP
@@ -15,6 +15,7 @@
 #include "jsonArrayParser.hpp"
 #include "gtest/gtest.h"
 #include <queue>
+#include <sstream>
 
 /**
  * @brief Parse an array with simple objects
@@ -462,6 +463,40 @@ TEST_F(JsonArrayParserTest, TopLevelArray)
     EXPECT_TRUE(expectedItems.empty());
 }
 
+/**
+ * @brief Parse a top level array read from a stream.
+ *
+ */
+TEST_F(JsonArrayParserTest, TopLevelArrayFromStream)
+{
+    // Setup the input data
+    std::istringstream testData {R"(
+    [
+        {"cve":"CVE-2005-AAAA"},
+        {"cve":"CVE-2008-AAAA"}
+    ]
+    )"};
+
+    // Set the expected items
+    std::queue<nlohmann::json> expectedItems;
+    expectedItems.push(R"({"cve":"CVE-2005-AAAA"})"_json);
+    expectedItems.push(R"({"cve":"CVE-2008-AAAA"})"_json);
+
+    // This callback will validate the extracted items
+    auto callback = [&](nlohmann::json&& item, const size_t /*itemId*/)
+    {
+        EXPECT_EQ(expectedItems.front(), item);
+        expectedItems.pop();
+        return true;
+    };
+
+    // Parse the JSON array
+    ASSERT_NO_THROW(JsonArray::parse(testData, callback));
+
+    // At the end of the processing the expected queue must be empty
+    EXPECT_TRUE(expectedItems.empty());
+}
+
 /**
  * @brief Parse an array that is located on a deeper level.
  *
@@ -687,3 +722,176 @@ TEST_F(JsonArrayParserTest, InexistentFile)
     // Start the parse and expect an exception
     ASSERT_THROW(JsonArray::parse(testFilepath, callback, testArrayPointer), std::runtime_error);
 }
+
+/**
+ * @brief Scan an array with items of different types and strings with special characters.
+ *
+ */
+TEST_F(JsonArrayParserTest, ScanArrayItems)
+{
+    // Setup the input data
+    const auto testData {R"(
+    {"some_key": "[\"not the array\"]",
+     "cves_array":
+            [
+                {"cve": "CVE-2005-AAAA", "refs": ["a", "b"]},
+                "text with ] , [ and \" inside",
+                -1.5e3 ,
+                [1, {"nested": [2]}],
+                null
+            ],
+     "other": {}
+    }
+    )"};
+    const auto testArrayPointer {"/cves_array"_json_pointer};
+    const auto testFilepath {m_testFolder / "ScanArrayItems.json"};
+    createTestFile(testData, testFilepath);
+
+    // Set the expected items
+    std::queue<std::string> expectedItems;
+    expectedItems.push(R"({"cve": "CVE-2005-AAAA", "refs": ["a", "b"]})");
+    expectedItems.push(R"("text with ] , [ and \" inside")");
+    expectedItems.push("-1.5e3");
+    expectedItems.push(R"([1, {"nested": [2]}])");
+    expectedItems.push("null");
+
+    size_t currentId {1};
+    auto callback = [&](std::string_view item, const size_t itemId)
+    {
+        EXPECT_EQ(expectedItems.front(), item);
+        EXPECT_EQ(itemId, currentId++);
+        expectedItems.pop();
+        return true;
+    };
+
+    ASSERT_NO_THROW(JsonArray::scan(testFilepath, callback, testArrayPointer));
+
+    // At the end of the processing the expected queue must be empty
+    EXPECT_TRUE(expectedItems.empty());
+}
+
+/**
+ * @brief Scan an array that is located on a deeper level.
+ *
+ */
+TEST_F(JsonArrayParserTest, ScanComplexJsonPointer)
+{
+    // Setup the input data
+    const auto testData {R"(
+        {
+        "one_array":
+            [
+                {"cves_array": ["wrong"]},
+                {"cves_array":
+                    [
+                        {"cve": "CVE-2005-AAAA"},
+                        {"cve": "CVE-2008-AAAA"}
+                    ]
+                }
+            ]
+        }
+    )"};
+    const auto testArrayPointer {"/one_array/1/cves_array"_json_pointer};
+    const auto testFilepath {m_testFolder / "ScanComplexJsonPointer.json"};
+    createTestFile(testData, testFilepath);
+
+    std::vector<nlohmann::json> items;
+    auto callback = [&items](std::string_view item, const size_t /*itemId*/)
+    {
+        items.push_back(nlohmann::json::parse(item));
+        return true;
+    };
+
+    ASSERT_NO_THROW(JsonArray::scan(testFilepath, callback, testArrayPointer));
+
+    ASSERT_EQ(items.size(), 2);
+    EXPECT_EQ(items.at(0), R"({"cve":"CVE-2005-AAAA"})"_json);
+    EXPECT_EQ(items.at(1), R"({"cve":"CVE-2008-AAAA"})"_json);
+}
+
+/**
+ * @brief Scan a top level array whose items don't fit in a single read block.
+ *
+ */
+TEST_F(JsonArrayParserTest, ScanTopLevelArrayWithLargeItems)
+{
+    constexpr auto ITEMS_COUNT {20};
+    std::vector<nlohmann::json> expectedItems;
+    auto input = nlohmann::json::array();
+    for (auto i {0}; i < ITEMS_COUNT; ++i)
+    {
+        auto item = nlohmann::json::object();
+        item["id"] = i;
+        item["description"] = std::string(10000 * (i + 1), 'a' + i);
+        expectedItems.push_back(item);
+        input.push_back(std::move(item));
+    }
+    std::stringstream stream {input.dump(4)};
+
+    size_t itemsCount {0};
+    auto callback = [&](std::string_view item, const size_t itemId)
+    {
+        EXPECT_EQ(expectedItems.at(itemsCount), nlohmann::json::parse(item));
+        EXPECT_EQ(itemId, ++itemsCount);
+        return true;
+    };
+
+    ASSERT_NO_THROW(JsonArray::scan(stream, callback));
+    EXPECT_EQ(itemsCount, ITEMS_COUNT);
+}
+
+/**
+ * @brief Stop the scan when the callback returns false.
+ *
+ */
+TEST_F(JsonArrayParserTest, StopScan)
+{
+    std::stringstream stream {R"({"test_array": [1, 2, 3, 4, 5]})"};
+
+    std::vector<std::string> items;
+    auto callback = [&items](std::string_view item, const size_t itemId)
+    {
+        items.emplace_back(item);
+        return itemId < 2;
+    };
+
+    ASSERT_NO_THROW(JsonArray::scan(stream, callback, "/test_array"_json_pointer));
+    EXPECT_EQ(items, std::vector<std::string>({"1", "2"}));
+}
+
+/**
+ * @brief Scan an empty array.
+ *
+ */
+TEST_F(JsonArrayParserTest, ScanEmptyArray)
+{
+    std::stringstream stream {R"({"test_array": [ ]})"};
+
+    auto callbackCount {0};
+    auto callback = [&callbackCount](std::string_view /*item*/, const size_t /*itemId*/)
+    {
+        ++callbackCount;
+        return true;
+    };
+
+    ASSERT_NO_THROW(JsonArray::scan(stream, callback, "/test_array"_json_pointer));
+    EXPECT_EQ(callbackCount, 0);
+}
+
+/**
+ * @brief The target array doesn't exist or the document is truncated. Expect exception.
+ *
+ */
+TEST_F(JsonArrayParserTest, ScanArrayIsNotFound)
+{
+    auto callback = [](std::string_view /*item*/, const size_t /*itemId*/)
+    {
+        return true;
+    };
+
+    std::stringstream notFound {R"({"other_array": [1, 2], "key": {"test_array": [3]}})"};
+    EXPECT_THROW(JsonArray::scan(notFound, callback, "/test_array"_json_pointer), std::runtime_error);
+
+    std::stringstream truncated {R"({"test_array": [1, 2)"};
+    EXPECT_THROW(JsonArray::scan(truncated, callback, "/test_array"_json_pointer), std::runtime_error);
+}
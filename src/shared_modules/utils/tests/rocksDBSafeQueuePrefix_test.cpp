@@ -184,3 +184,25 @@ TEST_F(RocksDBSafeQueuePrefixTest, ClearAllQueue)
     EXPECT_EQ(0, queue->size("001"));
     EXPECT_TRUE(queue->empty());
 }
+
+TEST_F(RocksDBSafeQueuePrefixTest, PushAndPopBulk)
+{
+    queue->push("000", "single");
+    queue->pushBulk("000", {"bulk1", "bulk2", "bulk3"});
+    queue->pushBulk("001", {"other"});
+    EXPECT_EQ(4, queue->size("000"));
+    EXPECT_EQ(1, queue->size("001"));
+
+    EXPECT_NO_THROW(queue->popBulk("000", 2));
+    EXPECT_EQ(2, queue->size("000"));
+    EXPECT_EQ(1, queue->size("001"));
+
+    // Popping more than the queue holds only empties it.
+    EXPECT_NO_THROW(queue->popBulk("000", 10));
+    EXPECT_EQ(0, queue->size("000"));
+    EXPECT_ANY_THROW(queue->popBulk("000", 1));
+
+    const auto front {queue->front()};
+    EXPECT_STREQ("001", front.second.c_str());
+    EXPECT_STREQ("other", front.first.c_str());
+}
@@ -157,3 +157,159 @@ TEST_F(RocksDBSafeQueueTest, CreateFolderRecursively)
     std::error_code ec;
     std::filesystem::remove_all(DATABASE_NAME, ec);
 }
+
+TEST_F(RocksDBSafeQueueTest, RecoverAfterReopen)
+{
+    const std::string DATABASE_NAME {"recovery.db"};
+    std::error_code ec;
+    std::filesystem::remove_all(DATABASE_NAME, ec);
+
+    {
+        RocksDBQueue<std::string> rocksDBQueue(DATABASE_NAME);
+        for (int i = 0; i < 10; i++)
+        {
+            rocksDBQueue.push(std::to_string(i));
+        }
+        rocksDBQueue.pop();
+        rocksDBQueue.pop();
+    }
+
+    {
+        RocksDBQueue<std::string> rocksDBQueue(DATABASE_NAME);
+        EXPECT_EQ(8, rocksDBQueue.size());
+        EXPECT_EQ("2", rocksDBQueue.front());
+        EXPECT_EQ("9", rocksDBQueue.at(7));
+
+        rocksDBQueue.push("10");
+        while (rocksDBQueue.size() > 1)
+        {
+            rocksDBQueue.pop();
+        }
+        EXPECT_EQ("10", rocksDBQueue.front());
+        rocksDBQueue.pop();
+    }
+
+    {
+        RocksDBQueue<std::string> rocksDBQueue(DATABASE_NAME);
+        EXPECT_TRUE(rocksDBQueue.empty());
+        rocksDBQueue.push("first");
+        EXPECT_EQ("first", rocksDBQueue.front());
+    }
+
+    std::filesystem::remove_all(DATABASE_NAME, ec);
+}
+
+TEST_F(RocksDBSafeQueueTest, RecoverWithCorruptedMetadata)
+{
+    const std::string DATABASE_NAME {"corrupted.db"};
+    std::error_code ec;
+    std::filesystem::remove_all(DATABASE_NAME, ec);
+
+    {
+        RocksDBQueue<std::string> rocksDBQueue(DATABASE_NAME);
+        for (int i = 0; i < 5; i++)
+        {
+            rocksDBQueue.push(std::to_string(i));
+        }
+    }
+
+    // Metadata not matching the elements, the queue is recovered by reading them all.
+    {
+        rocksdb::DB* db;
+        rocksdb::Options options;
+        ASSERT_TRUE(rocksdb::DB::Open(options, DATABASE_NAME, &db).ok());
+        ASSERT_TRUE(db->Put(rocksdb::WriteOptions(), "queue_metadata", "1:2:2").ok());
+        delete db;
+    }
+
+    {
+        RocksDBQueue<std::string> rocksDBQueue(DATABASE_NAME);
+        EXPECT_EQ(5, rocksDBQueue.size());
+        EXPECT_EQ("0", rocksDBQueue.front());
+        EXPECT_EQ("4", rocksDBQueue.at(4));
+    }
+
+    std::filesystem::remove_all(DATABASE_NAME, ec);
+}
+
+TEST_F(RocksDBSafeQueueTest, PushAndPopBulk)
+{
+    queue->push("single");
+    queue->pushBulk({"bulk1", "bulk2", "bulk3"});
+    EXPECT_EQ(4, queue->size());
+
+    queue->popBulk(2);
+    EXPECT_EQ(2, queue->size());
+
+    auto bulk {queue->getBulk(2)};
+    ASSERT_EQ(2, bulk.size());
+    EXPECT_EQ("bulk2", bulk.front());
+    bulk.pop();
+    EXPECT_EQ("bulk3", bulk.front());
+
+    // Popping more than the queue holds only empties it.
+    queue->popBulk(10);
+    EXPECT_TRUE(queue->empty());
+
+    queue->pushBulk({"after"});
+    std::string ret_val {};
+    EXPECT_TRUE(queue->pop(ret_val, false));
+    EXPECT_EQ("after", ret_val);
+}
+
+TEST_F(RocksDBSafeQueueTest, GetBulkIntoVector)
+{
+    for (int i = 0; i < 15; i++)
+    {
+        queue->push(std::to_string(i));
+    }
+    queue->popBulk(5);
+
+    // The keys 9 and 10 are not in order for an iterator.
+    std::vector<std::string> values;
+    queue->getBulk(values, 8, std::chrono::seconds(0));
+    ASSERT_EQ(8, values.size());
+    for (int i = 0; i < 8; i++)
+    {
+        EXPECT_EQ(std::to_string(i + 5), values[i]);
+    }
+    EXPECT_EQ(10, queue->size());
+
+    // Less elements than requested, the buffer is reused.
+    queue->popBulk(8);
+    queue->getBulk(values, 8, std::chrono::seconds(0));
+    ASSERT_EQ(2, values.size());
+    EXPECT_EQ("13", values[0]);
+    EXPECT_EQ("14", values[1]);
+
+    queue->cancel();
+    queue->getBulk(values, 8, std::chrono::seconds(0));
+    EXPECT_TRUE(values.empty());
+}
+
+TEST_F(RocksDBSafeQueueTest, GetBulkPinnedSlices)
+{
+    const std::string DATABASE_NAME {"pinned.db"};
+    std::error_code ec;
+    std::filesystem::remove_all(DATABASE_NAME, ec);
+
+    {
+        Utils::TSafeQueue<rocksdb::Slice, rocksdb::PinnableSlice, RocksDBQueue<rocksdb::Slice, rocksdb::PinnableSlice>>
+            pinnedQueue(RocksDBQueue<rocksdb::Slice, rocksdb::PinnableSlice>(DATABASE_NAME));
+        for (int i = 0; i < 12; i++)
+        {
+            const auto value {std::to_string(i)};
+            pinnedQueue.push(value);
+        }
+
+        std::vector<rocksdb::PinnableSlice> values;
+        pinnedQueue.getBulk(values, 12, std::chrono::seconds(0));
+        ASSERT_EQ(12, values.size());
+        for (int i = 0; i < 12; i++)
+        {
+            EXPECT_EQ(std::to_string(i), values[i].ToString());
+        }
+    }
+
+    std::filesystem::remove_all(DATABASE_NAME, ec);
+}
@@ -10,6 +10,8 @@
  */
 
 #include "rocksDBWrapper_test.hpp"
+#include <shared_mutex>
+#include <thread>
 
 /**
  * @brief Tests the put function
@@ -579,3 +581,382 @@ TEST_F(RocksDBWrapperTest, GetAllColumnFamiliesTest)
     EXPECT_EQ(columnFamilies[2], COLUMN_NAME_B);
     EXPECT_EQ(columnFamilies[3], COLUMN_NAME_C);
 }
+
+/**
+ * @brief Test put, get and delete through a column handle.
+ *
+ */
+TEST_F(RocksDBWrapperTest, PutGetAndDeleteWithColumnHandle)
+{
+    constexpr auto COLUMN_NAME {"column_A"};
+    constexpr auto KEY {"key_A"};
+    constexpr auto VALUE {"value_A"};
+    std::string readValue;
+    rocksdb::PinnableSlice readSlice;
+
+    db_wrapper->createColumn(COLUMN_NAME);
+    const auto column {db_wrapper->column(COLUMN_NAME)};
+    EXPECT_TRUE(column.exists());
+    EXPECT_EQ(column.name(), COLUMN_NAME);
+
+    ASSERT_NO_THROW(db_wrapper->put(KEY, VALUE, column));
+    ASSERT_TRUE(db_wrapper->get(KEY, readValue, column));
+    EXPECT_EQ(readValue, VALUE);
+    ASSERT_TRUE(db_wrapper->get(KEY, readSlice, column, Utils::RocksDBOptions::buildReadMostlyOptions()));
+    EXPECT_EQ(readSlice, VALUE);
+
+    // The handle and the name access the same column.
+    readValue.clear();
+    ASSERT_TRUE(db_wrapper->get(KEY, readValue, COLUMN_NAME));
+    EXPECT_EQ(readValue, VALUE);
+
+    ASSERT_NO_THROW(db_wrapper->delete_(KEY, column));
+    EXPECT_FALSE(db_wrapper->get(KEY, readValue, column));
+}
+
+/**
+ * @brief Test the handle of the default column.
+ *
+ */
+TEST_F(RocksDBWrapperTest, DefaultColumnHandle)
+{
+    std::string readValue;
+
+    const auto column {db_wrapper->column()};
+    EXPECT_EQ(column.name(), rocksdb::kDefaultColumnFamilyName);
+
+    db_wrapper->put("key1", "value1");
+    ASSERT_TRUE(db_wrapper->get("key1", readValue, column));
+    EXPECT_EQ(readValue, "value1");
+}
+
+/**
+ * @brief Test seek and iteration through a column handle.
+ *
+ */
+TEST_F(RocksDBWrapperTest, SeekAndBeginWithColumnHandle)
+{
+    constexpr auto COLUMN_NAME {"column_A"};
+
+    db_wrapper->createColumn(COLUMN_NAME);
+    const auto column {db_wrapper->column(COLUMN_NAME)};
+    db_wrapper->put("prefix_1", "value1", column);
+    db_wrapper->put("prefix_2", "value2", column);
+    db_wrapper->put("other_1", "value3", column);
+
+    auto count {0};
+    for (const auto& [key, value] : db_wrapper->seek("prefix_", column))
+    {
+        EXPECT_EQ(key.rfind("prefix_", 0), 0);
+        ++count;
+    }
+    EXPECT_EQ(count, 2);
+
+    count = 0;
+    for ([[maybe_unused]] const auto& [key, value] :
+         db_wrapper->begin(column, Utils::RocksDBOptions::buildScanOptions()))
+    {
+        ++count;
+    }
+    EXPECT_EQ(count, 3);
+}
+
+/**
+ * @brief Test the iteration of several prefixes with the same iterator.
+ *
+ */
+TEST_F(RocksDBWrapperTest, SeekReusingIteratorWithPrefix)
+{
+    db_wrapper->put("a_1", "value1");
+    db_wrapper->put("a_2", "value2");
+    db_wrapper->put("b_1", "value3");
+    db_wrapper->put("c_1", "value4");
+
+    std::vector<std::string> keys;
+    auto it {db_wrapper->seek("")};
+    for (const std::string_view prefix : {"a_", "c_", "d_"})
+    {
+        for (const auto& [key, value] : it.prefix(prefix))
+        {
+            keys.push_back(key);
+        }
+    }
+
+    EXPECT_EQ(keys, (std::vector<std::string> {"a_1", "a_2", "c_1"}));
+}
+
+/**
+ * @brief Test that a handle obtained before the column is created becomes valid once it is.
+ *
+ */
+TEST_F(RocksDBWrapperTest, ColumnHandleBeforeCreation)
+{
+    constexpr auto COLUMN_NAME {"column_A"};
+    std::string readValue;
+
+    const auto column {db_wrapper->column(COLUMN_NAME)};
+    EXPECT_FALSE(column.exists());
+    EXPECT_THROW(db_wrapper->put("key1", "value1", column), std::runtime_error);
+    EXPECT_THROW(db_wrapper->get("key1", readValue, column), std::runtime_error);
+
+    db_wrapper->createColumn(COLUMN_NAME);
+    EXPECT_TRUE(column.exists());
+    ASSERT_NO_THROW(db_wrapper->put("key1", "value1", column));
+    ASSERT_TRUE(db_wrapper->get("key1", readValue, column));
+    EXPECT_EQ(readValue, "value1");
+}
+
+/**
+ * @brief Test that a handle follows its column when deleteAll drops and creates it again.
+ *
+ */
+TEST_F(RocksDBWrapperTest, ColumnHandleAfterDeleteAll)
+{
+    constexpr auto COLUMN_NAME {"column_A"};
+    std::string readValue;
+
+    db_wrapper->createColumn(COLUMN_NAME);
+    const auto column {db_wrapper->column(COLUMN_NAME)};
+    db_wrapper->put("key1", "value1", column);
+
+    db_wrapper->deleteAll();
+    EXPECT_TRUE(column.exists());
+    EXPECT_FALSE(db_wrapper->get("key1", readValue, column));
+
+    db_wrapper->put("key2", "value2", column);
+    db_wrapper->deleteAll(COLUMN_NAME);
+    EXPECT_TRUE(column.exists());
+    EXPECT_FALSE(db_wrapper->get("key2", readValue, column));
+
+    ASSERT_NO_THROW(db_wrapper->put("key3", "value3", column));
+    ASSERT_TRUE(db_wrapper->get("key3", readValue, COLUMN_NAME));
+    EXPECT_EQ(readValue, "value3");
+}
+
+/**
+ * @brief Test getting multiple keys in a single call.
+ *
+ */
+TEST_F(RocksDBWrapperTest, MultiGet)
+{
+    constexpr auto COLUMN_NAME {"column_A"};
+    std::vector<rocksdb::PinnableSlice> values;
+
+    db_wrapper->createColumn(COLUMN_NAME);
+    db_wrapper->put("key1", "value1", COLUMN_NAME);
+    db_wrapper->put("key3", "value3", COLUMN_NAME);
+
+    const auto found {db_wrapper->multiGet({"key1", "key2", "key3"}, values, COLUMN_NAME)};
+    ASSERT_EQ(found.size(), 3);
+    ASSERT_EQ(values.size(), 3);
+    EXPECT_TRUE(found[0]);
+    EXPECT_EQ(values[0], "value1");
+    EXPECT_FALSE(found[1]);
+    EXPECT_TRUE(values[1].empty());
+    EXPECT_TRUE(found[2]);
+    EXPECT_EQ(values[2], "value3");
+
+    // The values are replaced on each call.
+    const auto column {db_wrapper->column(COLUMN_NAME)};
+    const auto foundAgain {
+        db_wrapper->multiGet({"key3"}, values, column, Utils::RocksDBOptions::buildReadMostlyOptions())};
+    ASSERT_EQ(foundAgain.size(), 1);
+    ASSERT_EQ(values.size(), 1);
+    EXPECT_TRUE(foundAgain[0]);
+    EXPECT_EQ(values[0], "value3");
+}
+
+/**
+ * @brief Test getting multiple keys with no keys and with an empty key.
+ *
+ */
+TEST_F(RocksDBWrapperTest, MultiGetEmptyKeys)
+{
+    std::vector<rocksdb::PinnableSlice> values;
+
+    EXPECT_TRUE(db_wrapper->multiGet({}, values).empty());
+    EXPECT_TRUE(values.empty());
+    EXPECT_THROW(db_wrapper->multiGet({"key1", ""}, values), std::invalid_argument);
+}
+
+/**
+ * @brief Test getting multiple keys from an inexistent column.
+ *
+ */
+TEST_F(RocksDBWrapperTest, MultiGetFromInexistentColumnThrows)
+{
+    std::vector<rocksdb::PinnableSlice> values;
+
+    EXPECT_THROW(db_wrapper->multiGet({"key1"}, values, "inexistent"), std::runtime_error);
+}
+
+/**
+ * @brief Test that the writes of a batch are only visible once it's committed.
+ *
+ */
+TEST_F(RocksDBWrapperTest, WriteBatchCommit)
+{
+    constexpr auto COLUMN_NAME {"column_A"};
+    std::shared_mutex columnsMutex;
+    std::string readValue;
+
+    db_wrapper->put("key2", "value2");
+
+    Utils::RocksDBWriteBatch batch {db_wrapper.get(), columnsMutex};
+    EXPECT_TRUE(batch.empty());
+    ASSERT_NO_THROW(batch.createColumn(COLUMN_NAME));
+    ASSERT_NO_THROW(batch.createColumn(COLUMN_NAME));
+    EXPECT_TRUE(batch.columnExists(COLUMN_NAME));
+
+    batch.put("key1", "value1", COLUMN_NAME);
+    batch.delete_("key2");
+    EXPECT_FALSE(batch.empty());
+    EXPECT_GT(batch.size(), 0);
+    EXPECT_FALSE(db_wrapper->get("key1", readValue, COLUMN_NAME));
+    EXPECT_TRUE(db_wrapper->get("key2", readValue));
+
+    ASSERT_NO_THROW(batch.commit());
+    EXPECT_TRUE(batch.empty());
+    ASSERT_TRUE(db_wrapper->get("key1", readValue, COLUMN_NAME));
+    EXPECT_EQ(readValue, "value1");
+    EXPECT_FALSE(db_wrapper->get("key2", readValue));
+    EXPECT_THROW(batch.put("key3", "value3", "inexistent"), std::runtime_error);
+}
+
+/**
+ * @brief Test reading a snapshot while the database is written.
+ *
+ */
+TEST_F(RocksDBWrapperTest, SnapshotReadView)
+{
+    db_wrapper->put("key1", "value1");
+    db_wrapper->put("key2", "value2");
+
+    const auto snapshot {db_wrapper->snapshot()};
+    rocksdb::ReadOptions readOptions;
+    readOptions.snapshot = snapshot.get();
+
+    db_wrapper->put("key1", "changed");
+    db_wrapper->delete_("key2");
+    db_wrapper->put("key3", "value3");
+
+    std::string readValue;
+    ASSERT_TRUE(db_wrapper->get("key1", readValue, db_wrapper->column(), readOptions));
+    EXPECT_EQ(readValue, "value1");
+    EXPECT_FALSE(db_wrapper->get("key3", readValue, db_wrapper->column(), readOptions));
+
+    std::vector<std::string> keys;
+    for (const auto& [key, value] : db_wrapper->seek("key", db_wrapper->column(), readOptions))
+    {
+        keys.push_back(key);
+    }
+    EXPECT_EQ(keys, std::vector<std::string>({"key1", "key2"}));
+
+    // The database is written normally.
+    ASSERT_TRUE(db_wrapper->get("key1", readValue));
+    EXPECT_EQ(readValue, "changed");
+    EXPECT_FALSE(db_wrapper->get("key2", readValue));
+}
+
+/**
+ * @brief Test filling several batches of the same database concurrently.
+ *
+ */
+TEST_F(RocksDBWrapperTest, WriteBatchConcurrentColumns)
+{
+    constexpr auto THREADS {4};
+    constexpr auto KEYS {100};
+    std::shared_mutex columnsMutex;
+
+    std::vector<std::thread> threads;
+    for (auto i {0}; i < THREADS; ++i)
+    {
+        threads.emplace_back(
+            [&, i]()
+            {
+                Utils::RocksDBWriteBatch batch {db_wrapper.get(), columnsMutex};
+                for (auto key {0}; key < KEYS; ++key)
+                {
+                    // All the threads create the same columns.
+                    const auto columnName {"column_" + std::to_string(key % 10)};
+                    if (!batch.columnExists(columnName))
+                    {
+                        batch.createColumn(columnName);
+                    }
+                    batch.put(std::to_string(i) + "_" + std::to_string(key), "value", columnName);
+                }
+                batch.commit();
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    std::string readValue;
+    for (auto i {0}; i < THREADS; ++i)
+    {
+        for (auto key {0}; key < KEYS; ++key)
+        {
+            EXPECT_TRUE(db_wrapper->get(
+                std::to_string(i) + "_" + std::to_string(key), readValue, "column_" + std::to_string(key % 10)));
+        }
+    }
+}
+
+/**
+ * @brief Test loading data in bulk, into the existing columns and into the ones created during the load.
+ *
+ */
+TEST_F(RocksDBWrapperTest, BulkLoad)
+{
+    constexpr auto COLUMN_NAME {"column_A"};
+    constexpr auto KEYS {1000};
+    std::string readValue;
+
+    ASSERT_NO_THROW(db_wrapper->beginBulkLoad());
+    db_wrapper->createColumn(COLUMN_NAME);
+    for (auto i {0}; i < KEYS; ++i)
+    {
+        db_wrapper->put("key" + std::to_string(i), "value" + std::to_string(i));
+        db_wrapper->put("key" + std::to_string(i), "value" + std::to_string(i), COLUMN_NAME);
+    }
+    ASSERT_NO_THROW(db_wrapper->endBulkLoad());
+
+    for (auto i {0}; i < KEYS; ++i)
+    {
+        ASSERT_TRUE(db_wrapper->get("key" + std::to_string(i), readValue));
+        EXPECT_EQ(readValue, "value" + std::to_string(i));
+        ASSERT_TRUE(db_wrapper->get("key" + std::to_string(i), readValue, COLUMN_NAME));
+        EXPECT_EQ(readValue, "value" + std::to_string(i));
+    }
+}
+
+TEST_F(RocksDBWrapperTest, CreateCheckpoint)
+{
+    constexpr auto COLUMN_NAME {"column_A"};
+    const auto checkpointPath {std::filesystem::temp_directory_path() / "RocksDBWrapperTest_checkpoint"};
+    std::filesystem::remove_all(checkpointPath);
+
+    db_wrapper->createColumn(COLUMN_NAME);
+    db_wrapper->put("key1", "value1");
+    db_wrapper->put("key2", "value2", COLUMN_NAME);
+    ASSERT_NO_THROW(db_wrapper->createCheckpoint(checkpointPath));
+
+    // The writes after the checkpoint are not in the copy.
+    db_wrapper->put("key3", "value3");
+
+    std::string readValue;
+    {
+        Utils::RocksDBWrapper checkpoint {checkpointPath.string(), false};
+        ASSERT_TRUE(checkpoint.get("key1", readValue));
+        EXPECT_EQ(readValue, "value1");
+        ASSERT_TRUE(checkpoint.get("key2", readValue, COLUMN_NAME));
+        EXPECT_EQ(readValue, "value2");
+        EXPECT_FALSE(checkpoint.get("key3", readValue));
+    }
+
+    // The directory of the copy must not exist.
+    EXPECT_THROW(db_wrapper->createCheckpoint(checkpointPath), std::runtime_error);
+    std::filesystem::remove_all(checkpointPath);
+}
@@ -89,6 +89,24 @@ TEST_F(SocketDBWrapperTest, OkTest)
     ASSERT_EQ(output[0].at("field"), "value");
 }
 
+TEST_F(SocketDBWrapperTest, SaveBatchTest)
+{
+    m_query = R"(agent 001 syscollector_packages save_batch [{"attributes":{"name":"a"}},{"attributes":{"name":"b"}}])";
+    m_responses = std::vector<std::string> {R"(ok)"};
+
+    const auto rows = nlohmann::json::parse(R"([{"attributes":{"name":"a"}},{"attributes":{"name":"b"}}])");
+    EXPECT_NO_THROW(SocketDBWrapper::instance().saveBatch("001", "syscollector_packages", rows));
+}
+
+TEST_F(SocketDBWrapperTest, SaveBatchErrorTest)
+{
+    m_query = R"(agent 001 syscollector_packages save_batch [{"attributes":{"name":"a"}}])";
+    m_responses = std::vector<std::string> {R"(err Cannot save Syscollector batch)"};
+
+    const auto rows = nlohmann::json::parse(R"([{"attributes":{"name":"a"}}])");
+    EXPECT_THROW(SocketDBWrapper::instance().saveBatch("001", "syscollector_packages", rows), std::exception);
+}
+
 TEST_F(SocketDBWrapperTestNoSetUp, NoSocketTest)
 {
     SocketDBWrapper::instance();
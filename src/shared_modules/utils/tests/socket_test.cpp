@@ -14,6 +14,8 @@
 #include "../socketServer.hpp"
 #include <chrono>
 #include <future>
+#include <map>
+#include <mutex>
 
 TYPED_TEST_SUITE_P(SocketTest);
 
@@ -394,6 +396,105 @@ TYPED_TEST_P(SocketTest, SingleDelayedClientWithReconnectionServerReset)
     EXPECT_EQ(counter, MESSAGE_QUANTITY);
 }
 
+TEST(SocketBatchTest, CoalescedFramesPerSyscall)
+{
+    constexpr size_t MESSAGE_QUANTITY {100000};
+    std::string socketPath {"/tmp/echo_sock"};
+    std::promise<void> promise;
+    std::atomic<size_t> counter {0};
+
+    using BatchedSocket = Socket<OSPrimitives, BatchedProtocol<AppendHeaderProtocol>>;
+    SocketServer<BatchedSocket, EpollWrapper> server {socketPath};
+    server.listen(
+        [&](const int fd, const char* data, uint32_t size, const char* dataHeader, uint32_t sizeHeader)
+        {
+            std::ignore = fd;
+            EXPECT_EQ(std::string(dataHeader, sizeHeader), "P");
+            EXPECT_EQ(std::string(data, size), std::to_string(counter));
+
+            if (++counter == MESSAGE_QUANTITY)
+            {
+                promise.set_value();
+            }
+        });
+
+    BatchedSocket client;
+    client.connect(UnixAddress::builder().address(socketPath).build().data(), SOCK_STREAM);
+
+    for (size_t i {0}; i < MESSAGE_QUANTITY; ++i)
+    {
+        auto message {std::to_string(i)};
+        client.send(message.c_str(), message.size(), "P", 1);
+    }
+    client.flush();
+
+    promise.get_future().wait_for(std::chrono::seconds(10));
+    EXPECT_EQ(counter, MESSAGE_QUANTITY);
+
+    const auto& counters {client.counters()};
+    EXPECT_EQ(counters.sentFrames, MESSAGE_QUANTITY);
+    EXPECT_GT(counters.sentFrames, counters.sendCalls * 100);
+}
+
+TEST(SocketServerReactorsTest, MultipleClientsInOrderPerClient)
+{
+    constexpr size_t MESSAGE_QUANTITY {10000};
+    constexpr size_t CLIENTS {8};
+    constexpr size_t REACTORS {4};
+    constexpr size_t CALLBACK_THREADS {2};
+    std::string socketPath {"/tmp/echo_sock"};
+    std::promise<void> promise;
+
+    SocketServer<Socket<OSPrimitives>, EpollWrapper> server {socketPath, REACTORS, CALLBACK_THREADS};
+    std::mutex mutex;
+    std::map<int, size_t> nextMessage;
+    std::atomic<size_t> counter {0};
+    server.listen(
+        [&](const int fd, const char* data, uint32_t size, const char* dataHeader, uint32_t sizeHeader)
+        {
+            std::ignore = dataHeader;
+            std::ignore = sizeHeader;
+            {
+                std::lock_guard<std::mutex> lock {mutex};
+                EXPECT_EQ(std::string(data, size), std::to_string(nextMessage[fd]++));
+            }
+
+            if (++counter == MESSAGE_QUANTITY)
+            {
+                promise.set_value();
+            }
+        });
+
+    std::vector<std::thread> threads;
+    for (size_t i {0}; i < CLIENTS; ++i)
+    {
+        threads.emplace_back(
+            [&]()
+            {
+                SocketClient<Socket<OSPrimitives>, EpollWrapper> client {socketPath};
+                client.connect([](const char*, uint32_t, const char*, uint32_t) {});
+
+                for (size_t i {0}; i < MESSAGE_QUANTITY / CLIENTS; ++i)
+                {
+                    auto message {std::to_string(i)};
+                    client.send(message.c_str(), message.size());
+                }
+
+                std::this_thread::sleep_for(std::chrono::seconds(5));
+            });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    promise.get_future().wait_for(std::chrono::seconds(10));
+
+    EXPECT_EQ(counter, MESSAGE_QUANTITY);
+    EXPECT_EQ(nextMessage.size(), CLIENTS);
+}
+
 // All tests must be registered
 
 REGISTER_TYPED_TEST_SUITE_P(SocketTest,
@@ -405,5 +506,8 @@ REGISTER_TYPED_TEST_SUITE_P(SocketTest,
                             SingleDelayedClientWithReconnectionServerReset);
 
 // Configuring typed-tests
-using ProtocolTypes = ::testing::Types<AppendHeaderProtocol, SizeHeaderProtocol>;
+using ProtocolTypes = ::testing::Types<AppendHeaderProtocol,
+                                       SizeHeaderProtocol,
+                                       BatchedProtocol<AppendHeaderProtocol>,
+                                       BatchedProtocol<SizeHeaderProtocol>>;
 INSTANTIATE_TYPED_TEST_SUITE_P(TypedSocketTests, SocketTest, ProtocolTypes);
@@ -589,3 +589,90 @@ TEST_F(StringUtilsTest, haveUpperCaseCharacters)
     EXPECT_FALSE(Utils::haveUpperCaseCharacters(""));
 }
 
+
+TEST_F(StringUtilsTest, SplitViewSameTokensAsSplit)
+{
+    for (const auto& str : {"", "a", "a,", ",a", "a,,b", ",", "hello,world,!"})
+    {
+        std::vector<std::string> tokens;
+        for (const auto& token : Utils::splitView(str, ','))
+        {
+            tokens.emplace_back(token);
+        }
+        EXPECT_EQ(tokens, Utils::split(str, ',')) << str;
+    }
+}
+
+TEST_F(StringUtilsTest, SplitViewNoCopy)
+{
+    const std::string str {"key=value"};
+    auto it {Utils::splitView(str, '=').begin()};
+    EXPECT_EQ(it->data(), str.data());
+    ++it;
+    EXPECT_EQ(*it, "value");
+    EXPECT_EQ(it->data(), str.data() + 4);
+    ++it;
+    EXPECT_EQ(it, Utils::splitView(str, '=').end());
+}
+
+TEST_F(StringUtilsTest, ToLowerCaseInPlace)
+{
+    std::string str {"Wazuh ÁÉ 1.0-ABC"};
+    Utils::toLowerCaseInPlace(str);
+    EXPECT_EQ(str, "wazuh ÁÉ 1.0-abc");
+}
+
+TEST_F(StringUtilsTest, ToUpperCaseInPlace)
+{
+    std::string str {"Wazuh áé 1.0-abc"};
+    Utils::toUpperCaseInPlace(str);
+    EXPECT_EQ(str, "WAZUH áé 1.0-ABC");
+}
+
+TEST_F(StringUtilsTest, EqualsIgnoreCase)
+{
+    EXPECT_TRUE(Utils::equalsIgnoreCase("OpenSSL", "openssl"));
+    EXPECT_TRUE(Utils::equalsIgnoreCase("", ""));
+    EXPECT_FALSE(Utils::equalsIgnoreCase("openssl", "openssh"));
+    EXPECT_FALSE(Utils::equalsIgnoreCase("openssl", "openssl3"));
+}
+
+TEST_F(StringUtilsTest, StartsWithIgnoreCase)
+{
+    EXPECT_TRUE(Utils::startsWithIgnoreCase("Microsoft Edge", "microsoft"));
+    EXPECT_TRUE(Utils::startsWithIgnoreCase("Microsoft Edge", ""));
+    EXPECT_FALSE(Utils::startsWithIgnoreCase("Microsoft", "Microsoft Edge"));
+    EXPECT_FALSE(Utils::startsWithIgnoreCase("Microsoft Edge", "edge"));
+}
+
+TEST_F(StringUtilsTest, MultiReplacement)
+{
+    std::string str {"cpe:/o:$(VENDOR):$(PRODUCT):$(VERSION)"};
+    EXPECT_TRUE(Utils::replaceAll(
+        str, {{"$(VENDOR)", "canonical"}, {"$(PRODUCT)", "ubuntu_linux"}, {"$(VERSION)", "22.04"}}));
+    EXPECT_EQ(str, "cpe:/o:canonical:ubuntu_linux:22.04");
+}
+
+TEST_F(StringUtilsTest, MultiReplacementSinglePass)
+{
+    // The replaced text is not searched again.
+    std::string str {"a-b"};
+    EXPECT_TRUE(Utils::replaceAll(str, {{"a", "b"}, {"b", "c"}, {"-", "--"}}));
+    EXPECT_EQ(str, "b--c");
+}
+
+TEST_F(StringUtilsTest, MultiReplacementPriority)
+{
+    // The earliest occurrence wins, and the first string of the list at the same position.
+    std::string str {"abcab"};
+    EXPECT_TRUE(Utils::replaceAll(str, {{"bc", "2"}, {"ab", "1"}, {"abc", "3"}}));
+    EXPECT_EQ(str, "1c1");
+}
+
+TEST_F(StringUtilsTest, MultiNotReplacement)
+{
+    std::string str {"hello_world"};
+    EXPECT_FALSE(Utils::replaceAll(str, {{"", "x"}, {"bye", "hello"}}));
+    EXPECT_FALSE(Utils::replaceAll(str, {}));
+    EXPECT_EQ(str, "hello_world");
+}
@@ -121,3 +121,112 @@ TEST_F(ThreadDispatcherTest, AsyncDispatcherQueue)
     dispatcher.rundown();
 }
 
+
+TEST_F(ThreadDispatcherTest, AsyncDispatcherExecutorPushAndRundown)
+{
+    FunctorWrapper functor;
+    auto spExecutor { std::make_shared<WorkStealingExecutor>(4) };
+    AsyncDispatcher<int, std::reference_wrapper<FunctorWrapper>> dispatcher
+    {
+        std::ref(functor), spExecutor
+    };
+    EXPECT_EQ(4u, dispatcher.numberOfThreads());
+
+    for (int i = 0; i < 20; ++i)
+    {
+        EXPECT_CALL(functor, Operator(i));
+    }
+
+    for (int i = 0; i < 10; ++i)
+    {
+        dispatcher.push(i);
+    }
+
+    dispatcher.pushBulk({10, 11, 12, 13, 14, 15, 16, 17, 18, 19});
+    dispatcher.rundown();
+    EXPECT_TRUE(dispatcher.cancelled());
+    EXPECT_EQ(0ul, dispatcher.size());
+}
+
+TEST_F(ThreadDispatcherTest, AsyncDispatcherExecutorShared)
+{
+    constexpr auto NUMBER_OF_ITEMS { 1000 };
+    std::atomic<int> first { 0 };
+    std::atomic<int> second { 0 };
+    auto spExecutor { std::make_shared<WorkStealingExecutor>(2) };
+    AsyncDispatcher<int, std::function<void(int)>> firstDispatcher
+    {
+        [&first](int value)
+        {
+            first += value;
+        }, spExecutor
+    };
+    AsyncDispatcher<int, std::function<void(int)>> secondDispatcher
+    {
+        [&second](int value)
+        {
+            second += value;
+        }, spExecutor
+    };
+
+    for (int i = 0; i < NUMBER_OF_ITEMS; ++i)
+    {
+        firstDispatcher.push(1);
+        secondDispatcher.push(2);
+    }
+
+    firstDispatcher.rundown();
+    EXPECT_EQ(NUMBER_OF_ITEMS, first);
+    secondDispatcher.rundown();
+    EXPECT_EQ(2 * NUMBER_OF_ITEMS, second);
+}
+
+TEST_F(ThreadDispatcherTest, AsyncDispatcherExecutorQueue)
+{
+    constexpr auto MAX_QUEUE_SIZE { 5ull };
+    std::promise<void> release;
+    auto released { release.get_future().share() };
+    std::atomic<int> calls { 0 };
+    auto spExecutor { std::make_shared<WorkStealingExecutor>(1) };
+
+    AsyncDispatcher<int, std::function<void(int)>> dispatcher
+    {
+        [&calls, released](int)
+        {
+            released.wait();
+            ++calls;
+        }
+        , spExecutor
+        , MAX_QUEUE_SIZE
+    };
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        dispatcher.push(0);
+    }
+
+    EXPECT_EQ(MAX_QUEUE_SIZE, dispatcher.size());
+    release.set_value();
+    dispatcher.rundown();
+    EXPECT_EQ(static_cast<int>(MAX_QUEUE_SIZE), calls);
+}
+
+TEST_F(ThreadDispatcherTest, AsyncDispatcherExecutorCancel)
+{
+    FunctorWrapper functor;
+    AsyncDispatcher<int, std::reference_wrapper<FunctorWrapper>> dispatcher
+    {
+        std::ref(functor), std::make_shared<WorkStealingExecutor>(2)
+    };
+    dispatcher.cancel();
+
+    EXPECT_CALL(functor, Operator(_)).Times(0);
+
+    for (int i = 0; i < 10; ++i)
+    {
+        dispatcher.push(i);
+    }
+
+    EXPECT_TRUE(dispatcher.cancelled());
+    EXPECT_EQ(0ul, dispatcher.size());
+}
@@ -11,6 +11,10 @@
 
 #include "threadEventDispatcher_test.hpp"
 #include "threadEventDispatcher.hpp"
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <set>
 
 void ThreadEventDispatcherTest::SetUp() {
     // Not implemented
@@ -145,3 +149,151 @@ TEST_F(ThreadEventDispatcherTest, CtorPopFeature)
     EXPECT_EQ(MESSAGES_TO_SEND, counter);
 }
 
+
+TEST_F(ThreadEventDispatcherTest, PushBulk)
+{
+    constexpr auto MESSAGES_TO_SEND {120};
+
+    std::atomic<size_t> counter {0};
+    std::promise<void> promise;
+    auto index {0};
+
+    ThreadEventDispatcher<std::string, std::function<void(std::queue<std::string>&)>> dispatcher(
+        [&counter, &index, &promise](std::queue<std::string>& data)
+        {
+            counter += data.size();
+            while (!data.empty())
+            {
+                EXPECT_EQ(std::to_string(index), data.front());
+                data.pop();
+                ++index;
+            }
+
+            if (counter == MESSAGES_TO_SEND)
+            {
+                promise.set_value();
+            }
+        },
+        "test.db",
+        BULK_SIZE);
+
+    std::vector<std::string> values;
+    for (int i = 0; i < MESSAGES_TO_SEND; ++i)
+    {
+        values.push_back(std::to_string(i));
+    }
+    dispatcher.push(values);
+
+    promise.get_future().wait_for(std::chrono::seconds(10));
+    EXPECT_EQ(MESSAGES_TO_SEND, counter);
+}
+
+TEST_F(ThreadEventDispatcherTest, VectorFunctor)
+{
+    constexpr auto MESSAGES_TO_SEND {120};
+
+    std::atomic<size_t> counter {0};
+    std::promise<void> promise;
+    auto index {0};
+    const std::vector<std::string>* buffer {nullptr};
+
+    ThreadEventDispatcher<std::string, std::function<void(std::vector<std::string>&)>> dispatcher(
+        [&counter, &index, &promise, &buffer](std::vector<std::string>& data)
+        {
+            // The same buffer is passed on every call.
+            if (buffer == nullptr)
+            {
+                buffer = &data;
+            }
+            EXPECT_EQ(buffer, &data);
+            EXPECT_LE(data.size(), BULK_SIZE);
+
+            counter += data.size();
+            for (const auto& value : data)
+            {
+                EXPECT_EQ(std::to_string(index), value);
+                ++index;
+            }
+
+            if (counter == MESSAGES_TO_SEND)
+            {
+                promise.set_value();
+            }
+        },
+        "test.db",
+        BULK_SIZE);
+
+    for (int i = 0; i < MESSAGES_TO_SEND; ++i)
+    {
+        dispatcher.push(std::to_string(i));
+    }
+
+    promise.get_future().wait_for(std::chrono::seconds(10));
+    EXPECT_EQ(MESSAGES_TO_SEND, counter);
+}
+
+TEST_F(ThreadEventDispatcherTest, PartitionedKeepsOrderPerKey)
+{
+    constexpr auto MESSAGES_TO_SEND {1000};
+    constexpr auto KEYS {16};
+    constexpr auto PARTITIONS {4};
+
+    std::mutex mutex;
+    std::map<std::string, int> lastByKey;
+    std::set<std::thread::id> workers;
+
+    std::error_code ec;
+    std::filesystem::remove_all("partitioned.db", ec);
+
+    PartitionedThreadEventDispatcher<std::string, std::function<void(std::queue<std::string>&)>> dispatcher(
+        [&](std::queue<std::string>& data)
+        {
+            std::lock_guard<std::mutex> lock {mutex};
+            workers.insert(std::this_thread::get_id());
+            while (!data.empty())
+            {
+                const auto value = data.front();
+                data.pop();
+                const auto separator = value.find(':');
+                const auto key = value.substr(0, separator);
+                const auto sequence = std::stoi(value.substr(separator + 1));
+
+                // The elements of the same key arrive in order.
+                const auto last = lastByKey.find(key);
+                EXPECT_TRUE(last == lastByKey.end() || last->second < sequence);
+                lastByKey[key] = sequence;
+            }
+        },
+        "partitioned.db",
+        PARTITIONS,
+        BULK_SIZE);
+
+    EXPECT_EQ(PARTITIONS, dispatcher.partitions());
+
+    std::set<size_t> partitionsUsed;
+    for (int i = 0; i < MESSAGES_TO_SEND; ++i)
+    {
+        const auto key = "agent" + std::to_string(i % KEYS);
+        partitionsUsed.insert(dispatcher.partition(key));
+        dispatcher.push(key, key + ":" + std::to_string(i));
+    }
+    EXPECT_GT(partitionsUsed.size(), 1U);
+
+    for (auto i = 0; i < 1000 && dispatcher.size() > 0; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(0, dispatcher.size());
+
+    dispatcher.cancel();
+    EXPECT_EQ(KEYS, lastByKey.size());
+    EXPECT_GT(workers.size(), 1U);
+    std::filesystem::remove_all("partitioned.db", ec);
+}
+
+TEST_F(ThreadEventDispatcherTest, PartitionedNeedsPartitions)
+{
+    EXPECT_THROW((PartitionedThreadEventDispatcher<std::string, std::function<void(std::queue<std::string>&)>>(
+                     "partitioned.db", 0)),
+                 std::invalid_argument);
+}
@@ -86,3 +86,35 @@ TEST_F(TimeUtilsTest, RawTimestampToISO8601)
     EXPECT_EQ("", Utils::rawTimestampToISO8601(""));
     EXPECT_EQ("", Utils::rawTimestampToISO8601("abcdefg"));
 }
+
+TEST_F(TimeUtilsTest, TimestampSameMinute)
+{
+    // 2020-11-13 01:54:25 UTC, the cached minute is reused for the following seconds.
+    EXPECT_EQ("2020/11/13 01:54:25", Utils::getTimestamp(1605232465));
+    EXPECT_EQ("2020/11/13 01:54:59", Utils::getTimestamp(1605232499));
+    EXPECT_EQ("2020/11/13 01:55:00", Utils::getTimestamp(1605232500));
+    EXPECT_EQ("2020/11/13 01:54:00", Utils::getTimestamp(1605232440));
+    EXPECT_EQ("20201113015425", Utils::getCompactTimestamp(1605232465));
+    EXPECT_EQ("20201113015426", Utils::getCompactTimestamp(1605232466));
+    EXPECT_EQ("1969/12/31 23:59:59", Utils::getTimestamp(-1));
+}
+
+TEST_F(TimeUtilsTest, LocalTimestamp)
+{
+    for (const std::time_t time : {1605232465, 1605232466, 1605232525, 1719792000})
+    {
+        std::ostringstream expected;
+        expected << std::put_time(std::localtime(&time), "%Y/%m/%d %H:%M:%S");
+        EXPECT_EQ(expected.str(), Utils::getTimestamp(time, false));
+    }
+}
+
+TEST_F(TimeUtilsTest, ISO8601)
+{
+    EXPECT_EQ("2020-11-13T01:54:25.000Z", Utils::getISO8601(1605232465));
+    EXPECT_EQ("2020-11-13T01:54:26.007Z", Utils::getISO8601(1605232466, 7));
+    EXPECT_EQ("2020-11-13T01:55:00.999Z", Utils::getISO8601(1605232500, 999));
+
+    constexpr auto ISO8601_REGEX_STR {"[0-9]{4}-[0-9]{2}-[0-9]{2}T[0-9]{2}:[0-9]{2}:[0-9]{2}\\.[0-9]{3}Z"};
+    EXPECT_TRUE(std::regex_match(Utils::getCurrentISO8601(), std::regex(ISO8601_REGEX_STR)));
+}
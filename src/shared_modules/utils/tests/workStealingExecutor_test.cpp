@@ -0,0 +1,119 @@
+/*
+ * Wazuh shared modules utils
+ * Copyright (C) 2015, Wazuh Inc.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include <atomic>
+#include <vector>
+#include "workStealingExecutor_test.hpp"
+#include "workStealingExecutor.hpp"
+
+using namespace Utils;
+
+TEST_F(WorkStealingExecutorTest, SubmitRunsAllTasks)
+{
+    constexpr auto NUMBER_OF_TASKS { 10000 };
+    std::atomic<int> counter { 0 };
+    auto spTasks { std::make_shared<TaskGroup>() };
+    WorkStealingExecutor executor { 4 };
+    EXPECT_EQ(4u, executor.numberOfThreads());
+
+    spTasks->add(NUMBER_OF_TASKS);
+
+    for (int i = 0; i < NUMBER_OF_TASKS; ++i)
+    {
+        executor.submit([&counter, spTasks]()
+        {
+            ++counter;
+            spTasks->done();
+        });
+    }
+
+    spTasks->wait();
+    EXPECT_EQ(NUMBER_OF_TASKS, counter);
+    EXPECT_EQ(0ul, spTasks->size());
+}
+
+TEST_F(WorkStealingExecutorTest, SubmitBulk)
+{
+    constexpr auto NUMBER_OF_TASKS { 1001 };
+    std::vector<std::atomic<int>> runs(NUMBER_OF_TASKS);
+    auto spTasks { std::make_shared<TaskGroup>() };
+    WorkStealingExecutor executor { 3 };
+    std::vector<WorkStealingExecutor::Task> tasks;
+
+    for (int i = 0; i < NUMBER_OF_TASKS; ++i)
+    {
+        tasks.push_back([&runs, i, spTasks]()
+        {
+            ++runs[i];
+            spTasks->done();
+        });
+    }
+
+    spTasks->add(NUMBER_OF_TASKS);
+    executor.submit(std::move(tasks));
+    spTasks->wait();
+
+    for (const auto& run : runs)
+    {
+        EXPECT_EQ(1, run);
+    }
+}
+
+TEST_F(WorkStealingExecutorTest, SingleThreadKeepsOrder)
+{
+    std::vector<int> order;
+    auto spTasks { std::make_shared<TaskGroup>() };
+    WorkStealingExecutor executor { 1 };
+
+    for (int i = 0; i < 100; ++i)
+    {
+        spTasks->add();
+        executor.submit([&order, i, spTasks]()
+        {
+            order.push_back(i);
+            spTasks->done();
+        });
+    }
+
+    spTasks->wait();
+    ASSERT_EQ(100ul, order.size());
+
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ(i, order[i]);
+    }
+}
+
+TEST_F(WorkStealingExecutorTest, NestedTasksAndExceptions)
+{
+    std::atomic<int> counter { 0 };
+    auto spTasks { std::make_shared<TaskGroup>() };
+    WorkStealingExecutor executor { 2 };
+
+    spTasks->add(3);
+    executor.submit([&executor, &counter, spTasks]()
+    {
+        executor.submit([&counter, spTasks]()
+        {
+            ++counter;
+            spTasks->done();
+        });
+        ++counter;
+        spTasks->done();
+    });
+    executor.submit([spTasks]()
+    {
+        spTasks->done();
+        throw std::runtime_error { "error" };
+    });
+
+    spTasks->wait();
+    EXPECT_EQ(2, counter);
+}
@@ -0,0 +1,26 @@
+/*
+ * Wazuh shared modules utils
+ * Copyright (C) 2015, Wazuh Inc.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef WORK_STEALING_EXECUTOR_TESTS_HPP
+#define WORK_STEALING_EXECUTOR_TESTS_HPP
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+class WorkStealingExecutorTest : public ::testing::Test
+{
+    protected:
+
+        WorkStealingExecutorTest() = default;
+        virtual ~WorkStealingExecutorTest() = default;
+
+        void SetUp() override {};
+        void TearDown() override {};
+};
+#endif //WORK_STEALING_EXECUTOR_TESTS_HPP
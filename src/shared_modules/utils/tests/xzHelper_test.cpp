@@ -343,6 +343,25 @@ TEST_F(XzHelperTest, DecompressFileOutputToDataVector)
     EXPECT_EQ(decompressedData, loadFile(UNCOMPRESSED_REFERENCE_FILE));
 }
 
+/**
+ * @brief Test correct decompression of a sample file as input, output streamed to a callback
+ *
+ */
+TEST_F(XzHelperTest, DecompressFileOutputToCallback)
+{
+    // Setup
+    std::vector<uint8_t> decompressedData;
+    Utils::XzHelper xz(COMPRESSED_INPUT_FILE_MT,
+                       [&decompressedData](const uint8_t* data, size_t size)
+                       { decompressedData.insert(decompressedData.end(), data, data + size); });
+
+    // Decompress
+    ASSERT_NO_THROW(xz.decompress());
+
+    // Check that the streamed data equals the data of the uncompressed reference file
+    EXPECT_EQ(decompressedData, loadFile(UNCOMPRESSED_REFERENCE_FILE));
+}
+
 /**
  * @brief Test correct compression of a data vector, output to file
  *
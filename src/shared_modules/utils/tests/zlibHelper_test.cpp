@@ -17,6 +17,7 @@
 #include <algorithm>
 #include <filesystem>
 #include <fstream>
+#include <iterator>
 #include <map>
 #include <stdexcept>
 #include <string>
@@ -116,6 +117,48 @@ TEST_F(ZlibHelperTest, GzDecompressFile)
     EXPECT_EQ(SHA1_EXPECTED, getFileHash(JSON_FILE));
 }
 
+/**
+ * @brief Tests the correct GZ decompression of a file, streamed to a callback.
+ *
+ */
+TEST_F(ZlibHelperTest, GzDecompressFileToCallback)
+{
+    ASSERT_NO_THROW(Utils::ZlibHelper::gzipDecompress(GZ_FILE, JSON_FILE));
+    std::ifstream referenceFile {JSON_FILE};
+    const std::string expectedData {std::istreambuf_iterator<char>(referenceFile), std::istreambuf_iterator<char>()};
+
+    std::string decompressedData;
+    ASSERT_NO_THROW(Utils::ZlibHelper::gzipDecompress(
+        GZ_FILE, [&decompressedData](const char* data, size_t size) { decompressedData.append(data, size); }));
+
+    EXPECT_EQ(expectedData, decompressedData);
+}
+
+/**
+ * @brief Tests that the data compressed in GZIP format is decompressed back to the original data.
+ *
+ */
+TEST_F(ZlibHelperTest, GzCompressData)
+{
+    std::string data;
+    for (auto i = 0; i < 1000; ++i)
+    {
+        data.append(R"({"index":{"_index":"wazuh-states","_id":")" + std::to_string(i) + "\"}}\n");
+    }
+
+    std::string compressedData;
+    ASSERT_NO_THROW(compressedData = Utils::ZlibHelper::gzipCompress(data));
+    EXPECT_LT(compressedData.size(), data.size());
+
+    const auto compressedFile {OUTPUT_DIR / "compressed.json.gz"};
+    std::ofstream {compressedFile, std::ios::binary} << compressedData;
+
+    std::string decompressedData;
+    ASSERT_NO_THROW(Utils::ZlibHelper::gzipDecompress(
+        compressedFile, [&decompressedData](const char* chunk, size_t size) { decompressedData.append(chunk, size); }));
+    EXPECT_EQ(data, decompressedData);
+}
+
 /**
  * @brief Tests the GZ decompression of a file whose format is not '.gz'.
  *
@@ -17,7 +17,9 @@
 #include <future>
 #include <functional>
 #include <iostream>
+#include <stdexcept>
 #include "threadSafeQueue.h"
+#include "workStealingExecutor.hpp"
 #include "promiseFactory.h"
 #include "commonDefs.h"
 
@@ -81,6 +83,26 @@ namespace Utils
                     m_threads.push_back(std::thread{ &AsyncDispatcher<Type, Functor>::dispatch, this });
                 }
             }
+            /**
+             * @brief Dispatcher that runs the functor on a shared executor instead of its own threads.
+             *
+             * @param functor Callable entity.
+             * @param executor Executor shared with other dispatchers.
+             * @param maxQueueSize Maximum number of pending messages, the rest are discarded.
+             */
+            AsyncDispatcher(Functor functor, std::shared_ptr<WorkStealingExecutor> executor, const size_t maxQueueSize = UNLIMITED_QUEUE_SIZE)
+                : m_functor{ functor }
+                , m_running{ true }
+                , m_numberOfThreads{ executor ? executor->numberOfThreads() : 0 }
+                , m_maxQueueSize { maxQueueSize }
+                , m_spExecutor{ std::move(executor) }
+                , m_spTasks{ std::make_shared<TaskGroup>() }
+            {
+                if (!m_spExecutor)
+                {
+                    throw std::invalid_argument{ "Invalid executor" };
+                }
+            }
             AsyncDispatcher& operator=(const AsyncDispatcher&) = delete;
             AsyncDispatcher(AsyncDispatcher& other) = delete;
             ~AsyncDispatcher()
@@ -92,7 +114,24 @@ namespace Utils
             {
                 if (m_running)
                 {
-                    if (UNLIMITED_QUEUE_SIZE == m_maxQueueSize || m_queue.size() < m_maxQueueSize)
+                    if (m_spExecutor)
+                    {
+                        if (UNLIMITED_QUEUE_SIZE == m_maxQueueSize || m_spTasks->size() < m_maxQueueSize)
+                        {
+                            // Counted before checking m_running again, so a concurrent cancel waits for the task
+                            m_spTasks->add();
+
+                            if (m_running)
+                            {
+                                m_spExecutor->submit(task(value));
+                            }
+                            else
+                            {
+                                m_spTasks->done();
+                            }
+                        }
+                    }
+                    else if (UNLIMITED_QUEUE_SIZE == m_maxQueueSize || m_queue.size() < m_maxQueueSize)
                     {
                         m_queue.push
                         (
@@ -105,9 +144,65 @@ namespace Utils
                 }
             }
 
-            void rundown()
+            /**
+             * @brief Pushes several messages, submitted to the executor at once.
+             *
+             * @param values Messages, the ones that do not fit in the queue are discarded.
+             */
+            void pushBulk(const std::vector<Type>& values)
             {
+                if (!m_spExecutor)
+                {
+                    for (const auto& value : values)
+                    {
+                        push(value);
+                    }
+
+                    return;
+                }
+
                 if (m_running)
+                {
+                    auto count { values.size() };
+
+                    if (UNLIMITED_QUEUE_SIZE != m_maxQueueSize)
+                    {
+                        const auto size { m_spTasks->size() };
+                        count = size < m_maxQueueSize ? std::min(count, m_maxQueueSize - size) : 0;
+                    }
+
+                    std::vector<WorkStealingExecutor::Task> tasks;
+                    tasks.reserve(count);
+
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        tasks.push_back(task(values[i]));
+                    }
+
+                    m_spTasks->add(count);
+
+                    if (m_running)
+                    {
+                        m_spExecutor->submit(std::move(tasks));
+                    }
+                    else
+                    {
+                        for (size_t i = 0; i < count; ++i)
+                        {
+                            m_spTasks->done();
+                        }
+                    }
+                }
+            }
+
+            void rundown()
+            {
+                if (m_running && m_spExecutor)
+                {
+                    m_spTasks->wait();
+                    cancel();
+                }
+                else if (m_running)
                 {
                     auto promise { PromiseFactory<PROMISE_TYPE>::getPromiseObject() };
                     m_queue.push
@@ -124,6 +219,13 @@ namespace Utils
             void cancel()
             {
                 m_running = false;
+
+                if (m_spExecutor)
+                {
+                    // The tasks left skip the functor, but they still use this dispatcher
+                    m_spTasks->wait();
+                }
+
                 m_queue.cancel();
                 joinThreads();
             }
@@ -138,10 +240,30 @@ namespace Utils
             }
             size_t size() const
             {
-                return m_queue.size();
+                return m_spExecutor ? m_spTasks->size() : m_queue.size();
             }
 
         private:
+            WorkStealingExecutor::Task task(const Type& value)
+            {
+                return [value, this, spTasks = m_spTasks]()
+                {
+                    try
+                    {
+                        if (m_running)
+                        {
+                            m_functor(value);
+                        }
+                    }
+                    catch (const std::exception& ex)
+                    {
+                        std::cerr << "Dispatch handler error, " << ex.what() << std::endl;
+                    }
+
+                    spTasks->done();
+                };
+            }
+
             void dispatch()
             {
                 try
@@ -178,6 +300,8 @@ namespace Utils
             std::atomic_bool m_running;
             const unsigned int m_numberOfThreads;
             const size_t m_maxQueueSize;
+            const std::shared_ptr<WorkStealingExecutor> m_spExecutor;
+            const std::shared_ptr<TaskGroup> m_spTasks;
     };
 
     template <typename Input, typename Functor>
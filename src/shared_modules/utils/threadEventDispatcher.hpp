@@ -18,9 +18,15 @@
 #include "rocksDBQueueCF.hpp"
 #include "threadSafeMultiQueue.hpp"
 #include "threadSafeQueue.h"
+#include <algorithm>
 #include <atomic>
+#include <functional>
 #include <iostream>
+#include <stdexcept>
+#include <string_view>
 #include <thread>
+#include <type_traits>
+#include <vector>
 
 template<typename T,
          typename U,
@@ -81,6 +87,36 @@ public:
         }
     }
 
+    void push(const std::vector<T>& values)
+    {
+        if constexpr (!std::is_same_v<Utils::TSafeMultiQueue<T, U, RocksDBQueueCF<T, U>>, TSafeQueueType>)
+        {
+            if (!m_running)
+            {
+                return;
+            }
+
+            if (UNLIMITED_QUEUE_SIZE == m_maxQueueSize)
+            {
+                m_queue->pushBulk(values);
+            }
+            else if (const auto size = m_queue->size(); size < m_maxQueueSize)
+            {
+                // Only the values fitting in the queue are pushed, as with the single push.
+                const auto fitting = std::min(values.size(), m_maxQueueSize - size);
+                m_queue->pushBulk(fitting == values.size()
+                                      ? values
+                                      : std::vector<T>(values.begin(), values.begin() + fitting));
+            }
+        }
+        else
+        {
+            // static assert to avoid compilation
+            static_assert(std::is_same_v<Utils::TSafeMultiQueue<T, U, RocksDBQueueCF<T, U>>, TSafeQueueType>,
+                          "This method is not supported for this queue type");
+        }
+    }
+
     void push(std::string_view prefix, const T& value)
     {
         if constexpr (std::is_same_v<Utils::TSafeMultiQueue<T, U, RocksDBQueueCF<T, U>>, TSafeQueueType>)
@@ -174,13 +210,28 @@ private:
             {
                 if constexpr (std::is_same_v<Utils::TSafeQueue<T, U, RocksDBQueue<T, U>>, TSafeQueueType>)
                 {
-                    std::queue<U> data = m_queue->getBulk(m_bulkSize);
-                    const auto size = data.size();
+                    // A functor taking a vector gets the same buffer on every call, read with a single lookup.
+                    if constexpr (std::is_invocable_v<Functor&, std::vector<U>&>)
+                    {
+                        m_queue->getBulk(m_bulk, m_bulkSize);
+                        const auto size = m_bulk.size();
 
-                    if (!data.empty())
+                        if (!m_bulk.empty())
+                        {
+                            m_functor(m_bulk);
+                            m_queue->popBulk(size);
+                        }
+                    }
+                    else
                     {
-                        m_functor(data);
-                        m_queue->popBulk(size);
+                        std::queue<U> data = m_queue->getBulk(m_bulkSize);
+                        const auto size = data.size();
+
+                        if (!data.empty())
+                        {
+                            m_functor(data);
+                            m_queue->popBulk(size);
+                        }
                     }
                 }
                 else if constexpr (std::is_same_v<Utils::TSafeMultiQueue<T, U, RocksDBQueueCF<T, U>>, TSafeQueueType>)
@@ -223,9 +274,106 @@ private:
 
     const size_t m_maxQueueSize;
     const uint64_t m_bulkSize;
+    std::vector<U> m_bulk; ///< Elements being dispatched, only used by the worker.
 };
 
 template<typename Type, typename Functor>
 using ThreadEventDispatcher = TThreadEventDispatcher<Type, Type, Functor>;
 
+// Dispatcher with one queue and one worker thread per partition, the elements with the same key are dispatched in
+// order by the same worker. The functor is called from all the workers at the same time.
+// Each partition keeps its elements in its own database under the given path, the elements keep their partition
+// only while the number of partitions does not change.
+template<typename T, typename U, typename Functor>
+class TPartitionedThreadEventDispatcher
+{
+public:
+    explicit TPartitionedThreadEventDispatcher(Functor functor,
+                                               const std::string& dbPath,
+                                               const size_t partitions,
+                                               const uint64_t bulkSize = 1,
+                                               const size_t maxQueueSize = UNLIMITED_QUEUE_SIZE)
+        : TPartitionedThreadEventDispatcher {dbPath, partitions, bulkSize, maxQueueSize}
+    {
+        startWorker(std::move(functor));
+    }
+
+    explicit TPartitionedThreadEventDispatcher(const std::string& dbPath,
+                                               const size_t partitions,
+                                               const uint64_t bulkSize = 1,
+                                               const size_t maxQueueSize = UNLIMITED_QUEUE_SIZE)
+    {
+        if (partitions == 0)
+        {
+            throw std::invalid_argument("The number of partitions must be greater than 0");
+        }
+
+        m_partitions.reserve(partitions);
+        for (size_t i = 0; i < partitions; ++i)
+        {
+            m_partitions.emplace_back(std::make_unique<TThreadEventDispatcher<T, U, Functor>>(
+                dbPath + "/partition_" + std::to_string(i), bulkSize, maxQueueSize));
+        }
+    }
+
+    TPartitionedThreadEventDispatcher& operator=(const TPartitionedThreadEventDispatcher&) = delete;
+    TPartitionedThreadEventDispatcher(TPartitionedThreadEventDispatcher& other) = delete;
+    ~TPartitionedThreadEventDispatcher()
+    {
+        cancel();
+    }
+
+    void startWorker(Functor functor)
+    {
+        for (auto& partition : m_partitions)
+        {
+            partition->startWorker(functor);
+        }
+    }
+
+    void push(std::string_view key, const T& value)
+    {
+        m_partitions[partition(key)]->push(value);
+    }
+
+    size_t partition(std::string_view key) const
+    {
+        return std::hash<std::string_view> {}(key) % m_partitions.size();
+    }
+
+    size_t partitions() const
+    {
+        return m_partitions.size();
+    }
+
+    void cancel()
+    {
+        for (auto& partition : m_partitions)
+        {
+            partition->cancel();
+        }
+    }
+
+    bool cancelled() const
+    {
+        return m_partitions.front()->cancelled();
+    }
+
+    size_t size() const
+    {
+        size_t size {0};
+        for (const auto& partition : m_partitions)
+        {
+            size += partition->size();
+        }
+        return size;
+    }
+
+private:
+    std::vector<std::unique_ptr<TThreadEventDispatcher<T, U, Functor>>> m_partitions;
+};
+
+template<typename Type, typename Functor>
+using PartitionedThreadEventDispatcher = TPartitionedThreadEventDispatcher<Type, Type, Functor>;
+
 #endif // _THREAD_EVENT_DISPATCHER_HPP
@@ -14,6 +14,7 @@
 #include <atomic>
 #include <condition_variable>
 #include <mutex>
+#include <vector>
 
 namespace Utils
 {
@@ -84,6 +85,16 @@ namespace Utils
             return std::pair<U, std::string> {};
         }
 
+        void pushBulk(std::string_view prefix, const std::vector<T>& values)
+        {
+            std::scoped_lock lock {m_mutex};
+            if (!m_canceled && !values.empty())
+            {
+                m_queue.pushBulk(prefix, values);
+                m_cv.notify_all();
+            }
+        }
+
         void pop(std::string_view prefix)
         {
             std::scoped_lock lock {m_mutex};
@@ -93,6 +104,15 @@ namespace Utils
             }
         }
 
+        void popBulk(std::string_view prefix, const uint64_t elementsQuantity)
+        {
+            std::scoped_lock lock {m_mutex};
+            if (!m_canceled)
+            {
+                m_queue.popBulk(prefix, elementsQuantity);
+            }
+        }
+
         bool empty() const
         {
             std::scoped_lock lock {m_mutex};
@@ -11,16 +11,55 @@
 
 #ifndef THREAD_SAFE_QUEUE_H
 #define THREAD_SAFE_QUEUE_H
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <iostream>
 #include <memory>
 #include <mutex>
 #include <queue>
 #include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace Utils
 {
+    // Detects the queues with their own bulk operations (e.g. a single write batch).
+    template<typename Q, typename = void>
+    struct HasPopBulk : std::false_type
+    {
+    };
+
+    template<typename Q>
+    struct HasPopBulk<Q, std::void_t<decltype(std::declval<Q&>().popBulk(uint64_t {}))>> : std::true_type
+    {
+    };
+
+    template<typename Q, typename T, typename = void>
+    struct HasPushBulk : std::false_type
+    {
+    };
+
+    template<typename Q, typename T>
+    struct HasPushBulk<Q, T, std::void_t<decltype(std::declval<Q&>().pushBulk(std::declval<const std::vector<T>&>()))>>
+        : std::true_type
+    {
+    };
+
+    template<typename Q, typename U, typename = void>
+    struct HasFrontBulk : std::false_type
+    {
+    };
+
+    template<typename Q, typename U>
+    struct HasFrontBulk<Q,
+                        U,
+                        std::void_t<decltype(std::declval<Q&>().frontBulk(std::declval<std::vector<U>&>(), uint64_t {}))>>
+        : std::true_type
+    {
+    };
 
     template<typename T, typename U, typename Tq = std::queue<T>>
     class TSafeQueue
@@ -130,12 +169,85 @@ namespace Utils
             return bulkQueue;
         }
 
+        /**
+         * @brief Gets the first elements without removing them (see popBulk), like the overload returning a queue.
+         *
+         * @param values Elements read, it is overwritten reusing its capacity, so a caller that keeps it between calls
+         * does not allocate per element. It is empty if the queue is canceled.
+         * @param elementsQuantity Maximum number of elements to get.
+         * @param timeout Maximum time to wait for the queue to have the requested number of elements.
+         */
+        void getBulk(std::vector<U>& values,
+                     const uint64_t elementsQuantity,
+                     const std::chrono::seconds& timeout = std::chrono::seconds(5))
+        {
+            std::unique_lock<std::mutex> lock {m_mutex};
+
+            // coverity[missing_lock]
+            if (m_queue.size() < elementsQuantity)
+            {
+                m_cv.wait_for(lock,
+                              timeout,
+                              [this, elementsQuantity]()
+                              {
+                                  // coverity[missing_lock]
+                                  return m_canceled.load() || m_queue.size() >= elementsQuantity;
+                              });
+            }
+
+            if (m_canceled)
+            {
+                values.clear();
+            }
+            else if constexpr (HasFrontBulk<Tq, U>::value)
+            {
+                m_queue.frontBulk(values, elementsQuantity);
+            }
+            else
+            {
+                const auto quantity = std::min<uint64_t>(elementsQuantity, m_queue.size());
+                values.resize(quantity);
+                for (uint64_t i = 0; i < quantity; ++i)
+                {
+                    values[i] = m_queue.at(i);
+                }
+            }
+        }
+
+        void pushBulk(const std::vector<T>& values)
+        {
+            std::lock_guard<std::mutex> lock {m_mutex};
+
+            if (!m_canceled && !values.empty())
+            {
+                if constexpr (HasPushBulk<Tq, T>::value)
+                {
+                    m_queue.pushBulk(values);
+                }
+                else
+                {
+                    for (const auto& value : values)
+                    {
+                        m_queue.push(value);
+                    }
+                }
+                m_cv.notify_all();
+            }
+        }
+
         void popBulk(const uint64_t elementsQuantity)
         {
             std::lock_guard<std::mutex> lock {m_mutex};
-            for (auto i = 0; i < elementsQuantity && !m_queue.empty(); ++i)
+            if constexpr (HasPopBulk<Tq>::value)
             {
-                m_queue.pop();
+                m_queue.popBulk(elementsQuantity);
+            }
+            else
+            {
+                for (auto i = 0; i < elementsQuantity && !m_queue.empty(); ++i)
+                {
+                    m_queue.pop();
+                }
             }
         }
 
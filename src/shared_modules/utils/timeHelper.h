@@ -14,6 +14,7 @@
 
 #include "stringHelper.h"
 #include <chrono>
+#include <cstdio>
 #include <ctime>
 #include <iomanip>
 #include <sstream>
@@ -24,27 +25,115 @@ namespace Utils
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-function"
 
+    /**
+     * @brief Thread-safe conversion of a time to broken-down time, that does not take the glibc timezone lock on
+     * every call like localtime().
+     *
+     * @param time Time to convert.
+     * @param utc If true, the time will be expressed as a UTC time.
+     * @param result Broken-down time.
+     * @return true on success.
+     */
+    static bool toBrokenDownTime(const std::time_t& time, const bool utc, std::tm& result)
+    {
+#ifdef WIN32
+        return 0 == (utc ? gmtime_s(&result, &time) : localtime_s(&result, &time));
+#else
+        return nullptr != (utc ? gmtime_r(&time, &result) : localtime_r(&time, &result));
+#endif
+    }
+
+    /**
+     * @brief Formatted date, hour and minute of the last minute converted. Each thread keeps its own instances, so
+     * the timestamps of the same minute only format their seconds, without converting the time again. The local
+     * time is cached too, its timezone offset is computed once per minute.
+     */
+    class TimestampCache final
+    {
+    private:
+        // Format of the year, month, day, hour and minute.
+        const char* m_format;
+        bool m_utc;
+        bool m_valid {false};
+        std::time_t m_minute {0};
+        std::string m_prefix;
+
+    public:
+        TimestampCache(const char* format, const bool utc)
+            : m_format {format}
+            , m_utc {utc}
+        {
+        }
+
+        /**
+         * @brief Get the formatted minute of a time.
+         *
+         * @param time Time to format.
+         * @param seconds Seconds of the time within its minute.
+         * @return const std::string& Formatted minute, valid until the next call.
+         */
+        const std::string& minute(const std::time_t time, int& seconds)
+        {
+            seconds = static_cast<int>((time % 60 + 60) % 60);
+            const auto minute {time - seconds};
+
+            if (!m_valid || minute != m_minute)
+            {
+                std::tm brokenDown {};
+                // Historical timezones with an offset that is not a whole number of minutes are not cached.
+                m_valid = toBrokenDownTime(time, m_utc, brokenDown) && brokenDown.tm_sec == seconds;
+                m_minute = minute;
+                seconds = brokenDown.tm_sec;
+
+                char buffer[64];
+                const auto length {std::snprintf(buffer,
+                                                 sizeof(buffer),
+                                                 m_format,
+                                                 brokenDown.tm_year + 1900,
+                                                 brokenDown.tm_mon + 1,
+                                                 brokenDown.tm_mday,
+                                                 brokenDown.tm_hour,
+                                                 brokenDown.tm_min)};
+                m_prefix.assign(buffer, length > 0 ? std::min(static_cast<size_t>(length), sizeof(buffer) - 1) : 0);
+            }
+
+            return m_prefix;
+        }
+    };
+
+    /**
+     * @brief Append a number with a fixed number of digits, padded with zeros.
+     */
+    static void appendDigits(std::string& str, int number, const size_t digits)
+    {
+        str.append(digits, '0');
+
+        for (auto it {str.rbegin()}; it != str.rbegin() + static_cast<std::ptrdiff_t>(digits); ++it)
+        {
+            *it = static_cast<char>('0' + number % 10);
+            number /= 10;
+        }
+    }
+
+    /**
+     * @brief Get a timestamp.
+     *
+     * @param time Time to convert.
+     * @param utc If true, the time will be expressed as a UTC time.
+     * @return std::string Timestamp. Format: "YYYY/MM/DD hh:mm:ss".
+     */
     static std::string getTimestamp(const std::time_t& time, const bool utc = true)
     {
-        std::stringstream ss;
-        // gmtime: result expressed as a UTC time
-        tm* localTime {utc ? gmtime(&time) : localtime(&time)};
-        // Final timestamp: "YYYY/MM/DD hh:mm:ss"
-        // Date
-        ss << std::setfill('0') << std::setw(4) << std::to_string(localTime->tm_year + 1900);
-        ss << "/";
-        ss << std::setfill('0') << std::setw(2) << std::to_string(localTime->tm_mon + 1);
-        ss << "/";
-        ss << std::setfill('0') << std::setw(2) << std::to_string(localTime->tm_mday);
-        // Time
-        ss << " ";
-        ss << std::setfill('0') << std::setw(2) << std::to_string(localTime->tm_hour);
-        ss << ":";
-        ss << std::setfill('0') << std::setw(2) << std::to_string(localTime->tm_min);
-        ss << ":";
-        ss << std::setfill('0') << std::setw(2) << std::to_string(localTime->tm_sec);
-        return ss.str();
+        constexpr auto FORMAT {"%04d/%02d/%02d %02d:%02d:"};
+        thread_local TimestampCache utcCache {FORMAT, true};
+        thread_local TimestampCache localCache {FORMAT, false};
+
+        int seconds {0};
+        std::string timestamp {(utc ? utcCache : localCache).minute(time, seconds)};
+        appendDigits(timestamp, seconds, 2);
+        return timestamp;
     }
+
     static std::string getCurrentTimestamp()
     {
         return getTimestamp(std::time(nullptr));
@@ -59,37 +148,47 @@ namespace Utils
      */
     static std::string getCompactTimestamp(const std::time_t& time, const bool utc = true)
     {
-        std::stringstream ss;
-        // gmtime: result expressed as a UTC time
-        tm const* localTime {utc ? gmtime(&time) : localtime(&time)};
-        // Date
-        ss << std::setfill('0') << std::setw(4) << std::to_string(localTime->tm_year + 1900);
-        ss << std::setfill('0') << std::setw(2) << std::to_string(localTime->tm_mon + 1);
-        ss << std::setfill('0') << std::setw(2) << std::to_string(localTime->tm_mday);
-        // Time
-        ss << std::setfill('0') << std::setw(2) << std::to_string(localTime->tm_hour);
-        ss << std::setfill('0') << std::setw(2) << std::to_string(localTime->tm_min);
-        ss << std::setfill('0') << std::setw(2) << std::to_string(localTime->tm_sec);
-        return ss.str();
+        constexpr auto FORMAT {"%04d%02d%02d%02d%02d"};
+        thread_local TimestampCache utcCache {FORMAT, true};
+        thread_local TimestampCache localCache {FORMAT, false};
+
+        int seconds {0};
+        std::string timestamp {(utc ? utcCache : localCache).minute(time, seconds)};
+        appendDigits(timestamp, seconds, 2);
+        return timestamp;
+    }
+
+    /**
+     * @brief Get an ISO 8601 timestamp in UTC.
+     *
+     * @param time Time to convert.
+     * @param milliseconds Milliseconds of the time.
+     * @return std::string Timestamp. Format: "YYYY-MM-DDThh:mm:ss.sssZ".
+     */
+    static std::string getISO8601(const std::time_t& time, const int milliseconds = 0)
+    {
+        thread_local TimestampCache cache {"%04d-%02d-%02dT%02d:%02d:", true};
+
+        int seconds {0};
+        std::string timestamp {cache.minute(time, seconds)};
+        timestamp.reserve(timestamp.size() + 7);
+        appendDigits(timestamp, seconds, 2);
+        timestamp += '.';
+        appendDigits(timestamp, milliseconds, 3);
+        timestamp += 'Z';
+        return timestamp;
     }
 
     static std::string getCurrentISO8601()
     {
         // Get local time in UTC
-        auto now = std::chrono::system_clock::now();
-        auto itt = std::chrono::system_clock::to_time_t(now);
-
-        std::ostringstream ss;
-        ss << std::put_time(gmtime(&itt), "%FT%T");
+        const auto now {std::chrono::system_clock::now()};
 
         // Get milliseconds from the current time
-        auto milliseconds =
-            std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count() % 1000;
-
-        // ISO 8601
-        ss << '.' << std::setfill('0') << std::setw(3) << milliseconds << 'Z';
+        const auto milliseconds {
+            std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count() % 1000};
 
-        return ss.str();
+        return getISO8601(std::chrono::system_clock::to_time_t(now), static_cast<int>(milliseconds));
     }
 
     static std::string timestampToISO8601(const std::string& timestamp)
@@ -103,19 +202,7 @@ namespace Utils
         }
         std::time_t time = std::mktime(&tm);
 
-        auto itt = std::chrono::system_clock::from_time_t(time);
-
-        std::ostringstream output;
-        output << std::put_time(gmtime(&time), "%FT%T");
-
-        // Get milliseconds from the current time
-        auto milliseconds =
-            std::chrono::duration_cast<std::chrono::milliseconds>(itt.time_since_epoch()).count() % 1000;
-
-        // ISO 8601
-        output << '.' << std::setfill('0') << std::setw(3) << milliseconds << 'Z';
-
-        return output.str();
+        return getISO8601(time);
     }
 
     static std::string rawTimestampToISO8601(const std::string& timestamp)
@@ -126,19 +213,8 @@ namespace Utils
         }
 
         std::time_t time = std::stoi(timestamp);
-        auto itt = std::chrono::system_clock::from_time_t(time);
-
-        std::ostringstream output;
-        output << std::put_time(gmtime(&time), "%FT%T");
-
-        // Get milliseconds from the current time
-        auto milliseconds =
-            std::chrono::duration_cast<std::chrono::milliseconds>(itt.time_since_epoch()).count() % 1000;
-
-        // ISO 8601
-        output << '.' << std::setfill('0') << std::setw(3) << milliseconds << 'Z';
 
-        return output.str();
+        return getISO8601(time);
     }
 
     static std::chrono::seconds secondsSinceEpoch()
@@ -0,0 +1,314 @@
+/*
+ * Wazuh shared modules utils
+ * Copyright (C) 2015, Wazuh Inc.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef WORK_STEALING_EXECUTOR_HPP
+#define WORK_STEALING_EXECUTOR_HPP
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Utils
+{
+    /**
+     * @brief Pool of threads, each one with its own deque of tasks.
+     *
+     * @details The tasks submitted from outside the pool are spread round robin over the deques, the ones submitted
+     * by a task go to the deque of its thread. A thread runs the tasks of its deque in order and steals from the
+     * others when it runs out, so the submitters and the threads do not contend on a single lock. The threads sleep
+     * only when there are no tasks left anywhere. The executor can be shared by several dispatchers, see
+     * AsyncDispatcher. The pending tasks are discarded when the executor is destroyed.
+     */
+    class WorkStealingExecutor final
+    {
+        public:
+            using Task = std::function<void()>;
+
+            explicit WorkStealingExecutor(const unsigned int numberOfThreads = std::thread::hardware_concurrency())
+                : m_workers(numberOfThreads ? numberOfThreads : 1)
+                , m_next{ 0 }
+                , m_pending{ 0 }
+                , m_sleeping{ 0 }
+                , m_stop{ false }
+            {
+                m_threads.reserve(m_workers.size());
+
+                for (size_t i = 0; i < m_workers.size(); ++i)
+                {
+                    m_threads.emplace_back(&WorkStealingExecutor::work, this, i);
+                }
+            }
+            WorkStealingExecutor& operator=(const WorkStealingExecutor&) = delete;
+            WorkStealingExecutor(const WorkStealingExecutor&) = delete;
+            ~WorkStealingExecutor()
+            {
+                {
+                    std::lock_guard<std::mutex> lock{ m_sleepMutex };
+                    m_stop = true;
+                }
+                m_wakeUp.notify_all();
+
+                for (auto& thread : m_threads)
+                {
+                    if (thread.joinable())
+                    {
+                        thread.join();
+                    }
+                }
+            }
+
+            /**
+             * @brief Submits a task.
+             *
+             * @param task Task to run.
+             */
+            void submit(Task task)
+            {
+                auto& worker { m_workers[target()] };
+                {
+                    std::lock_guard<std::mutex> lock{ worker.m_mutex };
+                    worker.m_tasks.push_back(std::move(task));
+                }
+                added(1);
+            }
+
+            /**
+             * @brief Submits several tasks at once, taking the lock of each deque once.
+             *
+             * @param tasks Tasks to run, they are split in contiguous chunks over the deques.
+             */
+            void submit(std::vector<Task>&& tasks)
+            {
+                if (tasks.empty())
+                {
+                    return;
+                }
+
+                const auto first { target() };
+                const auto chunks { std::min(tasks.size(), m_workers.size()) };
+                const auto chunkSize { (tasks.size() + chunks - 1) / chunks };
+                auto it { tasks.begin() };
+
+                for (size_t chunk = 0; it != tasks.end(); ++chunk)
+                {
+                    const auto end { tasks.end() - it > static_cast<std::ptrdiff_t>(chunkSize) ? it + chunkSize : tasks.end() };
+                    auto& worker { m_workers[(first + chunk) % m_workers.size()] };
+                    {
+                        std::lock_guard<std::mutex> lock{ worker.m_mutex };
+                        worker.m_tasks.insert(worker.m_tasks.end(), std::make_move_iterator(it), std::make_move_iterator(end));
+                    }
+                    it = end;
+                }
+
+                added(tasks.size());
+                tasks.clear();
+            }
+
+            unsigned int numberOfThreads() const
+            {
+                return static_cast<unsigned int>(m_workers.size());
+            }
+
+            /**
+             * @brief Number of tasks submitted and not started yet.
+             */
+            size_t size() const
+            {
+                return m_pending.load();
+            }
+
+        private:
+            struct alignas(64) Worker
+            {
+                std::mutex m_mutex;
+                std::deque<Task> m_tasks;
+            };
+
+            // Worker of the current thread, to keep the tasks submitted by a task in the same deque
+            static const WorkStealingExecutor*& currentExecutor()
+            {
+                thread_local const WorkStealingExecutor* executor { nullptr };
+                return executor;
+            }
+            static size_t& currentWorker()
+            {
+                thread_local size_t worker { 0 };
+                return worker;
+            }
+
+            size_t target()
+            {
+                if (currentExecutor() == this)
+                {
+                    return currentWorker();
+                }
+
+                return m_next.fetch_add(1, std::memory_order_relaxed) % m_workers.size();
+            }
+
+            void added(const size_t count)
+            {
+                // Pairs with the check of m_pending of the sleeping threads, see work
+                m_pending.fetch_add(count);
+
+                if (m_sleeping.load() > 0)
+                {
+                    {
+                        std::lock_guard<std::mutex> lock{ m_sleepMutex };
+                    }
+
+                    if (count > 1)
+                    {
+                        m_wakeUp.notify_all();
+                    }
+                    else
+                    {
+                        m_wakeUp.notify_one();
+                    }
+                }
+            }
+
+            bool take(const size_t index, Task& task)
+            {
+                // Own deque in order, then the newest task of the others
+                for (size_t i = 0; i < m_workers.size(); ++i)
+                {
+                    auto& worker { m_workers[(index + i) % m_workers.size()] };
+                    std::lock_guard<std::mutex> lock{ worker.m_mutex };
+
+                    if (!worker.m_tasks.empty())
+                    {
+                        if (0 == i)
+                        {
+                            task = std::move(worker.m_tasks.front());
+                            worker.m_tasks.pop_front();
+                        }
+                        else
+                        {
+                            task = std::move(worker.m_tasks.back());
+                            worker.m_tasks.pop_back();
+                        }
+
+                        return true;
+                    }
+                }
+
+                return false;
+            }
+
+            void work(const size_t index)
+            {
+                currentExecutor() = this;
+                currentWorker() = index;
+
+                while (true)
+                {
+                    Task task;
+
+                    if (take(index, task))
+                    {
+                        m_pending.fetch_sub(1);
+
+                        try
+                        {
+                            task();
+                        }
+                        catch (const std::exception& ex)
+                        {
+                            std::cerr << "Dispatch handler error, " << ex.what() << std::endl;
+                        }
+
+                        continue;
+                    }
+
+                    std::unique_lock<std::mutex> lock{ m_sleepMutex };
+                    ++m_sleeping;
+                    m_wakeUp.wait(lock, [this]()
+                    {
+                        return m_stop || m_pending.load() > 0;
+                    });
+                    --m_sleeping;
+
+                    if (m_stop)
+                    {
+                        break;
+                    }
+                }
+            }
+
+            std::vector<Worker> m_workers;
+            std::vector<std::thread> m_threads;
+            std::atomic<size_t> m_next;
+            std::atomic<size_t> m_pending;
+            std::atomic<size_t> m_sleeping;
+            std::mutex m_sleepMutex;
+            std::condition_variable m_wakeUp;
+            bool m_stop;
+    };
+
+    /**
+     * @brief Counter of the tasks that a client submitted to a shared executor, to wait for them to finish.
+     *
+     * @details The tasks must keep the group alive (e.g. capturing a shared_ptr), the last done may still be
+     * notifying when wait returns.
+     */
+    class TaskGroup final
+    {
+        public:
+            TaskGroup()
+                : m_count{ 0 }
+            {
+            }
+
+            void add(const size_t count = 1)
+            {
+                m_count.fetch_add(count);
+            }
+
+            void done()
+            {
+                if (1 == m_count.fetch_sub(1))
+                {
+                    std::lock_guard<std::mutex> lock{ m_mutex };
+                    m_finished.notify_all();
+                }
+            }
+
+            /**
+             * @brief Blocks until every task added is done.
+             */
+            void wait()
+            {
+                std::unique_lock<std::mutex> lock{ m_mutex };
+                m_finished.wait(lock, [this]()
+                {
+                    return 0 == m_count.load();
+                });
+            }
+
+            size_t size() const
+            {
+                return m_count.load();
+            }
+
+        private:
+            std::atomic<size_t> m_count;
+            std::mutex m_mutex;
+            std::condition_variable m_finished;
+    };
+}//namespace Utils
+
+#endif //WORK_STEALING_EXECUTOR_HPP
@@ -0,0 +1,73 @@
+/*
+ * Wazuh - Shared Modules utils
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _CALLBACK_DATA_COLLECTOR_HPP
+#define _CALLBACK_DATA_COLLECTOR_HPP
+
+#include "iDataCollector.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace Xz
+{
+    /**
+     * @brief Callback receiving each chunk of output data.
+     *
+     */
+    using DataCallback = std::function<void(const uint8_t*, size_t)>;
+
+    /**
+     * @brief Hands each chunk of output data to a callback, without keeping it
+     *
+     */
+    class CallbackDataCollector : public IDataCollector
+    {
+        static constexpr size_t DEFAULT_BUFFER_SIZE {65536}; ///< Default buffer size
+        DataCallback m_callback;                             ///< Callback receiving the output data
+        std::vector<uint8_t> m_buffer; ///< Buffer used to receive the data that will be handed to the callback
+
+    public:
+        /**
+         * @brief Construct a new Callback Data Collector object
+         *
+         * @param callback Callback called with each chunk of output data
+         * @param bufferSize Size to give to the receiving buffer, and maximum size of each chunk
+         */
+        explicit CallbackDataCollector(DataCallback callback, size_t bufferSize = DEFAULT_BUFFER_SIZE)
+            : m_callback(std::move(callback))
+        {
+            m_buffer.resize(bufferSize);
+        }
+
+        /*! @copydoc IDataCollector::begin() */
+        void begin() override {}
+
+        /*! @copydoc IDataCollector::setBuffer() */
+        void setBuffer(uint8_t** buffer, size_t& buffSize) override
+        {
+            *buffer = m_buffer.data();
+            buffSize = m_buffer.size();
+        }
+
+        /*! @copydoc IDataCollector::dataReady() */
+        void dataReady(size_t unusedBufferLen) override
+        {
+            if (const auto newDataQty {m_buffer.size() - unusedBufferLen}; newDataQty > 0)
+            {
+                m_callback(m_buffer.data(), newDataQty);
+            }
+        }
+    };
+} // namespace Xz
+#endif // _CALLBACK_DATA_COLLECTOR_HPP
@@ -8,6 +8,7 @@
 #ifndef _XZ_HELPER_HPP
 #define _XZ_HELPER_HPP
 
+#include "xz/callbackDataCollector.hpp"
 #include "xz/fileDataCollector.hpp"
 #include "xz/fileDataProvider.hpp"
 #include "xz/iDataCollector.hpp"
@@ -128,6 +129,23 @@ namespace Utils
         {
         }
 
+        /**
+         * @brief Construct XZ helper with file input and streamed output, so the data can be consumed while it's
+         * decompressed, without storing it.
+         *
+         * @param source Path to input file
+         * @param dest Callback called with each chunk of output data
+         * @param threadCount  Number of worker threads. 0 uses all the available threads.
+         */
+        XzHelper(const std::filesystem::path& source,
+                 Xz::DataCallback dest,
+                 uint32_t threadCount = Xz::DEFAULT_THREAD_COUNT)
+            : m_spDataProvider(std::make_unique<Xz::FileDataProvider>(source))
+            , m_spDataCollector(std::make_unique<Xz::CallbackDataCollector>(std::move(dest)))
+            , m_threadCount(threadCount)
+        {
+        }
+
         /**
          * @brief Compress the input data
          *
@@ -18,6 +18,7 @@
 #include "stringHelper.h"
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -50,6 +51,45 @@ namespace Utils
         ZlibHelper(ZlibHelper&&) = delete;
         ZlibHelper& operator=(ZlibHelper&&) = delete;
 
+        /**
+         * @brief Compress data in GZIP format, e.g. to send it as a gzip encoded HTTP body.
+         *
+         * @param data Data to compress.
+         * @param level Compression level, from 0 (no compression) to 9 (best compression).
+         * @return std::string Compressed data.
+         */
+        static std::string gzipCompress(const std::string& data, const int level = Z_DEFAULT_COMPRESSION)
+        {
+            z_stream stream {};
+
+            // Adding 16 to the window bits writes the gzip header and trailer instead of the zlib ones.
+            constexpr auto GZIP_WINDOW_BITS {MAX_WBITS + 16};
+            constexpr auto DEFAULT_MEM_LEVEL {8};
+            if (deflateInit2(&stream, level, Z_DEFLATED, GZIP_WINDOW_BITS, DEFAULT_MEM_LEVEL, Z_DEFAULT_STRATEGY) !=
+                Z_OK)
+            {
+                throw std::runtime_error("Unable to initialize the GZIP compression");
+            }
+            DEFER([&stream]() { deflateEnd(&stream); });
+
+            // The bound is enough to compress the whole data in a single call.
+            std::string output(deflateBound(&stream, data.size()), '\0');
+            stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+            stream.avail_in = data.size();
+            stream.next_out = reinterpret_cast<Bytef*>(output.data());
+            stream.avail_out = output.size();
+
+            if (deflate(&stream, Z_FINISH) != Z_STREAM_END)
+            {
+                // LCOV_EXCL_START
+                throw std::runtime_error("Unable to compress the data in GZIP format");
+                // LCOV_EXCL_STOP
+            }
+            output.resize(stream.total_out);
+
+            return output;
+        }
+
         /**
          * @brief Uncompress GZIP file.
          *
@@ -71,6 +111,36 @@ namespace Utils
                 throw std::runtime_error("Unable to create destination file: " + outputFilePath.string());
             }
 
+            gzipDecompress(gzFilePath,
+                           [&outputFile, &outputFilePath](const char* data, size_t size)
+                           {
+                               if (outputFile.write(data, size).bad())
+                               {
+                                   // LCOV_EXCL_START
+                                   throw std::runtime_error("Unable to write to destination file: " +
+                                                            outputFilePath.string());
+                                   // LCOV_EXCL_STOP
+                               }
+                           });
+            outputFile.close();
+        }
+
+        /**
+         * @brief Uncompress GZIP file chunk by chunk, so the data can be consumed while it's decompressed, without
+         * storing it.
+         *
+         * @param gzFilePath Compressed (.gz) file path.
+         * @param onData Callback called with each chunk of uncompressed data.
+         */
+        static void gzipDecompress(const std::filesystem::path& gzFilePath,
+                                   const std::function<void(const char*, size_t)>& onData)
+        {
+            // Check input file extension.
+            if (gzFilePath.extension() != ".gz")
+            {
+                throw std::runtime_error("Input file " + gzFilePath.string() + " doesn't have .gz extension");
+            }
+
             // Open compressed file.
             ZFilePtr gzFile {gzopen(gzFilePath.c_str(), "rb")};
             if (!gzFile)
@@ -86,17 +156,9 @@ namespace Utils
 
                 if (len > 0)
                 {
-                    if (outputFile.write(buf, len).bad())
-                    {
-                        // LCOV_EXCL_START
-                        throw std::runtime_error("Unable to write to destination file: " + outputFilePath.string());
-                        // LCOV_EXCL_STOP
-                    }
-
-                    buf[0] = '\0';
+                    onData(buf, len);
                 }
             } while (len == sizeof(buf));
-            outputFile.close();
         }
 
         /**
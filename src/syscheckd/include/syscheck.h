@@ -104,9 +104,31 @@ typedef struct create_json_event_ctx {
     const directory_t* config;
 } create_json_event_ctx;
 
+// Files queued by the scheduled scans before they are hashed, when there are several scan threads
+#define FIM_SCAN_BATCH_SIZE 256
+
+// Size of the events of a directory sent in a single message by the scheduled scans
+#define FIM_BATCH_MAX_SIZE (OS_MAXSTR / 2)
+
+typedef struct fim_pending_file_s {
+    char *path;
+    const directory_t *configuration;
+    struct stat statbuf;
+    fim_file_data *stored;      // Data stored in the DB, if its hashes can be reused
+    fim_file_data *data;
+} fim_pending_file_t;
+
+typedef struct fim_file_batch_s {
+    fim_pending_file_t files[FIM_SCAN_BATCH_SIZE];
+    size_t count;       // Files queued
+    size_t next;        // Next file to hash
+    size_t hashed;      // Files hashed
+} fim_file_batch_t;
+
 typedef struct fim_txn_context_s {
     event_data_t* evt_data;
     fim_entry* latest_entry;
+    fim_file_batch_t* pending_files;    // Files waiting to be hashed, NULL if the scan hashes them one by one
 } fim_txn_context_t;
 
 #ifdef WIN32
@@ -433,6 +455,22 @@ void free_whodata_event(whodata_evt *w_evt);
  */
 void send_syscheck_msg(const cJSON *msg) __attribute__((nonnull));
 
+/**
+ * @brief Add an event of a scheduled scan to the batch of its directory
+ *
+ * The events of a directory are sent together as an "event_batch" message, that holds the directory once and the
+ * old values of the changed attributes only. The batch is sent when an event of another directory arrives, when it
+ * reaches syscheck.event_batch events and on fim_batch_flush().
+ *
+ * @param event The event to be sent
+ */
+void fim_batch_event(const cJSON *event) __attribute__((nonnull));
+
+/**
+ * @brief Send the events batched by fim_batch_event()
+ */
+void fim_batch_flush();
+
 
 // TODO
 /**
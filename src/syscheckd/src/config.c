@@ -526,6 +526,8 @@ cJSON *getSyscheckInternalOptions(void) {
     cJSON *rootcheckd = cJSON_CreateObject();
 
     cJSON_AddNumberToObject(rootcheckd,"sleep",rootcheck.tsleep);
+    cJSON_AddNumberToObject(rootcheckd,"threads",rootcheck.threads);
+    cJSON_AddNumberToObject(rootcheckd,"io_idle",rootcheck.io_idle);
     cJSON_AddItemToObject(internals,"rootcheck",rootcheckd);
     cJSON_AddItemToObject(root,"internal",internals);
 
@@ -31,6 +31,7 @@ extern void mock_assert(const int result, const char* const expression,
 
 // Global variables
 static int _base_line = 0;
+static unsigned int _scan_number = 0;
 
 static const char *FIM_EVENT_TYPE_ARRAY[] = {
     "added",
@@ -423,7 +424,11 @@ static void transaction_callback(ReturnTypeCallback resultType, const cJSON* res
         cJSON_AddStringToObject(data, "tags", configuration->tag);
     }
 
-    send_syscheck_msg(json_event);
+    if (syscheck.event_batch > 0 && txn_context->evt_data->mode == FIM_SCHEDULED) {
+        fim_batch_event(json_event);
+    } else {
+        send_syscheck_msg(json_event);
+    }
 
 end:
     os_free(diff);
@@ -473,6 +478,233 @@ int fim_generate_delete_event(const char *file_path,
     return fim_db_get_path(file_path, callback_data);
 }
 
+static fim_file_data *fim_get_file_data(const char *file,
+                                        const directory_t *configuration,
+                                        const struct stat *statbuf,
+                                        const fim_file_data *stored);
+
+/**
+ * @brief Callback that copies the metadata and the hashes of a file stored in the DB.
+ *
+ * @param data The fim_entry of the file.
+ * @param ctx The fim_file_data where the data is copied.
+ */
+static void fim_copy_stored_data(void *data, void *ctx) {
+    const fim_file_data *entry_data = ((fim_entry *)data)->file_entry.data;
+    fim_file_data *stored = (fim_file_data *)ctx;
+
+    stored->size = entry_data->size;
+    stored->mtime = entry_data->mtime;
+    stored->inode = entry_data->inode;
+    stored->dev = entry_data->dev;
+    stored->options = entry_data->options;
+    snprintf(stored->hash_md5, sizeof(os_md5), "%s", entry_data->hash_md5);
+    snprintf(stored->hash_sha1, sizeof(os_sha1), "%s", entry_data->hash_sha1);
+    snprintf(stored->hash_sha256, sizeof(os_sha256), "%s", entry_data->hash_sha256);
+}
+
+/**
+ * @brief Get the data stored in the DB of a file found by a scheduled scan, so its hashes can be reused if the file
+ * didn't change. Each scan rotates through a fraction of the files, which are always rehashed.
+ *
+ * @param path Path of the file.
+ * @param configuration Configuration of the file.
+ * @return The stored data, NULL if the file must be hashed.
+ */
+static fim_file_data *fim_get_stored_data(const char *path, const directory_t *configuration) {
+    fim_file_data *stored = NULL;
+    callback_context_t callback_data;
+    unsigned int path_hash = 0;
+    const char *it;
+
+    if (syscheck.full_hash_interval <= 1 ||
+        (configuration->options & (CHECK_SIZE | CHECK_MTIME)) != (CHECK_SIZE | CHECK_MTIME) ||
+        (configuration->options & (CHECK_MD5SUM | CHECK_SHA1SUM | CHECK_SHA256SUM)) == 0) {
+        return NULL;
+    }
+
+    for (it = path; *it != '\0'; it++) {
+        path_hash = path_hash * 31 + (unsigned char)*it;
+    }
+
+    if ((path_hash + _scan_number) % syscheck.full_hash_interval == 0) {
+        return NULL;
+    }
+
+    os_calloc(1, sizeof(fim_file_data), stored);
+    callback_data.callback = fim_copy_stored_data;
+    callback_data.context = stored;
+
+    if (fim_db_get_path(path, callback_data) != FIMDB_OK) {
+        os_free(stored);
+    }
+
+    return stored;
+}
+
+/* The scan thread walks the directories and queues the files, the hash workers and the scan thread itself hash
+ * the files of the batch, and then the scan thread syncs them with the DB in order. */
+static struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t available;
+    pthread_cond_t finished;
+    fim_file_batch_t *batch;
+    unsigned int workers;
+} fim_hash_pool = {
+    .mutex = PTHREAD_MUTEX_INITIALIZER,
+    .available = PTHREAD_COND_INITIALIZER,
+    .finished = PTHREAD_COND_INITIALIZER,
+    .batch = NULL,
+    .workers = 0
+};
+
+/**
+ * @brief Hash the next file of a batch, if any is left.
+ *
+ * @param batch Batch of files. The pool mutex must be locked, it's unlocked while the file is hashed.
+ * @return true if a file was hashed.
+ */
+static bool fim_hash_next_file(fim_file_batch_t *batch) {
+    fim_pending_file_t *file;
+
+    if (batch->next >= batch->count) {
+        return false;
+    }
+
+    file = &batch->files[batch->next++];
+
+    w_mutex_unlock(&fim_hash_pool.mutex);
+    file->data = fim_get_file_data(file->path, file->configuration, &file->statbuf, file->stored);
+    w_mutex_lock(&fim_hash_pool.mutex);
+
+    if (++batch->hashed == batch->count) {
+        w_cond_signal(&fim_hash_pool.finished);
+    }
+
+    return true;
+}
+
+#ifdef WIN32
+static DWORD WINAPI fim_hash_worker(__attribute__((unused)) void *args) {
+#else
+static void *fim_hash_worker(__attribute__((unused)) void *args) {
+#endif
+    w_mutex_lock(&fim_hash_pool.mutex);
+
+    while (FOREVER()) {
+        if (fim_hash_pool.batch == NULL || !fim_hash_next_file(fim_hash_pool.batch)) {
+            w_cond_wait(&fim_hash_pool.available, &fim_hash_pool.mutex);
+        }
+    }
+
+    w_mutex_unlock(&fim_hash_pool.mutex);
+
+#ifdef WIN32
+    return 0;
+#else
+    return NULL;
+#endif
+}
+
+/**
+ * @brief Start the hash workers. The scan thread hashes files too, so there is one worker less than scan threads.
+ * The workers are kept for the next scans.
+ */
+static void fim_hash_pool_start() {
+    while (fim_hash_pool.workers + 1 < syscheck.scan_threads) {
+#ifndef WIN32
+        w_create_thread(fim_hash_worker, NULL);
+#else
+        if (CreateThread(NULL, 0, fim_hash_worker, NULL, 0, NULL) == NULL) {
+            merror(THREAD_ERROR);
+            break;
+        }
+#endif
+        fim_hash_pool.workers++;
+    }
+}
+
+/**
+ * @brief Hash the queued files and sync them with the DB in the order they were found.
+ *
+ * @param txn_handle DBSync transaction of the scan.
+ * @param txn_context Transaction context, with the queued files.
+ */
+static void fim_flush_pending_files(TXN_HANDLE txn_handle, fim_txn_context_t *txn_context) {
+    fim_file_batch_t *batch = txn_context->pending_files;
+    fim_entry new_entry;
+    size_t i;
+
+    if (batch == NULL || batch->count == 0) {
+        return;
+    }
+
+    w_mutex_lock(&fim_hash_pool.mutex);
+    fim_hash_pool.batch = batch;
+    w_cond_broadcast(&fim_hash_pool.available);
+
+    while (fim_hash_next_file(batch));
+
+    while (batch->hashed < batch->count) {
+        w_cond_wait(&fim_hash_pool.finished, &fim_hash_pool.mutex);
+    }
+    fim_hash_pool.batch = NULL;
+    w_mutex_unlock(&fim_hash_pool.mutex);
+
+    for (i = 0; i < batch->count; i++) {
+        fim_pending_file_t *file = &batch->files[i];
+
+        if (file->data == NULL) {
+            mdebug1(FIM_GET_ATTRIBUTES, file->path);
+        } else {
+            new_entry.type = FIM_TYPE_FILE;
+            new_entry.file_entry.path = file->path;
+            new_entry.file_entry.data = file->data;
+
+            txn_context->latest_entry = &new_entry;
+            fim_db_transaction_sync_row(txn_handle, &new_entry);
+            free_file_data(file->data);
+            txn_context->latest_entry = NULL;
+        }
+
+        os_free(file->path);
+        os_free(file->stored);
+        file->data = NULL;
+    }
+
+    batch->count = 0;
+    batch->next = 0;
+    batch->hashed = 0;
+}
+
+/**
+ * @brief Queue a file of a scheduled scan to be hashed, the batch is flushed when it's full.
+ *
+ * @param path Path of the file.
+ * @param configuration Configuration of the file.
+ * @param statbuf Attributes of the file.
+ * @param txn_handle DBSync transaction of the scan.
+ * @param txn_context Transaction context, with the queued files.
+ */
+static void fim_queue_file(const char *path,
+                           const directory_t *configuration,
+                           const struct stat *statbuf,
+                           TXN_HANDLE txn_handle,
+                           fim_txn_context_t *txn_context) {
+    fim_file_batch_t *batch = txn_context->pending_files;
+    fim_pending_file_t *file = &batch->files[batch->count++];
+
+    os_strdup(path, file->path);
+    file->configuration = configuration;
+    file->statbuf = *statbuf;
+    file->stored = fim_get_stored_data(path, configuration);
+    file->data = NULL;
+
+    if (batch->count == FIM_SCAN_BATCH_SIZE) {
+        fim_flush_pending_files(txn_handle, txn_context);
+    }
+}
+
 time_t fim_scan() {
     struct timespec start;
     struct timespec end;
@@ -482,7 +714,7 @@ time_t fim_scan() {
     OSListNode *node_it;
     directory_t *dir_it;
     event_data_t evt_data = { .report_event = true, .mode = FIM_SCHEDULED, .w_evt = NULL };
-    fim_txn_context_t txn_ctx = { .evt_data = &evt_data, .latest_entry = NULL };
+    fim_txn_context_t txn_ctx = { .evt_data = &evt_data, .latest_entry = NULL, .pending_files = NULL };
 
     static fim_state_db _files_db_state = FIM_STATE_DB_EMPTY;
 #ifdef WIN32
@@ -497,6 +729,7 @@ time_t fim_scan() {
     gettime(&start);
     minfo(FIM_FREQUENCY_STARTED);
     fim_send_scan_info(FIM_SCAN_START);
+    _scan_number++;
 
 
     TXN_HANDLE db_transaction_handle = fim_db_transaction_start(FIMDB_FILE_TXN_TABLE, transaction_callback, &txn_ctx);
@@ -504,6 +737,11 @@ time_t fim_scan() {
         merror(FIM_ERROR_TRANSACTION, FIMDB_FILE_TXN_TABLE);
         return time(NULL);
     }
+    if (syscheck.scan_threads > 1) {
+        fim_hash_pool_start();
+        os_calloc(1, sizeof(fim_file_batch_t), txn_ctx.pending_files);
+    }
+
     fim_diff_folder_size();
     syscheck.disk_quota_full_msg = true;
 
@@ -519,6 +757,7 @@ time_t fim_scan() {
         char *path = fim_get_real_path(dir_it);
 
         fim_checker(path, &evt_data, dir_it, db_transaction_handle, &txn_ctx);
+        fim_flush_pending_files(db_transaction_handle, &txn_ctx);
 
 #ifndef WIN32
         realtime_adddir(path, dir_it);
@@ -554,6 +793,7 @@ time_t fim_scan() {
             path = fim_get_real_path(dir_it);
 
             fim_checker(path, &evt_data, dir_it, db_transaction_handle, &txn_ctx);
+            fim_flush_pending_files(db_transaction_handle, &txn_ctx);
 
             // Verify the directory is being monitored correctly
 #ifndef WIN32
@@ -573,6 +813,12 @@ time_t fim_scan() {
         db_transaction_handle = NULL;
     }
 
+    os_free(txn_ctx.pending_files);
+
+    if (syscheck.event_batch > 0) {
+        fim_batch_flush();
+    }
+
 #ifdef WIN32
     fim_registry_scan();
 #endif
@@ -880,12 +1126,23 @@ void fim_file(const char *path,
     assert(evt_data != NULL);
 
     fim_entry new_entry;
+    fim_file_data *stored = NULL;
 
     check_max_fps();
 
+    if (txn_handle != NULL && txn_context->pending_files != NULL) {
+        fim_queue_file(path, configuration, &(evt_data->statbuf), txn_handle, txn_context);
+        return;
+    }
+
+    if (txn_handle != NULL) {
+        stored = fim_get_stored_data(path, configuration);
+    }
+
     new_entry.type = FIM_TYPE_FILE;
     new_entry.file_entry.path = (char *)path;
-    new_entry.file_entry.data = fim_get_data(path, configuration, &(evt_data->statbuf));
+    new_entry.file_entry.data = fim_get_file_data(path, configuration, &(evt_data->statbuf), stored);
+    os_free(stored);
 
     if (new_entry.file_entry.data == NULL) {
         mdebug1(FIM_GET_ATTRIBUTES, path);
@@ -1242,6 +1499,23 @@ int fim_check_depth(const char *path, const directory_t *configuration) {
 
 // Get data from file
 fim_file_data *fim_get_data(const char *file, const directory_t *configuration, const struct stat *statbuf) {
+    return fim_get_file_data(file, configuration, statbuf, NULL);
+}
+
+/**
+ * @brief Get data from file, reusing the hashes stored in the DB if the file didn't change.
+ *
+ * @param file Name of the file to get the data from
+ * @param [in] configuration Configuration block associated with a previous event.
+ * @param [in] statbuf Buffer acquired from a stat command with information linked to 'path'
+ * @param [in] stored Data of the file stored in the DB, NULL to always hash the file
+ *
+ * @return A fim_file_data structure with the data from the file
+ */
+static fim_file_data *fim_get_file_data(const char *file,
+                                        const directory_t *configuration,
+                                        const struct stat *statbuf,
+                                        const fim_file_data *stored) {
     fim_file_data * data = NULL;
 
     os_calloc(1, sizeof(fim_file_data), data);
@@ -1313,9 +1587,17 @@ fim_file_data *fim_get_data(const char *file, const directory_t *configuration,
     // The file exists and we don't have to delete it from the hash tables
     data->scanned = 1;
 
+    // Reuse the hashes if the size, modification time, inode and device didn't change since the file was hashed.
     // We won't calculate hash for symbolic links, empty or large files
-    if (S_ISREG(statbuf->st_mode) && (statbuf->st_size > 0 && (size_t)statbuf->st_size < syscheck.file_max_size) &&
-        (configuration->options & (CHECK_MD5SUM | CHECK_SHA1SUM | CHECK_SHA256SUM))) {
+    if (stored != NULL && stored->options == configuration->options && stored->size == data->size &&
+        stored->mtime == data->mtime && stored->inode == (unsigned long long int)statbuf->st_ino &&
+        stored->dev == (unsigned long int)statbuf->st_dev) {
+        snprintf(data->hash_md5, sizeof(os_md5), "%s", stored->hash_md5);
+        snprintf(data->hash_sha1, sizeof(os_sha1), "%s", stored->hash_sha1);
+        snprintf(data->hash_sha256, sizeof(os_sha256), "%s", stored->hash_sha256);
+    } else if (S_ISREG(statbuf->st_mode) &&
+               (statbuf->st_size > 0 && (size_t)statbuf->st_size < syscheck.file_max_size) &&
+               (configuration->options & (CHECK_MD5SUM | CHECK_SHA1SUM | CHECK_SHA256SUM))) {
         if (OS_MD5_SHA1_SHA256_File(file, syscheck.prefilter_cmd, data->hash_md5,
                                     data->hash_sha1, data->hash_sha256, OS_BINARY, syscheck.file_max_size) < 0) {
             mdebug1(FIM_HASHES_FAIL, file);
@@ -137,6 +137,20 @@ EXPORTED int fim_db_get_count_file_entry();
 EXPORTED FIMDBErrorCode fim_db_file_update(fim_entry* data,
                                            callback_context_t callback);
 
+/**
+ * @brief Makes any necessary queries to get a batch of entries of the same directory updated in the DB, with a
+ * single dbsync operation.
+ *
+ * @param data Array with the information linked to the paths to be created or updated, with different paths.
+ * @param count Number of entries in the array.
+ * @param callback Callback to send the fim message of each entry that changed.
+ *
+ * @return FIMDB_OK on success.
+ */
+EXPORTED FIMDBErrorCode fim_db_file_update_batch(fim_entry* data,
+                                                 size_t count,
+                                                 callback_context_t callback);
+
 /**
  * @brief Find entries using the inode.
  *
@@ -14,6 +14,7 @@
 #include "db.h"
 #include <string.h>
 #include <functional>
+#include <vector>
 #include <json.hpp>
 
 // Define EXPORTED for any platform
@@ -170,6 +171,17 @@ class EXPORTED DB final
                         create_json_event_ctx* ctx,
                         std::function<void(nlohmann::json)> callbackPrimitive);
 
+        /**
+        * @brief updateFiles Update/insert a batch of files of the same directory in the database.
+        *
+        * @param files File entries/data to update/insert, with different paths.
+        * @param ctx Context struct with data related to the fim_entries.
+        * @param callback Callback to send the fim message of each file that changed.
+        */
+        void updateFiles(const std::vector<nlohmann::json>& files,
+                         create_json_event_ctx* ctx,
+                         std::function<void(nlohmann::json)> callbackPrimitive);
+
         /**
         * @brief searchFiles Search files in the database.
         *
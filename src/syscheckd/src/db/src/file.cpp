@@ -16,6 +16,7 @@
 #include "fimDB.hpp"
 #include "dbFileItem.hpp"
 #include "cjsonSmartDeleter.hpp"
+#include <unordered_map>
 
 static const char* FIM_EVENT_TYPE_ARRAY[] =
 {
@@ -31,6 +32,12 @@ static const char* FIM_EVENT_MODE[] =
     "whodata"
 };
 
+// Filters of the lookups run for every realtime and whodata event. Their values are bound, so the SQL doesn't change
+// between calls and each statement is prepared once.
+constexpr auto FILE_PATH_FILTER { "WHERE path=?" };
+constexpr auto FILE_PATH_PATTERN_FILTER { "WHERE path LIKE ?" };
+constexpr auto FILE_INODE_FILTER { "WHERE inode=? AND dev=?" };
+
 enum SEARCH_FIELDS
 {
     SEARCH_FIELD_TYPE,
@@ -363,7 +370,8 @@ void DB::getFile(const std::string& path, std::function<void(const nlohmann::jso
             "hash_sha1",
             "hash_sha256",
             "mtime"})
-        .rowFilter(std::string("WHERE path=\"") + std::string(path) + "\"")
+        .rowFilter(FILE_PATH_FILTER)
+        .rowFilterParams(nlohmann::json::array({path}))
         .orderByOpt(FILE_PRIMARY_KEY)
         .distinctOpt(false)
         .countOpt(100)
@@ -412,18 +420,54 @@ void DB::updateFile(const nlohmann::json& file, create_json_event_ctx* ctx, std:
     return;
 }
 
+void DB::updateFiles(const std::vector<nlohmann::json>& files,
+                     create_json_event_ctx* ctx,
+                     std::function<void(nlohmann::json)> callbackPrimitive)
+{
+    std::unordered_map<std::string, const nlohmann::json*> filesByPath;
+
+    for (const auto& file : files)
+    {
+        filesByPath[file.at("data").front().at("path")] = &file;
+    }
+
+    const auto callback
+    {
+        [&filesByPath, callbackPrimitive, ctx, this](ReturnTypeCallback type, const nlohmann::json resultJson)
+        {
+            if (ctx->event->report_event)
+            {
+                // The modified rows are returned with their old data.
+                const auto& row { resultJson.contains("new") ? resultJson.at("new") : resultJson };
+                const auto it { filesByPath.find(row.at("path")) };
+
+                if (it != filesByPath.end())
+                {
+                    callbackPrimitive(createJsonEvent(*it->second, resultJson, type, ctx));
+                }
+            }
+        }
+    };
+
+    FIMDB::instance().updateItems(files, callback);
+}
+
 void DB::searchFile(const SearchData& data, std::function<void(const std::string&)> callback)
 {
     const auto searchType { std::get<SEARCH_FIELD_TYPE>(data) };
     std::string filter;
+    nlohmann::json parameters;
 
     if (SEARCH_TYPE_INODE == searchType)
     {
-        filter = "WHERE inode=" + std::get<SEARCH_FIELD_INODE>(data) + " AND dev=" + std::get<SEARCH_FIELD_DEV>(data);
+        filter = FILE_INODE_FILTER;
+        parameters.push_back(std::stoull(std::get<SEARCH_FIELD_INODE>(data)));
+        parameters.push_back(std::stoull(std::get<SEARCH_FIELD_DEV>(data)));
     }
     else if (SEARCH_TYPE_PATH == searchType)
     {
-        filter = "WHERE path LIKE \"" + std::get<SEARCH_FIELD_PATH>(data) + "\"";
+        filter = FILE_PATH_PATTERN_FILTER;
+        parameters.push_back(std::get<SEARCH_FIELD_PATH>(data));
     }
     else
     {
@@ -436,6 +480,7 @@ void DB::searchFile(const SearchData& data, std::function<void(const std::string
         .table(FIMDB_FILE_TABLE_NAME)
         .columnList({"path"})
         .rowFilter(filter)
+        .rowFilterParams(parameters)
         .orderByOpt(FILE_PRIMARY_KEY)
         .distinctOpt(false)
         .build()
@@ -598,6 +643,51 @@ FIMDBErrorCode fim_db_file_update(fim_entry* data, callback_context_t callback)
     return retVal;
 }
 
+FIMDBErrorCode fim_db_file_update_batch(fim_entry* data, size_t count, callback_context_t callback)
+{
+    auto retVal { FIMDB_ERR };
+
+    if (!data || !callback.callback)
+    {
+        FIMDB::instance().logFunction(LOG_ERROR, "Invalid parameters");
+    }
+    else
+    {
+        try
+        {
+            std::vector<nlohmann::json> files;
+            files.reserve(count);
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                const auto file { std::make_unique<FileItem>(&data[i], true) };
+                files.push_back(*file->toJSON());
+            }
+
+            create_json_event_ctx* ctx { reinterpret_cast<create_json_event_ctx*>(callback.context)};
+            DB::instance().updateFiles(files, ctx, [callback](const nlohmann::json jsonResult)
+            {
+                const std::unique_ptr<cJSON, CJsonSmartDeleter> spJson{ cJSON_Parse(jsonResult.dump().c_str()) };
+                callback.callback(spJson.get(), callback.context);
+            });
+            retVal = FIMDB_OK;
+        }
+        // LCOV_EXCL_START
+        catch (DbSync::max_rows_error& max_row)
+        {
+            FIMDB::instance().logFunction(LOG_WARNING, "Reached maximum files limit monitored, due to db_entry_limit configuration for files.");
+        }
+        catch (std::exception& err)
+        {
+            FIMDB::instance().logFunction(LOG_ERROR, err.what());
+        }
+
+        // LCOV_EXCL_STOP
+    }
+
+    return retVal;
+}
+
 FIMDBErrorCode fim_db_file_inode_search(const unsigned long long int inode,
                                         const unsigned long dev,
                                         callback_context_t callback)
@@ -131,6 +131,38 @@ void FIMDB::updateItem(const nlohmann::json& item, ResultCallbackData callbackDa
     }
 }
 
+void FIMDB::updateItems(const std::vector<nlohmann::json>& items, ResultCallbackData callbackData)
+{
+    if (items.empty())
+    {
+        return;
+    }
+
+    // The rows are synced with one statement, so dbsync locks the database and loads the table metadata once.
+    auto statement { items.front() };
+    auto& data { statement.at("data") };
+
+    for (auto it = std::next(items.begin()); it != items.end(); ++it)
+    {
+        if (it->at("table") != statement.at("table"))
+        {
+            throw std::runtime_error { "The items of a batch must belong to the same table" };
+        }
+
+        for (const auto& row : it->at("data"))
+        {
+            data.push_back(row);
+        }
+    }
+
+    std::shared_lock<std::shared_timed_mutex> lock(m_handlersMutex);
+
+    if (!m_stopping)
+    {
+        m_dbsyncHandler->syncRow(statement, callbackData);
+    }
+}
+
 void FIMDB::executeQuery(const nlohmann::json& item, ResultCallbackData callbackData)
 {
     m_dbsyncHandler->selectRows(item, callbackData);
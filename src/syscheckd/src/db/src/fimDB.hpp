@@ -18,6 +18,7 @@
 #include <mutex>
 #include <thread>
 #include <shared_mutex>
+#include <vector>
 
 #ifdef __cplusplus
 extern "C"
@@ -155,6 +156,17 @@ class FIMDB
         void updateItem(const nlohmann::json& item,
                         ResultCallbackData callbackData);
 
+        /**
+         * @brief Update a batch of items in the database, or insert them if they don't exist, with a single dbsync
+         *        operation, then uses the callbackData for the rows that changed.
+         *
+         * @param items json items that represent the fim_entry data, of the same table. The options of the first
+         *              item are used for all of them.
+         * @param callbackData Pointer to the callback used after update rows
+         */
+        void updateItems(const std::vector<nlohmann::json>& items,
+                         ResultCallbackData callbackData);
+
         /**
          * @brief Execute a query given and uses the callbackData in these rows
          *
@@ -130,6 +130,35 @@ TEST_F(DBTestFixture, TestFimDBFileUpdate)
         ASSERT_EQ(result, FIMDB_OK);
     });
 }
+TEST_F(DBTestFixture, TestFimDBFileUpdateBatch)
+{
+    EXPECT_NO_THROW(
+    {
+        const auto fileFIMTest { std::make_unique<FileItem>(insertStatement1["data"].front()) };
+        const auto fileFIMTest2 { std::make_unique<FileItem>(insertStatement2["data"].front()) };
+        const auto fileFIMTestUpdated { std::make_unique<FileItem>(updateStatement1["data"].front()) };
+        const auto fileFIMTestUpdated2 { std::make_unique<FileItem>(updateStatement2["data"].front()) };
+
+        fim_entry inserted[] { *fileFIMTest->toFimEntry(), *fileFIMTest2->toFimEntry() };
+        auto result = fim_db_file_update_batch(inserted, 2, callback_data_added);
+        ASSERT_EQ(result, FIMDB_OK);
+        ASSERT_EQ(fim_db_get_count_file_entry(), 2);
+
+        fim_entry updated[] { *fileFIMTestUpdated->toFimEntry(), *fileFIMTestUpdated2->toFimEntry() };
+        result = fim_db_file_update_batch(updated, 2, callback_data_modified);
+        ASSERT_EQ(result, FIMDB_OK);
+        ASSERT_EQ(fim_db_get_count_file_entry(), 2);
+    });
+}
+
+TEST_F(DBTestFixture, TestFimDBFileUpdateBatchNullParameters)
+{
+    const auto fileFIMTest { std::make_unique<FileItem>(insertStatement1["data"].front()) };
+    EXPECT_CALL(*mockLog, loggingFunction(LOG_ERROR, "Invalid parameters")).Times(2);
+    EXPECT_EQ(fim_db_file_update_batch(NULL, 1, callback_data_added), FIMDB_ERR);
+    EXPECT_EQ(fim_db_file_update_batch(fileFIMTest->toFimEntry(), 1, callback_null), FIMDB_ERR);
+}
+
 TEST_F(DBTestFixture, TestFimDBRemovePath)
 {
     const auto fileFIMTest1 { std::make_unique<FileItem>(insertStatement1["data"].front()) };
@@ -175,6 +204,28 @@ TEST_F(DBTestFixture, TestFimDBGetPath)
     });
 }
 
+TEST_F(DBTestFixture, TestFimDBGetPathWithQuotes)
+{
+    auto data { insertStatement1["data"].front() };
+    data["path"] = "/etc/\"wgetrc\"";
+    const auto fileFIMTest { std::make_unique<FileItem>(data) };
+
+    EXPECT_NO_THROW(
+    {
+        ASSERT_EQ(fim_db_file_update(fileFIMTest->toFimEntry(), callback_data_added), FIMDB_OK);
+        callback_context_t callback_data;
+        callback_data.callback = callBackTestFIMEntry;
+        callback_data.context = fileFIMTest->toFimEntry();
+        ASSERT_EQ(fim_db_get_path("/etc/\"wgetrc\"", callback_data), FIMDB_OK);
+        char *test;
+        test = strdup("/etc/\"wgetrc\"");
+        callback_data.callback = callbackTestSearchPath;
+        callback_data.context = test;
+        ASSERT_EQ(fim_db_file_pattern_search("/etc/\"%", callback_data), FIMDB_OK);
+        os_free(test);
+    });
+}
+
 TEST_F(DBTestFixture, TestFimDBGetCountFileEntry)
 {
     const auto fileFIMTest1 { std::make_unique<FileItem>(insertStatement1["data"].front()) };
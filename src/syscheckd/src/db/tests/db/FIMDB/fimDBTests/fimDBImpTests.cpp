@@ -234,6 +234,29 @@ TEST_F(FimDBFixture, updateItemSuccess)
     fimDBMock.updateItem(itemJson, callback);
 }
 
+TEST_F(FimDBFixture, updateItemsSuccess)
+{
+    const auto item1 { R"({"table":"file_entry","data":[{"path":"/tmp/a"}],"options":{"return_old_data":true}})"_json };
+    const auto item2 { R"({"table":"file_entry","data":[{"path":"/tmp/b"}],"options":{"return_old_data":true}})"_json };
+    const auto statement
+    {
+        R"({"table":"file_entry","data":[{"path":"/tmp/a"},{"path":"/tmp/b"}],"options":{"return_old_data":true}})"_json
+    };
+    ResultCallbackData callback;
+    EXPECT_CALL(*mockDBSync, syncRow(statement, testing::_)).Times(1);
+    fimDBMock.updateItems({item1, item2}, callback);
+    fimDBMock.updateItems({}, callback);
+}
+
+TEST_F(FimDBFixture, updateItemsDifferentTables)
+{
+    const auto item1 { R"({"table":"file_entry","data":[{"path":"/tmp/a"}]})"_json };
+    const auto item2 { R"({"table":"registry_key","data":[{"path":"/tmp/b"}]})"_json };
+    ResultCallbackData callback;
+    EXPECT_CALL(*mockDBSync, syncRow(testing::_, testing::_)).Times(0);
+    EXPECT_THROW(fimDBMock.updateItems({item1, item2}, callback), std::runtime_error);
+}
+
 TEST_F(FimDBFixture, registerSyncIDSuccess)
 {
     EXPECT_CALL(*mockRSync, registerSyncID(testing::_, testing::_, testing::_, testing::_)).Times(testing::AtLeast(1));
@@ -138,6 +138,144 @@ void send_syscheck_msg(const cJSON *_msg) {
     }
 }
 
+/* Scheduled events of the directory being batched */
+static cJSON *fim_batch = NULL;
+static size_t fim_batch_size = 0;
+static unsigned int fim_batch_count = 0;
+static pthread_mutex_t fim_batch_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+// Delta of an event in a batch: its name in the directory and the old values of the changed attributes only
+STATIC cJSON * fim_batch_item(const cJSON *data, const char *name) {
+    cJSON *item = cJSON_CreateObject();
+    cJSON *attributes = cJSON_GetObjectItem(data, "attributes");
+    cJSON *field = NULL;
+
+    cJSON_AddStringToObject(item, "name", name);
+
+    cJSON_ArrayForEach(field, data) {
+        if (strcmp(field->string, "path") == 0 || strcmp(field->string, "mode") == 0 ||
+            strcmp(field->string, "version") == 0 || strcmp(field->string, "tags") == 0) {
+            continue;
+        }
+
+        if (strcmp(field->string, "old_attributes") == 0) {
+            cJSON *old_attributes = cJSON_CreateObject();
+            cJSON *old_field = NULL;
+
+            cJSON_ArrayForEach(old_field, field) {
+                if (!cJSON_Compare(old_field, cJSON_GetObjectItem(attributes, old_field->string), true)) {
+                    cJSON_AddItemToObject(old_attributes, old_field->string, cJSON_Duplicate(old_field, true));
+                }
+            }
+
+            cJSON_AddItemToObject(item, field->string, old_attributes);
+        } else {
+            cJSON_AddItemToObject(item, field->string, cJSON_Duplicate(field, true));
+        }
+    }
+
+    return item;
+}
+
+// Send the batch, called with the batch mutex locked
+STATIC void fim_batch_send() {
+    if (fim_batch == NULL) {
+        return;
+    }
+
+    send_syscheck_msg(fim_batch);
+
+    cJSON_Delete(fim_batch);
+    fim_batch = NULL;
+    fim_batch_size = 0;
+    fim_batch_count = 0;
+}
+
+// Add a scheduled event to the batch of its directory
+void fim_batch_event(const cJSON *event) {
+    cJSON *data = cJSON_GetObjectItem(event, "data");
+    const char *path = cJSON_GetStringValue(cJSON_GetObjectItem(data, "path"));
+    const char *tags = cJSON_GetStringValue(cJSON_GetObjectItem(data, "tags"));
+    const char *name = path ? strrchr(path, PATH_SEP) : NULL;
+
+    if (name == NULL || cJSON_GetObjectItem(data, "audit") != NULL) {
+        send_syscheck_msg(event);
+        return;
+    }
+
+    name++;
+
+    cJSON *item = fim_batch_item(data, name);
+    char *item_plain = cJSON_PrintUnformatted(item);
+    size_t dir_length = name - path;
+    size_t item_size = strlen(item_plain);
+
+    cJSON_Delete(item);
+
+    if (item_size + dir_length > FIM_BATCH_MAX_SIZE) {
+        os_free(item_plain);
+        send_syscheck_msg(event);
+        return;
+    }
+
+    w_mutex_lock(&fim_batch_mutex);
+
+    if (fim_batch != NULL) {
+        cJSON *batch_data = cJSON_GetObjectItem(fim_batch, "data");
+        const char *batch_dir = cJSON_GetStringValue(cJSON_GetObjectItem(batch_data, "dir"));
+        const char *batch_tags = cJSON_GetStringValue(cJSON_GetObjectItem(batch_data, "tags"));
+
+        if (strlen(batch_dir) != dir_length || strncmp(batch_dir, path, dir_length) != 0 ||
+            (tags == NULL) != (batch_tags == NULL) || (tags != NULL && strcmp(tags, batch_tags) != 0) ||
+            fim_batch_size + item_size > FIM_BATCH_MAX_SIZE) {
+            fim_batch_send();
+        }
+    }
+
+    if (fim_batch == NULL) {
+        cJSON *batch_data = cJSON_CreateObject();
+        char *dir;
+
+        os_strdup(path, dir);
+        dir[dir_length] = '\0';
+
+        fim_batch = cJSON_CreateObject();
+        cJSON_AddStringToObject(fim_batch, "type", "event_batch");
+        cJSON_AddItemToObject(fim_batch, "data", batch_data);
+        cJSON_AddStringToObject(batch_data, "dir", dir);
+        cJSON_AddStringToObject(batch_data, "mode", cJSON_GetStringValue(cJSON_GetObjectItem(data, "mode")));
+        cJSON_AddNumberToObject(batch_data, "version", 2.0);
+
+        if (tags != NULL) {
+            cJSON_AddStringToObject(batch_data, "tags", tags);
+        }
+
+        cJSON_AddItemToObject(batch_data, "events", cJSON_CreateArray());
+        fim_batch_size = dir_length;
+        os_free(dir);
+    }
+
+    cJSON *events = cJSON_GetObjectItem(cJSON_GetObjectItem(fim_batch, "data"), "events");
+
+    // The item is printed once, the batch copies it verbatim
+    cJSON_AddItemToArray(events, cJSON_CreateRaw(item_plain));
+    fim_batch_size += item_size + 1;
+    os_free(item_plain);
+
+    if (++fim_batch_count >= syscheck.event_batch) {
+        fim_batch_send();
+    }
+
+    w_mutex_unlock(&fim_batch_mutex);
+}
+
+// Send the events batched
+void fim_batch_flush() {
+    w_mutex_lock(&fim_batch_mutex);
+    fim_batch_send();
+    w_mutex_unlock(&fim_batch_mutex);
+}
+
 // Send a scan info event
 void fim_send_scan_info(fim_scan_event event) {
     cJSON * json = fim_scan_info_json(event, time(NULL));
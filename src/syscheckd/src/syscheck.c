@@ -54,6 +54,9 @@ void read_internal(int debug_level)
     syscheck.max_depth = getDefine_Int("syscheck", "default_max_depth", 1, 320);
     syscheck.file_max_size = (size_t)getDefine_Int("syscheck", "file_max_size", 0, 4095) * 1024 * 1024;
     syscheck.sym_checker_interval = getDefine_Int("syscheck", "symlink_scan_interval", 1, 2592000);
+    syscheck.scan_threads = getDefine_Int("syscheck", "scan_threads", 1, 64);
+    syscheck.full_hash_interval = getDefine_Int("syscheck", "full_hash_interval", 1, 1024);
+    syscheck.event_batch = getDefine_Int("syscheck", "event_batch", 0, 1024);
 
 #ifndef WIN32
     syscheck.max_audit_entries = getDefine_Int("syscheck", "max_audit_entries", 1, 4096);
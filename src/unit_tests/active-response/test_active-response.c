@@ -112,12 +112,23 @@ void test_get_ip_version_success_invalid_ip(void **state) {
     assert_int_equal(ret, -1);    //OS_INVALID
 }
 
+void test_is_resident(void **state) {
+    char *argv_resident[] = { "firewall-drop", RESIDENT_ARG, NULL };
+    char *argv_other[] = { "firewall-drop", "other", NULL };
+    char *argv_none[] = { "firewall-drop", NULL };
+
+    assert_int_equal(is_resident(2, argv_resident), 1);
+    assert_int_equal(is_resident(2, argv_other), 0);
+    assert_int_equal(is_resident(1, argv_none), 0);
+}
+
 int main(void) {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test_setup_teardown(test_get_ip_version_success_ipv4, test_setup, test_teardown),
         cmocka_unit_test_setup_teardown(test_get_ip_version_success_ipv6, test_setup, test_teardown),
         cmocka_unit_test_setup_teardown(test_get_ip_version_no_success, test_setup, test_teardown),
         cmocka_unit_test_setup_teardown(test_get_ip_version_success_invalid_ip, test_setup, test_teardown),
+        cmocka_unit_test(test_is_resident),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2015, Wazuh Inc.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../../analysisd/output/alert_bus.h"
+#include "../../analysisd/rules.h"
+
+static void free_subscriber(alert_bus_subscriber_t *subscriber) {
+    free_strarray(subscriber->groups);
+    os_free(subscriber->rule_ids);
+}
+
+/* Tests alert_bus_parse_filter */
+
+static void test_alert_bus_parse_filter_empty(void **state) {
+    alert_bus_subscriber_t subscriber = { 0 };
+
+    assert_int_equal(alert_bus_parse_filter(&subscriber, "{}"), 0);
+    assert_int_equal(subscriber.level, 0);
+    assert_null(subscriber.groups);
+    assert_null(subscriber.rule_ids);
+    assert_false(subscriber.mail);
+}
+
+static void test_alert_bus_parse_filter_full(void **state) {
+    alert_bus_subscriber_t subscriber = { 0 };
+
+    assert_int_equal(alert_bus_parse_filter(&subscriber, "{\"level\":7,\"groups\":[\"sshd\",\"syscheck\"],\"rule_ids\":[5710,550],\"mail\":true}"), 0);
+    assert_int_equal(subscriber.level, 7);
+    assert_string_equal(subscriber.groups[0], "sshd");
+    assert_string_equal(subscriber.groups[1], "syscheck");
+    assert_null(subscriber.groups[2]);
+    assert_int_equal(subscriber.rule_ids[0], 5710);
+    assert_int_equal(subscriber.rule_ids[1], 550);
+    assert_int_equal(subscriber.rule_ids[2], -1);
+    assert_true(subscriber.mail);
+
+    free_subscriber(&subscriber);
+}
+
+static void test_alert_bus_parse_filter_invalid(void **state) {
+    alert_bus_subscriber_t subscriber = { 0 };
+
+    assert_int_equal(alert_bus_parse_filter(&subscriber, "not a filter"), -1);
+    assert_int_equal(alert_bus_parse_filter(&subscriber, "[]"), -1);
+    assert_int_equal(alert_bus_parse_filter(&subscriber, "{\"level\":-1}"), -1);
+    assert_int_equal(alert_bus_parse_filter(&subscriber, "{\"groups\":[\"sshd\",3]}"), -1);
+    assert_null(subscriber.groups);
+    assert_int_equal(alert_bus_parse_filter(&subscriber, "{\"rule_ids\":\"5710\"}"), -1);
+    assert_null(subscriber.rule_ids);
+}
+
+/* Tests alert_bus_match */
+
+static void test_alert_bus_match_level(void **state) {
+    alert_bus_subscriber_t subscriber = { .level = 5 };
+    RuleInfo rule = { .sigid = 5710, .level = 4 };
+    Eventinfo lf = { .generated_rule = &rule };
+
+    assert_false(alert_bus_match(&subscriber, &lf));
+
+    rule.level = 5;
+    assert_true(alert_bus_match(&subscriber, &lf));
+}
+
+static void test_alert_bus_match_mail(void **state) {
+    alert_bus_subscriber_t subscriber = { .mail = true };
+    RuleInfo rule = { .sigid = 5710, .level = 10 };
+    Eventinfo lf = { .generated_rule = &rule };
+
+    assert_false(alert_bus_match(&subscriber, &lf));
+
+    rule.alert_opts = DO_MAILALERT;
+    assert_true(alert_bus_match(&subscriber, &lf));
+}
+
+static void test_alert_bus_match_rule_ids(void **state) {
+    int rule_ids[] = { 550, 5710, -1 };
+    alert_bus_subscriber_t subscriber = { .rule_ids = rule_ids };
+    RuleInfo rule = { .sigid = 5710, .level = 5 };
+    Eventinfo lf = { .generated_rule = &rule };
+
+    assert_true(alert_bus_match(&subscriber, &lf));
+
+    rule.sigid = 5711;
+    assert_false(alert_bus_match(&subscriber, &lf));
+}
+
+static void test_alert_bus_match_groups(void **state) {
+    char *groups[] = { "authentication_failed", NULL };
+    alert_bus_subscriber_t subscriber = { .groups = groups };
+    RuleInfo rule = { .sigid = 5710, .level = 5, .group = "syslog,sshd,authentication_failed," };
+    Eventinfo lf = { .generated_rule = &rule };
+
+    assert_true(alert_bus_match(&subscriber, &lf));
+
+    // Only whole group names match
+    rule.group = "syslog,sshd,authentication_failed_multiple,";
+    assert_false(alert_bus_match(&subscriber, &lf));
+
+    rule.group = NULL;
+    assert_false(alert_bus_match(&subscriber, &lf));
+}
+
+static void test_alert_bus_match_no_rule(void **state) {
+    alert_bus_subscriber_t subscriber = { 0 };
+    Eventinfo lf = { .generated_rule = NULL };
+
+    assert_false(alert_bus_match(&subscriber, &lf));
+}
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        // Tests alert_bus_parse_filter
+        cmocka_unit_test(test_alert_bus_parse_filter_empty),
+        cmocka_unit_test(test_alert_bus_parse_filter_full),
+        cmocka_unit_test(test_alert_bus_parse_filter_invalid),
+        // Tests alert_bus_match
+        cmocka_unit_test(test_alert_bus_match_level),
+        cmocka_unit_test(test_alert_bus_match_mail),
+        cmocka_unit_test(test_alert_bus_match_rule_ids),
+        cmocka_unit_test(test_alert_bus_match_groups),
+        cmocka_unit_test(test_alert_bus_match_no_rule),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -110,21 +110,21 @@ static int test_setup(void ** state) {
     analysisd_state.eps_state_breakdown.seconds_over_limit = 1254;
     analysisd_state.eps_state_breakdown.available_credits_prev = 12;
 
-    decode_queue_syscheck_input = queue_init(4096);
-    decode_queue_syscollector_input = queue_init(4096);
-    decode_queue_rootcheck_input = queue_init(4096);
-    decode_queue_sca_input = queue_init(4096);
-    decode_queue_hostinfo_input = queue_init(4096);
-    decode_queue_winevt_input = queue_init(4096);
-    dispatch_dbsync_input = queue_init(4096);
-    upgrade_module_input = queue_init(4096);
-    decode_queue_event_input = queue_init(4096);
-    decode_queue_event_output = queue_init(4096);
-    writer_queue_log = queue_init(4096);
-    writer_queue_log_firewall = queue_init(4096);
-    writer_queue_log_fts = queue_init(4096);
-    writer_queue_log_statistical = queue_init(4096);
-    writer_queue = queue_init(4096);
+    decode_queue_syscheck_input = mpmc_queue_init(4096);
+    decode_queue_syscollector_input = mpmc_queue_init(4096);
+    decode_queue_rootcheck_input = mpmc_queue_init(4096);
+    decode_queue_sca_input = mpmc_queue_init(4096);
+    decode_queue_hostinfo_input = mpmc_queue_init(4096);
+    decode_queue_winevt_input = mpmc_queue_init(4096);
+    dispatch_dbsync_input = mpmc_queue_init(4096);
+    upgrade_module_input = mpmc_queue_init(4096);
+    decode_queue_event_input = mpmc_queue_init(4096);
+    decode_queue_event_output = mpmc_queue_init(4096);
+    writer_queue_log = mpmc_queue_init(4096);
+    writer_queue_log_firewall = mpmc_queue_init(4096);
+    writer_queue_log_fts = mpmc_queue_init(4096);
+    writer_queue_log_statistical = mpmc_queue_init(4096);
+    writer_queue = mpmc_queue_init(4096);
 
     decode_queue_syscheck_input->size = queue_status.syscheck_queue_size = 4096;
     decode_queue_syscollector_input->size = queue_status.syscollector_queue_size = 4096;
@@ -142,21 +142,21 @@ static int test_setup(void ** state) {
     writer_queue_log_statistical->size = queue_status.stats_queue_size = 4096;
     writer_queue->size = queue_status.archives_queue_size = 4096;
 
-    decode_queue_syscheck_input->elements = 128;
-    decode_queue_syscollector_input->elements = 46;
-    decode_queue_rootcheck_input->elements = 87;
-    decode_queue_sca_input->elements = 15;
-    decode_queue_hostinfo_input->elements = 1;
-    decode_queue_winevt_input->elements = 23;
-    dispatch_dbsync_input->elements = 456;
-    upgrade_module_input->elements = 0;
-    decode_queue_event_input->elements = 259;
-    decode_queue_event_output->elements = 154;
-    writer_queue_log->elements = 5;
-    writer_queue_log_firewall->elements = 1;
-    writer_queue_log_fts->elements = 0;
-    writer_queue_log_statistical->elements = 2;
-    writer_queue->elements = 24;
+    decode_queue_syscheck_input->push_pos = 128;
+    decode_queue_syscollector_input->push_pos = 46;
+    decode_queue_rootcheck_input->push_pos = 87;
+    decode_queue_sca_input->push_pos = 15;
+    decode_queue_hostinfo_input->push_pos = 1;
+    decode_queue_winevt_input->push_pos = 23;
+    dispatch_dbsync_input->push_pos = 456;
+    upgrade_module_input->push_pos = 0;
+    decode_queue_event_input->push_pos = 259;
+    decode_queue_event_output->push_pos = 154;
+    writer_queue_log->push_pos = 5;
+    writer_queue_log_firewall->push_pos = 1;
+    writer_queue_log_fts->push_pos = 0;
+    writer_queue_log_statistical->push_pos = 2;
+    writer_queue->push_pos = 24;
 
     return 0;
 }
@@ -214,36 +214,21 @@ static int test_setup_agent(void ** state) {
 }
 
 static int test_teardown(void ** state) {
-    os_free(decode_queue_syscheck_input->data);
-    os_free(decode_queue_syscollector_input->data);
-    os_free(decode_queue_rootcheck_input->data);
-    os_free(decode_queue_sca_input->data);
-    os_free(decode_queue_hostinfo_input->data);
-    os_free(decode_queue_winevt_input->data);
-    os_free(dispatch_dbsync_input->data);
-    os_free(upgrade_module_input->data);
-    os_free(decode_queue_event_input->data);
-    os_free(decode_queue_event_output->data);
-    os_free(writer_queue_log->data);
-    os_free(writer_queue_log_firewall->data);
-    os_free(writer_queue_log_fts->data);
-    os_free(writer_queue_log_statistical->data);
-    os_free(writer_queue->data);
-    os_free(decode_queue_syscheck_input);
-    os_free(decode_queue_syscollector_input);
-    os_free(decode_queue_rootcheck_input);
-    os_free(decode_queue_sca_input);
-    os_free(decode_queue_hostinfo_input);
-    os_free(decode_queue_winevt_input);
-    os_free(dispatch_dbsync_input);
-    os_free(upgrade_module_input);
-    os_free(decode_queue_event_input);
-    os_free(decode_queue_event_output);
-    os_free(writer_queue_log);
-    os_free(writer_queue_log_firewall);
-    os_free(writer_queue_log_fts);
-    os_free(writer_queue_log_statistical);
-    os_free(writer_queue);
+    mpmc_queue_free(decode_queue_syscheck_input);
+    mpmc_queue_free(decode_queue_syscollector_input);
+    mpmc_queue_free(decode_queue_rootcheck_input);
+    mpmc_queue_free(decode_queue_sca_input);
+    mpmc_queue_free(decode_queue_hostinfo_input);
+    mpmc_queue_free(decode_queue_winevt_input);
+    mpmc_queue_free(dispatch_dbsync_input);
+    mpmc_queue_free(upgrade_module_input);
+    mpmc_queue_free(decode_queue_event_input);
+    mpmc_queue_free(decode_queue_event_output);
+    mpmc_queue_free(writer_queue_log);
+    mpmc_queue_free(writer_queue_log_firewall);
+    mpmc_queue_free(writer_queue_log_fts);
+    mpmc_queue_free(writer_queue_log_statistical);
+    mpmc_queue_free(writer_queue);
 
     return 0;
 }
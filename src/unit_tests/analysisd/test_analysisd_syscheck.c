@@ -42,6 +42,9 @@ size_t fim_generate_comment(char * str, long size, const char * format, const ch
 int fim_generate_alert(Eventinfo *lf, syscheck_event_t event_type, cJSON *attributes, cJSON *old_attributes, cJSON *audit);
 int fim_process_alert(_sdb *sdb, Eventinfo *lf, cJSON *event);
 int decode_fim_event(_sdb *sdb, Eventinfo *lf);
+void fim_db_batch_start(_sdb * sdb);
+void fim_db_batch_end(_sdb * sdb);
+char ** fim_expand_batch(const char * msg);
 char *perm_json_to_old_format(cJSON *perm_json);
 void fim_adjust_checksum(sk_sum_t *newsum, char **checksum);
 
@@ -939,6 +942,87 @@ static void test_fim_send_db_save_null_data(void **state) {
     fim_send_db_save(&sdb, agent_id, NULL);
 }
 
+/* fim_db_batch */
+static void test_fim_db_batch_save_and_delete(void **state) {
+    _sdb sdb = {.socket = 10};
+    const char *result = "This is a mock query result, it wont go anywhere";
+    cJSON *data = cJSON_Parse("{\"path\":\"/a/path\",\"mode\":\"scheduled\",\"type\":\"added\","
+                              "\"attributes\":{\"type\":\"file\",\"size\":1}}");
+
+    // Both entries are stored by a single query
+    expect_any(__wrap_wdbc_query_ex, *sock);
+    expect_string(__wrap_wdbc_query_ex, query, "agent 007 syscheck save_batch "
+        "[{\"path\":\"/a/path\",\"attributes\":{\"type\":\"file\",\"size\":1}},{\"delete\":\"/b/path\"}]");
+    expect_any(__wrap_wdbc_query_ex, len);
+    will_return(__wrap_wdbc_query_ex, result);
+    will_return(__wrap_wdbc_query_ex, 0);
+
+    expect_string(__wrap_wdbc_parse_result, result, result);
+    will_return(__wrap_wdbc_parse_result, WDBC_OK);
+
+    fim_db_batch_start(&sdb);
+    fim_send_db_save(&sdb, "007", data);
+    fim_send_db_delete(&sdb, "007", "/b/path");
+    fim_db_batch_end(&sdb);
+
+    assert_null(sdb.db_batch);
+    assert_null(sdb.db_batch_agent);
+
+    cJSON_Delete(data);
+}
+
+static void test_fim_db_batch_empty(void **state) {
+    _sdb sdb = {.socket = 10};
+
+    // No query without entries
+    fim_db_batch_start(&sdb);
+    fim_db_batch_end(&sdb);
+
+    assert_null(sdb.db_batch);
+}
+
+/* fim_expand_batch */
+static void test_fim_expand_batch(void **state) {
+    const char *msg = "8:[001] (agent) any->syscheck:{\"type\":\"event_batch\",\"data\":{\"dir\":\"/usr/lib/app/\","
+        "\"mode\":\"scheduled\",\"version\":2,\"events\":["
+        "{\"name\":\"a.so\",\"type\":\"modified\",\"timestamp\":10,\"attributes\":{\"type\":\"file\",\"size\":2,"
+        "\"mtime\":5},\"old_attributes\":{\"size\":1},\"changed_attributes\":[\"size\"]},"
+        "{\"name\":\"b.so\",\"type\":\"added\",\"timestamp\":11,\"attributes\":{\"type\":\"file\",\"size\":3}}]}}";
+
+    char **messages = fim_expand_batch(msg);
+
+    assert_non_null(messages);
+    assert_string_equal(messages[0], "8:[001] (agent) any->syscheck:{\"type\":\"event\",\"data\":{"
+        "\"path\":\"/usr/lib/app/a.so\",\"mode\":\"scheduled\",\"version\":2,\"type\":\"modified\",\"timestamp\":10,"
+        "\"attributes\":{\"type\":\"file\",\"size\":2,\"mtime\":5},"
+        "\"old_attributes\":{\"size\":1,\"type\":\"file\",\"mtime\":5},\"changed_attributes\":[\"size\"]}}");
+    assert_string_equal(messages[1], "8:[001] (agent) any->syscheck:{\"type\":\"event\",\"data\":{"
+        "\"path\":\"/usr/lib/app/b.so\",\"mode\":\"scheduled\",\"version\":2,\"type\":\"added\",\"timestamp\":11,"
+        "\"attributes\":{\"type\":\"file\",\"size\":3}}}");
+    assert_null(messages[2]);
+
+    free_strarray(messages);
+}
+
+static void test_fim_expand_batch_not_batch(void **state) {
+    const char *msg = "8:[001] (agent) any->syscheck:{\"type\":\"event\",\"data\":{\"path\":\"/a/path\"}}";
+
+    assert_null(fim_expand_batch(msg));
+}
+
+static void test_fim_expand_batch_invalid(void **state) {
+    const char *msg = "8:[001] (agent) any->syscheck:{\"type\":\"event_batch\",\"data\":{\"events\":[]}}";
+
+    expect_string(__wrap__merror, formatted_msg, "Invalid FIM event batch");
+
+    char **messages = fim_expand_batch(msg);
+
+    assert_non_null(messages);
+    assert_null(messages[0]);
+
+    free_strarray(messages);
+}
+
 /* fim_process_scan_info */
 static void test_fim_process_scan_info_scan_start(void **state) {
     _sdb sdb = {.socket = 10};
@@ -3905,6 +3989,15 @@ int main(void) {
         cmocka_unit_test_setup_teardown(test_fim_send_db_save_null_agent_id, setup_fim_event_cjson, teardown_cjson),
         cmocka_unit_test_setup_teardown(test_fim_send_db_save_null_data, setup_fim_event_cjson, teardown_cjson),
 
+        /* fim_db_batch */
+        cmocka_unit_test(test_fim_db_batch_save_and_delete),
+        cmocka_unit_test(test_fim_db_batch_empty),
+
+        /* fim_expand_batch */
+        cmocka_unit_test(test_fim_expand_batch),
+        cmocka_unit_test(test_fim_expand_batch_not_batch),
+        cmocka_unit_test(test_fim_expand_batch_invalid),
+
         /* fim_process_scan_info */
         cmocka_unit_test_setup_teardown(test_fim_process_scan_info_scan_start,setup_fim_event_cjson, teardown_cjson),
         cmocka_unit_test_setup_teardown(test_fim_process_scan_info_scan_end, setup_fim_event_cjson, teardown_cjson),
@@ -23,6 +23,7 @@
 #include "../wrappers/wazuh/os_net/os_net_wrappers.h"
 #include "../wrappers/wazuh/analysisd/state_wrappers.h"
 #include "../wrappers/wazuh/analysisd/config_wrappers.h"
+#include "../wrappers/wazuh/analysisd/labels_wrappers.h"
 
 char* asyscom_output_builder(int error_code, const char* message, cJSON* data_json);
 size_t asyscom_dispatch(char * command, char ** output);
@@ -305,6 +306,66 @@ void test_asyscom_dispatch_getagentsstats_array_ok(void ** state) {
     assert_int_equal(size, strlen(response));
 }
 
+void test_asyscom_dispatch_setlabels(void ** state) {
+    char* request = "{\"command\":\"setlabels\",\"parameters\":{\"agent\":\"001\",\"labels\":[{\"key\":\"\\\"key1\\\"\",\"value\":\"value1\"}]}}";
+    char *response = NULL;
+
+    expect_string(__wrap_labels_cache_set, agent_id, "001");
+    expect_any(__wrap_labels_cache_set, labels_json);
+    will_return(__wrap_labels_cache_set, OS_SUCCESS);
+
+    size_t size = asyscom_dispatch(request, &response);
+
+    *state = response;
+
+    assert_non_null(response);
+    assert_string_equal(response, "{\"error\":0,\"message\":\"ok\",\"data\":{}}");
+    assert_int_equal(size, strlen(response));
+}
+
+void test_asyscom_dispatch_setlabels_invalid_labels(void ** state) {
+    char* request = "{\"command\":\"setlabels\",\"parameters\":{\"agent\":\"001\"}}";
+    char *response = NULL;
+
+    expect_string(__wrap_labels_cache_set, agent_id, "001");
+    expect_value(__wrap_labels_cache_set, labels_json, NULL);
+    will_return(__wrap_labels_cache_set, OS_INVALID);
+
+    size_t size = asyscom_dispatch(request, &response);
+
+    *state = response;
+
+    assert_non_null(response);
+    assert_string_equal(response, "{\"error\":13,\"message\":\"Invalid labels parameter\",\"data\":{}}");
+    assert_int_equal(size, strlen(response));
+}
+
+void test_asyscom_dispatch_setlabels_invalid_agent(void ** state) {
+    char* request = "{\"command\":\"setlabels\",\"parameters\":{\"agent\":\"../001\",\"labels\":[]}}";
+    char *response = NULL;
+
+    size_t size = asyscom_dispatch(request, &response);
+
+    *state = response;
+
+    assert_non_null(response);
+    assert_string_equal(response, "{\"error\":12,\"message\":\"Invalid agent parameter\",\"data\":{}}");
+    assert_int_equal(size, strlen(response));
+}
+
+void test_asyscom_dispatch_setlabels_empty_parameters(void ** state) {
+    char* request = "{\"command\":\"setlabels\"}";
+    char *response = NULL;
+
+    size_t size = asyscom_dispatch(request, &response);
+
+    *state = response;
+
+    assert_non_null(response);
+    assert_string_equal(response, "{\"error\":5,\"message\":\"Empty parameters\",\"data\":{}}");
+    assert_int_equal(size, strlen(response));
+}
+
 void test_asyscom_dispatch_unknown_command(void ** state) {
     char* request = "{\"command\":\"unknown\"}";
     char *response = NULL;
@@ -672,6 +733,10 @@ int main(void) {
         cmocka_unit_test_teardown(test_asyscom_dispatch_getagentsstats_all_ok, test_teardown),
         cmocka_unit_test_teardown(test_asyscom_dispatch_getagentsstats_array_empty_agents, test_teardown),
         cmocka_unit_test_teardown(test_asyscom_dispatch_getagentsstats_array_ok, test_teardown),
+        cmocka_unit_test_teardown(test_asyscom_dispatch_setlabels, test_teardown),
+        cmocka_unit_test_teardown(test_asyscom_dispatch_setlabels_invalid_labels, test_teardown),
+        cmocka_unit_test_teardown(test_asyscom_dispatch_setlabels_invalid_agent, test_teardown),
+        cmocka_unit_test_teardown(test_asyscom_dispatch_setlabels_empty_parameters, test_teardown),
         cmocka_unit_test_teardown(test_asyscom_dispatch_unknown_command, test_teardown),
         cmocka_unit_test_teardown(test_asyscom_dispatch_empty_command, test_teardown),
         cmocka_unit_test_teardown(test_asyscom_dispatch_invalid_json, test_teardown),
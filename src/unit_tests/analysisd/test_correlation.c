@@ -0,0 +1,233 @@
+/*
+ * Copyright (C) 2015, Wazuh Inc.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdio.h>
+
+#include "../../headers/shared.h"
+#include "../../analysisd/eventinfo.h"
+#include "../../analysisd/rules.h"
+#include "../../analysisd/correlation.h"
+
+typedef struct test_correlation_t {
+    RuleInfo matched;
+    RuleInfo searcher;
+    Eventinfo lf;
+} test_correlation_t;
+
+/* setup/teardown */
+
+static int setup_correlation(void **state) {
+    test_correlation_t * data;
+
+    os_calloc(1, sizeof(test_correlation_t), data);
+
+    data->searcher.timeframe = 120;
+    data->searcher.frequency = 3;
+    data->searcher.same_field = FIELD_SRCIP;
+    data->searcher.correlation = w_correlation_init(data->searcher.timeframe);
+
+    // The list is never used by the index, it only must exist
+    data->matched.sid_prev_matched = (OSList *)1;
+    w_correlation_add_sid_searcher(&data->matched, &data->searcher);
+
+    data->lf.agent_id = "000";
+    data->lf.srcip = "192.168.0.1";
+
+    *state = data;
+    return 0;
+}
+
+static int teardown_correlation(void **state) {
+    test_correlation_t * data = *state;
+
+    w_correlation_free(data->searcher.correlation);
+    os_free(data->matched.sid_searchers);
+    os_free(data);
+    return 0;
+}
+
+static void add_events(test_correlation_t * data, int count, time_t start, time_t step) {
+    for (int i = 0; i < count; i++) {
+        data->lf.generate_time = start + i * step;
+        w_correlation_add_event(&data->matched, &data->lf);
+    }
+}
+
+/* tests */
+
+/* w_correlation_init */
+
+void test_w_correlation_init_width(void **state)
+{
+    w_correlation_t * correlation = w_correlation_init(1);
+
+    assert_int_equal(correlation->width, 1);
+    w_correlation_free(correlation);
+
+    // The timeframe fits in two buckets less than the ring
+    correlation = w_correlation_init(120);
+    assert_true(correlation->width * (W_CORRELATION_BUCKETS - 2) >= 120);
+    w_correlation_free(correlation);
+}
+
+/* w_correlation_count */
+
+void test_w_correlation_count_same_key(void **state)
+{
+    test_correlation_t * data = *state;
+
+    add_events(data, 4, 1000, 10);
+
+    assert_int_equal(w_correlation_count(&data->searcher, &data->lf, 1030), 4);
+}
+
+void test_w_correlation_count_upper_bound(void **state)
+{
+    test_correlation_t * data = *state;
+
+    add_events(data, 4, 1000, 10);
+
+    // Only two events are in the timeframe, but the first bucket is partially inside
+    int count = w_correlation_count(&data->searcher, &data->lf, 1135);
+    assert_true(count >= 2 && count <= 4);
+}
+
+void test_w_correlation_count_expired(void **state)
+{
+    test_correlation_t * data = *state;
+
+    add_events(data, 4, 1000, 10);
+
+    assert_int_equal(w_correlation_count(&data->searcher, &data->lf, 1400), 0);
+}
+
+void test_w_correlation_count_other_key(void **state)
+{
+    test_correlation_t * data = *state;
+
+    add_events(data, 4, 1000, 10);
+
+    data->lf.srcip = "192.168.0.2";
+    assert_int_equal(w_correlation_count(&data->searcher, &data->lf, 1030), 0);
+}
+
+void test_w_correlation_count_missing_field(void **state)
+{
+    test_correlation_t * data = *state;
+
+    add_events(data, 4, 1000, 10);
+
+    // The event can't match without the field
+    data->lf.srcip = NULL;
+    assert_int_equal(w_correlation_count(&data->searcher, &data->lf, 1030), 0);
+}
+
+void test_w_correlation_count_global_frequency(void **state)
+{
+    test_correlation_t * data = *state;
+
+    data->searcher.context_opts = FIELD_GFREQUENCY;
+    add_events(data, 2, 1000, 10);
+
+    data->lf.agent_id = "001";
+    add_events(data, 2, 1020, 10);
+
+    assert_int_equal(w_correlation_count(&data->searcher, &data->lf, 1030), 4);
+}
+
+void test_w_correlation_count_clock_back(void **state)
+{
+    test_correlation_t * data = *state;
+
+    add_events(data, 4, 1000, 10);
+
+    assert_int_equal(w_correlation_count(&data->searcher, &data->lf, 900), -1);
+}
+
+void test_w_correlation_count_timeframe_changed(void **state)
+{
+    test_correlation_t * data = *state;
+
+    add_events(data, 4, 1000, 10);
+
+    data->searcher.timeframe = 600;
+    assert_int_equal(w_correlation_count(&data->searcher, &data->lf, 1030), -1);
+}
+
+void test_w_correlation_count_no_index(void **state)
+{
+    RuleInfo rule = { .timeframe = 120 };
+    Eventinfo lf = { .agent_id = "000" };
+
+    assert_int_equal(w_correlation_count(&rule, &lf, 1000), -1);
+}
+
+/* w_correlation_add_event */
+
+void test_w_correlation_add_event_sweep(void **state)
+{
+    test_correlation_t * data = *state;
+    char srcip[IPSIZE];
+
+    add_events(data, 1, 1000, 0);
+
+    // The old key is removed when enough events arrive later
+    for (int i = 0; i < W_CORRELATION_SWEEP; i++) {
+        snprintf(srcip, sizeof(srcip), "10.0.%d.%d", i / 256, i % 256);
+        data->lf.srcip = srcip;
+        data->lf.generate_time = 5000;
+        w_correlation_add_event(&data->matched, &data->lf);
+    }
+
+    assert_int_equal(OSHash_Get_Elem_ex(data->searcher.correlation->keys), W_CORRELATION_SWEEP);
+}
+
+void test_w_correlation_add_event_group(void **state)
+{
+    test_correlation_t * data = *state;
+    RuleInfo matched = { 0 };
+    OSList * lists[2] = { (OSList *)1, NULL };
+    RuleInfo * searchers[2] = { &data->searcher, NULL };
+
+    matched.group_prev_matched = lists;
+    matched.group_prev_matched_sz = 1;
+    matched.group_searchers = searchers;
+
+    data->lf.generate_time = 1000;
+    w_correlation_add_event(&matched, &data->lf);
+
+    assert_int_equal(w_correlation_count(&data->searcher, &data->lf, 1000), 1);
+}
+
+int main(void)
+{
+    const struct CMUnitTest tests[] = {
+        // w_correlation_init
+        cmocka_unit_test(test_w_correlation_init_width),
+        // w_correlation_count
+        cmocka_unit_test_setup_teardown(test_w_correlation_count_same_key, setup_correlation, teardown_correlation),
+        cmocka_unit_test_setup_teardown(test_w_correlation_count_upper_bound, setup_correlation, teardown_correlation),
+        cmocka_unit_test_setup_teardown(test_w_correlation_count_expired, setup_correlation, teardown_correlation),
+        cmocka_unit_test_setup_teardown(test_w_correlation_count_other_key, setup_correlation, teardown_correlation),
+        cmocka_unit_test_setup_teardown(test_w_correlation_count_missing_field, setup_correlation, teardown_correlation),
+        cmocka_unit_test_setup_teardown(test_w_correlation_count_global_frequency, setup_correlation, teardown_correlation),
+        cmocka_unit_test_setup_teardown(test_w_correlation_count_clock_back, setup_correlation, teardown_correlation),
+        cmocka_unit_test_setup_teardown(test_w_correlation_count_timeframe_changed, setup_correlation, teardown_correlation),
+        cmocka_unit_test(test_w_correlation_count_no_index),
+        // w_correlation_add_event
+        cmocka_unit_test_setup_teardown(test_w_correlation_add_event_sweep, setup_correlation, teardown_correlation),
+        cmocka_unit_test_setup_teardown(test_w_correlation_add_event_group, setup_correlation, teardown_correlation),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2015, Wazuh Inc.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../../analysisd/event_arena.h"
+
+/* Tests event_arena_alloc */
+
+static void test_event_arena_alloc_aligned(void **state) {
+    event_arena_t arena = { 0 };
+    char * first = event_arena_alloc(&arena, 3);
+    char * second = event_arena_alloc(&arena, 5);
+
+    assert_non_null(first);
+    assert_int_equal((size_t)first % EVENT_ARENA_ALIGN, 0);
+    assert_int_equal((size_t)second % EVENT_ARENA_ALIGN, 0);
+    assert_ptr_equal(second, first + EVENT_ARENA_ALIGN);
+    assert_int_equal(arena.used, 2 * EVENT_ARENA_ALIGN);
+
+    event_arena_free(&arena);
+}
+
+static void test_event_arena_alloc_grow(void **state) {
+    event_arena_t arena = { 0 };
+    char * small = event_arena_alloc(&arena, 8);
+    char * large = event_arena_alloc(&arena, EVENT_ARENA_MAX_SIZE * 4);
+
+    // Requests larger than a chunk get their own chunk
+    assert_non_null(arena.chunks->next);
+    assert_true(arena.chunks->size >= EVENT_ARENA_MAX_SIZE * 4);
+    memset(large, 'x', EVENT_ARENA_MAX_SIZE * 4);
+
+    assert_true(event_arena_owns(&arena, small));
+    assert_true(event_arena_owns(&arena, large));
+
+    event_arena_free(&arena);
+}
+
+/* Tests event_arena_strdup */
+
+static void test_event_arena_strdup(void **state) {
+    event_arena_t arena = { 0 };
+    char * copy = event_arena_strdup(&arena, "srcip");
+
+    assert_string_equal(copy, "srcip");
+    assert_null(event_arena_strdup(&arena, NULL));
+
+    event_arena_free(&arena);
+}
+
+/* Tests event_arena_owns */
+
+static void test_event_arena_owns(void **state) {
+    event_arena_t arena = { 0 };
+    char outside[] = "outside";
+    char * inside;
+
+    assert_false(event_arena_owns(&arena, outside));
+
+    inside = event_arena_strdup(&arena, "inside");
+
+    assert_true(event_arena_owns(&arena, inside));
+    assert_false(event_arena_owns(&arena, outside));
+    assert_false(event_arena_owns(&arena, NULL));
+
+    event_arena_free(&arena);
+}
+
+/* Tests event_arena_free */
+
+static void test_event_arena_free_reuse(void **state) {
+    event_arena_t arena = { 0 };
+
+    event_arena_strdup(&arena, "value");
+    event_arena_free(&arena);
+
+    assert_null(arena.chunks);
+    assert_int_equal(arena.used, 0);
+
+    // The arena can be used again after being freed
+    assert_string_equal(event_arena_strdup(&arena, "again"), "again");
+
+    event_arena_free(&arena);
+    event_arena_free(&arena);
+}
+
+int main() {
+    const struct CMUnitTest tests[] = {
+        // event_arena_alloc
+        cmocka_unit_test(test_event_arena_alloc_aligned),
+        cmocka_unit_test(test_event_arena_alloc_grow),
+        // event_arena_strdup
+        cmocka_unit_test(test_event_arena_strdup),
+        // event_arena_owns
+        cmocka_unit_test(test_event_arena_owns),
+        // event_arena_free
+        cmocka_unit_test(test_event_arena_free_reuse),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -31,19 +31,36 @@ static int teardown_labels_local(void **state) {
     return OS_SUCCESS;
 }
 
+/* auxiliary functions */
+
+static cJSON * dummy_labels() {
+    cJSON* array = cJSON_CreateArray();
+    cJSON* label1 = cJSON_CreateObject();
+    cJSON_AddStringToObject(label1, "key", "#\"_system_label\"");
+    cJSON_AddStringToObject(label1, "value", "system_value");
+    cJSON_AddItemToArray(array, label1);
+    cJSON* label2 = cJSON_CreateObject();
+    cJSON_AddStringToObject(label2, "key", "!\"_hidden_label\"");
+    cJSON_AddStringToObject(label2, "value", "hidden_value");
+    cJSON_AddItemToArray(array, label2);
+    cJSON* label3 = cJSON_CreateObject();
+    cJSON_AddStringToObject(label3, "key", "\"label\"");
+    cJSON_AddStringToObject(label3, "value", "value");
+    cJSON_AddItemToArray(array, label3);
+    return array;
+}
+
 /* tests */
 
 void test_labels_find_manager_no_labels(void **state) {
-    int sock = -1;
     char *agent_id = "000";
 
-    wlabel_t *labels = labels_find(agent_id, &sock);
+    wlabel_t *labels = labels_find(agent_id);
 
     assert_null(labels);
 }
 
 void test_labels_find_manager_with_labels(void **state) {
-    int sock = -1;
     char *agent_id = "000";
     wlabel_t *manager_labels = NULL;
 
@@ -51,49 +68,31 @@ void test_labels_find_manager_with_labels(void **state) {
     os_calloc(1, sizeof(wlabel_t), manager_labels);
     Config.labels = manager_labels;
 
-    wlabel_t *labels = labels_find(agent_id, &sock);
+    wlabel_t *labels = labels_find(agent_id);
 
     assert_ptr_equal(manager_labels, labels);
     os_free(manager_labels);
+    Config.labels = NULL;
 }
 
-void test_labels_find_agent_no_labels(void **state) {
-    int sock = -1;
+void test_labels_find_agent_not_cached(void **state) {
     char *agent_id = "001";
 
-    // Requesting labels to Wazuh DB
-    expect_value(__wrap_wdb_get_agent_labels, id, 1);
-    will_return(__wrap_wdb_get_agent_labels, NULL);
-
-    wlabel_t *labels = labels_find(agent_id, &sock);
+    // Wazuh DB is not queried from the event path
+    wlabel_t *labels = labels_find(agent_id);
 
     assert_null(labels);
 }
 
 void test_labels_find_agent_with_labels(void **state) {
-    int sock = -1;
     char *agent_id = "001";
+    cJSON *array = dummy_labels();
 
-    // Creating a dummy set of labels
-    cJSON* array = cJSON_CreateArray();
-    cJSON* label1 = cJSON_CreateObject();
-    cJSON_AddStringToObject(label1, "key", "#\"_system_label\"");
-    cJSON_AddStringToObject(label1, "value", "system_value");
-    cJSON_AddItemToArray(array, label1);
-    cJSON* label2 = cJSON_CreateObject();
-    cJSON_AddStringToObject(label2, "key", "!\"_hidden_label\"");
-    cJSON_AddStringToObject(label2, "value", "hidden_value");
-    cJSON_AddItemToArray(array, label2);
-    cJSON* label3 = cJSON_CreateObject();
-    cJSON_AddStringToObject(label3, "key", "\"label\"");
-    cJSON_AddStringToObject(label3, "value", "value");
-    cJSON_AddItemToArray(array, label3);
-
-    // Requesting labels to Wazuh DB
-    expect_value(__wrap_wdb_get_agent_labels, id, 1);
-    will_return(__wrap_wdb_get_agent_labels, array);
+    Config.label_cache_maxage = 60;
+    assert_int_equal(labels_cache_set(agent_id, array), OS_SUCCESS);
+    cJSON_Delete(array);
 
-    wlabel_t *labels = labels_find(agent_id, &sock);
+    wlabel_t *labels = labels_find(agent_id);
 
     assert_non_null(labels);
     assert_string_equal("system_value", labels_get(labels, "_system_label"));
@@ -102,13 +101,76 @@ void test_labels_find_agent_with_labels(void **state) {
     labels_free(labels);
 }
 
+void test_labels_cache_set_invalid(void **state) {
+    cJSON *object = cJSON_CreateObject();
+
+    assert_int_equal(labels_cache_set("001", object), OS_INVALID);
+    assert_int_equal(labels_cache_set("001", NULL), OS_INVALID);
+    cJSON_Delete(object);
+}
+
+void test_labels_cache_set_replace(void **state) {
+    char *agent_id = "001";
+    cJSON *array = dummy_labels();
+    cJSON *empty = cJSON_CreateArray();
+
+    Config.label_cache_maxage = 60;
+    labels_cache_set(agent_id, array);
+    labels_cache_set(agent_id, empty);
+    cJSON_Delete(array);
+    cJSON_Delete(empty);
+
+    wlabel_t *labels = labels_find(agent_id);
+
+    assert_null(labels);
+}
+
+void test_labels_refresh_thread(void **state) {
+    int *agents = NULL;
+
+    os_calloc(2, sizeof(int), agents);
+    agents[0] = 1;
+    agents[1] = -1;
+
+    Config.label_cache_maxage = 60;
+
+    // Agent 002 is queued by the event path
+    assert_null(labels_find("002"));
+
+    // Filling the cache at startup
+    expect_value(__wrap_wdb_get_all_agents, include_manager, false);
+    will_return(__wrap_wdb_get_all_agents, agents);
+
+    expect_value(__wrap_wdb_get_agent_labels, id, 1);
+    will_return(__wrap_wdb_get_agent_labels, dummy_labels());
+
+    // Serving the queued agent
+    expect_value(__wrap_wdb_get_agent_labels, id, 2);
+    will_return(__wrap_wdb_get_agent_labels, NULL);
+
+    labels_refresh_thread(NULL);
+
+    wlabel_t *labels = labels_find("001");
+
+    assert_non_null(labels);
+    assert_string_equal("value", labels_get(labels, "label"));
+    labels_free(labels);
+
+    assert_null(labels_find("002"));
+}
+
 int main(void) {
     const struct CMUnitTest tests[] = {
-        /* dispatch_send_local */
+        /* labels_find */
         cmocka_unit_test_setup_teardown(test_labels_find_manager_no_labels, setup_labels_context, teardown_labels_local),
         cmocka_unit_test_setup_teardown(test_labels_find_manager_with_labels, setup_labels_context, teardown_labels_local),
-        cmocka_unit_test_setup_teardown(test_labels_find_agent_no_labels, setup_labels_context, teardown_labels_local),
-        cmocka_unit_test_setup_teardown(test_labels_find_agent_with_labels, setup_labels_context, teardown_labels_local)
+        cmocka_unit_test_setup_teardown(test_labels_find_agent_not_cached, setup_labels_context, teardown_labels_local),
+        cmocka_unit_test_setup_teardown(test_labels_find_agent_with_labels, setup_labels_context, teardown_labels_local),
+        /* labels_cache_set */
+        cmocka_unit_test_setup_teardown(test_labels_cache_set_invalid, setup_labels_context, teardown_labels_local),
+        cmocka_unit_test_setup_teardown(test_labels_cache_set_replace, setup_labels_context, teardown_labels_local),
+        /* labels_refresh_thread */
+        cmocka_unit_test_setup_teardown(test_labels_refresh_thread, setup_labels_context, teardown_labels_local)
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
@@ -22,6 +22,8 @@
 #include <string.h>
 #include <errno.h>
 
+#include "../../analysisd/cdb/cdb_make.h"
+
 void os_remove_cdblist(ListNode **l_node);
 void os_remove_cdbrules(ListRule **l_rule);
 ListNode *OS_FindList(const char *listname, ListNode **l_node);
@@ -203,6 +205,93 @@ void test_OS_ListLoadRules_already_load(void ** state) {
     os_free(lrule);
 }
 
+/* OS_DBSearch */
+static ListNode * create_cdb_list(char * filename) {
+    struct cdb_make cdbm;
+    ListNode * node;
+    FILE * fp;
+    int fd;
+
+    fd = mkstemp(filename);
+    assert_int_not_equal(fd, -1);
+    fp = fdopen(fd, "w+");
+    assert_non_null(fp);
+
+    cdb_make_start(&cdbm, fp);
+    cdb_make_add(&cdbm, "root", 4, "admin", 5);
+    cdb_make_add(&cdbm, "10.1.", 5, "lan", 3);
+    cdb_make_add(&cdbm, "192.168.0.1", 11, "gw", 2);
+    assert_int_equal(cdb_make_finish(&cdbm), 0);
+    fclose(fp);
+
+    os_calloc(1, sizeof(ListNode), node);
+    os_strdup(filename, node->cdb_filename);
+    os_strdup(filename, node->txt_filename);
+    node->mutex = (pthread_mutex_t) PTHREAD_MUTEX_INITIALIZER;
+    return node;
+}
+
+void test_cdb_lookup(void ** state) {
+    char filename[] = "/tmp/test_lists_list_XXXXXX";
+    ListNode * node = create_cdb_list(filename);
+    uint32 vpos, vlen;
+    char val[8] = {0};
+    int fd;
+
+    fd = open(filename, O_RDONLY);
+    cdb_init(&node->cdb, fd);
+    node->loaded = 1;
+
+    assert_non_null(node->cdb.bloom);
+    assert_int_equal(cdb_lookup(&node->cdb, "root", 4, &vpos, &vlen), 1);
+    assert_int_equal(vlen, 5);
+    assert_int_equal(cdb_read(&node->cdb, val, vlen, vpos), 0);
+    assert_string_equal(val, "admin");
+    assert_int_equal(cdb_lookup(&node->cdb, "roo", 3, &vpos, &vlen), 0);
+    assert_int_equal(cdb_lookup(&node->cdb, "user", 4, &vpos, &vlen), 0);
+
+    os_remove_cdblist(&node);
+    unlink(filename);
+}
+
+void test_OS_DBSearch_string(void ** state) {
+    char filename[] = "/tmp/test_lists_list_XXXXXX";
+    ListNode * node = create_cdb_list(filename);
+    ListRule lrule = { .loaded = 1, .db = node, .mutex = PTHREAD_MUTEX_INITIALIZER };
+
+    lrule.lookup_type = LR_STRING_MATCH;
+    assert_int_equal(OS_DBSearch(&lrule, "root", &node), 1);
+    assert_int_equal(OS_DBSearch(&lrule, "user", &node), 0);
+    assert_int_equal(node->loaded, 1);
+
+    lrule.lookup_type = LR_STRING_NOT_MATCH;
+    assert_int_equal(OS_DBSearch(&lrule, "root", &node), 0);
+    assert_int_equal(OS_DBSearch(&lrule, "user", &node), 1);
+
+    os_remove_cdblist(&node);
+    unlink(filename);
+}
+
+void test_OS_DBSearch_address(void ** state) {
+    char filename[] = "/tmp/test_lists_list_XXXXXX";
+    ListNode * node = create_cdb_list(filename);
+    ListRule lrule = { .loaded = 1, .db = node, .mutex = PTHREAD_MUTEX_INITIALIZER };
+
+    lrule.lookup_type = LR_ADDRESS_MATCH;
+    assert_int_equal(OS_DBSearch(&lrule, "192.168.0.1", &node), 1);
+    // Found by its subnet
+    assert_int_equal(OS_DBSearch(&lrule, "10.1.2.3", &node), 1);
+    assert_int_equal(OS_DBSearch(&lrule, "10.2.2.3", &node), 0);
+    assert_int_equal(OS_DBSearch(&lrule, "192.168.0.2", &node), 0);
+
+    lrule.lookup_type = LR_ADDRESS_NOT_MATCH;
+    assert_int_equal(OS_DBSearch(&lrule, "10.1.2.3", &node), 0);
+    assert_int_equal(OS_DBSearch(&lrule, "10.2.2.3", &node), 1);
+
+    os_remove_cdblist(&node);
+    unlink(filename);
+}
+
 int main(void)
 {
     const struct CMUnitTest tests[] = {
@@ -220,6 +309,11 @@ int main(void)
         cmocka_unit_test(test_OS_ListLoadRules_list_checked),
         cmocka_unit_test(test_OS_ListLoadRules_list_checked_and_load),
         cmocka_unit_test(test_OS_ListLoadRules_already_load),
+        // Tests cdb_lookup
+        cmocka_unit_test(test_cdb_lookup),
+        // Tests OS_DBSearch
+        cmocka_unit_test(test_OS_DBSearch_string),
+        cmocka_unit_test(test_OS_DBSearch_address),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
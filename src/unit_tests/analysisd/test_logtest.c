@@ -913,6 +913,56 @@ void test_w_logtest_remove_session_OK(void **state)
 
 }
 
+/* w_logtest_shared_ruleset_get */
+void test_w_logtest_shared_ruleset_get_error_decoders(void **state)
+{
+    char * decoders[] = { "test_decoders.xml", NULL };
+    _Config ruleset_config = { .decoders = decoders };
+
+    will_return(__wrap_pthread_mutex_lock, 0);
+    will_return(__wrap_ReadDecodeXML, 0);
+    will_return(__wrap_pthread_mutex_unlock, 0);
+
+    assert_null(w_logtest_shared_ruleset_get(&ruleset_config, NULL));
+}
+
+void test_w_logtest_shared_ruleset_get_reuse(void **state)
+{
+    _Config ruleset_config = { 0 };
+    w_logtest_shared_ruleset_t * first;
+    w_logtest_shared_ruleset_t * second;
+
+    /* The first session loads the decoders and lists */
+    will_return(__wrap_pthread_mutex_lock, 0);
+    will_return(__wrap_SetDecodeXML, 1);
+    will_return(__wrap_pthread_mutex_unlock, 0);
+
+    first = w_logtest_shared_ruleset_get(&ruleset_config, NULL);
+
+    assert_non_null(first);
+    assert_int_equal(first->references, 2);
+
+    /* The files did not change, so the next session uses the same snapshot */
+    will_return(__wrap_pthread_mutex_lock, 0);
+    will_return(__wrap_pthread_mutex_unlock, 0);
+
+    second = w_logtest_shared_ruleset_get(&ruleset_config, NULL);
+
+    assert_ptr_equal(first, second);
+    assert_int_equal(second->references, 3);
+
+    /* The current snapshot is kept when its sessions are removed */
+    will_return(__wrap_pthread_mutex_lock, 0);
+    will_return(__wrap_pthread_mutex_unlock, 0);
+    w_logtest_shared_ruleset_release(first);
+
+    will_return(__wrap_pthread_mutex_lock, 0);
+    will_return(__wrap_pthread_mutex_unlock, 0);
+    w_logtest_shared_ruleset_release(second);
+
+    assert_int_equal(first->references, 1);
+}
+
 /* w_logtest_check_inactive_sessions */
 void test_w_logtest_check_inactive_sessions_no_remove(void **state)
 {
@@ -6585,6 +6635,9 @@ int main(void)
         // Tests w_logtest_remove_session
         cmocka_unit_test(test_w_logtest_remove_session_fail),
         cmocka_unit_test(test_w_logtest_remove_session_OK),
+        // Tests w_logtest_shared_ruleset_get
+        cmocka_unit_test(test_w_logtest_shared_ruleset_get_error_decoders),
+        cmocka_unit_test(test_w_logtest_shared_ruleset_get_reuse),
         // Tests w_logtest_check_inactive_sessions
         cmocka_unit_test(test_w_logtest_check_inactive_sessions_no_remove),
         cmocka_unit_test(test_w_logtest_check_inactive_sessions_remove),
@@ -25,6 +25,42 @@ void os_remove_ruleinfo(RuleInfo *ruleinfo);
 void os_remove_rules_list(RuleNode *node);
 int OS_AddChild(RuleInfo *read_rule, RuleNode **r_node, OSList* log_msg);
 
+/* Creates a rule with children decoded as the given decoders */
+static RuleNode * create_rule_children(const u_int16_t *decoded_as, int num_children) {
+    RuleNode *node;
+    RuleNode **child;
+
+    os_calloc(1, sizeof(RuleNode), node);
+    os_calloc(1, sizeof(RuleInfo), node->ruleinfo);
+
+    child = &node->child;
+
+    for (int i = 0; i < num_children; i++) {
+        os_calloc(1, sizeof(RuleNode), *child);
+        os_calloc(1, sizeof(RuleInfo), (*child)->ruleinfo);
+        (*child)->ruleinfo->sigid = i + 1;
+        (*child)->ruleinfo->decoded_as = decoded_as[i];
+        child = &(*child)->next;
+    }
+
+    return node;
+}
+
+static void free_rule_children(RuleNode *node) {
+    RuleNode *child = node->child;
+
+    while (child) {
+        RuleNode *next = child->next;
+        os_free(child->ruleinfo);
+        os_free(child);
+        child = next;
+    }
+
+    os_remove_children_index(node);
+    os_free(node->ruleinfo);
+    os_free(node);
+}
+
 /* setup/teardown */
 
 static int setup_AR(void **state) {
@@ -172,6 +208,129 @@ void test_os_remove_rulenode_child(void **state)
 
 }
 
+/* OS_IndexRules */
+void test_OS_IndexRules_few_children(void **state)
+{
+    const u_int16_t decoded_as[] = {1, 2, 0};
+    RuleNode *node = create_rule_children(decoded_as, 3);
+
+    OS_IndexRules(node);
+
+    assert_null(node->children_index);
+
+    free_rule_children(node);
+}
+
+void test_OS_IndexRules_no_decoded_as(void **state)
+{
+    const u_int16_t decoded_as[10] = {0};
+    RuleNode *node = create_rule_children(decoded_as, 10);
+
+    OS_IndexRules(node);
+
+    assert_null(node->children_index);
+
+    free_rule_children(node);
+}
+
+void test_OS_IndexRules_decoded_as(void **state)
+{
+    const u_int16_t decoded_as[] = {5, 0, 3, 5, 0, 7, 3, 0, 5, 0};
+    RuleNode *node = create_rule_children(decoded_as, 10);
+    RuleNode **children;
+
+    OS_IndexRules(node);
+
+    assert_non_null(node->children_index);
+    assert_int_equal(node->children_index->decoders_size, 3);
+
+    // Children decoded as 5 or without decoded_as, in order
+    children = OS_GetRuleChildren(node, 5);
+    assert_int_equal(children[0]->ruleinfo->sigid, 1);
+    assert_int_equal(children[1]->ruleinfo->sigid, 2);
+    assert_int_equal(children[2]->ruleinfo->sigid, 4);
+    assert_int_equal(children[3]->ruleinfo->sigid, 5);
+    assert_int_equal(children[4]->ruleinfo->sigid, 8);
+    assert_int_equal(children[5]->ruleinfo->sigid, 9);
+    assert_int_equal(children[6]->ruleinfo->sigid, 10);
+    assert_null(children[7]);
+
+    children = OS_GetRuleChildren(node, 7);
+    assert_int_equal(children[0]->ruleinfo->sigid, 2);
+    assert_int_equal(children[1]->ruleinfo->sigid, 5);
+    assert_int_equal(children[2]->ruleinfo->sigid, 6);
+    assert_int_equal(children[3]->ruleinfo->sigid, 8);
+    assert_int_equal(children[4]->ruleinfo->sigid, 10);
+    assert_null(children[5]);
+
+    // Decoder without rules
+    children = OS_GetRuleChildren(node, 4);
+    assert_int_equal(children[0]->ruleinfo->sigid, 2);
+    assert_int_equal(children[1]->ruleinfo->sigid, 5);
+    assert_int_equal(children[2]->ruleinfo->sigid, 8);
+    assert_int_equal(children[3]->ruleinfo->sigid, 10);
+    assert_null(children[4]);
+
+    free_rule_children(node);
+}
+
+/* OS_CreateRuleIndex */
+void test_OS_CreateRuleIndex_first_node(void **state)
+{
+    const u_int16_t decoded_as[3] = {0};
+    RuleNode *node = create_rule_children(decoded_as, 3);
+    RuleInfo child = { .sigid = 100, .if_sid = "2" };
+    RuleInfo grandchild = { .sigid = 101, .if_sid = "100" };
+    OSHash *sid_index;
+
+    // Rule 2 is repeated after rule 3, the first one is the parent
+    os_calloc(1, sizeof(RuleNode), node->child->next->next->next);
+    node->child->next->next->next->ruleinfo = node->child->next->ruleinfo;
+
+    sid_index = OS_CreateRuleIndex(node);
+
+    assert_true(OS_RuleIndexHas(sid_index, 2));
+    assert_false(OS_RuleIndexHas(sid_index, 100));
+
+    assert_int_equal(OS_AddIndexedChild(&child, &node, sid_index, NULL), 0);
+    assert_true(OS_RuleIndexHas(sid_index, 100));
+    assert_ptr_equal(node->child->next->child->ruleinfo, &child);
+    assert_null(node->child->next->next->next->child);
+
+    // The parent is searched in the list the first time
+    assert_int_equal(OS_AddIndexedChild(&grandchild, &node, sid_index, NULL), 0);
+    assert_ptr_equal(node->child->next->child->child->ruleinfo, &grandchild);
+
+    OSHash_Free(sid_index);
+    os_free(node->child->next->child->child);
+    os_free(node->child->next->child);
+    os_free(node->child->next->next->next);
+    node->child->next->next->next = NULL;
+    free_rule_children(node);
+}
+
+void test_OS_CreateRuleIndex_parent_not_found(void **state)
+{
+    const u_int16_t decoded_as[3] = {0};
+    RuleNode *node = create_rule_children(decoded_as, 3);
+    RuleInfo child = { .sigid = 100, .if_sid = "50" };
+    OSHash *sid_index = OS_CreateRuleIndex(node);
+
+    expect_value(__wrap__os_analysisd_add_logmsg, level, LOGLEVEL_WARNING);
+    expect_value(__wrap__os_analysisd_add_logmsg, list, NULL);
+    expect_string(__wrap__os_analysisd_add_logmsg, formatted_msg, "(7617): Signature ID '50' was not found and will be ignored "
+                  "in the 'if_sid' option of rule '100'.");
+    expect_value(__wrap__os_analysisd_add_logmsg, level, LOGLEVEL_WARNING);
+    expect_value(__wrap__os_analysisd_add_logmsg, list, NULL);
+    expect_string(__wrap__os_analysisd_add_logmsg, formatted_msg, "(7619): Empty 'if_sid' value. Rule '100' will be ignored.");
+
+    assert_int_equal(OS_AddIndexedChild(&child, &node, sid_index, NULL), -1);
+    assert_false(OS_RuleIndexHas(sid_index, 100));
+
+    OSHash_Free(sid_index);
+    free_rule_children(node);
+}
+
 /* os_remove_ruleinfo */
 void test_os_remove_ruleinfo_NULL(void **state)
 {
@@ -325,6 +484,13 @@ int main(void)
         // Tests os_remove_rulenode
         cmocka_unit_test(test_os_remove_rulenode_no_child),
         cmocka_unit_test(test_os_remove_rulenode_child),
+        // Tests OS_IndexRules
+        cmocka_unit_test(test_OS_IndexRules_few_children),
+        cmocka_unit_test(test_OS_IndexRules_no_decoded_as),
+        cmocka_unit_test(test_OS_IndexRules_decoded_as),
+        // Tests OS_CreateRuleIndex
+        cmocka_unit_test(test_OS_CreateRuleIndex_first_node),
+        cmocka_unit_test(test_OS_CreateRuleIndex_parent_not_found),
         // Tests os_remove_ruleinfo
         cmocka_unit_test(test_os_remove_ruleinfo_NULL),
         cmocka_unit_test_setup_teardown(test_os_remove_ruleinfo_OK, setup_AR, teardown_AR),
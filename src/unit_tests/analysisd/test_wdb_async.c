@@ -0,0 +1,216 @@
+/*
+ * Copyright (C) 2015, Wazuh Inc.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdio.h>
+
+#include "../../headers/shared.h"
+#include "../../analysisd/wdb_async.h"
+#include "../wrappers/wazuh/shared/debug_op_wrappers.h"
+#include "../wrappers/wazuh/wazuh_db/wdb_wrappers.h"
+
+size_t wdb_async_pack(wdb_async_op_t ** ops, size_t count, char * buffer, size_t size, size_t * packed);
+unsigned int wdb_async_frame_result(const char * response, size_t length, unsigned int operations);
+size_t wdb_async_coalesce(wdb_async_op_t ** ops, size_t count);
+
+/* auxiliary functions */
+
+static void op_init(wdb_async_op_t * op, bool frame, uint32_t agent, unsigned char type, unsigned char argument, char * name, char * data) {
+    memset(op, 0, sizeof(wdb_async_op_t));
+    op->frame = frame;
+    op->agent = agent;
+    op->type = type;
+    op->argument = argument;
+    op->name = name;
+    op->data = data;
+    op->data_length = strlen(data);
+}
+
+static size_t response_add(char * response, size_t length, unsigned char status, const char * message) {
+    response[length] = status;
+    response[length + 1] = strlen(message);
+    memcpy(response + length + 2, message, strlen(message));
+    return length + 2 + strlen(message);
+}
+
+/* Tests wdb_async_pack */
+
+static void test_wdb_async_pack_frame(void **state) {
+    wdb_async_op_t ops[3];
+    wdb_async_op_t * batch[] = { &ops[0], &ops[1], &ops[2] };
+    char buffer[OS_SIZE_1024];
+    uint32_t value;
+    uint16_t total;
+    size_t packed;
+    size_t length;
+
+    op_init(&ops[0], true, 1, WDB_FRAME_DBSYNC, WDB_FRAME_DBSYNC_MODIFIED, "ports", "{\"a\":1}");
+    op_init(&ops[1], true, 1, WDB_FRAME_FIM_SAVE, 0, NULL, "{}");
+    op_init(&ops[2], false, 1, 0, 0, NULL, "agent 001 syscheck delete /etc");
+
+    length = wdb_async_pack(batch, 3, buffer, sizeof(buffer), &packed);
+
+    // The text query is not packed
+    assert_int_equal(packed, 2);
+    assert_int_equal(length, WDB_FRAME_HEADER + 2 * WDB_FRAME_OP_HEADER + 5 + 7 + 2);
+
+    assert_int_equal((unsigned char)buffer[0], WDB_FRAME_MAGIC);
+    assert_int_equal(buffer[1], WDB_FRAME_VERSION);
+    memcpy(&total, buffer + 2, sizeof(total));
+    assert_int_equal(ntohs(total), 2);
+
+    assert_int_equal(buffer[4], WDB_FRAME_DBSYNC);
+    memcpy(&value, buffer + 5, sizeof(value));
+    assert_int_equal(ntohl(value), 1);
+    assert_int_equal(buffer[9], WDB_FRAME_DBSYNC_MODIFIED);
+    assert_int_equal(buffer[10], 5);
+    memcpy(&value, buffer + 11, sizeof(value));
+    assert_int_equal(ntohl(value), 7);
+    assert_memory_equal(buffer + 15, "ports{\"a\":1}", 12);
+
+    assert_int_equal(buffer[27], WDB_FRAME_FIM_SAVE);
+    assert_int_equal(buffer[33], 0);
+    assert_memory_equal(buffer + 38, "{}", 2);
+}
+
+static void test_wdb_async_pack_size(void **state) {
+    wdb_async_op_t ops[2];
+    wdb_async_op_t * batch[] = { &ops[0], &ops[1] };
+    char buffer[OS_SIZE_1024];
+    size_t packed;
+    size_t length;
+
+    op_init(&ops[0], true, 1, WDB_FRAME_FIM_SAVE, 0, NULL, "first");
+    op_init(&ops[1], true, 2, WDB_FRAME_FIM_SAVE, 0, NULL, "second");
+
+    // The second operation goes to the next frame
+    length = wdb_async_pack(batch, 2, buffer, WDB_FRAME_HEADER + WDB_FRAME_OP_HEADER + 8, &packed);
+
+    assert_int_equal(packed, 1);
+    assert_int_equal(length, WDB_FRAME_HEADER + WDB_FRAME_OP_HEADER + 5);
+}
+
+/* Tests wdb_async_coalesce */
+
+static wdb_async_op_t * op_new(uint32_t agent, unsigned char type, unsigned char argument, const char * data) {
+    wdb_async_op_t * op;
+    char * copy;
+
+    os_calloc(1, sizeof(wdb_async_op_t), op);
+    os_strdup(data, copy);
+    op_init(op, true, agent, type, argument, NULL, copy);
+    return op;
+}
+
+static void test_wdb_async_coalesce(void **state) {
+    wdb_async_op_t * ops[5];
+    size_t count;
+
+    ops[0] = op_new(1, WDB_FRAME_SYSCOLLECTOR_SAVE, 6, "{\"a\":1}");
+    ops[1] = op_new(1, WDB_FRAME_SYSCOLLECTOR_SAVE, 6, "{\"a\":2}");
+    ops[2] = op_new(1, WDB_FRAME_SYSCOLLECTOR_SAVE, 7, "{\"b\":1}");
+    ops[3] = op_new(2, WDB_FRAME_SYSCOLLECTOR_SAVE, 7, "{\"b\":2}");
+    ops[4] = op_new(2, WDB_FRAME_FIM_SAVE, 0, "{}");
+
+    count = wdb_async_coalesce(ops, 5);
+
+    // Only the saves of the same agent and component are merged
+    assert_int_equal(count, 4);
+    assert_int_equal(ops[0]->type, WDB_FRAME_SYSCOLLECTOR_BATCH);
+    assert_int_equal(ops[0]->data_length, strlen("[{\"a\":1},{\"a\":2}]"));
+    assert_memory_equal(ops[0]->data, "[{\"a\":1},{\"a\":2}]", ops[0]->data_length);
+    assert_int_equal(ops[1]->type, WDB_FRAME_SYSCOLLECTOR_SAVE);
+    assert_int_equal(ops[1]->argument, 7);
+    assert_int_equal(ops[2]->type, WDB_FRAME_SYSCOLLECTOR_SAVE);
+    assert_int_equal(ops[2]->agent, 2);
+    assert_int_equal(ops[3]->type, WDB_FRAME_FIM_SAVE);
+
+    for (size_t i = 0; i < count; i++) {
+        os_free(ops[i]->data);
+        os_free(ops[i]);
+    }
+}
+
+/* Tests wdb_async_frame_result */
+
+static void test_wdb_async_frame_result_ok(void **state) {
+    char response[OS_SIZE_256] = { (char)WDB_FRAME_MAGIC, WDB_FRAME_VERSION, 0, 2 };
+    size_t length = WDB_FRAME_HEADER;
+
+    length = response_add(response, length, 0, "");
+    length = response_add(response, length, 1, "Agent not found");
+
+    assert_int_equal(wdb_async_frame_result(response, length, 2), 1);
+}
+
+static void test_wdb_async_frame_result_error(void **state) {
+    char response[OS_SIZE_256] = { (char)WDB_FRAME_MAGIC, WDB_FRAME_VERSION, 0, 1 };
+    size_t length = WDB_FRAME_HEADER;
+
+    length = response_add(response, length, 1, "Cannot save Syscheck");
+
+    expect_string(__wrap__merror, formatted_msg, "wazuh-db client: Bad response from database: Cannot save Syscheck");
+    expect_string(__wrap__merror, formatted_msg, "wazuh-db client: 2 operations of a frame were not processed.");
+
+    assert_int_equal(wdb_async_frame_result(response, length, 3), 3);
+}
+
+static void test_wdb_async_frame_result_invalid(void **state) {
+    expect_string(__wrap__merror, formatted_msg, "wazuh-db client: Invalid response to a frame.");
+
+    assert_int_equal(wdb_async_frame_result("ok", 2, 4), 4);
+}
+
+/* Tests wdb_async_query */
+
+static void test_wdb_async_query_disabled(void **state) {
+    assert_false(wdb_async_enabled());
+    assert_int_equal(wdb_async_query("001", "agent 001 syscheck delete /etc"), -1);
+    assert_int_equal(wdb_async_frame_op(WDB_FRAME_FIM_SAVE, "001", 0, NULL, "{}"), -1);
+}
+
+/* Tests wdb_async_query_ex */
+
+static void test_wdb_async_query_ex_disabled(void **state) {
+    char response[OS_SIZE_256];
+    int sock = -1;
+
+    // The query is sent synchronously
+    expect_value(__wrap_wdbc_query_ex, *sock, -1);
+    expect_string(__wrap_wdbc_query_ex, query, "agent 001 syscollector_ports integrity_check_global {}");
+    expect_value(__wrap_wdbc_query_ex, len, OS_SIZE_256);
+    will_return(__wrap_wdbc_query_ex, "ok ");
+    will_return(__wrap_wdbc_query_ex, 0);
+
+    assert_int_equal(wdb_async_query_ex(&sock, "001", "agent 001 syscollector_ports integrity_check_global {}", response, OS_SIZE_256), 0);
+    assert_string_equal(response, "ok ");
+}
+
+int main() {
+    const struct CMUnitTest tests[] = {
+        // wdb_async_pack
+        cmocka_unit_test(test_wdb_async_pack_frame),
+        cmocka_unit_test(test_wdb_async_pack_size),
+        // wdb_async_coalesce
+        cmocka_unit_test(test_wdb_async_coalesce),
+        // wdb_async_frame_result
+        cmocka_unit_test(test_wdb_async_frame_result_ok),
+        cmocka_unit_test(test_wdb_async_frame_result_error),
+        cmocka_unit_test(test_wdb_async_frame_result_invalid),
+        // wdb_async_query
+        cmocka_unit_test(test_wdb_async_query_disabled),
+        // wdb_async_query_ex
+        cmocka_unit_test(test_wdb_async_query_ex_disabled),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
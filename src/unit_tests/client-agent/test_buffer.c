@@ -18,10 +18,29 @@
 #include "../wrappers/posix/pthread_wrappers.h"
 
 int w_agentd_get_buffer_lenght();
+size_t build_event_batch(char ** events, unsigned int count, char * batch);
+void buffer_set_credit(const char * ack_options);
+int current_eps();
+
+typedef struct buffer_lane_t {
+    const char * name;
+    const char * queues;
+    int weight;
+    char ** events;
+    unsigned int head;
+    unsigned int count;
+    int credit;
+} buffer_lane_t;
+
+buffer_lane_t * lane_of(const char * msg);
+buffer_lane_t * next_lane();
+char * take_event(buffer_lane_t * lane);
 
 extern agent *agt;
-extern int i;
-extern int j;
+extern int min_eps;
+extern unsigned int buffered;
+extern unsigned int current_lane;
+extern buffer_lane_t lanes[];
 
 /* setup/teardown */
 
@@ -57,8 +76,7 @@ void test_w_agentd_get_buffer_lenght_buffer_empty(void ** state)
     os_calloc(1, sizeof(agent), agt);
     agt->buffer = 1;
     agt->buflength = 10;
-    i = 1;
-    j = 1;
+    buffered = 0;
 
     expect_function_call(__wrap_pthread_mutex_lock);
 
@@ -77,8 +95,7 @@ void test_w_agentd_get_buffer_lenght_buffer(void ** state)
     os_calloc(1, sizeof(agent), agt);
     agt->buffer = 1;
     agt->buflength = 5;
-    i = 1;
-    j = 5;
+    buffered = 2;
 
     expect_function_call(__wrap_pthread_mutex_lock);
 
@@ -92,12 +109,109 @@ void test_w_agentd_get_buffer_lenght_buffer(void ** state)
 
 }
 
+/* build_event_batch */
+
+void test_build_event_batch(void ** state)
+{
+    char * events[] = { "1:a:foo", "1:b:bar:baz" };
+    char batch[64];
+
+    size_t length = build_event_batch(events, 2, batch);
+
+    assert_string_equal(batch, "#!batch 7:1:a:foo11:1:b:bar:baz");
+    assert_int_equal(length, strlen(batch));
+}
+
+/* lanes */
+
+void test_lane_of(void ** state)
+{
+    assert_string_equal(lane_of("8:syscheck:event")->name, "fim");
+    assert_string_equal(lane_of("d:syscollector:event")->name, "inventory");
+    assert_string_equal(lane_of("5:syscollector:sync")->name, "inventory");
+    assert_string_equal(lane_of("p:sca:event")->name, "sca");
+    assert_string_equal(lane_of("1:/var/log/syslog:line")->name, "logs");
+    assert_string_equal(lane_of("")->name, "logs");
+}
+
+void test_next_lane_weighted(void ** state)
+{
+    char * fim[] = { "8:a", "8:b", "8:c", NULL };
+    char * logs[] = { "1:a", "1:b", NULL, NULL };
+    char * expected[] = { "8:a", "8:b", "1:a", "8:c", "1:b" };
+
+    os_calloc(1, sizeof(agent), agt);
+    agt->buflength = 4;
+    current_lane = 0;
+    buffered = 5;
+
+    for (unsigned int k = 0; k < 4; k++) {
+        lanes[k].events = NULL;
+        lanes[k].head = 0;
+        lanes[k].count = 0;
+        lanes[k].weight = 1;
+        lanes[k].credit = 1;
+    }
+
+    lanes[0].events = fim;
+    lanes[0].count = 3;
+    lanes[0].weight = 2;
+    lanes[0].credit = 2;
+    lanes[3].events = logs;
+    lanes[3].count = 2;
+
+    for (unsigned int k = 0; k < 5; k++) {
+        assert_string_equal(take_event(next_lane()), expected[k]);
+    }
+
+    assert_int_equal(buffered, 0);
+    assert_int_equal(lanes[0].count, 0);
+    assert_int_equal(lanes[3].count, 0);
+
+    for (unsigned int k = 0; k < 4; k++) {
+        lanes[k].events = NULL;
+    }
+
+    os_free(agt);
+}
+
+/* buffer_set_credit */
+
+void test_buffer_set_credit(void ** state)
+{
+    os_calloc(1, sizeof(agent), agt);
+    agt->events_persec = 500;
+    min_eps = 50;
+
+    buffer_set_credit("{\"credit\":40}");
+    assert_int_equal(current_eps(), 200);
+
+    buffer_set_credit("{\"batch\":true,\"credit\":0}");
+    assert_int_equal(current_eps(), 50);
+
+    buffer_set_credit("{\"credit\":250}");
+    assert_int_equal(current_eps(), 500);
+
+    buffer_set_credit("{\"credit\":10}");
+    buffer_set_credit("");
+    assert_int_equal(current_eps(), 500);
+
+    os_free(agt);
+}
+
 int main(void) {
     const struct CMUnitTest tests[] = {
         // Tests w_agentd_get_buffer_lenght
         cmocka_unit_test(test_w_agentd_get_buffer_lenght_buffer_disabled),
         cmocka_unit_test(test_w_agentd_get_buffer_lenght_buffer_empty),
         cmocka_unit_test(test_w_agentd_get_buffer_lenght_buffer),
+        // Tests build_event_batch
+        cmocka_unit_test(test_build_event_batch),
+        // Tests lanes
+        cmocka_unit_test(test_lane_of),
+        cmocka_unit_test(test_next_lane_weighted),
+        // Tests buffer_set_credit
+        cmocka_unit_test(test_buffer_set_credit),
     };
 
     return cmocka_run_group_tests(tests, setup_group, teardown_group);
@@ -29,6 +29,7 @@
 
 extern void send_msg_on_startup(void);
 extern bool agent_handshake_to_server(int server_id, bool is_startup);
+extern bool ack_accepts_batch(const char *options);
 extern void send_agent_stopped_message();
 extern int _s_verify_counter;
 
@@ -472,6 +473,16 @@ static void test_send_agent_stopped_message(void **state) {
     send_agent_stopped_message();
 }
 
+/* ack_accepts_batch */
+static void test_ack_accepts_batch(void **state) {
+    expect_string(__wrap__mdebug1, formatted_msg, "The server accepts batches of events.");
+    assert_true(ack_accepts_batch("{\"batch\":true}"));
+
+    assert_false(ack_accepts_batch(""));
+    assert_false(ack_accepts_batch("{\"batch\":false}"));
+    assert_false(ack_accepts_batch("{\"batch\""));
+}
+
 int main(void) {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test_setup_teardown(test_connect_server, setup_test, teardown_test),
@@ -481,6 +492,7 @@ int main(void) {
         cmocka_unit_test_setup_teardown(test_agent_handshake_to_server_error_getting_msg2, setup_test, teardown_test),
         cmocka_unit_test_setup_teardown(test_send_msg_on_startup, setup_test, teardown_test),
         cmocka_unit_test_setup_teardown(test_send_agent_stopped_message, setup_test, teardown_test),
+        cmocka_unit_test(test_ack_accepts_batch),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2015, Wazuh Inc.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../../headers/shared.h"
+#include "../../logcollector/logcollector.h"
+
+#include "../wrappers/common.h"
+
+/* setup/teardown */
+
+static int setup_file(void **state) {
+    FILE * fp = tmpfile();
+
+    if (fp == NULL) {
+        return -1;
+    }
+
+    *state = fp;
+    return 0;
+}
+
+static int teardown_file(void **state) {
+    fclose((FILE *)*state);
+    return 0;
+}
+
+/* auxiliary functions */
+
+static void write_file(FILE * fp, const char * data, size_t length) {
+    fwrite(data, 1, length, fp);
+    rewind(fp);
+}
+
+/* Tests w_block_reader_gets */
+
+static void test_w_block_reader_gets_lines(void **state) {
+    FILE * fp = *state;
+    w_block_reader_t reader;
+    int64_t length;
+    char * line;
+
+    write_file(fp, "first\nsecond line\n", 18);
+    w_block_reader_init(&reader, fp, 0);
+
+    line = w_block_reader_gets(&reader, OS_MAXSTR, &length);
+    assert_string_equal(line, "first\n");
+    assert_int_equal(length, 6);
+    assert_int_equal(w_block_reader_tell(&reader), 6);
+
+    line = w_block_reader_gets(&reader, OS_MAXSTR, &length);
+    assert_string_equal(line, "second line\n");
+    assert_int_equal(length, 12);
+    assert_int_equal(w_block_reader_tell(&reader), 18);
+
+    assert_null(w_block_reader_gets(&reader, OS_MAXSTR, &length));
+    assert_int_equal(w_block_reader_tell(&reader), 18);
+
+    w_block_reader_free(&reader);
+}
+
+static void test_w_block_reader_gets_offset(void **state) {
+    FILE * fp = *state;
+    w_block_reader_t reader;
+    int64_t length;
+    char * line;
+
+    write_file(fp, "first\nsecond\n", 13);
+    fseek(fp, 6, SEEK_SET);
+    w_block_reader_init(&reader, fp, 6);
+
+    line = w_block_reader_gets(&reader, OS_MAXSTR, &length);
+    assert_string_equal(line, "second\n");
+    assert_int_equal(w_block_reader_tell(&reader), 13);
+
+    w_block_reader_free(&reader);
+}
+
+static void test_w_block_reader_gets_large_line(void **state) {
+    FILE * fp = *state;
+    w_block_reader_t reader;
+    char data[OS_MAXSTR + 8];
+    int64_t length;
+    char * line;
+
+    memset(data, 'x', OS_MAXSTR + 4);
+    memcpy(data + OS_MAXSTR + 4, "\nab\n", 4);
+    write_file(fp, data, sizeof(data));
+    w_block_reader_init(&reader, fp, 0);
+
+    // Like fgets(), a line is split when it doesn't fit in the size given
+    line = w_block_reader_gets(&reader, OS_MAXSTR - OS_LOG_HEADER, &length);
+    assert_int_equal(length, OS_MAXSTR - OS_LOG_HEADER - 1);
+    assert_int_equal(strlen(line), length);
+
+    line = w_block_reader_gets(&reader, OS_MAXSTR - OS_LOG_HEADER, &length);
+    assert_int_equal(length, OS_LOG_HEADER + 6);
+    assert_int_equal(line[length - 1], '\n');
+
+    line = w_block_reader_gets(&reader, OS_MAXSTR - OS_LOG_HEADER, &length);
+    assert_string_equal(line, "ab\n");
+    assert_int_equal(w_block_reader_tell(&reader), sizeof(data));
+
+    w_block_reader_free(&reader);
+}
+
+static void test_w_block_reader_gets_incomplete_line(void **state) {
+    FILE * fp = *state;
+    w_block_reader_t reader;
+    int64_t length;
+    char * line;
+
+    write_file(fp, "first\npartial", 13);
+    w_block_reader_init(&reader, fp, 0);
+
+    line = w_block_reader_gets(&reader, OS_MAXSTR, &length);
+    assert_string_equal(line, "first\n");
+
+    line = w_block_reader_gets(&reader, OS_MAXSTR, &length);
+    assert_string_equal(line, "partial");
+    assert_int_equal(length, 7);
+
+    assert_null(w_block_reader_gets(&reader, OS_MAXSTR, &length));
+
+    w_block_reader_free(&reader);
+}
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        // w_block_reader_gets
+        cmocka_unit_test_setup_teardown(test_w_block_reader_gets_lines, setup_file, teardown_file),
+        cmocka_unit_test_setup_teardown(test_w_block_reader_gets_offset, setup_file, teardown_file),
+        cmocka_unit_test_setup_teardown(test_w_block_reader_gets_large_line, setup_file, teardown_file),
+        cmocka_unit_test_setup_teardown(test_w_block_reader_gets_incomplete_line, setup_file, teardown_file),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
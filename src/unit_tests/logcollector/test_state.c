@@ -37,6 +37,8 @@ void w_logcollector_state_dump();
 void * w_logcollector_state_main(__attribute__((unused)) void * args);
 void _w_logcollector_state_delete_file(w_lc_state_storage_t * state, char * fpath);
 void w_logcollector_state_delete_file(char * fpath);
+void _w_logcollector_state_update_lag(w_lc_state_storage_t * state, char * fpath, uint64_t lag);
+void w_logcollector_state_update_lag(char * fpath, uint64_t lag);
 
 extern cJSON * g_lc_json_stats;
 extern w_lc_state_storage_t * g_lc_states_global;
@@ -349,6 +351,8 @@ void test__w_logcollector_generate_state_one_target(void ** state) {
     expect_value(__wrap_cJSON_AddNumberToObject, number, 5);
     expect_string(__wrap_cJSON_AddNumberToObject, name, "bytes");
     expect_value(__wrap_cJSON_AddNumberToObject, number, 100);
+    expect_string(__wrap_cJSON_AddNumberToObject, name, "lag");
+    expect_value(__wrap_cJSON_AddNumberToObject, number, 0);
 
     expect_function_call(__wrap_cJSON_AddItemToObject);
 
@@ -412,6 +416,8 @@ void test__w_logcollector_generate_state_one_target_restart(void ** state) {
     expect_value(__wrap_cJSON_AddNumberToObject, number, 5);
     expect_string(__wrap_cJSON_AddNumberToObject, name, "bytes");
     expect_value(__wrap_cJSON_AddNumberToObject, number, 100);
+    expect_string(__wrap_cJSON_AddNumberToObject, name, "lag");
+    expect_value(__wrap_cJSON_AddNumberToObject, number, 0);
 
     expect_function_call(__wrap_cJSON_AddItemToObject);
 
@@ -507,6 +513,37 @@ void test_w_logcollector_state_update_file_null(void ** state) {
 }
 
 
+/* _w_logcollector_state_update_lag */
+void test__w_logcollector_state_update_lag_no_data(void ** state) {
+    w_lc_state_storage_t stat = { .states = *state };
+
+    expect_value(__wrap_OSHash_Get, self, stat.states);
+    expect_string(__wrap_OSHash_Get, key, "/test_path");
+    will_return(__wrap_OSHash_Get, NULL);
+
+    _w_logcollector_state_update_lag(&stat, "/test_path", 100);
+}
+
+void test__w_logcollector_state_update_lag_ok(void ** state) {
+    w_lc_state_storage_t stat = { .states = *state };
+    w_lc_state_file_t data = { .bytes = 10, .events = 1, .lag = 50 };
+
+    expect_value(__wrap_OSHash_Get, self, stat.states);
+    expect_string(__wrap_OSHash_Get, key, "/test_path");
+    will_return(__wrap_OSHash_Get, &data);
+
+    _w_logcollector_state_update_lag(&stat, "/test_path", 100);
+
+    assert_int_equal(data.lag, 100);
+    assert_int_equal(data.bytes, 10);
+    assert_int_equal(data.events, 1);
+}
+
+/* w_logcollector_state_update_lag */
+void test_w_logcollector_state_update_lag_null(void ** state) {
+    w_logcollector_state_update_lag(NULL, 100);
+}
+
 /* _w_logcollector_state_update_target */
 void test__w_logcollector_state_update_target_get_file_stats_fail(void ** state) {
     g_lc_state_type = LC_STATE_GLOBAL | LC_STATE_INTERVAL;
@@ -785,6 +822,8 @@ void test_w_logcollector_generate_state_ok(void ** state) {
     expect_value(__wrap_cJSON_AddNumberToObject, number, 5);
     expect_string(__wrap_cJSON_AddNumberToObject, name, "bytes");
     expect_value(__wrap_cJSON_AddNumberToObject, number, 100);
+    expect_string(__wrap_cJSON_AddNumberToObject, name, "lag");
+    expect_value(__wrap_cJSON_AddNumberToObject, number, 0);
     expect_function_call(__wrap_cJSON_AddItemToObject);
 
 
@@ -832,6 +871,8 @@ void test_w_logcollector_generate_state_ok(void ** state) {
     expect_value(__wrap_cJSON_AddNumberToObject, number, 5);
     expect_string(__wrap_cJSON_AddNumberToObject, name, "bytes");
     expect_value(__wrap_cJSON_AddNumberToObject, number, 100);
+    expect_string(__wrap_cJSON_AddNumberToObject, name, "lag");
+    expect_value(__wrap_cJSON_AddNumberToObject, number, 0);
     expect_function_call(__wrap_cJSON_AddItemToObject);
 
 
@@ -983,6 +1024,8 @@ void test_w_logcollector_state_main_ok(void ** state) {
     expect_value(__wrap_cJSON_AddNumberToObject, number, 5);
     expect_string(__wrap_cJSON_AddNumberToObject, name, "bytes");
     expect_value(__wrap_cJSON_AddNumberToObject, number, 100);
+    expect_string(__wrap_cJSON_AddNumberToObject, name, "lag");
+    expect_value(__wrap_cJSON_AddNumberToObject, number, 0);
 
     expect_function_call(__wrap_cJSON_AddItemToObject);
 
@@ -1030,6 +1073,8 @@ void test_w_logcollector_state_main_ok(void ** state) {
     expect_value(__wrap_cJSON_AddNumberToObject, number, 5);
     expect_string(__wrap_cJSON_AddNumberToObject, name, "bytes");
     expect_value(__wrap_cJSON_AddNumberToObject, number, 100);
+    expect_string(__wrap_cJSON_AddNumberToObject, name, "lag");
+    expect_value(__wrap_cJSON_AddNumberToObject, number, 0);
 
     expect_function_call(__wrap_cJSON_AddItemToObject);
 
@@ -1192,6 +1237,13 @@ int main(void) {
         cmocka_unit_test(test_w_logcollector_state_update_file_null),
         cmocka_unit_test_setup_teardown(test_w_logcollector_state_update_file_ok, setup_global_variables, teardown_global_variables),
 
+        // Tests _w_logcollector_state_update_lag
+        cmocka_unit_test_setup_teardown(test__w_logcollector_state_update_lag_no_data, setup_local_hashmap, teardown_local_hashmap),
+        cmocka_unit_test_setup_teardown(test__w_logcollector_state_update_lag_ok, setup_local_hashmap, teardown_local_hashmap),
+
+        // Tests w_logcollector_state_update_lag
+        cmocka_unit_test(test_w_logcollector_state_update_lag_null),
+
         // Tests _w_logcollector_state_update_target
         cmocka_unit_test_setup_teardown(test__w_logcollector_state_update_target_get_file_stats_fail, setup_hashmap_state_file, teardown_local_hashmap),
         cmocka_unit_test_setup_teardown(test__w_logcollector_state_update_target_find_target_fail, setup_hashmap_state_file, teardown_local_hashmap),
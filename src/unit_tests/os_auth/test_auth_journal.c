@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2015, Wazuh Inc.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "shared.h"
+#include "../../os_auth/auth.h"
+#include "../../headers/sec.h"
+
+#include "../wrappers/wazuh/shared/debug_op_wrappers.h"
+
+#define TEST_JOURNAL "/tmp/test_auth_journal"
+
+static void keys_init(keystore *keys) {
+    /* Initialize hashes */
+    keys->keytree_id = rbtree_init();
+    keys->keytree_ip = rbtree_init();
+    keys->keytree_sock = rbtree_init();
+
+    if (!(keys->keytree_id && keys->keytree_ip && keys->keytree_sock)) {
+        merror_exit(MEM_ERROR, errno, strerror(errno));
+    }
+
+    /* Initialize structure */
+    os_calloc(1, sizeof(keyentry*), keys->keyentries);
+    keys->keysize = 0;
+    keys->id_counter = 0;
+    keys->flags.key_mode = W_RAW_KEY;
+    keys->flags.save_removed = 0;
+
+    /* Add additional entry for sender == keysize */
+    os_calloc(1, sizeof(keyentry), keys->keyentries[keys->keysize]);
+    w_mutex_init(&keys->keyentries[keys->keysize]->mutex, NULL);
+}
+
+/* setup/teardowns */
+
+static int setup_journal(void **state) {
+    keystore *test_keys;
+
+    unlink(TEST_JOURNAL);
+    os_calloc(1, sizeof(keystore), test_keys);
+    keys_init(test_keys);
+    *state = test_keys;
+
+    return 0;
+}
+
+static int teardown_journal(void **state) {
+    keystore *test_keys = *state;
+
+    unlink(TEST_JOURNAL);
+    OS_FreeKeys(test_keys);
+    os_free(test_keys);
+
+    return 0;
+}
+
+/* tests */
+
+static void test_w_auth_journal_replay_no_journal(void **state) {
+    keystore *test_keys = *state;
+
+    assert_int_equal(w_auth_journal_replay(TEST_JOURNAL, test_keys), 0);
+    assert_int_equal(test_keys->keysize, 0);
+}
+
+static void test_w_auth_journal_append_replay(void **state) {
+    keystore *test_keys = *state;
+    struct keynode insert2 = { .id = "002", .name = "agent2", .ip = "any", .raw_key = "key2", .time_added = 200, .seq = 2 };
+    struct keynode insert1 = { .id = "001", .name = "agent1", .ip = "any", .raw_key = "key1", .time_added = 100, .seq = 0, .next = &insert2 };
+    struct keynode remove1 = { .id = "001", .name = "agent1", .ip = "any", .purge = 1, .seq = 1 };
+
+    // The agent 001 is removed after being added, and the agent 002 is added after that
+    assert_int_equal(w_auth_journal_append(TEST_JOURNAL, &insert1, &remove1), 3);
+
+    assert_int_equal(w_auth_journal_replay(TEST_JOURNAL, test_keys), 3);
+    assert_int_equal(OS_IsAllowedID(test_keys, "001"), -1);
+
+    int index = OS_IsAllowedID(test_keys, "002");
+    assert_true(index >= 0);
+    assert_string_equal(test_keys->keyentries[index]->name, "agent2");
+    assert_string_equal(test_keys->keyentries[index]->raw_key, "key2");
+    assert_int_equal(test_keys->keyentries[index]->time_added, 200);
+    assert_int_equal(test_keys->id_counter, 2);
+}
+
+static void test_w_auth_journal_replay_existing_keys(void **state) {
+    keystore *test_keys = *state;
+    struct keynode insert1 = { .id = "001", .name = "agent1", .ip = "any", .raw_key = "key1", .time_added = 100 };
+
+    OS_AddKey(test_keys, "001", "agent1", "any", "key1", 100);
+
+    // A journal older than client.keys changes nothing
+    assert_int_equal(w_auth_journal_append(TEST_JOURNAL, &insert1, NULL), 1);
+    assert_int_equal(w_auth_journal_replay(TEST_JOURNAL, test_keys), 0);
+    assert_int_equal(test_keys->keysize, 1);
+}
+
+static void test_w_auth_journal_replay_incomplete_line(void **state) {
+    keystore *test_keys = *state;
+    FILE *fp;
+
+    fp = fopen(TEST_JOURNAL, "w");
+    assert_non_null(fp);
+    fprintf(fp, "+ 001 agent1 any key1 100\n");
+    fprintf(fp, "? 002\n");
+    fprintf(fp, "+ 003 agent3 any");
+    fclose(fp);
+
+    expect_string(__wrap__mwarn, formatted_msg, "Ignoring invalid line in '" TEST_JOURNAL "'.");
+    expect_string(__wrap__mwarn, formatted_msg, "Ignoring incomplete line in '" TEST_JOURNAL "'.");
+
+    assert_int_equal(w_auth_journal_replay(TEST_JOURNAL, test_keys), 1);
+    assert_true(OS_IsAllowedID(test_keys, "001") >= 0);
+    assert_int_equal(OS_IsAllowedID(test_keys, "003"), -1);
+}
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(test_w_auth_journal_replay_no_journal, setup_journal, teardown_journal),
+        cmocka_unit_test_setup_teardown(test_w_auth_journal_append_replay, setup_journal, teardown_journal),
+        cmocka_unit_test_setup_teardown(test_w_auth_journal_replay_existing_keys, setup_journal, teardown_journal),
+        cmocka_unit_test_setup_teardown(test_w_auth_journal_replay_incomplete_line, setup_journal, teardown_journal),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -36,9 +36,48 @@ void test_aes_string
     assert_int_equal(strncmp(buffer2, string, strlen(string)), 0);
 }
 
+void test_aes_string_several_keys(void **state)
+{
+    const char *key1 = "test_key";
+    const char *key2 = "another_test_key";
+    const char *string = "test string";
+    char buffer1[64];
+    char buffer2[64];
+    char buffer3[64];
+    int i;
+
+    // The same key is used again after other keys were used
+    for (i = 0; i < 2; i++) {
+        memset(buffer3, 0, sizeof(buffer3));
+
+        assert_int_equal(OS_AES_Str(string, buffer1, key1, strlen(string), OS_ENCRYPT), 16);
+        assert_int_equal(OS_AES_Str(string, buffer2, key2, strlen(string), OS_ENCRYPT), 16);
+        assert_memory_not_equal(buffer1, buffer2, 16);
+
+        assert_int_equal(OS_AES_Str(buffer1, buffer3, key1, 16, OS_DECRYPT), 11);
+        assert_string_equal(buffer3, string);
+
+        memset(buffer3, 0, sizeof(buffer3));
+        assert_int_equal(OS_AES_Str(buffer2, buffer3, key2, 16, OS_DECRYPT), 11);
+        assert_string_equal(buffer3, string);
+    }
+
+    // Decrypting with the wrong key fails the padding check or gives other data
+    memset(buffer3, 0, sizeof(buffer3));
+    if (OS_AES_Str(buffer1, buffer3, key2, 16, OS_DECRYPT) != 0) {
+        assert_string_not_equal(buffer3, string);
+    }
+
+    // The key is usable after a failure
+    memset(buffer3, 0, sizeof(buffer3));
+    assert_int_equal(OS_AES_Str(buffer2, buffer3, key2, 16, OS_DECRYPT), 11);
+    assert_string_equal(buffer3, string);
+}
+
 int main(void) {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(test_aes_string),
+        cmocka_unit_test(test_aes_string_several_keys),
     };
     return cmocka_run_group_tests(tests, NULL, NULL);
 }
@@ -32,9 +32,33 @@ void test_blowfish(void **state)
     assert_string_equal(buffer2, string);
 }
 
+void test_blowfish_several_keys(void **state)
+{
+    const char *key1 = "test_key";
+    const char *key2 = "another_test_key";
+    const char *string = "test string 1234";
+    char buffer1[32] = {0};
+    char buffer2[32] = {0};
+    char buffer3[32] = {0};
+    int i;
+
+    // The same key is used again after other keys were used
+    for (i = 0; i < 2; i++) {
+        assert_int_equal(OS_BF_Str(string, buffer1, key1, 16, OS_ENCRYPT), 1);
+        assert_int_equal(OS_BF_Str(string, buffer2, key2, 16, OS_ENCRYPT), 1);
+        assert_memory_not_equal(buffer1, buffer2, 16);
+
+        assert_int_equal(OS_BF_Str(buffer1, buffer3, key1, 16, OS_DECRYPT), 1);
+        assert_memory_equal(buffer3, string, 16);
+        assert_int_equal(OS_BF_Str(buffer2, buffer3, key2, 16, OS_DECRYPT), 1);
+        assert_memory_equal(buffer3, string, 16);
+    }
+}
+
 int main(void) {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(test_blowfish),
+        cmocka_unit_test(test_blowfish_several_keys),
     };
     return cmocka_run_group_tests(tests, NULL, NULL);
 }
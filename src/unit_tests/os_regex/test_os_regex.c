@@ -469,6 +469,45 @@ void test_regex_extraction(void **state)
     }
 }
 
+void test_strcasestr(void **state)
+{
+    (void) state;
+
+    const char *str = "Session Opened for user ROOT";
+
+    assert_ptr_equal(_os_strcasestr("session", 7, str, strlen(str)), str);
+    assert_ptr_equal(_os_strcasestr("opened for", 10, str, strlen(str)), str + 8);
+    assert_ptr_equal(_os_strcasestr("root", 4, str, strlen(str)), str + 24);
+    assert_ptr_equal(_os_strcasestr("", 0, str, strlen(str)), str);
+    // The pattern is always compared in lower case
+    assert_null(_os_strcasestr("ROOT", 4, str, strlen(str)));
+    assert_null(_os_strcasestr("closed", 6, str, strlen(str)));
+    // Only the first str_len bytes are searched
+    assert_null(_os_strcasestr("root", 4, str, strlen(str) - 1));
+    assert_null(_os_strcasestr("session opened for user root ", 29, str, strlen(str)));
+}
+
+void test_regex_literal_size(void **state)
+{
+    (void) state;
+
+    OSRegex reg;
+
+    assert_int_equal(OSRegex_Compile("^Failed password for (\\S+)|(\\d+) tries|error\\s+code", &reg, 0), 1);
+    assert_int_equal(reg.literal_size[0], 20);
+    assert_int_equal(reg.literal_size[1], 0);
+    assert_int_equal(reg.literal_size[2], 5);
+
+    // The patterns whose literal is missing are skipped
+    assert_null(OSRegex_Execute("sshd: Accepted password for root", &reg));
+    assert_null(OSRegex_Execute("sshd: Failed password for root", &reg));
+    assert_non_null(OSRegex_Execute("Failed password for root", &reg));
+    assert_non_null(OSRegex_Execute("3 tries", &reg));
+    assert_non_null(OSRegex_Execute("fatal ERROR   code", &reg));
+
+    OSRegex_FreePattern(&reg);
+}
+
 void test_hostname_map(void **state)
 {
     (void) state;
@@ -830,6 +869,8 @@ int main(void) {
         cmocka_unit_test(test_strbreak),
         cmocka_unit_test(test_strbreak_null),
         cmocka_unit_test(test_regex_extraction),
+        cmocka_unit_test(test_strcasestr),
+        cmocka_unit_test(test_regex_literal_size),
         cmocka_unit_test(test_hostname_map),
         cmocka_unit_test(test_case_insensitive_char_map),
         cmocka_unit_test(test_regexmap_digit),
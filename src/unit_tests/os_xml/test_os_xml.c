@@ -1086,6 +1086,44 @@ void test_os_readxml_empty_tag(void **state) {
     assert_int_equal(data->xml.err_line, 1);
 }
 
+void test_os_readxmlfiles(void **state) {
+    char file_names[3][256];
+    OS_XML_FILE files[4] = {{ .file = file_names[0] }, { .file = file_names[1] }, { .file = file_names[2] },
+                            { .file = "/tmp/tmp_file-not-found" }};
+    const char *xml_path[] = { "root", "item", NULL };
+    char *content;
+
+    create_xml_file("<root><item>one</item></root>", file_names[0], 256);
+    create_xml_file("<root><item>two</item></root>", file_names[1], 256);
+    create_xml_file("<root><item>three</root>", file_names[2], 256);
+
+    // Two files cannot be parsed
+    assert_int_equal(OS_ReadXMLFiles(files, 4, 3), 2);
+
+    assert_int_equal(files[0].result, 0);
+    assert_non_null(content = OS_GetOneContentforElement(&files[0].xml, xml_path));
+    assert_string_equal(content, "one");
+    os_free(content);
+
+    assert_int_equal(files[1].result, 0);
+    assert_non_null(content = OS_GetOneContentforElement(&files[1].xml, xml_path));
+    assert_string_equal(content, "two");
+    os_free(content);
+
+    assert_int_equal(files[2].result, -1);
+    assert_int_equal(files[3].result, -2);
+    assert_int_equal(files[3].error, ENOENT);
+
+    for (int i = 0; i < 4; i++) {
+        assert_true(files[i].time >= 0);
+        OS_ClearXML(&files[i].xml);
+    }
+
+    for (int i = 0; i < 3; i++) {
+        unlink(file_names[i]);
+    }
+}
+
 void test_node_attribute_value_truncate_overflow(void **state) {
     test_struct_t *data  = (test_struct_t *)*state;
 
@@ -1334,6 +1372,8 @@ int main(void) {
         cmocka_unit_test_setup_teardown(test_os_readxml_random_string_with_valid_xml, test_setup, test_teardown),
         cmocka_unit_test_setup_teardown(test_os_readxml_non_empty_tag, test_setup, test_teardown),
         cmocka_unit_test_setup_teardown(test_os_readxml_empty_tag, test_setup, test_teardown),
+        // OS_ReadXMLFiles tests
+        cmocka_unit_test(test_os_readxmlfiles),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
@@ -22,6 +22,7 @@
 #include "../wrappers/posix/unistd_wrappers.h"
 #include "../wrappers/wazuh/remoted/request_wrappers.h"
 #include "../wrappers/wazuh/remoted/remoted_op_wrappers.h"
+#include "../wrappers/wazuh/remoted/labels_push_wrappers.h"
 #include "../wrappers/wazuh/wazuh_db/wdb_global_helpers_wrappers.h"
 #include "../wrappers/wazuh/shared/hash_op_wrappers.h"
 
@@ -4784,6 +4785,245 @@ void test_save_controlmsg_unable_to_save_last_keepalive(void **state)
     os_free(data.message);
 }
 
+void test_save_controlmsg_keepalive_batch(void **state)
+{
+    char r_msg[OS_SIZE_128] = {0};
+    strcpy(r_msg, "Invalid message \n with enter");
+
+    keyentry key;
+    keyentry_init(&key, "NEW_AGENT", "001", "10.2.2.5", NULL);
+
+    size_t msg_length = sizeof(r_msg);
+    int *wdb_sock = NULL;
+
+    keepalive_batch_interval = 1;
+
+    expect_string(__wrap_send_msg, agent_id, "001");
+    expect_string(__wrap_send_msg, msg, "#!-agent ack ");
+
+    expect_string(__wrap_rem_inc_send_ack, agent_id, "001");
+
+    expect_string(__wrap_rem_inc_recv_ctrl_keepalive, agent_id, "001");
+
+    expect_function_call(__wrap_OSHash_Create);
+    will_return(__wrap_OSHash_Create, 1);
+    pending_data = OSHash_Create();
+
+    pending_data_t data;
+    char * message = strdup("Invalid message \n");
+    data.changed = true;
+    data.message = message;
+
+    expect_value(__wrap_OSHash_Get, self, pending_data);
+    expect_string(__wrap_OSHash_Get, key, "001");
+    will_return(__wrap_OSHash_Get, &data);
+
+    // lastmsg_mutex and keepalive_mutex
+    expect_function_call_any(__wrap_pthread_mutex_lock);
+    expect_function_call_any(__wrap_pthread_mutex_unlock);
+
+    // The keepalive waits for the batch
+    save_controlmsg(&key, r_msg, msg_length, wdb_sock);
+
+    assert_int_equal(keepalive_count, 1);
+    assert_int_equal(keepalive_ids[0], 1);
+
+    expect_string(__wrap__mdebug2, formatted_msg, "Saving the keepalive of 1 agents.");
+    expect_value(__wrap_wdb_update_agents_keepalive, count, 1);
+    expect_value(__wrap_wdb_update_agents_keepalive, id, 1);
+    expect_string(__wrap_wdb_update_agents_keepalive, connection_status, AGENT_CS_ACTIVE);
+    expect_string(__wrap_wdb_update_agents_keepalive, sync_status, "synced");
+    will_return(__wrap_wdb_update_agents_keepalive, OS_SUCCESS);
+
+    keepalive_flush(wdb_sock);
+
+    assert_int_equal(keepalive_count, 0);
+
+    keepalive_batch_interval = 0;
+    free_keyentry(&key);
+    os_free(data.message);
+}
+
+void test_keepalive_flush_empty(void **state)
+{
+    expect_function_call_any(__wrap_pthread_mutex_lock);
+    expect_function_call_any(__wrap_pthread_mutex_unlock);
+
+    // Nothing is sent to Wazuh DB
+    keepalive_flush(NULL);
+}
+
+void test_keepalive_flush_duplicated_agents(void **state)
+{
+    expect_function_call_any(__wrap_pthread_mutex_lock);
+    expect_function_call_any(__wrap_pthread_mutex_unlock);
+
+    keepalive_push(3);
+    keepalive_push(1);
+    keepalive_push(3);
+
+    // Each agent is sent once
+    expect_string(__wrap__mdebug2, formatted_msg, "Saving the keepalive of 2 agents.");
+    expect_value(__wrap_wdb_update_agents_keepalive, count, 2);
+    expect_value(__wrap_wdb_update_agents_keepalive, id, 1);
+    expect_value(__wrap_wdb_update_agents_keepalive, id, 3);
+    expect_string(__wrap_wdb_update_agents_keepalive, connection_status, AGENT_CS_ACTIVE);
+    expect_string(__wrap_wdb_update_agents_keepalive, sync_status, "synced");
+    will_return(__wrap_wdb_update_agents_keepalive, OS_INVALID);
+
+    expect_string(__wrap__mwarn, formatted_msg, "Unable to save last keepalive and set connection status as active for 2 agents.");
+
+    keepalive_flush(NULL);
+
+    assert_int_equal(keepalive_count, 0);
+}
+
+void test_keepalive_discard(void **state)
+{
+    expect_function_call_any(__wrap_pthread_mutex_lock);
+    expect_function_call_any(__wrap_pthread_mutex_unlock);
+
+    keepalive_push(1);
+    keepalive_push(2);
+    keepalive_push(1);
+
+    keepalive_discard(1);
+
+    assert_int_equal(keepalive_count, 1);
+    assert_int_equal(keepalive_ids[0], 2);
+
+    expect_string(__wrap__mdebug2, formatted_msg, "Saving the keepalive of 1 agents.");
+    expect_value(__wrap_wdb_update_agents_keepalive, count, 1);
+    expect_value(__wrap_wdb_update_agents_keepalive, id, 2);
+    expect_string(__wrap_wdb_update_agents_keepalive, connection_status, AGENT_CS_ACTIVE);
+    expect_string(__wrap_wdb_update_agents_keepalive, sync_status, "synced");
+    will_return(__wrap_wdb_update_agents_keepalive, OS_SUCCESS);
+
+    keepalive_flush(NULL);
+}
+
+static void expect_shared_file_read(const char *path, const char *content, size_t size, const char *sum) {
+    expect_string(__wrap_wfopen, path, path);
+    expect_string(__wrap_wfopen, mode, "r");
+    will_return(__wrap_wfopen, (FILE *)1);
+
+    expect_value(__wrap_fileno, __stream, (FILE *)1);
+    will_return(__wrap_fileno, 3);
+
+    expect_value(__wrap_fstat, __fd, 3);
+    will_return(__wrap_fstat, S_IFREG);
+    will_return(__wrap_fstat, size);
+    will_return(__wrap_fstat, 0);
+
+    will_return(__wrap_fread, content);
+    will_return(__wrap_fread, size);
+
+    expect_value(__wrap_fclose, _File, (FILE *)1);
+    will_return(__wrap_fclose, 0);
+
+    expect_string(__wrap_OS_MD5_Str, str, content);
+    expect_value(__wrap_OS_MD5_Str, length, size);
+    will_return(__wrap_OS_MD5_Str, sum);
+    will_return(__wrap_OS_MD5_Str, 0);
+}
+
+void test_shared_file_get_cached(void **state)
+{
+    shared_file_t cached = { .sum = "md5_test", .refs = 1 };
+
+    expect_function_call_any(__wrap_pthread_mutex_lock);
+    expect_function_call_any(__wrap_pthread_mutex_unlock);
+
+    expect_any(__wrap_OSHash_Get, self);
+    expect_string(__wrap_OSHash_Get, key, "etc/shared/default/merged.mg");
+    will_return(__wrap_OSHash_Get, &cached);
+
+    // The file isn't read again
+    assert_ptr_equal(shared_file_get("etc/shared/default/merged.mg", "md5_test"), &cached);
+    assert_int_equal(cached.refs, 2);
+
+    shared_file_release(&cached);
+    assert_int_equal(cached.refs, 1);
+}
+
+void test_shared_file_get_read_and_cache(void **state)
+{
+    shared_file_t *file;
+
+    expect_function_call_any(__wrap_pthread_mutex_lock);
+    expect_function_call_any(__wrap_pthread_mutex_unlock);
+
+    expect_any(__wrap_OSHash_Get, self);
+    expect_string(__wrap_OSHash_Get, key, "etc/shared/default/merged.mg");
+    will_return(__wrap_OSHash_Get, NULL);
+
+    expect_shared_file_read("etc/shared/default/merged.mg", "file content", 12, "md5_test");
+
+    expect_any(__wrap_OSHash_Get, self);
+    expect_string(__wrap_OSHash_Get, key, "etc/shared/default/merged.mg");
+    will_return(__wrap_OSHash_Get, NULL);
+
+    expect_string(__wrap_OSHash_Add, key, "etc/shared/default/merged.mg");
+    will_return(__wrap_OSHash_Add, 2);
+
+    file = shared_file_get("etc/shared/default/merged.mg", "md5_test");
+
+    assert_non_null(file);
+    assert_int_equal(file->size, 12);
+    assert_string_equal(file->data, "file content");
+    // One reference is held by the cache
+    assert_int_equal(file->refs, 2);
+
+    shared_file_release(file);
+    assert_int_equal(file->refs, 1);
+    shared_file_release(file);
+}
+
+void test_shared_file_get_sum_mismatch(void **state)
+{
+    shared_file_t *file;
+
+    expect_function_call_any(__wrap_pthread_mutex_lock);
+    expect_function_call_any(__wrap_pthread_mutex_unlock);
+
+    expect_any(__wrap_OSHash_Get, self);
+    expect_string(__wrap_OSHash_Get, key, "etc/shared/default/merged.mg");
+    will_return(__wrap_OSHash_Get, NULL);
+
+    expect_shared_file_read("etc/shared/default/merged.mg", "file content", 12, "md5_new");
+
+    expect_string(__wrap__mdebug2, formatted_msg, "The sum of file 'etc/shared/default/merged.mg' doesn't match the group sum, it won't be cached.");
+
+    file = shared_file_get("etc/shared/default/merged.mg", "md5_test");
+
+    assert_non_null(file);
+    assert_string_equal(file->data, "file content");
+    assert_int_equal(file->refs, 1);
+
+    shared_file_release(file);
+}
+
+void test_shared_file_get_open_error(void **state)
+{
+    errno = 0;
+
+    expect_function_call_any(__wrap_pthread_mutex_lock);
+    expect_function_call_any(__wrap_pthread_mutex_unlock);
+
+    expect_any(__wrap_OSHash_Get, self);
+    expect_string(__wrap_OSHash_Get, key, "etc/shared/default/merged.mg");
+    will_return(__wrap_OSHash_Get, NULL);
+
+    expect_string(__wrap_wfopen, path, "etc/shared/default/merged.mg");
+    expect_string(__wrap_wfopen, mode, "r");
+    will_return(__wrap_wfopen, NULL);
+
+    will_return(__wrap_strerror, "No such file or directory");
+    expect_string(__wrap__mdebug1, formatted_msg, "(1103): Could not open file 'etc/shared/default/merged.mg' due to [(0)-(No such file or directory)].");
+
+    assert_null(shared_file_get("etc/shared/default/merged.mg", "md5_test"));
+}
+
 void test_save_controlmsg_update_msg_error_parsing(void **state)
 {
     char r_msg[OS_SIZE_128] = {0};
@@ -5043,6 +5283,82 @@ void test_save_controlmsg_update_msg_lookfor_agent_group_fail(void **state)
     os_free(data);
 }
 
+void test_save_controlmsg_update_msg_push_labels(void **state)
+{
+    char r_msg[OS_SIZE_128] = {0};
+    strcpy(r_msg, "valid message \n with enter");
+
+    keyentry key;
+    keyentry_init(&key, "NEW_AGENT", "001", "10.2.2.5", NULL);
+
+    size_t msg_length = sizeof(r_msg);
+    int *wdb_sock = NULL;
+
+    expect_string(__wrap_send_msg, agent_id, "001");
+    expect_string(__wrap_send_msg, msg, "#!-agent ack ");
+
+    expect_string(__wrap_rem_inc_send_ack, agent_id, "001");
+
+    expect_string(__wrap_rem_inc_recv_ctrl_keepalive, agent_id, "001");
+
+    expect_function_call(__wrap_OSHash_Create);
+    will_return(__wrap_OSHash_Create, 1);
+    pending_data = OSHash_Create();
+
+    pending_data_t *data;
+    os_calloc(1, sizeof(struct pending_data_t), data);
+    char * message = strdup("different message");
+    data->changed = false;
+    data->message = message;
+
+    expect_value(__wrap_OSHash_Get, self, pending_data);
+    expect_string(__wrap_OSHash_Get, key, "001");
+    will_return(__wrap_OSHash_Get, data);
+
+    expect_function_call(__wrap_pthread_mutex_lock);
+
+    expect_string(__wrap__mdebug2, formatted_msg, "save_controlmsg(): inserting 'valid message \n'");
+
+    expect_value(__wrap_wdb_get_agent_group, id, 1);
+    will_return(__wrap_wdb_get_agent_group, NULL);
+
+    expect_function_call(__wrap_pthread_mutex_unlock);
+
+    expect_string(__wrap__merror, formatted_msg, "Error getting group for agent '001'");
+
+    agent_info_data *agent_data;
+    os_calloc(1, sizeof(agent_info_data), agent_data);
+    agent_data->id = 1;
+    os_strdup("manager_host", agent_data->manager_host);
+    os_strdup("10.2.2.2", agent_data->agent_ip);
+    os_strdup("version 4.3", agent_data->version);
+    os_strdup("112358", agent_data->merged_sum);
+
+    expect_string(__wrap_parse_agent_update_msg, msg, "valid message \n");
+    will_return(__wrap_parse_agent_update_msg, agent_data);
+    will_return(__wrap_parse_agent_update_msg, OS_SUCCESS);
+
+    expect_function_call(__wrap_pthread_mutex_lock);
+    expect_function_call(__wrap_pthread_mutex_unlock);
+
+    expect_any(__wrap_wdb_update_agent_data, agent_data);
+    will_return(__wrap_wdb_update_agent_data, OS_SUCCESS);
+
+    expect_string(__wrap_rem_push_labels, agent_id, "001");
+    expect_any(__wrap_rem_push_labels, labels);
+    will_return(__wrap_rem_push_labels, 0);
+
+    save_controlmsg(&key, r_msg, msg_length, wdb_sock);
+
+    os_free(agent_data->manager_host);
+    os_free(agent_data);
+
+    free_keyentry(&key);
+    os_free(data->message);
+    os_free(data->group);
+    os_free(data);
+}
+
 void test_save_controlmsg_startup(void **state)
 {
     char r_msg[OS_SIZE_128] = {0};
@@ -5348,9 +5664,18 @@ int main(void)
         cmocka_unit_test_setup_teardown(test_save_controlmsg_get_agent_version_fail, setup_test_mode, teardown_test_mode),
         cmocka_unit_test_setup_teardown(test_save_controlmsg_could_not_add_pending_data, setup_test_mode, teardown_test_mode),
         cmocka_unit_test_setup_teardown(test_save_controlmsg_unable_to_save_last_keepalive, setup_test_mode, teardown_test_mode),
+        cmocka_unit_test_setup_teardown(test_save_controlmsg_keepalive_batch, setup_test_mode, teardown_test_mode),
+        cmocka_unit_test(test_keepalive_flush_empty),
+        cmocka_unit_test(test_keepalive_flush_duplicated_agents),
+        cmocka_unit_test(test_keepalive_discard),
+        cmocka_unit_test_setup_teardown(test_shared_file_get_cached, setup_test_mode, teardown_test_mode),
+        cmocka_unit_test_setup_teardown(test_shared_file_get_read_and_cache, setup_test_mode, teardown_test_mode),
+        cmocka_unit_test_setup_teardown(test_shared_file_get_sum_mismatch, setup_test_mode, teardown_test_mode),
+        cmocka_unit_test_setup_teardown(test_shared_file_get_open_error, setup_test_mode, teardown_test_mode),
         cmocka_unit_test_setup_teardown(test_save_controlmsg_update_msg_error_parsing, setup_test_mode, teardown_test_mode),
         cmocka_unit_test_setup_teardown(test_save_controlmsg_update_msg_unable_to_update_information, setup_test_mode, teardown_test_mode),
         cmocka_unit_test_setup_teardown(test_save_controlmsg_update_msg_lookfor_agent_group_fail, setup_test_mode, teardown_test_mode),
+        cmocka_unit_test_setup_teardown(test_save_controlmsg_update_msg_push_labels, setup_test_mode, teardown_test_mode),
         cmocka_unit_test_setup_teardown(test_save_controlmsg_startup, setup_globals, teardown_globals),
         cmocka_unit_test_setup_teardown(test_save_controlmsg_shutdown, setup_globals, teardown_globals),
         cmocka_unit_test_setup_teardown(test_save_controlmsg_shutdown_wdb_fail, setup_globals, teardown_globals),
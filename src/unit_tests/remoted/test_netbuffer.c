@@ -21,10 +21,10 @@
 #include "../wrappers/posix/pthread_wrappers.h"
 #include "../wrappers/posix/unistd_wrappers.h"
 #include "../wrappers/wazuh/os_net/os_net_wrappers.h"
-#include "../wrappers/wazuh/shared/bqueue_op_wrappers.h"
 #include "../wrappers/wazuh/shared/debug_op_wrappers.h"
 #include "../wrappers/wazuh/shared/notify_op_wrappers.h"
 #include "../wrappers/wazuh/remoted/queue_wrappers.h"
+#include "../wrappers/wazuh/remoted/sendqueue_wrappers.h"
 
 extern wnotify_t * notify;
 extern unsigned int send_chunk;
@@ -65,6 +65,7 @@ static int test_teardown(void ** state) {
     netbuffer_t *netbuffer = *state;
 
     expect_function_call(__wrap_pthread_mutex_lock);
+    expect_value(__wrap_nb_sendq_clear, queue, &netbuffer->buffers[sock]->sendq);
     expect_function_call(__wrap_pthread_mutex_unlock);
 
     nb_close(netbuffer, sock);
@@ -92,14 +93,14 @@ void test_nb_queue_ok(void ** state) {
 
     expect_function_call(__wrap_pthread_mutex_lock);
 
-    expect_memory(__wrap_bqueue_push, queue, (bqueue_t *)netbuffer->buffers[sock].bqueue, sizeof(bqueue_t *));
-    expect_memory(__wrap_bqueue_push, data, final_msg, final_size);
-    expect_value(__wrap_bqueue_push, length, final_size);
-    expect_value(__wrap_bqueue_push, flags, BQUEUE_NOFLAG);
-    will_return(__wrap_bqueue_push, 0);
+    expect_value(__wrap_nb_sendq_push, queue, &netbuffer->buffers[sock]->sendq);
+    expect_memory(__wrap_nb_sendq_push, data, final_msg, final_size);
+    expect_value(__wrap_nb_sendq_push, length, final_size);
+    expect_value(__wrap_nb_sendq_push, max_length, send_buffer_size);
+    will_return(__wrap_nb_sendq_push, 0);
 
-    expect_memory(__wrap_bqueue_used, queue, (bqueue_t *)netbuffer->buffers[sock].bqueue, sizeof(bqueue_t *));
-    will_return(__wrap_bqueue_used, final_size);
+    expect_value(__wrap_nb_sendq_used, queue, &netbuffer->buffers[sock]->sendq);
+    will_return(__wrap_nb_sendq_used, final_size);
 
     expect_memory(__wrap_wnotify_modify, notify, notify, sizeof(wnotify_t *));
     expect_value(__wrap_wnotify_modify, fd, sock);
@@ -129,11 +130,14 @@ void test_nb_queue_retry_ok(void ** state) {
 
     expect_function_call(__wrap_pthread_mutex_lock);
 
-    expect_memory(__wrap_bqueue_push, queue, (bqueue_t *)netbuffer->buffers[sock].bqueue, sizeof(bqueue_t *));
-    expect_memory(__wrap_bqueue_push, data, final_msg, final_size);
-    expect_value(__wrap_bqueue_push, length, final_size);
-    expect_value(__wrap_bqueue_push, flags, BQUEUE_NOFLAG);
-    will_return(__wrap_bqueue_push, -1);
+    expect_value(__wrap_nb_sendq_push, queue, &netbuffer->buffers[sock]->sendq);
+    expect_memory(__wrap_nb_sendq_push, data, final_msg, final_size);
+    expect_value(__wrap_nb_sendq_push, length, final_size);
+    expect_value(__wrap_nb_sendq_push, max_length, send_buffer_size);
+    will_return(__wrap_nb_sendq_push, -1);
+
+    expect_value(__wrap_nb_sendq_used, queue, &netbuffer->buffers[sock]->sendq);
+    will_return(__wrap_nb_sendq_used, 0);
 
     expect_string(__wrap__mdebug1, formatted_msg, "Not enough buffer space. Retrying... [buffer_size=100, used=0, msg_size=9]");
 
@@ -143,14 +147,14 @@ void test_nb_queue_retry_ok(void ** state) {
 
     expect_function_call(__wrap_pthread_mutex_lock);
 
-    expect_memory(__wrap_bqueue_push, queue, (bqueue_t *)netbuffer->buffers[sock].bqueue, sizeof(bqueue_t *));
-    expect_memory(__wrap_bqueue_push, data, final_msg, final_size);
-    expect_value(__wrap_bqueue_push, length, final_size);
-    expect_value(__wrap_bqueue_push, flags, BQUEUE_NOFLAG);
-    will_return(__wrap_bqueue_push, 0);
+    expect_value(__wrap_nb_sendq_push, queue, &netbuffer->buffers[sock]->sendq);
+    expect_memory(__wrap_nb_sendq_push, data, final_msg, final_size);
+    expect_value(__wrap_nb_sendq_push, length, final_size);
+    expect_value(__wrap_nb_sendq_push, max_length, send_buffer_size);
+    will_return(__wrap_nb_sendq_push, 0);
 
-    expect_memory(__wrap_bqueue_used, queue, (bqueue_t *)netbuffer->buffers[sock].bqueue, sizeof(bqueue_t *));
-    will_return(__wrap_bqueue_used, final_size);
+    expect_value(__wrap_nb_sendq_used, queue, &netbuffer->buffers[sock]->sendq);
+    will_return(__wrap_nb_sendq_used, final_size);
 
     expect_memory(__wrap_wnotify_modify, notify, notify, sizeof(wnotify_t *));
     expect_value(__wrap_wnotify_modify, fd, sock);
@@ -180,11 +184,14 @@ void test_nb_queue_retry_err(void ** state) {
 
     expect_function_call(__wrap_pthread_mutex_lock);
 
-    expect_memory(__wrap_bqueue_push, queue, (bqueue_t *)netbuffer->buffers[sock].bqueue, sizeof(bqueue_t *));
-    expect_memory(__wrap_bqueue_push, data, final_msg, final_size);
-    expect_value(__wrap_bqueue_push, length, final_size);
-    expect_value(__wrap_bqueue_push, flags, BQUEUE_NOFLAG);
-    will_return(__wrap_bqueue_push, -1);
+    expect_value(__wrap_nb_sendq_push, queue, &netbuffer->buffers[sock]->sendq);
+    expect_memory(__wrap_nb_sendq_push, data, final_msg, final_size);
+    expect_value(__wrap_nb_sendq_push, length, final_size);
+    expect_value(__wrap_nb_sendq_push, max_length, send_buffer_size);
+    will_return(__wrap_nb_sendq_push, -1);
+
+    expect_value(__wrap_nb_sendq_used, queue, &netbuffer->buffers[sock]->sendq);
+    will_return(__wrap_nb_sendq_used, 0);
 
     expect_string(__wrap__mdebug1, formatted_msg, "Not enough buffer space. Retrying... [buffer_size=100, used=0, msg_size=9]");
 
@@ -194,11 +201,11 @@ void test_nb_queue_retry_err(void ** state) {
 
     expect_function_call(__wrap_pthread_mutex_lock);
 
-    expect_memory(__wrap_bqueue_push, queue, (bqueue_t *)netbuffer->buffers[sock].bqueue, sizeof(bqueue_t *));
-    expect_memory(__wrap_bqueue_push, data, final_msg, final_size);
-    expect_value(__wrap_bqueue_push, length, final_size);
-    expect_value(__wrap_bqueue_push, flags, BQUEUE_NOFLAG);
-    will_return(__wrap_bqueue_push, -1);
+    expect_value(__wrap_nb_sendq_push, queue, &netbuffer->buffers[sock]->sendq);
+    expect_memory(__wrap_nb_sendq_push, data, final_msg, final_size);
+    expect_value(__wrap_nb_sendq_push, length, final_size);
+    expect_value(__wrap_nb_sendq_push, max_length, send_buffer_size);
+    will_return(__wrap_nb_sendq_push, -1);
 
     expect_string(__wrap_rem_inc_send_discarded, agent_id, agent_id);
 
@@ -211,6 +218,54 @@ void test_nb_queue_retry_err(void ** state) {
     assert_int_equal(retval, -1);
 }
 
+void test_nb_queue_closed_socket(void ** state) {
+    netbuffer_t *netbuffer = *state;
+    char msg[10] = {0};
+    char *agent_id = "001";
+
+    ssize_t size = snprintf(msg, 10, "abcdefghi");
+
+    expect_value(__wrap_wnet_order, value, 9);
+    will_return(__wrap_wnet_order, 0b00110001001100100011001100110100); //1234
+
+    expect_function_call(__wrap_pthread_mutex_lock);
+    expect_function_call(__wrap_pthread_mutex_unlock);
+
+    expect_string(__wrap_rem_inc_send_discarded, agent_id, agent_id);
+
+    expect_string(__wrap__mwarn, formatted_msg, "Package dropped. Could not append data into buffer.");
+
+    int retval = nb_queue(netbuffer, sock + 1, msg, size, agent_id);
+
+    assert_int_equal(retval, -1);
+}
+
+void test_nb_open_grow_table(void ** state) {
+    netbuffer_t *netbuffer = *state;
+    struct sockaddr_storage peer_info;
+    int new_sock = FD_LIST_INIT_VALUE * 3;
+
+    memset(&peer_info, 0, sizeof(struct sockaddr_storage));
+
+    expect_function_call(__wrap_pthread_mutex_lock);
+    expect_function_call(__wrap_pthread_mutex_unlock);
+
+    nb_open(netbuffer, new_sock, &peer_info);
+
+    assert_int_equal(netbuffer->size, FD_LIST_INIT_VALUE * 4);
+    assert_non_null(netbuffer->buffers[sock]);
+    assert_non_null(netbuffer->buffers[new_sock]);
+    assert_null(netbuffer->buffers[new_sock - 1]);
+
+    expect_function_call(__wrap_pthread_mutex_lock);
+    expect_value(__wrap_nb_sendq_clear, queue, &netbuffer->buffers[new_sock]->sendq);
+    expect_function_call(__wrap_pthread_mutex_unlock);
+
+    nb_close(netbuffer, new_sock);
+
+    assert_null(netbuffer->buffers[new_sock]);
+}
+
 void test_nb_send_ok(void ** state) {
     netbuffer_t *netbuffer = *state;
     char final_msg[14] = {0};
@@ -219,20 +274,19 @@ void test_nb_send_ok(void ** state) {
 
     expect_function_call(__wrap_pthread_mutex_lock);
 
-    expect_memory(__wrap_bqueue_peek, queue, (bqueue_t *)netbuffer->buffers[sock].bqueue, sizeof(bqueue_t *));
-    expect_value(__wrap_bqueue_peek, flags, BQUEUE_NOFLAG);
-    will_return(__wrap_bqueue_peek, 1);
-    will_return(__wrap_bqueue_peek, final_msg);
-    will_return(__wrap_bqueue_peek, final_size);
+    expect_value(__wrap_nb_sendq_peek, queue, &netbuffer->buffers[sock]->sendq);
+    expect_value(__wrap_nb_sendq_peek, length, send_chunk);
+    will_return(__wrap_nb_sendq_peek, 1);
+    will_return(__wrap_nb_sendq_peek, final_msg);
+    will_return(__wrap_nb_sendq_peek, final_size);
 
     will_return(__wrap_send, final_size);
 
-    expect_memory(__wrap_bqueue_drop, queue, (bqueue_t *)netbuffer->buffers[sock].bqueue, sizeof(bqueue_t *));
-    expect_value(__wrap_bqueue_drop, length, final_size);
-    will_return(__wrap_bqueue_drop, final_size);
+    expect_value(__wrap_nb_sendq_drop, queue, &netbuffer->buffers[sock]->sendq);
+    expect_value(__wrap_nb_sendq_drop, length, final_size);
 
-    expect_memory(__wrap_bqueue_used, queue, (bqueue_t *)netbuffer->buffers[sock].bqueue, sizeof(bqueue_t *));
-    will_return(__wrap_bqueue_used, 0);
+    expect_value(__wrap_nb_sendq_used, queue, &netbuffer->buffers[sock]->sendq);
+    will_return(__wrap_nb_sendq_used, 0);
 
     expect_memory(__wrap_wnotify_modify, notify, notify, sizeof(wnotify_t *));
     expect_value(__wrap_wnotify_modify, fd, sock);
@@ -252,10 +306,10 @@ void test_nb_send_zero_ok(void ** state) {
 
     expect_function_call(__wrap_pthread_mutex_lock);
 
-    expect_memory(__wrap_bqueue_peek, queue, (bqueue_t *)netbuffer->buffers[sock].bqueue, sizeof(bqueue_t *));
-    expect_value(__wrap_bqueue_peek, flags, BQUEUE_NOFLAG);
-    will_return(__wrap_bqueue_peek, 0);
-    will_return(__wrap_bqueue_peek, 0);
+    expect_value(__wrap_nb_sendq_peek, queue, &netbuffer->buffers[sock]->sendq);
+    expect_value(__wrap_nb_sendq_peek, length, send_chunk);
+    will_return(__wrap_nb_sendq_peek, 0);
+    will_return(__wrap_nb_sendq_peek, 0);
 
     expect_memory(__wrap_wnotify_modify, notify, notify, sizeof(wnotify_t *));
     expect_value(__wrap_wnotify_modify, fd, sock);
@@ -279,16 +333,16 @@ void test_nb_send_would_block_ok(void ** state) {
 
     expect_function_call(__wrap_pthread_mutex_lock);
 
-    expect_memory(__wrap_bqueue_peek, queue, (bqueue_t *)netbuffer->buffers[sock].bqueue, sizeof(bqueue_t *));
-    expect_value(__wrap_bqueue_peek, flags, BQUEUE_NOFLAG);
-    will_return(__wrap_bqueue_peek, 1);
-    will_return(__wrap_bqueue_peek, final_msg);
-    will_return(__wrap_bqueue_peek, final_size);
+    expect_value(__wrap_nb_sendq_peek, queue, &netbuffer->buffers[sock]->sendq);
+    expect_value(__wrap_nb_sendq_peek, length, send_chunk);
+    will_return(__wrap_nb_sendq_peek, 1);
+    will_return(__wrap_nb_sendq_peek, final_msg);
+    will_return(__wrap_nb_sendq_peek, final_size);
 
     will_return(__wrap_send, -1);
 
-    expect_memory(__wrap_bqueue_used, queue, (bqueue_t *)netbuffer->buffers[sock].bqueue, sizeof(bqueue_t *));
-    will_return(__wrap_bqueue_used, final_size);
+    expect_value(__wrap_nb_sendq_used, queue, &netbuffer->buffers[sock]->sendq);
+    will_return(__wrap_nb_sendq_used, final_size);
 
     expect_function_call(__wrap_pthread_mutex_unlock);
 
@@ -307,18 +361,18 @@ void test_nb_send_err(void ** state) {
 
     expect_function_call(__wrap_pthread_mutex_lock);
 
-    expect_memory(__wrap_bqueue_peek, queue, (bqueue_t *)netbuffer->buffers[sock].bqueue, sizeof(bqueue_t *));
-    expect_value(__wrap_bqueue_peek, flags, BQUEUE_NOFLAG);
-    will_return(__wrap_bqueue_peek, 1);
-    will_return(__wrap_bqueue_peek, final_msg);
-    will_return(__wrap_bqueue_peek, final_size);
+    expect_value(__wrap_nb_sendq_peek, queue, &netbuffer->buffers[sock]->sendq);
+    expect_value(__wrap_nb_sendq_peek, length, send_chunk);
+    will_return(__wrap_nb_sendq_peek, 1);
+    will_return(__wrap_nb_sendq_peek, final_msg);
+    will_return(__wrap_nb_sendq_peek, final_size);
 
     will_return(__wrap_send, -1);
 
     expect_string(__wrap__merror, formatted_msg, "Could not send data to socket 15: Connection reset by peer (104)");
 
-    expect_memory(__wrap_bqueue_used, queue, (bqueue_t *)netbuffer->buffers[sock].bqueue, sizeof(bqueue_t *));
-    will_return(__wrap_bqueue_used, 0);
+    expect_value(__wrap_nb_sendq_used, queue, &netbuffer->buffers[sock]->sendq);
+    will_return(__wrap_nb_sendq_used, 0);
 
     expect_memory(__wrap_wnotify_modify, notify, notify, sizeof(wnotify_t *));
     expect_value(__wrap_wnotify_modify, fd, sock);
@@ -337,10 +391,10 @@ void test_nb_recv_incomplete_first_message(void ** state) {
     char buffer_data[14] = {0xFB,0x03,0x00,0x00,0x21,0x31,0x36,0x30,0x37,0x21,0x23,0x41,0x45,0x53};
 
     void *buffer = &buffer_data;
-    os_calloc(14, sizeof(char*), netbuffer->buffers[sock].data);
-    memcpy((char*)netbuffer->buffers[sock].data, (char*)buffer, 14);
+    os_calloc(14, sizeof(char*), netbuffer->buffers[sock]->data);
+    memcpy((char*)netbuffer->buffers[sock]->data, (char*)buffer, 14);
 
-    netbuffer->buffers[sock].data_len = 0;
+    netbuffer->buffers[sock]->data_len = 0;
 
     expect_function_call(__wrap_pthread_mutex_lock);
 
@@ -361,10 +415,10 @@ void test_nb_recv_incomplete_second_message(void ** state) {
     char buffer_data[26] = {0x08,0x00,0x00,0x00,0x21,0x31,0x36,0x30,0x37,0x37,0x31,0x36,0xFB,0x03,0x00,0x00,0x21,0x31,0x36,0x30,0x37,0x21,0x23,0x41,0x45,0x53};
 
     void *buffer = &buffer_data;
-    os_calloc(26, sizeof(char*), netbuffer->buffers[sock].data);
-    memcpy((char*)netbuffer->buffers[sock].data, (char*)buffer, 26);
+    os_calloc(26, sizeof(char*), netbuffer->buffers[sock]->data);
+    memcpy((char*)netbuffer->buffers[sock]->data, (char*)buffer, 26);
 
-    netbuffer->buffers[sock].data_len = 0;
+    netbuffer->buffers[sock]->data_len = 0;
 
     expect_function_call(__wrap_pthread_mutex_lock);
 
@@ -373,21 +427,22 @@ void test_nb_recv_incomplete_second_message(void ** state) {
     expect_value(__wrap_wnet_order, value, 8);
     will_return(__wrap_wnet_order, 8);
 
-    expect_value(__wrap_rem_msgpush, size, 8);
-    expect_value(__wrap_rem_msgpush, addr, (struct sockaddr_storage *)&netbuffer->buffers[sock].peer_info);
-    expect_value(__wrap_rem_msgpush, sock, 15);
-    will_return(__wrap_rem_msgpush, 0);
-
     expect_value(__wrap_wnet_order, value, 1019);
     will_return(__wrap_wnet_order, 1019);
 
+    expect_value(__wrap_rem_msgpush_batch, sock, 15);
+    expect_value(__wrap_rem_msgpush_batch, count, 1);
+    expect_value(__wrap_rem_msgpush_batch, size, 8);
+    expect_value(__wrap_rem_msgpush_batch, addr, (struct sockaddr_storage *)&netbuffer->buffers[sock]->peer_info);
+    will_return(__wrap_rem_msgpush_batch, 1);
+
     expect_function_call(__wrap_pthread_mutex_unlock);
 
     int retval = nb_recv(netbuffer, sock);
 
     assert_int_equal(retval, 26);
-    assert_int_equal(*(uint32_t *)netbuffer->buffers[sock].data, 1019);
-    assert_int_equal(netbuffer->buffers[sock].data_len, 14);
+    assert_int_equal(*(uint32_t *)netbuffer->buffers[sock]->data, 1019);
+    assert_int_equal(netbuffer->buffers[sock]->data_len, 14);
 }
 
 int main(void) {
@@ -395,6 +450,8 @@ int main(void) {
         cmocka_unit_test_setup_teardown(test_nb_queue_ok, test_setup, test_teardown),
         cmocka_unit_test_setup_teardown(test_nb_queue_retry_ok, test_setup, test_teardown),
         cmocka_unit_test_setup_teardown(test_nb_queue_retry_err, test_setup, test_teardown),
+        cmocka_unit_test_setup_teardown(test_nb_queue_closed_socket, test_setup, test_teardown),
+        cmocka_unit_test_setup_teardown(test_nb_open_grow_table, test_setup, test_teardown),
         cmocka_unit_test_setup_teardown(test_nb_send_zero_ok, test_setup, test_teardown),
         cmocka_unit_test_setup_teardown(test_nb_send_ok, test_setup, test_teardown),
         cmocka_unit_test_setup_teardown(test_nb_send_would_block_ok, test_setup, test_teardown),
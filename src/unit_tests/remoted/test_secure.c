@@ -7,6 +7,9 @@
  * Foundation.
  */
 
+// secure.c uses recvmmsg(), a GNU extension
+#define _GNU_SOURCE
+
 #include <stdarg.h>
 #include <stddef.h>
 #include <setjmp.h>
@@ -1807,35 +1810,61 @@ void test_handle_new_tcp_connection_socket_fail_err(void **state)
 
 void test_handle_incoming_data_from_udp_socket_0(void **state)
 {
-    struct sockaddr_in peer_info;
     logr.udp_sock = 1;
 
-    peer_info.sin_family = AF_INET;
-    peer_info.sin_addr.s_addr = 0x0A00A8C0;
+    will_return(__wrap_recvmmsg, 0);
+
+    handle_incoming_data_from_udp_socket();
+}
 
-    will_return(__wrap_recvfrom, 0);
+void test_handle_incoming_data_from_udp_socket_error(void **state)
+{
+    logr.udp_sock = 1;
+
+    will_return(__wrap_recvmmsg, -1);
 
-    handle_incoming_data_from_udp_socket((struct sockaddr_storage *)&peer_info);
+    handle_incoming_data_from_udp_socket();
 }
 
 void test_handle_incoming_data_from_udp_socket_success(void **state)
 {
-    struct sockaddr_in peer_info;
     logr.udp_sock = 1;
 
-    peer_info.sin_family = AF_INET;
-    peer_info.sin_addr.s_addr = 0x0A00A8C0;
-
-    will_return(__wrap_recvfrom, 10);
+    will_return(__wrap_recvmmsg, 1);
+    will_return(__wrap_recvmmsg, 10);
 
-    expect_value(__wrap_rem_msgpush, size, 10);
-    expect_value(__wrap_rem_msgpush, addr, (struct sockaddr_storage *)&peer_info);
-    expect_value(__wrap_rem_msgpush, sock, USING_UDP_NO_CLIENT_SOCKET);
-    will_return(__wrap_rem_msgpush, 0);
+    expect_value(__wrap_rem_msgpush_batch, sock, USING_UDP_NO_CLIENT_SOCKET);
+    expect_value(__wrap_rem_msgpush_batch, count, 1);
+    expect_value(__wrap_rem_msgpush_batch, size, 10);
+    expect_any(__wrap_rem_msgpush_batch, addr);
+    will_return(__wrap_rem_msgpush_batch, 1);
 
     expect_value(__wrap_rem_add_recv, bytes, 10);
 
-    handle_incoming_data_from_udp_socket((struct sockaddr_storage *)&peer_info);
+    handle_incoming_data_from_udp_socket();
+}
+
+void test_handle_incoming_data_from_udp_socket_batch(void **state)
+{
+    logr.udp_sock = 1;
+
+    // The empty datagram is skipped
+    will_return(__wrap_recvmmsg, 3);
+    will_return(__wrap_recvmmsg, 10);
+    will_return(__wrap_recvmmsg, 0);
+    will_return(__wrap_recvmmsg, 20);
+
+    expect_value(__wrap_rem_msgpush_batch, sock, USING_UDP_NO_CLIENT_SOCKET);
+    expect_value(__wrap_rem_msgpush_batch, count, 2);
+    expect_value(__wrap_rem_msgpush_batch, size, 10);
+    expect_any(__wrap_rem_msgpush_batch, addr);
+    expect_value(__wrap_rem_msgpush_batch, size, 20);
+    expect_any(__wrap_rem_msgpush_batch, addr);
+    will_return(__wrap_rem_msgpush_batch, 2);
+
+    expect_value(__wrap_rem_add_recv, bytes, 30);
+
+    handle_incoming_data_from_udp_socket();
 }
 
 void test_handle_incoming_data_from_tcp_socket_too_big_message(void **state)
@@ -2427,6 +2456,52 @@ void test_router_message_forward_legacy_agent_end_message(void **state) {
     router_message_forward(message, data->agent_id, data->agent_ip, data->agent_name);
 }
 
+void test_forward_event_batch(void **state) {
+    test_agent_info* data = (test_agent_info*)(*state);
+    char batch[] = "7:1:a:foo11:1:b:bar:baz";
+
+    expect_string(__wrap_SendMSG, message, "1:a:foo");
+    expect_string(__wrap_SendMSG, locmsg, "[001] (focal) 192.168.33.20");
+    expect_any(__wrap_SendMSG, loc);
+    will_return(__wrap_SendMSG, 0);
+    expect_function_call(__wrap_rem_inc_recv_evt);
+
+    expect_string(__wrap_SendMSG, message, "1:b:bar:baz");
+    expect_string(__wrap_SendMSG, locmsg, "[001] (focal) 192.168.33.20");
+    expect_any(__wrap_SendMSG, loc);
+    will_return(__wrap_SendMSG, 0);
+    expect_function_call(__wrap_rem_inc_recv_evt);
+
+    assert_int_equal(forward_event_batch(batch, strlen(batch), "[001] (focal) 192.168.33.20", data->agent_id, data->agent_ip, data->agent_name), 2);
+    // The batch is restored after sending each event
+    assert_string_equal(batch, "7:1:a:foo11:1:b:bar:baz");
+}
+
+void test_forward_event_batch_truncated(void **state) {
+    test_agent_info* data = (test_agent_info*)(*state);
+    char batch[] = "7:1:a:foo20:1:b:bar";
+
+    expect_string(__wrap_SendMSG, message, "1:a:foo");
+    expect_string(__wrap_SendMSG, locmsg, "[001] (focal) 192.168.33.20");
+    expect_any(__wrap_SendMSG, loc);
+    will_return(__wrap_SendMSG, 0);
+    expect_function_call(__wrap_rem_inc_recv_evt);
+
+    expect_string(__wrap__mwarn, formatted_msg, "Invalid batch of events from agent ID '001'.");
+
+    assert_int_equal(forward_event_batch(batch, strlen(batch), "[001] (focal) 192.168.33.20", data->agent_id, data->agent_ip, data->agent_name), 1);
+}
+
+void test_forward_event_batch_invalid_length(void **state) {
+    test_agent_info* data = (test_agent_info*)(*state);
+    // Event without length prefix
+    char batch[] = "a:foo";
+
+    expect_string(__wrap__mwarn, formatted_msg, "Invalid batch of events from agent ID '001'.");
+
+    assert_int_equal(forward_event_batch(batch, strlen(batch), "[001] (focal) 192.168.33.20", data->agent_id, data->agent_ip, data->agent_name), 0);
+}
+
 int main(void)
 {
     const struct CMUnitTest tests[] = {
@@ -2465,7 +2540,9 @@ int main(void)
         cmocka_unit_test_setup_teardown(test_handle_new_tcp_connection_socket_fail_err, setup_new_tcp, teardown_new_tcp),
         // Tests handle_incoming_data_from_udp_socket
         cmocka_unit_test(test_handle_incoming_data_from_udp_socket_0),
+        cmocka_unit_test(test_handle_incoming_data_from_udp_socket_error),
         cmocka_unit_test(test_handle_incoming_data_from_udp_socket_success),
+        cmocka_unit_test(test_handle_incoming_data_from_udp_socket_batch),
         // Tests handle_incoming_data_from_tcp_socket
         cmocka_unit_test(test_handle_incoming_data_from_tcp_socket_too_big_message),
         cmocka_unit_test(test_handle_incoming_data_from_tcp_socket_case_0),
@@ -2498,6 +2575,10 @@ int main(void)
         cmocka_unit_test_setup_teardown(test_router_message_forward_valid_delta_hotfixes_json_message, setup_remoted_configuration, teardown_remoted_configuration),
         cmocka_unit_test_setup_teardown(test_router_message_forward_legacy_agent_message, setup_remoted_configuration, teardown_remoted_configuration),
         cmocka_unit_test_setup_teardown(test_router_message_forward_legacy_agent_end_message, setup_remoted_configuration, teardown_remoted_configuration),
+        // Tests forward_event_batch
+        cmocka_unit_test_setup_teardown(test_forward_event_batch, setup_remoted_configuration, teardown_remoted_configuration),
+        cmocka_unit_test_setup_teardown(test_forward_event_batch_truncated, setup_remoted_configuration, teardown_remoted_configuration),
+        cmocka_unit_test_setup_teardown(test_forward_event_batch_invalid_length, setup_remoted_configuration, teardown_remoted_configuration),
         };
     return cmocka_run_group_tests(tests, NULL, NULL);
 }
@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2015, Wazuh Inc.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../../remoted/remoted.h"
+
+#define TEST_DATA_SIZE (NB_CHUNK_SIZE * 3)
+
+static char test_data[TEST_DATA_SIZE];
+
+/* setup/teardown */
+
+static int test_setup(void ** state) {
+    for (int i = 0; i < TEST_DATA_SIZE; i++) {
+        test_data[i] = (char)(i * 7);
+    }
+
+    sendqueue_t * queue;
+    os_calloc(1, sizeof(sendqueue_t), queue);
+    *state = queue;
+
+    return 0;
+}
+
+static int test_teardown(void ** state) {
+    sendqueue_t * queue = *state;
+
+    nb_sendq_clear(queue);
+    os_free(queue);
+
+    return 0;
+}
+
+/* Tests */
+
+void test_nb_sendq_push_empty(void ** state) {
+    sendqueue_t * queue = *state;
+
+    assert_int_equal(nb_sendq_used(queue), 0);
+    assert_null(queue->head);
+
+    assert_int_equal(nb_sendq_push(queue, test_data, 10, 100), 0);
+
+    assert_int_equal(nb_sendq_used(queue), 10);
+    assert_non_null(queue->head);
+    assert_ptr_equal(queue->head, queue->tail);
+}
+
+void test_nb_sendq_push_full(void ** state) {
+    sendqueue_t * queue = *state;
+
+    assert_int_equal(nb_sendq_push(queue, test_data, 60, 100), 0);
+    assert_int_equal(nb_sendq_push(queue, test_data, 40, 100), -1);
+    assert_int_equal(nb_sendq_push(queue, test_data, 39, 100), 0);
+
+    assert_int_equal(nb_sendq_used(queue), 99);
+}
+
+void test_nb_sendq_push_several_chunks(void ** state) {
+    sendqueue_t * queue = *state;
+    char buffer[TEST_DATA_SIZE];
+
+    assert_int_equal(nb_sendq_push(queue, test_data, NB_CHUNK_SIZE + 10, TEST_DATA_SIZE), 0);
+    assert_int_equal(nb_sendq_push(queue, test_data + NB_CHUNK_SIZE + 10, NB_CHUNK_SIZE, TEST_DATA_SIZE), 0);
+
+    assert_int_equal(nb_sendq_used(queue), NB_CHUNK_SIZE * 2 + 10);
+    assert_ptr_not_equal(queue->head, queue->tail);
+
+    assert_int_equal(nb_sendq_peek(queue, buffer, sizeof(buffer)), NB_CHUNK_SIZE * 2 + 10);
+    assert_memory_equal(buffer, test_data, NB_CHUNK_SIZE * 2 + 10);
+}
+
+void test_nb_sendq_peek_partial(void ** state) {
+    sendqueue_t * queue = *state;
+    char buffer[20];
+
+    assert_int_equal(nb_sendq_push(queue, test_data, 50, 100), 0);
+
+    assert_int_equal(nb_sendq_peek(queue, buffer, sizeof(buffer)), sizeof(buffer));
+    assert_memory_equal(buffer, test_data, sizeof(buffer));
+    assert_int_equal(nb_sendq_used(queue), 50);
+}
+
+void test_nb_sendq_drop(void ** state) {
+    sendqueue_t * queue = *state;
+    char buffer[TEST_DATA_SIZE];
+
+    assert_int_equal(nb_sendq_push(queue, test_data, NB_CHUNK_SIZE * 2, TEST_DATA_SIZE), 0);
+
+    nb_sendq_drop(queue, NB_CHUNK_SIZE + 5);
+
+    assert_int_equal(nb_sendq_used(queue), NB_CHUNK_SIZE - 5);
+    assert_ptr_equal(queue->head, queue->tail);
+    assert_int_equal(nb_sendq_peek(queue, buffer, sizeof(buffer)), NB_CHUNK_SIZE - 5);
+    assert_memory_equal(buffer, test_data + NB_CHUNK_SIZE + 5, NB_CHUNK_SIZE - 5);
+
+    nb_sendq_drop(queue, NB_CHUNK_SIZE - 5);
+
+    assert_int_equal(nb_sendq_used(queue), 0);
+    assert_null(queue->head);
+    assert_null(queue->tail);
+}
+
+void test_nb_sendq_clear(void ** state) {
+    sendqueue_t * queue = *state;
+
+    assert_int_equal(nb_sendq_push(queue, test_data, TEST_DATA_SIZE - 1, TEST_DATA_SIZE), 0);
+
+    nb_sendq_clear(queue);
+
+    assert_int_equal(nb_sendq_used(queue), 0);
+    assert_null(queue->head);
+    assert_null(queue->tail);
+
+    // The chunks are reused
+    assert_int_equal(nb_sendq_push(queue, test_data, 10, 100), 0);
+    assert_int_equal(nb_sendq_used(queue), 10);
+}
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(test_nb_sendq_push_empty, test_setup, test_teardown),
+        cmocka_unit_test_setup_teardown(test_nb_sendq_push_full, test_setup, test_teardown),
+        cmocka_unit_test_setup_teardown(test_nb_sendq_push_several_chunks, test_setup, test_teardown),
+        cmocka_unit_test_setup_teardown(test_nb_sendq_peek_partial, test_setup, test_teardown),
+        cmocka_unit_test_setup_teardown(test_nb_sendq_drop, test_setup, test_teardown),
+        cmocka_unit_test_setup_teardown(test_nb_sendq_clear, test_setup, test_teardown),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2015, Wazuh Inc.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdio.h>
+
+#include "shared.h"
+
+#define QUEUE_SIZE 5
+#define THREADS 4
+#define THREAD_ELEMENTS 10000
+
+// Element that tells a consumer thread to finish
+static int stop_element;
+
+/****************SETUP/TEARDOWN******************/
+int setup_queue(void **state) {
+    *state = mpmc_queue_init(QUEUE_SIZE);
+    return 0;
+}
+
+int teardown_queue(void **state) {
+    mpmc_queue_free(*state);
+    return 0;
+}
+
+/****************THREADS******************/
+static void * producer_thread(void * args) {
+    w_mpmc_queue_t *queue = args;
+    int i;
+
+    for (i = 1; i <= THREAD_ELEMENTS; i++) {
+        mpmc_queue_push_block(queue, (void *)(intptr_t)i);
+    }
+
+    return NULL;
+}
+
+static void * consumer_thread(void * args) {
+    w_mpmc_queue_t *queue = args;
+    intptr_t *sum = NULL;
+    void *data;
+
+    os_calloc(1, sizeof(intptr_t), sum);
+
+    while (data = mpmc_queue_pop_block(queue), data != &stop_element) {
+        *sum += (intptr_t)data;
+    }
+
+    return sum;
+}
+
+/****************TESTS******************/
+void test_mpmc_queue_minimum_size(void **state) {
+    w_mpmc_queue_t *queue = mpmc_queue_init(1);
+    int a, b;
+
+    assert_int_equal(queue->size, 2);
+    assert_int_equal(mpmc_queue_push(queue, &a), 0);
+    assert_int_equal(mpmc_queue_push(queue, &b), 0);
+    assert_int_equal(mpmc_queue_push(queue, &a), -1);
+    assert_ptr_equal(mpmc_queue_pop(queue), &a);
+    assert_ptr_equal(mpmc_queue_pop(queue), &b);
+    assert_ptr_equal(mpmc_queue_pop(queue), NULL);
+
+    mpmc_queue_free(queue);
+}
+
+void test_mpmc_queue_full(void **state) {
+    w_mpmc_queue_t *queue = *state;
+    int elements[QUEUE_SIZE];
+    int i;
+
+    for (i = 0; i < QUEUE_SIZE; i++) {
+        assert_int_equal(mpmc_queue_full(queue), 0);
+        assert_int_equal(mpmc_queue_push(queue, &elements[i]), 0);
+    }
+
+    assert_int_equal(mpmc_queue_full(queue), 1);
+    assert_int_equal(mpmc_queue_elements(queue), QUEUE_SIZE);
+    assert_int_equal(mpmc_queue_push(queue, &elements[0]), -1);
+}
+
+void test_mpmc_queue_empty(void **state) {
+    w_mpmc_queue_t *queue = *state;
+    int element;
+
+    assert_int_equal(mpmc_queue_empty(queue), 1);
+    assert_int_equal(mpmc_queue_push(queue, &element), 0);
+    assert_int_equal(mpmc_queue_empty(queue), 0);
+    assert_int_equal(mpmc_queue_elements(queue), 1);
+    assert_ptr_equal(mpmc_queue_pop(queue), &element);
+    assert_int_equal(mpmc_queue_empty(queue), 1);
+    assert_ptr_equal(mpmc_queue_pop(queue), NULL);
+}
+
+void test_mpmc_queue_push_pop_order(void **state) {
+    w_mpmc_queue_t *queue = *state;
+    int elements[QUEUE_SIZE];
+    int i, j;
+
+    // Several rounds so the positions wrap around the buffer
+    for (j = 0; j < 3; j++) {
+        for (i = 0; i < QUEUE_SIZE - 1; i++) {
+            assert_int_equal(mpmc_queue_push(queue, &elements[i]), 0);
+        }
+
+        for (i = 0; i < QUEUE_SIZE - 1; i++) {
+            assert_ptr_equal(mpmc_queue_pop(queue), &elements[i]);
+        }
+    }
+
+    assert_int_equal(mpmc_queue_empty(queue), 1);
+}
+
+void test_mpmc_queue_push_batch(void **state) {
+    w_mpmc_queue_t *queue = *state;
+    int elements[QUEUE_SIZE + 2];
+    void *data[QUEUE_SIZE + 2];
+    int i;
+
+    for (i = 0; i < QUEUE_SIZE + 2; i++) {
+        data[i] = &elements[i];
+    }
+
+    assert_int_equal(mpmc_queue_push_batch(queue, data, 3), 3);
+    // Only the free slots are filled
+    assert_int_equal(mpmc_queue_push_batch(queue, data + 3, 4), QUEUE_SIZE - 3);
+    assert_int_equal(mpmc_queue_push_batch(queue, data, 1), 0);
+
+    for (i = 0; i < QUEUE_SIZE; i++) {
+        assert_ptr_equal(mpmc_queue_pop(queue), &elements[i]);
+    }
+}
+
+void test_mpmc_queue_pop_batch(void **state) {
+    w_mpmc_queue_t *queue = *state;
+    int elements[3];
+    void *data[QUEUE_SIZE];
+    int i;
+
+    assert_int_equal(mpmc_queue_pop_batch(queue, data, QUEUE_SIZE), 0);
+
+    for (i = 0; i < 3; i++) {
+        mpmc_queue_push(queue, &elements[i]);
+    }
+
+    assert_int_equal(mpmc_queue_pop_batch(queue, data, 2), 2);
+    assert_ptr_equal(data[0], &elements[0]);
+    assert_ptr_equal(data[1], &elements[1]);
+
+    assert_int_equal(mpmc_queue_pop_batch_block(queue, data, QUEUE_SIZE), 1);
+    assert_ptr_equal(data[0], &elements[2]);
+    assert_int_equal(mpmc_queue_empty(queue), 1);
+}
+
+void test_mpmc_queue_pop_timedwait_timeout(void **state) {
+    w_mpmc_queue_t *queue = *state;
+    struct timespec abstime;
+    int element;
+
+    gettime(&abstime);
+    assert_ptr_equal(mpmc_queue_pop_timedwait(queue, &abstime), NULL);
+
+    mpmc_queue_push(queue, &element);
+    assert_ptr_equal(mpmc_queue_pop_timedwait(queue, &abstime), &element);
+}
+
+void test_mpmc_queue_threads(void **state) {
+    w_mpmc_queue_t *queue = *state;
+    pthread_t producers[THREADS];
+    pthread_t consumers[THREADS];
+    intptr_t total = 0;
+    int i;
+
+    for (i = 0; i < THREADS; i++) {
+        assert_int_equal(pthread_create(&consumers[i], NULL, consumer_thread, queue), 0);
+        assert_int_equal(pthread_create(&producers[i], NULL, producer_thread, queue), 0);
+    }
+
+    for (i = 0; i < THREADS; i++) {
+        pthread_join(producers[i], NULL);
+    }
+
+    for (i = 0; i < THREADS; i++) {
+        mpmc_queue_push_block(queue, &stop_element);
+    }
+
+    for (i = 0; i < THREADS; i++) {
+        intptr_t *sum;
+
+        pthread_join(consumers[i], (void **)&sum);
+        total += *sum;
+        os_free(sum);
+    }
+
+    // Every element was popped once
+    assert_int_equal(total, (intptr_t)THREADS * THREAD_ELEMENTS * (THREAD_ELEMENTS + 1) / 2);
+    assert_int_equal(mpmc_queue_empty(queue), 1);
+}
+/************************************************/
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_mpmc_queue_minimum_size),
+        cmocka_unit_test_setup_teardown(test_mpmc_queue_full, setup_queue, teardown_queue),
+        cmocka_unit_test_setup_teardown(test_mpmc_queue_empty, setup_queue, teardown_queue),
+        cmocka_unit_test_setup_teardown(test_mpmc_queue_push_pop_order, setup_queue, teardown_queue),
+        cmocka_unit_test_setup_teardown(test_mpmc_queue_push_batch, setup_queue, teardown_queue),
+        cmocka_unit_test_setup_teardown(test_mpmc_queue_pop_batch, setup_queue, teardown_queue),
+        cmocka_unit_test_setup_teardown(test_mpmc_queue_pop_timedwait_timeout, setup_queue, teardown_queue),
+        cmocka_unit_test_setup_teardown(test_mpmc_queue_threads, setup_queue, teardown_queue),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
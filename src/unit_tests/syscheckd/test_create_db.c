@@ -51,6 +51,12 @@ void fim_db_remove_entry(void * data, void * ctx);
 void process_delete_event(void * data, void * ctx);
 void fim_db_process_missing_entry(void * data, void * ctx);
 void dbsync_attributes_json(const cJSON *dbsync_event, const directory_t *configuration, cJSON *attributes);
+void fim_flush_pending_files(TXN_HANDLE txn_handle, fim_txn_context_t *txn_context);
+fim_file_data *fim_get_file_data(const char *file,
+                                 const directory_t *configuration,
+                                 const struct stat *statbuf,
+                                 const fim_file_data *stored);
+fim_file_data *fim_get_stored_data(const char *path, const directory_t *configuration);
 
 /* auxiliary structs */
 typedef struct __fim_data_s {
@@ -1396,6 +1402,51 @@ static void test_fim_file_modify_transaction(void **state) {
     fim_file(file_path, &configuration, &evt_data, mock_handle, &mock_context);
 }
 
+static void test_fim_file_queued_transaction(void **state) {
+    event_data_t evt_data = { .mode = FIM_SCHEDULED, .w_evt = NULL, .report_event = true, .statbuf = DEFAULT_STATBUF };
+    directory_t configuration = { .options = CHECK_SIZE | CHECK_PERM | CHECK_OWNER | CHECK_GROUP | CHECK_MD5SUM |
+                                             CHECK_SHA1SUM | CHECK_SHA256SUM };
+    TXN_HANDLE mock_handle = (TXN_HANDLE)1;
+    fim_file_batch_t batch = {0};
+    fim_txn_context_t mock_context = { .pending_files = &batch };
+
+#ifdef TEST_WINAGENT
+    char file_path[OS_SIZE_256] = "c:\\windows\\system32\\cmd.exe";
+    cJSON *permissions = create_win_permissions_object();
+#else
+    char file_path[OS_SIZE_256] = "/bin/ls";
+#endif
+
+    // The file is hashed and synced when the batch is flushed
+    fim_file(file_path, &configuration, &evt_data, mock_handle, &mock_context);
+    assert_int_equal(batch.count, 1);
+    assert_string_equal(batch.files[0].path, file_path);
+
+#ifndef TEST_WINAGENT
+    expect_get_user(0, strdup("user"));
+
+    expect_get_group(0, strdup("group"));
+#else
+
+    expect_get_file_user(file_path, "0", strdup("user"));
+    expect_w_get_file_permissions(file_path, permissions, 0);
+
+    expect_value(__wrap_decode_win_acl_json, perms, permissions);
+#endif
+
+    expect_OS_MD5_SHA1_SHA256_File_call(file_path, syscheck.prefilter_cmd, "d41d8cd98f00b204e9800998ecf8427e",
+                                        "da39a3ee5e6b4b0d3255bfef95601890afd80709",
+                                        "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855", OS_BINARY,
+                                        0x400, 0);
+
+    will_return(__wrap_fim_db_transaction_sync_row, FIMDB_OK);
+
+    fim_flush_pending_files(mock_handle, &mock_context);
+    assert_int_equal(batch.count, 0);
+    assert_null(batch.files[0].path);
+    assert_null(mock_context.latest_entry);
+}
+
 static void test_fim_file_modify(void **state) {
     fim_data_t *fim_data = *state;
     event_data_t evt_data = { .mode = FIM_REALTIME, .w_evt = NULL, .report_event = true, .statbuf = DEFAULT_STATBUF };
@@ -3175,6 +3226,88 @@ static void test_fim_get_data_no_hashes(void **state) {
     assert_string_equal(fim_data->local_data->hash_sha256, "");
 }
 
+static void test_fim_get_data_stored_hashes(void **state) {
+    fim_data_t *fim_data = *state;
+    directory_t configuration = { .options = CHECK_SIZE | CHECK_PERM | CHECK_MTIME | CHECK_OWNER | CHECK_GROUP |
+                                             CHECK_MD5SUM | CHECK_SHA1SUM | CHECK_SHA256SUM };
+    struct stat statbuf = { .st_mode = S_IFREG | 00444,
+                            .st_size = 1000,
+                            .st_uid = 0,
+                            .st_gid = 0,
+                            .st_ino = 1234,
+                            .st_dev = 2345,
+                            .st_mtime = 3456 };
+    fim_file_data stored = { .size = 1000,
+#ifndef TEST_WINAGENT
+                             .mtime = 3456,
+#else
+                             .mtime = 123456,
+#endif
+                             .inode = 1234,
+                             .dev = 2345,
+                             .hash_md5 = "3691689a513ace7e508297b583d7050d",
+                             .hash_sha1 = "07f05add1049244e7e71ad0f54f24d8094cd8f8b",
+                             .hash_sha256 = "672a8ceaea40a441f0268ca9bbb33e99f9643c6262667b61fbe57694df224d40",
+                             .options = configuration.options };
+
+    // The file isn't hashed
+    expect_get_data(strdup("user"), strdup("group"), "test", 0);
+
+    fim_data->local_data = fim_get_file_data("test", &configuration, &statbuf, &stored);
+
+    assert_string_equal(fim_data->local_data->hash_md5, "3691689a513ace7e508297b583d7050d");
+    assert_string_equal(fim_data->local_data->hash_sha1, "07f05add1049244e7e71ad0f54f24d8094cd8f8b");
+    assert_string_equal(fim_data->local_data->hash_sha256, "672a8ceaea40a441f0268ca9bbb33e99f9643c6262667b61fbe57694df224d40");
+}
+
+static void test_fim_get_data_stored_hashes_size_changed(void **state) {
+    fim_data_t *fim_data = *state;
+    directory_t configuration = { .options = CHECK_SIZE | CHECK_PERM | CHECK_MTIME | CHECK_OWNER | CHECK_GROUP |
+                                             CHECK_MD5SUM | CHECK_SHA1SUM | CHECK_SHA256SUM };
+    struct stat statbuf = { .st_mode = S_IFREG | 00444,
+                            .st_size = 1000,
+                            .st_uid = 0,
+                            .st_gid = 0,
+                            .st_ino = 1234,
+                            .st_dev = 2345,
+                            .st_mtime = 3456 };
+    fim_file_data stored = { .size = 999,
+#ifndef TEST_WINAGENT
+                             .mtime = 3456,
+#else
+                             .mtime = 123456,
+#endif
+                             .inode = 1234,
+                             .dev = 2345,
+                             .hash_md5 = "3691689a513ace7e508297b583d7050d",
+                             .hash_sha1 = "07f05add1049244e7e71ad0f54f24d8094cd8f8b",
+                             .hash_sha256 = "672a8ceaea40a441f0268ca9bbb33e99f9643c6262667b61fbe57694df224d40",
+                             .options = configuration.options };
+
+    expect_get_data(strdup("user"), strdup("group"), "test", 1);
+
+    fim_data->local_data = fim_get_file_data("test", &configuration, &statbuf, &stored);
+
+    assert_string_equal(fim_data->local_data->hash_md5, "d41d8cd98f00b204e9800998ecf8427e");
+    assert_string_equal(fim_data->local_data->hash_sha1, "da39a3ee5e6b4b0d3255bfef95601890afd80709");
+    assert_string_equal(fim_data->local_data->hash_sha256, "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+}
+
+static void test_fim_get_stored_data_full_hash(void **state) {
+    directory_t configuration = { .options = CHECK_SIZE | CHECK_MTIME | CHECK_MD5SUM };
+
+    // Every file is hashed in every scan
+    syscheck.full_hash_interval = 1;
+    assert_null(fim_get_stored_data("test", &configuration));
+
+    // The metadata needed to detect the changes isn't stored
+    syscheck.full_hash_interval = 10;
+    configuration.options = CHECK_SIZE | CHECK_MD5SUM;
+    assert_null(fim_get_stored_data("test", &configuration));
+
+    syscheck.full_hash_interval = 1;
+}
+
 static void test_fim_get_data_hash_error(void **state) {
     fim_data_t *fim_data = *state;
     directory_t configuration = { .options = CHECK_MD5SUM | CHECK_SHA1SUM | CHECK_SHA256SUM | CHECK_MTIME |
@@ -4340,6 +4473,7 @@ int main(void) {
         cmocka_unit_test(test_fim_file_add),
         cmocka_unit_test_setup_teardown(test_fim_file_modify, setup_fim_entry, teardown_fim_entry),
         cmocka_unit_test_setup_teardown(test_fim_file_modify_transaction, setup_fim_entry, teardown_fim_entry),
+        cmocka_unit_test(test_fim_file_queued_transaction),
 
         cmocka_unit_test(test_fim_file_no_attributes),
         cmocka_unit_test_setup_teardown(test_fim_file_error_on_insert, setup_fim_entry, teardown_fim_entry),
@@ -4410,6 +4544,9 @@ int main(void) {
         /* fim_get_data */
         cmocka_unit_test_teardown(test_fim_get_data, teardown_local_data),
         cmocka_unit_test_teardown(test_fim_get_data_no_hashes, teardown_local_data),
+        cmocka_unit_test_teardown(test_fim_get_data_stored_hashes, teardown_local_data),
+        cmocka_unit_test_teardown(test_fim_get_data_stored_hashes_size_changed, teardown_local_data),
+        cmocka_unit_test(test_fim_get_stored_data_full_hash),
         cmocka_unit_test(test_fim_get_data_hash_error),
 #ifdef TEST_WINAGENT
         cmocka_unit_test(test_fim_get_data_fail_to_get_file_premissions),
@@ -59,6 +59,7 @@ void fim_realtime_delete_watches(const directory_t *configuration);
 #endif
 
 void fim_db_remove_validated_path(void * data, void * ctx);
+cJSON * fim_batch_item(const cJSON *data, const char *name);
 
 extern time_t last_time;
 extern unsigned int files_read;
@@ -821,7 +822,94 @@ void test_fim_send_scan_info(void **state) {
     fim_send_scan_info(FIM_SCAN_START);
 }
 
+void test_fim_batch_item(void **state) {
+    (void) state;
+    cJSON *data = cJSON_Parse("{\"path\":\"/dir/a\",\"version\":2,\"mode\":\"scheduled\",\"type\":\"modified\","
+                              "\"timestamp\":10,\"attributes\":{\"type\":\"file\",\"size\":2,\"mtime\":5},"
+                              "\"old_attributes\":{\"type\":\"file\",\"size\":1,\"mtime\":5},"
+                              "\"changed_attributes\":[\"size\"],\"tags\":\"tag\"}");
+
+    cJSON *item = fim_batch_item(data, "a");
+    char *item_plain = cJSON_PrintUnformatted(item);
+
+    assert_string_equal(item_plain, "{\"name\":\"a\",\"type\":\"modified\",\"timestamp\":10,"
+                                    "\"attributes\":{\"type\":\"file\",\"size\":2,\"mtime\":5},"
+                                    "\"old_attributes\":{\"size\":1},\"changed_attributes\":[\"size\"]}");
+
+    free(item_plain);
+    cJSON_Delete(item);
+    cJSON_Delete(data);
+}
+
 #ifndef TEST_WINAGENT
+void test_fim_batch_event(void **state) {
+    (void) state;
+    const char *msg = "{\"type\":\"event_batch\",\"data\":{\"dir\":\"/dir/\",\"mode\":\"scheduled\",\"version\":2,"
+                      "\"events\":[{\"name\":\"a\",\"type\":\"added\",\"attributes\":{\"type\":\"file\",\"size\":1}},"
+                      "{\"name\":\"b\",\"type\":\"deleted\",\"attributes\":{\"type\":\"file\",\"size\":2}}]}}";
+    char debug_msg[OS_SIZE_1024];
+    cJSON *first = cJSON_Parse("{\"type\":\"event\",\"data\":{\"path\":\"/dir/a\",\"version\":2,\"mode\":\"scheduled\","
+                               "\"type\":\"added\",\"attributes\":{\"type\":\"file\",\"size\":1}}}");
+    cJSON *second = cJSON_Parse("{\"type\":\"event\",\"data\":{\"path\":\"/dir/b\",\"version\":2,\"mode\":\"scheduled\","
+                                "\"type\":\"deleted\",\"attributes\":{\"type\":\"file\",\"size\":2}}}");
+
+    syscheck.event_batch = 2;
+
+    expect_function_call_any(__wrap_pthread_mutex_lock);
+    expect_function_call_any(__wrap_pthread_mutex_unlock);
+
+    snprintf(debug_msg, sizeof(debug_msg), FIM_SEND, msg);
+    expect_string(__wrap__mdebug2, formatted_msg, debug_msg);
+    expect_w_send_sync_msg(msg, SYSCHECK, SYSCHECK_MQ, fim_shutdown_process_on, 0);
+
+    // The batch is sent when it reaches the maximum number of events
+    fim_batch_event(first);
+    fim_batch_event(second);
+
+    // Nothing left to send
+    fim_batch_flush();
+
+    syscheck.event_batch = 0;
+    cJSON_Delete(first);
+    cJSON_Delete(second);
+}
+
+void test_fim_batch_event_another_dir(void **state) {
+    (void) state;
+    const char *msg = "{\"type\":\"event_batch\",\"data\":{\"dir\":\"/dir/\",\"mode\":\"scheduled\",\"version\":2,"
+                      "\"events\":[{\"name\":\"a\",\"type\":\"added\",\"attributes\":{\"type\":\"file\",\"size\":1}}]}}";
+    const char *other_msg = "{\"type\":\"event_batch\",\"data\":{\"dir\":\"/other/\",\"mode\":\"scheduled\","
+                            "\"version\":2,\"events\":[{\"name\":\"a\",\"type\":\"added\","
+                            "\"attributes\":{\"type\":\"file\",\"size\":1}}]}}";
+    char debug_msg[OS_SIZE_1024];
+    cJSON *first = cJSON_Parse("{\"type\":\"event\",\"data\":{\"path\":\"/dir/a\",\"version\":2,\"mode\":\"scheduled\","
+                               "\"type\":\"added\",\"attributes\":{\"type\":\"file\",\"size\":1}}}");
+    cJSON *second = cJSON_Parse("{\"type\":\"event\",\"data\":{\"path\":\"/other/a\",\"version\":2,"
+                                "\"mode\":\"scheduled\",\"type\":\"added\",\"attributes\":{\"type\":\"file\",\"size\":1}}}");
+
+    syscheck.event_batch = 64;
+
+    expect_function_call_any(__wrap_pthread_mutex_lock);
+    expect_function_call_any(__wrap_pthread_mutex_unlock);
+
+    snprintf(debug_msg, sizeof(debug_msg), FIM_SEND, msg);
+    expect_string(__wrap__mdebug2, formatted_msg, debug_msg);
+    expect_w_send_sync_msg(msg, SYSCHECK, SYSCHECK_MQ, fim_shutdown_process_on, 0);
+
+    snprintf(debug_msg, sizeof(debug_msg), FIM_SEND, other_msg);
+    expect_string(__wrap__mdebug2, formatted_msg, debug_msg);
+    expect_w_send_sync_msg(other_msg, SYSCHECK, SYSCHECK_MQ, fim_shutdown_process_on, 0);
+
+    // The event of another directory sends the batch of the previous one
+    fim_batch_event(first);
+    fim_batch_event(second);
+    fim_batch_flush();
+
+    syscheck.event_batch = 0;
+    cJSON_Delete(first);
+    cJSON_Delete(second);
+}
+
 void test_fim_link_update(void **state) {
     char *new_path = "/new_path";
     char pattern[PATH_MAX] = {0};
@@ -1106,9 +1194,12 @@ int main(void) {
         cmocka_unit_test(test_log_realtime_status),
         cmocka_unit_test(test_fim_db_remove_validated_path),
         cmocka_unit_test(test_fim_send_scan_info),
+        cmocka_unit_test(test_fim_batch_item),
         cmocka_unit_test_setup_teardown(test_check_max_fps_no_sleep, setup_max_fps, teardown_max_fps),
         cmocka_unit_test_setup_teardown(test_check_max_fps_sleep, setup_max_fps, teardown_max_fps),
 #ifndef TEST_WINAGENT
+        cmocka_unit_test(test_fim_batch_event),
+        cmocka_unit_test(test_fim_batch_event_another_dir),
         cmocka_unit_test(test_fim_run_realtime_first_error),
         cmocka_unit_test(test_fim_run_realtime_first_timeout),
         cmocka_unit_test(test_fim_run_realtime_first_sleep),
@@ -255,6 +255,9 @@ static int test_setup(void ** state) {
     wdb_state.queries_breakdown.mitre_breakdown.sql_queries = 2;
     wdb_state.queries_breakdown.mitre_breakdown.sql_time.tv_sec = 0;
     wdb_state.queries_breakdown.mitre_breakdown.sql_time.tv_usec = 15202;
+    wdb_state.latency.agent.buckets[0] = 300;
+    wdb_state.latency.agent.buckets[2] = 65;
+    wdb_state.latency.global.buckets[5] = 3;
 
     return 0;
 }
@@ -280,6 +283,21 @@ void test_wazuhdb_create_state_json(void ** state) {
     assert_non_null(cJSON_GetObjectItem(state_json, "metrics"));
     cJSON* metrics = cJSON_GetObjectItem(state_json, "metrics");
 
+    assert_non_null(cJSON_GetObjectItem(metrics, "latency"));
+    cJSON* latency = cJSON_GetObjectItem(metrics, "latency");
+
+    cJSON* agent_latency = cJSON_GetObjectItem(latency, "agent");
+    assert_int_equal(cJSON_GetObjectItem(agent_latency, "under_0.1ms")->valueint, 300);
+    assert_int_equal(cJSON_GetObjectItem(agent_latency, "under_1ms")->valueint, 0);
+    assert_int_equal(cJSON_GetObjectItem(agent_latency, "under_10ms")->valueint, 65);
+
+    cJSON* global_latency = cJSON_GetObjectItem(latency, "global");
+    assert_int_equal(cJSON_GetObjectItem(global_latency, "over_1s")->valueint, 3);
+
+    assert_non_null(cJSON_GetObjectItem(latency, "mitre"));
+    assert_non_null(cJSON_GetObjectItem(latency, "task"));
+    assert_non_null(cJSON_GetObjectItem(latency, "wazuhdb"));
+
     assert_non_null(cJSON_GetObjectItem(metrics, "queries"));
     cJSON* queries = cJSON_GetObjectItem(metrics, "queries");
 
@@ -731,10 +749,65 @@ void test_wazuhdb_create_state_json(void ** state) {
     assert_int_equal(cJSON_GetObjectItem(wazuhdb_time_db, "remove")->valueint, 132);
 }
 
+void test_w_inc_query_latency(void ** state) {
+    struct timeval time = { 0, 500 };
+
+    memset(&wdb_state.latency, 0, sizeof(wdb_state.latency));
+
+    // wdb_parse() leaves the actor terminated
+    w_inc_query_latency("agent", time);
+    w_inc_query_latency(" global get-all-agents", time);
+
+    time.tv_sec = 2;
+    w_inc_query_latency("task upgrade", time);
+
+    time.tv_sec = 0;
+    time.tv_usec = 99;
+    w_inc_query_latency("mitre sql", time);
+
+    // Unknown actors are ignored
+    w_inc_query_latency("agents 001 sql", time);
+
+    assert_int_equal(wdb_state.latency.agent.buckets[1], 1);
+    assert_int_equal(wdb_state.latency.global.buckets[1], 1);
+    assert_int_equal(wdb_state.latency.task.buckets[5], 1);
+    assert_int_equal(wdb_state.latency.mitre.buckets[0], 1);
+    assert_int_equal(wdb_state.latency.agent.buckets[0], 0);
+}
+
+void test_w_inc_checkpoint(void ** state) {
+    struct timeval time = { 0, 1500 };
+
+    memset(&wdb_state.checkpoint, 0, sizeof(wdb_state.checkpoint));
+
+    w_inc_checkpoint(120, false, time);
+    w_inc_checkpoint(30, true, time);
+
+    assert_int_equal(wdb_state.checkpoint.checkpoints, 2);
+    assert_int_equal(wdb_state.checkpoint.incomplete, 1);
+    assert_int_equal(wdb_state.checkpoint.pages, 150);
+    assert_int_equal(wdb_state.checkpoint.time.tv_usec, 3000);
+
+    cJSON * state_json = wdb_create_state_json();
+    cJSON * checkpoint = cJSON_GetObjectItem(cJSON_GetObjectItem(state_json, "metrics"), "checkpoint");
+
+    assert_non_null(checkpoint);
+    assert_int_equal(cJSON_GetObjectItem(checkpoint, "count")->valueint, 2);
+    assert_int_equal(cJSON_GetObjectItem(checkpoint, "incomplete")->valueint, 1);
+    assert_int_equal(cJSON_GetObjectItem(checkpoint, "pages")->valueint, 150);
+    assert_int_equal(cJSON_GetObjectItem(checkpoint, "time")->valueint, 3);
+
+    cJSON_Delete(state_json);
+}
+
 int main(void) {
     const struct CMUnitTest tests[] = {
         // Test wdb_create_state_json
         cmocka_unit_test_setup_teardown(test_wazuhdb_create_state_json, test_setup, test_teardown),
+        // Test w_inc_query_latency
+        cmocka_unit_test(test_w_inc_query_latency),
+        // Test w_inc_checkpoint
+        cmocka_unit_test(test_w_inc_checkpoint),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
@@ -260,6 +260,63 @@ static void test_wdb_syscheck_save2_success(void **state) {
     assert_int_equal(ret, 0);
 }
 
+static void test_wdb_syscheck_save_batch_not_array(void **state) {
+    int ret;
+    wdb_t * wdb = *state;
+
+    expect_string(__wrap__mdebug1, formatted_msg, "DB(000): cannot parse FIM batch: '{}'");
+
+    ret = wdb_syscheck_save_batch(wdb, "{}");
+
+    assert_int_equal(ret, -1);
+}
+
+static void test_wdb_syscheck_save_batch_fail_entry(void **state) {
+    int ret;
+    wdb_t * wdb = *state;
+    cJSON *batch = cJSON_CreateArray();
+    char *unformatted_batch;
+
+    cJSON_AddItemToArray(batch, cJSON_CreateObject());
+    cJSON_AddItemToArray(batch, prepare_valid_entry(2));
+    unformatted_batch = cJSON_PrintUnformatted(batch);
+
+    wdb->transaction = 1;
+
+    // The rest of the batch is stored after an invalid entry
+    expect_string(__wrap__merror, formatted_msg, "DB(000) fim/save request with no file path argument.");
+    expect_string(__wrap__mdebug1, formatted_msg, "DB(000) Can't insert file entry.");
+    expect_wdb_fim_insert_entry2_success(2);
+
+    ret = wdb_syscheck_save_batch(wdb, unformatted_batch);
+
+    cJSON_Delete(batch);
+    free(unformatted_batch);
+    assert_int_equal(ret, -1);
+}
+
+static void test_wdb_syscheck_save_batch_success(void **state) {
+    int ret;
+    wdb_t * wdb = *state;
+    cJSON *batch = cJSON_CreateArray();
+    char *unformatted_batch;
+
+    cJSON_AddItemToArray(batch, prepare_valid_entry(2));
+    cJSON_AddItemToArray(batch, prepare_valid_entry(2));
+    unformatted_batch = cJSON_PrintUnformatted(batch);
+
+    wdb->transaction = 0;
+
+    will_return(__wrap_wdb_begin2, 0);
+    expect_wdb_fim_insert_entry2_success(2);
+    expect_wdb_fim_insert_entry2_success(2);
+
+    ret = wdb_syscheck_save_batch(wdb, unformatted_batch);
+
+    cJSON_Delete(batch);
+    free(unformatted_batch);
+    assert_int_equal(ret, 0);
+}
 
 static void test_wdb_fim_insert_entry2_wdb_null(void **state) {
     (void) state; /* unused */
@@ -770,6 +827,11 @@ int main(void) {
         cmocka_unit_test(test_wdb_syscheck_save2_fail_file_entry),
         cmocka_unit_test(test_wdb_syscheck_save2_success),
 
+        // Test wdb_syscheck_save_batch
+        cmocka_unit_test(test_wdb_syscheck_save_batch_not_array),
+        cmocka_unit_test(test_wdb_syscheck_save_batch_fail_entry),
+        cmocka_unit_test(test_wdb_syscheck_save_batch_success),
+
         // Test wdb_fim_insert_entry2
         cmocka_unit_test(test_wdb_fim_insert_entry2_wdb_null),
         cmocka_unit_test(test_wdb_fim_insert_entry2_data_null),
@@ -0,0 +1,227 @@
+/*
+ * Copyright (C) 2015, Wazuh Inc.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdio.h>
+#include <string.h>
+#include <arpa/inet.h>
+
+#include "../wazuh_db/wdb.h"
+#include "../wazuh_db/wdb_frame.h"
+#include "../wrappers/common.h"
+#include "../wrappers/wazuh/shared/debug_op_wrappers.h"
+#include "../wrappers/wazuh/wazuh_db/wdb_wrappers.h"
+#include "../wrappers/wazuh/wazuh_db/wdb_global_wrappers.h"
+#include "../wrappers/wazuh/wazuh_db/wdb_pool_wrappers.h"
+
+typedef struct test_frame_t {
+    char buffer[OS_MAXSTR + 1];
+    size_t length;
+    char output[OS_MAXSTR + 1];
+} test_frame_t;
+
+/* auxiliary functions */
+
+static void frame_init(test_frame_t * frame, unsigned char version, uint16_t count) {
+    count = htons(count);
+    frame->buffer[0] = (char)WDB_FRAME_MAGIC;
+    frame->buffer[1] = version;
+    memcpy(frame->buffer + 2, &count, sizeof(count));
+    frame->length = WDB_FRAME_HEADER;
+}
+
+static void frame_add(test_frame_t * frame, unsigned char type, uint32_t agent_id, unsigned char argument, const char * name, const char * data, size_t data_length) {
+    char * op = frame->buffer + frame->length;
+    size_t name_length = strlen(name);
+    uint32_t length = htonl(data_length);
+
+    agent_id = htonl(agent_id);
+    op[0] = type;
+    memcpy(op + 1, &agent_id, sizeof(agent_id));
+    op[5] = argument;
+    op[6] = name_length;
+    memcpy(op + 7, &length, sizeof(length));
+    memcpy(op + WDB_FRAME_OP_HEADER, name, name_length);
+    memcpy(op + WDB_FRAME_OP_HEADER + name_length, data, data_length);
+
+    frame->length += WDB_FRAME_OP_HEADER + name_length + data_length;
+}
+
+static void expect_open_agent(wdb_t * global, wdb_t * agent, int agent_id) {
+    will_return(__wrap_wdb_open_global, global);
+    expect_value(__wrap_wdb_global_agent_exists, wdb, global);
+    expect_value(__wrap_wdb_global_agent_exists, agent_id, agent_id);
+    will_return(__wrap_wdb_global_agent_exists, 1);
+    expect_function_call(__wrap_wdb_pool_leave);
+
+    expect_value(__wrap_wdb_open_agent2, agent_id, agent_id);
+    will_return(__wrap_wdb_open_agent2, agent);
+}
+
+/* Tests wdb_frame_check */
+
+static void test_wdb_frame_check(void **state) {
+    char frame[] = { (char)WDB_FRAME_MAGIC, WDB_FRAME_VERSION, 0, 1 };
+
+    assert_int_equal(wdb_frame_check(frame, sizeof(frame)), 1);
+    assert_int_equal(wdb_frame_check(frame, 3), 0);
+    assert_int_equal(wdb_frame_check("agent 001 sql SELECT 1", 22), 0);
+    assert_int_equal(wdb_frame_check("{\"command\":\"getstats\"}", 22), 0);
+}
+
+/* Tests wdb_frame_dispatch */
+
+static void test_wdb_frame_dispatch_invalid_version(void **state) {
+    test_frame_t frame;
+
+    frame_init(&frame, 2, 1);
+    frame_add(&frame, WDB_FRAME_FIM_SAVE, 1, 0, "", "{}", 2);
+
+    expect_string(__wrap__mdebug1, formatted_msg, "Unsupported frame version: 2");
+
+    assert_int_equal(wdb_frame_dispatch(frame.buffer, frame.length, frame.output, OS_MAXSTR), WDB_FRAME_HEADER);
+    assert_memory_equal(frame.output, "\xB7\x01\x00\x00", WDB_FRAME_HEADER);
+}
+
+static void test_wdb_frame_dispatch_dbsync_batch(void **state) {
+    wdb_t global = { .enabled = true };
+    wdb_t agent = { .id = "001" };
+    test_frame_t frame;
+
+    frame_init(&frame, WDB_FRAME_VERSION, 2);
+    frame_add(&frame, WDB_FRAME_DBSYNC, 1, WDB_FRAME_DBSYNC_INSERTED, "packages", "{\"name\":\"a\"}", 12);
+    frame_add(&frame, WDB_FRAME_DBSYNC, 1, WDB_FRAME_DBSYNC_DELETED, "packages", "{\"name\":\"b\"}", 12);
+
+    // The agent database is opened once for the frame
+    expect_open_agent(&global, &agent, 1);
+
+    expect_string(__wrap_wdb_dbsync_process, table_key, "packages");
+    expect_string(__wrap_wdb_dbsync_process, operation, "INSERTED");
+    expect_string(__wrap_wdb_dbsync_process, data, "{\"name\":\"a\"}");
+    will_return(__wrap_wdb_dbsync_process, OS_SUCCESS);
+
+    expect_string(__wrap_wdb_dbsync_process, table_key, "packages");
+    expect_string(__wrap_wdb_dbsync_process, operation, "DELETED");
+    expect_string(__wrap_wdb_dbsync_process, data, "{\"name\":\"b\"}");
+    will_return(__wrap_wdb_dbsync_process, OS_SUCCESS);
+
+    expect_function_call(__wrap_wdb_pool_leave);
+
+    assert_int_equal(wdb_frame_dispatch(frame.buffer, frame.length, frame.output, OS_MAXSTR), WDB_FRAME_HEADER + 4);
+    assert_memory_equal(frame.output, "\xB7\x01\x00\x02\x00\x00\x00\x00", WDB_FRAME_HEADER + 4);
+}
+
+static void test_wdb_frame_dispatch_syscollector_errors(void **state) {
+    wdb_t global = { .enabled = true };
+    wdb_t agent = { .id = "002" };
+    test_frame_t frame;
+
+    frame_init(&frame, WDB_FRAME_VERSION, 2);
+    frame_add(&frame, WDB_FRAME_SYSCOLLECTOR_SAVE, 2, WDB_FIM, "", "{}", 2);
+    frame_add(&frame, WDB_FRAME_SYSCOLLECTOR_SAVE, 2, WDB_SYSCOLLECTOR_PACKAGES, "", "{\"attributes\":{}}", 17);
+
+    expect_open_agent(&global, &agent, 2);
+
+    expect_value(__wrap_wdb_syscollector_save2, component, WDB_SYSCOLLECTOR_PACKAGES);
+    expect_string(__wrap_wdb_syscollector_save2, payload, "{\"attributes\":{}}");
+    will_return(__wrap_wdb_syscollector_save2, OS_INVALID);
+
+    expect_string(__wrap__mdebug1, formatted_msg, "DB(002) Cannot save Syscollector.");
+
+    expect_function_call(__wrap_wdb_pool_leave);
+
+    assert_int_equal(wdb_frame_dispatch(frame.buffer, frame.length, frame.output, OS_MAXSTR), WDB_FRAME_HEADER + 32 + 26);
+    assert_memory_equal(frame.output, "\xB7\x01\x00\x02\x01\x1E" "Invalid Syscollector component" "\x01\x18" "Cannot save Syscollector", WDB_FRAME_HEADER + 32 + 26);
+}
+
+static void test_wdb_frame_dispatch_keepalive(void **state) {
+    wdb_t global = { .enabled = true };
+    test_frame_t frame;
+    char data[1 + 6 + 8] = "\x06synced";
+    uint32_t id;
+
+    id = htonl(1);
+    memcpy(data + 7, &id, sizeof(id));
+    id = htonl(3);
+    memcpy(data + 11, &id, sizeof(id));
+
+    frame_init(&frame, WDB_FRAME_VERSION, 1);
+    frame_add(&frame, WDB_FRAME_KEEPALIVE, 0, 0, "active", data, sizeof(data));
+
+    will_return(__wrap_wdb_open_global, &global);
+
+    expect_value(__wrap_wdb_global_update_agents_keepalive, count, 2);
+    expect_value(__wrap_wdb_global_update_agents_keepalive, id, 1);
+    expect_value(__wrap_wdb_global_update_agents_keepalive, id, 3);
+    expect_string(__wrap_wdb_global_update_agents_keepalive, connection_status, "active");
+    expect_string(__wrap_wdb_global_update_agents_keepalive, sync_status, "synced");
+    will_return(__wrap_wdb_global_update_agents_keepalive, OS_SUCCESS);
+
+    expect_function_call(__wrap_wdb_pool_leave);
+
+    assert_int_equal(wdb_frame_dispatch(frame.buffer, frame.length, frame.output, OS_MAXSTR), WDB_FRAME_HEADER + 2);
+    assert_memory_equal(frame.output, "\xB7\x01\x00\x01\x00\x00", WDB_FRAME_HEADER + 2);
+}
+
+static void test_wdb_frame_dispatch_truncated(void **state) {
+    wdb_t global = { .enabled = true };
+    wdb_t agent = { .id = "001" };
+    test_frame_t frame;
+
+    frame_init(&frame, WDB_FRAME_VERSION, 2);
+    frame_add(&frame, WDB_FRAME_FIM_SAVE, 1, 0, "", "{}", 2);
+    frame_add(&frame, WDB_FRAME_FIM_SAVE, 1, 0, "", "{}", 2);
+    frame.length -= 1;
+
+    expect_open_agent(&global, &agent, 1);
+    will_return(__wrap_wdb_syscheck_save2, OS_SUCCESS);
+
+    expect_string(__wrap__mdebug1, formatted_msg, "Invalid operation at offset 17 of frame.");
+    expect_function_call(__wrap_wdb_pool_leave);
+
+    // Only the complete operation is answered
+    assert_int_equal(wdb_frame_dispatch(frame.buffer, frame.length, frame.output, OS_MAXSTR), WDB_FRAME_HEADER + 2);
+    assert_memory_equal(frame.output, "\xB7\x01\x00\x01\x00\x00", WDB_FRAME_HEADER + 2);
+}
+
+static void test_wdb_frame_dispatch_agent_not_found(void **state) {
+    wdb_t global = { .enabled = true };
+    test_frame_t frame;
+
+    frame_init(&frame, WDB_FRAME_VERSION, 1);
+    frame_add(&frame, WDB_FRAME_FIM_SAVE, 5, 0, "", "{}", 2);
+
+    will_return(__wrap_wdb_open_global, &global);
+    expect_value(__wrap_wdb_global_agent_exists, wdb, &global);
+    expect_value(__wrap_wdb_global_agent_exists, agent_id, 5);
+    will_return(__wrap_wdb_global_agent_exists, 0);
+    expect_function_call(__wrap_wdb_pool_leave);
+
+    assert_int_equal(wdb_frame_dispatch(frame.buffer, frame.length, frame.output, OS_MAXSTR), WDB_FRAME_HEADER + 2 + 15);
+    assert_memory_equal(frame.output, "\xB7\x01\x00\x01\x01\x0F" "Agent not found", WDB_FRAME_HEADER + 2 + 15);
+}
+
+int main() {
+    const struct CMUnitTest tests[] = {
+        // wdb_frame_check
+        cmocka_unit_test(test_wdb_frame_check),
+        // wdb_frame_dispatch
+        cmocka_unit_test(test_wdb_frame_dispatch_invalid_version),
+        cmocka_unit_test(test_wdb_frame_dispatch_dbsync_batch),
+        cmocka_unit_test(test_wdb_frame_dispatch_syscollector_errors),
+        cmocka_unit_test(test_wdb_frame_dispatch_keepalive),
+        cmocka_unit_test(test_wdb_frame_dispatch_truncated),
+        cmocka_unit_test(test_wdb_frame_dispatch_agent_not_found),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -1412,6 +1412,250 @@ void test_wdb_update_agent_keepalive_success(void **state)
     assert_int_equal(OS_SUCCESS, ret);
 }
 
+/* Tests wdb_update_agents_keepalive */
+
+void test_wdb_update_agents_keepalive_error_json(void **state)
+{
+    int ret = 0;
+    int ids[] = { 1, 2 };
+
+    will_return(__wrap_cJSON_CreateObject, NULL);
+
+    expect_string(__wrap__mdebug1, formatted_msg, "Error creating data JSON for Wazuh DB.");
+
+    ret = wdb_update_agents_keepalive(ids, 2, "active", "synced", NULL);
+
+    assert_int_equal(OS_INVALID, ret);
+}
+
+void test_wdb_update_agents_keepalive_error_result(void **state)
+{
+    int ret = 0;
+    int ids[] = { 1, 2 };
+
+    const char *json_str = strdup("{\"connection_status\":\"active\",\"sync_status\":\"synced\",\"agents\":[1,2]}");
+    const char *query_str = "global update-agents-keepalive {\"connection_status\":\"active\",\"sync_status\":\"synced\",\"agents\":[1,2]}";
+    const char *response = "err";
+
+    will_return(__wrap_cJSON_CreateObject, 1);
+    will_return_always(__wrap_cJSON_AddStringToObject, 1);
+
+    // Adding data to JSON
+    expect_string(__wrap_cJSON_AddStringToObject, name, "connection_status");
+    expect_string(__wrap_cJSON_AddStringToObject, string, "active");
+    expect_string(__wrap_cJSON_AddStringToObject, name, "sync_status");
+    expect_string(__wrap_cJSON_AddStringToObject, string, "synced");
+    expect_string(__wrap_cJSON_AddArrayToObject, name, "agents");
+    will_return(__wrap_cJSON_AddArrayToObject, 1);
+    expect_value(__wrap_cJSON_CreateNumber, num, 1);
+    will_return(__wrap_cJSON_CreateNumber, 1);
+    expect_function_call(__wrap_cJSON_AddItemToArray);
+    will_return(__wrap_cJSON_AddItemToArray, true);
+    expect_value(__wrap_cJSON_CreateNumber, num, 2);
+    will_return(__wrap_cJSON_CreateNumber, 1);
+    expect_function_call(__wrap_cJSON_AddItemToArray);
+    will_return(__wrap_cJSON_AddItemToArray, true);
+
+    // Printing JSON
+    will_return(__wrap_cJSON_PrintUnformatted, json_str);
+
+    // Calling Wazuh DB
+    expect_any(__wrap_wdbc_query_ex, *sock);
+    expect_string(__wrap_wdbc_query_ex, query, query_str);
+    expect_value(__wrap_wdbc_query_ex, len, WDBOUTPUT_SIZE);
+    will_return(__wrap_wdbc_query_ex, response);
+    will_return(__wrap_wdbc_query_ex, OS_SUCCESS);
+
+    // Parsing Wazuh DB result
+    expect_any(__wrap_wdbc_parse_result, result);
+    will_return(__wrap_wdbc_parse_result, WDBC_ERROR);
+    expect_string(__wrap__mdebug1, formatted_msg, "Global DB Error reported in the result of the query");
+    expect_function_call(__wrap_cJSON_Delete);
+
+    ret = wdb_update_agents_keepalive(ids, 2, "active", "synced", NULL);
+
+    assert_int_equal(OS_INVALID, ret);
+}
+
+void test_wdb_update_agents_keepalive_success(void **state)
+{
+    int ret = 0;
+    int ids[] = { 1 };
+
+    const char *json_str = strdup("{\"connection_status\":\"active\",\"sync_status\":\"synced\",\"agents\":[1]}");
+    const char *query_str = "global update-agents-keepalive {\"connection_status\":\"active\",\"sync_status\":\"synced\",\"agents\":[1]}";
+    const char *response = "ok";
+
+    will_return(__wrap_cJSON_CreateObject, 1);
+    will_return_always(__wrap_cJSON_AddStringToObject, 1);
+
+    // Adding data to JSON
+    expect_string(__wrap_cJSON_AddStringToObject, name, "connection_status");
+    expect_string(__wrap_cJSON_AddStringToObject, string, "active");
+    expect_string(__wrap_cJSON_AddStringToObject, name, "sync_status");
+    expect_string(__wrap_cJSON_AddStringToObject, string, "synced");
+    expect_string(__wrap_cJSON_AddArrayToObject, name, "agents");
+    will_return(__wrap_cJSON_AddArrayToObject, 1);
+    expect_value(__wrap_cJSON_CreateNumber, num, 1);
+    will_return(__wrap_cJSON_CreateNumber, 1);
+    expect_function_call(__wrap_cJSON_AddItemToArray);
+    will_return(__wrap_cJSON_AddItemToArray, true);
+
+    // Printing JSON
+    will_return(__wrap_cJSON_PrintUnformatted, json_str);
+
+    // Calling Wazuh DB
+    expect_any(__wrap_wdbc_query_ex, *sock);
+    expect_string(__wrap_wdbc_query_ex, query, query_str);
+    expect_value(__wrap_wdbc_query_ex, len, WDBOUTPUT_SIZE);
+    will_return(__wrap_wdbc_query_ex, response);
+    will_return(__wrap_wdbc_query_ex, OS_SUCCESS);
+
+    // Parsing Wazuh DB result
+    expect_any(__wrap_wdbc_parse_result, result);
+    will_return(__wrap_wdbc_parse_result, WDBC_OK);
+    expect_function_call(__wrap_cJSON_Delete);
+
+    ret = wdb_update_agents_keepalive(ids, 1, "active", "synced", NULL);
+
+    assert_int_equal(OS_SUCCESS, ret);
+}
+
+/* Tests wdb_insert_agents */
+
+void test_wdb_insert_agents_error_result(void **state)
+{
+    int ret = 0;
+    cJSON agent = { 0 };
+    cJSON agents = { .type = cJSON_Array, .child = &agent };
+
+    const char *query_str = "global insert-agents [{\"id\":1,\"name\":\"agent1\",\"date_add\":123}]";
+    const char *response = "err";
+
+    will_return(__wrap_cJSON_PrintUnformatted, strdup("{\"id\":1,\"name\":\"agent1\",\"date_add\":123}"));
+
+    // Calling Wazuh DB
+    expect_any(__wrap_wdbc_query_ex, *sock);
+    expect_string(__wrap_wdbc_query_ex, query, query_str);
+    expect_value(__wrap_wdbc_query_ex, len, WDBOUTPUT_SIZE);
+    will_return(__wrap_wdbc_query_ex, response);
+    will_return(__wrap_wdbc_query_ex, OS_SUCCESS);
+
+    // Parsing Wazuh DB result
+    expect_any(__wrap_wdbc_parse_result, result);
+    will_return(__wrap_wdbc_parse_result, WDBC_ERROR);
+    expect_string(__wrap__mdebug1, formatted_msg, "Global DB Error reported in the result of the query");
+
+    ret = wdb_insert_agents(&agents, NULL);
+
+    assert_int_equal(OS_INVALID, ret);
+}
+
+void test_wdb_insert_agents_success(void **state)
+{
+    int ret = 0;
+    cJSON agent2 = { 0 };
+    cJSON agent1 = { .next = &agent2 };
+    cJSON agents = { .type = cJSON_Array, .child = &agent1 };
+
+    const char *query_str = "global insert-agents [{\"id\":1,\"name\":\"agent1\",\"date_add\":123},{\"id\":2,\"name\":\"agent2\",\"date_add\":456}]";
+    const char *response = "ok";
+
+    will_return(__wrap_cJSON_PrintUnformatted, strdup("{\"id\":1,\"name\":\"agent1\",\"date_add\":123}"));
+    will_return(__wrap_cJSON_PrintUnformatted, strdup("{\"id\":2,\"name\":\"agent2\",\"date_add\":456}"));
+
+    // Both agents are sent in a single query
+    expect_any(__wrap_wdbc_query_ex, *sock);
+    expect_string(__wrap_wdbc_query_ex, query, query_str);
+    expect_value(__wrap_wdbc_query_ex, len, WDBOUTPUT_SIZE);
+    will_return(__wrap_wdbc_query_ex, response);
+    will_return(__wrap_wdbc_query_ex, OS_SUCCESS);
+
+    // Parsing Wazuh DB result
+    expect_any(__wrap_wdbc_parse_result, result);
+    will_return(__wrap_wdbc_parse_result, WDBC_OK);
+
+    ret = wdb_insert_agents(&agents, NULL);
+
+    assert_int_equal(OS_SUCCESS, ret);
+}
+
+void test_wdb_insert_agents_chunks(void **state)
+{
+    int ret = 0;
+    cJSON agent2 = { 0 };
+    cJSON agent1 = { .next = &agent2 };
+    cJSON agents = { .type = cJSON_Array, .child = &agent1 };
+    char *agent1_str = NULL;
+    char *agent2_str = NULL;
+    char *query_str1 = NULL;
+    char *query_str2 = NULL;
+    const char *response = "ok";
+
+    // Each agent takes more than half of the query, so they are sent in two queries
+    os_calloc(OS_MAXSTR / 2 + 1, sizeof(char), agent1_str);
+    memset(agent1_str, 'a', OS_MAXSTR / 2);
+    os_strdup(agent1_str, agent2_str);
+    os_calloc(OS_MAXSTR, sizeof(char), query_str1);
+    snprintf(query_str1, OS_MAXSTR, "global insert-agents [%s]", agent1_str);
+    os_strdup(query_str1, query_str2);
+
+    will_return(__wrap_cJSON_PrintUnformatted, agent1_str);
+    will_return(__wrap_cJSON_PrintUnformatted, agent2_str);
+
+    expect_any(__wrap_wdbc_query_ex, *sock);
+    expect_string(__wrap_wdbc_query_ex, query, query_str1);
+    expect_value(__wrap_wdbc_query_ex, len, WDBOUTPUT_SIZE);
+    will_return(__wrap_wdbc_query_ex, response);
+    will_return(__wrap_wdbc_query_ex, OS_SUCCESS);
+    expect_any(__wrap_wdbc_parse_result, result);
+    will_return(__wrap_wdbc_parse_result, WDBC_OK);
+
+    expect_any(__wrap_wdbc_query_ex, *sock);
+    expect_string(__wrap_wdbc_query_ex, query, query_str2);
+    expect_value(__wrap_wdbc_query_ex, len, WDBOUTPUT_SIZE);
+    will_return(__wrap_wdbc_query_ex, response);
+    will_return(__wrap_wdbc_query_ex, OS_SUCCESS);
+    expect_any(__wrap_wdbc_parse_result, result);
+    will_return(__wrap_wdbc_parse_result, WDBC_OK);
+
+    ret = wdb_insert_agents(&agents, NULL);
+
+    assert_int_equal(OS_SUCCESS, ret);
+
+    os_free(query_str1);
+    os_free(query_str2);
+}
+
+/* Tests wdb_set_agents_groups */
+
+void test_wdb_set_agents_groups_success(void **state)
+{
+    int ret = 0;
+    cJSON agent = { 0 };
+    cJSON agents = { .type = cJSON_Array, .child = &agent };
+
+    const char *query_str = "global set-agent-groups {\"mode\":\"override\",\"sync_status\":\"syncreq\",\"data\":[{\"id\":1,\"groups\":[\"default\"]}]}";
+    const char *response = "ok";
+
+    will_return(__wrap_cJSON_PrintUnformatted, strdup("{\"id\":1,\"groups\":[\"default\"]}"));
+
+    // Calling Wazuh DB
+    expect_any(__wrap_wdbc_query_ex, *sock);
+    expect_string(__wrap_wdbc_query_ex, query, query_str);
+    expect_value(__wrap_wdbc_query_ex, len, WDBOUTPUT_SIZE);
+    will_return(__wrap_wdbc_query_ex, response);
+    will_return(__wrap_wdbc_query_ex, OS_SUCCESS);
+
+    // Parsing Wazuh DB result
+    expect_any(__wrap_wdbc_parse_result, result);
+    will_return(__wrap_wdbc_parse_result, WDBC_OK);
+
+    ret = wdb_set_agents_groups(&agents, "override", "syncreq", NULL);
+
+    assert_int_equal(OS_SUCCESS, ret);
+}
+
 /* Tests wdb_update_agent_connection_status */
 
 void test_wdb_update_agent_connection_status_error_json(void **state)
@@ -4138,6 +4382,16 @@ int main()
         cmocka_unit_test_setup_teardown(test_wdb_update_agent_keepalive_error_sql_execution, setup_wdb_global_helpers, teardown_wdb_global_helpers),
         cmocka_unit_test_setup_teardown(test_wdb_update_agent_keepalive_error_result, setup_wdb_global_helpers, teardown_wdb_global_helpers),
         cmocka_unit_test_setup_teardown(test_wdb_update_agent_keepalive_success, setup_wdb_global_helpers, teardown_wdb_global_helpers),
+        /* Tests wdb_update_agents_keepalive */
+        cmocka_unit_test_setup_teardown(test_wdb_update_agents_keepalive_error_json, setup_wdb_global_helpers, teardown_wdb_global_helpers),
+        cmocka_unit_test_setup_teardown(test_wdb_update_agents_keepalive_error_result, setup_wdb_global_helpers, teardown_wdb_global_helpers),
+        cmocka_unit_test_setup_teardown(test_wdb_update_agents_keepalive_success, setup_wdb_global_helpers, teardown_wdb_global_helpers),
+        /* Tests wdb_insert_agents */
+        cmocka_unit_test_setup_teardown(test_wdb_insert_agents_error_result, setup_wdb_global_helpers, teardown_wdb_global_helpers),
+        cmocka_unit_test_setup_teardown(test_wdb_insert_agents_success, setup_wdb_global_helpers, teardown_wdb_global_helpers),
+        cmocka_unit_test_setup_teardown(test_wdb_insert_agents_chunks, setup_wdb_global_helpers, teardown_wdb_global_helpers),
+        /* Tests wdb_set_agents_groups */
+        cmocka_unit_test_setup_teardown(test_wdb_set_agents_groups_success, setup_wdb_global_helpers, teardown_wdb_global_helpers),
         /* Tests wdb_update_agent_connection_status */
         cmocka_unit_test_setup_teardown(test_wdb_update_agent_connection_status_error_json, setup_wdb_global_helpers, teardown_wdb_global_helpers),
         cmocka_unit_test_setup_teardown(test_wdb_update_agent_connection_status_error_socket, setup_wdb_global_helpers, teardown_wdb_global_helpers),
@@ -411,6 +411,165 @@ void test_wdb_parse_global_insert_agent_success(void **state)
     assert_int_equal(ret, OS_SUCCESS);
 }
 
+/* Tests wdb_parse_global_insert_agents */
+
+void test_wdb_parse_global_insert_agents_syntax_error(void **state)
+{
+    int ret = 0;
+    test_struct_t *data  = (test_struct_t *)*state;
+    char query[OS_BUFFER_SIZE] = "global insert-agents";
+
+    will_return(__wrap_wdb_open_global, data->wdb);
+    expect_string(__wrap__mdebug2, formatted_msg, "Global query: insert-agents");
+    expect_string(__wrap__mdebug1, formatted_msg, "Global DB Invalid DB query syntax for insert-agents.");
+    expect_string(__wrap__mdebug2, formatted_msg, "Global DB query error near: insert-agents");
+
+    expect_function_call(__wrap_w_inc_queries_total);
+    expect_function_call(__wrap_w_inc_global);
+    will_return(__wrap_gettimeofday, NULL);
+    will_return(__wrap_gettimeofday, NULL);
+    expect_function_call(__wrap_w_inc_global_open_time);
+    expect_function_call(__wrap_w_inc_global_agent_insert_agent);
+
+    expect_string(__wrap_w_is_file, file, "queue/db/global.db");
+    will_return(__wrap_w_is_file, 1);
+    expect_function_call(__wrap_wdb_pool_leave);
+
+    ret = wdb_parse(query, data->output, 0);
+
+    assert_string_equal(data->output, "err Invalid DB query syntax, near 'insert-agents'");
+    assert_int_equal(ret, OS_INVALID);
+}
+
+void test_wdb_parse_global_insert_agents_not_array(void **state)
+{
+    int ret = 0;
+    test_struct_t *data  = (test_struct_t *)*state;
+    char query[OS_BUFFER_SIZE] = "global insert-agents {\"id\":1,\"name\":\"test_name\",\"date_add\":123}";
+
+    will_return(__wrap_wdb_open_global, data->wdb);
+    expect_string(__wrap__mdebug2, formatted_msg, "Global query: insert-agents {\"id\":1,\"name\":\"test_name\",\"date_add\":123}");
+    expect_string(__wrap__mdebug1, formatted_msg, "Global DB Invalid JSON data when inserting agents.");
+
+    expect_function_call(__wrap_w_inc_queries_total);
+    expect_function_call(__wrap_w_inc_global);
+    will_return(__wrap_gettimeofday, NULL);
+    will_return(__wrap_gettimeofday, NULL);
+    expect_function_call(__wrap_w_inc_global_open_time);
+    expect_function_call(__wrap_w_inc_global_agent_insert_agent);
+    will_return(__wrap_gettimeofday, NULL);
+    will_return(__wrap_gettimeofday, NULL);
+    expect_function_call(__wrap_w_inc_global_agent_insert_agent_time);
+
+    expect_string(__wrap_w_is_file, file, "queue/db/global.db");
+    will_return(__wrap_w_is_file, 1);
+    expect_function_call(__wrap_wdb_pool_leave);
+
+    ret = wdb_parse(query, data->output, 0);
+
+    assert_string_equal(data->output, "err Invalid JSON data, near '{\"id\":1,\"name\":\"test_name\",\"date'");
+    assert_int_equal(ret, OS_INVALID);
+}
+
+void test_wdb_parse_global_insert_agents_partial_error(void **state)
+{
+    int ret = 0;
+    test_struct_t *data  = (test_struct_t *)*state;
+    char query[OS_BUFFER_SIZE] = "global insert-agents [{\"id\":1,\"name\":\"test_name\",\"date_add\":null},\
+{\"id\":2,\"name\":\"test_name2\",\"date_add\":123},{\"id\":3,\"name\":\"test_name3\",\"date_add\":456}]";
+
+    will_return(__wrap_wdb_open_global, data->wdb);
+    expect_string(__wrap__mdebug2, formatted_msg, "Global query: insert-agents [{\"id\":1,\"name\":\"test_name\",\"date_add\":null},\
+{\"id\":2,\"name\":\"test_name2\",\"date_add\":123},{\"id\":3,\"name\":\"test_name3\",\"date_add\":456}]");
+    expect_string(__wrap__mdebug1, formatted_msg, "Global DB Invalid JSON data when inserting agents. Not compliant with constraints defined in the database.");
+
+    expect_value(__wrap_wdb_global_insert_agent, id, 2);
+    expect_string(__wrap_wdb_global_insert_agent, name, "test_name2");
+    expect_value(__wrap_wdb_global_insert_agent, ip, NULL);
+    expect_value(__wrap_wdb_global_insert_agent, register_ip, NULL);
+    expect_value(__wrap_wdb_global_insert_agent, internal_key, NULL);
+    expect_value(__wrap_wdb_global_insert_agent, group, NULL);
+    expect_value(__wrap_wdb_global_insert_agent, date_add, 123);
+    will_return(__wrap_wdb_global_insert_agent, OS_INVALID);
+    will_return_count(__wrap_sqlite3_errmsg, "ERROR MESSAGE", -1);
+    expect_string(__wrap__mdebug1, formatted_msg, "Global DB Cannot insert agent 2; err database queue/db/global.db: ERROR MESSAGE");
+
+    expect_value(__wrap_wdb_global_insert_agent, id, 3);
+    expect_string(__wrap_wdb_global_insert_agent, name, "test_name3");
+    expect_value(__wrap_wdb_global_insert_agent, ip, NULL);
+    expect_value(__wrap_wdb_global_insert_agent, register_ip, NULL);
+    expect_value(__wrap_wdb_global_insert_agent, internal_key, NULL);
+    expect_value(__wrap_wdb_global_insert_agent, group, NULL);
+    expect_value(__wrap_wdb_global_insert_agent, date_add, 456);
+    will_return(__wrap_wdb_global_insert_agent, OS_SUCCESS);
+
+    expect_function_call(__wrap_w_inc_queries_total);
+    expect_function_call(__wrap_w_inc_global);
+    will_return(__wrap_gettimeofday, NULL);
+    will_return(__wrap_gettimeofday, NULL);
+    expect_function_call(__wrap_w_inc_global_open_time);
+    expect_function_call(__wrap_w_inc_global_agent_insert_agent);
+    will_return(__wrap_gettimeofday, NULL);
+    will_return(__wrap_gettimeofday, NULL);
+    expect_function_call(__wrap_w_inc_global_agent_insert_agent_time);
+
+    expect_string(__wrap_w_is_file, file, "queue/db/global.db");
+    will_return(__wrap_w_is_file, 1);
+    expect_function_call(__wrap_wdb_pool_leave);
+
+    ret = wdb_parse(query, data->output, 0);
+
+    assert_string_equal(data->output, "err Cannot insert 2 of 3 agents");
+    assert_int_equal(ret, OS_INVALID);
+}
+
+void test_wdb_parse_global_insert_agents_success(void **state)
+{
+    int ret = 0;
+    test_struct_t *data  = (test_struct_t *)*state;
+    char query[OS_BUFFER_SIZE] = "global insert-agents [{\"id\":1,\"name\":\"test_name\",\"date_add\":123,\
+\"register_ip\":\"1.1.1.1\",\"internal_key\":\"test_key\",\"group\":\"test_group\"},{\"id\":2,\"name\":\"test_name2\",\"date_add\":456}]";
+
+    will_return(__wrap_wdb_open_global, data->wdb);
+    expect_string(__wrap__mdebug2, formatted_msg, "Global query: insert-agents [{\"id\":1,\"name\":\"test_name\",\"date_add\":123,\
+\"register_ip\":\"1.1.1.1\",\"internal_key\":\"test_key\",\"group\":\"test_group\"},{\"id\":2,\"name\":\"test_name2\",\"date_add\":456}]");
+
+    expect_value(__wrap_wdb_global_insert_agent, id, 1);
+    expect_string(__wrap_wdb_global_insert_agent, name, "test_name");
+    expect_value(__wrap_wdb_global_insert_agent, ip, NULL);
+    expect_string(__wrap_wdb_global_insert_agent, register_ip, "1.1.1.1");
+    expect_string(__wrap_wdb_global_insert_agent, internal_key, "test_key");
+    expect_string(__wrap_wdb_global_insert_agent, group, "test_group");
+    expect_value(__wrap_wdb_global_insert_agent, date_add, 123);
+    will_return(__wrap_wdb_global_insert_agent, OS_SUCCESS);
+
+    expect_value(__wrap_wdb_global_insert_agent, id, 2);
+    expect_string(__wrap_wdb_global_insert_agent, name, "test_name2");
+    expect_value(__wrap_wdb_global_insert_agent, ip, NULL);
+    expect_value(__wrap_wdb_global_insert_agent, register_ip, NULL);
+    expect_value(__wrap_wdb_global_insert_agent, internal_key, NULL);
+    expect_value(__wrap_wdb_global_insert_agent, group, NULL);
+    expect_value(__wrap_wdb_global_insert_agent, date_add, 456);
+    will_return(__wrap_wdb_global_insert_agent, OS_SUCCESS);
+
+    expect_function_call(__wrap_w_inc_queries_total);
+    expect_function_call(__wrap_w_inc_global);
+    will_return(__wrap_gettimeofday, NULL);
+    will_return(__wrap_gettimeofday, NULL);
+    expect_function_call(__wrap_w_inc_global_open_time);
+    expect_function_call(__wrap_w_inc_global_agent_insert_agent);
+    will_return(__wrap_gettimeofday, NULL);
+    will_return(__wrap_gettimeofday, NULL);
+    expect_function_call(__wrap_w_inc_global_agent_insert_agent_time);
+
+    expect_function_call(__wrap_wdb_pool_leave);
+
+    ret = wdb_parse(query, data->output, 0);
+
+    assert_string_equal(data->output, "ok");
+    assert_int_equal(ret, OS_SUCCESS);
+}
+
 /* Tests wdb_parse_global_update_agent_name */
 
 void test_wdb_parse_global_update_agent_name_syntax_error(void **state)
@@ -1051,6 +1210,110 @@ void test_wdb_parse_global_update_agent_keepalive_success(void **state)
     assert_int_equal(ret, OS_SUCCESS);
 }
 
+/* Tests wdb_parse_global_update_agents_keepalive */
+
+void test_wdb_parse_global_update_agents_keepalive_invalid_data(void **state)
+{
+    int ret = 0;
+    test_struct_t *data  = (test_struct_t *)*state;
+    char query[OS_BUFFER_SIZE] = "global update-agents-keepalive {\"connection_status\":\"active\",\"sync_status\":\"syncreq\",\"agents\":[1,\"2\"]}";
+
+    will_return(__wrap_wdb_open_global, data->wdb);
+    expect_string(__wrap__mdebug2, formatted_msg, "Global query: update-agents-keepalive {\"connection_status\":\"active\",\"sync_status\":\"syncreq\",\"agents\":[1,\"2\"]}");
+    expect_string(__wrap__mdebug1, formatted_msg, "Global DB Invalid JSON data when updating agents keepalive.");
+
+    expect_function_call(__wrap_w_inc_queries_total);
+    expect_function_call(__wrap_w_inc_global);
+    will_return(__wrap_gettimeofday, NULL);
+    will_return(__wrap_gettimeofday, NULL);
+    expect_function_call(__wrap_w_inc_global_open_time);
+    expect_function_call(__wrap_w_inc_global_agent_update_keepalive);
+    will_return(__wrap_gettimeofday, NULL);
+    will_return(__wrap_gettimeofday, NULL);
+    expect_function_call(__wrap_w_inc_global_agent_update_keepalive_time);
+
+    expect_string(__wrap_w_is_file, file, "queue/db/global.db");
+    will_return(__wrap_w_is_file, 1);
+    expect_function_call(__wrap_wdb_pool_leave);
+
+    ret = wdb_parse(query, data->output, 0);
+
+    assert_string_equal(data->output, "err Invalid JSON data, near '{\"connection_status\":\"active\",\"s'");
+    assert_int_equal(ret, OS_INVALID);
+}
+
+void test_wdb_parse_global_update_agents_keepalive_query_error(void **state)
+{
+    int ret = 0;
+    test_struct_t *data  = (test_struct_t *)*state;
+    char query[OS_BUFFER_SIZE] = "global update-agents-keepalive {\"connection_status\":\"active\",\"sync_status\":\"syncreq\",\"agents\":[1,2]}";
+
+    will_return(__wrap_wdb_open_global, data->wdb);
+    expect_value(__wrap_wdb_global_update_agents_keepalive, count, 2);
+    expect_value(__wrap_wdb_global_update_agents_keepalive, id, 1);
+    expect_value(__wrap_wdb_global_update_agents_keepalive, id, 2);
+    expect_string(__wrap_wdb_global_update_agents_keepalive, connection_status, "active");
+    expect_string(__wrap_wdb_global_update_agents_keepalive, sync_status, "syncreq");
+    will_return(__wrap_wdb_global_update_agents_keepalive, OS_INVALID);
+
+    expect_string(__wrap__mdebug2, formatted_msg, "Global query: update-agents-keepalive {\"connection_status\":\"active\",\"sync_status\":\"syncreq\",\"agents\":[1,2]}");
+    will_return_count(__wrap_sqlite3_errmsg, "ERROR MESSAGE", -1);
+    expect_string(__wrap__mdebug1, formatted_msg, "Global DB Cannot execute SQL query; err database queue/db/global.db: ERROR MESSAGE");
+
+    expect_function_call(__wrap_w_inc_queries_total);
+    expect_function_call(__wrap_w_inc_global);
+    will_return(__wrap_gettimeofday, NULL);
+    will_return(__wrap_gettimeofday, NULL);
+    expect_function_call(__wrap_w_inc_global_open_time);
+    expect_function_call(__wrap_w_inc_global_agent_update_keepalive);
+    will_return(__wrap_gettimeofday, NULL);
+    will_return(__wrap_gettimeofday, NULL);
+    expect_function_call(__wrap_w_inc_global_agent_update_keepalive_time);
+
+    expect_string(__wrap_w_is_file, file, "queue/db/global.db");
+    will_return(__wrap_w_is_file, 1);
+    expect_function_call(__wrap_wdb_pool_leave);
+
+    ret = wdb_parse(query, data->output, 0);
+
+    assert_string_equal(data->output, "err Cannot execute Global database query; ERROR MESSAGE");
+    assert_int_equal(ret, OS_INVALID);
+}
+
+void test_wdb_parse_global_update_agents_keepalive_success(void **state)
+{
+    int ret = 0;
+    test_struct_t *data  = (test_struct_t *)*state;
+    char query[OS_BUFFER_SIZE] = "global update-agents-keepalive {\"connection_status\":\"active\",\"sync_status\":\"syncreq\",\"agents\":[1,2]}";
+
+    will_return(__wrap_wdb_open_global, data->wdb);
+    expect_value(__wrap_wdb_global_update_agents_keepalive, count, 2);
+    expect_value(__wrap_wdb_global_update_agents_keepalive, id, 1);
+    expect_value(__wrap_wdb_global_update_agents_keepalive, id, 2);
+    expect_string(__wrap_wdb_global_update_agents_keepalive, connection_status, "active");
+    expect_string(__wrap_wdb_global_update_agents_keepalive, sync_status, "syncreq");
+    will_return(__wrap_wdb_global_update_agents_keepalive, OS_SUCCESS);
+
+    expect_string(__wrap__mdebug2, formatted_msg, "Global query: update-agents-keepalive {\"connection_status\":\"active\",\"sync_status\":\"syncreq\",\"agents\":[1,2]}");
+
+    expect_function_call(__wrap_w_inc_queries_total);
+    expect_function_call(__wrap_w_inc_global);
+    will_return(__wrap_gettimeofday, NULL);
+    will_return(__wrap_gettimeofday, NULL);
+    expect_function_call(__wrap_w_inc_global_open_time);
+    expect_function_call(__wrap_w_inc_global_agent_update_keepalive);
+    will_return(__wrap_gettimeofday, NULL);
+    will_return(__wrap_gettimeofday, NULL);
+    expect_function_call(__wrap_w_inc_global_agent_update_keepalive_time);
+
+    expect_function_call(__wrap_wdb_pool_leave);
+
+    ret = wdb_parse(query, data->output, 0);
+
+    assert_string_equal(data->output, "ok");
+    assert_int_equal(ret, OS_SUCCESS);
+}
+
 /* Tests wdb_parse_global_update_connection_status */
 
 void test_wdb_parse_global_update_connection_status_syntax_error(void **state)
@@ -5176,6 +5439,11 @@ int main()
         cmocka_unit_test_setup_teardown(test_wdb_parse_global_insert_agent_compliant_error, test_setup, test_teardown),
         cmocka_unit_test_setup_teardown(test_wdb_parse_global_insert_agent_query_error, test_setup, test_teardown),
         cmocka_unit_test_setup_teardown(test_wdb_parse_global_insert_agent_success, test_setup, test_teardown),
+        /* Tests wdb_parse_global_insert_agents */
+        cmocka_unit_test_setup_teardown(test_wdb_parse_global_insert_agents_syntax_error, test_setup, test_teardown),
+        cmocka_unit_test_setup_teardown(test_wdb_parse_global_insert_agents_not_array, test_setup, test_teardown),
+        cmocka_unit_test_setup_teardown(test_wdb_parse_global_insert_agents_partial_error, test_setup, test_teardown),
+        cmocka_unit_test_setup_teardown(test_wdb_parse_global_insert_agents_success, test_setup, test_teardown),
         /* Tests wdb_parse_global_update_agent_name */
         cmocka_unit_test_setup_teardown(test_wdb_parse_global_update_agent_name_syntax_error, test_setup, test_teardown),
         cmocka_unit_test_setup_teardown(test_wdb_parse_global_update_agent_name_invalid_json, test_setup, test_teardown),
@@ -5198,6 +5466,10 @@ int main()
         cmocka_unit_test_setup_teardown(test_wdb_parse_global_update_agent_keepalive_invalid_data, test_setup, test_teardown),
         cmocka_unit_test_setup_teardown(test_wdb_parse_global_update_agent_keepalive_query_error, test_setup, test_teardown),
         cmocka_unit_test_setup_teardown(test_wdb_parse_global_update_agent_keepalive_success, test_setup, test_teardown),
+        /* Tests wdb_parse_global_update_agents_keepalive */
+        cmocka_unit_test_setup_teardown(test_wdb_parse_global_update_agents_keepalive_invalid_data, test_setup, test_teardown),
+        cmocka_unit_test_setup_teardown(test_wdb_parse_global_update_agents_keepalive_query_error, test_setup, test_teardown),
+        cmocka_unit_test_setup_teardown(test_wdb_parse_global_update_agents_keepalive_success, test_setup, test_teardown),
         /* Tests wdb_parse_global_update_connection_status */
         cmocka_unit_test_setup_teardown(test_wdb_parse_global_update_connection_status_syntax_error, test_setup, test_teardown),
         cmocka_unit_test_setup_teardown(test_wdb_parse_global_update_connection_status_invalid_json, test_setup, test_teardown),
@@ -98,6 +98,32 @@ static int setup_test_clean_3(void **state) {
     return 0;
 }
 
+static int setup_test_idle(void **state) {
+    // node1 is closed, node2 is in use and node3 was used before node4
+    const time_t last[] = { 0, 300, 200, 100 };
+
+    wdb_pool_init();
+
+    for(int i = 1; i<5; i++) {
+        char node_name[10];
+        snprintf(node_name, 10, "node%d", i);
+        wdb_t * node = wdb_init(node_name);
+        if(i != 1) {
+            node->db = (sqlite3 *)1;
+        }
+        if(i == 2) {
+            node->refcount++;
+        }
+        node->last = last[i - 1];
+        rbtree_insert(wdb_pool.nodes, node_name, node);
+        wdb_pool.size++;
+    }
+
+    test_mode = 1;
+
+    return 0;
+}
+
 static int teardown_test(void **state) {
     char ** keys = rbtree_keys(wdb_pool.nodes);
 
@@ -218,6 +244,40 @@ static void test_wdb_pool_keys(void **state) {
     free_strarray(keys);
 }
 
+static void test_wdb_pool_idle_keys(void **state) {
+    unsigned open;
+
+    // lock pool mutex
+    expect_function_call(__wrap_pthread_mutex_lock);
+
+    // unlock pool mutex
+    expect_function_call(__wrap_pthread_mutex_unlock);
+
+    char **keys = wdb_pool_idle_keys(&open);
+
+    assert_int_equal(open, 3);
+    assert_string_equal(keys[0], "node4");
+    assert_string_equal(keys[1], "node3");
+    assert_null(keys[2]);
+    free_strarray(keys);
+}
+
+static void test_wdb_pool_idle_keys_empty(void **state) {
+    unsigned open;
+
+    // lock pool mutex
+    expect_function_call(__wrap_pthread_mutex_lock);
+
+    // unlock pool mutex
+    expect_function_call(__wrap_pthread_mutex_unlock);
+
+    char **keys = wdb_pool_idle_keys(&open);
+
+    assert_int_equal(open, 0);
+    assert_null(keys[0]);
+    free_strarray(keys);
+}
+
 static void test_wdb_pool_clean_all(void **state) {
     // lock pool mutex
     expect_function_call(__wrap_pthread_mutex_lock);
@@ -304,6 +364,9 @@ int main(void) {
         cmocka_unit_test_setup_teardown(test_wdb_pool_leave_node_no_null, setup_test, teardown_test),
         // Test wdb_pool_keys
         cmocka_unit_test_setup_teardown(test_wdb_pool_keys, setup_test, teardown_test),
+        // Test wdb_pool_idle_keys
+        cmocka_unit_test_setup_teardown(test_wdb_pool_idle_keys, setup_test_idle, teardown_test),
+        cmocka_unit_test_setup_teardown(test_wdb_pool_idle_keys_empty, setup_test, teardown_test),
         // Test wdb_pool_clean
         cmocka_unit_test_setup_teardown(test_wdb_pool_clean_all, setup_test, teardown_test),
         cmocka_unit_test_setup_teardown(test_wdb_pool_clean_1, setup_test_clean_1, teardown_test),
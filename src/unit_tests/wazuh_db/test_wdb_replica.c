@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2015, Wazuh Inc.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "../wazuh_db/wdb_replica.h"
+#include "../wazuh_db/wdb.h"
+#include "../headers/shared.h"
+
+extern wdb_t ** wdb_replica_nodes;
+extern unsigned wdb_replica_size;
+
+/* setup/teardowns */
+
+static int setup_replica(void **state) {
+    wdb_replica_init(2);
+
+    // Pretend the connections are open
+    for (unsigned i = 0; i < wdb_replica_size; i++) {
+        wdb_replica_nodes[i]->db = (sqlite3 *)1;
+    }
+
+    return 0;
+}
+
+static int teardown_replica(void **state) {
+    for (unsigned i = 0; i < wdb_replica_size; i++) {
+        wdb_replica_nodes[i]->db = NULL;
+        wdb_destroy(wdb_replica_nodes[i]);
+    }
+
+    os_free(wdb_replica_nodes);
+    wdb_replica_size = 0;
+
+    return 0;
+}
+
+/* Tests wdb_replica_command */
+
+static void test_wdb_replica_command_read(void **state) {
+    assert_true(wdb_replica_command("get-all-agents last_id 0"));
+    assert_true(wdb_replica_command("get-agent-info 1"));
+    assert_true(wdb_replica_command("select-groups"));
+}
+
+static void test_wdb_replica_command_write(void **state) {
+    assert_false(wdb_replica_command("insert-agent {\"id\":1}"));
+    assert_false(wdb_replica_command("sql SELECT 1"));
+    // These commands update the sync status of the agents they return
+    assert_false(wdb_replica_command("sync-agent-info-get last_id 0"));
+    assert_false(wdb_replica_command("sync-agent-groups-get {}"));
+}
+
+static void test_wdb_replica_command_prefix(void **state) {
+    assert_false(wdb_replica_command("get-all-agents-now"));
+    assert_false(wdb_replica_command("get-all"));
+    assert_false(wdb_replica_command(""));
+}
+
+/* Tests wdb_replica_get */
+
+static void test_wdb_replica_get_disabled(void **state) {
+    assert_false(wdb_replica_enabled());
+    assert_null(wdb_replica_get());
+}
+
+static void test_wdb_replica_get_free(void **state) {
+    wdb_t * first = wdb_replica_get();
+    wdb_t * second = wdb_replica_get();
+
+    // The second caller doesn't wait for the first one
+    assert_non_null(first);
+    assert_non_null(second);
+    assert_ptr_not_equal(first, second);
+
+    wdb_replica_leave(first);
+    wdb_replica_leave(second);
+}
+
+static void test_wdb_replica_leave_null(void **state) {
+    wdb_replica_leave(NULL);
+}
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        // Test wdb_replica_command
+        cmocka_unit_test(test_wdb_replica_command_read),
+        cmocka_unit_test(test_wdb_replica_command_write),
+        cmocka_unit_test(test_wdb_replica_command_prefix),
+        // Test wdb_replica_get
+        cmocka_unit_test(test_wdb_replica_get_disabled),
+        cmocka_unit_test_setup_teardown(test_wdb_replica_get_free, setup_replica, teardown_replica),
+        // Test wdb_replica_leave
+        cmocka_unit_test(test_wdb_replica_leave_null),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -3760,6 +3760,55 @@ void test_wdb_syscollector_save2_osinfo_success(void ** state) {
     assert_int_equal(output, 0);
 }
 
+/* Test wdb_syscollector_save_batch */
+void test_wdb_syscollector_save_batch_not_array(void **state) {
+    int output = 0;
+    wdb_t *data = (wdb_t *)*state;
+
+    will_return(__wrap_cJSON_Parse, NULL);
+    expect_string(__wrap__mdebug1, formatted_msg, "at wdb_syscollector_save_batch(): invalid batch");
+    expect_function_call(__wrap_cJSON_Delete);
+
+    output = wdb_syscollector_save_batch(data, WDB_SYSCOLLECTOR_PROCESSES, NULL);
+    assert_int_equal(output, -1);
+}
+
+void test_wdb_syscollector_save_batch_begin_fail(void **state) {
+    int output = 0;
+    wdb_t *data = (wdb_t *)*state;
+    cJSON batch = { .type = cJSON_Array };
+
+    will_return(__wrap_cJSON_Parse, &batch);
+
+    data->transaction = 0;
+    will_return(__wrap_wdb_begin2, -1);
+    expect_string(__wrap__mdebug1, formatted_msg, "at wdb_syscollector_save_batch(): cannot begin transaction");
+    expect_function_call(__wrap_cJSON_Delete);
+
+    output = wdb_syscollector_save_batch(data, WDB_SYSCOLLECTOR_PROCESSES, NULL);
+    assert_int_equal(output, -1);
+}
+
+void test_wdb_syscollector_save_batch_fail_entry(void **state) {
+    int output = 0;
+    wdb_t *data = (wdb_t *)*state;
+    cJSON second = {0};
+    cJSON first = { .next = &second };
+    cJSON batch = { .type = cJSON_Array, .child = &first };
+
+    will_return(__wrap_cJSON_Parse, &batch);
+
+    // The rest of the batch is stored after an invalid entry
+    data->transaction = 1;
+    will_return(__wrap_cJSON_GetObjectItem, NULL);
+    expect_string(__wrap__mdebug1, formatted_msg, "at wdb_syscollector_save_batch(): no attributes");
+    will_return(__wrap_cJSON_GetObjectItem, 1);
+    expect_function_call(__wrap_cJSON_Delete);
+
+    output = wdb_syscollector_save_batch(data, 0, NULL);
+    assert_int_equal(output, -1);
+}
+
 /* test objects */
 
 // sys_netinfo
@@ -5193,6 +5242,10 @@ int main() {
         cmocka_unit_test_setup_teardown(test_wdb_syscollector_save2_hwinfo_success, test_setup, test_teardown),
         cmocka_unit_test_setup_teardown(test_wdb_syscollector_save2_osinfo_fail, test_setup, test_teardown),
         cmocka_unit_test_setup_teardown(test_wdb_syscollector_save2_osinfo_success, test_setup, test_teardown),
+        // Test wdb_syscollector_save_batch
+        cmocka_unit_test_setup_teardown(test_wdb_syscollector_save_batch_not_array, test_setup, test_teardown),
+        cmocka_unit_test_setup_teardown(test_wdb_syscollector_save_batch_begin_fail, test_setup, test_teardown),
+        cmocka_unit_test_setup_teardown(test_wdb_syscollector_save_batch_fail_entry, test_setup, test_teardown),
         // Test wdb_netinfo_save
         cmocka_unit_test_setup_teardown(test_wdb_netinfo_save_transaction_fail, setup_wdb, teardown_wdb),
         cmocka_unit_test_setup_teardown(test_wdb_netinfo_save_success, setup_wdb, teardown_wdb),
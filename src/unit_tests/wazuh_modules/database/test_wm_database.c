@@ -526,6 +526,150 @@ void test_sync_keys_with_wdb_null(void **state) {
     sync_keys_with_wdb(&keys);
 }
 
+/* Tests sync_keys_delta_with_wdb */
+
+void test_sync_keys_delta_with_wdb_insert(void **state) {
+    keystore keys = *((keystore *)*state);
+    keys.keysize = 1;
+
+    rb_tree *synced = rbtree_init();
+    rbtree_set_dispose(synced, free);
+
+    char *test_ip = "1.1.1.1";
+
+    char **ids = NULL;
+    ids = os_AddStrArray("001", ids);
+
+    expect_value(__wrap_rbtree_get, tree, synced);
+    expect_string(__wrap_rbtree_get, key, keys.keyentries[0]->id);
+    will_return(__wrap_rbtree_get, NULL);
+
+    expect_string(__wrap__mtdebug2, tag, "wazuh-modulesd:database");
+    expect_string(__wrap__mtdebug2, formatted_msg, "Synchronizing agent 001 'agent1'.");
+
+    expect_any(__wrap_OS_CIDRtoStr, ip);
+    expect_value(__wrap_OS_CIDRtoStr, size, IPSIZE);
+    will_return(__wrap_OS_CIDRtoStr, test_ip);
+    will_return(__wrap_OS_CIDRtoStr, 0);
+
+    expect_value(__wrap_wdb_insert_agent, id, 1);
+    expect_string(__wrap_wdb_insert_agent, name, keys.keyentries[0]->name);
+    expect_string(__wrap_wdb_insert_agent, register_ip, test_ip);
+    expect_string(__wrap_wdb_insert_agent, internal_key, keys.keyentries[0]->raw_key);
+    expect_value(__wrap_wdb_insert_agent, keep_date, 1);
+    will_return(__wrap_wdb_insert_agent, 0);
+
+    will_return(__wrap_rbtree_keys, ids);
+
+    expect_string(__wrap_OS_IsAllowedID, id, keys.keyentries[0]->id);
+    will_return(__wrap_OS_IsAllowedID, 0);
+
+    assert_int_equal(sync_keys_delta_with_wdb(&keys, synced), OS_SUCCESS);
+    assert_string_equal(rbtree_minimum(synced), "001");
+
+    rbtree_destroy(synced);
+}
+
+void test_sync_keys_delta_with_wdb_insert_error(void **state) {
+    keystore keys = *((keystore *)*state);
+    keys.keysize = 1;
+
+    rb_tree *synced = rbtree_init();
+
+    char *test_ip = "1.1.1.1";
+
+    char **ids = NULL;
+    os_calloc(1, sizeof(char *), ids);
+
+    expect_value(__wrap_rbtree_get, tree, synced);
+    expect_string(__wrap_rbtree_get, key, keys.keyentries[0]->id);
+    will_return(__wrap_rbtree_get, NULL);
+
+    expect_string(__wrap__mtdebug2, tag, "wazuh-modulesd:database");
+    expect_string(__wrap__mtdebug2, formatted_msg, "Synchronizing agent 001 'agent1'.");
+
+    expect_any(__wrap_OS_CIDRtoStr, ip);
+    expect_value(__wrap_OS_CIDRtoStr, size, IPSIZE);
+    will_return(__wrap_OS_CIDRtoStr, test_ip);
+    will_return(__wrap_OS_CIDRtoStr, 0);
+
+    expect_value(__wrap_wdb_insert_agent, id, 1);
+    expect_string(__wrap_wdb_insert_agent, name, keys.keyentries[0]->name);
+    expect_string(__wrap_wdb_insert_agent, register_ip, test_ip);
+    expect_string(__wrap_wdb_insert_agent, internal_key, keys.keyentries[0]->raw_key);
+    expect_value(__wrap_wdb_insert_agent, keep_date, 1);
+    will_return(__wrap_wdb_insert_agent, 1);
+
+    expect_string(__wrap__mtdebug1, tag, "wazuh-modulesd:database");
+    expect_string(__wrap__mtdebug1, formatted_msg, "Couldn't insert agent '001' in the database.");
+
+    will_return(__wrap_rbtree_keys, ids);
+
+    // The agent is not marked as synchronized, so it's retried the next time
+    assert_int_equal(sync_keys_delta_with_wdb(&keys, synced), OS_INVALID);
+    assert_null(rbtree_minimum(synced));
+
+    rbtree_destroy(synced);
+}
+
+void test_sync_keys_delta_with_wdb_delete(void **state) {
+    keystore keys = *((keystore *)*state);
+    keys.keysize = 1;
+
+    rb_tree *synced = rbtree_init();
+    rbtree_set_dispose(synced, free);
+    rbtree_insert(synced, "001", strdup("agent1"));
+    rbtree_insert(synced, "002", strdup("agent2"));
+
+    char **ids = NULL;
+    ids = os_AddStrArray("001", ids);
+    ids = os_AddStrArray("002", ids);
+
+    char *test_name = strdup("agent2");
+
+    expect_value(__wrap_rbtree_get, tree, synced);
+    expect_string(__wrap_rbtree_get, key, keys.keyentries[0]->id);
+    will_return(__wrap_rbtree_get, "agent1");
+
+    will_return(__wrap_rbtree_keys, ids);
+
+    expect_string(__wrap_OS_IsAllowedID, id, "001");
+    will_return(__wrap_OS_IsAllowedID, 0);
+
+    expect_string(__wrap_OS_IsAllowedID, id, "002");
+    will_return(__wrap_OS_IsAllowedID, -1);
+
+    expect_value(__wrap_wdb_get_agent_name, id, 2);
+    will_return(__wrap_wdb_get_agent_name, test_name);
+
+    expect_value(__wrap_wdb_remove_agent, id, 2);
+    will_return(__wrap_wdb_remove_agent, 0);
+
+    expect_value(__wrap_wdbc_query_ex, *sock, -1);
+    expect_string(__wrap_wdbc_query_ex, query, "wazuhdb remove 2");
+    expect_value(__wrap_wdbc_query_ex, len, OS_SIZE_1024);
+    will_return(__wrap_wdbc_query_ex, "ok");
+    will_return(__wrap_wdbc_query_ex, -1);
+
+    expect_string(__wrap__mtdebug1, tag, "wazuh-modulesd:database");
+    expect_string(__wrap__mtdebug1, formatted_msg, "Could not remove the wazuh-db DB of the agent 2.");
+
+    expect_string(__wrap_rmdir_ex, name, "queue/diff/agent2");
+    will_return(__wrap_rmdir_ex, 0);
+
+    expect_string(__wrap_unlink, file, "queue/rids/002");
+    will_return(__wrap_unlink, 0);
+
+    expect_string(__wrap_wfopen, path, "queue/agents-timestamp");
+    expect_string(__wrap_wfopen, mode, "r");
+    will_return(__wrap_wfopen, NULL);
+
+    assert_int_equal(sync_keys_delta_with_wdb(&keys, synced), OS_SUCCESS);
+    assert_string_equal(rbtree_maximum(synced), "001");
+
+    rbtree_destroy(synced);
+}
+
 int main()
 {
     const struct CMUnitTest tests[] = {
@@ -545,6 +689,10 @@ int main()
         cmocka_unit_test_setup_teardown(test_sync_keys_with_wdb_delete, setup_keys_to_db, teardown_keys_to_db),
         cmocka_unit_test_setup_teardown(test_sync_keys_with_wdb_insert_delete, setup_keys_to_db, teardown_keys_to_db),
         cmocka_unit_test_setup_teardown(test_sync_keys_with_wdb_null, setup_keys_to_db, teardown_keys_to_db),
+        // sync_keys_delta_with_wdb
+        cmocka_unit_test_setup_teardown(test_sync_keys_delta_with_wdb_insert, setup_keys_to_db, teardown_keys_to_db),
+        cmocka_unit_test_setup_teardown(test_sync_keys_delta_with_wdb_insert_error, setup_keys_to_db, teardown_keys_to_db),
+        cmocka_unit_test_setup_teardown(test_sync_keys_delta_with_wdb_delete, setup_keys_to_db, teardown_keys_to_db),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
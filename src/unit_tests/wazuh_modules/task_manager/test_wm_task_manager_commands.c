@@ -598,6 +598,61 @@ void test_wm_task_manager_command_upgrade_update_status_ok(void **state)
     assert_int_equal(error_code, 0);
 }
 
+void test_wm_task_manager_command_upgrade_update_status_batch_ok(void **state)
+{
+    char *node = "node02";
+    int error_code = 0;
+    int agent_id1 = 35;
+    int agent_id2 = 36;
+    char *status = "In progress";
+
+    char *wdb_response = "ok {\"error\":0,\"agents\":[{\"agent\":35,\"error\":0},{\"agent\":36,\"error\":-2}]}";
+
+    wm_task_manager_upgrade_update_status *task_parameters = wm_task_manager_init_upgrade_update_status_parameters();
+    int *agents = NULL;
+
+    os_calloc(3, sizeof(int), agents);
+    agents[0] = agent_id1;
+    agents[1] = agent_id2;
+    agents[2] = OS_INVALID;
+
+    os_strdup(node, task_parameters->node);
+    task_parameters->agent_ids = agents;
+    os_strdup(status, task_parameters->status);
+
+    cJSON* res1 = cJSON_CreateObject();
+    cJSON* res2 = cJSON_CreateObject();
+
+    // Both agents are updated with a single query
+    expect_value(__wrap_wdbc_query_ex, *sock, -1);
+    expect_string(__wrap_wdbc_query_ex, query, "task upgrade_update_status {\"agents\":[35,36],\"node\":\"node02\",\"status\":\"In progress\"}");
+    expect_value(__wrap_wdbc_query_ex, len, OS_MAXSTR);
+    will_return(__wrap_wdbc_query_ex, wdb_response);
+    will_return(__wrap_wdbc_query_ex, 0);
+
+    expect_string(__wrap_wdbc_parse_result, result, wdb_response);
+    will_return(__wrap_wdbc_parse_result, WDBC_OK);
+
+    expect_value(__wrap_wm_task_manager_parse_data_response, error_code, WM_TASK_SUCCESS);
+    expect_value(__wrap_wm_task_manager_parse_data_response, agent_id, agent_id1);
+    expect_value(__wrap_wm_task_manager_parse_data_response, task_id, OS_INVALID);
+    will_return(__wrap_wm_task_manager_parse_data_response, res1);
+
+    expect_value(__wrap_wm_task_manager_parse_data_response, error_code, WM_TASK_DATABASE_NO_TASK);
+    expect_value(__wrap_wm_task_manager_parse_data_response, agent_id, agent_id2);
+    expect_value(__wrap_wm_task_manager_parse_data_response, task_id, OS_INVALID);
+    will_return(__wrap_wm_task_manager_parse_data_response, res2);
+
+    cJSON *response = wm_task_manager_command_upgrade_update_status(task_parameters, &error_code);
+
+    state[0] = response;
+    state[1] = task_parameters;
+
+    assert_non_null(response);
+    assert_int_equal(cJSON_GetArraySize(response), 2);
+    assert_int_equal(error_code, 0);
+}
+
 void test_wm_task_manager_command_upgrade_update_status_task_err(void **state)
 {
     char *node = "node02";
@@ -1458,6 +1513,7 @@ int main(void) {
         cmocka_unit_test_teardown(test_wm_task_manager_command_upgrade_get_status_db_response_null, teardown_json_upgrade_get_status_task),
         // wm_task_manager_command_upgrade_update_status
         cmocka_unit_test_teardown(test_wm_task_manager_command_upgrade_update_status_ok, teardown_json_upgrade_update_status_task),
+        cmocka_unit_test_teardown(test_wm_task_manager_command_upgrade_update_status_batch_ok, teardown_json_upgrade_update_status_task),
         cmocka_unit_test_teardown(test_wm_task_manager_command_upgrade_update_status_task_err, teardown_json_upgrade_update_status_task),
         cmocka_unit_test_teardown(test_wm_task_manager_command_upgrade_update_status_db_err, teardown_json_upgrade_update_status_task),
         cmocka_unit_test_teardown(test_wm_task_manager_command_upgrade_update_status_db_response_null, teardown_json_upgrade_update_status_task),
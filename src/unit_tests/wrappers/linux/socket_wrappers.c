@@ -7,6 +7,11 @@
  * Foundation
  */
 
+// struct mmsghdr is a GNU extension
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
 #include "socket_wrappers.h"
 #include <stddef.h>
 #include <stdarg.h>
@@ -102,6 +107,16 @@ ssize_t __wrap_recvfrom(__attribute__((unused))int __fd, __attribute__((unused))
     return mock();
 }
 
+int __wrap_recvmmsg(__attribute__((unused))int __fd, struct mmsghdr *__vmessages, __attribute__((unused))unsigned int __vlen, __attribute__((unused))int __flags, __attribute__((unused))struct timespec *__tmo) {
+    int count = mock();
+
+    for (int i = 0; i < count; i++) {
+        __vmessages[i].msg_len = mock();
+    }
+
+    return count;
+}
+
 extern int __real_fcntl(__attribute__((unused))int __fd, __attribute__((unused))int __cmd, __attribute__((unused))unsigned long);
 int __wrap_fcntl(int __fd, int __cmd, ...) {
 
@@ -37,6 +37,14 @@ ssize_t __wrap_recv(__attribute__((unused))int __fd, __attribute__((unused))void
 
 ssize_t __wrap_recvfrom(__attribute__((unused))int __fd, __attribute__((unused))void *__restrict __buf, __attribute__((unused))size_t __n, __attribute__((unused))int __flags, __attribute__((unused))__SOCKADDR_ARG __addr, __attribute__((unused))socklen_t *__restrict __addr_len);
 
+struct mmsghdr;
+struct timespec;
+
+/**
+ * @brief Returns the number of messages received, followed by the length of each message
+ */
+int __wrap_recvmmsg(__attribute__((unused))int __fd, struct mmsghdr *__vmessages, __attribute__((unused))unsigned int __vlen, __attribute__((unused))int __flags, __attribute__((unused))struct timespec *__tmo);
+
 int __wrap_fcntl(__attribute__((unused))int __fd, __attribute__((unused))int __cmd, ...);
 
 int __wrap_getaddrinfo(const char *node, __attribute__((unused))const char *service, __attribute__((unused))const struct addrinfo *hints, struct addrinfo **res);
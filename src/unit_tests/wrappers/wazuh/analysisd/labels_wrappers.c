@@ -0,0 +1,21 @@
+/* Copyright (C) 2015, Wazuh Inc.
+ * All rights reserved.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation
+ */
+
+
+#include <stddef.h>
+#include <stdarg.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include "labels_wrappers.h"
+
+int __wrap_labels_cache_set(const char *agent_id, cJSON *labels_json) {
+    check_expected(agent_id);
+    check_expected_ptr(labels_json);
+    return mock();
+}
@@ -0,0 +1,17 @@
+/*
+ * Copyright (C) 2015, Wazuh Inc.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef ASYS_LABELS_WRAPPERS_H
+#define ASYS_LABELS_WRAPPERS_H
+
+#include <cJSON.h>
+
+int __wrap_labels_cache_set(const char *agent_id, cJSON *labels_json);
+
+#endif /* ASYS_LABELS_WRAPPERS_H */
@@ -43,7 +43,7 @@ void __wrap_add_insert(__attribute__((unused)) const keyentry *entry, __attribut
     // Empty wrapper
 }
 
-void __wrap_add_remove(__attribute__((unused)) const keyentry *entry) {
+void __wrap_add_remove(__attribute__((unused)) const keyentry *entry, __attribute__((unused)) int purge) {
     // Empty wrapper
 }
 
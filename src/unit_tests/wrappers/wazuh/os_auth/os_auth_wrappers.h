@@ -25,7 +25,7 @@ w_err_t __wrap_w_auth_validate_data(char *response, const char *ip, const char *
 
 void __wrap_add_insert(const keyentry *entry,const char *group);
 
-void __wrap_add_remove(const keyentry *entry);
+void __wrap_add_remove(const keyentry *entry, int purge);
 
 cJSON* __wrap_local_add(const char *id,
                         const char *name,
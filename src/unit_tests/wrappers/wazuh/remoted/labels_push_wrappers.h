@@ -0,0 +1,15 @@
+/* Copyright (C) 2015, Wazuh Inc.
+ * All rights reserved.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation
+ */
+
+#ifndef LABELS_PUSH_WRAPPERS_H
+#define LABELS_PUSH_WRAPPERS_H
+
+int __wrap_rem_push_labels(const char * agent_id, const char * labels);
+
+#endif
@@ -33,3 +33,18 @@ int __wrap_rem_msgpush(__attribute__((unused)) const char * buffer, unsigned lon
 
     return mock();
 }
+
+size_t __wrap_rem_msgpush_batch(const rem_msgref_t * messages, size_t count, int sock) {
+    check_expected(sock);
+    check_expected(count);
+
+    for (size_t i = 0; i < count; i++) {
+        unsigned long size = messages[i].size;
+        struct sockaddr_storage * addr = messages[i].addr;
+
+        check_expected(size);
+        check_expected_ptr(addr);
+    }
+
+    return mock();
+}
@@ -13,10 +13,13 @@
 #define REM_QUEUE_WRAPPERS_H
 
 #include <stddef.h>
+#include "../../../../remoted/remoted.h"
 
 size_t __wrap_rem_get_qsize();
 size_t __wrap_rem_get_tsize();
 
 int __wrap_rem_msgpush(const char * buffer, unsigned long size, struct sockaddr_storage * addr, int sock);
 
+size_t __wrap_rem_msgpush_batch(const rem_msgref_t * messages, size_t count, int sock);
+
 #endif /* REM_QUEUE_WRAPPERS_H */
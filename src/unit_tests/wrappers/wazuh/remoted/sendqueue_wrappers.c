@@ -0,0 +1,45 @@
+/* Copyright (C) 2015, Wazuh Inc.
+ * All rights reserved.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation
+ */
+
+#include "sendqueue_wrappers.h"
+#include <stddef.h>
+#include <stdarg.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+int __wrap_nb_sendq_push(sendqueue_t * queue, const char * data, unsigned long length, unsigned long max_length) {
+    check_expected_ptr(queue);
+    check_expected(data);
+    check_expected(length);
+    check_expected(max_length);
+    return mock();
+}
+
+unsigned long __wrap_nb_sendq_peek(const sendqueue_t * queue, char * buffer, unsigned long length) {
+    check_expected_ptr(queue);
+    check_expected(length);
+    if (mock()) {
+        memcpy(buffer, mock_type(char *), length);
+    }
+    return mock();
+}
+
+void __wrap_nb_sendq_drop(sendqueue_t * queue, unsigned long length) {
+    check_expected_ptr(queue);
+    check_expected(length);
+}
+
+unsigned long __wrap_nb_sendq_used(const sendqueue_t * queue) {
+    check_expected_ptr(queue);
+    return mock();
+}
+
+void __wrap_nb_sendq_clear(sendqueue_t * queue) {
+    check_expected_ptr(queue);
+}
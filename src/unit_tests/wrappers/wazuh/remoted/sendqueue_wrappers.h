@@ -0,0 +1,25 @@
+/* Copyright (C) 2015, Wazuh Inc.
+ * All rights reserved.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation
+ */
+
+#ifndef SENDQUEUE_WRAPPERS_H
+#define SENDQUEUE_WRAPPERS_H
+
+#include "../../../../remoted/remoted.h"
+
+int __wrap_nb_sendq_push(sendqueue_t * queue, const char * data, unsigned long length, unsigned long max_length);
+
+unsigned long __wrap_nb_sendq_peek(const sendqueue_t * queue, char * buffer, unsigned long length);
+
+void __wrap_nb_sendq_drop(sendqueue_t * queue, unsigned long length);
+
+unsigned long __wrap_nb_sendq_used(const sendqueue_t * queue);
+
+void __wrap_nb_sendq_clear(sendqueue_t * queue);
+
+#endif
@@ -13,7 +13,7 @@
 #include <setjmp.h>
 #include <cmocka.h>
 
-wlabel_t* __wrap_labels_find(char* agent_id, __attribute__((unused)) int* sock) {
+wlabel_t* __wrap_labels_find(const char* agent_id) {
     check_expected(agent_id);
 
     return mock_type(wlabel_t*);
@@ -13,7 +13,7 @@
 
 #include "shared.h"
 
-wlabel_t* __wrap_labels_find(char* agent_id, int* sock);
+wlabel_t* __wrap_labels_find(const char* agent_id);
 
 char* __wrap_labels_get(const wlabel_t* labels, const char* key);
 
@@ -65,6 +65,17 @@ int __wrap_wdb_update_agent_keepalive(int id, const char *connection_status, con
     return mock();
 }
 
+int __wrap_wdb_update_agents_keepalive(const int *ids, size_t count, const char *connection_status, const char *sync_status, __attribute__((unused)) int *sock) {
+    check_expected(count);
+    for (size_t i = 0; i < count; i++) {
+        int id = ids[i];
+        check_expected(id);
+    }
+    check_expected(connection_status);
+    check_expected(sync_status);
+    return mock();
+}
+
 int __wrap_wdb_update_agent_data(agent_info_data *agent_data, __attribute__((unused)) int *sock) {
     check_expected(agent_data);
     return mock();
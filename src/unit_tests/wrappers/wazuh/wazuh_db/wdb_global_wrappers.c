@@ -116,6 +116,21 @@ int __wrap_wdb_global_update_agent_keepalive(__attribute__((unused)) wdb_t *wdb,
     return mock();
 }
 
+int __wrap_wdb_global_update_agents_keepalive(__attribute__((unused)) wdb_t *wdb,
+                                             const int *ids,
+                                             size_t count,
+                                             const char *connection_status,
+                                             const char *sync_status) {
+    check_expected(count);
+    for (size_t i = 0; i < count; i++) {
+        int id = ids[i];
+        check_expected(id);
+    }
+    check_expected(connection_status);
+    check_expected(sync_status);
+    return mock();
+}
+
 int __wrap_wdb_global_update_agent_connection_status(__attribute__((unused)) wdb_t *wdb,
                                                      int id,
                                                      char* connection_status,
@@ -46,6 +46,8 @@ int __wrap_wdb_global_set_agent_label(wdb_t *wdb, int id, char* key, char* value
 
 int __wrap_wdb_global_update_agent_keepalive(wdb_t *wdb, int id, char* connection_status, char* status);
 
+int __wrap_wdb_global_update_agents_keepalive(wdb_t *wdb, const int *ids, size_t count, const char *connection_status, const char *sync_status);
+
 int __wrap_wdb_global_update_agent_connection_status(wdb_t *wdb, int id, char* connection_status, char* sync_status, int status_code);
 
 int __wrap_wdb_global_update_agent_status_code(wdb_t *wdb, int id, int status_code, const char *version, const char *sync_status);
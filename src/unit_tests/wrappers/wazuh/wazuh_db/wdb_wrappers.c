@@ -96,6 +96,19 @@ int __wrap_wdb_syscheck_save2(__attribute__((unused)) wdb_t *wdb,
     return mock();
 }
 
+int __wrap_wdb_syscollector_save2(__attribute__((unused)) wdb_t *wdb, wdb_component_t component, const char *payload) {
+    check_expected(component);
+    check_expected(payload);
+    return mock();
+}
+
+int __wrap_wdb_dbsync_process(__attribute__((unused)) wdb_t *wdb, const char *table_key, const char *operation, const char *data) {
+    check_expected(table_key);
+    check_expected(operation);
+    check_expected(data);
+    return mock();
+}
+
 cJSON * __wrap_wdb_exec_stmt(__attribute__((unused)) sqlite3_stmt *stmt) {
     return mock_ptr_type(cJSON *);
 }
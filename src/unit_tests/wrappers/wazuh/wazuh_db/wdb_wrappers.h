@@ -45,6 +45,10 @@ int __wrap_wdb_syscheck_save(wdb_t *wdb, int ftype, char *checksum, const char *
 
 int __wrap_wdb_syscheck_save2(wdb_t *wdb, const char *payload);
 
+int __wrap_wdb_syscollector_save2(wdb_t *wdb, wdb_component_t component, const char *payload);
+
+int __wrap_wdb_dbsync_process(wdb_t *wdb, const char *table_key, const char *operation, const char *data);
+
 cJSON * __wrap_wdb_exec_stmt(sqlite3_stmt *stmt);
 
 cJSON * __wrap_wdb_exec_stmt_sized(sqlite3_stmt *stmt, size_t max_size, int* status, bool column_mode);
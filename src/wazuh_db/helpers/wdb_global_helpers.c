@@ -19,10 +19,12 @@
 
 static const char *global_db_commands[] = {
     [WDB_INSERT_AGENT] = "global insert-agent %s",
+    [WDB_INSERT_AGENTS] = "global insert-agents [",
     [WDB_INSERT_AGENT_GROUP] = "global insert-agent-group %s",
     [WDB_UPDATE_AGENT_NAME] = "global update-agent-name %s",
     [WDB_UPDATE_AGENT_DATA] = "global update-agent-data %s",
     [WDB_UPDATE_AGENT_KEEPALIVE] = "global update-keepalive %s",
+    [WDB_UPDATE_AGENTS_KEEPALIVE] = "global update-agents-keepalive %s",
     [WDB_UPDATE_AGENT_CONNECTION_STATUS] = "global update-connection-status %s",
     [WDB_UPDATE_AGENT_STATUS_CODE] = "global update-status-code %s",
     [WDB_GET_ALL_AGENTS] = "global get-all-agents last_id %d",
@@ -333,6 +335,73 @@ int wdb_update_agent_keepalive(int id, const char *connection_status, const char
     return result;
 }
 
+int wdb_update_agents_keepalive(const int *ids, size_t count, const char *connection_status, const char *sync_status, int *sock) {
+    int result = OS_SUCCESS;
+    cJSON *data_in = NULL;
+    cJSON *agents = NULL;
+    char *data_in_str = NULL;
+    char *wdbquery = NULL;
+    char *wdboutput = NULL;
+    char *payload = NULL;
+    int aux_sock = -1;
+    size_t i;
+    size_t j;
+
+    os_malloc(OS_MAXSTR, wdbquery);
+    os_malloc(WDBOUTPUT_SIZE, wdboutput);
+
+    // Every agent ID takes up to 11 characters, so the queries fit in OS_MAXSTR
+    for (i = 0; i < count && result == OS_SUCCESS; i += WDB_AGENTS_KEEPALIVE_CHUNK) {
+        if (data_in = cJSON_CreateObject(), !data_in) {
+            mdebug1("Error creating data JSON for Wazuh DB.");
+            result = OS_INVALID;
+            break;
+        }
+
+        cJSON_AddStringToObject(data_in, "connection_status", connection_status);
+        cJSON_AddStringToObject(data_in, "sync_status", sync_status);
+        agents = cJSON_AddArrayToObject(data_in, "agents");
+
+        for (j = i; j < count && j < i + WDB_AGENTS_KEEPALIVE_CHUNK; j++) {
+            cJSON_AddItemToArray(agents, cJSON_CreateNumber(ids[j]));
+        }
+
+        data_in_str = cJSON_PrintUnformatted(data_in);
+        snprintf(wdbquery, OS_MAXSTR, global_db_commands[WDB_UPDATE_AGENTS_KEEPALIVE], data_in_str);
+
+        result = wdbc_query_ex(sock?sock:&aux_sock, wdbquery, wdboutput, WDBOUTPUT_SIZE);
+
+        switch (result) {
+            case OS_SUCCESS:
+                if (WDBC_OK != wdbc_parse_result(wdboutput, &payload)) {
+                    mdebug1("Global DB Error reported in the result of the query");
+                    result = OS_INVALID;
+                }
+                break;
+            case OS_INVALID:
+                mdebug1("Global DB Error in the response from socket");
+                mdebug2("Global DB SQL query: %s", wdbquery);
+                break;
+            default:
+                mdebug1("Global DB Cannot execute SQL query; err database %s/%s.db", WDB2_DIR, WDB_GLOB_NAME);
+                mdebug2("Global DB SQL query: %s", wdbquery);
+                result = OS_INVALID;
+        }
+
+        cJSON_Delete(data_in);
+        os_free(data_in_str);
+    }
+
+    if (!sock) {
+        wdbc_close(&aux_sock);
+    }
+
+    os_free(wdbquery);
+    os_free(wdboutput);
+
+    return result;
+}
+
 int wdb_update_agent_connection_status(int id, const char *connection_status, const char *sync_status, int *sock, agent_status_code_t status_code) {
     int result = 0;
     cJSON *data_in = NULL;
@@ -914,6 +983,143 @@ int wdb_set_agent_groups(int id, char** groups_array, char* mode, char* sync_sta
     return result;
 }
 
+/**
+ * @brief Sends a query made of a head, the items of the buffer and a tail.
+ *
+ * @param[in,out] wdbquery Query with the head and the items, of OS_MAXSTR bytes.
+ * @param[in] length Length of the head and the items.
+ * @param[in] tail Tail of the query.
+ * @param[in] sock The Wazuh DB socket connection.
+ * @return OS_SUCCESS on success or OS_INVALID on failure.
+ */
+static int wdb_send_chunk(char *wdbquery, size_t length, const char *tail, int *sock) {
+    char wdboutput[WDBOUTPUT_SIZE] = "";
+    int result;
+
+    snprintf(wdbquery + length, OS_MAXSTR - length, "%s", tail);
+
+    result = wdbc_query_ex(sock, wdbquery, wdboutput, sizeof(wdboutput));
+
+    switch (result) {
+        case OS_SUCCESS:
+            if (WDBC_OK != wdbc_parse_result(wdboutput, NULL)) {
+                mdebug1("Global DB Error reported in the result of the query");
+                result = OS_INVALID;
+            }
+            break;
+        case OS_INVALID:
+            mdebug1("Global DB Error in the response from socket");
+            mdebug2("Global DB SQL query: %s", wdbquery);
+            break;
+        default:
+            mdebug1("Global DB Cannot execute SQL query; err database %s/%s.db", WDB2_DIR, WDB_GLOB_NAME);
+            mdebug2("Global DB SQL query: %s", wdbquery);
+            result = OS_INVALID;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Sends the items of an array as a JSON array, in as few queries as fit in OS_MAXSTR.
+ *        Every query is the head, the items separated by commas and the tail.
+ *
+ * @param[in] head Head of the queries, ending with the opening bracket of the array.
+ * @param[in] items Array of items.
+ * @param[in] tail Tail of the queries, starting with the closing bracket of the array.
+ * @param[in] sock The Wazuh DB socket connection. If NULL, a new connection will be created and closed locally.
+ * @return OS_SUCCESS on success or OS_INVALID if any item or query failed.
+ */
+static int wdb_send_array_chunked(const char *head, const cJSON *items, const char *tail, int *sock) {
+    int result = OS_SUCCESS;
+    char *wdbquery = NULL;
+    char *item_str = NULL;
+    const cJSON *item = NULL;
+    size_t head_len = strlen(head);
+    size_t tail_len = strlen(tail);
+    size_t length = head_len;
+    size_t item_len;
+    int pending = 0;
+    int aux_sock = -1;
+
+    if (head_len + tail_len >= OS_MAXSTR) {
+        return OS_INVALID;
+    }
+
+    os_malloc(OS_MAXSTR, wdbquery);
+    memcpy(wdbquery, head, head_len);
+
+    cJSON_ArrayForEach(item, items) {
+        if (item_str = cJSON_PrintUnformatted(item), !item_str) {
+            mdebug1("Error creating data JSON for Wazuh DB.");
+            result = OS_INVALID;
+            continue;
+        }
+
+        item_len = strlen(item_str);
+
+        if (head_len + item_len + tail_len >= OS_MAXSTR) {
+            mdebug1("Global DB Item too large for a single query");
+            mdebug2("Global DB item: %.256s", item_str);
+            os_free(item_str);
+            result = OS_INVALID;
+            continue;
+        }
+
+        // Send the items gathered so far if this one doesn't fit, including the comma
+        if (pending && length + 1 + item_len + tail_len >= OS_MAXSTR) {
+            if (OS_SUCCESS != wdb_send_chunk(wdbquery, length, tail, sock?sock:&aux_sock)) {
+                result = OS_INVALID;
+            }
+            length = head_len;
+            pending = 0;
+        }
+
+        if (pending) {
+            wdbquery[length++] = ',';
+        }
+
+        memcpy(wdbquery + length, item_str, item_len);
+        length += item_len;
+        pending++;
+        os_free(item_str);
+    }
+
+    if (pending && OS_SUCCESS != wdb_send_chunk(wdbquery, length, tail, sock?sock:&aux_sock)) {
+        result = OS_INVALID;
+    }
+
+    if (!sock) {
+        wdbc_close(&aux_sock);
+    }
+
+    os_free(wdbquery);
+
+    return result;
+}
+
+int wdb_insert_agents(const cJSON *agents, int *sock) {
+    return wdb_send_array_chunked(global_db_commands[WDB_INSERT_AGENTS], agents, "]", sock);
+}
+
+int wdb_set_agents_groups(const cJSON *agents, const char *mode, const char *sync_status, int *sock) {
+    char head[OS_SIZE_256];
+
+    if (!mode) {
+        mdebug1("Invalid params to set the agents groups");
+        return OS_INVALID;
+    }
+
+    // Same request as wdb_set_agent_groups(), with every agent in the data array
+    if (sync_status) {
+        snprintf(head, sizeof(head), "global set-agent-groups {\"mode\":\"%s\",\"sync_status\":\"%s\",\"data\":[", mode, sync_status);
+    } else {
+        snprintf(head, sizeof(head), "global set-agent-groups {\"mode\":\"%s\",\"data\":[", mode);
+    }
+
+    return wdb_send_array_chunked(head, agents, "]}", sock);
+}
+
 int wdb_reset_agents_connection(const char *sync_status, int *sock) {
     int result = OS_SUCCESS;
     char *wdbquery = NULL;
@@ -14,12 +14,17 @@
 
 #include "../wdb.h"
 
+/* Maximum number of agents sent in each query by wdb_update_agents_keepalive() */
+#define WDB_AGENTS_KEEPALIVE_CHUNK 4096
+
 typedef enum global_db_access {
     WDB_INSERT_AGENT,
+    WDB_INSERT_AGENTS,
     WDB_INSERT_AGENT_GROUP,
     WDB_UPDATE_AGENT_NAME,
     WDB_UPDATE_AGENT_DATA,
     WDB_UPDATE_AGENT_KEEPALIVE,
+    WDB_UPDATE_AGENTS_KEEPALIVE,
     WDB_UPDATE_AGENT_CONNECTION_STATUS,
     WDB_UPDATE_AGENT_STATUS_CODE,
     WDB_GET_ALL_AGENTS,
@@ -101,6 +106,19 @@ int wdb_update_agent_data(agent_info_data *agent_data, int *sock);
  */
 int wdb_update_agent_keepalive(int id, const char *connection_status, const char *sync_status, int *sock);
 
+/**
+ * @brief Update the last keepalive and the cluster synchronization status of several agents.
+ *        The agents are sent in as few queries as possible, each one applied in a single transaction.
+ *
+ * @param[in] ids Array with the IDs of the agents whose keepalive must be updated.
+ * @param[in] count Number of agents.
+ * @param[in] connection_status String with the connection status to be set.
+ * @param[in] sync_status String with the cluster synchronization status to be set.
+ * @param[in] sock The Wazuh DB socket connection. If NULL, a new connection will be created and closed locally.
+ * @return OS_SUCCESS on success or OS_INVALID on failure.
+ */
+int wdb_update_agents_keepalive(const int *ids, size_t count, const char *connection_status, const char *sync_status, int *sock);
+
 /**
  * @brief Update agent's connection status.
  *
@@ -259,6 +277,29 @@ int wdb_set_agent_groups_csv(int id, char* groups_csv, char* mode, char* sync_st
  */
 int wdb_set_agent_groups(int id, char** groups_array, char* mode, char* sync_status,int *sock);
 
+/**
+ * @brief Insert several agents in the global.db.
+ *        The agents are sent in as few queries as fit in OS_MAXSTR, each one applied in a single transaction.
+ *
+ * @param[in] agents Array of agents, each one an object with the fields of wdb_insert_agent()
+ *                   (id, name, ip, register_ip, internal_key, group, date_add).
+ * @param[in] sock The Wazuh DB socket connection. If NULL, a new connection will be created and closed locally.
+ * @return OS_SUCCESS on success or OS_INVALID if any query failed.
+ */
+int wdb_insert_agents(const cJSON *agents, int *sock);
+
+/**
+ * @brief Set the groups of several agents.
+ *        The agents are sent in as few queries as fit in OS_MAXSTR.
+ *
+ * @param[in] agents Array of agents, each one an object with the "id" and the "groups" array.
+ * @param[in] mode The mode to request the writting.
+ * @param[in] sync_status The sync_status to ask the addition (optional).
+ * @param[in] sock The Wazuh DB socket connection. If NULL, a new connection will be created and closed locally.
+ * @return OS_SUCCESS on success or OS_INVALID if any query failed.
+ */
+int wdb_set_agents_groups(const cJSON *agents, const char *mode, const char *sync_status, int *sock);
+
 /**
  * @brief Reset the connection_status column of every agent (excluding the manager).
  *        If connection_status is pending or connected it will be changed to disconnected.
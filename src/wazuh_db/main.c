@@ -11,6 +11,8 @@
 
 #include "wdb.h"
 #include "wdb_state.h"
+#include "wdb_frame.h"
+#include "wdb_replica.h"
 #include <os_net/os_net.h>
 
 #define WDB_AGENT_EVENTS_TOPIC "wdb-agent-events"
@@ -20,16 +22,26 @@ static void handler(int signum);
 static void cleanup();
 static void * run_dealer(void * args);
 static void * run_worker(void * args);
+static void * run_reader(void * args);
+static void send_response(int peer, char * response, int terminal);
 static void * run_gc(void * args);
 static void * run_up(void * args);
 static void * run_backup(void * args);
 
 extern wdb_state_t wdb_state;
 
+/* Read-only query of the global database, waiting for a reader thread */
+typedef struct {
+    int peer;
+    int terminal;
+    char * query;
+} wdb_read_job_t;
+
 //int wazuhdb_fdsock;
 wnotify_t * notify_queue;
 //static w_queue_t * sock_queue;
 static pthread_mutex_t queue_mutex = PTHREAD_MUTEX_INITIALIZER;
+static w_mpmc_queue_t * read_queue;
 //static pthread_cond_t sock_cond = PTHREAD_COND_INITIALIZER;
 static volatile _Atomic(int) running = 1;
 rlim_t nofile;
@@ -43,6 +55,7 @@ int main(int argc, char ** argv)
 
     pthread_t thread_dealer;
     pthread_t * worker_pool = NULL;
+    pthread_t * reader_pool = NULL;
     pthread_t thread_gc;
     pthread_t thread_up;
     pthread_t thread_backup;
@@ -96,11 +109,24 @@ int main(int argc, char ** argv)
     wconfig.open_db_limit = getDefine_Int("wazuh_db", "open_db_limit", 1, 4096);
     nofile = getDefine_Int("wazuh_db", "rlimit_nofile", 1024, 1048576);
 
+    // Every open database may take three descriptors (database, WAL and shared memory), keep half of them for the sockets
+    if ((rlim_t)wconfig.open_db_limit * 3 > nofile / 2) {
+        int open_db_limit = nofile / 6;
+        mwarn("The limit of open databases (%d) is too high for the file descriptor limit (%d). Using %d.", wconfig.open_db_limit, (int)nofile, open_db_limit);
+        wconfig.open_db_limit = open_db_limit;
+    }
+
     wconfig.fragmentation_threshold = getDefine_Int("wazuh_db", "fragmentation_threshold", 0, 100);
     wconfig.fragmentation_delta = getDefine_Int("wazuh_db", "fragmentation_delta", 0, 100);
     wconfig.free_pages_percentage = getDefine_Int("wazuh_db", "free_pages_percentage", 0, 99);
     wconfig.max_fragmentation = getDefine_Int("wazuh_db", "max_fragmentation", 0, 100);
     wconfig.check_fragmentation_interval = getDefine_Int("wazuh_db", "check_fragmentation_interval", 1, 30758400);
+    wconfig.wal_mode = getDefine_Int("wazuh_db", "wal_mode", 0, 1);
+    wconfig.checkpoint_pages = getDefine_Int("wazuh_db", "checkpoint_pages", 1, 1000000);
+    wconfig.checkpoint_interval = getDefine_Int("wazuh_db", "checkpoint_interval", 1, 3600);
+    wconfig.checkpoint_limit = getDefine_Int("wazuh_db", "checkpoint_limit", 1, 4096);
+    wconfig.global_replica_threads = getDefine_Int("wazuh_db", "global_replica_threads", 0, 32);
+    int read_queue_size = getDefine_Int("wazuh_db", "global_replica_queue_size", 1, 65536);
 
     // Allocating memory for configuration structures and setting default values
     wdb_init_conf();
@@ -131,6 +157,7 @@ int main(int argc, char ** argv)
     // Initialize variables
 
     wdb_pool_init();
+    wdb_replica_init(wconfig.global_replica_threads);
 
     if (!run_foreground) {
         goDaemon();
@@ -237,6 +264,18 @@ int main(int argc, char ** argv)
         }
     }
 
+    if (wconfig.global_replica_threads > 0) {
+        read_queue = mpmc_queue_init(read_queue_size);
+        os_calloc(wconfig.global_replica_threads, sizeof(pthread_t), reader_pool);
+
+        for (i = 0; i < wconfig.global_replica_threads; i++) {
+            if (status = pthread_create(reader_pool + i, NULL, run_reader, NULL), status != 0) {
+                merror("Couldn't create 'run_reader' %d thread: %s", i + 1, strerror(status));
+                goto failure;
+            }
+        }
+    }
+
     if (status = pthread_create(&thread_gc, NULL, run_gc, NULL), status != 0) {
         merror("Couldn't create 'run_gc' thread: %s", strerror(status));
         goto failure;
@@ -262,14 +301,20 @@ int main(int argc, char ** argv)
         pthread_join(worker_pool[i], NULL);
     }
 
+    for (i = 0; i < wconfig.global_replica_threads; i++) {
+        pthread_join(reader_pool[i], NULL);
+    }
+
     wnotify_close(notify_queue);
     free(worker_pool);
+    free(reader_pool);
     pthread_join(thread_up, NULL);
     pthread_join(thread_gc, NULL);
     if(backups_enabled) {
         pthread_join(thread_backup, NULL);
     }
     wdb_close_all();
+    wdb_replica_close();
     wdb_free_conf();
 
     // Reset template here too, remove queue/db/.template.db again
@@ -283,6 +328,7 @@ int main(int argc, char ** argv)
 
 failure:
     os_free(worker_pool);
+    os_free(reader_pool);
     return EXIT_FAILURE;
 }
 
@@ -403,6 +449,16 @@ void * run_worker(__attribute__((unused)) void * args) {
             continue;
 
         default:
+            if (wdb_frame_check(buffer, length)) {
+                length = wdb_frame_dispatch(buffer, length, response, OS_MAXSTR);
+
+                if (OS_SendSecureTCP(peer, length, response) < 0) {
+                    merror("at run_worker(): OS_SendSecureTCP(%d): %s (%d)",
+                            peer, strerror(errno), errno);
+                }
+                break;
+            }
+
             if (length > 0 && buffer[length - 1] == '\n') {
                 buffer[length - 1] = '\0';
                 terminal = 1;
@@ -413,20 +469,36 @@ void * run_worker(__attribute__((unused)) void * args) {
 
             *response = '\0';
 
+            // Hand the read-only global queries to the readers. The peer is watched again after the response.
+            if (read_queue != NULL && strncmp(buffer, "global ", 7) == 0 && wdb_replica_command(buffer + 7)) {
+                wdb_read_job_t * job;
+                os_malloc(sizeof(wdb_read_job_t), job);
+                job->peer = peer;
+                job->terminal = terminal;
+                os_strdup(buffer, job->query);
+
+                if (mpmc_queue_push(read_queue, job) == 0) {
+                    continue;
+                }
+
+                os_free(job->query);
+                os_free(job);
+            }
+
             if (buffer[0] == '{') {
                 wdbcom_dispatch(buffer, response);
             } else {
+                struct timeval begin;
+                struct timeval end;
+                struct timeval diff;
+
+                gettimeofday(&begin, 0);
                 wdb_parse(buffer, response, peer);
+                gettimeofday(&end, 0);
+                timersub(&end, &begin, &diff);
+                w_inc_query_latency(buffer, diff);
             }
-            if (length = strlen(response), length > 0) {
-                if (terminal && length < OS_MAXSTR - 1) {
-                    response[length++] = '\n';
-                }
-                if (OS_SendSecureTCP(peer, length, response) < 0) {
-                    merror("at run_worker(): OS_SendSecureTCP(%d): %s (%d)",
-                            peer, strerror(errno), errno);
-                }
-            }
+            send_response(peer, response, terminal);
             break;
         }
 
@@ -439,10 +511,63 @@ void * run_worker(__attribute__((unused)) void * args) {
     return NULL;
 }
 
+void * run_reader(__attribute__((unused)) void * args) {
+    char response[OS_MAXSTR + 1];
+    struct timespec timeout;
+    struct timeval begin;
+    struct timeval end;
+    struct timeval diff;
+    wdb_read_job_t * job;
+
+    while (running) {
+        gettime(&timeout);
+        timeout.tv_sec++;
+
+        if (job = mpmc_queue_pop_timedwait(read_queue, &timeout), job == NULL) {
+            continue;
+        }
+
+        *response = '\0';
+
+        gettimeofday(&begin, 0);
+        wdb_parse(job->query, response, job->peer);
+        gettimeofday(&end, 0);
+        timersub(&end, &begin, &diff);
+        w_inc_query_latency(job->query, diff);
+
+        send_response(job->peer, response, job->terminal);
+
+        if (wnotify_add(notify_queue, job->peer, WO_READ) < 0) {
+            merror("at run_reader(): wnotify_add(%d): %s (%d)",
+                    job->peer, strerror(errno), errno);
+        }
+
+        os_free(job->query);
+        os_free(job);
+    }
+
+    return NULL;
+}
+
+void send_response(int peer, char * response, int terminal) {
+    size_t length = strlen(response);
+
+    if (length > 0) {
+        if (terminal && length < OS_MAXSTR - 1) {
+            response[length++] = '\n';
+        }
+        if (OS_SendSecureTCP(peer, length, response) < 0) {
+            merror("at send_response(): OS_SendSecureTCP(%d): %s (%d)",
+                    peer, strerror(errno), errno);
+        }
+    }
+}
+
 void * run_gc(__attribute__((unused)) void * args) {
     int fragmentation_interval = wconfig.check_fragmentation_interval;
     while (running) {
         wdb_commit_old();
+        wdb_checkpoint_old();
 
         if (fragmentation_interval <= 0) {
             wdb_check_fragmentation();
@@ -10,6 +10,7 @@
  */
 
 #include "wdb.h"
+#include "wdb_state.h"
 #include "wazuh_modules/wmodules.h"
 #include "wazuhdb_op.h"
 
@@ -117,6 +118,7 @@ static const char *SQL_STMT[] = {
     [WDB_STMT_SCA_POLICY_SHA256] = "SELECT hash_file FROM sca_policy WHERE id = ?;",
     [WDB_STMT_SCA_POLICY_INSERT] = "INSERT INTO sca_policy (name,file,id,description,`references`,hash_file) VALUES(?,?,?,?,?,?);",
     [WDB_STMT_SCA_CHECK_GET_ALL_RESULTS] = "SELECT result FROM sca_check WHERE policy_id = ? ORDER BY id;",
+    [WDB_STMT_SCA_CHECK_GET_RANGE_RESULTS] = "SELECT result FROM sca_check WHERE policy_id = ? AND id BETWEEN ? AND ? ORDER BY id;",
     [WDB_STMT_SCA_POLICY_GET_ALL] = "SELECT id FROM sca_policy;",
     [WDB_STMT_SCA_POLICY_DELETE] = "DELETE FROM sca_policy WHERE id = ?;",
     [WDB_STMT_SCA_CHECK_DELETE] = "DELETE FROM sca_check WHERE policy_id = ?;",
@@ -124,6 +126,7 @@ static const char *SQL_STMT[] = {
     [WDB_STMT_SCA_CHECK_COMPLIANCE_DELETE] = "DELETE FROM sca_check_compliance WHERE id_check NOT IN ( SELECT id FROM sca_check);",
     [WDB_STMT_SCA_CHECK_RULES_DELETE] = "DELETE FROM sca_check_rules WHERE id_check NOT IN ( SELECT id FROM sca_check);",
     [WDB_STMT_SCA_CHECK_DELETE_DISTINCT] = "DELETE FROM sca_check WHERE scan_id != ? AND policy_id = ?;",
+    [WDB_STMT_SCA_CHECK_DELETE_DISTINCT_RANGE] = "DELETE FROM sca_check WHERE scan_id != ? AND policy_id = ? AND id BETWEEN ? AND ?;",
     [WDB_STMT_FIM_SELECT_CHECKSUM] = "SELECT checksum FROM fim_entry ORDER BY file;",
     [WDB_STMT_FIM_SELECT_CHECKSUM_RANGE] = "SELECT checksum FROM fim_entry WHERE file BETWEEN ? and ? ORDER BY file;",
     [WDB_STMT_FIM_DELETE_AROUND] = "DELETE FROM fim_entry WHERE file < ? OR file > ?;",
@@ -366,6 +369,11 @@ wdb_t * wdb_open_global() {
         wdb_enable_foreign_keys(wdb->db);
 
         wdb_set_synchronous_normal(wdb);
+
+        // The read-only replica needs the snapshots of the write-ahead log
+        if (wconfig.wal_mode || wconfig.global_replica_threads > 0) {
+            wdb_set_wal_mode(wdb);
+        }
     }
 
     return wdb;
@@ -434,6 +442,11 @@ wdb_t * wdb_open_agent2(int agent_id) {
         }
     }
 
+    if (wconfig.wal_mode && wdb->db != NULL) {
+        wdb_set_synchronous_normal(wdb);
+        wdb_set_wal_mode(wdb);
+    }
+
     return wdb;
 }
 
@@ -919,6 +932,65 @@ void wdb_commit_old() {
     free_strarray(keys);
 }
 
+void wdb_checkpoint_old() {
+    static unsigned int turn;
+    char ** keys;
+    unsigned int count;
+    int done = 0;
+
+    if (!wconfig.wal_mode) {
+        return;
+    }
+
+    keys = wdb_pool_keys();
+
+    for (count = 0; keys[count]; count++);
+
+    // Start where the previous call stopped, so every database gets its turn
+    for (unsigned int i = 0; i < count && done < wconfig.checkpoint_limit; i++) {
+        wdb_t * node = wdb_pool_get(keys[(turn + i) % count]);
+
+        if (node == NULL) {
+            continue;
+        }
+
+        time_t cur_time = time(NULL);
+        int pages = node->wal_pages;
+
+        // A database in a transaction is checkpointed after its commit
+        if (node->db != NULL && !node->transaction && pages > 0 &&
+            (pages >= wconfig.checkpoint_pages || cur_time - node->checkpoint_time >= wconfig.checkpoint_interval)) {
+            struct timeval begin;
+            struct timeval end;
+            struct timeval diff;
+            int log = 0;
+            int checkpointed = 0;
+            int result;
+
+            gettimeofday(&begin, 0);
+            result = sqlite3_wal_checkpoint_v2(node->db, NULL, SQLITE_CHECKPOINT_PASSIVE, &log, &checkpointed);
+            gettimeofday(&end, 0);
+            timersub(&end, &begin, &diff);
+
+            if (result == SQLITE_OK) {
+                node->wal_pages = log - checkpointed;
+                w_inc_checkpoint(checkpointed, log > checkpointed, diff);
+                mdebug2("DB(%s) Checkpoint of %d pages (%d left). Time: %.3f ms.", node->id, checkpointed, log - checkpointed, diff.tv_sec * 1e3 + diff.tv_usec / 1e3);
+            } else {
+                mdebug1("DB(%s) Cannot checkpoint the write-ahead log: %s", node->id, sqlite3_errmsg(node->db));
+            }
+
+            node->checkpoint_time = cur_time;
+            done++;
+        }
+
+        wdb_pool_leave(node);
+    }
+
+    turn = count > 0 ? (turn + done) % count : 0;
+    free_strarray(keys);
+}
+
 void wdb_check_fragmentation() {
     char ** keys = wdb_pool_keys();
 
@@ -1084,10 +1156,11 @@ int wdb_update_last_vacuum_data(wdb_t * wdb, const char *last_vacuum_time, const
 }
 
 void wdb_close_old() {
-    char ** keys = wdb_pool_keys();
-    int closed = 0;
+    unsigned open;
+    char ** keys = wdb_pool_idle_keys(&open);
 
-    for (int i = 0; keys[i] && (int)wdb_pool_size() - closed > wconfig.open_db_limit; i++) {
+    // The least recently used databases are closed first
+    for (int i = 0; keys[i] && (int)open > wconfig.open_db_limit; i++) {
         wdb_t * node = wdb_pool_get(keys[i]);
 
         if (node == NULL) {
@@ -1097,7 +1170,7 @@ void wdb_close_old() {
         if (node->db != NULL && node->refcount == 1 && strcmp(node->id, WDB_GLOB_NAME) != 0) {
             mdebug2("Closing database for agent %s", node->id);
             wdb_close(node, true);
-            closed++;
+            open--;
         }
 
         wdb_pool_leave(node);
@@ -1512,6 +1585,40 @@ int wdb_journal_wal(sqlite3 *db) {
     return 0;
 }
 
+// Keep track of the pages of the write-ahead log after every commit
+static int wdb_wal_hook(void * arg, sqlite3 * db, __attribute__((unused)) const char * name, int pages) {
+    wdb_t * wdb = (wdb_t *)arg;
+    int log;
+    int checkpointed;
+
+    // Safety valve for a log that grows faster than the checkpoints are scheduled
+    if (pages >= wconfig.checkpoint_pages * WDB_CHECKPOINT_FORCE_FACTOR) {
+        mdebug1("DB(%s) The write-ahead log reached %d pages. Checkpointing it now.", wdb->id, pages);
+
+        if (sqlite3_wal_checkpoint_v2(db, NULL, SQLITE_CHECKPOINT_PASSIVE, &log, &checkpointed) == SQLITE_OK) {
+            pages = log - checkpointed;
+            wdb->checkpoint_time = time(NULL);
+        }
+    }
+
+    wdb->wal_pages = pages;
+    return SQLITE_OK;
+}
+
+int wdb_set_wal_mode(wdb_t * wdb) {
+    if (wdb_journal_wal(wdb->db) == -1) {
+        return -1;
+    }
+
+    sqlite3_wal_autocheckpoint(wdb->db, 0);
+    sqlite3_wal_hook(wdb->db, wdb_wal_hook, wdb);
+
+    wdb->wal_pages = 0;
+    wdb->checkpoint_time = time(NULL);
+
+    return 0;
+}
+
 int wdb_enable_foreign_keys(sqlite3 *db) {
     char *sql_error = NULL;
 
@@ -48,6 +48,8 @@
 #define WDB_MAX_RESPONSE_SIZE   OS_MAXSTR-WDB_MAX_COMMAND_SIZE
 #define WDB_MAX_QUERY_SIZE      OS_MAXSTR-WDB_MAX_COMMAND_SIZE
 
+#define WDB_CHECKPOINT_FORCE_FACTOR 8   // A write-ahead log this many times checkpoint_pages is checkpointed at commit
+
 #define AGENT_CS_NEVER_CONNECTED "never_connected"
 #define AGENT_CS_PENDING         "pending"
 #define AGENT_CS_ACTIVE          "active"
@@ -175,6 +177,7 @@ typedef enum wdb_stmt {
     WDB_STMT_SCA_POLICY_SHA256,
     WDB_STMT_SCA_POLICY_INSERT,
     WDB_STMT_SCA_CHECK_GET_ALL_RESULTS,
+    WDB_STMT_SCA_CHECK_GET_RANGE_RESULTS,
     WDB_STMT_SCA_POLICY_GET_ALL,
     WDB_STMT_SCA_POLICY_DELETE,
     WDB_STMT_SCA_CHECK_DELETE,
@@ -182,6 +185,7 @@ typedef enum wdb_stmt {
     WDB_STMT_SCA_CHECK_COMPLIANCE_DELETE,
     WDB_STMT_SCA_CHECK_RULES_DELETE,
     WDB_STMT_SCA_CHECK_DELETE_DISTINCT,
+    WDB_STMT_SCA_CHECK_DELETE_DISTINCT_RANGE,
     WDB_STMT_FIM_SELECT_CHECKSUM,
     WDB_STMT_FIM_SELECT_CHECKSUM_RANGE,
     WDB_STMT_FIM_DELETE_AROUND,
@@ -357,6 +361,8 @@ typedef struct wdb_t {
     struct stmt_cache_list *cache_list;
     struct wdb_t * next;
     bool enabled;
+    _Atomic(int) wal_pages;             ///< Pages in the write-ahead log, not checkpointed yet
+    time_t checkpoint_time;             ///< Last checkpoint, or database opening
 } wdb_t;
 
 typedef enum wdb_backup_db {
@@ -380,6 +386,11 @@ typedef struct wdb_config {
     int free_pages_percentage;
     int max_fragmentation;
     int check_fragmentation_interval;
+    int wal_mode;
+    int checkpoint_pages;
+    int checkpoint_interval;
+    int checkpoint_limit;
+    int global_replica_threads;
     wdb_backup_settings_node** wdb_backup_settings;
 } wdb_config;
 
@@ -541,6 +552,16 @@ int wdb_syscheck_load(wdb_t * wdb, const char * file, char * output, size_t size
 int wdb_syscheck_save(wdb_t * wdb, int ftype, char * checksum, const char * file);
 int wdb_syscheck_save2(wdb_t * wdb, const char * payload);
 
+/**
+ * @brief Store a batch of FIM entries in a single transaction.
+ *
+ * @param wdb Database of the agent.
+ * @param payload JSON array with the entries to save, like the payload of wdb_syscheck_save2(),
+ *                and the entries to delete as {"delete":<path>}.
+ * @return 0 on success, -1 if the batch is invalid or any of its entries failed.
+ */
+int wdb_syscheck_save_batch(wdb_t * wdb, const char * payload);
+
 // Find file entry: returns 1 if found, 0 if not, or -1 on error.
 int wdb_fim_find_entry(wdb_t * wdb, const char * path);
 
@@ -592,6 +613,9 @@ int wdb_sca_policy_find(wdb_t * wdb, char *id, char * output);
 /* Gets the result of all checks in Wazuh DB. Returns 1 if found, 0 if not, or -1 on error. (new) */
 int wdb_sca_checks_get_result(wdb_t * wdb, char * policy_id, char * output);
 
+/* Gets the result of the checks whose id is between first and last. Returns 1 if found, 0 if not, or -1 on error. */
+int wdb_sca_checks_get_result_range(wdb_t * wdb, char * policy_id, int first, int last, char * output);
+
 /* Insert policy entry. Returns number of affected rows or -1 on error.  */
 int wdb_sca_policy_info_save(wdb_t * wdb,char *name,char * file,char * id,char * description,char *references, char *hash_file);
 
@@ -616,6 +640,9 @@ int wdb_sca_check_rules_delete(wdb_t * wdb);
 /* Delete distinct configuration assessment check. Returns 0 on success or -1 on error (new) */
 int wdb_sca_check_delete_distinct(wdb_t * wdb,char * policy_id,int scan_id);
 
+/* Delete distinct configuration assessment check whose id is between first and last. Returns 0 on success or -1 on error */
+int wdb_sca_check_delete_distinct_range(wdb_t * wdb, char * policy_id, int scan_id, int first, int last);
+
 /* Gets the policy SHA256. Returns 1 if found, 0 if not or -1 on error */
 int wdb_sca_policy_sha256(wdb_t * wdb, char *id, char * output);
 
@@ -853,6 +880,16 @@ int wdb_port_delete(wdb_t * wdb, const char * scan_id);
 
 int wdb_syscollector_save2(wdb_t * wdb, wdb_component_t component, const char * payload);
 
+/**
+ * @brief Store a batch of Syscollector entries in a single transaction.
+ *
+ * @param wdb Database of the agent.
+ * @param component Syscollector component of the entries.
+ * @param payload JSON array with the entries, like the payload of wdb_syscollector_save2().
+ * @return 0 on success, -1 if the batch is invalid or any of its entries failed.
+ */
+int wdb_syscollector_save_batch(wdb_t * wdb, wdb_component_t component, const char * payload);
+
 // Save CIS-CAT scan results.
 int wdb_ciscat_save(wdb_t * wdb, const char * scan_id, const char * scan_time, const char * benchmark, const char * profile, int pass, int fail, int error, int notchecked, int unknown, int score);
 
@@ -884,6 +921,16 @@ void wdb_close_all();
 
 void wdb_commit_old();
 
+/**
+ * @brief Checkpoint the write-ahead log of the databases that are due
+ *
+ * A database is due when its log reaches checkpoint_pages, or when it has
+ * pages and checkpoint_interval seconds went by since its last checkpoint.
+ * Up to checkpoint_limit databases are checkpointed per call, taking turns,
+ * so the writes to the database files are spread over time.
+ */
+void wdb_checkpoint_old();
+
 void wdb_close_old();
 
 int wdb_remove_database(const char * agent_id);
@@ -1097,6 +1144,17 @@ int wdb_parse_agents_set_sys_osinfo(wdb_t * wdb, char * input, char * output);
  */
 int wdb_parse_dbsync(wdb_t * wdb, char * input, char * output);
 
+/**
+ * @brief Apply a dbsync operation to a table of the agent database.
+ *
+ * @param wdb The agent database.
+ * @param table_key Name of the table in the dbsync message, like "packages".
+ * @param operation Operation: "INSERTED", "MODIFIED" or "DELETED".
+ * @param data JSON with the row.
+ * @return OS_SUCCESS on success, OS_INVALID if the table is unknown or the operation failed.
+ */
+int wdb_dbsync_process(wdb_t * wdb, const char * table_key, const char * operation, const char * data);
+
 /**
  * @brief Function to parse the agent insert request.
  *
@@ -1108,6 +1166,17 @@ int wdb_parse_dbsync(wdb_t * wdb, char * input, char * output);
  */
 int wdb_parse_global_insert_agent(wdb_t * wdb, char * input, char * output);
 
+/**
+ * @brief Function to parse the insert request of several agents.
+ *
+ * @param [in] wdb The global struct database.
+ * @param [in] input String with the array of agents in JSON format, each one as in the insert agent request.
+ * @param [out] output Response of the query.
+ * @return 0 Success: response contains "ok".
+ *        -1 On error: response contains "err" and the number of agents that couldn't be inserted.
+ */
+int wdb_parse_global_insert_agents(wdb_t * wdb, char * input, char * output);
+
 /**
  * @brief Function to parse the update agent name request.
  *
@@ -1195,6 +1264,17 @@ int wdb_parse_global_set_agent_labels(wdb_t * wdb, char * input, char * output);
  */
 int wdb_parse_global_update_agent_keepalive(wdb_t * wdb, char * input, char * output);
 
+/**
+ * @brief Function to parse the update keepalive request of several agents.
+ *
+ * @param [in] wdb The global struct database.
+ * @param [in] input String with the statuses and the array of agent IDs in JSON format.
+ * @param [out] output Response of the query.
+ * @return 0 Success: response contains "ok".
+ *        -1 On error: response contains "err" and an error description.
+ */
+int wdb_parse_global_update_agents_keepalive(wdb_t * wdb, char * input, char * output);
+
 /**
  * @brief Function to parse the update agent connection status.
  *
@@ -1703,6 +1783,18 @@ int wdbi_query_clear(wdb_t * wdb, wdb_component_t component, const char * payloa
  */
 int wdb_journal_wal(sqlite3 *db);
 
+/**
+ * @brief Switch an open agent or global database to write-ahead logging
+ *
+ * The automatic checkpoints are disabled: wdb_checkpoint_old() runs them.
+ * The commits are not synced to disk, the checkpoints sync them all at once.
+ *
+ * @param [in] wdb Database to configure.
+ * @retval 0 On success.
+ * @retval -1 On error.
+ */
+int wdb_set_wal_mode(wdb_t * wdb);
+
 /**
  * @brief Enables foreign keys usage into the specified database.
  *
@@ -1851,6 +1943,18 @@ int wdb_global_set_agent_label(wdb_t *wdb, int id, char* key, char* value);
  */
 int wdb_global_update_agent_keepalive(wdb_t *wdb, int id, const char *connection_status, const char *sync_status);
 
+/**
+ * @brief Function to update the keepalive and the synchronization status of several agents in the same transaction.
+ *
+ * @param [in] wdb The Global struct database.
+ * @param [in] ids Array with the agent IDs.
+ * @param [in] count Number of agent IDs.
+ * @param [in] connection_status The agents' connection status.
+ * @param [in] sync_status The value of sync_status
+ * @return Returns 0 on success or -1 if any agent couldn't be updated.
+ */
+int wdb_global_update_agents_keepalive(wdb_t *wdb, const int *ids, size_t count, const char *connection_status, const char *sync_status);
+
 /**
  * @brief Function to update an agent connection status and the synchronization status.
  *
@@ -158,6 +158,48 @@ end:
     return retval;
 }
 
+int wdb_syscheck_save_batch(wdb_t * wdb, const char * payload) {
+    int retval = -1;
+    cJSON * batch = cJSON_Parse(payload);
+    cJSON * entry = NULL;
+
+    if (!wdb) {
+        merror("WDB object cannot be null.");
+        goto end;
+    }
+
+    if (!cJSON_IsArray(batch)) {
+        mdebug1("DB(%s): cannot parse FIM batch: '%s'", wdb->id, payload == NULL ? "" : payload);
+        goto end;
+    }
+
+    // The whole batch is stored in the same transaction
+    if (!wdb->transaction && wdb_begin2(wdb) < 0) {
+        merror("DB(%s) Can't begin transaction.", wdb->id);
+        goto end;
+    }
+
+    retval = 0;
+
+    cJSON_ArrayForEach(entry, batch) {
+        const char * deleted = cJSON_GetStringValue(cJSON_GetObjectItem(entry, "delete"));
+
+        if (deleted != NULL) {
+            if (wdb_fim_delete(wdb, deleted) < 0) {
+                mdebug1("DB(%s) Can't delete file entry.", wdb->id);
+                retval = -1;
+            }
+        } else if (wdb_fim_insert_entry2(wdb, entry) == -1) {
+            mdebug1("DB(%s) Can't insert file entry.", wdb->id);
+            retval = -1;
+        }
+    }
+
+end:
+    cJSON_Delete(batch);
+    return retval;
+}
+
 // Find file entry: returns 1 if found, 0 if not, or -1 on error.
 // LCOV_EXCL_START
 int wdb_fim_find_entry(wdb_t * wdb, const char * path) {
@@ -0,0 +1,354 @@
+/*
+ * Wazuh DB binary frames
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "wdb.h"
+#include "wdb_state.h"
+#include "wdb_frame.h"
+
+#ifdef WAZUH_UNIT_TESTING
+// Remove static qualifier when unit testing
+#define STATIC
+#else
+#define STATIC static
+#endif
+
+typedef struct wdb_frame_operation_t {
+    unsigned char type;
+    int agent_id;
+    unsigned char argument;
+    char name[UCHAR_MAX + 1];
+    char * data;
+    size_t data_length;
+} wdb_frame_operation_t;
+
+/* Agent database kept open between the operations of a frame */
+typedef struct wdb_frame_agent_t {
+    wdb_t * wdb;
+    int agent_id;
+} wdb_frame_agent_t;
+
+static const char * DBSYNC_OPERATIONS[] = { "INSERTED", "MODIFIED", "DELETED" };
+
+static uint32_t wdb_frame_read32(const char * buffer) {
+    uint32_t value;
+    memcpy(&value, buffer, sizeof(value));
+    return ntohl(value);
+}
+
+static uint16_t wdb_frame_read16(const char * buffer) {
+    uint16_t value;
+    memcpy(&value, buffer, sizeof(value));
+    return ntohs(value);
+}
+
+static void wdb_frame_write16(char * buffer, uint16_t value) {
+    value = htons(value);
+    memcpy(buffer, &value, sizeof(value));
+}
+
+/**
+ * @brief Read the next operation of a frame.
+ *
+ * @return Length of the operation, 0 if it's malformed.
+ */
+STATIC size_t wdb_frame_read_operation(char * buffer, size_t length, wdb_frame_operation_t * operation) {
+    size_t name_length;
+
+    if (length < WDB_FRAME_OP_HEADER) {
+        return 0;
+    }
+
+    operation->type = (unsigned char)buffer[0];
+    operation->agent_id = (int)wdb_frame_read32(buffer + 1);
+    operation->argument = (unsigned char)buffer[5];
+    name_length = (unsigned char)buffer[6];
+    operation->data_length = wdb_frame_read32(buffer + 7);
+
+    if (operation->agent_id < 0 || name_length > length - WDB_FRAME_OP_HEADER || operation->data_length > length - WDB_FRAME_OP_HEADER - name_length) {
+        return 0;
+    }
+
+    memcpy(operation->name, buffer + WDB_FRAME_OP_HEADER, name_length);
+    operation->name[name_length] = '\0';
+    operation->data = buffer + WDB_FRAME_OP_HEADER + name_length;
+
+    return WDB_FRAME_OP_HEADER + name_length + operation->data_length;
+}
+
+/**
+ * @brief Get the database of an agent, reusing the one of the previous operation if it's the same agent.
+ */
+static wdb_t * wdb_frame_open_agent(wdb_frame_agent_t * agent, int agent_id, const char ** error) {
+    struct timeval begin;
+    struct timeval end;
+    struct timeval diff;
+
+    if (agent->wdb != NULL && agent->agent_id == agent_id) {
+        return agent->wdb;
+    }
+
+    if (agent->wdb != NULL) {
+        wdb_pool_leave(agent->wdb);
+        agent->wdb = NULL;
+    }
+
+    // Don't perform this check if it's a manager.
+    if (agent_id != 0) {
+        wdb_t * wdb_global = wdb_open_global();
+
+        if (wdb_global == NULL) {
+            *error = "Couldn't open DB global";
+            return NULL;
+        } else if (!wdb_global->enabled) {
+            *error = "DB global disabled.";
+            wdb_pool_leave(wdb_global);
+            return NULL;
+        }
+
+        if (wdb_global_agent_exists(wdb_global, agent_id) <= 0) {
+            *error = "Agent not found";
+            wdb_pool_leave(wdb_global);
+            return NULL;
+        }
+
+        wdb_pool_leave(wdb_global);
+    }
+
+    gettimeofday(&begin, 0);
+    agent->wdb = wdb_open_agent2(agent_id);
+    gettimeofday(&end, 0);
+    timersub(&end, &begin, &diff);
+    w_inc_agent_open_time(diff);
+
+    if (agent->wdb == NULL) {
+        merror("Couldn't open DB for agent '%03d'", agent_id);
+        *error = "Couldn't open DB for agent";
+        return NULL;
+    }
+
+    agent->agent_id = agent_id;
+    return agent->wdb;
+}
+
+STATIC int wdb_frame_keepalive(wdb_frame_operation_t * operation, const char ** error) {
+    char sync_status[UCHAR_MAX + 1];
+    size_t sync_length;
+    size_t count;
+    int * ids;
+    wdb_t * wdb;
+    int result;
+
+    if (operation->data_length < 1 || (sync_length = (unsigned char)operation->data[0]) > operation->data_length - 1 || (operation->data_length - 1 - sync_length) % 4 != 0) {
+        *error = "Invalid keepalive data";
+        return OS_INVALID;
+    }
+
+    memcpy(sync_status, operation->data + 1, sync_length);
+    sync_status[sync_length] = '\0';
+    count = (operation->data_length - 1 - sync_length) / 4;
+
+    os_malloc((count + 1) * sizeof(int), ids);
+
+    for (size_t i = 0; i < count; i++) {
+        ids[i] = (int)wdb_frame_read32(operation->data + 1 + sync_length + i * 4);
+    }
+
+    w_inc_global();
+    w_inc_global_agent_update_keepalive();
+
+    if (wdb = wdb_open_global(), wdb == NULL) {
+        *error = "Couldn't open DB global";
+        os_free(ids);
+        return OS_INVALID;
+    } else if (!wdb->enabled) {
+        *error = "DB global disabled.";
+        wdb_pool_leave(wdb);
+        os_free(ids);
+        return OS_INVALID;
+    }
+
+    if (result = wdb_global_update_agents_keepalive(wdb, ids, count, operation->name, sync_status), result != OS_SUCCESS) {
+        *error = "Cannot execute Global database query";
+    }
+
+    wdb_pool_leave(wdb);
+    os_free(ids);
+
+    return result;
+}
+
+STATIC int wdb_frame_agent_operation(wdb_frame_agent_t * agent, wdb_frame_operation_t * operation, const char ** error) {
+    struct timeval begin;
+    struct timeval end;
+    struct timeval diff;
+    wdb_t * wdb;
+    int result = OS_INVALID;
+
+    w_inc_agent();
+
+    if (wdb = wdb_frame_open_agent(agent, operation->agent_id, error), wdb == NULL) {
+        return OS_INVALID;
+    }
+
+    gettimeofday(&begin, 0);
+
+    switch (operation->type) {
+    case WDB_FRAME_SYSCOLLECTOR_SAVE:
+        if (operation->argument < WDB_SYSCOLLECTOR_PROCESSES || operation->argument > WDB_SYSCOLLECTOR_OSINFO) {
+            *error = "Invalid Syscollector component";
+        } else if (result = wdb_syscollector_save2(wdb, operation->argument, operation->data), result == OS_INVALID) {
+            mdebug1("DB(%s) Cannot save Syscollector.", wdb->id);
+            *error = "Cannot save Syscollector";
+        } else {
+            result = OS_SUCCESS;
+        }
+        break;
+
+    case WDB_FRAME_SYSCOLLECTOR_BATCH:
+        if (operation->argument < WDB_SYSCOLLECTOR_PROCESSES || operation->argument > WDB_SYSCOLLECTOR_OSINFO) {
+            *error = "Invalid Syscollector component";
+        } else if (result = wdb_syscollector_save_batch(wdb, operation->argument, operation->data), result == OS_INVALID) {
+            mdebug1("DB(%s) Cannot save Syscollector batch.", wdb->id);
+            *error = "Cannot save Syscollector batch";
+        }
+        break;
+
+    case WDB_FRAME_DBSYNC:
+        w_inc_agent_dbsync();
+
+        if (operation->argument > WDB_FRAME_DBSYNC_DELETED) {
+            *error = "Invalid dbsync operation";
+        } else if (result = wdb_dbsync_process(wdb, operation->name, DBSYNC_OPERATIONS[operation->argument], operation->data), result != OS_SUCCESS) {
+            *error = "Cannot process dbsync data";
+        }
+
+        gettimeofday(&end, 0);
+        timersub(&end, &begin, &diff);
+        w_inc_agent_dbsync_time(diff);
+        break;
+
+    case WDB_FRAME_FIM_SAVE:
+        w_inc_agent_syscheck();
+
+        if (result = wdb_syscheck_save2(wdb, operation->data), result == OS_INVALID) {
+            mdebug1("DB(%s) Cannot save FIM.", wdb->id);
+            *error = "Cannot save Syscheck";
+        } else {
+            result = OS_SUCCESS;
+        }
+
+        gettimeofday(&end, 0);
+        timersub(&end, &begin, &diff);
+        w_inc_agent_syscheck_time(diff);
+        break;
+
+    case WDB_FRAME_FIM_BATCH:
+        w_inc_agent_syscheck();
+
+        if (result = wdb_syscheck_save_batch(wdb, operation->data), result == OS_INVALID) {
+            mdebug1("DB(%s) Cannot save FIM batch.", wdb->id);
+            *error = "Cannot save Syscheck batch";
+        }
+
+        gettimeofday(&end, 0);
+        timersub(&end, &begin, &diff);
+        w_inc_agent_syscheck_time(diff);
+        break;
+
+    default:
+        *error = "Invalid operation";
+    }
+
+    return result;
+}
+
+int wdb_frame_check(const char * buffer, size_t length) {
+    return length >= WDB_FRAME_HEADER && (unsigned char)buffer[0] == WDB_FRAME_MAGIC;
+}
+
+size_t wdb_frame_dispatch(char * buffer, size_t length, char * output, size_t size) {
+    wdb_frame_agent_t agent = { NULL, 0 };
+    size_t offset = WDB_FRAME_HEADER;
+    size_t out_length = WDB_FRAME_HEADER;
+    uint16_t count = 0;
+    uint16_t total;
+
+    output[0] = (char)WDB_FRAME_MAGIC;
+    output[1] = WDB_FRAME_VERSION;
+
+    if (buffer[1] != WDB_FRAME_VERSION) {
+        mdebug1("Unsupported frame version: %d", (unsigned char)buffer[1]);
+        wdb_frame_write16(output + 2, 0);
+        return out_length;
+    }
+
+    total = wdb_frame_read16(buffer + 2);
+
+    if (total > WDB_FRAME_MAX_OPERATIONS) {
+        mdebug1("Too many operations in frame: %u", total);
+        total = 0;
+    }
+
+    while (count < total) {
+        wdb_frame_operation_t operation;
+        const char * error = NULL;
+        size_t op_length;
+        int result;
+
+        if (op_length = wdb_frame_read_operation(buffer + offset, length - offset, &operation), op_length == 0) {
+            mdebug1("Invalid operation at offset %zu of frame.", offset);
+            break;
+        }
+
+        if (out_length + 2 + WDB_FRAME_MAX_MESSAGE > size) {
+            break;
+        }
+
+        w_inc_queries_total();
+
+        // The data is terminated in place, saving the byte that follows it
+        char * end = operation.data + operation.data_length;
+        char next = *end;
+        *end = '\0';
+
+        if (operation.type == WDB_FRAME_KEEPALIVE) {
+            result = wdb_frame_keepalive(&operation, &error);
+        } else {
+            result = wdb_frame_agent_operation(&agent, &operation, &error);
+        }
+
+        *end = next;
+
+        size_t message_length = (result == OS_SUCCESS || error == NULL) ? 0 : strlen(error);
+
+        if (message_length > WDB_FRAME_MAX_MESSAGE) {
+            message_length = WDB_FRAME_MAX_MESSAGE;
+        }
+
+        output[out_length++] = result == OS_SUCCESS ? 0 : 1;
+        output[out_length++] = (char)message_length;
+        if (message_length > 0) {
+            memcpy(output + out_length, error, message_length);
+            out_length += message_length;
+        }
+
+        offset += op_length;
+        count++;
+    }
+
+    if (agent.wdb != NULL) {
+        wdb_pool_leave(agent.wdb);
+    }
+
+    wdb_frame_write16(output + 2, count);
+
+    return out_length;
+}
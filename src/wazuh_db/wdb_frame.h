@@ -0,0 +1,83 @@
+/*
+ * Wazuh DB binary frames
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+/**
+ * Binary alternative to the text queries for the most frequent commands.
+ * A frame carries several operations, so a client can send a batch of
+ * deltas in a single message, and the fields are typed and length-prefixed
+ * instead of separated by spaces. The numbers are in network byte order.
+ *
+ * Request:
+ *   magic (1 byte, WDB_FRAME_MAGIC) | version (1) | operations (2)
+ *   and, for each operation:
+ *   type (1) | agent ID (4) | argument (1) | name length (1) | data length (4) | name | data
+ *
+ * Response:
+ *   magic (1) | version (1) | operations (2)
+ *   and, for each operation processed:
+ *   status (1, 0 on success) | message length (1) | message
+ *
+ * The operations are processed in order. A malformed operation stops the
+ * frame, so the response may hold less operations than the request.
+ */
+
+#ifndef WDB_FRAME_H
+#define WDB_FRAME_H
+
+#include <stddef.h>
+
+#define WDB_FRAME_MAGIC     0xB7
+#define WDB_FRAME_VERSION   1
+#define WDB_FRAME_HEADER    4
+#define WDB_FRAME_OP_HEADER 11
+
+/* Limits that keep the response within a single message */
+#define WDB_FRAME_MAX_OPERATIONS 1024
+#define WDB_FRAME_MAX_MESSAGE    60
+
+typedef enum wdb_frame_op_t {
+    WDB_FRAME_SYSCOLLECTOR_SAVE = 1, ///< Like "agent <id> <component> save2 <data>". Argument: wdb_component_t.
+    WDB_FRAME_DBSYNC,                ///< Like "agent <id> dbsync <name> <operation> <data>". Argument: wdb_frame_dbsync_t.
+    WDB_FRAME_FIM_SAVE,              ///< Like "agent <id> syscheck save2 <data>".
+    WDB_FRAME_KEEPALIVE,             ///< Like "global update-agents-keepalive". Name: connection status.
+                                     ///< Data: sync status length (1) | sync status | agent IDs (4 each).
+    WDB_FRAME_FIM_BATCH,             ///< Like "agent <id> syscheck save_batch <data>".
+    WDB_FRAME_SYSCOLLECTOR_BATCH,    ///< Like "agent <id> <component> save_batch <data>". Argument: wdb_component_t.
+} wdb_frame_op_t;
+
+typedef enum wdb_frame_dbsync_t {
+    WDB_FRAME_DBSYNC_INSERTED,
+    WDB_FRAME_DBSYNC_MODIFIED,
+    WDB_FRAME_DBSYNC_DELETED,
+} wdb_frame_dbsync_t;
+
+/**
+ * @brief Check whether a message is a binary frame.
+ *
+ * @param buffer Message received.
+ * @param length Length of the message.
+ * @return 1 if it's a binary frame, 0 if it's a text query.
+ */
+int wdb_frame_check(const char * buffer, size_t length);
+
+/**
+ * @brief Process the operations of a binary frame.
+ *
+ * @param buffer Frame received, with room for one byte after it. The data of every operation is terminated
+ *               in place while it's processed.
+ * @param length Length of the frame.
+ * @param output Buffer for the response frame.
+ * @param size Size of the output buffer.
+ * @return Length of the response frame.
+ */
+size_t wdb_frame_dispatch(char * buffer, size_t length, char * output, size_t size);
+
+#endif
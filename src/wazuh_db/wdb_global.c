@@ -10,6 +10,7 @@
  */
 
 #include "wdb.h"
+#include "wdb_replica.h"
 
 // List of agent information fields in global DB
 // The ":" is used for parameter binding
@@ -348,6 +349,26 @@ int wdb_global_update_agent_keepalive(wdb_t *wdb, int id, const char *connection
     return wdb_exec_stmt_silent(stmt);
 }
 
+int wdb_global_update_agents_keepalive(wdb_t *wdb, const int *ids, size_t count, const char *connection_status, const char *sync_status) {
+    int result = OS_SUCCESS;
+    size_t i;
+
+    if (!wdb->transaction && wdb_begin2(wdb) < 0) {
+        mdebug1("Cannot begin transaction");
+        return OS_INVALID;
+    }
+
+    // The transaction stays open, so each agent only executes the cached statement
+    for (i = 0; i < count; i++) {
+        if (OS_SUCCESS != wdb_global_update_agent_keepalive(wdb, ids[i], connection_status, sync_status)) {
+            mdebug1("Cannot update the keepalive of agent %d", ids[i]);
+            result = OS_INVALID;
+        }
+    }
+
+    return result;
+}
+
 int wdb_global_update_agent_connection_status(wdb_t *wdb, int id, const char *connection_status, const char *sync_status, int status_code) {
     sqlite3_stmt *stmt = NULL;
     time_t disconnection_time = 0;
@@ -2078,6 +2099,7 @@ int wdb_global_restore_backup(wdb_t** wdb, char* snapshot, bool save_pre_restore
             // Preparing DB for restoration.
 
             wdb_close(*wdb, true);
+            wdb_replica_close();
             unlink(global_path);
 
             if (rename(global_tmp_path, global_path) != OS_SUCCESS) {
@@ -14,6 +14,7 @@
 #include "wdb_agents.h"
 #include "external/cJSON/cJSON.h"
 #include "wdb_state.h"
+#include "wdb_replica.h"
 
 #define HOTFIXES_FIELD_COUNT 3
 static struct column_list const TABLE_HOTFIXES[HOTFIXES_FIELD_COUNT+1] = {
@@ -852,6 +853,7 @@ int wdb_parse(char * input, char * output, int peer) {
         wdb_pool_leave(wdb);
         return result;
     } else if (strcmp(actor, "global") == 0) {
+        bool replica = false;
         query = next;
 
         w_inc_global();
@@ -859,7 +861,10 @@ int wdb_parse(char * input, char * output, int peer) {
         mdebug2("Global query: %s", query);
 
         gettimeofday(&begin, 0);
-        if (wdb = wdb_open_global(), !wdb) {
+        // Read-only commands don't wait for the writers, when the replica is available
+        if (wdb_replica_command(query) && (wdb = wdb_replica_get(), wdb)) {
+            replica = true;
+        } else if (wdb = wdb_open_global(), !wdb) {
             mdebug2("Couldn't open DB global: %s/%s.db", WDB2_DIR, WDB_GLOB_NAME);
             snprintf(output, OS_MAXSTR + 1, "err Couldn't open DB global");
             gettimeofday(&end, 0);
@@ -926,6 +931,20 @@ int wdb_parse(char * input, char * output, int peer) {
                 timersub(&end, &begin, &diff);
                 w_inc_global_agent_insert_agent_time(diff);
             }
+        } else if (strcmp(query, "insert-agents") == 0) {
+            w_inc_global_agent_insert_agent();
+            if (!next) {
+                mdebug1("Global DB Invalid DB query syntax for insert-agents.");
+                mdebug2("Global DB query error near: %s", query);
+                snprintf(output, OS_MAXSTR + 1, "err Invalid DB query syntax, near '%.32s'", query);
+                result = OS_INVALID;
+            } else {
+                gettimeofday(&begin, 0);
+                result = wdb_parse_global_insert_agents(wdb, next, output);
+                gettimeofday(&end, 0);
+                timersub(&end, &begin, &diff);
+                w_inc_global_agent_insert_agent_time(diff);
+            }
         } else if (strcmp(query, "update-agent-name") == 0) {
             w_inc_global_agent_update_agent_name();
             if (!next) {
@@ -982,6 +1001,20 @@ int wdb_parse(char * input, char * output, int peer) {
                 timersub(&end, &begin, &diff);
                 w_inc_global_agent_update_keepalive_time(diff);
             }
+        } else if (strcmp(query, "update-agents-keepalive") == 0) {
+            w_inc_global_agent_update_keepalive();
+            if (!next) {
+                mdebug1("Global DB Invalid DB query syntax for update-agents-keepalive.");
+                mdebug2("Global DB query error near: %s", query);
+                snprintf(output, OS_MAXSTR + 1, "err Invalid DB query syntax, near '%.32s'", query);
+                result = OS_INVALID;
+            } else {
+                gettimeofday(&begin, 0);
+                result = wdb_parse_global_update_agents_keepalive(wdb, next, output);
+                gettimeofday(&end, 0);
+                timersub(&end, &begin, &diff);
+                w_inc_global_agent_update_keepalive_time(diff);
+            }
         } else if (strcmp(query, "update-connection-status") == 0) {
             w_inc_global_agent_update_connection_status();
             if (!next) {
@@ -1400,6 +1433,10 @@ int wdb_parse(char * input, char * output, int peer) {
             snprintf(output, OS_MAXSTR + 1, "err Invalid DB query syntax, near '%.32s'", query);
             result = OS_INVALID;
         }
+        if (replica) {
+            wdb_replica_leave(wdb);
+            return result;
+        }
         if (result == OS_INVALID) {
             snprintf(path, sizeof(path), "%s/%s.db", WDB2_DIR, wdb->id);
             if (!w_is_file(path)) {
@@ -1824,6 +1861,15 @@ int wdb_parse_syscheck(wdb_t * wdb, wdb_component_t component, char * input, cha
             return OS_INVALID;
         }
 
+        snprintf(output, OS_MAXSTR + 1, "ok");
+        return 0;
+    } else if (strcmp(curr, "save_batch") == 0) {
+        if (wdb_syscheck_save_batch(wdb, next) == OS_INVALID) {
+            mdebug1("DB(%s) Cannot save FIM batch.", wdb->id);
+            snprintf(output, OS_MAXSTR + 1, "err Cannot save Syscheck batch");
+            return OS_INVALID;
+        }
+
         snprintf(output, OS_MAXSTR + 1, "ok");
         return 0;
     } else if (strncmp(curr, "integrity_check_", 16) == 0) {
@@ -1959,6 +2005,16 @@ int wdb_parse_syscollector(wdb_t * wdb, const char * query, char * input, char *
         snprintf(output, OS_MAXSTR + 1, "ok");
         return component;
     }
+    if (strcmp(curr, "save_batch") == 0) {
+        if (wdb_syscollector_save_batch(wdb, component, next) == OS_INVALID) {
+            mdebug1("DB(%s) Cannot save Syscollector batch.", wdb->id);
+            snprintf(output, OS_MAXSTR + 1, "err Cannot save Syscollector batch");
+            return OS_INVALID;
+        }
+
+        snprintf(output, OS_MAXSTR + 1, "ok");
+        return component;
+    }
     if (strncmp(curr, "integrity_check_", 16) == 0) {
         dbsync_msg action = INTEGRITY_CLEAR;
         if (0 == strcmp(curr, INTEGRITY_COMMANDS[INTEGRITY_CHECK_GLOBAL])) {
@@ -2339,7 +2395,24 @@ int wdb_parse_sca(wdb_t * wdb, char * input, char * output) {
         else
             scan_id = strtol(curr, NULL, 10);
 
-        if (result = wdb_sca_check_delete_distinct(wdb, policy_id, scan_id), result < 0) {
+        /* Optional range of check ids: <policy_id>|<scan_id>|<first>|<last> */
+        if (next = strchr(curr, '|'), next) {
+            int first;
+            int last;
+
+            if (sscanf(next, "|%d|%d", &first, &last) != 2) {
+                mdebug1("Invalid Security Configuration Assessment query syntax.");
+                mdebug2("Security Configuration Assessment query: %s", curr);
+                snprintf(output, OS_MAXSTR + 1, "err Invalid Security Configuration Assessment query syntax, near '%.32s'", curr);
+                return OS_INVALID;
+            }
+
+            result = wdb_sca_check_delete_distinct_range(wdb, policy_id, scan_id, first, last);
+        } else {
+            result = wdb_sca_check_delete_distinct(wdb, policy_id, scan_id);
+        }
+
+        if (result < 0) {
             mdebug1("Cannot delete Security Configuration Assessment checks.");
             snprintf(output, OS_MAXSTR + 1, "err Cannot delete Security Configuration Assessment checks.");
         } else {
@@ -2365,6 +2438,38 @@ int wdb_parse_sca(wdb_t * wdb, char * input, char * output) {
             wdb_sca_check_rules_delete(wdb);
         }
 
+        return result;
+    } else if (strcmp(curr, "query_results_range") == 0) {
+        char * policy_id;
+        char result_found[OS_MAXSTR - WDB_RESPONSE_BEGIN_SIZE] = {0};
+        int first;
+        int last;
+
+        curr = next;
+        policy_id = curr;
+
+        if (next = strchr(curr, '|'), !next || sscanf(next, "|%d|%d", &first, &last) != 2) {
+            mdebug1("Invalid Security Configuration Assessment query syntax.");
+            mdebug2("Security Configuration Assessment query: %s", curr);
+            snprintf(output, OS_MAXSTR + 1, "err Invalid Security Configuration Assessment query syntax, near '%.32s'", curr);
+            return OS_INVALID;
+        }
+
+        *next = '\0';
+        result = wdb_sca_checks_get_result_range(wdb, policy_id, first, last, result_found);
+
+        switch (result) {
+            case 0:
+                snprintf(output, OS_MAXSTR + 1, "ok not found");
+                break;
+            case 1:
+                snprintf(output, OS_MAXSTR + 1, "ok found %s", result_found);
+                break;
+            default:
+                mdebug1("Cannot query Security Configuration Assessment.");
+                snprintf(output, OS_MAXSTR + 1, "err Cannot query Security Configuration Assessment global");
+        }
+
         return result;
     } else if (strcmp(curr, "query_results") == 0) {
         char * policy_id;
@@ -5153,6 +5258,71 @@ int wdb_parse_global_insert_agent(wdb_t * wdb, char * input, char * output) {
     return OS_SUCCESS;
 }
 
+int wdb_parse_global_insert_agents(wdb_t * wdb, char * input, char * output) {
+    cJSON *agents_data = NULL;
+    cJSON *agent_data = NULL;
+    const char *error = NULL;
+    int total = 0;
+    int failed = 0;
+
+    agents_data = cJSON_ParseWithOpts(input, &error, TRUE);
+    if (!agents_data) {
+        mdebug1("Global DB Invalid JSON syntax when inserting agents.");
+        mdebug2("Global DB JSON error near: %s", error);
+        snprintf(output, OS_MAXSTR + 1, "err Invalid JSON syntax, near '%.32s'", input);
+        return OS_INVALID;
+    }
+
+    if (!cJSON_IsArray(agents_data)) {
+        mdebug1("Global DB Invalid JSON data when inserting agents.");
+        snprintf(output, OS_MAXSTR + 1, "err Invalid JSON data, near '%.32s'", input);
+        cJSON_Delete(agents_data);
+        return OS_INVALID;
+    }
+
+    // Every agent is inserted in the same transaction, a failed agent doesn't prevent the others
+    cJSON_ArrayForEach(agent_data, agents_data) {
+        cJSON *j_id = cJSON_GetObjectItem(agent_data, "id");
+        cJSON *j_name = cJSON_GetObjectItem(agent_data, "name");
+        cJSON *j_ip = cJSON_GetObjectItem(agent_data, "ip");
+        cJSON *j_register_ip = cJSON_GetObjectItem(agent_data, "register_ip");
+        cJSON *j_internal_key = cJSON_GetObjectItem(agent_data, "internal_key");
+        cJSON *j_group = cJSON_GetObjectItem(agent_data, "group");
+        cJSON *j_date_add = cJSON_GetObjectItem(agent_data, "date_add");
+
+        total++;
+
+        if (!cJSON_IsNumber(j_id) || !cJSON_IsString(j_name) || !j_name->valuestring || !cJSON_IsNumber(j_date_add)) {
+            mdebug1("Global DB Invalid JSON data when inserting agents. Not compliant with constraints defined in the database.");
+            failed++;
+            continue;
+        }
+
+        if (OS_SUCCESS != wdb_global_insert_agent(wdb,
+                                                  j_id->valueint,
+                                                  j_name->valuestring,
+                                                  cJSON_IsString(j_ip) ? j_ip->valuestring : NULL,
+                                                  cJSON_IsString(j_register_ip) ? j_register_ip->valuestring : NULL,
+                                                  cJSON_IsString(j_internal_key) ? j_internal_key->valuestring : NULL,
+                                                  cJSON_IsString(j_group) ? j_group->valuestring : NULL,
+                                                  j_date_add->valueint)) {
+            mdebug1("Global DB Cannot insert agent %d; err database %s/%s.db: %s", j_id->valueint, WDB2_DIR, WDB_GLOB_NAME, sqlite3_errmsg(wdb->db));
+            failed++;
+        }
+    }
+
+    wdb_global_group_hash_cache(WDB_GLOBAL_GROUP_HASH_CLEAR, NULL);
+    cJSON_Delete(agents_data);
+
+    if (failed) {
+        snprintf(output, OS_MAXSTR + 1, "err Cannot insert %d of %d agents", failed, total);
+        return OS_INVALID;
+    }
+
+    snprintf(output, OS_MAXSTR + 1, "ok");
+    return OS_SUCCESS;
+}
+
 int wdb_parse_global_update_agent_name(wdb_t * wdb, char * input, char * output) {
     cJSON *agent_data = NULL;
     const char *error = NULL;
@@ -5422,6 +5592,64 @@ int wdb_parse_global_update_agent_keepalive(wdb_t * wdb, char * input, char * ou
     return OS_SUCCESS;
 }
 
+int wdb_parse_global_update_agents_keepalive(wdb_t * wdb, char * input, char * output) {
+    cJSON *agents_data = NULL;
+    const char *error = NULL;
+    cJSON *j_connection_status = NULL;
+    cJSON *j_sync_status = NULL;
+    cJSON *j_agents = NULL;
+    cJSON *j_id = NULL;
+    int *ids = NULL;
+    size_t count = 0;
+    int result = OS_SUCCESS;
+
+    agents_data = cJSON_ParseWithOpts(input, &error, TRUE);
+    if (!agents_data) {
+        mdebug1("Global DB Invalid JSON syntax when updating agents keepalive.");
+        mdebug2("Global DB JSON error near: %s", error);
+        snprintf(output, OS_MAXSTR + 1, "err Invalid JSON syntax, near '%.32s'", input);
+        return OS_INVALID;
+    }
+
+    j_connection_status = cJSON_GetObjectItem(agents_data, "connection_status");
+    j_sync_status = cJSON_GetObjectItem(agents_data, "sync_status");
+    j_agents = cJSON_GetObjectItem(agents_data, "agents");
+
+    if (!cJSON_IsString(j_connection_status) || !cJSON_IsString(j_sync_status) || !cJSON_IsArray(j_agents)) {
+        mdebug1("Global DB Invalid JSON data when updating agents keepalive.");
+        snprintf(output, OS_MAXSTR + 1, "err Invalid JSON data, near '%.32s'", input);
+        cJSON_Delete(agents_data);
+        return OS_INVALID;
+    }
+
+    os_calloc(cJSON_GetArraySize(j_agents) + 1, sizeof(int), ids);
+
+    cJSON_ArrayForEach(j_id, j_agents) {
+        if (!cJSON_IsNumber(j_id)) {
+            mdebug1("Global DB Invalid JSON data when updating agents keepalive.");
+            snprintf(output, OS_MAXSTR + 1, "err Invalid JSON data, near '%.32s'", input);
+            os_free(ids);
+            cJSON_Delete(agents_data);
+            return OS_INVALID;
+        }
+
+        ids[count++] = j_id->valueint;
+    }
+
+    if (OS_SUCCESS != wdb_global_update_agents_keepalive(wdb, ids, count, j_connection_status->valuestring, j_sync_status->valuestring)) {
+        mdebug1("Global DB Cannot execute SQL query; err database %s/%s.db: %s", WDB2_DIR, WDB_GLOB_NAME, sqlite3_errmsg(wdb->db));
+        snprintf(output, OS_MAXSTR + 1, "err Cannot execute Global database query; %s", sqlite3_errmsg(wdb->db));
+        result = OS_INVALID;
+    } else {
+        snprintf(output, OS_MAXSTR + 1, "ok");
+    }
+
+    os_free(ids);
+    cJSON_Delete(agents_data);
+
+    return result;
+}
+
 int wdb_parse_global_update_connection_status(wdb_t * wdb, char * input, char * output) {
     cJSON *agent_data = NULL;
     const char *error = NULL;
@@ -6383,6 +6611,19 @@ bool process_dbsync_data(wdb_t * wdb, const struct kv * kv_value, const char * o
     return ret_val;
 }
 
+int wdb_dbsync_process(wdb_t * wdb, const char * table_key, const char * operation, const char * data) {
+    struct kv_list const *head = TABLE_MAP;
+
+    while (NULL != head) {
+        if (strncmp(head->current.key, table_key, OS_SIZE_256 - 1) == 0) {
+            return process_dbsync_data(wdb, &head->current, operation, data) ? OS_SUCCESS : OS_INVALID;
+        }
+        head = head->next;
+    }
+
+    return OS_INVALID;
+}
+
 int wdb_parse_dbsync(wdb_t * wdb, char * input, char * output) {
     int ret_val = OS_INVALID;
     char *next = NULL;
@@ -6412,15 +6653,7 @@ int wdb_parse_dbsync(wdb_t * wdb, char * input, char * output) {
         return ret_val;
     }
 
-    char *data = curr;
-    struct kv_list const *head = TABLE_MAP;
-    while (NULL != head) {
-        if (strncmp(head->current.key, table_key, OS_SIZE_256 - 1) == 0) {
-            ret_val = process_dbsync_data(wdb, &head->current, operation, data) ? OS_SUCCESS : OS_INVALID;
-            break;
-        }
-        head = head->next;
-    }
+    ret_val = wdb_dbsync_process(wdb, table_key, operation, curr);
 
     if (OS_SUCCESS == ret_val) {
         strcat(output, "ok ");
@@ -6527,12 +6760,27 @@ int wdb_parse_task_upgrade_update_status(wdb_t* wdb, const cJSON *parameters, ch
     char *status = NULL;
     char *error = NULL;
 
+    // Several agents can be updated at once with an "agents" array
+    cJSON *agents_json = cJSON_GetObjectItem(parameters, "agents");
     cJSON *agent_id_json = cJSON_GetObjectItem(parameters, "agent");
-    if (!agent_id_json || (agent_id_json->type != cJSON_Number)) {
+    if (agents_json) {
+        cJSON *item = NULL;
+        if (agents_json->type != cJSON_Array) {
+            snprintf(output, OS_MAXSTR + 1, "err Error upgrade update status task: 'parsing agent error'");
+            return OS_INVALID;
+        }
+        cJSON_ArrayForEach(item, agents_json) {
+            if (item->type != cJSON_Number) {
+                snprintf(output, OS_MAXSTR + 1, "err Error upgrade update status task: 'parsing agent error'");
+                return OS_INVALID;
+            }
+        }
+    } else if (!agent_id_json || (agent_id_json->type != cJSON_Number)) {
         snprintf(output, OS_MAXSTR + 1, "err Error upgrade update status task: 'parsing agent error'");
         return OS_INVALID;
+    } else {
+        agent_id = agent_id_json->valueint;
     }
-    agent_id = agent_id_json->valueint;
 
     cJSON *node_json = cJSON_GetObjectItem(parameters, "node");
     if (!node_json || (node_json->type != cJSON_String)) {
@@ -6553,12 +6801,35 @@ int wdb_parse_task_upgrade_update_status(wdb_t* wdb, const cJSON *parameters, ch
         error = error_json->valuestring;
     }
 
-    result = wdb_task_update_upgrade_task_status(wdb, agent_id, node, status, error);
-
     cJSON *response = cJSON_CreateObject();
     char *out = NULL;
 
-    cJSON_AddNumberToObject(response, "error", result);
+    if (agents_json) {
+        cJSON *agents_response = cJSON_CreateArray();
+        cJSON *item = NULL;
+
+        result = OS_SUCCESS;
+
+        cJSON_ArrayForEach(item, agents_json) {
+            int agent_result = wdb_task_update_upgrade_task_status(wdb, item->valueint, node, status, error);
+            cJSON *agent_response = cJSON_CreateObject();
+
+            cJSON_AddNumberToObject(agent_response, "agent", item->valueint);
+            cJSON_AddNumberToObject(agent_response, "error", agent_result);
+            cJSON_AddItemToArray(agents_response, agent_response);
+
+            if (agent_result == OS_INVALID) {
+                result = OS_INVALID;
+            }
+        }
+
+        cJSON_AddNumberToObject(response, "error", result);
+        cJSON_AddItemToObject(response, "agents", agents_response);
+    } else {
+        result = wdb_task_update_upgrade_task_status(wdb, agent_id, node, status, error);
+        cJSON_AddNumberToObject(response, "error", result);
+    }
+
     out = cJSON_PrintUnformatted(response);
 
     snprintf(output, OS_MAXSTR + 1, "ok %s", out);
@@ -87,6 +87,62 @@ char ** wdb_pool_keys() {
     return keys;
 }
 
+typedef struct {
+    char * key;
+    time_t last;
+} wdb_pool_idle_t;
+
+static int wdb_pool_idle_cmp(const void * a, const void * b) {
+    const wdb_pool_idle_t * node_a = a;
+    const wdb_pool_idle_t * node_b = b;
+
+    return (node_a->last > node_b->last) - (node_a->last < node_b->last);
+}
+
+// Get the names of the open databases that are not in use, from the least recently used.
+
+char ** wdb_pool_idle_keys(unsigned * open) {
+    w_mutex_lock(&wdb_pool.mutex);
+    char ** keys = rbtree_keys(wdb_pool.nodes);
+    size_t size = strarray_size(keys);
+    wdb_pool_idle_t * idle;
+    size_t count = 0;
+
+    os_malloc(sizeof(wdb_pool_idle_t) * (size + 1), idle);
+    *open = 0;
+
+    for (size_t i = 0; i < size; i++) {
+        wdb_t * node = rbtree_get(wdb_pool.nodes, keys[i]);
+
+        if (node == NULL || node->db == NULL) {
+            os_free(keys[i]);
+            continue;
+        }
+
+        (*open)++;
+
+        if (node->refcount == 0) {
+            idle[count].key = keys[i];
+            idle[count++].last = node->last;
+        } else {
+            os_free(keys[i]);
+        }
+    }
+
+    w_mutex_unlock(&wdb_pool.mutex);
+
+    qsort(idle, count, sizeof(wdb_pool_idle_t), wdb_pool_idle_cmp);
+
+    for (size_t i = 0; i < count; i++) {
+        keys[i] = idle[i].key;
+    }
+
+    keys[count] = NULL;
+    os_free(idle);
+
+    return keys;
+}
+
 // Remove closed databases from the pool.
 
 void wdb_pool_clean() {
@@ -62,6 +62,17 @@ void wdb_pool_leave(wdb_t * node);
  */
 char ** wdb_pool_keys();
 
+/**
+ * @brief Get the names of the open databases that are not in use.
+ *
+ * The names are sorted by the time of the last query, from the least recently
+ * used, so the databases that keep receiving queries are closed last.
+ *
+ * @param[out] open Number of open databases in the pool, in use or not.
+ * @return String array containing the names of the idle databases.
+ */
+char ** wdb_pool_idle_keys(unsigned * open);
+
 /**
  * @brief Remove closed databases from the pool.
  *
@@ -0,0 +1,161 @@
+/*
+ * Wazuh DB read-only replica of the global database
+ * Copyright (C) 2015, Wazuh Inc.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "wdb_replica.h"
+
+#ifdef WAZUH_UNIT_TESTING
+// Remove static qualifier when unit testing
+#define STATIC
+#else
+#define STATIC static
+#endif
+
+// Global commands that don't write into the database
+static const char * WDB_REPLICA_COMMANDS[] = {
+    "get-labels",
+    "select-agent-name",
+    "select-agent-group",
+    "find-agent",
+    "find-group",
+    "select-group-belong",
+    "get-group-agents",
+    "select-groups",
+    "get-groups-integrity",
+    "get-all-agents",
+    "get-distinct-groups",
+    "get-agent-info",
+    "get-agents-by-connection-status",
+    NULL
+};
+
+STATIC wdb_t ** wdb_replica_nodes;
+STATIC unsigned wdb_replica_size;
+static _Atomic(unsigned) wdb_replica_turn;
+
+// Open a read-only connection. The database must be in WAL mode, otherwise the readers would block the writers.
+STATIC int wdb_replica_open(wdb_t * wdb) {
+    char path[PATH_MAX + 1];
+    sqlite3_stmt * stmt = NULL;
+    bool wal = false;
+
+    snprintf(path, sizeof(path), "%s/%s.db", WDB2_DIR, WDB_GLOB_NAME);
+
+    if (sqlite3_open_v2(path, &wdb->db, SQLITE_OPEN_READONLY, NULL)) {
+        mdebug1("Can't open SQLite database '%s' for reading: %s", path, sqlite3_errmsg(wdb->db));
+        wdb_close(wdb, false);
+        return OS_INVALID;
+    }
+
+    if (sqlite3_prepare_v2(wdb->db, "PRAGMA journal_mode;", -1, &stmt, NULL) == SQLITE_OK) {
+        if (sqlite3_step(stmt) == SQLITE_ROW) {
+            const char * mode = (const char *)sqlite3_column_text(stmt, 0);
+            wal = mode != NULL && strcmp(mode, "wal") == 0;
+        }
+
+        sqlite3_finalize(stmt);
+    }
+
+    if (!wal) {
+        mdebug1("Global database is not in WAL mode yet. Reading from the main connection.");
+        wdb_close(wdb, false);
+        return OS_INVALID;
+    }
+
+    return OS_SUCCESS;
+}
+
+void wdb_replica_init(int size) {
+    if (size <= 0) {
+        return;
+    }
+
+    os_calloc(size, sizeof(wdb_t *), wdb_replica_nodes);
+
+    for (int i = 0; i < size; i++) {
+        wdb_replica_nodes[i] = wdb_init(WDB_GLOB_NAME);
+    }
+
+    wdb_replica_size = size;
+}
+
+bool wdb_replica_enabled() {
+    return wdb_replica_size > 0;
+}
+
+bool wdb_replica_command(const char * command) {
+    size_t length = strcspn(command, " ");
+
+    for (int i = 0; WDB_REPLICA_COMMANDS[i]; i++) {
+        if (strlen(WDB_REPLICA_COMMANDS[i]) == length && strncmp(command, WDB_REPLICA_COMMANDS[i], length) == 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+wdb_t * wdb_replica_get() {
+    wdb_t * wdb = NULL;
+
+    if (wdb_replica_size == 0) {
+        return NULL;
+    }
+
+    unsigned turn = wdb_replica_turn++;
+
+    // Take the first free connection, or wait for the one of this turn
+    for (unsigned i = 0; i < wdb_replica_size; i++) {
+        wdb_t * node = wdb_replica_nodes[(turn + i) % wdb_replica_size];
+
+        if (pthread_mutex_trylock(&node->mutex) == 0) {
+            wdb = node;
+            break;
+        }
+    }
+
+    if (wdb == NULL) {
+        wdb = wdb_replica_nodes[turn % wdb_replica_size];
+        w_mutex_lock(&wdb->mutex);
+    }
+
+    if (wdb->db == NULL && wdb_replica_open(wdb) != OS_SUCCESS) {
+        w_mutex_unlock(&wdb->mutex);
+        return NULL;
+    }
+
+    return wdb;
+}
+
+void wdb_replica_leave(wdb_t * wdb) {
+    if (wdb) {
+        // A connection that can't end its transaction would keep its snapshot forever
+        if (wdb->transaction && wdb_commit2(wdb) < 0) {
+            wdb_close(wdb, false);
+            wdb->transaction = 0;
+        }
+
+        wdb->last = time(NULL);
+        w_mutex_unlock(&wdb->mutex);
+    }
+}
+
+void wdb_replica_close() {
+    for (unsigned i = 0; i < wdb_replica_size; i++) {
+        wdb_t * wdb = wdb_replica_nodes[i];
+
+        w_mutex_lock(&wdb->mutex);
+
+        if (wdb->db != NULL) {
+            wdb_close(wdb, false);
+        }
+
+        w_mutex_unlock(&wdb->mutex);
+    }
+}
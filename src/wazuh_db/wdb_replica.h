@@ -0,0 +1,76 @@
+/*
+ * Wazuh DB read-only replica of the global database
+ * Copyright (C) 2015, Wazuh Inc.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+/**
+ * Read-only connections to global.db.
+ *
+ * The queries that only read the global database (the agent and group
+ * lookups of the API and the cluster) are served through their own
+ * connections instead of the pooled read-write node. In WAL mode, each
+ * query reads a snapshot of the database, so the readers never wait for
+ * the writers and the writers never wait for the readers.
+ */
+
+#pragma once
+
+#include "wdb.h"
+
+/**
+ * @brief Open the replica with a number of read-only connections
+ *
+ * @param size Number of connections. 0 disables the replica.
+ */
+void wdb_replica_init(int size);
+
+/**
+ * @brief Check whether the replica is enabled
+ *
+ * @return true if the read-only queries can use the replica.
+ */
+bool wdb_replica_enabled();
+
+/**
+ * @brief Check whether a global command only reads the database
+ *
+ * @param command Command of the global actor, followed or not by its arguments.
+ * @return true if the command can be served by the replica.
+ */
+bool wdb_replica_command(const char * command);
+
+/**
+ * @brief Take a read-only connection of the replica
+ *
+ * Takes a free connection, or waits for one of them. The connection is
+ * opened (or reopened after wdb_replica_close()) on demand.
+ *
+ * @post The node's mutex gets locked.
+ * @return Pointer to the database node.
+ * @retval NULL The replica is disabled or the database couldn't be opened.
+ */
+wdb_t * wdb_replica_get();
+
+/**
+ * @brief Leave a connection of the replica
+ *
+ * Ends the read transaction, so the next query reads a newer snapshot and
+ * the write-ahead log can be checkpointed.
+ *
+ * @param wdb Pointer to a database node taken with wdb_replica_get().
+ * @post The node's mutex gets unlocked.
+ */
+void wdb_replica_leave(wdb_t * wdb);
+
+/**
+ * @brief Close all the connections of the replica
+ *
+ * The connections are reopened on demand. Call it before the global
+ * database file is replaced.
+ */
+void wdb_replica_close();
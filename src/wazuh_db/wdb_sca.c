@@ -226,6 +226,36 @@ int wdb_sca_check_delete_distinct(wdb_t * wdb,char * policy_id,int scan_id) {
     }
 }
 
+/* Delete distinct configuration assessment check whose id is between first and last. Returns 0 on success or -1 on error */
+int wdb_sca_check_delete_distinct_range(wdb_t * wdb, char * policy_id, int scan_id, int first, int last) {
+
+    if (!wdb->transaction && wdb_begin2(wdb) < 0){
+        mdebug1("cannot begin transaction");
+        return -1;
+    }
+
+    sqlite3_stmt *stmt = NULL;
+
+    if (wdb_stmt_cache(wdb, WDB_STMT_SCA_CHECK_DELETE_DISTINCT_RANGE) < 0) {
+        mdebug1("at wdb_sca_check_delete_distinct_range(): cannot cache statement");
+        return -1;
+    }
+
+    stmt = wdb->stmt[WDB_STMT_SCA_CHECK_DELETE_DISTINCT_RANGE];
+
+    sqlite3_bind_int(stmt, 1, scan_id);
+    sqlite3_bind_text(stmt, 2, policy_id, -1, NULL);
+    sqlite3_bind_int(stmt, 3, first);
+    sqlite3_bind_int(stmt, 4, last);
+
+    if (wdb_step(stmt) == SQLITE_DONE) {
+        return 0;
+    } else {
+        merror("SQLite: %s", sqlite3_errmsg(wdb->db));
+        return -1;
+    }
+}
+
 int wdb_sca_check_delete(wdb_t * wdb,char * policy_id) {
 
     if (!wdb->transaction && wdb_begin2(wdb) < 0){
@@ -597,6 +627,9 @@ int wdb_sca_scan_info_update_start(wdb_t * wdb, char * policy_id, int start_scan
     }
 }
 
+/* Hash the results selected by a statement, in the same way as the agent. Returns 1 if found, 0 if not, or -1 on error. */
+static int wdb_sca_checks_hash_result(wdb_t * wdb, sqlite3_stmt * stmt, char * output);
+
 /* Gets the result of all checks in Wazuh DB. Returns 1 if found, 0 if not, or -1 on error. (new) */
 int wdb_sca_checks_get_result(wdb_t * wdb, char * policy_id, char * output) {
 
@@ -616,6 +649,34 @@ int wdb_sca_checks_get_result(wdb_t * wdb, char * policy_id, char * output) {
 
     sqlite3_bind_text(stmt, 1, policy_id,-1, NULL);
 
+    return wdb_sca_checks_hash_result(wdb, stmt, output);
+}
+
+/* Gets the result of the checks whose id is between first and last. Returns 1 if found, 0 if not, or -1 on error. */
+int wdb_sca_checks_get_result_range(wdb_t * wdb, char * policy_id, int first, int last, char * output) {
+
+    if (!wdb->transaction && wdb_begin2(wdb) < 0){
+        mdebug1("cannot begin transaction");
+        return -1;
+    }
+
+    sqlite3_stmt *stmt = NULL;
+
+    if (wdb_stmt_cache(wdb, WDB_STMT_SCA_CHECK_GET_RANGE_RESULTS) < 0) {
+        mdebug1("cannot cache statement");
+        return -1;
+    }
+
+    stmt = wdb->stmt[WDB_STMT_SCA_CHECK_GET_RANGE_RESULTS];
+
+    sqlite3_bind_text(stmt, 1, policy_id, -1, NULL);
+    sqlite3_bind_int(stmt, 2, first);
+    sqlite3_bind_int(stmt, 3, last);
+
+    return wdb_sca_checks_hash_result(wdb, stmt, output);
+}
+
+static int wdb_sca_checks_hash_result(wdb_t * wdb, sqlite3_stmt * stmt, char * output) {
     char *str = NULL;
     int has_result = 0;
 
@@ -34,6 +34,8 @@ STATIC uint64_t get_task_time(wdb_state_t *state);
 
 STATIC uint64_t get_time_total(wdb_state_t *state);
 
+STATIC cJSON* latency_histogram_json(const latency_histogram_t *histogram);
+
 wdb_state_t wdb_state = {0};
 pthread_mutex_t db_state_t_mutex = PTHREAD_MUTEX_INITIALIZER;
 
@@ -1031,6 +1033,65 @@ void w_inc_mitre_sql_time(struct timeval time) {
     w_mutex_unlock(&db_state_t_mutex);
 }
 
+void w_inc_query_latency(const char *query, struct timeval time) {
+    static const uint64_t bounds[] = WDB_LATENCY_BOUNDS;
+    const uint64_t usec = time.tv_sec * (uint64_t)1000000 + time.tv_usec;
+    latency_histogram_t *histogram;
+    size_t length;
+    int i;
+
+    query += strspn(query, " \n");
+    length = strcspn(query, " ");
+
+    if (length == 5 && strncmp(query, "agent", 5) == 0) {
+        histogram = &wdb_state.latency.agent;
+    } else if (length == 6 && strncmp(query, "global", 6) == 0) {
+        histogram = &wdb_state.latency.global;
+    } else if (length == 5 && strncmp(query, "mitre", 5) == 0) {
+        histogram = &wdb_state.latency.mitre;
+    } else if (length == 4 && strncmp(query, "task", 4) == 0) {
+        histogram = &wdb_state.latency.task;
+    } else if (length == 7 && strncmp(query, "wazuhdb", 7) == 0) {
+        histogram = &wdb_state.latency.wazuhdb;
+    } else {
+        return;
+    }
+
+    for (i = 0; i < WDB_LATENCY_BUCKETS - 1; i++) {
+        if (usec < bounds[i]) {
+            break;
+        }
+    }
+
+    w_mutex_lock(&db_state_t_mutex);
+    histogram->buckets[i]++;
+    w_mutex_unlock(&db_state_t_mutex);
+}
+
+void w_inc_checkpoint(int pages, bool incomplete, struct timeval time) {
+    w_mutex_lock(&db_state_t_mutex);
+    wdb_state.checkpoint.checkpoints++;
+    wdb_state.checkpoint.pages += pages;
+
+    if (incomplete) {
+        wdb_state.checkpoint.incomplete++;
+    }
+
+    timeradd(&wdb_state.checkpoint.time, &time, &wdb_state.checkpoint.time);
+    w_mutex_unlock(&db_state_t_mutex);
+}
+
+STATIC cJSON* latency_histogram_json(const latency_histogram_t *histogram) {
+    static const char *labels[WDB_LATENCY_BUCKETS] = { "under_0.1ms", "under_1ms", "under_10ms", "under_100ms", "under_1s", "over_1s" };
+    cJSON *_histogram = cJSON_CreateObject();
+
+    for (int i = 0; i < WDB_LATENCY_BUCKETS; i++) {
+        cJSON_AddNumberToObject(_histogram, labels[i], histogram->buckets[i]);
+    }
+
+    return _histogram;
+}
+
 cJSON* wdb_create_state_json() {
     wdb_state_t wdb_state_cpy;
 
@@ -1049,6 +1110,23 @@ cJSON* wdb_create_state_json() {
 
     // Fields within metrics are sorted alphabetically
 
+    cJSON *_checkpoint = cJSON_CreateObject();
+    cJSON_AddItemToObject(_metrics, "checkpoint", _checkpoint);
+
+    cJSON_AddNumberToObject(_checkpoint, "count", wdb_state_cpy.checkpoint.checkpoints);
+    cJSON_AddNumberToObject(_checkpoint, "incomplete", wdb_state_cpy.checkpoint.incomplete);
+    cJSON_AddNumberToObject(_checkpoint, "pages", wdb_state_cpy.checkpoint.pages);
+    cJSON_AddNumberToObject(_checkpoint, "time", timeval_to_milis(wdb_state_cpy.checkpoint.time));
+
+    cJSON *_latency = cJSON_CreateObject();
+    cJSON_AddItemToObject(_metrics, "latency", _latency);
+
+    cJSON_AddItemToObject(_latency, "agent", latency_histogram_json(&wdb_state_cpy.latency.agent));
+    cJSON_AddItemToObject(_latency, "global", latency_histogram_json(&wdb_state_cpy.latency.global));
+    cJSON_AddItemToObject(_latency, "mitre", latency_histogram_json(&wdb_state_cpy.latency.mitre));
+    cJSON_AddItemToObject(_latency, "task", latency_histogram_json(&wdb_state_cpy.latency.task));
+    cJSON_AddItemToObject(_latency, "wazuhdb", latency_histogram_json(&wdb_state_cpy.latency.wazuhdb));
+
     cJSON *_queries = cJSON_CreateObject();
     cJSON_AddItemToObject(_metrics, "queries", _queries);
 
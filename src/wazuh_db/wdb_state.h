@@ -255,10 +255,35 @@ typedef struct _queries_breakdown_t {
     wazuhdb_breakdown_t wazuhdb_breakdown;
 } queries_breakdown_t;
 
+/* Upper bounds of the latency buckets, in microseconds. The last bucket has no bound */
+#define WDB_LATENCY_BOUNDS { 100, 1000, 10000, 100000, 1000000 }
+#define WDB_LATENCY_BUCKETS 6
+
+typedef struct _latency_histogram_t {
+    uint64_t buckets[WDB_LATENCY_BUCKETS];
+} latency_histogram_t;
+
+typedef struct _latency_breakdown_t {
+    latency_histogram_t agent;
+    latency_histogram_t global;
+    latency_histogram_t mitre;
+    latency_histogram_t task;
+    latency_histogram_t wazuhdb;
+} latency_breakdown_t;
+
+typedef struct _checkpoint_breakdown_t {
+    uint64_t checkpoints;
+    uint64_t incomplete;                // Checkpoints that left pages in the log, held by readers
+    uint64_t pages;
+    struct timeval time;
+} checkpoint_breakdown_t;
+
 typedef struct _db_stats_t {
     uint64_t uptime;
     uint64_t queries_total;
     queries_breakdown_t queries_breakdown;
+    latency_breakdown_t latency;
+    checkpoint_breakdown_t checkpoint;
 } wdb_state_t;
 
 /* Status functions */
@@ -1298,6 +1323,23 @@ void w_inc_mitre_sql();
  */
 void w_inc_mitre_sql_time(struct timeval time);
 
+/**
+ * @brief Add a query to the latency histogram of its database type
+ *
+ * @param query Query received, only the first word (agent, global, mitre, task or wazuhdb) is read.
+ * @param time Time taken to answer the query.
+ */
+void w_inc_query_latency(const char *query, struct timeval time);
+
+/**
+ * @brief Count a checkpoint of the write-ahead log of a database
+ *
+ * @param pages Pages written back to the database file.
+ * @param incomplete Whether some pages were left in the log.
+ * @param time Time taken by the checkpoint.
+ */
+void w_inc_checkpoint(int pages, bool incomplete, struct timeval time);
+
 /**
  * @brief Create a JSON object with all the wazuh-db state information
  * @return JSON object
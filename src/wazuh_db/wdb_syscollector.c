@@ -1274,22 +1274,9 @@ int wdb_syscollector_osinfo_save2(wdb_t * wdb, const cJSON * attributes)
 }
 
 
-int wdb_syscollector_save2(wdb_t * wdb, wdb_component_t component, const char * payload)
+static int wdb_syscollector_save_attributes(wdb_t * wdb, wdb_component_t component, const cJSON * attributes)
 {
     int result = -1;
-    cJSON * data = cJSON_Parse(payload);
-    if(!data)
-    {
-        mdebug1("at wdb_syscollector_save2(): no payload");
-        return -1;
-    }
-    cJSON * attributes = cJSON_GetObjectItem(data, "attributes");
-    if(!attributes)
-    {
-        cJSON_Delete(data);
-        mdebug1("at wdb_syscollector_save2(): no attributes");
-        return -1;
-    }
     if(component == WDB_SYSCOLLECTOR_PROCESSES)
     {
         result = wdb_syscollector_processes_save2(wdb, attributes);
@@ -1326,6 +1313,66 @@ int wdb_syscollector_save2(wdb_t * wdb, wdb_component_t component, const char *
     {
         result = wdb_syscollector_osinfo_save2(wdb, attributes);
     }
+    return result;
+}
+
+int wdb_syscollector_save2(wdb_t * wdb, wdb_component_t component, const char * payload)
+{
+    int result = -1;
+    cJSON * data = cJSON_Parse(payload);
+    if(!data)
+    {
+        mdebug1("at wdb_syscollector_save2(): no payload");
+        return -1;
+    }
+    cJSON * attributes = cJSON_GetObjectItem(data, "attributes");
+    if(!attributes)
+    {
+        cJSON_Delete(data);
+        mdebug1("at wdb_syscollector_save2(): no attributes");
+        return -1;
+    }
+    result = wdb_syscollector_save_attributes(wdb, component, attributes);
     cJSON_Delete(data);
     return result;
 }
+
+int wdb_syscollector_save_batch(wdb_t * wdb, wdb_component_t component, const char * payload)
+{
+    int result = -1;
+    cJSON * batch = cJSON_Parse(payload);
+    cJSON * entry = NULL;
+
+    if(!cJSON_IsArray(batch))
+    {
+        mdebug1("at wdb_syscollector_save_batch(): invalid batch");
+        goto end;
+    }
+
+    // The whole batch is stored in the same transaction, with the cached statement of the component
+    if(!wdb->transaction && wdb_begin2(wdb) < 0)
+    {
+        mdebug1("at wdb_syscollector_save_batch(): cannot begin transaction");
+        goto end;
+    }
+
+    result = 0;
+
+    cJSON_ArrayForEach(entry, batch)
+    {
+        cJSON * attributes = cJSON_GetObjectItem(entry, "attributes");
+        if(!attributes)
+        {
+            mdebug1("at wdb_syscollector_save_batch(): no attributes");
+            result = -1;
+        }
+        else if(wdb_syscollector_save_attributes(wdb, component, attributes) < 0)
+        {
+            result = -1;
+        }
+    }
+
+end:
+    cJSON_Delete(batch);
+    return result;
+}
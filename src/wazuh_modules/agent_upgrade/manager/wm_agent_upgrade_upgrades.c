@@ -36,6 +36,28 @@ typedef struct _wm_upgrade_args {
     wm_agent_task *agent_task;
 } wm_upgrade_args;
 
+/* WPK file kept in memory while it's being sent to the agents */
+typedef struct _wm_upgrade_wpk {
+    char *path;
+    time_t mtime;
+    off_t size;
+    char *data;
+    unsigned int refs;
+    struct _wm_upgrade_wpk *next;
+} wm_upgrade_wpk;
+
+/* Maximum memory used by the cached WPK files */
+#define WM_UPGRADE_WPK_CACHE_SIZE (256 * 1024 * 1024)
+
+/* Round trip times to grow or shrink the chunks sent to an agent */
+#define WM_UPGRADE_CHUNK_RTT_LOW 0.1
+#define WM_UPGRADE_CHUNK_RTT_HIGH 1.0
+
+/* Cached WPK files, only used when the upgrade queue is running */
+STATIC wm_upgrade_wpk *wpk_cache;
+STATIC int wpk_cache_enabled;
+static pthread_mutex_t wpk_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+
 /**
  * Main function of upgrade threads
  * @param arg Upgrade arguments structure
@@ -84,13 +106,36 @@ STATIC int wm_agent_upgrade_send_open(int agent_id, int wpk_message_format, cons
  * @param wpk_message_format 1 for new format, 0 for old
  * @param wpk_file name of the file to write in the agent
  * @param file_path name of the file to read in the manager
- * @param chunk_size size of block to send WPK file
+ * @param chunk_size initial size of block to send WPK file, it grows while the agent answers quickly
  * @return error code
  * @retval OS_SUCCESS on success
  * @retval OS_INVALID on errors
  * */
 STATIC int wm_agent_upgrade_send_write(int agent_id, int wpk_message_format, const char *wpk_file, const char *file_path, int chunk_size) __attribute__((nonnull));
 
+/**
+ * Get a WPK file from the cache, loading it if it's not there or it changed
+ * @param file_path path of the WPK file
+ * @return cached WPK file, to be released with wm_agent_upgrade_release_wpk
+ * @retval NULL if the cache is disabled or the file can't be cached
+ * */
+STATIC wm_upgrade_wpk* wm_agent_upgrade_get_wpk(const char *file_path) __attribute__((nonnull));
+
+/**
+ * Release a WPK file got from the cache
+ * @param wpk cached WPK file
+ * */
+STATIC void wm_agent_upgrade_release_wpk(wm_upgrade_wpk *wpk) __attribute__((nonnull));
+
+/**
+ * Size of the next chunk sent to an agent, depending on the round trip time of the last one
+ * @param current size of the last chunk
+ * @param min configured chunk size
+ * @param rtt round trip time of the last chunk, in seconds
+ * @return size of the next chunk, between min and WM_UPGRADE_CHUNK_SIZE_MAX
+ * */
+STATIC int wm_agent_upgrade_next_chunk_size(int current, int min, double rtt);
+
 /**
  * Send a close file command to an agent
  * @param agent_id id of the agent
@@ -128,10 +173,28 @@ STATIC int wm_agent_upgrade_send_upgrade(int agent_id, int wpk_message_format, c
 
 void wm_agent_upgrade_init_upgrade_queue() {
     upgrade_queue = linked_queue_init();
+    wpk_cache_enabled = 1;
 }
 
 void wm_agent_upgrade_destroy_upgrade_queue() {
     linked_queue_free(upgrade_queue);
+
+    w_mutex_lock(&wpk_cache_mutex);
+    wpk_cache_enabled = 0;
+
+    // The files still being sent are left to their threads
+    for (wm_upgrade_wpk **prev = &wpk_cache, *wpk; wpk = *prev, wpk; ) {
+        if (!wpk->refs) {
+            *prev = wpk->next;
+            os_free(wpk->path);
+            os_free(wpk->data);
+            os_free(wpk);
+        } else {
+            prev = &wpk->next;
+        }
+    }
+
+    w_mutex_unlock(&wpk_cache_mutex);
 }
 
 void wm_agent_upgrade_prepare_upgrades() {
@@ -422,21 +485,45 @@ STATIC int wm_agent_upgrade_send_write(int agent_id, int wpk_message_format, con
     int result = OS_INVALID;
     char *command = NULL;
     char *response = NULL;
-    char buffer[chunk_size];
+    char *buffer = NULL;
+    const char *chunk = NULL;
     size_t bytes = 0;
     size_t command_size = 0;
+    off_t offset = 0;
+    int block_size = chunk_size;
+    struct timespec sent;
+    struct timespec received;
+    FILE *file = NULL;
 
-    os_calloc(OS_MAXSTR, sizeof(char), command);
+    // The WPK is read from disk only if it can't be cached
+    wm_upgrade_wpk *wpk = wm_agent_upgrade_get_wpk(file_path);
 
-    FILE *file = wfopen(file_path, "rb");
-    if (file) {
-        while (bytes = fread(buffer, 1, sizeof(buffer), file), bytes) {
+    if (wpk || (file = wfopen(file_path, "rb"), file)) {
+        os_calloc(OS_MAXSTR, sizeof(char), command);
+
+        if (!wpk) {
+            os_malloc(WM_UPGRADE_CHUNK_SIZE_MAX, buffer);
+        }
+
+        while (1) {
+            if (wpk) {
+                bytes = (wpk->size - offset < block_size) ? (size_t)(wpk->size - offset) : (size_t)block_size;
+                chunk = wpk->data + offset;
+                offset += bytes;
+            } else {
+                bytes = fread(buffer, 1, block_size, file);
+                chunk = buffer;
+            }
+
+            if (!bytes) {
+                break;
+            }
 
             if (wpk_message_format >= 0) {
                 cJSON *command_info = cJSON_CreateObject();
                 cJSON_AddStringToObject(command_info, task_manager_json_keys[WM_TASK_COMMAND], "write");
                 cJSON *params = cJSON_CreateObject();
-                char *base64 = encode_base64(bytes, buffer);
+                char *base64 = encode_base64(bytes, chunk);
                 cJSON_AddStringToObject(params, "buffer", base64);
                 cJSON_AddNumberToObject(params, "length", bytes);
                 cJSON_AddStringToObject(params, "file", wpk_file);
@@ -451,14 +538,18 @@ STATIC int wm_agent_upgrade_send_write(int agent_id, int wpk_message_format, con
                 snprintf(command, OS_MAXSTR, "%.3d com write %ld %s ", agent_id, bytes, wpk_file);
                 command_size = strlen(command);
                 for (size_t byte = 0; byte < bytes; ++byte) {
-                    sprintf(&command[command_size++], "%c", buffer[byte]);
+                    sprintf(&command[command_size++], "%c", chunk[byte]);
                 }
             }
 
             os_free(response);
+            gettime(&sent);
             response = wm_agent_upgrade_send_command_to_agent(command, command_size);
+            gettime(&received);
             if (wpk_message_format >= 0) {
                 result = wm_agent_upgrade_parse_agent_upgrade_command_response(response, NULL);
+                // Legacy agents keep the configured chunk size
+                block_size = wm_agent_upgrade_next_chunk_size(block_size, chunk_size, time_diff(&sent, &received));
             } else {
                 result = wm_agent_upgrade_parse_agent_response(response, NULL);
             }
@@ -466,15 +557,124 @@ STATIC int wm_agent_upgrade_send_write(int agent_id, int wpk_message_format, con
                 break;
             }
         }
-        fclose(file);
+
+        if (wpk) {
+            wm_agent_upgrade_release_wpk(wpk);
+        } else {
+            fclose(file);
+        }
     }
 
+    os_free(buffer);
     os_free(command);
     os_free(response);
 
     return result;
 }
 
+STATIC wm_upgrade_wpk* wm_agent_upgrade_get_wpk(const char *file_path) {
+    wm_upgrade_wpk *wpk = NULL;
+    wm_upgrade_wpk **prev = NULL;
+    struct stat file_stat;
+    off_t cache_size = 0;
+
+    w_mutex_lock(&wpk_cache_mutex);
+
+    if (!wpk_cache_enabled || stat(file_path, &file_stat) < 0 || file_stat.st_size > WM_UPGRADE_WPK_CACHE_SIZE) {
+        w_mutex_unlock(&wpk_cache_mutex);
+        return NULL;
+    }
+
+    // Look for the file and drop the unused ones that changed
+    for (prev = &wpk_cache; wpk = *prev, wpk; ) {
+        if (!strcmp(wpk->path, file_path)) {
+            if (wpk->mtime == file_stat.st_mtime && wpk->size == file_stat.st_size) {
+                wpk->refs++;
+                w_mutex_unlock(&wpk_cache_mutex);
+                return wpk;
+            }
+
+            if (!wpk->refs) {
+                *prev = wpk->next;
+                os_free(wpk->path);
+                os_free(wpk->data);
+                os_free(wpk);
+                continue;
+            }
+        }
+
+        cache_size += wpk->size;
+        prev = &wpk->next;
+    }
+
+    // Make room for the file dropping the unused ones
+    for (prev = &wpk_cache; wpk = *prev, wpk && cache_size + file_stat.st_size > WM_UPGRADE_WPK_CACHE_SIZE; ) {
+        if (!wpk->refs) {
+            *prev = wpk->next;
+            cache_size -= wpk->size;
+            os_free(wpk->path);
+            os_free(wpk->data);
+            os_free(wpk);
+        } else {
+            prev = &wpk->next;
+        }
+    }
+
+    if (cache_size + file_stat.st_size > WM_UPGRADE_WPK_CACHE_SIZE) {
+        w_mutex_unlock(&wpk_cache_mutex);
+        return NULL;
+    }
+
+    FILE *file = wfopen(file_path, "rb");
+    if (!file) {
+        w_mutex_unlock(&wpk_cache_mutex);
+        return NULL;
+    }
+
+    os_calloc(1, sizeof(wm_upgrade_wpk), wpk);
+    os_strdup(file_path, wpk->path);
+    os_malloc(file_stat.st_size + 1, wpk->data);
+    wpk->mtime = file_stat.st_mtime;
+
+    if (wpk->size = fread(wpk->data, 1, file_stat.st_size, file), wpk->size != file_stat.st_size) {
+        // The file is being written, read it from disk this time
+        fclose(file);
+        os_free(wpk->path);
+        os_free(wpk->data);
+        os_free(wpk);
+        w_mutex_unlock(&wpk_cache_mutex);
+        return NULL;
+    }
+
+    fclose(file);
+
+    wpk->refs = 1;
+    wpk->next = wpk_cache;
+    wpk_cache = wpk;
+
+    w_mutex_unlock(&wpk_cache_mutex);
+
+    return wpk;
+}
+
+STATIC void wm_agent_upgrade_release_wpk(wm_upgrade_wpk *wpk) {
+    w_mutex_lock(&wpk_cache_mutex);
+    wpk->refs--;
+    w_mutex_unlock(&wpk_cache_mutex);
+}
+
+STATIC int wm_agent_upgrade_next_chunk_size(int current, int min, double rtt) {
+    if (rtt < WM_UPGRADE_CHUNK_RTT_LOW && current <= WM_UPGRADE_CHUNK_SIZE_MAX / 2) {
+        return current * 2;
+    }
+
+    if (rtt > WM_UPGRADE_CHUNK_RTT_HIGH && current / 2 >= min) {
+        return current / 2;
+    }
+
+    return current;
+}
+
 STATIC int wm_agent_upgrade_send_close(int agent_id, int wpk_message_format, const char *wpk_file) {
     int result = OS_INVALID;
     char *command = NULL;
@@ -13,6 +13,8 @@
 #include <json.hpp>
 #include <string>
 #include <map>
+#include <regex>
+#include <vector>
 
 class SysNormalizer
 {
@@ -25,11 +27,54 @@ class SysNormalizer
         void removeExcluded(const std::string& type,
                             nlohmann::json& data) const;
     private:
+        // Pattern compiled once. Literals, optionally wrapped in a group and
+        // surrounded by ".*", are matched without the regex engine.
+        class Pattern
+        {
+            public:
+                Pattern() = default;
+                explicit Pattern(const std::string& pattern);
+                bool match(const std::string& value) const;
+                std::string replace(const std::string& value,
+                                    const std::string& format) const;
+            private:
+                std::regex m_regex;
+                std::string m_literal;
+                bool m_isLiteral{false};
+                bool m_anyBefore{false};
+                bool m_anyAfter{false};
+        };
+
+        struct DictionaryRule
+        {
+            bool hasFind{false};
+            std::string findField;
+            Pattern findPattern;
+            bool hasReplace{false};
+            std::string replaceField;
+            Pattern replacePattern;
+            std::string replaceValue;
+            bool hasAdd{false};
+            std::string addField;
+            std::string addValue;
+        };
+
+        // Exclusion patterns of a data type, indexed by the field they test.
+        using ExclusionRules = std::map<std::string, std::vector<Pattern>>;
+        // Dictionary rules of a data type, in the order they must be applied.
+        using DictionaryRules = std::vector<DictionaryRule>;
+
         static std::map<std::string, nlohmann::json> getTypeValues(const std::string& configFile,
                                                                    const std::string& target,
                                                                    const std::string& type);
-        const std::map<std::string, nlohmann::json> m_typeExclusions;
-        const std::map<std::string, nlohmann::json> m_typeDictionary;
+        static std::map<std::string, ExclusionRules> compileExclusions(const std::map<std::string, nlohmann::json>& typeValues);
+        static std::map<std::string, DictionaryRules> compileDictionary(const std::map<std::string, nlohmann::json>& typeValues);
+        static bool isExcluded(const ExclusionRules& exclusions,
+                               const nlohmann::json& item);
+        static void normalizeItem(const DictionaryRules& dictionary,
+                                  nlohmann::json& item);
+        const std::map<std::string, ExclusionRules> m_typeExclusions;
+        const std::map<std::string, DictionaryRules> m_typeDictionary;
 };
 
 
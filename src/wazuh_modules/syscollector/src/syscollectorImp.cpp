@@ -12,6 +12,7 @@
 #include "syscollector.hpp"
 #include "json.hpp"
 #include <iostream>
+#include <atomic>
 #include "stringHelper.h"
 #include "hashHelper.h"
 #include "timeHelper.h"
@@ -21,6 +22,11 @@ constexpr std::chrono::seconds MAX_DELAY_TIME
     300
 };
 
+constexpr auto MAX_SCAN_THREADS
+{
+    4u
+};
+
 #define TRY_CATCH_TASK(task)                                            \
 do                                                                      \
 {                                                                       \
@@ -1612,13 +1618,42 @@ void Syscollector::scan()
     m_logFunction(LOG_INFO, "Starting evaluation.");
     m_scanTime = Utils::getCurrentTimestamp();
 
-    TRY_CATCH_TASK(scanHardware);
-    TRY_CATCH_TASK(scanOs);
-    TRY_CATCH_TASK(scanNetwork);
-    TRY_CATCH_TASK(scanPackages);
-    TRY_CATCH_TASK(scanHotfixes);
-    TRY_CATCH_TASK(scanPorts);
-    TRY_CATCH_TASK(scanProcesses);
+    // Each provider syncs its own tables, so they are scanned concurrently. The slowest ones go first.
+    const std::vector<std::function<void()>> tasks
+    {
+        [this]() { TRY_CATCH_TASK(scanPackages); },
+        [this]() { TRY_CATCH_TASK(scanProcesses); },
+        [this]() { TRY_CATCH_TASK(scanPorts); },
+        [this]() { TRY_CATCH_TASK(scanNetwork); },
+        [this]() { TRY_CATCH_TASK(scanHardware); },
+        [this]() { TRY_CATCH_TASK(scanOs); },
+        [this]() { TRY_CATCH_TASK(scanHotfixes); }
+    };
+    std::atomic<size_t> nextTask{0};
+    const auto worker
+    {
+        [&tasks, &nextTask]()
+        {
+            for (auto task{nextTask++}; task < tasks.size(); task = nextTask++)
+            {
+                tasks[task]();
+            }
+        }
+    };
+    std::vector<std::thread> threads;
+
+    for (auto i{1u}; i < MAX_SCAN_THREADS; ++i)
+    {
+        threads.emplace_back(worker);
+    }
+
+    worker();
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
     m_notify = true;
     m_logFunction(LOG_INFO, "Evaluation finished.");
 }
@@ -13,11 +13,118 @@
 #include <regex>
 #include <syscollectorNormalizer.h>
 
+static const std::string ANY_SEQUENCE{".*"};
+static const std::string REGEX_SPECIAL_CHARS{"\\^$.|?*+()[]{}"};
+
+SysNormalizer::Pattern::Pattern(const std::string& pattern)
+    : m_regex{pattern}
+{
+    std::string literal{pattern};
+
+    if (literal.compare(0, ANY_SEQUENCE.size(), ANY_SEQUENCE) == 0)
+    {
+        m_anyBefore = true;
+        literal.erase(0, ANY_SEQUENCE.size());
+    }
+
+    if (literal.size() >= ANY_SEQUENCE.size() &&
+            literal.compare(literal.size() - ANY_SEQUENCE.size(), ANY_SEQUENCE.size(), ANY_SEQUENCE) == 0)
+    {
+        m_anyAfter = true;
+        literal.erase(literal.size() - ANY_SEQUENCE.size());
+    }
+
+    if (literal.size() > 2 && literal.front() == '(' && literal.back() == ')')
+    {
+        literal = literal.substr(1, literal.size() - 2);
+    }
+
+    if (!literal.empty() && literal.find_first_of(REGEX_SPECIAL_CHARS) == std::string::npos)
+    {
+        m_literal = literal;
+        m_isLiteral = true;
+    }
+}
+
+bool SysNormalizer::Pattern::match(const std::string& value) const
+{
+    // ".*" does not match line terminators, leave those values to the regex.
+    if (!m_isLiteral ||
+            ((m_anyBefore || m_anyAfter) && value.find_first_of("\r\n") != std::string::npos))
+    {
+        return std::regex_match(value, m_regex);
+    }
+
+    if (m_anyBefore && m_anyAfter)
+    {
+        return value.find(m_literal) != std::string::npos;
+    }
+
+    if (m_anyBefore)
+    {
+        return value.size() >= m_literal.size() &&
+               value.compare(value.size() - m_literal.size(), m_literal.size(), m_literal) == 0;
+    }
+
+    if (m_anyAfter)
+    {
+        return value.compare(0, m_literal.size(), m_literal) == 0;
+    }
+
+    return value == m_literal;
+}
+
+std::string SysNormalizer::Pattern::replace(const std::string& value,
+                                            const std::string& format) const
+{
+    if (!m_isLiteral || m_anyBefore || m_anyAfter || format.find('$') != std::string::npos)
+    {
+        return std::regex_replace(value, m_regex, format);
+    }
+
+    std::string result;
+    size_t start{0};
+
+    for (auto pos{value.find(m_literal)}; pos != std::string::npos; pos = value.find(m_literal, start))
+    {
+        result.append(value, start, pos - start);
+        result.append(format);
+        start = pos + m_literal.size();
+    }
+
+    result.append(value, start, std::string::npos);
+    return result;
+}
+
 SysNormalizer::SysNormalizer(const std::string& configFile,
                              const std::string& target)
-    : m_typeExclusions{getTypeValues(configFile, target, "exclusions")}
-    , m_typeDictionary{getTypeValues(configFile, target, "dictionary")}
+    : m_typeExclusions{compileExclusions(getTypeValues(configFile, target, "exclusions"))}
+    , m_typeDictionary{compileDictionary(getTypeValues(configFile, target, "dictionary"))}
+{
+}
+
+bool SysNormalizer::isExcluded(const ExclusionRules& exclusions,
+                               const nlohmann::json& item)
 {
+    for (const auto& exclusion : exclusions)
+    {
+        const auto fieldIt{item.find(exclusion.first)};
+
+        if (fieldIt != item.end() && fieldIt->is_string())
+        {
+            const auto& value{fieldIt->get_ref<const std::string&>()};
+
+            for (const auto& pattern : exclusion.second)
+            {
+                if (pattern.match(value))
+                {
+                    return true;
+                }
+            }
+        }
+    }
+
+    return false;
 }
 
 void SysNormalizer::removeExcluded(const std::string& type,
@@ -27,92 +134,57 @@ void SysNormalizer::removeExcluded(const std::string& type,
 
     if (exclusionsIt != m_typeExclusions.cend())
     {
-        for (const auto& exclusionItem : exclusionsIt->second)
+        if (data.is_array())
         {
-            try
+            for (auto item{data.begin()}; item != data.end();)
             {
-                std::regex pattern{exclusionItem["pattern"].get_ref<const std::string&>()};
-                const auto& fieldName{exclusionItem["field_name"].get_ref<const std::string&>()};
-
-                if (data.is_array())
+                if (isExcluded(exclusionsIt->second, *item))
                 {
-                    for (auto item{data.begin()}; item != data.end(); ++item)
-                    {
-                        const auto fieldIt{item->find(fieldName)};
-
-                        if (fieldIt != item->end() && std::regex_match(fieldIt->get_ref<const std::string&>(), pattern))
-                        {
-                            data.erase(item);
-                        }
-                    }
+                    item = data.erase(item);
                 }
                 else
                 {
-                    const auto fieldIt{data.find(fieldName)};
-
-                    if (fieldIt != data.end() && std::regex_match(fieldIt->get_ref<const std::string&>(), pattern))
-                    {
-                        data.clear();
-                    }
+                    ++item;
                 }
             }
-            // LCOV_EXCL_START
-            catch (...)
-            {}
-
-            // LCOV_EXCL_STOP
+        }
+        else if (isExcluded(exclusionsIt->second, data))
+        {
+            data.clear();
         }
     }
 }
 
-
-static void normalizeItem(const nlohmann::json& dictionary,
-                          nlohmann::json& item)
+void SysNormalizer::normalizeItem(const DictionaryRules& dictionary,
+                                  nlohmann::json& item)
 {
-    for (const auto& dictItem : dictionary)
+    for (const auto& rule : dictionary)
     {
-        const auto itFindPattern{dictItem.find("find_pattern")};
-        const auto itFindField{dictItem.find("find_field")};
-
-        if (itFindPattern != dictItem.end() && itFindField != dictItem.end())
+        if (rule.hasFind)
         {
-            const auto fieldIt{item.find(itFindField->get_ref<const std::string&>())};
-            std::regex pattern{itFindPattern->get_ref<const std::string&>()};
+            const auto fieldIt{item.find(rule.findField)};
 
-            if (fieldIt == item.end() ||
-                    !std::regex_match(fieldIt->get_ref<const std::string&>(), pattern))
+            if (fieldIt == item.end() || !fieldIt->is_string() ||
+                    !rule.findPattern.match(fieldIt->get_ref<const std::string&>()))
             {
                 //no field in the item or no matching, we continue
                 continue;
             }
         }
-        else if (itFindPattern != dictItem.end() || itFindField != dictItem.end())
-        {
-            //we won't evaluate an incomplete item.
-            continue;
-        }
-
-        const auto itReplacePattern{dictItem.find("replace_pattern")};
-        const auto itReplaceField{dictItem.find("replace_field")};
-        const auto itReplaceValue{dictItem.find("replace_value")};
 
-        if (itReplacePattern != dictItem.end() && itReplaceField != dictItem.end() && itReplaceValue != dictItem.end())
+        if (rule.hasReplace)
         {
-            std::regex pattern{itReplacePattern->get_ref<const std::string&>()};
-            const auto fieldIt{item.find(itReplaceField->get_ref<const std::string&>())};
+            const auto fieldIt{item.find(rule.replaceField)};
 
-            if (fieldIt != item.end())
+            if (fieldIt != item.end() && fieldIt->is_string())
             {
-                *fieldIt = std::regex_replace(fieldIt->get_ref<const std::string&>(), pattern, itReplaceValue->get_ref<const std::string&>());
+                *fieldIt = rule.replacePattern.replace(fieldIt->get_ref<const std::string&>(), rule.replaceValue);
             }
         }
 
-        const auto itAddField{dictItem.find("add_field")};
-        const auto itAddValue{dictItem.find("add_value")};
-
-        if (itAddField != dictItem.end() && itAddValue != dictItem.end())
+        if (rule.hasAdd)
         {
-            item[itAddField->get_ref<const std::string&>()] = itAddValue->get_ref<const std::string&>();
+            item[rule.addField] = rule.addValue;
         }
     }
 }
@@ -138,6 +210,94 @@ void SysNormalizer::normalize(const std::string& type,
     }
 }
 
+std::map<std::string, SysNormalizer::ExclusionRules> SysNormalizer::compileExclusions(const std::map<std::string, nlohmann::json>& typeValues)
+{
+    std::map<std::string, ExclusionRules> ret;
+
+    for (const auto& type : typeValues)
+    {
+        for (const auto& exclusionItem : type.second)
+        {
+            try
+            {
+                const auto& fieldName{exclusionItem.at("field_name").get_ref<const std::string&>()};
+                Pattern pattern{exclusionItem.at("pattern").get_ref<const std::string&>()};
+                ret[type.first][fieldName].push_back(std::move(pattern));
+            }
+            // LCOV_EXCL_START
+            catch (...)
+            {}
+
+            // LCOV_EXCL_STOP
+        }
+    }
+
+    return ret;
+}
+
+std::map<std::string, SysNormalizer::DictionaryRules> SysNormalizer::compileDictionary(const std::map<std::string, nlohmann::json>& typeValues)
+{
+    std::map<std::string, DictionaryRules> ret;
+
+    for (const auto& type : typeValues)
+    {
+        auto& rules{ret[type.first]};
+
+        for (const auto& dictItem : type.second)
+        {
+            try
+            {
+                DictionaryRule rule;
+                const auto itFindPattern{dictItem.find("find_pattern")};
+                const auto itFindField{dictItem.find("find_field")};
+
+                if (itFindPattern != dictItem.end() && itFindField != dictItem.end())
+                {
+                    rule.hasFind = true;
+                    rule.findField = itFindField->get_ref<const std::string&>();
+                    rule.findPattern = Pattern{itFindPattern->get_ref<const std::string&>()};
+                }
+                else if (itFindPattern != dictItem.end() || itFindField != dictItem.end())
+                {
+                    //we won't evaluate an incomplete item.
+                    continue;
+                }
+
+                const auto itReplacePattern{dictItem.find("replace_pattern")};
+                const auto itReplaceField{dictItem.find("replace_field")};
+                const auto itReplaceValue{dictItem.find("replace_value")};
+
+                if (itReplacePattern != dictItem.end() && itReplaceField != dictItem.end() && itReplaceValue != dictItem.end())
+                {
+                    rule.hasReplace = true;
+                    rule.replaceField = itReplaceField->get_ref<const std::string&>();
+                    rule.replacePattern = Pattern{itReplacePattern->get_ref<const std::string&>()};
+                    rule.replaceValue = itReplaceValue->get_ref<const std::string&>();
+                }
+
+                const auto itAddField{dictItem.find("add_field")};
+                const auto itAddValue{dictItem.find("add_value")};
+
+                if (itAddField != dictItem.end() && itAddValue != dictItem.end())
+                {
+                    rule.hasAdd = true;
+                    rule.addField = itAddField->get_ref<const std::string&>();
+                    rule.addValue = itAddValue->get_ref<const std::string&>();
+                }
+
+                rules.push_back(std::move(rule));
+            }
+            // LCOV_EXCL_START
+            catch (...)
+            {}
+
+            // LCOV_EXCL_STOP
+        }
+    }
+
+    return ret;
+}
+
 std::map<std::string, nlohmann::json> SysNormalizer::getTypeValues(const std::string& configFile,
                                                                    const std::string& target,
                                                                    const std::string& type)
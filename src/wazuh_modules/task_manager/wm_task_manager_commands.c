@@ -23,6 +23,9 @@
 #include "defs.h"
 #include "wazuhdb_op.h"
 
+/* Maximum agents whose status is updated with a single query to wazuh-db */
+#define WM_TASK_UPDATE_STATUS_BATCH 1000
+
 /**
  * Analyze an upgrade or upgrade_custom command. Update the tasks DB when necessary.
  * @param task Upgrade task to be processed.
@@ -208,6 +211,64 @@ STATIC cJSON* wm_task_manager_command_upgrade_update_status(wm_task_manager_upgr
         cJSON *parameters = cJSON_CreateObject();
         cJSON *wdb_response = NULL;
 
+        // Update the status of several agents with a single query
+        if (task->agent_ids[agent_it] != OS_INVALID) {
+            cJSON *agents = cJSON_CreateArray();
+            cJSON *wdb_agents = NULL;
+            cJSON *wdb_agent = NULL;
+            int count = 1;
+
+            cJSON_AddItemToArray(agents, cJSON_CreateNumber(agent_id));
+            while (count < WM_TASK_UPDATE_STATUS_BATCH && task->agent_ids[agent_it] != OS_INVALID) {
+                cJSON_AddItemToArray(agents, cJSON_CreateNumber(task->agent_ids[agent_it++]));
+                count++;
+            }
+
+            cJSON_AddItemToObject(parameters, task_manager_json_keys[WM_TASK_AGENTS], agents);
+            cJSON_AddStringToObject(parameters, task_manager_json_keys[WM_TASK_NODE], task->node);
+            cJSON_AddStringToObject(parameters, task_manager_json_keys[WM_TASK_STATUS], task->status);
+            if (task->error_msg) {
+                cJSON_AddStringToObject(parameters, task_manager_json_keys[WM_TASK_ERROR_MSG], task->error_msg);
+            }
+
+            if (wdb_response = wm_task_manager_send_message_to_wdb(task_manager_commands_list[WM_TASK_UPGRADE_UPDATE_STATUS], parameters, error_code), !wdb_response) {
+                cJSON_Delete(parameters);
+                cJSON_Delete(response);
+                return NULL;
+            }
+
+            wdb_agents = cJSON_GetObjectItem(wdb_response, task_manager_json_keys[WM_TASK_AGENTS]);
+
+            if (cJSON_GetArraySize(wdb_agents) != count) {
+                *error_code = WM_TASK_DATABASE_ERROR;
+                cJSON_Delete(wdb_response);
+                cJSON_Delete(parameters);
+                cJSON_Delete(response);
+                return NULL;
+            }
+
+            cJSON_ArrayForEach(wdb_agent, wdb_agents) {
+                cJSON *wdb_agent_id = cJSON_GetObjectItem(wdb_agent, task_manager_json_keys[WM_TASK_AGENT_ID]);
+                cJSON *wdb_error = cJSON_GetObjectItem(wdb_agent, task_manager_json_keys[WM_TASK_ERROR]);
+
+                if (cJSON_IsNumber(wdb_agent_id) && cJSON_IsNumber(wdb_error) && (wdb_error->valueint == OS_SUCCESS)) {
+                    cJSON_AddItemToArray(response, wm_task_manager_parse_data_response(WM_TASK_SUCCESS, wdb_agent_id->valueint, OS_INVALID, NULL));
+                } else if (cJSON_IsNumber(wdb_agent_id) && cJSON_IsNumber(wdb_error) && (wdb_error->valueint == OS_NOTFOUND)) {
+                    cJSON_AddItemToArray(response, wm_task_manager_parse_data_response(WM_TASK_DATABASE_NO_TASK, wdb_agent_id->valueint, OS_INVALID, NULL));
+                } else {
+                    *error_code = WM_TASK_DATABASE_ERROR;
+                    cJSON_Delete(wdb_response);
+                    cJSON_Delete(parameters);
+                    cJSON_Delete(response);
+                    return NULL;
+                }
+            }
+
+            cJSON_Delete(wdb_response);
+            cJSON_Delete(parameters);
+            continue;
+        }
+
         cJSON_AddNumberToObject(parameters, task_manager_json_keys[WM_TASK_AGENT_ID], agent_id);
         cJSON_AddStringToObject(parameters, task_manager_json_keys[WM_TASK_NODE], task->node);
         cJSON_AddStringToObject(parameters, task_manager_json_keys[WM_TASK_STATUS], task->status);
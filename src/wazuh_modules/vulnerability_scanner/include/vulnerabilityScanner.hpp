@@ -30,6 +30,7 @@
 constexpr auto HOTFIXES_APPLICATIONS_COLUMN {"hotfixes_applications"};
 constexpr auto REMEDIATIONS_COLUMN {"remediations"};
 constexpr auto TRANSLATIONS_COLUMN {"translation"};
+constexpr auto TRANSLATIONS_INDEX_COLUMN {"translations_index"};
 constexpr auto DESCRIPTIONS_COLUMN {"descriptions"};
 constexpr auto VENDOR_MAP_COLUMN {"vendor_map"};
 constexpr auto OS_CPE_RULES_COLUMN {"oscpe_rules"};
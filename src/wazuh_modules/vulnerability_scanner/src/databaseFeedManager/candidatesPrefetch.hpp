@@ -0,0 +1,146 @@
+/*
+ * Wazuh Vulnerability scanner - Database Feed Manager
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _CANDIDATES_PREFETCH_HPP
+#define _CANDIDATES_PREFETCH_HPP
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+constexpr auto CANDIDATES_KEY_SEPARATOR {"_CVE"};
+
+/**
+ * @brief CandidatesPrefetch class.
+ *
+ * @details Vulnerability candidates of the packages of an agent. The first time a CNA is queried, the candidates of all
+ * the packages are read in a single pass over the CNA column (see DatabaseFeedManager::getVulnerabilitiesCandidates),
+ * and the following queries of the same CNA are served from memory. The candidate arrays are copied and verified when
+ * they are read, so they remain valid if the feed database is replaced during the scan.
+ *
+ * An instance isn't thread safe: It's meant to be used by the thread that scans the agent.
+ */
+class CandidatesPrefetch final
+{
+public:
+    /**
+     * @brief Candidate arrays of each package, keyed by the package key prefix.
+     */
+    using Candidates = std::unordered_map<std::string, std::vector<std::string>>;
+
+private:
+    std::vector<std::string> m_prefixes;
+    std::unordered_map<std::string, Candidates> m_candidates;
+
+public:
+    /**
+     * @brief Class constructor.
+     *
+     * @param packageNames Names of the packages of the agent, as they are queried.
+     */
+    explicit CandidatesPrefetch(const std::vector<std::string>& packageNames)
+    {
+        m_prefixes.reserve(packageNames.size());
+        for (const auto& packageName : packageNames)
+        {
+            if (!packageName.empty())
+            {
+                m_prefixes.push_back(keyPrefix(packageName));
+            }
+        }
+
+        // Sorted as the database keys, so the column is read in order.
+        std::sort(m_prefixes.begin(), m_prefixes.end());
+        m_prefixes.erase(std::unique(m_prefixes.begin(), m_prefixes.end()), m_prefixes.end());
+    }
+
+    /**
+     * @brief Key prefix of the candidates of a package.
+     *
+     * @param packageName Package name.
+     * @return std::string Key prefix.
+     */
+    static std::string keyPrefix(std::string_view packageName)
+    {
+        std::string prefix;
+        prefix.reserve(packageName.size() + std::char_traits<char>::length(CANDIDATES_KEY_SEPARATOR));
+        prefix.append(packageName);
+        prefix.append(CANDIDATES_KEY_SEPARATOR);
+        return prefix;
+    }
+
+    /**
+     * @brief Key prefixes of the packages, sorted.
+     *
+     * @return const std::vector<std::string>& Key prefixes.
+     */
+    const std::vector<std::string>& prefixes() const
+    {
+        return m_prefixes;
+    }
+
+    /**
+     * @brief Checks if a package is part of the prefetch.
+     *
+     * @param prefix Key prefix of the package.
+     * @return true If the package candidates are prefetched with the rest of the packages.
+     */
+    bool contains(const std::string& prefix) const
+    {
+        return std::binary_search(m_prefixes.begin(), m_prefixes.end(), prefix);
+    }
+
+    /**
+     * @brief Checks if the candidates of a CNA were already read.
+     *
+     * @param cnaName CNA name.
+     * @return true If the candidates were read.
+     */
+    bool fetched(const std::string& cnaName) const
+    {
+        return m_candidates.find(cnaName) != m_candidates.end();
+    }
+
+    /**
+     * @brief Stores the candidates of a CNA.
+     *
+     * @param cnaName CNA name.
+     * @param candidates Verified candidate arrays of the packages that have any.
+     */
+    void store(const std::string& cnaName, Candidates candidates)
+    {
+        m_candidates[cnaName] = std::move(candidates);
+    }
+
+    /**
+     * @brief Gets the candidate arrays of a package.
+     *
+     * @param cnaName CNA name, it must be fetched.
+     * @param prefix Key prefix of the package.
+     * @return const std::vector<std::string>& Verified candidate arrays, in key order.
+     */
+    const std::vector<std::string>& candidates(const std::string& cnaName, const std::string& prefix) const
+    {
+        static const std::vector<std::string> EMPTY_CANDIDATES;
+
+        const auto& cnaCandidates {m_candidates.at(cnaName)};
+        if (const auto it {cnaCandidates.find(prefix)}; it != cnaCandidates.end())
+        {
+            return it->second;
+        }
+        return EMPTY_CANDIDATES;
+    }
+};
+
+#endif // _CANDIDATES_PREFETCH_HPP
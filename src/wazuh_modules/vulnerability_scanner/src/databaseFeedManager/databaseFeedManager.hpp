@@ -15,11 +15,16 @@
 #include "../policyManager/policyManager.hpp"
 #include "UNIXSocketRequest.hpp"
 #include "cacheLRU.hpp"
+#include "candidatesPrefetch.hpp"
+#include "chunkedInputStream.hpp"
 #include "contentManager.hpp"
 #include "contentRegister.hpp"
 #include "databaseFeedManagerException.hpp"
 #include "eventDecoder.hpp"
+#include "feedDelta.hpp"
+#include "feedDistribution.hpp"
 #include "feedIndexer.hpp"
+#include "feedImporter.hpp"
 #include "globalData.hpp"
 #include "indexerConnector.hpp"
 #include "jsonArrayParser.hpp"
@@ -27,20 +32,35 @@
 #include "observer.hpp"
 #include "rocksDBWrapper.hpp"
 #include "routerSubscriber.hpp"
+#include "scannerMetrics.hpp"
 #include "storeModel.hpp"
 #include "vulnerabilityCandidate_generated.h"
 #include "vulnerabilityDescription_generated.h"
 #include "vulnerabilityRemediations_generated.h"
 #include "vulnerabilityScanner.hpp"
+#include "xzHelper.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <external/nlohmann/json.hpp>
+#include <filesystem>
 #include <fstream>
+#include <istream>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <thread>
+#include <unordered_set>
 #include <vector>
 
 using namespace NSVulnerabilityScanner;
 constexpr auto DATABASE_PATH {"queue/vd/feed"};
+constexpr auto IMPORT_DATABASE_PATH {"queue/vd/feed_import"};
+constexpr auto PREVIOUS_DATABASE_PATH {"queue/vd/feed_previous"};
+constexpr auto DISTRIBUTED_VERSION_PATH {"queue/vd/feed_distributed_version"};
+constexpr auto FEED_DISTRIBUTION_CHECK_INTERVAL {std::chrono::seconds(30)};
 constexpr auto OFFSET_TRANSACTION_SIZE {1000};
 constexpr auto EMPTY_KEY {""};
 
@@ -127,10 +147,12 @@ public:
      * @param message Message received by the router.
      * @param topicName Topic name.
      * @param orchestration Chain of actions to execute for each valid resource extracted from the message.
+     * @param feedDelta Changes of the update, filled by the orchestration. It's marked as full for a snapshot.
      */
     void processMessage(const std::vector<char>& message,
                         const std::string& topicName,
-                        const std::function<void(const nlohmann::json&, Utils::IRocksDBWrapper*)>& orchestration)
+                        const std::function<void(const nlohmann::json&, Utils::IRocksDBWrapper*)>& orchestration,
+                        FeedDelta* feedDelta = nullptr)
     {
         auto parsedMessage = nlohmann::json::parse(message, nullptr, false);
 
@@ -139,11 +161,15 @@ public:
         {
             throw std::runtime_error("Invalid message");
         }
-        // Lock the mutex to protect the access to the internal databases.
-        std::scoped_lock<std::shared_mutex> lock(m_mutex);
         if (parsedMessage.at("type") == "offsets")
         {
+            // Lock the mutex to protect the access to the internal databases.
+            std::scoped_lock<std::shared_mutex> lock(m_mutex);
             auto jsonPointer {"/data"_json_pointer};
+
+            // The changes of a coalesced file aren't sorted by offset, so the file must be applied as a whole before
+            // updating the offset.
+            const auto coalesced {parsedMessage.contains("coalesced") && parsedMessage.at("coalesced").get<bool>()};
             for (const auto& path : parsedMessage.at("paths"))
             {
                 auto currentOffset = 0LL;
@@ -153,17 +179,18 @@ public:
                 // The lambda function returns false if the module is stopped.
                 // This uses the json sax api, so it is faster than the json tree api and it consumes less memory.
                 // LCOV_EXCL_START
+                const auto content {openContent(path.get_ref<const std::string&>())};
                 JsonArray::parse(
-                    path,
+                    *content,
                     [&](nlohmann::json&& item, const size_t)
                     {
                         orchestration(item, m_feedDatabase.get());
 
-                        // Extract the offset from the last element.
-                        currentOffset = item.at("offset");
+                        // Extract the greatest offset processed.
+                        currentOffset = std::max(currentOffset, item.at("offset").get<long long>());
 
                         // Commit the transaction for every 200 elements.
-                        return !m_shouldStop.load();
+                        return coalesced || !m_shouldStop.load();
                     },
                     jsonPointer);
                 // LCOV_EXCL_STOP
@@ -187,48 +214,36 @@ public:
             {
                 throw std::runtime_error("Invalid message");
             }
-            // Delete all the data in the database, because the raw message contains all and latest data.
-            m_feedDatabase->deleteAll();
+            const auto& path {parsedMessage.at("paths").front().get_ref<const std::string&>()};
+            logDebug2(WM_VULNSCAN_LOGTAG, "Processing file: %s", path.c_str());
+            const auto content {openContent(path)};
 
-            for (const auto& path : parsedMessage.at("paths"))
+            // The whole feed is replaced. It's marked before the import, so the workers don't track the resources.
+            if (feedDelta)
             {
-                logDebug2(WM_VULNSCAN_LOGTAG, "Processing file: %s", path.get_ref<const std::string&>().c_str());
-                std::ifstream file(path.get_ref<const std::string&>());
-                if (!file.is_open())
+                feedDelta->markFull();
+            }
+
+            // The raw message contains all and latest data: It's imported into a new database while the scans keep
+            // using the current one, with its caches, which is replaced once the import is complete. The new database
+            // is loaded in bulk: Its files are compacted once at the end, instead of while the data is imported.
+            std::filesystem::remove_all(IMPORT_DATABASE_PATH);
+            {
+                auto importDatabase {std::make_unique<TRocksDBWrapper>(IMPORT_DATABASE_PATH, false)};
+                try
                 {
-                    throw std::runtime_error("Unable to open input file: " + path.get_ref<const std::string&>());
+                    importDatabase->beginBulkLoad();
+                    FeedImporter(*importDatabase, orchestration, m_shouldStop).import(*content, path);
+                    importDatabase->endBulkLoad();
                 }
-
-                std::string line;
-                int32_t step = 0;
-                // Parse the file and execute the chain/orchestration for each valid resource.
-                // It orchestrate line by line.
-                while (std::getline(file, line))
+                catch (...)
                 {
-                    if (m_shouldStop.load())
-                    {
-                        throw DatabaseFeedManagerException("Module stopped.");
-                    }
-
-                    if (step++ % 1000 == 0)
-                    {
-                        logDebug2(WM_VULNSCAN_LOGTAG, "Processing line: %d", step);
-                    }
-
-                    nlohmann::json parsedLine = nlohmann::json::parse(line, nullptr, false);
-                    if (parsedLine.is_discarded() || !parsedLine.contains("name"))
-                    {
-                        throw std::runtime_error("Invalid line. file: " + path.get_ref<const std::string&>());
-                    }
-
-                    parsedLine["resource"] = parsedLine["name"];
-                    parsedLine["type"] = "create";
-
-                    orchestration(parsedLine, m_feedDatabase.get());
+                    importDatabase.reset();
+                    std::filesystem::remove_all(IMPORT_DATABASE_PATH);
+                    throw;
                 }
             }
-
-            m_feedDatabase->flush();
+            replaceFeedDatabase();
 
             // Update the offset.
             contentManagerUpdateOffset(topicName, parsedMessage.at("offset"));
@@ -255,7 +270,9 @@ public:
      * @param isLocalSubscriber Configures the router subscription lambda execution as local or remote.
      * @param reloadGlobalMapsStartup If true, the vendor and os cpe maps will be reloaded at startup.
      * @param initContentUpdater If true, the content updater will be initialized.
-     * @param postUpdateCallback Callback to be executed after the update process.
+     * @param postUpdateCallback Callback to be executed after the update process, with the changes applied.
+     * @param feedDistributionRole Role of the node in the distribution of the feed across the cluster. A worker
+     * doesn't update the feed, it imports the one exported by the master.
      */
     // LCOV_EXCL_START
     explicit TDatabaseFeedManager(
@@ -265,13 +282,15 @@ public:
         const bool isLocalSubscriber = true,
         const bool reloadGlobalMapsStartup = true,
         const bool initContentUpdater = true,
-        const std::function<void()>& postUpdateCallback =
-            []() { // Not used
-            })
+        const std::function<void(const FeedDelta&)>& postUpdateCallback =
+            [](const FeedDelta&) { // Not used
+            },
+        const FeedDistributionRole feedDistributionRole = FeedDistributionRole::NONE)
         : Observer("database_feed_manager")
         , m_indexerConnector(std::move(indexerConnector))
         , m_shouldStop(shouldStop)
         , m_mutex(mutex)
+        , m_feedDistributionRole(feedDistributionRole)
 
     {
         const auto updaterPolicy = TPolicyManager::instance().getUpdaterConfiguration();
@@ -279,7 +298,14 @@ public:
 
         try
         {
+            // Restore the previous database if the module was stopped while it was being replaced.
+            if (!std::filesystem::exists(DATABASE_PATH) && std::filesystem::exists(PREVIOUS_DATABASE_PATH))
+            {
+                std::filesystem::rename(PREVIOUS_DATABASE_PATH, DATABASE_PATH);
+            }
+
             m_feedDatabase = std::make_unique<TRocksDBWrapper>(DATABASE_PATH, false);
+            resolveFeedColumns();
 
             // This initializes the vendor and os cpe maps and should be called before any scan or message processing.
             if (reloadGlobalMapsStartup)
@@ -296,6 +322,7 @@ public:
             {
                 std::filesystem::remove_all(DATABASE_PATH);
                 m_feedDatabase = std::make_unique<TRocksDBWrapper>(DATABASE_PATH, false);
+                resolveFeedColumns();
             }
 
             // Remove the updater directory to force the download of the complete feed.
@@ -315,25 +342,32 @@ public:
                 eventDecoder->setLast(std::make_shared<StoreModel>());
                 eventDecoder->setLast(std::make_shared<FeedIndexer<TIndexerConnector>>(m_indexerConnector));
 
+                FeedDelta feedDelta;
                 auto orchestrationLambda = [&](const nlohmann::json& resource, Utils::IRocksDBWrapper* feedDatabaseArg)
                 {
                     auto eventContext =
                         std::make_shared<EventContext>(EventContext {.message = message,
                                                                      .resource = resource,
                                                                      .feedDatabase = feedDatabaseArg,
-                                                                     .resourceType = ResourceType::UNKNOWN});
+                                                                     .resourceType = ResourceType::UNKNOWN,
+                                                                     .feedDelta = &feedDelta});
                     eventDecoder->handleRequest(std::move(eventContext));
                 };
                 try
                 {
                     logInfo(WM_VULNSCAN_LOGTAG, "Initiating update feed process.");
-                    processMessage(message, topicName, orchestrationLambda);
+                    processMessage(message, topicName, orchestrationLambda, &feedDelta);
 
                     // Verify vendor-map and oscpe-map values and update the maps in memory
                     reloadGlobalMaps();
 
+                    if (m_feedDistributionRole == FeedDistributionRole::MASTER)
+                    {
+                        exportFeed();
+                    }
+
                     // Dispatch the post update Callback
-                    postUpdateCallback();
+                    postUpdateCallback(feedDelta);
                     logInfo(WM_VULNSCAN_LOGTAG, "Feed update process completed.");
                 }
                 catch (const DatabaseFeedManagerException& e)
@@ -356,12 +390,31 @@ public:
                 }
             });
 
-        if (initContentUpdater)
+        if (initContentUpdater && m_feedDistributionRole != FeedDistributionRole::WORKER)
         {
             // Vulnerability content updater initialization.
             m_contentRegistration =
                 std::make_unique<TContentRegister>(topicName, TPolicyManager::instance().getUpdaterConfiguration());
         }
+
+        if (m_feedDistributionRole == FeedDistributionRole::WORKER)
+        {
+            m_distributionThread =
+                std::thread([this, postUpdateCallback]() { importDistributedFeeds(postUpdateCallback); });
+        }
+    }
+
+    ~TDatabaseFeedManager()
+    {
+        if (m_distributionThread.joinable())
+        {
+            {
+                std::scoped_lock lock(m_distributionMutex);
+                m_stopDistribution = true;
+            }
+            m_distributionCv.notify_all();
+            m_distributionThread.join();
+        }
     }
 
     /**
@@ -381,7 +434,8 @@ public:
     void getVulnerabilityRemediation(const std::string& cveId, FlatbufferDataPair<RemediationInfo>& dtoVulnRemediation)
     {
         // If the remediation information is not found in the database, we return because there is no remediation.
-        if (auto result = m_feedDatabase->get(cveId, dtoVulnRemediation.slice, REMEDIATIONS_COLUMN); !result)
+        if (auto result = m_feedDatabase->get(cveId, dtoVulnRemediation.slice, m_remediationsColumn, m_readOptions);
+            !result)
         {
             return;
         }
@@ -438,10 +492,27 @@ public:
         m_translationL2Cache->clear();
 
         // Clear the translation filter before filling any cache
-        m_translationFilter->clear();
+        {
+            std::scoped_lock lock(m_translationFilterMutex);
+            m_translationFilter->clear();
+        }
+
+        // FNV-1a hash of the translations loaded, the persisted index is rebuilt when it changes.
+        uint64_t rulesFingerprint {14695981039346656037ULL};
+        const auto fingerprint = [&rulesFingerprint](const rocksdb::Slice& data)
+        {
+            for (size_t i = 0; i < data.size(); ++i)
+            {
+                rulesFingerprint ^= static_cast<unsigned char>(data[i]);
+                rulesFingerprint *= 1099511628211ULL;
+            }
+        };
 
-        // Iterate over translations in the feed database
-        for (const auto& [key, value] : m_feedDatabase->begin(TRANSLATIONS_COLUMN))
+        // Iterate over translations in the feed database, without keeping the blocks of the whole column in the
+        // block cache.
+        const auto translationsColumn = m_feedDatabase->column(TRANSLATIONS_COLUMN);
+        for (const auto& [key, value] :
+             m_feedDatabase->begin(translationsColumn, Utils::RocksDBOptions::buildScanOptions()))
         {
             // Check if the cache is full
             if (m_translationL2Cache->isFull())
@@ -456,6 +527,9 @@ public:
                 throw std::runtime_error("Error: Invalid FlatBuffers translation data in RocksDB.");
             }
 
+            fingerprint(key);
+            fingerprint(value);
+
             // Parse translation data
             auto queryData = GetTranslationEntry(reinterpret_cast<const uint8_t*>(value.data()));
 
@@ -488,6 +562,8 @@ public:
             // Insert translation into cache
             m_translationL2Cache->insertKey(key, translationQuery);
         }
+
+        warmTranslationCaches(rulesFingerprint);
     }
 
     /**
@@ -557,6 +633,16 @@ public:
         return translationResult;
     }
 
+    /**
+     * @brief Generation of the feed, incremented each time the feed is updated.
+     *
+     * @return uint64_t Feed generation.
+     */
+    uint64_t feedGeneration() const
+    {
+        return m_feedGeneration.load();
+    }
+
     /**
      * @brief Get the Vulnerabilities Candidates information.
      *
@@ -576,32 +662,71 @@ public:
             throw std::runtime_error("Invalid package/cna name.");
         }
 
-        std::string packageNameWithSeparator;
-        packageNameWithSeparator.append(package.name);
-        packageNameWithSeparator.append("_CVE");
+        // The candidates are scanned while they're read, so the scan is included.
+        static auto& queryTime {ScannerMetrics::instance().histogram("feed.candidates_query")};
+        const ScannerMetrics::Timer timer(queryTime);
+
+        const auto packageNameWithSeparator {CandidatesPrefetch::keyPrefix(package.name)};
 
         for (const auto& [key, value] : m_feedDatabase->seek(packageNameWithSeparator, cnaName))
         {
-            if (flatbuffers::Verifier verifier(reinterpret_cast<const uint8_t*>(value.data()), value.size());
-                !NSVulnerabilityScanner::VerifyScanVulnerabilityCandidateArrayBuffer(verifier))
-            {
-                throw std::runtime_error(
-                    "Error getting ScanVulnerabilityCandidateArray object from rocksdb. FlatBuffers verifier failed");
-            }
+            verifyCandidates(value);
+            scanCandidates(cnaName, package, value.data(), callback);
+        }
+    }
+
+    /**
+     * @brief Get the Vulnerabilities Candidates information through the prefetch of the agent packages.
+     *
+     * @details The first query of a CNA reads the candidates of all the packages of the prefetch with a single
+     * iterator, in key order. A package that isn't part of the prefetch (e.g. a translated package) is queried alone.
+     *
+     * @param cnaName RocksDB table identifier.
+     * @param package Struct with package data.
+     * @param callback Store vulnerability data.
+     * @param prefetch Candidates of the agent packages.
+     */
+    void getVulnerabilitiesCandidates(
+        const std::string& cnaName,
+        const PackageData& package,
+        const std::function<bool(const std::string& cnaName,
+                                 const PackageData& package,
+                                 const NSVulnerabilityScanner::ScanVulnerabilityCandidate&)>& callback,
+        CandidatesPrefetch& prefetch)
+    {
+        if (package.name.empty() || cnaName.empty())
+        {
+            throw std::runtime_error("Invalid package/cna name.");
+        }
+
+        const auto prefix {CandidatesPrefetch::keyPrefix(package.name)};
+        if (!prefetch.contains(prefix))
+        {
+            getVulnerabilitiesCandidates(cnaName, package, callback);
+            return;
+        }
 
-            auto candidatesArray = GetScanVulnerabilityCandidateArray(reinterpret_cast<const uint8_t*>(value.data()));
+        if (!prefetch.fetched(cnaName))
+        {
+            static auto& prefetchTime {ScannerMetrics::instance().histogram("feed.candidates_prefetch")};
+            const ScannerMetrics::Timer timer(prefetchTime);
 
-            if (candidatesArray)
+            CandidatesPrefetch::Candidates candidates;
+            auto it {m_feedDatabase->seek("", cnaName)};
+            for (const auto& packagePrefix : prefetch.prefixes())
             {
-                for (const auto& candidate : *candidatesArray->candidates())
+                for (const auto& [key, value] : it.prefix(packagePrefix))
                 {
-                    if (callback(cnaName, package, *candidate))
-                    {
-                        // If the candidate is vulnerable, we stop looking for.
-                        break;
-                    }
+                    verifyCandidates(value);
+                    candidates[packagePrefix].emplace_back(value.data(), value.size());
                 }
             }
+            prefetch.store(cnaName, std::move(candidates));
+        }
+
+        for (const auto& value : prefetch.candidates(cnaName, prefix))
+        {
+            scanCandidates(cnaName, package, value.data(), callback);
         }
     }
 
@@ -619,7 +744,7 @@ public:
     std::vector<PackageData> checkAndTranslatePackage(const PackageData& package, const std::string& osPlatform)
     {
         std::vector<PackageData> vulnerabilityTranslations;
-        const auto cacheKey = osPlatform + "_" + package.vendor + "_" + package.name;
+        const auto cacheKey = translationKey(package, osPlatform);
 
         auto translatePackage = [&](const auto& translations)
         {
@@ -642,9 +767,17 @@ public:
             }
         };
 
+        auto& metrics {ScannerMetrics::instance()};
+        static auto& filterHits {metrics.counter("translation.filter_hits")};
+        static auto& l1Hits {metrics.counter("translation.l1_hits")};
+        static auto& l2Hits {metrics.counter("translation.l2_hits")};
+        static auto& misses {metrics.counter("translation.misses")};
+        static auto& indexHits {metrics.counter("translation.index_hits")};
+
         // Check first the filter
-        if (m_translationFilter->count(cacheKey) > 0)
+        if (filtered(cacheKey))
         {
+            filterHits.fetch_add(1, std::memory_order_relaxed);
             logDebug2(WM_VULNSCAN_LOGTAG,
                       "No translation exists for package '%s' on platform '%s'. Using provided package data.",
                       package.name.c_str(),
@@ -653,22 +786,39 @@ public:
         }
 
         // Check Level 1 cache
-        if (m_translationL1Cache->isHit(cacheKey))
+        if (const auto L1Translations = m_translationL1Cache->getValue(cacheKey); L1Translations.has_value())
         {
+            l1Hits.fetch_add(1, std::memory_order_relaxed);
             logDebug2(WM_VULNSCAN_LOGTAG,
                       "Translation for package '%s' on platform '%s' found in Level 1 cache.",
                       package.name.c_str(),
                       osPlatform.c_str());
 
-            const auto& L1Translations = m_translationL1Cache->getValue(cacheKey).value();
-            translatePackage(L1Translations);
+            translatePackage(*L1Translations);
+            return vulnerabilityTranslations;
+        }
+
+        // Check the persisted index, with the result of the previous lookups of the package
+        if (auto indexedTranslations = getTranslationFromIndex(cacheKey); indexedTranslations.has_value())
+        {
+            indexHits.fetch_add(1, std::memory_order_relaxed);
+            if (indexedTranslations->empty())
+            {
+                filter(cacheKey);
+                return vulnerabilityTranslations;
+            }
+
+            translatePackage(*indexedTranslations);
+            m_translationL1Cache->insertKey(cacheKey, std::move(*indexedTranslations));
             return vulnerabilityTranslations;
         }
 
         // Check Level 2 cache
         const auto L2Translations = getTranslationFromL2(package, osPlatform);
+        storeTranslationIndex(cacheKey, package, osPlatform, L2Translations);
         if (!L2Translations.empty())
         {
+            l2Hits.fetch_add(1, std::memory_order_relaxed);
             logDebug2(WM_VULNSCAN_LOGTAG,
                       "Translation for package '%s' on platform '%s' found in Level 2 cache.",
                       package.name.c_str(),
@@ -682,7 +832,8 @@ public:
         }
 
         // Insert the key in the filter to avoid searching for it again
-        m_translationFilter->insert(cacheKey);
+        misses.fetch_add(1, std::memory_order_relaxed);
+        filter(cacheKey);
         logDebug2(WM_VULNSCAN_LOGTAG,
                   "No translation exists for package '%s' on platform '%s'. Using provided package data.",
                   package.name.c_str(),
@@ -727,7 +878,8 @@ public:
     void getVulnerabiltyDescriptiveInformation(const std::string_view cveId,
                                                FlatbufferDataPair<VulnerabilityDescription>& resultContainer)
     {
-        if (m_feedDatabase->get(std::string(cveId), resultContainer.slice, DESCRIPTIONS_COLUMN) == false)
+        if (m_feedDatabase->get(std::string(cveId), resultContainer.slice, m_descriptionsColumn, m_readOptions) ==
+            false)
         {
             throw std::runtime_error(
                 "Error getting VulnerabilityDescription object from rocksdb. Object not found for cveId: " +
@@ -746,6 +898,51 @@ public:
             NSVulnerabilityScanner::GetVulnerabilityDescription(resultContainer.slice.data()));
     }
 
+    /**
+     * @brief Gets descriptive information for multiple cveids, looked up together in the database.
+     *
+     * @param cveIds cveids to search.
+     * @param resultContainers container structs to store the results, in the order of the cveids.
+     */
+    void getVulnerabilitiesDescriptiveInformation(
+        const std::vector<std::string>& cveIds,
+        std::vector<FlatbufferDataPair<VulnerabilityDescription>>& resultContainers)
+    {
+        static auto& readTime {ScannerMetrics::instance().histogram("feed.descriptions_read")};
+
+        std::vector<rocksdb::PinnableSlice> values;
+        const auto found = [&]()
+        {
+            const ScannerMetrics::Timer timer(readTime);
+            return m_feedDatabase->multiGet(cveIds, values, m_descriptionsColumn, m_readOptions);
+        }();
+
+        resultContainers.clear();
+        resultContainers.resize(cveIds.size());
+        for (size_t i = 0; i < cveIds.size(); ++i)
+        {
+            if (!found[i])
+            {
+                throw std::runtime_error(
+                    "Error getting VulnerabilityDescription object from rocksdb. Object not found for cveId: " +
+                    cveIds[i]);
+            }
+
+            auto& resultContainer = resultContainers[i];
+            resultContainer.slice = std::move(values[i]);
+            if (flatbuffers::Verifier verifier(reinterpret_cast<const uint8_t*>(resultContainer.slice.data()),
+                                               resultContainer.slice.size());
+                NSVulnerabilityScanner::VerifyVulnerabilityDescriptionBuffer(verifier) == false)
+            {
+                throw std::runtime_error(
+                    "Error getting VulnerabilityDescription object from rocksdb. FlatBuffers verifier failed");
+            }
+
+            resultContainer.data = const_cast<NSVulnerabilityScanner::VulnerabilityDescription*>(
+                NSVulnerabilityScanner::GetVulnerabilityDescription(resultContainer.slice.data()));
+        }
+    }
+
     /**
      * @brief Get CNA/ADP name based on the package source.
      *
@@ -860,16 +1057,408 @@ private:
     std::shared_ptr<TIndexerConnector> m_indexerConnector;
     std::unique_ptr<TContentRegister> m_contentRegistration;
     std::unique_ptr<TRocksDBWrapper> m_feedDatabase;
+    // Columns and read options of the lookups done for each vulnerability.
+    Utils::RocksDBColumn m_descriptionsColumn;
+    Utils::RocksDBColumn m_remediationsColumn;
+    Utils::RocksDBColumn m_translationsIndexColumn;
+    const rocksdb::ReadOptions m_readOptions {Utils::RocksDBOptions::buildReadMostlyOptions()};
     std::unique_ptr<TranslationLRUCache> m_translationL2Cache =
         std::make_unique<TranslationLRUCache>(TPolicyManager::instance().getTranslationLRUSize());
 
+    // Packages without translations, filled by the concurrent scans.
     std::unique_ptr<std::unordered_set<std::string>> m_translationFilter =
         std::make_unique<std::unordered_set<std::string>>();
-    std::unique_ptr<LRUCache<std::string, std::vector<PackageData>>> m_translationL1Cache =
-        std::make_unique<LRUCache<std::string, std::vector<PackageData>>>(
+    mutable std::mutex m_translationFilterMutex;
+    // Looked up and filled by the concurrent scans, under the shared lock.
+    std::unique_ptr<ShardedLRUCache<std::string, std::vector<PackageData>>> m_translationL1Cache =
+        std::make_unique<ShardedLRUCache<std::string, std::vector<PackageData>>>(
             TPolicyManager::instance().getTranslationLRUSize());
     std::unique_ptr<TRouterSubscriber> m_contentUpdateSubscription;
     const std::atomic<bool>& m_shouldStop;
+    std::atomic<uint64_t> m_feedGeneration {0};
+
+    // Distribution of the feed across the cluster.
+    const FeedDistributionRole m_feedDistributionRole;
+    const FeedDistribution m_feedDistribution;
+    std::thread m_distributionThread;
+    std::mutex m_distributionMutex;
+    std::condition_variable m_distributionCv;
+    bool m_stopDistribution {false};
+
+    /**
+     * @brief Opens a content file published by the content manager. The XZ files (published when the stream
+     * decompression is enabled) are decompressed while they are read, without storing the decompressed content.
+     *
+     * @param path Content file path.
+     * @return std::unique_ptr<std::istream> Stream with the content.
+     */
+    static std::unique_ptr<std::istream> openContent(const std::string& path)
+    {
+        if (std::filesystem::path(path).extension() == ".xz")
+        {
+            return std::make_unique<Utils::ChunkedInputStream>(
+                [path](const Utils::ChunkedInputStream::PushFunction& push)
+                {
+                    Utils::XzHelper(std::filesystem::path(path),
+                                    [&push](const uint8_t* data, size_t size)
+                                    { push(reinterpret_cast<const char*>(data), size); })
+                        .decompress();
+                });
+        }
+
+        auto file {std::make_unique<std::ifstream>(path)};
+        if (!file->is_open())
+        {
+            throw std::runtime_error("Unable to open input file: " + path);
+        }
+        return file;
+    }
+
+    /**
+     * @brief Verifies a candidates array read from the database.
+     *
+     * @param value Serialized ScanVulnerabilityCandidateArray.
+     */
+    static void verifyCandidates(const rocksdb::Slice& value)
+    {
+        if (flatbuffers::Verifier verifier(reinterpret_cast<const uint8_t*>(value.data()), value.size());
+            !NSVulnerabilityScanner::VerifyScanVulnerabilityCandidateArrayBuffer(verifier))
+        {
+            throw std::runtime_error(
+                "Error getting ScanVulnerabilityCandidateArray object from rocksdb. FlatBuffers verifier failed");
+        }
+    }
+
+    /**
+     * @brief Calls the callback for each candidate of a verified array, until a candidate is vulnerable.
+     *
+     * @param cnaName RocksDB table identifier.
+     * @param package Struct with package data.
+     * @param data Verified ScanVulnerabilityCandidateArray.
+     * @param callback Store vulnerability data.
+     */
+    static void scanCandidates(
+        const std::string& cnaName,
+        const PackageData& package,
+        const char* data,
+        const std::function<bool(const std::string& cnaName,
+                                 const PackageData& package,
+                                 const NSVulnerabilityScanner::ScanVulnerabilityCandidate&)>& callback)
+    {
+        auto candidatesArray = GetScanVulnerabilityCandidateArray(reinterpret_cast<const uint8_t*>(data));
+
+        if (candidatesArray)
+        {
+            for (const auto& candidate : *candidatesArray->candidates())
+            {
+                if (callback(cnaName, package, *candidate))
+                {
+                    // If the candidate is vulnerable, we stop looking for.
+                    break;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Gets the handles of the columns looked up by the scans, they stay valid while the database is open.
+     */
+    void resolveFeedColumns()
+    {
+        m_descriptionsColumn = m_feedDatabase->column(DESCRIPTIONS_COLUMN);
+        m_remediationsColumn = m_feedDatabase->column(REMEDIATIONS_COLUMN);
+
+        // The index isn't part of the feed, so it's missing in a new or imported database.
+        if (!m_feedDatabase->columnExists(TRANSLATIONS_INDEX_COLUMN))
+        {
+            m_feedDatabase->createColumn(TRANSLATIONS_INDEX_COLUMN);
+        }
+        m_translationsIndexColumn = m_feedDatabase->column(TRANSLATIONS_INDEX_COLUMN);
+    }
+
+    /**
+     * @brief Key of the translations of a package, in the caches and in the persisted index.
+     *
+     * @param package Package data.
+     * @param osPlatform Operating system platform.
+     * @return std::string Key.
+     */
+    static std::string translationKey(const PackageData& package, const std::string& osPlatform)
+    {
+        return osPlatform + "_" + package.vendor + "_" + package.name;
+    }
+
+    /**
+     * @brief Checks whether a package is known to have no translations.
+     *
+     * @param key Translation key.
+     * @return true If the package has no translations.
+     */
+    bool filtered(const std::string& key) const
+    {
+        std::scoped_lock lock(m_translationFilterMutex);
+        return m_translationFilter->count(key) > 0;
+    }
+
+    /**
+     * @brief Records that a package has no translations.
+     *
+     * @param key Translation key.
+     */
+    void filter(const std::string& key)
+    {
+        std::scoped_lock lock(m_translationFilterMutex);
+        m_translationFilter->insert(key);
+    }
+
+    /**
+     * @brief Parses the translations of an entry of the persisted index.
+     *
+     * @param entry Index entry, with the package and its translations.
+     * @return std::vector<PackageData> Translations, empty if the package has none.
+     */
+    static std::vector<PackageData> parseIndexTranslations(const nlohmann::json& entry)
+    {
+        std::vector<PackageData> translations;
+        for (const auto& translation : entry.at("translations"))
+        {
+            translations.push_back(PackageData {.name = translation.at("name").get<std::string>(),
+                                                .vendor = translation.at("vendor").get<std::string>(),
+                                                .version = translation.at("version").get<std::string>()});
+        }
+        return translations;
+    }
+
+    /**
+     * @brief Serializes the translations of a package for the persisted index.
+     *
+     * @param translations Translations, empty if the package has none.
+     * @return nlohmann::json Array of translations.
+     */
+    static nlohmann::json serializeIndexTranslations(const std::vector<PackageData>& translations)
+    {
+        auto array = nlohmann::json::array();
+        for (const auto& translation : translations)
+        {
+            array.push_back(
+                {{"name", translation.name}, {"vendor", translation.vendor}, {"version", translation.version}});
+        }
+        return array;
+    }
+
+    /**
+     * @brief Gets the translations of a package from the persisted index.
+     *
+     * @param key Translation key.
+     * @return std::optional<std::vector<PackageData>> Translations (empty if the package has none), or nothing if
+     * the package isn't indexed.
+     */
+    std::optional<std::vector<PackageData>> getTranslationFromIndex(const std::string& key)
+    {
+        rocksdb::PinnableSlice value;
+        if (!m_feedDatabase->get(key, value, m_translationsIndexColumn, m_readOptions))
+        {
+            return std::nullopt;
+        }
+
+        try
+        {
+            return parseIndexTranslations(nlohmann::json::parse(value.data(), value.data() + value.size()));
+        }
+        catch (const std::exception& e)
+        {
+            logDebug2(WM_VULNSCAN_LOGTAG, "Invalid translations index entry '%s'. Reason: %s.", key.c_str(), e.what());
+            return std::nullopt;
+        }
+    }
+
+    /**
+     * @brief Persists the translations of a package, so the next lookups (and the caches, when the module starts)
+     * don't match it against the translation rules again.
+     *
+     * @param key Translation key.
+     * @param package Package data.
+     * @param osPlatform Operating system platform.
+     * @param translations Translations, empty if the package has none.
+     */
+    void storeTranslationIndex(const std::string& key,
+                               const PackageData& package,
+                               const std::string& osPlatform,
+                               const std::vector<PackageData>& translations)
+    {
+        nlohmann::json entry;
+        entry["platform"] = osPlatform;
+        entry["vendor"] = package.vendor;
+        entry["name"] = package.name;
+        entry["translations"] = serializeIndexTranslations(translations);
+
+        try
+        {
+            m_feedDatabase->put(key, entry.dump(), m_translationsIndexColumn);
+        }
+        catch (const std::exception& e)
+        {
+            logDebug2(
+                WM_VULNSCAN_LOGTAG, "Unable to index the translations of '%s'. Reason: %s.", key.c_str(), e.what());
+        }
+    }
+
+    /**
+     * @brief Warms the Level 1 cache and the filter with the persisted index of translations.
+     *
+     * @details If the translation rules changed since the index was built, each indexed package is matched against the
+     * new rules first, so the index never returns the translations of older rules. The fingerprint is stored last,
+     * so an interrupted rebuild is started again.
+     *
+     * @param rulesFingerprint Fingerprint of the translation rules loaded in the Level 2 cache.
+     */
+    void warmTranslationCaches(const uint64_t rulesFingerprint)
+    {
+        constexpr auto FINGERPRINT_KEY {"#rules_fingerprint"};
+        const auto currentFingerprint {std::to_string(rulesFingerprint)};
+
+        std::string storedFingerprint;
+        const auto rebuild {!m_feedDatabase->get(FINGERPRINT_KEY, storedFingerprint, m_translationsIndexColumn) ||
+                            storedFingerprint != currentFingerprint};
+
+        std::vector<std::pair<std::string, nlohmann::json>> rebuiltEntries;
+        std::vector<std::string> invalidEntries;
+        size_t warmed {0};
+        for (const auto& [key, value] :
+             m_feedDatabase->begin(m_translationsIndexColumn, Utils::RocksDBOptions::buildScanOptions()))
+        {
+            if (key == FINGERPRINT_KEY)
+            {
+                continue;
+            }
+
+            try
+            {
+                auto entry = nlohmann::json::parse(value.data(), value.data() + value.size());
+                if (rebuild)
+                {
+                    const PackageData package {.name = entry.at("name").get<std::string>(),
+                                               .vendor = entry.at("vendor").get<std::string>()};
+                    const auto translations {getTranslationFromL2(package, entry.at("platform").get<std::string>())};
+
+                    entry["translations"] = serializeIndexTranslations(translations);
+                    rebuiltEntries.emplace_back(key, entry);
+                }
+
+                if (auto translations = parseIndexTranslations(entry); translations.empty())
+                {
+                    filter(key);
+                }
+                else if (!m_translationL1Cache->isFull())
+                {
+                    m_translationL1Cache->insertKey(key, std::move(translations));
+                }
+                ++warmed;
+            }
+            catch (const std::exception&)
+            {
+                invalidEntries.push_back(key);
+            }
+        }
+
+        for (const auto& [key, entry] : rebuiltEntries)
+        {
+            m_feedDatabase->put(key, entry.dump(), m_translationsIndexColumn);
+        }
+        for (const auto& key : invalidEntries)
+        {
+            m_feedDatabase->delete_(key, m_translationsIndexColumn);
+        }
+        m_feedDatabase->put(FINGERPRINT_KEY, currentFingerprint, m_translationsIndexColumn);
+
+        logDebug2(WM_VULNSCAN_LOGTAG,
+                  "Translation caches warmed with %zu indexed packages%s.",
+                  warmed,
+                  rebuild ? ", rebuilt for the new translation rules" : "");
+    }
+
+    /**
+     * @brief Replaces the feed database with the one imported from a snapshot.
+     *
+     * @note This methods locks the mutex.
+     */
+    void replaceFeedDatabase()
+    {
+        std::filesystem::remove_all(PREVIOUS_DATABASE_PATH);
+        {
+            std::scoped_lock<std::shared_mutex> lock(m_mutex);
+
+            // The directories are renamed, so the scans are blocked only while the databases are closed and opened.
+            m_feedDatabase.reset();
+            std::filesystem::rename(DATABASE_PATH, PREVIOUS_DATABASE_PATH);
+            std::filesystem::rename(IMPORT_DATABASE_PATH, DATABASE_PATH);
+            m_feedDatabase = std::make_unique<TRocksDBWrapper>(DATABASE_PATH, false);
+            resolveFeedColumns();
+        }
+        std::filesystem::remove_all(PREVIOUS_DATABASE_PATH);
+    }
+
+    /**
+     * @brief Exports the feed database for the worker nodes of the cluster.
+     */
+    void exportFeed()
+    {
+        try
+        {
+            std::shared_lock<std::shared_mutex> lock(m_mutex);
+            const auto version {m_feedDistribution.publish(*m_feedDatabase)};
+            logDebug1(WM_VULNSCAN_LOGTAG, "Feed exported for the worker nodes, version: %s.", version.c_str());
+        }
+        catch (const std::exception& e)
+        {
+            logError(WM_VULNSCAN_LOGTAG, "Error exporting the feed for the worker nodes: %s.", e.what());
+        }
+    }
+
+    /**
+     * @brief Imports the feed exported by the master node each time a new version is received, until the object is
+     * destroyed. The imported database replaces the current one like a snapshot.
+     *
+     * @param postUpdateCallback Callback to be executed after each import.
+     */
+    void importDistributedFeeds(const std::function<void(const FeedDelta&)>& postUpdateCallback)
+    {
+        std::string currentVersion;
+        if (std::ifstream file {DISTRIBUTED_VERSION_PATH}; file.is_open())
+        {
+            std::getline(file, currentVersion);
+        }
+
+        std::unique_lock lock(m_distributionMutex);
+        do
+        {
+            try
+            {
+                if (const auto version {m_feedDistribution.available(currentVersion)}; !version.empty())
+                {
+                    logInfo(WM_VULNSCAN_LOGTAG, "Importing the feed distributed by the master node.");
+                    std::filesystem::remove_all(IMPORT_DATABASE_PATH);
+                    m_feedDistribution.fetch(version, IMPORT_DATABASE_PATH);
+                    replaceFeedDatabase();
+                    reloadGlobalMaps();
+
+                    currentVersion = version;
+                    std::ofstream {DISTRIBUTED_VERSION_PATH} << currentVersion;
+
+                    FeedDelta feedDelta;
+                    feedDelta.markFull();
+                    postUpdateCallback(feedDelta);
+                    logInfo(WM_VULNSCAN_LOGTAG, "Feed update process completed.");
+                }
+            }
+            catch (const std::exception& e)
+            {
+                std::filesystem::remove_all(IMPORT_DATABASE_PATH);
+                logError(WM_VULNSCAN_LOGTAG, "Error importing the distributed feed: %s.", e.what());
+            }
+        } while (!m_distributionCv.wait_for(
+            lock, FEED_DISTRIBUTION_CHECK_INTERVAL, [this]() { return m_stopDistribution; }));
+    }
 
     void contentManagerUpdateOffset(const std::string& topicName, const long long currentOffset) const
     {
@@ -953,6 +1542,9 @@ private:
 
         // Load translations into the Level 2 cache
         fillL2CacheTranslations();
+
+        // The data derived from the previous feed is no longer valid.
+        ++m_feedGeneration;
     }
 };
 
@@ -12,6 +12,7 @@
 #ifndef _EVENT_CONTEXT_HPP
 #define _EVENT_CONTEXT_HPP
 
+#include "feedDelta.hpp"
 #include "flatbuffers/detached_buffer.h"
 #include "json.hpp"
 #include "rocksDBWrapper.hpp"
@@ -38,6 +39,7 @@ struct EventContext final
     flatbuffers::DetachedBuffer cve5Buffer; ///< CVE data.
     Utils::IRocksDBWrapper* feedDatabase;   ///< CVEs database.
     ResourceType resourceType;              ///< Resource type.
+    FeedDelta* feedDelta {nullptr};         ///< Changes of the update, if they're tracked.
 };
 
 #endif // _EVENT_CONTEXT_HPP
@@ -0,0 +1,80 @@
+/*
+ * Wazuh Vulnerability scanner - Database Feed Manager
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _FEED_DELTA_HPP
+#define _FEED_DELTA_HPP
+
+#include <set>
+#include <string>
+#include <string_view>
+#include <utility>
+
+/**
+ * @brief FeedDelta class.
+ *
+ * @details Changes applied to the feed database by an update, used to decide which scans must be repeated. The CVE
+ * records only change the candidates of their packages, so they're tracked as (CNA, package name) keys. Any other
+ * change (a snapshot, the translations, the vendor, OS CPE or CNA maps) may change the result of any scan, so the
+ * delta is marked as full.
+ *
+ * An instance isn't thread safe, except that a full delta ignores the keys added afterwards.
+ */
+class FeedDelta final
+{
+    bool m_full {false};
+    std::set<std::pair<std::string, std::string>> m_candidates;
+
+public:
+    /**
+     * @brief Adds the candidates of a package, they were written or removed.
+     *
+     * @param cnaName CNA name, the column of the candidates.
+     * @param packageName Package name, as it's queried.
+     */
+    void addCandidates(std::string_view cnaName, std::string_view packageName)
+    {
+        if (!m_full)
+        {
+            m_candidates.emplace(cnaName, packageName);
+        }
+    }
+
+    /**
+     * @brief Marks the delta as full: Any scan may be affected.
+     */
+    void markFull()
+    {
+        m_full = true;
+        m_candidates.clear();
+    }
+
+    /**
+     * @brief Checks whether any scan may be affected.
+     *
+     * @return true If the delta is full.
+     */
+    bool full() const
+    {
+        return m_full;
+    }
+
+    /**
+     * @brief Candidates that changed, if the delta isn't full.
+     *
+     * @return const std::set<std::pair<std::string, std::string>>& (CNA, package name) keys.
+     */
+    const std::set<std::pair<std::string, std::string>>& candidates() const
+    {
+        return m_candidates;
+    }
+};
+
+#endif // _FEED_DELTA_HPP
@@ -0,0 +1,173 @@
+/*
+ * Wazuh Vulnerability scanner - Database Feed Manager
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _FEED_DISTRIBUTION_HPP
+#define _FEED_DISTRIBUTION_HPP
+
+#include "rocksDBWrapper.hpp"
+#include <chrono>
+#include <external/nlohmann/json.hpp>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+
+// The directory is synchronized from the master node to the workers by the cluster (see cluster.json).
+constexpr auto FEED_DISTRIBUTION_PATH {"queue/vd/feed_distribution"};
+constexpr auto FEED_DISTRIBUTION_TMP_PATH {"queue/vd/feed_distribution_tmp"};
+constexpr auto FEED_DISTRIBUTION_MANIFEST {"manifest.json"};
+
+/**
+ * @brief Role of the node in the distribution of the feed.
+ */
+enum class FeedDistributionRole
+{
+    NONE,   ///< The node updates its own feed.
+    MASTER, ///< The node updates the feed and exports it for the workers.
+    WORKER  ///< The node imports the feed exported by the master.
+};
+
+/**
+ * @brief FeedDistribution class.
+ *
+ * @details The master node exports its feed database, once updated, as a checkpoint: A directory with the sorted
+ * files of the database, hard linked, and a manifest with the version and the size of each file, written last. The
+ * workers receive the files through the cluster synchronization, in any order, so a version is only available once
+ * all the files listed by its manifest are complete. Then it's copied and opened as the new feed database, without
+ * downloading, parsing or encoding the content again.
+ */
+class FeedDistribution final
+{
+    const std::filesystem::path m_path;
+    const std::filesystem::path m_tmpPath;
+
+    nlohmann::json readManifest() const
+    {
+        std::ifstream file {m_path / FEED_DISTRIBUTION_MANIFEST};
+        if (!file.is_open())
+        {
+            return {};
+        }
+        auto manifest {nlohmann::json::parse(file, nullptr, false)};
+        return manifest.is_discarded() ? nlohmann::json {} : manifest;
+    }
+
+public:
+    /**
+     * @brief Class constructor.
+     *
+     * @param path Directory of the exported feed.
+     * @param tmpPath Directory where the checkpoint is created, in the same filesystem and out of the synchronized
+     * one, so the workers never see a partial checkpoint.
+     */
+    explicit FeedDistribution(std::filesystem::path path = FEED_DISTRIBUTION_PATH,
+                              std::filesystem::path tmpPath = FEED_DISTRIBUTION_TMP_PATH)
+        : m_path(std::move(path))
+        , m_tmpPath(std::move(tmpPath))
+    {
+    }
+
+    /**
+     * @brief Exports the feed database, replacing the previous version.
+     *
+     * @param database Feed database.
+     * @return std::string Version exported.
+     */
+    std::string publish(Utils::RocksDBWrapper& database) const
+    {
+        const auto version {std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                               std::chrono::system_clock::now().time_since_epoch())
+                                               .count())};
+
+        std::filesystem::remove_all(m_tmpPath);
+        database.createCheckpoint(m_tmpPath);
+
+        nlohmann::json manifest;
+        manifest["version"] = version;
+        manifest["files"] = nlohmann::json::object();
+        for (const auto& entry : std::filesystem::directory_iterator(m_tmpPath))
+        {
+            manifest["files"][entry.path().filename().string()] = entry.file_size();
+        }
+
+        // The previous versions are removed, so the workers don't receive them anymore.
+        std::filesystem::create_directories(m_path);
+        for (const auto& entry : std::filesystem::directory_iterator(m_path))
+        {
+            std::filesystem::remove_all(entry.path());
+        }
+        std::filesystem::rename(m_tmpPath, m_path / version);
+
+        const auto manifestPath {m_path / FEED_DISTRIBUTION_MANIFEST};
+        const auto manifestTmpPath {m_tmpPath.string() + "_" + FEED_DISTRIBUTION_MANIFEST};
+        {
+            std::ofstream file {manifestTmpPath};
+            if (!file.is_open())
+            {
+                throw std::runtime_error {"Unable to write the feed manifest: " + manifestTmpPath};
+            }
+            file << manifest.dump();
+        }
+        std::filesystem::rename(manifestTmpPath, manifestPath);
+
+        return version;
+    }
+
+    /**
+     * @brief Checks if a new version of the feed is available.
+     *
+     * @param currentVersion Version imported by this node.
+     * @return std::string Version available, empty if there isn't a different one or its files are still being
+     * received.
+     */
+    std::string available(const std::string& currentVersion) const
+    {
+        const auto manifest {readManifest()};
+        if (!manifest.contains("version") || !manifest.contains("files"))
+        {
+            return {};
+        }
+
+        const auto& version {manifest.at("version").get_ref<const std::string&>()};
+        if (version == currentVersion)
+        {
+            return {};
+        }
+
+        for (const auto& [name, size] : manifest.at("files").items())
+        {
+            std::error_code ec;
+            if (std::filesystem::file_size(m_path / version / name, ec) != size.get<uintmax_t>() || ec)
+            {
+                return {};
+            }
+        }
+        return version;
+    }
+
+    /**
+     * @brief Copies a version of the feed into a new database directory.
+     *
+     * @details The files are copied instead of linked, because the synchronization may replace or remove them while
+     * the database is open.
+     *
+     * @param version Version to copy, returned by available().
+     * @param destination Directory of the new database, it must not exist.
+     */
+    void fetch(const std::string& version, const std::filesystem::path& destination) const
+    {
+        std::filesystem::copy(m_path / version, destination, std::filesystem::copy_options::recursive);
+    }
+};
+
+#endif // _FEED_DISTRIBUTION_HPP
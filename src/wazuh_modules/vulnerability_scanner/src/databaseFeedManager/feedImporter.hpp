@@ -0,0 +1,338 @@
+/*
+ * Wazuh Vulnerability scanner - Database Feed Manager
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _FEED_IMPORTER_HPP
+#define _FEED_IMPORTER_HPP
+
+#include "databaseFeedManagerException.hpp"
+#include "loggerHelper.h"
+#include "rocksDBWrapper.hpp"
+#include "vulnerabilityScannerDefs.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <external/nlohmann/json.hpp>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+constexpr auto FEED_IMPORT_LINES_PER_TASK {64u};
+constexpr auto FEED_IMPORT_MAX_WORKERS {8u};
+constexpr size_t FEED_IMPORT_MEMORY_BUDGET {256 * 1024 * 1024};
+constexpr size_t FEED_IMPORT_WRITE_BATCH_SIZE {8 * 1024 * 1024};
+
+/**
+ * @brief FeedImporter class.
+ *
+ * @details Imports a snapshot of the feed (one resource per line) into an empty database through a pipeline: The
+ * caller thread reads the lines, a pool of workers parses them and runs the orchestration (that encodes the resources
+ * into flatbuffers) over per worker write batches, and a writer thread writes the full batches into the database. The
+ * lines waiting to be processed and the batches waiting to be written are bounded by the memory budget, so a slow
+ * stage blocks the previous one instead of accumulating the snapshot in memory.
+ *
+ * The resources of a snapshot are independent from each other, so they can be processed in any order. The reads done
+ * by the orchestration don't see the writes still pending on the batches, which is harmless on an empty database.
+ */
+class FeedImporter final
+{
+public:
+    /**
+     * @brief Chain of actions to execute for each resource.
+     */
+    using Orchestration = std::function<void(const nlohmann::json&, Utils::IRocksDBWrapper*)>;
+
+private:
+    /**
+     * @brief Queue whose elements can't exceed a size in bytes.
+     *
+     * @tparam T Element type.
+     */
+    template<typename T>
+    class BoundedQueue final
+    {
+        std::mutex m_mutex;
+        std::condition_variable m_cv;
+        std::queue<std::pair<T, size_t>> m_elements;
+        const size_t m_maxBytes;
+        size_t m_bytes {0};
+        bool m_closed {false};
+        bool m_canceled {false};
+
+    public:
+        explicit BoundedQueue(const size_t maxBytes)
+            : m_maxBytes(maxBytes)
+        {
+        }
+
+        /**
+         * @brief Pushes an element, waiting while the queue is full. An element larger than the queue is pushed
+         * once the queue is empty.
+         *
+         * @return false If the queue was canceled.
+         */
+        bool push(T element, const size_t bytes)
+        {
+            std::unique_lock lock {m_mutex};
+            m_cv.wait(lock, [&]() { return m_canceled || m_elements.empty() || m_bytes + bytes <= m_maxBytes; });
+            if (m_canceled)
+            {
+                return false;
+            }
+
+            m_bytes += bytes;
+            m_elements.emplace(std::move(element), bytes);
+            m_cv.notify_all();
+            return true;
+        }
+
+        /**
+         * @brief Pops an element, waiting while the queue is empty.
+         *
+         * @return false If the queue was canceled, or closed and empty.
+         */
+        bool pop(T& element)
+        {
+            std::unique_lock lock {m_mutex};
+            m_cv.wait(lock, [this]() { return m_canceled || m_closed || !m_elements.empty(); });
+            if (m_canceled || m_elements.empty())
+            {
+                return false;
+            }
+
+            element = std::move(m_elements.front().first);
+            m_bytes -= m_elements.front().second;
+            m_elements.pop();
+            m_cv.notify_all();
+            return true;
+        }
+
+        /**
+         * @brief No more elements will be pushed: The consumers end once the queue is empty.
+         */
+        void close()
+        {
+            std::scoped_lock lock {m_mutex};
+            m_closed = true;
+            m_cv.notify_all();
+        }
+
+        /**
+         * @brief Releases the producers and consumers, discarding the pending elements.
+         */
+        void cancel()
+        {
+            std::scoped_lock lock {m_mutex};
+            m_canceled = true;
+            m_cv.notify_all();
+        }
+    };
+
+    Utils::RocksDBWrapper& m_database;
+    Orchestration m_orchestration;
+    const std::atomic<bool>& m_shouldStop;
+    const unsigned int m_workers;
+    BoundedQueue<std::vector<std::string>> m_lines;
+    BoundedQueue<std::unique_ptr<Utils::RocksDBWriteBatch>> m_batches;
+    std::shared_mutex m_columnsMutex;
+    std::mutex m_errorMutex;
+    std::exception_ptr m_error;
+
+    /**
+     * @brief Keeps the first error and stops the pipeline.
+     *
+     * @param error Exception thrown by any stage.
+     */
+    void fail(std::exception_ptr error)
+    {
+        {
+            std::scoped_lock lock {m_errorMutex};
+            if (!m_error)
+            {
+                m_error = std::move(error);
+            }
+        }
+        m_lines.cancel();
+        m_batches.cancel();
+    }
+
+    /**
+     * @brief Worker: Parses the lines and executes the orchestration for each resource.
+     *
+     * @param path Content file path, for the error messages.
+     */
+    void processLines(const std::string& path)
+    {
+        try
+        {
+            auto batch {std::make_unique<Utils::RocksDBWriteBatch>(&m_database, m_columnsMutex)};
+            std::vector<std::string> lines;
+            while (m_lines.pop(lines))
+            {
+                for (const auto& line : lines)
+                {
+                    auto parsedLine = nlohmann::json::parse(line, nullptr, false);
+                    if (parsedLine.is_discarded() || !parsedLine.contains("name"))
+                    {
+                        throw std::runtime_error("Invalid line. file: " + path);
+                    }
+
+                    parsedLine["resource"] = parsedLine["name"];
+                    parsedLine["type"] = "create";
+
+                    m_orchestration(parsedLine, batch.get());
+                }
+
+                if (const auto size {batch->size()}; size >= FEED_IMPORT_WRITE_BATCH_SIZE)
+                {
+                    if (!m_batches.push(std::move(batch), size))
+                    {
+                        return;
+                    }
+                    batch = std::make_unique<Utils::RocksDBWriteBatch>(&m_database, m_columnsMutex);
+                }
+            }
+
+            if (!batch->empty())
+            {
+                const auto size {batch->size()};
+                m_batches.push(std::move(batch), size);
+            }
+        }
+        catch (...)
+        {
+            fail(std::current_exception());
+        }
+    }
+
+    /**
+     * @brief Writer: Writes the batches filled by the workers into the database.
+     */
+    void writeBatches()
+    {
+        try
+        {
+            std::unique_ptr<Utils::RocksDBWriteBatch> batch;
+            while (m_batches.pop(batch))
+            {
+                batch->commit();
+            }
+        }
+        catch (...)
+        {
+            fail(std::current_exception());
+        }
+    }
+
+public:
+    /**
+     * @brief Class constructor.
+     *
+     * @param database Database where the resources are imported, it should be empty.
+     * @param orchestration Chain of actions to execute for each resource, it's called concurrently.
+     * @param shouldStop Variable to control the graceful shutdown of the module.
+     * @param workers Number of workers. If zero, it depends on the number of CPUs.
+     * @param memoryBudget Maximum size of the lines waiting to be processed plus the batches waiting to be written.
+     * Each worker also fills a batch of up to FEED_IMPORT_WRITE_BATCH_SIZE bytes.
+     */
+    FeedImporter(Utils::RocksDBWrapper& database,
+                 Orchestration orchestration,
+                 const std::atomic<bool>& shouldStop,
+                 const unsigned int workers = 0,
+                 const size_t memoryBudget = FEED_IMPORT_MEMORY_BUDGET)
+        : m_database(database)
+        , m_orchestration(std::move(orchestration))
+        , m_shouldStop(shouldStop)
+        , m_workers(workers != 0 ? workers
+                                 : std::clamp(std::thread::hardware_concurrency(), 1u, FEED_IMPORT_MAX_WORKERS))
+        , m_lines(memoryBudget / 2)
+        , m_batches(memoryBudget / 2)
+    {
+    }
+
+    /**
+     * @brief Imports the content. An importer can only be used once.
+     *
+     * @param content Snapshot content, with a JSON resource per line.
+     * @param path Content file path, for the log and error messages.
+     */
+    void import(std::istream& content, const std::string& path)
+    {
+        std::vector<std::thread> workers;
+        for (auto i {0u}; i < m_workers; ++i)
+        {
+            workers.emplace_back(&FeedImporter::processLines, this, std::cref(path));
+        }
+        std::thread writer {&FeedImporter::writeBatches, this};
+
+        try
+        {
+            std::string line;
+            std::vector<std::string> lines;
+            size_t linesSize {0};
+            int32_t step = 0;
+            while (std::getline(content, line))
+            {
+                if (m_shouldStop.load())
+                {
+                    throw DatabaseFeedManagerException("Module stopped.");
+                }
+
+                if (step++ % 1000 == 0)
+                {
+                    logDebug2(WM_VULNSCAN_LOGTAG, "Processing line: %d", step);
+                }
+
+                linesSize += line.size();
+                lines.push_back(std::move(line));
+                if (lines.size() == FEED_IMPORT_LINES_PER_TASK)
+                {
+                    if (!m_lines.push(std::exchange(lines, {}), std::exchange(linesSize, 0)))
+                    {
+                        break;
+                    }
+                }
+            }
+
+            if (!lines.empty())
+            {
+                m_lines.push(std::move(lines), linesSize);
+            }
+        }
+        catch (...)
+        {
+            fail(std::current_exception());
+        }
+
+        m_lines.close();
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+        m_batches.close();
+        writer.join();
+
+        if (m_error)
+        {
+            std::rethrow_exception(m_error);
+        }
+    }
+};
+
+#endif // _FEED_IMPORTER_HPP
@@ -57,14 +57,14 @@ public:
                     UpdateHotfixes::storeVulnerabilityHotfixes(cve5Entry, data->feedDatabase);
                     UpdateCVERemediations::storeVulnerabilityRemediation(cve5Entry, data->feedDatabase);
                     UpdateCVEDescription::storeVulnerabilityDescription(cve5Entry, data->feedDatabase);
-                    UpdateCVECandidates::storeVulnerabilityCandidate(cve5Entry, data->feedDatabase);
+                    UpdateCVECandidates::storeVulnerabilityCandidate(cve5Entry, data->feedDatabase, data->feedDelta);
                 }
                 else if ("REJECTED" == state)
                 {
                     UpdateHotfixes::removeHotfix(cve5Entry, data->feedDatabase);
                     UpdateCVERemediations::removeRemediation(cve5Entry, data->feedDatabase);
                     UpdateCVEDescription::removeVulnerabilityDescription(cve5Entry, data->feedDatabase);
-                    UpdateCVECandidates::removeVulnerabilityCandidate(cve5Entry, data->feedDatabase);
+                    UpdateCVECandidates::removeVulnerabilityCandidate(cve5Entry, data->feedDatabase, data->feedDelta);
                 }
                 else
                 {
@@ -78,7 +78,15 @@ public:
                     UpdateHotfixes::storeVulnerabilityHotfixes(cve5Entry, data->feedDatabase);
                     UpdateCVERemediations::storeVulnerabilityRemediation(cve5Entry, data->feedDatabase);
                     UpdateCVEDescription::storeVulnerabilityDescription(cve5Entry, data->feedDatabase);
-                    UpdateCVECandidates::storeVulnerabilityCandidate(cve5Entry, data->feedDatabase);
+                    UpdateCVECandidates::storeVulnerabilityCandidate(cve5Entry, data->feedDatabase, data->feedDelta);
+                }
+                else if ("REJECTED" == state)
+                {
+                    // A creation may replace an existing resource, e.g. when the offsets are coalesced.
+                    UpdateHotfixes::removeHotfix(cve5Entry, data->feedDatabase);
+                    UpdateCVERemediations::removeRemediation(cve5Entry, data->feedDatabase);
+                    UpdateCVEDescription::removeVulnerabilityDescription(cve5Entry, data->feedDatabase);
+                    UpdateCVECandidates::removeVulnerabilityCandidate(cve5Entry, data->feedDatabase, data->feedDelta);
                 }
             }
             else
@@ -86,6 +94,11 @@ public:
                 throw std::runtime_error("Invalid type of resource.");
             }
         }
+        else if (data->feedDelta)
+        {
+            // The translations and the maps may change the result of any scan.
+            data->feedDelta->markFull();
+        }
 
         return AbstractHandler<std::shared_ptr<EventContext>>::handleRequest(std::move(data));
     }
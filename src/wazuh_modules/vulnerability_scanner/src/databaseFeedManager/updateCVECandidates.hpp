@@ -13,6 +13,7 @@
 #define _UPDATE_CVE_CANDIDATES_HPP
 
 #include "cve5_generated.h"
+#include "feedDelta.hpp"
 #include "rocksDBWrapper.hpp"
 #include "stringHelper.h"
 #include "vulnerabilityCandidate_generated.h"
@@ -36,8 +37,11 @@ public:
      *
      * @param cve5Flatbuffer CVE5 Flatbuffer.
      * @param feedDatabase rocksDB wrapper instance.
+     * @param feedDelta Changes of the update, the packages of the CVE are added to it. Optional.
      */
-    static void storeVulnerabilityCandidate(const cve_v5::Entry* cve5Flatbuffer, Utils::IRocksDBWrapper* feedDatabase)
+    static void storeVulnerabilityCandidate(const cve_v5::Entry* cve5Flatbuffer,
+                                            Utils::IRocksDBWrapper* feedDatabase,
+                                            FeedDelta* feedDelta = nullptr)
     {
         if (!cve5Flatbuffer || !cve5Flatbuffer->containers())
         {
@@ -81,7 +85,8 @@ public:
                     continue;
                 }
 
-                const auto productName = Utils::toLowerCase(affected->product()->str());
+                auto productName = affected->product()->str();
+                Utils::toLowerCaseInPlace(productName);
                 if (candidatesArraysMap.find(productName) == candidatesArraysMap.end())
                 {
                     candidatesArraysMap.emplace(
@@ -171,11 +176,22 @@ public:
                 {
                     feedDatabase->delete_(packageCve, shortName);
                     feedDatabase->delete_(cvePackage, CVE_PACKAGE_COLUMN_NAME);
+                    if (feedDelta)
+                    {
+                        feedDelta->addCandidates(shortName, packageCandidate);
+                    }
                 }
             }
 
             for (auto& [key, value] : candidatesArraysMap)
             {
+                // The packages are added even if their candidates don't change, as the rest of the CVE (description,
+                // remediations) is reported with them.
+                if (feedDelta)
+                {
+                    feedDelta->addCandidates(shortName, key);
+                }
+
                 const auto finalArray =
                     NSVulnerabilityScanner::CreateScanVulnerabilityCandidateArrayDirect(value.second, &value.first);
                 value.second.Finish(finalArray);
@@ -264,8 +280,11 @@ public:
      *
      * @param cve5Flatbuffer Flatbuffer object containing the CVE information.
      * @param feedDatabase rocksDB wrapper instance.
+     * @param feedDelta Changes of the update, the packages of the removed candidates are added to it. Optional.
      */
-    static void removeVulnerabilityCandidate(const cve_v5::Entry* cve5Flatbuffer, Utils::IRocksDBWrapper* feedDatabase)
+    static void removeVulnerabilityCandidate(const cve_v5::Entry* cve5Flatbuffer,
+                                             Utils::IRocksDBWrapper* feedDatabase,
+                                             FeedDelta* feedDelta = nullptr)
     {
         if (!cve5Flatbuffer->cveMetadata() || !cve5Flatbuffer->cveMetadata()->cveId())
         {
@@ -300,6 +319,11 @@ public:
                 {
                     feedDatabase->delete_(packageCve.ToString(), cnaName);
                     cvePackagesToDelete.push_back(cvePackage);
+                    if (feedDelta)
+                    {
+                        // The reverse key is the CVE ID, followed by "_" and the package name.
+                        feedDelta->addCandidates(cnaName, std::string_view(cvePackage).substr(cveId.size()));
+                    }
                 }
 
                 for (const auto& cvePackage : cvePackagesToDelete)
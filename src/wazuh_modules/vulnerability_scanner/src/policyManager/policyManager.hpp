@@ -128,6 +128,11 @@ private:
             newPolicy["vulnerability-detection"]["feed-update-interval"] = "60m";
         }
 
+        if (!newPolicy.at("vulnerability-detection").contains("feed-distribution"))
+        {
+            newPolicy["vulnerability-detection"]["feed-distribution"] = "no";
+        }
+
         if (!newPolicy.contains("updater"))
         {
             newPolicy["updater"] = nlohmann::json::object();
@@ -193,6 +198,11 @@ private:
             newPolicy["clusterName"] = UNKNOWN_VALUE;
         }
 
+        if (!newPolicy.contains("clusterNodeType"))
+        {
+            newPolicy["clusterNodeType"] = UNKNOWN_VALUE;
+        }
+
         return newPolicy;
     }
 
@@ -242,6 +252,14 @@ private:
             }
         }
 
+        if (vdObj.contains("feed-distribution"))
+        {
+            if (vdObj.at("feed-distribution") != "yes" && vdObj.at("feed-distribution") != "no")
+            {
+                throw std::runtime_error("Invalid feed distribution value.");
+            }
+        }
+
         if (vdObj.contains("offline-url"))
         {
             if (!(Utils::startsWith(vdObj["offline-url"], "file") || Utils::startsWith(vdObj["offline-url"], "http") ||
@@ -730,6 +748,27 @@ public:
         return m_configuration.at("clusterName").get_ref<const std::string&>();
     }
 
+    /**
+     * @brief Get feed distribution status.
+     * The feed is distributed when the option is enabled and the manager is part of a cluster: The master node
+     * updates it and exports the result, that the worker nodes import instead of updating it themselves.
+     * @return true if the feed is distributed, false otherwise.
+     */
+    bool isFeedDistributionEnabled() const
+    {
+        return m_configuration.contains("clusterEnabled") && m_configuration.at("clusterEnabled").get<bool>() &&
+               Utils::parseStrToBool(m_configuration.at("vulnerability-detection").at("feed-distribution"));
+    }
+
+    /**
+     * @brief Get whether the feed is imported from the master node.
+     * @return true if the feed is distributed and this node is a worker, false otherwise.
+     */
+    bool isFeedDistributionWorker() const
+    {
+        return isFeedDistributionEnabled() && m_configuration.at("clusterNodeType") == "worker";
+    }
+
     /**
      * @brief Retrieves the alerts max events per second.
      * This function retrieves the alerts max events per second from the configuration and returns it as a uint32_t.
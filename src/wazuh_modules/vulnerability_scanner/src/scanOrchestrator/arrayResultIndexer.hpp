@@ -15,6 +15,7 @@
 #include "chainOfResponsability.hpp"
 #include "indexerConnector.hpp"
 #include "scanContext.hpp"
+#include "scannerMetrics.hpp"
 
 /**
  * @brief ArrayResultIndexer class.
@@ -51,12 +52,16 @@ public:
     {
         if (m_indexerConnector != nullptr)
         {
+            static auto& publishTime {ScannerMetrics::instance().histogram("indexer.publish")};
+
             auto resultCallback = [&](const nlohmann::json& result, const std::string& key)
             {
                 logDebug2(WM_VULNSCAN_LOGTAG, "Processing and publish key: %s", key.c_str());
                 if (result.contains("operation") && result.contains("id"))
                 {
-                    m_indexerConnector->publish(result.dump());
+                    const auto element {result.dump()};
+                    const ScannerMetrics::Timer timer(publishTime);
+                    m_indexerConnector->publish(element);
                 }
                 else
                 {
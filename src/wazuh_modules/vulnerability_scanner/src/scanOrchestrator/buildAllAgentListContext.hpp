@@ -15,6 +15,7 @@
 #include "chainOfResponsability.hpp"
 #include "loggerHelper.h"
 #include "scanContext.hpp"
+#include "scannerMetrics.hpp"
 #include "socketDBWrapper.hpp"
 #include "vulnerabilityScanner.hpp"
 #include "wazuhDBQueryBuilder.hpp"
@@ -61,6 +62,7 @@ public:
         try
         {
             // Execute query
+            const ScannerMetrics::Timer timer {"wazuhdb.query"};
             TSocketDBWrapper::instance().query(
                 WazuhDBQueryBuilder::builder().globalGetCommand("all-agents context").build(), response);
         }
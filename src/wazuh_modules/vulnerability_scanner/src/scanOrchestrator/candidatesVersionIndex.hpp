@@ -0,0 +1,272 @@
+/*
+ * Wazuh Vulnerability scanner - Scan Orchestrator
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _CANDIDATES_VERSION_INDEX_HPP
+#define _CANDIDATES_VERSION_INDEX_HPP
+
+#include "vulnerabilityCandidate_generated.h"
+#include "versionMatcher/versionIntervalIndex.hpp"
+#include "versionMatcher/versionMatcher.hpp"
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief CandidatesVersionIndex class.
+ *
+ * @details Index of the affected version ranges of the vulnerability candidates of a package, for a package format.
+ * It's built while the candidates are evaluated for a first package, and it tells which candidates can't be
+ * vulnerable for the installed version of the following packages, so they are discarded without evaluating them.
+ *
+ * The index replicates the version matching of PackageScanner: The first version entry that contains the installed
+ * version defines the status, and the default status applies when no entry contains it. A candidate is always
+ * evaluated if any of its versions can't be compared, as the evaluation then depends on the installed version type.
+ */
+class CandidatesVersionIndex final
+{
+    struct Candidate
+    {
+        bool evaluate {false};
+        bool defaultAffected {false};
+        std::vector<bool> affectedEntries;
+    };
+
+    std::vector<Candidate> m_candidates;
+    // Candidates of each CVE, in the order they are stored in the database.
+    std::unordered_map<std::string, std::vector<size_t>> m_cveCandidates;
+    // Candidate and version entry of each interval.
+    std::vector<std::pair<size_t, size_t>> m_entries;
+    VersionIntervalIndex m_index;
+    uint64_t m_feedGeneration;
+    bool m_valid {false};
+
+public:
+    /**
+     * @brief Candidates that may be vulnerable for an installed version.
+     */
+    class Lookup final
+    {
+        friend class CandidatesVersionIndex;
+
+        const CandidatesVersionIndex* m_index {nullptr};
+        // First version entry of each candidate that contains the installed version.
+        std::unordered_map<size_t, size_t> m_matches;
+
+    public:
+        /**
+         * @brief Checks whether a candidate can be discarded without evaluating it.
+         *
+         * @param cveId CVE of the candidate.
+         * @param ordinal Position of the candidate among the candidates of the same CVE.
+         * @return true If the candidate can't be vulnerable.
+         */
+        bool discard(const std::string& cveId, const size_t ordinal) const
+        {
+            if (!m_index)
+            {
+                return false;
+            }
+
+            const auto it {m_index->m_cveCandidates.find(cveId)};
+            if (it == m_index->m_cveCandidates.end() || ordinal >= it->second.size())
+            {
+                return false;
+            }
+
+            const auto candidateId {it->second[ordinal]};
+            const auto& candidate {m_index->m_candidates[candidateId]};
+            if (candidate.evaluate)
+            {
+                return false;
+            }
+
+            if (const auto match {m_matches.find(candidateId)}; match != m_matches.end())
+            {
+                return !candidate.affectedEntries[match->second];
+            }
+            return !candidate.defaultAffected;
+        }
+    };
+
+    /**
+     * @brief Class constructor.
+     *
+     * @param feedGeneration Generation of the feed the candidates are read from.
+     */
+    explicit CandidatesVersionIndex(const uint64_t feedGeneration)
+        : m_feedGeneration(feedGeneration)
+    {
+    }
+
+    /**
+     * @brief Generation of the feed the index was built from.
+     *
+     * @return uint64_t Feed generation.
+     */
+    uint64_t feedGeneration() const
+    {
+        return m_feedGeneration;
+    }
+
+    /**
+     * @brief Adds a candidate, in the order they are read from the database.
+     *
+     * @param candidate Vulnerability candidate.
+     * @param parsedVersions Parsed versions of the package format.
+     */
+    void add(const NSVulnerabilityScanner::ScanVulnerabilityCandidate& candidate,
+             VersionMatcher::ParsedVersions& parsedVersions)
+    {
+        const auto candidateId {m_candidates.size()};
+        auto& newCandidate {m_candidates.emplace_back()};
+        m_cveCandidates[candidate.cveId()->str()].push_back(candidateId);
+        newCandidate.defaultAffected = candidate.defaultStatus() == NSVulnerabilityScanner::Status::Status_affected;
+
+        if (!candidate.versions())
+        {
+            newCandidate.evaluate = true;
+            return;
+        }
+
+        // Endpoints of each entry: Empty if the entry never contains a version.
+        std::vector<std::optional<std::pair<std::optional<VersionMatcher::ParsedVersion>,
+                                            std::optional<VersionMatcher::ParsedVersion>>>>
+            entries;
+        std::vector<bool> upperInclusive;
+        const auto parse = [&](const flatbuffers::String* version) -> std::optional<VersionMatcher::ParsedVersion>
+        {
+            const auto& parsedVersion {parsedVersions.get(version ? version->str() : "")};
+            if (!m_index.accepts(parsedVersion))
+            {
+                return std::nullopt;
+            }
+            return parsedVersion;
+        };
+
+        for (const auto& version : *candidate.versions())
+        {
+            newCandidate.affectedEntries.push_back(version->status() ==
+                                                   NSVulnerabilityScanner::Status::Status_affected);
+            const std::string lessThan {version->lessThan() ? version->lessThan()->str() : ""};
+            const std::string lessThanOrEqual {version->lessThanOrEqual() ? version->lessThanOrEqual()->str() : ""};
+
+            if (lessThan.empty() && lessThanOrEqual.empty())
+            {
+                const auto exact {parse(version->version())};
+                if (!exact)
+                {
+                    newCandidate.evaluate = true;
+                    return;
+                }
+                entries.emplace_back(std::make_pair(exact, exact));
+                upperInclusive.push_back(true);
+                continue;
+            }
+
+            std::optional<VersionMatcher::ParsedVersion> lower;
+            if (!version->version() || version->version()->str() != "0")
+            {
+                lower = parse(version->version());
+                if (!lower)
+                {
+                    newCandidate.evaluate = true;
+                    return;
+                }
+            }
+
+            const auto lessThanUpper {!lessThan.empty() && lessThan != "*"};
+            if (!lessThanUpper && lessThanOrEqual.empty())
+            {
+                entries.emplace_back(std::nullopt);
+                upperInclusive.push_back(false);
+                continue;
+            }
+
+            const auto upper {parse(lessThanUpper ? version->lessThan() : version->lessThanOrEqual())};
+            if (!upper)
+            {
+                newCandidate.evaluate = true;
+                return;
+            }
+            entries.emplace_back(std::make_pair(lower, upper));
+            upperInclusive.push_back(!lessThanUpper);
+        }
+
+        for (size_t entry {0}; entry < entries.size(); ++entry)
+        {
+            if (entries[entry].has_value())
+            {
+                m_index.addRange(
+                    m_entries.size(), entries[entry]->first, entries[entry]->second, upperInclusive[entry]);
+                m_entries.emplace_back(candidateId, entry);
+            }
+        }
+    }
+
+    /**
+     * @brief Builds the index. No candidates can be added afterwards.
+     *
+     * @details If the versions of the candidates can't be sorted, the index is left empty and no candidate is
+     * discarded.
+     */
+    void build()
+    {
+        try
+        {
+            m_index.build();
+            m_valid = true;
+        }
+        catch (const std::exception&)
+        {
+            m_valid = false;
+        }
+    }
+
+    /**
+     * @brief Finds the candidates that may be vulnerable for an installed version.
+     *
+     * @param installedVersion Parsed installed version.
+     * @return Lookup Result of the search. If the version can't be compared with the index, no candidate is
+     * discarded.
+     */
+    Lookup lookup(const VersionMatcher::ParsedVersion& installedVersion) const
+    {
+        Lookup result;
+        if (!m_valid)
+        {
+            return result;
+        }
+
+        try
+        {
+            if (const auto* intervals {m_index.find(installedVersion)}; intervals)
+            {
+                result.m_index = this;
+                for (const auto interval : *intervals)
+                {
+                    // The intervals are in insertion order, so the first one found is the first entry of the candidate.
+                    result.m_matches.try_emplace(m_entries[interval].first, m_entries[interval].second);
+                }
+            }
+        }
+        catch (const std::exception&)
+        {
+            return {};
+        }
+        return result;
+    }
+};
+
+#endif // _CANDIDATES_VERSION_INDEX_HPP
@@ -16,6 +16,7 @@
 #include "inventorySync.hpp"
 #include "loggerHelper.h"
 #include "scanContext.hpp"
+#include <shared_mutex>
 
 /**
  * @brief A class for handling data cleanup operations in the inventory database and publishing the changes to the
@@ -69,14 +70,25 @@ public:
 
         ctx->m_isInventoryEmpty = true;
 
-        auto deleteAll = [this](std::shared_ptr<TScanContext> data,
-                                const std::string& key,
-                                const std::vector<AffectedComponentType>& types)
+        // The entries are read from a snapshot while their deletions are published, and deleted at once in a single
+        // batch, so the inventory isn't iterated while it's written and the agent is never left partially cleaned.
+        auto& inventoryDatabase = TInventorySync<TScanContext>::m_inventoryDatabase;
+        const auto snapshot {inventoryDatabase.snapshot()};
+        rocksdb::ReadOptions readOptions;
+        readOptions.snapshot = snapshot.get();
+
+        std::shared_mutex columnsMutex;
+        Utils::RocksDBWriteBatch batch {&inventoryDatabase, columnsMutex};
+
+        auto deleteAll = [&](std::shared_ptr<TScanContext> data,
+                             const std::string& key,
+                             const std::vector<AffectedComponentType>& types)
         {
             for (const auto& type : types)
             {
-                for (const auto& dbQuery :
-                     TInventorySync<TScanContext>::m_inventoryDatabase.seek(key, AFFECTED_COMPONENT_COLUMNS.at(type)))
+                const auto& columnName = AFFECTED_COMPONENT_COLUMNS.at(type);
+                const auto column = inventoryDatabase.column(columnName);
+                for (const auto& dbQuery : inventoryDatabase.seek(key, column, readOptions))
                 {
                     auto listCve = Utils::split(dbQuery.second.ToString(), ',');
                     auto context = std::make_shared<TScanContext>();
@@ -96,10 +108,9 @@ public:
                     m_subOrchestration->handleRequest(std::move(context));
                     logDebug2(WM_VULNSCAN_LOGTAG,
                               "Deleting %s agent vulnerabilities key: %s",
-                              AFFECTED_COMPONENT_COLUMNS.at(type).c_str(),
+                              columnName.c_str(),
                               dbQuery.first.c_str());
-                    TInventorySync<TScanContext>::m_inventoryDatabase.delete_(dbQuery.first,
-                                                                              AFFECTED_COMPONENT_COLUMNS.at(type));
+                    batch.delete_(dbQuery.first, columnName);
                 }
             }
         };
@@ -119,8 +130,9 @@ public:
         if (ctx->affectedComponentType() == AffectedComponentType::Os ||
             ctx->affectedComponentType() == AffectedComponentType::Agent)
         {
-            TInventorySync<TScanContext>::m_inventoryDatabase.delete_(ctx->agentId().data(), OS_INITIAL_SCAN);
+            batch.delete_(std::string(ctx->agentId()), OS_INITIAL_SCAN);
         }
+        batch.commit();
 
         return AbstractHandler<std::shared_ptr<TScanContext>>::handleRequest(std::move(ctx));
     }
@@ -0,0 +1,165 @@
+/*
+ * Wazuh Vulnerability scanner - Scan Orchestrator
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _EVENT_COALESCER_HPP
+#define _EVENT_COALESCER_HPP
+
+#include "flatbuffers/include/syscollector_deltas_generated.h"
+#include "flatbuffers/include/syscollector_synchronization_generated.h"
+#include "messageBuffer_generated.h"
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/**
+ * @brief EventCoalescer class.
+ *
+ * @details Counts the pending events of each package of each agent (the syscollector deltas and the rsync states,
+ * keyed by agent and item ID), so the event queue only scans the last one: An event is skipped when a later event of
+ * the same package is pending, e.g. the transient states of the packages while an agent is upgraded.
+ *
+ * The counters are kept in memory, so the events queued before the module started are all scanned.
+ */
+class EventCoalescer final
+{
+private:
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, uint64_t> m_pending;
+
+    template<typename TAgentInfo>
+    static std::string packageKey(const TAgentInfo* agentInfo, const flatbuffers::String* itemId)
+    {
+        if (!agentInfo || !agentInfo->agent_id() || !itemId || itemId->size() == 0)
+        {
+            return {};
+        }
+        return agentInfo->agent_id()->str() + ":" + itemId->str();
+    }
+
+public:
+    /**
+     * @brief Coalescing key of an event.
+     *
+     * @param type Event type.
+     * @param data Event data.
+     * @param size Event data size.
+     * @return std::string Agent and package item ID, empty if the event isn't coalesced.
+     */
+    static std::string key(const BufferType type, const int8_t* data, const size_t size)
+    {
+        if (type == BufferType::BufferType_DBSync)
+        {
+            if (flatbuffers::Verifier verifier(reinterpret_cast<const uint8_t*>(data), size);
+                !SyscollectorDeltas::VerifyDeltaBuffer(verifier))
+            {
+                return {};
+            }
+
+            const auto delta {SyscollectorDeltas::GetDelta(data)};
+            if (const auto package {delta->data_as_dbsync_packages()}; package)
+            {
+                return packageKey(delta->agent_info(), package->item_id());
+            }
+        }
+        else if (type == BufferType::BufferType_RSync)
+        {
+            if (flatbuffers::Verifier verifier(reinterpret_cast<const uint8_t*>(data), size);
+                !SyscollectorSynchronization::VerifySyncMsgBuffer(verifier))
+            {
+                return {};
+            }
+
+            const auto syncMsg {SyscollectorSynchronization::GetSyncMsg(data)};
+            if (const auto state {syncMsg->data_as_state()}; state)
+            {
+                if (const auto package {state->attributes_as_syscollector_packages()}; package)
+                {
+                    return packageKey(syncMsg->agent_info(), package->item_id());
+                }
+            }
+        }
+        return {};
+    }
+
+    /**
+     * @brief Coalescing key of a queued event.
+     *
+     * @param message Event, as it's queued.
+     * @return std::string Agent and package item ID, empty if the event isn't coalesced.
+     */
+    static std::string key(const MessageBuffer* message)
+    {
+        if (!message || !message->data())
+        {
+            return {};
+        }
+        return key(message->type(), message->data()->data(), message->data()->size());
+    }
+
+    /**
+     * @brief Records that an event was queued.
+     *
+     * @param key Coalescing key, the events without key are ignored.
+     */
+    void pushed(const std::string& key)
+    {
+        if (key.empty())
+        {
+            return;
+        }
+
+        std::scoped_lock lock(m_mutex);
+        ++m_pending[key];
+    }
+
+    /**
+     * @brief Records that an event was dequeued, and checks whether a later event of the same package is pending.
+     *
+     * @param key Coalescing key, the events without key are never superseded.
+     * @return true If the event can be skipped.
+     */
+    bool superseded(const std::string& key)
+    {
+        if (key.empty())
+        {
+            return false;
+        }
+
+        std::scoped_lock lock(m_mutex);
+        const auto it {m_pending.find(key)};
+        if (it == m_pending.end())
+        {
+            // Queued before the module started.
+            return false;
+        }
+
+        if (--it->second == 0)
+        {
+            m_pending.erase(it);
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Number of packages with pending events.
+     *
+     * @return size_t
+     */
+    size_t size() const
+    {
+        std::scoped_lock lock(m_mutex);
+        return m_pending.size();
+    }
+};
+
+#endif // _EVENT_COALESCER_HPP
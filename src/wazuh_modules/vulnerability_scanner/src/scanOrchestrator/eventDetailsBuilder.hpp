@@ -14,6 +14,7 @@
 
 #include "chainOfResponsability.hpp"
 #include "databaseFeedManager.hpp"
+#include "jsonWriter.hpp"
 #include "loggerHelper.h"
 #include "numericHelper.h"
 #include "scanContext.hpp"
@@ -41,36 +42,42 @@ private:
     std::shared_ptr<TDatabaseFeedManager> m_databaseFeedManager;
 
     /**
-     * @brief Populate a JSON field with a value if the value is non-empty (for strings) or always (for other types).
+     * @brief Writes a string field if the value isn't blank, the blank fields aren't indexed.
      *
-     * This function takes a JSON object, a JSON pointer specifying the field to populate, and a value to populate the
-     * field with. If the value is a string or a string view and is not empty, it will populate the field in the JSON
-     * object. For other types, the field will be populated regardless of the value.
-     *
-     * @tparam T       The type of the value to populate the field with.
-     * @param json     The JSON object to populate.
-     * @param key      The JSON pointer specifying the field to populate.
-     * @param value    The value to populate the field with.
+     * @param writer Writer of the object.
+     * @param key    Field key.
+     * @param value  Field value.
      */
-    template<typename T>
-    void populateField(nlohmann::json& json, const nlohmann::json::json_pointer& key, T&& value)
+    static void writeNonBlankField(JsonWriter& writer, std::string_view key, std::string_view value)
     {
-        if constexpr (std::is_same_v<std::remove_cv_t<std::remove_reference_t<T>>, std::string_view> ||
-                      std::is_same_v<T, std::string>)
+        if (value.find_first_not_of(' ') != std::string_view::npos)
         {
-            const auto valueTrimmed = Utils::trim(value.data());
-
-            if (!valueTrimmed.empty())
-            {
-                json[key] = value;
-            }
-        }
-        else
-        {
-            json[key] = value;
+            writer.key(key).string(value);
         }
     }
 
+    /**
+     * @brief Gets an object written by a writer, or null if it doesn't have any field.
+     *
+     * @param writer Writer of the object.
+     * @return std::string_view Serialized value.
+     */
+    static std::string_view objectOrNull(const JsonWriter& writer)
+    {
+        return writer.str() == "{}" ? "null" : std::string_view {writer.str()};
+    }
+
+    /**
+     * @brief Gets a string of the feed.
+     *
+     * @param value Flatbuffers string.
+     * @return std::string_view View of the string.
+     */
+    static std::string_view view(const flatbuffers::String* value)
+    {
+        return {value->c_str(), value->size()};
+    }
+
 public:
     // LCOV_EXCL_START
     /**
@@ -129,79 +136,93 @@ public:
         std::string osType =
             Utils::toLowerCase(data->osPlatform().compare("darwin") == 0 ? "macos" : data->osPlatform().data());
 
-        nlohmann::json package;
-
+        // The fields shared by the documents of all the elements are written once. The keys of each object are
+        // written sorted, as they were serialized when the documents were built as JSON objects.
+        JsonWriter package;
+        package.beginObject();
         switch (data->affectedComponentType())
         {
             case AffectedComponentType::Package:
-                populateField(package, "/architecture"_json_pointer, data->packageArchitecture());
-                populateField(package, "/description"_json_pointer, data->packageDescription());
+                writeNonBlankField(package, "architecture", data->packageArchitecture());
+                writeNonBlankField(package, "description", data->packageDescription());
 
                 if (!data->packageInstallTime().empty())
                 {
                     const auto installTime {Utils::rawTimestampToISO8601(data->packageInstallTime().data())};
                     if (!installTime.empty())
                     {
-                        package["installed"] = installTime;
+                        package.key("installed").string(installTime);
                     }
                 }
-                populateField(package, "/name"_json_pointer, data->packageName());
-                populateField(package, "/path"_json_pointer, data->packageLocation());
-                populateField(package, "/size"_json_pointer, data->packageSize());
-                populateField(package, "/type"_json_pointer, data->packageFormat());
-                populateField(package, "/version"_json_pointer, data->packageVersion());
+                writeNonBlankField(package, "name", data->packageName());
+                writeNonBlankField(package, "path", data->packageLocation());
+                package.key("size").number(data->packageSize());
+                writeNonBlankField(package, "type", data->packageFormat());
+                writeNonBlankField(package, "version", data->packageVersion());
                 break;
 
             case AffectedComponentType::Os:
-                populateField(package, "/architecture"_json_pointer, data->osArchitecture());
-                populateField(package, "/name"_json_pointer, osFullName);
-                populateField(package, "/type"_json_pointer, osType);
-                populateField(package, "/version"_json_pointer, osVersion);
+                writeNonBlankField(package, "architecture", data->osArchitecture());
+                package.key("name").string(osFullName);
+                package.key("type").string(osType);
+                package.key("version").string(osVersion);
                 break;
 
             default: break;
         }
+        package.endObject();
 
-        nlohmann::json agent;
+        JsonWriter agent;
+        agent.beginObject();
         if (data->agentId().compare("000") == 0 && data->clusterStatus())
         {
-            populateField(agent, "/ephemeral_id"_json_pointer, data->clusterNodeName());
+            writeNonBlankField(agent, "ephemeral_id", data->clusterNodeName());
         }
-        populateField(agent, "/id"_json_pointer, data->agentId());
-        populateField(agent, "/name"_json_pointer, data->agentName());
-        populateField(agent, "/type"_json_pointer, "wazuh");
-        populateField(agent, "/version"_json_pointer, data->agentVersion());
-
-        nlohmann::json os;
-        populateField(os, "/full"_json_pointer, std::move(osFullName));
-        populateField(os, "/kernel"_json_pointer, data->osKernelRelease());
-        populateField(os, "/name"_json_pointer, data->osName());
-        populateField(os, "/platform"_json_pointer, Utils::toLowerCase(data->osPlatform().data()));
-        populateField(os, "/type"_json_pointer, std::move(osType));
-        populateField(os, "/version"_json_pointer, std::move(osVersion));
-
-        for (auto& [cve, json] : data->m_elements)
+        writeNonBlankField(agent, "id", data->agentId());
+        writeNonBlankField(agent, "name", data->agentName());
+        agent.key("type").string("wazuh");
+        writeNonBlankField(agent, "version", data->agentVersion());
+        agent.endObject();
+
+        JsonWriter os;
+        os.beginObject();
+        writeNonBlankField(os, "full", osFullName);
+        writeNonBlankField(os, "kernel", data->osKernelRelease());
+        writeNonBlankField(os, "name", data->osName());
+        writeNonBlankField(os, "platform", Utils::toLowerCase(data->osPlatform().data()));
+        writeNonBlankField(os, "type", osType);
+        writeNonBlankField(os, "version", osVersion);
+        os.endObject();
+
+        JsonWriter ecsData;
+        for (const auto& element : data->m_elements)
         {
+            const auto& cve {element.first};
             FlatbufferDataPair<NSVulnerabilityScanner::VulnerabilityDescription> returnData;
             m_databaseFeedManager->getVulnerabiltyDescriptiveInformation(cve, returnData);
             if (returnData.data)
             {
-                auto ecsData = nlohmann::json::object();
+                ecsData.clear();
+                ecsData.beginObject();
 
                 // ECS agent fields.
-                ecsData["agent"] = agent;
+                ecsData.key("agent").raw(objectOrNull(agent));
+
+                // ECS os fields.
+                ecsData.key("host").beginObject().key("os").raw(objectOrNull(os)).endObject();
 
                 // ECS package fields.
+                std::string_view category;
                 switch (data->affectedComponentType())
                 {
                     case AffectedComponentType::Package:
-                        ecsData["package"] = package;
-                        ecsData["vulnerability"]["category"] = "Packages";
+                        ecsData.key("package").raw(objectOrNull(package));
+                        category = "Packages";
                         break;
 
                     case AffectedComponentType::Os:
-                        ecsData["package"] = package;
-                        ecsData["vulnerability"]["category"] = "OS";
+                        ecsData.key("package").raw(objectOrNull(package));
+                        category = "OS";
                         break;
 
                     default:
@@ -209,28 +230,47 @@ public:
                         break;
                 }
 
-                // ECS os fields.
-                ecsData["host"]["os"] = os;
-
                 // ECS vulnerability fields.
-                ecsData["vulnerability"]["classification"] = returnData.data->classification()->str();
-                ecsData["vulnerability"]["description"] = returnData.data->description()->str();
-                ecsData["vulnerability"]["detected_at"] = Utils::getCurrentISO8601();
-                ecsData["vulnerability"]["enumeration"] = "CVE";
-                ecsData["vulnerability"]["id"] = cve;
-                ecsData["vulnerability"]["published_at"] = returnData.data->datePublished()->str();
-                ecsData["vulnerability"]["reference"] = returnData.data->reference()->str();
-                ecsData["vulnerability"]["scanner"]["vendor"] = "Wazuh";
-                ecsData["vulnerability"]["score"]["base"] = Utils::floatToDoubleRound(returnData.data->scoreBase(), 2);
-                ecsData["vulnerability"]["score"]["version"] = returnData.data->scoreVersion()->str();
-                ecsData["vulnerability"]["severity"] = Utils::toSentenceCase(returnData.data->severity()->str());
+                ecsData.key("vulnerability").beginObject();
+                if (!category.empty())
+                {
+                    ecsData.key("category").string(category);
+                }
+                ecsData.key("classification").string(view(returnData.data->classification()));
+                ecsData.key("description").string(view(returnData.data->description()));
+                ecsData.key("detected_at").string(Utils::getCurrentISO8601());
+                ecsData.key("enumeration").string("CVE");
+                ecsData.key("id").string(cve);
+                ecsData.key("published_at").string(view(returnData.data->datePublished()));
+                ecsData.key("reference").string(view(returnData.data->reference()));
+                ecsData.key("scanner").beginObject().key("vendor").string("Wazuh").endObject();
+                ecsData.key("score")
+                    .beginObject()
+                    .key("base")
+                    .fixedNumber(returnData.data->scoreBase(), 2)
+                    .key("version")
+                    .string(view(returnData.data->scoreVersion()))
+                    .endObject();
+                ecsData.key("severity").string(Utils::toSentenceCase(returnData.data->severity()->str()));
+                ecsData.endObject();
 
                 // ECS wazuh fields.
-                auto vulnerabilityDetection = PolicyManager::instance().getVulnerabilityDetection();
-                ecsData["wazuh"]["cluster"]["name"] = data->clusterName();
-                ecsData["wazuh"]["schema"]["version"] = WAZUH_SCHEMA_VERSION;
+                ecsData.key("wazuh")
+                    .beginObject()
+                    .key("cluster")
+                    .beginObject()
+                    .key("name")
+                    .string(data->clusterName())
+                    .endObject()
+                    .key("schema")
+                    .beginObject()
+                    .key("version")
+                    .string(WAZUH_SCHEMA_VERSION)
+                    .endObject()
+                    .endObject();
 
-                json["data"] = std::move(ecsData);
+                ecsData.endObject();
+                data->m_elementsData[cve] = ecsData.str();
             }
         }
 
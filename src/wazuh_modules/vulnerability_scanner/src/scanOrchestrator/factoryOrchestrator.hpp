@@ -31,11 +31,21 @@
 #include "hotfixInsert.hpp"
 #include "osScanner.hpp"
 #include "packageScanner.hpp"
+#include "preloadAgentsData.hpp"
 #include "resultIndexer.hpp"
 #include "scanAgentList.hpp"
 #include "scanInventorySync.hpp"
 #include "scanOsAlertDetailsBuilder.hpp"
+#include "serializedStage.hpp"
+#include "timedStage.hpp"
+#include <algorithm>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+constexpr auto RESCAN_AGENTS_MAX_WORKERS {8u};
 
 /**
  * @brief FactoryOrchestrator class.
@@ -65,12 +75,73 @@ template<typename TPackageScanner = PackageScanner,
          typename TScanAgentList = ScanAgentList,
          typename TGlobalSyncInventory = GlobalSyncInventory,
          typename THotfixInsert = HotfixInsert,
-         typename TArrayResultIndexer = ArrayResultIndexer>
+         typename TArrayResultIndexer = ArrayResultIndexer,
+         typename TPreloadAgentsData = PreloadAgentsData>
 class TFactoryOrchestrator final
 {
 private:
     TFactoryOrchestrator() = default;
 
+    /**
+     * @brief Wraps a step of the chain so it runs under the write mutex, if any.
+     *
+     * @param stage Step of the chain.
+     * @param writeMutex Mutex shared by the steps that write the inventory and publish to the indexer.
+     * @return std::shared_ptr<AbstractHandler<std::shared_ptr<TScanContext>>> The step, serialized if needed.
+     */
+    static std::shared_ptr<AbstractHandler<std::shared_ptr<TScanContext>>>
+    serialized(std::shared_ptr<AbstractHandler<std::shared_ptr<TScanContext>>> stage,
+               const std::shared_ptr<std::mutex>& writeMutex)
+    {
+        if (!writeMutex)
+        {
+            return stage;
+        }
+        return std::make_shared<TSerializedStage<TScanContext>>(writeMutex, std::move(stage));
+    }
+
+    /**
+     * @brief Name of the chain of a scanner type, used to name the metrics of its steps.
+     *
+     * @param type Scanner type.
+     * @return std::string_view Chain name.
+     */
+    static std::string_view chainName(ScannerType type)
+    {
+        switch (type)
+        {
+            case ScannerType::PackageInsert: return "package_insert";
+            case ScannerType::PackageDelete: return "package_delete";
+            case ScannerType::Os: return "os";
+            case ScannerType::HotfixInsert: return "hotfix_insert";
+            case ScannerType::IntegrityClear: return "integrity_clear";
+            case ScannerType::CleanupAllAgentData: return "cleanup_all_agent_data";
+            case ScannerType::ReScanAllAgents: return "rescan_all_agents";
+            case ScannerType::ReScanSingleAgent: return "rescan_single_agent";
+            case ScannerType::CleanupSingleAgentData: return "cleanup_single_agent_data";
+            case ScannerType::GlobalSyncInventory: return "global_sync_inventory";
+            default: return "unknown";
+        }
+    }
+
+    /**
+     * @brief Wraps a step of the chain so its duration is recorded in the "stage.<chain>.<step>" histogram.
+     *
+     * @param type Scanner type of the chain.
+     * @param name Step name.
+     * @param stage Step of the chain.
+     * @return std::shared_ptr<AbstractHandler<std::shared_ptr<TScanContext>>> The timed step.
+     */
+    static std::shared_ptr<AbstractHandler<std::shared_ptr<TScanContext>>>
+    timed(ScannerType type,
+          std::string_view name,
+          std::shared_ptr<AbstractHandler<std::shared_ptr<TScanContext>>> stage)
+    {
+        std::string histogram {"stage."};
+        histogram.append(chainName(type)).append(".").append(name);
+        return std::make_shared<TTimedStage<TScanContext>>(histogram, std::move(stage));
+    }
+
 public:
     /**
      * @brief Creates an orchestrator and returns it.
@@ -80,6 +151,8 @@ public:
      * @param indexerConnector Indexer connector object.
      * @param inventoryDatabase Inventory database.
      * @param reportDispatcher Report dispatcher queue to send vulnerability reports.
+     * @param writeMutex Mutex that serializes the inventory writes and the indexer publication, for the chains that are
+     * executed concurrently. If empty, the chain isn't serialized.
      * @return std::shared_ptr<ScanContext> Abstract handler.
      */
     static std::shared_ptr<AbstractHandler<std::shared_ptr<TScanContext>>>
@@ -87,93 +160,144 @@ public:
            std::shared_ptr<TDatabaseFeedManager> databaseFeedManager,
            std::shared_ptr<TIndexerConnector> indexerConnector,
            Utils::RocksDBWrapper& inventoryDatabase,
-           std::shared_ptr<ReportDispatcher> reportDispatcher)
+           std::shared_ptr<ReportDispatcher> reportDispatcher,
+           const std::shared_ptr<std::mutex>& writeMutex = nullptr)
     {
+        // Each step records its duration, see timed().
+        const auto step = [type](std::string_view name,
+                                 std::shared_ptr<AbstractHandler<std::shared_ptr<TScanContext>>> stage)
+        {
+            return timed(type, name, std::move(stage));
+        };
+
         std::shared_ptr<AbstractHandler<std::shared_ptr<TScanContext>>> orchestration;
         switch (type)
         {
             case ScannerType::PackageInsert:
-                orchestration = std::make_shared<TPackageScanner>(databaseFeedManager);
-                orchestration->setLast(std::make_shared<TEventInsertInventory>(inventoryDatabase));
-                orchestration->setLast(std::make_shared<TEventDetailsBuilder>(databaseFeedManager));
-                orchestration->setLast(std::make_shared<TEventPackageAlertDetailsBuilder>(databaseFeedManager));
-                orchestration->setLast(std::make_shared<TEventSendReport>(reportDispatcher));
-                orchestration->setLast(std::make_shared<TResultIndexer>(indexerConnector));
+                orchestration = step("package_scanner", std::make_shared<TPackageScanner>(databaseFeedManager));
+                orchestration->setLast(serialized(
+                    step("event_insert_inventory", std::make_shared<TEventInsertInventory>(inventoryDatabase)),
+                    writeMutex));
+                orchestration->setLast(
+                    step("event_details_builder", std::make_shared<TEventDetailsBuilder>(databaseFeedManager)));
+                orchestration->setLast(step("event_package_alert_details_builder",
+                                            std::make_shared<TEventPackageAlertDetailsBuilder>(databaseFeedManager)));
+                orchestration->setLast(step("event_send_report", std::make_shared<TEventSendReport>(reportDispatcher)));
+                orchestration->setLast(
+                    serialized(step("result_indexer", std::make_shared<TResultIndexer>(indexerConnector)), writeMutex));
                 break;
 
             case ScannerType::PackageDelete:
-                orchestration = std::make_shared<TEventDeleteInventory>(inventoryDatabase);
-                orchestration->setLast(std::make_shared<TEventPackageAlertDetailsBuilder>(databaseFeedManager));
-                orchestration->setLast(std::make_shared<TEventSendReport>(reportDispatcher));
-                orchestration->setLast(std::make_shared<TResultIndexer>(indexerConnector));
+                orchestration =
+                    step("event_delete_inventory", std::make_shared<TEventDeleteInventory>(inventoryDatabase));
+                orchestration->setLast(step("event_package_alert_details_builder",
+                                            std::make_shared<TEventPackageAlertDetailsBuilder>(databaseFeedManager)));
+                orchestration->setLast(step("event_send_report", std::make_shared<TEventSendReport>(reportDispatcher)));
+                orchestration->setLast(step("result_indexer", std::make_shared<TResultIndexer>(indexerConnector)));
                 break;
 
             case ScannerType::HotfixInsert:
-                orchestration = std::make_shared<THotfixInsert>(databaseFeedManager);
-                orchestration->setLast(std::make_shared<TCVESolvedInventorySync>(inventoryDatabase));
-                orchestration->setLast(std::make_shared<TCVESolvedAlertDetailsBuilder>(databaseFeedManager));
-                orchestration->setLast(std::make_shared<TEventSendReport>(reportDispatcher));
-                orchestration->setLast(std::make_shared<TArrayResultIndexer>(indexerConnector));
+                orchestration = step("hotfix_insert", std::make_shared<THotfixInsert>(databaseFeedManager));
+                orchestration->setLast(
+                    step("cve_solved_inventory_sync", std::make_shared<TCVESolvedInventorySync>(inventoryDatabase)));
+                orchestration->setLast(step("cve_solved_alert_details_builder",
+                                            std::make_shared<TCVESolvedAlertDetailsBuilder>(databaseFeedManager)));
+                orchestration->setLast(step("event_send_report", std::make_shared<TEventSendReport>(reportDispatcher)));
+                orchestration->setLast(
+                    step("array_result_indexer", std::make_shared<TArrayResultIndexer>(indexerConnector)));
                 break;
             case ScannerType::HotfixDelete: break;
 
             case ScannerType::Os:
-                orchestration = std::make_shared<TOsScanner>(databaseFeedManager);
-                orchestration->setLast(std::make_shared<TScanInventorySync>(inventoryDatabase));
-                orchestration->setLast(std::make_shared<TEventDetailsBuilder>(databaseFeedManager));
-                orchestration->setLast(std::make_shared<TScanOsAlertDetailsBuilder>(databaseFeedManager));
-                orchestration->setLast(std::make_shared<TEventSendReport>(reportDispatcher));
-                orchestration->setLast(std::make_shared<TResultIndexer>(indexerConnector));
+                orchestration = step("os_scanner", std::make_shared<TOsScanner>(databaseFeedManager));
+                orchestration->setLast(serialized(
+                    step("scan_inventory_sync", std::make_shared<TScanInventorySync>(inventoryDatabase)), writeMutex));
+                orchestration->setLast(
+                    step("event_details_builder", std::make_shared<TEventDetailsBuilder>(databaseFeedManager)));
+                orchestration->setLast(step("scan_os_alert_details_builder",
+                                            std::make_shared<TScanOsAlertDetailsBuilder>(databaseFeedManager)));
+                orchestration->setLast(step("event_send_report", std::make_shared<TEventSendReport>(reportDispatcher)));
+                orchestration->setLast(
+                    serialized(step("result_indexer", std::make_shared<TResultIndexer>(indexerConnector)), writeMutex));
                 break;
 
             case ScannerType::IntegrityClear:
-                orchestration = std::make_shared<TCleanAgentInventory>(
-                    inventoryDatabase, std::make_shared<TResultIndexer>(indexerConnector));
-                orchestration->setLast(std::make_shared<TAlertClearBuilder>(databaseFeedManager));
-                orchestration->setLast(std::make_shared<TCleanSendReport>(reportDispatcher));
+                orchestration = step("clean_agent_inventory",
+                                     std::make_shared<TCleanAgentInventory>(
+                                         inventoryDatabase, std::make_shared<TResultIndexer>(indexerConnector)));
+                orchestration->setLast(
+                    step("alert_clear_builder", std::make_shared<TAlertClearBuilder>(databaseFeedManager)));
+                orchestration->setLast(step("clear_send_report", std::make_shared<TCleanSendReport>(reportDispatcher)));
                 break;
 
             case ScannerType::CleanupAllAgentData:
-                orchestration = std::make_shared<TCleanInventory>(inventoryDatabase,
-                                                                  std::make_shared<TResultIndexer>(indexerConnector));
+                orchestration =
+                    step("clean_inventory",
+                         std::make_shared<TCleanInventory>(inventoryDatabase,
+                                                           std::make_shared<TResultIndexer>(indexerConnector)));
                 break;
 
             case ScannerType::ReScanAllAgents:
+            {
+                orchestration =
+                    step("clean_inventory",
+                         std::make_shared<TCleanInventory>(inventoryDatabase,
+                                                           std::make_shared<TResultIndexer>(indexerConnector)));
+                orchestration->setLast(
+                    step("build_all_agent_list_context", std::make_shared<TBuildAllAgentListContext>()));
+                orchestration->setLast(step("preload_agents_data", std::make_shared<TPreloadAgentsData>()));
 
-                orchestration = std::make_shared<TCleanInventory>(inventoryDatabase,
-                                                                  std::make_shared<TResultIndexer>(indexerConnector));
-                orchestration->setLast(std::make_shared<TBuildAllAgentListContext>());
-                orchestration->setLast(std::make_shared<TScanAgentList>(
-                    TFactoryOrchestrator::create(ScannerType::PackageInsert,
-                                                 databaseFeedManager,
-                                                 indexerConnector,
-                                                 inventoryDatabase,
-                                                 reportDispatcher),
-                    TFactoryOrchestrator::create(
-                        ScannerType::Os, databaseFeedManager, indexerConnector, inventoryDatabase, reportDispatcher)));
+                // The agents are scanned concurrently: The scanners only read the feed, and the steps that write are
+                // serialized by a mutex shared by both chains.
+                const auto rescanWriteMutex {std::make_shared<std::mutex>()};
+                orchestration->setLast(step(
+                    "scan_agent_list",
+                    std::make_shared<TScanAgentList>(
+                        TFactoryOrchestrator::create(ScannerType::PackageInsert,
+                                                     databaseFeedManager,
+                                                     indexerConnector,
+                                                     inventoryDatabase,
+                                                     reportDispatcher,
+                                                     rescanWriteMutex),
+                        TFactoryOrchestrator::create(ScannerType::Os,
+                                                     databaseFeedManager,
+                                                     indexerConnector,
+                                                     inventoryDatabase,
+                                                     reportDispatcher,
+                                                     rescanWriteMutex),
+                        std::clamp(std::thread::hardware_concurrency(), 1u, RESCAN_AGENTS_MAX_WORKERS))));
                 break;
+            }
 
             case ScannerType::ReScanSingleAgent:
-                orchestration = std::make_shared<TCleanAgentInventory>(
-                    inventoryDatabase, std::make_shared<TResultIndexer>(indexerConnector));
-                orchestration->setLast(std::make_shared<TBuildSingleAgentListInfoContext>());
-                orchestration->setLast(std::make_shared<TScanAgentList>(
-                    TFactoryOrchestrator::create(ScannerType::PackageInsert,
-                                                 databaseFeedManager,
-                                                 indexerConnector,
-                                                 inventoryDatabase,
-                                                 reportDispatcher),
-                    TFactoryOrchestrator::create(
-                        ScannerType::Os, databaseFeedManager, indexerConnector, inventoryDatabase, reportDispatcher)));
+                orchestration = step("clean_agent_inventory",
+                                     std::make_shared<TCleanAgentInventory>(
+                                         inventoryDatabase, std::make_shared<TResultIndexer>(indexerConnector)));
+                orchestration->setLast(
+                    step("build_single_agent_list_context", std::make_shared<TBuildSingleAgentListInfoContext>()));
+                orchestration->setLast(step("scan_agent_list",
+                                            std::make_shared<TScanAgentList>(
+                                                TFactoryOrchestrator::create(ScannerType::PackageInsert,
+                                                                             databaseFeedManager,
+                                                                             indexerConnector,
+                                                                             inventoryDatabase,
+                                                                             reportDispatcher),
+                                                TFactoryOrchestrator::create(ScannerType::Os,
+                                                                             databaseFeedManager,
+                                                                             indexerConnector,
+                                                                             inventoryDatabase,
+                                                                             reportDispatcher))));
                 break;
 
             case ScannerType::CleanupSingleAgentData:
-                orchestration = std::make_shared<TCleanAgentInventory>(
-                    inventoryDatabase, std::make_shared<TResultIndexer>(indexerConnector));
+                orchestration = step("clean_agent_inventory",
+                                     std::make_shared<TCleanAgentInventory>(
+                                         inventoryDatabase, std::make_shared<TResultIndexer>(indexerConnector)));
                 break;
 
             case ScannerType::GlobalSyncInventory:
-                orchestration = std::make_shared<TGlobalSyncInventory>(indexerConnector);
+                orchestration =
+                    step("global_sync_inventory", std::make_shared<TGlobalSyncInventory>(indexerConnector));
                 break;
 
             default: throw std::runtime_error("Invalid scanner type");
@@ -0,0 +1,302 @@
+/*
+ * Wazuh Vulnerability scanner - Scan Orchestrator
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _JSON_WRITER_HPP
+#define _JSON_WRITER_HPP
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief JsonWriter class.
+ *
+ * @details Writes a JSON document into a reusable buffer, without building a nlohmann::json DOM. The output is the
+ * same as nlohmann::json::dump() without indentation, as long as the keys of each object are written sorted, like
+ * nlohmann::json stores them: The strings are escaped the same way, and invalid UTF-8 is rejected too.
+ *
+ * Only objects are supported, the writer doesn't check that the document is well formed.
+ */
+class JsonWriter final
+{
+private:
+    std::string m_buffer;
+    bool m_comma {false};
+
+    void escape(std::string_view value)
+    {
+        static constexpr auto HEX_DIGITS {"0123456789abcdef"};
+
+        m_buffer.push_back('"');
+        for (size_t i = 0; i < value.size();)
+        {
+            const auto byte {static_cast<unsigned char>(value[i])};
+            if (byte >= 0x80)
+            {
+                const auto length {utf8Length(value, i)};
+                if (length == 0)
+                {
+                    throw std::invalid_argument("Invalid UTF-8 byte at index " + std::to_string(i));
+                }
+                m_buffer.append(value.data() + i, length);
+                i += length;
+                continue;
+            }
+
+            switch (byte)
+            {
+                case '"': m_buffer.append("\\\""); break;
+                case '\\': m_buffer.append("\\\\"); break;
+                case '\b': m_buffer.append("\\b"); break;
+                case '\f': m_buffer.append("\\f"); break;
+                case '\n': m_buffer.append("\\n"); break;
+                case '\r': m_buffer.append("\\r"); break;
+                case '\t': m_buffer.append("\\t"); break;
+                default:
+                    if (byte < 0x20)
+                    {
+                        m_buffer.append("\\u00");
+                        m_buffer.push_back(HEX_DIGITS[byte >> 4]);
+                        m_buffer.push_back(HEX_DIGITS[byte & 0x0F]);
+                    }
+                    else
+                    {
+                        m_buffer.push_back(static_cast<char>(byte));
+                    }
+                    break;
+            }
+            ++i;
+        }
+        m_buffer.push_back('"');
+    }
+
+    /**
+     * @brief Length of the UTF-8 sequence that starts at a position, rejecting the overlong encodings, the surrogates
+     * and the code points above U+10FFFF.
+     *
+     * @return size_t Length of the sequence, 0 if it's invalid.
+     */
+    static size_t utf8Length(std::string_view value, const size_t position)
+    {
+        const auto byte {[&value](const size_t index)
+                         {
+                             return index < value.size() ? static_cast<unsigned char>(value[index]) : 0;
+                         }};
+        const auto continuation {[](const unsigned char c)
+                                 {
+                                     return (c & 0xC0) == 0x80;
+                                 }};
+
+        const auto first {byte(position)};
+        const auto second {byte(position + 1)};
+
+        size_t length {0};
+        unsigned char low {0x80};
+        unsigned char high {0xBF};
+        if (first >= 0xC2 && first <= 0xDF)
+        {
+            length = 2;
+        }
+        else if (first >= 0xE0 && first <= 0xEF)
+        {
+            length = 3;
+            low = first == 0xE0 ? 0xA0 : 0x80;
+            high = first == 0xED ? 0x9F : 0xBF;
+        }
+        else if (first >= 0xF0 && first <= 0xF4)
+        {
+            length = 4;
+            low = first == 0xF0 ? 0x90 : 0x80;
+            high = first == 0xF4 ? 0x8F : 0xBF;
+        }
+        else
+        {
+            return 0;
+        }
+
+        if (second < low || second > high)
+        {
+            return 0;
+        }
+        for (size_t i = 2; i < length; ++i)
+        {
+            if (!continuation(byte(position + i)))
+            {
+                return 0;
+            }
+        }
+        return length;
+    }
+
+public:
+    /**
+     * @brief Clears the document, keeping the buffer capacity.
+     */
+    void clear()
+    {
+        m_buffer.clear();
+        m_comma = false;
+    }
+
+    /**
+     * @brief Document written so far.
+     *
+     * @return const std::string&
+     */
+    const std::string& str() const
+    {
+        return m_buffer;
+    }
+
+    /**
+     * @brief Starts an object, as a value.
+     *
+     * @return JsonWriter&
+     */
+    JsonWriter& beginObject()
+    {
+        m_buffer.push_back('{');
+        m_comma = false;
+        return *this;
+    }
+
+    /**
+     * @brief Ends the current object.
+     *
+     * @return JsonWriter&
+     */
+    JsonWriter& endObject()
+    {
+        m_buffer.push_back('}');
+        m_comma = true;
+        return *this;
+    }
+
+    /**
+     * @brief Writes the key of the next field of the current object.
+     *
+     * @param key Key.
+     * @return JsonWriter&
+     */
+    JsonWriter& key(std::string_view key)
+    {
+        if (m_comma)
+        {
+            m_buffer.push_back(',');
+        }
+        escape(key);
+        m_buffer.push_back(':');
+        m_comma = false;
+        return *this;
+    }
+
+    /**
+     * @brief Writes a string value.
+     *
+     * @param value Value, it must be valid UTF-8.
+     * @return JsonWriter&
+     */
+    JsonWriter& string(std::string_view value)
+    {
+        escape(value);
+        m_comma = true;
+        return *this;
+    }
+
+    /**
+     * @brief Writes an integer value.
+     *
+     * @param value Value.
+     * @return JsonWriter&
+     */
+    JsonWriter& number(const uint64_t value)
+    {
+        char digits[20];
+        const auto result {std::to_chars(digits, digits + sizeof(digits), value)};
+        m_buffer.append(digits, result.ptr);
+        m_comma = true;
+        return *this;
+    }
+
+    /**
+     * @brief Writes a number rounded to some decimals, as Utils::floatToDoubleRound() rounds it and nlohmann::json
+     * serializes the result: The trailing zeros are removed, but one decimal is always kept. It's exact while the
+     * rounded number has up to 15 significant digits, nlohmann::json uses the exponent notation for larger ones.
+     *
+     * @param value Value.
+     * @param precision Number of decimals.
+     * @return JsonWriter&
+     */
+    JsonWriter& fixedNumber(const float value, const int precision)
+    {
+        if (!std::isfinite(value))
+        {
+            m_buffer.append("null");
+            m_comma = true;
+            return *this;
+        }
+
+        char digits[64];
+        const auto length {std::snprintf(digits, sizeof(digits), "%.*f", precision, static_cast<double>(value))};
+        if (length <= 0 || static_cast<size_t>(length) >= sizeof(digits))
+        {
+            throw std::invalid_argument("Number out of range");
+        }
+
+        std::string_view number {digits, static_cast<size_t>(length)};
+        if (const auto point {number.find('.')}; point == std::string_view::npos)
+        {
+            m_buffer.append(number);
+            m_buffer.append(".0");
+        }
+        else
+        {
+            // Keep at least one decimal.
+            const auto last {number.find_last_not_of('0')};
+            m_buffer.append(number.substr(0, std::max(last, point + 1) + 1));
+        }
+        m_comma = true;
+        return *this;
+    }
+
+    /**
+     * @brief Writes a boolean value.
+     *
+     * @param value Value.
+     * @return JsonWriter&
+     */
+    JsonWriter& boolean(const bool value)
+    {
+        m_buffer.append(value ? "true" : "false");
+        m_comma = true;
+        return *this;
+    }
+
+    /**
+     * @brief Writes a value already serialized, such as a document written by another writer.
+     *
+     * @param json Serialized value.
+     * @return JsonWriter&
+     */
+    JsonWriter& raw(std::string_view json)
+    {
+        m_buffer.append(json);
+        m_comma = true;
+        return *this;
+    }
+};
+
+#endif // _JSON_WRITER_HPP
@@ -14,6 +14,7 @@
 
 #include "../policyManager/policyManager.hpp"
 #include "cacheLRU.hpp"
+#include "scannerMetrics.hpp"
 #include "singleton.hpp"
 #include "socketDBWrapper.hpp"
 #include "wazuhDBQueryBuilder.hpp"
@@ -46,12 +47,15 @@ struct Os final
 
 /**
  * @brief OsDataCache class.
+ *
+ * @tparam TSocketDBWrapper Wazuh-DB wrapper type.
+ * @tparam TCache Cache type, it must be thread-safe as the lookups only hold a shared lock.
  */
-template<typename TSocketDBWrapper = SocketDBWrapper>
+template<typename TSocketDBWrapper = SocketDBWrapper, typename TCache = ShardedLRUCache<std::string, Os>>
 class OsDataCache final : public Singleton<OsDataCache<>>
 {
 private:
-    LRUCache<std::string, Os> m_osData {PolicyManager::instance().getOsdataLRUSize()};
+    TCache m_osData {PolicyManager::instance().getOsdataLRUSize()};
     std::shared_mutex m_mutex;
 
     Os getOsDataFromWdb(const std::string& agentId)
@@ -59,6 +63,7 @@ private:
         nlohmann::json response;
         try
         {
+            const ScannerMetrics::Timer timer {"wazuhdb.query"};
             TSocketDBWrapper::instance().query(WazuhDBQueryBuilder::builder().agentGetOsInfoCommand(agentId).build(),
                                                response);
         }
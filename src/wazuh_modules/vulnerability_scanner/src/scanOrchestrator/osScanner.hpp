@@ -14,8 +14,10 @@
 
 #include "chainOfResponsability.hpp"
 #include "databaseFeedManager.hpp"
+#include "packageAgentsIndex.hpp"
 #include "scanContext.hpp"
 #include "scannerHelper.hpp"
+#include "scannerMetrics.hpp"
 #include "versionMatcher/versionMatcher.hpp"
 #include "wdbDataException.hpp"
 
@@ -59,6 +61,7 @@ public:
         {
             try
             {
+                const ScannerMetrics::Timer timer {"wazuhdb.query"};
                 SocketDBWrapper::instance().query(
                     WazuhDBQueryBuilder::builder().agentGetHotfixesCommand(data->agentId().data()).build(),
                     responseHotfixes);
@@ -277,6 +280,8 @@ public:
                 {
                     PackageData package = {.name = osCPE.product};
 
+                    // The agent is rescanned when the candidates of the OS change.
+                    PackageAgentsIndex::instance().add("nvd", package.name, data->agentId());
                     m_databaseFeedManager->getVulnerabilitiesCandidates("nvd", package, vulnerabilityScan);
 
                     if (data->osPlatform() == "windows")
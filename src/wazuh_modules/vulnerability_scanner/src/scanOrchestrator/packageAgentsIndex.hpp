@@ -0,0 +1,194 @@
+/*
+ * Wazuh Vulnerability scanner - Scan Orchestrator
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _PACKAGE_AGENTS_INDEX_HPP
+#define _PACKAGE_AGENTS_INDEX_HPP
+
+#include "singleton.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+constexpr auto PACKAGE_AGENTS_INDEX_SHARDS {16};
+constexpr auto PACKAGE_AGENTS_INDEX_MIN_COMPACTION {16};
+
+/**
+ * @brief PackageAgentsIndex class.
+ *
+ * @details Agents whose scans queried the candidates of each package, keyed by CNA and package name as they are
+ * queried (after the translations). It tells which agents must be rescanned when the candidates of some packages
+ * change, instead of rescanning all of them.
+ *
+ * The index is only complete after a rescan of all the agents, which rebuilds it: Until then, the agents scanned
+ * before the module started are unknown. The scans of the agents that were removed, or of packages that were
+ * uninstalled, are kept until the next rescan, they only cause unneeded rescans.
+ */
+class PackageAgentsIndex final : public Singleton<PackageAgentsIndex>
+{
+private:
+    struct Agents
+    {
+        // Appended as the packages are scanned, and deduplicated when the list doubles its size.
+        std::vector<uint32_t> ids;
+        size_t compacted {0};
+    };
+
+    struct Shard
+    {
+        std::mutex mutex;
+        std::unordered_map<std::string, Agents> agents;
+    };
+
+    std::array<Shard, PACKAGE_AGENTS_INDEX_SHARDS> m_shards;
+    std::atomic<bool> m_complete {false};
+
+    static std::string key(std::string_view cnaName, std::string_view packageName)
+    {
+        std::string key;
+        key.reserve(cnaName.size() + 1 + packageName.size());
+        key.append(cnaName);
+        key.push_back('|');
+        key.append(packageName);
+        return key;
+    }
+
+    Shard& shard(const std::string& key)
+    {
+        return m_shards[std::hash<std::string> {}(key) % m_shards.size()];
+    }
+
+    static void compact(std::vector<uint32_t>& ids)
+    {
+        std::sort(ids.begin(), ids.end());
+        ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    }
+
+public:
+    /**
+     * @brief Records that an agent queried the candidates of a package.
+     *
+     * @param cnaName CNA name.
+     * @param packageName Package name, as it's queried.
+     * @param agentId Agent ID. If it isn't numeric, the index is marked as incomplete.
+     */
+    void add(std::string_view cnaName, std::string_view packageName, std::string_view agentId)
+    {
+        uint32_t id {0};
+        if (const auto [end, error] {std::from_chars(agentId.data(), agentId.data() + agentId.size(), id)};
+            error != std::errc() || end != agentId.data() + agentId.size())
+        {
+            m_complete = false;
+            return;
+        }
+
+        const auto packageKey {key(cnaName, packageName)};
+        auto& packageShard {shard(packageKey)};
+        std::scoped_lock lock(packageShard.mutex);
+
+        auto& agents {packageShard.agents[packageKey]};
+        if (!agents.ids.empty() && agents.ids.back() == id)
+        {
+            return;
+        }
+
+        agents.ids.push_back(id);
+        if (agents.ids.size() >= 2 * std::max<size_t>(agents.compacted, PACKAGE_AGENTS_INDEX_MIN_COMPACTION))
+        {
+            compact(agents.ids);
+            agents.compacted = agents.ids.size();
+        }
+    }
+
+    /**
+     * @brief Clears the index before it's rebuilt by a rescan of all the agents.
+     */
+    void reset()
+    {
+        m_complete = false;
+        for (auto& packageShard : m_shards)
+        {
+            std::scoped_lock lock(packageShard.mutex);
+            packageShard.agents.clear();
+        }
+    }
+
+    /**
+     * @brief Marks the index as complete, once all the agents were scanned.
+     */
+    void markComplete()
+    {
+        m_complete = true;
+    }
+
+    /**
+     * @brief Checks whether the index contains the scans of all the agents.
+     *
+     * @return true If it's complete.
+     */
+    bool complete() const
+    {
+        return m_complete;
+    }
+
+    /**
+     * @brief Gets the agents that queried the candidates of any of the packages.
+     *
+     * @param candidates (CNA, package name) keys.
+     * @param agentIds Sorted agent IDs, in the Wazuh format (at least three digits).
+     * @return true If the index is complete, otherwise the agents are unknown and all of them should be rescanned.
+     */
+    bool agents(const std::set<std::pair<std::string, std::string>>& candidates, std::vector<std::string>& agentIds)
+    {
+        agentIds.clear();
+        if (!m_complete)
+        {
+            return false;
+        }
+
+        std::vector<uint32_t> ids;
+        for (const auto& [cnaName, packageName] : candidates)
+        {
+            const auto packageKey {key(cnaName, packageName)};
+            auto& packageShard {shard(packageKey)};
+            std::scoped_lock lock(packageShard.mutex);
+
+            if (const auto it {packageShard.agents.find(packageKey)}; it != packageShard.agents.end())
+            {
+                ids.insert(ids.end(), it->second.ids.begin(), it->second.ids.end());
+            }
+        }
+        compact(ids);
+
+        agentIds.reserve(ids.size());
+        for (const auto id : ids)
+        {
+            auto agentId {std::to_string(id)};
+            if (agentId.size() < 3)
+            {
+                agentId.insert(0, 3 - agentId.size(), '0');
+            }
+            agentIds.push_back(std::move(agentId));
+        }
+        return true;
+    }
+};
+
+#endif // _PACKAGE_AGENTS_INDEX_HPP
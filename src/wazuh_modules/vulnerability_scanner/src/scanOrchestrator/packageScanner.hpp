@@ -12,18 +12,23 @@
 #ifndef _PACKAGE_SCANNER_HPP
 #define _PACKAGE_SCANNER_HPP
 
+#include "cacheLRU.hpp"
+#include "candidatesVersionIndex.hpp"
 #include "chainOfResponsability.hpp"
 #include "databaseFeedManager.hpp"
+#include "packageAgentsIndex.hpp"
 #include "remediationDataCache.hpp"
 #include "scanContext.hpp"
 #include "scannerHelper.hpp"
 #include "versionMatcher/versionMatcher.hpp"
 #include <memory>
+#include <unordered_map>
 #include <unordered_set>
 #include <variant>
 
 auto constexpr DEFAULT_CNA {"nvd"};
 auto constexpr L1_CACHE_SIZE {2048};
+auto constexpr CANDIDATES_INDEX_CACHE_SIZE {4096};
 
 /**
  * @brief PackageScanner class.
@@ -60,6 +65,88 @@ private:
 
     std::shared_ptr<TDatabaseFeedManager> m_databaseFeedManager;
 
+    /**
+     * @brief Version indexes of the candidates of the scanned packages, keyed by CNA, package format and name. They
+     * are shared by the scans of all the agents, and discarded when the feed is updated.
+     */
+    ShardedLRUCache<std::string, std::shared_ptr<const CandidatesVersionIndex>> m_candidatesIndexes {
+        CANDIDATES_INDEX_CACHE_SIZE};
+
+    /**
+     * @brief Scans the vulnerability candidates of a package.
+     *
+     * @details The first scan of a package builds the version index of its candidates while it evaluates them. The
+     * following scans of the same package, with the same feed, discard through the index the candidates whose
+     * affected versions don't contain the installed version, without evaluating them.
+     *
+     * @param cnaName The name of the CVE Numbering Authority (CNA) responsible for the package.
+     * @param data A shared pointer to the scan context.
+     * @param package The package data.
+     * @param vulnerabilityScan A function to perform the vulnerability scan of each candidate.
+     * @param parsedVersions Parsed versions of the package format.
+     */
+    void scanCandidates(
+        const std::string& cnaName,
+        const std::shared_ptr<TScanContext>& data,
+        const PackageData& package,
+        const std::function<bool(const std::string& cnaName,
+                                 const PackageData& package,
+                                 const NSVulnerabilityScanner::ScanVulnerabilityCandidate&)>& vulnerabilityScan,
+        VersionMatcher::ParsedVersions& parsedVersions)
+    {
+        // The agent is rescanned when the candidates of the package change.
+        PackageAgentsIndex::instance().add(cnaName, package.name, data->agentId());
+
+        const auto getCandidates = [&](const auto& callback)
+        {
+            if (data->m_candidatesPrefetch)
+            {
+                m_databaseFeedManager->getVulnerabilitiesCandidates(
+                    cnaName, package, callback, *data->m_candidatesPrefetch);
+            }
+            else
+            {
+                m_databaseFeedManager->getVulnerabilitiesCandidates(cnaName, package, callback);
+            }
+        };
+
+        const auto feedGeneration {m_databaseFeedManager->feedGeneration()};
+        const auto indexKey {cnaName + "|" + package.format + "|" + package.name};
+        if (const auto index {m_candidatesIndexes.getValue(indexKey)};
+            index.has_value() && index.value()->feedGeneration() == feedGeneration)
+        {
+            const auto lookup {index.value()->lookup(parsedVersions.get(package.version))};
+
+            // Position of each candidate among the candidates of its CVE, as they were added to the index.
+            std::unordered_map<std::string, size_t> ordinals;
+            getCandidates(
+                [&](const std::string& candidateCnaName,
+                    const PackageData& candidatePackage,
+                    const NSVulnerabilityScanner::ScanVulnerabilityCandidate& candidate)
+                {
+                    const auto cveId {candidate.cveId()->str()};
+                    if (lookup.discard(cveId, ordinals[cveId]++))
+                    {
+                        return false;
+                    }
+                    return vulnerabilityScan(candidateCnaName, candidatePackage, candidate);
+                });
+            return;
+        }
+
+        auto index {std::make_shared<CandidatesVersionIndex>(feedGeneration)};
+        getCandidates(
+            [&](const std::string& candidateCnaName,
+                const PackageData& candidatePackage,
+                const NSVulnerabilityScanner::ScanVulnerabilityCandidate& candidate)
+            {
+                index->add(candidate, parsedVersions);
+                return vulnerabilityScan(candidateCnaName, candidatePackage, candidate);
+            });
+        index->build();
+        m_candidatesIndexes.insertKey(indexKey, std::move(index));
+    }
+
     /**
      * @brief Scans package translation for vulnerabilities.
      *
@@ -73,6 +160,7 @@ private:
      * @param packageCandidate The package data candidate to be checked and translated for vulnerabilities.
      * @param vulnerabilityScan A function to perform the vulnerability scan. This function takes the CNA name,
      *                          package data, and a scan vulnerability candidate as arguments and returns a boolean.
+     * @param parsedVersions Parsed versions of the scan, per package format.
      */
     void scanPackageTranslation(
         const std::string& cnaName,
@@ -80,12 +168,13 @@ private:
         const PackageData& packageCandidate,
         const std::function<bool(const std::string& cnaName,
                                  const PackageData& package,
-                                 const NSVulnerabilityScanner::ScanVulnerabilityCandidate&)>& vulnerabilityScan)
+                                 const NSVulnerabilityScanner::ScanVulnerabilityCandidate&)>& vulnerabilityScan,
+        std::unordered_map<std::string, VersionMatcher::ParsedVersions>& parsedVersions)
     {
         const auto osPlatform = data->osPlatform().data();
         const auto translations = m_databaseFeedManager->checkAndTranslatePackage(packageCandidate, osPlatform);
 
-        auto scanPackage = [this, &data, &cnaName, &vulnerabilityScan](const PackageData& package)
+        auto scanPackage = [this, &data, &cnaName, &vulnerabilityScan, &parsedVersions](const PackageData& package)
         {
             logDebug1(WM_VULNSCAN_LOGTAG,
                       "Initiating a vulnerability scan for package '%s' (%s) (%s) with CVE Numbering Authorities (CNA) "
@@ -98,7 +187,11 @@ private:
                       data->agentId().data(),
                       data->agentVersion().data());
 
-            m_databaseFeedManager->getVulnerabilitiesCandidates(cnaName, package, vulnerabilityScan);
+            scanCandidates(cnaName,
+                           data,
+                           package,
+                           vulnerabilityScan,
+                           formatParsedVersions(package.format, parsedVersions));
         };
 
         if (!translations.empty())
@@ -110,10 +203,12 @@ private:
         }
         else
         {
-            PackageData package = {.name = Utils::toLowerCase(data->packageName().data()),
-                                   .vendor = Utils::toLowerCase(data->packageVendor().data()),
+            PackageData package = {.name = std::string(data->packageName()),
+                                   .vendor = std::string(data->packageVendor()),
                                    .format = data->packageFormat().data(),
                                    .version = data->packageVersion().data()};
+            Utils::toLowerCaseInPlace(package.name);
+            Utils::toLowerCaseInPlace(package.vendor);
 
             scanPackage(package);
         }
@@ -192,10 +287,11 @@ private:
         else
         {
             std::string base = it->template get<std::string>();
-            Utils::replaceAll(base, "$(PLATFORM)", platformEquivalence(ctx->osPlatform().data()));
-            Utils::replaceAll(base,
-                              "$(MAJOR_VERSION)",
-                              majorVersionEquivalence(ctx->osPlatform().data(), ctx->osMajorVersion().data()));
+            Utils::replaceAll(
+                base,
+                {{"$(PLATFORM)", platformEquivalence(ctx->osPlatform().data())},
+                 {"$(MAJOR_VERSION)",
+                  majorVersionEquivalence(ctx->osPlatform().data(), ctx->osMajorVersion().data())}});
             return base;
         }
     }
@@ -319,20 +415,42 @@ private:
         return true;
     }
 
-    bool versionMatch(const std::string& cnaName,
-                      const PackageData& package,
-                      const NSVulnerabilityScanner::ScanVulnerabilityCandidate& callbackData,
-                      std::shared_ptr<TScanContext> contextData)
+    /**
+     * @brief Gets the parsed versions of a package format, so the installed version and the bounds of the candidates
+     * are parsed once per package scan instead of once per comparison.
+     *
+     * @param format Package format.
+     * @param parsedVersions Parsed versions of the scan, per package format.
+     * @return VersionMatcher::ParsedVersions& Parsed versions of the format.
+     */
+    VersionMatcher::ParsedVersions&
+    formatParsedVersions(const std::string& format,
+                         std::unordered_map<std::string, VersionMatcher::ParsedVersions>& parsedVersions)
     {
+        if (const auto it = parsedVersions.find(format); it != parsedVersions.end())
+        {
+            return it->second;
+        }
+
         std::variant<VersionObjectType, VersionMatcherStrategy> objectType = VersionMatcherStrategy::Unspecified;
-        if (const auto it = m_packageMap.find(package.format); it != m_packageMap.end())
+        if (const auto it = m_packageMap.find(format); it != m_packageMap.end())
         {
             objectType = it->second;
         }
+        return parsedVersions.try_emplace(format, objectType).first->second;
+    }
+
+    bool versionMatch(const std::string& cnaName,
+                      const PackageData& package,
+                      const NSVulnerabilityScanner::ScanVulnerabilityCandidate& callbackData,
+                      std::shared_ptr<TScanContext> contextData,
+                      VersionMatcher::ParsedVersions& parsedVersions)
+    {
+        const auto& parsedPackageVersion = parsedVersions.get(package.version);
 
         for (const auto& version : *callbackData.versions())
         {
-            const std::string packageVersion {package.version};
+            const std::string& packageVersion {package.version};
             std::string versionString {version->version() ? version->version()->str() : ""};
             std::string versionStringLessThan {version->lessThan() ? version->lessThan()->str() : ""};
             std::string versionStringLessThanOrEqual {version->lessThanOrEqual() ? version->lessThanOrEqual()->str()
@@ -352,7 +470,7 @@ private:
             // No version range specified, check if the installed version is equal to the required version.
             if (versionStringLessThan.empty() && versionStringLessThanOrEqual.empty())
             {
-                if (VersionMatcher::compare(packageVersion, versionString, objectType) ==
+                if (VersionMatcher::compare(parsedPackageVersion, parsedVersions.get(versionString)) ==
                     VersionComparisonResult::A_EQUAL_B)
                 {
                     // Version match found, the package status is defined by the vulnerability status.
@@ -390,7 +508,8 @@ private:
                 }
                 else
                 {
-                    const auto matchResult = VersionMatcher::compare(packageVersion, versionString, objectType);
+                    const auto matchResult =
+                        VersionMatcher::compare(parsedPackageVersion, parsedVersions.get(versionString));
                     lowerBoundMatch = matchResult == VersionComparisonResult::A_GREATER_THAN_B ||
                                       matchResult == VersionComparisonResult::A_EQUAL_B;
                 }
@@ -402,13 +521,13 @@ private:
                     if (!versionStringLessThan.empty() && versionStringLessThan.compare("*") != 0)
                     {
                         const auto matchResult =
-                            VersionMatcher::compare(packageVersion, versionStringLessThan, objectType);
+                            VersionMatcher::compare(parsedPackageVersion, parsedVersions.get(versionStringLessThan));
                         upperBoundMatch = matchResult == VersionComparisonResult::A_LESS_THAN_B;
                     }
                     else if (!versionStringLessThanOrEqual.empty())
                     {
-                        const auto matchResult =
-                            VersionMatcher::compare(packageVersion, versionStringLessThanOrEqual, objectType);
+                        const auto matchResult = VersionMatcher::compare(
+                            parsedPackageVersion, parsedVersions.get(versionStringLessThanOrEqual));
                         upperBoundMatch = matchResult == VersionComparisonResult::A_LESS_THAN_B ||
                                           matchResult == VersionComparisonResult::A_EQUAL_B;
                     }
@@ -568,6 +687,8 @@ public:
      */
     std::shared_ptr<TScanContext> handleRequest(std::shared_ptr<TScanContext> data) override
     {
+        std::unordered_map<std::string, VersionMatcher::ParsedVersions> parsedVersions;
+
         auto vulnerabilityScan = [&](const std::string& cnaName,
                                      const PackageData& package,
                                      const NSVulnerabilityScanner::ScanVulnerabilityCandidate& callbackData)
@@ -589,7 +710,8 @@ public:
                 }
 
                 /* Real version analysis of the candidate. */
-                if (versionMatch(cnaName, package, callbackData, data))
+                if (versionMatch(
+                        cnaName, package, callbackData, data, formatParsedVersions(package.format, parsedVersions)))
                 {
                     // The candidate version matches the package. Post-match filtering.
                     if (data->osPlatform().compare("windows") == 0)
@@ -628,7 +750,7 @@ public:
                                    .vendor = data->packageVendor().data(),
                                    .format = data->packageFormat().data(),
                                    .version = data->packageVersion().data()};
-            scanPackageTranslation(CNAValue, data, package, vulnerabilityScan);
+            scanPackageTranslation(CNAValue, data, package, vulnerabilityScan, parsedVersions);
         }
         catch (const std::exception& e)
         {
@@ -0,0 +1,121 @@
+/*
+ * Wazuh Vulnerability scanner - Scan Orchestrator
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _PRELOAD_AGENTS_DATA_HPP
+#define _PRELOAD_AGENTS_DATA_HPP
+
+#include "chainOfResponsability.hpp"
+#include "loggerHelper.h"
+#include "remediationDataCache.hpp"
+#include "scanContext.hpp"
+#include "scannerMetrics.hpp"
+#include "socketDBWrapper.hpp"
+#include "stringHelper.h"
+#include "wazuhDBQueryBuilder.hpp"
+#include <unordered_set>
+#include <vector>
+
+/**
+ * @brief Preloads the data of the agents about to be scanned.
+ *
+ * The hotfixes of the Windows agents are loaded into the remediation data cache before the scan, so the scanners
+ * don't wait for Wazuh-DB when they check the remediations of the candidates. The Windows agents are found with a
+ * single query to the global database, the rest of the agents don't have hotfixes and aren't queried. The OS data
+ * isn't preloaded, as the scan of each agent starts with its OS, which fills the OS data cache.
+ *
+ * @tparam TScanContext scan context type.
+ * @tparam TSocketDBWrapper Wazuh-DB wrapper type.
+ * @tparam TRemediationDataCache remediation data cache type.
+ */
+template<typename TScanContext = ScanContext,
+         typename TSocketDBWrapper = SocketDBWrapper,
+         typename TRemediationDataCache = RemediationDataCache<>>
+class TPreloadAgentsData final : public AbstractHandler<std::shared_ptr<TScanContext>>
+{
+public:
+    // LCOV_EXCL_START
+    /**
+     * @brief Construct a new preload object.
+     */
+    explicit TPreloadAgentsData() = default;
+    // LCOV_EXCL_STOP
+
+    /**
+     * @brief Handles request and passes control to the next step of the chain.
+     *
+     * The preload is an optimization: If the Windows agents can't be queried, the chain continues and the hotfixes
+     * are queried by the scans as needed.
+     *
+     * @param data Scan context, with the list of agents to scan.
+     * @return std::shared_ptr<TScanContext> Abstract handler.
+     */
+    std::shared_ptr<TScanContext> handleRequest(std::shared_ptr<TScanContext> data) override
+    {
+        nlohmann::json response;
+        try
+        {
+            const ScannerMetrics::Timer timer {"wazuhdb.query"};
+            TSocketDBWrapper::instance().query(WazuhDBQueryBuilder::builder()
+                                                   .global()
+                                                   .selectAll()
+                                                   .fromTable("agent")
+                                                   .whereColumn("os_platform")
+                                                   .equalsTo("windows")
+                                                   .build(),
+                                               response);
+        }
+        catch (const std::exception& e)
+        {
+            logDebug2(WM_VULNSCAN_LOGTAG, "Unable to retrieve the Windows agents to preload. Reason: %s.", e.what());
+            return AbstractHandler<std::shared_ptr<TScanContext>>::handleRequest(std::move(data));
+        }
+
+        std::unordered_set<std::string> windowsAgents;
+        for (const auto& agent : response)
+        {
+            if (agent.contains("id") && agent.at("id").is_number_integer())
+            {
+                windowsAgents.insert(Utils::padString(std::to_string(agent.at("id").get<int>()), '0', 3));
+            }
+        }
+
+        std::vector<std::string> agentIds;
+        for (const auto& agent : data->m_agents)
+        {
+            if (windowsAgents.count(agent.id) != 0)
+            {
+                agentIds.push_back(agent.id);
+            }
+        }
+
+        if (!agentIds.empty())
+        {
+            auto& remediationDataCache = TRemediationDataCache::instance();
+            const auto loaded = remediationDataCache.preload(agentIds);
+            const auto stats = remediationDataCache.stats();
+            logDebug2(WM_VULNSCAN_LOGTAG,
+                      "Preloaded the hotfixes of %zu of %zu Windows agents. Remediation cache: %zu agents, %llu hits, "
+                      "%llu misses, %llu evictions.",
+                      loaded,
+                      agentIds.size(),
+                      remediationDataCache.size(),
+                      static_cast<unsigned long long>(stats.hits),
+                      static_cast<unsigned long long>(stats.misses),
+                      static_cast<unsigned long long>(stats.evictions));
+        }
+
+        return AbstractHandler<std::shared_ptr<TScanContext>>::handleRequest(std::move(data));
+    }
+};
+
+using PreloadAgentsData = TPreloadAgentsData<>;
+
+#endif // _PRELOAD_AGENTS_DATA_HPP
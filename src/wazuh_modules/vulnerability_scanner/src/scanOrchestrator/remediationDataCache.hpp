@@ -14,6 +14,7 @@
 
 #include "../policyManager/policyManager.hpp"
 #include "cacheLRU.hpp"
+#include "scannerMetrics.hpp"
 #include "singleton.hpp"
 #include "socketDBWrapper.hpp"
 #include "wazuhDBQueryBuilder.hpp"
@@ -21,6 +22,7 @@
 #include <shared_mutex>
 #include <string>
 #include <unordered_set>
+#include <vector>
 
 /**
  * @brief Remediation structure.
@@ -34,12 +36,15 @@ struct Remediation final
  * @brief RemediationDataCache class.
  *
  * @note This class queries the Wazuh-DB to get the remediation data for a given agent, and stores it in a LRU cache
+ *
+ * @tparam TSocketDBWrapper Wazuh-DB wrapper type.
+ * @tparam TCache Cache type, it must be thread-safe as the lookups only hold a shared lock.
  */
-template<typename TSocketDBWrapper = SocketDBWrapper>
+template<typename TSocketDBWrapper = SocketDBWrapper, typename TCache = ShardedLRUCache<std::string, Remediation>>
 class RemediationDataCache final : public Singleton<RemediationDataCache<>>
 {
 private:
-    LRUCache<std::string, Remediation> m_remediationData {PolicyManager::instance().getRemediationLRUSize()};
+    TCache m_remediationData {PolicyManager::instance().getRemediationLRUSize()};
     std::shared_mutex m_mutex;
 
     Remediation getRemediationDataFromWdb(const std::string& agentId) const
@@ -47,6 +52,7 @@ private:
         nlohmann::json response;
         try
         {
+            const ScannerMetrics::Timer timer {"wazuhdb.query"};
             TSocketDBWrapper::instance().query(WazuhDBQueryBuilder::builder().agentGetHotfixesCommand(agentId).build(),
                                                response);
         }
@@ -97,15 +103,72 @@ public:
 
         const auto remediationData = getRemediationDataFromWdb(agentId);
 
-        if (!remediationData.hotfixes.empty())
-        {
-            // Update the cache with the queried data
-            m_remediationData.insertKey(agentId, remediationData);
-        }
+        // Update the cache with the queried data. An agent without hotfixes is cached too, so it isn't queried again
+        // for each candidate with remediations: The hotfixes installed later are merged by addRemediationData.
+        m_remediationData.insertKey(agentId, remediationData);
 
         return remediationData;
     } // LCOV_EXCL_LINE
 
+    /**
+     * @brief Loads the remediation data of the agents that aren't cached, before they're scanned.
+     *
+     * @note The loading stops when the cache is full, as the following agents would evict the ones loaded before. The
+     * agents whose data can't be fetched are skipped, their scans query it again and handle the error.
+     *
+     * @param agentIds agent ids.
+     * @return size_t Number of agents loaded.
+     */
+    size_t preload(const std::vector<std::string>& agentIds)
+    {
+        size_t loaded {0};
+        for (const auto& agentId : agentIds)
+        {
+            // The lock is taken for each agent, so the events that add hotfixes aren't held by the whole preload.
+            std::shared_lock lock(m_mutex);
+            if (m_remediationData.isFull())
+            {
+                break;
+            }
+
+            if (m_remediationData.isHit(agentId))
+            {
+                continue;
+            }
+
+            try
+            {
+                m_remediationData.insertKey(agentId, getRemediationDataFromWdb(agentId));
+                ++loaded;
+            }
+            catch (const std::exception&)
+            {
+                continue;
+            }
+        }
+        return loaded;
+    }
+
+    /**
+     * @brief Number of agents cached.
+     *
+     * @return size_t
+     */
+    size_t size() const
+    {
+        return m_remediationData.size();
+    }
+
+    /**
+     * @brief Hits, misses and evictions of the cache lookups.
+     *
+     * @return LRUCacheStats
+     */
+    LRUCacheStats stats() const
+    {
+        return m_remediationData.stats();
+    }
+
     /**
      * @brief Add remediation data to the cache.
      *
@@ -14,7 +14,9 @@
 
 #include "chainOfResponsability.hpp"
 #include "indexerConnector.hpp"
+#include "jsonWriter.hpp"
 #include "scanContext.hpp"
+#include "scannerMetrics.hpp"
 
 /**
  * @brief ResultIndexer class.
@@ -28,6 +30,56 @@ class TResultIndexer final : public AbstractHandler<std::shared_ptr<TScanContext
 private:
     std::shared_ptr<TIndexerConnector> m_indexerConnector;
 
+    /**
+     * @brief Writes an element with its ECS document as the "data" field, as the element would be serialized with it.
+     *
+     * @param writer Writer, it's cleared first.
+     * @param element Element, without its document.
+     * @param elementData Serialized ECS document.
+     */
+    static void writeElement(JsonWriter& writer, const nlohmann::json& element, std::string_view elementData)
+    {
+        static constexpr std::string_view DATA_KEY {"data"};
+
+        writer.clear();
+        writer.beginObject();
+
+        // The fields are written sorted, as nlohmann::json serializes them.
+        auto dataWritten {false};
+        for (const auto& [key, value] : element.items())
+        {
+            if (!dataWritten && key >= DATA_KEY)
+            {
+                writer.key(DATA_KEY).raw(elementData);
+                dataWritten = true;
+            }
+            if (key == DATA_KEY)
+            {
+                continue;
+            }
+
+            writer.key(key);
+            if (value.is_string())
+            {
+                writer.string(value.template get_ref<const std::string&>());
+            }
+            else if (value.is_boolean())
+            {
+                writer.boolean(value.template get<bool>());
+            }
+            else
+            {
+                writer.raw(value.dump());
+            }
+        }
+        if (!dataWritten)
+        {
+            writer.key(DATA_KEY).raw(elementData);
+        }
+
+        writer.endObject();
+    }
+
 public:
     // LCOV_EXCL_START
     /**
@@ -51,6 +103,9 @@ public:
     {
         if (m_indexerConnector != nullptr)
         {
+            // The publication queues the elements, they're sent to the indexer by the connector.
+            static auto& publishTime {ScannerMetrics::instance().histogram("indexer.publish")};
+
             for (auto& [key, value] : data->m_elements)
             {
                 // Add no-index field to the json object, based on the scan context value.
@@ -62,7 +117,20 @@ public:
                 logDebug2(WM_VULNSCAN_LOGTAG, "Processing and publish key: %s", key.c_str());
                 if (value.contains("operation") && value.contains("id"))
                 {
-                    m_indexerConnector->publish(value.dump());
+                    // The ECS documents are already serialized, so they aren't parsed into the elements.
+                    if (const auto it {data->m_elementsData.find(key)}; it != data->m_elementsData.end())
+                    {
+                        thread_local JsonWriter writer;
+                        writeElement(writer, value, it->second);
+                        const ScannerMetrics::Timer timer(publishTime);
+                        m_indexerConnector->publish(writer.str());
+                    }
+                    else
+                    {
+                        const auto element {value.dump()};
+                        const ScannerMetrics::Timer timer(publishTime);
+                        m_indexerConnector->publish(element);
+                    }
                 }
                 else
                 {
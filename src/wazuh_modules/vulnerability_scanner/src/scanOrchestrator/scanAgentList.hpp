@@ -16,9 +16,16 @@
 #include "chainOfResponsability.hpp"
 #include "loggerHelper.h"
 #include "scanContext.hpp"
+#include "scannerMetrics.hpp"
 #include "socketDBWrapper.hpp"
+#include "stringHelper.h"
 #include "wazuhDBQueryBuilder.hpp"
 #include "wdbDataException.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
 
 /**
  * @brief Orchestrates queries to the global Wazuh-DB system and initiates package scanning.
@@ -36,6 +43,7 @@ class TScanAgentList final : public AbstractHandler<std::shared_ptr<TScanContext
 private:
     std::shared_ptr<TAbstractHandler> m_packageScanSuborchestration;
     std::shared_ptr<TAbstractHandler> m_osScanSuborchestration;
+    unsigned int m_workers;
 
     /**
      * @brief The `scanAgentOs` method fetches the OS information of an agent from the Wazuh-DB and sends the data to
@@ -49,6 +57,7 @@ private:
 
         try
         {
+            const ScannerMetrics::Timer timer {"wazuhdb.query"};
             TSocketDBWrapper::instance().query(WazuhDBQueryBuilder::builder().agentGetOsInfoCommand(agent.id).build(),
                                                response);
         }
@@ -132,6 +141,7 @@ private:
 
         try
         {
+            const ScannerMetrics::Timer timer {"wazuhdb.query"};
             TSocketDBWrapper::instance().query(WazuhDBQueryBuilder::builder().agentGetPackagesCommand(agent.id).build(),
                                                response);
         }
@@ -156,6 +166,16 @@ private:
             return;
         }
 
+        // The packages of the agent share their candidates prefetch, so each CNA column is read once in key order.
+        // The names are queried in lower case when there isn't a translation.
+        std::vector<std::string> packageNames;
+        packageNames.reserve(response.size());
+        for (const auto& package : response)
+        {
+            Utils::toLowerCaseInPlace(packageNames.emplace_back(package.value("name", "")));
+        }
+        const auto candidatesPrefetch {std::make_shared<CandidatesPrefetch>(packageNames)};
+
         for (const auto& package : response)
         {
             flatbuffers::FlatBufferBuilder fbBuilder;
@@ -197,11 +217,39 @@ private:
 
             auto context = std::make_shared<TScanContext>(variantData);
             context->m_noIndex = noIndex;
+            context->m_candidatesPrefetch = candidatesPrefetch;
 
             m_packageScanSuborchestration->handleRequest(std::move(context));
         }
     }
 
+    /**
+     * @brief Scans the OS and packages of an agent.
+     *
+     * @param agent The agent data.
+     * @param noIndex Flag to indicate if the elements should be indexed.
+     * @return true If the scan is complete, false if the agent data couldn't be fetched and it should be rescanned.
+     */
+    bool scanAgent(const AgentData& agent, const bool noIndex)
+    {
+        try
+        {
+            scanAgentOs(agent, noIndex);
+            scanAgentPackages(agent, noIndex);
+        }
+        catch (const WdbDataException& e)
+        {
+            logDebug2(
+                WM_VULNSCAN_LOGTAG, "Error executing query to fetch agent data for agents. Reason: %s.", e.what());
+            return false;
+        }
+        catch (const std::exception& e)
+        {
+            logError(WM_VULNSCAN_LOGTAG, "Error handling request: %s.", e.what());
+        }
+        return true;
+    }
+
 public:
     /**
      * @brief Construct a new `TScanAgentList` object.
@@ -211,11 +259,15 @@ public:
      *
      * @param packageScanOrchestration package orchestration instance.
      * @param osScanOrchestration os orchestration instance.
+     * @param workers Number of agents scanned concurrently. With more than one, the sub-orchestrations must be safe to
+     * call from several threads.
      */
     explicit TScanAgentList(std::shared_ptr<TAbstractHandler> packageScanOrchestration,
-                            std::shared_ptr<TAbstractHandler> osScanOrchestration)
+                            std::shared_ptr<TAbstractHandler> osScanOrchestration,
+                            const unsigned int workers = 1)
         : m_packageScanSuborchestration(std::move(packageScanOrchestration))
         , m_osScanSuborchestration(std::move(osScanOrchestration))
+        , m_workers(std::max(workers, 1u))
     {
     }
 
@@ -226,7 +278,8 @@ public:
      * query response to a sub-orchestration component. The handling involves several steps:
      *
      * 1. It iterates over the list of agents and executes queries to fetch data from the Wazuh-DB.
-     * 2. For each agent, it scans the OS and packages.
+     * 2. For each agent, it scans the OS and packages. With several workers, each one takes the next agent of the list
+     * when it finishes the previous one, so the agents with many packages don't hold back the rest.
      * 3. If a query fails, it logs a warning and adds the agent to a list of agents with incomplete scans.
      * 4. If the list is not empty, it throws an exception to initiate a rescan for the agents in the list.
      * @param data A shared pointer to the input data.
@@ -235,22 +288,49 @@ public:
      */
     std::shared_ptr<TScanContext> handleRequest(std::shared_ptr<TScanContext> data) override
     {
-        for (const auto& agent : data->m_agents)
+        const auto& agents {data->m_agents};
+        const auto workers {std::min<size_t>(m_workers, agents.size())};
+
+        if (workers <= 1)
         {
-            try
+            for (const auto& agent : agents)
             {
-                scanAgentOs(agent, data->m_noIndex);
-                scanAgentPackages(agent, data->m_noIndex);
+                if (!scanAgent(agent, data->m_noIndex))
+                {
+                    data->m_agentsWithIncompletedScan.push_back(agent);
+                }
             }
-            catch (const WdbDataException& e)
+        }
+        else
+        {
+            // Result of each agent, so the incomplete scans are reported in the order of the list.
+            std::vector<uint8_t> completed(agents.size(), 1);
+            std::atomic<size_t> nextAgent {0};
+
+            std::vector<std::thread> threads;
+            threads.reserve(workers);
+            for (size_t i {0}; i < workers; ++i)
             {
-                logDebug2(
-                    WM_VULNSCAN_LOGTAG, "Error executing query to fetch agent data for agents. Reason: %s.", e.what());
-                data->m_agentsWithIncompletedScan.push_back(agent);
+                threads.emplace_back(
+                    [&]()
+                    {
+                        for (auto index {nextAgent++}; index < agents.size(); index = nextAgent++)
+                        {
+                            completed[index] = scanAgent(agents[index], data->m_noIndex) ? 1 : 0;
+                        }
+                    });
             }
-            catch (const std::exception& e)
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+
+            for (size_t index {0}; index < agents.size(); ++index)
             {
-                logError(WM_VULNSCAN_LOGTAG, "Error handling request: %s.", e.what());
+                if (!completed[index])
+                {
+                    data->m_agentsWithIncompletedScan.push_back(agents[index]);
+                }
             }
         }
 
@@ -12,6 +12,7 @@
 #ifndef _SCAN_CONTEXT_HPP
 #define _SCAN_CONTEXT_HPP
 
+#include "candidatesPrefetch.hpp"
 #include "external/nlohmann/json.hpp"
 #include "flatbuffers/include/syscollector_deltas_generated.h"
 #include "flatbuffers/include/syscollector_synchronization_generated.h"
@@ -188,20 +189,22 @@ private:
 
         if (!cpe.empty())
         {
-            // Replace variables in the CPE name
-            Utils::replaceAll(cpe, "$(MAJOR_VERSION)", m_osData.majorVersion);
-            Utils::replaceAll(cpe, "$(MINOR_VERSION)", m_osData.minorVersion);
-            Utils::replaceAll(cpe, "$(DISPLAY_VERSION)", m_osData.displayVersion);
-            Utils::replaceAll(cpe, "$(VERSION)", m_osData.version);
-            Utils::replaceAll(cpe, "$(RELEASE)", m_osData.release);
-
             // For SUSE, replace the hyphen in the version with a colon, because inner the version we have the version
             // update.
             auto versionWithHyphen {m_osData.version};
             Utils::replaceAll(versionWithHyphen, "-", ":");
-            Utils::replaceAll(cpe, "$(VERSION_UPDATE_HYPHEN)", versionWithHyphen);
 
-            m_osData.cpeName += Utils::toLowerCase(cpe);
+            // Replace variables in the CPE name
+            Utils::replaceAll(cpe,
+                              {{"$(MAJOR_VERSION)", m_osData.majorVersion},
+                               {"$(MINOR_VERSION)", m_osData.minorVersion},
+                               {"$(DISPLAY_VERSION)", m_osData.displayVersion},
+                               {"$(VERSION)", m_osData.version},
+                               {"$(RELEASE)", m_osData.release},
+                               {"$(VERSION_UPDATE_HYPHEN)", versionWithHyphen}});
+
+            Utils::toLowerCaseInPlace(cpe);
+            m_osData.cpeName += cpe;
         }
         else
         {
@@ -1483,6 +1486,12 @@ public:
      */
     std::unordered_map<std::string, nlohmann::json> m_elements;
 
+    /**
+     * @brief ECS documents of the elements, already serialized, keyed as the elements.
+     * @details They're published as the "data" field of the elements, without building them as JSON objects.
+     */
+    std::unordered_map<std::string, std::string> m_elementsData;
+
     /**
      * @brief Elements for alerts.
      *
@@ -1526,6 +1535,12 @@ public:
      * @details This is used to avoid indexing the scan results.
      */
     bool m_noIndex = false;
+
+    /**
+     * @brief Vulnerability candidates of the agent packages, shared by the package contexts of a re-scan.
+     * @details If it's not set, the candidates of each package are queried alone.
+     */
+    std::shared_ptr<CandidatesPrefetch> m_candidatesPrefetch;
     // LCOV_EXCL_STOP
 private:
     /**
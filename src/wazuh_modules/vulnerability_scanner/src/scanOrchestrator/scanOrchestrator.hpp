@@ -17,20 +17,24 @@
 #include "flatbuffers/include/syscollector_synchronization_generated.h"
 #include "indexerConnector.hpp"
 #include "messageBuffer_generated.h"
+#include "packageAgentsIndex.hpp"
 #include "scanContext.hpp"
+#include "scannerMetrics.hpp"
 #include "wdbDataException.hpp"
 #include <memory>
 #include <string>
 #include <variant>
+#include <vector>
 
 constexpr auto INVENTORY_DB_PATH = "queue/vd/inventory";
 constexpr auto DELAYED_EVENTS_BULK_SIZE {1};
 constexpr auto DELAYED_QUEUE_PATH = "queue/vd/delayed";
 constexpr auto DELAYED_POSTPONE_SECONDS {60};
+constexpr auto DELAYED_QUEUE_GAUGE {"queue.delayed_events"};
 
 using EventDispatcher = TThreadEventDispatcher<rocksdb::Slice,
                                                rocksdb::PinnableSlice,
-                                               std::function<void(std::queue<rocksdb::PinnableSlice>&)>>;
+                                               std::function<void(std::vector<rocksdb::PinnableSlice>&)>>;
 
 using EventDelayedDispatcher =
     TThreadEventDispatcher<rocksdb::Slice,
@@ -116,7 +120,10 @@ public:
 
         initEventDelayedDispatcher();
     }
-    ~TScanOrchestrator() = default;
+    ~TScanOrchestrator()
+    {
+        ScannerMetrics::instance().removeGauge(DELAYED_QUEUE_GAUGE);
+    }
     // LCOV_EXCL_STOP
 
     /**
@@ -134,6 +141,7 @@ public:
                 }
                 catch (const WdbDataException& e)
                 {
+                    m_delayedPostpones.fetch_add(1, std::memory_order_relaxed);
                     m_eventDelayedDispatcher->postpone(e.agentId(), std::chrono::seconds(DELAYED_POSTPONE_SECONDS));
                     logDebug2(WM_VULNSCAN_LOGTAG, "Postponed delayed event for agent %s", e.agentId().c_str());
                     throw std::runtime_error(e.what());
@@ -144,6 +152,7 @@ public:
                     for (const auto& agentData : e.agentList())
                     {
                         pushReScanToDelayedDispatcher(agentData.id, e.noIndex());
+                        m_delayedPostpones.fetch_add(1, std::memory_order_relaxed);
                         m_eventDelayedDispatcher->postpone(agentData.id,
                                                            std::chrono::seconds(DELAYED_POSTPONE_SECONDS));
                     }
@@ -154,6 +163,8 @@ public:
                 }
             },
             DELAYED_QUEUE_PATH);
+
+        ScannerMetrics::instance().gauge(DELAYED_QUEUE_GAUGE, [this]() { return m_eventDelayedDispatcher->size(); });
     }
 
     /**
@@ -163,6 +174,7 @@ public:
      */
     void pushEventToDelayedDispatcher(const rocksdb::PinnableSlice& element, const std::string& agentId)
     {
+        m_delayedPushes.fetch_add(1, std::memory_order_relaxed);
         m_eventDelayedDispatcher->push(agentId, element);
     }
 
@@ -189,6 +201,7 @@ public:
 
         builder.Finish(object);
 
+        m_delayedPushes.fetch_add(1, std::memory_order_relaxed);
         m_eventDelayedDispatcher->push(agentId,
                                        {reinterpret_cast<const char*>(builder.GetBufferPointer()), builder.GetSize()});
     }
@@ -260,6 +273,7 @@ private:
         if (!isDelayed && type != ScannerType::CleanupAllAgentData && type != ScannerType::ReScanAllAgents &&
             m_eventDelayedDispatcher->size(context->agentId()))
         {
+            m_delayedPushes.fetch_add(1, std::memory_order_relaxed);
             m_eventDelayedDispatcher->push(context->agentId(), rawData);
         }
         else
@@ -275,7 +289,10 @@ private:
                     break;
                 // LCOV_EXCL_START
                 case ScannerType::ReScanAllAgents:
+                    // The index of the scanned packages is rebuilt, it's complete if all the agents are scanned.
+                    PackageAgentsIndex::instance().reset();
                     m_reScanAllOrchestration->handleRequest(std::move(context));
+                    PackageAgentsIndex::instance().markComplete();
                     m_eventDelayedDispatcher->clear();
                     break;
                 case ScannerType::ReScanSingleAgent:
@@ -319,6 +336,8 @@ private:
     std::shared_ptr<TOrchestrationNode> m_inventorySyncOrchestration;
     std::shared_mutex& m_mutex;
     std::shared_ptr<EventDelayedDispatcher> m_eventDelayedDispatcher;
+    std::atomic<uint64_t>& m_delayedPushes {ScannerMetrics::instance().counter("delayed.pushed")};
+    std::atomic<uint64_t>& m_delayedPostpones {ScannerMetrics::instance().counter("delayed.postponed")};
 };
 
 using ScanOrchestrator = TScanOrchestrator<>;
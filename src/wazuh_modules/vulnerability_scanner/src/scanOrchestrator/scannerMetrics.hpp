@@ -0,0 +1,303 @@
+/*
+ * Wazuh Vulnerability scanner - Scan Orchestrator
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _SCANNER_METRICS_HPP
+#define _SCANNER_METRICS_HPP
+
+#include "json.hpp"
+#include "singleton.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+// Bucket i counts the durations below 2^i microseconds (and above the previous bound), the last one is unbounded.
+constexpr auto SCANNER_METRICS_BUCKETS {28};
+
+/**
+ * @brief ScannerMetrics class.
+ *
+ * @details Throughput and latency metrics of the scanner: Latency histograms (e.g. of each step of the chains, of the
+ * Wazuh-DB queries or of the feed reads), counters and gauges sampled when the metrics are dumped (e.g. the queue
+ * depths). The metrics are created on first use and never removed, so the references returned can be kept, and they
+ * are updated without locks.
+ */
+class ScannerMetrics final : public Singleton<ScannerMetrics>
+{
+public:
+    /**
+     * @brief Latency histogram, with power of two buckets in microseconds.
+     */
+    class Histogram final
+    {
+    private:
+        std::array<std::atomic<uint64_t>, SCANNER_METRICS_BUCKETS> m_buckets {};
+        std::atomic<uint64_t> m_count {0};
+        std::atomic<uint64_t> m_sum {0};
+        std::atomic<uint64_t> m_max {0};
+
+        static uint64_t bucketBound(const size_t bucket)
+        {
+            return uint64_t {1} << bucket;
+        }
+
+        uint64_t percentile(const uint64_t count, const double ratio) const
+        {
+            // Position of the percentile among the recorded durations, starting at one.
+            const auto position {static_cast<uint64_t>(std::ceil(static_cast<double>(count) * ratio))};
+            const auto rank {std::max<uint64_t>(position, 1)};
+            uint64_t accumulated {0};
+            for (size_t i = 0; i < m_buckets.size() - 1; ++i)
+            {
+                accumulated += m_buckets[i].load(std::memory_order_relaxed);
+                if (accumulated >= rank)
+                {
+                    return bucketBound(i);
+                }
+            }
+            return m_max.load(std::memory_order_relaxed);
+        }
+
+    public:
+        /**
+         * @brief Records a duration.
+         *
+         * @param elapsed Duration.
+         */
+        void record(const std::chrono::microseconds elapsed)
+        {
+            const auto value {static_cast<uint64_t>(std::max<int64_t>(elapsed.count(), 0))};
+
+            size_t bucket {0};
+            while (bucket < m_buckets.size() - 1 && value >= bucketBound(bucket))
+            {
+                ++bucket;
+            }
+
+            m_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+            m_count.fetch_add(1, std::memory_order_relaxed);
+            m_sum.fetch_add(value, std::memory_order_relaxed);
+            auto max {m_max.load(std::memory_order_relaxed)};
+            while (value > max && !m_max.compare_exchange_weak(max, value, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        /**
+         * @brief Number of durations recorded.
+         *
+         * @return uint64_t
+         */
+        uint64_t count() const
+        {
+            return m_count.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Summary of the histogram. The percentiles are the upper bounds of their buckets.
+         *
+         * @return nlohmann::json Count, sum, mean, max and percentiles, in microseconds.
+         */
+        nlohmann::json dump() const
+        {
+            const auto count {m_count.load(std::memory_order_relaxed)};
+            const auto sum {m_sum.load(std::memory_order_relaxed)};
+
+            nlohmann::json summary;
+            summary["count"] = count;
+            summary["sum_us"] = sum;
+            summary["mean_us"] = count == 0 ? 0 : sum / count;
+            summary["max_us"] = m_max.load(std::memory_order_relaxed);
+            summary["p50_us"] = count == 0 ? 0 : percentile(count, 0.5);
+            summary["p90_us"] = count == 0 ? 0 : percentile(count, 0.9);
+            summary["p99_us"] = count == 0 ? 0 : percentile(count, 0.99);
+            return summary;
+        }
+
+        /**
+         * @brief Clears the recorded durations.
+         */
+        void reset()
+        {
+            for (auto& bucket : m_buckets)
+            {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+            m_count.store(0, std::memory_order_relaxed);
+            m_sum.store(0, std::memory_order_relaxed);
+            m_max.store(0, std::memory_order_relaxed);
+        }
+    };
+
+    /**
+     * @brief Records the lifetime of the object in a histogram.
+     */
+    class Timer final
+    {
+    private:
+        Histogram& m_histogram;
+        std::chrono::steady_clock::time_point m_start {std::chrono::steady_clock::now()};
+
+    public:
+        /**
+         * @brief Starts timing.
+         *
+         * @param histogram Histogram where the duration is recorded.
+         */
+        explicit Timer(Histogram& histogram)
+            : m_histogram(histogram)
+        {
+        }
+
+        /**
+         * @brief Starts timing.
+         *
+         * @param name Name of the histogram where the duration is recorded.
+         */
+        explicit Timer(const std::string& name)
+            : m_histogram(ScannerMetrics::instance().histogram(name))
+        {
+        }
+
+        Timer(const Timer&) = delete;
+        Timer& operator=(const Timer&) = delete;
+
+        ~Timer()
+        {
+            m_histogram.record(
+                std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_start));
+        }
+    };
+
+    /**
+     * @brief Gets a histogram, creating it if needed.
+     *
+     * @param name Name.
+     * @return Histogram& Histogram, valid while the process runs.
+     */
+    Histogram& histogram(const std::string& name)
+    {
+        std::scoped_lock lock(m_mutex);
+        auto& histogram {m_histograms[name]};
+        if (!histogram)
+        {
+            histogram = std::make_unique<Histogram>();
+        }
+        return *histogram;
+    }
+
+    /**
+     * @brief Gets a counter, creating it if needed.
+     *
+     * @param name Name.
+     * @return std::atomic<uint64_t>& Counter, valid while the process runs.
+     */
+    std::atomic<uint64_t>& counter(const std::string& name)
+    {
+        std::scoped_lock lock(m_mutex);
+        auto& counter {m_counters[name]};
+        if (!counter)
+        {
+            counter = std::make_unique<std::atomic<uint64_t>>(0);
+        }
+        return *counter;
+    }
+
+    /**
+     * @brief Registers a gauge, replacing the previous one with the same name.
+     *
+     * @param name Name.
+     * @param sample Function that returns the current value. It's called while the metrics are dumped, so the gauge
+     * must be removed before the objects it reads are destroyed.
+     */
+    void gauge(const std::string& name, std::function<uint64_t()> sample)
+    {
+        std::scoped_lock lock(m_mutex);
+        m_gauges[name] = std::move(sample);
+    }
+
+    /**
+     * @brief Removes a gauge.
+     *
+     * @param name Name.
+     */
+    void removeGauge(const std::string& name)
+    {
+        std::scoped_lock lock(m_mutex);
+        m_gauges.erase(name);
+    }
+
+    /**
+     * @brief Dumps the metrics, sampling the gauges.
+     *
+     * @return nlohmann::json Object with the "histograms", "counters" and "gauges" by name.
+     */
+    nlohmann::json dump() const
+    {
+        std::scoped_lock lock(m_mutex);
+
+        nlohmann::json metrics;
+        metrics["histograms"] = nlohmann::json::object();
+        metrics["counters"] = nlohmann::json::object();
+        metrics["gauges"] = nlohmann::json::object();
+        for (const auto& [name, histogram] : m_histograms)
+        {
+            metrics["histograms"][name] = histogram->dump();
+        }
+        for (const auto& [name, counter] : m_counters)
+        {
+            metrics["counters"][name] = counter->load(std::memory_order_relaxed);
+        }
+        for (const auto& [name, sample] : m_gauges)
+        {
+            try
+            {
+                metrics["gauges"][name] = sample();
+            }
+            catch (const std::exception&)
+            {
+                // The gauge can't be sampled now, e.g. its queue is being destroyed.
+            }
+        }
+        return metrics;
+    }
+
+    /**
+     * @brief Clears the histograms and the counters, keeping them and the gauges registered.
+     */
+    void reset()
+    {
+        std::scoped_lock lock(m_mutex);
+        for (auto& [name, histogram] : m_histograms)
+        {
+            histogram->reset();
+        }
+        for (auto& [name, counter] : m_counters)
+        {
+            counter->store(0, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    mutable std::mutex m_mutex;
+    std::map<std::string, std::unique_ptr<Histogram>> m_histograms;
+    std::map<std::string, std::unique_ptr<std::atomic<uint64_t>>> m_counters;
+    std::map<std::string, std::function<uint64_t()>> m_gauges;
+};
+
+#endif // _SCANNER_METRICS_HPP
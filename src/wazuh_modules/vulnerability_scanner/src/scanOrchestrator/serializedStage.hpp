@@ -0,0 +1,76 @@
+/*
+ * Wazuh Vulnerability scanner - Scan Orchestrator
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _SERIALIZED_STAGE_HPP
+#define _SERIALIZED_STAGE_HPP
+
+#include "chainOfResponsability.hpp"
+#include "scanContext.hpp"
+#include <memory>
+#include <mutex>
+
+/**
+ * @brief SerializedStage class.
+ *
+ * @details Runs a single step of the chain under a mutex shared with other stages, and then passes control to the next
+ * step without holding it. It's used by the chains that are executed concurrently for many agents, so only the steps
+ * that write shared state (the inventory and the indexer queue) are serialized while the rest runs in parallel.
+ *
+ * @tparam TScanContext scan context type.
+ */
+template<typename TScanContext = ScanContext>
+class TSerializedStage final : public AbstractHandler<std::shared_ptr<TScanContext>>
+{
+private:
+    std::shared_ptr<std::mutex> m_mutex;
+    std::shared_ptr<AbstractHandler<std::shared_ptr<TScanContext>>> m_stage;
+
+public:
+    // LCOV_EXCL_START
+    /**
+     * @brief Class constructor.
+     *
+     * @param mutex Mutex shared by the serialized stages.
+     * @param stage Step of the chain to serialize, it shouldn't have a next step.
+     */
+    explicit TSerializedStage(std::shared_ptr<std::mutex> mutex,
+                              std::shared_ptr<AbstractHandler<std::shared_ptr<TScanContext>>> stage)
+        : m_mutex(std::move(mutex))
+        , m_stage(std::move(stage))
+    {
+    }
+    // LCOV_EXCL_STOP
+
+    /**
+     * @brief Handles request and passes control to the next step of the chain.
+     *
+     * @param data Scan context.
+     * @return std::shared_ptr<TScanContext> Abstract handler.
+     */
+    std::shared_ptr<TScanContext> handleRequest(std::shared_ptr<TScanContext> data) override
+    {
+        {
+            std::scoped_lock lock(*m_mutex);
+            data = m_stage->handleRequest(std::move(data));
+        }
+
+        // The stage stopped the chain.
+        if (!data)
+        {
+            return nullptr;
+        }
+        return AbstractHandler<std::shared_ptr<TScanContext>>::handleRequest(std::move(data));
+    }
+};
+
+using SerializedStage = TSerializedStage<>;
+
+#endif // _SERIALIZED_STAGE_HPP
@@ -0,0 +1,76 @@
+/*
+ * Wazuh Vulnerability scanner - Scan Orchestrator
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _TIMED_STAGE_HPP
+#define _TIMED_STAGE_HPP
+
+#include "chainOfResponsability.hpp"
+#include "scanContext.hpp"
+#include "scannerMetrics.hpp"
+#include <memory>
+#include <string>
+
+/**
+ * @brief TimedStage class.
+ *
+ * @details Runs a single step of the chain, recording its duration in a histogram of the scanner metrics, and then
+ * passes control to the next step. Only the step is timed, not the rest of the chain, although a step that runs
+ * sub-chains (e.g. the scan of an agent list) includes them.
+ *
+ * @tparam TScanContext scan context type.
+ */
+template<typename TScanContext = ScanContext>
+class TTimedStage final : public AbstractHandler<std::shared_ptr<TScanContext>>
+{
+private:
+    ScannerMetrics::Histogram& m_histogram;
+    std::shared_ptr<AbstractHandler<std::shared_ptr<TScanContext>>> m_stage;
+
+public:
+    // LCOV_EXCL_START
+    /**
+     * @brief Class constructor.
+     *
+     * @param name Name of the histogram.
+     * @param stage Step of the chain to time, it shouldn't have a next step.
+     */
+    explicit TTimedStage(const std::string& name, std::shared_ptr<AbstractHandler<std::shared_ptr<TScanContext>>> stage)
+        : m_histogram(ScannerMetrics::instance().histogram(name))
+        , m_stage(std::move(stage))
+    {
+    }
+    // LCOV_EXCL_STOP
+
+    /**
+     * @brief Handles request and passes control to the next step of the chain.
+     *
+     * @param data Scan context.
+     * @return std::shared_ptr<TScanContext> Abstract handler.
+     */
+    std::shared_ptr<TScanContext> handleRequest(std::shared_ptr<TScanContext> data) override
+    {
+        {
+            const ScannerMetrics::Timer timer(m_histogram);
+            data = m_stage->handleRequest(std::move(data));
+        }
+
+        // The stage stopped the chain.
+        if (!data)
+        {
+            return nullptr;
+        }
+        return AbstractHandler<std::shared_ptr<TScanContext>>::handleRequest(std::move(data));
+    }
+};
+
+using TimedStage = TTimedStage<>;
+
+#endif // _TIMED_STAGE_HPP
@@ -0,0 +1,180 @@
+/*
+ * Wazuh Vulnerability scanner - Scan Orchestrator
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _VERSION_INTERVAL_INDEX_HPP
+#define _VERSION_INTERVAL_INDEX_HPP
+
+#include "versionMatcher.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @brief VersionIntervalIndex class.
+ *
+ * @details Index of version intervals that finds, with a single binary search, the intervals that contain a version.
+ * The endpoints of the intervals split the versions into elementary regions (each endpoint and the gaps between
+ * consecutive endpoints), and each region keeps the intervals that cover it.
+ *
+ * All the endpoints must have the same version type: The first version accepted fixes the type of the index.
+ */
+class VersionIntervalIndex final
+{
+    struct Interval
+    {
+        std::optional<VersionMatcher::ParsedVersion> lower;
+        std::optional<VersionMatcher::ParsedVersion> upper;
+        bool upperInclusive;
+        size_t id;
+    };
+
+    std::optional<VersionObjectType> m_type;
+    std::vector<Interval> m_intervals;
+    std::vector<VersionMatcher::ParsedVersion> m_points;
+    std::vector<std::vector<size_t>> m_regions {1};
+    bool m_built {false};
+
+    static bool less(const VersionMatcher::ParsedVersion& versionA, const VersionMatcher::ParsedVersion& versionB)
+    {
+        return VersionMatcher::compare(versionA, versionB) == VersionComparisonResult::A_LESS_THAN_B;
+    }
+
+    /**
+     * @brief Region of a version: 2 * i + 1 if it's the endpoint i, 2 * i if it's between the endpoints i - 1 and i.
+     */
+    size_t region(const VersionMatcher::ParsedVersion& version) const
+    {
+        const auto it {std::lower_bound(m_points.begin(), m_points.end(), version, less)};
+        const auto index {static_cast<size_t>(std::distance(m_points.begin(), it))};
+        if (it != m_points.end() && !less(version, *it))
+        {
+            return 2 * index + 1;
+        }
+        return 2 * index;
+    }
+
+public:
+    /**
+     * @brief Checks whether a version can be an endpoint of the index.
+     *
+     * @param version Parsed version.
+     * @return true If the version is valid and it has the type of the index.
+     */
+    bool accepts(const VersionMatcher::ParsedVersion& version)
+    {
+        const auto type {version.type()};
+        if (!type.has_value())
+        {
+            return false;
+        }
+        if (!m_type.has_value())
+        {
+            m_type = type;
+        }
+        return m_type == type;
+    }
+
+    /**
+     * @brief Adds an interval. The endpoints must be accepted.
+     *
+     * @param id Interval identifier, returned by find().
+     * @param lower Inclusive lower endpoint, unbounded if empty.
+     * @param upper Upper endpoint, unbounded if empty.
+     * @param upperInclusive Whether the upper endpoint belongs to the interval.
+     */
+    void addRange(const size_t id,
+                  std::optional<VersionMatcher::ParsedVersion> lower,
+                  std::optional<VersionMatcher::ParsedVersion> upper,
+                  const bool upperInclusive)
+    {
+        if (m_built)
+        {
+            throw std::logic_error("The version interval index is already built.");
+        }
+        m_intervals.push_back({std::move(lower), std::move(upper), upperInclusive, id});
+    }
+
+    /**
+     * @brief Adds an interval with a single version. The version must be accepted.
+     *
+     * @param id Interval identifier, returned by find().
+     * @param version Version.
+     */
+    void addExact(const size_t id, const VersionMatcher::ParsedVersion& version)
+    {
+        addRange(id, version, version, true);
+    }
+
+    /**
+     * @brief Builds the index. No intervals can be added afterwards.
+     */
+    void build()
+    {
+        for (const auto& interval : m_intervals)
+        {
+            for (const auto& endpoint : {interval.lower, interval.upper})
+            {
+                if (endpoint.has_value())
+                {
+                    m_points.push_back(endpoint.value());
+                }
+            }
+        }
+        std::sort(m_points.begin(), m_points.end(), less);
+        m_points.erase(std::unique(m_points.begin(),
+                                   m_points.end(),
+                                   [](const auto& versionA, const auto& versionB)
+                                   { return !less(versionA, versionB) && !less(versionB, versionA); }),
+                       m_points.end());
+
+        m_regions.assign(2 * m_points.size() + 1, {});
+        for (const auto& interval : m_intervals)
+        {
+            const auto first {interval.lower.has_value() ? region(interval.lower.value()) : 0};
+            auto last {m_regions.size() - 1};
+            if (interval.upper.has_value())
+            {
+                // The region of an endpoint is odd, the gap before it is the previous region.
+                last = region(interval.upper.value()) - (interval.upperInclusive ? 0 : 1);
+            }
+
+            for (auto index {first}; index <= last && index < m_regions.size(); ++index)
+            {
+                m_regions[index].push_back(interval.id);
+            }
+        }
+
+        m_intervals.clear();
+        m_intervals.shrink_to_fit();
+        m_built = true;
+    }
+
+    /**
+     * @brief Finds the intervals that contain a version.
+     *
+     * @param version Parsed version.
+     * @return const std::vector<size_t>* Identifiers of the intervals, in insertion order. nullptr if the version
+     * can't be compared with the endpoints of the index.
+     */
+    const std::vector<size_t>* find(const VersionMatcher::ParsedVersion& version) const
+    {
+        const auto type {version.type()};
+        if (!type.has_value() || (m_type.has_value() && m_type != type))
+        {
+            return nullptr;
+        }
+        return &m_regions[region(version)];
+    }
+};
+
+#endif // _VERSION_INTERVAL_INDEX_HPP
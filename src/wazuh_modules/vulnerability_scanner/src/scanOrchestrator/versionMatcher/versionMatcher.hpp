@@ -22,8 +22,10 @@
 #include "versionObjectSemVer.hpp"
 #include "vulnerabilityScannerDefs.hpp"
 #include <memory>
+#include <optional>
 #include <stdexcept>
 #include <string>
+#include <unordered_map>
 #include <variant>
 
 enum class VersionComparisonResult : int
@@ -253,20 +255,108 @@ private:
 
 public:
     /**
-     * @brief Compares 2 version strings.
+     * @brief Version string parsed once, to be compared many times.
+     */
+    class ParsedVersion final
+    {
+        friend class VersionMatcher;
+
+        std::string m_version;
+        std::shared_ptr<IVersionObject> m_object;
+
+    public:
+        /**
+         * @brief Version string.
+         *
+         * @return const std::string& Version.
+         */
+        const std::string& str() const
+        {
+            return m_version;
+        }
+
+        /**
+         * @brief Type of the parsed version.
+         *
+         * @return std::optional<VersionObjectType> Type, empty if the version doesn't match the type it was parsed
+         * with.
+         */
+        std::optional<VersionObjectType> type() const
+        {
+            if (!m_object)
+            {
+                return std::nullopt;
+            }
+            return m_object->getType();
+        }
+    };
+
+    /**
+     * @brief Parsed versions of a scan, keyed by the version string. Each version is parsed the first time it's
+     * compared.
+     */
+    class ParsedVersions final
+    {
+        std::variant<VersionObjectType, VersionMatcherStrategy> m_type;
+        std::unordered_map<std::string, ParsedVersion> m_versions;
+
+    public:
+        /**
+         * @brief Class constructor.
+         *
+         * @param type Version object or matcher strategy used to parse the versions.
+         */
+        explicit ParsedVersions(std::variant<VersionObjectType, VersionMatcherStrategy> type)
+            : m_type(type)
+        {
+        }
+
+        /**
+         * @brief Gets a parsed version, parsing it if needed.
+         *
+         * @param version Version string.
+         * @return const ParsedVersion& Parsed version.
+         */
+        const ParsedVersion& get(const std::string& version)
+        {
+            if (const auto it {m_versions.find(version)}; it != m_versions.end())
+            {
+                return it->second;
+            }
+            return m_versions.emplace(version, VersionMatcher::parse(version, m_type)).first->second;
+        }
+    };
+
+    /**
+     * @brief Parses a version string, so it can be compared without parsing it again.
      *
-     * @param versionA string version item A to compare
-     * @param versionB string version item B to compare
-     * @param type Version object or matcher strategy to compare A and B.
+     * @note A version that doesn't match the type is returned too: Comparing it throws.
+     *
+     * @param version Version string.
+     * @param type Version object or matcher strategy.
+     * @return ParsedVersion Parsed version.
+     */
+    static ParsedVersion
+    parse(const std::string& version,
+          std::variant<VersionObjectType, VersionMatcherStrategy> type = VersionMatcherStrategy::Unspecified)
+    {
+        ParsedVersion parsedVersion;
+        parsedVersion.m_version = version;
+        parsedVersion.m_object = createVersionObject(version, type);
+        return parsedVersion;
+    }
+
+    /**
+     * @brief Compares 2 parsed versions.
+     *
+     * @param versionA Parsed version A to compare.
+     * @param versionB Parsed version B to compare.
      * @return VersionComparisonResult result of the comparison.
      */
-    static VersionComparisonResult
-    compare(const std::string& versionA,
-            const std::string& versionB,
-            std::variant<VersionObjectType, VersionMatcherStrategy> type = VersionMatcherStrategy::Unspecified)
+    static VersionComparisonResult compare(const ParsedVersion& versionA, const ParsedVersion& versionB)
     {
-        auto pVersionObjectA = createVersionObject(versionA, type);
-        auto pVersionObjectB = createVersionObject(versionB, type);
+        const auto& pVersionObjectA = versionA.m_object;
+        const auto& pVersionObjectB = versionB.m_object;
 
         if (pVersionObjectA && pVersionObjectB && pVersionObjectA->getType() == pVersionObjectB->getType())
         {
@@ -285,7 +375,23 @@ public:
             }
         }
 
-        throw std::invalid_argument("Unable to compare versions (" + versionA + " vs " + versionB + ").");
+        throw std::invalid_argument("Unable to compare versions (" + versionA.str() + " vs " + versionB.str() + ").");
+    }
+
+    /**
+     * @brief Compares 2 version strings.
+     *
+     * @param versionA string version item A to compare
+     * @param versionB string version item B to compare
+     * @param type Version object or matcher strategy to compare A and B.
+     * @return VersionComparisonResult result of the comparison.
+     */
+    static VersionComparisonResult
+    compare(const std::string& versionA,
+            const std::string& versionB,
+            std::variant<VersionObjectType, VersionMatcherStrategy> type = VersionMatcherStrategy::Unspecified)
+    {
+        return compare(parse(versionA, type), parse(versionB, type));
     }
 
     /**
@@ -15,10 +15,13 @@
 #include "defs.h"
 #include "loggerHelper.h"
 #include "messageBuffer_generated.h"
+#include "packageAgentsIndex.hpp"
 #include "scanOrchestrator.hpp"
+#include "scannerMetrics.hpp"
 #include "wazuh_modules/vulnerability_scanner/src/policyManager/policyManager.hpp"
 #include "wdbDataException.hpp"
 #include "xzHelper.hpp"
+#include <fstream>
 #include <string>
 
 constexpr auto DEFAULT_QUEUE_PATH = "queue/sockets/queue";
@@ -41,6 +44,11 @@ constexpr auto CLUSTER_NODE_NAME_KEY {"cluster_node_name"};
 constexpr auto CLUSTER_STATE_KEY {"cluster_previous_state"};
 constexpr auto DISABLED {"disabled"};
 constexpr auto ENABLED {"enabled"};
+constexpr auto VD_METRICS_PATH {"queue/vd/metrics.json"};
+constexpr auto VD_METRICS_TMP_PATH {"queue/vd/metrics.json.tmp"};
+constexpr auto METRICS_INTERVAL {std::chrono::seconds(5)};
+constexpr auto EVENTS_QUEUE_GAUGE {"queue.events"};
+constexpr auto REPORTS_QUEUE_GAUGE {"queue.reports"};
 
 bool VulnerabilityScannerFacade::decompressDatabase(std::string_view databaseVersion) const
 {
@@ -149,8 +157,10 @@ void VulnerabilityScannerFacade::initEventDispatcher()
 
     m_eventDispatcher->startWorker(
         // coverity[copy_constructor_call]
-        [scanOrchestrator](std::queue<rocksdb::PinnableSlice>& dataQueue)
+        [scanOrchestrator, eventCoalescer = m_eventCoalescer](std::vector<rocksdb::PinnableSlice>& data)
         {
+            static auto& coalesced {ScannerMetrics::instance().counter("events.coalesced")};
+
             const auto parseEventMessage = [](const rocksdb::PinnableSlice& element) -> std::string
             {
                 if (const auto eventMessageBuffer = GetMessageBuffer(element.data()); eventMessageBuffer)
@@ -161,12 +171,18 @@ void VulnerabilityScannerFacade::initEventDispatcher()
                 return "unable to parse";
             };
 
-            const auto& element = dataQueue.front();
+            const auto& element = data.front();
             try
             {
                 if (flatbuffers::Verifier verifier(reinterpret_cast<const uint8_t*>(element.data()), element.size());
                     VerifyMessageBufferBuffer(verifier))
                 {
+                    // Only the last pending event of each package is scanned.
+                    if (eventCoalescer->superseded(EventCoalescer::key(GetMessageBuffer(element.data()))))
+                    {
+                        coalesced.fetch_add(1, std::memory_order_relaxed);
+                        return;
+                    }
                     scanOrchestrator->processEvent(element);
                 }
             }
@@ -200,6 +216,48 @@ void VulnerabilityScannerFacade::initEventDispatcher()
         });
 }
 
+void VulnerabilityScannerFacade::initMetricsExport()
+{
+    auto& metrics = ScannerMetrics::instance();
+    metrics.gauge(EVENTS_QUEUE_GAUGE, [this]() { return m_eventDispatcher->size(); });
+    metrics.gauge(REPORTS_QUEUE_GAUGE, [this]() { return m_reportDispatcher->size(); });
+
+    m_stopMetrics.store(false);
+    m_metricsThread = std::thread(
+        [this]()
+        {
+            std::unique_lock lock(m_metricsMutex);
+            while (!m_metricsWait.wait_for(lock, METRICS_INTERVAL, [this]() { return m_stopMetrics.load(); }))
+            {
+                writeMetrics();
+            }
+        });
+}
+
+void VulnerabilityScannerFacade::writeMetrics() const
+{
+    try
+    {
+        auto metrics = ScannerMetrics::instance().dump();
+        metrics["timestamp"] = getSecondsFromEpoch();
+
+        // The file is replaced at once, so it's never read half written.
+        {
+            std::ofstream file(VD_METRICS_TMP_PATH, std::ios::trunc);
+            file << metrics.dump();
+            if (!file)
+            {
+                throw std::runtime_error("Unable to write " + std::string(VD_METRICS_TMP_PATH));
+            }
+        }
+        std::filesystem::rename(VD_METRICS_TMP_PATH, VD_METRICS_PATH);
+    }
+    catch (const std::exception& e)
+    {
+        logDebug2(WM_VULNSCAN_LOGTAG, "Unable to write the scanner metrics. Reason: %s.", e.what());
+    }
+}
+
 /**
  * @brief Start the deltas subscription
  *
@@ -431,6 +489,7 @@ void VulnerabilityScannerFacade::start(
         // Socket client initialization to send vulnerability reports.
         initAlertReportDispatcher();
 
+        m_eventCoalescer = std::make_shared<EventCoalescer>();
         m_eventDispatcher = std::make_shared<EventDispatcher>(EVENTS_QUEUE_PATH, EVENTS_BULK_SIZE);
 
         // Checks for the actions to be performed after the policy change (vulnerability scanner).
@@ -463,6 +522,14 @@ void VulnerabilityScannerFacade::start(
             logDebug1(WM_VULNSCAN_LOGTAG, "Updated %s key of %s.", VD_DATABASE_VERSION_KEY, VD_STATE_QUEUE_PATH);
         }
 
+        // In a cluster, the feed may be updated only by the master node, and imported by the workers.
+        auto feedDistributionRole {FeedDistributionRole::NONE};
+        if (policyManager.isFeedDistributionEnabled())
+        {
+            feedDistributionRole = policyManager.isFeedDistributionWorker() ? FeedDistributionRole::WORKER
+                                                                            : FeedDistributionRole::MASTER;
+        }
+
         // Database feed manager initialization.
         m_databaseFeedManager = std::make_shared<DatabaseFeedManager>(
             m_indexerConnector,
@@ -471,23 +538,52 @@ void VulnerabilityScannerFacade::start(
             true,
             reloadGlobalMapsStartup,
             initContentUpdater,
-            [this, reloadGlobalMapsStartup]()
+            [this, reloadGlobalMapsStartup](const FeedDelta& feedDelta)
             {
-                // Re-scan all agent after content update, only if is an instance of vulnerability scanner.
+                // Re-scan the agents after content update, only if is an instance of vulnerability scanner.
                 if (reloadGlobalMapsStartup)
                 {
-                    nlohmann::json actionData;
-                    actionData["action"] = "reboot";
+                    const auto pushActionData = [this](const nlohmann::json& actionData)
+                    {
+                        const std::string actionDataString = actionData.dump();
+                        const std::vector<char> actionMessage(actionDataString.begin(), actionDataString.end());
+
+                        pushEvent(actionMessage, BufferType::BufferType_JSON);
+                    };
+
                     // We shouldn't index if we are in a cluster environment
-                    actionData["no-index"] = PolicyManager::instance().getClusterStatus();
+                    const auto noIndex {PolicyManager::instance().getClusterStatus()};
+
+                    // If only the candidates of some packages changed, only the agents that scanned them are
+                    // rescanned. The index of the scanned packages is incomplete until all the agents are rescanned.
+                    std::vector<std::string> agentIds;
+                    if (!feedDelta.full() && PackageAgentsIndex::instance().agents(feedDelta.candidates(), agentIds))
+                    {
+                        for (const auto& agentId : agentIds)
+                        {
+                            nlohmann::json actionData;
+                            actionData["action"] = "scanAgent";
+                            actionData["agent_info"]["agent_id"] = agentId;
+                            actionData["no-index"] = noIndex;
+
+                            pushActionData(actionData);
+                        }
+                        logInfo(WM_VULNSCAN_LOGTAG,
+                                "Triggered a re-scan of %zu agents after content update (%zu packages changed).",
+                                agentIds.size(),
+                                feedDelta.candidates().size());
+                        return;
+                    }
 
-                    const std::string actionDataString = actionData.dump();
-                    const std::vector<char> actionMessage(actionDataString.begin(), actionDataString.end());
+                    nlohmann::json actionData;
+                    actionData["action"] = "reboot";
+                    actionData["no-index"] = noIndex;
 
-                    pushEvent(actionMessage, BufferType::BufferType_JSON);
+                    pushActionData(actionData);
                     logInfo(WM_VULNSCAN_LOGTAG, "Triggered a re-scan after content update.");
                 }
-            });
+            },
+            feedDistributionRole);
 
         // Add subscribers for policy updates.
         policyManager.addSubscriber(m_databaseFeedManager);
@@ -495,6 +591,9 @@ void VulnerabilityScannerFacade::start(
         // Event dispatcher initialization.
         initEventDispatcher();
 
+        // Metrics state file, with the latencies of the scans and the queue depths.
+        initMetricsExport();
+
         logInfo(WM_VULNSCAN_LOGTAG, "Vulnerability scanner module started.");
     }
     catch (const std::exception& e)
@@ -518,6 +617,12 @@ void VulnerabilityScannerFacade::stop()
 
     m_retryWait.notify_all();
 
+    {
+        std::scoped_lock lock(m_metricsMutex);
+        m_stopMetrics.store(true);
+    }
+    m_metricsWait.notify_all();
+
     // Threads join
     if (m_rebootThread.joinable())
     {
@@ -529,6 +634,13 @@ void VulnerabilityScannerFacade::stop()
         m_managerThread.join();
     }
 
+    if (m_metricsThread.joinable())
+    {
+        m_metricsThread.join();
+    }
+    ScannerMetrics::instance().removeGauge(EVENTS_QUEUE_GAUGE);
+    ScannerMetrics::instance().removeGauge(REPORTS_QUEUE_GAUGE);
+
     // Reset shared pointers
     m_indexerConnector.reset();
     m_databaseFeedManager.reset();
@@ -540,6 +652,7 @@ void VulnerabilityScannerFacade::stop()
     PolicyManager::instance().teardown();
     m_reportDispatcher.reset();
     m_eventDispatcher.reset();
+    m_eventCoalescer.reset();
 
     // Destroy socketDbWrapper
     SocketDBWrapper::instance().teardown();
@@ -17,6 +17,7 @@
 #include "messageBuffer_generated.h"
 #include "policyManager/policyManager.hpp"
 #include "routerSubscriber.hpp"
+#include "scanOrchestrator/eventCoalescer.hpp"
 #include "scanOrchestrator/scanOrchestrator.hpp"
 #include "singleton.hpp"
 #include "socketClient.hpp"
@@ -144,6 +145,10 @@ public:
         auto bufferData = reinterpret_cast<const char*>(builder.GetBufferPointer());
         size_t bufferSize = builder.GetSize();
         const rocksdb::Slice messageSlice(bufferData, bufferSize);
+
+        // Counted before it's queued, so the worker never dequeues an event that isn't counted yet.
+        m_eventCoalescer->pushed(
+            EventCoalescer::key(type, reinterpret_cast<const int8_t*>(message.data()), message.size()));
         m_eventDispatcher->push(messageSlice);
     }
 
@@ -224,6 +229,19 @@ private:
     };
 
     void processEvent(ScanOrchestrator& scanOrchestrator, const MessageBuffer* message) const;
+
+    /**
+     * @brief Starts the thread that periodically writes the scanner metrics to the metrics state file.
+     *
+     */
+    void initMetricsExport();
+
+    /**
+     * @brief Writes the scanner metrics to the metrics state file, replacing it.
+     *
+     */
+    void writeMetrics() const;
+
     std::unique_ptr<RouterSubscriber> m_syscollectorDeltasSubscription;
     std::unique_ptr<RouterSubscriber> m_syscollectorRsyncSubscription;
     std::unique_ptr<RouterSubscriber> m_wdbAgentEventsSubscription;
@@ -234,14 +252,19 @@ private:
     std::shared_ptr<ReportDispatcher> m_reportDispatcher;
     std::thread m_rebootThread;
     std::thread m_managerThread;
+    std::thread m_metricsThread;
     std::atomic<bool> m_shouldStop {false};
     mutable ActionWrapper m_agentsAction;
     mutable ActionWrapper m_managerAction;
     bool m_noWaitToStop {true};
     std::shared_ptr<EventDispatcher> m_eventDispatcher;
+    std::shared_ptr<EventCoalescer> m_eventCoalescer;
     std::shared_mutex m_internalMutex;
     std::condition_variable m_retryWait;
     std::mutex m_retryMutex;
+    std::atomic<bool> m_stopMetrics {false};
+    std::condition_variable m_metricsWait;
+    std::mutex m_metricsMutex;
 };
 
 #endif // _VULNERABILITY_SCANNER_FACADE_HPP
@@ -0,0 +1,156 @@
+/*
+ * Wazuh Vulnerability Scanner - Benchmark
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "feedSnapshot.hpp"
+#include <benchmark/benchmark.h>
+
+constexpr size_t LOOKUP_PACKAGES {2000};
+constexpr size_t TRANSLATION_PACKAGES {1000};
+constexpr int TRANSLATION_PROBABILITY_TRANSLATED {10};
+
+/**
+ * @brief FeedLookupPerformanceFixture class.
+ *
+ */
+class FeedLookupPerformanceFixture : public benchmark::Fixture
+{
+public:
+    std::unique_ptr<FeedSnapshot> snapshot; ///< Feed snapshot.
+    std::vector<PackageData> packages;      ///< Packages looked up.
+    size_t currentIdx;                      ///< Current index of container
+
+    /**
+     * @brief Benchmark setup routine.
+     *
+     * @param state Benchmark state.
+     */
+    void SetUp(const ::benchmark::State& state) override
+    {
+        snapshot = std::make_unique<FeedSnapshot>();
+        packages = FeedSnapshot::agentPackages(LOOKUP_PACKAGES);
+        currentIdx = 0;
+    }
+
+    /**
+     * @brief Benchmark teardown routine.
+     *
+     * @param state Benchmark state.
+     */
+    void TearDown(const ::benchmark::State& state) override
+    {
+        packages.clear();
+        snapshot.reset();
+    }
+};
+
+BENCHMARK_DEFINE_F(FeedLookupPerformanceFixture, VulnerabilitiesCandidatesPerformance)(benchmark::State& state)
+{
+    size_t candidates {0};
+    for (auto _ : state)
+    {
+        snapshot->feedManager()->getVulnerabilitiesCandidates(
+            SNAPSHOT_CNA_NAME,
+            packages[currentIdx],
+            [&](const std::string&, const PackageData&, const NSVulnerabilityScanner::ScanVulnerabilityCandidate&)
+            {
+                ++candidates;
+                return false;
+            });
+        if (++currentIdx >= LOOKUP_PACKAGES)
+        {
+            currentIdx = 0;
+        }
+    }
+    state.counters["candidates"] = benchmark::Counter(candidates, benchmark::Counter::kAvgIterations);
+}
+
+/**
+ * @brief TranslationPerformanceFixture class.
+ *
+ */
+class TranslationPerformanceFixture : public benchmark::Fixture
+{
+public:
+    std::unique_ptr<FeedSnapshot> snapshot; ///< Feed snapshot.
+    std::vector<PackageData> packages;      ///< Packages translated.
+    size_t currentIdx;                      ///< Current index of container
+
+    /**
+     * @brief Benchmark setup routine.
+     *
+     * @param state Benchmark state.
+     */
+    void SetUp(const ::benchmark::State& state) override
+    {
+        snapshot = std::make_unique<FeedSnapshot>();
+
+        // A part of the packages have a translation, the rest are looked up in the caches and discarded.
+        packages.resize(TRANSLATION_PACKAGES);
+        for (size_t i = 0; i < TRANSLATION_PACKAGES; ++i)
+        {
+            const auto translated {(std::rand() % 100) < TRANSLATION_PROBABILITY_TRANSLATED};
+            const auto product {std::rand() % SNAPSHOT_TRANSLATIONS};
+            packages[i] = PackageData {
+                .name = (translated ? "Bench Product " : "Other Product ") + std::to_string(product) + " 1.2",
+                .vendor = "Bench Corporation",
+                .format = "win",
+                .version = "1.2." + std::to_string(i)};
+        }
+        currentIdx = 0;
+    }
+
+    /**
+     * @brief Benchmark teardown routine.
+     *
+     * @param state Benchmark state.
+     */
+    void TearDown(const ::benchmark::State& state) override
+    {
+        packages.clear();
+        snapshot.reset();
+    }
+};
+
+BENCHMARK_DEFINE_F(TranslationPerformanceFixture, TranslationCachePerformance)(benchmark::State& state)
+{
+    // The first lookups fill the caches, the measured ones are served from them.
+    for (const auto& package : packages)
+    {
+        snapshot->feedManager()->checkAndTranslatePackage(package, "windows");
+    }
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(snapshot->feedManager()->checkAndTranslatePackage(packages[currentIdx], "windows"));
+        if (++currentIdx >= TRANSLATION_PACKAGES)
+        {
+            currentIdx = 0;
+        }
+    }
+}
+
+BENCHMARK_DEFINE_F(TranslationPerformanceFixture, TranslationL2Performance)(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(snapshot->feedManager()->getTranslationFromL2(packages[currentIdx], "windows"));
+        if (++currentIdx >= TRANSLATION_PACKAGES)
+        {
+            currentIdx = 0;
+        }
+    }
+}
+
+BENCHMARK_REGISTER_F(FeedLookupPerformanceFixture, VulnerabilitiesCandidatesPerformance)
+    ->Iterations(100000)
+    ->Threads(1);
+BENCHMARK_REGISTER_F(TranslationPerformanceFixture, TranslationCachePerformance)->Iterations(100000)->Threads(1);
+BENCHMARK_REGISTER_F(TranslationPerformanceFixture, TranslationL2Performance)->Iterations(1000)->Threads(1);
@@ -0,0 +1,360 @@
+/*
+ * Wazuh Vulnerability Scanner - Benchmark
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _FEED_SNAPSHOT_HPP
+#define _FEED_SNAPSHOT_HPP
+
+#include "../../../../shared_modules/utils/flatbuffers/include/syscollector_deltas_generated.h"
+#include "../../../../shared_modules/utils/flatbuffers/include/syscollector_deltas_schema.h"
+#include "databaseFeedManager.hpp"
+#include "flatbuffers/flatbuffer_builder.h"
+#include "flatbuffers/idl.h"
+#include "json.hpp"
+#include "packageTranslation_generated.h"
+#include "policyManager.hpp"
+#include "rocksDBWrapper.hpp"
+#include "scanOrchestrator/osDataCache.hpp"
+#include <atomic>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+constexpr auto SNAPSHOT_DATABASE_DIR {"queue/vd"};
+constexpr auto SNAPSHOT_CNA_NAME {"canonical"};
+constexpr auto SNAPSHOT_AGENT_ID {"001"};
+constexpr auto SNAPSHOT_CODE_NAME {"jammy"};
+constexpr size_t SNAPSHOT_FEED_PACKAGES {20000};
+constexpr int SNAPSHOT_MAX_CVES_PER_PACKAGE {8};
+constexpr int SNAPSHOT_PROBABILITY_OTHER_PLATFORM {30};
+constexpr size_t SNAPSHOT_TRANSLATIONS {500};
+constexpr int SNAPSHOT_PROBABILITY_PACKAGE_IN_FEED {80};
+
+/**
+ * @brief Router subscriber that never receives content updates, the snapshot is not updated while it is measured.
+ */
+class BenchmarkRouterSubscriber final
+{
+public:
+    /**
+     * @brief Class constructor.
+     *
+     * @param topicName Name of the topic.
+     * @param subscriberId Subscriber ID.
+     * @param isLocal Local subscriber.
+     */
+    BenchmarkRouterSubscriber([[maybe_unused]] const std::string& topicName,
+                              [[maybe_unused]] const std::string& subscriberId,
+                              [[maybe_unused]] const bool isLocal = true)
+    {
+    }
+
+    /**
+     * @brief Subscribes to the topic, the callback is never called.
+     *
+     * @param callback Subscriber update callback.
+     */
+    void subscribe([[maybe_unused]] const std::function<void(const std::vector<char>&)>& callback) {}
+};
+
+using BenchmarkFeedManager =
+    TDatabaseFeedManager<IndexerConnector, PolicyManager, ContentRegister, BenchmarkRouterSubscriber>;
+
+/**
+ * @brief Synthetic feed, with the layout of the columns of the real one: Candidates of a CNA for many packages with
+ * several CVEs each, the descriptions of the CVEs, the translations and the global maps.
+ */
+class FeedSnapshot final
+{
+    std::atomic<bool> m_shouldStop {false};
+    std::shared_mutex m_mutex;
+    std::shared_ptr<BenchmarkFeedManager> m_feedManager;
+
+    /**
+     * @brief Name of a package of the feed.
+     *
+     * @param index Index of the package.
+     * @return std::string Package name.
+     */
+    static std::string packageName(const size_t index)
+    {
+        return "libbench" + std::to_string(index);
+    }
+
+    /**
+     * @brief Installed version of a package, the candidates of the feed are built around it.
+     *
+     * @param index Index of the package.
+     * @return std::string Package version.
+     */
+    static std::string packageVersion(const size_t index)
+    {
+        return std::to_string(index % 10) + "." + std::to_string(index % 20) + "." + std::to_string(index % 100) +
+               "-1ubuntu1";
+    }
+
+    static void createColumn(Utils::RocksDBWrapper& database, const std::string& column)
+    {
+        if (!database.columnExists(column))
+        {
+            database.createColumn(column);
+        }
+    }
+
+    static void putBuffer(Utils::RocksDBWrapper& database,
+                          const std::string& key,
+                          const flatbuffers::FlatBufferBuilder& builder,
+                          const std::string& column)
+    {
+        const rocksdb::Slice value(reinterpret_cast<const char*>(builder.GetBufferPointer()), builder.GetSize());
+        database.put(key, value, column);
+    }
+
+    static void writeCandidates(Utils::RocksDBWrapper& database)
+    {
+        size_t cveCount {0};
+        for (size_t i = 0; i < SNAPSHOT_FEED_PACKAGES; ++i)
+        {
+            const auto cves {(std::rand() % SNAPSHOT_MAX_CVES_PER_PACKAGE) + 1};
+            for (int j = 0; j < cves; ++j)
+            {
+                const auto cveId {"CVE-2024-" + std::to_string(10000 + cveCount++)};
+
+                // Fixed in a later revision or in a later patch, so a part of the packages is vulnerable.
+                const auto fixedVersion {std::to_string(i % 10) + "." + std::to_string(i % 20) + "." +
+                                         std::to_string((i % 100) + (std::rand() % 3)) + "-1ubuntu1"};
+
+                flatbuffers::FlatBufferBuilder builder;
+                std::vector<flatbuffers::Offset<NSVulnerabilityScanner::ScanVulnerabilityCandidate>> candidates;
+                for (const std::string codeName : {SNAPSHOT_CODE_NAME, "focal"})
+                {
+                    if (codeName != SNAPSHOT_CODE_NAME && (std::rand() % 100) >= SNAPSHOT_PROBABILITY_OTHER_PLATFORM)
+                    {
+                        continue;
+                    }
+
+                    std::vector<flatbuffers::Offset<flatbuffers::String>> platforms {builder.CreateString(codeName)};
+                    std::vector<flatbuffers::Offset<NSVulnerabilityScanner::Version>> versions {
+                        NSVulnerabilityScanner::CreateVersionDirect(builder,
+                                                                    NSVulnerabilityScanner::Status::Status_affected,
+                                                                    "0",
+                                                                    fixedVersion.c_str(),
+                                                                    nullptr,
+                                                                    "deb")};
+                    candidates.push_back(NSVulnerabilityScanner::CreateScanVulnerabilityCandidateDirect(
+                        builder,
+                        cveId.c_str(),
+                        NSVulnerabilityScanner::Status::Status_unaffected,
+                        &platforms,
+                        &versions));
+                }
+                builder.Finish(NSVulnerabilityScanner::CreateScanVulnerabilityCandidateArrayDirect(builder, &candidates));
+                putBuffer(database, packageName(i) + "_" + cveId, builder, SNAPSHOT_CNA_NAME);
+
+                flatbuffers::FlatBufferBuilder descriptionBuilder;
+                descriptionBuilder.Finish(NSVulnerabilityScanner::CreateVulnerabilityDescriptionDirect(
+                    descriptionBuilder,
+                    "LOW",
+                    "canonical",
+                    "NETWORK",
+                    "NONE",
+                    "HIGH",
+                    "CVSS",
+                    "HIGH",
+                    "CWE-787",
+                    "2024-01-01T00:00:00Z",
+                    "2024-02-01T00:00:00Z",
+                    "Out-of-bounds write in the parser of the benchmark library allows remote attackers to execute "
+                    "arbitrary code via a crafted file.",
+                    "HIGH",
+                    "NONE",
+                    "https://ubuntu.com/security/CVE",
+                    "UNCHANGED",
+                    7.5,
+                    "3.1",
+                    "high",
+                    "NONE"));
+                putBuffer(database, cveId, descriptionBuilder, DESCRIPTIONS_COLUMN);
+            }
+        }
+    }
+
+    static void writeTranslations(Utils::RocksDBWrapper& database)
+    {
+        for (size_t i = 0; i < SNAPSHOT_TRANSLATIONS; ++i)
+        {
+            const auto product {"^Bench Product " + std::to_string(i) + " ([0-9]+\\.*[0-9]*)"};
+            const auto translatedProduct {"bench_product_" + std::to_string(i)};
+
+            flatbuffers::FlatBufferBuilder builder;
+            const auto source {NSVulnerabilityScanner::CreateSourceFieldsDirect(
+                builder, "Bench Corporation", product.c_str(), product.c_str())};
+            std::vector<flatbuffers::Offset<flatbuffers::String>> target {builder.CreateString("windows")};
+            std::vector<flatbuffers::Offset<NSVulnerabilityScanner::TranslationFields>> translation {
+                NSVulnerabilityScanner::CreateTranslationFieldsDirect(builder, "bench", translatedProduct.c_str(), "")};
+            builder.Finish(
+                NSVulnerabilityScanner::CreateTranslationEntryDirect(builder, nullptr, source, &target, &translation));
+            putBuffer(database, "TID-" + std::to_string(i), builder, TRANSLATIONS_COLUMN);
+        }
+    }
+
+public:
+    /**
+     * @brief Writes the snapshot and opens the feed manager on it.
+     */
+    FeedSnapshot()
+    {
+        std::srand(0);
+        std::filesystem::remove_all(SNAPSHOT_DATABASE_DIR);
+        std::filesystem::create_directories(SNAPSHOT_DATABASE_DIR);
+
+        PolicyManager::instance().initialize(nlohmann::json::parse(R"({
+            "vulnerability-detection": {
+                "enabled": "yes",
+                "index-status": "yes",
+                "cti-url": "cti-url.com"
+            },
+            "osdataLRUSize": 1000,
+            "clusterName": "cluster01",
+            "clusterEnabled": true,
+            "clusterNodeName": "node01"
+        })"));
+
+        {
+            Utils::RocksDBWrapper database(DATABASE_PATH);
+            for (const auto& column : {std::string(SNAPSHOT_CNA_NAME),
+                                       std::string(DESCRIPTIONS_COLUMN),
+                                       std::string(REMEDIATIONS_COLUMN),
+                                       std::string(TRANSLATIONS_COLUMN),
+                                       std::string(VENDOR_MAP_COLUMN),
+                                       std::string(OS_CPE_RULES_COLUMN),
+                                       std::string(CNA_MAPPING_COLUMN)})
+            {
+                createColumn(database, column);
+            }
+
+            writeCandidates(database);
+            writeTranslations(database);
+
+            database.put("FEED-GLOBAL",
+                         R"({"prefix": [], "contains": [], "format": [{"deb": "canonical"}], "source": []})",
+                         VENDOR_MAP_COLUMN);
+            database.put("OSCPE-GLOBAL", "{}", OS_CPE_RULES_COLUMN);
+            database.put("CNA-MAPPING-GLOBAL",
+                         R"({"cnaMapping": {}, "platformEquivalence": {}, "majorVersionEquivalence": {}})",
+                         CNA_MAPPING_COLUMN);
+        }
+
+        m_feedManager = std::make_shared<BenchmarkFeedManager>(nullptr, m_shouldStop, m_mutex, true, true, false);
+
+        OsDataCache<>::instance().setOsData(SNAPSHOT_AGENT_ID,
+                                            Os {.hostName = "bench",
+                                                .architecture = "x86_64",
+                                                .name = "Ubuntu",
+                                                .codeName = SNAPSHOT_CODE_NAME,
+                                                .majorVersion = "22",
+                                                .minorVersion = "04",
+                                                .platform = "ubuntu",
+                                                .version = "22.04.4 LTS (Jammy Jellyfish)",
+                                                .sysName = "Linux",
+                                                .kernelRelease = "5.15.0-101-generic"});
+    }
+
+    ~FeedSnapshot()
+    {
+        m_feedManager.reset();
+        PolicyManager::instance().teardown();
+        std::filesystem::remove_all(SNAPSHOT_DATABASE_DIR);
+    }
+
+    FeedSnapshot(const FeedSnapshot&) = delete;
+    FeedSnapshot& operator=(const FeedSnapshot&) = delete;
+
+    /**
+     * @brief Feed manager opened on the snapshot.
+     *
+     * @return std::shared_ptr<BenchmarkFeedManager>& Feed manager.
+     */
+    std::shared_ptr<BenchmarkFeedManager>& feedManager()
+    {
+        return m_feedManager;
+    }
+
+    /**
+     * @brief Packages installed in a synthetic agent, most of them with candidates in the feed.
+     *
+     * @param count Number of packages.
+     * @return std::vector<PackageData> Packages.
+     */
+    static std::vector<PackageData> agentPackages(const size_t count)
+    {
+        std::vector<PackageData> packages;
+        packages.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            const auto index {static_cast<size_t>(std::rand()) % SNAPSHOT_FEED_PACKAGES};
+            const auto inFeed {(std::rand() % 100) < SNAPSHOT_PROBABILITY_PACKAGE_IN_FEED};
+            packages.push_back(PackageData {.name = inFeed ? packageName(index) : "libmissing" + std::to_string(i),
+                                            .vendor = "Ubuntu Developers <ubuntu-devel-discuss@lists.ubuntu.com>",
+                                            .format = "deb",
+                                            .version = packageVersion(index)});
+        }
+        return packages;
+    }
+
+    /**
+     * @brief Syscollector deltas of the packages of an agent, as received by the scanner.
+     *
+     * @param packages Packages.
+     * @return std::vector<std::vector<uint8_t>> Flatbuffers of the deltas.
+     */
+    static std::vector<std::vector<uint8_t>> packageDeltas(const std::vector<PackageData>& packages)
+    {
+        flatbuffers::Parser parser;
+        if (!parser.Parse(syscollector_deltas_SCHEMA))
+        {
+            throw std::runtime_error("Invalid syscollector deltas schema: " + parser.error_);
+        }
+
+        std::vector<std::vector<uint8_t>> deltas;
+        deltas.reserve(packages.size());
+        for (const auto& package : packages)
+        {
+            const nlohmann::json delta = {
+                {"agent_info", {{"agent_id", SNAPSHOT_AGENT_ID}, {"agent_ip", "10.0.0.1"}, {"agent_name", "bench"}}},
+                {"data_type", "dbsync_packages"},
+                {"data",
+                 {{"architecture", "amd64"},
+                  {"description", "Benchmark package"},
+                  {"format", package.format},
+                  {"name", package.name},
+                  {"size", 1024},
+                  {"vendor", package.vendor},
+                  {"version", package.version},
+                  {"install_time", "1577890801"}}},
+                {"operation", "INSERTED"}};
+
+            if (!parser.Parse(delta.dump().c_str()))
+            {
+                throw std::runtime_error("Invalid package delta: " + parser.error_);
+            }
+
+            const auto* buffer {parser.builder_.GetBufferPointer()};
+            deltas.emplace_back(buffer, buffer + parser.builder_.GetSize());
+        }
+        return deltas;
+    }
+};
+
+#endif // _FEED_SNAPSHOT_HPP
@@ -0,0 +1,159 @@
+/*
+ * Wazuh Vulnerability Scanner - Benchmark
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "feedSnapshot.hpp"
+#include "scanOrchestrator/eventDetailsBuilder.hpp"
+#include "scanOrchestrator/packageScanner.hpp"
+#include "scanOrchestrator/scanContext.hpp"
+#include <benchmark/benchmark.h>
+
+constexpr size_t DETAILS_PACKAGES {2000};
+
+using ScanContextVariant =
+    std::variant<const SyscollectorDeltas::Delta*, const SyscollectorSynchronization::SyncMsg*, const nlohmann::json*>;
+
+/**
+ * @brief PackageScannerPerformanceFixture class.
+ *
+ * @note The argument of the benchmark is the number of packages of the agent scanned in each iteration.
+ */
+class PackageScannerPerformanceFixture : public benchmark::Fixture
+{
+public:
+    std::unique_ptr<FeedSnapshot> snapshot;                          ///< Feed snapshot.
+    std::unique_ptr<TPackageScanner<BenchmarkFeedManager>> scanner; ///< Package scanner.
+    std::vector<std::vector<uint8_t>> deltas;                        ///< Package deltas of the agent.
+
+    /**
+     * @brief Benchmark setup routine.
+     *
+     * @param state Benchmark state.
+     */
+    void SetUp(const ::benchmark::State& state) override
+    {
+        snapshot = std::make_unique<FeedSnapshot>();
+        scanner = std::make_unique<TPackageScanner<BenchmarkFeedManager>>(snapshot->feedManager());
+        deltas = FeedSnapshot::packageDeltas(FeedSnapshot::agentPackages(state.range(0)));
+    }
+
+    /**
+     * @brief Benchmark teardown routine.
+     *
+     * @param state Benchmark state.
+     */
+    void TearDown(const ::benchmark::State& state) override
+    {
+        deltas.clear();
+        scanner.reset();
+        snapshot.reset();
+    }
+};
+
+BENCHMARK_DEFINE_F(PackageScannerPerformanceFixture, PackageScannerPerformance)(benchmark::State& state)
+{
+    size_t vulnerabilities {0};
+    for (auto _ : state)
+    {
+        for (const auto& delta : deltas)
+        {
+            const auto context {scanner->handleRequest(std::make_shared<ScanContext>(
+                ScanContextVariant {SyscollectorDeltas::GetDelta(reinterpret_cast<const char*>(delta.data()))}))};
+            if (context)
+            {
+                vulnerabilities += context->m_elements.size();
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * deltas.size());
+    state.counters["vulnerabilities"] = benchmark::Counter(vulnerabilities, benchmark::Counter::kAvgIterations);
+}
+
+/**
+ * @brief EventDetailsBuilderPerformanceFixture class.
+ *
+ */
+class EventDetailsBuilderPerformanceFixture : public benchmark::Fixture
+{
+public:
+    std::unique_ptr<FeedSnapshot> snapshot;                                    ///< Feed snapshot.
+    std::unique_ptr<TEventDetailsBuilder<BenchmarkFeedManager>> detailsBuilder; ///< Details builder.
+    std::vector<std::vector<uint8_t>> deltas;                                  ///< Package deltas of the agent.
+    std::vector<std::shared_ptr<ScanContext>> contexts;                        ///< Contexts of the vulnerable packages.
+    size_t currentIdx;                                                         ///< Current index of container
+
+    /**
+     * @brief Benchmark setup routine.
+     *
+     * @param state Benchmark state.
+     */
+    void SetUp(const ::benchmark::State& state) override
+    {
+        snapshot = std::make_unique<FeedSnapshot>();
+        detailsBuilder = std::make_unique<TEventDetailsBuilder<BenchmarkFeedManager>>(snapshot->feedManager());
+        deltas = FeedSnapshot::packageDeltas(FeedSnapshot::agentPackages(DETAILS_PACKAGES));
+
+        // The details are built for the vulnerabilities found by the package scanner.
+        TPackageScanner<BenchmarkFeedManager> scanner(snapshot->feedManager());
+        for (const auto& delta : deltas)
+        {
+            if (auto context {scanner.handleRequest(std::make_shared<ScanContext>(
+                    ScanContextVariant {SyscollectorDeltas::GetDelta(reinterpret_cast<const char*>(delta.data()))}))};
+                context)
+            {
+                contexts.push_back(std::move(context));
+            }
+        }
+
+        if (contexts.empty())
+        {
+            throw std::runtime_error("No vulnerabilities found in the feed snapshot.");
+        }
+        currentIdx = 0;
+    }
+
+    /**
+     * @brief Benchmark teardown routine.
+     *
+     * @param state Benchmark state.
+     */
+    void TearDown(const ::benchmark::State& state) override
+    {
+        contexts.clear();
+        deltas.clear();
+        detailsBuilder.reset();
+        snapshot.reset();
+    }
+};
+
+BENCHMARK_DEFINE_F(EventDetailsBuilderPerformanceFixture, EventDetailsBuilderPerformance)(benchmark::State& state)
+{
+    size_t documents {0};
+    for (auto _ : state)
+    {
+        const auto context {detailsBuilder->handleRequest(contexts[currentIdx])};
+        documents += context->m_elementsData.size();
+        if (++currentIdx >= contexts.size())
+        {
+            currentIdx = 0;
+        }
+    }
+    state.counters["documents"] = benchmark::Counter(documents, benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK_REGISTER_F(PackageScannerPerformanceFixture, PackageScannerPerformance)
+    ->Arg(500)
+    ->Arg(2000)
+    ->Arg(10000)
+    ->Unit(benchmark::kMillisecond)
+    ->Threads(1);
+BENCHMARK_REGISTER_F(EventDetailsBuilderPerformanceFixture, EventDetailsBuilderPerformance)
+    ->Iterations(10000)
+    ->Threads(1);
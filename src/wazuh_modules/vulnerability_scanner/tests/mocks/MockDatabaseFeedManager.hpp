@@ -14,6 +14,7 @@
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 
+#include "candidatesPrefetch.hpp"
 #include "json.hpp"
 
 /**
@@ -76,6 +77,28 @@ public:
                                           const NSVulnerabilityScanner::ScanVulnerabilityCandidate&)>& callback),
                 ());
 
+    /**
+     * @brief Mock method for getVulnerabilitiesCandidates through a prefetch.
+     *
+     * @note This method is intended for testing purposes and does not perform any real action.
+     */
+    MOCK_METHOD(void,
+                getVulnerabilitiesCandidates,
+                (const std::string& cnaName,
+                 const PackageData& package,
+                 const std::function<bool(const std::string& cnaName,
+                                          const PackageData& package,
+                                          const NSVulnerabilityScanner::ScanVulnerabilityCandidate&)>& callback,
+                 CandidatesPrefetch& prefetch),
+                ());
+
+    /**
+     * @brief Mock method for feedGeneration.
+     *
+     * @note This method is intended for testing purposes and does not perform any real action.
+     */
+    MOCK_METHOD(uint64_t, feedGeneration, (), (const));
+
     /**
      * @brief Mock method for getCVEDatabase.
      *
@@ -51,6 +51,27 @@ public:
      * @note This method is intended for testing purposes and does not perform any real action.
      */
     MOCK_METHOD(void, addRemediationData, (const std::string& agentId, Remediation newRemediationData), ());
+
+    /**
+     * @brief Mock method for preload.
+     *
+     * @note This method is intended for testing purposes and does not perform any real action.
+     */
+    MOCK_METHOD(size_t, preload, (const std::vector<std::string>& agentIds), ());
+
+    /**
+     * @brief Mock method for size.
+     *
+     * @note This method is intended for testing purposes and does not perform any real action.
+     */
+    MOCK_METHOD(size_t, size, (), (const));
+
+    /**
+     * @brief Mock method for stats.
+     *
+     * @note This method is intended for testing purposes and does not perform any real action.
+     */
+    MOCK_METHOD(LRUCacheStats, stats, (), (const));
 };
 
 #endif // _MOCK_REMEDIATION_DATA_CACHE_HPP
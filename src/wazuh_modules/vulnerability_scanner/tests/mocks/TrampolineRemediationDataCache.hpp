@@ -56,6 +56,38 @@ public:
     {
         spRemediationDataCacheMock->addRemediationData(agentId, newRemediationData);
     }
+
+    /**
+     * @brief Trampoline to method preload.
+     *
+     * @param agentIds
+     *
+     * @return size_t
+     */
+    size_t preload(const std::vector<std::string>& agentIds)
+    {
+        return spRemediationDataCacheMock->preload(agentIds);
+    }
+
+    /**
+     * @brief Trampoline to method size.
+     *
+     * @return size_t
+     */
+    size_t size() const
+    {
+        return spRemediationDataCacheMock->size();
+    }
+
+    /**
+     * @brief Trampoline to method stats.
+     *
+     * @return LRUCacheStats
+     */
+    LRUCacheStats stats() const
+    {
+        return spRemediationDataCacheMock->stats();
+    }
 };
 
 #endif //_TRAMPOLINE_REMEDIATION_DATA_CACHE_HPP
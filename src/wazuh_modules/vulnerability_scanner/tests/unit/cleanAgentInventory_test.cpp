@@ -209,3 +209,40 @@ TEST_F(CleanAgentInventoryTest, CleanAgentDataIntegrityClearOs)
     EXPECT_FALSE(m_inventoryDatabase->get("001", value, OS_INITIAL_SCAN));
     EXPECT_TRUE(m_inventoryDatabase->get("002", value, OS_INITIAL_SCAN));
 }
+
+TEST_F(CleanAgentInventoryTest, CleanAgentDataKeptIfThePublicationFails)
+{
+    // Created dummy data.
+    m_inventoryDatabase->put("001_aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa", "CVE-1234-2024,CVE-4321-2024", PACKAGE);
+    m_inventoryDatabase->put("001_bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbb", "CVE-1234-2024,CVE-4321-2024", OS);
+    m_inventoryDatabase->put("001", "1", OS_INITIAL_SCAN);
+
+    auto spSubOrchestration = std::make_shared<MockAbstractHandler<
+        std::shared_ptr<TScanContext<TrampolineOsDataCache, GlobalData, TrampolineRemediationDataCache>>>>();
+    EXPECT_CALL(*spSubOrchestration, handleRequest(testing::_))
+        .WillOnce(testing::Return(nullptr))
+        .WillOnce(testing::Throw(std::runtime_error("Indexer error")));
+
+    auto cleanAgentInventory = std::make_shared<
+        TCleanAgentInventory<TScanContext<TrampolineOsDataCache, GlobalData, TrampolineRemediationDataCache>,
+                             MockAbstractHandler<std::shared_ptr<
+                                 TScanContext<TrampolineOsDataCache, GlobalData, TrampolineRemediationDataCache>>>>>(
+        *m_inventoryDatabase, spSubOrchestration);
+
+    nlohmann::json jsonData = nlohmann::json::parse(
+        R"({"agent_info":  {"agent_id":"001",  "agent_version":"4.8.0",  "agent_name":"test_agent_name",
+"agent_ip":"10.0.0.1"},  "action":"upgradeAgentDB"})");
+
+    std::variant<const SyscollectorDeltas::Delta*, const SyscollectorSynchronization::SyncMsg*, const nlohmann::json*>
+        data = &jsonData;
+    auto context =
+        std::make_shared<TScanContext<TrampolineOsDataCache, GlobalData, TrampolineRemediationDataCache>>(data);
+
+    EXPECT_THROW(cleanAgentInventory->handleRequest(context), std::runtime_error);
+
+    // The agent is deleted at once, so nothing was deleted and the clean up can be retried.
+    std::string value;
+    EXPECT_TRUE(m_inventoryDatabase->get("001_aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa", value, PACKAGE));
+    EXPECT_TRUE(m_inventoryDatabase->get("001_bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbb", value, OS));
+    EXPECT_TRUE(m_inventoryDatabase->get("001", value, OS_INITIAL_SCAN));
+}
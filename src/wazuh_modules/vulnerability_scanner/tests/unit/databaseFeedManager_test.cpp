@@ -338,6 +338,93 @@ TEST_F(DatabaseFeedManagerTest, getVulnerabiltyDescriptiveInformation_Ok)
     EXPECT_STREQ(container.data->userInteraction()->c_str(), "UserInteractionStr");
 }
 
+TEST_F(DatabaseFeedManagerTest, getVulnerabilitiesDescriptiveInformation_Ok)
+{
+    const auto configurationParameters = R"( {"topicName": "topicNameTest"} )"_json;
+    constexpr auto CVEID_TEST_OTHER {"cveid_test_other"};
+
+    spIndexerConnectorMock = std::make_shared<MockIndexerConnector>();
+
+    spPolicyManagerMock = std::make_shared<MockPolicyManager>();
+    EXPECT_CALL(*spPolicyManagerMock, getUpdaterConfiguration()).WillRepeatedly(Return(configurationParameters));
+    EXPECT_CALL(*spPolicyManagerMock, getTranslationLRUSize()).WillRepeatedly(Return(2048));
+
+    spContentRegisterMock = std::make_shared<MockContentRegister>(
+        configurationParameters.at("topicName").get<const std::string>(), configurationParameters);
+
+    spRouterSubscriberMock = std::make_shared<MockRouterSubscriber>(
+        configurationParameters.at("topicName").get<const std::string>(), "vulnerability_feed_manager");
+    EXPECT_CALL(*spRouterSubscriberMock, subscribe(_));
+
+    auto buildDescription = [](flatbuffers::FlatBufferBuilder& fbBuilder, const char* description)
+    {
+        fbBuilder.Finish(NSVulnerabilityScanner::CreateVulnerabilityDescriptionDirect(fbBuilder,
+                                                                                      "AccessComplexityStr",
+                                                                                      "AssignerStr",
+                                                                                      "AttackVectorStr",
+                                                                                      "AuthenticationStr",
+                                                                                      "AvailabilityStr",
+                                                                                      "ClassificationStr",
+                                                                                      "ConfidentialityImpactStr",
+                                                                                      "CWEIdStr",
+                                                                                      "DataPublishedStr",
+                                                                                      "DataUpdatedStr",
+                                                                                      description,
+                                                                                      "IntegrityImpactStr",
+                                                                                      "PrivilegesRequiredStr",
+                                                                                      "ReferenceStr",
+                                                                                      "ScopeStr",
+                                                                                      999.99,
+                                                                                      "ScoreVersionStr",
+                                                                                      "SeverityStr",
+                                                                                      "UserInteractionStr"));
+    };
+
+    {
+        flatbuffers::FlatBufferBuilder fbBuilderOk;
+        buildDescription(fbBuilderOk, "DescriptionOk");
+        flatbuffers::FlatBufferBuilder fbBuilderOther;
+        buildDescription(fbBuilderOther, "DescriptionOther");
+
+        auto dbWrapper = std::make_unique<Utils::RocksDBWrapper>(DATABASE_PATH);
+        if (!dbWrapper->columnExists(DESCRIPTIONS_COLUMN))
+        {
+            dbWrapper->createColumn(DESCRIPTIONS_COLUMN);
+        }
+        dbWrapper->put(
+            CVEID_TEST_OK,
+            rocksdb::Slice(reinterpret_cast<const char*>(fbBuilderOk.GetBufferPointer()), fbBuilderOk.GetSize()),
+            DESCRIPTIONS_COLUMN);
+        dbWrapper->put(
+            CVEID_TEST_OTHER,
+            rocksdb::Slice(reinterpret_cast<const char*>(fbBuilderOther.GetBufferPointer()), fbBuilderOther.GetSize()),
+            DESCRIPTIONS_COLUMN);
+    }
+
+    auto spTrampolineIndexerConnector = std::make_shared<TrampolineIndexerConnector>();
+    std::atomic<bool> shouldStop {false};
+    std::shared_mutex mutex;
+
+    auto spDatabaseFeedManager {std::make_shared<TDatabaseFeedManager<TrampolineIndexerConnector,
+                                                                      TrampolinePolicyManager,
+                                                                      TrampolineContentRegister,
+                                                                      TrampolineRouterSubscriber>>(
+        spTrampolineIndexerConnector, shouldStop, mutex)};
+
+    std::vector<FlatbufferDataPair<NSVulnerabilityScanner::VulnerabilityDescription>> containers;
+
+    EXPECT_NO_THROW(spDatabaseFeedManager->getVulnerabilitiesDescriptiveInformation(
+        {CVEID_TEST_OTHER, CVEID_TEST_OK}, containers));
+    ASSERT_EQ(containers.size(), 2);
+    EXPECT_STREQ(containers[0].data->description()->c_str(), "DescriptionOther");
+    EXPECT_STREQ(containers[1].data->description()->c_str(), "DescriptionOk");
+    EXPECT_STREQ(containers[1].data->severity()->c_str(), "SeverityStr");
+
+    EXPECT_THROW(
+        spDatabaseFeedManager->getVulnerabilitiesDescriptiveInformation({CVEID_TEST_OK, "cveid_any"}, containers),
+        std::runtime_error);
+}
+
 TEST_F(DatabaseFeedManagerTest, getVulnerabiltyDescriptiveInformation_NotFound)
 {
     const auto configurationParameters = R"( {"topicName": "topicNameTest"} )"_json;
@@ -546,6 +633,81 @@ TEST_F(DatabaseFeedManagerTest, GetVulnerabilityCandidatesCorrupted)
         std::runtime_error);
 }
 
+TEST_F(DatabaseFeedManagerTest, GetVulnerabilityCandidatesThroughPrefetch)
+{
+    const auto configurationParameters = R"( {"topicName": "topicNameTest"} )"_json;
+
+    spIndexerConnectorMock = std::make_shared<MockIndexerConnector>();
+    spPolicyManagerMock = std::make_shared<MockPolicyManager>();
+    spRouterSubscriberMock = std::make_shared<MockRouterSubscriber>(
+        configurationParameters.at("topicName").get<const std::string>(), "vulnerability_feed_manager");
+    spContentRegisterMock = std::make_shared<MockContentRegister>(
+        configurationParameters.at("topicName").get<const std::string>(), configurationParameters);
+
+    EXPECT_CALL(*spPolicyManagerMock, getUpdaterConfiguration()).WillRepeatedly(Return(configurationParameters));
+    EXPECT_CALL(*spPolicyManagerMock, getTranslationLRUSize()).WillRepeatedly(Return(2048));
+
+    EXPECT_CALL(*spRouterSubscriberMock, subscribe(_));
+
+    auto pIndexerConnectorTrap = std::make_shared<TrampolineIndexerConnector>();
+    std::atomic<bool> shouldStop {false};
+    std::shared_mutex mutex;
+
+    // Store a candidate for each package, including a package whose name is a prefix of another one.
+    const std::vector<std::pair<std::string, std::string>> storedCandidates {
+        {"libprefetch", "CVE-2024-0001"}, {"libprefetch-dev", "CVE-2024-0002"}, {"libalone", "CVE-2024-0003"}};
+    {
+        auto dbWrapper = std::make_unique<Utils::RocksDBWrapper>(DATABASE_PATH);
+        for (const auto& [packageName, cveId] : storedCandidates)
+        {
+            flatbuffers::FlatBufferBuilder builder;
+            std::vector<flatbuffers::Offset<NSVulnerabilityScanner::ScanVulnerabilityCandidate>> candidates {
+                NSVulnerabilityScanner::CreateScanVulnerabilityCandidateDirect(
+                    builder, cveId.c_str(), NSVulnerabilityScanner::Status::Status_affected)};
+            builder.Finish(NSVulnerabilityScanner::CreateScanVulnerabilityCandidateArrayDirect(builder, &candidates));
+
+            rocksdb::Slice dbValue(reinterpret_cast<const char*>(builder.GetBufferPointer()), builder.GetSize());
+            dbWrapper->put(packageName + "_" + cveId, dbValue, CNA_NAME);
+        }
+    }
+
+    auto pDatabaseFeedManager {
+        std::make_shared<TDatabaseFeedManager<TrampolineIndexerConnector,
+                                              TrampolinePolicyManager,
+                                              TrampolineContentRegister,
+                                              TrampolineRouterSubscriber>>(pIndexerConnectorTrap, shouldStop, mutex)};
+
+    CandidatesPrefetch prefetch {{"libprefetch-dev", "libprefetch", "libmissing"}};
+
+    const auto getCandidates = [&](const std::string& packageName)
+    {
+        std::vector<std::string> cves;
+        PackageData package = {.name = packageName};
+        pDatabaseFeedManager->getVulnerabilitiesCandidates(
+            CNA_NAME,
+            package,
+            [&](const std::string& cnaName,
+                const PackageData& package,
+                const NSVulnerabilityScanner::ScanVulnerabilityCandidate& candidate) -> bool
+            {
+                cves.push_back(candidate.cveId()->str());
+                EXPECT_STREQ(package.name.c_str(), packageName.c_str());
+                return false;
+            },
+            prefetch);
+        return cves;
+    };
+
+    EXPECT_FALSE(prefetch.fetched(CNA_NAME));
+    EXPECT_EQ(getCandidates("libprefetch"), std::vector<std::string> {"CVE-2024-0001"});
+    EXPECT_TRUE(prefetch.fetched(CNA_NAME));
+    EXPECT_EQ(getCandidates("libprefetch-dev"), std::vector<std::string> {"CVE-2024-0002"});
+    EXPECT_TRUE(getCandidates("libmissing").empty());
+
+    // A package out of the prefetch is queried alone.
+    EXPECT_EQ(getCandidates("libalone"), std::vector<std::string> {"CVE-2024-0003"});
+}
+
 TEST_F(DatabaseFeedManagerTest, GetVulnerabilityCandidatesNoPackageName)
 {
     const auto configurationParameters = R"( {"topicName": "topicNameTest"} )"_json;
@@ -750,6 +912,78 @@ TEST_F(DatabaseFeedManagerTest, PackageTranslationInvalidCache)
     // ToDo It's necessary the write function to store a value corrupted and run this test.
 }
 
+TEST_F(DatabaseFeedManagerTest, PackageTranslationIndexWarmsTheCaches)
+{
+    const auto configurationParameters = R"( {"topicName": "topicNameTest"} )"_json;
+
+    spIndexerConnectorMock = std::make_shared<MockIndexerConnector>();
+    spPolicyManagerMock = std::make_shared<MockPolicyManager>();
+    spRouterSubscriberMock = std::make_shared<MockRouterSubscriber>(
+        configurationParameters.at("topicName").get<const std::string>(), "vulnerability_feed_manager");
+    spContentRegisterMock = std::make_shared<MockContentRegister>(
+        configurationParameters.at("topicName").get<const std::string>(), configurationParameters);
+
+    EXPECT_CALL(*spPolicyManagerMock, getUpdaterConfiguration()).WillRepeatedly(Return(configurationParameters));
+    EXPECT_CALL(*spPolicyManagerMock, getTranslationLRUSize()).WillRepeatedly(Return(2048));
+
+    EXPECT_CALL(*spRouterSubscriberMock, subscribe(_)).Times(2);
+
+    auto pIndexerConnectorTrap = std::make_shared<TrampolineIndexerConnector>();
+    std::atomic<bool> shouldStop {false};
+    std::shared_mutex mutex;
+
+    const auto createDatabaseFeedManager = [&]()
+    {
+        return std::make_shared<TDatabaseFeedManager<TrampolineIndexerConnector,
+                                                     TrampolinePolicyManager,
+                                                     TrampolineContentRegister,
+                                                     TrampolineRouterSubscriber>>(
+            pIndexerConnectorTrap, shouldStop, mutex);
+    };
+
+    const PackageData translatedPackage {.name = "Microsoft ASP.NET Core 6.0.1",
+                                         .vendor = "Microsoft Corporation",
+                                         .version = "6.0.1"};
+    const PackageData untranslatedPackage {.name = "Notepad++", .vendor = "Notepad++ Team", .version = "8.5"};
+
+    const auto checkTranslations = [&](const auto& databaseFeedManager)
+    {
+        const auto translations = databaseFeedManager->checkAndTranslatePackage(translatedPackage, "windows");
+        ASSERT_EQ(translations.size(), 1);
+        EXPECT_EQ(translations.at(0).name, "asp.net_core");
+        EXPECT_EQ(translations.at(0).vendor, "microsoft");
+        EXPECT_EQ(translations.at(0).version, "6.0.1");
+
+        EXPECT_TRUE(databaseFeedManager->checkAndTranslatePackage(untranslatedPackage, "windows").empty());
+    };
+
+    auto& metrics {ScannerMetrics::instance()};
+    const auto& l1Hits {metrics.counter("translation.l1_hits")};
+    const auto& l2Hits {metrics.counter("translation.l2_hits")};
+    const auto& filterHits {metrics.counter("translation.filter_hits")};
+    const auto& misses {metrics.counter("translation.misses")};
+
+    // The first lookups match the translation rules, and persist the result.
+    {
+        const auto l2HitsBefore {l2Hits.load()};
+        const auto missesBefore {misses.load()};
+        checkTranslations(createDatabaseFeedManager());
+        EXPECT_EQ(l2Hits.load(), l2HitsBefore + 1);
+        EXPECT_EQ(misses.load(), missesBefore + 1);
+    }
+
+    // A new instance (e.g. after a restart) warms its caches with the persisted lookups.
+    const auto l1HitsBefore {l1Hits.load()};
+    const auto l2HitsBefore {l2Hits.load()};
+    const auto filterHitsBefore {filterHits.load()};
+    const auto missesBefore {misses.load()};
+    checkTranslations(createDatabaseFeedManager());
+    EXPECT_EQ(l1Hits.load(), l1HitsBefore + 1);
+    EXPECT_EQ(filterHits.load(), filterHitsBefore + 1);
+    EXPECT_EQ(l2Hits.load(), l2HitsBefore);
+    EXPECT_EQ(misses.load(), missesBefore);
+}
+
 void databaseFeedManagerTestGracefulShutdown()
 {
     // Test setup
@@ -1389,6 +1623,15 @@ TEST_F(DatabaseFeedManagerMessageProcessorTest, TestRawFileWithDataSuccess)
 
     auto testingLambda1 = [](const nlohmann::json& obj, Utils::IRocksDBWrapper* dbWrapper)
     {
+        // The snapshot is imported into a new database.
+        for (const auto& column : {VENDOR_MAP_COLUMN, OS_CPE_RULES_COLUMN})
+        {
+            if (!dbWrapper->columnExists(column))
+            {
+                dbWrapper->createColumn(column);
+            }
+        }
+
         if (obj.at("name") == "FEED-GLOBAL")
         {
             dbWrapper->put(obj.at("name"), obj.at("payload").dump().c_str(), VENDOR_MAP_COLUMN);
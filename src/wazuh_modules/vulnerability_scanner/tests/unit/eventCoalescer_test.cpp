@@ -0,0 +1,162 @@
+/*
+ * Wazuh Vulnerability Scanner - Unit Tests
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "eventCoalescer_test.hpp"
+#include "../../../../shared_modules/utils/flatbuffers/include/syscollector_deltas_schema.h"
+#include "../../../../shared_modules/utils/flatbuffers/include/syscollector_synchronization_schema.h"
+#include "eventCoalescer.hpp"
+#include "flatbuffers/idl.h"
+
+const std::string DELTA_PACKAGE_MSG {
+    R"(
+            {
+                "agent_info": {
+                    "agent_id": "001",
+                    "agent_ip": "192.168.33.20",
+                    "agent_name": "focal"
+                },
+                "data_type": "dbsync_packages",
+                "data": {
+                    "architecture": "amd64",
+                    "format": "deb",
+                    "item_id": "ec465b7eb5fa011a336e95614072e4c7f1a65a53",
+                    "name": "libgif7",
+                    "vendor": "Ubuntu Developers <ubuntu-devel-discuss@lists.ubuntu.com>",
+                    "version": "5.1.9-1"
+                },
+                "operation": "DELETED"
+            }
+        )"};
+
+const std::string DELTA_HOTFIX_MSG {
+    R"(
+            {
+                "agent_info": {
+                    "agent_id": "001",
+                    "agent_ip": "192.168.33.20",
+                    "agent_name": "focal"
+                },
+                "data_type": "dbsync_hotfixes",
+                "data": {
+                    "hotfix": "KB12345678",
+                    "checksum": "1e6ce14f97f57d1bbd46ff8e5d3e133171a1bbce"
+                },
+                "operation": "INSERTED"
+            }
+        )"};
+
+const std::string SYNC_STATE_PACKAGE_MSG {
+    R"(
+            {
+                "agent_info": {
+                    "agent_id": "001",
+                    "agent_ip": "192.168.33.20",
+                    "agent_name": "focal"
+                },
+                "data_type": "state",
+                "data": {
+                    "attributes_type": "syscollector_packages",
+                    "attributes": {
+                        "architecture": "amd64",
+                        "format": "deb",
+                        "item_id": "ec465b7eb5fa011a336e95614072e4c7f1a65a53",
+                        "name": "libgif7",
+                        "vendor": "Ubuntu Developers <ubuntu-devel-discuss@lists.ubuntu.com>",
+                        "version": "5.1.9-1"
+                    },
+                    "index": "ec465b7eb5fa011a336e95614072e4c7f1a65a53",
+                    "timestamp": ""
+                }
+            }
+        )"};
+
+const std::string SYNC_INTEGRITY_CLEAR_MSG {
+    R"(
+            {
+                "agent_info": {
+                    "agent_id": "001",
+                    "agent_ip": "192.168.33.20",
+                    "agent_name": "focal"
+                },
+                "data_type": "integrity_clear",
+                "data": {
+                    "attributes_type": "syscollector_packages",
+                    "id": 1700236640
+                }
+            }
+        )"};
+
+const std::string PACKAGE_KEY {"001:ec465b7eb5fa011a336e95614072e4c7f1a65a53"};
+
+namespace
+{
+    std::string eventKey(const char* schema, const std::string& message, const BufferType type)
+    {
+        flatbuffers::Parser parser;
+        EXPECT_TRUE(parser.Parse(schema));
+        EXPECT_TRUE(parser.Parse(message.c_str()));
+        return EventCoalescer::key(type,
+                                   reinterpret_cast<const int8_t*>(parser.builder_.GetBufferPointer()),
+                                   parser.builder_.GetSize());
+    }
+} // namespace
+
+void EventCoalescerTest::SetUp() {}
+
+void EventCoalescerTest::TearDown() {}
+
+TEST_F(EventCoalescerTest, PackageEventsKey)
+{
+    EXPECT_EQ(eventKey(syscollector_deltas_SCHEMA, DELTA_PACKAGE_MSG, BufferType::BufferType_DBSync), PACKAGE_KEY);
+    EXPECT_EQ(eventKey(syscollector_synchronization_SCHEMA, SYNC_STATE_PACKAGE_MSG, BufferType::BufferType_RSync),
+              PACKAGE_KEY);
+}
+
+TEST_F(EventCoalescerTest, OtherEventsWithoutKey)
+{
+    EXPECT_TRUE(eventKey(syscollector_deltas_SCHEMA, DELTA_HOTFIX_MSG, BufferType::BufferType_DBSync).empty());
+    EXPECT_TRUE(
+        eventKey(syscollector_synchronization_SCHEMA, SYNC_INTEGRITY_CLEAR_MSG, BufferType::BufferType_RSync).empty());
+
+    // The type doesn't match the data.
+    EXPECT_TRUE(eventKey(syscollector_deltas_SCHEMA, DELTA_PACKAGE_MSG, BufferType::BufferType_JSON).empty());
+
+    const std::vector<int8_t> invalid {1, 2, 3};
+    EXPECT_TRUE(EventCoalescer::key(BufferType::BufferType_DBSync, invalid.data(), invalid.size()).empty());
+}
+
+TEST_F(EventCoalescerTest, OnlyTheLastEventIsScanned)
+{
+    EventCoalescer coalescer;
+    coalescer.pushed(PACKAGE_KEY);
+    coalescer.pushed(PACKAGE_KEY);
+    coalescer.pushed("002:ec465b7eb5fa011a336e95614072e4c7f1a65a53");
+    coalescer.pushed(PACKAGE_KEY);
+    EXPECT_EQ(coalescer.size(), 2u);
+
+    EXPECT_TRUE(coalescer.superseded(PACKAGE_KEY));
+    EXPECT_TRUE(coalescer.superseded(PACKAGE_KEY));
+    EXPECT_FALSE(coalescer.superseded("002:ec465b7eb5fa011a336e95614072e4c7f1a65a53"));
+    EXPECT_FALSE(coalescer.superseded(PACKAGE_KEY));
+    EXPECT_EQ(coalescer.size(), 0u);
+}
+
+TEST_F(EventCoalescerTest, EventsQueuedBeforeStartAreScanned)
+{
+    EventCoalescer coalescer;
+    EXPECT_FALSE(coalescer.superseded(PACKAGE_KEY));
+
+    // The events without key are never coalesced.
+    coalescer.pushed("");
+    coalescer.pushed("");
+    EXPECT_FALSE(coalescer.superseded(""));
+    EXPECT_EQ(coalescer.size(), 0u);
+}
@@ -282,7 +282,7 @@ TEST_F(EventDetailsBuilderTest, TestSuccessfulPackageInsertedCVSS2)
         std::string(scanContext->agentId()) + "_" + std::string(scanContext->packageItemId()) + "_" + CVEID;
     EXPECT_STREQ(element.at("id").get_ref<const std::string&>().c_str(), elementId.c_str());
 
-    auto& elementData = scanContext->m_elements[CVEID].at("data");
+    const auto elementData = nlohmann::json::parse(scanContext->m_elementsData.at(CVEID));
 
     EXPECT_STREQ(elementData.at("agent").at("id").get_ref<const std::string&>().c_str(), scanContext->agentId().data());
     EXPECT_STREQ(elementData.at("agent").at("name").get_ref<const std::string&>().c_str(),
@@ -465,7 +465,7 @@ TEST_F(EventDetailsBuilderTest, TestSuccessfulPackageInsertedCVSS3)
         std::string(scanContext->agentId()) + "_" + std::string(scanContext->packageItemId()) + "_" + CVEID;
     EXPECT_STREQ(element.at("id").get_ref<const std::string&>().c_str(), elementId.c_str());
 
-    auto& elementData = scanContext->m_elements[CVEID].at("data");
+    const auto elementData = nlohmann::json::parse(scanContext->m_elementsData.at(CVEID));
 
     EXPECT_STREQ(elementData.at("agent").at("ephemeral_id").get_ref<const std::string&>().c_str(),
                  scanContext->clusterNodeName().data());
@@ -736,7 +736,7 @@ TEST_F(EventDetailsBuilderTest, TestSuccessfulOsInserted)
         std::string(scanContext->agentId()) + "_" + std::string(scanContext->osName()) + "_" + CVEID;
     EXPECT_STREQ(element.at("id").get_ref<const std::string&>().c_str(), elementId.c_str());
 
-    auto& elementData = scanContext->m_elements[CVEID].at("data");
+    const auto elementData = nlohmann::json::parse(scanContext->m_elementsData.at(CVEID));
 
     EXPECT_STREQ(elementData.at("agent").at("id").get_ref<const std::string&>().c_str(), scanContext->agentId().data());
     EXPECT_STREQ(elementData.at("agent").at("name").get_ref<const std::string&>().c_str(),
@@ -36,7 +36,8 @@ enum class ScannerMockID : int
     SCAN_AGENT_LIST = 18,
     GLOBAL_INVENTORY_SYNC = 19,
     HOTFIX_INSERT = 20,
-    ARRAY_RESULT_INDEXER = 21
+    ARRAY_RESULT_INDEXER = 21,
+    PRELOAD_AGENTS_DATA = 22
 };
 
 /**
@@ -86,6 +87,13 @@ public:
      */
     TFakeClass(std::shared_ptr<AbstractHandler<std::shared_ptr<std::vector<ScannerMockID>>>>,
                std::shared_ptr<AbstractHandler<std::shared_ptr<std::vector<ScannerMockID>>>>) {};
+    /**
+     * @brief Construct a new TFakeClass object.
+     *
+     */
+    TFakeClass(std::shared_ptr<AbstractHandler<std::shared_ptr<std::vector<ScannerMockID>>>>,
+               std::shared_ptr<AbstractHandler<std::shared_ptr<std::vector<ScannerMockID>>>>,
+               unsigned int) {};
     /**
      * @brief Construct a new TFakeClass object.
      */
@@ -136,11 +144,12 @@ TEST_F(FactoryOrchestratorTest, TestScannerTypePackageInsert)
                              TFakeClass<ScannerMockID::SCAN_AGENT_LIST>,
                              TFakeClass<ScannerMockID::GLOBAL_INVENTORY_SYNC>,
                              TFakeClass<ScannerMockID::HOTFIX_INSERT>,
-                             TFakeClass<ScannerMockID::ARRAY_RESULT_INDEXER>>::create(ScannerType::PackageInsert,
-                                                                                      nullptr,
-                                                                                      nullptr,
-                                                                                      *m_inventoryDatabase,
-                                                                                      nullptr);
+                             TFakeClass<ScannerMockID::ARRAY_RESULT_INDEXER>,
+                             TFakeClass<ScannerMockID::PRELOAD_AGENTS_DATA>>::create(ScannerType::PackageInsert,
+                                                                                     nullptr,
+                                                                                     nullptr,
+                                                                                     *m_inventoryDatabase,
+                                                                                     nullptr);
 
     auto context = std::make_shared<std::vector<ScannerMockID>>();
 
@@ -185,11 +194,12 @@ TEST_F(FactoryOrchestratorTest, TestScannerTypePackageDelete)
                              TFakeClass<ScannerMockID::SCAN_AGENT_LIST>,
                              TFakeClass<ScannerMockID::GLOBAL_INVENTORY_SYNC>,
                              TFakeClass<ScannerMockID::HOTFIX_INSERT>,
-                             TFakeClass<ScannerMockID::ARRAY_RESULT_INDEXER>>::create(ScannerType::PackageDelete,
-                                                                                      nullptr,
-                                                                                      nullptr,
-                                                                                      *m_inventoryDatabase,
-                                                                                      nullptr);
+                             TFakeClass<ScannerMockID::ARRAY_RESULT_INDEXER>,
+                             TFakeClass<ScannerMockID::PRELOAD_AGENTS_DATA>>::create(ScannerType::PackageDelete,
+                                                                                     nullptr,
+                                                                                     nullptr,
+                                                                                     *m_inventoryDatabase,
+                                                                                     nullptr);
 
     auto context = std::make_shared<std::vector<ScannerMockID>>();
 
@@ -232,11 +242,12 @@ TEST_F(FactoryOrchestratorTest, TestScannerTypeIntegrityClear)
                              TFakeClass<ScannerMockID::SCAN_AGENT_LIST>,
                              TFakeClass<ScannerMockID::GLOBAL_INVENTORY_SYNC>,
                              TFakeClass<ScannerMockID::HOTFIX_INSERT>,
-                             TFakeClass<ScannerMockID::ARRAY_RESULT_INDEXER>>::create(ScannerType::IntegrityClear,
-                                                                                      nullptr,
-                                                                                      nullptr,
-                                                                                      *m_inventoryDatabase,
-                                                                                      nullptr);
+                             TFakeClass<ScannerMockID::ARRAY_RESULT_INDEXER>,
+                             TFakeClass<ScannerMockID::PRELOAD_AGENTS_DATA>>::create(ScannerType::IntegrityClear,
+                                                                                     nullptr,
+                                                                                     nullptr,
+                                                                                     *m_inventoryDatabase,
+                                                                                     nullptr);
 
     auto context = std::make_shared<std::vector<ScannerMockID>>();
 
@@ -278,11 +289,12 @@ TEST_F(FactoryOrchestratorTest, TestScannerTypeOs)
                              TFakeClass<ScannerMockID::SCAN_AGENT_LIST>,
                              TFakeClass<ScannerMockID::GLOBAL_INVENTORY_SYNC>,
                              TFakeClass<ScannerMockID::HOTFIX_INSERT>,
-                             TFakeClass<ScannerMockID::ARRAY_RESULT_INDEXER>>::create(ScannerType::Os,
-                                                                                      nullptr,
-                                                                                      nullptr,
-                                                                                      *m_inventoryDatabase,
-                                                                                      nullptr);
+                             TFakeClass<ScannerMockID::ARRAY_RESULT_INDEXER>,
+                             TFakeClass<ScannerMockID::PRELOAD_AGENTS_DATA>>::create(ScannerType::Os,
+                                                                                     nullptr,
+                                                                                     nullptr,
+                                                                                     *m_inventoryDatabase,
+                                                                                     nullptr);
 
     auto context = std::make_shared<std::vector<ScannerMockID>>();
 
@@ -327,11 +339,12 @@ TEST_F(FactoryOrchestratorTest, TestCreationCleanUpAllData)
                              TFakeClass<ScannerMockID::SCAN_AGENT_LIST>,
                              TFakeClass<ScannerMockID::GLOBAL_INVENTORY_SYNC>,
                              TFakeClass<ScannerMockID::HOTFIX_INSERT>,
-                             TFakeClass<ScannerMockID::ARRAY_RESULT_INDEXER>>::create(ScannerType::CleanupAllAgentData,
-                                                                                      nullptr,
-                                                                                      nullptr,
-                                                                                      *m_inventoryDatabase,
-                                                                                      nullptr);
+                             TFakeClass<ScannerMockID::ARRAY_RESULT_INDEXER>,
+                             TFakeClass<ScannerMockID::PRELOAD_AGENTS_DATA>>::create(ScannerType::CleanupAllAgentData,
+                                                                                     nullptr,
+                                                                                     nullptr,
+                                                                                     *m_inventoryDatabase,
+                                                                                     nullptr);
 
     auto context = std::make_shared<std::vector<ScannerMockID>>();
 
@@ -371,19 +384,21 @@ TEST_F(FactoryOrchestratorTest, TestCreationReScanAllAgents)
                              TFakeClass<ScannerMockID::SCAN_AGENT_LIST>,
                              TFakeClass<ScannerMockID::GLOBAL_INVENTORY_SYNC>,
                              TFakeClass<ScannerMockID::HOTFIX_INSERT>,
-                             TFakeClass<ScannerMockID::ARRAY_RESULT_INDEXER>>::create(ScannerType::ReScanAllAgents,
-                                                                                      nullptr,
-                                                                                      nullptr,
-                                                                                      *m_inventoryDatabase,
-                                                                                      nullptr);
+                             TFakeClass<ScannerMockID::ARRAY_RESULT_INDEXER>,
+                             TFakeClass<ScannerMockID::PRELOAD_AGENTS_DATA>>::create(ScannerType::ReScanAllAgents,
+                                                                                     nullptr,
+                                                                                     nullptr,
+                                                                                     *m_inventoryDatabase,
+                                                                                     nullptr);
 
     auto context = std::make_shared<std::vector<ScannerMockID>>();
 
     EXPECT_NO_THROW(orchestration->handleRequest(context));
-    EXPECT_EQ(context->size(), 3);
+    EXPECT_EQ(context->size(), 4);
     EXPECT_EQ(context->at(0), ScannerMockID::CLEAN_ALL_AGENT_INVENTORY);
     EXPECT_EQ(context->at(1), ScannerMockID::BUILD_ALL_AGENT_LIST_CONTEXT);
-    EXPECT_EQ(context->at(2), ScannerMockID::SCAN_AGENT_LIST);
+    EXPECT_EQ(context->at(2), ScannerMockID::PRELOAD_AGENTS_DATA);
+    EXPECT_EQ(context->at(3), ScannerMockID::SCAN_AGENT_LIST);
 }
 
 /**
@@ -417,11 +432,12 @@ TEST_F(FactoryOrchestratorTest, TestCreationReScanSingleAgent)
                              TFakeClass<ScannerMockID::SCAN_AGENT_LIST>,
                              TFakeClass<ScannerMockID::GLOBAL_INVENTORY_SYNC>,
                              TFakeClass<ScannerMockID::HOTFIX_INSERT>,
-                             TFakeClass<ScannerMockID::ARRAY_RESULT_INDEXER>>::create(ScannerType::ReScanSingleAgent,
-                                                                                      nullptr,
-                                                                                      nullptr,
-                                                                                      *m_inventoryDatabase,
-                                                                                      nullptr);
+                             TFakeClass<ScannerMockID::ARRAY_RESULT_INDEXER>,
+                             TFakeClass<ScannerMockID::PRELOAD_AGENTS_DATA>>::create(ScannerType::ReScanSingleAgent,
+                                                                                     nullptr,
+                                                                                     nullptr,
+                                                                                     *m_inventoryDatabase,
+                                                                                     nullptr);
 
     auto context = std::make_shared<std::vector<ScannerMockID>>();
 
@@ -459,7 +475,8 @@ TEST_F(FactoryOrchestratorTest, TestCreationCleanUpAgentData)
                                               TFakeClass<ScannerMockID::SCAN_AGENT_LIST>,
                                               TFakeClass<ScannerMockID::GLOBAL_INVENTORY_SYNC>,
                                               TFakeClass<ScannerMockID::HOTFIX_INSERT>,
-                                              TFakeClass<ScannerMockID::ARRAY_RESULT_INDEXER>>::
+                                              TFakeClass<ScannerMockID::ARRAY_RESULT_INDEXER>,
+                                              TFakeClass<ScannerMockID::PRELOAD_AGENTS_DATA>>::
         create(ScannerType::CleanupSingleAgentData, nullptr, nullptr, *m_inventoryDatabase, nullptr);
 
     auto context = std::make_shared<std::vector<ScannerMockID>>();
@@ -498,11 +515,12 @@ TEST_F(FactoryOrchestratorTest, TestCreationHotfixInsert)
                              TFakeClass<ScannerMockID::SCAN_AGENT_LIST>,
                              TFakeClass<ScannerMockID::GLOBAL_INVENTORY_SYNC>,
                              TFakeClass<ScannerMockID::HOTFIX_INSERT>,
-                             TFakeClass<ScannerMockID::ARRAY_RESULT_INDEXER>>::create(ScannerType::HotfixInsert,
-                                                                                      nullptr,
-                                                                                      nullptr,
-                                                                                      *m_inventoryDatabase,
-                                                                                      nullptr);
+                             TFakeClass<ScannerMockID::ARRAY_RESULT_INDEXER>,
+                             TFakeClass<ScannerMockID::PRELOAD_AGENTS_DATA>>::create(ScannerType::HotfixInsert,
+                                                                                     nullptr,
+                                                                                     nullptr,
+                                                                                     *m_inventoryDatabase,
+                                                                                     nullptr);
 
     auto context = std::make_shared<std::vector<ScannerMockID>>();
 
@@ -549,11 +567,12 @@ TEST_F(FactoryOrchestratorTest, TestCreationInvalidScannerType)
                              TFakeClass<ScannerMockID::SCAN_AGENT_LIST>,
                              TFakeClass<ScannerMockID::GLOBAL_INVENTORY_SYNC>,
                              TFakeClass<ScannerMockID::HOTFIX_INSERT>,
-                             TFakeClass<ScannerMockID::ARRAY_RESULT_INDEXER>>::create(invalidScannerType,
-                                                                                      nullptr,
-                                                                                      nullptr,
-                                                                                      *m_inventoryDatabase,
-                                                                                      nullptr);
+                             TFakeClass<ScannerMockID::ARRAY_RESULT_INDEXER>,
+                             TFakeClass<ScannerMockID::PRELOAD_AGENTS_DATA>>::create(invalidScannerType,
+                                                                                     nullptr,
+                                                                                     nullptr,
+                                                                                     *m_inventoryDatabase,
+                                                                                     nullptr);
     }
     catch (const std::runtime_error& e)
     {
@@ -593,11 +612,12 @@ TEST_F(FactoryOrchestratorTest, TestCreationGlobalSyncInventory)
                              TFakeClass<ScannerMockID::SCAN_AGENT_LIST>,
                              TFakeClass<ScannerMockID::GLOBAL_INVENTORY_SYNC>,
                              TFakeClass<ScannerMockID::HOTFIX_INSERT>,
-                             TFakeClass<ScannerMockID::ARRAY_RESULT_INDEXER>>::create(ScannerType::GlobalSyncInventory,
-                                                                                      nullptr,
-                                                                                      nullptr,
-                                                                                      *m_inventoryDatabase,
-                                                                                      nullptr);
+                             TFakeClass<ScannerMockID::ARRAY_RESULT_INDEXER>,
+                             TFakeClass<ScannerMockID::PRELOAD_AGENTS_DATA>>::create(ScannerType::GlobalSyncInventory,
+                                                                                     nullptr,
+                                                                                     nullptr,
+                                                                                     *m_inventoryDatabase,
+                                                                                     nullptr);
 
     auto context = std::make_shared<std::vector<ScannerMockID>>();
 
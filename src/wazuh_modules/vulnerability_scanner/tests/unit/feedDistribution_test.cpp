@@ -0,0 +1,112 @@
+/*
+ * Wazuh Vulnerability scanner - Database Feed Manager
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "feedDistribution_test.hpp"
+#include <chrono>
+#include <fstream>
+#include <thread>
+
+namespace NSFeedDistributionTest
+{
+    constexpr auto COLUMN_NAME {"column_A"};
+} // namespace NSFeedDistributionTest
+
+using namespace NSFeedDistributionTest;
+
+void FeedDistributionTest::SetUp()
+{
+    std::filesystem::remove_all(m_testPath);
+    std::filesystem::create_directories(m_testPath);
+    m_database = std::make_unique<Utils::RocksDBWrapper>(m_databasePath, false);
+    m_database->createColumn(COLUMN_NAME);
+    m_database->put("CVE-1", "payload-1", COLUMN_NAME);
+}
+
+void FeedDistributionTest::TearDown()
+{
+    m_database.reset();
+    std::filesystem::remove_all(m_testPath);
+}
+
+/*
+ * @brief The exported feed is imported as a new database.
+ */
+TEST_F(FeedDistributionTest, PublishAndFetch)
+{
+    const FeedDistribution distribution {m_distributionPath, m_testPath / "feed_distribution_tmp"};
+    EXPECT_TRUE(distribution.available("").empty());
+
+    std::string version;
+    ASSERT_NO_THROW(version = distribution.publish(*m_database));
+    ASSERT_EQ(distribution.available(""), version);
+
+    // The imported version is not available again.
+    EXPECT_TRUE(distribution.available(version).empty());
+
+    ASSERT_NO_THROW(distribution.fetch(version, m_importPath));
+    Utils::RocksDBWrapper imported {m_importPath, false};
+    std::string value;
+    ASSERT_TRUE(imported.get("CVE-1", value, COLUMN_NAME));
+    EXPECT_EQ(value, "payload-1");
+}
+
+/*
+ * @brief A new export replaces the previous version.
+ */
+TEST_F(FeedDistributionTest, PublishReplacesPreviousVersion)
+{
+    const FeedDistribution distribution {m_distributionPath, m_testPath / "feed_distribution_tmp"};
+
+    const auto first {distribution.publish(*m_database)};
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    m_database->put("CVE-2", "payload-2", COLUMN_NAME);
+    const auto second {distribution.publish(*m_database)};
+
+    ASSERT_NE(first, second);
+    EXPECT_EQ(distribution.available(first), second);
+    EXPECT_FALSE(std::filesystem::exists(m_distributionPath / first));
+
+    ASSERT_NO_THROW(distribution.fetch(second, m_importPath));
+    Utils::RocksDBWrapper imported {m_importPath, false};
+    std::string value;
+    EXPECT_TRUE(imported.get("CVE-2", value, COLUMN_NAME));
+}
+
+/*
+ * @brief A version is not available while its files are still being received.
+ */
+TEST_F(FeedDistributionTest, IncompleteVersionNotAvailable)
+{
+    const FeedDistribution distribution {m_distributionPath, m_testPath / "feed_distribution_tmp"};
+    const auto version {distribution.publish(*m_database)};
+
+    // Truncate one of the files of the version, not linked to the database.
+    const auto file {m_distributionPath / version / "CURRENT"};
+    std::ofstream {file, std::ios::trunc} << "x";
+
+    EXPECT_TRUE(distribution.available("").empty());
+
+    // A missing file has the same effect.
+    std::filesystem::remove(file);
+    EXPECT_TRUE(distribution.available("").empty());
+}
+
+/*
+ * @brief An invalid manifest is ignored.
+ */
+TEST_F(FeedDistributionTest, InvalidManifest)
+{
+    const FeedDistribution distribution {m_distributionPath, m_testPath / "feed_distribution_tmp"};
+    std::filesystem::create_directories(m_distributionPath);
+    std::ofstream {m_distributionPath / FEED_DISTRIBUTION_MANIFEST} << "{invalid";
+
+    EXPECT_TRUE(distribution.available("").empty());
+}
@@ -0,0 +1,49 @@
+/*
+ * Wazuh Vulnerability scanner - Database Feed Manager
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _FEED_DISTRIBUTION_TEST_HPP
+#define _FEED_DISTRIBUTION_TEST_HPP
+#include "../../src/databaseFeedManager/feedDistribution.hpp"
+#include "gtest/gtest.h"
+#include <filesystem>
+#include <memory>
+
+/**
+ * @brief This test class contains unit tests for the FeedDistribution class.
+ */
+class FeedDistributionTest : public ::testing::Test
+{
+protected:
+    // LCOV_EXCL_START
+    FeedDistributionTest() = default;
+    ~FeedDistributionTest() override = default;
+    // LCOV_EXCL_STOP
+
+    const std::filesystem::path m_testPath {std::filesystem::temp_directory_path() / "FeedDistributionTest"};
+    const std::filesystem::path m_databasePath {m_testPath / "feed"};
+    const std::filesystem::path m_distributionPath {m_testPath / "feed_distribution"};
+    const std::filesystem::path m_importPath {m_testPath / "feed_import"};
+    std::unique_ptr<Utils::RocksDBWrapper> m_database;
+
+    /**
+     * @brief SetUp.
+     *
+     */
+    void SetUp() override;
+
+    /**
+     * @brief TearDown.
+     *
+     */
+    void TearDown() override;
+};
+
+#endif //_FEED_DISTRIBUTION_TEST_HPP
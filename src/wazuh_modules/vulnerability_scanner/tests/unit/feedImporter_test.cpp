@@ -0,0 +1,120 @@
+/*
+ * Wazuh Vulnerability scanner - Database Feed Manager
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "feedImporter_test.hpp"
+#include <sstream>
+
+namespace NSFeedImporterTest
+{
+    constexpr auto COLUMN_NAME {"column_A"};
+
+    // Stores the payload of each resource, in a column created by the first resource that needs it.
+    const auto STORE_PAYLOAD = [](const nlohmann::json& resource, Utils::IRocksDBWrapper* database)
+    {
+        if (!database->columnExists(COLUMN_NAME))
+        {
+            database->createColumn(COLUMN_NAME);
+        }
+        database->put(resource.at("resource"), resource.at("payload").dump(), COLUMN_NAME);
+    };
+
+    std::stringstream buildSnapshot(const int resources)
+    {
+        std::stringstream snapshot;
+        for (auto i {0}; i < resources; ++i)
+        {
+            snapshot << R"({"name": "CVE-)" << i << R"(", "payload": {"id": )" << i << "}}\n";
+        }
+        return snapshot;
+    }
+} // namespace NSFeedImporterTest
+
+using namespace NSFeedImporterTest;
+
+void FeedImporterTest::SetUp()
+{
+    std::filesystem::remove_all(m_databasePath);
+    m_database = std::make_unique<Utils::RocksDBWrapper>(m_databasePath, false);
+}
+
+void FeedImporterTest::TearDown()
+{
+    m_database.reset();
+    std::filesystem::remove_all(m_databasePath);
+}
+
+/*
+ * @brief Import a snapshot with several workers and a memory budget smaller than the snapshot.
+ */
+TEST_F(FeedImporterTest, ImportSnapshot)
+{
+    constexpr auto RESOURCES {5000};
+    std::atomic<bool> shouldStop {false};
+    auto snapshot {buildSnapshot(RESOURCES)};
+
+    FeedImporter importer {*m_database, STORE_PAYLOAD, shouldStop, 4, 16 * 1024};
+    ASSERT_NO_THROW(importer.import(snapshot, "snapshot.json"));
+
+    std::string value;
+    for (auto i {0}; i < RESOURCES; ++i)
+    {
+        ASSERT_TRUE(m_database->get("CVE-" + std::to_string(i), value, COLUMN_NAME));
+        EXPECT_EQ(nlohmann::json::parse(value).at("id"), i);
+    }
+}
+
+/*
+ * @brief An invalid line stops the import.
+ */
+TEST_F(FeedImporterTest, ImportInvalidLine)
+{
+    std::atomic<bool> shouldStop {false};
+    auto snapshot {buildSnapshot(1000)};
+    snapshot << R"({"field": "value"})" << "\n";
+
+    FeedImporter importer {*m_database, STORE_PAYLOAD, shouldStop, 2};
+    try
+    {
+        importer.import(snapshot, "snapshot.json");
+        FAIL() << "Expected std::runtime_error";
+    }
+    catch (const std::runtime_error& e)
+    {
+        EXPECT_STREQ(e.what(), "Invalid line. file: snapshot.json");
+    }
+}
+
+/*
+ * @brief An error of the orchestration stops the import.
+ */
+TEST_F(FeedImporterTest, ImportOrchestrationError)
+{
+    std::atomic<bool> shouldStop {false};
+    auto snapshot {buildSnapshot(1000)};
+
+    FeedImporter importer {
+        *m_database,
+        [](const nlohmann::json&, Utils::IRocksDBWrapper*) { throw std::runtime_error {"Error"}; },
+        shouldStop};
+    EXPECT_THROW(importer.import(snapshot, "snapshot.json"), std::runtime_error);
+}
+
+/*
+ * @brief The import is interrupted when the module is stopped.
+ */
+TEST_F(FeedImporterTest, ImportStopped)
+{
+    std::atomic<bool> shouldStop {true};
+    auto snapshot {buildSnapshot(1000)};
+
+    FeedImporter importer {*m_database, STORE_PAYLOAD, shouldStop};
+    EXPECT_THROW(importer.import(snapshot, "snapshot.json"), DatabaseFeedManagerException);
+}
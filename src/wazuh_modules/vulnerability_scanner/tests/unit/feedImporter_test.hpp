@@ -0,0 +1,46 @@
+/*
+ * Wazuh Vulnerability scanner - Database Feed Manager
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _FEED_IMPORTER_TEST_HPP
+#define _FEED_IMPORTER_TEST_HPP
+#include "../../src/databaseFeedManager/feedImporter.hpp"
+#include "gtest/gtest.h"
+#include <filesystem>
+#include <memory>
+
+/**
+ * @brief This test class contains unit tests for the FeedImporter class.
+ */
+class FeedImporterTest : public ::testing::Test
+{
+protected:
+    // LCOV_EXCL_START
+    FeedImporterTest() = default;
+    ~FeedImporterTest() override = default;
+    // LCOV_EXCL_STOP
+
+    const std::filesystem::path m_databasePath {std::filesystem::temp_directory_path() / "FeedImporterTest"};
+    std::unique_ptr<Utils::RocksDBWrapper> m_database;
+
+    /**
+     * @brief SetUp.
+     *
+     */
+    void SetUp() override;
+
+    /**
+     * @brief TearDown.
+     *
+     */
+    void TearDown() override;
+};
+
+#endif //_FEED_IMPORTER_TEST_HPP
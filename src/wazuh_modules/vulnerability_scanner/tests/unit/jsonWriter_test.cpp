@@ -0,0 +1,90 @@
+/*
+ * Wazuh Vulnerability Scanner - Unit Tests
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "jsonWriter_test.hpp"
+#include "../scanOrchestrator/jsonWriter.hpp"
+#include "json.hpp"
+#include "numericHelper.h"
+
+TEST_F(JsonWriterTest, SameAsDump)
+{
+    JsonWriter writer;
+    writer.beginObject()
+        .key("agent")
+        .beginObject()
+        .key("id")
+        .string("001")
+        .key("type")
+        .string("wazuh")
+        .endObject()
+        .key("empty")
+        .beginObject()
+        .endObject()
+        .key("indexed")
+        .boolean(false)
+        .key("null")
+        .raw("null")
+        .key("size")
+        .number(UINT64_MAX)
+        .endObject();
+
+    nlohmann::json expected;
+    expected["agent"]["id"] = "001";
+    expected["agent"]["type"] = "wazuh";
+    expected["empty"] = nlohmann::json::object();
+    expected["indexed"] = false;
+    expected["null"] = nullptr;
+    expected["size"] = UINT64_MAX;
+
+    EXPECT_EQ(writer.str(), expected.dump());
+}
+
+TEST_F(JsonWriterTest, Escape)
+{
+    JsonWriter writer;
+    for (const std::string value : {std::string {"quote \" backslash \\ slash /"},
+                                    std::string {"\b\f\n\r\t"},
+                                    std::string {"\x01\x1f\x7f"},
+                                    std::string {"\0 null", 6},
+                                    std::string {"caf\xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80"}})
+    {
+        writer.clear();
+        writer.string(value);
+        EXPECT_EQ(writer.str(), nlohmann::json(value).dump());
+    }
+}
+
+TEST_F(JsonWriterTest, InvalidUtf8)
+{
+    JsonWriter writer;
+    for (const std::string value : {std::string {"\xc3"},
+                                    std::string {"\xc0\xaf"},
+                                    std::string {"\xe0\x80\xaf"},
+                                    std::string {"\xed\xa0\x80"},
+                                    std::string {"\xf4\x90\x80\x80"},
+                                    std::string {"\xff"}})
+    {
+        writer.clear();
+        EXPECT_THROW(writer.string(value), std::invalid_argument);
+        EXPECT_ANY_THROW(nlohmann::json(value).dump());
+    }
+}
+
+TEST_F(JsonWriterTest, FixedNumber)
+{
+    JsonWriter writer;
+    for (const float value : {0.0f, -0.0f, 5.0f, 7.5f, 9.8f, 10.0f, 0.1f, 4.35f, 6.049f, 1234.5678f})
+    {
+        writer.clear();
+        writer.fixedNumber(value, 2);
+        EXPECT_EQ(writer.str(), nlohmann::json(Utils::floatToDoubleRound(value, 2)).dump()) << value;
+    }
+}
@@ -0,0 +1,29 @@
+/*
+ * Wazuh Vulnerability Scanner - Unit Tests
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _JSON_WRITER_TEST_HPP
+#define _JSON_WRITER_TEST_HPP
+
+#include "gtest/gtest.h"
+
+/**
+ * @brief Runs unit tests for JsonWriter
+ */
+class JsonWriterTest : public ::testing::Test
+{
+protected:
+    // LCOV_EXCL_START
+    JsonWriterTest() = default;
+    ~JsonWriterTest() override = default;
+    // LCOV_EXCL_STOP
+};
+
+#endif // _JSON_WRITER_TEST_HPP
@@ -0,0 +1,106 @@
+/*
+ * Wazuh Vulnerability Scanner - Unit Tests
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "packageAgentsIndex_test.hpp"
+#include "packageAgentsIndex.hpp"
+#include <thread>
+
+void PackageAgentsIndexTest::SetUp()
+{
+    PackageAgentsIndex::instance().reset();
+}
+
+void PackageAgentsIndexTest::TearDown()
+{
+    PackageAgentsIndex::instance().reset();
+}
+
+TEST_F(PackageAgentsIndexTest, IncompleteUntilMarked)
+{
+    auto& index {PackageAgentsIndex::instance()};
+    index.add("nvd", "bash", "001");
+
+    std::vector<std::string> agentIds;
+    EXPECT_FALSE(index.agents({{"nvd", "bash"}}, agentIds));
+    EXPECT_TRUE(agentIds.empty());
+
+    index.markComplete();
+    EXPECT_TRUE(index.agents({{"nvd", "bash"}}, agentIds));
+    EXPECT_EQ(agentIds, std::vector<std::string>({"001"}));
+
+    index.reset();
+    EXPECT_FALSE(index.complete());
+}
+
+TEST_F(PackageAgentsIndexTest, AgentsOfChangedPackages)
+{
+    auto& index {PackageAgentsIndex::instance()};
+    index.add("nvd", "bash", "001");
+    index.add("nvd", "bash", "1002");
+    index.add("nvd", "openssl", "002");
+    index.add("canonical", "openssl", "003");
+    index.add("canonical", "bash", "000");
+    index.add("nvd", "bash", "001");
+    index.markComplete();
+
+    std::vector<std::string> agentIds;
+    EXPECT_TRUE(index.agents({{"nvd", "bash"}, {"nvd", "openssl"}}, agentIds));
+    EXPECT_EQ(agentIds, std::vector<std::string>({"001", "002", "1002"}));
+
+    EXPECT_TRUE(index.agents({{"canonical", "bash"}}, agentIds));
+    EXPECT_EQ(agentIds, std::vector<std::string>({"000"}));
+
+    EXPECT_TRUE(index.agents({{"debian", "bash"}}, agentIds));
+    EXPECT_TRUE(agentIds.empty());
+}
+
+TEST_F(PackageAgentsIndexTest, InvalidAgentId)
+{
+    auto& index {PackageAgentsIndex::instance()};
+    index.markComplete();
+    index.add("nvd", "bash", "node01_000");
+
+    std::vector<std::string> agentIds;
+    EXPECT_FALSE(index.agents({{"nvd", "bash"}}, agentIds));
+}
+
+TEST_F(PackageAgentsIndexTest, ConcurrentScans)
+{
+    constexpr auto AGENTS {500};
+    auto& index {PackageAgentsIndex::instance()};
+
+    std::vector<std::thread> threads;
+    for (auto worker {0}; worker < 4; ++worker)
+    {
+        threads.emplace_back(
+            [&index, worker]()
+            {
+                for (auto agent {worker}; agent < AGENTS; agent += 4)
+                {
+                    const auto agentId {std::to_string(agent)};
+                    index.add("nvd", "bash", agentId);
+                    index.add("nvd", "curl", agentId);
+                    index.add("nvd", "bash", agentId);
+                }
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    index.markComplete();
+
+    std::vector<std::string> agentIds;
+    EXPECT_TRUE(index.agents({{"nvd", "bash"}}, agentIds));
+    EXPECT_EQ(agentIds.size(), AGENTS);
+    EXPECT_TRUE(index.agents({{"nvd", "bash"}, {"nvd", "curl"}}, agentIds));
+    EXPECT_EQ(agentIds.size(), AGENTS);
+}
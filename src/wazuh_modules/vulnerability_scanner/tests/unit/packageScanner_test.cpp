@@ -1537,6 +1537,58 @@ TEST_F(PackageScannerTest, TestPackageAffectedEqualToAlma8)
     EXPECT_NO_THROW(packageScanner.handleRequest(scanContextOriginal));
 }
 
+TEST_F(PackageScannerTest, TestPackageCandidatesThroughPrefetch)
+{
+    Os osData {.hostName = "osdata_hostname",
+               .architecture = "osdata_architecture",
+               .name = "osdata_name",
+               .codeName = "upstream",
+               .majorVersion = "8",
+               .minorVersion = "osdata_minorVersion",
+               .patch = "osdata_patch",
+               .build = "osdata_build",
+               .platform = "alma",
+               .version = "osdata_version",
+               .release = "osdata_release",
+               .displayVersion = "osdata_displayVersion",
+               .sysName = "osdata_sysName",
+               .kernelVersion = "osdata_kernelVersion",
+               .kernelRelease = "osdata_kernelRelease"};
+
+    spOsDataCacheMock = std::make_shared<MockOsDataCache>();
+    EXPECT_CALL(*spOsDataCacheMock, getOsData(_)).WillRepeatedly(testing::Return(osData));
+
+    spRemediationDataCacheMock = std::make_shared<MockRemediationDataCache>();
+    EXPECT_CALL(*spRemediationDataCacheMock, getRemediationData(_)).WillRepeatedly(testing::Return(Remediation {}));
+
+    auto spDatabaseFeedManagerMock = std::make_shared<MockDatabaseFeedManager>();
+    EXPECT_CALL(*spDatabaseFeedManagerMock, getCnaNameByFormat(_)).WillOnce(testing::Return("alma"));
+    EXPECT_CALL(*spDatabaseFeedManagerMock, getVulnerabilitiesCandidates("alma_8", _, _, _));
+    EXPECT_CALL(*spDatabaseFeedManagerMock, getVulnerabilitiesCandidates(_, _, _)).Times(0);
+    EXPECT_CALL(*spDatabaseFeedManagerMock, checkAndTranslatePackage(_, _));
+
+    flatbuffers::Parser parser;
+    ASSERT_TRUE(parser.Parse(syscollector_deltas_SCHEMA));
+    ASSERT_TRUE(parser.Parse(DELTA_PACKAGES_INSERTED_MSG.c_str()));
+    uint8_t* buffer = parser.builder_.GetBufferPointer();
+    std::variant<const SyscollectorDeltas::Delta*, const SyscollectorSynchronization::SyncMsg*, const nlohmann::json*>
+        syscollectorDelta = SyscollectorDeltas::GetDelta(reinterpret_cast<const char*>(buffer));
+    auto scanContextOriginal = std::make_shared<TrampolineScanContext>(syscollectorDelta);
+    scanContextOriginal->m_candidatesPrefetch =
+        std::make_shared<CandidatesPrefetch>(std::vector<std::string> {scanContextOriginal->packageName().data()});
+
+    spGlobalDataMock = std::make_shared<MockGlobalData>();
+    EXPECT_CALL(*spGlobalDataMock, cnaMappings()).WillOnce(testing::Return(CNA_MAPPINGS));
+
+    TPackageScanner<MockDatabaseFeedManager,
+                    TrampolineScanContext,
+                    TrampolineGlobalData,
+                    TrampolineRemediationDataCache>
+        packageScanner(spDatabaseFeedManagerMock);
+
+    EXPECT_NO_THROW(packageScanner.handleRequest(scanContextOriginal));
+}
+
 TEST_F(PackageScannerTest, TestPackageAffectedEqualToAlas1)
 {
     Os osData {.hostName = "osdata_hostname",
@@ -256,6 +256,50 @@ TEST_F(PolicyManagerTest, validConfigurationNoCluster)
     EXPECT_NO_THROW(m_policyManager->initialize(configJson));
 }
 
+TEST_F(PolicyManagerTest, validConfigurationFeedDistribution)
+{
+    auto configJson {nlohmann::json::parse(R"({
+      "vulnerability-detection": {
+        "enabled": "yes",
+        "index-status": "no",
+        "cti-url": "https://cti-url.com",
+        "feed-distribution": "yes"
+      },
+      "clusterName":"clusterName",
+      "clusterEnabled":true,
+      "clusterNodeType":"worker"
+    })")};
+    EXPECT_NO_THROW(m_policyManager->initialize(configJson));
+    EXPECT_TRUE(m_policyManager->isFeedDistributionEnabled());
+    EXPECT_TRUE(m_policyManager->isFeedDistributionWorker());
+
+    configJson["clusterNodeType"] = "master";
+    EXPECT_NO_THROW(m_policyManager->initialize(configJson));
+    EXPECT_TRUE(m_policyManager->isFeedDistributionEnabled());
+    EXPECT_FALSE(m_policyManager->isFeedDistributionWorker());
+
+    // The feed is not distributed out of a cluster.
+    configJson["clusterEnabled"] = false;
+    EXPECT_NO_THROW(m_policyManager->initialize(configJson));
+    EXPECT_FALSE(m_policyManager->isFeedDistributionEnabled());
+    EXPECT_FALSE(m_policyManager->isFeedDistributionWorker());
+}
+
+TEST_F(PolicyManagerTest, invalidConfigurationFeedDistribution)
+{
+    const auto& configJson {nlohmann::json::parse(R"({
+      "vulnerability-detection": {
+        "enabled": "yes",
+        "index-status": "no",
+        "cti-url": "https://cti-url.com",
+        "feed-distribution": "sometimes"
+      },
+      "clusterName":"clusterName",
+      "clusterEnabled":true
+    })")};
+    EXPECT_THROW(m_policyManager->validateConfiguration(configJson), std::runtime_error);
+}
+
 TEST_F(PolicyManagerTest, invalidConfigurationNoCTIUrl)
 {
     const auto& configJson {nlohmann::json::parse(R"({
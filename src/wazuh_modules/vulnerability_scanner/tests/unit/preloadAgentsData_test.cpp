@@ -0,0 +1,105 @@
+/*
+ * Wazuh Vulnerability Scanner - Unit Tests
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "preloadAgentsData_test.hpp"
+#include "TrampolineOsDataCache.hpp"
+#include "TrampolineRemediationDataCache.hpp"
+#include "TrampolineSocketDBWrapper.hpp"
+#include "preloadAgentsData.hpp"
+#include "shared_modules/utils/mocks/chainOfResponsabilityMock.h"
+#include "socketDBWrapperException.hpp"
+
+using TrampolineScanContext = TScanContext<TrampolineOsDataCache, GlobalData, TrampolineRemediationDataCache>;
+using TestedPreloadAgentsData =
+    TPreloadAgentsData<TrampolineScanContext, TrampolineSocketDBWrapper, TrampolineRemediationDataCache>;
+
+const std::string EXPECTED_QUERY_WINDOWS_AGENTS {"global sql SELECT * FROM agent WHERE os_platform = 'windows' "};
+
+TEST_F(PreloadAgentsDataTest, PreloadWindowsAgentsInList)
+{
+    spSocketDBWrapperMock = std::make_shared<MockSocketDBWrapper>();
+    EXPECT_CALL(*spSocketDBWrapperMock, query(EXPECTED_QUERY_WINDOWS_AGENTS, testing::_))
+        .Times(1)
+        .WillOnce(testing::SetArgReferee<1>(R"([{"id": 1}, {"id": 3}, {"id": 12}])"_json));
+
+    spRemediationDataCacheMock = std::make_shared<MockRemediationDataCache>();
+    EXPECT_CALL(*spRemediationDataCacheMock, preload(std::vector<std::string> {"001", "003"}))
+        .Times(1)
+        .WillOnce(testing::Return(2));
+    EXPECT_CALL(*spRemediationDataCacheMock, size()).WillRepeatedly(testing::Return(2));
+    EXPECT_CALL(*spRemediationDataCacheMock, stats()).WillRepeatedly(testing::Return(LRUCacheStats {}));
+
+    auto spNextMock = std::make_shared<MockAbstractHandler<std::shared_ptr<TrampolineScanContext>>>();
+    EXPECT_CALL(*spNextMock, handleRequest(testing::_)).Times(1);
+
+    auto preloadAgentsData = std::make_shared<TestedPreloadAgentsData>();
+    preloadAgentsData->setLast(spNextMock);
+
+    auto scanContext = std::make_shared<TrampolineScanContext>();
+    scanContext->m_agents.push_back({"001", "agent1", "4.8.0", "192.168.0.1"});
+    scanContext->m_agents.push_back({"002", "agent2", "4.8.0", "192.168.0.2"});
+    scanContext->m_agents.push_back({"003", "agent3", "4.8.0", "192.168.0.3"});
+
+    preloadAgentsData->handleRequest(scanContext);
+
+    spSocketDBWrapperMock.reset();
+    spRemediationDataCacheMock.reset();
+}
+
+TEST_F(PreloadAgentsDataTest, NoWindowsAgents)
+{
+    spSocketDBWrapperMock = std::make_shared<MockSocketDBWrapper>();
+    EXPECT_CALL(*spSocketDBWrapperMock, query(EXPECTED_QUERY_WINDOWS_AGENTS, testing::_))
+        .Times(1)
+        .WillOnce(testing::SetArgReferee<1>(nlohmann::json::array()));
+
+    spRemediationDataCacheMock = std::make_shared<MockRemediationDataCache>();
+    EXPECT_CALL(*spRemediationDataCacheMock, preload(testing::_)).Times(0);
+
+    auto spNextMock = std::make_shared<MockAbstractHandler<std::shared_ptr<TrampolineScanContext>>>();
+    EXPECT_CALL(*spNextMock, handleRequest(testing::_)).Times(1);
+
+    auto preloadAgentsData = std::make_shared<TestedPreloadAgentsData>();
+    preloadAgentsData->setLast(spNextMock);
+
+    auto scanContext = std::make_shared<TrampolineScanContext>();
+    scanContext->m_agents.push_back({"001", "agent1", "4.8.0", "192.168.0.1"});
+
+    preloadAgentsData->handleRequest(scanContext);
+
+    spSocketDBWrapperMock.reset();
+    spRemediationDataCacheMock.reset();
+}
+
+TEST_F(PreloadAgentsDataTest, ExceptionOnDBContinuesTheChain)
+{
+    spSocketDBWrapperMock = std::make_shared<MockSocketDBWrapper>();
+    EXPECT_CALL(*spSocketDBWrapperMock, query(EXPECTED_QUERY_WINDOWS_AGENTS, testing::_))
+        .Times(1)
+        .WillOnce(testing::Throw(SocketDbWrapperException("Error on DB")));
+
+    spRemediationDataCacheMock = std::make_shared<MockRemediationDataCache>();
+    EXPECT_CALL(*spRemediationDataCacheMock, preload(testing::_)).Times(0);
+
+    auto spNextMock = std::make_shared<MockAbstractHandler<std::shared_ptr<TrampolineScanContext>>>();
+    EXPECT_CALL(*spNextMock, handleRequest(testing::_)).Times(1);
+
+    auto preloadAgentsData = std::make_shared<TestedPreloadAgentsData>();
+    preloadAgentsData->setLast(spNextMock);
+
+    auto scanContext = std::make_shared<TrampolineScanContext>();
+    scanContext->m_agents.push_back({"001", "agent1", "4.8.0", "192.168.0.1"});
+
+    EXPECT_NO_THROW(preloadAgentsData->handleRequest(scanContext));
+
+    spSocketDBWrapperMock.reset();
+    spRemediationDataCacheMock.reset();
+}
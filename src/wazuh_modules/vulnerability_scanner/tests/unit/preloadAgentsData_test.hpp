@@ -0,0 +1,41 @@
+/*
+ * Wazuh Vulnerability Scanner - Unit Tests
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _PRELOAD_AGENTS_DATA_TEST_HPP
+#define _PRELOAD_AGENTS_DATA_TEST_HPP
+
+#include "gtest/gtest.h"
+
+/**
+ * @brief Runs unit tests for PreloadAgentsData
+ */
+class PreloadAgentsDataTest : public ::testing::Test
+{
+protected:
+    // LCOV_EXCL_START
+    PreloadAgentsDataTest() = default;
+    ~PreloadAgentsDataTest() override = default;
+
+    /**
+     * @brief Set the environment for testing.
+     *
+     */
+    void SetUp() override {}
+
+    /**
+     * @brief Clean the environment after testing.
+     *
+     */
+    void TearDown() override {}
+    // LCOV_EXCL_STOP
+};
+
+#endif // _PRELOAD_AGENTS_DATA_TEST_HPP
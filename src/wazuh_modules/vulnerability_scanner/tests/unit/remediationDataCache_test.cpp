@@ -174,3 +174,80 @@ TEST_F(RemediationDataCacheTest, RecoverableExceptionOnDB)
     EXPECT_THROW(cache.getRemediationData(agentId), WdbDataException);
     spSocketDBWrapperMock.reset();
 }
+
+TEST_F(RemediationDataCacheTest, EmptyResponseIsCached)
+{
+    RemediationDataCache<TrampolineSocketDBWrapper> cache;
+    spSocketDBWrapperMock = std::make_shared<MockSocketDBWrapper>();
+
+    EXPECT_CALL(*spSocketDBWrapperMock, query(testing::_, testing::_))
+        .Times(1)
+        .WillOnce(testing::SetArgReferee<1>(nlohmann::json::array()));
+
+    std::string agentId {"1"};
+
+    // The second lookup doesn't query the agent again.
+    EXPECT_TRUE(remediationsAreEqual(cache.getRemediationData(agentId), Remediation {}));
+    EXPECT_TRUE(remediationsAreEqual(cache.getRemediationData(agentId), Remediation {}));
+
+    // The hotfixes installed later are merged.
+    cache.addRemediationData(agentId, Remediation {.hotfixes = {"hotfix1"}});
+    EXPECT_TRUE(remediationsAreEqual(cache.getRemediationData(agentId), Remediation {.hotfixes = {"hotfix1"}}));
+}
+
+TEST_F(RemediationDataCacheTest, PreloadSkipsCachedAndFailedAgents)
+{
+    RemediationDataCache<TrampolineSocketDBWrapper> cache;
+    spSocketDBWrapperMock = std::make_shared<MockSocketDBWrapper>();
+
+    cache.addRemediationData("1", Remediation {.hotfixes = {"hotfix1"}});
+
+    EXPECT_CALL(*spSocketDBWrapperMock, query("agent 2 hotfix get ", testing::_))
+        .Times(1)
+        .WillOnce(testing::SetArgReferee<1>(R"([{"hotfix": "hotfix2"}])"_json));
+    EXPECT_CALL(*spSocketDBWrapperMock, query("agent 3 hotfix get ", testing::_))
+        .Times(2)
+        .WillOnce(testing::Throw(SocketDbWrapperException("Warning on DB")))
+        .WillOnce(testing::SetArgReferee<1>(R"([{"hotfix": "hotfix3"}])"_json));
+
+    EXPECT_EQ(cache.preload({"1", "2", "3"}), 1);
+    EXPECT_EQ(cache.size(), 2);
+
+    // The preloaded agent isn't queried again, the failed one is queried by its scan.
+    EXPECT_TRUE(remediationsAreEqual(cache.getRemediationData("2"), Remediation {.hotfixes = {"hotfix2"}}));
+    EXPECT_TRUE(remediationsAreEqual(cache.getRemediationData("3"), Remediation {.hotfixes = {"hotfix3"}}));
+
+    const auto stats = cache.stats();
+    EXPECT_EQ(stats.hits, 1);
+    EXPECT_EQ(stats.misses, 2);
+    spSocketDBWrapperMock.reset();
+}
+
+TEST_F(RemediationDataCacheTest, PreloadStopsWhenFull)
+{
+    PolicyManager::instance().teardown();
+    PolicyManager::instance().initialize(nlohmann::json::parse(R"(
+        {
+            "vulnerability-detection": {
+                "enabled": "yes",
+                "index-status": "yes",
+                "cti-url": "cti-url.com"
+            },
+            "remediationLRUSize":1,
+            "clusterName":"cluster01",
+            "clusterEnabled":false
+        })"));
+
+    RemediationDataCache<TrampolineSocketDBWrapper> cache;
+    spSocketDBWrapperMock = std::make_shared<MockSocketDBWrapper>();
+
+    EXPECT_CALL(*spSocketDBWrapperMock, query(testing::_, testing::_))
+        .Times(1)
+        .WillOnce(testing::SetArgReferee<1>(nlohmann::json::array()));
+
+    // The second agent would evict the agent loaded before.
+    EXPECT_EQ(cache.preload({"1", "2", "3"}), 1);
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_EQ(cache.stats().evictions, 0);
+    spSocketDBWrapperMock.reset();
+}
@@ -125,6 +125,48 @@ TEST_F(ResultIndexerTest, TestHandleRequest)
     EXPECT_NO_THROW(spResultIndexer->handleRequest(scanContextOriginal));
 }
 
+TEST_F(ResultIndexerTest, TestHandleRequestElementData)
+{
+    auto elementValue = nlohmann::json::parse(R"({"id": "id_test","operation":"INSERTED"})");
+    const std::string elementData {R"({"agent":{"id":"001","type":"wazuh"},"vulnerability":{"score":{"base":7.5}}})"};
+
+    // The element is published as it would be serialized with its document.
+    auto expected = elementValue;
+    expected["data"] = nlohmann::json::parse(elementData);
+    expected["no-index"] = true;
+
+    spIndexerConnectorMock = std::make_shared<MockIndexerConnector>();
+    EXPECT_CALL(*spIndexerConnectorMock, publish(expected.dump())).Times(1);
+
+    auto pIndexerConnectorTrap = std::make_shared<TrampolineIndexerConnector>();
+
+    spOsDataCacheMock = std::make_shared<MockOsDataCache>();
+    EXPECT_CALL(*spOsDataCacheMock, getOsData(_)).WillRepeatedly(testing::Return(Os {}));
+
+    spRemediationDataCacheMock = std::make_shared<MockRemediationDataCache>();
+    EXPECT_CALL(*spRemediationDataCacheMock, getRemediationData(_)).WillRepeatedly(testing::Return(Remediation {}));
+
+    flatbuffers::Parser parser;
+    ASSERT_TRUE(parser.Parse(syscollector_deltas_SCHEMA));
+    ASSERT_TRUE(parser.Parse(DELTA_PACKAGES_INSERTED_MSG.c_str()));
+    uint8_t* buffer = parser.builder_.GetBufferPointer();
+    std::variant<const SyscollectorDeltas::Delta*, const SyscollectorSynchronization::SyncMsg*, const nlohmann::json*>
+        syscollectorDelta = SyscollectorDeltas::GetDelta(reinterpret_cast<const char*>(buffer));
+    auto scanContextOriginal =
+        std::make_shared<TScanContext<TrampolineOsDataCache, GlobalData, TrampolineRemediationDataCache>>(
+            syscollectorDelta);
+    scanContextOriginal->m_elements[CVEID] = elementValue;
+    scanContextOriginal->m_elementsData[CVEID] = elementData;
+    scanContextOriginal->m_noIndex = true;
+
+    auto spResultIndexer = std::make_shared<
+        TResultIndexer<TrampolineIndexerConnector,
+                       TScanContext<TrampolineOsDataCache, GlobalData, TrampolineRemediationDataCache>>>(
+        pIndexerConnectorTrap);
+
+    EXPECT_NO_THROW(spResultIndexer->handleRequest(scanContextOriginal));
+}
+
 TEST_F(ResultIndexerTest, TestHandleRequestNoOperation)
 {
     auto elementValue = nlohmann::json::parse(R"({"id": "id_test"})");
@@ -379,3 +379,82 @@ TEST_F(ScanAgentListTest, DISABLED_InsertAllTestNotSyncedResponse)
 
     scanAgentList->handleRequest(contextData);
 }
+
+TEST_F(ScanAgentListTest, ConcurrentAgentsWithRecoverableException)
+{
+    spSocketDBWrapperMock = std::make_shared<MockSocketDBWrapper>();
+
+    Os osData {.hostName = "osdata_hostname",
+               .architecture = "osdata_architecture",
+               .name = "osdata_name",
+               .codeName = "upstream",
+               .majorVersion = "osdata_majorVersion",
+               .minorVersion = "osdata_minorVersion",
+               .patch = "osdata_patch",
+               .build = "osdata_build",
+               .platform = "osdata_platform",
+               .version = "osdata_version",
+               .release = "osdata_release",
+               .displayVersion = "osdata_displayVersion",
+               .sysName = "osdata_sysName",
+               .kernelVersion = "osdata_kernelVersion",
+               .kernelRelease = "osdata_kernelRelease"};
+
+    spOsDataCacheMock = std::make_shared<MockOsDataCache>();
+    EXPECT_CALL(*spOsDataCacheMock, getOsData(testing::_)).WillRepeatedly(testing::Return(osData));
+    EXPECT_CALL(*spOsDataCacheMock, setOsData(_, _)).Times(3);
+
+    spRemediationDataCacheMock = std::make_shared<MockRemediationDataCache>();
+    EXPECT_CALL(*spRemediationDataCacheMock, getRemediationData(testing::_))
+        .WillRepeatedly(testing::Return(Remediation {}));
+
+    auto spPackageInsertOrchestrationMock =
+        std::make_shared<MockAbstractHandler<std::shared_ptr<TrampolineScanContext>>>();
+    auto spOsOrchestrationMock = std::make_shared<MockAbstractHandler<std::shared_ptr<TrampolineScanContext>>>();
+
+    // Two packages for each of the three agents that are scanned, the fourth one fails.
+    EXPECT_CALL(*spPackageInsertOrchestrationMock, handleRequest(testing::_)).Times(6);
+    EXPECT_CALL(*spOsOrchestrationMock, handleRequest(testing::_)).Times(3);
+
+    auto scanAgentList = std::make_shared<TScanAgentList<TrampolineScanContext,
+                                                         MockAbstractHandler<std::shared_ptr<TrampolineScanContext>>,
+                                                         TrampolineSocketDBWrapper>>(
+        spPackageInsertOrchestrationMock, spOsOrchestrationMock, 4);
+
+    for (const auto* agentId : {"001", "002", "004"})
+    {
+        EXPECT_CALL(*spSocketDBWrapperMock, query(std::string("agent ") + agentId + " osinfo get ", testing::_))
+            .Times(1)
+            .WillOnce(testing::SetArgReferee<1>(nlohmann::json::parse(OS_RESPONSE)));
+        EXPECT_CALL(*spSocketDBWrapperMock, query(std::string("agent ") + agentId + " package get ", testing::_))
+            .Times(1)
+            .WillOnce(testing::SetArgReferee<1>(nlohmann::json::parse(PACKAGES_RESPONSE)));
+    }
+    EXPECT_CALL(*spSocketDBWrapperMock, query("agent 003 osinfo get ", testing::_))
+        .Times(1)
+        .WillOnce(testing::Throw(SocketDbWrapperException("Temporal error on DB")));
+
+    nlohmann::json jsonData = nlohmann::json::parse(
+        R"({"agent_info":  {"agent_id":"001",  "agent_version":"4.8.0",  "agent_name":"test_agent_name",  "agent_ip":"10.0.0.1",  "node_name":"node01"},  "action":"upgradeAgentDB"})");
+
+    std::variant<const SyscollectorDeltas::Delta*, const SyscollectorSynchronization::SyncMsg*, const nlohmann::json*>
+        data = &jsonData;
+
+    auto contextData = std::make_shared<TrampolineScanContext>(data);
+    contextData->m_agents.push_back({"001", "test_agent_name_1", "4.8.0", "192.168.0.1"});
+    contextData->m_agents.push_back({"002", "test_agent_name_2", "4.8.0", "192.168.0.2"});
+    contextData->m_agents.push_back({"003", "test_agent_name_3", "4.8.0", "192.168.0.3"});
+    contextData->m_agents.push_back({"004", "test_agent_name_4", "4.8.0", "192.168.0.4"});
+
+    try
+    {
+        scanAgentList->handleRequest(contextData);
+        FAIL() << "Expected AgentReScanListException";
+    }
+    catch (const AgentReScanListException& e)
+    {
+        ASSERT_EQ(e.agentList().size(), 1);
+        EXPECT_EQ(e.agentList().front().id, "003");
+    }
+    spSocketDBWrapperMock.reset();
+}
@@ -0,0 +1,138 @@
+/*
+ * Wazuh Vulnerability Scanner - Unit Tests
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#include "scannerMetrics_test.hpp"
+#include "chainOfResponsability.hpp"
+#include "scannerMetrics.hpp"
+#include "timedStage.hpp"
+#include <thread>
+#include <vector>
+
+void ScannerMetricsTest::SetUp()
+{
+    ScannerMetrics::instance().reset();
+}
+
+void ScannerMetricsTest::TearDown()
+{
+    ScannerMetrics::instance().removeGauge("test.gauge");
+    ScannerMetrics::instance().reset();
+}
+
+TEST_F(ScannerMetricsTest, HistogramSummary)
+{
+    auto& histogram {ScannerMetrics::instance().histogram("test.histogram")};
+    EXPECT_EQ(&histogram, &ScannerMetrics::instance().histogram("test.histogram"));
+
+    for (auto i = 0; i < 98; ++i)
+    {
+        histogram.record(std::chrono::microseconds(10));
+    }
+    histogram.record(std::chrono::microseconds(1000));
+    histogram.record(std::chrono::microseconds(100000));
+
+    const auto summary = ScannerMetrics::instance().dump().at("histograms").at("test.histogram");
+    EXPECT_EQ(summary.at("count"), 100);
+    EXPECT_EQ(summary.at("sum_us"), 98 * 10 + 1000 + 100000);
+    EXPECT_EQ(summary.at("mean_us"), (98 * 10 + 1000 + 100000) / 100);
+    EXPECT_EQ(summary.at("max_us"), 100000);
+    // The percentiles are the upper bounds of their buckets.
+    EXPECT_EQ(summary.at("p50_us"), 16);
+    EXPECT_EQ(summary.at("p90_us"), 16);
+    EXPECT_EQ(summary.at("p99_us"), 1024);
+}
+
+TEST_F(ScannerMetricsTest, EmptyHistogram)
+{
+    ScannerMetrics::instance().histogram("test.histogram");
+
+    const auto summary = ScannerMetrics::instance().dump().at("histograms").at("test.histogram");
+    EXPECT_EQ(summary.at("count"), 0);
+    EXPECT_EQ(summary.at("mean_us"), 0);
+    EXPECT_EQ(summary.at("p99_us"), 0);
+}
+
+TEST_F(ScannerMetricsTest, CountersAndGauges)
+{
+    auto& counter {ScannerMetrics::instance().counter("test.counter")};
+    std::vector<std::thread> threads;
+    for (auto i = 0; i < 4; ++i)
+    {
+        threads.emplace_back(
+            [&counter]()
+            {
+                for (auto j = 0; j < 1000; ++j)
+                {
+                    counter.fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    uint64_t depth {3};
+    ScannerMetrics::instance().gauge("test.gauge", [&depth]() { return depth; });
+    auto metrics = ScannerMetrics::instance().dump();
+    EXPECT_EQ(metrics.at("counters").at("test.counter"), 4000);
+    EXPECT_EQ(metrics.at("gauges").at("test.gauge"), 3);
+
+    depth = 5;
+    EXPECT_EQ(ScannerMetrics::instance().dump().at("gauges").at("test.gauge"), 5);
+
+    ScannerMetrics::instance().removeGauge("test.gauge");
+    ScannerMetrics::instance().reset();
+    metrics = ScannerMetrics::instance().dump();
+    EXPECT_FALSE(metrics.at("gauges").contains("test.gauge"));
+    EXPECT_EQ(metrics.at("counters").at("test.counter"), 0);
+}
+
+TEST_F(ScannerMetricsTest, TimedStageRecordsTheStep)
+{
+    using Context = std::vector<int>;
+
+    class Step final : public AbstractHandler<std::shared_ptr<Context>>
+    {
+        int m_id;
+
+    public:
+        explicit Step(int id)
+            : m_id(id)
+        {
+        }
+
+        std::shared_ptr<Context> handleRequest(std::shared_ptr<Context> data) override
+        {
+            if (m_id < 0)
+            {
+                return nullptr;
+            }
+            data->push_back(m_id);
+            return AbstractHandler<std::shared_ptr<Context>>::handleRequest(std::move(data));
+        }
+    };
+
+    auto chain {std::make_shared<TTimedStage<Context>>("test.first", std::make_shared<Step>(1))};
+    chain->setLast(std::make_shared<TTimedStage<Context>>("test.second", std::make_shared<Step>(2)));
+
+    const auto context {std::make_shared<Context>()};
+    EXPECT_EQ(chain->handleRequest(context), context);
+    EXPECT_EQ(*context, Context({1, 2}));
+
+    // A step that stops the chain is recorded, and the next steps aren't run.
+    auto stopped {std::make_shared<TTimedStage<Context>>("test.first", std::make_shared<Step>(-1))};
+    stopped->setLast(std::make_shared<TTimedStage<Context>>("test.second", std::make_shared<Step>(2)));
+    EXPECT_EQ(stopped->handleRequest(std::make_shared<Context>()), nullptr);
+
+    EXPECT_EQ(ScannerMetrics::instance().histogram("test.first").count(), 2u);
+    EXPECT_EQ(ScannerMetrics::instance().histogram("test.second").count(), 1u);
+}
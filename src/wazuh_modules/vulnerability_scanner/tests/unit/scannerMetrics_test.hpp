@@ -0,0 +1,39 @@
+/*
+ * Wazuh Vulnerability Scanner - Unit Tests
+ * Copyright (C) 2015, Wazuh Inc.
+ * October 15, 2026.
+ *
+ * This program is free software; you can redistribute it
+ * and/or modify it under the terms of the GNU General Public
+ * License (version 2) as published by the FSF - Free Software
+ * Foundation.
+ */
+
+#ifndef _SCANNER_METRICS_TEST_HPP
+#define _SCANNER_METRICS_TEST_HPP
+
+#include "gtest/gtest.h"
+
+/**
+ * @brief ScannerMetrics test class.
+ */
+class ScannerMetricsTest : public ::testing::Test
+{
+protected:
+    ScannerMetricsTest() = default;
+    ~ScannerMetricsTest() override = default;
+
+    /**
+     * @brief Set the environment for testing.
+     *
+     */
+    void SetUp() override;
+
+    /**
+     * @brief Clean the environment after testing.
+     *
+     */
+    void TearDown() override;
+};
+
+#endif // _SCANNER_METRICS_TEST_HPP
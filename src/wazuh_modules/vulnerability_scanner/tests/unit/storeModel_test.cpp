@@ -199,6 +199,37 @@ TEST_F(StoreModelTest, TestHandleRequestCreate)
     EXPECT_NO_THROW(storeModel->handleRequest(eventContext));
 }
 
+/*
+ * @brief Test handleRequest of the StoreModel class with the creation of a rejected entry.
+ */
+TEST_F(StoreModelTest, TestHandleRequestCreateRejected)
+{
+    std::vector<char> message;
+    nlohmann::json resource;
+    resource["type"] = "create";
+
+    flatbuffers::Parser parser;
+    ASSERT_TRUE(parser.Parse(cve5_SCHEMA) && parser.Parse(CVE5_ENTRY_REJECTED.c_str()));
+
+    flatbuffers::FlatBufferBuilder& builder = parser.builder_;
+
+    auto feedDatabase = std::make_unique<Utils::RocksDBWrapper>("temp");
+    auto eventContext = std::make_shared<EventContext>(EventContext {.message = message,
+                                                                     .resource = resource,
+                                                                     .feedDatabase = feedDatabase.get(),
+                                                                     .resourceType = ResourceType::CVE});
+
+    eventContext->cve5Buffer = builder.Release();
+
+    std::shared_ptr<StoreModel> storeModel;
+
+    // Instantiation of the StoreModel class.
+    EXPECT_NO_THROW(storeModel = std::make_shared<StoreModel>());
+
+    // HandleRequest
+    EXPECT_NO_THROW(storeModel->handleRequest(eventContext));
+}
+
 TEST_F(StoreModelTest, TestHandleRequestUpdate)
 {
     std::vector<char> message;
@@ -1441,3 +1441,48 @@ TEST_F(UpdateCVECandidatesTest, RemoveCandidatesSeparator)
     EXPECT_TRUE(
         m_feedDatabase->get("CVE-2020-13520_openusd", slice, std::string(CVE_PACKAGE_COLUMN_NAME_PREFIX) + "_nvd"));
 }
+
+TEST_F(UpdateCVECandidatesTest, FeedDeltaPackages)
+{
+    std::string cve5FlatbufferSchemaStr;
+
+    // Read schemas from filesystem.
+    bool valid = flatbuffers::LoadFile(CVE5_FLATBUFFER_SCHEMA_PATH.c_str(), false, &cve5FlatbufferSchemaStr);
+    ASSERT_EQ(valid, true);
+
+    // Parse schemas and JSON example.
+    flatbuffers::Parser parser;
+    valid = (parser.Parse(cve5FlatbufferSchemaStr.c_str(), INCLUDE_DIRECTORIES) && parser.Parse(CVE_INPUT_2.c_str()));
+    ASSERT_EQ(valid, true);
+
+    // Verify flatbuffer.
+    flatbuffers::Verifier verifierCVE5(parser.builder_.GetBufferPointer(), parser.builder_.GetSize());
+    ASSERT_EQ(cve_v5::VerifyEntryBuffer(verifierCVE5), true);
+    const cve_v5::Entry* cve5Flatbuffer = cve_v5::GetEntry(parser.builder_.GetBufferPointer());
+
+    const std::set<std::pair<std::string, std::string>> expectedCandidates {
+        {"canonical", "bash"}, {"canonical", "kernel"}, {"debian", "bash"}, {"debian", "firefox"}, {"nvd", "bash"}};
+
+    // The stored packages are added to the delta.
+    FeedDelta storeDelta;
+    UpdateCVECandidates::storeVulnerabilityCandidate(cve5Flatbuffer, m_feedDatabase.get(), &storeDelta);
+    EXPECT_FALSE(storeDelta.full());
+    EXPECT_EQ(storeDelta.candidates(), expectedCandidates);
+
+    // Storing the same candidates again still reports the packages.
+    FeedDelta sameDelta;
+    UpdateCVECandidates::storeVulnerabilityCandidate(cve5Flatbuffer, m_feedDatabase.get(), &sameDelta);
+    EXPECT_EQ(sameDelta.candidates(), expectedCandidates);
+
+    // The removed packages are added to the delta.
+    FeedDelta removeDelta;
+    UpdateCVECandidates::removeVulnerabilityCandidate(cve5Flatbuffer, m_feedDatabase.get(), &removeDelta);
+    EXPECT_EQ(removeDelta.candidates(), expectedCandidates);
+
+    // A full delta doesn't track the packages.
+    FeedDelta fullDelta;
+    fullDelta.markFull();
+    UpdateCVECandidates::storeVulnerabilityCandidate(cve5Flatbuffer, m_feedDatabase.get(), &fullDelta);
+    EXPECT_TRUE(fullDelta.full());
+    EXPECT_TRUE(fullDelta.candidates().empty());
+}
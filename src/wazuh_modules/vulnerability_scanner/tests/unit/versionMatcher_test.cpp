@@ -907,3 +907,64 @@ TEST_F(VersionMatcherTest, matchRPM)
 
     EXPECT_NO_THROW(VersionMatcher::compare("invalid", "3:2.3.15-24.el8", VersionObjectType::RPM));
 }
+
+TEST_F(VersionMatcherTest, parsedVersions)
+{
+    const auto parsedA {VersionMatcher::parse("1.2.3", VersionObjectType::SemVer)};
+    const auto parsedB {VersionMatcher::parse("1.10.0", VersionObjectType::SemVer)};
+    EXPECT_EQ(parsedA.str(), "1.2.3");
+    EXPECT_EQ(VersionMatcher::compare(parsedA, parsedB), VersionComparisonResult::A_LESS_THAN_B);
+    EXPECT_EQ(VersionMatcher::compare(parsedB, parsedA), VersionComparisonResult::A_GREATER_THAN_B);
+    EXPECT_EQ(VersionMatcher::compare(parsedA, parsedA), VersionComparisonResult::A_EQUAL_B);
+
+    // The same version is parsed once and compared many times.
+    VersionMatcher::ParsedVersions parsedVersions {VersionMatcherStrategy::Unspecified};
+    const auto& installed {parsedVersions.get("2023.11.02.1")};
+    EXPECT_EQ(&installed, &parsedVersions.get("2023.11.02.1"));
+    EXPECT_EQ(VersionMatcher::compare(installed, parsedVersions.get("2023.11.02.2")),
+              VersionComparisonResult::A_LESS_THAN_B);
+    EXPECT_EQ(VersionMatcher::compare(installed, parsedVersions.get("2023.11.01")),
+              VersionComparisonResult::A_GREATER_THAN_B);
+
+    // A version that doesn't match the type can't be compared.
+    const auto invalid {VersionMatcher::parse("invalid", VersionObjectType::SemVer)};
+    EXPECT_THROW(VersionMatcher::compare(parsedA, invalid), std::invalid_argument);
+}
+
+TEST_F(VersionMatcherTest, versionIntervalIndex)
+{
+    VersionMatcher::ParsedVersions parsedVersions {VersionObjectType::SemVer};
+    VersionIntervalIndex index;
+
+    for (const auto* version : {"1.0.0", "2.0.0", "3.0.0", "1.5.0"})
+    {
+        ASSERT_TRUE(index.accepts(parsedVersions.get(version)));
+    }
+    EXPECT_FALSE(index.accepts(parsedVersions.get("invalid")));
+
+    // [1.0.0, 2.0.0), [1.5.0, 3.0.0], (-inf, 1.0.0], {2.0.0} and [1.0.0, +inf).
+    index.addRange(0, parsedVersions.get("1.0.0"), parsedVersions.get("2.0.0"), false);
+    index.addRange(1, parsedVersions.get("1.5.0"), parsedVersions.get("3.0.0"), true);
+    index.addRange(2, std::nullopt, parsedVersions.get("1.0.0"), true);
+    index.addExact(3, parsedVersions.get("2.0.0"));
+    index.addRange(4, parsedVersions.get("1.0.0"), std::nullopt, false);
+    index.build();
+
+    const auto find = [&](const std::string& version)
+    {
+        const auto* intervals {index.find(parsedVersions.get(version))};
+        return intervals ? *intervals : std::vector<size_t> {99};
+    };
+
+    EXPECT_EQ(find("0.5.0"), (std::vector<size_t> {2}));
+    EXPECT_EQ(find("1.0.0"), (std::vector<size_t> {0, 2, 4}));
+    EXPECT_EQ(find("1.2.0"), (std::vector<size_t> {0, 4}));
+    EXPECT_EQ(find("1.5.0"), (std::vector<size_t> {0, 1, 4}));
+    EXPECT_EQ(find("2.0.0"), (std::vector<size_t> {1, 3, 4}));
+    EXPECT_EQ(find("3.0.0"), (std::vector<size_t> {1, 4}));
+    EXPECT_EQ(find("4.0.0"), (std::vector<size_t> {4}));
+
+    // A version that can't be compared with the endpoints isn't found.
+    EXPECT_EQ(find("invalid"), (std::vector<size_t> {99}));
+    EXPECT_EQ(index.find(VersionMatcher::parse("2023.11.02", VersionObjectType::CalVer)), nullptr);
+}
@@ -10,6 +10,7 @@
  */
 #ifndef _VERSION_MATCHER_TEST_HPP
 #define _VERSION_MATCHER_TEST_HPP
+#include "versionMatcher/versionIntervalIndex.hpp"
 #include "versionMatcher/versionMatcher.hpp"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
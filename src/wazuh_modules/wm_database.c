@@ -81,9 +81,20 @@ static void wm_check_agents();
  *        have a key will be removed.
  *        This method will also create and remove the agents artifacts according to
  *        the action taken in the database with the agent.
+ *        After a complete synchronization, only the keys added or removed since the
+ *        previous one are synchronized.
  */
 static void wm_sync_agents();
 
+// Insert an agent of the keystore into the DB
+static int wm_sync_agent_insert(const keyentry *entry);
+
+// Remove an agent from the DB, along with its artifacts
+static int wm_sync_agent_remove(const char *id);
+
+// IDs of the agents in 'client.keys' on the last synchronization, NULL if it wasn't complete
+static rb_tree *synced_agents;
+
 // Clean dangling database files
 static void wm_clean_dangling_wdb_dbs();
 
@@ -280,7 +291,19 @@ void wm_sync_agents() {
     OS_PassEmptyKeyfile();
     OS_ReadKeys(&keys, W_RAW_KEY, 0);
 
-    sync_keys_with_wdb(&keys);
+    if (synced_agents != NULL) {
+        sync_keys_delta_with_wdb(&keys, synced_agents);
+    } else if (sync_keys_with_wdb(&keys) == OS_SUCCESS) {
+        // Next time, only the changes need to be synchronized
+        synced_agents = rbtree_init();
+        rbtree_set_dispose(synced_agents, free);
+
+        for (unsigned int i = 0; i < keys.keysize; i++) {
+            if (atoi(keys.keyentries[i]->id)) {
+                rbtree_insert(synced_agents, keys.keyentries[i]->id, strdup(keys.keyentries[i]->name));
+            }
+        }
+    }
 
     OS_FreeKeys(&keys);
     mtdebug1(WM_DATABASE_LOGTAG, "Agents synchronization completed.");
@@ -298,32 +321,25 @@ void wm_sync_agents() {
  *
  * @param keys The keystore structure to be synchronized
  */
-void sync_keys_with_wdb(keystore *keys) {
+int sync_keys_with_wdb(keystore *keys) {
     rb_tree *agents = NULL;
     char **ids = NULL;
     unsigned int i;
+    int retval = OS_SUCCESS;
 
     agents = wdb_get_all_agents_rbtree(FALSE, &wdb_wmdb_sock);
 
     if (agents == NULL) {
         mterror(WM_DATABASE_LOGTAG, "Couldn't synchronize the keystore with the DB.");
-        return;
+        return OS_INVALID;
     }
 
     // Add new agents to the database
     for (i = 0; i < keys->keysize; i++) {
         keyentry *entry = keys->keyentries[i];
-        int agent_id = atoi(entry->id);
 
-        if (agent_id && (rbtree_get(agents, entry->id) == NULL)) {
-            char agent_cidr[IPSIZE + 1];
-
-            mtdebug2(WM_DATABASE_LOGTAG, "Synchronizing agent %s '%s'.", entry->id, entry->name);
-
-            if (wdb_insert_agent(agent_id, entry->name, NULL, OS_CIDRtoStr(entry->ip, agent_cidr, IPSIZE) ?
-                                entry->ip->ip : agent_cidr, entry->raw_key, NULL, 1, &wdb_wmdb_sock)) {
-                mtdebug1(WM_DATABASE_LOGTAG, "Couldn't insert agent '%s' in the database.", entry->id);
-            }
+        if (atoi(entry->id) && (rbtree_get(agents, entry->id) == NULL) && wm_sync_agent_insert(entry) < 0) {
+            retval = OS_INVALID;
         }
     }
 
@@ -331,30 +347,84 @@ void sync_keys_with_wdb(keystore *keys) {
 
     // Delete from the database all the agents without a key and all its artifacts
     for (i = 0; ids[i] != NULL; i++) {
-        int agent_id = atoi(ids[i]);
+        if (atoi(ids[i]) && (OS_IsAllowedID(keys, ids[i]) == -1) && wm_sync_agent_remove(ids[i]) < 0) {
+            retval = OS_INVALID;
+        }
+    }
 
-        if (agent_id && (OS_IsAllowedID(keys, ids[i]) == -1)) {
-            char *agent_name = wdb_get_agent_name(agent_id, &wdb_wmdb_sock);
+    free_strarray(ids);
+    rbtree_destroy(agents);
+    return retval;
+}
 
-            if (wdb_remove_agent(agent_id, &wdb_wmdb_sock) < 0) {
-                mtdebug1(WM_DATABASE_LOGTAG, "Couldn't remove agent '%s' from the database.", ids[i]);
-                os_free(agent_name);
-                continue;
-            }
+int sync_keys_delta_with_wdb(keystore *keys, rb_tree *synced) {
+    char **ids = NULL;
+    unsigned int i;
+    int retval = OS_SUCCESS;
+
+    // Add the agents whose key was added. If it fails, it's retried the next time
+    for (i = 0; i < keys->keysize; i++) {
+        keyentry *entry = keys->keyentries[i];
 
-            // Agent not found. Removing agent artifacts
-            wm_clean_agent_artifacts(agent_id, agent_name);
+        if (atoi(entry->id) && (rbtree_get(synced, entry->id) == NULL)) {
+            if (wm_sync_agent_insert(entry) < 0) {
+                retval = OS_INVALID;
+            } else {
+                rbtree_insert(synced, entry->id, strdup(entry->name));
+            }
+        }
+    }
 
-            // Remove agent-related files
-            OS_RemoveCounter(ids[i]);
-            OS_RemoveAgentTimestamp(ids[i]);
+    ids = rbtree_keys(synced);
 
-            os_free(agent_name);
+    // Delete the agents whose key was removed
+    for (i = 0; ids[i] != NULL; i++) {
+        if (OS_IsAllowedID(keys, ids[i]) == -1) {
+            if (wm_sync_agent_remove(ids[i]) < 0) {
+                retval = OS_INVALID;
+            } else {
+                rbtree_delete(synced, ids[i]);
+            }
         }
     }
 
     free_strarray(ids);
-    rbtree_destroy(agents);
+    return retval;
+}
+
+int wm_sync_agent_insert(const keyentry *entry) {
+    char agent_cidr[IPSIZE + 1];
+
+    mtdebug2(WM_DATABASE_LOGTAG, "Synchronizing agent %s '%s'.", entry->id, entry->name);
+
+    if (wdb_insert_agent(atoi(entry->id), entry->name, NULL, OS_CIDRtoStr(entry->ip, agent_cidr, IPSIZE) ?
+                         entry->ip->ip : agent_cidr, entry->raw_key, NULL, 1, &wdb_wmdb_sock)) {
+        mtdebug1(WM_DATABASE_LOGTAG, "Couldn't insert agent '%s' in the database.", entry->id);
+        return OS_INVALID;
+    }
+
+    return OS_SUCCESS;
+}
+
+int wm_sync_agent_remove(const char *id) {
+    int agent_id = atoi(id);
+    char *agent_name = wdb_get_agent_name(agent_id, &wdb_wmdb_sock);
+
+    if (wdb_remove_agent(agent_id, &wdb_wmdb_sock) < 0) {
+        mtdebug1(WM_DATABASE_LOGTAG, "Couldn't remove agent '%s' from the database.", id);
+        os_free(agent_name);
+        return OS_INVALID;
+    }
+
+    // Agent not found. Removing agent artifacts
+    wm_clean_agent_artifacts(agent_id, agent_name);
+
+    // Remove agent-related files
+    OS_RemoveCounter(id);
+    OS_RemoveAgentTimestamp(id);
+
+    os_free(agent_name);
+    return OS_SUCCESS;
 }
 
 /**
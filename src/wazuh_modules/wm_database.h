@@ -34,8 +34,22 @@ wmodule* wm_database_read();
  *        agents.
  *
  * @param keys The keystore structure to be synchronized
+ * @return OS_SUCCESS, or OS_INVALID if the DB couldn't be read or any agent couldn't be synchronized.
  */
-void sync_keys_with_wdb(keystore *keys);
+int sync_keys_with_wdb(keystore *keys);
+
+/**
+ * @brief Synchronizes the keys added to and removed from a keystore since the last
+ *        synchronization with the agent table of global.db. The agents whose key
+ *        is new are inserted, and the ones whose key is gone are removed with all
+ *        their artifacts. The rest of the agents are not looked up.
+ *
+ * @param keys The keystore structure to be synchronized
+ * @param synced IDs of the agents in the keystore on the last synchronization.
+ *               It's updated with the changes synchronized, the failed ones are retried the next time.
+ * @return OS_SUCCESS, or OS_INVALID if any agent couldn't be synchronized.
+ */
+int sync_keys_delta_with_wdb(keystore *keys, rb_tree *synced);
 
 /**
  * @brief This function removes the wazuh-db agent DB and the diff folder of an agent.
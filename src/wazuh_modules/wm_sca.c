@@ -36,8 +36,12 @@
 typedef struct request_dump_t {
     int policy_index;
     int first_scan;
+    char *ranges;       // Ranges of check ids to dump ("first-last,..."), NULL to dump all the checks
 } request_dump_t;
 
+/* Checks hashed together in each range of the summary */
+#define WM_SCA_RANGE_SIZE 32
+
 #ifdef WIN32
 static HKEY wm_sca_sub_tree;
 #endif
@@ -67,6 +71,8 @@ static void wm_sca_reset_summary();
 static int wm_sca_send_alert(wm_sca_t * data,cJSON *json_alert); // Send alert
 static int wm_sca_check_hash(OSHash *cis_db_hash, const char * const result, const cJSON * const check, const cJSON * const event, int check_index, int policy_index);
 static char *wm_sca_hash_integrity(int policy_index);
+static cJSON *wm_sca_hash_ranges(int policy_index);  // Hash the sorted results by ranges of checks
+static int wm_sca_in_ranges(const char * const ranges, int id);
 static void wm_sca_free_hash_data(cis_db_info_t *event);
 #ifdef WIN32
 static DWORD WINAPI wm_sca_dump_db_thread(wm_sca_t * data);
@@ -74,7 +80,7 @@ static DWORD WINAPI wm_sca_dump_db_thread(wm_sca_t * data);
 static void * wm_sca_dump_db_thread(wm_sca_t * data);
 #endif
 static void wm_sca_send_policies_scanned(wm_sca_t * data);
-static int wm_sca_send_dump_end(wm_sca_t * data, unsigned int elements_sent,char * policy_id,int scan_id);  // Send dump end event
+static int wm_sca_send_dump_end(wm_sca_t * data, unsigned int elements_sent,char * policy_id,int scan_id, const char * ranges);  // Send dump end event
 static int append_msg_to_vm_scat (wm_sca_t * const data, const char * const msg);
 static int compare_cis_db_info_t_entry(const void * const a, const void * const  b);
 
@@ -93,6 +99,11 @@ static int wm_sca_check_file_existence(const char * const file, char ** reason);
 static int wm_sca_check_file_list_for_existence(const char * const file_list, char ** reason);
 static int wm_sca_check_file_list(const char * const file_list, char * const pattern, char ** reason, w_expression_t * regex_engine);
 static int wm_sca_read_command(char *command, char * pattern, wm_sca_t * data, char ** reason, w_expression_t * regex_engine);
+static wm_sca_probe_t *wm_sca_probe_file(const char * const path, const char * const file); // Read a file, or reuse it if it didn't change
+static wm_sca_probe_t *wm_sca_probe_command(char * const command, wm_sca_t * data); // Run a command, or reuse its output
+static int wm_sca_probe_lines_match(const wm_sca_probe_t * const probe, const char * const pattern, char ** reason, w_expression_t * regex_engine);
+static void wm_sca_probe_release(wm_sca_probe_t *probe);
+static void wm_sca_probe_free(wm_sca_probe_t *probe);
 static int wm_sca_test_positive_minterm(char * const minterm, const char * const str, char ** reason, w_expression_t * regex_engine);
 static int wm_sca_pattern_matches(const char * const str, const char * const pattern, char ** reason, w_expression_t * regex_engine); // Check pattern match
 static int wm_sca_check_dir(const char * const dir, const char * const file, char * const pattern, char ** reason, w_expression_t * regex_engine);
@@ -135,6 +146,9 @@ static cis_db_hash_info_t *cis_db_for_hash;
 static w_queue_t * request_queue;
 static wm_sca_t * data_win;
 
+/* Files and commands probed in the current scan, by "f:<path>" or "c:<command>" */
+static OSHash *probe_cache;
+
 cJSON **last_summary_json = NULL;
 
 /* Multiple readers / one write mutex */
@@ -351,6 +365,10 @@ static void wm_sca_read_files(wm_sca_t * data) {
     if(data->policies) {
         OSHash *check_list = OSHash_Create();
         int i;
+
+        if (probe_cache = OSHash_Create(), probe_cache) {
+            OSHash_SetFreeDataPointer(probe_cache, (void (*)(void *))wm_sca_probe_free);
+        }
         for(i = 0; data->policies[i]; i++) {
             if(!data->policies[i]->enabled){
                 continue;
@@ -545,6 +563,11 @@ static void wm_sca_read_files(wm_sca_t * data) {
         }
         first_scan = 0;
         OSHash_Clean(check_list, free);
+
+        if (probe_cache) {
+            OSHash_Free(probe_cache);
+            probe_cache = NULL;
+        }
     }
 }
 
@@ -1549,32 +1572,19 @@ static int wm_sca_check_file_contents(const char * const file,
     }
     #endif
 
-    FILE *fp = wfopen(realpath_buffer, "r");
-    const int fopen_errno = errno;
-    if (!fp) {
-        if (*reason == NULL) {
-            os_malloc(snprintf(NULL, 0, "Could not open file '%s': %s", file, strerror(fopen_errno)) + 1, *reason);
-            sprintf(*reason, "Could not open file '%s': %s", file, strerror(fopen_errno));
-        }
-        mdebug2("Could not open file '%s': %s", file, strerror(fopen_errno));
-        return RETURN_INVALID;
-    }
-
-    int result = RETURN_NOT_FOUND;
-    char buf[OS_SIZE_2048 + 1];
-    while (fgets(buf, OS_SIZE_2048, fp) != NULL) {
-        os_trimcrlf(buf);
-        result = wm_sca_pattern_matches(buf, pattern, reason, regex_engine);
-        mdebug2("(%s)(%s) -> %d", pattern, *buf != '\0' ? buf : "EMPTY_LINE" , result);
+    wm_sca_probe_t *probe = wm_sca_probe_file(realpath_buffer, file);
+    int result = probe->result;
 
-        if (result) {
-            mdebug2("Match found. Skipping the rest.");
-            break;
+    if (result == RETURN_INVALID) {
+        if (*reason == NULL) {
+            os_strdup(probe->reason, *reason);
         }
+    } else {
+        result = wm_sca_probe_lines_match(probe, pattern, reason, regex_engine);
+        mdebug2("Result for (%s)(%s) -> %d", pattern, file, result);
     }
 
-    fclose(fp);
-    mdebug2("Result for (%s)(%s) -> %d", pattern, file, result);
+    wm_sca_probe_release(probe);
     return result;
 }
 
@@ -1698,71 +1708,192 @@ static int wm_sca_read_command(char * command,
     }
 
     mdebug1("Executing command '%s', and testing output with pattern '%s'", command, pattern);
+
+    wm_sca_probe_t *probe = wm_sca_probe_command(command, data);
+    int result = probe->result;
+
+    if (result == RETURN_INVALID) {
+        if (*reason == NULL) {
+            os_strdup(probe->reason, *reason);
+        }
+    } else {
+        result = wm_sca_probe_lines_match(probe, pattern, reason, regex_engine);
+        mdebug2("Result for (%s)(%s) -> %d", pattern, command, result);
+    }
+
+    wm_sca_probe_release(probe);
+    return result;
+}
+
+static wm_sca_probe_t *wm_sca_probe_file(const char * const path, const char * const file)
+{
+    wm_sca_probe_t *probe = NULL;
+    struct stat statbuf;
+    char *key = NULL;
+
+    if (stat(path, &statbuf) < 0) {
+        memset(&statbuf, 0, sizeof(statbuf));
+    }
+
+    if (probe_cache) {
+        os_malloc(strlen(path) + 3, key);
+        sprintf(key, "f:%s", path);
+
+        // The file may have changed in the middle of the scan
+        if (probe = OSHash_Get(probe_cache, key), probe) {
+            if (probe->mtime == statbuf.st_mtime && probe->size == statbuf.st_size) {
+                mdebug2("Reusing the contents of file '%s'", file);
+                os_free(key);
+                return probe;
+            }
+
+            OSHash_Delete(probe_cache, key);
+            wm_sca_probe_free(probe);
+        }
+    }
+
+    os_calloc(1, sizeof(wm_sca_probe_t), probe);
+    probe->result = RETURN_FOUND;
+    probe->mtime = statbuf.st_mtime;
+    probe->size = statbuf.st_size;
+
+    FILE *fp = wfopen(path, "r");
+    const int fopen_errno = errno;
+    if (!fp) {
+        os_malloc(snprintf(NULL, 0, "Could not open file '%s': %s", file, strerror(fopen_errno)) + 1, probe->reason);
+        sprintf(probe->reason, "Could not open file '%s': %s", file, strerror(fopen_errno));
+        mdebug2("Could not open file '%s': %s", file, strerror(fopen_errno));
+        probe->result = RETURN_INVALID;
+    } else {
+        char buf[OS_SIZE_2048 + 1];
+        int count = 0;
+
+        os_calloc(1, sizeof(char *), probe->lines);
+
+        while (fgets(buf, OS_SIZE_2048, fp) != NULL) {
+            os_trimcrlf(buf);
+            os_realloc(probe->lines, (count + 2) * sizeof(char *), probe->lines);
+            os_strdup(buf, probe->lines[count]);
+            probe->lines[++count] = NULL;
+        }
+
+        fclose(fp);
+    }
+
+    if (key) {
+        probe->cached = OSHash_Add(probe_cache, key, probe) == 2;
+        os_free(key);
+    }
+
+    return probe;
+}
+
+static wm_sca_probe_t *wm_sca_probe_command(char * const command, wm_sca_t * data)
+{
+    wm_sca_probe_t *probe = NULL;
+    char *key = NULL;
+
+    if (probe_cache) {
+        os_malloc(strlen(command) + 3, key);
+        sprintf(key, "c:%s", command);
+
+        if (probe = OSHash_Get(probe_cache, key), probe) {
+            mdebug2("Reusing the output of command '%s'", command);
+            os_free(key);
+            return probe;
+        }
+    }
+
     char *cmd_output = NULL;
     int result_code;
 
+    os_calloc(1, sizeof(wm_sca_probe_t), probe);
+    probe->result = RETURN_FOUND;
+
     switch (wm_exec(command, &cmd_output, &result_code, data->commands_timeout, NULL)) {
     case 0:
         mdebug1("Command '%s' returned code %d", command, result_code);
         break;
     case WM_ERROR_TIMEOUT:
-        os_free(cmd_output);
         mdebug1("Timeout overtaken running command '%s'", command);
-        if (*reason == NULL) {
-            os_malloc(snprintf(NULL, 0, "Timeout overtaken running command '%s'", command) + 1, *reason);
-            sprintf(*reason, "Timeout overtaken running command '%s'", command);
-        }
-        os_free(cmd_output);
-        return RETURN_INVALID;
+        os_malloc(snprintf(NULL, 0, "Timeout overtaken running command '%s'", command) + 1, probe->reason);
+        sprintf(probe->reason, "Timeout overtaken running command '%s'", command);
+        probe->result = RETURN_INVALID;
+        break;
     default:
         if (result_code == EXECVE_ERROR) {
             mdebug1("Invalid path or wrong permissions to run command '%s'", command);
-            if (*reason == NULL) {
-                os_malloc(snprintf(NULL, 0, "Invalid path or wrong permissions to run command '%s'", command) + 1, *reason);
-                sprintf(*reason, "Invalid path or wrong permissions to run command '%s'", command);
-            }
+            os_malloc(snprintf(NULL, 0, "Invalid path or wrong permissions to run command '%s'", command) + 1, probe->reason);
+            sprintf(probe->reason, "Invalid path or wrong permissions to run command '%s'", command);
         } else {
             mdebug1("Failed to run command '%s'. Returned code %d", command, result_code);
-            if (*reason == NULL) {
-                os_malloc(snprintf(NULL, 0, "Failed to run command '%s'. Returned code %d", command, result_code) + 1, *reason);
-                sprintf(*reason, "Failed to run command '%s'. Returned code %d", command, result_code);
-            }
+            os_malloc(snprintf(NULL, 0, "Failed to run command '%s'. Returned code %d", command, result_code) + 1, probe->reason);
+            sprintf(probe->reason, "Failed to run command '%s'. Returned code %d", command, result_code);
         }
-        return RETURN_INVALID;
+        probe->result = RETURN_INVALID;
     }
 
-    if(!cmd_output) {
-        mdebug2("Command yielded no output. Returning.");
-        return RETURN_NOT_FOUND;
+    if (probe->result == RETURN_FOUND) {
+        if (!cmd_output) {
+            mdebug2("Command yielded no output.");
+        } else if (probe->lines = OS_StrBreak('\n', cmd_output, 256), !probe->lines) {
+            mdebug1("Command output could not be processed. Output dump:\n%s", cmd_output);
+        } else {
+            int i;
+            for (i = 0; probe->lines[i]; i++) {
+                os_trimcrlf(probe->lines[i]);
+            }
+        }
     }
 
-    char **output_line;
-    output_line = OS_StrBreak('\n', cmd_output, 256);
+    os_free(cmd_output);
 
-    if(!output_line) {
-        mdebug1("Command output could not be processed. Output dump:\n%s", cmd_output);
-        os_free(cmd_output);
-        return RETURN_NOT_FOUND;
+    if (key) {
+        probe->cached = OSHash_Add(probe_cache, key, probe) == 2;
+        os_free(key);
     }
 
-    os_free(cmd_output);
+    return probe;
+}
 
-    int i;
+static int wm_sca_probe_lines_match(const wm_sca_probe_t * const probe,
+                                    const char * const pattern,
+                                    char ** reason,
+                                    w_expression_t * regex_engine)
+{
     int result = RETURN_NOT_FOUND;
-    for (i=0; output_line[i] != NULL; i++) {
-        char *buf = output_line[i];
-        os_trimcrlf(buf);
+    int i;
+
+    for (i = 0; probe->lines && probe->lines[i]; i++) {
+        const char * const buf = probe->lines[i];
         result = wm_sca_pattern_matches(buf, pattern, reason, regex_engine);
-        if (result == RETURN_FOUND){
+        mdebug2("(%s)(%s) -> %d", pattern, *buf != '\0' ? buf : "EMPTY_LINE" , result);
+
+        if (result) {
+            mdebug2("Match found. Skipping the rest.");
             break;
         }
     }
 
-    free_strarray(output_line);
-    mdebug2("Result for (%s)(%s) -> %d", pattern, command, result);
     return result;
 }
 
+static void wm_sca_probe_release(wm_sca_probe_t *probe)
+{
+    if (!probe->cached) {
+        wm_sca_probe_free(probe);
+    }
+}
+
+static void wm_sca_probe_free(wm_sca_probe_t *probe)
+{
+    if (probe) {
+        free_strarray(probe->lines);
+        os_free(probe->reason);
+        os_free(probe);
+    }
+}
+
 static int wm_sca_apply_numeric_partial_comparison(const char * const partial_comparison,
                                                    const long int number,
                                                    char ** reason,
@@ -2590,6 +2721,7 @@ static int wm_sca_send_summary(wm_sca_t * data, int scan_id,unsigned int passed,
 
     cJSON_AddStringToObject(json_summary, "hash", integrity_hash);
     cJSON_AddStringToObject(json_summary, "hash_file", integrity_hash_file);
+    cJSON_AddItemToObject(json_summary, "ranges", wm_sca_hash_ranges(id));
 
     if (first_scan) {
         cJSON_AddNumberToObject(json_summary, "first_scan", first_scan);
@@ -2981,6 +3113,62 @@ static char *wm_sca_hash_integrity(int policy_index) {
     return NULL;
 }
 
+static cJSON *wm_sca_hash_ranges(int policy_index) {
+    cJSON *ranges = cJSON_CreateArray();
+    int first = INT_MIN;
+    int i = 0;
+
+    /* The results are already sorted by wm_sca_hash_integrity() */
+    while (cis_db_for_hash[policy_index].elem[i]) {
+        char *str = NULL;
+        int count;
+
+        for (count = 0; count < WM_SCA_RANGE_SIZE && cis_db_for_hash[policy_index].elem[i]; count++, i++) {
+            const cis_db_info_t * const event = cis_db_for_hash[policy_index].elem[i];
+            if (event->result) {
+                wm_strcat(&str, event->result, ':');
+            }
+        }
+
+        /* The last range covers every check after it */
+        int last = cis_db_for_hash[policy_index].elem[i] ? cis_db_for_hash[policy_index].elem[i - 1]->id : INT_MAX;
+
+        if (str) {
+            cJSON *range = cJSON_CreateObject();
+            os_sha256 hash;
+
+            OS_SHA256_String(str, hash);
+            cJSON_AddNumberToObject(range, "first", first);
+            cJSON_AddNumberToObject(range, "last", last);
+            cJSON_AddStringToObject(range, "hash", hash);
+            cJSON_AddItemToArray(ranges, range);
+            os_free(str);
+        }
+
+        first = last + (last < INT_MAX);
+    }
+
+    return ranges;
+}
+
+static int wm_sca_in_ranges(const char * const ranges, int id) {
+    const char *range = ranges;
+    int first;
+    int last;
+
+    while (range && *range) {
+        if (sscanf(range, "%d-%d", &first, &last) == 2 && id >= first && id <= last) {
+            return 1;
+        }
+
+        if (range = strchr(range, ','), range) {
+            range++;
+        }
+    }
+
+    return 0;
+}
+
 char *wm_sca_hash_integrity_file(const char *file) {
 
     char *hash_file = NULL;
@@ -3044,13 +3232,24 @@ static void *wm_sca_dump_db_thread(wm_sca_t * data) {
             mdebug1("Dumping results to SCA DB for policy '%s' (Policy index: %u)",
                     data->policies[request->policy_index]->policy_path, request->policy_index);
 
+            if (request->ranges) {
+                mdebug1("Dumping only the checks in the ranges '%s'", request->ranges);
+            }
+
             int scan_id = -1;
+            int elements_sent = 0;
             w_rwlock_wrlock(&dump_rwlock);
 
             for(i = 0; cis_db_for_hash[request->policy_index].elem[i]; i++) {
                 cis_db_info_t *event;
                 event = cis_db_for_hash[request->policy_index].elem[i];
 
+                if (request->ranges && !wm_sca_in_ranges(request->ranges, event->id)) {
+                    continue;
+                }
+
+                elements_sent++;
+
                 if (event) {
                     if(event->event){
                         cJSON *db_obj;
@@ -3070,10 +3269,9 @@ static void *wm_sca_dump_db_thread(wm_sca_t * data) {
 
             w_time_delay(5000);
 
-            int elements_sent = i;
             mdebug1("Sending end of dump control event.");
 
-            wm_sca_send_dump_end(data,elements_sent,data->policies[request->policy_index]->policy_id,scan_id);
+            wm_sca_send_dump_end(data,elements_sent,data->policies[request->policy_index]->policy_id,scan_id,request->ranges);
 
             w_time_delay(2000);
 
@@ -3093,6 +3291,7 @@ static void *wm_sca_dump_db_thread(wm_sca_t * data) {
                 request->first_scan);
 
             w_rwlock_unlock(&dump_rwlock);
+            os_free(request->ranges);
             os_free(request);
         }
     }
@@ -3103,7 +3302,7 @@ static void *wm_sca_dump_db_thread(wm_sca_t * data) {
 }
 
 
-static int wm_sca_send_dump_end(wm_sca_t * data, unsigned int elements_sent,char * policy_id, int scan_id) {
+static int wm_sca_send_dump_end(wm_sca_t * data, unsigned int elements_sent,char * policy_id, int scan_id, const char * ranges) {
     cJSON *dump_event = cJSON_CreateObject();
 
     cJSON_AddStringToObject(dump_event, "type", "dump_end");
@@ -3111,6 +3310,10 @@ static int wm_sca_send_dump_end(wm_sca_t * data, unsigned int elements_sent,char
     cJSON_AddNumberToObject(dump_event, "elements_sent", elements_sent);
     cJSON_AddNumberToObject(dump_event, "scan_id", scan_id);
 
+    if (ranges) {
+        cJSON_AddStringToObject(dump_event, "ranges", ranges);
+    }
+
     wm_sca_send_alert(data,dump_event);
 
     cJSON_Delete(dump_event);
@@ -3136,6 +3339,14 @@ void wm_sca_push_request_win(char * msg){
 
         *first_scan++ = '\0';
 
+        /* Ranges of checks to dump, sent by managers that compare them separately */
+        char *ranges = strchr(first_scan,':');
+
+        if (ranges) {
+            *ranges++ = '\0';
+            ranges[strcspn(ranges, "\n")] = '\0';
+        }
+
         /* Search DB */
         int i;
 
@@ -3161,7 +3372,12 @@ void wm_sca_push_request_win(char * msg){
                         request->policy_index = i;
                         request->first_scan = atoi(first_scan);
 
+                        if (ranges && *ranges) {
+                            os_strdup(ranges, request->ranges);
+                        }
+
                         if(queue_push_ex(request_queue,request) < 0) {
+                            os_free(request->ranges);
                             os_free(request);
                             mdebug1("Could not push policy index to queue.");
                         }
@@ -3217,6 +3433,14 @@ static void * wm_sca_request_thread(wm_sca_t * data) {
 
                 *first_scan++ = '\0';
 
+                /* Ranges of checks to dump, sent by managers that compare them separately */
+                char *ranges = strchr(first_scan,':');
+
+                if (ranges) {
+                    *ranges++ = '\0';
+                    ranges[strcspn(ranges, "\n")] = '\0';
+                }
+
                 /* Search DB */
                 int i;
                 for(i = 0; data->policies[i]; i++) {
@@ -3240,7 +3464,12 @@ static void * wm_sca_request_thread(wm_sca_t * data) {
                             request->policy_index = i;
                             request->first_scan = atoi(first_scan);
 
+                            if (ranges && *ranges) {
+                                os_strdup(ranges, request->ranges);
+                            }
+
                             if(queue_push_ex(request_queue,request) < 0) {
+                                os_free(request->ranges);
                                 os_free(request);
                                 mdebug1("Could not push policy index to queue.");
                             }
@@ -63,6 +63,16 @@ typedef struct cis_db_hash_info_t {
     cis_db_info_t **elem;
 } cis_db_hash_info_t;
 
+/* Lines of a file or output of a command, read once per scan */
+typedef struct wm_sca_probe_t {
+    char **lines;       // NULL-terminated
+    int result;         // RETURN_FOUND if it could be read, RETURN_INVALID otherwise
+    char *reason;       // Why it could not be read
+    time_t mtime;       // Modification time of the file
+    off_t size;         // Size of the file
+    int cached;         // Owned by the probe cache
+} wm_sca_probe_t;
+
 extern const wm_context WM_SCA_CONTEXT;
 
 // Read configuration and return a module (if enabled) or NULL (if disabled)
@@ -108,6 +108,8 @@ void* wm_vulnerability_scanner_main(wm_vulnerability_scanner_t* data) {
                 char* manager_node_name = get_node_name();
                 cJSON_AddStringToObject(config_json, "clusterNodeName", manager_node_name);
                 os_free(manager_node_name);
+
+                cJSON_AddStringToObject(config_json, "clusterNodeType", w_is_worker() == 1 ? "worker" : "master");
             }
             else {
                 char hostname[HOST_NAME_MAX + 1];